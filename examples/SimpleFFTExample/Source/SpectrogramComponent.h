@@ -31,8 +31,7 @@ public:
     SpectrogramComponent()
         : forwardFFT (fftOrder),
           spectrogramImage (Image::RGB, 512, 512, true),
-          fifoIndex (0),
-          nextFFTBlockReady (false)
+          fifoIndex (0)
     {
         setOpaque (true);
         setAudioChannels (2, 0);  // we want a couple of input channels but no outputs
@@ -78,26 +77,24 @@ public:
 
     void timerCallback() override
     {
-        if (nextFFTBlockReady)
+        if (fftBlocks.acquireLatest())
         {
+            zeromem (fftData, sizeof (fftData));
+            memcpy (fftData, fftBlocks.getReadFrame().samples, sizeof (FFTBlock::samples));
+
             drawNextLineOfSpectrogram();
-            nextFFTBlockReady = false;
             repaint();
         }
     }
 
     void pushNextSampleIntoFifo (float sample) noexcept
     {
-        // if the fifo contains enough data, set a flag to say
-        // that the next line should now be rendered..
+        // if the fifo contains enough data, hand it over to the
+        // message thread so that the next line can be rendered..
         if (fifoIndex == fftSize)
         {
-            if (! nextFFTBlockReady)
-            {
-                zeromem (fftData, sizeof (fftData));
-                memcpy (fftData, fifo, sizeof (fifo));
-                nextFFTBlockReady = true;
-            }
+            memcpy (fftBlocks.getWriteFrame().samples, fifo, sizeof (fifo));
+            fftBlocks.publish();
 
             fifoIndex = 0;
         }
@@ -140,10 +137,15 @@ private:
     dsp::FFT forwardFFT;
     Image spectrogramImage;
 
+    struct FFTBlock
+    {
+        float samples [fftSize];
+    };
+
     float fifo [fftSize];
     float fftData [2 * fftSize];
     int fifoIndex;
-    bool nextFFTBlockReady;
+    TripleBuffer<FFTBlock> fftBlocks;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramComponent)
 };
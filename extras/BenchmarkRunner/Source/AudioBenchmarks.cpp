@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+class SynthesiserBenchmark  : public Benchmark
+{
+public:
+    SynthesiserBenchmark() : Benchmark ("Synthesiser", "Audio") {}
+
+    struct Sound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct SineVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            angle = 0;
+            level = velocity * 0.05;
+            delta = MathConstants<double>::pi * 2.0 * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+        }
+
+        void stopNote (float, bool) override        { clearCurrentNote(); }
+        void pitchWheelMoved (int) override         {}
+        void controllerMoved (int, int) override    {}
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                auto sample = (float) (std::sin (angle) * level);
+                angle += delta;
+
+                if (angle > MathConstants<double>::pi * 2.0)
+                    angle -= MathConstants<double>::pi * 2.0;
+
+                for (int ch = output.getNumChannels(); --ch >= 0;)
+                    output.addSample (ch, i, sample);
+            }
+        }
+
+        double angle = 0, delta = 0, level = 0;
+    };
+
+    void runBenchmark() override
+    {
+        const int blockSize = 512, numVoices = 16;
+
+        Synthesiser synth;
+        synth.addSound (new Sound());
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new SineVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        AudioBuffer<float> output (2, blockSize);
+        MidiBuffer noMidi, notes, controllers;
+
+        for (int i = 0; i < numVoices; ++i)
+            notes.addEvent (MidiMessage::noteOn (1, 48 + i, 0.8f), 0);
+
+        auto random = getRandom();
+
+        for (int i = 0; i < 32; ++i)
+            controllers.addEvent (MidiMessage::controllerEvent (1, 1, random.nextInt (128)), random.nextInt (blockSize));
+
+        synth.renderNextBlock (output, notes, 0, blockSize);
+
+        measure ("16 voices", [&]
+        {
+            output.clear();
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+        }, blockSize);
+
+        measure ("16 voices, 32 controller events", [&]
+        {
+            output.clear();
+            synth.renderNextBlock (output, controllers, 0, blockSize);
+        }, blockSize);
+
+        synth.setVoiceLaneRendering (true, 2, blockSize);
+
+        measure ("16 voices, rendered to lanes", [&]
+        {
+            output.clear();
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+        }, blockSize);
+    }
+};
+
+static SynthesiserBenchmark synthesiserBenchmark;
+
+//==============================================================================
+class AudioProcessorGraphBenchmark  : public Benchmark
+{
+public:
+    AudioProcessorGraphBenchmark() : Benchmark ("AudioProcessorGraph", "Audio") {}
+
+    // A processor that does a fixed amount of work on each sample
+    struct FilterProcessor  : public AudioProcessor
+    {
+        const String getName() const override                       { return "Filter"; }
+        void prepareToPlay (double, int) override                   { state[0] = state[1] = 0; }
+        void releaseResources() override                            {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (int ch = 0; ch < jmin (2, buffer.getNumChannels()); ++ch)
+            {
+                auto* data = buffer.getWritePointer (ch);
+                auto s = state[ch];
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    data[i] = s = s * 0.9f + data[i] * 0.1f;
+
+                state[ch] = s;
+            }
+        }
+
+        double getTailLengthSeconds() const override                { return 0; }
+        bool acceptsMidi() const override                           { return false; }
+        bool producesMidi() const override                          { return false; }
+        AudioProcessorEditor* createEditor() override               { return nullptr; }
+        bool hasEditor() const override                             { return false; }
+        int getNumPrograms() override                               { return 1; }
+        int getCurrentProgram() override                            { return 0; }
+        void setCurrentProgram (int) override                       {}
+        const String getProgramName (int) override                  { return {}; }
+        void changeProgramName (int, const String&) override        {}
+        void getStateInformation (MemoryBlock&) override            {}
+        void setStateInformation (const void*, int) override        {}
+
+        float state[2];
+    };
+
+    // Builds a graph of numChains parallel chains of processors, which are all mixed into the output
+    static void buildGraph (AudioProcessorGraph& graph, int numChains, int chainLength)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        auto inputId  = graph.addNode (new IOProcessor (IOProcessor::audioInputNode))->nodeId;
+        auto outputId = graph.addNode (new IOProcessor (IOProcessor::audioOutputNode))->nodeId;
+
+        for (int chain = 0; chain < numChains; ++chain)
+        {
+            auto previousId = inputId;
+
+            for (int i = 0; i < chainLength; ++i)
+            {
+                auto nodeId = graph.addNode (new FilterProcessor())->nodeId;
+
+                for (int ch = 0; ch < 2; ++ch)
+                    graph.addConnection (previousId, ch, nodeId, ch);
+
+                previousId = nodeId;
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                graph.addConnection (previousId, ch, outputId, ch);
+        }
+    }
+
+    void runBenchmark() override
+    {
+        const int blockSize = 512;
+        const double sampleRate = 44100.0;
+
+        AudioBuffer<float> buffer (2, blockSize);
+        MidiBuffer midi;
+
+        for (int numWorkerThreads : { 0, 3 })
+        {
+            AudioProcessorGraph graph;
+            graph.setNumWorkerThreads (numWorkerThreads);
+            graph.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+            buildGraph (graph, 8, 4);
+            graph.prepareToPlay (sampleRate, blockSize);
+
+            auto random = getRandom();
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            AudioBuffer<float> input (buffer);
+
+            measure ("8 chains of 4 nodes, " + String (graph.getNumWorkerThreads()) + " worker threads", [&]
+            {
+                buffer.copyFrom (0, 0, input, 0, 0, blockSize);
+                buffer.copyFrom (1, 0, input, 1, 0, blockSize);
+                graph.processBlock (buffer, midi);
+            }, blockSize);
+
+            graph.releaseResources();
+        }
+    }
+};
+
+static AudioProcessorGraphBenchmark audioProcessorGraphBenchmark;
+
+//==============================================================================
+class MidiBufferBenchmark  : public Benchmark
+{
+public:
+    MidiBufferBenchmark() : Benchmark ("MidiBuffer", "Audio") {}
+
+    void runBenchmark() override
+    {
+        const int numEvents = 256, blockSize = 512;
+
+        Array<MidiMessage> messages;
+        Array<int> positions;
+        auto random = getRandom();
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            messages.add (MidiMessage::noteOn (1 + random.nextInt (16), random.nextInt (128), (uint8) (1 + random.nextInt (127))));
+            positions.add (random.nextInt (blockSize));
+        }
+
+        MidiBuffer buffer;
+
+        measure ("add 256 events in random order", [&]
+        {
+            buffer.clear();
+
+            for (int i = 0; i < numEvents; ++i)
+                buffer.addEvent (messages.getReference (i), positions.getUnchecked (i));
+        }, numEvents);
+
+        measure ("iterate over 256 events", [&]
+        {
+            MidiBuffer::Iterator iter (buffer);
+            const uint8* data;
+            int numBytes, position, total = 0;
+
+            while (iter.getNextEvent (data, numBytes, position))
+                total += data[1];
+
+            doNotOptimiseAway (total);
+        }, numEvents);
+
+        MidiBuffer other;
+
+        measure ("merge two buffers of 256 events", [&]
+        {
+            other.clear();
+            other.addEvents (buffer, 0, blockSize, 0);
+            other.addEvents (buffer, 0, blockSize, 0);
+        }, numEvents * 2);
+    }
+};
+
+static MidiBufferBenchmark midiBufferBenchmark;
+
+//==============================================================================
+/*  This measures the cost of running real plug-ins through the hosting classes, so it
+    needs to be given some plug-ins to load. Set the JUCE_BENCHMARK_PLUGINS environment
+    variable to a list of plug-in files, separated by semicolons. The formats that can be
+    loaded are the ones enabled by the JUCE_PLUGINHOST_xxx flags in AppConfig.h.
+
+    Each case times a single block for a single instance, so loading the same plug-in in
+    several formats shows how much overhead each format's hosting code adds.
+*/
+class PluginHostingBenchmark  : public Benchmark
+{
+public:
+    PluginHostingBenchmark() : Benchmark ("Plugin hosting", "Audio") {}
+
+    void runBenchmark() override
+    {
+        auto paths = StringArray::fromTokens (SystemStats::getEnvironmentVariable ("JUCE_BENCHMARK_PLUGINS", {}), ";", {});
+        paths.trim();
+        paths.removeEmptyStrings();
+
+        if (paths.isEmpty())
+        {
+            logMessage ("Set JUCE_BENCHMARK_PLUGINS to a list of plug-in files to measure the hosting overhead");
+            return;
+        }
+
+        AudioPluginFormatManager formatManager;
+        formatManager.addDefaultFormats();
+
+        for (auto& path : paths)
+        {
+            for (int i = 0; i < formatManager.getNumFormats(); ++i)
+            {
+                auto* format = formatManager.getFormat (i);
+
+                if (format->fileMightContainThisPluginType (path))
+                {
+                    OwnedArray<PluginDescription> descriptions;
+                    format->findAllTypesForFile (descriptions, path);
+
+                    for (auto* description : descriptions)
+                        measurePlugin (formatManager, *description);
+                }
+            }
+        }
+    }
+
+    void measurePlugin (AudioPluginFormatManager& formatManager, const PluginDescription& description)
+    {
+        const int blockSize = 512;
+        const double sampleRate = 44100.0;
+
+        String error;
+        ScopedPointer<AudioPluginInstance> plugin (formatManager.createPluginInstance (description, sampleRate, blockSize, error));
+
+        if (plugin == nullptr)
+        {
+            logMessage ("Couldn't load " + description.name + ": " + error);
+            return;
+        }
+
+        plugin->prepareToPlay (sampleRate, blockSize);
+
+        AudioBuffer<float> buffer (jmax (1, plugin->getTotalNumInputChannels(), plugin->getTotalNumOutputChannels()), blockSize);
+        MidiBuffer midi;
+        auto name = description.pluginFormatName + " " + description.name;
+
+        measure (name + ", silent block", [&]
+        {
+            buffer.clear();
+            midi.clear();
+            plugin->processBlock (buffer, midi);
+        });
+
+        auto numParametersToChange = jmin (16, plugin->getNumParameters());
+
+        if (numParametersToChange > 0)
+        {
+            auto random = getRandom();
+
+            measure (name + ", " + String (numParametersToChange) + " parameter changes per block", [&]
+            {
+                for (int i = 0; i < numParametersToChange; ++i)
+                    plugin->setParameter (i, random.nextFloat());
+
+                buffer.clear();
+                midi.clear();
+                plugin->processBlock (buffer, midi);
+            });
+        }
+
+        plugin->releaseResources();
+    }
+};
+
+static PluginHostingBenchmark pluginHostingBenchmark;
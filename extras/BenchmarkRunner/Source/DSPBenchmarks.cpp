@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+static void fillWithNoise (float* data, int numSamples, Random& r)
+{
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = r.nextFloat() * 2.0f - 1.0f;
+}
+
+static void fillWithNoise (AudioBuffer<float>& buffer, Random& r)
+{
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        fillWithNoise (buffer.getWritePointer (ch), buffer.getNumSamples(), r);
+}
+
+//==============================================================================
+class FloatVectorOperationsBenchmark  : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmark() : Benchmark ("FloatVectorOperations", "DSP") {}
+
+    void runBenchmark() override
+    {
+        auto random = getRandom();
+        const int numSamples = 4096;
+        HeapBlock<float> src1 (numSamples), src2 (numSamples), dst (numSamples);
+        fillWithNoise (src1, numSamples, random);
+        fillWithNoise (src2, numSamples, random);
+        fillWithNoise (dst, numSamples, random);
+
+        // (these all write to a different buffer from their inputs, so that repeating them
+        // can't make the values drift towards infinity or denormals)
+        measure ("add",              [&] { FloatVectorOperations::add (dst, src1, src2, numSamples); },             numSamples);
+        measure ("multiply",         [&] { FloatVectorOperations::multiply (dst, src1, src2, numSamples); },        numSamples);
+        measure ("addWithMultiply",  [&] { FloatVectorOperations::addWithMultiply (dst, src1, src2, numSamples); }, numSamples);
+        measure ("copyWithMultiply", [&] { FloatVectorOperations::copyWithMultiply (dst, src1, 0.5f, numSamples); }, numSamples);
+        measure ("findMinAndMax",    [&] { doNotOptimiseAway (FloatVectorOperations::findMinAndMax (src1, numSamples)); }, numSamples);
+
+        HeapBlock<int> fixed (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            fixed[i] = roundToInt (src1[i] * 8388607.0f);
+
+        measure ("convertFixedToFloat", [&] { FloatVectorOperations::convertFixedToFloat (dst, fixed, 1.0f / 8388607.0f, numSamples); }, numSamples);
+    }
+};
+
+static FloatVectorOperationsBenchmark floatVectorOperationsBenchmark;
+
+//==============================================================================
+class FFTBenchmark  : public Benchmark
+{
+public:
+    FFTBenchmark() : Benchmark ("FFT", "DSP") {}
+
+    void runBenchmark() override
+    {
+        auto random = getRandom();
+        for (int order : { 9, 11, 13 })
+        {
+            dsp::FFT fft (order);
+            auto size = fft.getSize();
+
+            HeapBlock<float> input (size * 2), data (size * 2);
+            fillWithNoise (input, size, random);
+
+            measure ("real-only forward, size " + String (size), [&]
+            {
+                FloatVectorOperations::copy (data, input, size);
+                fft.performRealOnlyForwardTransform (data);
+            }, size);
+
+            measure ("frequency-only forward, size " + String (size), [&]
+            {
+                FloatVectorOperations::copy (data, input, size);
+                fft.performFrequencyOnlyForwardTransform (data);
+            }, size);
+        }
+    }
+};
+
+static FFTBenchmark fftBenchmark;
+
+//==============================================================================
+// This uses MultichannelConvolution rather than Convolution, because Convolution loads
+// its impulse responses on a background thread and crossfades to them, so the amount
+// of work it does in the first few blocks depends on the timing of that thread.
+class ConvolutionBenchmark  : public Benchmark
+{
+public:
+    ConvolutionBenchmark() : Benchmark ("Convolution", "DSP") {}
+
+    void runBenchmark() override
+    {
+        auto random = getRandom();
+        const int blockSize = 512;
+        const double sampleRate = 44100.0;
+
+        AudioBuffer<float> input (2, blockSize), output (2, blockSize);
+        fillWithNoise (input, random);
+
+        dsp::AudioBlock<float> inputBlock (input), outputBlock (output);
+
+        for (int impulseLength : { 4096, 65536 })
+        {
+            AudioBuffer<float> impulse (2, impulseLength);
+            fillWithNoise (impulse, random);
+
+            dsp::MultichannelConvolution convolution;
+            convolution.prepare ({ sampleRate, (uint32) blockSize, 2 });
+            convolution.copyAndLoadImpulseResponseFromBuffer (impulse, sampleRate);
+
+            measure ("stereo, " + String (impulseLength) + " sample impulse", [&]
+            {
+                convolution.process (dsp::ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+            }, blockSize);
+        }
+    }
+};
+
+static ConvolutionBenchmark convolutionBenchmark;
+
+//==============================================================================
+class FilterBenchmark  : public Benchmark
+{
+public:
+    FilterBenchmark() : Benchmark ("IIR and FIR filters", "DSP") {}
+
+    void runBenchmark() override
+    {
+        auto random = getRandom();
+        const int blockSize = 512;
+        const double sampleRate = 44100.0;
+        const dsp::ProcessSpec spec { sampleRate, (uint32) blockSize, 1 };
+
+        AudioBuffer<float> input (1, blockSize), output (1, blockSize);
+        fillWithNoise (input, random);
+
+        // the input is never changed, so that the filters can't decay into denormals
+        dsp::AudioBlock<float> inputBlock (input), outputBlock (output);
+        const dsp::ProcessContextNonReplacing<float> context (inputBlock, outputBlock);
+
+        {
+            dsp::IIR::Filter<float> filter (dsp::IIR::Coefficients<float>::makeLowPass (sampleRate, 1000.0f));
+            filter.prepare (spec);
+
+            measure ("IIR low-pass", [&] { filter.process (context); }, blockSize);
+        }
+
+        for (int numTaps : { 32, 256 })
+        {
+            HeapBlock<float> taps (numTaps);
+            fillWithNoise (taps, numTaps, random);
+            FloatVectorOperations::multiply (taps, 1.0f / (float) numTaps, numTaps);
+
+            dsp::FIR::Filter<float> filter (new dsp::FIR::Coefficients<float> (taps.get(), (size_t) numTaps));
+            filter.prepare (spec);
+
+            measure ("FIR, " + String (numTaps) + " taps", [&] { filter.process (context); }, blockSize);
+        }
+    }
+};
+
+static FilterBenchmark filterBenchmark;
+
+//==============================================================================
+class OversamplingBenchmark  : public Benchmark
+{
+public:
+    OversamplingBenchmark() : Benchmark ("Oversampling", "DSP") {}
+
+    void runBenchmark() override
+    {
+        auto random = getRandom();
+        const int blockSize = 512;
+
+        AudioBuffer<float> input (2, blockSize), output (2, blockSize);
+        fillWithNoise (input, random);
+        dsp::AudioBlock<float> inputBlock (input), outputBlock (output);
+
+        using OversamplingType = dsp::Oversampling<float>;
+
+        for (auto filterType : { OversamplingType::filterHalfBandFIREquiripple, OversamplingType::filterHalfBandPolyphaseIIR })
+        {
+            OversamplingType oversampling (2, 2, filterType);
+            oversampling.initProcessing ((size_t) blockSize);
+
+            measure (String ("4x up and down, ") + (filterType == OversamplingType::filterHalfBandPolyphaseIIR ? "IIR" : "FIR"), [&]
+            {
+                oversampling.processSamplesUp (inputBlock);
+                oversampling.processSamplesDown (outputBlock);
+            }, blockSize);
+        }
+    }
+};
+
+static OversamplingBenchmark oversamplingBenchmark;
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+class ValueTreeBenchmark  : public Benchmark
+{
+public:
+    ValueTreeBenchmark() : Benchmark ("ValueTree", "Data Structures") {}
+
+    struct CountingListener  : public ValueTree::Listener
+    {
+        void valueTreePropertyChanged (ValueTree&, const Identifier&) override   { ++numChanges; }
+        void valueTreeChildAdded (ValueTree&, ValueTree&) override               {}
+        void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override        {}
+        void valueTreeChildOrderChanged (ValueTree&, int, int) override          {}
+        void valueTreeParentChanged (ValueTree&) override                        {}
+
+        int numChanges = 0;
+    };
+
+    void runBenchmark() override
+    {
+        const int numChildren = 1000;
+        const Identifier itemType ("ITEM"), idProperty ("id"), nameProperty ("name"), gainProperty ("gain");
+
+        auto random = getRandom();
+        ValueTree tree ("ROOT");
+
+        auto buildTree = [&]
+        {
+            tree.removeAllChildren (nullptr);
+
+            for (int i = 0; i < numChildren; ++i)
+            {
+                ValueTree child (itemType);
+                child.setProperty (idProperty, i, nullptr);
+                child.setProperty (nameProperty, "Item " + String (i), nullptr);
+                child.setProperty (gainProperty, random.nextDouble(), nullptr);
+                tree.addChild (child, -1, nullptr);
+            }
+        };
+
+        measure ("build a tree of 1000 children", buildTree, numChildren);
+
+        measure ("find a child by property", [&]
+        {
+            doNotOptimiseAway (tree.getChildWithProperty (idProperty, numChildren - 1).isValid());
+        });
+
+        tree.setChildIndexProperty (idProperty);
+
+        measure ("find a child by an indexed property", [&]
+        {
+            doNotOptimiseAway (tree.getChildWithProperty (idProperty, numChildren - 1).isValid());
+        });
+
+        tree.setChildIndexProperty ({});
+
+        CountingListener listener;
+        tree.addListener (&listener);
+
+        measure ("set a property, with a listener", [&]
+        {
+            for (int i = 0; i < numChildren; ++i)
+                tree.getChild (i).setProperty (gainProperty, (double) i, nullptr);
+        }, numChildren);
+
+        tree.removeListener (&listener);
+
+        UndoManager undoManager;
+
+        measure ("set a property, with an UndoManager", [&]
+        {
+            undoManager.clearUndoHistory();
+
+            for (int i = 0; i < numChildren; ++i)
+                tree.getChild (i).setProperty (gainProperty, (double) (numChildren - i), &undoManager);
+        }, numChildren);
+
+        measure ("create a deep copy", [&] { doNotOptimiseAway (tree.createCopy().getNumChildren()); }, numChildren);
+
+        MemoryOutputStream binary;
+
+        measure ("write to a binary stream", [&]
+        {
+            binary.reset();
+            tree.writeToStream (binary);
+        }, numChildren);
+
+        measure ("read from binary data", [&]
+        {
+            doNotOptimiseAway (ValueTree::readFromData (binary.getData(), binary.getDataSize()).getNumChildren());
+        }, numChildren);
+
+        measure ("convert to an XML string", [&]
+        {
+            ScopedPointer<XmlElement> xml (tree.createXml());
+            doNotOptimiseAway (xml->createDocument ({}).length());
+        }, numChildren);
+    }
+};
+
+static ValueTreeBenchmark valueTreeBenchmark;
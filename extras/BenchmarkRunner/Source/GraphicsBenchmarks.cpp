@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+// These draw into software images, so they measure the LowLevelGraphicsSoftwareRenderer
+// without needing a window. Text isn't included, because the fonts that are available
+// differ from one machine to the next.
+class SoftwareRendererBenchmark  : public Benchmark
+{
+public:
+    SoftwareRendererBenchmark() : Benchmark ("Software renderer", "Graphics") {}
+
+    static Path createTestPath (Random& random, int width, int height)
+    {
+        Path p;
+
+        for (int i = 0; i < 20; ++i)
+            p.addStar ({ random.nextFloat() * (float) width, random.nextFloat() * (float) height },
+                       5 + random.nextInt (5), 20.0f, 20.0f + random.nextFloat() * 100.0f,
+                       random.nextFloat());
+
+        p.setUsingNonZeroWinding (false);
+        return p;
+    }
+
+    void runBenchmark() override
+    {
+        const int width = 1024, height = 768;
+        auto random = getRandom();
+        auto path = createTestPath (random, width, height);
+
+        Image sourceImage (Image::ARGB, 256, 256, true, SoftwareImageType());
+
+        {
+            Graphics g (sourceImage);
+            g.setGradientFill (ColourGradient (Colours::red, 0, 0, Colours::blue.withAlpha (0.5f), 256.0f, 256.0f, true));
+            g.fillEllipse (0, 0, 256.0f, 256.0f);
+        }
+
+        for (auto format : { Image::ARGB, Image::RGB })
+        {
+            Image image (format, width, height, true, SoftwareImageType());
+            Graphics g (image);
+
+            auto suffix = String (format == Image::ARGB ? " (ARGB)" : " (RGB)");
+            auto numPixels = (int64) width * height;
+
+            measure ("fill with a solid colour" + suffix, [&]
+            {
+                g.setColour (Colours::darkgrey);
+                g.fillAll();
+            }, numPixels);
+
+            measure ("fill with a translucent colour" + suffix, [&]
+            {
+                g.setColour (Colours::orange.withAlpha (0.5f));
+                g.fillRect (0, 0, width, height);
+            }, numPixels);
+
+            measure ("fill with a linear gradient" + suffix, [&]
+            {
+                g.setGradientFill (ColourGradient (Colours::white, 0, 0, Colours::black, (float) width, (float) height, false));
+                g.fillRect (0, 0, width, height);
+            }, numPixels);
+
+            measure ("fill with a radial gradient" + suffix, [&]
+            {
+                g.setGradientFill (ColourGradient (Colours::white, width * 0.5f, height * 0.5f, Colours::black, 0, 0, true));
+                g.fillRect (0, 0, width, height);
+            }, numPixels);
+
+            measure ("fill a complex path" + suffix, [&]
+            {
+                g.setColour (Colours::green.withAlpha (0.7f));
+                g.fillPath (path);
+            });
+
+            measure ("stroke a complex path" + suffix, [&]
+            {
+                g.setColour (Colours::white);
+                g.strokePath (path, PathStrokeType (2.5f));
+            });
+
+            measure ("draw an image with a rotation" + suffix, [&]
+            {
+                g.drawImageTransformed (sourceImage, AffineTransform::rotation (0.3f, 128.0f, 128.0f)
+                                                                    .scaled (2.5f)
+                                                                    .translated (200.0f, 50.0f));
+            });
+
+            g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+
+            measure ("draw an image with a rotation, low quality" + suffix, [&]
+            {
+                g.drawImageTransformed (sourceImage, AffineTransform::rotation (0.3f, 128.0f, 128.0f)
+                                                                    .scaled (2.5f)
+                                                                    .translated (200.0f, 50.0f));
+            });
+        }
+    }
+};
+
+static SoftwareRendererBenchmark softwareRendererBenchmark;
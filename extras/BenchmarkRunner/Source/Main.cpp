@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+class ConsoleLogger : public Logger
+{
+    void logMessage (const String& message) override
+    {
+        std::cout << message << std::endl;
+
+       #if JUCE_WINDOWS
+        Logger::outputDebugString (message);
+       #endif
+    }
+};
+
+//==============================================================================
+static void printUsage()
+{
+    std::cout << "Usage: BenchmarkRunner [options]" << std::endl
+              << std::endl
+              << "  --list                  list the benchmarks and their categories" << std::endl
+              << "  --category name         only run the benchmarks in this category" << std::endl
+              << "  --repetitions n         the number of timed repetitions of each case" << std::endl
+              << "  --warmup n              the number of untimed repetitions before those" << std::endl
+              << "  --seed n                the random seed used to create the test data" << std::endl
+              << "  --json file             write the results to a JSON file" << std::endl
+              << "  --baseline file         compare the results with a JSON file from an earlier run," << std::endl
+              << "                          and fail if any case has got slower" << std::endl
+              << "  --tolerance n           the proportion by which a case can be slower than the" << std::endl
+              << "                          baseline before it counts as a regression (default 0.1)" << std::endl
+              << std::endl
+              << "The \"Plugin hosting\" benchmark loads the plug-in files listed in the JUCE_BENCHMARK_PLUGINS" << std::endl
+              << "environment variable, separated by semicolons." << std::endl;
+}
+
+int main (int argc, char* argv[])
+{
+    ConsoleLogger logger;
+    Logger::setCurrentLogger (&logger);
+
+    StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+        args.add (CharPointer_UTF8 (argv[i]));
+
+    auto getOption = [&] (const char* name, const String& defaultValue) -> String
+    {
+        auto index = args.indexOf (name);
+        return index >= 0 && index + 1 < args.size() ? args[index + 1] : defaultValue;
+    };
+
+    if (args.contains ("--help") || args.contains ("-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    if (args.contains ("--list"))
+    {
+        for (auto* b : Benchmark::getAllBenchmarks())
+            std::cout << b->getCategory() << ": " << b->getName() << std::endl;
+
+        return 0;
+    }
+
+    BenchmarkRunner runner;
+    BenchmarkRunner::Options options;
+    options.repetitions = jmax (1, getOption ("--repetitions", String (options.repetitions)).getIntValue());
+    options.warmupRepetitions = jmax (0, getOption ("--warmup", String (options.warmupRepetitions)).getIntValue());
+    runner.setOptions (options);
+
+    auto seed = getOption ("--seed", "0").getLargeIntValue();
+    auto category = getOption ("--category", {});
+
+    if (category.isNotEmpty())
+        runner.runBenchmarksInCategory (category, seed);
+    else
+        runner.runAllBenchmarks (seed);
+
+    int result = 0;
+    auto jsonFile = getOption ("--json", {});
+
+    if (jsonFile.isNotEmpty() && ! File::getCurrentWorkingDirectory().getChildFile (jsonFile)
+                                                                    .replaceWithText (runner.getResultsAsJSON()))
+    {
+        std::cout << "!!! Couldn't write " << jsonFile << std::endl;
+        result = 1;
+    }
+
+    auto baselineFile = getOption ("--baseline", {});
+
+    if (baselineFile.isNotEmpty())
+    {
+        auto baseline = JSON::parse (File::getCurrentWorkingDirectory().getChildFile (baselineFile));
+
+        if (baseline.isVoid())
+        {
+            std::cout << "!!! Couldn't read " << baselineFile << std::endl;
+            result = 1;
+        }
+        else
+        {
+            auto regressions = runner.findRegressions (baseline, getOption ("--tolerance", "0.1").getDoubleValue());
+
+            for (auto& r : regressions)
+                std::cout << "!!! Regression: " << r << std::endl;
+
+            if (! regressions.isEmpty())
+                result = 1;
+        }
+    }
+
+    Logger::setCurrentLogger (nullptr);
+    return result;
+}
@@ -102,6 +102,13 @@ namespace ProjectProperties
                 .getChildFile ("Intermediate Files")
                 .getChildFile (cacheFolderName);
     }
+
+    // The last class list that the compile engine sent, so that the component list
+    // can be shown straight away when the project is next opened
+    static File getClassListCacheFile (Project& project)
+    {
+        return getCacheLocation (project).getChildFile ("ClassList.bin");
+    }
 }
 
 //==============================================================================
@@ -300,10 +307,10 @@ public:
     {
         server = nullptr;
         server = new ClientIPC (owner);
-        sendRebuild();
+        sendRebuild (true);
     }
 
-    void sendRebuild()
+    void sendRebuild (bool forceRebuild = false)
     {
         stopTimer();
 
@@ -311,7 +318,7 @@ public:
 
         if (! doesProjectMatchSavedHeaderState (project))
         {
-            MessageTypes::sendNewBuild (*server, build);
+            sendNewBuildIfChanged (build, forceRebuild);
 
             owner.errorList.resetToError ("Project structure does not match the saved headers! "
                                           "Please re-save your project to enable compilation");
@@ -320,7 +327,7 @@ public:
 
         if (areAnyModulesMissing (project))
         {
-            MessageTypes::sendNewBuild (*server, build);
+            sendNewBuildIfChanged (build, forceRebuild);
 
             owner.errorList.resetToError ("Some of your JUCE modules can't be found! "
                                           "Please check that all the module paths are correct");
@@ -343,13 +350,13 @@ public:
 
         owner.updateAllEditors();
 
-        MessageTypes::sendNewBuild (*server, build);
+        sendNewBuildIfChanged (build, forceRebuild);
     }
 
     void cleanAll()
     {
         MessageTypes::sendCleanAll (*server);
-        sendRebuild();
+        sendRebuild (true);
     }
 
     void reinstantiatePreviews()
@@ -372,6 +379,19 @@ private:
     CompileEngineChildProcess& owner;
     Project& project;
     ValueTree projectRoot;
+    ProjectBuildInfo lastBuild;
+
+    // Most changes to the project tree (e.g. GUI state or exporter settings) don't
+    // alter anything that the compiler uses, so the engine is only asked to rescan
+    // everything when the build info really differs from what it was last sent
+    void sendNewBuildIfChanged (const ProjectBuildInfo& build, bool forceRebuild)
+    {
+        if (! forceRebuild && build.tree.isEquivalentTo (lastBuild.tree))
+            return;
+
+        lastBuild = build;
+        MessageTypes::sendNewBuild (*server, build);
+    }
 
     void projectStructureChanged()
     {
@@ -569,6 +589,7 @@ CompileEngineChildProcess::CompileEngineChildProcess (Project& p)
 {
     ProjucerApplication::getApp().openDocumentManager.addListener (this);
 
+    loadCachedClassList();
     createProcess();
 
     errorList.setWarningsEnabled (! LiveBuildProjectSettings::areWarningsDisabled (project));
@@ -579,9 +600,37 @@ CompileEngineChildProcess::~CompileEngineChildProcess()
     ProjucerApplication::getApp().openDocumentManager.removeListener (this);
 
     process = nullptr;
+
+    saveCachedClassList();
     lastComponentList.clear();
 }
 
+void CompileEngineChildProcess::loadCachedClassList()
+{
+    FileInputStream in (ProjectProperties::getClassListCacheFile (project));
+
+    if (in.openedOk())
+    {
+        auto classList = ValueTree::readFromStream (in);
+
+        if (classList.isValid())
+            handleClassListChanged (classList);
+    }
+}
+
+void CompileEngineChildProcess::saveCachedClassList() const
+{
+    auto file = ProjectProperties::getClassListCacheFile (project);
+
+    // if the cache has been cleaned, leave it empty
+    if (! file.getParentDirectory().isDirectory())
+        return;
+
+    MemoryOutputStream out;
+    lastComponentList.toValueTree().writeToStream (out);
+    file.replaceWithData (out.getData(), out.getDataSize());
+}
+
 void CompileEngineChildProcess::createProcess()
 {
     jassert (process == nullptr);
@@ -98,6 +98,9 @@ private:
     OwnedArray<Editor> editors;
     void updateAllEditors();
 
+    void loadCachedClassList();
+    void saveCachedClassList() const;
+
     void createProcess();
     Editor* getOrOpenEditorFor (const File&);
     ProjectContentComponent* findProjectContentComponent() const;
@@ -44,6 +44,166 @@ void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
     dispatcher.addToQueue (event);
 }
 
+void ThreadedAnalyticsDestination::setAdaptiveBatchSize (bool shouldAdaptBatchSize)
+{
+    dispatcher.adaptiveBatchSize = shouldAdaptBatchSize ? 1 : 0;
+}
+
+void ThreadedAnalyticsDestination::setUnloggedEventsFile (const File& file)
+{
+    // This must be set before the analytics thread starts!
+    jassert (! dispatcher.isThreadRunning());
+
+    dispatcher.unloggedEventsFile = file;
+}
+
+void ThreadedAnalyticsDestination::saveUnloggedEvents (const std::deque<AnalyticsEvent>&) {}
+void ThreadedAnalyticsDestination::restoreUnloggedEvents (std::deque<AnalyticsEvent>&) {}
+
+//==============================================================================
+namespace AnalyticsEventEncoding
+{
+    enum
+    {
+        magicNumber = 0x3145414a, // "JAE1"
+        compressedFlag = 1
+    };
+
+    static void writeStringPairs (OutputStream& out, const StringPairArray& pairs)
+    {
+        auto& keys = pairs.getAllKeys();
+        auto& values = pairs.getAllValues();
+
+        out.writeCompressedInt (keys.size());
+
+        for (int i = 0; i < keys.size(); ++i)
+        {
+            out.writeString (keys[i]);
+            out.writeString (values[i]);
+        }
+    }
+
+    static bool readStringPairs (InputStream& in, StringPairArray& pairs)
+    {
+        auto numPairs = in.readCompressedInt();
+
+        if (numPairs < 0)
+            return false;
+
+        for (int i = 0; i < numPairs; ++i)
+        {
+            if (in.isExhausted())
+                return false;
+
+            auto key = in.readString();
+            pairs.set (key, in.readString());
+        }
+
+        return true;
+    }
+
+    static void writeEvents (OutputStream& out, const Array<AnalyticsDestination::AnalyticsEvent>& events)
+    {
+        out.writeCompressedInt (events.size());
+
+        for (auto& event : events)
+        {
+            out.writeString (event.name);
+            out.writeInt ((int) event.timestamp);
+            writeStringPairs (out, event.parameters);
+            out.writeString (event.userID);
+            writeStringPairs (out, event.userProperties);
+        }
+    }
+
+    static bool readEvents (InputStream& in, Array<AnalyticsDestination::AnalyticsEvent>& events)
+    {
+        auto numEvents = in.readCompressedInt();
+
+        if (numEvents < 0)
+            return false;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            if (in.isExhausted())
+                return false;
+
+            AnalyticsDestination::AnalyticsEvent event;
+            event.name = in.readString();
+            event.timestamp = (uint32) in.readInt();
+
+            if (! readStringPairs (in, event.parameters))
+                return false;
+
+            event.userID = in.readString();
+
+            if (! readStringPairs (in, event.userProperties))
+                return false;
+
+            events.add (event);
+        }
+
+        return true;
+    }
+}
+
+MemoryBlock ThreadedAnalyticsDestination::encodeEvents (const Array<AnalyticsEvent>& events, bool compress)
+{
+    MemoryOutputStream out;
+    out.writeInt (AnalyticsEventEncoding::magicNumber);
+    out.writeByte (compress ? (char) AnalyticsEventEncoding::compressedFlag : 0);
+
+    if (compress)
+    {
+        GZIPCompressorOutputStream zipper (&out);
+        AnalyticsEventEncoding::writeEvents (zipper, events);
+    }
+    else
+    {
+        AnalyticsEventEncoding::writeEvents (out, events);
+    }
+
+    return out.getMemoryBlock();
+}
+
+bool ThreadedAnalyticsDestination::decodeEvents (const void* data, size_t dataSize, Array<AnalyticsEvent>& events)
+{
+    MemoryInputStream in (data, dataSize, false);
+
+    if (dataSize < 5 || in.readInt() != AnalyticsEventEncoding::magicNumber)
+        return false;
+
+    Array<AnalyticsEvent> newEvents;
+    bool ok;
+
+    if ((in.readByte() & AnalyticsEventEncoding::compressedFlag) != 0)
+    {
+        GZIPDecompressorInputStream unzipper (in);
+        ok = AnalyticsEventEncoding::readEvents (unzipper, newEvents);
+    }
+    else
+    {
+        ok = AnalyticsEventEncoding::readEvents (in, newEvents);
+    }
+
+    if (ok)
+        events.addArray (newEvents);
+
+    return ok;
+}
+
+MemoryBlock ThreadedAnalyticsDestination::compressWithGZIP (const void* data, size_t dataSize)
+{
+    MemoryOutputStream out;
+
+    {
+        GZIPCompressorOutputStream zipper (&out, -1, false, GZIPCompressorOutputStream::windowBitsGZIP);
+        zipper.write (data, dataSize);
+    }
+
+    return out.getMemoryBlock();
+}
+
 void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodMilliseconds)
 {
     setBatchPeriod (initialBatchPeriodMilliseconds);
@@ -55,9 +215,7 @@ void ThreadedAnalyticsDestination::stopAnalyticsThread (int timeout)
     dispatcher.signalThreadShouldExit();
     stopLoggingEvents();
     dispatcher.stopThread (timeout);
-
-    if (dispatcher.eventQueue.size() > 0)
-        saveUnloggedEvents (dispatcher.eventQueue);
+    dispatcher.saveEvents();
 }
 
 ThreadedAnalyticsDestination::EventDispatcher::EventDispatcher (const String& threadName,
@@ -66,26 +224,86 @@ ThreadedAnalyticsDestination::EventDispatcher::EventDispatcher (const String& th
       parent (destination)
 {}
 
-void ThreadedAnalyticsDestination::EventDispatcher::run()
+void ThreadedAnalyticsDestination::EventDispatcher::restoreEvents()
 {
+    std::deque<AnalyticsEvent> restoredEventQueue;
+
+    if (unloggedEventsFile == File())
+    {
+        parent.restoreUnloggedEvents (restoredEventQueue);
+    }
+    else if (unloggedEventsFile.existsAsFile())
+    {
+        Array<AnalyticsEvent> restoredEvents;
+
+        {
+            MemoryMappedFile mappedFile (unloggedEventsFile, MemoryMappedFile::readOnly);
+
+            if (mappedFile.getData() != nullptr)
+                ThreadedAnalyticsDestination::decodeEvents (mappedFile.getData(), mappedFile.getSize(), restoredEvents);
+        }
+
+        unloggedEventsFile.deleteFile();
+        restoredEventQueue.insert (restoredEventQueue.end(), restoredEvents.begin(), restoredEvents.end());
+    }
+
     // We may have inserted some events into the queue (on the message thread)
     // before this thread has started, so make sure the old events are at the
     // front of the queue.
-    {
-        std::deque<AnalyticsEvent> restoredEventQueue;
-        parent.restoreUnloggedEvents (restoredEventQueue);
+    const ScopedLock lock (queueAccess);
+
+    for (auto rit = restoredEventQueue.rbegin(); rit != restoredEventQueue.rend(); ++rit)
+        eventQueue.push_front (*rit);
+}
 
-        const ScopedLock lock (queueAccess);
+void ThreadedAnalyticsDestination::EventDispatcher::saveEvents()
+{
+    if (eventQueue.size() == 0)
+        return;
 
-        for (auto rit = restoredEventQueue.rbegin(); rit != restoredEventQueue.rend(); ++rit)
-            eventQueue.push_front (*rit);
+    if (unloggedEventsFile == File())
+    {
+        parent.saveUnloggedEvents (eventQueue);
+        return;
     }
 
+    Array<AnalyticsEvent> eventsToSave;
+    eventsToSave.ensureStorageAllocated ((int) eventQueue.size());
+
+    for (auto& event : eventQueue)
+        eventsToSave.add (event);
+
+    // written to a temporary file first, so that an interrupted write can't leave a corrupt one
+    TemporaryFile tempFile (unloggedEventsFile);
+    auto data = ThreadedAnalyticsDestination::encodeEvents (eventsToSave, false);
+
+    if (tempFile.getFile().replaceWithData (data.getData(), data.getSize()))
+        tempFile.overwriteTargetFileWithTemporary();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::updateBatchSize (bool eventsWereLogged, uint32 timeTaken,
+                                                                     int maxBatchSize) noexcept
+{
+    const auto period = (uint32) jmax (1, batchPeriodMilliseconds.get());
+
+    if (! eventsWereLogged || timeTaken > period)
+        currentBatchSize = jmax (1, currentBatchSize / 2);
+    else if (timeTaken < period / 4)
+        currentBatchSize = jmin (maxBatchSize, currentBatchSize * 2);
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::run()
+{
+    restoreEvents();
+
     const int maxBatchSize = parent.getMaximumBatchSize();
+    currentBatchSize = maxBatchSize;
 
     while (! threadShouldExit())
     {
-        auto eventsToSendCapacity = maxBatchSize - eventsToSend.size();
+        const bool isAdaptive = (adaptiveBatchSize.get() != 0);
+        const int batchSize = isAdaptive ? currentBatchSize : maxBatchSize;
+        auto eventsToSendCapacity = batchSize - eventsToSend.size();
 
         if (eventsToSendCapacity > 0)
         {
@@ -103,10 +321,13 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
         }
 
         const auto submissionTime = Time::getMillisecondCounter();
+        bool sendNextBatchNow = false;
 
         if (! eventsToSend.isEmpty())
         {
-            if (parent.logBatchedEvents (eventsToSend))
+            const bool eventsWereLogged = parent.logBatchedEvents (eventsToSend);
+
+            if (eventsWereLogged)
             {
                 const ScopedLock lock (queueAccess);
 
@@ -115,8 +336,27 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
 
                 eventsToSend.clearQuick();
             }
+
+            if (isAdaptive)
+            {
+                updateBatchSize (eventsWereLogged, Time::getMillisecondCounter() - submissionTime, maxBatchSize);
+
+                if (eventsWereLogged)
+                {
+                    const ScopedLock lock (queueAccess);
+                    sendNextBatchNow = ((int) eventQueue.size() >= currentBatchSize);
+                }
+                else if (eventsToSend.size() > currentBatchSize)
+                {
+                    // the events are the front of the queue, so fewer of them can be retried
+                    eventsToSend.removeRange (currentBatchSize, eventsToSend.size() - currentBatchSize);
+                }
+            }
         }
 
+        if (sendNextBatchNow)
+            continue;
+
         while (Time::getMillisecondCounter() - submissionTime < (uint32) batchPeriodMilliseconds.get())
         {
             if (threadShouldExit())
@@ -173,9 +413,11 @@ namespace DestinationTestHelpers
     struct BasicDestination   : public TestDestination
     {
         BasicDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                          std::deque<AnalyticsEvent>& unloggedEvents)
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          const File& unloggedEventsFile = File())
             : TestDestination (loggedEvents, unloggedEvents)
         {
+            setUnloggedEventsFile (unloggedEventsFile);
             startAnalyticsThread (100);
         }
 
@@ -202,9 +444,11 @@ namespace DestinationTestHelpers
     struct SlowWebDestination   : public TestDestination
     {
         SlowWebDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                            std::deque<AnalyticsEvent>& unloggedEvents)
+                            std::deque<AnalyticsEvent>& unloggedEvents,
+                            const File& unloggedEventsFile = File())
             : TestDestination (loggedEvents, unloggedEvents)
         {
+            setUnloggedEventsFile (unloggedEventsFile);
             startAnalyticsThread (initialPeriod);
         }
 
@@ -270,6 +514,47 @@ namespace DestinationTestHelpers
 
         WaitableEvent threadHasStarted;
     };
+
+    //==============================================================================
+    struct FlakyDestination   : public TestDestination
+    {
+        FlakyDestination (std::deque<AnalyticsEvent>& loggedEvents,
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          int numFailuresToUse)
+            : TestDestination (loggedEvents, unloggedEvents),
+              numFailures (numFailuresToUse)
+        {
+            setAdaptiveBatchSize (true);
+        }
+
+        void start()
+        {
+            startAnalyticsThread (10);
+        }
+
+        virtual ~FlakyDestination()
+        {
+            stopAnalyticsThread (1000);
+        }
+
+        bool logBatchedEvents (const Array<AnalyticsEvent>& events) override
+        {
+            batchSizes.add (events.size());
+
+            if (batchSizes.size() <= numFailures)
+                return false;
+
+            for (auto& event : events)
+                loggedEventQueue.push_back (event);
+
+            return true;
+        }
+
+        void stopLoggingEvents() override {}
+
+        const int numFailures;
+        Array<int> batchSizes;
+    };
 }
 
 //==============================================================================
@@ -299,6 +584,9 @@ struct ThreadedAnalyticsDestinationTests   : public UnitTest
         for (int i = 0; i < 7; ++i)
             testEvents.push_back ({ String (i), Time::getMillisecondCounter(), {}, "TestUser", {} });
 
+        testEvents[3].parameters.set ("key", "value");
+        testEvents[3].userProperties.set ("property", String (CharPointer_UTF8 ("\xe2\x82\xac")));
+
         std::deque<AnalyticsDestination::AnalyticsEvent> loggedEvents, unloggedEvents;
 
         beginTest ("Basic");
@@ -340,6 +628,88 @@ struct ThreadedAnalyticsDestinationTests   : public UnitTest
 
             unloggedEvents.clear();
         }
+
+        beginTest ("Binary encoding");
+        {
+            Array<AnalyticsDestination::AnalyticsEvent> events, decodedEvents;
+
+            for (auto& event : testEvents)
+                events.add (event);
+
+            for (auto compress : { false, true })
+            {
+                auto data = ThreadedAnalyticsDestination::encodeEvents (events, compress);
+                decodedEvents.clear();
+
+                expect (ThreadedAnalyticsDestination::decodeEvents (data.getData(), data.getSize(), decodedEvents));
+                expectEquals (decodedEvents.size(), events.size());
+
+                for (int i = 0; i < events.size(); ++i)
+                {
+                    expectEquals (decodedEvents[i].name, events[i].name);
+                    expect (decodedEvents[i].timestamp == events[i].timestamp);
+                    expect (decodedEvents[i].parameters == events[i].parameters);
+                    expectEquals (decodedEvents[i].userID, events[i].userID);
+                    expect (decodedEvents[i].userProperties == events[i].userProperties);
+                }
+
+                data.setSize (data.getSize() / 2);
+                decodedEvents.clear();
+                expect (! ThreadedAnalyticsDestination::decodeEvents (data.getData(), data.getSize(), decodedEvents));
+                expect (decodedEvents.isEmpty());
+            }
+        }
+
+        beginTest ("Unlogged events file");
+        {
+            const File file (File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("analytics", ".bin"));
+
+            {
+                DestinationTestHelpers::SlowWebDestination destination (loggedEvents, unloggedEvents, file);
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+            }
+
+            expect (file.existsAsFile());
+            expect (unloggedEvents.size() == 0);
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, file);
+                Thread::sleep (400);
+            }
+
+            compareEventQueues (loggedEvents, testEvents);
+            expect (! file.exists());
+
+            loggedEvents.clear();
+        }
+
+        beginTest ("Adaptive batch size");
+        {
+            {
+                DestinationTestHelpers::FlakyDestination destination (loggedEvents, unloggedEvents, 2);
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+
+                destination.start();
+                Thread::sleep (1000);
+
+                // halved after each failure, then doubled again after each quick success
+                const int expectedSizes[] = { 5, 2, 1, 2, 4 };
+
+                expect (destination.batchSizes.size() >= numElementsInArray (expectedSizes));
+
+                for (int i = 0; i < numElementsInArray (expectedSizes); ++i)
+                    expectEquals (destination.batchSizes[i], expectedSizes[i]);
+            }
+
+            compareEventQueues (loggedEvents, testEvents);
+            expect (unloggedEvents.size() == 0);
+
+            loggedEvents.clear();
+        }
     }
 };
 
@@ -75,7 +75,11 @@ public:
         contain the same events as previous call, plus any new events that have been
         generated in the period between calls. The order of events will not be
         changed. This allows you to retry logging events until they are logged
-        successfully.
+        successfully. If setAdaptiveBatchSize has been enabled then the retry may
+        contain only the first of those events.
+
+        The encodeEvents and compressWithGZIP methods can be used to make the data
+        that you upload smaller.
 
         @param events        a list of events to be logged
         @returns             if the events were successfully logged
@@ -123,6 +127,56 @@ public:
     */
     void logEvent (const AnalyticsEvent& event) override final;
 
+    /**
+        Makes the number of events given to each logBatchedEvents call follow the
+        speed of the connection.
+
+        When this is enabled, a batch is halved after logBatchedEvents fails or takes
+        longer than the batch period, and doubled (up to getMaximumBatchSize) after it
+        succeeds in less than a quarter of the period. While calls are succeeding and a
+        full batch of events is waiting, the next call is made straight away
+        instead of after the batch period.
+
+        This method is thread safe.
+    */
+    void setAdaptiveBatchSize (bool shouldAdaptBatchSize);
+
+    /**
+        Makes the destination keep any events that couldn't be logged in a file,
+        instead of calling saveUnloggedEvents and restoreUnloggedEvents.
+
+        When the analytics thread stops, the unlogged events are written to the file
+        in the format used by encodeEvents. When it next starts, the file is
+        memory-mapped, its events are put at the front of the queue, and it's deleted.
+
+        This must be called before startAnalyticsThread. Pass File() to go back to
+        using saveUnloggedEvents and restoreUnloggedEvents.
+    */
+    void setUnloggedEventsFile (const File& file);
+
+    //==============================================================================
+    /**
+        Writes a list of events in a compact binary format, which can be read back
+        with decodeEvents.
+
+        This is typically several times smaller than the same events as JSON or XML,
+        and smaller still if it's compressed.
+    */
+    static MemoryBlock encodeEvents (const Array<AnalyticsEvent>& events, bool compress = true);
+
+    /**
+        Reads events that were written by encodeEvents, adding them to the end of a list.
+
+        @returns false if the data isn't valid, in which case no events are added
+    */
+    static bool decodeEvents (const void* data, size_t dataSize, Array<AnalyticsEvent>& events);
+
+    /**
+        Compresses some data in the gzip format, e.g. for uploading a batch of events
+        with a "Content-Encoding: gzip" header.
+    */
+    static MemoryBlock compressWithGZIP (const void* data, size_t dataSize);
+
 protected:
     //==============================================================================
     /**
@@ -166,9 +220,11 @@ private:
 
         @param eventsToSave                  the events that could not be logged
 
-        @see stopAnalyticsThread, stopLoggingEvents, restoreUnloggedEvents
+        The default implementation does nothing.
+
+        @see stopAnalyticsThread, stopLoggingEvents, restoreUnloggedEvents, setUnloggedEventsFile
     */
-    virtual void saveUnloggedEvents (const std::deque<AnalyticsEvent>& eventsToSave) = 0;
+    virtual void saveUnloggedEvents (const std::deque<AnalyticsEvent>& eventsToSave);
 
     /**
         The counterpart to saveUnloggedEvents.
@@ -178,13 +234,14 @@ private:
         restore any unlogged events previously stored in a call to
         saveUnloggedEvents.
 
-        This method is called on the analytics thread.
+        This method is called on the analytics thread. The default implementation
+        does nothing.
 
         @param restoredEventQueue          place restored events into this queue
 
-        @see saveUnloggedEvents
+        @see saveUnloggedEvents, setUnloggedEventsFile
     */
-    virtual void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue) = 0;
+    virtual void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue);
 
     struct EventDispatcher   : public Thread
     {
@@ -192,6 +249,9 @@ private:
 
         void run() override;
         void addToQueue (const AnalyticsEvent&);
+        void restoreEvents();
+        void saveEvents();
+        void updateBatchSize (bool eventsWereLogged, uint32 timeTaken, int maxBatchSize) noexcept;
 
         ThreadedAnalyticsDestination& parent;
 
@@ -199,8 +259,11 @@ private:
         CriticalSection queueAccess;
 
         Atomic<int> batchPeriodMilliseconds { 1000 };
+        Atomic<int> adaptiveBatchSize { 0 };
+        int currentBatchSize = 0;
 
         Array<AnalyticsEvent> eventsToSend;
+        File unloggedEventsFile;
     };
 
     const String destinationName;
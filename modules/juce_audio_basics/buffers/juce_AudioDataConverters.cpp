@@ -472,6 +472,527 @@ void AudioDataConverters::deinterleaveSamples (const float* const source,
 }
 
 
+//==============================================================================
+namespace AudioDataVectorHelpers
+{
+    // Each format reads a sample as a signed integer in the range of its own bit depth,
+    // which is then scaled to or from the float range.
+    template <bool bigEndian>
+    struct Int16Format
+    {
+        enum { bytesPerSample = 2, maxValue = 0x7fff, needsSwap = (bigEndian != (bool) AudioData::NativeEndian::isBigEndian) };
+
+        static inline int32 read (const char* p) noexcept
+        {
+            auto v = *reinterpret_cast<const uint16*> (p);
+            return (int16) (needsSwap ? ByteOrder::swap (v) : v);
+        }
+
+        static inline void write (char* p, int32 v) noexcept
+        {
+            *reinterpret_cast<uint16*> (p) = needsSwap ? ByteOrder::swap ((uint16) v) : (uint16) v;
+        }
+    };
+
+    template <bool bigEndian>
+    struct Int24Format
+    {
+        enum { bytesPerSample = 3, maxValue = 0x7fffff, needsSwap = 0 };
+
+        static inline int32 read (const char* p) noexcept           { return bigEndian ? ByteOrder::bigEndian24Bit (p) : ByteOrder::littleEndian24Bit (p); }
+        static inline void write (char* p, int32 v) noexcept        { if (bigEndian) ByteOrder::bigEndian24BitToChars (v, p); else ByteOrder::littleEndian24BitToChars (v, p); }
+    };
+
+    template <bool bigEndian, int maximum>
+    struct Int32Format
+    {
+        enum { bytesPerSample = 4, maxValue = maximum, needsSwap = (bigEndian != (bool) AudioData::NativeEndian::isBigEndian) };
+
+        static inline int32 read (const char* p) noexcept
+        {
+            auto v = *reinterpret_cast<const uint32*> (p);
+            return (int32) (needsSwap ? ByteOrder::swap (v) : v);
+        }
+
+        static inline void write (char* p, int32 v) noexcept
+        {
+            *reinterpret_cast<uint32*> (p) = needsSwap ? ByteOrder::swap ((uint32) v) : (uint32) v;
+        }
+    };
+
+    // The integers are divided by (maxValue + 1), which is a power of two, so it makes no
+    // difference whether this is done in single or double precision.
+    template <class Format>
+    static inline float getScale() noexcept     { return (float) (1.0 / (1.0 + Format::maxValue)); }
+
+    template <class Format>
+    static inline float intToFloat (int32 v) noexcept
+    {
+        return (float) v * getScale<Format>();
+    }
+
+    // 16 and 24-bit values are rounded to the nearest integer, and the full-width formats
+    // are truncated, in the same way as the AudioData format classes do it.
+    template <class Format>
+    static inline int32 floatToInt (float v) noexcept
+    {
+        if (Format::bytesPerSample == 4)
+            return (int32) (uint32) (int64) (Format::maxValue * jlimit (-1.0, 1.0, (double) v));
+
+        return jlimit ((int) -Format::maxValue, (int) Format::maxValue, roundToInt (v * (1.0 + Format::maxValue)));
+    }
+
+   #if JUCE_USE_SSE_INTRINSICS
+    static inline __m128i swapBytes16 (__m128i v) noexcept
+    {
+        return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+    }
+
+    static inline __m128i swapBytes32 (__m128i v) noexcept
+    {
+        v = swapBytes16 (v);
+        return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1)), _MM_SHUFFLE (2, 3, 0, 1));
+    }
+
+    template <class Format>
+    static inline __m128i load4 (const char* p, int stride) noexcept
+    {
+        if (stride == 1)
+        {
+            if (Format::bytesPerSample == 2)
+            {
+                auto v = _mm_loadl_epi64 (reinterpret_cast<const __m128i*> (p));
+
+                if (Format::needsSwap)
+                    v = swapBytes16 (v);
+
+                return _mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16);
+            }
+
+            if (Format::bytesPerSample == 4)
+            {
+                auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+                return Format::needsSwap ? swapBytes32 (v) : v;
+            }
+        }
+
+        const int step = stride * Format::bytesPerSample;
+        return _mm_setr_epi32 (Format::read (p), Format::read (p + step), Format::read (p + 2 * step), Format::read (p + 3 * step));
+    }
+
+    template <class Format>
+    static inline void store4 (char* p, int stride, __m128i v) noexcept
+    {
+        if (stride == 1)
+        {
+            if (Format::bytesPerSample == 2)
+            {
+                v = _mm_packs_epi32 (v, v);
+                _mm_storel_epi64 (reinterpret_cast<__m128i*> (p), Format::needsSwap ? swapBytes16 (v) : v);
+                return;
+            }
+
+            if (Format::bytesPerSample == 4)
+            {
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (p), Format::needsSwap ? swapBytes32 (v) : v);
+                return;
+            }
+        }
+
+        int32 values[4];
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (values), v);
+
+        const int step = stride * Format::bytesPerSample;
+
+        for (int i = 0; i < 4; ++i)
+            Format::write (p + i * step, values[i]);
+    }
+
+    template <class Format>
+    static inline __m128i floatToInt4 (__m128 v) noexcept
+    {
+        if (Format::bytesPerSample == 4)
+        {
+            const auto one = _mm_set1_pd (1.0), minusOne = _mm_set1_pd (-1.0), scale = _mm_set1_pd ((double) Format::maxValue);
+
+            auto lo = _mm_mul_pd (_mm_max_pd (minusOne, _mm_min_pd (one, _mm_cvtps_pd (v))), scale);
+            auto hi = _mm_mul_pd (_mm_max_pd (minusOne, _mm_min_pd (one, _mm_cvtps_pd (_mm_movehl_ps (v, v)))), scale);
+
+            return _mm_unpacklo_epi64 (_mm_cvttpd_epi32 (lo), _mm_cvttpd_epi32 (hi));
+        }
+
+        // scaling by a power of two is exact, so clamping to the integer range before rounding
+        // gives the same answer as clamping afterwards
+        const auto limit = _mm_set1_ps ((float) Format::maxValue);
+        auto scaled = _mm_mul_ps (v, _mm_set1_ps ((float) (1.0 + Format::maxValue)));
+
+        return _mm_cvtps_epi32 (_mm_max_ps (_mm_sub_ps (_mm_setzero_ps(), limit), _mm_min_ps (limit, scaled)));
+    }
+   #endif
+
+    template <class Format>
+    static void convertToFloat (const void* source, int sourceStride, float* dest, int destStride, int numSamples) noexcept
+    {
+        auto* src = static_cast<const char*> (source);
+        const int sourceStep = sourceStride * Format::bytesPerSample;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto scale = _mm_set1_ps (getScale<Format>());
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            auto v = _mm_mul_ps (_mm_cvtepi32_ps (load4<Format> (src, sourceStride)), scale);
+
+            if (destStride == 1)
+            {
+                _mm_storeu_ps (dest, v);
+            }
+            else
+            {
+                float values[4];
+                _mm_storeu_ps (values, v);
+
+                for (int j = 0; j < 4; ++j)
+                    dest[j * destStride] = values[j];
+            }
+
+            src += 4 * sourceStep;
+            dest += 4 * destStride;
+        }
+       #elif JUCE_USE_ARM_NEON
+        const auto scale = getScale<Format>();
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            int32 ints[4];
+
+            for (int j = 0; j < 4; ++j)
+                ints[j] = Format::read (src + j * sourceStep);
+
+            auto v = vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (ints)), scale);
+
+            if (destStride == 1)
+            {
+                vst1q_f32 (dest, v);
+            }
+            else
+            {
+                float values[4];
+                vst1q_f32 (values, v);
+
+                for (int j = 0; j < 4; ++j)
+                    dest[j * destStride] = values[j];
+            }
+
+            src += 4 * sourceStep;
+            dest += 4 * destStride;
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+        {
+            *dest = intToFloat<Format> (Format::read (src));
+            src += sourceStep;
+            dest += destStride;
+        }
+    }
+
+    template <class Format>
+    static void convertFromFloat (const float* source, int sourceStride, void* dest, int destStride, int numSamples) noexcept
+    {
+        auto* dst = static_cast<char*> (dest);
+        const int destStep = destStride * Format::bytesPerSample;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            auto v = sourceStride == 1 ? _mm_loadu_ps (source)
+                                       : _mm_setr_ps (source[0], source[sourceStride], source[2 * sourceStride], source[3 * sourceStride]);
+
+            store4<Format> (dst, destStride, floatToInt4<Format> (v));
+
+            source += 4 * sourceStride;
+            dst += 4 * destStep;
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+        {
+            Format::write (dst, floatToInt<Format> (*source));
+            source += sourceStride;
+            dst += destStep;
+        }
+    }
+
+    template <template <bool> class Format>
+    static void convertToFloat (bool bigEndian, const void* source, int sourceStride, float* dest, int destStride, int numSamples) noexcept
+    {
+        if (bigEndian)  convertToFloat<Format<true>>  (source, sourceStride, dest, destStride, numSamples);
+        else            convertToFloat<Format<false>> (source, sourceStride, dest, destStride, numSamples);
+    }
+
+    template <template <bool> class Format>
+    static void convertFromFloat (bool bigEndian, const float* source, int sourceStride, void* dest, int destStride, int numSamples) noexcept
+    {
+        if (bigEndian)  convertFromFloat<Format<true>>  (source, sourceStride, dest, destStride, numSamples);
+        else            convertFromFloat<Format<false>> (source, sourceStride, dest, destStride, numSamples);
+    }
+
+    template <bool bigEndian> using Int24in32Format  = Int32Format<bigEndian, 0x7fffff>;
+    template <bool bigEndian> using FullInt32Format  = Int32Format<bigEndian, 0x7fffffff>;
+
+    //==============================================================================
+    // These scan several samples at a time and fold the lanes together at the end. The integers
+    // are compared in their own range and only the two results are scaled to floats, which gives
+    // the same answer as scaling every sample because the scale is a power of two.
+   #if JUCE_USE_SSE_INTRINSICS
+    // (SSE2 only has min and max instructions for 16-bit integers)
+    static inline __m128i min4 (__m128i a, __m128i b) noexcept
+    {
+        auto aIsLower = _mm_cmplt_epi32 (a, b);
+        return _mm_or_si128 (_mm_and_si128 (aIsLower, a), _mm_andnot_si128 (aIsLower, b));
+    }
+
+    static inline __m128i max4 (__m128i a, __m128i b) noexcept
+    {
+        auto aIsHigher = _mm_cmpgt_epi32 (a, b);
+        return _mm_or_si128 (_mm_and_si128 (aIsHigher, a), _mm_andnot_si128 (aIsHigher, b));
+    }
+
+    // SSE2 can compare eight 16-bit integers at once, so these are scanned whole registers at a time,
+    // even when they're interleaved, and only the lanes that belong to this channel are looked at
+    // once it's finished. That works when the stride divides the number of lanes, as long as the
+    // last load doesn't go past the final sample.
+    template <class Format>
+    static int scanInt16Registers (const char* src, int stride, int numSamples, int32& lowest, int32& highest) noexcept
+    {
+        if (8 % stride != 0)
+            return 0;
+
+        const int samplesPerLoad = 8 / stride;
+        const int end = stride == 1 ? numSamples : numSamples - 1;
+
+        if (end < 2 * samplesPerLoad)
+            return 0;
+
+        auto load = [] (const char* p)
+        {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+            return Format::needsSwap ? swapBytes16 (v) : v;
+        };
+
+        auto mn = load (src), mx = mn;
+        int i = samplesPerLoad;
+
+        for (; i + samplesPerLoad <= end; i += samplesPerLoad)
+        {
+            auto v = load (src + i * stride * 2);
+            mn = _mm_min_epi16 (mn, v);
+            mx = _mm_max_epi16 (mx, v);
+        }
+
+        int16 mins[8], maxs[8];
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (mins), mn);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (maxs), mx);
+
+        for (int j = 0; j < 8; j += stride)
+        {
+            lowest  = jmin (lowest,  (int32) mins[j]);
+            highest = jmax (highest, (int32) maxs[j]);
+        }
+
+        return i;
+    }
+   #endif
+
+    template <class Format>
+    static Range<float> findMinAndMax (const void* source, int sourceStride, int numSamples) noexcept
+    {
+        auto* src = static_cast<const char*> (source);
+        const int sourceStep = sourceStride * Format::bytesPerSample;
+        int32 lowest = Format::read (src), highest = lowest;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        if (Format::bytesPerSample == 2)
+            i = scanInt16Registers<Format> (src, sourceStride, numSamples, lowest, highest);
+
+        if (i == 0 && numSamples >= 8)
+        {
+            auto mn = load4<Format> (src, sourceStride), mx = mn;
+
+            for (i = 4; i + 4 <= numSamples; i += 4)
+            {
+                auto v = load4<Format> (src + i * sourceStep, sourceStride);
+                mn = min4 (mn, v);
+                mx = max4 (mx, v);
+            }
+
+            int32 mins[4], maxs[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (mins), mn);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (maxs), mx);
+
+            for (int j = 0; j < 4; ++j)
+            {
+                lowest  = jmin (lowest,  mins[j]);
+                highest = jmax (highest, maxs[j]);
+            }
+        }
+       #elif JUCE_USE_ARM_NEON
+        if (numSamples >= 8)
+        {
+            auto load4 = [src, sourceStep] (int index)
+            {
+                int32 ints[4];
+
+                for (int j = 0; j < 4; ++j)
+                    ints[j] = Format::read (src + (index + j) * sourceStep);
+
+                return vld1q_s32 (ints);
+            };
+
+            auto mn = load4 (0), mx = mn;
+
+            for (i = 4; i + 4 <= numSamples; i += 4)
+            {
+                auto v = load4 (i);
+                mn = vminq_s32 (mn, v);
+                mx = vmaxq_s32 (mx, v);
+            }
+
+            int32 mins[4], maxs[4];
+            vst1q_s32 (mins, mn);
+            vst1q_s32 (maxs, mx);
+
+            for (int j = 0; j < 4; ++j)
+            {
+                lowest  = jmin (lowest,  mins[j]);
+                highest = jmax (highest, maxs[j]);
+            }
+        }
+       #endif
+
+        for (src += i * sourceStep; i < numSamples; ++i)
+        {
+            auto v = Format::read (src);
+            lowest  = jmin (lowest, v);
+            highest = jmax (highest, v);
+            src += sourceStep;
+        }
+
+        return { intToFloat<Format> (lowest), intToFloat<Format> (highest) };
+    }
+
+    template <template <bool> class Format>
+    static Range<float> findMinAndMax (bool bigEndian, const void* source, int sourceStride, int numSamples) noexcept
+    {
+        return bigEndian ? findMinAndMax<Format<true>>  (source, sourceStride, numSamples)
+                         : findMinAndMax<Format<false>> (source, sourceStride, numSamples);
+    }
+}
+
+void AudioData::convertIntToFloat (VectorisedFormat format, bool sourceIsBigEndian, const void* source, int sourceStride,
+                                   float* dest, int destStride, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    switch (format)
+    {
+        case vectorisedInt16:       convertToFloat<Int16Format>      (sourceIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt24:       convertToFloat<Int24Format>      (sourceIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt24in32:   convertToFloat<Int24in32Format>  (sourceIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt32:       convertToFloat<FullInt32Format>  (sourceIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case notVectorised:
+        default:                    jassertfalse; break;
+    }
+}
+
+void AudioData::convertFloatToInt (VectorisedFormat format, bool destIsBigEndian, const float* source, int sourceStride,
+                                   void* dest, int destStride, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    switch (format)
+    {
+        case vectorisedInt16:       convertFromFloat<Int16Format>     (destIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt24:       convertFromFloat<Int24Format>     (destIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt24in32:   convertFromFloat<Int24in32Format> (destIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case vectorisedInt32:       convertFromFloat<FullInt32Format> (destIsBigEndian, source, sourceStride, dest, destStride, numSamples); break;
+        case notVectorised:
+        default:                    jassertfalse; break;
+    }
+}
+
+Range<float> AudioData::findMinAndMaxOfInts (VectorisedFormat format, bool sourceIsBigEndian, const void* source,
+                                             int sourceStride, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    jassert (numSamples > 0);
+
+    switch (format)
+    {
+        case vectorisedInt16:       return AudioDataVectorHelpers::findMinAndMax<Int16Format>      (sourceIsBigEndian, source, sourceStride, numSamples);
+        case vectorisedInt24:       return AudioDataVectorHelpers::findMinAndMax<Int24Format>      (sourceIsBigEndian, source, sourceStride, numSamples);
+        case vectorisedInt24in32:   return AudioDataVectorHelpers::findMinAndMax<Int24in32Format>  (sourceIsBigEndian, source, sourceStride, numSamples);
+        case vectorisedInt32:       return AudioDataVectorHelpers::findMinAndMax<FullInt32Format>  (sourceIsBigEndian, source, sourceStride, numSamples);
+        case notVectorised:
+        default:                    jassertfalse; return {};
+    }
+}
+
+Range<float> AudioData::findMinAndMaxOfFloats (const float* source, int sourceStride, int numSamples) noexcept
+{
+    jassert (numSamples > 0);
+
+    if (sourceStride == 1)
+        return FloatVectorOperations::findMinAndMax (source, numSamples);
+
+    float lowest = source[0], highest = lowest;
+    int i = 0;
+
+   #if JUCE_USE_SSE_INTRINSICS
+    if (numSamples >= 8)
+    {
+        auto load4 = [source, sourceStride] (int index)
+        {
+            auto* p = source + index * sourceStride;
+            return _mm_setr_ps (p[0], p[sourceStride], p[2 * sourceStride], p[3 * sourceStride]);
+        };
+
+        auto mn = load4 (0), mx = mn;
+
+        for (i = 4; i + 4 <= numSamples; i += 4)
+        {
+            auto v = load4 (i);
+            mn = _mm_min_ps (mn, v);
+            mx = _mm_max_ps (mx, v);
+        }
+
+        float mins[4], maxs[4];
+        _mm_storeu_ps (mins, mn);
+        _mm_storeu_ps (maxs, mx);
+
+        for (int j = 0; j < 4; ++j)
+        {
+            lowest  = jmin (lowest,  mins[j]);
+            highest = jmax (highest, maxs[j]);
+        }
+    }
+   #endif
+
+    for (source += i * sourceStride; i < numSamples; ++i)
+    {
+        lowest  = jmin (lowest,  *source);
+        highest = jmax (highest, *source);
+        source += sourceStride;
+    }
+
+    return { lowest, highest };
+}
+
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
@@ -580,9 +1101,125 @@ public:
         }
     };
 
+    // Checks that the block conversions give exactly the same results as converting
+    // each sample on its own, with the integer data interleaved with other channels.
+    template <class F, class E>
+    struct VectorisedTest
+    {
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            for (auto numChannels : { 1, 2, 4, 8 })
+            {
+                const int numSamples = 1003;
+                const int channel = numChannels - 1;
+                HeapBlock<char> ints ((size_t) (numChannels * numSamples * 4 + 16), true), scalarInts ((size_t) (numChannels * numSamples * 4 + 16), true);
+                HeapBlock<float> floats ((size_t) numSamples), scalarFloats ((size_t) numSamples);
+
+                for (int i = 0; i < numChannels * numSamples * 4; ++i)
+                    ints[i] = (char) r.nextInt (256);
+
+                typedef AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::NonConst> IntPointer;
+                typedef AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst> FloatPointer;
+
+                AudioData::ConverterInstance<AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::Const>,
+                                             AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>> toFloat (numChannels, 1);
+                toFloat.convertSamples (floats, 0, ints, channel, numSamples);
+
+                IntPointer src (addBytesToPointer (ints.get(), channel * IntPointer::getBytesPerSample()), numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++src)
+                    scalarFloats[i] = src.getAsFloat();
+
+                unitTest.expect (memcmp (floats, scalarFloats, sizeof (float) * (size_t) numSamples) == 0);
+
+                for (int i = 0; i < numSamples; ++i)
+                    floats[i] = r.nextFloat() * 2.4f - 1.2f;
+
+                AudioData::ConverterInstance<AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>,
+                                             AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::NonConst>> fromFloat (1, numChannels);
+                fromFloat.convertSamples (ints, channel, floats, 0, numSamples);
+
+                memcpy (scalarInts, ints, (size_t) (numChannels * numSamples * 4));
+                IntPointer dest (addBytesToPointer (scalarInts.get(), channel * IntPointer::getBytesPerSample()), numChannels);
+                FloatPointer floatSrc (floats.get());
+
+                for (int i = 0; i < numSamples; ++i, ++dest, ++floatSrc)
+                    dest.setAsFloat (floatSrc.getAsFloat());
+
+                unitTest.expect (memcmp (ints, scalarInts, (size_t) (numChannels * numSamples * 4)) == 0);
+            }
+        }
+    };
+
+    template <class F>
+    static void testVectorised (UnitTest& unitTest, Random& r)
+    {
+        VectorisedTest<F, AudioData::LittleEndian>::test (unitTest, r);
+        VectorisedTest<F, AudioData::BigEndian>::test (unitTest, r);
+    }
+
+    // Checks that the block min/max scans find the same levels as a per-sample scan.
+    template <class F, class E>
+    struct MinMaxTest
+    {
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            for (auto numChannels : { 1, 2, 3, 8 })
+            {
+                for (auto numSamples : { 1, 7, 15, 16, 33, 1003 })
+                {
+                    typedef AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::NonConst> Pointer;
+
+                    const int channel = numChannels - 1;
+                    HeapBlock<char> data ((size_t) (numChannels * numSamples * 4 + 16), true);
+                    Pointer p (addBytesToPointer (data.get(), channel * Pointer::getBytesPerSample()), numChannels);
+
+                    Pointer d (p);
+
+                    for (int i = 0; i < numSamples; ++i, ++d)
+                    {
+                        if (Pointer::isFloatingPoint())
+                            d.setAsFloat (r.nextFloat() * 2.4f - 1.2f);
+                        else
+                            d.setAsInt32 (r.nextInt());
+                    }
+
+                    Pointer s (p);
+                    auto expected = Range<float>::emptyRange (s.getAsFloat());
+
+                    for (int i = 0; i < numSamples; ++i, ++s)
+                        expected = expected.getUnionWith (s.getAsFloat());
+
+                    auto result = p.findMinAndMax ((size_t) numSamples);
+                    unitTest.expect (result == expected);
+                }
+            }
+        }
+    };
+
+    template <class F>
+    static void testMinMax (UnitTest& unitTest, Random& r)
+    {
+        MinMaxTest<F, AudioData::LittleEndian>::test (unitTest, r);
+        MinMaxTest<F, AudioData::BigEndian>::test (unitTest, r);
+    }
+
     void runTest() override
     {
         Random r = getRandom();
+        beginTest ("Block conversion matches per-sample conversion");
+        testVectorised<AudioData::Int16> (*this, r);
+        testVectorised<AudioData::Int24> (*this, r);
+        testVectorised<AudioData::Int24in32> (*this, r);
+        testVectorised<AudioData::Int32> (*this, r);
+
+        beginTest ("Block min/max scans match per-sample scans");
+        testMinMax<AudioData::Int16> (*this, r);
+        testMinMax<AudioData::Int24> (*this, r);
+        testMinMax<AudioData::Int24in32> (*this, r);
+        testMinMax<AudioData::Int32> (*this, r);
+        testMinMax<AudioData::Float32> (*this, r);
+
         beginTest ("Round-trip conversion: Int8");
         Test1 <AudioData::Int8>::test (*this, r);
         beginTest ("Round-trip conversion: Int16");
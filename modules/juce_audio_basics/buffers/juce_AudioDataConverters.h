@@ -226,8 +226,8 @@ public:
 
         inline float getAsFloatLE() const noexcept              { return (float) ((1.0 / (1.0 + maxValue)) * (int32) ByteOrder::swapIfBigEndian (*data)); }
         inline float getAsFloatBE() const noexcept              { return (float) ((1.0 / (1.0 + maxValue)) * (int32) ByteOrder::swapIfLittleEndian (*data)); }
-        inline void setAsFloatLE (float newValue) noexcept      { *data = ByteOrder::swapIfBigEndian    ((uint32) (maxValue * jlimit (-1.0, 1.0, (double) newValue))); }
-        inline void setAsFloatBE (float newValue) noexcept      { *data = ByteOrder::swapIfLittleEndian ((uint32) (maxValue * jlimit (-1.0, 1.0, (double) newValue))); }
+        inline void setAsFloatLE (float newValue) noexcept      { *data = ByteOrder::swapIfBigEndian    ((uint32) (int32) (maxValue * jlimit (-1.0, 1.0, (double) newValue))); }
+        inline void setAsFloatBE (float newValue) noexcept      { *data = ByteOrder::swapIfLittleEndian ((uint32) (int32) (maxValue * jlimit (-1.0, 1.0, (double) newValue))); }
         inline int32 getAsInt32LE() const noexcept              { return (int32) ByteOrder::swapIfBigEndian    (*data) << 8; }
         inline int32 getAsInt32BE() const noexcept              { return (int32) ByteOrder::swapIfLittleEndian (*data) << 8; }
         inline void setAsInt32LE (int32 newValue) noexcept      { *data = ByteOrder::swapIfBigEndian    ((uint32) newValue >> 8); }
@@ -318,6 +318,38 @@ public:
         static inline void* toVoidPtr (VoidType* v) noexcept { return const_cast<void*> (v); }
         enum { isConst = 1 };
     };
+
+    //==============================================================================
+    // The integer formats which Pointer::convertSamples() converts to and from native-endian
+    // floats with vectorised code, rather than one sample at a time.
+    enum VectorisedFormat
+    {
+        notVectorised = 0,
+        vectorisedInt16,
+        vectorisedInt24,
+        vectorisedInt24in32,
+        vectorisedInt32
+    };
+
+    template <class SampleFormat, typename Dummy = void> struct VectorisedFormatOf  { enum { value = notVectorised }; };
+    template <typename Dummy> struct VectorisedFormatOf<Int16, Dummy>               { enum { value = vectorisedInt16 }; };
+    template <typename Dummy> struct VectorisedFormatOf<Int24, Dummy>               { enum { value = vectorisedInt24 }; };
+    template <typename Dummy> struct VectorisedFormatOf<Int24in32, Dummy>           { enum { value = vectorisedInt24in32 }; };
+    template <typename Dummy> struct VectorisedFormatOf<Int32, Dummy>               { enum { value = vectorisedInt32 }; };
+
+    // The strides are the number of interleaved channels in each block of data. These give
+    // exactly the same results as the per-sample conversions in the format classes.
+    static void convertIntToFloat (VectorisedFormat, bool sourceIsBigEndian, const void* source, int sourceStride,
+                                   float* dest, int destStride, int numSamples) noexcept;
+    static void convertFloatToInt (VectorisedFormat, bool destIsBigEndian, const float* source, int sourceStride,
+                                   void* dest, int destStride, int numSamples) noexcept;
+
+    // Scans a block of one of the vectorised integer formats, or of native-endian floats, without
+    // converting it first. The results are exactly the same as the per-sample scan in
+    // Pointer::findMinAndMax(). numSamples must be greater than zero.
+    static Range<float> findMinAndMaxOfInts (VectorisedFormat, bool sourceIsBigEndian, const void* source,
+                                             int sourceStride, int numSamples) noexcept;
+    static Range<float> findMinAndMaxOfFloats (const float* source, int sourceStride, int numSamples) noexcept;
   #endif
 
     //==============================================================================
@@ -352,6 +384,9 @@ public:
     class Pointer  : private InterleavingType  // (inherited for EBCO)
     {
     public:
+        typedef SampleFormat SampleFormatType;
+        typedef Endianness EndiannessType;
+
         //==============================================================================
         /** Creates a non-interleaved pointer from some raw data in the appropriate format.
             This constructor is only used if you've specified the AudioData::NonInterleaved option -
@@ -461,6 +496,9 @@ public:
 
             Pointer dest (*this);
 
+            if (convertVectorised (source, numSamples))
+                return;
+
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
             {
                 while (--numSamples >= 0)
@@ -495,6 +533,15 @@ public:
 
             Pointer dest (*this);
 
+            if (SampleFormat::isFloat && (bool) Endianness::isBigEndian == (bool) NativeEndian::isBigEndian)
+                return findMinAndMaxOfFloats ((const float*) data.data, getNumInterleavedChannels(), (int) numSamples);
+
+            const auto format = (VectorisedFormat) VectorisedFormatOf<SampleFormat>::value;
+
+            if (format != notVectorised)
+                return findMinAndMaxOfInts (format, (bool) Endianness::isBigEndian,
+                                            data.data, getNumInterleavedChannels(), (int) numSamples);
+
             if (isFloatingPoint())
             {
                 float mn = dest.getAsFloat();
@@ -569,6 +616,40 @@ public:
 
         inline void advance() noexcept                          { this->advanceData (data); }
 
+        // Hands the conversion to the vectorised routines if it's between native floats and one
+        // of the formats that they support. In-place conversions are left to the generic code.
+        template <class OtherPointerType>
+        bool convertVectorised (const OtherPointerType& source, int numSamples) const noexcept
+        {
+            typedef typename OtherPointerType::SampleFormatType SourceFormat;
+            typedef typename OtherPointerType::EndiannessType SourceEndianness;
+
+            const bool destIsNativeFloat   = SampleFormat::isFloat && (bool) Endianness::isBigEndian == (bool) NativeEndian::isBigEndian;
+            const bool sourceIsNativeFloat = SourceFormat::isFloat && (bool) SourceEndianness::isBigEndian == (bool) NativeEndian::isBigEndian;
+
+            const auto sourceFormat = (VectorisedFormat) VectorisedFormatOf<SourceFormat>::value;
+            const auto destFormat   = (VectorisedFormat) VectorisedFormatOf<SampleFormat>::value;
+
+            if (! ((destIsNativeFloat && sourceFormat != notVectorised) || (sourceIsNativeFloat && destFormat != notVectorised)))
+                return false;
+
+            auto* sourceStart = static_cast<const char*> (source.getRawData());
+            auto* destStart   = static_cast<const char*> (getRawData());
+
+            if (sourceStart < destStart + numSamples * getNumBytesBetweenSamples()
+                 && destStart < sourceStart + numSamples * source.getNumBytesBetweenSamples())
+                return false;
+
+            if (destIsNativeFloat)
+                convertIntToFloat (sourceFormat, (bool) SourceEndianness::isBigEndian, sourceStart, source.getNumInterleavedChannels(),
+                                   (float*) data.data, getNumInterleavedChannels(), numSamples);
+            else
+                convertFloatToInt (destFormat, (bool) Endianness::isBigEndian, (const float*) sourceStart, source.getNumInterleavedChannels(),
+                                   data.data, getNumInterleavedChannels(), numSamples);
+
+            return true;
+        }
+
         Pointer operator++ (int); // private to force you to use the more efficient pre-increment!
         Pointer operator-- (int);
     };
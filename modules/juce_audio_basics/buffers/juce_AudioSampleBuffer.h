@@ -23,6 +23,107 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    Describes how an AudioBuffer or dsp::AudioBlock lays out the sample data that
+    it allocates.
+
+    The default settings give the same layout that AudioBuffer has always used:
+    each channel starts on a 16-byte boundary and its length is rounded up to a
+    multiple of 4 samples.
+
+    For SIMD code you may want a wider alignment (e.g. 32 bytes for AVX), and
+    padding that's a multiple of the vector width, so that a loop can run on past
+    the end of a block without needing a scalar tail. Because every channel's
+    allocation is a whole multiple of the alignment, choosing 64 bytes (or setting
+    separateCacheLines) also means that no two channels share a cache line, so
+    different threads can write to different channels without false sharing.
+
+    E.g.
+    @code
+    AudioBuffer<float> buffer (numChannels, blockSize, AudioBufferLayout().withAlignment (32)
+                                                                          .withSampleMultiple (8));
+    @endcode
+
+    @see AudioBuffer, dsp::AudioBlock
+*/
+struct AudioBufferLayout
+{
+    /** Returns a copy of this layout with a different channel alignment, in bytes.
+        This must be a power of two.
+    */
+    AudioBufferLayout withAlignment (size_t newAlignment) const noexcept
+    {
+        jassert (isPowerOfTwo (newAlignment));
+        auto l = *this;
+        l.alignment = newAlignment;
+        return l;
+    }
+
+    /** Returns a copy of this layout which rounds each channel's length up to a multiple
+        of the given number of samples.
+    */
+    AudioBufferLayout withSampleMultiple (int newSampleMultiple) const noexcept
+    {
+        jassert (newSampleMultiple > 0);
+        auto l = *this;
+        l.sampleMultiple = newSampleMultiple;
+        return l;
+    }
+
+    /** Returns a copy of this layout which starts each channel on a new cache line. */
+    AudioBufferLayout withSeparateCacheLines (bool shouldSeparate = true) const noexcept
+    {
+        auto l = *this;
+        l.separateCacheLines = shouldSeparate;
+        return l;
+    }
+
+    /** Returns the byte alignment that will be used for the first sample of each channel. */
+    template <typename Type>
+    size_t getChannelAlignment() const noexcept
+    {
+        return jmax (alignment, (size_t) alignof (Type), separateCacheLines ? (size_t) cacheLineSize : (size_t) 0);
+    }
+
+    /** Returns the number of samples that will be allocated for each channel, which is
+        the distance between the start of one channel and the next.
+    */
+    template <typename Type>
+    size_t getChannelStride (int numSamples) const noexcept
+    {
+        auto multiple = (size_t) sampleMultiple;
+        auto bytes = (((size_t) numSamples + multiple - 1) / multiple) * multiple * sizeof (Type);
+        auto channelAlignment = getChannelAlignment<Type>();
+        bytes = (bytes + channelAlignment - 1) & ~(channelAlignment - 1);
+
+        // the alignment must be a whole number of samples
+        jassert (bytes % sizeof (Type) == 0);
+        return bytes / sizeof (Type);
+    }
+
+    bool operator== (const AudioBufferLayout& other) const noexcept
+    {
+        return alignment == other.alignment
+                && sampleMultiple == other.sampleMultiple
+                && separateCacheLines == other.separateCacheLines;
+    }
+
+    bool operator!= (const AudioBufferLayout& other) const noexcept    { return ! operator== (other); }
+
+    /** The size of cache line that separateCacheLines assumes. */
+    static constexpr size_t cacheLineSize = 64;
+
+    /** The byte alignment of the first sample in each channel. This must be a power of two. */
+    size_t alignment = 16;
+
+    /** Each channel's allocated length is rounded up to a multiple of this many samples. */
+    int sampleMultiple = 4;
+
+    /** If true, each channel begins on a new cache line. */
+    bool separateCacheLines = false;
+};
+
 //==============================================================================
 /**
     A multi-channel buffer of floating point audio samples.
@@ -61,6 +162,24 @@ public:
         allocateData();
     }
 
+    /** Creates a buffer with a specified number of channels and samples, whose memory
+        is laid out as described by an AudioBufferLayout.
+
+        The layout will also be used whenever the buffer has to re-allocate its data.
+
+        @see setLayout
+    */
+    AudioBuffer (int numChannelsToAllocate,
+                 int numSamplesToAllocate,
+                 const AudioBufferLayout& layoutToUse)
+       : numChannels (numChannelsToAllocate),
+         size (numSamplesToAllocate),
+         layout (layoutToUse)
+    {
+        jassert (size >= 0 && numChannels >= 0);
+        allocateData();
+    }
+
     /** Creates a buffer using a pre-allocated block of memory.
 
         Note that if the buffer is resized or its number of channels is changed, it
@@ -127,7 +246,8 @@ public:
     AudioBuffer (const AudioBuffer& other)
        : numChannels (other.numChannels),
          size (other.size),
-         allocatedBytes (other.allocatedBytes)
+         allocatedBytes (other.allocatedBytes),
+         layout (other.layout)
     {
         if (allocatedBytes == 0)
         {
@@ -185,6 +305,7 @@ public:
           size (other.size),
           allocatedBytes (other.allocatedBytes),
           allocatedData (static_cast<HeapBlock<char, true>&&> (other.allocatedData)),
+          layout (other.layout),
           isClear (other.isClear)
     {
         if (numChannels < (int) numElementsInArray (preallocatedChannelSpace))
@@ -209,6 +330,7 @@ public:
         size = other.size;
         allocatedBytes = other.allocatedBytes;
         allocatedData = static_cast<HeapBlock<char, true>&&> (other.allocatedData);
+        layout = other.layout;
         isClear = other.isClear;
 
         if (numChannels < (int) numElementsInArray (preallocatedChannelSpace))
@@ -306,6 +428,33 @@ public:
     */
     Type** getArrayOfWritePointers() noexcept                       { isClear = false; return channels; }
 
+    //==============================================================================
+    /** Changes the way that the buffer lays out any memory it allocates.
+
+        If the buffer currently owns its data and the layout is different, the data is
+        re-allocated using the new layout, keeping its existing content. If the buffer
+        refers to external data, the layout will be used the next time it allocates.
+
+        @see AudioBufferLayout, getLayout
+    */
+    void setLayout (const AudioBufferLayout& newLayout)
+    {
+        if (newLayout != layout)
+        {
+            layout = newLayout;
+
+            if (allocatedBytes != 0)
+                reallocate (numChannels, size, true, false, false);
+        }
+    }
+
+    /** Returns the layout that the buffer uses when it allocates memory.
+
+        Note that when the buffer is referring to external data (see setDataToReferTo),
+        that data won't necessarily have the alignment or padding that's described here.
+    */
+    const AudioBufferLayout& getLayout() const noexcept             { return layout; }
+
     //==============================================================================
     /** Changes the buffer's size or number of channels.
 
@@ -336,67 +485,7 @@ public:
         jassert (newNumSamples >= 0);
 
         if (newNumSamples != size || newNumChannels != numChannels)
-        {
-            const auto allocatedSamplesPerChannel = ((size_t) newNumSamples + 3) & ~3u;
-            const auto channelListSize = ((sizeof (Type*) * (size_t) (newNumChannels + 1)) + 15) & ~15u;
-            const auto newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (Type))
-                                          + channelListSize + 32;
-
-            if (keepExistingContent)
-            {
-                HeapBlock<char, true> newData;
-                newData.allocate (newTotalBytes, clearExtraSpace || isClear);
-
-                auto numSamplesToCopy = (size_t) jmin (newNumSamples, size);
-
-                auto newChannels = reinterpret_cast<Type**> (newData.get());
-                auto newChan     = reinterpret_cast<Type*> (newData + channelListSize);
-
-                for (int j = 0; j < newNumChannels; ++j)
-                {
-                    newChannels[j] = newChan;
-                    newChan += allocatedSamplesPerChannel;
-                }
-
-                if (! isClear)
-                {
-                    auto numChansToCopy = jmin (numChannels, newNumChannels);
-
-                    for (int i = 0; i < numChansToCopy; ++i)
-                        FloatVectorOperations::copy (newChannels[i], channels[i], (int) numSamplesToCopy);
-                }
-
-                allocatedData.swapWith (newData);
-                allocatedBytes = newTotalBytes;
-                channels = newChannels;
-            }
-            else
-            {
-                if (avoidReallocating && allocatedBytes >= newTotalBytes)
-                {
-                    if (clearExtraSpace || isClear)
-                        allocatedData.clear (newTotalBytes);
-                }
-                else
-                {
-                    allocatedBytes = newTotalBytes;
-                    allocatedData.allocate (newTotalBytes, clearExtraSpace || isClear);
-                    channels = reinterpret_cast<Type**> (allocatedData.get());
-                }
-
-                auto* chan = reinterpret_cast<Type*> (allocatedData + channelListSize);
-
-                for (int i = 0; i < newNumChannels; ++i)
-                {
-                    channels[i] = chan;
-                    chan += allocatedSamplesPerChannel;
-                }
-            }
-
-            channels[newNumChannels] = 0;
-            size = newNumSamples;
-            numChannels = newNumChannels;
-        }
+            reallocate (newNumChannels, newNumSamples, keepExistingContent, clearExtraSpace, avoidReallocating);
     }
 
     /** Makes this buffer point to a pre-allocated set of channel data arrays.
@@ -432,10 +521,16 @@ public:
             allocatedData.free();
         }
 
+        // If a previous call had to allocate a list of channel pointers, that list can be
+        // re-used, so that a plugin wrapper which re-points a buffer with lots of channels
+        // at the host's data for every block doesn't have to allocate each time.
+        auto canReuseChannelList = channels == reinterpret_cast<Type**> (allocatedData.get())
+                                     && newNumChannels <= numChannels;
+
         numChannels = newNumChannels;
         size = newNumSamples;
 
-        allocateChannels (dataToReferTo, newStartSample);
+        allocateChannels (dataToReferTo, newStartSample, canReuseChannelList);
         jassert (! isClear);
     }
 
@@ -646,14 +741,8 @@ public:
                 jassert (isPositiveAndBelow (channel, numChannels));
                 jassert (startSample >= 0 && numSamples >= 0 && startSample + numSamples <= size);
 
-                const auto increment = (endGain - startGain) / (float) numSamples;
                 auto* d = channels[channel] + startSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ *= startGain;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (d, d, startGain, endGain, numSamples);
             }
         }
     }
@@ -802,14 +891,7 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::addWithRamp (channels[destChannel] + destStartSample, source, startGain, endGain, numSamples);
             }
         }
     }
@@ -958,14 +1040,7 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ = startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (channels[destChannel] + destStartSample, source, startGain, endGain, numSamples);
             }
         }
     }
@@ -1022,14 +1097,8 @@ public:
         if (numSamples <= 0 || channel < 0 || channel >= numChannels || isClear)
             return {};
 
-        auto* data = channels[channel] + startSample;
-        double sum = 0.0;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const Type sample = data[i];
-            sum += sample * sample;
-        }
+        Type peak;
+        auto sum = FloatVectorOperations::findSumOfSquaresAndPeak (channels[channel] + startSample, numSamples, peak);
 
         return (Type) std::sqrt (sum / numSamples);
     }
@@ -1059,29 +1128,96 @@ private:
     size_t allocatedBytes;
     Type** channels;
     HeapBlock<char, true> allocatedData;
+    AudioBufferLayout layout;
     Type* preallocatedChannelSpace[32];
     bool isClear;
 
+    static size_t getChannelListSize (int numChans) noexcept
+    {
+        return ((sizeof (Type*) * (size_t) (numChans + 1)) + 15) & ~(size_t) 15;
+    }
+
+    size_t getNumBytesNeeded (int numChans, int numSamples) const noexcept
+    {
+        // The alignment padding is allowed for in the total, so the layout of a block
+        // is the same wherever it happens to get allocated.
+        return getChannelListSize (numChans) + layout.getChannelAlignment<Type>() - 1
+                 + (size_t) numChans * layout.getChannelStride<Type> (numSamples) * sizeof (Type);
+    }
+
+    void setUpChannels (Type** channelList, char* block, int numChans, int numSamples) const noexcept
+    {
+        auto* chan = snapPointerToAlignment (reinterpret_cast<Type*> (block + getChannelListSize (numChans)),
+                                             layout.getChannelAlignment<Type>());
+        auto stride = layout.getChannelStride<Type> (numSamples);
+
+        for (int i = 0; i < numChans; ++i)
+        {
+            channelList[i] = chan;
+            chan += stride;
+        }
+
+        channelList[numChans] = nullptr;
+    }
+
     void allocateData()
     {
         jassert (size >= 0);
-        auto channelListSize = sizeof (Type*) * (size_t) (numChannels + 1);
-        allocatedBytes = (size_t) numChannels * (size_t) size * sizeof (Type) + channelListSize + 32;
+        allocatedBytes = getNumBytesNeeded (numChannels, size);
         allocatedData.malloc (allocatedBytes);
         channels = reinterpret_cast<Type**> (allocatedData.get());
-        auto* chan = (Type*) (allocatedData + channelListSize);
+        setUpChannels (channels, allocatedData, numChannels, size);
+        isClear = false;
+    }
 
-        for (int i = 0; i < numChannels; ++i)
+    void reallocate (int newNumChannels, int newNumSamples, bool keepExistingContent,
+                     bool clearExtraSpace, bool avoidReallocating)
+    {
+        const auto newTotalBytes = getNumBytesNeeded (newNumChannels, newNumSamples);
+
+        if (keepExistingContent)
+        {
+            HeapBlock<char, true> newData;
+            newData.allocate (newTotalBytes, clearExtraSpace || isClear);
+
+            auto numSamplesToCopy = jmin (newNumSamples, size);
+            auto newChannels = reinterpret_cast<Type**> (newData.get());
+            setUpChannels (newChannels, newData, newNumChannels, newNumSamples);
+
+            if (! isClear)
+            {
+                auto numChansToCopy = jmin (numChannels, newNumChannels);
+
+                for (int i = 0; i < numChansToCopy; ++i)
+                    FloatVectorOperations::copy (newChannels[i], channels[i], numSamplesToCopy);
+            }
+
+            allocatedData.swapWith (newData);
+            allocatedBytes = newTotalBytes;
+            channels = newChannels;
+        }
+        else
         {
-            channels[i] = chan;
-            chan += size;
+            if (avoidReallocating && allocatedBytes >= newTotalBytes)
+            {
+                if (clearExtraSpace || isClear)
+                    allocatedData.clear (newTotalBytes);
+            }
+            else
+            {
+                allocatedBytes = newTotalBytes;
+                allocatedData.allocate (newTotalBytes, clearExtraSpace || isClear);
+                channels = reinterpret_cast<Type**> (allocatedData.get());
+            }
+
+            setUpChannels (channels, allocatedData, newNumChannels, newNumSamples);
         }
 
-        channels[numChannels] = nullptr;
-        isClear = false;
+        size = newNumSamples;
+        numChannels = newNumChannels;
     }
 
-    void allocateChannels (Type* const* dataToReferTo, int offset)
+    void allocateChannels (Type* const* dataToReferTo, int offset, bool canReuseChannelList = false)
     {
         jassert (offset >= 0);
 
@@ -1090,7 +1226,7 @@ private:
         {
             channels = static_cast<Type**> (preallocatedChannelSpace);
         }
-        else
+        else if (! canReuseChannelList)
         {
             allocatedData.malloc (numChannels + 1, sizeof (Type*));
             channels = reinterpret_cast<Type**> (allocatedData.get());
@@ -25,9 +25,9 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
     inline static bool isAligned (const void* p) noexcept
@@ -349,6 +349,337 @@ namespace FloatVectorHelpers
     #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
     #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
 
+    // The gain ramps keep one gain per SIMD element, which all move along by the same step
+    // on each iteration, while startGain follows them for the elements left at the end.
+    #define JUCE_SETUP_GAIN_RAMP \
+        Mode::Type rampGains[Mode::numParallel]; \
+        for (int lane = 0; lane < Mode::numParallel; ++lane) rampGains[lane] = startGain + (Mode::Type) lane * gainIncrement; \
+        Mode::ParallelType gain = Mode::loadU (rampGains); \
+        const Mode::Type gainStepPerOp = gainIncrement * (Mode::Type) Mode::numParallel; \
+        const Mode::ParallelType gainStep = Mode::load1 (gainStepPerOp);
+
+    #define JUCE_INCREMENT_GAIN_RAMP        gain = Mode::add (gain, gainStep); startGain += gainStepPerOp;
+
+    // The squares are summed in SIMD registers for a limited number of iterations at a
+    // time, and then added to a double, so that long arrays don't lose precision.
+    #define JUCE_FIND_SUM_OF_SQUARES_AND_PEAK(ModeToUse) \
+        typedef ModeToUse Mode; \
+        double sum = 0; \
+        Mode::Type lowest = 0, highest = 0; \
+        int numLongOps = num / Mode::numParallel; \
+        \
+        if (numLongOps > 0) \
+        { \
+            Mode::ParallelType mn = Mode::load1 (0), mx = mn; \
+            \
+            while (numLongOps > 0) \
+            { \
+                const int numInBlock = jmin (numLongOps, 256); \
+                Mode::ParallelType squares = Mode::load1 (0); \
+                \
+                for (int i = 0; i < numInBlock; ++i) \
+                { \
+                    const Mode::ParallelType s = Mode::loadU (src); \
+                    squares = Mode::add (squares, Mode::mul (s, s)); \
+                    mn = Mode::min (mn, s); \
+                    mx = Mode::max (mx, s); \
+                    src += Mode::numParallel; \
+                } \
+                \
+                Mode::Type blockSums[Mode::numParallel]; \
+                Mode::storeU (blockSums, squares); \
+                \
+                for (int lane = 0; lane < Mode::numParallel; ++lane) \
+                    sum += blockSums[lane]; \
+                \
+                numLongOps -= numInBlock; \
+            } \
+            \
+            lowest  = Mode::min (mn); \
+            highest = Mode::max (mx); \
+            num &= (Mode::numParallel - 1); \
+        } \
+        \
+        for (int i = 0; i < num; ++i) \
+        { \
+            const Mode::Type sample = src[i]; \
+            sum += sample * sample; \
+            lowest  = jmin (lowest, sample); \
+            highest = jmax (highest, sample); \
+        } \
+        \
+        peak = jmax (highest, -lowest); \
+        return sum;
+
+    //==============================================================================
+   #if JUCE_USE_AVX_DISPATCH
+    // These are the 256 and 512-bit versions of the most heavily used operations. They're
+    // compiled for AVX or AVX-512 individually, and FloatVectorOperations only calls them
+    // after checking that the CPU it's running on supports them.
+   #if JUCE_MSVC
+    #define JUCE_AVX_TARGET
+    #define JUCE_AVX512_TARGET
+   #else
+    #define JUCE_AVX_TARGET     __attribute__ ((target ("avx")))
+    #define JUCE_AVX512_TARGET  __attribute__ ((target ("avx512f")))
+   #endif
+
+    // Leaving the upper halves of the registers dirty makes any SSE code that runs afterwards
+    // very slow, so every one of the wide operations clears them again on its way out.
+    struct ScopedZeroUpper
+    {
+        JUCE_AVX_TARGET ~ScopedZeroUpper() noexcept   { _mm256_zeroupper(); }
+    };
+
+    // Unaligned loads and stores are as fast as aligned ones on this hardware when
+    // the data happens to be aligned, so there's no need to check the pointers.
+    struct AVXOps32
+    {
+        typedef float Type;
+        typedef __m256 ParallelType;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadInts (const int* v) noexcept               { return _mm256_cvtepi32_ps (_mm256_loadu_si256 ((const __m256i*) v)); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+    };
+
+    struct AVXOps64
+    {
+        typedef double Type;
+        typedef __m256d ParallelType;
+        enum { numParallel = 4 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+    };
+
+    struct AVX512Ops32
+    {
+        typedef float Type;
+        typedef __m512 ParallelType;
+        enum { numParallel = 16 };
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadInts (const int* v) noexcept               { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMinimum (v, (int) numParallel); }
+    };
+
+    struct AVX512Ops64
+    {
+        typedef double Type;
+        typedef __m512d ParallelType;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMinimum (v, (int) numParallel); }
+    };
+
+    #define JUCE_PERFORM_WIDE_VEC_OP(WideMode, normalOp, vecOp, locals, increment, setupOp) \
+        typedef WideMode Mode; \
+        const ScopedZeroUpper zeroUpper; \
+        { \
+            const int numLongOps = num / Mode::numParallel; \
+            setupOp \
+            JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+        JUCE_FINISH_VEC_OP (normalOp)
+
+    #define JUCE_DECLARE_WIDE_VEC_OPS(target, WideMode) \
+        target static void add (WideMode::Type* dest, WideMode::Type amount, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST, JUCE_INCREMENT_DEST, \
+                                      const Mode::ParallelType amountToAdd = Mode::load1 (amount);) \
+        } \
+        \
+        target static void add (WideMode::Type* dest, const WideMode::Type* src, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, ) \
+        } \
+        \
+        target static void add (WideMode::Type* dest, const WideMode::Type* src1, const WideMode::Type* src2, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, ) \
+        } \
+        \
+        target static void addWithMultiply (WideMode::Type* dest, const WideMode::Type* src, WideMode::Type multiplier, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)), \
+                                      JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, \
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);) \
+        } \
+        \
+        target static void multiply (WideMode::Type* dest, WideMode::Type multiplier, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST, JUCE_INCREMENT_DEST, \
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);) \
+        } \
+        \
+        target static void multiply (WideMode::Type* dest, const WideMode::Type* src, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, ) \
+        } \
+        \
+        target static void multiply (WideMode::Type* dest, const WideMode::Type* src1, const WideMode::Type* src2, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, ) \
+        } \
+        \
+        target static void copyWithMultiply (WideMode::Type* dest, const WideMode::Type* src, WideMode::Type multiplier, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = src[i] * multiplier, Mode::mul (mult, s), JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST, \
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);) \
+        } \
+        \
+        target static void addWithRamp (WideMode::Type* dest, const WideMode::Type* src, WideMode::Type startGain, WideMode::Type gainIncrement, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, { dest[i] += src[i] * startGain; startGain += gainIncrement; }, Mode::add (d, Mode::mul (s, gain)), \
+                                      JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP) \
+        } \
+        \
+        target static void copyWithRamp (WideMode::Type* dest, const WideMode::Type* src, WideMode::Type startGain, WideMode::Type gainIncrement, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, { dest[i] = src[i] * startGain; startGain += gainIncrement; }, Mode::mul (s, gain), \
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP) \
+        } \
+        \
+        target static void multiplyAddAndClip (WideMode::Type* dest, WideMode::Type destMultiplier, const WideMode::Type* src, WideMode::Type srcMultiplier, \
+                                               WideMode::Type low, WideMode::Type high, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = jmax (jmin (dest[i] * destMultiplier + src[i] * srcMultiplier, high), low), \
+                                      Mode::max (Mode::min (Mode::add (Mode::mul (d, dm), Mode::mul (s, sm)), hi), lo), \
+                                      JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, \
+                                      const Mode::ParallelType dm = Mode::load1 (destMultiplier); const Mode::ParallelType sm = Mode::load1 (srcMultiplier); \
+                                      const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);) \
+        } \
+        \
+        target static double findSumOfSquaresAndPeak (const WideMode::Type* src, int num, WideMode::Type& peak) noexcept \
+        { \
+            const ScopedZeroUpper zeroUpper; \
+            JUCE_FIND_SUM_OF_SQUARES_AND_PEAK (WideMode) \
+        } \
+        \
+        target static void clip (WideMode::Type* dest, const WideMode::Type* src, WideMode::Type low, WideMode::Type high, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo), \
+                                      JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST, \
+                                      const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);) \
+        } \
+        \
+        target static Range<WideMode::Type> findMinAndMax (const WideMode::Type* src, int num) noexcept \
+        { \
+            typedef WideMode Mode; \
+            const ScopedZeroUpper zeroUpper; \
+            int numLongOps = num / Mode::numParallel; \
+            \
+            if (numLongOps > 1) \
+            { \
+                Mode::ParallelType mn = Mode::loadU (src), mx = mn; \
+                \
+                while (--numLongOps > 0) \
+                { \
+                    src += Mode::numParallel; \
+                    const Mode::ParallelType v = Mode::loadU (src); \
+                    mn = Mode::min (mn, v); \
+                    mx = Mode::max (mx, v); \
+                } \
+                \
+                Range<Mode::Type> result (Mode::min (mn), Mode::max (mx)); \
+                \
+                num &= (Mode::numParallel - 1); \
+                src += Mode::numParallel; \
+                \
+                for (int i = 0; i < num; ++i) \
+                    result = result.getUnionWith (src[i]); \
+                \
+                return result; \
+            } \
+            \
+            return Range<Mode::Type>::findMinAndMax (src, num); \
+        }
+
+    #define JUCE_DECLARE_WIDE_FIXED_TO_FLOAT_OP(target, WideMode) \
+        target static void convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept \
+        { \
+            JUCE_PERFORM_WIDE_VEC_OP (WideMode, dest[i] = (float) src[i] * multiplier, Mode::mul (mult, Mode::loadInts (src)), \
+                                      JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, \
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);) \
+        }
+
+    struct AVXOps
+    {
+        JUCE_DECLARE_WIDE_VEC_OPS (JUCE_AVX_TARGET, AVXOps32)
+        JUCE_DECLARE_WIDE_VEC_OPS (JUCE_AVX_TARGET, AVXOps64)
+        JUCE_DECLARE_WIDE_FIXED_TO_FLOAT_OP (JUCE_AVX_TARGET, AVXOps32)
+    };
+
+    struct AVX512Ops
+    {
+        JUCE_DECLARE_WIDE_VEC_OPS (JUCE_AVX512_TARGET, AVX512Ops32)
+        JUCE_DECLARE_WIDE_VEC_OPS (JUCE_AVX512_TARGET, AVX512Ops64)
+        JUCE_DECLARE_WIDE_FIXED_TO_FLOAT_OP (JUCE_AVX512_TARGET, AVX512Ops32)
+    };
+
+    enum class WideInstructionSet { none, avx, avx512 };
+
+    static WideInstructionSet getWideInstructionSet() noexcept
+    {
+        static const CPUDispatch::Function<WideInstructionSet> instructionSet ("FloatVectorOperations",
+        {
+            { "avx512", CPUDispatch::avx512f, WideInstructionSet::avx512 },
+            { "avx",    CPUDispatch::avx,     WideInstructionSet::avx },
+            { "sse",    0,                    WideInstructionSet::none }
+        });
+
+        return instructionSet.get();
+    }
+
+    #define JUCE_DISPATCH_WIDE_VEC_OP(functionCall) \
+        switch (FloatVectorHelpers::getWideInstructionSet()) \
+        { \
+            case FloatVectorHelpers::WideInstructionSet::avx512:  return FloatVectorHelpers::AVX512Ops::functionCall; \
+            case FloatVectorHelpers::WideInstructionSet::avx:     return FloatVectorHelpers::AVXOps::functionCall; \
+            default:                                              break; \
+        }
+   #else
+    #define JUCE_DISPATCH_WIDE_VEC_OP(functionCall)
+   #endif
+
     union signMask32 { float  f; uint32 i; };
     union signMask64 { double d; uint64 i; };
 
@@ -552,6 +883,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -563,17 +895,43 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept
+{
+    if (num <= 0)
+        return;
+
+    const float gainIncrement = (endGain - startGain) / (float) num;
+
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithRamp (dest, src, startGain, gainIncrement, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST ({ dest[i] = src[i] * startGain; startGain += gainIncrement; }, Mode::mul (s, gain),
+                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept
+{
+    if (num <= 0)
+        return;
+
+    const double gainIncrement = (endGain - startGain) / (double) num;
+
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithRamp (dest, src, startGain, gainIncrement, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST ({ dest[i] = src[i] * startGain; startGain += gainIncrement; }, Mode::mul (s, gain),
+                                  JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP)
+}
+
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int num) noexcept
 {
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, amount, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
    #endif
@@ -581,6 +939,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, amount, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
 }
@@ -612,6 +971,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -621,6 +981,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -630,6 +991,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -639,6 +1001,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -684,6 +1047,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -695,6 +1059,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -723,6 +1088,56 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #endif
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept
+{
+    if (num <= 0)
+        return;
+
+    const float gainIncrement = (endGain - startGain) / (float) num;
+
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithRamp (dest, src, startGain, gainIncrement, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST ({ dest[i] += src[i] * startGain; startGain += gainIncrement; }, Mode::add (d, Mode::mul (s, gain)),
+                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept
+{
+    if (num <= 0)
+        return;
+
+    const double gainIncrement = (endGain - startGain) / (double) num;
+
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithRamp (dest, src, startGain, gainIncrement, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST ({ dest[i] += src[i] * startGain; startGain += gainIncrement; }, Mode::add (d, Mode::mul (s, gain)),
+                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST JUCE_INCREMENT_GAIN_RAMP, JUCE_SETUP_GAIN_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyAddAndClip (float* dest, float destMultiplier, const float* src, float srcMultiplier,
+                                                              float low, float high, int num) noexcept
+{
+    jassert (high >= low);
+
+    JUCE_DISPATCH_WIDE_VEC_OP (multiplyAddAndClip (dest, destMultiplier, src, srcMultiplier, low, high, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (dest[i] * destMultiplier + src[i] * srcMultiplier, high), low),
+                                  Mode::max (Mode::min (Mode::add (Mode::mul (d, dm), Mode::mul (s, sm)), hi), lo),
+                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
+                                  const Mode::ParallelType dm = Mode::load1 (destMultiplier); const Mode::ParallelType sm = Mode::load1 (srcMultiplier);
+                                  const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyAddAndClip (double* dest, double destMultiplier, const double* src, double srcMultiplier,
+                                                              double low, double high, int num) noexcept
+{
+    jassert (high >= low);
+
+    JUCE_DISPATCH_WIDE_VEC_OP (multiplyAddAndClip (dest, destMultiplier, src, srcMultiplier, low, high, num))
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (dest[i] * destMultiplier + src[i] * srcMultiplier, high), low),
+                                  Mode::max (Mode::min (Mode::add (Mode::mul (d, dm), Mode::mul (s, sm)), hi), lo),
+                                  JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
+                                  const Mode::ParallelType dm = Mode::load1 (destMultiplier); const Mode::ParallelType sm = Mode::load1 (srcMultiplier);
+                                  const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
+}
+
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
@@ -756,6 +1171,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -765,6 +1181,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -774,6 +1191,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -783,6 +1201,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -792,6 +1211,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, multiplier, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -802,6 +1222,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply (dest, multiplier, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -809,6 +1230,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -816,6 +1238,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -877,6 +1300,7 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
                                   vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, )
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (convertFixedToFloat (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
                                   Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*) src))),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
@@ -955,6 +1379,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (float* dest, const float* src, f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (clip (dest, src, low, high, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
@@ -968,6 +1393,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (clip (dest, src, low, high, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
@@ -977,6 +1403,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinAndMax (src, num))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
    #else
     return Range<float>::findMinAndMax (src, num);
@@ -986,6 +1413,7 @@ Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* sr
 Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinAndMax (src, num))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
    #else
     return Range<double>::findMinAndMax (src, num);
@@ -1028,6 +1456,46 @@ double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int
    #endif
 }
 
+double JUCE_CALLTYPE FloatVectorOperations::findSumOfSquaresAndPeak (const float* src, int num, float& peak) noexcept
+{
+    JUCE_DISPATCH_WIDE_VEC_OP (findSumOfSquaresAndPeak (src, num, peak))
+
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_FIND_SUM_OF_SQUARES_AND_PEAK (FloatVectorHelpers::BasicOps32)
+   #else
+    double sum = 0;
+    peak = 0;
+
+    for (int i = 0; i < num; ++i)
+    {
+        sum += src[i] * src[i];
+        peak = jmax (peak, std::abs (src[i]));
+    }
+
+    return sum;
+   #endif
+}
+
+double JUCE_CALLTYPE FloatVectorOperations::findSumOfSquaresAndPeak (const double* src, int num, double& peak) noexcept
+{
+    JUCE_DISPATCH_WIDE_VEC_OP (findSumOfSquaresAndPeak (src, num, peak))
+
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_FIND_SUM_OF_SQUARES_AND_PEAK (FloatVectorHelpers::BasicOps64)
+   #else
+    double sum = 0;
+    peak = 0;
+
+    for (int i = 0; i < num; ++i)
+    {
+        sum += src[i] * src[i];
+        peak = jmax (peak, std::abs (src[i]));
+    }
+
+    return sum;
+   #endif
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1230,6 +1698,31 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            FloatVectorOperations::add (data2, data1, data1, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 16));
+
+            FloatVectorOperations::multiply (data1, data2, data2, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) 256));
+
+            FloatVectorOperations::clip (data2, data1, (ValueType) -100, (ValueType) 100, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 100));
+
+            FloatVectorOperations::fill (data1, (ValueType) 1, num);
+            FloatVectorOperations::multiplyAddAndClip (data1, (ValueType) 3, data2, (ValueType) 4, (ValueType) -5, (ValueType) 5, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) 5));
+
+            FloatVectorOperations::copyWithRamp (data2, data1, (ValueType) 0, (ValueType) num, num);
+            u.expect (isRamp (data2, num, (ValueType) 5));
+
+            FloatVectorOperations::addWithRamp (data2, data1, (ValueType) 0, (ValueType) num, num);
+            u.expect (isRamp (data2, num, (ValueType) 10));
+
+            FloatVectorOperations::fill (data1, (ValueType) 3, num);
+            data1[num - 1] = (ValueType) -4;
+            ValueType peak = 0;
+            u.expect (FloatVectorOperations::findSumOfSquaresAndPeak (data1, num, peak) == 9.0 * (num - 1) + 16.0);
+            u.expect (peak == (ValueType) 4);
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1268,6 +1761,15 @@ public:
             return true;
         }
 
+        static bool isRamp (const ValueType* d, int num, ValueType step)
+        {
+            for (int i = 0; i < num; ++i)
+                if (d[i] != step * (ValueType) i)
+                    return false;
+
+            return true;
+        }
+
         static bool buffersMatch (const ValueType* d1, const ValueType* d2, int num)
         {
             while (--num >= 0)
@@ -63,6 +63,20 @@ public:
     /** Copies a vector of doubles, multiplying each value by a given multiplier */
     static void JUCE_CALLTYPE copyWithMultiply (double* dest, const double* src, double multiplier, int numValues) noexcept;
 
+    /** Copies a vector of floats, multiplying each value by a gain which ramps linearly from startGain.
+
+        The gain applied to element i is startGain + i * (endGain - startGain) / numValues. The
+        source and destination can be the same array, to apply the ramp in-place.
+    */
+    static void JUCE_CALLTYPE copyWithRamp (float* dest, const float* src, float startGain, float endGain, int numValues) noexcept;
+
+    /** Copies a vector of doubles, multiplying each value by a gain which ramps linearly from startGain.
+
+        The gain applied to element i is startGain + i * (endGain - startGain) / numValues. The
+        source and destination can be the same array, to apply the ramp in-place.
+    */
+    static void JUCE_CALLTYPE copyWithRamp (double* dest, const double* src, double startGain, double endGain, int numValues) noexcept;
+
     /** Adds a fixed value to the destination values. */
     static void JUCE_CALLTYPE add (float* dest, float amountToAdd, int numValues) noexcept;
 
@@ -111,6 +125,30 @@ public:
     /** Multiplies each source1 value by the corresponding source2 value, then adds it to the destination value. */
     static void JUCE_CALLTYPE addWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept;
 
+    /** Multiplies each source value by a gain which ramps linearly from startGain, then adds it to the destination value.
+
+        The gain applied to element i is startGain + i * (endGain - startGain) / numValues.
+    */
+    static void JUCE_CALLTYPE addWithRamp (float* dest, const float* src, float startGain, float endGain, int numValues) noexcept;
+
+    /** Multiplies each source value by a gain which ramps linearly from startGain, then adds it to the destination value.
+
+        The gain applied to element i is startGain + i * (endGain - startGain) / numValues.
+    */
+    static void JUCE_CALLTYPE addWithRamp (double* dest, const double* src, double startGain, double endGain, int numValues) noexcept;
+
+    /** Multiplies the destination values by the destMultiplier, adds the source values multiplied by the srcMultiplier,
+        and then hard clips the result to the range low to high, in a single pass over the data.
+    */
+    static void JUCE_CALLTYPE multiplyAddAndClip (float* dest, float destMultiplier, const float* src, float srcMultiplier,
+                                                  float low, float high, int numValues) noexcept;
+
+    /** Multiplies the destination values by the destMultiplier, adds the source values multiplied by the srcMultiplier,
+        and then hard clips the result to the range low to high, in a single pass over the data.
+    */
+    static void JUCE_CALLTYPE multiplyAddAndClip (double* dest, double destMultiplier, const double* src, double srcMultiplier,
+                                                  double low, double high, int numValues) noexcept;
+
     /** Multiplies each source value by the given multiplier, then subtracts it to the destination value. */
     static void JUCE_CALLTYPE subtractWithMultiply (float* dest, const float* src, float multiplier, int numValues) noexcept;
 
@@ -210,6 +248,16 @@ public:
     /** Finds the maximum value in the given array. */
     static double JUCE_CALLTYPE findMaximum (const double* src, int numValues) noexcept;
 
+    /** Returns the sum of the squares of the values in the given array, and finds the
+        largest absolute value at the same time, which is what a level meter needs.
+    */
+    static double JUCE_CALLTYPE findSumOfSquaresAndPeak (const float* src, int numValues, float& peak) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array, and finds the
+        largest absolute value at the same time, which is what a level meter needs.
+    */
+    static double JUCE_CALLTYPE findSumOfSquaresAndPeak (const double* src, int numValues, double& peak) noexcept;
+
     /** This method enables or disables the SSE/NEON flush-to-zero mode. */
     static void JUCE_CALLTYPE enableFlushToZeroMode (bool shouldEnable) noexcept;
 
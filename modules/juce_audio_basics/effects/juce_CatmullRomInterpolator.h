@@ -32,7 +32,7 @@ namespace juce
     multiple channels, make sure each one uses its own CatmullRomInterpolator
     object.
 
-    @see LagrangeInterpolator
+    @see LagrangeInterpolator, WindowedSincInterpolator
 */
 class JUCE_API  CatmullRomInterpolator
 {
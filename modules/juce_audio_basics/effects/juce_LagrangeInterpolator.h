@@ -32,7 +32,7 @@ namespace juce
     multiple channels, make sure each one uses its own LagrangeInterpolator
     object.
 
-    @see CatmullRomInterpolator
+    @see CatmullRomInterpolator, WindowedSincInterpolator
 */
 class JUCE_API  LagrangeInterpolator
 {
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Utility class for values like gains or frequencies which should be smoothed
+    along an exponential curve, rather than the straight line of a LinearSmoothedValue.
+
+    Each step multiplies the value by the same ratio, so a gain moves by the same
+    number of decibels per sample, and a frequency by the same number of cents,
+    which sounds even all the way through the ramp. The values must all be greater
+    than zero.
+
+    It has the same block operations as LinearSmoothedValue.
+
+    @see LinearSmoothedValue
+*/
+template <typename FloatType>
+class MultiplicativeSmoothedValue  : public SmoothedValueBase<MultiplicativeSmoothedValue<FloatType>, FloatType>
+{
+public:
+    /** Constructor. */
+    MultiplicativeSmoothedValue() noexcept
+    {
+    }
+
+    /** Constructor. */
+    MultiplicativeSmoothedValue (FloatType initialValue) noexcept
+        : currentValue (initialValue), target (initialValue)
+    {
+        jassert (initialValue > 0);
+    }
+
+    //==============================================================================
+    /** Reset to a new sample rate and ramp length.
+        @param sampleRate The sampling rate
+        @param rampLengthInSeconds The duration of the ramp in seconds
+    */
+    void reset (double sampleRate, double rampLengthInSeconds) noexcept
+    {
+        jassert (sampleRate > 0 && rampLengthInSeconds >= 0);
+        stepsToTarget = (int) std::floor (rampLengthInSeconds * sampleRate);
+        currentValue = target;
+        countdown = 0;
+    }
+
+    //==============================================================================
+    /** Set a new target value, which must be greater than zero.
+        @param newValue New target value
+    */
+    void setValue (FloatType newValue) noexcept
+    {
+        // a multiplicative ramp can't reach or cross zero!
+        jassert (newValue > 0);
+
+        if (target != newValue)
+        {
+            target = newValue;
+            countdown = stepsToTarget;
+
+            if (countdown <= 0)
+                currentValue = target;
+            else
+                step = std::exp ((std::log (target) - std::log (currentValue)) / (FloatType) countdown);
+        }
+    }
+
+    //==============================================================================
+    /** Compute the next value.
+        @returns Smoothed value
+    */
+    FloatType getNextValue() noexcept
+    {
+        if (countdown <= 0)
+            return target;
+
+        --countdown;
+        currentValue *= step;
+        return currentValue;
+    }
+
+    /** Writes the next numSamples values of the ramp into an array, and moves the
+        ramp on by that many samples.
+    */
+    void fillRamp (FloatType* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        auto numSteps = jmax (0, jmin (numSamples, countdown));
+
+        if (numSteps > 0)
+        {
+            auto value = currentValue;
+
+            for (int i = 0; i < numSteps; ++i)
+            {
+                value *= step;
+                dest[i] = value;
+            }
+
+            countdown -= numSteps;
+            currentValue = countdown > 0 ? value : target;
+        }
+
+        FloatVectorOperations::fill (dest + numSteps, target, numSamples - numSteps);
+    }
+
+    /** Moves the ramp on by a number of samples, without computing the values in between. */
+    void skip (int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        if (numSamples >= countdown)
+        {
+            currentValue = target;
+            countdown = 0;
+        }
+        else
+        {
+            currentValue *= std::pow (step, (FloatType) numSamples);
+            countdown -= numSamples;
+        }
+    }
+
+    /** Returns true if the current value is currently being interpolated. */
+    bool isSmoothing() const noexcept
+    {
+        return countdown > 0;
+    }
+
+    /** Returns the value which was last returned by getNextValue(). */
+    FloatType getCurrentValue() const noexcept
+    {
+        return countdown > 0 ? currentValue : target;
+    }
+
+    /** Returns the target value towards which the smoothed value is currently moving. */
+    FloatType getTargetValue() const noexcept
+    {
+        return target;
+    }
+
+private:
+    //==============================================================================
+    FloatType currentValue = 1, target = 1, step = 1;
+    int countdown = 0, stepsToTarget = 0;
+};
+
+} // namespace juce
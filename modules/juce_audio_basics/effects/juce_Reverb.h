@@ -31,6 +31,9 @@ namespace juce
     Use setSampleRate() to prepare it, and then call processStereo() or processMono() to
     apply the reverb to your audio data.
 
+    For a denser tail, the juce_dsp module has a feedback delay network reverb,
+    dsp::FDNReverb, which processes all of its delay lines together in SIMD registers.
+
     @see ReverbAudioSource
 */
 class Reverb
@@ -251,7 +254,12 @@ private:
             float temp = input + (last * feedbackLevel);
             JUCE_UNDENORMALISE (temp);
             buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
+
+            // (a compare is much cheaper than the integer division of a modulo,
+            // and this runs 16 times for every stereo sample)
+            if (++bufferIndex >= bufferSize)
+                bufferIndex = 0;
+
             return output;
         }
 
@@ -292,7 +300,10 @@ private:
             float temp = input + (bufferedValue * 0.5f);
             JUCE_UNDENORMALISE (temp);
             buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
+
+            if (++bufferIndex >= bufferSize)
+                bufferIndex = 0;
+
             return bufferedValue - input;
         }
 
@@ -0,0 +1,468 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  The filter kernel for one quality setting.
+
+    The continuous kernel is sampled numPhases times per input sample. From that, the
+    polyphase table holds a row of numTaps coefficients for each of the numPhases + 1
+    fractional offsets, along with the difference to the next row, so that the taps for
+    any offset can be found by interpolating between two rows.
+*/
+struct WindowedSincInterpolator::Kernel
+{
+    enum { numPhases = 256 };
+
+    void build (int taps, double cutoff, double beta)
+    {
+        numTaps = taps;
+        halfTaps = taps / 2;
+
+        auto kernelSize = numTaps * numPhases + 1;
+        continuous.malloc ((size_t) kernelSize);
+
+        for (int i = 0; i < kernelSize; ++i)
+        {
+            auto t = i / (double) numPhases - halfTaps;
+            continuous[i] = (float) calculateKernel (t, cutoff, beta);
+        }
+
+        rows.malloc ((size_t) ((numPhases + 1) * numTaps));
+        deltas.malloc ((size_t) (numPhases * numTaps));
+
+        for (int phase = 0; phase <= numPhases; ++phase)
+        {
+            auto* row = rows + phase * numTaps;
+            double sum = 0;
+
+            for (int k = 0; k < numTaps; ++k)
+            {
+                row[k] = continuous[(k + 1) * numPhases - phase];
+                sum += row[k];
+            }
+
+            // normalise each row so that the filter has unity gain at DC for every offset
+            for (int k = 0; k < numTaps; ++k)
+                row[k] = (float) (row[k] / sum);
+        }
+
+        for (int i = 0; i < numPhases * numTaps; ++i)
+            deltas[i] = rows[i + numTaps] - rows[i];
+    }
+
+    double calculateKernel (double t, double cutoff, double beta) const noexcept
+    {
+        if (beta <= 0)
+            return jmax (0.0, 1.0 - std::abs (t));
+
+        auto x = t / halfTaps;
+
+        if (std::abs (x) >= 1.0)
+            return 0.0;
+
+        auto sinc = t == 0 ? 1.0 : std::sin (double_Pi * cutoff * t) / (double_Pi * cutoff * t);
+        return cutoff * sinc * besselI0 (beta * std::sqrt (1.0 - x * x)) / besselI0 (beta);
+    }
+
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0, halfX = x * 0.5;
+
+        for (int k = 1; k < 50; ++k)
+        {
+            auto f = halfX / k;
+            term *= f * f;
+            sum += term;
+
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    // Samples the continuous kernel at a position relative to its centre
+    float evaluate (double t) const noexcept
+    {
+        auto index = (t + halfTaps) * numPhases;
+        auto i = (int) std::floor (index);
+
+        if (i < 0 || i >= numTaps * numPhases)
+            return 0.0f;
+
+        auto alpha = (float) (index - i);
+        return continuous[i] + alpha * (continuous[i + 1] - continuous[i]);
+    }
+
+    int numTaps = 0, halfTaps = 0;
+    HeapBlock<float> continuous, rows, deltas;
+};
+
+const WindowedSincInterpolator::Kernel* WindowedSincInterpolator::getKernel (Quality q) noexcept
+{
+    struct KernelSet
+    {
+        KernelSet()
+        {
+            kernels[linearQuality].build (2, 1.0, 0.0);
+            kernels[lowQuality]   .build (8,  0.80, 5.0);
+            kernels[mediumQuality].build (16, 0.88, 7.0);
+            kernels[highQuality]  .build (32, 0.92, 8.5);
+            kernels[bestQuality]  .build (64, 0.95, 10.0);
+        }
+
+        Kernel kernels[5];
+    };
+
+    static KernelSet kernelSet;
+    return kernelSet.kernels + jlimit (0, 4, (int) q);
+}
+
+namespace SincInterpolatorHelpers
+{
+    // Calculates the dot product of some samples with a set of taps that lie a fraction
+    // alpha of the way between two rows of the table.
+    static forcedinline float applyTaps (const float* samples, const float* row, const float* delta,
+                                         float alpha, int numTaps) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        auto sum = _mm_setzero_ps(), deltaSum = _mm_setzero_ps();
+
+        for (int i = 0; i < numTaps; i += 4)
+        {
+            auto s = _mm_loadu_ps (samples + i);
+            sum      = _mm_add_ps (sum,      _mm_mul_ps (s, _mm_loadu_ps (row + i)));
+            deltaSum = _mm_add_ps (deltaSum, _mm_mul_ps (s, _mm_loadu_ps (delta + i)));
+        }
+
+        sum = _mm_add_ps (sum, _mm_mul_ps (deltaSum, _mm_set1_ps (alpha)));
+        sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+        sum = _mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1));
+        return _mm_cvtss_f32 (sum);
+       #elif JUCE_USE_ARM_NEON
+        auto sum = vdupq_n_f32 (0), deltaSum = vdupq_n_f32 (0);
+
+        for (int i = 0; i < numTaps; i += 4)
+        {
+            auto s = vld1q_f32 (samples + i);
+            sum      = vmlaq_f32 (sum,      s, vld1q_f32 (row + i));
+            deltaSum = vmlaq_f32 (deltaSum, s, vld1q_f32 (delta + i));
+        }
+
+        sum = vmlaq_n_f32 (sum, deltaSum, alpha);
+        auto pair = vadd_f32 (vget_low_f32 (sum), vget_high_f32 (sum));
+        return vget_lane_f32 (vpadd_f32 (pair, pair), 0);
+       #else
+        float sum = 0, deltaSum = 0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            sum      += samples[i] * row[i];
+            deltaSum += samples[i] * delta[i];
+        }
+
+        return sum + alpha * deltaSum;
+       #endif
+    }
+}
+
+//==============================================================================
+WindowedSincInterpolator::WindowedSincInterpolator (Quality q)
+{
+    setQuality (q);
+}
+
+WindowedSincInterpolator::~WindowedSincInterpolator() noexcept {}
+
+void WindowedSincInterpolator::setQuality (Quality newQuality)
+{
+    jassert (isPositiveAndBelow ((int) newQuality, 5));
+
+    quality = newQuality;
+    kernel = getKernel (newQuality);
+
+    // the window of samples is stored twice over, so that the latest numTaps samples
+    // can always be read as one contiguous block
+    historySize = kernel->numTaps;
+    history.malloc ((size_t) historySize * 2);
+    reset();
+}
+
+int WindowedSincInterpolator::getNumTaps() const noexcept
+{
+    return kernel->numTaps;
+}
+
+void WindowedSincInterpolator::reset() noexcept
+{
+    subSamplePos = 1.0;
+    historyPos = 0;
+    history.clear ((size_t) historySize * 2);
+}
+
+void WindowedSincInterpolator::pushSample (float newValue) noexcept
+{
+    history[historyPos] = newValue;
+    history[historyPos + historySize] = newValue;
+
+    if (++historyPos >= historySize)
+        historyPos = 0;
+}
+
+float WindowedSincInterpolator::valueFromHistory (float offset) const noexcept
+{
+    auto* samples = history + historyPos;
+
+    if (quality == linearQuality)
+        return samples[0] + offset * (samples[1] - samples[0]);
+
+    auto phase = offset * (float) Kernel::numPhases;
+    auto row = jmin ((int) phase, (int) Kernel::numPhases - 1);
+    auto rowOffset = row * kernel->numTaps;
+
+    return SincInterpolatorHelpers::applyTaps (samples, kernel->rows + rowOffset, kernel->deltas + rowOffset,
+                                               phase - (float) row, kernel->numTaps);
+}
+
+template <bool isAdding>
+int WindowedSincInterpolator::interpolate (double actualRatio, const float* in, float* out, int numOut, float gain) noexcept
+{
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    if (actualRatio == 1.0 && pos == 1.0)
+    {
+        // the input is just delayed by the latency
+        auto centreTap = getLatencyInSamples() - 1;
+
+        for (int i = 0; i < numOut; ++i)
+        {
+            pushSample (in[i]);
+            auto value = history[historyPos + centreTap];
+
+            if (isAdding)
+                out[i] += gain * value;
+            else
+                out[i] = value;
+        }
+
+        return numOut;
+    }
+
+    while (numOut > 0)
+    {
+        while (pos >= 1.0)
+        {
+            pushSample (in[numUsed++]);
+            pos -= 1.0;
+        }
+
+        auto value = valueFromHistory ((float) pos);
+
+        if (isAdding)
+            *out++ += gain * value;
+        else
+            *out++ = value;
+
+        pos += actualRatio;
+        --numOut;
+    }
+
+    subSamplePos = pos;
+    return numUsed;
+}
+
+int WindowedSincInterpolator::process (double actualRatio, const float* in, float* out, int numOut) noexcept
+{
+    return interpolate<false> (actualRatio, in, out, numOut, 1.0f);
+}
+
+int WindowedSincInterpolator::processAdding (double actualRatio, const float* in, float* out, int numOut, float gain) noexcept
+{
+    return interpolate<true> (actualRatio, in, out, numOut, gain);
+}
+
+int WindowedSincInterpolator::getNumInputSamplesNeeded (double actualRatio, int numOut) const noexcept
+{
+    auto pos = subSamplePos;
+
+    if (actualRatio == 1.0 && pos == 1.0)
+        return numOut;
+
+    int numUsed = 0;
+
+    while (--numOut >= 0)
+    {
+        while (pos >= 1.0)
+        {
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        pos += actualRatio;
+    }
+
+    return numUsed;
+}
+
+//==============================================================================
+float WindowedSincInterpolator::valueAt (const float* samples, int numSamples, double position, double speedRatio) const noexcept
+{
+    auto index = (int) std::floor (position);
+    auto offset = (float) (position - index);
+
+    auto getSample = [=] (int i) noexcept { return isPositiveAndBelow (i, numSamples) ? samples[i] : 0.0f; };
+
+    if (quality == linearQuality)
+    {
+        auto s0 = getSample (index);
+        return s0 + offset * (getSample (index + 1) - s0);
+    }
+
+    auto numTaps = kernel->numTaps;
+
+    if (speedRatio <= 1.0)
+    {
+        auto phase = offset * (float) Kernel::numPhases;
+        auto row = jmin ((int) phase, (int) Kernel::numPhases - 1);
+        auto rowOffset = row * numTaps;
+        auto first = index - kernel->halfTaps + 1;
+
+        const float* source = samples + first;
+        float window[64];
+
+        if (first < 0 || first + numTaps > numSamples)
+        {
+            for (int i = 0; i < numTaps; ++i)
+                window[i] = getSample (first + i);
+
+            source = window;
+        }
+
+        return SincInterpolatorHelpers::applyTaps (source, kernel->rows + rowOffset, kernel->deltas + rowOffset,
+                                                   phase - (float) row, numTaps);
+    }
+
+    // When reading faster than the original rate, the kernel is stretched to lower its cut-off.
+    // The taps then fall at arbitrary points on the kernel, so they're looked up one at a time.
+    auto stretch = jmin (speedRatio, 4.0);
+    auto scale = 1.0 / stretch;
+    auto span = kernel->halfTaps * stretch;
+    auto first = (int) std::floor (position - span) + 1;
+    auto last  = (int) std::ceil  (position + span) - 1;
+
+    float sum = 0, tapSum = 0;
+
+    for (int i = first; i <= last; ++i)
+    {
+        auto tap = kernel->evaluate ((i - position) * scale);
+        sum += tap * getSample (i);
+        tapSum += tap;
+    }
+
+    return tapSum > 0 ? sum / tapSum : 0.0f;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WindowedSincInterpolatorTests  : public UnitTest
+{
+public:
+    WindowedSincInterpolatorTests() : UnitTest ("WindowedSincInterpolator", "Audio") {}
+
+    void runTest() override
+    {
+        const int numSamples = 4096;
+        HeapBlock<float> input (numSamples), output (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            input[i] = (float) std::sin (i * 0.05);
+
+        beginTest ("Unity ratio is a pure delay");
+        {
+            for (int q = WindowedSincInterpolator::linearQuality; q <= WindowedSincInterpolator::bestQuality; ++q)
+            {
+                WindowedSincInterpolator interpolator ((WindowedSincInterpolator::Quality) q);
+                expectEquals (interpolator.process (1.0, input, output, numSamples), numSamples);
+
+                auto latency = interpolator.getLatencyInSamples();
+                expectEquals (output[latency + 100], input[100]);
+            }
+        }
+
+        beginTest ("Resampling a sine");
+        {
+            for (int q = WindowedSincInterpolator::lowQuality; q <= WindowedSincInterpolator::bestQuality; ++q)
+            {
+                WindowedSincInterpolator interpolator ((WindowedSincInterpolator::Quality) q);
+                const double ratio = 0.7;
+                const int numOut = 2000;
+
+                expectEquals (interpolator.getNumInputSamplesNeeded (ratio, numOut),
+                              interpolator.process (ratio, input, output, numOut));
+
+                auto latency = interpolator.getLatencyInSamples();
+                float maxError = 0;
+
+                for (int i = 200; i < numOut; ++i)
+                {
+                    auto expected = (float) std::sin ((i * ratio - latency) * 0.05);
+                    maxError = jmax (maxError, std::abs (output[i] - expected));
+                }
+
+                expect (maxError < 0.01f);
+            }
+        }
+
+        beginTest ("Random access");
+        {
+            for (int q = WindowedSincInterpolator::linearQuality; q <= WindowedSincInterpolator::bestQuality; ++q)
+            {
+                WindowedSincInterpolator interpolator ((WindowedSincInterpolator::Quality) q);
+                auto tolerance = q == WindowedSincInterpolator::linearQuality ? 0.002f : 0.01f;
+
+                for (double pos = 100.0; pos < 3000.0; pos += 37.3)
+                {
+                    auto expected = (float) std::sin (pos * 0.05);
+                    expect (std::abs (interpolator.valueAt (input, numSamples, pos) - expected) < tolerance);
+                    expect (std::abs (interpolator.valueAt (input, numSamples, pos, 2.5) - expected) < 0.05f);
+                }
+
+                expectEquals (interpolator.valueAt (input, numSamples, -1000.0), 0.0f);
+            }
+        }
+    }
+};
+
+static WindowedSincInterpolatorTests windowedSincInterpolatorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Interpolator for resampling a stream of floats using a windowed-sinc filter.
+
+    This uses a polyphase table of Kaiser-windowed sinc coefficients, which is
+    shared between all instances that use the same quality setting. The number of
+    filter taps depends on the quality, so you can trade alias rejection against
+    CPU use. The inner loops use SSE or NEON where they're available.
+
+    It can be used in the same way as a LagrangeInterpolator, by repeatedly calling
+    process() on a continuous stream of samples, in which case the output is delayed
+    by getLatencyInSamples(). Or it can be used to read from random positions in a
+    block of samples with valueAt(), which is how SamplerVoice uses it.
+
+    Like the other interpolators, this is stateful when used with process(), so call
+    reset() when there's a break in the input stream, and use a separate object for
+    each channel.
+
+    @see LagrangeInterpolator, CatmullRomInterpolator, ResamplingAudioSource
+*/
+class JUCE_API  WindowedSincInterpolator
+{
+public:
+    //==============================================================================
+    /** The available quality settings. */
+    enum Quality
+    {
+        linearQuality = 0,  /**< Plain linear interpolation between neighbouring samples.
+                                 This is the cheapest, but has the poorest alias rejection. */
+        lowQuality,         /**< An 8-point windowed sinc. */
+        mediumQuality,      /**< A 16-point windowed sinc. */
+        highQuality,        /**< A 32-point windowed sinc. */
+        bestQuality         /**< A 64-point windowed sinc. */
+    };
+
+    //==============================================================================
+    /** Creates an interpolator with the given quality. */
+    WindowedSincInterpolator (Quality quality = mediumQuality);
+
+    /** Destructor. */
+    ~WindowedSincInterpolator() noexcept;
+
+    //==============================================================================
+    /** Changes the quality setting. This also resets the interpolator's state. */
+    void setQuality (Quality newQuality);
+
+    /** Returns the current quality setting. */
+    Quality getQuality() const noexcept                 { return quality; }
+
+    /** Returns the number of input samples that are used to calculate each output sample. */
+    int getNumTaps() const noexcept;
+
+    /** Returns the number of samples by which process() delays its input. */
+    int getLatencyInSamples() const noexcept            { return getNumTaps() / 2; }
+
+    /** Resets the state of the interpolator.
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Resamples a stream of samples.
+
+        Note that this doesn't low-pass the input for speed ratios above 1.0, so when
+        down-sampling, you should filter the input first if its content would alias.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples.
+        @param outputSamples    the buffer to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+        @see getNumInputSamplesNeeded
+    */
+    int process (double speedRatio,
+                 const float* inputSamples,
+                 float* outputSamples,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a stream of samples, adding the results to the output data
+        with a gain.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples.
+        @param outputSamples    the buffer to write the results to - the result values will be added
+                                to any pre-existing data in this buffer after being multiplied by
+                                the gain factor
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param gain             a gain factor to multiply the resulting samples by before
+                                adding them to the destination buffer
+
+        @returns the actual number of input samples that were used
+    */
+    int processAdding (double speedRatio,
+                       const float* inputSamples,
+                       float* outputSamples,
+                       int numOutputSamplesToProduce,
+                       float gain) noexcept;
+
+    /** Returns the exact number of input samples that the next call to process() will use
+        to produce the given number of output samples.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept;
+
+    //==============================================================================
+    /** Returns the interpolated value at a fractional position in a block of samples.
+
+        Samples outside the range 0 to numSamples are treated as silence. This doesn't use
+        or change the interpolator's stream state.
+
+        If speedRatio is greater than 1.0, the filter is widened (by up to 4 times) so that
+        its cut-off frequency follows the rate at which the data is being read, preventing
+        aliasing when a sample is pitched upwards.
+    */
+    float valueAt (const float* samples, int numSamples, double position, double speedRatio = 1.0) const noexcept;
+
+private:
+    //==============================================================================
+    struct Kernel;
+    const Kernel* kernel = nullptr;
+    static const Kernel* getKernel (Quality) noexcept;
+
+    Quality quality = mediumQuality;
+    HeapBlock<float> history;
+    int historySize = 0, historyPos = 0;
+    double subSamplePos = 1.0;
+
+    void pushSample (float) noexcept;
+    float valueFromHistory (float offset) const noexcept;
+
+    template <bool isAdding>
+    int interpolate (double speedRatio, const float* in, float* out, int numOut, float gain) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WindowedSincInterpolator)
+};
+
+} // namespace juce
@@ -37,6 +37,19 @@
 
 #if JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
+
+ // The FloatVectorOperations can switch to AVX or AVX-512 versions at runtime, which
+ // needs a compiler that can generate those without the whole file being built for them.
+ #ifndef JUCE_USE_AVX_DISPATCH
+  #if (JUCE_MSVC && _MSC_VER >= 1911) || JUCE_CLANG \
+        || (JUCE_GCC && ! JUCE_MINGW && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409)
+   #define JUCE_USE_AVX_DISPATCH 1
+  #endif
+ #endif
+
+ #if JUCE_USE_AVX_DISPATCH
+  #include <immintrin.h>
+ #endif
 #endif
 
 #ifndef JUCE_USE_VDSP_FRAMEWORK
@@ -59,6 +72,7 @@
 #include "effects/juce_IIRFilter.cpp"
 #include "effects/juce_LagrangeInterpolator.cpp"
 #include "effects/juce_CatmullRomInterpolator.cpp"
+#include "effects/juce_WindowedSincInterpolator.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
@@ -79,6 +93,7 @@
 #include "sources/juce_IIRFilterAudioSource.cpp"
 #include "sources/juce_MemoryAudioSource.cpp"
 #include "sources/juce_MixerAudioSource.cpp"
+#include "sources/juce_MultiTrackStreamingAudioSource.cpp"
 #include "sources/juce_ResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
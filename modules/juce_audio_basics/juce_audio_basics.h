@@ -88,7 +88,9 @@
 #include "effects/juce_IIRFilter.h"
 #include "effects/juce_LagrangeInterpolator.h"
 #include "effects/juce_CatmullRomInterpolator.h"
+#include "effects/juce_WindowedSincInterpolator.h"
 #include "effects/juce_LinearSmoothedValue.h"
+#include "effects/juce_MultiplicativeSmoothedValue.h"
 #include "effects/juce_Reverb.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
@@ -112,6 +114,7 @@
 #include "sources/juce_IIRFilterAudioSource.h"
 #include "sources/juce_MemoryAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
+#include "sources/juce_MultiTrackStreamingAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
@@ -69,7 +69,7 @@ namespace MidiBufferHelpers
         return size;
     }
 
-    static uint8* findEventAfter (uint8* d, uint8* endData, const int samplePosition) noexcept
+    static const uint8* findEventAfter (const uint8* d, const uint8* endData, const int samplePosition) noexcept
     {
         while (d < endData && getEventTime (d) <= samplePosition)
             d += getEventTotalSize (d);
@@ -102,8 +102,8 @@ bool MidiBuffer::isEmpty() const noexcept                   { return data.size()
 
 void MidiBuffer::clear (const int startSample, const int numSamples)
 {
-    uint8* const start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
-    uint8* const end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
+    auto* const start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
+    auto* const end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
     data.removeRange ((int) (start - data.begin()), (int) (end - data.begin()));
 }
@@ -136,17 +136,109 @@ void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             const int numSamples,
                             const int sampleDeltaToAdd)
 {
-    Iterator i (otherBuffer);
-    i.setNextSamplePosition (startSample);
+    if (&otherBuffer == this)
+    {
+        const MidiBuffer copy (otherBuffer);
+        addEvents (copy, startSample, numSamples, sampleDeltaToAdd);
+        return;
+    }
+
+    // the events to add are a contiguous, already-sorted run of the other buffer's data
+    auto* otherEnd = otherBuffer.data.end();
+
+    auto* sourceStart = MidiBufferHelpers::findEventAfter (otherBuffer.data.begin(), otherEnd, startSample - 1);
+    auto* sourceEnd   = numSamples < 0 ? otherEnd
+                                       : MidiBufferHelpers::findEventAfter (sourceStart, otherEnd, startSample + numSamples - 1);
+
+    if (sourceStart >= sourceEnd)
+        return;
 
-    const uint8* eventData;
-    int eventSize, position;
+    auto tailStart = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(),
+                                                               MidiBufferHelpers::getEventTime (sourceStart) + sampleDeltaToAdd)
+                              - data.begin());
+    auto newEventsStart = data.size();
 
-    while (i.getNextEvent (eventData, eventSize, position)
-            && (position < startSample + numSamples || numSamples < 0))
+    data.addArray (sourceStart, (int) (sourceEnd - sourceStart));
+
+    if (sampleDeltaToAdd != 0)
     {
-        addEvent (eventData, eventSize, position + sampleDeltaToAdd);
+        for (auto* d = data.begin() + newEventsStart; d < data.end(); d += MidiBufferHelpers::getEventTotalSize (d))
+            writeUnaligned<int32> (d, MidiBufferHelpers::getEventTime (d) + sampleDeltaToAdd);
     }
+
+    mergeWithTail (tailStart, newEventsStart);
+}
+
+void MidiBuffer::addSortedEvents (const MidiMessageMetadata* events, int numEvents)
+{
+    if (numEvents <= 0)
+        return;
+
+    auto tailStart = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), events[0].samplePosition) - data.begin());
+    auto newEventsStart = data.size();
+
+    size_t totalSize = 0;
+
+    for (int i = 0; i < numEvents; ++i)
+        totalSize += (size_t) jmax (0, events[i].numBytes) + sizeof (int32) + sizeof (uint16);
+
+    data.ensureStorageAllocated (newEventsStart + (int) totalSize);
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        auto& e = events[i];
+
+        // the events must be sorted by their sample positions!
+        jassert (i == 0 || e.samplePosition >= events[i - 1].samplePosition);
+
+        auto numBytes = e.numBytes > 0 ? MidiBufferHelpers::findActualEventLength (e.data, e.numBytes) : 0;
+
+        if (numBytes > 0)
+        {
+            auto offset = data.size();
+            data.insertMultiple (-1, 0, numBytes + (int) (sizeof (int32) + sizeof (uint16)));
+
+            auto* d = data.begin() + offset;
+            writeUnaligned<int32>  (d, e.samplePosition);
+            writeUnaligned<uint16> (d + 4, static_cast<uint16> (numBytes));
+            memcpy (d + 6, e.data, (size_t) numBytes);
+        }
+    }
+
+    mergeWithTail (tailStart, newEventsStart);
+}
+
+void MidiBuffer::mergeWithTail (const int tailStart, const int newEventsStart)
+{
+    // Merges the existing events from tailStart onwards with the sorted block of new
+    // events that has just been appended at newEventsStart, keeping the existing ones
+    // first when their times are equal.
+    if (tailStart >= newEventsStart || newEventsStart >= data.size())
+        return;
+
+    auto numBytes = (size_t) (data.size() - tailStart);
+    HeapBlock<uint8> merged (numBytes);
+
+    auto* oldEvent = data.begin() + tailStart;
+    auto* oldEnd   = data.begin() + newEventsStart;
+    auto* newEvent = oldEnd;
+    auto* newEnd   = data.end();
+    auto* dest     = merged.get();
+
+    while (oldEvent < oldEnd || newEvent < newEnd)
+    {
+        auto takeOld = newEvent >= newEnd
+                        || (oldEvent < oldEnd && MidiBufferHelpers::getEventTime (oldEvent) <= MidiBufferHelpers::getEventTime (newEvent));
+
+        auto*& source = takeOld ? oldEvent : newEvent;
+        auto size = MidiBufferHelpers::getEventTotalSize (source);
+
+        memcpy (dest, source, size);
+        dest += size;
+        source += size;
+    }
+
+    memcpy (data.begin() + tailStart, merged, numBytes);
 }
 
 int MidiBuffer::getNumEvents() const noexcept
@@ -183,6 +275,17 @@ int MidiBuffer::getLastEventTime() const noexcept
     }
 }
 
+MidiBufferIterator MidiBuffer::findNextSamplePosition (const int samplePosition) const noexcept
+{
+    auto* d = data.begin();
+    auto* endData = data.end();
+
+    while (d < endData && MidiBufferHelpers::getEventTime (d) < samplePosition)
+        d += MidiBufferHelpers::getEventTotalSize (d);
+
+    return MidiBufferIterator (d);
+}
+
 //==============================================================================
 MidiBuffer::Iterator::Iterator (const MidiBuffer& b) noexcept
     : buffer (b), data (b.data.begin())
@@ -227,4 +330,143 @@ bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePositio
     return true;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiBufferTests  : public UnitTest
+{
+public:
+    MidiBufferTests() : UnitTest ("MidiBuffer", "MIDI/MPE") {}
+
+    static MidiBuffer createRandomBuffer (Random& r, int numEvents, int maxTime)
+    {
+        MidiBuffer b;
+
+        for (int i = 0; i < numEvents; ++i)
+            b.addEvent (MidiMessage::noteOn (1 + r.nextInt (16), r.nextInt (128), (uint8) (1 + r.nextInt (127))),
+                        r.nextInt (maxTime));
+
+        return b;
+    }
+
+    void expectIdentical (const MidiBuffer& a, const MidiBuffer& b)
+    {
+        auto i = a.begin(), j = b.begin();
+
+        for (; i != a.end() && j != b.end(); ++i, ++j)
+        {
+            auto x = *i, y = *j;
+
+            if (x.samplePosition != y.samplePosition || x.numBytes != y.numBytes
+                 || memcmp (x.data, y.data, (size_t) x.numBytes) != 0)
+                break;
+        }
+
+        expect (i == a.end() && j == b.end());
+    }
+
+    void runTest() override
+    {
+        Random r = getRandom();
+
+        beginTest ("Range-based iteration");
+        {
+            auto buffer = createRandomBuffer (r, 200, 1000);
+            buffer.addEvent (MidiMessage::createSysExMessage ("abcdefg", 7), 500);
+
+            MidiBuffer::Iterator i (buffer);
+            const uint8* data;
+            int numBytes, position, numEvents = 0;
+
+            for (const auto metadata : buffer)
+            {
+                expect (i.getNextEvent (data, numBytes, position));
+                expect (metadata.data == data);
+                expectEquals (metadata.numBytes, numBytes);
+                expectEquals (metadata.samplePosition, position);
+                expect (metadata.getMessage().getRawDataSize() == numBytes);
+                ++numEvents;
+            }
+
+            expect (! i.getNextEvent (data, numBytes, position));
+            expectEquals (numEvents, buffer.getNumEvents());
+
+            auto it = buffer.findNextSamplePosition (500);
+            expect (it == buffer.end() || (*it).samplePosition >= 500);
+
+            for (auto e = buffer.begin(); e != it; ++e)
+                expect ((*e).samplePosition < 500);
+
+            expect (buffer.findNextSamplePosition (1000) == buffer.end());
+            expect (MidiBuffer().begin() == MidiBuffer().end());
+        }
+
+        beginTest ("addSortedEvents");
+        {
+            for (int test = 0; test < 20; ++test)
+            {
+                auto buffer = createRandomBuffer (r, r.nextInt (50), 1000);
+                auto reference = buffer;
+
+                Array<MidiMessage> messages;
+                Array<MidiMessageMetadata> events;
+                auto time = test < 5 ? 1000 : r.nextInt (200);
+
+                for (int i = r.nextInt (100); --i >= 0;)
+                {
+                    time += r.nextInt (20);
+                    messages.add (MidiMessage::noteOff (1, r.nextInt (128)));
+                }
+
+                time = test < 5 ? 1000 : 0;
+
+                for (auto& m : messages)
+                {
+                    time += r.nextInt (20);
+                    events.add ({ m.getRawData(), m.getRawDataSize(), time });
+                    reference.addEvent (m, time);
+                }
+
+                buffer.addSortedEvents (events.begin(), events.size());
+                expectIdentical (buffer, reference);
+            }
+        }
+
+        beginTest ("addEvents");
+        {
+            for (int test = 0; test < 20; ++test)
+            {
+                auto buffer = createRandomBuffer (r, r.nextInt (50), 1000);
+                auto source = createRandomBuffer (r, r.nextInt (100), 1000);
+                auto reference = buffer;
+
+                auto start = r.nextInt (500);
+                auto num = r.nextInt (700) - 100;
+                auto delta = r.nextInt (400) - 200;
+
+                MidiBuffer::Iterator i (source);
+                i.setNextSamplePosition (start);
+                const uint8* data;
+                int numBytes, position;
+
+                while (i.getNextEvent (data, numBytes, position) && (position < start + num || num < 0))
+                    reference.addEvent (data, numBytes, position + delta);
+
+                buffer.addEvents (source, start, num, delta);
+                expectIdentical (buffer, reference);
+            }
+
+            auto buffer = createRandomBuffer (r, 30, 100);
+            auto reference = buffer;
+            reference.addEvents (MidiBuffer (buffer), 0, -1, 50);
+            buffer.addEvents (buffer, 0, -1, 50);
+            expectIdentical (buffer, reference);
+        }
+    }
+};
+
+static MidiBufferTests midiBufferTests;
+
+#endif
+
 } // namespace juce
@@ -23,6 +23,110 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    A lightweight view of one of the events in a MidiBuffer.
+
+    This just points at the event's data inside the buffer, so it's only valid until
+    the buffer is next modified. It's also the format used to pass sorted events
+    to MidiBuffer::addSortedEvents().
+
+    @see MidiBuffer, MidiBufferIterator
+*/
+struct JUCE_API  MidiMessageMetadata
+{
+    /** Creates an empty event. */
+    MidiMessageMetadata() noexcept {}
+
+    /** Creates an event referring to some raw midi data. */
+    MidiMessageMetadata (const uint8* midiData, int numBytesOfData, int position) noexcept
+        : data (midiData), numBytes (numBytesOfData), samplePosition (position)
+    {
+    }
+
+    /** Creates a MidiMessage containing a copy of this event's data. The message's
+        timestamp will be set to the event's sample position.
+    */
+    MidiMessage getMessage() const          { return MidiMessage (data, numBytes, samplePosition); }
+
+    /** A pointer to the raw midi data. */
+    const uint8* data = nullptr;
+
+    /** The number of bytes of midi data. */
+    int numBytes = 0;
+
+    /** The event's position, as a sample index in the buffer. */
+    int samplePosition = 0;
+};
+
+//==============================================================================
+/**
+    A forward iterator over the events in a MidiBuffer.
+
+    Dereferencing it returns a MidiMessageMetadata that points directly into the
+    buffer's data, so stepping through a buffer doesn't copy any events. You'll
+    normally get these from MidiBuffer::begin() and end(), which means you can use
+    a range-based for loop:
+
+    @code
+    for (const auto metadata : midiBuffer)
+        if (metadata.numBytes == 3 && (metadata.data[0] & 0xf0) == 0x90)
+            startNote (metadata.samplePosition, metadata.data[1]);
+    @endcode
+
+    As with MidiBuffer::Iterator, altering the buffer while an iterator is using it
+    will produce undefined behaviour.
+
+    @see MidiBuffer, MidiMessageMetadata
+*/
+class JUCE_API  MidiBufferIterator
+{
+public:
+    //==============================================================================
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = MidiMessageMetadata;
+    using reference         = MidiMessageMetadata;
+    using pointer           = void;
+    using iterator_category = std::forward_iterator_tag;
+
+    /** Creates an iterator pointing at the event which starts at the given address
+        in a MidiBuffer's data.
+    */
+    explicit MidiBufferIterator (const uint8* eventData) noexcept   : data (eventData) {}
+
+    /** Moves on to the next event. */
+    MidiBufferIterator& operator++() noexcept
+    {
+        data += headerSize + readUnaligned<uint16> (data + sizeof (int32));
+        return *this;
+    }
+
+    /** Moves on to the next event, returning an iterator to the previous one. */
+    MidiBufferIterator operator++ (int) noexcept
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    bool operator== (const MidiBufferIterator& other) const noexcept    { return data == other.data; }
+    bool operator!= (const MidiBufferIterator& other) const noexcept    { return data != other.data; }
+
+    /** Returns a view of the event that the iterator is pointing at. */
+    MidiMessageMetadata operator*() const noexcept
+    {
+        return { data + headerSize,
+                 (int) readUnaligned<uint16> (data + sizeof (int32)),
+                 (int) readUnaligned<int32> (data) };
+    }
+
+private:
+    // each event is stored as its int32 sample position, then its uint16 size, then the data
+    enum { headerSize = sizeof (int32) + sizeof (uint16) };
+
+    const uint8* data;
+};
+
 //==============================================================================
 /**
     Holds a sequence of time-stamped midi events.
@@ -132,6 +236,18 @@ public:
                     int numSamples,
                     int sampleDeltaToAdd);
 
+    /** Adds a block of events which are already sorted by their sample positions.
+
+        This is much quicker than calling addEvent() for each one. Events that come
+        after everything already in the buffer are just appended, and otherwise the new
+        events are merged with the existing ones in a single pass. As with addEvent(),
+        new events go after any existing events which have the same sample position,
+        and events with invalid midi data are skipped.
+
+        The events' data is copied, so it doesn't need to stay valid after this call.
+    */
+    void addSortedEvents (const MidiMessageMetadata* events, int numEvents);
+
     /** Returns the sample number of the first event in the buffer.
         If the buffer's empty, this will just return 0.
     */
@@ -156,10 +272,26 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    //==============================================================================
+    /** Returns an iterator pointing at the first event in the buffer. */
+    MidiBufferIterator begin() const noexcept               { return MidiBufferIterator (data.begin()); }
+
+    /** Returns an iterator pointing just past the last event in the buffer. */
+    MidiBufferIterator end() const noexcept                 { return MidiBufferIterator (data.end()); }
+
+    /** Returns an iterator pointing at the first event whose sample position is
+        greater than or equal to the given position, or end() if there isn't one.
+    */
+    MidiBufferIterator findNextSamplePosition (int samplePosition) const noexcept;
+
     //==============================================================================
     /**
         Used to iterate through the events in a MidiBuffer.
 
+        A MidiBufferIterator (which you can get from begin(), end() and
+        findNextSamplePosition()) does the same job without copying anything, and
+        lets you use a range-based for loop.
+
         Note that altering the buffer while an iterator is using it will produce
         undefined behaviour.
 
@@ -229,6 +361,8 @@ public:
     Array<uint8> data;
 
 private:
+    void mergeWithTail (int tailStart, int newEventsStart);
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
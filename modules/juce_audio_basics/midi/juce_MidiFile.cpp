@@ -261,44 +261,64 @@ double MidiFile::getLastTimestamp() const
 //==============================================================================
 bool MidiFile::readFrom (InputStream& sourceStream)
 {
-    clear();
+    // if the data's already in memory, there's no need to copy it
+    if (auto* memoryStream = dynamic_cast<MemoryInputStream*> (&sourceStream))
+    {
+        auto position = (size_t) memoryStream->getPosition();
+        auto numBytes = memoryStream->getDataSize() - position;
+        memoryStream->setPosition ((int64) memoryStream->getDataSize());
+
+        return readFrom (addBytesToPointer (memoryStream->getData(), position), numBytes);
+    }
+
     MemoryBlock data;
 
     const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
 
     // (put a sanity-check on the file size, as midi files are generally small)
     if (sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize))
-    {
-        size_t size = data.getSize();
-        const uint8* d = static_cast<const uint8*> (data.getData());
-        short fileType, expectedTracks;
+        return readFrom (data.getData(), data.getSize());
 
-        if (size > 16 && MidiFileHelpers::parseMidiHeader (d, timeFormat, fileType, expectedTracks))
-        {
-            size -= (size_t) (d - static_cast<const uint8*> (data.getData()));
+    clear();
+    return false;
+}
+
+bool MidiFile::readFrom (const void* data, size_t size)
+{
+    clear();
 
-            int track = 0;
+    const uint8* d = static_cast<const uint8*> (data);
+    short fileType, expectedTracks;
 
-            while (size > 0 && track < expectedTracks)
-            {
-                const int chunkType = (int) ByteOrder::bigEndianInt (d);
-                d += 4;
-                const int chunkSize = (int) ByteOrder::bigEndianInt (d);
-                d += 4;
+    if (size > 16 && MidiFileHelpers::parseMidiHeader (d, timeFormat, fileType, expectedTracks))
+    {
+        size -= jmin (size, (size_t) (d - static_cast<const uint8*> (data)));
 
-                if (chunkSize <= 0)
-                    break;
+        int track = 0;
 
-                if (chunkType == (int) ByteOrder::bigEndianInt ("MTrk"))
-                    readNextTrack (d, chunkSize);
+        while (size > 8 && track < expectedTracks)
+        {
+            const int chunkType = (int) ByteOrder::bigEndianInt (d);
+            d += 4;
+            int chunkSize = (int) ByteOrder::bigEndianInt (d);
+            d += 4;
+            size -= 8;
 
-                size -= (size_t) chunkSize + 8;
-                d += chunkSize;
-                ++track;
-            }
+            if (chunkSize <= 0)
+                break;
+
+            // a truncated file may claim that its last chunk is bigger than what's left
+            chunkSize = (int) jmin ((size_t) chunkSize, size);
+
+            if (chunkType == (int) ByteOrder::bigEndianInt ("MTrk"))
+                readNextTrack (d, chunkSize);
 
-            return true;
+            size -= (size_t) chunkSize;
+            d += chunkSize;
+            ++track;
         }
+
+        return true;
     }
 
     return false;
@@ -311,6 +331,9 @@ void MidiFile::readNextTrack (const uint8* data, int size)
 
     MidiMessageSequence result;
 
+    // every event takes at least a couple of bytes, so this is roughly an upper bound
+    result.list.ensureStorageAllocated (size / 3);
+
     while (size > 0)
     {
         int bytesUsed;
@@ -339,8 +362,8 @@ void MidiFile::readNextTrack (const uint8* data, int size)
     MidiFileHelpers::Sorter sorter;
     result.list.sort (sorter, true);
 
-    addTrack (result);
-    tracks.getLast()->updateMatchedPairs();
+    result.updateMatchedPairs();
+    tracks.add (new MidiMessageSequence (static_cast<MidiMessageSequence&&> (result)));
 }
 
 //==============================================================================
@@ -153,6 +153,22 @@ public:
     */
     bool readFrom (InputStream& sourceStream);
 
+    /** Reads a midi file from a block of memory.
+
+        This is the same as readFrom (InputStream&), but it parses the data where it is,
+        rather than copying it first, so for a large file on disk you can use a
+        MemoryMappedFile to avoid loading it all into memory:
+        @code
+        MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() != nullptr)
+            midiFile.readFrom (mappedFile.getData(), mappedFile.getSize());
+        @endcode
+
+        @returns true if the data was read successfully
+    */
+    bool readFrom (const void* data, size_t numBytes);
+
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
         or 2 - see the midi file spec for more info about that.
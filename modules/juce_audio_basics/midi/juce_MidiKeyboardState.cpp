@@ -25,7 +25,9 @@ namespace juce
 
 MidiKeyboardState::MidiKeyboardState()
 {
-    zerostruct (noteStates);
+    for (auto& channel : noteStates)
+        for (auto& bits : channel)
+            bits = 0;
 }
 
 MidiKeyboardState::~MidiKeyboardState()
@@ -36,22 +38,60 @@ MidiKeyboardState::~MidiKeyboardState()
 void MidiKeyboardState::reset()
 {
     const ScopedLock sl (lock);
-    zerostruct (noteStates);
+
+    for (auto& channel : noteStates)
+        for (auto& bits : channel)
+            bits = 0;
+
+    ++numStateChanges;
     eventsToAdd.clear();
 }
 
+static inline uint64 getNoteBit (int midiNoteNumber) noexcept
+{
+    return ((uint64) 1) << (midiNoteNumber & 63);
+}
+
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
 {
     jassert (midiChannel >= 0 && midiChannel <= 16);
 
     return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & (1 << (midiChannel - 1))) != 0;
+            && isPositiveAndBelow (midiChannel - 1, 16)
+            && (noteStates[midiChannel - 1][n >> 6].load() & getNoteBit (n)) != 0;
 }
 
 bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const int n) const noexcept
 {
-    return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & midiChannelMask) != 0;
+    if (! isPositiveAndBelow (n, 128))
+        return false;
+
+    for (int i = 0; i < 16; ++i)
+        if ((midiChannelMask & (1 << i)) != 0 && (noteStates[i][n >> 6].load() & getNoteBit (n)) != 0)
+            return true;
+
+    return false;
+}
+
+BigInteger MidiKeyboardState::getNotesOnForChannels (const int midiChannelMask) const
+{
+    uint64 bits[2] = {};
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((midiChannelMask & (1 << i)) != 0)
+        {
+            bits[0] |= noteStates[i][0].load();
+            bits[1] |= noteStates[i][1].load();
+        }
+    }
+
+    BigInteger notes;
+    notes.setBitRangeAsInt (96, 32, (uint32) (bits[1] >> 32));
+    notes.setBitRangeAsInt (64, 32, (uint32) bits[1]);
+    notes.setBitRangeAsInt (32, 32, (uint32) (bits[0] >> 32));
+    notes.setBitRangeAsInt (0,  32, (uint32) bits[0]);
+    return notes;
 }
 
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
@@ -73,9 +113,10 @@ void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber,
 
 void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    if (isPositiveAndBelow (midiNoteNumber, 128))
+    if (isPositiveAndBelow (midiNoteNumber, 128) && isPositiveAndBelow (midiChannel - 1, 16))
     {
-        noteStates [midiNoteNumber] |= (1 << (midiChannel - 1));
+        noteStates[midiChannel - 1][midiNoteNumber >> 6] |= getNoteBit (midiNoteNumber);
+        ++numStateChanges;
 
         for (int i = listeners.size(); --i >= 0;)
             listeners.getUnchecked(i)->handleNoteOn (this, midiChannel, midiNoteNumber, velocity);
@@ -100,7 +141,8 @@ void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiN
 {
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        noteStates [midiNoteNumber] &= ~(1 << (midiChannel - 1));
+        noteStates[midiChannel - 1][midiNoteNumber >> 6] &= ~getNoteBit (midiNoteNumber);
+        ++numStateChanges;
 
         for (int i = listeners.size(); --i >= 0;)
             listeners.getUnchecked(i)->handleNoteOff (this, midiChannel, midiNoteNumber, velocity);
@@ -113,6 +113,22 @@ public:
     */
     bool isNoteOnForChannels (int midiChannelMask, int midiNoteNumber) const noexcept;
 
+    /** Returns all the keys that are held down on any of a set of midi channels.
+
+        Bit n of the result is set if midi note n is on. The channel mask works in the same
+        way as for isNoteOnForChannels(). This doesn't lock anything or allocate any memory,
+        so it's a quick way to get the whole keyboard, e.g. for comparing it with the keys
+        that a display has already drawn.
+    */
+    BigInteger getNotesOnForChannels (int midiChannelMask) const;
+
+    /** Returns a number that changes whenever a key goes up or down, or the state is reset.
+
+        Something that's displaying the keyboard can check this regularly, and only needs
+        to look at the state again when it's different from the last time it checked.
+    */
+    uint32 getNumStateChanges() const noexcept          { return numStateChanges.load(); }
+
     /** Turns a specified note on.
 
         This will cause a suitable midi note-on event to be injected into the midi buffer during the
@@ -189,7 +205,9 @@ public:
 private:
     //==============================================================================
     CriticalSection lock;
-    uint16 noteStates [128];
+    // a 128-bit set of notes for each channel, which can be read without the lock
+    std::atomic<uint64> noteStates[16][2];
+    std::atomic<uint32> numStateChanges { 0 };
     MidiBuffer eventsToAdd;
     Array <MidiKeyboardStateListener*> listeners;
 
@@ -107,14 +107,11 @@ int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcep
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
+    // the events are kept in time order, so this can use a binary search
+    auto* found = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                    [] (const MidiEventHolder* e, double t) { return e->message.getTimeStamp() < t; });
 
-    int i;
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked(i)->message.getTimeStamp() >= timeStamp)
-            break;
-
-    return i;
+    return (int) (found - list.begin());
 }
 
 //==============================================================================
@@ -142,12 +139,11 @@ MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiEventHo
     newEvent->message.addToTimeStamp (timeAdjustment);
     auto time = newEvent->message.getTimeStamp();
 
-    int i;
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.getTimeStamp() <= time)
-            break;
+    // goes after any other events with the same time
+    auto* insertPoint = std::upper_bound (list.begin(), list.end(), time,
+                                          [] (double t, const MidiEventHolder* e) { return t < e->message.getTimeStamp(); });
 
-    list.insert (i + 1, newEvent);
+    list.insert ((int) (insertPoint - list.begin()), newEvent);
     return newEvent;
 }
 
@@ -172,8 +168,46 @@ void MidiMessageSequence::deleteEvent (int index, bool deleteMatchingNoteUp)
     }
 }
 
+struct MidiMessageSequenceSorter
+{
+    static int compareElements (const MidiMessageSequence::MidiEventHolder* first,
+                                const MidiMessageSequence::MidiEventHolder* second) noexcept
+    {
+        auto diff = first->message.getTimeStamp() - second->message.getTimeStamp();
+        return (diff > 0) - (diff < 0);
+    }
+
+    static bool isEarlier (const MidiMessageSequence::MidiEventHolder* first,
+                           const MidiMessageSequence::MidiEventHolder* second) noexcept
+    {
+        return first->message.getTimeStamp() < second->message.getTimeStamp();
+    }
+
+    // After adding some events to the end of a list, this merges them into place. That's
+    // linear rather than n log n, and gives the same order as a stable sort would.
+    static void mergeAddedEvents (OwnedArray<MidiMessageSequence::MidiEventHolder>& list, int numOldEvents)
+    {
+        auto* start = list.begin();
+        auto* middle = start + numOldEvents;
+        auto* end = list.end();
+
+        if (std::is_sorted (start, middle, isEarlier) && std::is_sorted (middle, end, isEarlier))
+        {
+            std::inplace_merge (start, middle, end, isEarlier);
+        }
+        else
+        {
+            MidiMessageSequenceSorter sorter;
+            list.sort (sorter, true);
+        }
+    }
+};
+
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double timeAdjustment)
 {
+    auto numOldEvents = list.size();
+    list.ensureStorageAllocated (numOldEvents + other.getNumEvents());
+
     for (auto* m : other)
     {
         auto newOne = new MidiEventHolder (m->message);
@@ -181,7 +215,7 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double
         list.add (newOne);
     }
 
-    sort();
+    MidiMessageSequenceSorter::mergeAddedEvents (list, numOldEvents);
 }
 
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
@@ -189,6 +223,8 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
                                        double firstAllowableTime,
                                        double endOfAllowableDestTimes)
 {
+    auto numOldEvents = list.size();
+
     for (auto* m : other)
     {
         auto t = m->message.getTimeStamp() + timeAdjustment;
@@ -201,19 +237,9 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
         }
     }
 
-    sort();
+    MidiMessageSequenceSorter::mergeAddedEvents (list, numOldEvents);
 }
 
-struct MidiMessageSequenceSorter
-{
-    static int compareElements (const MidiMessageSequence::MidiEventHolder* first,
-                                const MidiMessageSequence::MidiEventHolder* second) noexcept
-    {
-        auto diff = first->message.getTimeStamp() - second->message.getTimeStamp();
-        return (diff > 0) - (diff < 0);
-    }
-};
-
 void MidiMessageSequence::sort() noexcept
 {
     MidiMessageSequenceSorter sorter;
@@ -222,42 +248,57 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
+    // Each note-on is paired with the next note-on or note-off for the same key, so a
+    // single pass that remembers the last unmatched note-on for each key will find them
+    // all. If that next event is another note-on, a note-off gets inserted just before it.
+    HeapBlock<MidiEventHolder*> unmatchedNoteOns (16 * 128, true);
+    Array<MidiEventHolder*> newList;
+    newList.ensureStorageAllocated (list.size());
+    bool anyInserted = false;
+
     for (int i = 0; i < list.size(); ++i)
     {
-        auto* meh = list.getUnchecked(i);
-        auto& m1 = meh->message;
+        auto* meh = list.getUnchecked (i);
+        auto& m = meh->message;
 
-        if (m1.isNoteOn())
+        if (m.isNoteOn() || m.isNoteOff())
         {
-            meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            auto chan = m.getChannel();
+            auto note = m.getNoteNumber();
+            auto& unmatched = unmatchedNoteOns[(chan - 1) * 128 + note];
 
-            for (int j = i + 1; j < len; ++j)
+            if (unmatched != nullptr)
             {
-                auto* meh2 = list.getUnchecked(j);
-                auto& m = meh2->message;
-
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
+                if (m.isNoteOn())
                 {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = meh2;
-                        break;
-                    }
-
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
+                    auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
+                    newEvent->message.setTimeStamp (m.getTimeStamp());
+                    unmatched->noteOffObject = newEvent;
+                    newList.add (newEvent);
+                    anyInserted = true;
                 }
+                else
+                {
+                    unmatched->noteOffObject = meh;
+                }
+
+                unmatched = nullptr;
+            }
+
+            if (m.isNoteOn())
+            {
+                meh->noteOffObject = nullptr;
+                unmatched = meh;
             }
         }
+
+        newList.add (meh);
+    }
+
+    if (anyInserted)
+    {
+        list.clear (false);
+        list.addArray (newList);
     }
 }
 
@@ -389,6 +430,49 @@ struct MidiMessageSequenceTest  : public juce::UnitTest
         expectEquals (s.getNumEvents(), 7);
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
+
+        beginTest ("Overlapping notes");
+        MidiMessageSequence s3;
+        s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+        s3.addEvent (MidiMessage::noteOn  (2, 60, 0.5f).withTimeStamp (1.0));
+        s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (2.0)); // retriggered before the first one ended
+        s3.addEvent (MidiMessage::noteOff (2, 60, 0.5f).withTimeStamp (3.0));
+        s3.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+        s3.updateMatchedPairs();
+
+        expectEquals (s3.getNumEvents(), 6);   // a note-off is inserted before the second note-on
+        expectEquals (s3.getTimeOfMatchingKeyUp (0), 2.0);
+        expectEquals (s3.getIndexOfMatchingKeyUp (0), 2);
+        expectEquals (s3.getTimeOfMatchingKeyUp (1), 3.0);
+        expectEquals (s3.getTimeOfMatchingKeyUp (3), 4.0);
+        expect (s3.getEventPointer (2)->message.isNoteOff());
+        expect (s3.getEventPointer (3)->message.isNoteOn());
+
+        beginTest ("Events with the same time");
+        MidiMessageSequence s4;
+
+        for (int i = 0; i < 10; ++i)
+            s4.addEvent (MidiMessage::controllerEvent (1, i, 0).withTimeStamp ((double) (i / 3)));
+
+        s4.addEvent (MidiMessage::controllerEvent (1, 10, 0).withTimeStamp (1.0));
+
+        expectEquals (s4.getNextIndexAtTime (1.0), 3);
+        expectEquals (s4.getNextIndexAtTime (1.5), 7);
+        expectEquals (s4.getNextIndexAtTime (-1.0), 0);
+        expectEquals (s4.getNextIndexAtTime (3.0), 10);
+        expectEquals (s4.getEventPointer (6)->message.getControllerNumber(), 10); // added after the others at that time
+
+        MidiMessageSequence s5;
+        s5.addEvent (MidiMessage::controllerEvent (2, 0, 0).withTimeStamp (1.0));
+        s5.addEvent (MidiMessage::controllerEvent (2, 1, 0).withTimeStamp (2.5));
+        s4.addSequence (s5, 0.0);
+
+        expectEquals (s4.getNumEvents(), 13);
+        expectEquals (s4.getEventPointer (7)->message.getChannel(), 2);   // merged after the existing events at 1.0
+        expectEquals (s4.getEventPointer (11)->message.getChannel(), 2);
+
+        for (int i = 1; i < s4.getNumEvents(); ++i)
+            expect (s4.getEventTime (i - 1) <= s4.getEventTime (i));
     }
 };
 
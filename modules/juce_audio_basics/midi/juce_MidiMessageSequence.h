@@ -124,6 +124,9 @@ public:
     /** Returns the index of the first event on or after the given timestamp.
         If the time is beyond the end of the sequence, this will return the
         number of events.
+
+        This is a binary search, so it's quick enough to call at the start and end of
+        each block of a playback callback to find the events that need playing.
     */
     int getNextIndexAtTime (double timeStamp) const noexcept;
 
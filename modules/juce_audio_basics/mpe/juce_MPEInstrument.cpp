@@ -29,8 +29,190 @@ namespace
     const Range<int> allChannels = Range<int> (1, 17);
 }
 
+//==============================================================================
+/*  A fixed-capacity table of the playing notes, which never allocates once it's
+    been created.
+
+    The notes live in slots that don't move while they're playing. As well as the
+    overall order in which the notes were added, the table keeps the order of the
+    notes on each MIDI channel and a direct (channel, note number) -> slot lookup,
+    so that per-channel expression messages never have to search the whole table.
+*/
+struct MPEInstrument::NoteTable
+{
+    enum { maxNumNotes = 16 * 128, noSlot = 0xffff };
+
+    NoteTable() noexcept
+    {
+        std::fill_n (&slotForNote[0][0], maxNumNotes, (uint16) noSlot);
+        std::fill_n (numNotesOnChannel, 16, (uint8) 0);
+
+        for (int i = 0; i < maxNumNotes; ++i)
+            freeSlots[i] = (uint16) (maxNumNotes - 1 - i);
+    }
+
+    int size() const noexcept                       { return numNotes; }
+    bool isEmpty() const noexcept                   { return numNotes == 0; }
+
+    MPENote& getReference (int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, numNotes));
+        return slots[order[index]];
+    }
+
+    MPENote operator[] (int index) const noexcept
+    {
+        return isPositiveAndBelow (index, numNotes) ? slots[order[index]] : MPENote();
+    }
+
+    MPENote* find (int midiChannel, int midiNoteNumber) noexcept
+    {
+        if (! (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128)))
+            return nullptr;
+
+        auto slot = slotForNote[midiChannel - 1][midiNoteNumber];
+        return slot != noSlot ? slots + slot : nullptr;
+    }
+
+    int getNumNotesOnChannel (int midiChannel) const noexcept
+    {
+        return isPositiveAndBelow (midiChannel - 1, 16) ? numNotesOnChannel[midiChannel - 1] : 0;
+    }
+
+    /** Returns one of the notes on a channel, in the order in which they were added. */
+    MPENote& getNoteOnChannel (int midiChannel, int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, getNumNotesOnChannel (midiChannel)));
+        return slots[slotForNote[midiChannel - 1][channelNotes[midiChannel - 1][index]]];
+    }
+
+    void add (const MPENote& newNote) noexcept
+    {
+        auto channel = newNote.midiChannel - 1;
+
+        jassert (isPositiveAndBelow (channel, 16) && isPositiveAndBelow ((int) newNote.initialNote, 128));
+        jassert (slotForNote[channel][newNote.initialNote] == noSlot);
+
+        // (the table has room for every note on every channel, so this can't fill up)
+        auto slot = freeSlots[--numFreeSlots];
+        slots[slot] = newNote;
+        slotForNote[channel][newNote.initialNote] = slot;
+        channelNotes[channel][numNotesOnChannel[channel]++] = newNote.initialNote;
+        order[numNotes++] = slot;
+    }
+
+    void remove (int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, numNotes));
+
+        auto slot = order[index];
+        auto& note = slots[slot];
+        auto channel = note.midiChannel - 1;
+        auto* notesOnChannel = channelNotes[channel];
+        auto numOnChannel = (int) numNotesOnChannel[channel];
+
+        for (int i = 0; i < numOnChannel; ++i)
+        {
+            if (notesOnChannel[i] == note.initialNote)
+            {
+                memmove (notesOnChannel + i, notesOnChannel + i + 1, (size_t) (numOnChannel - i - 1));
+                break;
+            }
+        }
+
+        --numNotesOnChannel[channel];
+        slotForNote[channel][note.initialNote] = noSlot;
+
+        memmove (order + index, order + index + 1, sizeof (uint16) * (size_t) (numNotes - index - 1));
+        --numNotes;
+
+        freeSlots[numFreeSlots++] = slot;
+    }
+
+    void remove (const MPENote* note) noexcept
+    {
+        auto slot = (uint16) (note - slots);
+
+        for (int i = numNotes; --i >= 0;)
+        {
+            if (order[i] == slot)
+            {
+                remove (i);
+                return;
+            }
+        }
+
+        jassertfalse; // this note isn't in the table!
+    }
+
+    void clear() noexcept
+    {
+        while (numNotes > 0)
+            remove (numNotes - 1);
+    }
+
+private:
+    MPENote slots[maxNumNotes];
+    uint16 order[maxNumNotes], freeSlots[maxNumNotes];
+    uint16 slotForNote[16][128];
+    uint8 channelNotes[16][128], numNotesOnChannel[16];
+    int numNotes = 0, numFreeSlots = maxNumNotes;
+
+    JUCE_DECLARE_NON_COPYABLE (NoteTable)
+};
+
+//==============================================================================
+/*  A single-reader, single-writer FIFO of listener callbacks, which is filled by
+    the thread that's processing MIDI and emptied by dispatchPendingNotifications().
+*/
+struct MPEInstrument::NotificationQueue
+{
+    enum { capacity = 1024 };
+
+    typedef void (Listener::*Callback) (MPENote);
+
+    struct Notification
+    {
+        Callback callback;
+        MPENote note;
+    };
+
+    void push (Callback callback, const MPENote& note) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        // if this fills up, dispatchPendingNotifications() isn't being called often
+        // enough, and the notifications that don't fit will be lost
+        if (size1 > 0)
+        {
+            notifications[start1].callback = callback;
+            notifications[start1].note = note;
+        }
+
+        fifo.finishedWrite (size1);
+    }
+
+    bool pop (Notification& result) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (1, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            result = notifications[start1];
+
+        fifo.finishedRead (size1);
+        return size1 > 0;
+    }
+
+    AbstractFifo fifo { capacity };
+    Notification notifications[capacity];
+    Atomic<int> numListeners;
+};
+
 //==============================================================================
 MPEInstrument::MPEInstrument() noexcept
+    : notes (new NoteTable()), notificationQueue (new NotificationQueue())
 {
     std::fill_n (lastPressureLowerBitReceivedOnChannel, 16, noLSBValueReceived);
     std::fill_n (lastTimbreLowerBitReceivedOnChannel, 16, noLSBValueReceived);
@@ -139,6 +321,34 @@ void MPEInstrument::removeListener (Listener* const listenerToRemove) noexcept
     listeners.remove (listenerToRemove);
 }
 
+void MPEInstrument::addQueuedListener (Listener* const listenerToAdd)
+{
+    queuedListeners.add (listenerToAdd);
+    notificationQueue->numListeners = queuedListeners.size();
+}
+
+void MPEInstrument::removeQueuedListener (Listener* const listenerToRemove)
+{
+    queuedListeners.remove (listenerToRemove);
+    notificationQueue->numListeners = queuedListeners.size();
+}
+
+void MPEInstrument::dispatchPendingNotifications()
+{
+    NotificationQueue::Notification notification;
+
+    while (notificationQueue->pop (notification))
+        queuedListeners.call (notification.callback, notification.note);
+}
+
+void MPEInstrument::callListeners (void (Listener::*callback) (MPENote), MPENote note)
+{
+    listeners.call (callback, note);
+
+    if (notificationQueue->numListeners.get() > 0)
+        notificationQueue->push (callback, note);
+}
+
 //==============================================================================
 void MPEInstrument::processNextMidiEvent (const MidiMessage& message)
 {
@@ -218,31 +428,28 @@ void MPEInstrument::processMidiAllNotesOffMessage (const MidiMessage& message)
 
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
-        for (int i = notes.size(); --i >= 0;)
+        for (int i = notes->getNumNotesOnChannel (message.getChannel()); --i >= 0;)
         {
-            MPENote& note = notes.getReference (i);
+            MPENote& note = notes->getNoteOnChannel (message.getChannel(), i);
 
-            if (note.midiChannel == message.getChannel())
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call (&MPEInstrument::Listener::noteReleased, note);
-                notes.remove (i);
-            }
+            note.keyState = MPENote::off;
+            note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+            callListeners (&MPEInstrument::Listener::noteReleased, note);
+            notes->remove (&note);
         }
     }
     else if (MPEZone* zone = zoneLayout.getZoneByMasterChannel (message.getChannel()))
     {
-        for (int i = notes.size(); --i >= 0;)
+        for (int i = notes->size(); --i >= 0;)
         {
-            MPENote& note = notes.getReference (i);
+            MPENote& note = notes->getReference (i);
 
             if (zone->isUsingChannelAsNoteChannel (note.midiChannel))
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call (&MPEInstrument::Listener::noteReleased, note);
-                notes.remove (i);
+                callListeners (&MPEInstrument::Listener::noteReleased, note);
+                notes->remove (i);
             }
         }
     }
@@ -299,12 +506,12 @@ void MPEInstrument::noteOn (int midiChannel,
         // pathological case: second note-on received for same note -> retrigger it
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call (&MPEInstrument::Listener::noteReleased, *alreadyPlayingNote);
-        notes.remove (alreadyPlayingNote);
+        callListeners (&MPEInstrument::Listener::noteReleased, *alreadyPlayingNote);
+        notes->remove (alreadyPlayingNote);
     }
 
-    notes.add (newNote);
-    listeners.call (&MPEInstrument::Listener::noteAdded, newNote);
+    notes->add (newNote);
+    callListeners (&MPEInstrument::Listener::noteAdded, newNote);
 }
 
 //==============================================================================
@@ -312,7 +519,7 @@ void MPEInstrument::noteOff (int midiChannel,
                              int midiNoteNumber,
                              MPEValue midiNoteOffVelocity)
 {
-    if (notes.isEmpty() || ! isNoteChannel (midiChannel))
+    if (notes->isEmpty() || ! isNoteChannel (midiChannel))
         return;
 
     const ScopedLock sl (lock);
@@ -330,12 +537,12 @@ void MPEInstrument::noteOff (int midiChannel,
 
         if (note->keyState == MPENote::off)
         {
-            listeners.call (&MPEInstrument::Listener::noteReleased, *note);
-            notes.remove (note);
+            callListeners (&MPEInstrument::Listener::noteReleased, *note);
+            notes->remove (note);
         }
         else
         {
-            listeners.call (&MPEInstrument::Listener::noteKeyStateChanged, *note);
+            callListeners (&MPEInstrument::Listener::noteKeyStateChanged, *note);
         }
     }
 }
@@ -372,7 +579,7 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
 {
     dimension.lastValueReceivedOnChannel[midiChannel - 1] = value;
 
-    if (notes.isEmpty())
+    if (notes->isEmpty())
         return;
 
     if (MPEZone* zone = zoneLayout.getZoneByMasterChannel (midiChannel))
@@ -383,13 +590,8 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
-            for (int i = notes.size(); --i >= 0;)
-            {
-                MPENote& note = notes.getReference (i);
-
-                if (note.midiChannel == midiChannel)
-                    updateDimensionForNote (note, dimension, value);
-            }
+            for (int i = notes->getNumNotesOnChannel (midiChannel); --i >= 0;)
+                updateDimensionForNote (notes->getNoteOnChannel (midiChannel, i), dimension, value);
         }
         else
         {
@@ -404,9 +606,9 @@ void MPEInstrument::updateDimensionMaster (MPEZone& zone, MPEDimension& dimensio
 {
     const Range<int> channels (zone.getNoteChannelRange());
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->size(); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getReference (i);
 
         if (! channels.contains (note.midiChannel))
             continue;
@@ -416,7 +618,7 @@ void MPEInstrument::updateDimensionMaster (MPEZone& zone, MPEDimension& dimensio
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call (&MPEInstrument::Listener::notePitchbendChanged, note);
+            callListeners (&MPEInstrument::Listener::notePitchbendChanged, note);
         }
         else if (dimension.getValue (note) != value)
         {
@@ -443,9 +645,9 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (MPENote& note, MPEDimension& dimension)
 {
-    if (&dimension == &pressureDimension)  { listeners.call (&MPEInstrument::Listener::notePressureChanged,  note); return; }
-    if (&dimension == &timbreDimension)    { listeners.call (&MPEInstrument::Listener::noteTimbreChanged,    note); return; }
-    if (&dimension == &pitchbendDimension) { listeners.call (&MPEInstrument::Listener::notePitchbendChanged, note); return; }
+    if (&dimension == &pressureDimension)  { callListeners (&MPEInstrument::Listener::notePressureChanged,  note); return; }
+    if (&dimension == &timbreDimension)    { callListeners (&MPEInstrument::Listener::noteTimbreChanged,    note); return; }
+    if (&dimension == &pitchbendDimension) { callListeners (&MPEInstrument::Listener::notePitchbendChanged, note); return; }
 }
 
 //==============================================================================
@@ -495,9 +697,9 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
     if (legacyMode.isEnabled ? (! legacyMode.channelRange.contains (midiChannel)) : (affectedZone == nullptr))
         return;
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->size(); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getReference (i);
 
         if (legacyMode.isEnabled ? (note.midiChannel == midiChannel) : affectedZone->isUsingChannel (note.midiChannel))
         {
@@ -510,12 +712,12 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
 
             if (note.keyState == MPENote::off)
             {
-                listeners.call (&MPEInstrument::Listener::noteReleased, note);
-                notes.remove (i);
+                callListeners (&MPEInstrument::Listener::noteReleased, note);
+                notes->remove (i);
             }
             else
             {
-                listeners.call (&MPEInstrument::Listener::noteKeyStateChanged, note);
+                callListeners (&MPEInstrument::Listener::noteKeyStateChanged, note);
             }
         }
     }
@@ -550,7 +752,7 @@ bool MPEInstrument::isMasterChannel (int midiChannel) const noexcept
 //==============================================================================
 int MPEInstrument::getNumPlayingNotes() const noexcept
 {
-    return notes.size();
+    return notes->size();
 }
 
 MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexcept
@@ -563,7 +765,7 @@ MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexc
 
 MPENote MPEInstrument::getNote (int index) const noexcept
 {
-    return notes[index];
+    return (*notes)[index];
 }
 
 //==============================================================================
@@ -577,9 +779,9 @@ MPENote MPEInstrument::getMostRecentNote (int midiChannel) const noexcept
 
 MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) const noexcept
 {
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->size(); --i >= 0;)
     {
-        const MPENote& note = notes.getReference (i);
+        const MPENote& note = notes->getReference (i);
 
         if (note != otherThanThisNote)
             return note;
@@ -591,15 +793,7 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
 //==============================================================================
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        MPENote& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
-
-    return nullptr;
+    return notes->find (midiChannel, midiNoteNumber);
 }
 
 //==============================================================================
@@ -619,12 +813,11 @@ MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) const no
 //==============================================================================
 MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
             return &note;
     }
 
@@ -637,12 +830,11 @@ MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
     int initialNoteMax = -1;
     MPENote* result = nullptr;
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote > initialNoteMax)
         {
             result = &note;
@@ -658,12 +850,11 @@ MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
     int initialNoteMin = 128;
     MPENote* result = nullptr;
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote < initialNoteMin)
         {
             result = &note;
@@ -679,15 +870,15 @@ void MPEInstrument::releaseAllNotes()
 {
     const ScopedLock sl (lock);
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = notes->size(); --i >= 0;)
     {
-        MPENote& note = notes.getReference (i);
+        MPENote& note = notes->getReference (i);
         note.keyState = MPENote::off;
         note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call (&MPEInstrument::Listener::noteReleased, note);
+        callListeners (&MPEInstrument::Listener::noteReleased, note);
     }
 
-    notes.clear();
+    notes->clear();
 }
 
 //==============================================================================
@@ -1996,6 +2187,97 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("Many notes on one channel");
+        {
+            UnitTestInstrument test;
+            test.enableLegacyMode();
+
+            for (int i = 0; i < 128; ++i)
+                test.noteOn (1, (i * 37) % 128, MPEValue::from7BitInt (100));
+
+            test.noteOn (2, 60, MPEValue::from7BitInt (100));
+            expectEquals (test.getNumPlayingNotes(), 129);
+            expectEquals (test.getNote (128).midiChannel, (uint8) 2);
+            expectEquals (test.getMostRecentNote (1).initialNote, (uint8) ((127 * 37) % 128));
+
+            // release every other note, and check the order of the ones that are left
+            for (int i = 0; i < 128; i += 2)
+                test.noteOff (1, (i * 37) % 128, MPEValue::from7BitInt (64));
+
+            expectEquals (test.getNumPlayingNotes(), 65);
+
+            for (int i = 0; i < 64; ++i)
+                expectEquals (test.getNote (i).initialNote, (uint8) (((2 * i + 1) * 37) % 128));
+
+            test.setTimbreTrackingMode (MPEInstrument::lowestNoteOnChannel);
+            test.timbre (1, MPEValue::from7BitInt (10));
+            expectNote (test.getNote (1, 1), 100, 0, 8192, 10, MPENote::keyDown);
+            expectNote (test.getNote (1, 127), 100, 0, 8192, 64, MPENote::keyDown);
+
+            test.setTimbreTrackingMode (MPEInstrument::highestNoteOnChannel);
+            test.timbre (1, MPEValue::from7BitInt (20));
+            expectNote (test.getNote (1, 127), 100, 0, 8192, 20, MPENote::keyDown);
+
+            test.setTimbreTrackingMode (MPEInstrument::allNotesOnChannel);
+            test.timbre (1, MPEValue::from7BitInt (30));
+            expectNote (test.getNote (1, 63), 100, 0, 8192, 30, MPENote::keyDown);
+            expectNote (test.getNote (2, 60), 100, 0, 8192, 64, MPENote::keyDown);
+            expect (! test.getNote (1, 0).isValid());
+
+            // retriggering a note moves it to the end
+            test.noteOn (1, 37, MPEValue::from7BitInt (50));
+            expectEquals (test.getNumPlayingNotes(), 65);
+            expectEquals (test.getNote (64).initialNote, (uint8) 37);
+            expectEquals (test.getNote (64).noteOnVelocity.as7BitInt(), 50);
+
+            test.releaseAllNotes();
+            expectEquals (test.getNumPlayingNotes(), 0);
+            expectEquals (test.noteReleasedCallCounter, 130);
+        }
+
+        beginTest ("Queued listeners");
+        {
+            struct QueuedListener  : public MPEInstrument::Listener
+            {
+                void noteAdded (MPENote n) override              { events.add ("added " + String (n.initialNote)); }
+                void notePressureChanged (MPENote n) override    { events.add ("pressure " + String (n.pressure.as7BitInt())); }
+                void notePitchbendChanged (MPENote n) override   { events.add ("pitchbend " + String (n.pitchbend.as14BitInt())); }
+                void noteTimbreChanged (MPENote n) override      { events.add ("timbre " + String (n.timbre.as7BitInt())); }
+                void noteKeyStateChanged (MPENote) override      { events.add ("keystate"); }
+                void noteReleased (MPENote n) override           { events.add ("released " + String (n.initialNote)); }
+
+                StringArray events;
+            };
+
+            UnitTestInstrument test;
+            QueuedListener listener;
+            test.setZoneLayout (testLayout);
+            test.noteOn (3, 60, MPEValue::from7BitInt (100));
+
+            test.addQueuedListener (&listener);
+            test.noteOn (3, 61, MPEValue::from7BitInt (100));
+            test.pressure (3, MPEValue::from7BitInt (40));
+            test.pitchbend (3, MPEValue::from14BitInt (1000));
+            test.timbre (3, MPEValue::from7BitInt (30));
+            test.noteOff (3, 61, MPEValue::from7BitInt (64));
+
+            // nothing is delivered until the queue is dispatched
+            expectEquals (listener.events.size(), 0);
+            expectEquals (test.noteAddedCallCounter, 2);
+
+            test.dispatchPendingNotifications();
+            expectEquals (listener.events.joinIntoString (", "),
+                          String ("added 61, pressure 40, pitchbend 1000, timbre 30, released 61"));
+
+            test.dispatchPendingNotifications();
+            expectEquals (listener.events.size(), 5);
+
+            test.removeQueuedListener (&listener);
+            test.noteOff (3, 60, MPEValue::from7BitInt (64));
+            test.dispatchPendingNotifications();
+            expectEquals (listener.events.size(), 5);
+        }
     }
 
 private:
@@ -225,7 +225,8 @@ public:
         Note: This listener type receives its callbacks immediately, and not
         via the message thread (so you might be for example in the MIDI thread).
         Therefore you should never do heavy work such as graphics rendering etc.
-        inside those callbacks.
+        inside those callbacks. If you need to do that, register the listener with
+        addQueuedListener() instead.
     */
     class JUCE_API  Listener
     {
@@ -279,6 +280,30 @@ public:
     /** Removes a listener. */
     void removeListener (Listener* listenerToRemove) noexcept;
 
+    /** Adds a listener whose callbacks are queued up and delivered later by
+        dispatchPendingNotifications(), rather than being made immediately from
+        whichever thread is processing the MIDI.
+
+        This is the way to drive a GUI (e.g. an MPE visualiser) from an instrument
+        that's running on the audio thread: nothing the listener does can hold up
+        the audio, and it'll be called on whatever thread calls
+        dispatchPendingNotifications(), which would typically be from a Timer.
+
+        The queue has room for a fixed number of notifications, and any that arrive
+        while it's full will be dropped, so make sure it gets emptied regularly.
+
+        Queued listeners must be added, removed and dispatched on the same thread.
+    */
+    void addQueuedListener (Listener* listenerToAdd);
+
+    /** Removes a listener that was added with addQueuedListener(). */
+    void removeQueuedListener (Listener* listenerToRemove);
+
+    /** Delivers all the notifications that have been queued since the last call to
+        any listeners registered with addQueuedListener().
+    */
+    void dispatchPendingNotifications();
+
     //==============================================================================
     /** Puts the instrument into legacy mode.
         As a side effect, this will discard all currently playing notes,
@@ -323,9 +348,13 @@ protected:
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    struct NoteTable;
+    struct NotificationQueue;
+
+    ScopedPointer<NoteTable> notes;
+    ScopedPointer<NotificationQueue> notificationQueue;
     MPEZoneLayout zoneLayout;
-    ListenerList<Listener> listeners;
+    ListenerList<Listener> listeners, queuedListeners;
 
     uint8 lastPressureLowerBitReceivedOnChannel[16];
     uint8 lastTimbreLowerBitReceivedOnChannel[16];
@@ -354,6 +383,7 @@ private:
     void updateDimensionMaster (MPEZone&, MPEDimension&, MPEValue);
     void updateDimensionForNote (MPENote&, MPEDimension&, MPEValue);
     void callListenersDimensionChanged (MPENote&, MPEDimension&);
+    void callListeners (void (Listener::*) (MPENote), MPENote);
     MPEValue getInitialValueForNewNote (int midiChannel, MPEDimension&) const;
 
     void processMidiNoteOnMessage (const MidiMessage&);
@@ -40,6 +40,7 @@ void MPESynthesiser::startVoice (MPESynthesiserVoice* voice, MPENote noteToStart
 {
     jassert (voice != nullptr);
     voice->currentlyPlayingNote = noteToStart;
+    voice->resetExpressionRamps();
     voice->noteStarted();
 }
 
@@ -334,6 +335,15 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 }
 
 //==============================================================================
+void MPESynthesiser::startExpressionRamps (int numSamples)
+{
+    const ScopedLock sl (voicesLock);
+
+    for (auto* voice : voices)
+        if (voice->isActive())
+            voice->startExpressionRamps (numSamples);
+}
+
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
     for (int i = voices.size(); --i >= 0;)
@@ -252,6 +252,14 @@ protected:
                                      int startSample,
                                      int numSamples) override;
 
+    /** When expression ramping is enabled, this sets up the pitchbend, pressure and timbre
+        ramps of each active voice to glide to its note's current values over the next
+        numSamples samples.
+
+        @see MPESynthesiserBase::setExpressionRampingEnabled, MPESynthesiserVoice::pitchbendRamp
+    */
+    void startExpressionRamps (int numSamples) override;
+
     //==============================================================================
     /** Searches through the voices to find one that's not currently playing, and
         which can play the given MPE note.
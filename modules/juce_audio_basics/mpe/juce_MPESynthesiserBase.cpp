@@ -115,6 +115,12 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
     // you must set the sample rate before using this!
     jassert (sampleRate != 0);
 
+    if (expressionRampingEnabled)
+    {
+        renderNextBlockWithExpressionRamps (outputAudio, inputMidi, startSample, numSamples);
+        return;
+    }
+
     MidiBuffer::Iterator midiIterator (inputMidi);
     midiIterator.setNextSamplePosition (startSample);
 
@@ -159,6 +165,71 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
         handleMidiEvent (m);
 }
 
+namespace
+{
+    // These are the messages that MPEInstrument turns into changes of a note's
+    // pitchbend, pressure or timbre, and which can be ramped rather than splitting the block.
+    bool isExpressionMessage (const MidiMessage& m) noexcept
+    {
+        if (m.isPitchWheel() || m.isChannelPressure())
+            return true;
+
+        if (m.isController())
+        {
+            auto controller = m.getControllerNumber();
+            return controller == 70 || controller == 74 || controller == 102 || controller == 106;
+        }
+
+        return false;
+    }
+}
+
+template <typename floatType>
+void MPESynthesiserBase::renderNextBlockWithExpressionRamps (AudioBuffer<floatType>& outputAudio,
+                                                             const MidiBuffer& inputMidi,
+                                                             int startSample,
+                                                             int numSamples)
+{
+    auto midiEvent = inputMidi.findNextSamplePosition (startSample);
+    const auto endSample = startSample + numSamples;
+    bool firstEvent = true;
+
+    const ScopedLock sl (noteStateLock);
+
+    while (startSample < endSample)
+    {
+        auto subBlockEnd = endSample;
+
+        for (; midiEvent != inputMidi.end(); ++midiEvent)
+        {
+            const auto metadata = *midiEvent;
+
+            if (metadata.samplePosition >= endSample)
+                break;
+
+            auto m = metadata.getMessage();
+
+            if (! isExpressionMessage (m)
+                 && metadata.samplePosition - startSample >= ((firstEvent && ! subBlockSubdivisionIsStrict) ? 1 : minimumSubBlockSize))
+            {
+                subBlockEnd = metadata.samplePosition;
+                break;
+            }
+
+            handleMidiEvent (m);
+        }
+
+        firstEvent = false;
+
+        startExpressionRamps (subBlockEnd - startSample);
+        renderNextSubBlock (outputAudio, startSample, subBlockEnd - startSample);
+        startSample = subBlockEnd;
+    }
+
+    for (; midiEvent != inputMidi.end(); ++midiEvent)
+        handleMidiEvent ((*midiEvent).getMessage());
+}
+
 // explicit instantiation for supported float types:
 template void MPESynthesiserBase::renderNextBlock<float> (AudioBuffer<float>&, const MidiBuffer&, int, int);
 template void MPESynthesiserBase::renderNextBlock<double> (AudioBuffer<double>&, const MidiBuffer&, int, int);
@@ -182,4 +253,10 @@ void MPESynthesiserBase::setMinimumRenderingSubdivisionSize (int numSamples, boo
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void MPESynthesiserBase::setExpressionRampingEnabled (bool shouldRampExpression) noexcept
+{
+    const ScopedLock sl (noteStateLock);
+    expressionRampingEnabled = shouldRampExpression;
+}
+
 } // namespace juce
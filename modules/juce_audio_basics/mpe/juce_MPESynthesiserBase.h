@@ -133,6 +133,27 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Enables or disables expression ramping.
+
+        Normally, renderNextBlock() splits the audio at every MIDI event, so a stream of
+        pitchbend, pressure and timbre messages can chop a block into lots of tiny sub-blocks.
+
+        When expression ramping is enabled, only the events that start, stop or otherwise
+        change the state of notes (note-ons, note-offs, pedals, etc.) split the block. The
+        per-note expression messages that fall between two such events are all handled before
+        the audio in between them is rendered, and startExpressionRamps() is called so that a
+        subclass can glide smoothly to the new values over the course of that sub-block.
+
+        The MPESynthesiser class does this with the ramps in each MPESynthesiserVoice.
+    */
+    void setExpressionRampingEnabled (bool shouldRampExpression) noexcept;
+
+    /** Returns true if expression ramping has been enabled.
+        @see setExpressionRampingEnabled
+    */
+    bool isExpressionRampingEnabled() const noexcept          { return expressionRampingEnabled; }
+
     //==============================================================================
     /** Puts the synthesiser into legacy mode.
 
@@ -190,6 +211,16 @@ protected:
                                      int /*startSample*/,
                                      int /*numSamples*/) {}
 
+    /** When expression ramping is enabled, this is called before each sub-block is rendered,
+        once all the expression messages that fall inside it have been handled.
+
+        The numSamples parameter is the length of the sub-block that's about to be rendered,
+        which is the time over which any changes in expression should be ramped.
+
+        @see setExpressionRampingEnabled
+    */
+    virtual void startExpressionRamps (int /*numSamples*/) {}
+
 protected:
     //==============================================================================
     /** @internal */
@@ -201,6 +232,10 @@ private:
     double sampleRate;
     int minimumSubBlockSize;
     bool subBlockSubdivisionIsStrict;
+    bool expressionRampingEnabled = false;
+
+    template <typename floatType>
+    void renderNextBlockWithExpressionRamps (AudioBuffer<floatType>&, const MidiBuffer&, int, int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserBase)
 };
@@ -53,4 +53,27 @@ void MPESynthesiserVoice::clearCurrentNote() noexcept
     currentlyPlayingNote = MPENote();
 }
 
+//==============================================================================
+void MPESynthesiserVoice::resetExpressionRamps() noexcept
+{
+    for (auto* ramp : { &pitchbendRamp, &pressureRamp, &timbreRamp })
+        ramp->reset (1.0, 0.0);
+
+    pitchbendRamp.setValue ((float) currentlyPlayingNote.totalPitchbendInSemitones);
+    pressureRamp.setValue (currentlyPlayingNote.pressure.asUnsignedFloat());
+    timbreRamp.setValue (currentlyPlayingNote.timbre.asUnsignedFloat());
+}
+
+void MPESynthesiserVoice::startExpressionRamps (int numSamples) noexcept
+{
+    // (resetting the ramps to a length of numSamples steps also snaps them onto their
+    // previous targets, in case the last block didn't use up every step)
+    for (auto* ramp : { &pitchbendRamp, &pressureRamp, &timbreRamp })
+        ramp->reset ((double) numSamples, 1.0);
+
+    pitchbendRamp.setValue ((float) currentlyPlayingNote.totalPitchbendInSemitones);
+    pressureRamp.setValue (currentlyPlayingNote.pressure.asUnsignedFloat());
+    timbreRamp.setValue (currentlyPlayingNote.timbre.asUnsignedFloat());
+}
+
 } // namespace juce
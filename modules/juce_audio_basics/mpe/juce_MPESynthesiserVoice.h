@@ -177,11 +177,26 @@ protected:
     double currentSampleRate;
     MPENote currentlyPlayingNote;
 
+    /** When the synthesiser has expression ramping enabled, these ramp linearly across
+        each block that renderNextBlock() is asked to render, from the expression that the
+        note had at the start of the block to the expression it has at the end of it.
+
+        Call getNextValue() on each of them once per sample that you render. The pitchbend
+        ramp is the note's total pitchbend in semitones, and the pressure and timbre ramps
+        go from 0 to 1.
+
+        @see MPESynthesiserBase::setExpressionRampingEnabled
+    */
+    LinearSmoothedValue<float> pitchbendRamp, pressureRamp, timbreRamp;
+
 private:
     //==============================================================================
     friend class MPESynthesiser;
     uint32 noteStartTime;
 
+    void resetExpressionRamps() noexcept;
+    void startExpressionRamps (int numSamples) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserVoice)
 };
 
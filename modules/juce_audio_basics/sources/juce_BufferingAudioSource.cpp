@@ -45,6 +45,9 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
 
     jassert (numberOfSamplesToBuffer > 1024); // not much point using this class if you're
                                               //  not using a larger buffer..
+
+    // the audio thread will be waiting for this, so it mustn't be held up by other clients
+    setTimeSlicePriority (TimeSliceClient::playbackPriority);
 }
 
 BufferingAudioSource::~BufferingAudioSource()
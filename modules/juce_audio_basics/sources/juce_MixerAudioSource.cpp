@@ -23,26 +23,184 @@
 namespace juce
 {
 
+// Each input has a task that the scheduler can run, either to render the input into
+// its own buffer, or to add another input's buffer into its own.
+struct MixerAudioSource::Input  : public WorkStealingScheduler::Task
+{
+    Input (AudioSource* s, bool shouldDelete)  : source (s), deleteWhenRemoved (shouldDelete) {}
+
+    void run() override
+    {
+        if (inputToAdd != nullptr)
+        {
+            for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+                buffer.addFrom (chan, 0, inputToAdd->buffer, chan, 0, buffer.getNumSamples());
+        }
+        else
+        {
+            source->getNextAudioBlock (AudioSourceChannelInfo (&buffer, 0, buffer.getNumSamples()));
+            applyGain (buffer, 0, buffer.getNumSamples());
+        }
+    }
+
+    // Works out the gain for the left and right channels (or for all of the channels, if
+    // the output isn't stereo). Each block ramps from the previous gains to these.
+    void updateTargetGains (int numChannels) noexcept
+    {
+        auto g = gain.load();
+        auto p = numChannels == 2 ? jlimit (-1.0f, 1.0f, pan.load()) : 0.0f;
+
+        targetGains[0] = g * jmin (1.0f, 1.0f - p);
+        targetGains[1] = g * jmin (1.0f, 1.0f + p);
+    }
+
+    bool hasUnityGain() const noexcept
+    {
+        return lastGains[0] == 1.0f && lastGains[1] == 1.0f
+            && targetGains[0] == 1.0f && targetGains[1] == 1.0f;
+    }
+
+    void applyGain (AudioBuffer<float>& dest, int startSample, int numSamples) noexcept
+    {
+        if (! hasUnityGain())
+            for (int chan = 0; chan < dest.getNumChannels(); ++chan)
+                dest.applyGainRamp (chan, startSample, numSamples, lastGains[jmin (chan, 1)], targetGains[jmin (chan, 1)]);
+
+        finishBlock();
+    }
+
+    // Adds the first numSamples of src into dest, with the gain ramp applied as it's added
+    void addWithGain (AudioBuffer<float>& dest, int destStartSample, const AudioBuffer<float>& src, int numSamples) noexcept
+    {
+        for (int chan = 0; chan < dest.getNumChannels(); ++chan)
+        {
+            auto startGain = lastGains[jmin (chan, 1)];
+            auto endGain = targetGains[jmin (chan, 1)];
+
+            if (startGain == endGain)
+                dest.addFrom (chan, destStartSample, src, chan, 0, numSamples, endGain);
+            else
+                dest.addFromWithRamp (chan, destStartSample, src.getReadPointer (chan), numSamples, startGain, endGain);
+        }
+
+        finishBlock();
+    }
+
+    void finishBlock() noexcept
+    {
+        lastGains[0] = targetGains[0];
+        lastGains[1] = targetGains[1];
+    }
+
+    AudioSource* const source;
+    const bool deleteWhenRemoved;
+    std::atomic<float> gain { 1.0f }, pan { 0.0f };
+
+    // These are only used by the thread that's calling getNextAudioBlock(), or by tasks
+    // that it's waiting for.
+    float lastGains[2] = { 1.0f, 1.0f }, targetGains[2] = { 1.0f, 1.0f };
+    AudioBuffer<float> buffer;
+    Input* inputToAdd = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (Input)
+};
+
+// An immutable snapshot of the inputs, which getNextAudioBlock() can use without locking
+struct MixerAudioSource::InputList
+{
+    InputList (const OwnedArray<Input>& allInputs)
+    {
+        inputs.addArray (allInputs);
+        tasks.ensureStorageAllocated (inputs.size());
+    }
+
+    Array<Input*> inputs;
+    mutable Array<WorkStealingScheduler::Task*> tasks; // space for the batches that are submitted by mixInParallel()
+};
+
+// A reader registers itself with the counter for the current epoch before it loads the
+// list. When the list is replaced, waitForReaders() flips the epoch twice, waiting for the
+// other epoch's counter to drain each time, after which nothing can still be using the old list.
+struct MixerAudioSource::ScopedInputListReader
+{
+    ScopedInputListReader (MixerAudioSource& m) noexcept
+        : counter (m.numReaders[m.readerEpoch.load() & 1])
+    {
+        ++counter;
+        list = m.currentInputs.load();
+    }
+
+    ~ScopedInputListReader() noexcept    { --counter; }
+
+    std::atomic<int>& counter;
+    const InputList* list;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedInputListReader)
+};
+
+//==============================================================================
 MixerAudioSource::MixerAudioSource()
    : currentSampleRate (0.0), bufferSizeExpected (0)
 {
+    numReaders[0] = 0;
+    numReaders[1] = 0;
+    currentInputs = new InputList (inputs);
 }
 
 MixerAudioSource::~MixerAudioSource()
 {
     removeAllInputs();
+    delete currentInputs.load();
 }
 
 //==============================================================================
+MixerAudioSource::Input* MixerAudioSource::findInput (AudioSource* source) const noexcept
+{
+    for (auto* i : inputs)
+        if (i->source == source)
+            return i;
+
+    return nullptr;
+}
+
+// Must be called with the lock held, after changing the inputs array
+void MixerAudioSource::publishInputList()
+{
+    ScopedPointer<InputList> oldList (currentInputs.exchange (new InputList (inputs)));
+    waitForReaders();
+}
+
+void MixerAudioSource::waitForReaders()
+{
+    for (int numFlips = 0; numFlips < 2;)
+    {
+        auto oldEpoch = readerEpoch.load();
+
+        if (numReaders[(oldEpoch + 1) & 1] == 0)
+        {
+            readerEpoch = oldEpoch + 1;
+            ++numFlips;
+        }
+        else
+        {
+            Thread::yield();
+        }
+    }
+}
+
 void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhenRemoved)
 {
-    if (input != nullptr && ! inputs.contains (input))
+    if (input != nullptr)
     {
         double localRate;
         int localBufferSize;
 
         {
             const ScopedLock sl (lock);
+
+            if (findInput (input) != nullptr)
+                return;
+
             localRate = currentSampleRate;
             localBufferSize = bufferSizeExpected;
         }
@@ -50,10 +208,12 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
         if (localRate > 0.0)
             input->prepareToPlay (localBufferSize, localRate);
 
-        const ScopedLock sl (lock);
+        auto* newInput = new Input (input, deleteWhenRemoved);
+        newInput->buffer.setSize (2, jmax (1, localBufferSize));
 
-        inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
-        inputs.add (input);
+        const ScopedLock sl (lock);
+        inputs.add (newInput);
+        publishInputList();
     }
 }
 
@@ -61,42 +221,66 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 {
     if (input != nullptr)
     {
-        ScopedPointer<AudioSource> toDelete;
+        ScopedPointer<Input> removed;
 
         {
             const ScopedLock sl (lock);
-            const int index = inputs.indexOf (input);
+            removed = findInput (input);
 
-            if (index < 0)
+            if (removed == nullptr)
                 return;
 
-            if (inputsToDelete [index])
-                toDelete = input;
-
-            inputsToDelete.shiftBits (-1, index);
-            inputs.remove (index);
+            inputs.removeObject (removed, false);
+            publishInputList();
         }
 
         input->releaseResources();
+
+        if (removed->deleteWhenRemoved)
+            delete input;
     }
 }
 
 void MixerAudioSource::removeAllInputs()
 {
-    OwnedArray<AudioSource> toDelete;
+    OwnedArray<Input> removed;
 
     {
         const ScopedLock sl (lock);
 
-        for (int i = inputs.size(); --i >= 0;)
-            if (inputsToDelete[i])
-                toDelete.add (inputs.getUnchecked(i));
+        if (inputs.isEmpty())
+            return;
+
+        removed.swapWith (inputs);
+        publishInputList();
+    }
+
+    for (int i = removed.size(); --i >= 0;)
+    {
+        auto* input = removed.getUnchecked (i);
+
+        if (input->deleteWhenRemoved)
+        {
+            input->source->releaseResources();
+            delete input->source;
+        }
+    }
+}
+
+void MixerAudioSource::setInputGainAndPan (AudioSource* input, float gain, float pan)
+{
+    const ScopedLock sl (lock);
 
-        inputs.clear();
+    if (auto* i = findInput (input))
+    {
+        i->gain = gain;
+        i->pan = pan;
     }
+}
 
-    for (int i = toDelete.size(); --i >= 0;)
-        toDelete.getUnchecked(i)->releaseResources();
+void MixerAudioSource::setScheduler (WorkStealingScheduler* schedulerToUse) noexcept
+{
+    scheduler = schedulerToUse;
 }
 
 void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
@@ -109,7 +293,10 @@ void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sample
     bufferSizeExpected = samplesPerBlockExpected;
 
     for (int i = inputs.size(); --i >= 0;)
-        inputs.getUnchecked(i)->prepareToPlay (samplesPerBlockExpected, sampleRate);
+    {
+        inputs.getUnchecked(i)->source->prepareToPlay (samplesPerBlockExpected, sampleRate);
+        inputs.getUnchecked(i)->buffer.setSize (2, samplesPerBlockExpected);
+    }
 }
 
 void MixerAudioSource::releaseResources()
@@ -117,7 +304,10 @@ void MixerAudioSource::releaseResources()
     const ScopedLock sl (lock);
 
     for (int i = inputs.size(); --i >= 0;)
-        inputs.getUnchecked(i)->releaseResources();
+    {
+        inputs.getUnchecked(i)->source->releaseResources();
+        inputs.getUnchecked(i)->buffer.setSize (2, 0);
+    }
 
     tempBuffer.setSize (2, 0);
 
@@ -127,25 +317,39 @@ void MixerAudioSource::releaseResources()
 
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (lock);
+    const ScopedInputListReader reader (*this);
+    auto& list = *reader.list;
+    auto numChannels = info.buffer->getNumChannels();
+
+    for (auto* input : list.inputs)
+        input->updateTargetGains (numChannels);
+
+    if (list.inputs.size() > 1)
+    {
+        if (auto* s = scheduler.load())
+        {
+            mixInParallel (*s, list, info);
+            return;
+        }
+    }
 
-    if (inputs.size() > 0)
+    if (list.inputs.size() > 0)
     {
-        inputs.getUnchecked(0)->getNextAudioBlock (info);
+        auto* first = list.inputs.getUnchecked (0);
+        first->source->getNextAudioBlock (info);
+        first->applyGain (*info.buffer, info.startSample, info.numSamples);
 
-        if (inputs.size() > 1)
+        if (list.inputs.size() > 1)
         {
-            tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
-                                info.buffer->getNumSamples());
+            tempBuffer.setSize (jmax (1, numChannels), info.buffer->getNumSamples(), false, false, true);
 
             AudioSourceChannelInfo info2 (&tempBuffer, 0, info.numSamples);
 
-            for (int i = 1; i < inputs.size(); ++i)
+            for (int i = 1; i < list.inputs.size(); ++i)
             {
-                inputs.getUnchecked(i)->getNextAudioBlock (info2);
-
-                for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
-                    info.buffer->addFrom (chan, info.startSample, tempBuffer, chan, 0, info.numSamples);
+                auto* input = list.inputs.getUnchecked (i);
+                input->source->getNextAudioBlock (info2);
+                input->addWithGain (*info.buffer, info.startSample, tempBuffer, info.numSamples);
             }
         }
     }
@@ -155,4 +359,54 @@ void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
     }
 }
 
+void MixerAudioSource::mixInParallel (WorkStealingScheduler& s, const InputList& list,
+                                      const AudioSourceChannelInfo& info)
+{
+    auto& inputSnapshot = list.inputs;
+    auto& tasks = list.tasks;
+    auto numInputs = inputSnapshot.size();
+    WorkStealingScheduler::TaskGroup group;
+
+    // Render all the inputs into their own buffers, with their gains applied..
+    tasks.clearQuick();
+
+    for (auto* input : inputSnapshot)
+    {
+        input->buffer.setSize (jmax (1, info.buffer->getNumChannels()), info.numSamples, false, false, true);
+        input->inputToAdd = nullptr;
+        tasks.add (input);
+    }
+
+    s.submit (tasks.getRawDataPointer(), numInputs, &group);
+    s.wait (group);
+
+    // ..then add them together in pairs, halving the number of buffers at each stage
+    for (int stride = 1; stride < numInputs; stride *= 2)
+    {
+        tasks.clearQuick();
+
+        for (int i = 0; i + stride < numInputs; i += stride * 2)
+        {
+            auto* input = inputSnapshot.getUnchecked (i);
+            input->inputToAdd = inputSnapshot.getUnchecked (i + stride);
+            tasks.add (input);
+        }
+
+        if (tasks.size() > 1)
+        {
+            s.submit (tasks.getRawDataPointer(), tasks.size(), &group);
+            s.wait (group);
+        }
+        else
+        {
+            tasks.getFirst()->run();
+        }
+    }
+
+    auto& mix = inputSnapshot.getFirst()->buffer;
+
+    for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+        info.buffer->copyFrom (chan, info.startSample, mix, chan, 0, info.numSamples);
+}
+
 } // namespace juce
@@ -29,7 +29,15 @@ namespace juce
 
     Input sources can be added and removed while the mixer is running as long as their
     prepareToPlay() and releaseResources() methods are called before and after adding
-    them to the mixer.
+    them to the mixer. Adding and removing inputs never blocks the audio thread: the
+    mixer's getNextAudioBlock() reads the list of inputs without taking a lock, and
+    removeInputSource() waits for any block that might still be using the input to finish.
+
+    Each input can be given its own gain and pan with setInputGainAndPan(), which are
+    applied as the input is mixed, rather than in a separate pass. And if you give the
+    mixer a WorkStealingScheduler with setScheduler(), it'll pull its inputs on several
+    threads at once, which helps when it's mixing lots of sources that do some work of
+    their own, like AudioTransportSources.
 */
 class JUCE_API  MixerAudioSource  : public AudioSource
 {
@@ -67,6 +75,29 @@ public:
     */
     void removeAllInputs();
 
+    /** Sets the gain and pan that are applied to one of the inputs as it's mixed.
+
+        The gain is a linear multiplier, and the pan goes from -1.0 (left) to 1.0 (right).
+        The pan only has an effect when the mixer's output is stereo, where it balances
+        the input between the two channels.
+
+        The new values are ramped towards over the course of the next block, so they can be
+        changed while the mixer is running without causing clicks.
+    */
+    void setInputGainAndPan (AudioSource* input, float gain, float pan = 0.0f);
+
+    /** Lets the mixer pull its inputs concurrently on a WorkStealingScheduler.
+
+        When a scheduler has been set and there's more than one input, each input is
+        rendered by a separate task into its own buffer, and the results are then added
+        together in pairs, again spread across the scheduler's threads. The inputs must be
+        safe to call from any thread, and mustn't depend on each other.
+
+        The scheduler must stay alive for as long as the mixer is using it. Pass nullptr to
+        go back to pulling the inputs one after another on the calling thread.
+    */
+    void setScheduler (WorkStealingScheduler* schedulerToUse) noexcept;
+
     //==============================================================================
     /** Implementation of the AudioSource method.
         This will call prepareToPlay() on all its input sources.
@@ -84,13 +115,27 @@ public:
 
 private:
     //==============================================================================
-    Array<AudioSource*> inputs;
-    BigInteger inputsToDelete;
+    struct Input;
+    struct InputList;
+    struct ScopedInputListReader;
+    friend struct ContainerDeletePolicy<Input>;
+    friend struct ContainerDeletePolicy<InputList>;
+
+    OwnedArray<Input> inputs;
+    std::atomic<InputList*> currentInputs;
+    std::atomic<int> numReaders[2];
+    std::atomic<uint32> readerEpoch { 0 };
+    std::atomic<WorkStealingScheduler*> scheduler { nullptr };
     CriticalSection lock;
     AudioSampleBuffer tempBuffer;
     double currentSampleRate;
     int bufferSizeExpected;
 
+    Input* findInput (AudioSource*) const noexcept;
+    void publishInputList();
+    void waitForReaders();
+    void mixInParallel (WorkStealingScheduler&, const InputList&, const AudioSourceChannelInfo&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerAudioSource)
 };
 
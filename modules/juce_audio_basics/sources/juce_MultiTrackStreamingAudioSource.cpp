@@ -0,0 +1,552 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MultiTrackStreamingAudioSource::Track
+{
+    Track (PositionableAudioSource* s, bool deleteWhenRemoved)  : source (s, deleteWhenRemoved) {}
+
+    void updateLength()
+    {
+        length = source->isLooping() ? std::numeric_limits<int64>::max()
+                                     : source->getTotalLength();
+    }
+
+    OptionalScopedPointer<PositionableAudioSource> source;
+    AudioSampleBuffer buffer;  // a ring buffer that refers to this track's slice of the pool
+    int64 validStart = 0, validEnd = 0, length = 0;
+    float gain = 1.0f, lastGain = 1.0f;
+    bool busy = false;
+
+    JUCE_DECLARE_NON_COPYABLE (Track)
+};
+
+//==============================================================================
+class MultiTrackStreamingAudioSource::IOThread  : public Thread
+{
+public:
+    IOThread (MultiTrackStreamingAudioSource& s)  : Thread ("Multi-track streaming"), owner (s) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! owner.serviceMostUrgentTrack())
+                owner.workAvailable.wait (10);
+    }
+
+private:
+    MultiTrackStreamingAudioSource& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (IOThread)
+};
+
+//==============================================================================
+MultiTrackStreamingAudioSource::MultiTrackStreamingAudioSource (int numberOfChannels,
+                                                                size_t bufferPoolSizeInBytes,
+                                                                int numIOThreads)
+    : numChannels (jmax (1, numberOfChannels)),
+      bufferPoolSize (bufferPoolSizeInBytes),
+      samplesPerTrack (0),
+      prefetchLength (0),
+      samplesToPrefetch (0),
+      blockSize (0),
+      currentSampleRate (0),
+      playPosition (0),
+      generation (0),
+      isPrepared (false),
+      waitingForPrefetch (true),
+      ioPaused (false)
+{
+    jassert (numIOThreads > 0);
+
+    for (int i = 0; i < jmax (1, numIOThreads); ++i)
+        threads.add (new IOThread (*this))->startThread (6);
+}
+
+MultiTrackStreamingAudioSource::~MultiTrackStreamingAudioSource()
+{
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    workAvailable.signal();
+
+    for (auto* t : threads)
+        t->stopThread (4000);
+
+    removeAllTracks();
+}
+
+//==============================================================================
+void MultiTrackStreamingAudioSource::addTrack (PositionableAudioSource* newTrack, bool deleteWhenRemoved)
+{
+    if (newTrack == nullptr || findTrack (newTrack) != nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    ScopedPointer<Track> track (new Track (newTrack, deleteWhenRemoved));
+
+    if (isPrepared)
+        newTrack->prepareToPlay (blockSize, currentSampleRate);
+
+    track->updateLength();
+
+    pauseIO();
+
+    {
+        const ScopedLock sl (lock);
+        track->validStart = track->validEnd = playPosition;
+        tracks.add (track.release());
+    }
+
+    rebuildBufferPool();
+}
+
+void MultiTrackStreamingAudioSource::removeTrack (PositionableAudioSource* trackSource)
+{
+    ScopedPointer<Track> toDelete;
+
+    pauseIO();
+
+    {
+        const ScopedLock sl (lock);
+
+        if (auto* track = findTrack (trackSource))
+            toDelete = tracks.removeAndReturn (tracks.indexOf (track));
+    }
+
+    rebuildBufferPool();
+
+    if (toDelete != nullptr)
+        toDelete->source->releaseResources();
+}
+
+void MultiTrackStreamingAudioSource::removeAllTracks()
+{
+    OwnedArray<Track> toDelete;
+
+    pauseIO();
+
+    {
+        const ScopedLock sl (lock);
+        toDelete.swapWith (tracks);
+    }
+
+    rebuildBufferPool();
+
+    for (auto* t : toDelete)
+        t->source->releaseResources();
+}
+
+int MultiTrackStreamingAudioSource::getNumTracks() const noexcept
+{
+    const ScopedLock sl (lock);
+    return tracks.size();
+}
+
+void MultiTrackStreamingAudioSource::setTrackGain (PositionableAudioSource* trackSource, float newGain)
+{
+    const ScopedLock sl (lock);
+
+    if (auto* track = findTrack (trackSource))
+        track->gain = newGain;
+}
+
+MultiTrackStreamingAudioSource::Track* MultiTrackStreamingAudioSource::findTrack (PositionableAudioSource* s) const noexcept
+{
+    for (auto* t : tracks)
+        if (t->source == s)
+            return t;
+
+    return nullptr;
+}
+
+//==============================================================================
+void MultiTrackStreamingAudioSource::setBufferPoolSize (size_t newSizeInBytes)
+{
+    if (bufferPoolSize != newSizeInBytes)
+    {
+        pauseIO();
+        bufferPoolSize = newSizeInBytes;
+        rebuildBufferPool();
+    }
+}
+
+void MultiTrackStreamingAudioSource::setPrefetchLength (int numSamples)
+{
+    const ScopedLock sl (lock);
+
+    prefetchLength = jmax (0, numSamples);
+    samplesToPrefetch = jmin (prefetchLength > 0 ? prefetchLength : (int) (currentSampleRate / 4),
+                              samplesPerTrack / 2);
+}
+
+bool MultiTrackStreamingAudioSource::isReadyToPlay() const noexcept
+{
+    const ScopedLock sl (lock);
+    return isPrepared && (! waitingForPrefetch || areAllTracksReady());
+}
+
+bool MultiTrackStreamingAudioSource::waitUntilReady (int timeoutMilliseconds)
+{
+    const uint32 startTime = Time::getMillisecondCounter();
+
+    while (! isReadyToPlay())
+    {
+        if (timeoutMilliseconds >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMilliseconds)
+            return false;
+
+        workAvailable.signal();
+        Thread::sleep (1);
+    }
+
+    return true;
+}
+
+bool MultiTrackStreamingAudioSource::areAllTracksReady() const noexcept
+{
+    for (auto* t : tracks)
+        if (t->validEnd < t->length && t->validEnd - playPosition < samplesToPrefetch)
+            return false;
+
+    return true;
+}
+
+void MultiTrackStreamingAudioSource::restartAllTracksFrom (int64 position) noexcept
+{
+    ++generation;
+    waitingForPrefetch = true;
+
+    for (auto* t : tracks)
+        t->validStart = t->validEnd = position;
+}
+
+//==============================================================================
+void MultiTrackStreamingAudioSource::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
+{
+    pauseIO();
+
+    for (auto* t : tracks)
+    {
+        t->source->prepareToPlay (samplesPerBlockExpected, newSampleRate);
+        t->updateLength();
+    }
+
+    {
+        const ScopedLock sl (lock);
+
+        blockSize = samplesPerBlockExpected;
+        currentSampleRate = newSampleRate;
+        isPrepared = true;
+    }
+
+    rebuildBufferPool();
+}
+
+void MultiTrackStreamingAudioSource::releaseResources()
+{
+    pauseIO();
+
+    {
+        const ScopedLock sl (lock);
+        isPrepared = false;
+    }
+
+    rebuildBufferPool();
+
+    for (auto* t : tracks)
+        t->source->releaseResources();
+}
+
+void MultiTrackStreamingAudioSource::pauseIO()
+{
+    {
+        const ScopedLock sl (lock);
+        ioPaused = true;
+    }
+
+    // wait for any reads that are in progress to finish
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+            bool anyBusy = false;
+
+            for (auto* t : tracks)
+                anyBusy = anyBusy || t->busy;
+
+            if (! anyBusy)
+                break;
+        }
+
+        Thread::sleep (1);
+    }
+}
+
+void MultiTrackStreamingAudioSource::rebuildBufferPool()
+{
+    // The I/O threads must have been paused before the pool can be replaced
+    jassert (ioPaused);
+
+    HeapBlock<float> newPool;
+    HeapBlock<float*> channels ((size_t) numChannels);
+    int newSamplesPerTrack = 0;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (isPrepared && tracks.size() > 0)
+        {
+            const size_t bytesPerTrack = bufferPoolSize / ((size_t) tracks.size() * (size_t) numChannels * sizeof (float));
+
+            // If this is hit, the pool is too small to buffer this many tracks. Each one will
+            // be given enough for two blocks, which will probably cause glitches.
+            jassert (bytesPerTrack >= (size_t) blockSize * 2);
+
+            newSamplesPerTrack = (int) jlimit ((size_t) jmax (1, blockSize * 2), (size_t) 0x3fffffff, bytesPerTrack);
+        }
+    }
+
+    if (newSamplesPerTrack > 0)
+    {
+        newPool.allocate ((size_t) tracks.size() * (size_t) numChannels * (size_t) newSamplesPerTrack, true);
+    }
+
+    {
+        const ScopedLock sl (lock);
+
+        pool.swapWith (newPool);
+        samplesPerTrack = newSamplesPerTrack;
+
+        for (int i = 0; i < tracks.size(); ++i)
+        {
+            auto& buffer = tracks.getUnchecked (i)->buffer;
+
+            if (samplesPerTrack > 0)
+            {
+                for (int chan = 0; chan < numChannels; ++chan)
+                    channels[chan] = pool + ((size_t) (i * numChannels + chan) * (size_t) samplesPerTrack);
+
+                buffer.setDataToReferTo (channels, numChannels, samplesPerTrack);
+            }
+            else
+            {
+                buffer.setSize (numChannels, 0);
+            }
+        }
+
+        samplesToPrefetch = jmin (prefetchLength > 0 ? prefetchLength : (int) (currentSampleRate / 4),
+                                  samplesPerTrack / 2);
+
+        restartAllTracksFrom (playPosition);
+        ioPaused = false;
+    }
+
+    workAvailable.signal();
+}
+
+//==============================================================================
+void MultiTrackStreamingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    info.clearActiveBufferRegion();
+
+    const ScopedLock sl (lock);
+
+    if (! isPrepared || samplesPerTrack <= 0)
+        return;
+
+    if (waitingForPrefetch)
+    {
+        // hold the position until all the tracks can start together
+        if (! areAllTracksReady())
+            return;
+
+        waitingForPrefetch = false;
+    }
+
+    const int numChansToMix = jmin (numChannels, info.buffer->getNumChannels());
+    const int64 blockStart = playPosition;
+    const int64 blockEnd = playPosition + info.numSamples;
+
+    for (auto* t : tracks)
+    {
+        const int64 start = jmax (blockStart, t->validStart);
+        const int64 end   = jmin (blockEnd, t->validEnd);
+
+        if (start < end)
+        {
+            int destIndex = info.startSample + (int) (start - blockStart);
+            int ringIndex = (int) (start % samplesPerTrack);
+            int numLeft = (int) (end - start);
+
+            while (numLeft > 0)
+            {
+                const int numToDo = jmin (numLeft, samplesPerTrack - ringIndex);
+                const int offsetInBlock = destIndex - info.startSample;
+                const float gain1 = t->lastGain + (t->gain - t->lastGain) * (float) offsetInBlock / (float) info.numSamples;
+                const float gain2 = t->lastGain + (t->gain - t->lastGain) * (float) (offsetInBlock + numToDo) / (float) info.numSamples;
+
+                for (int chan = 0; chan < numChansToMix; ++chan)
+                {
+                    if (gain1 == gain2)
+                        info.buffer->addFrom (chan, destIndex, t->buffer, chan, ringIndex, numToDo, gain1);
+                    else
+                        info.buffer->addFromWithRamp (chan, destIndex, t->buffer.getReadPointer (chan, ringIndex),
+                                                      numToDo, gain1, gain2);
+                }
+
+                destIndex += numToDo;
+                ringIndex = 0;
+                numLeft -= numToDo;
+            }
+        }
+
+        t->lastGain = t->gain;
+    }
+
+    playPosition = blockEnd;
+}
+
+//==============================================================================
+void MultiTrackStreamingAudioSource::setNextReadPosition (int64 newPosition)
+{
+    {
+        const ScopedLock sl (lock);
+        playPosition = newPosition;
+        restartAllTracksFrom (newPosition);
+    }
+
+    workAvailable.signal();
+}
+
+int64 MultiTrackStreamingAudioSource::getNextReadPosition() const
+{
+    const ScopedLock sl (lock);
+    return playPosition;
+}
+
+int64 MultiTrackStreamingAudioSource::getTotalLength() const
+{
+    const ScopedLock sl (lock);
+    int64 length = 0;
+
+    for (auto* t : tracks)
+        if (! t->source->isLooping())
+            length = jmax (length, t->length);
+
+    return length;
+}
+
+//==============================================================================
+bool MultiTrackStreamingAudioSource::serviceMostUrgentTrack()
+{
+    Track* track = nullptr;
+    int64 startPos = 0, endPos = 0;
+    uint32 startGeneration;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (ioPaused || ! isPrepared || samplesPerTrack <= 0)
+            return false;
+
+        // Skip tracks that have only a little free space, so that reads stay large
+        const int minimumRead = jmax (1, jmin (4096, samplesPerTrack / 4));
+        int64 bestAhead = 0;
+
+        for (auto* t : tracks)
+        {
+            if (t->busy)
+                continue;
+
+            if (t->validEnd < playPosition)
+                t->validStart = t->validEnd = playPosition;  // the track has underrun, so skip forward
+
+            const int64 limit = jmin (t->length, playPosition + samplesPerTrack);
+            const int64 space = limit - t->validEnd;
+
+            if (space <= 0 || (space < minimumRead && limit != t->length))
+                continue;
+
+            const int64 ahead = t->validEnd - playPosition;
+
+            if (track == nullptr || ahead < bestAhead)
+            {
+                track = t;
+                bestAhead = ahead;
+                endPos = limit;
+            }
+        }
+
+        if (track == nullptr)
+            return false;
+
+        // While a seek is waiting, only fetch as much as is needed to resume, so that
+        // all the tracks get their first chunk before any of them gets a second one
+        const int64 chunkSize = (waitingForPrefetch && bestAhead < samplesToPrefetch)
+                                   ? jmax ((int64) minimumRead, samplesToPrefetch - bestAhead)
+                                   : (int64) maxSamplesPerRead;
+
+        startPos = track->validEnd;
+        endPos = jmin (endPos, startPos + chunkSize);
+        startGeneration = generation;
+        track->busy = true;
+    }
+
+    readTrackSection (*track, startPos, endPos);
+
+    {
+        const ScopedLock sl (lock);
+        track->busy = false;
+
+        // if there's been a seek while reading, the data is no use
+        if (startGeneration == generation)
+        {
+            track->validEnd = endPos;
+            track->validStart = jmax (track->validStart, endPos - samplesPerTrack);
+        }
+    }
+
+    return true;
+}
+
+void MultiTrackStreamingAudioSource::readTrackSection (Track& track, int64 start, int64 end)
+{
+    while (start < end)
+    {
+        const int ringIndex = (int) (start % samplesPerTrack);
+        const int numToDo = (int) jmin (end - start, (int64) (samplesPerTrack - ringIndex));
+
+        if (track.source->getNextReadPosition() != start)
+            track.source->setNextReadPosition (start);
+
+        AudioSourceChannelInfo info (&track.buffer, ringIndex, numToDo);
+        track.source->getNextAudioBlock (info);
+
+        start += numToDo;
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A PositionableAudioSource that streams many tracks from disk in sync and mixes
+    them together.
+
+    Each track is a PositionableAudioSource, e.g. an AudioFormatReaderSource.
+    All tracks start at position 0 of the timeline. Unlike giving every track its
+    own BufferingAudioSource, all the tracks share one set of I/O threads and one
+    buffer pool of a fixed size. The pool is divided evenly between the tracks. The
+    I/O threads always refill whichever track has the least audio buffered ahead,
+    and each read is a large sequential chunk.
+
+    When setNextReadPosition() is called, every track is refilled from the new
+    position. Playback stays silent, and the position doesn't advance, until every
+    track has buffered enough audio (see setPrefetchLength()). So all the tracks
+    resume together, sample-accurately. The same happens after prepareToPlay() and
+    whenever tracks are added or removed, because these re-divide the pool.
+
+    To get transport controls, gain and sample-rate conversion, give one of these to
+    an AudioTransportSource with a readAheadBufferSize of 0, so that the transport
+    doesn't add a second buffer of its own.
+
+    @see BufferingAudioSource, MixerAudioSource, AudioTransportSource
+*/
+class JUCE_API  MultiTrackStreamingAudioSource  : public PositionableAudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a MultiTrackStreamingAudioSource.
+
+        @param numberOfChannels         the number of channels that each track will be read with
+        @param bufferPoolSizeInBytes    the total amount of memory used for buffering all of the tracks
+        @param numIOThreads             the number of threads that read from the tracks concurrently
+    */
+    MultiTrackStreamingAudioSource (int numberOfChannels = 2,
+                                    size_t bufferPoolSizeInBytes = 64 * 1024 * 1024,
+                                    int numIOThreads = 2);
+
+    /** Destructor. */
+    ~MultiTrackStreamingAudioSource();
+
+    //==============================================================================
+    /** Adds a track to be streamed and mixed.
+
+        @param newTrack             the source to use. If it's already being used, it won't be added again
+        @param deleteWhenRemoved    if true, the source will be deleted when it's removed or when
+                                    this object is deleted
+    */
+    void addTrack (PositionableAudioSource* newTrack, bool deleteWhenRemoved);
+
+    /** Removes a track.
+        If the source was added with deleteWhenRemoved set to true, it will also be deleted.
+    */
+    void removeTrack (PositionableAudioSource* track);
+
+    /** Removes all the tracks. */
+    void removeAllTracks();
+
+    /** Returns the number of tracks. */
+    int getNumTracks() const noexcept;
+
+    /** Changes the gain that a track gets mixed with. The change is ramped over one block. */
+    void setTrackGain (PositionableAudioSource* track, float newGain);
+
+    //==============================================================================
+    /** Changes the total amount of memory that the tracks are buffered in.
+        This re-divides the pool, so all the tracks will be refilled.
+    */
+    void setBufferPoolSize (size_t newSizeInBytes);
+
+    /** Returns the total amount of memory that the tracks are buffered in. */
+    size_t getBufferPoolSize() const noexcept               { return bufferPoolSize; }
+
+    /** Returns the number of samples that each track can buffer, or 0 if this isn't prepared. */
+    int getBufferSizePerTrack() const noexcept              { return samplesPerTrack; }
+
+    /** Sets the number of samples that every track must have buffered before playback
+        can resume after a seek. A value of 0 means a quarter of a second, which is the default.
+        The length is always limited to half of each track's buffer.
+    */
+    void setPrefetchLength (int numSamples);
+
+    /** Returns true if all the tracks have enough audio buffered to play. */
+    bool isReadyToPlay() const noexcept;
+
+    /** Blocks until all the tracks have enough audio buffered to play, or the timeout expires.
+        This is useful for offline rendering or before starting a transport.
+        @returns true if the tracks are ready
+    */
+    bool waitUntilReady (int timeoutMilliseconds);
+
+    //==============================================================================
+    /** Implementation of the AudioSource method. */
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+
+    /** Implementation of the AudioSource method. */
+    void releaseResources() override;
+
+    /** Implementation of the AudioSource method. */
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+    //==============================================================================
+    /** Implements the PositionableAudioSource method. */
+    void setNextReadPosition (int64 newPosition) override;
+
+    /** Implements the PositionableAudioSource method. */
+    int64 getNextReadPosition() const override;
+
+    /** Implements the PositionableAudioSource method. */
+    int64 getTotalLength() const override;
+
+    /** Implements the PositionableAudioSource method. */
+    bool isLooping() const override                         { return false; }
+
+private:
+    //==============================================================================
+    struct Track;
+    class IOThread;
+
+    OwnedArray<Track> tracks;
+    OwnedArray<IOThread> threads;
+    CriticalSection lock;
+    WaitableEvent workAvailable;
+    HeapBlock<float> pool;
+
+    const int numChannels;
+    size_t bufferPoolSize;
+    int samplesPerTrack, prefetchLength, samplesToPrefetch, blockSize;
+    double currentSampleRate;
+    int64 playPosition;
+    uint32 generation;
+    bool isPrepared, waitingForPrefetch, ioPaused;
+
+    enum { maxSamplesPerRead = 65536 };
+
+    Track* findTrack (PositionableAudioSource*) const noexcept;
+    bool areAllTracksReady() const noexcept;
+    void restartAllTracksFrom (int64 position) noexcept;
+    void pauseIO();
+    void rebuildBufferPool();
+    bool serviceMostUrgentTrack();
+    void readTrackSection (Track&, int64 start, int64 end);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiTrackStreamingAudioSource)
+};
+
+} // namespace juce
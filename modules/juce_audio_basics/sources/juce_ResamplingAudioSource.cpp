@@ -48,6 +48,11 @@ void ResamplingAudioSource::setResamplingRatio (const double samplesInPerOutputS
     ratio = jmax (0.0, samplesInPerOutputSample);
 }
 
+void ResamplingAudioSource::setResamplingQuality (WindowedSincInterpolator::Quality newQuality)
+{
+    resamplingQuality = newQuality;
+}
+
 void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
     const SpinLock::ScopedLockType sl (ratioLock);
@@ -62,6 +67,12 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     destBuffers.calloc (numChannels);
     createLowPass (ratio);
 
+    sincInterpolators.clear();
+
+    if (resamplingQuality != WindowedSincInterpolator::linearQuality)
+        for (int i = 0; i < numChannels; ++i)
+            sincInterpolators.add (new WindowedSincInterpolator (resamplingQuality));
+
     flushBuffers();
 }
 
@@ -72,6 +83,9 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    for (auto* interpolator : sincInterpolators)
+        interpolator->reset();
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -95,6 +109,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         lastRatio = localRatio;
     }
 
+    if (! sincInterpolators.isEmpty())
+    {
+        getNextBlockUsingSincInterpolators (info, localRatio);
+        return;
+    }
+
     const int sampsNeeded = roundToInt (info.numSamples * localRatio) + 3;
 
     int bufferSize = buffer.getNumSamples();
@@ -196,6 +216,35 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextBlockUsingSincInterpolators (const AudioSourceChannelInfo& info, double localRatio)
+{
+    // The interpolators keep their own history, so the input can be read straight into
+    // the start of the buffer, asking for exactly the number of samples they'll consume.
+    auto sampsNeeded = sincInterpolators.getUnchecked (0)->getNumInputSamplesNeeded (localRatio, info.numSamples);
+
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (buffer.getNumChannels(), sampsNeeded + 32, false, false, true);
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    if (sampsNeeded > 0)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, 0, sampsNeeded);
+        input->getNextAudioBlock (readInfo);
+
+        // the windowed sinc is already band-limited when up-sampling, but
+        // the input still needs filtering when down-sampling
+        if (localRatio > 1.0001)
+            for (int i = channelsToProcess; --i >= 0;)
+                applyFilter (buffer.getWritePointer (i), sampsNeeded, filterStates[i]);
+    }
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+        sincInterpolators.getUnchecked (channel)->process (localRatio, buffer.getReadPointer (channel),
+                                                           info.buffer->getWritePointer (channel, info.startSample),
+                                                           info.numSamples);
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
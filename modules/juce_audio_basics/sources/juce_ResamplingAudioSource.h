@@ -27,7 +27,7 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator, WindowedSincInterpolator
 */
 class JUCE_API  ResamplingAudioSource  : public AudioSource
 {
@@ -63,6 +63,19 @@ public:
     */
     double getResamplingRatio() const noexcept                  { return ratio; }
 
+    /** Changes the type of interpolation that is used.
+
+        The default setting of WindowedSincInterpolator::linearQuality uses simple linear
+        interpolation with a low-pass filter. The other settings use a WindowedSincInterpolator
+        for each channel, which gives much less aliasing at a higher CPU cost.
+
+        The new setting will take effect the next time prepareToPlay() is called.
+    */
+    void setResamplingQuality (WindowedSincInterpolator::Quality newQuality);
+
+    /** Returns the quality that was set with setResamplingQuality(). */
+    WindowedSincInterpolator::Quality getResamplingQuality() const noexcept     { return resamplingQuality; }
+
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
@@ -83,6 +96,8 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    WindowedSincInterpolator::Quality resamplingQuality = WindowedSincInterpolator::linearQuality;
+    OwnedArray<WindowedSincInterpolator> sincInterpolators;
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -96,6 +111,7 @@ private:
     void resetFilters();
 
     void applyFilter (float* samples, int num, FilterState& fs);
+    void getNextBlockUsingSincInterpolators (const AudioSourceChannelInfo&, double ratio);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
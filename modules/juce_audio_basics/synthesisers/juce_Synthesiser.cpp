@@ -94,19 +94,23 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    updateVoiceLanes();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
-    return voices.add (newVoice);
+    voices.add (newVoice);
+    updateVoiceLanes();
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    updateVoiceLanes();
 }
 
 void Synthesiser::clearSounds()
@@ -139,6 +143,51 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setVoiceLaneRendering (bool shouldUseLanes, int numChannels, int maximumBlockSize)
+{
+    jassert (numChannels > 0 && maximumBlockSize > 0);
+
+    const ScopedLock sl (lock);
+    voiceLanesEnabled = shouldUseLanes;
+    numLaneChannels = jmax (1, numChannels);
+    laneBlockSize = jmax (1, maximumBlockSize);
+    updateVoiceLanes();
+}
+
+void Synthesiser::updateVoiceLanes()
+{
+    auto numLanes = voiceLanesEnabled ? voices.size() * numLaneChannels : 0;
+
+    if (numLanes == 0)
+    {
+        laneData.free();
+        floatLanes.setSize (0, 0);
+        doubleLanes.setSize (0, 0);
+        return;
+    }
+
+    // Round each lane up to a whole number of cache lines, so that every lane starts on an
+    // aligned boundary. The same memory is shared between the float and double lanes.
+    laneStride = (laneBlockSize + 15) & ~15;
+    laneData.malloc ((size_t) numLanes * (size_t) laneStride * sizeof (double) + 64);
+
+    auto* base = reinterpret_cast<double*> ((reinterpret_cast<pointer_sized_int> (laneData.get()) + 63) & ~(pointer_sized_int) 63);
+
+    HeapBlock<float*> floatPointers ((size_t) numLanes);
+    HeapBlock<double*> doublePointers ((size_t) numLanes);
+
+    for (int i = 0; i < numLanes; ++i)
+    {
+        floatPointers[i]  = reinterpret_cast<float*> (base) + i * laneStride;
+        doublePointers[i] = base + i * laneStride;
+    }
+
+    floatLanes.setDataToReferTo (floatPointers, numLanes, laneBlockSize);
+    doubleLanes.setDataToReferTo (doublePointers, numLanes, laneBlockSize);
+
+    activeLaneVoices.ensureStorageAllocated (voices.size());
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -219,14 +268,87 @@ template void Synthesiser::processNextBlock<double> (AudioBuffer<double>&, const
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    if (! renderVoicesUsingLanes (buffer, floatLanes, startSample, numSamples))
+        for (auto* voice : voices)
+            voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    if (! renderVoicesUsingLanes (buffer, doubleLanes, startSample, numSamples))
+        for (auto* voice : voices)
+            voice->renderNextBlock (buffer, startSample, numSamples);
+}
+
+template <typename floatType>
+bool Synthesiser::renderVoicesUsingLanes (AudioBuffer<floatType>& outputAudio,
+                                          AudioBuffer<floatType>& lanes,
+                                          int startSample,
+                                          int numSamples)
+{
+    if (! voiceLanesEnabled
+         || outputAudio.getNumChannels() != numLaneChannels
+         || lanes.getNumChannels() != voices.size() * numLaneChannels)
+        return false;
+
+    while (numSamples > 0)
+    {
+        auto numThisTime = jmin (numSamples, laneBlockSize);
+
+        activeLaneVoices.clearQuick();
+
+        for (int i = 0; i < voices.size(); ++i)
+        {
+            if (voices.getUnchecked (i)->isVoiceActive())
+            {
+                activeLaneVoices.add (i);
+
+                for (int chan = 0; chan < numLaneChannels; ++chan)
+                    FloatVectorOperations::clear (lanes.getWritePointer (i * numLaneChannels + chan), numThisTime);
+            }
+        }
+
+        if (activeLaneVoices.isEmpty())
+            break;
+
+        renderVoicesToLanes (lanes, activeLaneVoices, numThisTime);
+
+        for (int chan = 0; chan < numLaneChannels; ++chan)
+        {
+            auto* dest = outputAudio.getWritePointer (chan, startSample);
+
+            for (auto voiceIndex : activeLaneVoices)
+                FloatVectorOperations::add (dest, lanes.getReadPointer (voiceIndex * numLaneChannels + chan), numThisTime);
+        }
+
+        startSample += numThisTime;
+        numSamples  -= numThisTime;
+    }
+
+    return true;
+}
+
+template <typename floatType>
+static void renderEachVoiceIntoItsLanes (const OwnedArray<SynthesiserVoice>& voices, AudioBuffer<floatType>& lanes,
+                                         const Array<int>& activeVoices, int numChannelsPerVoice, int numSamples)
+{
+    for (auto voiceIndex : activeVoices)
+    {
+        AudioBuffer<floatType> voiceLanes (lanes.getArrayOfWritePointers() + voiceIndex * numChannelsPerVoice,
+                                           numChannelsPerVoice, numSamples);
+
+        voices.getUnchecked (voiceIndex)->renderNextBlock (voiceLanes, 0, numSamples);
+    }
+}
+
+void Synthesiser::renderVoicesToLanes (AudioBuffer<float>& lanes, const Array<int>& activeVoices, int numSamples)
+{
+    renderEachVoiceIntoItsLanes (voices, lanes, activeVoices, numLaneChannels, numSamples);
+}
+
+void Synthesiser::renderVoicesToLanes (AudioBuffer<double>& lanes, const Array<int>& activeVoices, int numSamples)
+{
+    renderEachVoiceIntoItsLanes (voices, lanes, activeVoices, numLaneChannels, numSamples);
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -558,6 +558,35 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Enables or disables rendering the voices into separate scratch lanes.
+
+        Normally each voice renders by adding directly into the output buffer. When lane
+        rendering is enabled, the synth instead keeps a contiguous block of memory holding a
+        separate lane for each channel of each voice. The active voices render into their own
+        lanes, and the lanes are then summed into the output in a single mixdown pass.
+
+        This keeps each voice's writes sequential, and lets a subclass override
+        renderVoicesToLanes() to process several voices at once with SIMD code.
+
+        The lanes are allocated here (and again if voices are added or removed), so call this
+        before playback starts, e.g. from your prepareToPlay() method.
+
+        @param shouldUseLanes      whether lane rendering should be used
+        @param numChannels         the number of channels that each voice's lanes should have.
+                                   If the output buffer has a different number of channels,
+                                   the synth falls back to rendering directly into it.
+        @param maximumBlockSize    the number of samples each lane holds. Larger blocks are
+                                   rendered in several chunks.
+    */
+    void setVoiceLaneRendering (bool shouldUseLanes, int numChannels = 2, int maximumBlockSize = 512);
+
+    /** Returns true if lane rendering has been enabled with setVoiceLaneRendering(). */
+    bool isUsingVoiceLanes() const noexcept                         { return voiceLanesEnabled; }
+
+    /** Returns the number of channels in each voice's lanes. */
+    int getNumChannelsPerVoiceLane() const noexcept                 { return numLaneChannels; }
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -578,6 +607,21 @@ protected:
     virtual void renderVoices (AudioBuffer<double>& outputAudio,
                                int startSample, int numSamples);
 
+    /** Renders the active voices into their lanes, when lane rendering is enabled.
+
+        The lanes buffer has getNumChannelsPerVoiceLane() channels for each voice, so channel c
+        of voice v is at index (v * getNumChannelsPerVoiceLane() + c). The lanes of the voices
+        listed in activeVoices have been cleared before this is called, and only those lanes will
+        be mixed into the output afterwards.
+
+        By default this calls renderNextBlock() on each active voice, passing it a buffer that
+        refers to its own lanes. You can override it to render groups of voices together.
+
+        @see setVoiceLaneRendering
+    */
+    virtual void renderVoicesToLanes (AudioBuffer<float>& lanes, const Array<int>& activeVoices, int numSamples);
+    virtual void renderVoicesToLanes (AudioBuffer<double>& lanes, const Array<int>& activeVoices, int numSamples);
+
     /** Searches through the voices to find one that's not currently playing, and
         which can play the given sound.
 
@@ -627,6 +671,15 @@ private:
                            const MidiBuffer& inputMidi,
                            int startSample,
                            int numSamples);
+
+    template <typename floatType>
+    bool renderVoicesUsingLanes (AudioBuffer<floatType>& outputAudio,
+                                 AudioBuffer<floatType>& lanes,
+                                 int startSample,
+                                 int numSamples);
+
+    void updateVoiceLanes();
+
     //==============================================================================
     double sampleRate = 0;
     uint32 lastNoteOnCounter = 0;
@@ -635,6 +688,13 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    bool voiceLanesEnabled = false;
+    int numLaneChannels = 2, laneBlockSize = 512, laneStride = 0;
+    HeapBlock<char> laneData;
+    AudioBuffer<float> floatLanes;
+    AudioBuffer<double> doubleLanes;
+    Array<int> activeLaneVoices;
+
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for these methods.
     virtual int findFreeVoice (const bool) const { return 0; }
@@ -0,0 +1,841 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace AggregateDeviceHelpers
+{
+    // the furthest that the resamplers may stray from the nominal speed
+    const double maxCorrection = 0.005;
+
+    //==============================================================================
+    /*  A windowed-sinc resampler whose ratio can be changed for every block. It's only
+        designed to make small adjustments to the speed of a stream, so the kernel isn't
+        scaled for downsampling.
+
+        The caller writes getNumInputsNeeded() samples into the input pointers, and then
+        calls process() to turn them into the required number of output samples.
+    */
+    struct DriftResampler
+    {
+        enum { numTaps = 16, numPhases = 256 };
+
+        void prepare (int numChannels, int maxInputSamples, int maxOutputSamples)
+        {
+            work.setSize (numChannels, numTaps + maxInputSamples);
+            work.clear();
+            positions.calloc ((size_t) maxOutputSamples);
+            kernels.calloc ((size_t) (maxOutputSamples * numTaps));
+            maxInputs = maxInputSamples;
+            maxOutputs = maxOutputSamples;
+            position = 0;
+        }
+
+        int getNumInputsNeeded (double ratio, int numOutputs) const noexcept
+        {
+            return (int) (position + numOutputs * ratio);
+        }
+
+        int getMaxNumInputs() const noexcept    { return maxInputs; }
+        int getMaxNumOutputs() const noexcept   { return maxOutputs; }
+
+        float* getInputPointer (int channel) noexcept
+        {
+            return work.getWritePointer (channel, numTaps);
+        }
+
+        void process (double ratio, float* const* outputs, int numOutputs) noexcept
+        {
+            jassert (numOutputs <= maxOutputs);
+
+            auto numInputs = getNumInputsNeeded (ratio, numOutputs);
+            jassert (numInputs <= maxInputs);
+
+            auto& table = getKernelTable();
+
+            for (int i = 0; i < numOutputs; ++i)
+            {
+                auto pos = position + i * ratio;
+                auto index = (int) pos;
+                auto phase = (float) ((pos - index) * numPhases);
+                auto phaseIndex = jmin ((int) phase, numPhases - 1);
+                auto alpha = phase - (float) phaseIndex;
+
+                auto* k1 = table[phaseIndex];
+                auto* k2 = table[phaseIndex + 1];
+                auto* kernel = kernels + i * numTaps;
+
+                for (int k = 0; k < numTaps; ++k)
+                    kernel[k] = k1[k] + alpha * (k2[k] - k1[k]);
+
+                positions[i] = index;
+            }
+
+            for (int ch = 0; ch < work.getNumChannels(); ++ch)
+            {
+                auto* src = work.getWritePointer (ch);
+                auto* dst = outputs[ch];
+
+                for (int i = 0; i < numOutputs; ++i)
+                {
+                    auto* s = src + positions[i];
+                    auto* kernel = kernels + i * numTaps;
+                    float sum = 0;
+
+                    for (int k = 0; k < numTaps; ++k)
+                        sum += s[k] * kernel[k];
+
+                    dst[i] = sum;
+                }
+
+                // keep the last few inputs as the history for the next block
+                memmove (src, src + numInputs, sizeof (float) * numTaps);
+            }
+
+            position += numOutputs * ratio - numInputs;
+        }
+
+    private:
+        AudioSampleBuffer work;
+        HeapBlock<int> positions;
+        HeapBlock<float> kernels;
+        int maxInputs = 0, maxOutputs = 0;
+        double position = 0;
+
+        struct KernelTable
+        {
+            KernelTable()
+            {
+                const double cutoff = 0.9;
+                const double halfLength = numTaps / 2;
+
+                for (int phase = 0; phase <= numPhases; ++phase)
+                {
+                    double sum = 0;
+
+                    for (int k = 0; k < numTaps; ++k)
+                    {
+                        auto x = k - (halfLength - 1) - phase / (double) numPhases;
+                        auto sinc = x == 0 ? 1.0 : std::sin (double_Pi * cutoff * x) / (double_Pi * cutoff * x);
+                        auto window = 0.42 + 0.5 * std::cos (double_Pi * x / halfLength)
+                                           + 0.08 * std::cos (2.0 * double_Pi * x / halfLength);
+
+                        kernels[phase][k] = sinc * window;
+                        sum += kernels[phase][k];
+                    }
+
+                    for (int k = 0; k < numTaps; ++k)
+                        kernels[phase][k] /= sum;
+                }
+
+                for (int phase = 0; phase <= numPhases; ++phase)
+                    for (int k = 0; k < numTaps; ++k)
+                        values[phase][k] = (float) kernels[phase][k];
+            }
+
+            const float* operator[] (int phase) const noexcept   { return values[phase]; }
+
+            double kernels[numPhases + 1][numTaps];
+            float values[numPhases + 1][numTaps];
+        };
+
+        static const KernelTable& getKernelTable()
+        {
+            static const KernelTable table;
+            return table;
+        }
+    };
+
+    //==============================================================================
+    /*  Carries audio from one device's thread to another's, resampling it at the
+        consumer's end so that the FIFO stays at a constant level, however much the
+        two clocks drift apart.
+    */
+    struct DriftCompensatingFifo
+    {
+        void prepare (int numChannelsToUse, int producerBlockSize, int consumerBlockSize)
+        {
+            numChannels = numChannelsToUse;
+
+            if (numChannels <= 0)
+                return;
+
+            // leave enough in hand to cope with one of the threads being woken up late
+            targetLevel = producerBlockSize + consumerBlockSize + jmax (producerBlockSize, consumerBlockSize) / 2
+                            + DriftResampler::numTaps;
+            fifo.setTotalSize (4 * targetLevel + producerBlockSize);
+            buffer.setSize (numChannels, fifo.getTotalSize());
+            buffer.clear();
+
+            auto maxOutputs = jmax (consumerBlockSize, 64);
+            resampler.prepare (numChannels, (int) (maxOutputs * (1.0 + maxCorrection)) + 2, maxOutputs);
+            tempPointers.calloc ((size_t) numChannels);
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            fifo.reset();
+            filteredLevel = targetLevel;
+            integral = 0;
+            ratio = 1.0;
+            primed = false;
+            consumerIsRunning = false;
+        }
+
+        int getNumChannels() const noexcept     { return numChannels; }
+        int getTargetLevel() const noexcept     { return targetLevel; }
+        double getRatio() const noexcept        { return ratio; }
+
+        // Called by the producer
+        void write (const float* const* data, int numSamples) noexcept
+        {
+            if (numChannels <= 0)
+                return;
+
+            if (numSamples > fifo.getFreeSpace())
+            {
+                // if the consumer isn't running yet, it'll throw away the old data when it starts
+                if (consumerIsRunning.get())
+                    ++numErrors;
+
+                return;
+            }
+
+            const auto scope = fifo.write (numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if (scope.blockSize1 > 0)
+                    buffer.copyFrom (ch, scope.startIndex1, data[ch], scope.blockSize1);
+
+                if (scope.blockSize2 > 0)
+                    buffer.copyFrom (ch, scope.startIndex2, data[ch] + scope.blockSize1, scope.blockSize2);
+            }
+        }
+
+        // Called by the consumer, and always fills the destination with numSamples samples
+        void read (float* const* dest, int numSamples) noexcept
+        {
+            if (numChannels <= 0)
+                return;
+
+            for (int done = 0; done < numSamples;)
+            {
+                auto num = jmin (numSamples - done, resampler.getMaxNumOutputs());
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    tempPointers[ch] = dest[ch] + done;
+
+                readBlock (tempPointers, num);
+                done += num;
+            }
+        }
+
+        int getNumErrors() const noexcept       { return numErrors.get(); }
+
+    private:
+        AbstractFifo fifo { 1 };
+        AudioSampleBuffer buffer;
+        DriftResampler resampler;
+        HeapBlock<float*> tempPointers;
+
+        int numChannels = 0, targetLevel = 0;
+        double filteredLevel = 0, integral = 0, ratio = 1.0;
+        bool primed = false;
+        Atomic<bool> consumerIsRunning;
+        Atomic<int> numErrors;
+
+        void readBlock (float* const* dest, int numSamples) noexcept
+        {
+            auto numReady = fifo.getNumReady();
+
+            if (primed && numReady > 3 * targetLevel)
+            {
+                // the producer has got a long way ahead, e.g. because we missed some blocks
+                ++numErrors;
+                primed = false;
+            }
+
+            if (! primed)
+            {
+                if (numReady < targetLevel)
+                {
+                    clear (dest, numSamples);
+                    return;
+                }
+
+                // throw away anything that built up while we weren't running
+                fifo.read (numReady - targetLevel);
+                numReady = targetLevel;
+                filteredLevel = targetLevel;
+                primed = true;
+                consumerIsRunning = true;
+            }
+
+            updateRatio (numReady);
+
+            auto numNeeded = resampler.getNumInputsNeeded (ratio, numSamples);
+
+            if (numNeeded > numReady)
+            {
+                clear (dest, numSamples);
+                ++numErrors;
+                reset();
+                return;
+            }
+
+            {
+                const auto scope = fifo.read (numNeeded);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* input = resampler.getInputPointer (ch);
+
+                    if (scope.blockSize1 > 0)
+                        FloatVectorOperations::copy (input, buffer.getReadPointer (ch, scope.startIndex1), scope.blockSize1);
+
+                    if (scope.blockSize2 > 0)
+                        FloatVectorOperations::copy (input + scope.blockSize1, buffer.getReadPointer (ch, scope.startIndex2), scope.blockSize2);
+                }
+            }
+
+            resampler.process (ratio, dest, numSamples);
+        }
+
+        void updateRatio (int numReady) noexcept
+        {
+            // The level goes up and down by a block at a time, so smooth it before using
+            // it to steer the resampler, with a PI controller to cancel out the drift.
+            const double smoothing = 0.02, proportionalGain = 0.002, integralGain = 0.00001;
+
+            filteredLevel += smoothing * (numReady - filteredLevel);
+
+            auto error = (filteredLevel - targetLevel) / targetLevel;
+            integral = jlimit (-maxCorrection, maxCorrection, integral + integralGain * error);
+            ratio = 1.0 + jlimit (-maxCorrection, maxCorrection, proportionalGain * error + integral);
+        }
+
+        void clear (float* const* dest, int numSamples) const noexcept
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::clear (dest[ch], numSamples);
+        }
+    };
+}
+
+//==============================================================================
+class AggregateAudioIODevice  : public AudioIODevice
+{
+public:
+    AggregateAudioIODevice (const String& deviceName, const String& typeNameToUse)
+        : AudioIODevice (deviceName, typeNameToUse),
+          masterCallback (*this)
+    {
+    }
+
+    ~AggregateAudioIODevice()
+    {
+        close();
+    }
+
+    void addMember (AudioIODevice* device)
+    {
+        auto* member = members.add (new Member (*this, device));
+        member->isMaster = members.size() == 1;
+    }
+
+    //==============================================================================
+    StringArray getOutputChannelNames() override    { return getChannelNames (false); }
+    StringArray getInputChannelNames() override     { return getChannelNames (true); }
+
+    Array<double> getAvailableSampleRates() override
+    {
+        Array<double> rates (getMaster().getAvailableSampleRates());
+
+        for (auto* m : members)
+        {
+            auto memberRates = m->device->getAvailableSampleRates();
+
+            for (int i = rates.size(); --i >= 0;)
+                if (! memberRates.contains (rates.getUnchecked (i)))
+                    rates.remove (i);
+        }
+
+        return rates;
+    }
+
+    Array<int> getAvailableBufferSizes() override   { return getMaster().getAvailableBufferSizes(); }
+    int getDefaultBufferSize() override             { return getMaster().getDefaultBufferSize(); }
+
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override
+    {
+        close();
+
+        int inputBase = 0, outputBase = 0;
+
+        for (auto* m : members)
+        {
+            auto& device = *m->device;
+            auto numInputNames  = device.getInputChannelNames().size();
+            auto numOutputNames = device.getOutputChannelNames().size();
+
+            auto memberBufferSize = m->isMaster ? bufferSizeSamples
+                                                : getClosestBufferSize (device, bufferSizeSamples);
+
+            lastError = device.open (inputChannels.getBitRange (inputBase, numInputNames),
+                                     outputChannels.getBitRange (outputBase, numOutputNames),
+                                     sampleRate, memberBufferSize);
+
+            inputBase += numInputNames;
+            outputBase += numOutputNames;
+
+            if (lastError.isEmpty() && device.getCurrentSampleRate() != getMaster().getCurrentSampleRate())
+                lastError = "All the devices in an aggregate must be able to run at the same sample rate";
+
+            if (lastError.isNotEmpty())
+            {
+                lastError = device.getName() + ": " + lastError;
+                closeMembers();
+                return lastError;
+            }
+
+            m->numInputChannels  = device.getActiveInputChannels().countNumberOfSetBits();
+            m->numOutputChannels = device.getActiveOutputChannels().countNumberOfSetBits();
+        }
+
+        auto masterBlockSize = getMaster().getCurrentBufferSizeSamples();
+
+        for (auto* m : members)
+        {
+            if (m->isMaster)
+                continue;
+
+            auto memberBlockSize = m->device->getCurrentBufferSizeSamples();
+            m->inputFifo.prepare (m->numInputChannels, memberBlockSize, masterBlockSize);
+            m->outputFifo.prepare (m->numOutputChannels, masterBlockSize, memberBlockSize);
+            m->inputScratch.setSize (jmax (1, m->numInputChannels), masterBlockSize);
+            m->outputScratch.setSize (jmax (1, m->numOutputChannels), masterBlockSize);
+            m->inputScratch.clear();
+            m->outputScratch.clear();
+        }
+
+        int totalIns = 0, totalOuts = 0;
+
+        for (auto* m : members)
+        {
+            totalIns += m->numInputChannels;
+            totalOuts += m->numOutputChannels;
+        }
+
+        inputPointers.calloc ((size_t) totalIns + 1);
+        outputPointers.calloc ((size_t) totalOuts + 1);
+        deviceIsOpen = true;
+        return {};
+    }
+
+    void close() override
+    {
+        stop();
+        closeMembers();
+    }
+
+    bool isOpen() override                          { return deviceIsOpen; }
+
+    void start (AudioIODeviceCallback* newCallback) override
+    {
+        if (deviceIsOpen && newCallback != nullptr && callback == nullptr)
+        {
+            newCallback->audioDeviceAboutToStart (this);
+            callback = newCallback;
+
+            for (auto* m : members)
+            {
+                m->inputFifo.reset();
+                m->outputFifo.reset();
+            }
+
+            // start the others first, so that their FIFOs are ready for the master
+            for (auto* m : members)
+                if (! m->isMaster)
+                    m->device->start (m);
+
+            getMaster().start (&masterCallback);
+        }
+    }
+
+    void stop() override
+    {
+        if (auto* oldCallback = callback)
+        {
+            getMaster().stop();
+
+            for (auto* m : members)
+                if (! m->isMaster)
+                    m->device->stop();
+
+            callback = nullptr;
+            oldCallback->audioDeviceStopped();
+        }
+    }
+
+    bool isPlaying() override                       { return callback != nullptr && getMaster().isPlaying(); }
+    String getLastError() override                  { return lastError; }
+    int getCurrentBufferSizeSamples() override      { return getMaster().getCurrentBufferSizeSamples(); }
+    double getCurrentSampleRate() override          { return getMaster().getCurrentSampleRate(); }
+    int getCurrentBitDepth() override               { return getMaster().getCurrentBitDepth(); }
+
+    BigInteger getActiveOutputChannels() const override     { return getActiveChannels (false); }
+    BigInteger getActiveInputChannels() const override      { return getActiveChannels (true); }
+
+    int getOutputLatencyInSamples() override        { return getLatency (false); }
+    int getInputLatencyInSamples() override         { return getLatency (true); }
+
+    int getXRunCount() const noexcept override
+    {
+        int total = 0;
+
+        for (auto* m : members)
+        {
+            total += jmax (0, m->device->getXRunCount());
+            total += m->inputFifo.getNumErrors() + m->outputFifo.getNumErrors();
+        }
+
+        return total;
+    }
+
+private:
+    //==============================================================================
+    struct Member  : public AudioIODeviceCallback
+    {
+        Member (AggregateAudioIODevice& o, AudioIODevice* d)  : owner (o), device (d) {}
+
+        // Only used for the devices that aren't the master
+        void audioDeviceIOCallback (const float** inputChannelData, int numInputs,
+                                    float** outputChannelData, int numOutputs, int numSamples) override
+        {
+            if (numInputs > 0)
+                inputFifo.write (inputChannelData, numSamples);
+
+            if (numOutputs > 0)
+                outputFifo.read (outputChannelData, numSamples);
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override  {}
+        void audioDeviceStopped() override                      {}
+        void audioDeviceError (const String& message) override  { owner.handleError (device->getName(), message); }
+
+        AggregateAudioIODevice& owner;
+        ScopedPointer<AudioIODevice> device;
+        bool isMaster = false;
+        int numInputChannels = 0, numOutputChannels = 0;
+
+        // these carry audio to and from the master's thread
+        AggregateDeviceHelpers::DriftCompensatingFifo inputFifo, outputFifo;
+        AudioSampleBuffer inputScratch, outputScratch;
+
+        JUCE_DECLARE_NON_COPYABLE (Member)
+    };
+
+    struct MasterCallback  : public AudioIODeviceCallback
+    {
+        MasterCallback (AggregateAudioIODevice& o)  : owner (o) {}
+
+        void audioDeviceIOCallback (const float** inputChannelData, int numInputs,
+                                    float** outputChannelData, int numOutputs, int numSamples) override
+        {
+            owner.processMasterBlock (inputChannelData, numInputs, outputChannelData, numOutputs, numSamples);
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override  {}
+        void audioDeviceStopped() override                      {}
+        void audioDeviceError (const String& message) override  { owner.handleError (owner.getMaster().getName(), message); }
+
+        AggregateAudioIODevice& owner;
+
+        JUCE_DECLARE_NON_COPYABLE (MasterCallback)
+    };
+
+    OwnedArray<Member> members;
+    MasterCallback masterCallback;
+    AudioIODeviceCallback* callback = nullptr;
+    HeapBlock<const float*> inputPointers;
+    HeapBlock<float*> outputPointers;
+    String lastError;
+    bool deviceIsOpen = false;
+
+    //==============================================================================
+    AudioIODevice& getMaster() const noexcept       { return *members.getFirst()->device; }
+
+    void processMasterBlock (const float** inputChannelData, int numInputs,
+                             float** outputChannelData, int numOutputs, int numSamples) noexcept
+    {
+        int numIns = 0, numOuts = 0;
+
+        for (int i = 0; i < numInputs; ++i)
+            inputPointers[numIns++] = inputChannelData[i];
+
+        for (int i = 0; i < numOutputs; ++i)
+            outputPointers[numOuts++] = outputChannelData[i];
+
+        for (auto* m : members)
+        {
+            if (m->isMaster)
+                continue;
+
+            m->inputScratch.setSize (m->inputScratch.getNumChannels(), numSamples, false, false, true);
+            m->outputScratch.setSize (m->outputScratch.getNumChannels(), numSamples, false, false, true);
+
+            auto** ins = m->inputScratch.getArrayOfWritePointers();
+            auto** outs = m->outputScratch.getArrayOfWritePointers();
+
+            m->inputFifo.read (ins, numSamples);
+
+            for (int i = 0; i < m->numInputChannels; ++i)
+                inputPointers[numIns++] = ins[i];
+
+            for (int i = 0; i < m->numOutputChannels; ++i)
+                outputPointers[numOuts++] = outs[i];
+        }
+
+        if (callback != nullptr)
+            callback->audioDeviceIOCallback (inputPointers, numIns, outputPointers, numOuts, numSamples);
+
+        for (auto* m : members)
+            if (! m->isMaster)
+                m->outputFifo.write (m->outputScratch.getArrayOfReadPointers(), numSamples);
+    }
+
+    void handleError (const String& memberName, const String& message)
+    {
+        if (auto* c = callback)
+            c->audioDeviceError (memberName + ": " + message);
+    }
+
+    void closeMembers()
+    {
+        for (auto* m : members)
+            m->device->close();
+
+        deviceIsOpen = false;
+    }
+
+    StringArray getChannelNames (bool forInput) const
+    {
+        StringArray names;
+
+        for (auto* m : members)
+        {
+            auto memberNames = forInput ? m->device->getInputChannelNames()
+                                        : m->device->getOutputChannelNames();
+
+            for (auto& channelName : memberNames)
+                names.add (m->device->getName() + ": " + channelName);
+        }
+
+        return names;
+    }
+
+    BigInteger getActiveChannels (bool forInput) const
+    {
+        BigInteger channels;
+        int base = 0;
+
+        for (auto* m : members)
+        {
+            auto active = forInput ? m->device->getActiveInputChannels()
+                                   : m->device->getActiveOutputChannels();
+
+            for (int bit = active.findNextSetBit (0); bit >= 0; bit = active.findNextSetBit (bit + 1))
+                channels.setBit (base + bit);
+
+            base += forInput ? m->device->getInputChannelNames().size()
+                             : m->device->getOutputChannelNames().size();
+        }
+
+        return channels;
+    }
+
+    int getLatency (bool forInput) const
+    {
+        int latency = 0;
+
+        for (auto* m : members)
+        {
+            auto memberLatency = forInput ? m->device->getInputLatencyInSamples()
+                                          : m->device->getOutputLatencyInSamples();
+
+            if (! m->isMaster)
+            {
+                auto& fifo = forInput ? m->inputFifo : m->outputFifo;
+
+                if (fifo.getNumChannels() > 0)
+                    memberLatency += fifo.getTargetLevel() + AggregateDeviceHelpers::DriftResampler::numTaps / 2;
+            }
+
+            latency = jmax (latency, memberLatency);
+        }
+
+        return latency;
+    }
+
+    static int getClosestBufferSize (AudioIODevice& device, int bufferSize)
+    {
+        auto sizes = device.getAvailableBufferSizes();
+
+        if (sizes.isEmpty())
+            return device.getDefaultBufferSize();
+
+        auto best = sizes.getFirst();
+
+        for (auto size : sizes)
+            if (std::abs (size - bufferSize) < std::abs (best - bufferSize))
+                best = size;
+
+        return best;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODevice)
+};
+
+//==============================================================================
+AggregateAudioIODeviceType::AggregateAudioIODeviceType (AudioIODeviceType* typeToAggregate)
+    : AudioIODeviceType ("Aggregate " + typeToAggregate->getTypeName()),
+      aggregatedType (typeToAggregate)
+{
+    aggregatedType->addListener (this);
+}
+
+AggregateAudioIODeviceType::~AggregateAudioIODeviceType()
+{
+    aggregatedType->removeListener (this);
+}
+
+void AggregateAudioIODeviceType::addAggregateDevice (const String& aggregateName, const StringArray& memberDeviceNames)
+{
+    jassert (memberDeviceNames.size() > 0);
+
+    auto index = indexOfAggregate (aggregateName);
+
+    if (index >= 0)
+        aggregates.getReference (index).memberNames = memberDeviceNames;
+    else
+        aggregates.add ({ aggregateName, memberDeviceNames });
+
+    callDeviceChangeListeners();
+}
+
+void AggregateAudioIODeviceType::removeAggregateDevice (const String& aggregateName)
+{
+    auto index = indexOfAggregate (aggregateName);
+
+    if (index >= 0)
+    {
+        aggregates.remove (index);
+        callDeviceChangeListeners();
+    }
+}
+
+StringArray AggregateAudioIODeviceType::getMemberDeviceNames (const String& aggregateName) const
+{
+    auto index = indexOfAggregate (aggregateName);
+    return index >= 0 ? aggregates.getReference (index).memberNames : StringArray();
+}
+
+int AggregateAudioIODeviceType::indexOfAggregate (const String& name) const noexcept
+{
+    for (int i = 0; i < aggregates.size(); ++i)
+        if (aggregates.getReference (i).name == name)
+            return i;
+
+    return -1;
+}
+
+void AggregateAudioIODeviceType::audioDeviceListChanged()
+{
+    callDeviceChangeListeners();
+}
+
+//==============================================================================
+void AggregateAudioIODeviceType::scanForDevices()
+{
+    aggregatedType->scanForDevices();
+}
+
+StringArray AggregateAudioIODeviceType::getDeviceNames (bool) const
+{
+    StringArray names;
+
+    for (auto& info : aggregates)
+        names.add (info.name);
+
+    return names;
+}
+
+int AggregateAudioIODeviceType::getDefaultDeviceIndex (bool) const
+{
+    return 0;
+}
+
+int AggregateAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool) const
+{
+    if (device != nullptr && device->getTypeName() == getTypeName())
+        return indexOfAggregate (device->getName());
+
+    return -1;
+}
+
+bool AggregateAudioIODeviceType::hasSeparateInputsAndOutputs() const
+{
+    return false;
+}
+
+AudioIODevice* AggregateAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    auto index = indexOfAggregate (outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName);
+
+    if (index < 0)
+        return nullptr;
+
+    auto& info = aggregates.getReference (index);
+    ScopedPointer<AggregateAudioIODevice> device (new AggregateAudioIODevice (info.name, getTypeName()));
+
+    auto separateIO = aggregatedType->hasSeparateInputsAndOutputs();
+    auto outputNames = aggregatedType->getDeviceNames (false);
+    auto inputNames  = aggregatedType->getDeviceNames (true);
+
+    for (auto& memberName : info.memberNames)
+    {
+        auto outputName = (! separateIO || outputNames.contains (memberName)) ? memberName : String();
+        auto inputName  = (! separateIO || inputNames.contains (memberName))  ? memberName : String();
+
+        if (auto* member = aggregatedType->createDevice (outputName, inputName))
+            device->addMember (member);
+        else
+            return nullptr;
+    }
+
+    return device.release();
+}
+
+} // namespace juce
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+//==============================================================================
+/**
+    An AudioIODeviceType which combines several devices of another type into a single
+    AudioIODevice, so that an AudioDeviceManager can stream to and from all of them
+    at once.
+
+    Each aggregate device is given a name and a list of member devices with
+    addAggregateDevice(). The first member is the clock master: the aggregate's
+    callback is driven by the master device's own audio thread, and the channels of
+    the other devices are appended after the master's channels. The other members run
+    on their own threads, and exchange their audio with the master through lock-free
+    FIFOs. Because their clocks will always drift away from the master's a little, the
+    audio passing through each FIFO is played back through a windowed-sinc resampler
+    whose speed is continuously adjusted to keep the FIFO at a constant level.
+
+    All the members must be able to run at the same sample rate, but can use different
+    buffer sizes.
+
+    e.g.
+    @code
+    auto* aggregate = new AggregateAudioIODeviceType (AudioIODeviceType::createAudioIODeviceType_ALSA());
+    aggregate->addAggregateDevice ("Studio", { "Interface A", "Interface B" });
+    deviceManager.addAudioDeviceType (aggregate);
+    @endcode
+
+    @see AudioIODeviceType, AudioDeviceManager
+*/
+class JUCE_API  AggregateAudioIODeviceType  : public AudioIODeviceType,
+                                              private AudioIODeviceType::Listener
+{
+public:
+    //==============================================================================
+    /** Creates an aggregate type which combines devices of another type.
+        The object passed in will be owned and deleted by this one.
+    */
+    explicit AggregateAudioIODeviceType (AudioIODeviceType* typeToAggregate);
+
+    /** Destructor. */
+    ~AggregateAudioIODeviceType();
+
+    //==============================================================================
+    /** Defines an aggregate device, or replaces the members of an existing one.
+
+        The member names must be device names from the aggregated type, and the first
+        one will be used as the clock master.
+    */
+    void addAggregateDevice (const String& aggregateName, const StringArray& memberDeviceNames);
+
+    /** Removes an aggregate device that was defined with addAggregateDevice(). */
+    void removeAggregateDevice (const String& aggregateName);
+
+    /** Returns the names of the members of one of the aggregate devices. */
+    StringArray getMemberDeviceNames (const String& aggregateName) const;
+
+    /** Returns the type whose devices are being aggregated. */
+    AudioIODeviceType& getAggregatedType() const noexcept       { return *aggregatedType; }
+
+    //==============================================================================
+    /** @internal */
+    void scanForDevices() override;
+    /** @internal */
+    StringArray getDeviceNames (bool wantInputNames) const override;
+    /** @internal */
+    int getDefaultDeviceIndex (bool forInput) const override;
+    /** @internal */
+    int getIndexOfDevice (AudioIODevice*, bool asInput) const override;
+    /** @internal */
+    bool hasSeparateInputsAndOutputs() const override;
+    /** @internal */
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    //==============================================================================
+    struct AggregateInfo
+    {
+        String name;
+        StringArray memberNames;
+    };
+
+    ScopedPointer<AudioIODeviceType> aggregatedType;
+    Array<AggregateInfo> aggregates;
+
+    int indexOfAggregate (const String&) const noexcept;
+    void audioDeviceListChanged() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODeviceType)
+};
+
+} // namespace juce
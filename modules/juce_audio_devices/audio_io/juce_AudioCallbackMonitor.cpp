@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace
+{
+    int getHistogramBin (double proportionOfPeriod) noexcept
+    {
+        return jlimit (0, (int) AudioCallbackMonitor::numHistogramBins - 1,
+                       (int) (proportionOfPeriod * (AudioCallbackMonitor::numHistogramBins / 2)));
+    }
+
+    const double smoothingAmount = 0.2;
+}
+
+//==============================================================================
+AudioCallbackMonitor::AudioCallbackMonitor()
+    : current(),
+      deadlineMisses (64),
+      msPerTick (1000.0 / (double) Time::getHighResolutionTicksPerSecond())
+{
+    zerostruct (currentSectionMs);
+}
+
+AudioCallbackMonitor::~AudioCallbackMonitor() {}
+
+//==============================================================================
+AudioCallbackMonitor::Statistics AudioCallbackMonitor::getStatistics() noexcept
+{
+    published.acquireLatest();
+    return published.getReadFrame();
+}
+
+bool AudioCallbackMonitor::popDeadlineMiss (DeadlineMiss& result) noexcept
+{
+    return deadlineMisses.pop (result);
+}
+
+uint32 AudioCallbackMonitor::getNumDiscardedDeadlineMisses() const noexcept
+{
+    return deadlineMisses.getNumDropped();
+}
+
+//==============================================================================
+int AudioCallbackMonitor::addSection (const String& name)
+{
+    auto index = numSections.get();
+
+    if (index >= (int) maxNumSections)
+    {
+        jassertfalse; // too many sections!
+        return -1;
+    }
+
+    sectionNames.add (name);
+    numSections = index + 1;
+    return index;
+}
+
+int AudioCallbackMonitor::getNumSections() const noexcept
+{
+    return numSections.get();
+}
+
+String AudioCallbackMonitor::getSectionName (int sectionIndex) const
+{
+    return sectionNames[sectionIndex];
+}
+
+AudioCallbackMonitor::ScopedSectionTimer::ScopedSectionTimer (AudioCallbackMonitor& m, int sectionIndex) noexcept
+    : owner (m), section (sectionIndex), startTicks (Time::getHighResolutionTicks())
+{
+    jassert (isPositiveAndBelow (sectionIndex, owner.getNumSections()));
+}
+
+AudioCallbackMonitor::ScopedSectionTimer::~ScopedSectionTimer() noexcept
+{
+    if (isPositiveAndBelow (section, (int) maxNumSections))
+        owner.currentSectionMs[section] += owner.ticksToMs (Time::getHighResolutionTicks() - startTicks);
+}
+
+//==============================================================================
+void AudioCallbackMonitor::prepare (double sampleRate, int blockSize) noexcept
+{
+    zerostruct (current);
+    zerostruct (currentSectionMs);
+
+    if (sampleRate > 0.0 && blockSize > 0)
+        current.periodMs = 1000.0 * blockSize / sampleRate;
+
+    lastStartTicks = 0;
+
+    published.getWriteFrame() = current;
+    published.publish();
+}
+
+void AudioCallbackMonitor::callbackStarted (int numSamples) noexcept
+{
+    callbackStartTicks = Time::getHighResolutionTicks();
+    currentNumSamples = numSamples;
+}
+
+void AudioCallbackMonitor::callbackFinished() noexcept
+{
+    auto durationMs = ticksToMs (Time::getHighResolutionTicks() - callbackStartTicks);
+    auto intervalMs = lastStartTicks != 0 ? ticksToMs (callbackStartTicks - lastStartTicks) : 0.0;
+    lastStartTicks = callbackStartTicks;
+
+    auto& stats = current;
+    auto periodMs = stats.periodMs;
+
+    stats.averageDurationMs = stats.numCallbacks == 0 ? durationMs
+                                                      : stats.averageDurationMs + smoothingAmount * (durationMs - stats.averageDurationMs);
+    stats.worstDurationMs = jmax (stats.worstDurationMs, durationMs);
+
+    if (periodMs > 0.0)
+    {
+        ++stats.durationHistogram[getHistogramBin (durationMs / periodMs)];
+
+        if (intervalMs > 0.0)
+        {
+            ++stats.intervalHistogram[getHistogramBin (intervalMs / periodMs)];
+            stats.worstJitterMs = jmax (stats.worstJitterMs, std::abs (intervalMs - periodMs));
+        }
+    }
+
+    auto numSectionsInUse = numSections.get();
+
+    for (int i = 0; i < numSectionsInUse; ++i)
+    {
+        auto sectionMs = currentSectionMs[i];
+        stats.sectionAverageMs[i] += smoothingAmount * (sectionMs - stats.sectionAverageMs[i]);
+        stats.sectionWorstMs[i] = jmax (stats.sectionWorstMs[i], sectionMs);
+    }
+
+    if (periodMs > 0.0 && durationMs > periodMs)
+    {
+        ++stats.numDeadlineMisses;
+
+        DeadlineMiss miss;
+        miss.callbackIndex = stats.numCallbacks;
+        miss.startTimeMs = ticksToMs (callbackStartTicks);
+        miss.durationMs = durationMs;
+        miss.intervalMs = intervalMs;
+        miss.numSamples = currentNumSamples;
+        memcpy (miss.sectionDurationsMs, currentSectionMs, sizeof (currentSectionMs));
+
+        deadlineMisses.push (miss);
+    }
+
+    ++stats.numCallbacks;
+    zerostruct (currentSectionMs);
+
+    published.getWriteFrame() = stats;
+    published.publish();
+}
+
+} // namespace juce
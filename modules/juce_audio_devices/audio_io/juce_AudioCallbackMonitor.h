@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+//==============================================================================
+/**
+    Measures how long audio callbacks take and how regularly they arrive, without
+    ever blocking the audio thread.
+
+    The AudioDeviceManager owns one of these and feeds it from its audio callback (see
+    AudioDeviceManager::getCallbackMonitor()), so you'll rarely need to create one
+    yourself. Each time a callback finishes, its duration and the interval since the
+    previous callback are added to a pair of histograms, and if it took longer than the
+    buffer period, a DeadlineMiss record is queued for the message thread to pick up.
+
+    The message thread can read a consistent copy of the figures at any time with
+    getStatistics(), and drain the queue of deadline misses with popDeadlineMiss().
+    Neither of these ever takes a lock, but because each one hands data over to a
+    single reader, they must only be called from one thread (normally the message
+    thread).
+
+    To find out where the time goes inside a callback, you can register some named
+    sections with addSection(), and time them with a ScopedSectionTimer, e.g.
+    @code
+    // message thread, before starting the device
+    reverbSection = deviceManager.getCallbackMonitor().addSection ("Reverb");
+
+    // audio thread
+    void audioDeviceIOCallback (...) override
+    {
+        const AudioCallbackMonitor::ScopedSectionTimer timer (deviceManager.getCallbackMonitor(), reverbSection);
+        reverb.process (...);
+    }
+    @endcode
+
+    The time spent in each section is then included in the Statistics and in any
+    DeadlineMiss records, which makes it easy to see which part of the processing
+    blew the budget.
+
+    @see AudioDeviceManager
+*/
+class JUCE_API  AudioCallbackMonitor
+{
+public:
+    //==============================================================================
+    /** Creates a monitor. Call prepare() before the first callback. */
+    AudioCallbackMonitor();
+
+    /** Destructor. */
+    ~AudioCallbackMonitor();
+
+    //==============================================================================
+    enum
+    {
+        numHistogramBins = 32,  /**< The number of bins in each histogram. */
+        maxNumSections = 8      /**< The maximum number of sections that can be registered with addSection(). */
+    };
+
+    /** A snapshot of the figures collected since the device was last started. */
+    struct Statistics
+    {
+        /** The length of one buffer, i.e. the deadline for each callback. */
+        double periodMs;
+
+        /** The number of callbacks that have been measured. */
+        int64 numCallbacks;
+
+        /** The number of callbacks that took longer than periodMs. */
+        int64 numDeadlineMisses;
+
+        /** A smoothed average of the recent callback durations. */
+        double averageDurationMs;
+
+        /** The longest callback so far. */
+        double worstDurationMs;
+
+        /** The largest difference between periodMs and the interval between the
+            starts of two consecutive callbacks.
+        */
+        double worstJitterMs;
+
+        /** The number of callbacks whose duration fell into each bin.
+            Use getBinStart() to find out which range of durations a bin covers.
+        */
+        uint32 durationHistogram[numHistogramBins];
+
+        /** The number of callbacks whose interval since the start of the previous
+            callback fell into each bin. Use getBinStart() to find out which range of
+            intervals a bin covers.
+        */
+        uint32 intervalHistogram[numHistogramBins];
+
+        /** A smoothed average of the time spent in each section per callback. */
+        double sectionAverageMs[maxNumSections];
+
+        /** The longest time that each section has taken in a single callback. */
+        double sectionWorstMs[maxNumSections];
+
+        /** Returns the average proportion of the buffer period spent in a callback. */
+        double getLoad() const noexcept             { return periodMs > 0 ? averageDurationMs / periodMs : 0.0; }
+
+        /** Returns the start of the range covered by a histogram bin, as a proportion of
+            the buffer period. The bins are evenly spaced between 0 and 2 periods, and the
+            last one also holds everything longer than that.
+        */
+        static double getBinStart (int binIndex) noexcept    { return binIndex * (2.0 / numHistogramBins); }
+    };
+
+    /** A record of a callback which took longer than the buffer period. */
+    struct DeadlineMiss
+    {
+        /** The index of the callback since the device was started. */
+        int64 callbackIndex;
+
+        /** The time at which the callback began, in milliseconds, measured with the
+            same clock as Time::getHighResolutionTicks().
+        */
+        double startTimeMs;
+
+        /** How long the callback took. */
+        double durationMs;
+
+        /** The time since the start of the previous callback. */
+        double intervalMs;
+
+        /** The number of samples that the callback was asked to process. */
+        int numSamples;
+
+        /** The time spent in each of the sections registered with addSection(). */
+        double sectionDurationsMs[maxNumSections];
+    };
+
+    //==============================================================================
+    /** Returns a copy of the latest statistics.
+        This never blocks, but must only be called from a single thread.
+    */
+    Statistics getStatistics() noexcept;
+
+    /** Removes the oldest deadline miss from the queue, returning false if there
+        aren't any. If the queue overflows, the oldest records are discarded.
+        This never blocks, but must only be called from a single thread.
+    */
+    bool popDeadlineMiss (DeadlineMiss& result) noexcept;
+
+    /** Returns the number of deadline misses which were discarded because the queue
+        was full before popDeadlineMiss() could read them.
+    */
+    uint32 getNumDiscardedDeadlineMisses() const noexcept;
+
+    //==============================================================================
+    /** Registers a named section, returning the index to pass to a ScopedSectionTimer,
+        or -1 if there are already maxNumSections sections.
+        This must be called by the message thread, before the sections are used.
+    */
+    int addSection (const String& name);
+
+    /** Returns the number of sections that have been registered. */
+    int getNumSections() const noexcept;
+
+    /** Returns the name of one of the sections. */
+    String getSectionName (int sectionIndex) const;
+
+    /** Adds the time between its construction and destruction to one of the sections
+        that was registered with addSection(). This must only be used on the audio
+        thread while a callback is running.
+    */
+    class JUCE_API  ScopedSectionTimer
+    {
+    public:
+        ScopedSectionTimer (AudioCallbackMonitor&, int sectionIndex) noexcept;
+        ~ScopedSectionTimer() noexcept;
+
+    private:
+        AudioCallbackMonitor& owner;
+        const int section;
+        const int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSectionTimer)
+    };
+
+    //==============================================================================
+    /** Clears the statistics, and sets the buffer period that callbacks will be
+        measured against. This must be called by the audio thread, or before the
+        device starts, but must not overlap with a callback.
+    */
+    void prepare (double sampleRate, int blockSize) noexcept;
+
+    /** Must be called by the audio thread at the start of each callback. */
+    void callbackStarted (int numSamples) noexcept;
+
+    /** Must be called by the audio thread at the end of each callback. */
+    void callbackFinished() noexcept;
+
+    /** Calls callbackStarted() and callbackFinished() for you. */
+    struct ScopedCallback
+    {
+        ScopedCallback (AudioCallbackMonitor& m, int numSamples) noexcept  : monitor (m)   { monitor.callbackStarted (numSamples); }
+        ~ScopedCallback() noexcept                                                          { monitor.callbackFinished(); }
+
+        AudioCallbackMonitor& monitor;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCallback)
+    };
+
+private:
+    //==============================================================================
+    Statistics current;
+    TripleBuffer<Statistics> published;
+    OverwritingFifo<DeadlineMiss> deadlineMisses;
+
+    const double msPerTick;
+    int64 callbackStartTicks = 0, lastStartTicks = 0;
+    int currentNumSamples = 0;
+    double currentSectionMs[maxNumSections];
+
+    StringArray sectionNames;
+    Atomic<int> numSections;
+
+    double ticksToMs (int64 ticks) const noexcept   { return (double) ticks * msPerTick; }
+
+    JUCE_DECLARE_NON_COPYABLE (AudioCallbackMonitor)
+};
+
+} // namespace juce
@@ -87,6 +87,125 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackHandler)
 };
 
+//==============================================================================
+// An immutable snapshot of the registered callbacks, which is handed to the audio thread
+struct AudioDeviceManager::CallbackList
+{
+    Array<AudioIODeviceCallback*> callbacks;
+    OwnedArray<AudioSampleBuffer> buffers;   // one for each callback after the first, when rendering in parallel
+    ParallelRenderer* renderer = nullptr;
+};
+
+//==============================================================================
+class AudioDeviceManager::ParallelRenderer
+{
+public:
+    ParallelRenderer (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this))->startThread (9);
+    }
+
+    ~ParallelRenderer()
+    {
+        for (auto* worker : workers)
+        {
+            worker->signalThreadShouldExit();
+            worker->notify();
+        }
+
+        for (auto* worker : workers)
+            worker->stopThread (4000);
+    }
+
+    int getNumThreads() const noexcept      { return workers.size(); }
+
+    void render (CallbackList& list, const float** inputs, int numIns, float** outputs, int numOuts, int numSamples)
+    {
+        currentList = &list;
+        inputChannels = inputs;
+        outputChannels = outputs;
+        numInputChannels = numIns;
+        numOutputChannels = numOuts;
+        numSamplesToRender = numSamples;
+        numJobs = list.callbacks.size();
+        nextJob = 0;
+
+        auto numToWake = jmin (workers.size(), numJobs - 1);
+        activeWorkers = numToWake;
+
+        for (int i = 0; i < numToWake; ++i)
+            workers.getUnchecked (i)->notify();
+
+        runJobs();
+
+        // the last worker to finish will signal this event. This is the only wait on the
+        // audio thread, and it's only for other realtime threads that are doing its work.
+        if (numToWake > 0)
+        {
+            const RealtimeSafety::ScopedExemption exemption;
+            finished.wait (-1);
+        }
+    }
+
+private:
+    struct Worker  : public Thread
+    {
+        Worker (ParallelRenderer& r)  : Thread ("Audio callback renderer"), owner (r) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait (-1);
+
+                if (threadShouldExit())
+                    break;
+
+                owner.runJobs();
+
+                if (--(owner.activeWorkers) == 0)
+                    owner.finished.signal();
+            }
+        }
+
+        ParallelRenderer& owner;
+
+        JUCE_DECLARE_NON_COPYABLE (Worker)
+    };
+
+    void runJobs() noexcept
+    {
+        JUCE_REALTIME_CONTEXT;
+
+        for (;;)
+        {
+            auto job = (++nextJob) - 1;
+
+            if (job >= numJobs)
+                return;
+
+            auto** outputs = job == 0 ? outputChannels
+                                      : currentList->buffers.getUnchecked (job - 1)->getArrayOfWritePointers();
+
+            currentList->callbacks.getUnchecked (job)->audioDeviceIOCallback (inputChannels, numInputChannels,
+                                                                              outputs, numOutputChannels,
+                                                                              numSamplesToRender);
+        }
+    }
+
+    OwnedArray<Worker> workers;
+    WaitableEvent finished;
+    Atomic<int> nextJob, activeWorkers;
+
+    CallbackList* currentList = nullptr;
+    const float** inputChannels = nullptr;
+    float** outputChannels = nullptr;
+    int numInputChannels = 0, numOutputChannels = 0, numSamplesToRender = 0, numJobs = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelRenderer)
+};
+
 //==============================================================================
 AudioDeviceManager::AudioDeviceManager()
     : numInputChansNeeded (0),
@@ -94,7 +213,8 @@ AudioDeviceManager::AudioDeviceManager()
       listNeedsScanning (true),
       testSoundPosition (0),
       cpuUsageMs (0),
-      timeToCpuScale (0)
+      timeToCpuScale (0),
+      activeCallbacks (new CallbackList())
 {
     callbackHandler = new CallbackHandler (*this);
 }
@@ -103,6 +223,7 @@ AudioDeviceManager::~AudioDeviceManager()
 {
     currentAudioDevice = nullptr;
     defaultMidiOutput = nullptr;
+    delete activeCallbacks.get();
 }
 
 //==============================================================================
@@ -662,7 +783,7 @@ void AudioDeviceManager::updateXml()
 void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
 {
     {
-        const ScopedLock sl (audioCallbackLock);
+        const ScopedLock sl (callbackListLock);
         if (callbacks.contains (newCallback))
             return;
     }
@@ -670,8 +791,9 @@ void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
     if (currentAudioDevice != nullptr && newCallback != nullptr)
         newCallback->audioDeviceAboutToStart (currentAudioDevice);
 
-    const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl (callbackListLock);
     callbacks.add (newCallback);
+    publishCallbacks();
 }
 
 void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToRemove)
@@ -681,10 +803,11 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
         bool needsDeinitialising = currentAudioDevice != nullptr;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
 
             needsDeinitialising = needsDeinitialising && callbacks.contains (callbackToRemove);
             callbacks.removeFirstMatchingValue (callbackToRemove);
+            publishCallbacks();
         }
 
         if (needsDeinitialising)
@@ -692,41 +815,132 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
     }
 }
 
+void AudioDeviceManager::setNumParallelCallbackThreads (int numThreads)
+{
+    const ScopedLock sl (callbackListLock);
+
+    if (numThreads != getNumParallelCallbackThreads())
+    {
+        ScopedPointer<ParallelRenderer> oldRenderer (parallelRenderer.release());
+
+        if (numThreads > 0)
+            parallelRenderer = new ParallelRenderer (numThreads);
+
+        // once this returns, the audio thread can't be using the old renderer any more
+        publishCallbacks();
+    }
+}
+
+int AudioDeviceManager::getNumParallelCallbackThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumThreads() : 0;
+}
+
+void AudioDeviceManager::publishCallbacks()
+{
+    // this must be called with the callbackListLock held
+    ScopedPointer<CallbackList> newList (new CallbackList());
+    newList->callbacks = callbacks;
+    newList->renderer = parallelRenderer;
+
+    if (parallelRenderer != nullptr)
+    {
+        int numChannels = 1, numSamples = 1;
+
+        if (currentAudioDevice != nullptr)
+        {
+            numChannels = jmax (1, currentAudioDevice->getActiveOutputChannels().countNumberOfSetBits());
+            numSamples  = jmax (1, currentAudioDevice->getCurrentBufferSizeSamples());
+        }
+
+        for (int i = 1; i < callbacks.size(); ++i)
+            newList->buffers.add (new AudioSampleBuffer (numChannels, numSamples));
+    }
+
+    ScopedPointer<CallbackList> oldList (activeCallbacks.exchange (newList.release()));
+
+    // The counter is odd while the audio thread is using a list, so if it's odd now,
+    // wait until the audio thread has finished with the old one before deleting it.
+    auto counter = audioCallbackCounter.get();
+
+    if ((counter & 1) != 0)
+        while (audioCallbackCounter.get() == counter)
+            Thread::sleep (1);
+}
+
+void AudioDeviceManager::renderCallbacks (CallbackList& list,
+                                          const float** inputChannelData, int numInputChannels,
+                                          float** outputChannelData, int numOutputChannels, int numSamples)
+{
+    auto& activeList = list.callbacks;
+
+    if (list.renderer != nullptr && activeList.size() > 1)
+    {
+        for (auto* buffer : list.buffers)
+            buffer->setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
+
+        list.renderer->render (list, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples);
+
+        for (int i = activeList.size(); --i > 0;)
+        {
+            auto** tempChans = list.buffers.getUnchecked (i - 1)->getArrayOfWritePointers();
+
+            for (int chan = 0; chan < numOutputChannels; ++chan)
+                if (auto* dst = outputChannelData [chan])
+                    FloatVectorOperations::add (dst, tempChans [chan], numSamples);
+        }
+
+        return;
+    }
+
+    tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
+
+    activeList.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                       outputChannelData, numOutputChannels, numSamples);
+
+    float** const tempChans = tempBuffer.getArrayOfWritePointers();
+
+    for (int i = activeList.size(); --i > 0;)
+    {
+        activeList.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                           tempChans, numOutputChannels, numSamples);
+
+        for (int chan = 0; chan < numOutputChannels; ++chan)
+        {
+            if (const float* const src = tempChans [chan])
+                if (float* const dst = outputChannelData [chan])
+                    for (int j = 0; j < numSamples; ++j)
+                        dst[j] += src[j];
+        }
+    }
+}
+
 void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelData,
                                                    int numInputChannels,
                                                    float** outputChannelData,
                                                    int numOutputChannels,
                                                    int numSamples)
 {
-    const ScopedLock sl (audioCallbackLock);
+    JUCE_TRACE_ZONE_WITH_ARG ("AudioDeviceManager callback", numSamples);
+    JUCE_REALTIME_CONTEXT;
+
+    const AudioCallbackMonitor::ScopedCallback monitorScope (callbackMonitor, numSamples);
+
+    // (other threads only hold this lock for as long as it takes to swap a pointer)
+    const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (audioCallbackLock);
 
     inputLevelMeter.updateLevel (inputChannelData, numInputChannels, numSamples);
     outputLevelMeter.updateLevel (const_cast<const float**> (outputChannelData), numOutputChannels, numSamples);
 
-    if (callbacks.size() > 0)
+    ++audioCallbackCounter;
+    auto& activeList = *activeCallbacks.get();
+
+    if (activeList.callbacks.size() > 0)
     {
         const double callbackStartTime = Time::getMillisecondCounterHiRes();
 
-        tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
-
-        callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                          outputChannelData, numOutputChannels, numSamples);
-
-        float** const tempChans = tempBuffer.getArrayOfWritePointers();
-
-        for (int i = callbacks.size(); --i > 0;)
-        {
-            callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                              tempChans, numOutputChannels, numSamples);
-
-            for (int chan = 0; chan < numOutputChannels; ++chan)
-            {
-                if (const float* const src = tempChans [chan])
-                    if (float* const dst = outputChannelData [chan])
-                        for (int j = 0; j < numSamples; ++j)
-                            dst[j] += src[j];
-            }
-        }
+        renderCallbacks (activeList, inputChannelData, numInputChannels,
+                         outputChannelData, numOutputChannels, numSamples);
 
         const double msTaken = Time::getMillisecondCounterHiRes() - callbackStartTime;
         const double filterAmount = 0.2;
@@ -741,7 +955,11 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
             zeromem (outputChannelData[i], sizeof (float) * (size_t) numSamples);
     }
 
-    if (testSound != nullptr)
+    ++audioCallbackCounter;
+
+    // the sound isn't deleted here when it finishes, as that would free memory on the
+    // audio thread - it's left until the next call to playTestSound() or stopDevice()
+    if (testSound != nullptr && testSoundPosition < testSound->getNumSamples())
     {
         const int numSamps = jmin (numSamples, testSound->getNumSamples() - testSoundPosition);
         const float* const src = testSound->getReadPointer (0, testSoundPosition);
@@ -751,8 +969,6 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
                 outputChannelData [i][j] += src[j];
 
         testSoundPosition += numSamps;
-        if (testSoundPosition >= testSound->getNumSamples())
-            testSound = nullptr;
     }
 }
 
@@ -770,10 +986,17 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
         timeToCpuScale = (msPerBlock > 0.0) ? (1.0 / msPerBlock) : 0.0;
     }
 
+    callbackMonitor.prepare (sampleRate, blockSize);
+
     {
         const ScopedLock sl (audioCallbackLock);
+        const ScopedLock sl2 (callbackListLock);
+
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked(i)->audioDeviceAboutToStart (device);
+
+        if (parallelRenderer != nullptr)
+            publishCallbacks(); // to resize the buffers for the new device
     }
 
     sendChangeMessage();
@@ -787,6 +1010,8 @@ void AudioDeviceManager::audioDeviceStoppedInt()
     sendChangeMessage();
 
     const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl2 (callbackListLock);
+
     for (int i = callbacks.size(); --i >= 0;)
         callbacks.getUnchecked(i)->audioDeviceStopped();
 }
@@ -794,6 +1019,8 @@ void AudioDeviceManager::audioDeviceStoppedInt()
 void AudioDeviceManager::audioDeviceErrorInt (const String& message)
 {
     const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl2 (callbackListLock);
+
     for (int i = callbacks.size(); --i >= 0;)
         callbacks.getUnchecked(i)->audioDeviceError (message);
 }
@@ -895,8 +1122,9 @@ void AudioDeviceManager::setDefaultMidiOutput (const String& deviceName)
         Array<AudioIODeviceCallback*> oldCallbacks;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbacks();
         }
 
         if (currentAudioDevice != nullptr)
@@ -914,8 +1142,9 @@ void AudioDeviceManager::setDefaultMidiOutput (const String& deviceName)
                 oldCallbacks.getUnchecked(i)->audioDeviceAboutToStart (currentAudioDevice);
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbacks();
         }
 
         updateXml();
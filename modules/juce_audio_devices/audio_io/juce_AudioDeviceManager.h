@@ -284,19 +284,41 @@ public:
         If necessary, this method will invoke audioDeviceAboutToStart() on the callback
         object before returning.
 
+        The list of callbacks is handed over to the audio thread without locking it, so
+        adding or removing a callback never stalls the audio thread.
+
         To remove a callback, use removeAudioCallback().
     */
     void addAudioCallback (AudioIODeviceCallback* newCallback);
 
     /** Deregisters a previously added callback.
 
-        If necessary, this method will invoke audioDeviceStopped() on the callback
+        If the audio thread is currently inside the callback, this will wait for it to
+        return, so once this method returns, the callback will never be called again.
+        That also means that it mustn't be called from inside an audio callback.
+        If necessary, this method will then invoke audioDeviceStopped() on the callback
         object before returning.
 
         @see addAudioCallback
     */
     void removeAudioCallback (AudioIODeviceCallback* callback);
 
+    /** Makes the manager render its callbacks concurrently, using a pool of worker threads.
+
+        When more than one callback is registered, each one normally renders in turn on
+        the audio thread. If you set a number of threads here, the callbacks will instead
+        be shared out between the audio thread and the workers, with each one rendering
+        into a buffer of its own, and their outputs will then be summed.
+
+        Only use this if your callbacks are completely independent of each other, because
+        their audioDeviceIOCallback() methods may be called on different threads at the
+        same time. Passing 0 goes back to rendering all the callbacks on the audio thread.
+    */
+    void setNumParallelCallbackThreads (int numThreads);
+
+    /** Returns the number of worker threads set with setNumParallelCallbackThreads(). */
+    int getNumParallelCallbackThreads() const noexcept;
+
     //==============================================================================
     /** Returns the average proportion of available CPU being spent inside the audio callbacks.
         @returns  A value between 0 and 1.0 to indicate the approximate proportion of CPU
@@ -445,6 +467,17 @@ public:
     */
     int getXRunCount() const noexcept;
 
+    /** Returns the object which measures the duration and timing of each audio callback.
+
+        This collects histograms of how long the callbacks take and how regularly they
+        arrive, and records any callbacks which overran the buffer period. The figures
+        can be read from the message thread without locking, and your callbacks can use
+        it to time sections of their own processing.
+
+        @see AudioCallbackMonitor
+    */
+    AudioCallbackMonitor& getCallbackMonitor() noexcept     { return callbackMonitor; }
+
 private:
     //==============================================================================
     OwnedArray<AudioIODeviceType> availableDeviceTypes;
@@ -472,7 +505,7 @@ private:
 
     String defaultMidiOutputName;
     ScopedPointer<MidiOutput> defaultMidiOutput;
-    CriticalSection audioCallbackLock, midiCallbackLock;
+    CriticalSection audioCallbackLock, midiCallbackLock, callbackListLock;
 
     ScopedPointer<AudioSampleBuffer> testSound;
     int testSoundPosition;
@@ -492,6 +525,7 @@ private:
     };
 
     LevelMeter inputLevelMeter, outputLevelMeter;
+    AudioCallbackMonitor callbackMonitor;
 
     //==============================================================================
     class CallbackHandler;
@@ -499,6 +533,17 @@ private:
     friend struct ContainerDeletePolicy<CallbackHandler>;
     ScopedPointer<CallbackHandler> callbackHandler;
 
+    struct CallbackList;
+    class ParallelRenderer;
+    friend struct ContainerDeletePolicy<ParallelRenderer>;
+    ScopedPointer<ParallelRenderer> parallelRenderer;
+    Atomic<CallbackList*> activeCallbacks;
+    Atomic<int> audioCallbackCounter;
+
+    void publishCallbacks();
+    void renderCallbacks (CallbackList&, const float** inputChannelData, int numInputChannels,
+                          float** outputChannelData, int numOutputChannels, int numSamples);
+
     void audioDeviceIOCallbackInt (const float** inputChannelData, int totalNumInputChannels,
                                    float** outputChannelData, int totalNumOutputChannels, int numSamples);
     void audioDeviceAboutToStartInt (AudioIODevice*);
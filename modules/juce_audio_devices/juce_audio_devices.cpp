@@ -155,9 +155,11 @@
 
 #endif
 
+#include "audio_io/juce_AudioCallbackMonitor.cpp"
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_AggregateAudioIODeviceType.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "midi_io/juce_MidiOutput.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
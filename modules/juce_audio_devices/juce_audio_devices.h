@@ -101,6 +101,44 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_USE_MMAP
+    If this is enabled, ALSA devices are opened with mmap access when they support it,
+    so that the samples are converted straight between the device's buffer and the
+    audio callback's buffers, without going through an intermediate buffer.
+    Devices which don't support mmap access fall back to the read/write calls.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 0
+#endif
+
+/** Config: JUCE_ALSA_NUM_PERIODS
+    The number of periods (of the audio callback's buffer size) that ALSA devices are
+    asked to use for their hardware buffer. Lower values give a lower latency, but
+    make xruns more likely.
+*/
+#ifndef JUCE_ALSA_NUM_PERIODS
+ #define JUCE_ALSA_NUM_PERIODS 4
+#endif
+
+/** Config: JUCE_ALSA_THREAD_PRIORITY
+    The priority, between 0 and 10, of the thread which runs the ALSA audio callback.
+    See Thread::setPriority() for details.
+*/
+#ifndef JUCE_ALSA_THREAD_PRIORITY
+ #define JUCE_ALSA_THREAD_PRIORITY 9
+#endif
+
+/** Config: JUCE_ALSA_USE_SCHED_FIFO
+    If this is enabled, the ALSA audio thread is started with Thread::startRealtimeThread(),
+    which asks for the SCHED_FIFO realtime scheduling policy instead of SCHED_RR, with a
+    priority scaled from JUCE_ALSA_THREAD_PRIORITY.
+    The process needs the rights to use realtime scheduling (e.g. an rtprio limit),
+    otherwise the thread keeps its normal priority.
+*/
+#ifndef JUCE_ALSA_USE_SCHED_FIFO
+ #define JUCE_ALSA_USE_SCHED_FIFO 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -145,7 +183,9 @@
 #include "midi_io/juce_MidiOutput.h"
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
+#include "audio_io/juce_AggregateAudioIODeviceType.h"
 #include "audio_io/juce_SystemAudioVolume.h"
+#include "audio_io/juce_AudioCallbackMonitor.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
 #include "audio_io/juce_AudioDeviceManager.h"
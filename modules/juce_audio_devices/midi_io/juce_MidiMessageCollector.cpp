@@ -23,7 +23,8 @@
 namespace juce
 {
 
-MidiMessageCollector::MidiMessageCollector()
+MidiMessageCollector::MidiMessageCollector (int maxPendingMessages)
+    : pendingMessages (maxPendingMessages)
 {
 }
 
@@ -36,16 +37,31 @@ void MidiMessageCollector::reset (const double newSampleRate)
 {
     jassert (newSampleRate > 0);
 
-    const ScopedLock sl (midiCallbackLock);
    #if JUCE_DEBUG
     hasCalledReset = true;
    #endif
     sampleRate = newSampleRate;
+
+    while (pendingMessages.pop (lastPendingMessage))
+    {
+    }
+
     incomingMessages.clear();
+    messagesForLaterBlocks.clear();
+    numDroppedMessages = 0;
     lastCallbackTime = Time::getMillisecondCounterHiRes();
+    callbackClock.reset();
 }
 
-void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
+void MidiMessageCollector::setSampleAccurateTiming (bool shouldUseSampleAccurateTiming)
+{
+    useSampleAccurateTiming = shouldUseSampleAccurateTiming;
+    incomingMessages.clear();
+    messagesForLaterBlocks.clear();
+    callbackClock.reset();
+}
+
+bool MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 {
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
@@ -55,11 +71,28 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (message.getTimeStamp() != 0);
 
-    const ScopedLock sl (midiCallbackLock);
+    // if the queue is full the message is dropped, as waiting for the
+    // audio thread to make some space could block a real-time thread
+    if (pendingMessages.push (message))
+        return true;
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    ++numDroppedMessages;
 
-    incomingMessages.addEvent (message, sampleNumber);
+    // The queue is full! Either nothing is calling removeNextBlockOfMessages(), or
+    // you need to give the constructor a bigger limit for the number of pending messages.
+    jassertfalse;
+    return false;
+}
+
+void MidiMessageCollector::collectPendingMessages() noexcept
+{
+    int sampleNumber = 0;
+
+    while (pendingMessages.pop (lastPendingMessage))
+    {
+        sampleNumber = (int) ((lastPendingMessage.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+        incomingMessages.addEvent (lastPendingMessage, sampleNumber);
+    }
 
     // if the messages don't get used for over a second, we'd better
     // get rid of any old ones to avoid the queue getting too big
@@ -76,10 +109,17 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
 
     jassert (numSamples > 0);
 
+    if (useSampleAccurateTiming)
+    {
+        removeNextBlockWithSampleAccurateTiming (destBuffer, numSamples);
+        return;
+    }
+
+    collectPendingMessages();
+
     auto timeNow = Time::getMillisecondCounterHiRes();
     auto msElapsed = timeNow - lastCallbackTime;
 
-    const ScopedLock sl (midiCallbackLock);
     lastCallbackTime = timeNow;
 
     if (! incomingMessages.isEmpty())
@@ -133,6 +173,65 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
     }
 }
 
+//==============================================================================
+void MidiMessageCollector::CallbackClock::update (double timeNow, double blockDuration) noexcept
+{
+    // This is the second-order DLL described by Fons Adriaensen in "Using a DLL to filter
+    // time". It gives a steady estimate of when the callbacks happen, so that the
+    // scheduling jitter of the audio thread doesn't end up in the midi timing.
+    auto error = timeNow - nextCallbackTime;
+
+    if (! hasStarted || std::abs (error) > 0.1 || std::abs (blockDuration - period) > period * 0.01)
+    {
+        // (starting, after a glitch, or when the block size changes, just jump to the new time)
+        previousCallbackTime = timeNow - blockDuration;
+        callbackTime = timeNow;
+        nextCallbackTime = timeNow + blockDuration;
+        period = blockDuration;
+        hasStarted = true;
+        return;
+    }
+
+    const double bandwidthHz = 0.5;
+    auto omega = 2.0 * MathConstants<double>::pi * bandwidthHz * blockDuration;
+
+    previousCallbackTime = callbackTime;
+    callbackTime = nextCallbackTime;
+    nextCallbackTime += std::sqrt (2.0) * omega * error + period;
+    period += omega * omega * error;
+}
+
+void MidiMessageCollector::removeNextBlockWithSampleAccurateTiming (MidiBuffer& destBuffer, int numSamples)
+{
+    callbackClock.update (Time::getMillisecondCounterHiRes() * 0.001, numSamples / sampleRate);
+
+    // This block plays the messages that were stamped during the previous callback period,
+    // so its first sample corresponds to the time of the previous callback.
+    auto blockStartTime = callbackClock.previousCallbackTime;
+
+    incomingMessages.swapWith (messagesForLaterBlocks);
+    messagesForLaterBlocks.clear();
+
+    while (pendingMessages.pop (lastPendingMessage))
+    {
+        auto samplePosition = roundToInt ((lastPendingMessage.getTimeStamp() - blockStartTime) * sampleRate);
+        incomingMessages.addEvent (lastPendingMessage, jlimit (0, (int) sampleRate, samplePosition));
+    }
+
+    const uint8* midiData;
+    int numBytes, samplePosition;
+
+    for (MidiBuffer::Iterator iter (incomingMessages); iter.getNextEvent (midiData, numBytes, samplePosition);)
+    {
+        if (samplePosition < numSamples)
+            destBuffer.addEvent (midiData, numBytes, samplePosition);
+        else
+            messagesForLaterBlocks.addEvent (midiData, numBytes, samplePosition - numSamples);
+    }
+
+    incomingMessages.clear();
+}
+
 //==============================================================================
 void MidiMessageCollector::handleNoteOn (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity)
 {
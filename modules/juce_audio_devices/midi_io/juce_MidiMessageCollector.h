@@ -31,6 +31,10 @@ namespace juce
     The class can also be used as either a MidiKeyboardStateListener or a MidiInputCallback
     so it can easily use a midi input or keyboard component as its source.
 
+    The messages are passed from the threads which add them to the thread which removes
+    them through a lock-free MultiProducerFifo, so several midi inputs can feed the same
+    collector without ever blocking the audio callback.
+
     @see MidiMessage, MidiInput
 */
 class JUCE_API  MidiMessageCollector    : public MidiKeyboardStateListener,
@@ -38,8 +42,14 @@ class JUCE_API  MidiMessageCollector    : public MidiKeyboardStateListener,
 {
 public:
     //==============================================================================
-    /** Creates a MidiMessageCollector. */
-    MidiMessageCollector();
+    /** Creates a MidiMessageCollector.
+
+        @param maxPendingMessages   the number of messages that can be waiting to be removed
+                                    by removeNextBlockOfMessages() - once this many have been
+                                    queued, any more will be dropped. It's rounded up to a
+                                    power of two.
+    */
+    explicit MidiMessageCollector (int maxPendingMessages = 1024);
 
     /** Destructor. */
     ~MidiMessageCollector();
@@ -49,6 +59,9 @@ public:
 
         You need to call this method before starting to use the collector, so that
         it knows the correct sample rate to use.
+
+        This must not be called while another thread may be calling
+        removeNextBlockOfMessages().
     */
     void reset (double sampleRate);
 
@@ -57,10 +70,21 @@ public:
         The message's timestamp is taken, and it will be ready for retrieval as part
         of the block returned by the next call to removeNextBlockOfMessages().
 
-        This method is fully thread-safe when overlapping calls are made with
-        removeNextBlockOfMessages().
+        This method can be called by several threads at once, and is fully thread-safe
+        when overlapping calls are made with removeNextBlockOfMessages(). It never blocks,
+        so if the number of messages waiting to be removed has reached the limit that was
+        given to the constructor, the new message is dropped. If you expect large bursts
+        of messages, e.g. sysex dumps, make sure the limit is big enough to hold them.
+
+        @returns false if the message had to be dropped
+        @see getNumDroppedMessages
+    */
+    bool addMessageToQueue (const MidiMessage& message);
+
+    /** Returns the number of messages that addMessageToQueue() has had to drop since
+        the last call to reset(), because too many were waiting to be removed.
     */
-    void addMessageToQueue (const MidiMessage& message);
+    int getNumDroppedMessages() const noexcept          { return numDroppedMessages.get(); }
 
     /** Removes all the pending messages from the queue as a buffer.
 
@@ -78,6 +102,27 @@ public:
     */
     void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples);
 
+    /** Chooses how removeNextBlockOfMessages() turns the messages' timestamps into
+        sample positions.
+
+        By default, all the messages that have arrived since the last block are spread
+        across the next block, which means that the spacing between them can get
+        stretched or squashed when the callbacks are irregular.
+
+        If you enable sample-accurate timing, the collector keeps a smoothed estimate of
+        when each audio callback happens, and uses it to convert each message's timestamp
+        to an exact position on the audio clock. Each message then comes out exactly one
+        block after the time it was stamped with, so the timing between messages is kept
+        to the sample, and any that fall beyond the end of a block are held back for the
+        next one. For this to work properly, removeNextBlockOfMessages() must be called
+        once for every audio callback, with the callback's full block size.
+
+        This must not be called while another thread may be calling
+        removeNextBlockOfMessages(), and it resets the timing estimate in the same way
+        as reset() does.
+    */
+    void setSampleAccurateTiming (bool shouldUseSampleAccurateTiming);
+
 
     //==============================================================================
     /** @internal */
@@ -90,13 +135,31 @@ public:
 private:
     //==============================================================================
     double lastCallbackTime = 0;
-    CriticalSection midiCallbackLock;
-    MidiBuffer incomingMessages;
+    MultiProducerFifo<MidiMessage> pendingMessages;
+    Atomic<int> numDroppedMessages;
+    MidiMessage lastPendingMessage;
+    MidiBuffer incomingMessages, messagesForLaterBlocks;
     double sampleRate = 44100.0;
+
+    // A delay-locked loop which tracks the audio callback times, for sample-accurate timing
+    struct CallbackClock
+    {
+        void reset() noexcept               { hasStarted = false; }
+        void update (double timeNow, double blockDuration) noexcept;
+
+        double previousCallbackTime = 0, callbackTime = 0, nextCallbackTime = 0, period = 0;
+        bool hasStarted = false;
+    };
+
+    CallbackClock callbackClock;
+    bool useSampleAccurateTiming = false;
    #if JUCE_DEBUG
     bool hasCalledReset = false;
    #endif
 
+    void collectPendingMessages() noexcept;
+    void removeNextBlockWithSampleAccurateTiming (MidiBuffer&, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiMessageCollector)
 };
 
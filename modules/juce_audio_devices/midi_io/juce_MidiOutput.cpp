@@ -23,21 +23,196 @@
 namespace juce
 {
 
-struct MidiOutput::PendingMessage
+// A block of messages from one call to sendBlockOfMessages(). These are pushed onto
+// a lock-free stack by the sender, and collected by the scheduler thread.
+struct MidiOutput::PendingBlock
 {
-    PendingMessage (const void* const data, const int len, const double timeStamp)
-        : message (data, len, timeStamp)
-    {}
+    PendingBlock* next = nullptr;
+    uint32 clearCountWhenAdded;
+    Array<MidiMessage> messages;
+};
 
-    MidiMessage message;
-    PendingMessage* next;
+void MidiOutput::deletePendingBlocks (PendingBlock* block)
+{
+    while (block != nullptr)
+    {
+        const ScopedPointer<PendingBlock> deleter (block);
+        block = block->next;
+    }
+}
+
+//==============================================================================
+/*  The thread that sends the timestamped messages for all the MidiOutputs.
+
+    It keeps all the outputs' messages in one heap, ordered by time. It sleeps until
+    shortly before the next message is due, and then yields in a loop until the exact
+    time, because a plain wait() is only accurate to a millisecond or so.
+*/
+struct MidiOutput::Scheduler  : private Thread
+{
+    Scheduler() : Thread ("midi out")
+    {
+        startThread (9);
+    }
+
+    ~Scheduler()
+    {
+        stopThread (5000);
+    }
+
+    static void addOutput (MidiOutput& output)
+    {
+        const ScopedLock sl (getInstanceLock());
+        auto*& instance = getInstance();
+
+        if (instance == nullptr)
+            instance = new Scheduler();
+
+        const ScopedLock sl2 (instance->lock);
+        instance->outputs.addIfNotAlreadyThere (&output);
+        output.scheduler = instance;
+    }
+
+    static void removeOutput (MidiOutput& output)
+    {
+        ScopedPointer<Scheduler> schedulerToDelete;
+
+        {
+            const ScopedLock sl (getInstanceLock());
+            auto*& instance = getInstance();
+
+            if (instance == nullptr)
+                return;
+
+            {
+                const ScopedLock sl2 (instance->lock);
+                instance->outputs.removeFirstMatchingValue (&output);
+                instance->removeScheduledMessages (output);
+                output.scheduler = nullptr;
+
+                if (instance->outputs.isEmpty())
+                {
+                    schedulerToDelete = instance;
+                    instance = nullptr;
+                }
+            }
+        }
+    }
+
+    void wakeUp()
+    {
+        notify();
+    }
+
+private:
+    struct ScheduledMessage
+    {
+        MidiMessage message;
+        MidiOutput* output;
+        uint32 clearCount;
+        uint64 order;
+
+        // the heap keeps the earliest message at the front, and messages with the same
+        // time stay in the order that they were added
+        static bool isLaterThan (const ScheduledMessage& a, const ScheduledMessage& b) noexcept
+        {
+            auto timeA = a.message.getTimeStamp();
+            auto timeB = b.message.getTimeStamp();
+            return timeA > timeB || (timeA == timeB && a.order > b.order);
+        }
+    };
+
+    CriticalSection lock;
+    Array<MidiOutput*> outputs;
+    Array<ScheduledMessage> queue;
+    uint64 nextOrder = 0;
+
+    // A wait() can overshoot by a millisecond or two, so we stop waiting this long
+    // before a message is due, and yield until it's time to send it.
+    static constexpr double spinTimeMs = 2.0;
+
+    static CriticalSection& getInstanceLock()   { static CriticalSection cs; return cs; }
+    static Scheduler*& getInstance()            { static Scheduler* instance = nullptr; return instance; }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            double msUntilNextMessage = 500.0;
+
+            {
+                const ScopedLock sl (lock);
+                collectNewMessages();
+
+                while (! queue.isEmpty())
+                {
+                    auto& next = queue.getReference (0);
+                    auto now = Time::getMillisecondCounterHiRes();
+                    auto eventTime = next.message.getTimeStamp();
+
+                    if (eventTime > now)
+                    {
+                        msUntilNextMessage = eventTime - now;
+                        break;
+                    }
+
+                    if (next.clearCount == next.output->clearCount.load() && eventTime > now - 200.0)
+                        next.output->sendMessageNow (next.message);
+
+                    std::pop_heap (queue.begin(), queue.end(), ScheduledMessage::isLaterThan);
+                    queue.removeLast();
+                }
+            }
+
+            if (msUntilNextMessage > spinTimeMs)
+                wait ((int) (msUntilNextMessage - spinTimeMs));
+            else
+                Thread::yield();
+        }
+    }
+
+    void collectNewMessages()
+    {
+        for (auto* output : outputs)
+        {
+            // The blocks come off the stack newest-first, so we reverse them before
+            // adding their messages, to keep any messages with equal times in order
+            PendingBlock* blocks = nullptr;
+
+            for (auto* b = output->pendingBlocks.exchange (nullptr); b != nullptr;)
+            {
+                auto* next = b->next;
+                b->next = blocks;
+                blocks = b;
+                b = next;
+            }
+
+            for (auto* b = blocks; b != nullptr; b = b->next)
+            {
+                for (auto& m : b->messages)
+                {
+                    queue.add ({ m, output, b->clearCountWhenAdded, nextOrder++ });
+                    std::push_heap (queue.begin(), queue.end(), ScheduledMessage::isLaterThan);
+                }
+            }
+
+            deletePendingBlocks (blocks);
+        }
+    }
+
+    void removeScheduledMessages (MidiOutput& output)
+    {
+        queue.removeIf ([&output] (const ScheduledMessage& m) { return m.output == &output; });
+        std::make_heap (queue.begin(), queue.end(), ScheduledMessage::isLaterThan);
+        deletePendingBlocks (output.pendingBlocks.exchange (nullptr));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Scheduler)
 };
 
+//==============================================================================
 MidiOutput::MidiOutput (const String& midiName)
-    : Thread ("midi out"),
-      internal (nullptr),
-      firstMessage (nullptr),
-      name (midiName)
+    : name (midiName)
 {
 }
 
@@ -56,120 +231,53 @@ void MidiOutput::sendBlockOfMessages (const MidiBuffer& buffer,
                                       double samplesPerSecondForBuffer)
 {
     // You've got to call startBackgroundThread() for this to actually work..
-    jassert (isThreadRunning());
+    jassert (scheduler != nullptr);
 
     // this needs to be a value in the future - RTFM for this method!
     jassert (millisecondCounterToStartAt > 0);
 
+    if (buffer.isEmpty())
+        return;
+
     const double timeScaleFactor = 1000.0 / samplesPerSecondForBuffer;
 
+    auto* block = new PendingBlock();
+    block->clearCountWhenAdded = clearCount.load();
+    block->messages.ensureStorageAllocated (buffer.getNumEvents());
+
     MidiBuffer::Iterator i (buffer);
 
     const uint8* data;
     int len, time;
 
     while (i.getNextEvent (data, len, time))
-    {
-        const double eventTime = millisecondCounterToStartAt + timeScaleFactor * time;
-
-        PendingMessage* const m = new PendingMessage (data, len, eventTime);
+        block->messages.add (MidiMessage (data, len, millisecondCounterToStartAt + timeScaleFactor * time));
 
-        const ScopedLock sl (lock);
+    block->next = pendingBlocks.load();
 
-        if (firstMessage == nullptr || firstMessage->message.getTimeStamp() > eventTime)
-        {
-            m->next = firstMessage;
-            firstMessage = m;
-        }
-        else
-        {
-            PendingMessage* mm = firstMessage;
-
-            while (mm->next != nullptr && mm->next->message.getTimeStamp() <= eventTime)
-                mm = mm->next;
-
-            m->next = mm->next;
-            mm->next = m;
-        }
-    }
+    while (! pendingBlocks.compare_exchange_weak (block->next, block))
+    {}
 
-    notify();
+    if (scheduler != nullptr)
+        scheduler->wakeUp();
 }
 
 void MidiOutput::clearAllPendingMessages()
 {
-    const ScopedLock sl (lock);
-
-    while (firstMessage != nullptr)
-    {
-        PendingMessage* const m = firstMessage;
-        firstMessage = firstMessage->next;
-        delete m;
-    }
+    // any messages that the scheduler has already collected will be skipped
+    // when it sees that this count has changed
+    ++clearCount;
+    deletePendingBlocks (pendingBlocks.exchange (nullptr));
 }
 
 void MidiOutput::startBackgroundThread()
 {
-    startThread (9);
+    Scheduler::addOutput (*this);
 }
 
 void MidiOutput::stopBackgroundThread()
 {
-    stopThread (5000);
-}
-
-void MidiOutput::run()
-{
-    while (! threadShouldExit())
-    {
-        uint32 now = Time::getMillisecondCounter();
-        uint32 eventTime = 0;
-        uint32 timeToWait = 500;
-
-        PendingMessage* message;
-
-        {
-            const ScopedLock sl (lock);
-            message = firstMessage;
-
-            if (message != nullptr)
-            {
-                eventTime = (uint32) roundToInt (message->message.getTimeStamp());
-
-                if (eventTime > now + 20)
-                {
-                    timeToWait = eventTime - (now + 20);
-                    message = nullptr;
-                }
-                else
-                {
-                    firstMessage = message->next;
-                }
-            }
-        }
-
-        if (message != nullptr)
-        {
-            const ScopedPointer<PendingMessage> messageDeleter (message);
-
-            if (eventTime > now)
-            {
-                Time::waitForMillisecondCounter (eventTime);
-
-                if (threadShouldExit())
-                    break;
-            }
-
-            if (eventTime > now - 200)
-                sendMessageNow (message->message);
-        }
-        else
-        {
-            jassert (timeToWait < 1000 * 30);
-            wait ((int) timeToWait);
-        }
-    }
-
+    Scheduler::removeOutput (*this);
     clearAllPendingMessages();
 }
 
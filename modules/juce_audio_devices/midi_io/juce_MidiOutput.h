@@ -32,7 +32,7 @@ namespace juce
 
     @see MidiInput
 */
-class JUCE_API  MidiOutput  : private Thread
+class JUCE_API  MidiOutput
 {
 public:
     //==============================================================================
@@ -94,14 +94,21 @@ public:
     /** This lets you supply a block of messages that will be sent out at some point
         in the future.
 
-        The MidiOutput class has an internal thread that can send out timestamped
-        messages - this appends a set of messages to its internal buffer, ready for
-        sending.
+        A background thread, which is shared by all the open MidiOutputs, sends out
+        timestamped messages - this appends a set of messages to this device's queue,
+        ready for sending. Adding the messages doesn't take any locks, so it's OK to
+        call this from an audio callback, although it does allocate a small amount
+        of memory for each block.
+
+        The thread waits until shortly before each message is due, and then spins
+        until its exact time, so the messages are sent with sub-millisecond accuracy
+        rather than just to the nearest millisecond. Any message that's more than
+        200ms late by the time the thread gets to it is discarded.
 
         This will only work if you've already started the thread with startBackgroundThread().
 
         A time is specified, at which the block of messages should be sent. This time uses
-        the same time base as Time::getMillisecondCounter(), and must be in the future.
+        the same time base as Time::getMillisecondCounterHiRes(), and must be in the future.
 
         The samplesPerSecondForBuffer parameter indicates the number of samples per second
         used by the MidiBuffer. Each event in a MidiBuffer has a sample position, and the
@@ -117,6 +124,9 @@ public:
 
     /** Starts up a background thread so that the device can send blocks of data.
         Call this to get the device ready, before using sendBlockOfMessages().
+
+        All the MidiOutputs share the same thread, which is started when the first one
+        calls this method, and stopped when the last one stops using it.
     */
     void startBackgroundThread();
 
@@ -129,13 +139,17 @@ public:
 private:
     //==============================================================================
     void* internal = nullptr;
-    CriticalSection lock;
-    struct PendingMessage;
-    PendingMessage* firstMessage;
     String name;
 
+    struct PendingBlock;
+    struct Scheduler;
+    friend struct Scheduler;
+    std::atomic<PendingBlock*> pendingBlocks { nullptr };
+    std::atomic<uint32> clearCount { 0 };
+    Scheduler* scheduler = nullptr;
+
     MidiOutput (const String& midiName); // These objects are created with the openDevice() method.
-    void run() override;
+    static void deletePendingBlocks (PendingBlock*);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiOutput)
 };
@@ -156,7 +156,8 @@ public:
           latency (0),
           deviceID (devID),
           isInput (forInput),
-          isInterleaved (true)
+          isInterleaved (true),
+          isMMap (false)
     {
         JUCE_ALSA_LOG ("snd_pcm_open (" << deviceID.toUTF8().getAddress() << ", forInput=" << (int) forInput << ")");
 
@@ -210,11 +211,7 @@ public:
             return false;
         }
 
-        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
-            isInterleaved = true;
-        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
-            isInterleaved = false;
-        else
+        if (! setAccessMode (hwParams))
         {
             jassertfalse;
             return false;
@@ -258,7 +255,7 @@ public:
         }
 
         int dir = 0;
-        unsigned int periods = 4;
+        unsigned int periods = (unsigned int) jmax (2, JUCE_ALSA_NUM_PERIODS);
         snd_pcm_uframes_t samplesPerPeriod = (snd_pcm_uframes_t) bufferSize;
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_set_rate_near (handle, hwParams, &sampleRate, 0))
@@ -279,7 +276,7 @@ public:
             latency = (int) frames * ((int) periods - 1); // (this is the method JACK uses to guess the latency..)
 
         JUCE_ALSA_LOG ("frames: " << (int) frames << ", periods: " << (int) periods
-                          << ", samplesPerPeriod: " << (int) samplesPerPeriod);
+                          << ", samplesPerPeriod: " << (int) samplesPerPeriod << ", mmap: " << (int) isMMap);
 
         snd_pcm_sw_params_t* swParams;
         snd_pcm_sw_params_alloca (&swParams);
@@ -316,6 +313,9 @@ public:
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
+        if (isMMap)
+            return transferMMapSamples (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -333,14 +333,8 @@ public:
             numDone = snd_pcm_writen (handle, (void**) data, (snd_pcm_uframes_t) numSamples);
         }
 
-        if (numDone < 0)
-        {
-            if (numDone == -(EPIPE))
-                underrunCount++;
-
-            if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) numDone, 1 /* silent */)))
-                return false;
-        }
+        if (numDone < 0 && ! recover ((int) numDone))
+            return false;
 
         if (numDone < numSamples)
             JUCE_ALSA_LOG ("Did not write all samples: numDone: " << numDone << ", numSamples: " << numSamples);
@@ -353,6 +347,9 @@ public:
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
+        if (isMMap)
+            return transferMMapSamples (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -360,14 +357,8 @@ public:
 
             snd_pcm_sframes_t num = snd_pcm_readi (handle, scratch.getData(), (snd_pcm_uframes_t) numSamples);
 
-            if (num < 0)
-            {
-                if (num == -(EPIPE))
-                    overrunCount++;
-
-                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) num, 1 /* silent */)))
-                    return false;
-            }
+            if (num < 0 && ! recover ((int) num))
+                return false;
 
 
             if (num < numSamples)
@@ -380,14 +371,8 @@ public:
         {
             snd_pcm_sframes_t num = snd_pcm_readn (handle, (void**) data, (snd_pcm_uframes_t) numSamples);
 
-            if (num < 0)
-            {
-                if (num == -(EPIPE))
-                    overrunCount++;
-
-                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) num, 1 /* silent */)))
-                    return false;
-            }
+            if (num < 0 && ! recover ((int) num))
+                return false;
 
             if (num < numSamples)
                 JUCE_ALSA_LOG ("Did not read all samples: num: " << num << ", numSamples: " << numSamples);
@@ -399,6 +384,20 @@ public:
         return true;
     }
 
+    /** Counts xruns and tries to recover from the error returned by an ALSA call. */
+    bool recover (int errorNum)
+    {
+        if (errorNum == -(EPIPE))
+        {
+            if (isInput)
+                overrunCount++;
+            else
+                underrunCount++;
+        }
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, errorNum, 1 /* silent */));
+    }
+
     //==============================================================================
     snd_pcm_t* handle;
     String error;
@@ -409,7 +408,7 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMMap;
     MemoryBlock scratch;
     ScopedPointer<AudioData::Converter> converter;
 
@@ -468,6 +467,125 @@ private:
         return ConverterHelper <AudioData::Int32>::createConverter (forInput, isLittleEndian, numInterleavedChannels, interleaved);
     }
 
+    //==============================================================================
+    bool setAccessMode (snd_pcm_hw_params_t* hwParams)
+    {
+        struct AccessMode
+        {
+            snd_pcm_access_t access;
+            bool interleaved, mmap;
+        };
+
+        const AccessMode modesToTry[] = {
+           #if JUCE_ALSA_USE_MMAP
+            { SND_PCM_ACCESS_MMAP_INTERLEAVED,    true,  true },
+            { SND_PCM_ACCESS_MMAP_NONINTERLEAVED, false, true },
+           #endif
+            { SND_PCM_ACCESS_RW_INTERLEAVED,      true,  false }, // works better for plughw..
+            { SND_PCM_ACCESS_RW_NONINTERLEAVED,   false, false }
+        };
+
+        for (auto& mode : modesToTry)
+        {
+            if (snd_pcm_hw_params_set_access (handle, hwParams, mode.access) >= 0)
+            {
+                isInterleaved = mode.interleaved;
+                isMMap = mode.mmap;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Converts the samples straight between the device's mmap areas and the
+        callback's buffers, as many periods as are needed to fill numSamples.
+    */
+    bool transferMMapSamples (float* const* data, const int numSamples)
+    {
+        int numDone = 0;
+
+        while (numDone < numSamples)
+        {
+            // capture streams aren't started automatically when they use mmap access
+            if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                 && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recover ((int) avail))
+                    return false;
+
+                continue;
+            }
+
+            if (avail == 0)
+            {
+                auto result = snd_pcm_wait (handle, 1000);
+
+                if (result < 0 && ! recover (result))
+                    return false;
+
+                if (result == 0)
+                {
+                    JUCE_ALSA_LOG ("Timed out waiting for the device: numDone: " << numDone << ", numSamples: " << numSamples);
+                    return true;
+                }
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto numFrames = (snd_pcm_uframes_t) jmin ((snd_pcm_sframes_t) (numSamples - numDone), avail);
+
+            auto result = snd_pcm_mmap_begin (handle, &areas, &offset, &numFrames);
+
+            if (result < 0)
+            {
+                if (! recover (result))
+                    return false;
+
+                continue;
+            }
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                // interleaved channels are addressed through the frame start and a sub-channel index
+                auto& area = areas[isInterleaved ? 0 : i];
+                auto* deviceData = static_cast<char*> (area.addr) + (area.first + offset * area.step) / 8;
+                auto subChannel = isInterleaved ? i : 0;
+
+                if (isInput)
+                    converter->convertSamples (data[i] + numDone, 0, deviceData, subChannel, (int) numFrames);
+                else
+                    converter->convertSamples (deviceData, subChannel, data[i] + numDone, 0, (int) numFrames);
+            }
+
+            auto numCommitted = snd_pcm_mmap_commit (handle, offset, numFrames);
+
+            if (numCommitted < 0)
+            {
+                if (! recover ((int) numCommitted))
+                    return false;
+
+                continue;
+            }
+
+            numDone += (int) numFrames;
+        }
+
+        // playback streams aren't started automatically when they use mmap access
+        if (! isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+             && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+            return false;
+
+        return true;
+    }
+
     //==============================================================================
     bool failed (const int errorNum)
     {
@@ -625,7 +743,12 @@ public:
         if (outputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
             return;
 
-        startThread (9);
+       #if JUCE_ALSA_USE_SCHED_FIFO
+        startRealtimeThread (RealtimeOptions().withPriority (JUCE_ALSA_THREAD_PRIORITY)
+                                              .withApproximateAudioProcessingTime (bufferSize, sampleRate));
+       #else
+        startThread (JUCE_ALSA_THREAD_PRIORITY);
+       #endif
 
         int count = 1000;
 
@@ -695,7 +818,7 @@ public:
                     snd_pcm_sframes_t avail = snd_pcm_avail_update (inputDevice->handle);
 
                     if (avail < 0)
-                        JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
+                        inputDevice->recover ((int) avail);
                 }
 
                 audioIoInProgress = true;
@@ -741,7 +864,7 @@ public:
                 snd_pcm_sframes_t avail = snd_pcm_avail_update (outputDevice->handle);
 
                 if (avail < 0)
-                    JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
+                    outputDevice->recover ((int) avail);
 
                 audioIoInProgress = true;
 
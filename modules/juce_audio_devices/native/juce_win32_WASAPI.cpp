@@ -224,6 +224,21 @@ JUCE_IUNKNOWNCLASS (IAudioClient, "1CB9AD4C-DBFA-4c32-B178-C2F568A703B2")
     JUCE_COMCALL GetService (REFIID, void**) = 0;
 };
 
+// These are only available on Windows 10 and later
+JUCE_COMCLASS (IAudioClient2, "726778CD-F60A-4eda-82DE-E47610CD78AA")  : public IAudioClient
+{
+    JUCE_COMCALL IsOffloadCapable (int, BOOL*) = 0;
+    JUCE_COMCALL SetClientProperties (const void*) = 0;
+    JUCE_COMCALL GetBufferSizeLimits (const WAVEFORMATEX*, BOOL, REFERENCE_TIME*, REFERENCE_TIME*) = 0;
+};
+
+JUCE_COMCLASS (IAudioClient3, "7ED4EE07-8E67-4CD4-8C1A-2B7A5987AD42")  : public IAudioClient2
+{
+    JUCE_COMCALL GetSharedModeEnginePeriod (const WAVEFORMATEX*, UINT32*, UINT32*, UINT32*, UINT32*) = 0;
+    JUCE_COMCALL GetCurrentSharedModeEnginePeriod (WAVEFORMATEX**, UINT32*) = 0;
+    JUCE_COMCALL InitializeSharedAudioStream (DWORD, UINT32, const WAVEFORMATEX*, LPCGUID) = 0;
+};
+
 JUCE_IUNKNOWNCLASS (IAudioCaptureClient, "C8ADBD64-E71E-48a0-A4DE-185C395CD317")
 {
     JUCE_COMCALL GetBuffer (BYTE**, UINT32*, DWORD*, UINT64*, UINT64*) = 0;
@@ -348,6 +363,35 @@ void copyWavFormat (WAVEFORMATEXTENSIBLE& dest, const WAVEFORMATEX* const src) n
                                                                   : sizeof (WAVEFORMATEX));
 }
 
+// When the device's format is 32-bit float, the samples only need to be (de)interleaved
+void copyFromInterleavedFloat (float* dest, const void* source, int channel, int numChannels, int numSamples) noexcept
+{
+    auto* src = static_cast<const float*> (source) + channel;
+
+    if (numChannels == 1)
+    {
+        memcpy (dest, src, sizeof (float) * (size_t) numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = src[i * numChannels];
+}
+
+void copyToInterleavedFloat (void* destination, const float* src, int channel, int numChannels, int numSamples) noexcept
+{
+    auto* dest = static_cast<float*> (destination) + channel;
+
+    if (numChannels == 1)
+    {
+        memcpy (dest, src, sizeof (float) * (size_t) numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i * numChannels] = src[i];
+}
+
 //==============================================================================
 class WASAPIDeviceBase
 {
@@ -366,7 +410,11 @@ public:
           bytesPerSample (0),
           bytesPerFrame (0),
           sampleRateHasChanged (false),
-          shouldClose (false)
+          shouldClose (false),
+          isFloat32 (false),
+          lowLatencyMinPeriod (0),
+          lowLatencyMaxPeriod (0),
+          lowLatencyFundamentalPeriod (0)
     {
         clientEvent = CreateEvent (nullptr, false, false, nullptr);
 
@@ -384,6 +432,10 @@ public:
 
         WAVEFORMATEXTENSIBLE format;
         copyWavFormat (format, mixFormat);
+
+        if (! useExclusiveMode)
+            findLowLatencySharedModePeriods (tempClient, mixFormat);
+
         CoTaskMemFree (mixFormat);
 
         actualNumChannels = numChannels = format.Format.nChannels;
@@ -392,6 +444,9 @@ public:
         defaultBufferSize = refTimeToSamples (defaultPeriod, defaultSampleRate);
         mixFormatChannelMask = format.dwChannelMask;
 
+        if (lowLatencyMinPeriod > 0)
+            minBufferSize = jmin (minBufferSize, (int) lowLatencyMinPeriod);
+
         rates.addUsingDefaultSort (defaultSampleRate);
 
         if (useExclusiveMode
@@ -497,7 +552,10 @@ public:
     Array<int> channelMaps;
     UINT32 actualBufferSize;
     int bytesPerSample, bytesPerFrame;
-    bool sampleRateHasChanged, shouldClose;
+    bool sampleRateHasChanged, shouldClose, isFloat32;
+
+    // the range of periods that an IAudioClient3 can use in shared mode, if it's available
+    UINT32 lowLatencyMinPeriod, lowLatencyMaxPeriod, lowLatencyFundamentalPeriod;
 
     virtual void updateFormat (bool isFloat) = 0;
 
@@ -574,6 +632,64 @@ private:
         return newClient;
     }
 
+    void findLowLatencySharedModePeriods (const ComSmartPtr<IAudioClient>& clientToUse, const WAVEFORMATEX* mixFormat)
+    {
+        ComSmartPtr<IAudioClient3> client3;
+
+        if (SUCCEEDED (clientToUse.QueryInterface (client3)))
+        {
+            UINT32 defaultPeriod = 0, fundamentalPeriod = 0, minPeriod = 0, maxPeriod = 0;
+
+            if (check (client3->GetSharedModeEnginePeriod (mixFormat, &defaultPeriod, &fundamentalPeriod, &minPeriod, &maxPeriod))
+                 && minPeriod > 0 && minPeriod < defaultPeriod && fundamentalPeriod > 0)
+            {
+                lowLatencyMinPeriod = minPeriod;
+                lowLatencyMaxPeriod = maxPeriod;
+                lowLatencyFundamentalPeriod = fundamentalPeriod;
+            }
+        }
+    }
+
+    // Tries to use IAudioClient3 to get a shared mode period which is shorter than the
+    // engine's default one, which is usually 10ms.
+    bool tryInitialisingLowLatencySharedStream (const WAVEFORMATEXTENSIBLE& format, int bufferSizeSamples)
+    {
+        if (useExclusiveMode || lowLatencyMinPeriod == 0
+             || bufferSizeSamples <= 0 || bufferSizeSamples >= defaultBufferSize
+             || format.Format.nSamplesPerSec != (DWORD) defaultSampleRate)
+            return false;
+
+        ComSmartPtr<IAudioClient3> client3;
+
+        if (! check (client.QueryInterface (client3)))
+            return false;
+
+        // The period has to be a multiple of the fundamental period, so round up to the next one
+        auto period = ((UINT32) bufferSizeSamples + lowLatencyFundamentalPeriod - 1) / lowLatencyFundamentalPeriod * lowLatencyFundamentalPeriod;
+        period = jlimit (lowLatencyMinPeriod, lowLatencyMaxPeriod, period);
+
+        if (check (client3->InitializeSharedAudioStream (0x40000 /*AUDCLNT_STREAMFLAGS_EVENTCALLBACK*/,
+                                                         period, (const WAVEFORMATEX*) &format, nullptr)))
+            return true;
+
+        // a client can't be initialised again after a failed attempt, so start again with a new one
+        client3 = nullptr;
+        client = nullptr;
+        client = createClient();
+        return false;
+    }
+
+    void formatWasChosen (const WAVEFORMATEXTENSIBLE& format)
+    {
+        actualNumChannels  = format.Format.nChannels;
+        const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+        bytesPerSample     = format.Format.wBitsPerSample / 8;
+        bytesPerFrame      = format.Format.nBlockAlign;
+        isFloat32          = isFloat && bytesPerSample == 4;
+
+        updateFormat (isFloat);
+    }
+
     struct AudioSampleFormat
     {
         bool useFloat;
@@ -650,6 +766,12 @@ private:
 
         if (findSupportedFormat (client, sampleRate, mixFormatChannelMask, format))
         {
+            if (tryInitialisingLowLatencySharedStream (format, bufferSizeSamples))
+            {
+                formatWasChosen (format);
+                return true;
+            }
+
             REFERENCE_TIME defaultPeriod = 0, minPeriod = 0;
 
             check (client->GetDevicePeriod (&defaultPeriod, &minPeriod));
@@ -666,12 +788,7 @@ private:
 
                 if (check (hr))
                 {
-                    actualNumChannels  = format.Format.nChannels;
-                    const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
-                    bytesPerSample     = format.Format.wBitsPerSample / 8;
-                    bytesPerFrame      = format.Format.nBlockAlign;
-
-                    updateFormat (isFloat);
+                    formatWasChosen (format);
                     return true;
                 }
 
@@ -836,9 +953,15 @@ public:
                 break;
 
             const int reservoirOffset = localRead * bytesPerFrame;
+            const void* const source = addBytesToPointer (reservoir.getData(), reservoirOffset);
 
             for (int i = 0; i < numDestBuffers; ++i)
-                converter->convertSamples (destBuffers[i] + offset, 0, addBytesToPointer (reservoir.getData(), reservoirOffset), channelMaps.getUnchecked(i), samplesToDo);
+            {
+                if (isFloat32)
+                    copyFromInterleavedFloat (destBuffers[i] + offset, source, channelMaps.getUnchecked(i), actualNumChannels, samplesToDo);
+                else
+                    converter->convertSamples (destBuffers[i] + offset, 0, source, channelMaps.getUnchecked(i), samplesToDo);
+            }
 
             bufferSize -= samplesToDo;
             offset += samplesToDo;
@@ -958,7 +1081,12 @@ public:
             if (check (renderClient->GetBuffer ((UINT32) samplesToDo, &outputData)))
             {
                 for (int i = 0; i < numSrcBuffers; ++i)
-                    converter->convertSamples (outputData, channelMaps.getUnchecked(i), srcBuffers[i] + offset, 0, samplesToDo);
+                {
+                    if (isFloat32)
+                        copyToInterleavedFloat (outputData, srcBuffers[i] + offset, channelMaps.getUnchecked(i), actualNumChannels, samplesToDo);
+                    else
+                        converter->convertSamples (outputData, channelMaps.getUnchecked(i), srcBuffers[i] + offset, 0, samplesToDo);
+                }
 
                 renderClient->ReleaseBuffer ((UINT32) samplesToDo, 0);
             }
@@ -1036,6 +1164,15 @@ public:
             if (minBufferSize != defaultBufferSize)
                 bufferSizes.addUsingDefaultSort (minBufferSize);
 
+            // offer the low-latency shared mode periods, if they're available
+            const UINT32 lowLatencyStep = jmax (inputDevice  != nullptr ? inputDevice->lowLatencyFundamentalPeriod  : 0u,
+                                                outputDevice != nullptr ? outputDevice->lowLatencyFundamentalPeriod : 0u);
+
+            if (lowLatencyStep > 0)
+                for (int size = minBufferSize; size < defaultBufferSize; size += (int) lowLatencyStep)
+                    if (! bufferSizes.contains (size))
+                        bufferSizes.addUsingDefaultSort (size);
+
             int n = 64;
             for (int i = 0; i < 40; ++i)
             {
@@ -1223,18 +1360,35 @@ public:
 
     void setMMThreadPriority()
     {
-        DynamicLibrary dll ("avrt.dll");
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
+        // the library is kept open until the thread reverts its registration
+        avrtLibrary.open ("avrt.dll");
+
+        JUCE_LOAD_WINAPI_FUNCTION (avrtLibrary, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+        JUCE_LOAD_WINAPI_FUNCTION (avrtLibrary, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
 
         if (avSetMmThreadCharacteristics != 0 && avSetMmThreadPriority != 0)
         {
-            DWORD dummy = 0;
-            HANDLE h = avSetMmThreadCharacteristics (L"Pro Audio", &dummy);
+            DWORD taskIndex = 0;
+            mmcssHandle = avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex);
+
+            if (mmcssHandle != 0)
+                avSetMmThreadPriority (mmcssHandle, AVRT_PRIORITY_HIGH);
+        }
+    }
+
+    void revertMMThreadPriority()
+    {
+        if (mmcssHandle != 0)
+        {
+            JUCE_LOAD_WINAPI_FUNCTION (avrtLibrary, AvRevertMmThreadCharacteristics, avRevertMmThreadCharacteristics, BOOL, (HANDLE))
 
-            if (h != 0)
-                avSetMmThreadPriority (h, AVRT_PRIORITY_NORMAL);
+            if (avRevertMmThreadCharacteristics != 0)
+                avRevertMmThreadCharacteristics (mmcssHandle);
+
+            mmcssHandle = 0;
         }
+
+        avrtLibrary.close();
     }
 
     void run() override
@@ -1318,6 +1472,8 @@ public:
                 break; // Quit the thread... will restart it later!
             }
         }
+
+        revertMMThreadPriority();
     }
 
     //==============================================================================
@@ -1344,6 +1500,9 @@ private:
     AudioIODeviceCallback* callback;
     CriticalSection startStopLock;
 
+    DynamicLibrary avrtLibrary;
+    HANDLE mmcssHandle = 0;
+
     BigInteger lastKnownInputChannels, lastKnownOutputChannels;
 
     //==============================================================================
@@ -198,6 +198,14 @@ public:
                 FLAC__stream_decoder_process_until_end_of_metadata (decoder);
                 lengthInSamples = tempLength;
             }
+
+            // this is where the index of frame positions will start from
+            FlacNamespace::FLAC__uint64 firstFramePosition = 0;
+
+            if (FLAC__stream_decoder_get_decode_position (decoder, &firstFramePosition))
+                indexScanPosition = (int64) firstFramePosition;
+            else
+                indexIsUsable = false;
         }
     }
 
@@ -210,8 +218,10 @@ public:
     {
         sampleRate = info.sample_rate;
         bitsPerSample = info.bits_per_sample;
-        lengthInSamples = (unsigned int) info.total_samples;
+        lengthInSamples = (int64) info.total_samples;
         numChannels = info.channels;
+        streamBlockSize = info.min_blocksize == info.max_blocksize ? (int) info.max_blocksize : 0;
+        minFrameSize = (int) info.min_framesize;
 
         reservoir.setSize ((int) numChannels, 2 * (int) info.max_blocksize, false, false, true);
     }
@@ -245,18 +255,14 @@ public:
             }
             else
             {
-                if (startSampleInFile >= (int) lengthInSamples)
+                if (startSampleInFile >= lengthInSamples)
                 {
                     samplesInReservoir = 0;
                 }
                 else if (startSampleInFile < reservoirStart
                           || startSampleInFile > reservoirStart + jmax (samplesInReservoir, 511))
                 {
-                    // had some problems with flac crashing if the read pos is aligned more
-                    // accurately than this. Probably fixed in newer versions of the library, though.
-                    reservoirStart = (int) (startSampleInFile & ~511);
-                    samplesInReservoir = 0;
-                    FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) reservoirStart);
+                    seekToSample (startSampleInFile);
                 }
                 else
                 {
@@ -280,7 +286,7 @@ public:
         return true;
     }
 
-    void useSamples (const FlacNamespace::FLAC__int32* const buffer[], int numSamples)
+    void useSamples (const FlacNamespace::FLAC__int32* const buffer[], int64 firstSample, int numSamples)
     {
         if (scanningForLength)
         {
@@ -288,6 +294,8 @@ public:
         }
         else
         {
+            reservoirStart = firstSample;
+
             if (numSamples > reservoir.getNumSamples())
                 reservoir.setSize ((int) numChannels, numSamples, false, false, true);
 
@@ -323,7 +331,7 @@ public:
 
     static FlacNamespace::FLAC__StreamDecoderSeekStatus seekCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__uint64 absolute_byte_offset, void* client_data)
     {
-        static_cast<const FlacReader*> (client_data)->input->setPosition ((int) absolute_byte_offset);
+        static_cast<const FlacReader*> (client_data)->input->setPosition ((int64) absolute_byte_offset);
         return FlacNamespace::FLAC__STREAM_DECODER_SEEK_STATUS_OK;
     }
 
@@ -349,7 +357,8 @@ public:
                                                                          const FlacNamespace::FLAC__int32* const buffer[],
                                                                          void* client_data)
     {
-        static_cast<FlacReader*> (client_data)->useSamples (buffer, (int) frame->header.blocksize);
+        static_cast<FlacReader*> (client_data)->useSamples (buffer, (int64) frame->header.number.sample_number,
+                                                            (int) frame->header.blocksize);
         return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
     }
 
@@ -365,11 +374,198 @@ public:
     }
 
 private:
+    //==============================================================================
+    // Each entry is the start of a frame, which is found by scanning the stream for
+    // frame headers the first time a read needs to seek past the ones found so far.
+    // This means a random read only has to decode the frame containing it, rather than
+    // leaving libFLAC to search for its position.
+    struct FrameIndexEntry
+    {
+        int64 sampleNumber, bytePosition;
+
+        bool operator< (int64 sample) const noexcept    { return sampleNumber < sample; }
+    };
+
+    void seekToSample (int64 sample)
+    {
+        samplesInReservoir = 0;
+
+        if (auto* frame = findFrameContaining (sample))
+        {
+            if (FLAC__stream_decoder_flush (decoder) && input->setPosition (frame->bytePosition))
+            {
+                FLAC__stream_decoder_process_single (decoder);
+
+                if (samplesInReservoir > 0 && sample >= reservoirStart && sample < reservoirStart + samplesInReservoir)
+                    return;
+            }
+
+            // the index doesn't match what the decoder found, so stop using it
+            frameIndex.clearQuick();
+            indexIsUsable = false;
+            samplesInReservoir = 0;
+        }
+
+        // had some problems with flac crashing if the read pos is aligned more
+        // accurately than this. Probably fixed in newer versions of the library, though.
+        reservoirStart = sample & ~511;
+        FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) reservoirStart);
+    }
+
+    const FrameIndexEntry* findFrameContaining (int64 sample)
+    {
+        if (! indexIsUsable)
+            return nullptr;
+
+        while (nextIndexedSample <= sample && scanForMoreFrames())
+        {}
+
+        if (frameIndex.isEmpty() || sample >= nextIndexedSample)
+            return nullptr;
+
+        auto* next = std::lower_bound (frameIndex.begin(), frameIndex.end(), sample + 1);
+        return next == frameIndex.begin() ? nullptr : next - 1;
+    }
+
+    // Adds the frames in the next chunk of the stream to the index, returning false
+    // when there's nothing more to scan.
+    bool scanForMoreFrames()
+    {
+        const int maxHeaderSize = 16, chunkSize = 65536;
+        const uint8* data = nullptr;
+        int64 numAvailable = 0;
+        bool reachedEnd = false;
+
+        if (auto* memoryStream = dynamic_cast<MemoryInputStream*> (input))
+        {
+            // the whole stream is already in memory, so it can be scanned in place
+            auto numRemaining = (int64) memoryStream->getDataSize() - indexScanPosition;
+            data = static_cast<const uint8*> (memoryStream->getData()) + indexScanPosition;
+            numAvailable = jmin (numRemaining, (int64) chunkSize);
+            reachedEnd = numAvailable == numRemaining;
+        }
+        else
+        {
+            scanBuffer.ensureSize ((size_t) chunkSize);
+
+            if (! input->setPosition (indexScanPosition))
+                return false;
+
+            data = static_cast<const uint8*> (scanBuffer.getData());
+            numAvailable = input->read (scanBuffer.getData(), chunkSize);
+            reachedEnd = numAvailable < chunkSize;
+        }
+
+        // a header which starts too near the end of the chunk is left for the next scan
+        auto scanEnd = reachedEnd ? numAvailable : numAvailable - maxHeaderSize;
+        int64 pos = 0;
+
+        while (pos < scanEnd)
+        {
+            int64 frameSampleNumber = 0;
+            int frameBlockSize = 0, headerSize = 0;
+
+            if (data[pos] == 0xff
+                 && parseFrameHeader (data + pos, (int) jmin ((int64) maxHeaderSize, numAvailable - pos),
+                                      frameSampleNumber, frameBlockSize, headerSize)
+                 && frameSampleNumber == nextIndexedSample)
+            {
+                frameIndex.add ({ frameSampleNumber, indexScanPosition + pos });
+                nextIndexedSample += frameBlockSize;
+                pos += jmax (headerSize, minFrameSize);
+            }
+            else
+            {
+                ++pos;
+            }
+        }
+
+        indexScanPosition += jmax ((int64) 0, pos);
+        return ! reachedEnd;
+    }
+
+    // Checks whether the data is a valid frame header, and if so, works out where it
+    // lies in the stream. Syncs can appear by chance in the audio data, so the caller
+    // also makes sure the frame carries on directly from the previous one.
+    bool parseFrameHeader (const uint8* header, int numBytes, int64& sampleNumber, int& blockSize, int& headerSize) const noexcept
+    {
+        if (numBytes < 6 || header[0] != 0xff || (header[1] & 0xfe) != 0xf8)
+            return false;
+
+        const bool variableBlockSize = (header[1] & 1) != 0;
+        auto blockSizeCode  = header[2] >> 4;
+        auto sampleRateCode = header[2] & 0x0f;
+
+        if (blockSizeCode == 0 || sampleRateCode == 15
+             || (header[3] >> 4) > 10 || ((header[3] >> 1) & 7) == 3 || ((header[3] >> 1) & 7) == 7
+             || (header[3] & 1) != 0)
+            return false;
+
+        // the frame or sample number uses the same variable-length coding as UTF-8
+        int pos = 4;
+        auto numberSize = 1;
+        uint64 number = header[pos];
+
+        if ((number & 0x80) != 0)
+        {
+            while (numberSize < 7 && (header[pos] & (0x80 >> numberSize)) != 0)
+                ++numberSize;
+
+            if (numberSize == 1 || header[pos] == 0xff || pos + numberSize > numBytes)
+                return false;
+
+            number &= (uint64) (0x7f >> numberSize);
+
+            for (int i = 1; i < numberSize; ++i)
+            {
+                if ((header[pos + i] & 0xc0) != 0x80)
+                    return false;
+
+                number = (number << 6) | (uint64) (header[pos + i] & 0x3f);
+            }
+        }
+
+        pos += numberSize;
+
+        if (pos + 2 > numBytes)
+            return false;
+
+        if (blockSizeCode == 1)        blockSize = 192;
+        else if (blockSizeCode <= 5)   blockSize = 576 << (blockSizeCode - 2);
+        else if (blockSizeCode == 6)   blockSize = header[pos++] + 1;
+        else if (blockSizeCode == 7)   { blockSize = ((header[pos] << 8) | header[pos + 1]) + 1; pos += 2; }
+        else                           blockSize = 256 << (blockSizeCode - 8);
+
+        if (sampleRateCode == 12)                           pos += 1;
+        else if (sampleRateCode == 13 || sampleRateCode == 14)  pos += 2;
+
+        if (pos >= numBytes || FlacNamespace::FLAC__crc8 (header, (unsigned) pos) != header[pos])
+            return false;
+
+        if (variableBlockSize)
+            sampleNumber = (int64) number;
+        else if (streamBlockSize > 0)
+            sampleNumber = (int64) number * streamBlockSize;
+        else
+            return false;
+
+        headerSize = pos + 1;
+        return true;
+    }
+
+    //==============================================================================
     FlacNamespace::FLAC__StreamDecoder* decoder;
     AudioSampleBuffer reservoir;
-    int reservoirStart = 0, samplesInReservoir = 0;
+    int64 reservoirStart = 0;
+    int samplesInReservoir = 0;
     bool ok = false, scanningForLength = false;
 
+    int streamBlockSize = 0, minFrameSize = 0;
+    Array<FrameIndexEntry> frameIndex;
+    int64 indexScanPosition = 0, nextIndexedSample = 0;
+    MemoryBlock scanBuffer;
+    bool indexIsUsable = true;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
 };
 
@@ -378,33 +574,46 @@ private:
 class FlacWriter  : public AudioFormatWriter
 {
 public:
-    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
+    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex,
+                ThreadPool* poolToUse, int numSamplesPerJob)
         : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
-          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          qualityIndex (qualityOptionIndex),
+          threadPool (poolToUse)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        configureEncoder (encoder);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
                                                encodeTellCallback, encodeMetadataCallback,
                                                this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+        if (ok && threadPool != nullptr)
+        {
+            // Each job has to contain a whole number of blocks, so that every frame except
+            // the very last one in the stream has the standard size
+            auto blockSize = (int) FlacNamespace::FLAC__stream_encoder_get_blocksize (encoder);
+
+            if (numSamplesPerJob <= 0)
+                numSamplesPerJob = blockSize * 64;
+
+            samplesPerJob = jmax (1, numSamplesPerJob / blockSize) * blockSize;
+            FlacNamespace::FLAC__MD5Init (&md5Context);
+        }
     }
 
     ~FlacWriter()
     {
         if (ok)
         {
+            if (threadPool != nullptr)
+            {
+                startNextJob();
+                writeFinishedJobs (0);
+                FlacNamespace::FLAC__MD5Final (md5Digest, &md5Context);
+            }
+
             FlacNamespace::FLAC__stream_encoder_finish (encoder);
             output->flush();
         }
@@ -420,9 +629,12 @@ public:
     //==============================================================================
     bool write (const int** samplesToWrite, int numSamples) override
     {
-        if (! ok)
+        if (! ok || encodingFailed)
             return false;
 
+        if (threadPool != nullptr)
+            return writeToJobs (samplesToWrite, numSamples);
+
         HeapBlock<int*> channels;
         HeapBlock<int> temp;
         auto bitsToShift = 32 - (int) bitsPerSample;
@@ -469,7 +681,17 @@ public:
     void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
+        auto info = metadata->data.stream_info;
+
+        if (threadPool != nullptr)
+        {
+            // The main encoder never saw any audio, so the details of the frames
+            // that were encoded by the jobs have to be filled in here
+            info.min_framesize = minFrameSize;
+            info.max_framesize = maxFrameSize;
+            info.total_samples = totalSamplesWritten;
+            memcpy (info.md5sum, md5Digest, sizeof (md5Digest));
+        }
 
         unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
@@ -532,8 +754,268 @@ public:
     bool ok = false;
 
 private:
+    //==============================================================================
+    // Encodes a run of samples as a complete stream using its own encoder, and keeps
+    // the frames so that the writer can append them to the real stream afterwards.
+    struct EncoderJob  : public ThreadPoolJob
+    {
+        EncoderJob (const FlacWriter& w, int maxSamples)
+            : ThreadPoolJob ("FLAC encoder"),
+              writer (w),
+              samples (w.numChannels * (size_t) maxSamples),
+              capacity (maxSamples)
+        {
+        }
+
+        FlacNamespace::FLAC__int32* getChannel (unsigned int channel) const noexcept
+        {
+            return samples.get() + channel * (size_t) capacity;
+        }
+
+        JobStatus runJob() override
+        {
+            auto* jobEncoder = FlacNamespace::FLAC__stream_encoder_new();
+            writer.configureEncoder (jobEncoder);
+            FlacNamespace::FLAC__stream_encoder_set_do_md5 (jobEncoder, false);
+
+            HeapBlock<const FlacNamespace::FLAC__int32*> channels (writer.numChannels);
+
+            for (unsigned int i = 0; i < writer.numChannels; ++i)
+                channels[i] = getChannel (i);
+
+            failed = FLAC__stream_encoder_init_stream (jobEncoder, frameWriteCallback, nullptr, nullptr, nullptr, this)
+                        != FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                     || ! FLAC__stream_encoder_process (jobEncoder, channels, (unsigned) numSamples);
+
+            if (! FlacNamespace::FLAC__stream_encoder_finish (jobEncoder))
+                failed = true;
+
+            FlacNamespace::FLAC__stream_encoder_delete (jobEncoder);
+            return jobHasFinished;
+        }
+
+        static FlacNamespace::FLAC__StreamEncoderWriteStatus frameWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                                 const FlacNamespace::FLAC__byte buffer[],
+                                                                                 size_t bytes,
+                                                                                 unsigned int numFrameSamples,
+                                                                                 unsigned int /*current_frame*/,
+                                                                                 void* client_data)
+        {
+            // the header and metadata blocks are written with a sample count of zero
+            if (numFrameSamples > 0)
+            {
+                auto* job = static_cast<EncoderJob*> (client_data);
+                job->encodedFrames.write (buffer, bytes);
+                job->frameSizes.add ((int) bytes);
+            }
+
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+        }
+
+        const FlacWriter& writer;
+        HeapBlock<FlacNamespace::FLAC__int32> samples;
+        const int capacity;
+        int numSamples = 0;
+        MemoryOutputStream encodedFrames;
+        Array<int> frameSizes;
+        bool failed = false;
+
+        JUCE_DECLARE_NON_COPYABLE (EncoderJob)
+    };
+
+    void configureEncoder (FlacNamespace::FLAC__StreamEncoder* e) const
+    {
+        if (qualityIndex > 0)
+            FLAC__stream_encoder_set_compression_level (e, (uint32) jmin (8, qualityIndex));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_channels (e, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (e, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (e, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (e, 0);
+        FLAC__stream_encoder_set_do_escape_coding (e, true);
+    }
+
+    bool writeToJobs (const int** samplesToWrite, int numSamples)
+    {
+        auto bitsToShift = 32 - (int) bitsPerSample;
+        auto bytesPerSample = (jmin ((unsigned int) 24, bitsPerSample) + 7) / 8;
+        HeapBlock<const FlacNamespace::FLAC__int32*> channels (numChannels);
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            if (currentJob == nullptr)
+                currentJob = new EncoderJob (*this, samplesPerJob);
+
+            auto numToCopy = jmin (numSamples - pos, currentJob->capacity - currentJob->numSamples);
+
+            for (unsigned int i = 0; i < numChannels; ++i)
+            {
+                auto* dest = currentJob->getChannel (i) + currentJob->numSamples;
+                channels[i] = dest;
+
+                if (samplesToWrite[i] == nullptr)
+                {
+                    zeromem (dest, sizeof (FlacNamespace::FLAC__int32) * (size_t) numToCopy);
+                }
+                else
+                {
+                    auto* src = samplesToWrite[i] + pos;
+
+                    for (int j = 0; j < numToCopy; ++j)
+                        dest[j] = (src[j] >> bitsToShift);
+                }
+            }
+
+            FlacNamespace::FLAC__MD5Accumulate (&md5Context, channels, numChannels, (unsigned) numToCopy, bytesPerSample);
+
+            currentJob->numSamples += numToCopy;
+            pos += numToCopy;
+
+            if (currentJob->numSamples == currentJob->capacity)
+                startNextJob();
+        }
+
+        // Don't let the encoded data pile up faster than it can be written out
+        writeFinishedJobs (threadPool->getNumThreads() * 2);
+        return ! encodingFailed;
+    }
+
+    void startNextJob()
+    {
+        if (currentJob != nullptr && currentJob->numSamples > 0)
+        {
+            threadPool->addJob (currentJob, false);
+            pendingJobs.add (currentJob.release());
+        }
+
+        currentJob = nullptr;
+    }
+
+    // Writes out jobs in order until no more than maxPendingJobs are left, waiting for
+    // the oldest job when there are too many, and otherwise stopping at the first one
+    // which is still running.
+    void writeFinishedJobs (int maxPendingJobs)
+    {
+        while (pendingJobs.size() > 0)
+        {
+            auto* job = pendingJobs.getFirst();
+
+            if (pendingJobs.size() > maxPendingJobs)
+                threadPool->waitForJobToFinish (job, -1);
+            else if (threadPool->contains (job))
+                break;
+
+            if (job->failed)
+                encodingFailed = true;
+
+            const auto* frame = static_cast<const uint8*> (job->encodedFrames.getData());
+
+            for (auto frameSize : job->frameSizes)
+            {
+                if (! encodingFailed && ! writeRenumberedFrame (frame, frameSize))
+                    encodingFailed = true;
+
+                frame += frameSize;
+            }
+
+            totalSamplesWritten += (FlacNamespace::FLAC__uint64) job->numSamples;
+            pendingJobs.remove (0);
+        }
+    }
+
+    // The frames a job produces are numbered from zero, so each frame header has to be
+    // rebuilt with the frame's position in the whole stream, along with both of its CRCs.
+    bool writeRenumberedFrame (const uint8* frame, int frameSize)
+    {
+        // sync code and blocking strategy, block size, sample rate, channels and bit depth
+        const int fixedHeaderSize = 4;
+
+        if (frameSize < fixedHeaderSize + 4)
+            return false;
+
+        auto firstNumberByte = frame[fixedHeaderSize];
+        auto oldNumberSize = 1;
+
+        if ((firstNumberByte & 0x80) != 0)
+            while (oldNumberSize < 7 && (firstNumberByte & (0x80 >> oldNumberSize)) != 0)
+                ++oldNumberSize;
+
+        auto blockSizeCode  = frame[2] >> 4;
+        auto sampleRateCode = frame[2] & 0x0f;
+        auto extraHeaderSize = (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                             + (sampleRateCode == 12 ? 1 : ((sampleRateCode == 13 || sampleRateCode == 14) ? 2 : 0));
+
+        auto oldHeaderSize = fixedHeaderSize + oldNumberSize + extraHeaderSize;
+        auto bodySize = frameSize - oldHeaderSize - 1 - 2;
+
+        if (bodySize < 0)
+            return false;
+
+        uint8 number[7];
+        auto numberSize = encodeFrameNumber (number, numFramesWritten++);
+
+        auto newFrameSize = oldHeaderSize - oldNumberSize + numberSize + 1 + bodySize + 2;
+        frameBuffer.ensureSize ((size_t) newFrameSize);
+        auto* dest = static_cast<uint8*> (frameBuffer.getData());
+
+        memcpy (dest, frame, fixedHeaderSize);
+        memcpy (dest + fixedHeaderSize, number, (size_t) numberSize);
+        memcpy (dest + fixedHeaderSize + numberSize, frame + fixedHeaderSize + oldNumberSize, (size_t) extraHeaderSize);
+
+        auto newHeaderSize = fixedHeaderSize + numberSize + extraHeaderSize;
+        dest[newHeaderSize] = FlacNamespace::FLAC__crc8 (dest, (unsigned) newHeaderSize);
+
+        memcpy (dest + newHeaderSize + 1, frame + oldHeaderSize + 1, (size_t) bodySize);
+
+        auto crc16 = FlacNamespace::FLAC__crc16 (dest, (unsigned) (newFrameSize - 2));
+        dest[newFrameSize - 2] = (uint8) (crc16 >> 8);
+        dest[newFrameSize - 1] = (uint8) (crc16 & 0xff);
+
+        minFrameSize = (minFrameSize == 0 ? (unsigned) newFrameSize : jmin (minFrameSize, (unsigned) newFrameSize));
+        maxFrameSize = jmax (maxFrameSize, (unsigned) newFrameSize);
+
+        return writeData (dest, newFrameSize);
+    }
+
+    // Frame numbers are stored using the same variable-length scheme as UTF-8
+    static int encodeFrameNumber (uint8* dest, uint32 value) noexcept
+    {
+        if (value < 0x80)
+        {
+            dest[0] = (uint8) value;
+            return 1;
+        }
+
+        auto numBytes = value < 0x800 ? 2 : (value < 0x10000 ? 3 : (value < 0x200000 ? 4 : (value < 0x4000000 ? 5 : 6)));
+
+        for (int i = numBytes; --i > 0;)
+        {
+            dest[i] = (uint8) (0x80 | (value & 0x3f));
+            value >>= 6;
+        }
+
+        dest[0] = (uint8) ((0xff00 >> numBytes) | value);
+        return numBytes;
+    }
+
+    //==============================================================================
     FlacNamespace::FLAC__StreamEncoder* encoder;
     int64 streamStartPos;
+    int qualityIndex;
+
+    ThreadPool* threadPool;
+    int samplesPerJob = 0;
+    bool encodingFailed = false;
+    ScopedPointer<EncoderJob> currentJob;
+    OwnedArray<EncoderJob> pendingJobs;
+    MemoryBlock frameBuffer;
+    FlacNamespace::FLAC__MD5Context md5Context;
+    FlacNamespace::FLAC__byte md5Digest[16] = {};
+    FlacNamespace::FLAC__uint64 totalSamplesWritten = 0;
+    uint32 numFramesWritten = 0;
+    unsigned int minFrameSize = 0, maxFrameSize = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
@@ -571,6 +1053,36 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+// A MemoryInputStream that reads from a mapped file, which it keeps open while it's alive
+struct FlacMappedFileHolder
+{
+    FlacMappedFileHolder (const File& file)  : map (new MemoryMappedFile (file, MemoryMappedFile::readOnly, false)) {}
+
+    ScopedPointer<MemoryMappedFile> map;
+};
+
+struct FlacMappedFileInputStream  : private FlacMappedFileHolder,
+                                    public MemoryInputStream
+{
+    FlacMappedFileInputStream (const File& file)
+        : FlacMappedFileHolder (file),
+          MemoryInputStream (map->getData(), map->getData() != nullptr ? map->getSize() : 0, false)
+    {
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FlacMappedFileInputStream)
+};
+
+AudioFormatReader* FlacAudioFormat::createMappedReaderFor (const File& file)
+{
+    ScopedPointer<FlacMappedFileInputStream> in (new FlacMappedFileInputStream (file));
+
+    if (in->getDataSize() == 0)
+        return nullptr;
+
+    return createReaderFor (in.release(), true);
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
@@ -581,7 +1093,8 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
     {
         ScopedPointer<FlacWriter> w (new FlacWriter (out, sampleRate, numberOfChannels,
-                                                     (uint32) bitsPerSample, qualityOptionIndex));
+                                                     (uint32) bitsPerSample, qualityOptionIndex,
+                                                     parallelEncodingPool, samplesPerEncodingJob));
         if (w->ok)
             return w.release();
     }
@@ -589,11 +1102,141 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+void FlacAudioFormat::setParallelEncodingThreadPool (ThreadPool* poolToUse, int numSamplesPerJob) noexcept
+{
+    parallelEncodingPool = poolToUse;
+    samplesPerEncodingJob = numSamplesPerJob;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlacAudioFormatTests  : public UnitTest
+{
+    FlacAudioFormatTests() : UnitTest ("FLAC audio format tests") {}
+
+    void runTest() override
+    {
+        AudioSampleBuffer source (numTestChannels, numTestSamples);
+        Random r (0x1234);
+
+        for (int ch = 0; ch < numTestChannels; ++ch)
+            for (int i = 0; i < numTestSamples; ++i)
+                source.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1))
+                                           + 0.1f * (r.nextFloat() - 0.5f));
+
+        for (auto bitDepth : { 16, 24 })
+        {
+            beginTest ("Writing on one thread, " + String (bitDepth) + " bit");
+            auto serial = writeFlac (source, bitDepth, nullptr);
+            expectDecodesTo (serial, source, bitDepth);
+
+            ThreadPool pool (3);
+
+            beginTest ("Writing in parallel, " + String (bitDepth) + " bit");
+            auto parallel = writeFlac (source, bitDepth, &pool);
+            expectDecodesTo (parallel, source, bitDepth);
+            expect (std::abs ((int) parallel.getSize() - (int) serial.getSize()) < (int) serial.getSize() / 100);
+
+            beginTest ("Random access reads, " + String (bitDepth) + " bit");
+            FlacAudioFormat format;
+            expectRandomReadsMatch (format.createReaderFor (new MemoryInputStream (parallel, false), true), source, bitDepth);
+
+            TemporaryFile tempFile (".flac");
+            expect (tempFile.getFile().replaceWithData (parallel.getData(), parallel.getSize()));
+            expectRandomReadsMatch (format.createReaderFor (new FileInputStream (tempFile.getFile()), true), source, bitDepth);
+            expectRandomReadsMatch (format.createMappedReaderFor (tempFile.getFile()), source, bitDepth);
+        }
+    }
+
+    void expectRandomReadsMatch (AudioFormatReader* newReader, const AudioSampleBuffer& source, int bitDepth)
+    {
+        ScopedPointer<AudioFormatReader> reader (newReader);
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        Random r (0x4567);
+        AudioSampleBuffer block (numTestChannels, 3000);
+        auto tolerance = 1.5f / (float) (1 << (bitDepth - 1));
+
+        for (int i = 0; i < 50; ++i)
+        {
+            auto start = r.nextInt (source.getNumSamples() - block.getNumSamples());
+            reader->read (&block, 0, block.getNumSamples(), start, true, true);
+
+            auto maxError = 0.0f;
+
+            for (int ch = 0; ch < numTestChannels; ++ch)
+                for (int j = 0; j < block.getNumSamples(); ++j)
+                    maxError = jmax (maxError, std::abs (block.getSample (ch, j) - source.getSample (ch, start + j)));
+
+            expect (maxError < tolerance, "Read at " + String (start) + " differs by " + String (maxError));
+        }
+    }
+
+    MemoryBlock writeFlac (const AudioSampleBuffer& source, int bitDepth, ThreadPool* pool)
+    {
+        FlacAudioFormat format;
+        format.setParallelEncodingThreadPool (pool, 4096 * 3);
+
+        MemoryBlock data;
+
+        {
+            ScopedPointer<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (data, false),
+                                                                             44100.0, numTestChannels, bitDepth,
+                                                                             {}, 5));
+            expect (writer != nullptr);
+
+            // odd-sized blocks, so that the jobs get split across calls to write()
+            for (int pos = 0; pos < source.getNumSamples(); pos += 1000)
+                expect (writer->writeFromAudioSampleBuffer (source, pos, jmin (1000, source.getNumSamples() - pos)));
+        }
+
+        return data;
+    }
+
+    void expectDecodesTo (const MemoryBlock& data, const AudioSampleBuffer& source, int bitDepth)
+    {
+        FlacAudioFormat format;
+        ScopedPointer<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        expectEquals ((int) reader->lengthInSamples, source.getNumSamples());
+
+        AudioSampleBuffer decoded (numTestChannels, source.getNumSamples());
+        reader->read (&decoded, 0, source.getNumSamples(), 0, true, true);
+
+        auto tolerance = 1.5f / (float) (1 << (bitDepth - 1));
+        auto maxError = 0.0f;
+
+        for (int ch = 0; ch < numTestChannels; ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (decoded.getSample (ch, i) - source.getSample (ch, i)));
+
+        expect (maxError < tolerance, "Decoded audio differs by " + String (maxError));
+    }
+
+    enum
+    {
+        numTestChannels = 2,
+        numTestSamples = 100000
+    };
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
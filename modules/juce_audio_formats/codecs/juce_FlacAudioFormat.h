@@ -35,6 +35,10 @@ namespace juce
 
     To compile this, you'll need to set the JUCE_USE_FLAC flag.
 
+    The readers keep an index of the position of each frame in the stream, which
+    is built up as reads need to seek further in, so that a random-access read only
+    needs to decode the frame that contains it.
+
     @see AudioFormat
 */
 class JUCE_API  FlacAudioFormat    : public AudioFormat
@@ -56,13 +60,44 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader which decodes from a memory-mapped view of a FLAC file.
+
+        The whole file is mapped, so reading from it doesn't involve any calls to the
+        file system once the pages have been loaded. This is a good choice for samplers
+        and other code that makes a lot of random-access reads.
+
+        Returns nullptr if the file can't be mapped, or isn't a valid FLAC file.
+    */
+    AudioFormatReader* createMappedReaderFor (const File& file);
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
                                         int bitsPerSample,
                                         const StringPairArray& metadataValues,
                                         int qualityOptionIndex) override;
+
+    //==============================================================================
+    /** Makes the writers that this format creates encode their audio on a thread pool.
+
+        FLAC frames can be encoded independently, so when a pool is set, each writer
+        collects the incoming audio into runs of numSamplesPerJob samples and hands each
+        run to the pool to be encoded, while it carries on accepting more data. The frames
+        are written to the stream in their original order, so the file is identical in
+        format to one written on a single thread, although the compressed data may differ
+        slightly in the frames at the edges of each run.
+
+        This only affects writers that are created after it's called. The pool must stay
+        alive until all those writers have been deleted. Pass nullptr to go back to encoding
+        on the thread that calls write(). If numSamplesPerJob is zero, a suitable size is
+        chosen, and the value is always rounded to a whole number of FLAC blocks.
+    */
+    void setParallelEncodingThreadPool (ThreadPool* poolToUse, int numSamplesPerJob = 0) noexcept;
+
 private:
+    ThreadPool* parallelEncodingPool = nullptr;
+    int samplesPerEncodingJob = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
 
@@ -1249,69 +1249,80 @@ namespace DCT
         }
     }
 
-    static void dct64 (float* out0, float* out1, const float* samples) noexcept
+   #if JUCE_USE_SSE_INTRINSICS
+    inline __m128 reverse (__m128 v) noexcept
     {
-        float b1[32], b2[32];
+        return _mm_shuffle_ps (v, v, _MM_SHUFFLE (0, 1, 2, 3));
+    }
+
+    inline float sumOfElements (__m128 v) noexcept
+    {
+        v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_add_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+   #elif JUCE_USE_ARM_NEON
+    inline float32x4_t reverse (float32x4_t v) noexcept
+    {
+        auto pairsSwapped = vrev64q_f32 (v);
+        return vcombine_f32 (vget_high_f32 (pairsSwapped), vget_low_f32 (pairsSwapped));
+    }
 
+    inline float sumOfElements (float32x4_t v) noexcept
+    {
+        auto halves = vadd_f32 (vget_low_f32 (v), vget_high_f32 (v));
+        return vget_lane_f32 (vpadd_f32 (halves, halves), 0);
+    }
+   #endif
+
+    /*  One of the first three butterfly stages of dct64, where each value is paired
+        with its mirror image. The vector versions do exactly the same arithmetic on
+        each element as the scalar one, so the results are identical.
+    */
+    inline void butterfly (const float* in, float* out, const float* costab, int size, bool negateDifferences) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        for (int i = 0; i < size / 2; i += 4)
         {
-            auto* costab = constants.cosTables[0];
-            b1[0x00] = samples[0x00] + samples[0x1F];   b1[0x1F] = (samples[0x00] - samples[0x1F]) * costab[0x0];
-            b1[0x01] = samples[0x01] + samples[0x1E];   b1[0x1E] = (samples[0x01] - samples[0x1E]) * costab[0x1];
-            b1[0x02] = samples[0x02] + samples[0x1D];   b1[0x1D] = (samples[0x02] - samples[0x1D]) * costab[0x2];
-            b1[0x03] = samples[0x03] + samples[0x1C];   b1[0x1C] = (samples[0x03] - samples[0x1C]) * costab[0x3];
-            b1[0x04] = samples[0x04] + samples[0x1B];   b1[0x1B] = (samples[0x04] - samples[0x1B]) * costab[0x4];
-            b1[0x05] = samples[0x05] + samples[0x1A];   b1[0x1A] = (samples[0x05] - samples[0x1A]) * costab[0x5];
-            b1[0x06] = samples[0x06] + samples[0x19];   b1[0x19] = (samples[0x06] - samples[0x19]) * costab[0x6];
-            b1[0x07] = samples[0x07] + samples[0x18];   b1[0x18] = (samples[0x07] - samples[0x18]) * costab[0x7];
-            b1[0x08] = samples[0x08] + samples[0x17];   b1[0x17] = (samples[0x08] - samples[0x17]) * costab[0x8];
-            b1[0x09] = samples[0x09] + samples[0x16];   b1[0x16] = (samples[0x09] - samples[0x16]) * costab[0x9];
-            b1[0x0A] = samples[0x0A] + samples[0x15];   b1[0x15] = (samples[0x0A] - samples[0x15]) * costab[0xA];
-            b1[0x0B] = samples[0x0B] + samples[0x14];   b1[0x14] = (samples[0x0B] - samples[0x14]) * costab[0xB];
-            b1[0x0C] = samples[0x0C] + samples[0x13];   b1[0x13] = (samples[0x0C] - samples[0x13]) * costab[0xC];
-            b1[0x0D] = samples[0x0D] + samples[0x12];   b1[0x12] = (samples[0x0D] - samples[0x12]) * costab[0xD];
-            b1[0x0E] = samples[0x0E] + samples[0x11];   b1[0x11] = (samples[0x0E] - samples[0x11]) * costab[0xE];
-            b1[0x0F] = samples[0x0F] + samples[0x10];   b1[0x10] = (samples[0x0F] - samples[0x10]) * costab[0xF];
-        }
-
-        {
-            auto* costab = constants.cosTables[1];
-            b2[0x00] = b1[0x00] + b1[0x0F];   b2[0x0F] = (b1[0x00] - b1[0x0F]) * costab[0];
-            b2[0x01] = b1[0x01] + b1[0x0E];   b2[0x0E] = (b1[0x01] - b1[0x0E]) * costab[1];
-            b2[0x02] = b1[0x02] + b1[0x0D];   b2[0x0D] = (b1[0x02] - b1[0x0D]) * costab[2];
-            b2[0x03] = b1[0x03] + b1[0x0C];   b2[0x0C] = (b1[0x03] - b1[0x0C]) * costab[3];
-            b2[0x04] = b1[0x04] + b1[0x0B];   b2[0x0B] = (b1[0x04] - b1[0x0B]) * costab[4];
-            b2[0x05] = b1[0x05] + b1[0x0A];   b2[0x0A] = (b1[0x05] - b1[0x0A]) * costab[5];
-            b2[0x06] = b1[0x06] + b1[0x09];   b2[0x09] = (b1[0x06] - b1[0x09]) * costab[6];
-            b2[0x07] = b1[0x07] + b1[0x08];   b2[0x08] = (b1[0x07] - b1[0x08]) * costab[7];
-            b2[0x10] = b1[0x10] + b1[0x1F];   b2[0x1F] = (b1[0x1F] - b1[0x10]) * costab[0];
-            b2[0x11] = b1[0x11] + b1[0x1E];   b2[0x1E] = (b1[0x1E] - b1[0x11]) * costab[1];
-            b2[0x12] = b1[0x12] + b1[0x1D];   b2[0x1D] = (b1[0x1D] - b1[0x12]) * costab[2];
-            b2[0x13] = b1[0x13] + b1[0x1C];   b2[0x1C] = (b1[0x1C] - b1[0x13]) * costab[3];
-            b2[0x14] = b1[0x14] + b1[0x1B];   b2[0x1B] = (b1[0x1B] - b1[0x14]) * costab[4];
-            b2[0x15] = b1[0x15] + b1[0x1A];   b2[0x1A] = (b1[0x1A] - b1[0x15]) * costab[5];
-            b2[0x16] = b1[0x16] + b1[0x19];   b2[0x19] = (b1[0x19] - b1[0x16]) * costab[6];
-            b2[0x17] = b1[0x17] + b1[0x18];   b2[0x18] = (b1[0x18] - b1[0x17]) * costab[7];
-        }
-
-        {
-            auto* costab = constants.cosTables[2];
-            b1[0x00] = b2[0x00] + b2[0x07];   b1[0x07] = (b2[0x00] - b2[0x07]) * costab[0];
-            b1[0x01] = b2[0x01] + b2[0x06];   b1[0x06] = (b2[0x01] - b2[0x06]) * costab[1];
-            b1[0x02] = b2[0x02] + b2[0x05];   b1[0x05] = (b2[0x02] - b2[0x05]) * costab[2];
-            b1[0x03] = b2[0x03] + b2[0x04];   b1[0x04] = (b2[0x03] - b2[0x04]) * costab[3];
-            b1[0x08] = b2[0x08] + b2[0x0F];   b1[0x0F] = (b2[0x0F] - b2[0x08]) * costab[0];
-            b1[0x09] = b2[0x09] + b2[0x0E];   b1[0x0E] = (b2[0x0E] - b2[0x09]) * costab[1];
-            b1[0x0A] = b2[0x0A] + b2[0x0D];   b1[0x0D] = (b2[0x0D] - b2[0x0A]) * costab[2];
-            b1[0x0B] = b2[0x0B] + b2[0x0C];   b1[0x0C] = (b2[0x0C] - b2[0x0B]) * costab[3];
-            b1[0x10] = b2[0x10] + b2[0x17];   b1[0x17] = (b2[0x10] - b2[0x17]) * costab[0];
-            b1[0x11] = b2[0x11] + b2[0x16];   b1[0x16] = (b2[0x11] - b2[0x16]) * costab[1];
-            b1[0x12] = b2[0x12] + b2[0x15];   b1[0x15] = (b2[0x12] - b2[0x15]) * costab[2];
-            b1[0x13] = b2[0x13] + b2[0x14];   b1[0x14] = (b2[0x13] - b2[0x14]) * costab[3];
-            b1[0x18] = b2[0x18] + b2[0x1F];   b1[0x1F] = (b2[0x1F] - b2[0x18]) * costab[0];
-            b1[0x19] = b2[0x19] + b2[0x1E];   b1[0x1E] = (b2[0x1E] - b2[0x19]) * costab[1];
-            b1[0x1A] = b2[0x1A] + b2[0x1D];   b1[0x1D] = (b2[0x1D] - b2[0x1A]) * costab[2];
-            b1[0x1B] = b2[0x1B] + b2[0x1C];   b1[0x1C] = (b2[0x1C] - b2[0x1B]) * costab[3];
+            auto front = _mm_loadu_ps (in + i);
+            auto back  = reverse (_mm_loadu_ps (in + size - 4 - i));
+            auto diff  = negateDifferences ? _mm_sub_ps (back, front) : _mm_sub_ps (front, back);
+
+            _mm_storeu_ps (out + i, _mm_add_ps (front, back));
+            _mm_storeu_ps (out + size - 4 - i, reverse (_mm_mul_ps (diff, _mm_loadu_ps (costab + i))));
         }
+       #elif JUCE_USE_ARM_NEON
+        for (int i = 0; i < size / 2; i += 4)
+        {
+            auto front = vld1q_f32 (in + i);
+            auto back  = reverse (vld1q_f32 (in + size - 4 - i));
+            auto diff  = negateDifferences ? vsubq_f32 (back, front) : vsubq_f32 (front, back);
+
+            vst1q_f32 (out + i, vaddq_f32 (front, back));
+            vst1q_f32 (out + size - 4 - i, reverse (vmulq_f32 (diff, vld1q_f32 (costab + i))));
+        }
+       #else
+        for (int i = 0; i < size / 2; ++i)
+        {
+            const int j = size - 1 - i;
+            out[i] = in[i] + in[j];
+            out[j] = (negateDifferences ? (in[j] - in[i]) : (in[i] - in[j])) * costab[i];
+        }
+       #endif
+    }
+
+    static void dct64 (float* out0, float* out1, const float* samples) noexcept
+    {
+        float b1[32], b2[32];
+
+        butterfly (samples, b1, constants.cosTables[0], 32, false);
+
+        butterfly (b1,      b2,      constants.cosTables[1], 16, false);
+        butterfly (b1 + 16, b2 + 16, constants.cosTables[1], 16, true);
+
+        butterfly (b2,      b1,      constants.cosTables[2], 8, false);
+        butterfly (b2 + 8,  b1 + 8,  constants.cosTables[2], 8, true);
+        butterfly (b2 + 16, b1 + 16, constants.cosTables[2], 8, false);
+        butterfly (b2 + 24, b1 + 24, constants.cosTables[2], 8, true);
 
         {
             auto cos0 = constants.cosTables[3][0];
@@ -1549,16 +1560,24 @@ struct MP3Stream
     {
         frameIndex = jmax (0, frameIndex);
 
-        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+        auto scanResult = scanFramePositionsUpTo (frameIndex);
+
+        if (scanResult == reachedEndOfStream)
+            return false;
+
+        if (scanResult == cannotScanHeaders)
         {
-            int dummy = 0;
-            auto result = decodeNextBlock (nullptr, nullptr, dummy);
+            while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+            {
+                int dummy = 0;
+                auto result = decodeNextBlock (nullptr, nullptr, dummy);
 
-            if (result < 0)
-                return false;
+                if (result < 0)
+                    return false;
 
-            if (result > 0)
-                break;
+                if (result > 0)
+                    break;
+            }
         }
 
         frameIndex = jmin (frameIndex & ~(storedStartPosInterval - 1),
@@ -1569,6 +1588,136 @@ struct MP3Stream
         return true;
     }
 
+    //==============================================================================
+    enum FrameScanResult
+    {
+        foundFrame,
+        reachedEndOfStream,
+        cannotScanHeaders
+    };
+
+    /*  Finds the stream positions of all the frames up to the given index, starting from
+        the last position that's known. Only the frame headers are read, and each one gives
+        the size of the frame, so the scan can jump straight to the next one without
+        decoding anything. Free-format streams don't have sizes in their headers, so they
+        can't be scanned like this.
+    */
+    FrameScanResult scanFramePositionsUpTo (int frameIndex)
+    {
+        if (frameIndex < frameStreamPositions.size() * storedStartPosInterval)
+            return foundFrame;
+
+        if (frameStreamPositions.isEmpty())
+            return cannotScanHeaders;
+
+        auto oldPos = stream.getPosition();
+        auto index = (frameStreamPositions.size() - 1) * storedStartPosInterval;
+        auto pos = frameStreamPositions.getLast();
+        auto result = foundFrame;
+
+        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+        {
+            pos = findFrameHeader (pos);
+
+            if (pos < 0)
+            {
+                result = reachedEndOfStream;
+                break;
+            }
+
+            stream.setPosition (pos);
+            MP3Frame header;
+            header.decodeHeader ((uint32) stream.readIntBigEndian());
+
+            if (header.frameSize <= 0)
+            {
+                result = cannotScanHeaders;
+                break;
+            }
+
+            if ((index & (storedStartPosInterval - 1)) == 0)
+                frameStreamPositions.set (index / storedStartPosInterval, pos);
+
+            pos += header.frameSize + 4;
+            ++index;
+        }
+
+        stream.setPosition (oldPos);
+        return result;
+    }
+
+    /*  Writes the table of frame positions, so that a reader opened on the same stream
+        later on can seek without scanning anything.
+    */
+    bool writeSeekIndex (OutputStream& out)
+    {
+        if (scanFramePositionsUpTo (std::numeric_limits<int>::max()) != reachedEndOfStream)
+            return false;
+
+        out.writeInt (seekIndexMagicNumber);
+        out.writeInt64 (stream.getTotalLength());
+        out.writeInt ((int) storedStartPosInterval);
+        out.writeInt (frameStreamPositions.size());
+
+        int64 lastPos = 0;
+
+        for (auto pos : frameStreamPositions)
+        {
+            out.writeCompressedInt ((int) (pos - lastPos));
+            lastPos = pos;
+        }
+
+        return true;
+    }
+
+    bool readSeekIndex (const MemoryBlock& data)
+    {
+        if (data.getSize() == 0)
+            return false;
+
+        MemoryInputStream in (data, false);
+        auto streamLength = stream.getTotalLength();
+
+        if (in.readInt() != seekIndexMagicNumber
+             || in.readInt64() != streamLength
+             || in.readInt() != (int) storedStartPosInterval)
+            return false;
+
+        auto numPositions = in.readInt();
+
+        if (numPositions <= 0 || (size_t) numPositions > data.getSize())
+            return false;
+
+        Array<int64> positions;
+        positions.ensureStorageAllocated (numPositions);
+        int64 pos = 0;
+
+        for (int i = 0; i < numPositions; ++i)
+        {
+            auto delta = in.readCompressedInt();
+
+            if (delta < 0 || (delta == 0 && i > 0))
+                return false;
+
+            pos += delta;
+
+            if (pos >= streamLength)
+                return false;
+
+            positions.add (pos);
+        }
+
+        // make sure that the index agrees with any frames that have already been found
+        for (int i = 0; i < jmin (positions.size(), frameStreamPositions.size()); ++i)
+            if (positions.getUnchecked (i) != frameStreamPositions.getUnchecked (i))
+                return false;
+
+        if (positions.size() > frameStreamPositions.size())
+            frameStreamPositions.swapWith (positions);
+
+        return true;
+    }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -1611,6 +1760,28 @@ private:
     enum { storedStartPosInterval = 4 };
     Array<int64> frameStreamPositions;
 
+    enum { seekIndexMagicNumber = 0x4933504d }; // 'MP3I'
+
+    int64 findFrameHeader (int64 startPos)
+    {
+        stream.setPosition (startPos);
+        int offset = -3;
+        uint32 header = 0;
+
+        for (;;)
+        {
+            if (stream.isExhausted() || offset > 32768)
+                return -1;
+
+            header = (header << 8) | (uint8) stream.readByte();
+
+            if (offset >= 0 && isValidHeader (header, frame.layer))
+                return startPos + offset;
+
+            ++offset;
+        }
+    }
+
     struct SideInfoLayer1
     {
         uint8 allocation[32][2];
@@ -2889,8 +3060,87 @@ private:
         }
 
         synthBo = bo;
-        const float* window = constants.decodeWin + 16 - bo1;
+        applySynthesisWindow (out, b0, constants.decodeWin + 16 - bo1, bo1);
+        samplesDone += 32;
+    }
+
+    static void applySynthesisWindow (float* out, const float* b0, const float* window, int bo1) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        // The alternating signs of the first half are applied to the four partial sums,
+        // because each lane only ever holds products with the same sign.
+        #if JUCE_USE_SSE_INTRINSICS
+         const auto oddSigns = _mm_castsi128_ps (_mm_set_epi32 ((int) 0x80000000, 0, (int) 0x80000000, 0));
+         const auto evenMask = _mm_castsi128_ps (_mm_set_epi32 (0, -1, 0, -1));
+
+         #define JUCE_MP3_MUL(w, x)       _mm_mul_ps (_mm_loadu_ps (w), _mm_loadu_ps (x))
+         #define JUCE_MP3_MULADD(s, w, x) _mm_add_ps (s, JUCE_MP3_MUL (w, x))
+         #define JUCE_MP3_REVERSED(w)     DCT::reverse (_mm_loadu_ps (w))
+        #else
+         const float signValues[] = { 1.0f, -1.0f, 1.0f, -1.0f }, maskValues[] = { 1.0f, 0.0f, 1.0f, 0.0f };
+         const auto oddSigns = vld1q_f32 (signValues);
+         const auto evenMask = vld1q_f32 (maskValues);
+
+         #define JUCE_MP3_MUL(w, x)       vmulq_f32 (vld1q_f32 (w), vld1q_f32 (x))
+         #define JUCE_MP3_MULADD(s, w, x) vmlaq_f32 (s, vld1q_f32 (w), vld1q_f32 (x))
+         #define JUCE_MP3_REVERSED(w)     DCT::reverse (vld1q_f32 (w))
+        #endif
+
+        for (int j = 16; j != 0; --j, b0 += 16, window += 32)
+        {
+            auto sum = JUCE_MP3_MUL (window, b0);
+            sum = JUCE_MP3_MULADD (sum, window + 4,  b0 + 4);
+            sum = JUCE_MP3_MULADD (sum, window + 8,  b0 + 8);
+            sum = JUCE_MP3_MULADD (sum, window + 12, b0 + 12);
+
+           #if JUCE_USE_SSE_INTRINSICS
+            *out++ = DCT::sumOfElements (_mm_xor_ps (sum, oddSigns));
+           #else
+            *out++ = DCT::sumOfElements (vmulq_f32 (sum, oddSigns));
+           #endif
+        }
 
+        {
+            auto sum = JUCE_MP3_MUL (window, b0);
+            sum = JUCE_MP3_MULADD (sum, window + 4,  b0 + 4);
+            sum = JUCE_MP3_MULADD (sum, window + 8,  b0 + 8);
+            sum = JUCE_MP3_MULADD (sum, window + 12, b0 + 12);
+
+           #if JUCE_USE_SSE_INTRINSICS
+            *out++ = DCT::sumOfElements (_mm_and_ps (sum, evenMask));
+           #else
+            *out++ = DCT::sumOfElements (vmulq_f32 (sum, evenMask));
+           #endif
+
+            b0 -= 16; window -= 32;
+            window += bo1 << 1;
+        }
+
+        // The second half reads the window backwards, from window[-1] down to window[-15],
+        // followed by window[0]
+        for (int j = 15; j != 0; --j, b0 -= 16, window -= 32)
+        {
+           #if JUCE_USE_SSE_INTRINSICS
+            auto sum = _mm_mul_ps (JUCE_MP3_REVERSED (window - 4), _mm_loadu_ps (b0));
+            sum = _mm_add_ps (sum, _mm_mul_ps (JUCE_MP3_REVERSED (window - 8),  _mm_loadu_ps (b0 + 4)));
+            sum = _mm_add_ps (sum, _mm_mul_ps (JUCE_MP3_REVERSED (window - 12), _mm_loadu_ps (b0 + 8)));
+            sum = _mm_add_ps (sum, _mm_mul_ps (DCT::reverse (_mm_move_ss (_mm_loadu_ps (window - 16), _mm_load_ss (window))),
+                                               _mm_loadu_ps (b0 + 12)));
+           #else
+            auto sum = vmulq_f32 (JUCE_MP3_REVERSED (window - 4), vld1q_f32 (b0));
+            sum = vmlaq_f32 (sum, JUCE_MP3_REVERSED (window - 8),  vld1q_f32 (b0 + 4));
+            sum = vmlaq_f32 (sum, JUCE_MP3_REVERSED (window - 12), vld1q_f32 (b0 + 8));
+            sum = vmlaq_f32 (sum, DCT::reverse (vsetq_lane_f32 (window[0], vld1q_f32 (window - 16), 0)),
+                             vld1q_f32 (b0 + 12));
+           #endif
+
+            *out++ = -DCT::sumOfElements (sum);
+        }
+
+        #undef JUCE_MP3_MUL
+        #undef JUCE_MP3_MULADD
+        #undef JUCE_MP3_REVERSED
+       #else
         for (int j = 16; j != 0; --j, b0 += 16, window += 32)
         {
             auto sum = window[0] * b0[0];  sum -= window[1] * b0[1];
@@ -2926,8 +3176,7 @@ private:
             sum -= window[-15] * b0[14];  sum -= window[0]   * b0[15];
             *out++ = sum;
         }
-
-        samplesDone += 32;
+       #endif
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MP3Stream)
@@ -3027,6 +3276,17 @@ public:
         return true;
     }
 
+    bool useSeekIndex (const MemoryBlock& seekIndex)
+    {
+        return stream.readSeekIndex (seekIndex);
+    }
+
+    bool writeSeekIndex (MemoryBlock& dest)
+    {
+        MemoryOutputStream out (dest, false);
+        return stream.writeSeekIndex (out);
+    }
+
 private:
     MP3Stream stream;
     int64 currentPosition;
@@ -3131,11 +3391,20 @@ bool MP3AudioFormat::isCompressed()                 { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return {}; }
 
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
+{
+    return createReaderFor (sourceStream, deleteStreamIfOpeningFails, MemoryBlock());
+}
+
+AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails,
+                                                    const MemoryBlock& seekIndex)
 {
     ScopedPointer<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream));
 
     if (r->lengthInSamples > 0)
+    {
+        r->useSeekIndex (seekIndex);
         return r.release();
+    }
 
     if (! deleteStreamIfOpeningFails)
         r->input = nullptr;
@@ -3143,6 +3412,18 @@ AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, c
     return nullptr;
 }
 
+MemoryBlock MP3AudioFormat::createSeekIndex (InputStream& source)
+{
+    MemoryBlock seekIndex;
+    MP3Decoder::MP3Reader r (&source);
+
+    if (r.lengthInSamples <= 0 || ! r.writeSeekIndex (seekIndex))
+        seekIndex.reset();
+
+    r.input = nullptr;
+    return seekIndex;
+}
+
 AudioFormatWriter* MP3AudioFormat::createWriterFor (OutputStream*, double /*sampleRateToUse*/,
                                                     unsigned int /*numberOfChannels*/, int /*bitsPerSample*/,
                                                     const StringPairArray& /*metadataValues*/, int /*qualityOptionIndex*/)
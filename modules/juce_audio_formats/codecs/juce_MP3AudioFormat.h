@@ -61,6 +61,23 @@ public:
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that uses a seek index that was made by createSeekIndex().
+
+        Opening a file this way means that seeking won't need to scan the file to find
+        its frames, which can take a long time in a large file. If the index doesn't
+        match the stream, it's ignored and the reader works as normal.
+    */
+    AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails,
+                                        const MemoryBlock& seekIndex);
+
+    /** Scans a stream and returns a table of its frame positions.
+
+        The index can be kept, e.g. in a sidecar file next to the mp3, and given to
+        createReaderFor() whenever the same file is opened again.
+        Returns an empty block if the stream can't be indexed. The stream isn't deleted.
+    */
+    static MemoryBlock createSeekIndex (InputStream& source);
+
     AudioFormatWriter* createWriterFor (OutputStream*, double sampleRateToUse,
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
@@ -209,10 +209,9 @@ void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples
             }
             else
             {
-                Range<int> intRange (Range<int>::findMinAndMax (intBuffer[i], numToDo));
-
-                r = Range<float> (intRange.getStart() / (float) std::numeric_limits<int>::max(),
-                                  intRange.getEnd()   / (float) std::numeric_limits<int>::max());
+                // (this scales by 1 / 2^31, which is what dividing by (float) INT_MAX rounds to)
+                r = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const> (intBuffer[i])
+                        .findMinAndMax ((size_t) numToDo);
             }
 
             results[i] = isFirstBlock ? r : results[i].getUnionWith (r);
@@ -62,20 +62,48 @@ AudioFormatWriter::~AudioFormatWriter()
     delete output;
 }
 
+static inline int convertFloatToInt (double samp) noexcept
+{
+    if (samp <= -1.0)
+        return std::numeric_limits<int>::min();
+
+    if (samp >= 1.0)
+        return std::numeric_limits<int>::max();
+
+    return roundToInt (std::numeric_limits<int>::max() * samp);
+}
+
 static void convertFloatsToInts (int* dest, const float* src, int numSamples) noexcept
 {
     while (--numSamples >= 0)
+        *dest++ = convertFloatToInt (*src++);
+}
+
+void AudioFormatWriter::convertFloatsToFixed (int* dest, const float* src, int numSamples) noexcept
+{
+    if (! ditherEnabled || bitsPerSample == 0 || bitsPerSample >= 32)
     {
-        const double samp = *src++;
+        convertFloatsToInts (dest, src, numSamples);
+        return;
+    }
 
-        if (samp <= -1.0)
-            *dest = std::numeric_limits<int>::min();
-        else if (samp >= 1.0)
-            *dest = std::numeric_limits<int>::max();
-        else
-            *dest = roundToInt (std::numeric_limits<int>::max() * samp);
+    // the size of one step at the file's bit depth, as a float sample value
+    const double ditherLevel = 1.0 / (double) (1 << (bitsPerSample - 1));
+    float noise[512];
 
-        ++dest;
+    while (numSamples > 0)
+    {
+        const int numToDo = jmin (numSamples, numElementsInArray (noise));
+        ditherRandom.fillBuffer (noise, numToDo, Random::triangular);
+
+        // the extra half-step is because the writers truncate rather than round when
+        // they reduce the 32-bit values to their own bit depth
+        for (int i = 0; i < numToDo; ++i)
+            dest[i] = convertFloatToInt (src[i] + ditherLevel * (noise[i] + 0.5));
+
+        dest += numToDo;
+        src += numToDo;
+        numSamples -= numToDo;
     }
 }
 
@@ -112,7 +140,7 @@ bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                 if (isFloatingPoint())
                     FloatVectorOperations::convertFixedToFloat ((float*) b, (int*) b, 1.0f / 0x7fffffff, numToDo);
                 else
-                    convertFloatsToInts ((int*) b, (float*) b, numToDo);
+                    convertFloatsToFixed ((int*) b, (float*) b, numToDo);
             }
         }
 
@@ -173,7 +201,7 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
         const int numToDo = jmin (numSamples, maxSamples);
 
         for (int i = 0; i < numSourceChannels; ++i)
-            convertFloatsToInts (chans[i], channels[i] + startSample, numToDo);
+            convertFloatsToFixed (chans[i], channels[i] + startSample, numToDo);
 
         if (! write ((const int**) chans, numToDo))
             return false;
@@ -222,8 +250,11 @@ public:
           samplesWritten (0),
           samplesPerFlush (0),
           flushSampleCounter (0),
+          samplesPerBatch (0),
           isRunning (true)
     {
+        // if the fifo isn't emptied in time, incoming audio will be lost
+        setTimeSlicePriority (TimeSliceClient::playbackPriority);
         timeSliceThread.addTimeSliceClient (this);
     }
 
@@ -267,7 +298,10 @@ public:
 
     int writePendingData()
     {
-        const int numToDo = fifo.getTotalSize() / 4;
+        if (isRunning && fifo.getNumReady() < samplesPerBatch)
+            return 10;
+
+        const int numToDo = jmax (fifo.getTotalSize() / 4, samplesPerBatch);
 
         int start1, size1, start2, size2;
         fifo.prepareToRead (numToDo, start1, size1, start2, size2);
@@ -324,6 +358,11 @@ public:
         samplesPerFlush = numSamples;
     }
 
+    void setWriteBatchSize (int numSamples) noexcept
+    {
+        samplesPerBatch = jlimit (0, fifo.getTotalSize() / 2, numSamples);
+    }
+
 private:
     AbstractFifo fifo;
     AudioSampleBuffer buffer;
@@ -332,7 +371,7 @@ private:
     CriticalSection thumbnailLock;
     IncomingDataReceiver* receiver;
     int64 samplesWritten;
-    int samplesPerFlush, flushSampleCounter;
+    int samplesPerFlush, flushSampleCounter, samplesPerBatch;
     volatile bool isRunning;
 
     JUCE_DECLARE_NON_COPYABLE (Buffer)
@@ -362,4 +401,9 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+void AudioFormatWriter::ThreadedWriter::setWriteBatchSize (int numSamplesPerBatch) noexcept
+{
+    buffer->setWriteBatchSize (numSamplesPerBatch);
+}
+
 } // namespace juce
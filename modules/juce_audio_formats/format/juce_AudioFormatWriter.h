@@ -174,10 +174,32 @@ public:
     /** Returns true if it's a floating-point format, false if it's fixed-point. */
     bool isFloatingPoint() const noexcept       { return usesFloatingPointData; }
 
+    //==============================================================================
+    /** Enables or disables dithering of floating-point data.
+
+        When this is enabled, writeFromFloatArrays(), writeFromAudioSampleBuffer() and
+        the other methods that take floating-point data will add triangular (TPDF) dither
+        of +/- 1 LSB before the data is reduced to the writer's bit depth. This only
+        affects fixed-point formats of less than 32 bits, and has no effect on data
+        that's passed straight to write().
+
+        By default, dithering is disabled, so the data is simply truncated to the
+        writer's bit depth.
+    */
+    void setDitherEnabled (bool shouldDither) noexcept  { ditherEnabled = shouldDither; }
+
+    /** Returns true if dithering has been enabled with setDitherEnabled(). */
+    bool isDitherEnabled() const noexcept       { return ditherEnabled; }
+
     //==============================================================================
     /**
         Provides a FIFO for an AudioFormatWriter, allowing you to push incoming
         data into a buffer which will be flushed to disk by a background thread.
+
+        Any number of ThreadedWriters can share the same TimeSliceThread. When a lot of
+        them are running at once, giving each one a large FIFO and a write batch size
+        (see setWriteBatchSize()) means the thread spends its time encoding large blocks
+        rather than switching between writers.
     */
     class ThreadedWriter
     {
@@ -235,6 +257,16 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        /** Sets the minimum number of samples that the background thread will write in one go.
+
+            By default the thread writes whatever data is waiting each time it runs. With a
+            batch size set, it leaves the data in the FIFO until at least this many samples
+            have arrived, and then writes them with a single call to the AudioFormatWriter.
+            The size is limited to half the size of the FIFO, and any samples that are still
+            waiting are always written when the ThreadedWriter is deleted.
+        */
+        void setWriteBatchSize (int numSamplesPerBatch) noexcept;
+
     private:
         class Buffer;
         friend struct ContainerDeletePolicy<Buffer>;
@@ -290,8 +322,12 @@ protected:
 
 private:
     String formatName;
+    bool ditherEnabled = false;
+    Random ditherRandom;
     friend class ThreadedWriter;
 
+    void convertFloatsToFixed (int* dest, const float* src, int numSamples) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriter)
 };
 
@@ -0,0 +1,386 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioPeakSummaryCache::Summary::Summary (int64 hash, int64 length, int chans, int blockSize)
+    : hashCode (hash),
+      lengthInSamples (jmax ((int64) 0, length)),
+      numChannels (chans),
+      samplesPerBlock (blockSize),
+      numBlocks ((int) ((lengthInSamples + blockSize - 1) / blockSize)),
+      levels ((size_t) numBlocks * (size_t) chans),
+      blockScanned ((size_t) numBlocks, true)
+{
+}
+
+bool AudioPeakSummaryCache::Summary::isFullyScanned() const noexcept
+{
+    return numBlocksScanned.get() >= numBlocks;
+}
+
+int64 AudioPeakSummaryCache::Summary::getBlockStart (int block) const noexcept
+{
+    return jmin (lengthInSamples, block * (int64) samplesPerBlock);
+}
+
+void AudioPeakSummaryCache::Summary::readMaxLevels (AudioFormatReader& reader, int64 startSample, int64 numSamples,
+                                                    Range<float>* results, int numChannelsToRead)
+{
+    jassert (numChannelsToRead > 0 && numChannelsToRead <= numChannels);
+
+    auto endSample = startSample + numSamples;
+
+    // The last block may be shorter than the others, but it still counts as whole
+    // if the range reaches the end of the file.
+    auto firstBlock = (int) jmin ((int64) numBlocks, (jmax ((int64) 0, startSample) + samplesPerBlock - 1) / samplesPerBlock);
+    auto endBlock   = endSample >= lengthInSamples ? numBlocks : (int) jmax ((int64) 0, endSample / samplesPerBlock);
+
+    if (numSamples <= 0 || endBlock <= firstBlock)
+    {
+        reader.readMaxLevels (startSample, numSamples, results, numChannelsToRead);
+        return;
+    }
+
+    scanBlocks (reader, firstBlock, endBlock);
+
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        for (int i = 0; i < numChannelsToRead; ++i)
+            results[i] = levels[firstBlock * numChannels + i];
+
+        for (int block = firstBlock + 1; block < endBlock; ++block)
+            for (int i = 0; i < numChannelsToRead; ++i)
+                results[i] = results[i].getUnionWith (levels[block * numChannels + i]);
+    }
+
+    HeapBlock<Range<float>> partialLevels;
+
+    auto addPartialBlock = [&] (int64 start, int64 end)
+    {
+        if (end > start)
+        {
+            if (partialLevels == nullptr)
+                partialLevels.malloc ((size_t) numChannelsToRead);
+
+            reader.readMaxLevels (start, end - start, partialLevels, numChannelsToRead);
+
+            for (int i = 0; i < numChannelsToRead; ++i)
+                results[i] = results[i].getUnionWith (partialLevels[i]);
+        }
+    };
+
+    addPartialBlock (startSample, getBlockStart (firstBlock));
+    addPartialBlock (getBlockStart (endBlock), endSample);
+}
+
+void AudioPeakSummaryCache::Summary::scanBlocks (AudioFormatReader& reader, int firstBlock, int endBlock)
+{
+    // Memory-mapped readers can scan each block in its raw format, but anything else
+    // is read in bigger chunks and scanned after it's been converted.
+    auto* mappedReader = dynamic_cast<MemoryMappedAudioFormatReader*> (&reader);
+    const int maxBlocksPerRead = jmax (1, 32768 / samplesPerBlock);
+
+    HeapBlock<Range<float>> blockLevels;
+    AudioSampleBuffer buffer;
+
+    for (int block = firstBlock; block < endBlock;)
+    {
+        int runStart, runEnd;
+
+        {
+            const SpinLock::ScopedLockType sl (lock);
+
+            while (block < endBlock && blockScanned[block])
+                ++block;
+
+            runStart = block;
+
+            while (block < endBlock && ! blockScanned[block] && block - runStart < maxBlocksPerRead)
+                ++block;
+
+            runEnd = block;
+        }
+
+        if (runStart == runEnd)
+            break;
+
+        if (blockLevels == nullptr)
+            blockLevels.malloc ((size_t) (maxBlocksPerRead * numChannels));
+
+        if (mappedReader != nullptr)
+        {
+            for (int i = runStart; i < runEnd; ++i)
+                reader.readMaxLevels (getBlockStart (i), getBlockStart (i + 1) - getBlockStart (i),
+                                      blockLevels + (i - runStart) * numChannels, numChannels);
+        }
+        else
+        {
+            auto runStartSample = getBlockStart (runStart);
+            auto numToRead = (int) (getBlockStart (runEnd) - runStartSample);
+
+            buffer.setSize (numChannels, numToRead, false, false, true);
+            reader.read (&buffer, 0, numToRead, runStartSample, true, true);
+
+            for (int i = runStart; i < runEnd; ++i)
+            {
+                auto offset = (int) (getBlockStart (i) - runStartSample);
+                auto length = (int) (getBlockStart (i + 1) - getBlockStart (i));
+
+                for (int chan = 0; chan < numChannels; ++chan)
+                    blockLevels[(i - runStart) * numChannels + chan] = FloatVectorOperations::findMinAndMax (buffer.getReadPointer (chan, offset), length);
+            }
+        }
+
+        storeBlocks (blockLevels, runStart, runEnd);
+    }
+}
+
+void AudioPeakSummaryCache::Summary::storeBlocks (const Range<float>* blockLevels, int firstBlock, int endBlock)
+{
+    const SpinLock::ScopedLockType sl (lock);
+
+    // (another client may have scanned some of these blocks in the meantime, which is harmless)
+    for (int block = firstBlock; block < endBlock; ++block)
+    {
+        if (! blockScanned[block])
+        {
+            for (int i = 0; i < numChannels; ++i)
+                levels[block * numChannels + i] = blockLevels[(block - firstBlock) * numChannels + i];
+
+            blockScanned[block] = true;
+            ++numBlocksScanned;
+        }
+    }
+}
+
+//==============================================================================
+AudioPeakSummaryCache::AudioPeakSummaryCache (int maxNum, int blockSize)
+    : maxNumSummaries (maxNum), samplesPerBlock (blockSize)
+{
+    jassert (maxNumSummaries > 0 && samplesPerBlock > 0);
+}
+
+AudioPeakSummaryCache::~AudioPeakSummaryCache()
+{
+}
+
+int AudioPeakSummaryCache::indexOf (int64 hashCode) const noexcept
+{
+    for (int i = summaries.size(); --i >= 0;)
+        if (summaries.getObjectPointerUnchecked (i)->hashCode == hashCode)
+            return i;
+
+    return -1;
+}
+
+AudioPeakSummaryCache::Summary::Ptr AudioPeakSummaryCache::getSummaryFor (int64 hashCode, const AudioFormatReader& reader)
+{
+    const ScopedLock sl (lock);
+
+    auto index = indexOf (hashCode);
+
+    if (index >= 0)
+    {
+        auto* existing = summaries.getObjectPointerUnchecked (index);
+
+        if (existing->lengthInSamples == jmax ((int64) 0, reader.lengthInSamples)
+             && existing->numChannels == (int) reader.numChannels)
+        {
+            existing->lastUsed = Time::getMillisecondCounter();
+            return existing;
+        }
+
+        summaries.remove (index);
+    }
+
+    Summary::Ptr summary (new Summary (hashCode, reader.lengthInSamples, (int) reader.numChannels, samplesPerBlock));
+    summary->lastUsed = Time::getMillisecondCounter();
+
+    // make room by dropping the least recently requested summaries that nobody's holding on to
+    while (summaries.size() >= maxNumSummaries)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < summaries.size(); ++i)
+        {
+            auto* s = summaries.getObjectPointerUnchecked (i);
+
+            if (s->getReferenceCount() == 1 && (oldest < 0 || s->lastUsed < summaries.getObjectPointerUnchecked (oldest)->lastUsed))
+                oldest = i;
+        }
+
+        if (oldest < 0)
+            break;
+
+        summaries.remove (oldest);
+    }
+
+    summaries.add (summary);
+    return summary;
+}
+
+AudioPeakSummaryCache::Summary::Ptr AudioPeakSummaryCache::findSummary (int64 hashCode) const
+{
+    const ScopedLock sl (lock);
+    return summaries[indexOf (hashCode)];
+}
+
+void AudioPeakSummaryCache::removeSummary (int64 hashCode)
+{
+    const ScopedLock sl (lock);
+
+    auto index = indexOf (hashCode);
+
+    if (index >= 0)
+        summaries.remove (index);
+}
+
+void AudioPeakSummaryCache::clear()
+{
+    const ScopedLock sl (lock);
+    summaries.clear();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioPeakSummaryCacheTests  : public UnitTest
+{
+public:
+    AudioPeakSummaryCacheTests() : UnitTest ("AudioPeakSummaryCache", "Audio") {}
+
+    void runTest() override
+    {
+        Random r = getRandom();
+        AudioSampleBuffer audio (2, 10000 + r.nextInt (1000));
+
+        for (int chan = 0; chan < audio.getNumChannels(); ++chan)
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+                audio.setSample (chan, i, r.nextFloat() * 2.0f - 1.0f);
+
+        AudioPeakSummaryCache cache (2, 64);
+
+        beginTest ("Levels match the reader's levels");
+        {
+            BufferReader reader (audio);
+            auto summary = cache.getSummaryFor (1, reader);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto start = (int64) r.nextInt (audio.getNumSamples());
+                auto num = (int64) r.nextInt (audio.getNumSamples() - (int) start + 1);
+                expectLevelsMatch (*summary, reader, start, num);
+            }
+
+            expectLevelsMatch (*summary, reader, 0, audio.getNumSamples());
+            expect (summary->isFullyScanned());
+        }
+
+        beginTest ("Summaries are shared between clients");
+        {
+            BufferReader reader (audio);
+            auto summary = cache.getSummaryFor (1, reader);
+            expect (summary == cache.findSummary (1));
+            expect (summary->isFullyScanned());
+
+            Range<float> results[2];
+            summary->readMaxLevels (reader, 0, audio.getNumSamples(), results, 2);
+            expectEquals (reader.numSamplesRead, (int64) 0);
+
+            expectLevelsMatch (*summary, reader, 0, audio.getNumSamples());
+        }
+
+        beginTest ("Summaries which don't match the file are replaced");
+        {
+            AudioSampleBuffer shorterAudio (audio);
+            shorterAudio.setSize (2, audio.getNumSamples() / 2, true);
+
+            BufferReader reader (shorterAudio);
+            auto summary = cache.getSummaryFor (1, reader);
+            expect (! summary->isFullyScanned());
+            expectEquals (summary->getLengthInSamples(), (int64) shorterAudio.getNumSamples());
+            expectLevelsMatch (*summary, reader, 0, shorterAudio.getNumSamples());
+        }
+
+        beginTest ("Unused summaries are removed");
+        {
+            BufferReader reader (audio);
+            auto summary = cache.getSummaryFor (2, reader);
+            cache.getSummaryFor (3, reader);
+            cache.getSummaryFor (4, reader);
+
+            expect (cache.findSummary (1) == nullptr);
+            expect (cache.findSummary (2) == summary);
+            expect (cache.findSummary (4) != nullptr);
+        }
+    }
+
+private:
+    /** A reader that plays back a buffer, and counts the samples it's asked for. */
+    struct BufferReader  : public AudioFormatReader
+    {
+        BufferReader (const AudioSampleBuffer& b)  : AudioFormatReader (nullptr, "test"), buffer (b)
+        {
+            sampleRate = 44100.0;
+            bitsPerSample = 32;
+            usesFloatingPointData = true;
+            lengthInSamples = buffer.getNumSamples();
+            numChannels = (unsigned int) buffer.getNumChannels();
+        }
+
+        bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                               startSampleInFile, numSamples, lengthInSamples);
+
+            for (int i = 0; i < numDestChannels; ++i)
+                if (destSamples[i] != nullptr)
+                    memcpy (destSamples[i] + startOffsetInDestBuffer, buffer.getReadPointer (i, (int) startSampleInFile),
+                            sizeof (float) * (size_t) numSamples);
+
+            numSamplesRead += numSamples;
+            return true;
+        }
+
+        const AudioSampleBuffer& buffer;
+        int64 numSamplesRead = 0;
+    };
+
+    void expectLevelsMatch (AudioPeakSummaryCache::Summary& summary, AudioFormatReader& reader, int64 start, int64 num)
+    {
+        Range<float> expected[2], results[2];
+        reader.readMaxLevels (start, num, expected, 2);
+        summary.readMaxLevels (reader, start, num, results, 2);
+
+        expect (results[0] == expected[0] && results[1] == expected[1]);
+    }
+};
+
+static AudioPeakSummaryCacheTests audioPeakSummaryCacheTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Keeps summaries of the peak levels in audio files, so that several thumbnails,
+    meters or other displays of the same file can share a single scan of it.
+
+    Each summary holds the lowest and highest level of every channel in each block
+    of getSamplesPerBlock() samples. The blocks are filled in the first time that
+    any client needs them, using whichever reader that client passes in, so a file
+    that has already been scanned once can be summarised again without touching
+    the audio data.
+
+    A summary takes 8 bytes per channel for each block, so e.g. an hour of stereo
+    audio at 48kHz with the default block size takes about 11MB.
+
+    @see AudioFormatReader::readMaxLevels, AudioThumbnailCache::setPeakSummaryCache
+*/
+class JUCE_API  AudioPeakSummaryCache
+{
+public:
+    //==============================================================================
+    /** The peak levels of one file, which may be shared between several clients. */
+    class JUCE_API  Summary  : public ReferenceCountedObject
+    {
+    public:
+        typedef ReferenceCountedObjectPtr<Summary> Ptr;
+
+        /** Finds the highest and lowest levels in a range of the file.
+
+            This gives the same results as calling AudioFormatReader::readMaxLevels()
+            on the reader, but the whole blocks in the range are taken from the
+            summary, and only need to be scanned if no client has asked for them yet.
+            Any partial blocks at either end are read from the reader.
+
+            The reader must be reading the same audio that the summary was created for,
+            and must be able to read every sample in the range. It's only used during
+            this call.
+        */
+        void readMaxLevels (AudioFormatReader& reader, int64 startSample, int64 numSamples,
+                            Range<float>* results, int numChannelsToRead);
+
+        /** Returns the hash code that identifies the file. */
+        int64 getHashCode() const noexcept                  { return hashCode; }
+
+        /** Returns the length of the file that this summary describes. */
+        int64 getLengthInSamples() const noexcept           { return lengthInSamples; }
+
+        /** Returns the number of channels in the file that this summary describes. */
+        int getNumChannels() const noexcept                 { return numChannels; }
+
+        /** Returns the number of samples covered by each block of the summary. */
+        int getSamplesPerBlock() const noexcept             { return samplesPerBlock; }
+
+        /** Returns true once the levels of every block in the file are known. */
+        bool isFullyScanned() const noexcept;
+
+    private:
+        friend class AudioPeakSummaryCache;
+
+        Summary (int64 hashCode, int64 lengthInSamples, int numChannels, int samplesPerBlock);
+
+        const int64 hashCode, lengthInSamples;
+        const int numChannels, samplesPerBlock, numBlocks;
+        HeapBlock<Range<float>> levels;
+        HeapBlock<bool> blockScanned;
+        Atomic<int> numBlocksScanned;
+        uint32 lastUsed = 0;
+        SpinLock lock;
+
+        int64 getBlockStart (int block) const noexcept;
+        void scanBlocks (AudioFormatReader&, int firstBlock, int endBlock);
+        void storeBlocks (const Range<float>* blockLevels, int firstBlock, int endBlock);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Summary)
+    };
+
+    //==============================================================================
+    /** Creates a cache.
+
+        The maxNumSummaries parameter is the number of summaries that the cache will
+        keep, although summaries that are still being used by a client won't be thrown
+        away to make room. A smaller samplesPerBlock makes a summary more useful to
+        clients that look at short ranges, but takes more memory.
+    */
+    explicit AudioPeakSummaryCache (int maxNumSummaries, int samplesPerBlock = 256);
+
+    /** Destructor. */
+    ~AudioPeakSummaryCache();
+
+    //==============================================================================
+    /** Returns the summary for the file with the given hash code, creating one if
+        the cache doesn't have it.
+
+        If the stored summary doesn't match the reader's length and number of
+        channels, it's replaced with a new empty one.
+    */
+    Summary::Ptr getSummaryFor (int64 hashCode, const AudioFormatReader& reader);
+
+    /** Returns the summary for the file with the given hash code, or nullptr if the
+        cache doesn't have one.
+    */
+    Summary::Ptr findSummary (int64 hashCode) const;
+
+    /** Tells the cache to forget about the summary with the given hash code.
+        Any clients which are still using it can carry on doing so.
+    */
+    void removeSummary (int64 hashCode);
+
+    /** Clears out all the stored summaries. */
+    void clear();
+
+    /** Returns the number of samples covered by each block of the summaries. */
+    int getSamplesPerBlock() const noexcept                 { return samplesPerBlock; }
+
+private:
+    //==============================================================================
+    ReferenceCountedArray<Summary> summaries;
+    CriticalSection lock;
+    const int maxNumSummaries, samplesPerBlock;
+
+    int indexOf (int64 hashCode) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPeakSummaryCache)
+};
+
+} // namespace juce
@@ -27,14 +27,164 @@
 namespace juce
 {
 
+//==============================================================================
+class BufferingAudioReadScheduler::IOThread  : public Thread
+{
+public:
+    IOThread (BufferingAudioReadScheduler& s)  : Thread ("Audio read-ahead"), owner (s) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! owner.serviceMostUrgentReader())
+                owner.workAvailable.wait (100);
+    }
+
+private:
+    BufferingAudioReadScheduler& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (IOThread)
+};
+
+BufferingAudioReadScheduler::BufferingAudioReadScheduler (int numIOThreads, int maxSamples, int threadPriority)
+    : maxSamplesPerRead (jmax ((int) BufferingAudioReader::samplesPerBlock, maxSamples))
+{
+    jassert (numIOThreads > 0);
+
+    for (int i = 0; i < jmax (1, numIOThreads); ++i)
+        threads.add (new IOThread (*this))->startThread (threadPriority);
+}
+
+BufferingAudioReadScheduler::~BufferingAudioReadScheduler()
+{
+    // All the readers that use this scheduler must be deleted before it is!
+    jassert (readers.isEmpty());
+
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    for (auto* t : threads)
+        t->stopThread (4000);
+}
+
+void BufferingAudioReadScheduler::addReader (BufferingAudioReader* reader)
+{
+    {
+        const ScopedLock sl (lock);
+        readers.addIfNotAlreadyThere (reader);
+    }
+
+    workAvailable.signal();
+}
+
+void BufferingAudioReadScheduler::removeReader (BufferingAudioReader* reader)
+{
+    {
+        const ScopedLock sl (lock);
+        readers.removeFirstMatchingValue (reader);
+    }
+
+    // wait for any thread that's still reading for it to finish
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (! readersInUse.contains (reader))
+                break;
+        }
+
+        Thread::sleep (1);
+    }
+}
+
+void BufferingAudioReadScheduler::readerNeedsData() noexcept
+{
+    workAvailable.signal();
+}
+
+bool BufferingAudioReadScheduler::serviceMostUrgentReader()
+{
+    if (auto* reader = getMostUrgentReader())
+    {
+        reader->readNextBufferChunk (jmax (1, maxSamplesPerRead / (int) BufferingAudioReader::samplesPerBlock));
+        finishedWithReader (reader);
+        return true;
+    }
+
+    return false;
+}
+
+BufferingAudioReader* BufferingAudioReadScheduler::getMostUrgentReader()
+{
+    const ScopedLock sl (lock);
+
+    BufferingAudioReader* best = nullptr;
+    double bestSecondsAhead = 0;
+
+    for (auto* r : readers)
+    {
+        if (readersInUse.contains (r))
+            continue;
+
+        auto secondsAhead = r->getSecondsBufferedAhead();
+
+        if (secondsAhead >= 0 && (best == nullptr || secondsAhead < bestSecondsAhead))
+        {
+            best = r;
+            bestSecondsAhead = secondsAhead;
+        }
+    }
+
+    if (best != nullptr)
+        readersInUse.add (best);
+
+    return best;
+}
+
+void BufferingAudioReadScheduler::finishedWithReader (BufferingAudioReader* reader)
+{
+    const ScopedLock sl (lock);
+    readersInUse.removeFirstMatchingValue (reader);
+}
+
+//==============================================================================
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader), thread (&timeSliceThread), scheduler (nullptr),
       nextReadPosition (0),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock)),
       timeoutMs (0)
+{
+    initialise();
+    setTimeSlicePriority (TimeSliceClient::playbackPriority);
+    timeSliceThread.addTimeSliceClient (this);
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            BufferingAudioReadScheduler& readScheduler,
+                                            int samplesToBuffer)
+    : AudioFormatReader (nullptr, sourceReader->getFormatName()),
+      source (sourceReader), thread (nullptr), scheduler (&readScheduler),
+      nextReadPosition (0),
+      numBlocks (1 + (samplesToBuffer / samplesPerBlock)),
+      timeoutMs (0)
+{
+    initialise();
+    readScheduler.addReader (this);
+}
+
+BufferingAudioReader::~BufferingAudioReader()
+{
+    if (thread != nullptr)
+        thread->removeTimeSliceClient (this);
+    else
+        scheduler->removeReader (this);
+}
+
+void BufferingAudioReader::initialise()
 {
     sampleRate            = source->sampleRate;
     lengthInSamples       = source->lengthInSamples;
@@ -43,15 +193,13 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
-    for (int i = 3; --i >= 0;)
-        readNextBufferChunk();
-
-    timeSliceThread.addTimeSliceClient (this);
-}
+    playingBackwards    = false;
+    playbackSpeed       = 1.0;
+    lastRequestedSample = -1;
+    lastRequestTime     = 0;
 
-BufferingAudioReader::~BufferingAudioReader()
-{
-    thread.removeTimeSliceClient (this);
+    for (int i = 3; --i >= 0;)
+        readNextBufferChunk (1);
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -67,8 +215,12 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
                                        startSampleInFile, numSamples, lengthInSamples);
 
     const ScopedLock sl (lock);
+    updatePlaybackEstimate (startSampleInFile, numSamples);
     nextReadPosition = startSampleInFile;
 
+    if (scheduler != nullptr && getSecondsBufferedAhead() >= 0)
+        scheduler->readerNeedsData();
+
     while (numSamples > 0)
     {
         if (const BufferedBlock* const block = getBlockContaining (startSampleInFile))
@@ -114,6 +266,97 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
     return true;
 }
 
+void BufferingAudioReader::updatePlaybackEstimate (int64 startSample, int numSamples) noexcept
+{
+    const double now = Time::getMillisecondCounterHiRes();
+
+    if (lastRequestedSample >= 0)
+    {
+        const int64 distance = startSample - lastRequestedSample;
+        const int64 largestStep = jmax ((int64) numSamples, (int64) numBlocks * samplesPerBlock);
+
+        if (std::abs (distance) > largestStep)
+        {
+            // a jump this big is a seek rather than playback, so start estimating again
+            playbackSpeed = 1.0;
+        }
+        else if (distance != 0)
+        {
+            playingBackwards = distance < 0;
+
+            const double elapsedSeconds = (now - lastRequestTime) * 0.001;
+
+            if (elapsedSeconds > 0 && sampleRate > 0)
+            {
+                const double speed = std::abs ((double) distance) / (elapsedSeconds * sampleRate);
+                playbackSpeed += 0.2 * (jlimit (1.0, 4.0, speed) - playbackSpeed);
+            }
+        }
+    }
+
+    lastRequestedSample = startSample;
+    lastRequestTime = now;
+}
+
+Range<int64> BufferingAudioReader::getWantedRange() const noexcept
+{
+    const int numBlocksWanted = roundToInt (numBlocks * jlimit (1.0, 4.0, playbackSpeed));
+    const int64 pos = nextReadPosition;
+
+    if (playingBackwards)
+    {
+        const int64 endPos = ((pos + 1024) / samplesPerBlock + 1) * samplesPerBlock;
+        return Range<int64> (jmax ((int64) 0, endPos - numBlocksWanted * (int64) samplesPerBlock), endPos);
+    }
+
+    const int64 startPos = ((pos - 1024) / samplesPerBlock) * samplesPerBlock;
+    return Range<int64> (startPos, startPos + numBlocksWanted * (int64) samplesPerBlock);
+}
+
+double BufferingAudioReader::getSecondsBufferedAhead() const noexcept
+{
+    const ScopedLock sl (lock);
+    const Range<int64> wanted (getWantedRange());
+    const int64 pos = wanted.clipValue (nextReadPosition);
+    int64 end = pos;
+
+    if (playingBackwards)
+    {
+        while (end > wanted.getStart())
+        {
+            if (auto* b = getBlockContaining (end - 1))
+                end = b->range.getStart();
+            else
+                break;
+        }
+    }
+    else
+    {
+        while (end < wanted.getEnd())
+        {
+            if (auto* b = getBlockContaining (end))
+                end = b->range.getEnd();
+            else
+                break;
+        }
+    }
+
+    if (end <= wanted.getStart() || end >= wanted.getEnd())
+    {
+        // everything ahead has been read, so only a gap behind the play position is left
+        bool anyMissing = false;
+
+        for (int64 p = wanted.getStart(); p < wanted.getEnd(); p += samplesPerBlock)
+            if (getBlockContaining (p) == nullptr)
+                anyMissing = true;
+
+        if (! anyMissing)
+            return -1.0;
+    }
+
+    return (double) std::abs (end - pos) / jmax (1.0, sampleRate * playbackSpeed);
+}
+
 BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
     : range (pos, pos + numSamples),
       buffer ((int) reader.numChannels, numSamples)
@@ -136,36 +379,59 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
 
 int BufferingAudioReader::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return readNextBufferChunk (1) ? 1 : 100;
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+bool BufferingAudioReader::readNextBufferChunk (int maxBlocksToRead)
 {
-    const int64 pos = nextReadPosition;
-    const int64 startPos = ((pos - 1024) / samplesPerBlock) * samplesPerBlock;
-    const int64 endPos = startPos + numBlocks * samplesPerBlock;
+    Range<int64> wanted;
+    bool backwards;
+
+    {
+        const ScopedLock sl (lock);
+        wanted = getWantedRange();
+        backwards = playingBackwards;
+    }
 
     OwnedArray<BufferedBlock> newBlocks;
 
     for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked(i)->range.intersects (Range<int64> (startPos, endPos)))
+        if (blocks.getUnchecked(i)->range.intersects (wanted))
             newBlocks.add (blocks.getUnchecked(i));
 
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
-        return false;
-    }
+    // Find the nearest missing block in the direction of play, and merge it with
+    // any missing neighbours so that they're all fetched in one sequential read
+    const int numWanted = (int) (wanted.getLength() / samplesPerBlock);
+    int64 runStart = 0;
+    int runLength = 0;
 
-    for (int64 p = startPos; p < endPos; p += samplesPerBlock)
+    for (int i = 0; i < numWanted && runLength < maxBlocksToRead; ++i)
     {
-        if (getBlockContaining (p) == nullptr)
+        const int64 p = backwards ? wanted.getEnd() - (i + 1) * (int64) samplesPerBlock
+                                  : wanted.getStart() + i * (int64) samplesPerBlock;
+
+        if (getBlockContaining (p) != nullptr)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
+            if (runLength > 0)
+                break;
+
+            continue;
         }
+
+        if (runLength == 0 || backwards)
+            runStart = p;
+
+        ++runLength;
     }
 
+    if (runLength == 0)
+    {
+        newBlocks.clear (false);
+        return false;
+    }
+
+    newBlocks.add (new BufferedBlock (*source, runStart, runLength * samplesPerBlock));
+
     {
         const ScopedLock sl (lock);
         newBlocks.swapWith (blocks);
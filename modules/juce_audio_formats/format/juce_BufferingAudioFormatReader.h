@@ -27,12 +27,81 @@
 namespace juce
 {
 
+class BufferingAudioReader;
+
+//==============================================================================
+/**
+    A set of background threads that does the reading for many BufferingAudioReaders.
+
+    When a lot of BufferingAudioReaders share a single TimeSliceThread, each one
+    polls separately and does small synchronous reads, so a disk ends up seeking
+    back and forth between files. If the readers are given a
+    BufferingAudioReadScheduler instead, its threads always service whichever
+    reader has the least audio buffered ahead of its play position. They also
+    merge neighbouring missing blocks into a single large sequential read.
+
+    Having more than one I/O thread lets reads from different files or disks
+    overlap. That matters most for network volumes, where each request waits a
+    long time.
+
+    The scheduler must outlive all the readers that use it.
+
+    @see BufferingAudioReader
+*/
+class JUCE_API  BufferingAudioReadScheduler
+{
+public:
+    /** Creates a scheduler and starts its threads.
+
+        @param numIOThreads         the number of threads that will perform reads concurrently
+        @param maxSamplesPerRead    the largest number of samples that a single read from
+                                    a source reader may cover
+        @param threadPriority       the priority of the I/O threads, from 0 to 10
+    */
+    BufferingAudioReadScheduler (int numIOThreads = 2,
+                                 int maxSamplesPerRead = 262144,
+                                 int threadPriority = 6);
+
+    /** Destructor.
+        All the readers that use this scheduler must be deleted before it is.
+    */
+    ~BufferingAudioReadScheduler();
+
+    /** Returns the largest number of samples that one read may cover. */
+    int getMaxSamplesPerRead() const noexcept           { return maxSamplesPerRead; }
+
+private:
+    //==============================================================================
+    friend class BufferingAudioReader;
+    class IOThread;
+
+    CriticalSection lock;
+    Array<BufferingAudioReader*> readers, readersInUse;
+    OwnedArray<IOThread> threads;
+    WaitableEvent workAvailable;
+    const int maxSamplesPerRead;
+
+    void addReader (BufferingAudioReader*);
+    void removeReader (BufferingAudioReader*);
+    void readerNeedsData() noexcept;
+    bool serviceMostUrgentReader();
+    BufferingAudioReader* getMostUrgentReader();
+    void finishedWithReader (BufferingAudioReader*);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReadScheduler)
+};
+
 //==============================================================================
 /**
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
-    @see AudioFormatReader
+    The reader watches the positions that readSamples() is asked for. When they
+    go backwards it pre-reads the audio before the play position instead of the
+    audio after it. When they move faster than real-time it buffers further
+    ahead, up to four times the requested amount.
+
+    @see AudioFormatReader, BufferingAudioReadScheduler
 */
 class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
                                         private TimeSliceClient
@@ -52,6 +121,19 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that shares a scheduler's I/O threads with other readers.
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler that will do the background reading. It
+                                must not be deleted while the reader object still exists.
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          BufferingAudioReadScheduler& scheduler,
+                          int samplesToBuffer);
+
     ~BufferingAudioReader();
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -66,7 +148,8 @@ public:
 
 private:
     ScopedPointer<AudioFormatReader> source;
-    TimeSliceThread& thread;
+    TimeSliceThread* thread;
+    BufferingAudioReadScheduler* scheduler;
     int64 nextReadPosition;
     const int numBlocks;
     int timeoutMs;
@@ -84,9 +167,21 @@ private:
     CriticalSection lock;
     OwnedArray<BufferedBlock> blocks;
 
+    // Where the reads are heading, estimated from successive readSamples() calls
+    bool playingBackwards;
+    double playbackSpeed;
+    int64 lastRequestedSample;
+    double lastRequestTime;
+
+    friend class BufferingAudioReadScheduler;
+
+    void initialise();
+    void updatePlaybackEstimate (int64 startSample, int numSamples) noexcept;
+    Range<int64> getWantedRange() const noexcept;
+    double getSecondsBufferedAhead() const noexcept;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
     int useTimeSlice() override;
-    bool readNextBufferChunk();
+    bool readNextBufferChunk (int maxBlocksToRead);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
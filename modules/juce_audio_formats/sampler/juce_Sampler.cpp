@@ -68,7 +68,7 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
 }
 
 //==============================================================================
-SamplerVoice::SamplerVoice() {}
+SamplerVoice::SamplerVoice()  : interpolator (WindowedSincInterpolator::linearQuality) {}
 SamplerVoice::~SamplerVoice() {}
 
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
@@ -125,6 +125,11 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     }
 }
 
+void SamplerVoice::setInterpolationQuality (WindowedSincInterpolator::Quality newQuality)
+{
+    interpolator.setQuality (newQuality);
+}
+
 void SamplerVoice::pitchWheelMoved (int /*newValue*/) {}
 void SamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
 
@@ -137,19 +142,33 @@ void SamplerVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int startSa
         const float* const inL = data.getReadPointer (0);
         const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
 
+        const int numSourceSamples = data.getNumSamples();
+        const bool useLinearInterpolation = (interpolator.getQuality() == WindowedSincInterpolator::linearQuality);
+
         float* outL = outputBuffer.getWritePointer (0, startSample);
         float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
 
         while (--numSamples >= 0)
         {
-            auto pos = (int) sourceSamplePosition;
-            auto alpha = (float) (sourceSamplePosition - pos);
-            auto invAlpha = 1.0f - alpha;
-
-            // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+            float l, r;
+
+            if (useLinearInterpolation)
+            {
+                auto pos = (int) sourceSamplePosition;
+                auto alpha = (float) (sourceSamplePosition - pos);
+                auto invAlpha = 1.0f - alpha;
+
+                // just using a very simple linear interpolation here..
+                l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
+                r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
+                                     : l;
+            }
+            else
+            {
+                l = interpolator.valueAt (inL, numSourceSamples, sourceSamplePosition, pitchRatio);
+                r = (inR != nullptr) ? interpolator.valueAt (inR, numSourceSamples, sourceSamplePosition, pitchRatio)
+                                     : l;
+            }
 
             l *= lgain;
             r *= rgain;
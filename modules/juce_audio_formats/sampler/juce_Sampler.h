@@ -132,9 +132,22 @@ public:
 
     void renderNextBlock (AudioSampleBuffer&, int startSample, int numSamples) override;
 
+    //==============================================================================
+    /** Changes the type of interpolation used when the sample is played at a different pitch.
+
+        The default is WindowedSincInterpolator::linearQuality, which is the cheapest. The
+        windowed-sinc settings are much cleaner, and also filter the sample when it's pitched
+        upwards, so that it doesn't alias.
+    */
+    void setInterpolationQuality (WindowedSincInterpolator::Quality newQuality);
+
+    /** Returns the quality that was set with setInterpolationQuality(). */
+    WindowedSincInterpolator::Quality getInterpolationQuality() const noexcept  { return interpolator.getQuality(); }
+
 
 private:
     //==============================================================================
+    WindowedSincInterpolator interpolator;
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0, attackReleaseLevel = 0, attackDelta = 0, releaseDelta = 0;
@@ -0,0 +1,361 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              MemoryMappedAudioFormatReader* source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadTimeSecs)
+    : name (soundName),
+      reader (source),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    jassert (source != nullptr);
+
+    if (reader != nullptr && reader->sampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        if (! reader->mapEntireFile())
+        {
+            jassertfalse; // the file couldn't be mapped, so it can't be streamed
+            reader = nullptr;
+            return;
+        }
+
+        sourceSampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        preloadLength = (int) jmin (length, (int64) (preloadTimeSecs * sourceSampleRate));
+
+        preloadedData.setSize (jmin (2, (int) reader->numChannels), preloadLength + 4);
+        reader->read (&preloadedData, 0, preloadLength + 4, 0, true, true);
+
+        attackSamples  = roundToInt (attackTimeSecs  * sourceSampleRate);
+        releaseSamples = roundToInt (releaseTimeSecs * sourceSampleRate);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (TimeSliceThread& readAheadThread, int bufferSizeSamples)
+    : thread (readAheadThread),
+      ringBuffer (2, jmax (1024, bufferSizeSamples)),
+      fifo (ringBuffer.getNumSamples())
+{
+    setTimeSlicePriority (TimeSliceClient::playbackPriority);
+    thread.addTimeSliceClient (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        if (sound->length <= 0)
+        {
+            clearCurrentNote();
+            return;
+        }
+
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        ringStartPosition = sound->preloadLength;
+        lgain = velocity;
+        rgain = velocity;
+
+        isInAttack = (sound->attackSamples > 0);
+        isInRelease = false;
+
+        if (isInAttack)
+        {
+            attackReleaseLevel = 0.0f;
+            attackDelta = (float) (pitchRatio / sound->attackSamples);
+        }
+        else
+        {
+            attackReleaseLevel = 1.0f;
+            attackDelta = 0.0f;
+        }
+
+        if (sound->releaseSamples > 0)
+            releaseDelta = (float) (-pitchRatio / sound->releaseSamples);
+        else
+            releaseDelta = -1.0f;
+
+        playingSound = sound;
+        requestStream (sound);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        isInAttack = false;
+        isInRelease = true;
+    }
+    else
+    {
+        clearCurrentNote();
+        playingSound = nullptr;
+        requestStream (nullptr);
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+void StreamingSamplerVoice::requestStream (StreamingSamplerSound* sound)
+{
+    SynthesiserSound::Ptr previousRequest;
+
+    {
+        const SpinLock::ScopedLockType sl (requestLock);
+        previousRequest = requestedSound;
+        requestedSound = sound;
+        playingGeneration = ++requestedGeneration;
+    }
+}
+
+//==============================================================================
+int StreamingSamplerVoice::useTimeSlice()
+{
+    SynthesiserSound::Ptr previousSound;
+    bool isNewRequest = false;
+
+    {
+        const SpinLock::ScopedLockType sl (requestLock);
+
+        if (streamingGeneration != requestedGeneration)
+        {
+            previousSound = streamingSound;
+            streamingSound = requestedSound;
+            streamingGeneration = requestedGeneration;
+            isNewRequest = true;
+        }
+    }
+
+    auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get());
+
+    if (isNewRequest)
+    {
+        // The audio thread won't touch the fifo until readyGeneration matches the note it's
+        // playing, so it's safe to reset it here.
+        fifo.reset();
+        nextReadPosition = sound != nullptr ? sound->preloadLength : 0;
+        readyGeneration.set (streamingGeneration);
+    }
+
+    if (sound == nullptr || sound->reader == nullptr)
+        return 10;
+
+    auto numToRead = (int) jmin ((int64) fifo.getFreeSpace(),
+                                 sound->length + 4 - nextReadPosition,
+                                 (int64) 8192);
+
+    if (numToRead <= 0)
+        return 10;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        sound->reader->read (&ringBuffer, start1, size1, nextReadPosition, true, true);
+
+    if (size2 > 0)
+        sound->reader->read (&ringBuffer, start2, size2, nextReadPosition + size1, true, true);
+
+    fifo.finishedWrite (size1 + size2);
+    nextReadPosition += size1 + size2;
+    return 1;
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* sound = playingSound)
+    {
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+
+        // The streaming thread resets the ring buffer when it picks up a new note, so
+        // it can only be read once it has caught up with the one that's playing.
+        if (readyGeneration.get() == playingGeneration)
+            fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+        auto& preloaded = sound->preloadedData;
+        auto preloadLength = (int64) sound->preloadLength;
+        auto numInRing = (int64) (size1 + size2);
+
+        const float* const preL = preloaded.getReadPointer (0);
+        const float* const preR = preloaded.getNumChannels() > 1 ? preloaded.getReadPointer (1) : nullptr;
+        const float* const ringL = ringBuffer.getReadPointer (0);
+        const float* const ringR = ringBuffer.getReadPointer (1);
+
+        auto getFrame = [&] (int64 index, float& l, float& r) noexcept
+        {
+            if (index < preloadLength)
+            {
+                l = preL[index];
+                r = preR != nullptr ? preR[index] : l;
+                return true;
+            }
+
+            auto offset = index - ringStartPosition;
+
+            if (offset < 0 || offset >= numInRing)
+            {
+                l = r = 0.0f;
+                return false;
+            }
+
+            auto i = (int) (offset < size1 ? start1 + offset : start2 + (offset - size1));
+            l = ringL[i];
+            r = preR != nullptr ? ringR[i] : l;
+            return true;
+        };
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        int numMissing = 0;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - pos);
+            auto invAlpha = 1.0f - alpha;
+
+            float l0, r0, l1, r1;
+
+            if (! getFrame (pos, l0, r0))
+                ++numMissing;
+
+            getFrame (pos + 1, l1, r1);
+
+            // just using a very simple linear interpolation here..
+            float l = l0 * invAlpha + l1 * alpha;
+            float r = r0 * invAlpha + r1 * alpha;
+
+            l *= lgain;
+            r *= rgain;
+
+            if (isInAttack)
+            {
+                l *= attackReleaseLevel;
+                r *= attackReleaseLevel;
+
+                attackReleaseLevel += attackDelta;
+
+                if (attackReleaseLevel >= 1.0f)
+                {
+                    attackReleaseLevel = 1.0f;
+                    isInAttack = false;
+                }
+            }
+            else if (isInRelease)
+            {
+                l *= attackReleaseLevel;
+                r *= attackReleaseLevel;
+
+                attackReleaseLevel += releaseDelta;
+
+                if (attackReleaseLevel <= 0.0f)
+                {
+                    stopNote (0.0f, false);
+                    break;
+                }
+            }
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > sound->length)
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+
+        if (numMissing > 0)
+            numUnderrunSamples += numMissing;
+
+        // hand back the part of the ring buffer that has been played, unless the note has
+        // stopped, in which case the streaming thread will reset it anyway
+        if (playingSound != nullptr)
+        {
+            auto numFinished = (int) jlimit ((int64) 0, numInRing, (int64) sourceSamplePosition - ringStartPosition);
+
+            if (numFinished > 0)
+            {
+                fifo.finishedRead (numFinished);
+                ringStartPosition += numFinished;
+            }
+        }
+    }
+}
+
+} // namespace juce
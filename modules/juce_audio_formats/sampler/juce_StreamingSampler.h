@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A sampled sound that keeps only the start of its audio in memory, and streams
+    the rest of it from disk while it plays.
+
+    This is used in the same way as a SamplerSound, but must be played by a
+    StreamingSamplerVoice. Only the first few hundred milliseconds of the sample are
+    loaded when the sound is created, so large sample libraries can be used without
+    having to read all of their audio into RAM. The remainder is read from a
+    MemoryMappedAudioFormatReader by a background thread as each voice plays.
+
+    @see StreamingSamplerVoice, SamplerSound, Synthesiser
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streaming sound from a memory-mapped reader.
+
+        @param name             a name for the sample
+        @param source           the audio to play. This object will be deleted by the
+                                sound when no longer needed. The constructor will map the
+                                whole file, so you don't need to do this first.
+        @param midiNotes        the set of midi keys that this sound should be played on. This
+                                is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadTimeSecs  the length of audio at the start of the sample that will be held
+                                in memory. This needs to be long enough to cover the time it
+                                takes the streaming thread to start filling a voice's buffer.
+    */
+    StreamingSamplerSound (const String& name,
+                           MemoryMappedAudioFormatReader* source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadTimeSecs = 0.5);
+
+    /** Destructor. */
+    ~StreamingSamplerSound();
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the total length of the sample, in samples. */
+    int64 getLengthInSamples() const noexcept               { return length; }
+
+    /** Returns the number of samples at the start of the sound that are held in memory. */
+    int getPreloadLength() const noexcept                   { return preloadLength; }
+
+    /** Returns the reader that the rest of the sound is streamed from.
+        This could return nullptr if there was a problem opening the source.
+    */
+    MemoryMappedAudioFormatReader* getReader() const noexcept   { return reader; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    String name;
+    ScopedPointer<MemoryMappedAudioFormatReader> reader;
+    AudioSampleBuffer preloadedData;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, attackSamples = 0, releaseSamples = 0;
+    int midiRootNote = 0;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+
+//==============================================================================
+/**
+    A SynthesiserVoice that plays a StreamingSamplerSound.
+
+    Each voice owns a ring buffer that a shared TimeSliceThread keeps topped up with the
+    part of the sample that comes after the preloaded section. The audio thread and the
+    streaming thread only communicate through an AbstractFifo and a few atomic counters,
+    so rendering never waits for the disk. If the stream can't keep up, the missing
+    samples are played as silence rather than blocking.
+
+    You must make sure the TimeSliceThread is started, and that it outlives all the voices
+    that use it.
+
+    @see StreamingSamplerSound, SamplerVoice, Synthesiser
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice,
+                                           private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a voice that streams its audio using the given thread.
+
+        @param readAheadThread      the thread that will fill this voice's buffer. The same
+                                    thread can be shared between any number of voices.
+        @param bufferSizeSamples    the size of the voice's ring buffer, in samples
+    */
+    StreamingSamplerVoice (TimeSliceThread& readAheadThread, int bufferSizeSamples = 32768);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice();
+
+    //==============================================================================
+    /** Returns the number of samples that have been replaced by silence because the
+        stream hadn't read them in time.
+    */
+    int getNumUnderrunSamples() const noexcept              { return numUnderrunSamples.get(); }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioSampleBuffer&, int startSample, int numSamples) override;
+
+private:
+    //==============================================================================
+    TimeSliceThread& thread;
+
+    // shared between the audio and streaming threads
+    AudioSampleBuffer ringBuffer;
+    AbstractFifo fifo;
+    SpinLock requestLock;
+    SynthesiserSound::Ptr requestedSound;
+    int requestedGeneration = 0;
+    Atomic<int> readyGeneration, numUnderrunSamples;
+
+    // only used by the streaming thread
+    SynthesiserSound::Ptr streamingSound;
+    int streamingGeneration = 0;
+    int64 nextReadPosition = 0;
+
+    // only used by the audio thread
+    StreamingSamplerSound* playingSound = nullptr;
+    int playingGeneration = 0;
+    int64 ringStartPosition = 0;
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0, attackReleaseLevel = 0, attackDelta = 0, releaseDelta = 0;
+    bool isInAttack = false, isInRelease = false;
+
+    void requestStream (StreamingSamplerSound*);
+    int useTimeSlice() override;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
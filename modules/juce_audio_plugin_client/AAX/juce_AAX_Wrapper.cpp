@@ -993,6 +993,8 @@ namespace AAXClasses
                       AAX_IMIDINode* midiNodeIn, AAX_IMIDINode* midiNodesOut,
                       float* const meterBuffers)
         {
+            JUCE_REALTIME_CONTEXT;
+
             const int numIns    = pluginInstance->getTotalNumInputChannels();
             const int numOuts   = pluginInstance->getTotalNumOutputChannels();
             const int numMeters = aaxMeters.size();
@@ -1278,9 +1280,11 @@ namespace AAXClasses
                     }
                 }
 
-                const ScopedLock sl (pluginInstance->getCallbackLock());
+                const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (pluginInstance->getCallbackLock());
 
-                if (bypass)
+                if (auto* adapter = pluginInstance->getBlockSizeAdapter())
+                    adapter->process (buffer, midiBuffer, bypass);
+                else if (bypass)
                     pluginInstance->processBlockBypassed (buffer, midiBuffer);
                 else
                     pluginInstance->processBlock (buffer, midiBuffer);
@@ -1180,6 +1180,8 @@ public:
                             const AudioTimeStamp& inTimeStamp,
                             const UInt32 nFrames) override
     {
+        JUCE_REALTIME_CONTEXT;
+
         lastTimeStamp = inTimeStamp;
 
         // prepare buffers
@@ -1200,6 +1202,22 @@ public:
             bool interleaved = false;
             AudioBufferList* buffer = nullptr;
 
+            // note where each input comes from, so that an output buffer that is also the
+            // host's buffer for a different input isn't written to before it's been read
+            for (int busIdx = 0, inIdx = 0; busIdx < numInputBuses && inIdx < totalInChannels; ++busIdx)
+            {
+                const bool badData = ! pulledSucceeded[busIdx];
+
+                if (! badData)
+                    GetAudioBufferList (true, busIdx, buffer, interleaved, numChannels);
+
+                const int* inLayoutMap = mapper.get (true, busIdx);
+                const int n = juceFilter->getChannelCountOfBus (true, busIdx);
+
+                for (int ch = 0; ch < n && inIdx < totalInChannels; ++ch)
+                    audioBuffer.setInputSource (inIdx++, interleaved || badData ? nullptr : static_cast<float*> (buffer->mBuffers[inLayoutMap[ch]].mData));
+            }
+
             // use output pointers
             for (int busIdx = 0; busIdx < numOutputBuses; ++busIdx)
             {
@@ -1692,12 +1710,16 @@ private:
 
     void processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiBuffer) noexcept
     {
-        const ScopedLock sl (juceFilter->getCallbackLock());
+        const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (juceFilter->getCallbackLock());
 
         if (juceFilter->isSuspended())
         {
             buffer.clear();
         }
+        else if (auto* adapter = juceFilter->getBlockSizeAdapter())
+        {
+            adapter->process (buffer, midiBuffer, isBypassed);
+        }
         else if (isBypassed)
         {
             juceFilter->processBlockBypassed (buffer, midiBuffer);
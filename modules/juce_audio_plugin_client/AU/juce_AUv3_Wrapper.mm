@@ -1364,6 +1364,8 @@ private:
 
         if (processor.isSuspended())
             buffer.clear();
+        else if (auto* adapter = processor.getBlockSizeAdapter())
+            adapter->process (buffer, midiBuffer, [au shouldBypassEffect]);
         else if ([au shouldBypassEffect])
             processor.processBlockBypassed (buffer, midiBuffer);
         else
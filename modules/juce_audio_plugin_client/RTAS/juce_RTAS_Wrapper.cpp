@@ -601,7 +601,9 @@ public:
 
                 AudioSampleBuffer chans (channels, totalChans, numSamples);
 
-                if (mBypassed)
+                if (auto* adapter = juceFilter->getBlockSizeAdapter())
+                    adapter->process (chans, midiEvents, mBypassed);
+                else if (mBypassed)
                     juceFilter->processBlockBypassed (chans, midiEvents);
                 else
                     juceFilter->processBlock (chans, midiEvents);
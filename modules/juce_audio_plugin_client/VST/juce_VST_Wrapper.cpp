@@ -362,6 +362,8 @@ public:
     void internalProcessReplacing (FloatType** inputs, FloatType** outputs,
                                    int32 numSamples, VstTempBuffers<FloatType>& tmpBuffers)
     {
+        JUCE_REALTIME_CONTEXT;
+
         const bool isMidiEffect = processor->isMidiEffect();
 
         if (firstProcessCallback)
@@ -399,7 +401,7 @@ public:
             const int numIn  = processor->getTotalNumInputChannels();
             const int numOut = processor->getTotalNumOutputChannels();
 
-            const ScopedLock sl (processor->getCallbackLock());
+            const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (processor->getCallbackLock());
 
             if (processor->isSuspended())
             {
@@ -460,7 +462,9 @@ public:
                     const int numChannels = jmax (numIn, numOut);
                     AudioBuffer<FloatType> chans (tmpBuffers.channels, isMidiEffect ? 0 : numChannels, numSamples);
 
-                    if (isBypassed)
+                    if (auto* adapter = processor->getBlockSizeAdapter())
+                        adapter->process (chans, midiEvents, isBypassed);
+                    else if (isBypassed)
                         processor->processBlockBypassed (chans, midiEvents);
                     else
                         processor->processBlock (chans, midiEvents);
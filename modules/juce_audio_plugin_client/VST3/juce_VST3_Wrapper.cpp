@@ -1240,8 +1240,8 @@ public:
         {
             getPluginInstance().releaseResources();
 
-            deallocateChannelListAndBuffers (channelListFloat,  emptyBufferFloat);
-            deallocateChannelListAndBuffers (channelListDouble, emptyBufferDouble);
+            deallocateChannelListAndBuffers (channelListFloat,  inputListFloat,  emptyBufferFloat);
+            deallocateChannelListAndBuffers (channelListDouble, inputListDouble, emptyBufferDouble);
         }
         else
         {
@@ -1256,8 +1256,8 @@ public:
                             ? (int) processSetup.maxSamplesPerBlock
                             : bufferSize;
 
-            allocateChannelListAndBuffers (channelListFloat,  emptyBufferFloat);
-            allocateChannelListAndBuffers (channelListDouble, emptyBufferDouble);
+            allocateChannelListAndBuffers (channelListFloat,  inputListFloat,  emptyBufferFloat);
+            allocateChannelListAndBuffers (channelListDouble, inputListDouble, emptyBufferDouble);
 
             preparePlugin (sampleRate, bufferSize);
         }
@@ -1996,13 +1996,38 @@ public:
                         auto index = getJuceIndexForVSTParamID (vstParamID);
 
                         if (isPositiveAndBelow (index, pluginInstance->getNumParameters()))
+                        {
+                            if (auto* automation = pluginInstance->getParameterAutomationBuffer())
+                                addParameterChangesToAutomationBuffer (*automation, *paramQueue, index);
+
                             pluginInstance->setParameter (index, static_cast<float> (value));
+                        }
                     }
                 }
             }
         }
     }
 
+    void addParameterChangesToAutomationBuffer (ParameterAutomationBuffer& automation, Vst::IParamValueQueue& paramQueue, const int index)
+    {
+        if (! isPositiveAndBelow (index, automation.getNumParameters()))
+            return;
+
+        // (this gets called before the parameter is set to the block's last value)
+        automation.setValueAtStartOfBlock (index, pluginInstance->getParameter (index));
+
+        auto numPoints = paramQueue.getPointCount();
+
+        for (Steinberg::int32 i = 0; i < numPoints; ++i)
+        {
+            Steinberg::int32 offsetSamples = 0;
+            double value = 0.0;
+
+            if (paramQueue.getPoint (i, offsetSamples, value) == kResultTrue)
+                automation.addPoint (index, (int) offsetSamples, static_cast<float> (value));
+        }
+    }
+
     void addParameterChangeToMidiBuffer (const Steinberg::int32 offsetSamples, const Vst::ParamID id, const double value)
     {
         // If the parameter is mapped to a MIDI CC message then insert it into the midiBuffer.
@@ -2025,6 +2050,8 @@ public:
 
     tresult PLUGIN_API process (Vst::ProcessData& data) override
     {
+        JUCE_REALTIME_CONTEXT;
+
         if (pluginInstance == nullptr)
             return kResultFalse;
 
@@ -2038,6 +2065,9 @@ public:
 
         midiBuffer.clear();
 
+        if (auto* automation = pluginInstance->getParameterAutomationBuffer())
+            automation->clear();
+
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
 
@@ -2056,8 +2086,8 @@ public:
                 return kResultFalse;
         }
 
-        if      (processSetup.symbolicSampleSize == Vst::kSample32) processAudio<float>  (data, channelListFloat);
-        else if (processSetup.symbolicSampleSize == Vst::kSample64) processAudio<double> (data, channelListDouble);
+        if      (processSetup.symbolicSampleSize == Vst::kSample32) processAudio<float>  (data, channelListFloat,  inputListFloat);
+        else if (processSetup.symbolicSampleSize == Vst::kSample64) processAudio<double> (data, channelListDouble, inputListDouble);
         else jassertfalse;
 
        #if JucePlugin_ProducesMidiOutput
@@ -2085,12 +2115,17 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
-    Array<float*> channelListFloat;
-    Array<double*> channelListDouble;
+    Array<float*> channelListFloat, inputListFloat;
+    Array<double*> channelListDouble, inputListDouble;
 
     AudioBuffer<float>  emptyBufferFloat;
     AudioBuffer<double> emptyBufferDouble;
 
+    // these just refer to the channelList data, but are kept so that the buffer's list
+    // of channel pointers doesn't need to be re-allocated for every block
+    AudioBuffer<float>  processBufferFloat;
+    AudioBuffer<double> processBufferDouble;
+
    #if JucePlugin_WantsMidiInput
     bool isMidiInputBusEnabled = true;
    #else
@@ -2116,10 +2151,9 @@ private:
 
     //==============================================================================
     template <typename FloatType>
-    void processAudio (Vst::ProcessData& data, Array<FloatType*>& channelList)
+    void processAudio (Vst::ProcessData& data, Array<FloatType*>& channelList, Array<FloatType*>& inputList)
     {
         int totalInputChans = 0, totalOutputChans = 0;
-        bool tmpBufferNeedsClearing = false;
 
         auto plugInInputChannels  = pluginInstance->getTotalNumInputChannels();
         auto plugInOutputChannels = pluginInstance->getTotalNumOutputChannels();
@@ -2151,12 +2185,7 @@ private:
                         for (int i = 0; i < numChans; ++i)
                         {
                             if (auto dst = busChannels[i])
-                            {
-                                if (totalOutputChans >= plugInInputChannels)
-                                    FloatVectorOperations::clear (dst, (int) data.numSamples);
-
-                                channelList.set (totalOutputChans++, busChannels[i]);
-                            }
+                                channelList.set (totalOutputChans++, dst);
                         }
                     }
                 }
@@ -2166,9 +2195,9 @@ private:
 
                     for (int i = 0; i < numChans; ++i)
                     {
-                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalOutputChans, data.numSamples))\
+                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalOutputChans, data.numSamples))
                         {
-                            tmpBufferNeedsClearing = true;
+                            FloatVectorOperations::clear (tmpBuffer, (int) data.numSamples);
                             channelList.set (totalOutputChans++, tmpBuffer);
                         }
                         else
@@ -2178,6 +2207,9 @@ private:
             }
         }
 
+        for (int i = 0; i < totalOutputChans; ++i)
+            inputList.set (i, nullptr);
+
         {
             auto n = jmax (vstInputs, getNumAudioBuses (true));
 
@@ -2191,18 +2223,15 @@ private:
 
                         for (int i = 0; i < numChans; ++i)
                         {
-                            if (busChannels[i] != nullptr)
+                            if (auto* src = busChannels[i])
                             {
+                                // an input with no output channel can be used where it is, and the
+                                // others are copied into their output channels further down, unless
+                                // the host is processing in-place
                                 if (totalInputChans >= totalOutputChans)
-                                    channelList.set (totalInputChans, busChannels[i]);
-                                else
-                                {
-                                    auto* dst = channelList.getReference (totalInputChans);
-                                    auto* src = busChannels[i];
-
-                                    if (dst != src)
-                                        FloatVectorOperations::copy (dst, src, (int) data.numSamples);
-                                }
+                                    channelList.set (totalInputChans, src);
+                                else if (channelList.getUnchecked (totalInputChans) != src)
+                                    inputList.set (totalInputChans, src);
                             }
 
                             ++totalInputChans;
@@ -2217,7 +2246,11 @@ private:
                     {
                         if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalInputChans, data.numSamples))
                         {
-                            tmpBufferNeedsClearing = true;
+                            FloatVectorOperations::clear (tmpBuffer, (int) data.numSamples);
+
+                            if (totalInputChans < totalOutputChans)
+                                inputList.set (totalInputChans, nullptr);
+
                             channelList.set (totalInputChans++, tmpBuffer);
                         }
                         else
@@ -2227,16 +2260,17 @@ private:
             }
         }
 
-        if (tmpBufferNeedsClearing)
-            ChooseBufferHelper<FloatType>::impl (emptyBufferFloat, emptyBufferDouble).clear();
+        copyInputsToOutputChannels (channelList, inputList, jmin (totalInputChans, totalOutputChans), data.numSamples);
 
-        AudioBuffer<FloatType> buffer;
+        for (int i = plugInInputChannels; i < totalOutputChans; ++i)
+            FloatVectorOperations::clear (channelList.getUnchecked (i), (int) data.numSamples);
 
-        if (int totalChans = jmax (totalOutputChans, totalInputChans))
-            buffer.setDataToReferTo (channelList.getRawDataPointer(), totalChans, (int) data.numSamples);
+        auto& buffer = ChooseBufferHelper<FloatType>::impl (processBufferFloat, processBufferDouble);
+        auto totalChans = jmax (totalOutputChans, totalInputChans);
+        buffer.setDataToReferTo (channelList.getRawDataPointer(), totalChans, totalChans > 0 ? (int) data.numSamples : 0);
 
         {
-            const ScopedLock sl (pluginInstance->getCallbackLock());
+            const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (pluginInstance->getCallbackLock());
 
             pluginInstance->setNonRealtime (data.processMode == Vst::kOffline);
 
@@ -2253,7 +2287,9 @@ private:
                 if (totalInputChans == pluginInstance->getTotalNumInputChannels()
                  && totalOutputChans == pluginInstance->getTotalNumOutputChannels())
                 {
-                    if (isBypassed())
+                    if (auto* adapter = pluginInstance->getBlockSizeAdapter())
+                        adapter->process (buffer, midiBuffer, isBypassed());
+                    else if (isBypassed())
                         pluginInstance->processBlockBypassed (buffer, midiBuffer);
                     else
                         pluginInstance->processBlock (buffer, midiBuffer);
@@ -2280,12 +2316,64 @@ private:
         }
     }
 
+    template <typename FloatType>
+    void copyInputsToOutputChannels (Array<FloatType*>& channelList, Array<FloatType*>& inputList,
+                                     int numChannels, int32 numSamples) noexcept
+    {
+        auto* outputs = channelList.getRawDataPointer();
+        auto* inputs  = inputList.getRawDataPointer();
+
+        if (numChannels <= 0)
+            return;
+
+        // An input whose buffer is also the output buffer of a different channel would be overwritten
+        // when that channel's input is copied into it, so only those inputs get moved out of the way
+        // first. Each one goes into its own channel's temp buffer, which isn't otherwise in use, as the
+        // channel's output has a host buffer (and if it hasn't, the temp buffer is the output anyway).
+        auto lowestOutput = outputs[0], highestOutput = outputs[0];
+
+        for (int i = 1; i < numChannels; ++i)
+        {
+            lowestOutput  = jmin (lowestOutput,  outputs[i]);
+            highestOutput = jmax (highestOutput, outputs[i]);
+        }
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto* src = inputs[i];
+
+            if (src == nullptr || src < lowestOutput || src > highestOutput)
+                continue;
+
+            for (int j = 0; j < numChannels; ++j)
+            {
+                if (outputs[j] == src)
+                {
+                    if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (i, numSamples))
+                    {
+                        FloatVectorOperations::copy (tmpBuffer, src, (int) numSamples);
+                        inputs[i] = tmpBuffer;
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        for (int i = 0; i < numChannels; ++i)
+            if (inputs[i] != nullptr && inputs[i] != outputs[i])
+                FloatVectorOperations::copy (outputs[i], inputs[i], (int) numSamples);
+    }
+
     //==============================================================================
     template <typename FloatType>
-    void allocateChannelListAndBuffers (Array<FloatType*>& channelList, AudioBuffer<FloatType>& buffer)
+    void allocateChannelListAndBuffers (Array<FloatType*>& channelList, Array<FloatType*>& inputList,
+                                        AudioBuffer<FloatType>& buffer)
     {
         channelList.clearQuick();
         channelList.insertMultiple (0, nullptr, 128);
+        inputList.clearQuick();
+        inputList.insertMultiple (0, nullptr, 128);
 
         auto& p = getPluginInstance();
         buffer.setSize (jmax (p.getTotalNumInputChannels(), p.getTotalNumOutputChannels()), p.getBlockSize() * 4);
@@ -2293,10 +2381,13 @@ private:
     }
 
     template <typename FloatType>
-    void deallocateChannelListAndBuffers (Array<FloatType*>& channelList, AudioBuffer<FloatType>& buffer)
+    void deallocateChannelListAndBuffers (Array<FloatType*>& channelList, Array<FloatType*>& inputList,
+                                          AudioBuffer<FloatType>& buffer)
     {
         channelList.clearQuick();
         channelList.resize (0);
+        inputList.clearQuick();
+        inputList.resize (0);
         buffer.setSize (0, 0);
     }
 
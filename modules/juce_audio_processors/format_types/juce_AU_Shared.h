@@ -127,6 +127,7 @@ struct AudioUnitHelpers
 
             scratch.setSize (numChannels, maxFrames);
             channels.calloc (static_cast<size_t> (numChannels));
+            inputSources.calloc (static_cast<size_t> (numChannels));
 
             reset();
         }
@@ -135,6 +136,7 @@ struct AudioUnitHelpers
         {
             scratch.setSize (0, 0);
             channels.free();
+            inputSources.free();
         }
 
         void reset() noexcept
@@ -142,9 +144,21 @@ struct AudioUnitHelpers
             pushIdx = 0;
             popIdx = 0;
             zeromem (channels.get(), sizeof(float*) * static_cast<size_t> (scratch.getNumChannels()));
+            zeromem (inputSources.get(), sizeof(float*) * static_cast<size_t> (scratch.getNumChannels()));
         }
 
         //==============================================================================
+        /** Tells the list which host buffer an input channel will be pushed from.
+            If this is called for all the inputs before any calls to setBuffer(), then an
+            output buffer that is also the input of a different channel won't be used
+            directly, as it'd be overwritten before that channel's input had been read.
+        */
+        void setInputSource (const int idx, const float* ptr) noexcept
+        {
+            jassert (idx < scratch.getNumChannels());
+            inputSources[idx] = ptr;
+        }
+
         float* setBuffer (const int idx, float* ptr = nullptr) noexcept
         {
             jassert (idx < scratch.getNumChannels());
@@ -236,6 +250,11 @@ struct AudioUnitHelpers
                 if (buffer == channels[ch])
                     return scratch.getWritePointer (idx);
 
+            // only the channels that alias a different input need to go through the scratch buffer
+            for (int ch = 0; ch < scratch.getNumChannels(); ++ch)
+                if (buffer == inputSources[ch] && ch != idx)
+                    return scratch.getWritePointer (idx);
+
             return buffer;
         }
 
@@ -244,6 +263,7 @@ struct AudioUnitHelpers
         AudioSampleBuffer mutableBuffer;
 
         HeapBlock<float*> channels;
+        HeapBlock<const float*> inputSources;
         int pushIdx, popIdx;
     };
 
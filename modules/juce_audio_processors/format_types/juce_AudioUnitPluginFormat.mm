@@ -1464,17 +1464,19 @@ private:
         {
             // if this ever happens, might need to add extra handling
             jassert (inNumberFrames == (UInt32) currentBuffer->getNumSamples());
-            AudioSampleBuffer buffer =
-                (static_cast<int> (inBusNumber) < getBusCount (true)
-                    ? getBusBuffer (*currentBuffer, true, static_cast<int> (inBusNumber))
-                    : AudioSampleBuffer());
+
+            // read the bus's channels directly, rather than making a temporary buffer for each callback
+            auto busIndex = static_cast<int> (inBusNumber);
+            auto* bus = busIndex < getBusCount (true) ? getBus (true, busIndex) : nullptr;
+            auto numBusChannels = bus != nullptr ? bus->getNumberOfChannels() : 0;
+            auto firstChannel = bus != nullptr ? getChannelIndexInProcessBlockBuffer (true, busIndex, 0) : 0;
 
             for (int i = 0; i < static_cast<int> (ioData->mNumberBuffers); ++i)
             {
-                if (i < buffer.getNumChannels())
+                if (i < numBusChannels)
                 {
                     memcpy (ioData->mBuffers[i].mData,
-                            buffer.getReadPointer (i),
+                            currentBuffer->getReadPointer (firstChannel + i),
                             sizeof (float) * inNumberFrames);
                 }
                 else
@@ -374,7 +374,12 @@ private:
 class MidiEventList  : public Steinberg::Vst::IEventList
 {
 public:
-    MidiEventList() {}
+    MidiEventList()
+    {
+        // enough that a typical block's events can be added without allocating
+        events.ensureStorageAllocated (128);
+    }
+
     virtual ~MidiEventList() {}
 
     JUCE_DECLARE_VST3_COM_REF_METHODS
@@ -586,6 +591,22 @@ struct VST3BufferExchange
         channelIndexOffset += numChansForBus;
     }
 
+    /** Allocates the space that mapBufferToBuses() will need for a set of arrangements,
+        so that it can be called on the audio thread without allocating.
+    */
+    static void preallocateBuses (Array<Steinberg::Vst::AudioBusBuffers>& result, BusMap& busMapToUse,
+                                  const Array<AudioChannelSet>& arrangements)
+    {
+        while (result.size() < arrangements.size())
+            result.add (Steinberg::Vst::AudioBusBuffers());
+
+        while (busMapToUse.size() < arrangements.size())
+            busMapToUse.add (Bus());
+
+        for (int i = 0; i < arrangements.size(); ++i)
+            busMapToUse.getReference (i).ensureStorageAllocated (arrangements.getReference (i).size());
+    }
+
     static inline void mapBufferToBuses (Array<Steinberg::Vst::AudioBusBuffers>& result, BusMap& busMapToUse,
                                           const Array<AudioChannelSet>& arrangements,
                                           AudioBuffer<FloatType>& source)
@@ -300,10 +300,7 @@ struct VST3HostContext  : public Vst::IComponentHandler,  // From VST V3.0.0
 
             plugin->sendParamChangeMessageToListeners (index, (float) valueNormalized);
 
-            {
-                Steinberg::int32 eventIndex;
-                plugin->inputParameterChanges->addParameterData (paramID, eventIndex)->addPoint (0, valueNormalized, eventIndex);
-            }
+            plugin->pendingParameterChanges.set (index, paramID, valueNormalized);
 
             // did the plug-in already update the parameter internally
             if (plugin->editController->getParamNormalized (paramID) != (float) valueNormalized)
@@ -1685,7 +1682,7 @@ struct VST3PluginInstance : public AudioPluginInstance
     VST3PluginInstance (VST3ComponentHolder* componentHolder)
       : AudioPluginInstance (getBusProperties (componentHolder->component)),
         holder (componentHolder),
-        inputParameterChanges (new ParamValueQueueList()),
+        inputParameterChanges (new ParamValueQueueList (1)),
         outputParameterChanges (new ParamValueQueueList()),
         midiInputs (new MidiEventList()),
         midiOutputs (new MidiEventList())
@@ -1750,6 +1747,16 @@ struct VST3PluginInstance : public AudioPluginInstance
         synchroniseStates();
         syncProgramNames();
         setupIO();
+
+        auto numParameters = getNumParameters();
+        pendingParameterChanges.setNumParameters (numParameters);
+        inputParameterChanges->ensureQueuesAllocated (numParameters + 1);
+
+        processData.inputParameterChanges  = inputParameterChanges;
+        processData.outputParameterChanges = outputParameterChanges;
+        processData.inputEvents            = midiInputs;
+        processData.outputEvents           = midiOutputs;
+        processData.processContext         = &timingInfo;
         return true;
     }
 
@@ -1840,6 +1847,7 @@ struct VST3PluginInstance : public AudioPluginInstance
 
         setLatencySamples (jmax (0, (int) processor->getLatencySamples()));
         cachedBusLayouts = getBusesLayout();
+        preallocateBusMaps();
 
         warnOnFailure (holder->component->setActive (true));
         warnOnFailure (processor->setProcessing (true));
@@ -1891,27 +1899,25 @@ struct VST3PluginInstance : public AudioPluginInstance
         using namespace Vst;
         auto numSamples = buffer.getNumSamples();
 
-        auto numInputAudioBuses  = getBusCount (true);
-        auto numOutputAudioBuses = getBusCount (false);
+        // The ProcessData is kept between blocks, and only the fields that can change are updated here
+        processData.processMode         = isNonRealtime() ? kOffline : kRealtime;
+        processData.symbolicSampleSize  = sampleSize;
+        processData.numInputs           = getBusCount (true);
+        processData.numOutputs          = getBusCount (false);
+        processData.numSamples          = (Steinberg::int32) numSamples;
 
-        ProcessData data;
-        data.processMode            = isNonRealtime() ? kOffline : kRealtime;
-        data.symbolicSampleSize     = sampleSize;
-        data.numInputs              = numInputAudioBuses;
-        data.numOutputs             = numOutputAudioBuses;
-        data.inputParameterChanges  = inputParameterChanges;
-        data.outputParameterChanges = outputParameterChanges;
-        data.numSamples             = (Steinberg::int32) numSamples;
-
-        updateTimingInformation (data, getSampleRate());
+        updateTimingInformation (processData, getSampleRate());
 
         for (int i = getTotalNumInputChannels(); i < buffer.getNumChannels(); ++i)
             buffer.clear (i, 0, numSamples);
 
-        associateTo (data, buffer);
-        associateTo (data, midiMessages);
+        associateTo (processData, buffer);
+        associateTo (processData, midiMessages);
+
+        pendingParameterChanges.moveTo (*inputParameterChanges);
+        outputParameterChanges->clearAllQueues();
 
-        processor->process (data);
+        processor->process (processData);
 
         MidiEventList::toMidiBuffer (midiMessages, *midiOutputs);
 
@@ -2205,9 +2211,7 @@ struct VST3PluginInstance : public AudioPluginInstance
         {
             auto paramID = getParameterInfoForIndex (parameterIndex).id;
             editController->setParamNormalized (paramID, (double) newValue);
-
-            Steinberg::int32 index;
-            inputParameterChanges->addParameterData (paramID, index)->addPoint (0, newValue, index);
+            pendingParameterChanges.set (parameterIndex, paramID, newValue);
         }
     }
 
@@ -2224,8 +2228,7 @@ struct VST3PluginInstance : public AudioPluginInstance
             auto value = static_cast<Vst::ParamValue> (program) / static_cast<Vst::ParamValue> (programNames.size());
 
             editController->setParamNormalized (programParameterID, value);
-            Steinberg::int32 index;
-            inputParameterChanges->addParameterData (programParameterID, index)->addPoint (0, value, index);
+            pendingParameterChanges.setProgram (programParameterID, value);
         }
     }
 
@@ -2304,7 +2307,7 @@ struct VST3PluginInstance : public AudioPluginInstance
     // DLL builds under MSVC.
     struct ParamValueQueueList  : public Vst::IParameterChanges
     {
-        ParamValueQueueList() {}
+        ParamValueQueueList (int pointsPerQueue = 1024)  : numPointsToReserve (pointsPerQueue) {}
         virtual ~ParamValueQueueList() {}
 
         JUCE_DECLARE_VST3_COM_REF_METHODS
@@ -2324,14 +2327,27 @@ struct VST3PluginInstance : public AudioPluginInstance
                 }
             }
 
-            index = numQueuesUsed++;
-            ParamValueQueue* valueQueue = (index < queues.size() ? queues[index]
-                                                                 : queues.add (new ParamValueQueue()));
+            index = numQueuesUsed;
+            return useNextQueue (id);
+        }
 
-            valueQueue->clear();
-            valueQueue->setParamID (id);
+        /** Adds a queue containing a single value at the start of the block.
 
-            return valueQueue;
+            Unlike addParameterData(), this doesn't search for an existing queue with the
+            same ID, so the caller must make sure that each parameter is only added once
+            between calls to clearAllQueues().
+        */
+        void addSingleValue (Vst::ParamID id, Vst::ParamValue value)
+        {
+            Steinberg::int32 index;
+            useNextQueue (id)->addPoint (0, value, index);
+        }
+
+        /** Creates enough queues that this many parameters can be added without allocating. */
+        void ensureQueuesAllocated (int numQueues)
+        {
+            while (queues.size() < numQueues)
+                queues.add (new ParamValueQueue (numPointsToReserve));
         }
 
         void clearAllQueues() noexcept
@@ -2341,9 +2357,9 @@ struct VST3PluginInstance : public AudioPluginInstance
 
         struct ParamValueQueue  : public Vst::IParamValueQueue
         {
-            ParamValueQueue()
+            ParamValueQueue (int numPointsToReserve)
             {
-                points.ensureStorageAllocated (1024);
+                points.ensureStorageAllocated (numPointsToReserve);
             }
 
             virtual ~ParamValueQueue() {}
@@ -2360,8 +2376,6 @@ struct VST3PluginInstance : public AudioPluginInstance
                                                     Steinberg::int32& sampleOffset,
                                                     Steinberg::Vst::ParamValue& value) override
             {
-                const ScopedLock sl (pointLock);
-
                 if (isPositiveAndBelow ((int) index, points.size()))
                 {
                     ParamPoint e (points.getUnchecked ((int) index));
@@ -2380,8 +2394,6 @@ struct VST3PluginInstance : public AudioPluginInstance
                                                     Steinberg::int32& index) override
             {
                 ParamPoint p = { sampleOffset, value };
-
-                const ScopedLock sl (pointLock);
                 index = (Steinberg::int32) points.size();
                 points.add (p);
                 return kResultTrue;
@@ -2389,7 +2401,6 @@ struct VST3PluginInstance : public AudioPluginInstance
 
             void clear() noexcept
             {
-                const ScopedLock sl (pointLock);
                 points.clearQuick();
             }
 
@@ -2403,7 +2414,6 @@ struct VST3PluginInstance : public AudioPluginInstance
             Atomic<int> refCount;
             Vst::ParamID paramID = static_cast<Vst::ParamID> (-1);
             Array<ParamPoint> points;
-            CriticalSection pointLock;
 
             JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParamValueQueue)
         };
@@ -2411,6 +2421,19 @@ struct VST3PluginInstance : public AudioPluginInstance
         Atomic<int> refCount;
         OwnedArray<ParamValueQueue> queues;
         int numQueuesUsed = 0;
+        const int numPointsToReserve;
+
+        ParamValueQueue* useNextQueue (Vst::ParamID id)
+        {
+            auto index = numQueuesUsed++;
+            auto* valueQueue = (index < queues.size() ? queues.getUnchecked (index)
+                                                      : queues.add (new ParamValueQueue (numPointsToReserve)));
+
+            valueQueue->clear();
+            valueQueue->setParamID (id);
+
+            return valueQueue;
+        }
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParamValueQueueList)
     };
@@ -2488,6 +2511,66 @@ private:
     ComSmartPtr<ParamValueQueueList> inputParameterChanges, outputParameterChanges;
     ComSmartPtr<MidiEventList> midiInputs, midiOutputs;
     Vst::ProcessContext timingInfo; //< Only use this in processBlock()!
+    Vst::ProcessData processData;   //< Only use this in processBlock()!
+
+    //==============================================================================
+    /** Parameter changes can be made on any thread, so rather than adding them straight
+        to the plug-in's input queues, each parameter has a slot here that holds its most
+        recent value. At the start of each block, the audio thread passes all the slots
+        that have changed to the plug-in as one batch, without locking or allocating.
+    */
+    struct PendingParameterChanges
+    {
+        void setNumParameters (int numParameters)
+        {
+            slots.clear();
+
+            // the extra slot at the end is for the program parameter
+            for (int i = 0; i <= numParameters; ++i)
+                slots.add (new Slot());
+        }
+
+        void set (int parameterIndex, Vst::ParamID paramID, Vst::ParamValue value) noexcept
+        {
+            if (isPositiveAndBelow (parameterIndex, slots.size() - 1))
+                setSlot (*slots.getUnchecked (parameterIndex), paramID, value);
+        }
+
+        void setProgram (Vst::ParamID paramID, Vst::ParamValue value) noexcept
+        {
+            if (auto* slot = slots.getLast())
+                setSlot (*slot, paramID, value);
+        }
+
+        void moveTo (ParamValueQueueList& destination)
+        {
+            if (anyChanged.exchange (false))
+                for (auto* slot : slots)
+                    if (slot->changed.exchange (false))
+                        destination.addSingleValue (slot->paramID.get(), slot->value.get());
+        }
+
+    private:
+        struct Slot
+        {
+            Atomic<Vst::ParamID> paramID;
+            Atomic<Vst::ParamValue> value;
+            Atomic<bool> changed;
+        };
+
+        void setSlot (Slot& slot, Vst::ParamID paramID, Vst::ParamValue value) noexcept
+        {
+            slot.paramID = paramID;
+            slot.value = value;
+            slot.changed = true;
+            anyChanged = true;
+        }
+
+        OwnedArray<Slot> slots;
+        Atomic<bool> anyChanged;
+    };
+
+    PendingParameterChanges pendingParameterChanges;
     bool isControllerInitialised = false, isActive = false;
 
     //==============================================================================
@@ -2645,6 +2728,15 @@ private:
         destination.processContext = &timingInfo;
     }
 
+    // Makes sure that associateTo() won't need to allocate anything for the current layout
+    void preallocateBusMaps()
+    {
+        VST3BufferExchange<float> ::preallocateBuses (inputBuses,  inputBusMap.get<float>(),   cachedBusLayouts.inputBuses);
+        VST3BufferExchange<float> ::preallocateBuses (outputBuses, outputBusMap.get<float>(),  cachedBusLayouts.outputBuses);
+        VST3BufferExchange<double>::preallocateBuses (inputBuses,  inputBusMap.get<double>(),  cachedBusLayouts.inputBuses);
+        VST3BufferExchange<double>::preallocateBuses (outputBuses, outputBusMap.get<double>(), cachedBusLayouts.outputBuses);
+    }
+
     Vst::ParameterInfo getParameterInfoForIndex (int index) const
     {
         Vst::ParameterInfo paramInfo = { 0 };
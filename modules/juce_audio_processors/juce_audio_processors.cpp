@@ -159,6 +159,8 @@ struct AutoResizingNSViewComponentWithParent  : public AutoResizingNSViewCompone
 #include "processors/juce_AudioProcessorGraph.cpp"
 #include "processors/juce_GenericAudioProcessorEditor.cpp"
 #include "processors/juce_PluginDescription.cpp"
+#include "processors/juce_ParameterAutomationBuffer.cpp"
+#include "processors/juce_BlockSizeAdapter.cpp"
 #include "format_types/juce_LADSPAPluginFormat.cpp"
 #include "format_types/juce_VSTPluginFormat.cpp"
 #include "format_types/juce_VST3PluginFormat.cpp"
@@ -166,5 +168,6 @@ struct AutoResizingNSViewComponentWithParent  : public AutoResizingNSViewCompone
 #include "scanning/juce_KnownPluginList.cpp"
 #include "scanning/juce_PluginDirectoryScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
+#include "scanning/juce_OutOfProcessPluginScanner.cpp"
 #include "utilities/juce_AudioProcessorParameters.cpp"
 #include "utilities/juce_AudioProcessorValueTreeState.cpp"
@@ -101,6 +101,8 @@
 #include "processors/juce_AudioProcessorEditor.h"
 #include "processors/juce_AudioProcessorListener.h"
 #include "processors/juce_AudioProcessorParameter.h"
+#include "processors/juce_ParameterAutomationBuffer.h"
+#include "processors/juce_BlockSizeAdapter.h"
 #include "processors/juce_AudioProcessor.h"
 #include "processors/juce_PluginDescription.h"
 #include "processors/juce_AudioPluginInstance.h"
@@ -116,6 +118,7 @@
 #include "format_types/juce_VST3PluginFormat.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
 #include "scanning/juce_PluginListComponent.h"
+#include "scanning/juce_OutOfProcessPluginScanner.h"
 #include "utilities/juce_AudioProcessorParameterWithID.h"
 #include "utilities/juce_AudioParameterFloat.h"
 #include "utilities/juce_AudioParameterInt.h"
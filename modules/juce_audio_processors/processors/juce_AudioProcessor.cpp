@@ -412,6 +412,9 @@ void AudioProcessor::setRateAndBufferSizeDetails (double newSampleRate, int newB
 {
     currentSampleRate = newSampleRate;
     blockSize = newBlockSize;
+
+    if (blockSizeAdapter != nullptr)
+        blockSizeAdapter->prepare (jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()));
 }
 
 //==============================================================================
@@ -547,6 +550,38 @@ const OwnedArray<AudioProcessorParameter>& AudioProcessor::getParameters() const
     return managedParameters;
 }
 
+void AudioProcessor::setParameterAutomationBufferEnabled (bool shouldBeEnabled, int maxPointsPerParameter)
+{
+    ScopedPointer<ParameterAutomationBuffer> newBuffer;
+
+    if (shouldBeEnabled)
+    {
+        newBuffer = new ParameterAutomationBuffer();
+        newBuffer->prepare (getNumParameters(), maxPointsPerParameter);
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+        automationBuffer.swapWith (newBuffer);
+    }
+}
+
+void AudioProcessor::setFixedBlockSize (int numSamples, bool addLatencyToKeepBlocksFull)
+{
+    ScopedPointer<BlockSizeAdapter> newAdapter;
+
+    if (numSamples > 0)
+    {
+        newAdapter = new BlockSizeAdapter (*this, numSamples, addLatencyToKeepBlocksFull);
+        newAdapter->prepare (jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()));
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+        blockSizeAdapter.swapWith (newAdapter);
+    }
+}
+
 int AudioProcessor::getNumParameters()
 {
     return managedParameters.size();
@@ -799,7 +799,10 @@ public:
         The host will call this to find the latency - the processor itself should set this value
         by calling setLatencySamples() as soon as it can during its initialisation.
     */
-    int getLatencySamples() const noexcept                      { return latencySamples; }
+    int getLatencySamples() const noexcept
+    {
+        return latencySamples + (blockSizeAdapter != nullptr ? blockSizeAdapter->getLatencySamples() : 0);
+    }
 
     /** Your processor subclass should call this to set the number of samples delay that it introduces.
 
@@ -1184,6 +1187,55 @@ public:
     /** Returns the current list of parameters. */
     const OwnedArray<AudioProcessorParameter>& getParameters() const noexcept;
 
+    //==============================================================================
+    /** Enables or disables sample-accurate parameter automation for this processor.
+
+        When this is enabled, plugin wrappers that receive sample-accurate automation from
+        their host will fill in the buffer that getParameterAutomationBuffer() returns, so
+        that processBlock() can see exactly where each parameter changed, rather than just
+        its last value in the block.
+
+        The buffer is allocated for the parameters that the processor currently has, with
+        room for up to maxPointsPerParameter breakpoints per parameter in each block, so call
+        this after adding all your parameters, e.g. at the end of your constructor.
+
+        @see ParameterAutomationBuffer
+    */
+    void setParameterAutomationBufferEnabled (bool shouldBeEnabled, int maxPointsPerParameter = 64);
+
+    /** Returns the automation that the host has sent for the current block, or nullptr if
+        setParameterAutomationBufferEnabled() hasn't been used to enable it.
+
+        This must only be used on the audio thread, from inside your processBlock() method.
+        @see ParameterAutomationBuffer
+    */
+    ParameterAutomationBuffer* getParameterAutomationBuffer() const noexcept   { return automationBuffer; }
+
+    //==============================================================================
+    /** Asks for processBlock() to always be called with a particular block size.
+
+        When this is set, the plugin wrappers, AudioProcessorPlayer and AudioProcessorGraph
+        pass their blocks through a BlockSizeAdapter, which calls processBlock() with chunks
+        of this size, rather than with whatever size the host happens to use.
+
+        If addLatencyToKeepBlocksFull is true, the audio is buffered so that every block is
+        exactly this size, which adds this many samples of latency. The extra latency is
+        included in the value that getLatencySamples() returns, so don't add it yourself.
+        If it's false, there's no extra latency, but only host blocks that are larger than
+        this get split up, so processBlock() may still be called with smaller blocks.
+
+        Call this before the processor is prepared, e.g. in your constructor. Passing zero
+        turns it off again.
+
+        @see BlockSizeAdapter
+    */
+    void setFixedBlockSize (int numSamples, bool addLatencyToKeepBlocksFull);
+
+    /** Returns the adapter that's being used to give this processor a fixed block size,
+        or nullptr if setFixedBlockSize() hasn't been used to turn it on.
+    */
+    BlockSizeAdapter* getBlockSizeAdapter() const noexcept      { return blockSizeAdapter; }
+
     //==============================================================================
     /** Returns the number of preset programs the processor supports.
 
@@ -1600,6 +1652,8 @@ private:
 
     OwnedArray<AudioProcessorParameter> managedParameters;
     AudioProcessorParameter* getParamChecked (int) const noexcept;
+    ScopedPointer<ParameterAutomationBuffer> automationBuffer;
+    ScopedPointer<BlockSizeAdapter> blockSizeAdapter;
 
    #if JUCE_DEBUG && ! JUCE_DISABLE_AUDIOPROCESSOR_BEGIN_END_GESTURE_CHECKING
     BigInteger changingParams;
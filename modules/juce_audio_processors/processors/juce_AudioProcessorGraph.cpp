@@ -63,6 +63,44 @@ template <typename FloatingType> struct FloatDoubleType<AudioBuffer<FloatPlaceho
 namespace GraphRenderingOps
 {
 
+//==============================================================================
+/** Describes which of the shared buffers a rendering op reads and writes, so that
+    the parallel renderer can work out which ops are able to run concurrently.
+*/
+struct BufferUsage
+{
+    Array<int> audioBuffersRead, audioBuffersWritten;
+    Array<int> midiBuffersRead, midiBuffersWritten;
+    Array<int> delayLinesRead, delayLinesWritten;
+    bool writesToGraphOutput = false;
+};
+
+//==============================================================================
+/** Keeps track of which of the shared buffers are known to contain only zeros, so
+    that the ops can avoid clearing, copying or mixing silence, and so that nodes can
+    be skipped when all their inputs are silent.
+
+    Each flag is only touched by the ops that read or write its buffer, so the parallel
+    renderer's ordering of those ops also keeps the flags consistent.
+*/
+struct SilentBufferFlags
+{
+    // the buffers are cleared when they're allocated, so they all start off silent
+    void allocate (int numBuffers)
+    {
+        flags.malloc ((size_t) jmax (1, numBuffers));
+
+        for (int i = 0; i < numBuffers; ++i)
+            flags[i] = true;
+    }
+
+    bool isSilent (int buffer) const noexcept               { return flags[buffer]; }
+    void setSilent (int buffer, bool shouldBeSilent) noexcept   { flags[buffer] = shouldBeSilent; }
+
+private:
+    HeapBlock<bool> flags;
+};
+
 struct AudioGraphRenderingOpBase
 {
     AudioGraphRenderingOpBase() noexcept {}
@@ -76,6 +114,9 @@ struct AudioGraphRenderingOpBase
                           const OwnedArray<MidiBuffer>& sharedMidiBuffers,
                           const int numSamples) = 0;
 
+    virtual void getBufferUsage (BufferUsage&) const = 0;
+    virtual bool isProcessBufferOp() const noexcept     { return false; }
+
     JUCE_LEAK_DETECTOR (AudioGraphRenderingOpBase)
 };
 
@@ -101,14 +142,26 @@ struct AudioGraphRenderingOp  : public AudioGraphRenderingOpBase
 //==============================================================================
 struct ClearChannelOp  : public AudioGraphRenderingOp<ClearChannelOp>
 {
-    ClearChannelOp (const int channel) noexcept  : channelNum (channel)  {}
+    ClearChannelOp (SilentBufferFlags& flags, const int channel) noexcept
+        : silentBuffers (flags), channelNum (channel)
+    {}
 
     template <typename FloatType>
     void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
     {
-        sharedBufferChans.clear (channelNum, 0, numSamples);
+        if (! silentBuffers.isSilent (channelNum))
+        {
+            sharedBufferChans.clear (channelNum, 0, numSamples);
+            silentBuffers.setSilent (channelNum, true);
+        }
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.audioBuffersWritten.add (channelNum);
     }
 
+    SilentBufferFlags& silentBuffers;
     const int channelNum;
 
     JUCE_DECLARE_NON_COPYABLE (ClearChannelOp)
@@ -117,16 +170,35 @@ struct ClearChannelOp  : public AudioGraphRenderingOp<ClearChannelOp>
 //==============================================================================
 struct CopyChannelOp  : public AudioGraphRenderingOp<CopyChannelOp>
 {
-    CopyChannelOp (const int srcChan, const int dstChan) noexcept
-        : srcChannelNum (srcChan), dstChannelNum (dstChan)
+    CopyChannelOp (SilentBufferFlags& flags, const int srcChan, const int dstChan) noexcept
+        : silentBuffers (flags), srcChannelNum (srcChan), dstChannelNum (dstChan)
     {}
 
     template <typename FloatType>
     void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
     {
-        sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+        if (silentBuffers.isSilent (srcChannelNum))
+        {
+            if (! silentBuffers.isSilent (dstChannelNum))
+            {
+                sharedBufferChans.clear (dstChannelNum, 0, numSamples);
+                silentBuffers.setSilent (dstChannelNum, true);
+            }
+        }
+        else
+        {
+            sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+            silentBuffers.setSilent (dstChannelNum, false);
+        }
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.audioBuffersRead.add (srcChannelNum);
+        usage.audioBuffersWritten.add (dstChannelNum);
     }
 
+    SilentBufferFlags& silentBuffers;
     const int srcChannelNum, dstChannelNum;
 
     JUCE_DECLARE_NON_COPYABLE (CopyChannelOp)
@@ -135,16 +207,32 @@ struct CopyChannelOp  : public AudioGraphRenderingOp<CopyChannelOp>
 //==============================================================================
 struct AddChannelOp  : public AudioGraphRenderingOp<AddChannelOp>
 {
-    AddChannelOp (const int srcChan, const int dstChan) noexcept
-        : srcChannelNum (srcChan), dstChannelNum (dstChan)
+    AddChannelOp (SilentBufferFlags& flags, const int srcChan, const int dstChan) noexcept
+        : silentBuffers (flags), srcChannelNum (srcChan), dstChannelNum (dstChan)
     {}
 
     template <typename FloatType>
     void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
     {
-        sharedBufferChans.addFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+        if (silentBuffers.isSilent (srcChannelNum))
+            return;
+
+        // adding to silence is just a copy
+        if (silentBuffers.isSilent (dstChannelNum))
+            sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+        else
+            sharedBufferChans.addFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+
+        silentBuffers.setSilent (dstChannelNum, false);
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.audioBuffersRead.add (srcChannelNum);
+        usage.audioBuffersWritten.add (dstChannelNum);
     }
 
+    SilentBufferFlags& silentBuffers;
     const int srcChannelNum, dstChannelNum;
 
     JUCE_DECLARE_NON_COPYABLE (AddChannelOp)
@@ -161,6 +249,11 @@ struct ClearMidiBufferOp  : public AudioGraphRenderingOp<ClearMidiBufferOp>
         sharedMidiBuffers.getUnchecked (bufferNum)->clear();
     }
 
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.midiBuffersWritten.add (bufferNum);
+    }
+
     const int bufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (ClearMidiBufferOp)
@@ -179,6 +272,12 @@ struct CopyMidiBufferOp  : public AudioGraphRenderingOp<CopyMidiBufferOp>
         *sharedMidiBuffers.getUnchecked (dstBufferNum) = *sharedMidiBuffers.getUnchecked (srcBufferNum);
     }
 
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.midiBuffersRead.add (srcBufferNum);
+        usage.midiBuffersWritten.add (dstBufferNum);
+    }
+
     const int srcBufferNum, dstBufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (CopyMidiBufferOp)
@@ -198,58 +297,224 @@ struct AddMidiBufferOp  : public AudioGraphRenderingOp<AddMidiBufferOp>
             ->addEvents (*sharedMidiBuffers.getUnchecked (srcBufferNum), 0, numSamples, 0);
     }
 
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.midiBuffersRead.add (srcBufferNum);
+        usage.midiBuffersWritten.add (dstBufferNum);
+    }
+
     const int srcBufferNum, dstBufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (AddMidiBufferOp)
 };
 
 //==============================================================================
-struct DelayChannelOp  : public AudioGraphRenderingOp<DelayChannelOp>
+/** The delay lines that compensate for the latencies of the nodes.
+
+    Each source channel whose output needs delaying gets a single line, which is
+    written once per block. Every connection that needs a delayed copy of that channel
+    reads from the line through its own tap, so connections that share a source also
+    share its line. All the lines live in one block of memory.
+*/
+struct DelayLinePool
 {
-    DelayChannelOp (const int chan, const int delaySize)
-        : channel (chan),
-          bufferSize (delaySize + 1),
-          readIndex (0), writeIndex (delaySize)
+    struct Line
+    {
+        uint32 sourceNodeId;
+        int sourceChannel, maxDelay, size, writePosition;
+        size_t offset;
+    };
+
+    struct Tap
+    {
+        Tap (int line, uint32 destNode, int initialDelay) noexcept
+            : lineIndex (line), destNodeId (destNode), delay (initialDelay)
+        {}
+
+        const int lineIndex;
+        const uint32 destNodeId;
+        std::atomic<int> delay;
+    };
+
+    /** Returns the line for a source channel, adding one if there isn't one yet. */
+    int getLineIndex (uint32 sourceNodeId, int sourceChannel, bool& isNewLine)
+    {
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            auto& line = *lines.getUnchecked (i);
+
+            if (line.sourceNodeId == sourceNodeId && line.sourceChannel == sourceChannel)
+            {
+                isNewLine = false;
+                return i;
+            }
+        }
+
+        lines.add (new Line { sourceNodeId, sourceChannel, 0, 0, 0, 0 });
+        isNewLine = true;
+        return lines.size() - 1;
+    }
+
+    Tap& addTap (int lineIndex, uint32 destNodeId, int delay)
+    {
+        auto& line = *lines.getUnchecked (lineIndex);
+        line.maxDelay = jmax (line.maxDelay, delay);
+
+        return *taps.add (new Tap (lineIndex, destNodeId, delay));
+    }
+
+    /** Allocates the lines once all of them have been added. */
+    void allocate (int maxBlockSize, bool useDoublePrecision)
     {
-        buffer.floatVersion. calloc ((size_t) bufferSize);
-        buffer.doubleVersion.calloc ((size_t) bufferSize);
+        blockSize = maxBlockSize;
+        size_t totalSize = 0;
+
+        for (auto* line : lines)
+        {
+            // rounding up leaves some room for the latencies to grow without a rebuild
+            line->size = nextPowerOfTwo (line->maxDelay + blockSize);
+            line->offset = totalSize;
+            totalSize += (size_t) line->size;
+        }
+
+        if (useDoublePrecision)
+            storage.doubleVersion.calloc (totalSize);
+        else
+            storage.floatVersion.calloc (totalSize);
     }
 
+    /** Returns the longest delay that a tap on a line can have. */
+    int getMaxDelay (const Line& line) const noexcept       { return line.size - blockSize; }
+
     template <typename FloatType>
-    void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    void write (Line& line, const FloatType* source, int numSamples) noexcept
     {
-        FloatType* data = sharedBufferChans.getWritePointer (channel, 0);
-        HeapBlock<FloatType>& block = buffer.get<FloatType>();
+        auto* data = storage.get<FloatType>().get();
+
+        // the lines were allocated for the graph's other processing precision!
+        jassert (data != nullptr);
 
-        for (int i = numSamples; --i >= 0;)
+        if (data != nullptr)
         {
-            block [writeIndex] = *data;
-            *data++ = block [readIndex];
+            data += line.offset;
+            auto num1 = jmin (numSamples, line.size - line.writePosition);
 
-            if (++readIndex  >= bufferSize) readIndex = 0;
-            if (++writeIndex >= bufferSize) writeIndex = 0;
+            FloatVectorOperations::copy (data + line.writePosition, source, num1);
+            FloatVectorOperations::copy (data, source + num1, numSamples - num1);
+        }
+
+        line.writePosition = (line.writePosition + numSamples) % line.size;
+    }
+
+    template <typename FloatType>
+    void read (const Line& line, int delay, FloatType* dest, int numSamples, bool addToDest) const noexcept
+    {
+        auto* data = storage.get<FloatType>().get();
+
+        if (data == nullptr)
+            return;
+
+        data += line.offset;
+
+        // (the line was written with this block's samples just before this)
+        auto start = (line.writePosition - numSamples - delay + 2 * line.size) % line.size;
+        auto num1 = jmin (numSamples, line.size - start);
+
+        if (addToDest)
+        {
+            FloatVectorOperations::add (dest, data + start, num1);
+            FloatVectorOperations::add (dest + num1, data, numSamples - num1);
+        }
+        else
+        {
+            FloatVectorOperations::copy (dest, data + start, num1);
+            FloatVectorOperations::copy (dest + num1, data, numSamples - num1);
         }
     }
 
+    OwnedArray<Line> lines;
+    OwnedArray<Tap> taps;
+
 private:
-    FloatAndDoubleComposition<HeapBlock<FloatPlaceholder> > buffer;
-    const int channel, bufferSize;
-    int readIndex, writeIndex;
+    mutable FloatAndDoubleComposition<HeapBlock<FloatPlaceholder> > storage;
+    int blockSize = 0;
+};
 
-    JUCE_DECLARE_NON_COPYABLE (DelayChannelOp)
+//==============================================================================
+struct WriteDelayLineOp  : public AudioGraphRenderingOp<WriteDelayLineOp>
+{
+    WriteDelayLineOp (DelayLinePool& p, const int line, const int chan) noexcept
+        : pool (p), lineIndex (line), channel (chan)
+    {}
+
+    template <typename FloatType>
+    void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    {
+        pool.write (*pool.lines.getUnchecked (lineIndex), sharedBufferChans.getReadPointer (channel), numSamples);
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.audioBuffersRead.add (channel);
+        usage.delayLinesWritten.add (lineIndex);
+    }
+
+    DelayLinePool& pool;
+    const int lineIndex, channel;
+
+    JUCE_DECLARE_NON_COPYABLE (WriteDelayLineOp)
+};
+
+//==============================================================================
+struct ReadDelayLineOp  : public AudioGraphRenderingOp<ReadDelayLineOp>
+{
+    ReadDelayLineOp (DelayLinePool& p, DelayLinePool::Tap& t, SilentBufferFlags& flags,
+                     const int chan, const bool shouldAdd) noexcept
+        : pool (p), tap (t), silentBuffers (flags), channel (chan), addToChannel (shouldAdd)
+    {}
+
+    template <typename FloatType>
+    void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    {
+        pool.read (*pool.lines.getUnchecked (tap.lineIndex), tap.delay.load(),
+                   sharedBufferChans.getWritePointer (channel), numSamples, addToChannel);
+
+        // the line isn't checked for silence, so the result has to be assumed to contain something
+        silentBuffers.setSilent (channel, false);
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        usage.audioBuffersWritten.add (channel);
+        usage.delayLinesRead.add (tap.lineIndex);
+    }
+
+    const DelayLinePool& pool;
+    const DelayLinePool::Tap& tap;
+    SilentBufferFlags& silentBuffers;
+    const int channel;
+    const bool addToChannel;
+
+    JUCE_DECLARE_NON_COPYABLE (ReadDelayLineOp)
 };
 
 //==============================================================================
 struct ProcessBufferOp   : public AudioGraphRenderingOp<ProcessBufferOp>
 {
     ProcessBufferOp (const AudioProcessorGraph::Node::Ptr& n,
+                     SilentBufferFlags& flags,
                      const Array<int>& audioChannelsUsed,
                      const int totalNumChans,
+                     const int numInputChans,
+                     const int numOutputChans,
                      const int midiBuffer)
         : node (n),
           processor (n->getProcessor()),
+          silentBuffers (flags),
           audioChannelsToUse (audioChannelsUsed),
           totalChans (jmax (1, totalNumChans)),
+          numIns (numInputChans),
+          numOuts (numOutputChans),
           midiBufferToUse (midiBuffer)
     {
         audioChannels.floatVersion. calloc ((size_t) totalChans);
@@ -262,6 +527,24 @@ struct ProcessBufferOp   : public AudioGraphRenderingOp<ProcessBufferOp>
     template <typename FloatType>
     void perform (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>& sharedMidiBuffers, const int numSamples)
     {
+        JUCE_TRACE_ZONE_WITH_ARG ("AudioProcessorGraph node", node->nodeId);
+
+        if (node->isSkippedWhenSilent() && canSkip (*sharedMidiBuffers.getUnchecked (midiBufferToUse), numSamples))
+        {
+            for (int i = 0; i < numOuts; ++i)
+            {
+                const int chan = audioChannelsToUse.getUnchecked (i);
+
+                if (! silentBuffers.isSilent (chan))
+                {
+                    sharedBufferChans.clear (chan, 0, numSamples);
+                    silentBuffers.setSilent (chan, true);
+                }
+            }
+
+            return;
+        }
+
         HeapBlock<FloatType*>& channels = audioChannels.get<FloatType>();
 
         for (int i = totalChans; --i >= 0;)
@@ -269,28 +552,80 @@ struct ProcessBufferOp   : public AudioGraphRenderingOp<ProcessBufferOp>
 
         AudioBuffer<FloatType> buffer (channels, totalChans, numSamples);
 
-        if (processor->isSuspended())
+        const bool isSuspended = processor->isSuspended();
+
+        if (isSuspended)
         {
             buffer.clear();
         }
         else
         {
-            ScopedLock lock (processor->getCallbackLock());
+            const RealtimeSafety::ScopedExemptLock<CriticalSection> lock (processor->getCallbackLock());
 
             callProcess (buffer, *sharedMidiBuffers.getUnchecked (midiBufferToUse));
         }
+
+        for (int i = 0; i < numOuts; ++i)
+            silentBuffers.setSilent (audioChannelsToUse.getUnchecked (i), isSuspended);
+    }
+
+    // Returns true if all the inputs are silent and the processor's tail has finished. A node
+    // with no audio inputs is a source, so it's never skipped.
+    bool canSkip (const MidiBuffer& midiInput, const int numSamples) noexcept
+    {
+        bool inputIsSilent = numIns > 0 && midiInput.isEmpty();
+
+        for (int i = 0; i < numIns && inputIsSilent; ++i)
+            inputIsSilent = silentBuffers.isSilent (audioChannelsToUse.getUnchecked (i));
+
+        if (! inputIsSilent)
+        {
+            numSilentSamples = 0;
+            return false;
+        }
+
+        const double tailSeconds = processor->getTailLengthSeconds();
+
+        if (std::isinf (tailSeconds)
+             || numSilentSamples < (int64) (tailSeconds * processor->getSampleRate()))
+        {
+            numSilentSamples += numSamples;
+            return false;
+        }
+
+        return true;
+    }
+
+    void getBufferUsage (BufferUsage& usage) const override
+    {
+        // the processor can write in-place to any of its output channels, but any
+        // extra input channels that it has are only read from
+        for (int i = 0; i < totalChans; ++i)
+        {
+            if (i < numOuts)
+                usage.audioBuffersWritten.addIfNotAlreadyThere (audioChannelsToUse.getUnchecked (i));
+            else
+                usage.audioBuffersRead.addIfNotAlreadyThere (audioChannelsToUse.getUnchecked (i));
+        }
+
+        usage.midiBuffersWritten.add (midiBufferToUse);
+
+        if (auto* ioProc = dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (processor))
+            usage.writesToGraphOutput = ioProc->isOutput();
     }
 
+    bool isProcessBufferOp() const noexcept override    { return true; }
+
     void callProcess (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
     {
-        processor->processBlock (buffer, midiMessages);
+        processBlock (buffer, midiMessages);
     }
 
     void callProcess (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
     {
         if (processor->isUsingDoublePrecision())
         {
-            processor->processBlock (buffer, midiMessages);
+            processBlock (buffer, midiMessages);
         }
         else
         {
@@ -299,69 +634,230 @@ struct ProcessBufferOp   : public AudioGraphRenderingOp<ProcessBufferOp>
             // this will only happen if the processor does not support double
             // precision processing.
             tempBuffer.makeCopyOf (buffer, true);
-            processor->processBlock (tempBuffer, midiMessages);
+            processBlock (tempBuffer, midiMessages);
             buffer.makeCopyOf (tempBuffer, true);
         }
     }
 
+    template <typename FloatType>
+    void processBlock (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages)
+    {
+        if (auto* adapter = processor->getBlockSizeAdapter())
+            adapter->process (buffer, midiMessages, false);
+        else
+            processor->processBlock (buffer, midiMessages);
+    }
+
     const AudioProcessorGraph::Node::Ptr node;
     AudioProcessor* const processor;
 
 private:
+    SilentBufferFlags& silentBuffers;
     Array<int> audioChannelsToUse;
     FloatAndDoubleComposition<HeapBlock<FloatPlaceholder*> > audioChannels;
     AudioBuffer<float> tempBuffer;
-    const int totalChans;
+    const int totalChans, numIns, numOuts;
     const int midiBufferToUse;
+    int64 numSilentSamples = 0;
 
     JUCE_DECLARE_NON_COPYABLE (ProcessBufferOp)
 };
 
+//==============================================================================
+/** A copy of the graph's nodes and connections, taken on the message thread, which
+    the rendering sequence can then be built from on a background thread.
+*/
+struct GraphSnapshot
+{
+    struct NodeInfo
+    {
+        AudioProcessorGraph::Node::Ptr node;
+        uint32 nodeId;
+        int numIns, numOuts, latencySamples;
+        bool acceptsMidi, producesMidi;
+        Array<const AudioProcessorGraph::Connection*> inputs;
+    };
+
+    GraphSnapshot (const ReferenceCountedArray<AudioProcessorGraph::Node>& graphNodes,
+                   const OwnedArray<AudioProcessorGraph::Connection>& graphConnections,
+                   int blockSizeToUse, bool shouldBuildParallelSchedule, bool shouldUseDoublePrecision)
+        : blockSize (blockSizeToUse),
+          buildParallelSchedule (shouldBuildParallelSchedule),
+          useDoublePrecision (shouldUseDoublePrecision)
+    {
+        for (auto* c : graphConnections)
+            connections.add (*c);
+
+        for (auto* n : graphNodes)
+        {
+            auto* info = new NodeInfo();
+            auto& processor = *n->getProcessor();
+
+            info->node           = n;
+            info->nodeId         = n->nodeId;
+            info->numIns         = processor.getTotalNumInputChannels();
+            info->numOuts        = processor.getTotalNumOutputChannels();
+            info->latencySamples = processor.getLatencySamples();
+            info->acceptsMidi    = processor.acceptsMidi();
+            info->producesMidi   = processor.producesMidi();
+
+            nodes.add (info);
+            nodeIndexes.set (n->nodeId, nodes.size() - 1);
+        }
+
+        for (auto& c : connections)
+            if (auto* dest = getNodeForId (c.destNodeId))
+                dest->inputs.add (&c);
+    }
+
+    NodeInfo* getNodeForId (uint32 nodeId) const
+    {
+        return nodeIndexes.contains (nodeId) ? nodes.getUnchecked (nodeIndexes[nodeId]) : nullptr;
+    }
+
+    const Array<const AudioProcessorGraph::Connection*>& getInputConnections (uint32 nodeId) const
+    {
+        if (auto* n = getNodeForId (nodeId))
+            return n->inputs;
+
+        static const Array<const AudioProcessorGraph::Connection*> noConnections;
+        return noConnections;
+    }
+
+    const AudioProcessorGraph::Connection* getConnectionBetween (uint32 sourceNodeId, int sourceChannelIndex,
+                                                                 uint32 destNodeId, int destChannelIndex) const
+    {
+        // the connections are copied from the graph in sorted order, so can be binary-searched
+        const AudioProcessorGraph::Connection target (sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex);
+
+        int start = 0, end = connections.size();
+
+        while (start < end)
+        {
+            const int halfway = (start + end) / 2;
+            auto& c = connections.getReference (halfway);
+            const int comparison = compare (target, c);
+
+            if (comparison == 0)
+                return &c;
+
+            if (comparison < 0)
+                end = halfway;
+            else
+                start = halfway + 1;
+        }
+
+        return nullptr;
+    }
+
+    static int compare (const AudioProcessorGraph::Connection& first,
+                        const AudioProcessorGraph::Connection& second) noexcept
+    {
+        if (first.sourceNodeId < second.sourceNodeId)                return -1;
+        if (first.sourceNodeId > second.sourceNodeId)                return 1;
+        if (first.destNodeId < second.destNodeId)                    return -1;
+        if (first.destNodeId > second.destNodeId)                    return 1;
+        if (first.sourceChannelIndex < second.sourceChannelIndex)    return -1;
+        if (first.sourceChannelIndex > second.sourceChannelIndex)    return 1;
+        if (first.destChannelIndex < second.destChannelIndex)        return -1;
+        if (first.destChannelIndex > second.destChannelIndex)        return 1;
+
+        return 0;
+    }
+
+    OwnedArray<NodeInfo> nodes;
+    Array<AudioProcessorGraph::Connection> connections;
+    HashMap<uint32, int> nodeIndexes;
+    const int blockSize;
+    const bool buildParallelSchedule, useDoublePrecision;
+
+    JUCE_DECLARE_NON_COPYABLE (GraphSnapshot)
+};
+
 //==============================================================================
 /** Used to calculate the correct sequence of rendering ops needed, based on
     the best re-use of shared buffers at each stage.
 */
 struct RenderingOpSequenceCalculator
 {
-    RenderingOpSequenceCalculator (AudioProcessorGraph& g,
-                                   const Array<AudioProcessorGraph::Node*>& nodes,
-                                   Array<void*>& renderingOps)
+    RenderingOpSequenceCalculator (const GraphSnapshot& g,
+                                   const Array<GraphSnapshot::NodeInfo*>& nodes,
+                                   Array<void*>& renderingOps,
+                                   DelayLinePool& delayLinePool,
+                                   SilentBufferFlags& silentBufferFlags)
         : graph (g),
           orderedNodes (nodes),
+          delayLines (delayLinePool),
+          silentBuffers (silentBufferFlags),
+          channels (arena), nodeIds (arena), midiNodeIds (arena),
+          freedAtStep (arena), midiFreedAtStep (arena),
+          nodeDelayIDs (arena), nodeDelays (arena),
+          lastUses (jmax (16, nodes.size() * 4)),
           totalLatency (0)
     {
         nodeIds.add ((uint32) zeroNodeID); // first buffer is read-only zeros
         channels.add (0);
+        freedAtStep.add (0);
 
         midiNodeIds.add ((uint32) zeroNodeID);
+        midiFreedAtStep.add (0);
+
+        // Each output channel is live from the step that renders it until the last step that
+        // reads it, so finding those last reads up-front means that each buffer can be freed
+        // as soon as its interval ends, without searching the rest of the graph each time.
+        for (int i = 0; i < orderedNodes.size(); ++i)
+            for (auto* c : orderedNodes.getUnchecked (i)->inputs)
+                lastUses.set (getOutputKey (c->sourceNodeId, c->sourceChannelIndex), i);
 
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (*orderedNodes.getUnchecked(i), renderingOps, i);
-            markAnyUnusedBuffersAsFree (i);
+            markAnyUnusedBuffersAsFree (i + 1);
         }
-
-        graph.setLatencySamples (totalLatency);
     }
 
     int getNumBuffersNeeded() const noexcept         { return nodeIds.size(); }
     int getNumMidiBuffersNeeded() const noexcept     { return midiNodeIds.size(); }
+    int getTotalLatencySamples() const noexcept      { return totalLatency; }
 
 private:
     //==============================================================================
-    AudioProcessorGraph& graph;
-    const Array<AudioProcessorGraph::Node*>& orderedNodes;
-    Array<int> channels;
-    Array<uint32> nodeIds, midiNodeIds;
+    // All the temporary arrays live in this arena, so working out the sequence
+    // doesn't need to keep going back to the heap
+    template <typename ElementType>
+    using TempArray = Array<ElementType, DummyCriticalSection, 0, MemoryArena::Allocator>;
+
+    const GraphSnapshot& graph;
+    const Array<GraphSnapshot::NodeInfo*>& orderedNodes;
+    DelayLinePool& delayLines;
+    SilentBufferFlags& silentBuffers;
+    char arenaSpace[2048];
+    MemoryArena arena { arenaSpace, sizeof (arenaSpace) };
+    TempArray<int> channels;
+    TempArray<uint32> nodeIds, midiNodeIds;
+    TempArray<int> freedAtStep, midiFreedAtStep;
 
     enum { freeNodeID = 0xffffffff, zeroNodeID = 0xfffffffe, anonymousNodeID = 0xfffffffd };
 
     static bool isNodeBusy (uint32 nodeID) noexcept     { return nodeID != freeNodeID && nodeID != zeroNodeID; }
 
-    Array<uint32> nodeDelayIDs;
-    Array<int> nodeDelays;
+    TempArray<uint32> nodeDelayIDs;
+    TempArray<int> nodeDelays;
+    HashMap<uint64, int> lastUses;
     int totalLatency;
 
+    static uint64 getOutputKey (uint32 nodeId, int outputChannel) noexcept
+    {
+        return (((uint64) nodeId) << 32) | (uint32) outputChannel;
+    }
+
+    // returns the index of the last node that reads this output, or -1 if nothing does
+    int getLastUse (uint32 nodeId, int outputChannel) const
+    {
+        const uint64 key = getOutputKey (nodeId, outputChannel);
+        return lastUses.contains (key) ? lastUses[key] : -1;
+    }
+
     int getNodeDelay (const uint32 nodeID) const        { return nodeDelays [nodeDelayIDs.indexOf (nodeID)]; }
 
     void setNodeDelay (const uint32 nodeID, const int latency)
@@ -383,25 +879,19 @@ private:
     {
         int maxLatency = 0;
 
-        for (int i = graph.getNumConnections(); --i >= 0;)
-        {
-            const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
-
-            if (c->destNodeId == nodeID)
-                maxLatency = jmax (maxLatency, getNodeDelay (c->sourceNodeId));
-        }
+        for (auto* c : graph.getInputConnections (nodeID))
+            maxLatency = jmax (maxLatency, getNodeDelay (c->sourceNodeId));
 
         return maxLatency;
     }
 
     //==============================================================================
-    void createRenderingOpsForNode (AudioProcessorGraph::Node& node,
+    void createRenderingOpsForNode (const GraphSnapshot::NodeInfo& node,
                                     Array<void*>& renderingOps,
                                     const int ourRenderingIndex)
     {
-        AudioProcessor& processor = *node.getProcessor();
-        const int numIns  = processor.getTotalNumInputChannels();
-        const int numOuts = processor.getTotalNumOutputChannels();
+        const int numIns  = node.numIns;
+        const int numOuts = node.numOuts;
         const int totalChans = jmax (numIns, numOuts);
 
         Array<int> audioChannelsToUse;
@@ -412,14 +902,14 @@ private:
         for (int inputChan = 0; inputChan < numIns; ++inputChan)
         {
             // get a list of all the inputs to this node
-            Array<uint32> sourceNodes;
-            Array<int> sourceOutputChans;
+            TempArray<uint32> sourceNodes (arena);
+            TempArray<int> sourceOutputChans (arena);
 
-            for (int i = graph.getNumConnections(); --i >= 0;)
+            for (int i = node.inputs.size(); --i >= 0;)
             {
-                const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
+                const AudioProcessorGraph::Connection* const c = node.inputs.getUnchecked (i);
 
-                if (c->destNodeId == node.nodeId && c->destChannelIndex == inputChan)
+                if (c->destChannelIndex == inputChan)
                 {
                     sourceNodes.add (c->sourceNodeId);
                     sourceOutputChans.add (c->sourceChannelIndex);
@@ -440,7 +930,7 @@ private:
                 else
                 {
                     bufIndex = getFreeBuffer (false);
-                    renderingOps.add (new ClearChannelOp (bufIndex));
+                    renderingOps.add (new ClearChannelOp (silentBuffers, bufIndex));
                 }
             }
             else if (sourceNodes.size() == 1)
@@ -458,24 +948,30 @@ private:
                     jassert (bufIndex >= 0);
                 }
 
-                if (inputChan < numOuts
-                     && isBufferNeededLater (ourRenderingIndex,
-                                             inputChan,
-                                             srcNode, srcChan))
+                const int nodeDelay = getNodeDelay (srcNode);
+                const bool neededLater = isBufferNeededLater (ourRenderingIndex, inputChan, srcNode, srcChan);
+
+                if (nodeDelay < maxLatency && bufIndex != getReadOnlyEmptyBuffer())
+                {
+                    // if the channel is needed later by another node, the delayed copy
+                    // goes into a new buffer rather than replacing it
+                    const int delayedBuffer = neededLater ? getFreeAnonymousBuffer() : bufIndex;
+
+                    addDelayOps (renderingOps, bufIndex, srcNode, srcChan,
+                                 delayedBuffer, node.nodeId, maxLatency - nodeDelay, false);
+
+                    bufIndex = delayedBuffer;
+                }
+                else if (inputChan < numOuts && neededLater)
                 {
                     // can't mess up this channel because it's needed later by another node, so we
                     // need to use a copy of it..
                     const int newFreeBuffer = getFreeBuffer (false);
 
-                    renderingOps.add (new CopyChannelOp (bufIndex, newFreeBuffer));
+                    renderingOps.add (new CopyChannelOp (silentBuffers, bufIndex, newFreeBuffer));
 
                     bufIndex = newFreeBuffer;
                 }
-
-                const int nodeDelay = getNodeDelay (srcNode);
-
-                if (nodeDelay < maxLatency)
-                    renderingOps.add (new DelayChannelOp (bufIndex, maxLatency - nodeDelay));
             }
             else
             {
@@ -500,8 +996,11 @@ private:
                         bufIndex = sourceBufIndex;
 
                         const int nodeDelay = getNodeDelay (sourceNodes.getUnchecked (i));
+
                         if (nodeDelay < maxLatency)
-                            renderingOps.add (new DelayChannelOp (sourceBufIndex, maxLatency - nodeDelay));
+                            addDelayOps (renderingOps, sourceBufIndex, sourceNodes.getUnchecked (i),
+                                         sourceOutputChans.getUnchecked (i), sourceBufIndex, node.nodeId,
+                                         maxLatency - nodeDelay, false);
 
                         break;
                     }
@@ -517,51 +1016,43 @@ private:
 
                     const int srcIndex = getBufferContaining (sourceNodes.getUnchecked (0),
                                                               sourceOutputChans.getUnchecked (0));
+                    const int nodeDelay = getNodeDelay (sourceNodes.getFirst());
+
                     if (srcIndex < 0)
                     {
                         // if not found, this is probably a feedback loop
-                        renderingOps.add (new ClearChannelOp (bufIndex));
+                        renderingOps.add (new ClearChannelOp (silentBuffers, bufIndex));
+                    }
+                    else if (nodeDelay < maxLatency)
+                    {
+                        addDelayOps (renderingOps, srcIndex, sourceNodes.getFirst(), sourceOutputChans.getFirst(),
+                                     bufIndex, node.nodeId, maxLatency - nodeDelay, false);
                     }
                     else
                     {
-                        renderingOps.add (new CopyChannelOp (srcIndex, bufIndex));
+                        renderingOps.add (new CopyChannelOp (silentBuffers, srcIndex, bufIndex));
                     }
 
                     reusableInputIndex = 0;
-                    const int nodeDelay = getNodeDelay (sourceNodes.getFirst());
-
-                    if (nodeDelay < maxLatency)
-                        renderingOps.add (new DelayChannelOp (bufIndex, maxLatency - nodeDelay));
                 }
 
                 for (int j = 0; j < sourceNodes.size(); ++j)
                 {
                     if (j != reusableInputIndex)
                     {
-                        int srcIndex = getBufferContaining (sourceNodes.getUnchecked(j),
-                                                            sourceOutputChans.getUnchecked(j));
+                        const int srcIndex = getBufferContaining (sourceNodes.getUnchecked(j),
+                                                                  sourceOutputChans.getUnchecked(j));
                         if (srcIndex >= 0)
                         {
                             const int nodeDelay = getNodeDelay (sourceNodes.getUnchecked (j));
 
+                            // a delayed input is mixed straight from its delay line
                             if (nodeDelay < maxLatency)
-                            {
-                                if (! isBufferNeededLater (ourRenderingIndex, inputChan,
-                                                           sourceNodes.getUnchecked(j),
-                                                           sourceOutputChans.getUnchecked(j)))
-                                {
-                                    renderingOps.add (new DelayChannelOp (srcIndex, maxLatency - nodeDelay));
-                                }
-                                else // buffer is reused elsewhere, can't be delayed
-                                {
-                                    const int bufferToDelay = getFreeBuffer (false);
-                                    renderingOps.add (new CopyChannelOp (srcIndex, bufferToDelay));
-                                    renderingOps.add (new DelayChannelOp (bufferToDelay, maxLatency - nodeDelay));
-                                    srcIndex = bufferToDelay;
-                                }
-                            }
-
-                            renderingOps.add (new AddChannelOp (srcIndex, bufIndex));
+                                addDelayOps (renderingOps, srcIndex, sourceNodes.getUnchecked (j),
+                                             sourceOutputChans.getUnchecked (j), bufIndex, node.nodeId,
+                                             maxLatency - nodeDelay, true);
+                            else
+                                renderingOps.add (new AddChannelOp (silentBuffers, srcIndex, bufIndex));
                         }
                     }
                 }
@@ -584,13 +1075,13 @@ private:
         }
 
         // Now the same thing for midi..
-        Array<uint32> midiSourceNodes;
+        TempArray<uint32> midiSourceNodes (arena);
 
-        for (int i = graph.getNumConnections(); --i >= 0;)
+        for (int i = node.inputs.size(); --i >= 0;)
         {
-            const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
+            const AudioProcessorGraph::Connection* const c = node.inputs.getUnchecked (i);
 
-            if (c->destNodeId == node.nodeId && c->destChannelIndex == AudioProcessorGraph::midiChannelIndex)
+            if (c->destChannelIndex == AudioProcessorGraph::midiChannelIndex)
                 midiSourceNodes.add (c->sourceNodeId);
         }
 
@@ -599,7 +1090,7 @@ private:
             // No midi inputs..
             midiBufferToUse = getFreeBuffer (true); // need to pick a buffer even if the processor doesn't use midi
 
-            if (processor.acceptsMidi() || processor.producesMidi())
+            if (node.acceptsMidi || node.producesMidi)
                 renderingOps.add (new ClearMidiBufferOp (midiBufferToUse));
         }
         else if (midiSourceNodes.size() == 1)
@@ -679,41 +1170,45 @@ private:
             }
         }
 
-        if (processor.producesMidi())
+        if (node.producesMidi)
             markBufferAsContaining (midiBufferToUse, node.nodeId,
                                     AudioProcessorGraph::midiChannelIndex);
 
-        setNodeDelay (node.nodeId, maxLatency + processor.getLatencySamples());
+        setNodeDelay (node.nodeId, maxLatency + node.latencySamples);
 
         if (numOuts == 0)
             totalLatency = maxLatency;
 
-        renderingOps.add (new ProcessBufferOp (&node, audioChannelsToUse,
-                                               totalChans, midiBufferToUse));
+        renderingOps.add (new ProcessBufferOp (node.node, silentBuffers, audioChannelsToUse,
+                                               totalChans, numIns, numOuts, midiBufferToUse));
     }
 
     //==============================================================================
+    // Because the nodes are visited in order, and a buffer is only ever added when all the
+    // existing ones are live, this never uses more buffers than the greatest number of
+    // outputs that are live at once. Out of the free ones, the most recently freed buffer is
+    // picked, as it's the one most likely to still be in the cache.
     int getFreeBuffer (const bool forMidi)
     {
-        if (forMidi)
-        {
-            for (int i = 1; i < midiNodeIds.size(); ++i)
-                if (midiNodeIds.getUnchecked(i) == freeNodeID)
-                    return i;
+        auto& ids = forMidi ? midiNodeIds : nodeIds;
+        auto& freedAt = forMidi ? midiFreedAtStep : freedAtStep;
+        int bestIndex = -1;
 
-            midiNodeIds.add ((uint32) freeNodeID);
-            return midiNodeIds.size() - 1;
-        }
-        else
-        {
-            for (int i = 1; i < nodeIds.size(); ++i)
-                if (nodeIds.getUnchecked(i) == freeNodeID)
-                    return i;
+        for (int i = 1; i < ids.size(); ++i)
+            if (ids.getUnchecked(i) == freeNodeID
+                 && (bestIndex < 0 || freedAt.getUnchecked(i) > freedAt.getUnchecked (bestIndex)))
+                bestIndex = i;
 
-            nodeIds.add ((uint32) freeNodeID);
+        if (bestIndex >= 0)
+            return bestIndex;
+
+        ids.add ((uint32) freeNodeID);
+        freedAt.add (0);
+
+        if (! forMidi)
             channels.add (0);
-            return nodeIds.size() - 1;
-        }
+
+        return ids.size() - 1;
     }
 
     int getReadOnlyEmptyBuffer() const noexcept
@@ -721,6 +1216,30 @@ private:
         return 0;
     }
 
+    // returns a free buffer that's reserved until the current node has been rendered
+    int getFreeAnonymousBuffer()
+    {
+        const int bufIndex = getFreeBuffer (false);
+        markBufferAsContaining (bufIndex, static_cast<uint32> (anonymousNodeID), 0);
+        return bufIndex;
+    }
+
+    // Adds the ops that put the output of a source channel, delayed by the given amount,
+    // into a buffer. The first time a source channel is delayed, an op that writes it into
+    // its delay line is added too, and the line is shared by everything that reads it.
+    void addDelayOps (Array<void*>& renderingOps, int sourceBuffer, uint32 sourceNodeId, int sourceChannel,
+                      int destBuffer, uint32 destNodeId, int delay, bool addToDestBuffer)
+    {
+        bool isNewLine;
+        const int lineIndex = delayLines.getLineIndex (sourceNodeId, sourceChannel, isNewLine);
+
+        if (isNewLine)
+            renderingOps.add (new WriteDelayLineOp (delayLines, lineIndex, sourceBuffer));
+
+        renderingOps.add (new ReadDelayLineOp (delayLines, delayLines.addTap (lineIndex, destNodeId, delay),
+                                               silentBuffers, destBuffer, addToDestBuffer));
+    }
+
     int getBufferContaining (const uint32 nodeId, const int outputChannel) const noexcept
     {
         if (outputChannel == AudioProcessorGraph::midiChannelIndex)
@@ -740,27 +1259,26 @@ private:
         return -1;
     }
 
+    // frees the buffers whose contents aren't read by this step or any later one
     void markAnyUnusedBuffersAsFree (const int stepIndex)
     {
         for (int i = 0; i < nodeIds.size(); ++i)
         {
             if (isNodeBusy (nodeIds.getUnchecked(i))
-                 && ! isBufferNeededLater (stepIndex, -1,
-                                           nodeIds.getUnchecked(i),
-                                           channels.getUnchecked(i)))
+                 && getLastUse (nodeIds.getUnchecked(i), channels.getUnchecked(i)) < stepIndex)
             {
                 nodeIds.set (i, (uint32) freeNodeID);
+                freedAtStep.set (i, stepIndex);
             }
         }
 
         for (int i = 0; i < midiNodeIds.size(); ++i)
         {
             if (isNodeBusy (midiNodeIds.getUnchecked(i))
-                 && ! isBufferNeededLater (stepIndex, -1,
-                                           midiNodeIds.getUnchecked(i),
-                                           AudioProcessorGraph::midiChannelIndex))
+                 && getLastUse (midiNodeIds.getUnchecked(i), AudioProcessorGraph::midiChannelIndex) < stepIndex)
             {
                 midiNodeIds.set (i, (uint32) freeNodeID);
+                midiFreedAtStep.set (i, stepIndex);
             }
         }
     }
@@ -770,29 +1288,17 @@ private:
                               const uint32 nodeId,
                               const int outputChanIndex) const
     {
-        while (stepIndexToSearchFrom < orderedNodes.size())
-        {
-            const AudioProcessorGraph::Node* const node = (const AudioProcessorGraph::Node*) orderedNodes.getUnchecked (stepIndexToSearchFrom);
+        const int lastUse = getLastUse (nodeId, outputChanIndex);
 
-            if (outputChanIndex == AudioProcessorGraph::midiChannelIndex)
-            {
-                if (inputChannelOfIndexToIgnore != AudioProcessorGraph::midiChannelIndex
-                     && graph.getConnectionBetween (nodeId, AudioProcessorGraph::midiChannelIndex,
-                                                    node->nodeId, AudioProcessorGraph::midiChannelIndex) != nullptr)
-                    return true;
-            }
-            else
-            {
-                for (int i = 0; i < node->getProcessor()->getTotalNumInputChannels(); ++i)
-                    if (i != inputChannelOfIndexToIgnore
-                         && graph.getConnectionBetween (nodeId, outputChanIndex,
-                                                        node->nodeId, i) != nullptr)
-                        return true;
-            }
+        if (lastUse != stepIndexToSearchFrom)
+            return lastUse > stepIndexToSearchFrom;
 
-            inputChannelOfIndexToIgnore = -1;
-            ++stepIndexToSearchFrom;
-        }
+        // this step is the last one to read it, so it's only needed if another of its inputs does
+        for (auto* c : orderedNodes.getUnchecked (stepIndexToSearchFrom)->inputs)
+            if (c->sourceNodeId == nodeId
+                 && c->sourceChannelIndex == outputChanIndex
+                 && c->destChannelIndex != inputChannelOfIndexToIgnore)
+                return true;
 
         return false;
     }
@@ -822,11 +1328,11 @@ private:
 class ConnectionLookupTable
 {
 public:
-    explicit ConnectionLookupTable (const OwnedArray<AudioProcessorGraph::Connection>& connections)
+    explicit ConnectionLookupTable (const Array<AudioProcessorGraph::Connection>& connections)
     {
         for (int i = 0; i < connections.size(); ++i)
         {
-            const AudioProcessorGraph::Connection* const c = connections.getUnchecked(i);
+            const AudioProcessorGraph::Connection* const c = &connections.getReference (i);
 
             int index;
             Entry* entry = findEntry (c->destNodeId, index);
@@ -947,6 +1453,359 @@ struct ConnectionSorter
     }
 };
 
+//==============================================================================
+/** A version of the rendering sequence which has been split into tasks that can
+    be run concurrently.
+
+    Each task is a ProcessBufferOp together with the clear/copy/mix/delay ops that
+    prepare its input buffers. The dependencies between the tasks are worked out
+    from the buffers that each op reads and writes, so running them in any order
+    that respects those dependencies gives exactly the same result as running the
+    serial sequence.
+*/
+struct ParallelRenderSchedule
+{
+    explicit ParallelRenderSchedule (const Array<void*>& renderingOps)
+    {
+        for (int i = 0; i < renderingOps.size(); ++i)
+        {
+            auto* op = static_cast<AudioGraphRenderingOpBase*> (renderingOps.getUnchecked (i));
+
+            if (tasks.size() == 0 || tasks.getLast()->isComplete)
+                tasks.add (new Task());
+
+            auto& task = *tasks.getLast();
+            task.ops.add (op);
+            task.isComplete = op->isProcessBufferOp();
+        }
+
+        BufferTracker audioTracker, midiTracker, delayLineTracker, outputTracker;
+        Array<SortedSet<int>> dependencies;
+        dependencies.resize (tasks.size());
+
+        for (int taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+        {
+            auto& deps = dependencies.getReference (taskIndex);
+
+            for (auto* op : tasks.getUnchecked (taskIndex)->ops)
+            {
+                BufferUsage usage;
+                op->getBufferUsage (usage);
+
+                for (auto b : usage.audioBuffersRead)       audioTracker.addRead (b, taskIndex, deps);
+                for (auto b : usage.midiBuffersRead)        midiTracker.addRead (b, taskIndex, deps);
+                for (auto b : usage.audioBuffersWritten)    audioTracker.addWrite (b, taskIndex, deps);
+                for (auto b : usage.midiBuffersWritten)     midiTracker.addWrite (b, taskIndex, deps);
+                for (auto l : usage.delayLinesRead)         delayLineTracker.addRead (l, taskIndex, deps);
+                for (auto l : usage.delayLinesWritten)      delayLineTracker.addWrite (l, taskIndex, deps);
+
+                if (usage.writesToGraphOutput)
+                    outputTracker.addWrite (0, taskIndex, deps);
+            }
+        }
+
+        for (int taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+        {
+            auto& deps = dependencies.getReference (taskIndex);
+            auto& task = *tasks.getUnchecked (taskIndex);
+            task.numDependencies = deps.size();
+
+            for (auto dep : deps)
+                tasks.getUnchecked (dep)->dependents.add (taskIndex);
+        }
+    }
+
+    /** Must be called before each block (before any threads can see it). */
+    void reset() noexcept
+    {
+        for (auto* task : tasks)
+        {
+            task->pendingDependencies = task->numDependencies;
+            task->claimed = 0;
+        }
+
+        numTasksRemaining = tasks.size();
+    }
+
+    /** Finds a task whose inputs are ready, and runs it. Returns false if there
+        was nothing that could be run yet.
+    */
+    template <typename FloatType>
+    bool runNextTask (AudioBuffer<FloatType>& sharedBufferChans,
+                      const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                      const int numSamples) noexcept
+    {
+        for (int i = 0; i < tasks.size(); ++i)
+        {
+            auto& task = *tasks.getUnchecked (i);
+
+            if (task.pendingDependencies.get() == 0 && task.claimed.compareAndSetBool (1, 0))
+            {
+                for (auto* op : task.ops)
+                    op->perform (sharedBufferChans, sharedMidiBuffers, numSamples);
+
+                for (auto dependent : task.dependents)
+                    --(tasks.getUnchecked (dependent)->pendingDependencies);
+
+                --numTasksRemaining;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool isFinished() const noexcept      { return numTasksRemaining.get() <= 0; }
+
+private:
+    struct Task
+    {
+        Array<AudioGraphRenderingOpBase*> ops;
+        Array<int> dependents;
+        int numDependencies = 0;
+        bool isComplete = false;
+
+        Atomic<int> pendingDependencies, claimed;
+    };
+
+    // Keeps track of which tasks have touched each buffer, so that a task which
+    // writes a buffer waits for earlier readers and writers, and a task which reads
+    // a buffer waits for its last writer.
+    struct BufferTracker
+    {
+        void addRead (int buffer, int taskIndex, SortedSet<int>& deps)
+        {
+            auto& state = getState (buffer);
+
+            if (state.lastWriter >= 0 && state.lastWriter != taskIndex)
+                deps.add (state.lastWriter);
+
+            state.readers.addIfNotAlreadyThere (taskIndex);
+        }
+
+        void addWrite (int buffer, int taskIndex, SortedSet<int>& deps)
+        {
+            auto& state = getState (buffer);
+
+            if (state.lastWriter >= 0 && state.lastWriter != taskIndex)
+                deps.add (state.lastWriter);
+
+            for (auto reader : state.readers)
+                if (reader != taskIndex)
+                    deps.add (reader);
+
+            state.lastWriter = taskIndex;
+            state.readers.clearQuick();
+        }
+
+    private:
+        struct State
+        {
+            int lastWriter = -1;
+            Array<int> readers;
+        };
+
+        OwnedArray<State> states;
+
+        State& getState (int buffer)
+        {
+            jassert (buffer >= 0);
+
+            while (states.size() <= buffer)
+                states.add (new State());
+
+            return *states.getUnchecked (buffer);
+        }
+    };
+
+    OwnedArray<Task> tasks;
+    Atomic<int> numTasksRemaining;
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelRenderSchedule)
+};
+
+//==============================================================================
+/** Everything that the audio thread needs in order to render one version of the
+    graph: the ops, the shared buffers they work on, and an optional parallel schedule.
+
+    These are built away from the audio thread, handed over to it with an atomic
+    pointer swap, and then handed back again to be deleted once they've been replaced.
+*/
+struct RenderSequence
+{
+    RenderSequence() {}
+
+    ~RenderSequence()
+    {
+        schedule = nullptr;
+
+        for (int i = ops.size(); --i >= 0;)
+            delete static_cast<AudioGraphRenderingOpBase*> (ops.getUnchecked (i));
+    }
+
+    template <typename FloatType>
+    void perform (const int numSamples) noexcept
+    {
+        auto& buffers = renderingBuffers.get<FloatType>();
+
+        for (int i = 0; i < ops.size(); ++i)
+            static_cast<AudioGraphRenderingOpBase*> (ops.getUnchecked (i))->perform (buffers, midiBuffers, numSamples);
+    }
+
+    /** Recalculates the latency compensation delays from the current latencies of the
+        nodes' processors, and sets the delay line taps to match them. If the new delays
+        need taps that don't exist, or are longer than the lines can hold, this returns
+        false without changing anything, and the sequence needs to be rebuilt.
+    */
+    bool updateLatencies (int& newTotalLatency)
+    {
+        HashMap<uint32, int> nodeDelays;
+        Array<int> newTapDelays;
+        newTapDelays.insertMultiple (0, 0, delayLines.taps.size());
+        newTotalLatency = 0;
+
+        for (auto* info : orderedNodes)
+        {
+            int maxLatency = 0;
+
+            for (auto* c : info->inputs)
+                maxLatency = jmax (maxLatency, nodeDelays[c->sourceNodeId]);
+
+            for (auto* c : info->inputs)
+            {
+                if (c->destChannelIndex == AudioProcessorGraph::midiChannelIndex)
+                    continue;
+
+                const int delay = maxLatency - nodeDelays[c->sourceNodeId];
+                bool hasTap = false;
+
+                for (int i = 0; i < delayLines.taps.size(); ++i)
+                {
+                    auto& tap = *delayLines.taps.getUnchecked (i);
+                    auto& line = *delayLines.lines.getUnchecked (tap.lineIndex);
+
+                    if (tap.destNodeId == info->nodeId
+                         && line.sourceNodeId == c->sourceNodeId
+                         && line.sourceChannel == c->sourceChannelIndex)
+                    {
+                        if (delay > delayLines.getMaxDelay (line))
+                            return false;
+
+                        newTapDelays.set (i, delay);
+                        hasTap = true;
+                    }
+                }
+
+                if (delay > 0 && ! hasTap)
+                    return false;
+            }
+
+            nodeDelays.set (info->nodeId, maxLatency + info->node->getProcessor()->getLatencySamples());
+
+            if (info->numOuts == 0)
+                newTotalLatency = maxLatency;
+        }
+
+        for (int i = 0; i < newTapDelays.size(); ++i)
+            delayLines.taps.getUnchecked (i)->delay = newTapDelays.getUnchecked (i);
+
+        latencySamples = newTotalLatency;
+        return true;
+    }
+
+    Array<void*> ops;
+    ScopedPointer<ParallelRenderSchedule> schedule;
+    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder> > renderingBuffers;
+    OwnedArray<MidiBuffer> midiBuffers;
+    DelayLinePool delayLines;
+    SilentBufferFlags silentBuffers;
+    int latencySamples = 0;
+
+    // keeps the nodes alive for as long as this sequence might be used
+    ScopedPointer<GraphSnapshot> snapshot;
+    Array<GraphSnapshot::NodeInfo*> orderedNodes;
+    RenderSequence* nextRetired = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (RenderSequence)
+};
+
+//==============================================================================
+/** Works out the order in which the nodes must be rendered.
+
+    Most edits to a graph don't break the order that was used for the last build
+    (removing nodes or connections never does, and nor does adding a connection that
+    runs forwards through it), so the last order is kept and just checked against the
+    new connections, and a full re-sort is only done when that check fails.
+*/
+struct NodeOrderer
+{
+    Array<GraphSnapshot::NodeInfo*> getOrderedNodes (const GraphSnapshot& snapshot)
+    {
+        Array<GraphSnapshot::NodeInfo*> orderedNodes;
+        HashMap<uint32, int> positions;
+
+        for (auto nodeId : lastOrder)
+        {
+            if (auto* n = snapshot.getNodeForId (nodeId))
+            {
+                positions.set (nodeId, orderedNodes.size());
+                orderedNodes.add (n);
+            }
+        }
+
+        for (auto* n : snapshot.nodes)
+        {
+            if (! positions.contains (n->nodeId))
+            {
+                positions.set (n->nodeId, orderedNodes.size());
+                orderedNodes.add (n);
+            }
+        }
+
+        if (! isValidOrder (snapshot, positions))
+            orderedNodes = sortNodes (snapshot);
+
+        lastOrder.clearQuick();
+
+        for (auto* n : orderedNodes)
+            lastOrder.add (n->nodeId);
+
+        return orderedNodes;
+    }
+
+private:
+    Array<uint32> lastOrder;
+
+    static bool isValidOrder (const GraphSnapshot& snapshot, const HashMap<uint32, int>& positions)
+    {
+        for (auto& c : snapshot.connections)
+            if (positions.contains (c.sourceNodeId) && positions.contains (c.destNodeId)
+                 && positions[c.sourceNodeId] >= positions[c.destNodeId])
+                return false;
+
+        return true;
+    }
+
+    static Array<GraphSnapshot::NodeInfo*> sortNodes (const GraphSnapshot& snapshot)
+    {
+        Array<GraphSnapshot::NodeInfo*> orderedNodes;
+        const ConnectionLookupTable table (snapshot.connections);
+
+        for (auto* node : snapshot.nodes)
+        {
+            int j = 0;
+
+            for (; j < orderedNodes.size(); ++j)
+                if (table.isAnInputTo (node->nodeId, orderedNodes.getUnchecked (j)->nodeId))
+                    break;
+
+            orderedNodes.insert (j, node);
+        }
+
+        return orderedNodes;
+    }
+};
+
 }
 
 //==============================================================================
@@ -1006,39 +1865,427 @@ struct AudioProcessorGraph::AudioProcessorGraphBufferHelpers
         currentAudioInputBuffer.doubleVersion = nullptr;
     }
 
-    void setRenderingBufferSize (int newNumChannels, int newNumSamples)
-    {
-        renderingBuffers.floatVersion. setSize (newNumChannels, newNumSamples);
-        renderingBuffers.doubleVersion.setSize (newNumChannels, newNumSamples);
+    void release()
+    {
+        currentAudioInputBuffer.floatVersion  = nullptr;
+        currentAudioInputBuffer.doubleVersion = nullptr;
+
+        currentAudioOutputBuffer.floatVersion. setSize (1, 1);
+        currentAudioOutputBuffer.doubleVersion.setSize (1, 1);
+    }
+
+    void prepareInOutBuffers(int newNumChannels, int newNumSamples)
+    {
+        currentAudioInputBuffer.floatVersion  = nullptr;
+        currentAudioInputBuffer.doubleVersion = nullptr;
+
+        currentAudioOutputBuffer.floatVersion. setSize (newNumChannels, newNumSamples);
+        currentAudioOutputBuffer.doubleVersion.setSize (newNumChannels, newNumSamples);
+    }
+
+    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder>*> currentAudioInputBuffer;
+    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder> > currentAudioOutputBuffer;
+};
+
+//==============================================================================
+/** Owns the worker threads used for multi-threaded rendering, and hands out the
+    tasks of the current ParallelRenderSchedule to them during each block.
+
+    The audio thread publishes a block by bumping currentBlock, and then helps to
+    run the tasks itself. Once they've all been done it clears currentBlock and spins
+    until every worker has left the block, so nothing can touch the schedule or the
+    shared buffers after the callback returns. None of this allocates or locks: the
+    only system call involved is waking a worker that has gone to sleep because the
+    graph had been idle for a while.
+*/
+struct AudioProcessorGraph::ParallelRenderer
+{
+    ParallelRenderer (int numWorkerThreads, const Thread::RealtimeOptions& options)
+    {
+        for (int i = 0; i < numWorkerThreads; ++i)
+        {
+            auto* worker = new WorkerThread (*this, i);
+            workers.add (worker);
+            worker->startRealtimeThread (options);
+        }
+    }
+
+    ~ParallelRenderer()
+    {
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto* worker : workers)
+            worker->notify();
+
+        for (auto* worker : workers)
+            worker->stopThread (2000);
+    }
+
+    int getNumWorkerThreads() const noexcept        { return workers.size(); }
+
+    template <typename FloatType>
+    void perform (GraphRenderingOps::ParallelRenderSchedule& scheduleToUse,
+                  AudioBuffer<FloatType>& sharedBufferChans,
+                  const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                  const int numSamples) noexcept
+    {
+        schedule = &scheduleToUse;
+        schedule->reset();
+        setCurrentBlock (sharedBufferChans, sharedMidiBuffers, numSamples);
+
+        if (++lastBlockId <= 0)
+            lastBlockId = 1;
+
+        currentBlock = lastBlockId;
+
+        for (auto* worker : workers)
+            if (worker->isSleeping.get() != 0)
+                worker->notify();
+
+        while (! schedule->isFinished())
+            if (! schedule->runNextTask (sharedBufferChans, sharedMidiBuffers, numSamples))
+                pause();
+
+        currentBlock = 0;
+
+        while (numActiveWorkers.get() > 0)
+            pause();
+
+        schedule = nullptr;
+    }
+
+private:
+    //==============================================================================
+    struct WorkerThread  : public Thread
+    {
+        WorkerThread (ParallelRenderer& r, int index)
+            : Thread ("Graph Render Thread " + String (index + 1)), owner (r)
+        {
+        }
+
+        void run() override
+        {
+            FloatVectorOperations::disableDenormalisedNumberSupport();
+
+            int lastBlockId = 0;
+            uint32 lastActiveTime = Time::getMillisecondCounter();
+
+            while (! threadShouldExit())
+            {
+                if (owner.contributeToCurrentBlock (lastBlockId))
+                {
+                    lastActiveTime = Time::getMillisecondCounter();
+                }
+                else if (Time::getMillisecondCounter() - lastActiveTime < maxSpinTimeMs)
+                {
+                    yield();
+                }
+                else
+                {
+                    // go to sleep until the audio thread wakes us up, re-checking for
+                    // a block after setting the flag so that a wake-up can't be missed
+                    isSleeping = 1;
+
+                    if (! owner.isBlockAvailable (lastBlockId))
+                        wait (100);
+
+                    isSleeping = 0;
+                    lastActiveTime = Time::getMillisecondCounter();
+                }
+            }
+        }
+
+        ParallelRenderer& owner;
+        Atomic<int> isSleeping;
+
+        enum { maxSpinTimeMs = 20 };
+
+        JUCE_DECLARE_NON_COPYABLE (WorkerThread)
+    };
+
+    OwnedArray<WorkerThread> workers;
+    GraphRenderingOps::ParallelRenderSchedule* schedule = nullptr;
+
+    Atomic<int> currentBlock, numActiveWorkers;
+    int lastBlockId = 0;
+
+    // details of the block that's currently being rendered
+    void* currentAudioBuffer = nullptr;
+    bool currentBlockIsDouble = false;
+    const OwnedArray<MidiBuffer>* currentMidiBuffers = nullptr;
+    int currentNumSamples = 0;
+
+    void setCurrentBlock (AudioBuffer<float>& buffer, const OwnedArray<MidiBuffer>& midi, int numSamples) noexcept
+    {
+        currentAudioBuffer = &buffer;
+        currentBlockIsDouble = false;
+        currentMidiBuffers = &midi;
+        currentNumSamples = numSamples;
+    }
+
+    void setCurrentBlock (AudioBuffer<double>& buffer, const OwnedArray<MidiBuffer>& midi, int numSamples) noexcept
+    {
+        currentAudioBuffer = &buffer;
+        currentBlockIsDouble = true;
+        currentMidiBuffers = &midi;
+        currentNumSamples = numSamples;
+    }
+
+    bool isBlockAvailable (int lastBlockSeen) const noexcept
+    {
+        const int blockId = currentBlock.get();
+        return blockId != 0 && blockId != lastBlockSeen;
+    }
+
+    bool contributeToCurrentBlock (int& lastBlockSeen) noexcept
+    {
+        const int blockId = currentBlock.get();
+
+        if (blockId == 0 || blockId == lastBlockSeen)
+            return false;
+
+        ++numActiveWorkers;
+
+        // the audio thread may have finished this block before we registered, in
+        // which case none of the block's state can be used any more
+        if (currentBlock.get() == blockId)
+        {
+            JUCE_REALTIME_CONTEXT;
+            lastBlockSeen = blockId;
+
+            while (! schedule->isFinished())
+            {
+                const bool didRunTask = currentBlockIsDouble
+                    ? schedule->runNextTask (*static_cast<AudioBuffer<double>*> (currentAudioBuffer), *currentMidiBuffers, currentNumSamples)
+                    : schedule->runNextTask (*static_cast<AudioBuffer<float>*>  (currentAudioBuffer), *currentMidiBuffers, currentNumSamples);
+
+                if (! didRunTask)
+                    pause();
+            }
+        }
+
+        --numActiveWorkers;
+        return true;
+    }
+
+    static void pause() noexcept
+    {
+        Thread::yield();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelRenderer)
+};
+
+//==============================================================================
+/** Builds new rendering sequences, either synchronously or on a background thread,
+    and manages handing them over to the audio thread.
+
+    A sequence that's been built in the background is published by swapping it into
+    pendingSequence, where the audio thread will pick it up at the start of its next
+    block. The audio thread then pushes the sequence that it was using onto a lock-free
+    list of retired sequences, which get deleted later on the message thread. (They
+    can't be deleted on the builder thread, as they may hold the last reference to a
+    node that has been removed, and processors need to be deleted on the message thread).
+*/
+struct AudioProcessorGraph::RenderSequenceBuilder  : private Thread
+{
+    RenderSequenceBuilder (AudioProcessorGraph& g)  : Thread ("Graph Builder"), graph (g)
+    {
+    }
+
+    ~RenderSequenceBuilder()
+    {
+        stopThread (4000);
+
+        delete pendingSequence.exchange (nullptr);
+        deleteRetiredSequences();
+    }
+
+    //==============================================================================
+    /** Builds a sequence on the calling thread, cancelling any background builds. */
+    GraphRenderingOps::RenderSequence* buildNow (GraphRenderingOps::GraphSnapshot* snapshot)
+    {
+        cancelPendingBuilds();
+
+        const ScopedLock sl (buildLock);
+        return build (snapshot);
+    }
+
+    /** Asks the background thread to build a sequence for the given snapshot. If a
+        previous request hasn't been started yet, it gets replaced by this one. */
+    void buildInBackground (GraphRenderingOps::GraphSnapshot* snapshot)
+    {
+        {
+            const ScopedLock sl (requestLock);
+            requestedSnapshot = snapshot;
+        }
+
+        if (! isThreadRunning())
+            startThread (3);
+
+        notify();
+    }
+
+    void cancelPendingBuilds()
+    {
+        const ScopedLock sl (requestLock);
+        requestedSnapshot = nullptr;
+        ++buildGeneration;
+    }
+
+    /** Returns the latency of the most recently published sequence, or -1. */
+    int getPublishedLatency() const noexcept        { return publishedLatency.get(); }
+
+    /** Returns true if a sequence is waiting to be built, being built, or waiting for
+        the audio thread to pick it up. */
+    bool hasPendingBuild()
+    {
+        const ScopedLock sl (requestLock);
+        return requestedSnapshot != nullptr || isBuilding || pendingSequence.get() != nullptr;
+    }
+
+    //==============================================================================
+    /** Called by the audio thread (or with the callback lock held) to take any new
+        sequence that's been built. */
+    GraphRenderingOps::RenderSequence* takePendingSequence() noexcept
+    {
+        return pendingSequence.get() != nullptr ? pendingSequence.exchange (nullptr) : nullptr;
+    }
+
+    /** Called by the audio thread to hand back a sequence that it's finished with. */
+    void retire (GraphRenderingOps::RenderSequence* sequence) noexcept
+    {
+        for (;;)
+        {
+            auto* head = retiredSequences.get();
+            sequence->nextRetired = head;
+
+            if (retiredSequences.compareAndSetBool (sequence, head))
+                break;
+        }
+    }
+
+    /** Deletes any sequences that are no longer in use. Must be called on the message thread. */
+    void deleteRetiredSequences()
+    {
+        OwnedArray<GraphRenderingOps::RenderSequence> toDelete;
+
+        {
+            const ScopedLock sl (requestLock);
+            toDelete.swapWith (unusedSequences);
+        }
+
+        for (auto* s = retiredSequences.exchange (nullptr); s != nullptr;)
+        {
+            auto* next = s->nextRetired;
+            toDelete.add (s);
+            s = next;
+        }
+    }
+
+private:
+    //==============================================================================
+    AudioProcessorGraph& graph;
+    GraphRenderingOps::NodeOrderer orderer;
+    CriticalSection buildLock, requestLock;
+    ScopedPointer<GraphRenderingOps::GraphSnapshot> requestedSnapshot;
+    OwnedArray<GraphRenderingOps::RenderSequence> unusedSequences;
+    int buildGeneration = 0;
+    bool isBuilding = false;
+
+    Atomic<GraphRenderingOps::RenderSequence*> pendingSequence, retiredSequences;
+    Atomic<int> publishedLatency { -1 };
+
+    GraphRenderingOps::RenderSequence* build (GraphRenderingOps::GraphSnapshot* snapshot)
+    {
+        ScopedPointer<GraphRenderingOps::RenderSequence> sequence (new GraphRenderingOps::RenderSequence());
+        sequence->snapshot = snapshot;
+
+        sequence->orderedNodes = orderer.getOrderedNodes (*snapshot);
+
+        GraphRenderingOps::RenderingOpSequenceCalculator calculator (*snapshot, sequence->orderedNodes,
+                                                                     sequence->ops, sequence->delayLines,
+                                                                     sequence->silentBuffers);
+
+        sequence->delayLines.allocate (snapshot->blockSize, snapshot->useDoublePrecision);
+
+        if (snapshot->buildParallelSchedule)
+            sequence->schedule = new GraphRenderingOps::ParallelRenderSchedule (sequence->ops);
+
+        const int numBuffers = calculator.getNumBuffersNeeded();
+
+        sequence->renderingBuffers.floatVersion. setSize (numBuffers, snapshot->blockSize);
+        sequence->renderingBuffers.doubleVersion.setSize (numBuffers, snapshot->blockSize);
+        sequence->renderingBuffers.floatVersion. clear();
+        sequence->renderingBuffers.doubleVersion.clear();
+        sequence->silentBuffers.allocate (numBuffers);
+
+        for (int i = calculator.getNumMidiBuffersNeeded(); --i >= 0;)
+            sequence->midiBuffers.add (new MidiBuffer());
+
+        sequence->latencySamples = calculator.getTotalLatencySamples();
+        return sequence.release();
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            ScopedPointer<GraphRenderingOps::GraphSnapshot> snapshot;
+            int generation;
+
+            {
+                const ScopedLock sl (requestLock);
+                snapshot = requestedSnapshot.release();
+                generation = buildGeneration;
+                isBuilding = (snapshot != nullptr);
+            }
+
+            if (snapshot != nullptr)
+            {
+                ScopedPointer<GraphRenderingOps::RenderSequence> sequence;
 
-        renderingBuffers.floatVersion. clear();
-        renderingBuffers.doubleVersion.clear();
-    }
+                {
+                    const ScopedLock sl (buildLock);
+                    sequence = build (snapshot.release());
+                }
 
-    void release()
-    {
-        renderingBuffers.floatVersion. setSize (1, 1);
-        renderingBuffers.doubleVersion.setSize (1, 1);
+                const int latency = sequence->latencySamples;
 
-        currentAudioInputBuffer.floatVersion  = nullptr;
-        currentAudioInputBuffer.doubleVersion = nullptr;
+                {
+                    const ScopedLock sl (requestLock);
+                    isBuilding = false;
 
-        currentAudioOutputBuffer.floatVersion. setSize (1, 1);
-        currentAudioOutputBuffer.doubleVersion.setSize (1, 1);
-    }
+                    if (generation == buildGeneration)
+                    {
+                        // if the audio thread never saw the last one, it can just be thrown away
+                        if (auto* unused = pendingSequence.exchange (sequence.release()))
+                            unusedSequences.add (unused);
 
-    void prepareInOutBuffers(int newNumChannels, int newNumSamples)
-    {
-        currentAudioInputBuffer.floatVersion  = nullptr;
-        currentAudioInputBuffer.doubleVersion = nullptr;
+                        publishedLatency = latency;
+                    }
+                    else
+                    {
+                        // a synchronous build has happened since this was requested
+                        unusedSequences.add (sequence.release());
+                    }
+                }
 
-        currentAudioOutputBuffer.floatVersion. setSize (newNumChannels, newNumSamples);
-        currentAudioOutputBuffer.doubleVersion.setSize (newNumChannels, newNumSamples);
+                graph.triggerAsyncUpdate();
+            }
+            else if (retiredSequences.get() != nullptr)
+            {
+                graph.triggerAsyncUpdate();
+            }
+
+            // while a sequence is waiting to be picked up, keep checking for the old
+            // one being retired so that it can be deleted
+            wait (pendingSequence.get() != nullptr || retiredSequences.get() != nullptr ? 50 : -1);
+        }
     }
 
-    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder> > renderingBuffers;
-    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder>*> currentAudioInputBuffer;
-    FloatAndDoubleComposition<AudioBuffer<FloatPlaceholder> > currentAudioOutputBuffer;
+    JUCE_DECLARE_NON_COPYABLE (RenderSequenceBuilder)
 };
 
 //==============================================================================
@@ -1046,11 +2293,15 @@ AudioProcessorGraph::AudioProcessorGraph()
     : lastNodeId (0), audioBuffers (new AudioProcessorGraphBufferHelpers),
       currentMidiInputBuffer (nullptr), isPrepared (false)
 {
+    builder = new RenderSequenceBuilder (*this);
 }
 
 AudioProcessorGraph::~AudioProcessorGraph()
 {
+    cancelPendingUpdate();
+    setNumWorkerThreads (0);
     clearRenderingSequence();
+    builder = nullptr;
     clear();
 }
 
@@ -1064,7 +2315,7 @@ void AudioProcessorGraph::clear()
 {
     nodes.clear();
     connections.clear();
-    triggerAsyncUpdate();
+    topologyChanged();
 }
 
 AudioProcessorGraph::Node* AudioProcessorGraph::getNodeForId (const uint32 nodeId) const
@@ -1113,7 +2364,7 @@ AudioProcessorGraph::Node* AudioProcessorGraph::addNode (AudioProcessor* const n
     nodes.add (n);
 
     if (isPrepared)
-        triggerAsyncUpdate();
+        topologyChanged();
 
     n->setParentGraph (this);
     return n;
@@ -1130,7 +2381,7 @@ bool AudioProcessorGraph::removeNode (const uint32 nodeId)
             nodes.remove (i);
 
             if (isPrepared)
-                triggerAsyncUpdate();
+                topologyChanged();
 
             return true;
         }
@@ -1218,7 +2469,7 @@ bool AudioProcessorGraph::addConnection (const uint32 sourceNodeId,
                                                    destNodeId, destChannelIndex));
 
     if (isPrepared)
-        triggerAsyncUpdate();
+        topologyChanged();
 
     return true;
 }
@@ -1228,7 +2479,7 @@ void AudioProcessorGraph::removeConnection (const int index)
     connections.remove (index);
 
     if (isPrepared)
-        triggerAsyncUpdate();
+        topologyChanged();
 }
 
 bool AudioProcessorGraph::removeConnection (const uint32 sourceNodeId, const int sourceChannelIndex,
@@ -1303,22 +2554,65 @@ bool AudioProcessorGraph::removeIllegalConnections()
 }
 
 //==============================================================================
-static void deleteRenderOpArray (Array<void*>& ops)
+void AudioProcessorGraph::topologyChanged()
+{
+    needsRebuild = true;
+    triggerAsyncUpdate();
+}
+
+void AudioProcessorGraph::swapRenderSequence (GraphRenderingOps::RenderSequence* newSequence)
 {
-    for (int i = ops.size(); --i >= 0;)
-        delete static_cast<GraphRenderingOps::AudioGraphRenderingOpBase*> (ops.getUnchecked(i));
+    ScopedPointer<GraphRenderingOps::RenderSequence> oldSequence, unusedSequence;
+
+    {
+        const ScopedLock sl (getCallbackLock());
+        unusedSequence = builder->takePendingSequence();
+        oldSequence = currentSequence;
+        currentSequence = newSequence;
+    }
 }
 
 void AudioProcessorGraph::clearRenderingSequence()
 {
-    Array<void*> oldOps;
+    builder->cancelPendingBuilds();
+    swapRenderSequence (nullptr);
+    builder->deleteRetiredSequences();
+}
+
+void AudioProcessorGraph::setNumWorkerThreads (int numWorkerThreads)
+{
+    // the audio thread does its share of the work too, so there's no point in
+    // having more workers than there are other cores for them to run on
+    numWorkerThreads = jlimit (0, jmax (0, SystemStats::getNumCpus() - 1), numWorkerThreads);
+
+    if (numWorkerThreads == getNumWorkerThreads())
+        return;
+
+    // the workers share the audio thread's deadline, so they're given the same kind of
+    // realtime scheduling that the audio thread would get for the current block size
+    auto options = Thread::RealtimeOptions().withPriority (9);
+
+    if (getSampleRate() > 0 && getBlockSize() > 0)
+        options = options.withApproximateAudioProcessingTime (getBlockSize(), getSampleRate());
+
+    ScopedPointer<ParallelRenderer> newRenderer (numWorkerThreads > 0 ? new ParallelRenderer (numWorkerThreads, options)
+                                                                      : nullptr);
 
     {
         const ScopedLock sl (getCallbackLock());
-        renderingOps.swapWith (oldOps);
+        parallelRenderer.swapWith (newRenderer);
     }
 
-    deleteRenderOpArray (oldOps);
+    newRenderer = nullptr;
+
+    // until the sequence has been rebuilt with a parallel schedule, it'll be rendered serially
+    if (isPrepared)
+        topologyChanged();
+}
+
+int AudioProcessorGraph::getNumWorkerThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumWorkerThreads() : 0;
 }
 
 bool AudioProcessorGraph::isAnInputTo (const uint32 possibleInputId,
@@ -1341,63 +2635,73 @@ bool AudioProcessorGraph::isAnInputTo (const uint32 possibleInputId,
     return false;
 }
 
-void AudioProcessorGraph::buildRenderingSequence()
+void AudioProcessorGraph::buildRenderingSequence (const bool buildInBackground)
 {
-    Array<void*> newRenderingOps;
-    int numRenderingBuffersNeeded = 2;
-    int numMidiBuffersNeeded = 1;
+    ScopedPointer<GraphRenderingOps::GraphSnapshot> snapshot;
 
     {
         MessageManagerLock mml;
 
-        Array<Node*> orderedNodes;
-
-        {
-            const GraphRenderingOps::ConnectionLookupTable table (connections);
+        for (int i = 0; i < nodes.size(); ++i)
+            nodes.getUnchecked(i)->prepare (getSampleRate(), getBlockSize(), this, getProcessingPrecision());
 
-            for (int i = 0; i < nodes.size(); ++i)
-            {
-                Node* const node = nodes.getUnchecked(i);
+        snapshot = new GraphRenderingOps::GraphSnapshot (nodes, connections, getBlockSize(),
+                                                         parallelRenderer != nullptr,
+                                                         getProcessingPrecision() == doublePrecision);
+    }
 
-                node->prepare (getSampleRate(), getBlockSize(), this, getProcessingPrecision());
+    if (buildInBackground)
+    {
+        // the new sequence will be picked up by the audio thread when it's ready
+        builder->buildInBackground (snapshot.release());
+        return;
+    }
 
-                int j = 0;
-                for (; j < orderedNodes.size(); ++j)
-                    if (table.isAnInputTo (node->nodeId, ((Node*) orderedNodes.getUnchecked(j))->nodeId))
-                      break;
+    ScopedPointer<GraphRenderingOps::RenderSequence> newSequence (builder->buildNow (snapshot.release()));
+    setLatencySamples (newSequence->latencySamples);
+    swapRenderSequence (newSequence.release());
+}
 
-                orderedNodes.insert (j, node);
-            }
-        }
+void AudioProcessorGraph::handleAsyncUpdate()
+{
+    if (needsRebuild)
+    {
+        needsRebuild = false;
+        buildRenderingSequence (true);
+    }
 
-        GraphRenderingOps::RenderingOpSequenceCalculator calculator (*this, orderedNodes, newRenderingOps);
+    const int latency = builder->getPublishedLatency();
 
-        numRenderingBuffersNeeded = calculator.getNumBuffersNeeded();
-        numMidiBuffersNeeded = calculator.getNumMidiBuffersNeeded();
-    }
+    if (latency >= 0 && latency != getLatencySamples())
+        setLatencySamples (latency);
 
-    {
-        // swap over to the new rendering sequence..
-        const ScopedLock sl (getCallbackLock());
+    builder->deleteRetiredSequences();
+}
 
-        audioBuffers->setRenderingBufferSize (numRenderingBuffersNeeded, getBlockSize());
+void AudioProcessorGraph::updateLatencyCompensation()
+{
+    if (! isPrepared)
+        return;
 
-        for (int i = midiBuffers.size(); --i >= 0;)
-            midiBuffers.getUnchecked(i)->clear();
+    int newLatency = 0;
+    bool updated = false;
 
-        while (midiBuffers.size() < numMidiBuffersNeeded)
-            midiBuffers.add (new MidiBuffer());
+    {
+        const ScopedLock sl (getCallbackLock());
 
-        renderingOps.swapWith (newRenderingOps);
+        // a sequence that hasn't been picked up yet may have been built from older latencies
+        if (currentSequence != nullptr && ! builder->hasPendingBuild())
+            updated = currentSequence->updateLatencies (newLatency);
     }
 
-    // delete the old ones..
-    deleteRenderOpArray (newRenderingOps);
-}
+    if (! updated)
+    {
+        topologyChanged();
+        return;
+    }
 
-void AudioProcessorGraph::handleAsyncUpdate()
-{
-    buildRenderingSequence();
+    if (newLatency != getLatencySamples())
+        setLatencySamples (newLatency);
 }
 
 //==============================================================================
@@ -1409,7 +2713,7 @@ void AudioProcessorGraph::prepareToPlay (double /*sampleRate*/, int estimatedSam
     currentMidiOutputBuffer.clear();
 
     clearRenderingSequence();
-    buildRenderingSequence();
+    buildRenderingSequence (false);
 
     isPrepared = true;
 }
@@ -1423,11 +2727,12 @@ void AudioProcessorGraph::releaseResources()
 {
     isPrepared = false;
 
+    clearRenderingSequence();
+
     for (int i = 0; i < nodes.size(); ++i)
         nodes.getUnchecked(i)->unprepare();
 
     audioBuffers->release();
-    midiBuffers.clear();
 
     currentMidiInputBuffer = nullptr;
     currentMidiOutputBuffer.clear();
@@ -1464,7 +2769,8 @@ void AudioProcessorGraph::setPlayHead (AudioPlayHead* audioPlayHead)
 template <typename FloatType>
 void AudioProcessorGraph::processAudio (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages)
 {
-    AudioBuffer<FloatType>&  renderingBuffers         = audioBuffers->renderingBuffers.get<FloatType>();
+    JUCE_TRACE_ZONE ("AudioProcessorGraph");
+
     AudioBuffer<FloatType>*& currentAudioInputBuffer  = audioBuffers->currentAudioInputBuffer.get<FloatType>();
     AudioBuffer<FloatType>&  currentAudioOutputBuffer = audioBuffers->currentAudioOutputBuffer.get<FloatType>();
 
@@ -1477,12 +2783,22 @@ void AudioProcessorGraph::processAudio (AudioBuffer<FloatType>& buffer, MidiBuff
     currentMidiInputBuffer = &midiMessages;
     currentMidiOutputBuffer.clear();
 
-    for (int i = 0; i < renderingOps.size(); ++i)
+    // pick up any new sequence that has been built since the last block
+    if (auto* newSequence = builder->takePendingSequence())
     {
-        GraphRenderingOps::AudioGraphRenderingOpBase* const op
-            = (GraphRenderingOps::AudioGraphRenderingOpBase*) renderingOps.getUnchecked(i);
+        if (currentSequence != nullptr)
+            builder->retire (currentSequence);
+
+        currentSequence = newSequence;
+    }
 
-        op->perform (renderingBuffers, midiBuffers, numSamples);
+    if (auto* sequence = currentSequence)
+    {
+        if (parallelRenderer != nullptr && sequence->schedule != nullptr)
+            parallelRenderer->perform (*sequence->schedule, sequence->renderingBuffers.get<FloatType>(),
+                                       sequence->midiBuffers, numSamples);
+        else
+            sequence->perform<FloatType> (numSamples);
     }
 
     for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -1697,4 +3013,393 @@ void AudioProcessorGraph::AudioGraphIOProcessor::setParentGraph (AudioProcessorG
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorGraphTests  : public UnitTest
+{
+public:
+    AudioProcessorGraphTests() : UnitTest ("AudioProcessorGraph", "Audio Processors") {}
+
+    void runTest() override
+    {
+        // the graph needs a message manager to prepare its nodes and deliver its async
+        // updates, and a console test runner won't have created one
+        MessageManager::getInstance();
+
+        beginTest ("Parallel rendering matches serial rendering");
+        {
+            Atomic<int> numLiveProcessors;
+            AudioProcessorGraph serial, parallel;
+
+            parallel.setNumWorkerThreads (numWorkerThreads);
+            expectEquals (parallel.getNumWorkerThreads(), getExpectedNumWorkers (numWorkerThreads));
+
+            if (parallel.getNumWorkerThreads() == 0)
+                logMessage ("Only one CPU is available, so both graphs will be rendered serially");
+
+            buildBranchedGraph (serial,   numLiveProcessors, 7);
+            buildBranchedGraph (parallel, numLiveProcessors, 7);
+            prepare (serial);
+            prepare (parallel);
+
+            Random random (0x1234);
+            expect (rendersIdentically (serial, parallel, 100, random));
+
+            serial.releaseResources();
+            parallel.releaseResources();
+        }
+
+        beginTest ("Worker threads start and stop cleanly");
+        {
+            Atomic<int> numLiveProcessors;
+
+            {
+                AudioProcessorGraph serial, parallel;
+                buildBranchedGraph (serial,   numLiveProcessors, 0);
+                buildBranchedGraph (parallel, numLiveProcessors, 0);
+
+                Random random (0x5678);
+                const int workerCounts[] = { numWorkerThreads, 1, 0, numWorkerThreads };
+
+                for (auto numWorkers : workerCounts)
+                {
+                    parallel.setNumWorkerThreads (numWorkers);
+                    expectEquals (parallel.getNumWorkerThreads(), getExpectedNumWorkers (numWorkers));
+
+                    prepare (serial);
+                    prepare (parallel);
+                    expect (rendersIdentically (serial, parallel, 20, random));
+
+                    // the renderer can also be replaced while the graph is prepared
+                    parallel.setNumWorkerThreads (numWorkerThreads - numWorkers);
+                    expect (rendersIdentically (serial, parallel, 20, random));
+
+                    serial.releaseResources();
+                    parallel.releaseResources();
+
+                    // leave the workers long enough to go to sleep, so that the next
+                    // cycle has to wake them up again
+                    Thread::sleep (50);
+                }
+
+                parallel.setNumWorkerThreads (numWorkerThreads);
+            }
+
+            expectEquals (numLiveProcessors.get(), 0);
+        }
+
+        beginTest ("Topology can be changed while the audio thread is rendering");
+        {
+            Atomic<int> numLiveProcessors;
+
+            {
+                AudioProcessorGraph graph;
+                graph.setNumWorkerThreads (numWorkerThreads);
+
+                const auto input  = addIONode (graph, AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode);
+                const auto output = addIONode (graph, AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode);
+                prepare (graph);
+
+                RenderThread renderThread (graph);
+                Random random (0x9abc);
+                Array<uint32> branches;
+
+                for (int i = 0; i < 300; ++i)
+                {
+                    if (branches.isEmpty() || (branches.size() < maxBranches && random.nextBool()))
+                    {
+                        const auto branch = addTestNode (graph, numLiveProcessors, branchGain, 0);
+                        connect (graph, input, branch);
+                        connect (graph, branch, output);
+                        branches.add (branch);
+                    }
+                    else
+                    {
+                        graph.removeNode (branches.removeAndReturn (random.nextInt (branches.size())));
+                    }
+
+                    // let the graph's async update hand the edits to the builder thread, sometimes
+                    // after several of them have piled up, and give the audio thread a block to render
+                    if (random.nextInt (3) != 0)
+                    {
+                        const int numBlocksRendered = renderThread.numBlocks.get();
+                        expect (waitUntil ([&] { return renderThread.numBlocks.get() > numBlocksRendered; }));
+                    }
+                }
+
+                while (branches.size() > 1)
+                    graph.removeNode (branches.removeAndReturn (0));
+
+                // once the audio thread has picked up the last sequence and the ones it retired
+                // have been deleted, only the remaining branch's processor should still exist
+                expect (waitUntil ([&]
+                {
+                    return numLiveProcessors.get() == 1 && renderThread.lastOutput.get() == branchGain;
+                }));
+
+                renderThread.stopThread (4000);
+
+                expect (renderThread.numBlocks.get() > 0);
+                expectEquals (renderThread.numInvalidBlocks.get(), 0);
+
+                graph.releaseResources();
+            }
+
+            expectEquals (numLiveProcessors.get(), 0);
+        }
+    }
+
+private:
+    enum
+    {
+        numChannels = 2,
+        blockSize = 256,
+        numWorkerThreads = 3,
+        maxBranches = 6
+    };
+
+    static constexpr double sampleRate = 44100.0;
+    static constexpr float branchGain = 0.5f;
+
+    //==============================================================================
+    /** A processor with some state, so that rendering its blocks out of order or
+        mixing up its buffers will show up in the output. */
+    struct TestProcessor  : public AudioProcessor
+    {
+        TestProcessor (Atomic<int>& liveCount, float gainToUse, float feedbackToUse, int latency)
+            : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::stereo())
+                                               .withOutput ("Output", AudioChannelSet::stereo())),
+              numLiveProcessors (liveCount), gain (gainToUse), feedback (feedbackToUse)
+        {
+            setLatencySamples (latency);
+            ++numLiveProcessors;
+        }
+
+        ~TestProcessor()
+        {
+            --numLiveProcessors;
+        }
+
+        const String getName() const override                   { return "Test Processor"; }
+        void prepareToPlay (double, int) override               { zeromem (state, sizeof (state)); }
+        void releaseResources() override                        {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* data = buffer.getWritePointer (ch);
+                auto& lastOutput = state[ch];
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    data[i] = lastOutput = data[i] * gain + lastOutput * feedback;
+            }
+        }
+
+        double getTailLengthSeconds() const override            { return 0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 0; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (juce::MemoryBlock&) override  {}
+        void setStateInformation (const void*, int) override    {}
+
+        Atomic<int>& numLiveProcessors;
+        const float gain, feedback;
+        float state[numChannels];
+
+        JUCE_DECLARE_NON_COPYABLE (TestProcessor)
+    };
+
+    //==============================================================================
+    static int getExpectedNumWorkers (int numRequested)
+    {
+        return jlimit (0, jmax (0, SystemStats::getNumCpus() - 1), numRequested);
+    }
+
+    static uint32 addIONode (AudioProcessorGraph& graph, AudioProcessorGraph::AudioGraphIOProcessor::IODeviceType type)
+    {
+        return graph.addNode (new AudioProcessorGraph::AudioGraphIOProcessor (type))->nodeId;
+    }
+
+    static uint32 addTestNode (AudioProcessorGraph& graph, Atomic<int>& numLive,
+                               float gain, float feedback, int latency = 0)
+    {
+        return graph.addNode (new TestProcessor (numLive, gain, feedback, latency))->nodeId;
+    }
+
+    static void connect (AudioProcessorGraph& graph, uint32 source, uint32 dest)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            graph.addConnection (source, ch, dest, ch);
+    }
+
+    /** Connects the input to four processors, mixes them in pairs into two more, and
+        sums those with the dry input at the output. One of the branches can report
+        some latency, so that the delay compensation gets scheduled too. */
+    static void buildBranchedGraph (AudioProcessorGraph& graph, Atomic<int>& numLive, int latency)
+    {
+        const auto input  = addIONode (graph, AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode);
+        const auto output = addIONode (graph, AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto mixer = addTestNode (graph, numLive, 0.7f + 0.1f * (float) i, 0.25f);
+
+            for (int j = 0; j < 2; ++j)
+            {
+                const auto branch = addTestNode (graph, numLive, 0.2f * (float) (i * 2 + j + 1), 0.5f,
+                                                 i == 1 && j == 0 ? latency : 0);
+                connect (graph, input, branch);
+                connect (graph, branch, mixer);
+            }
+
+            connect (graph, mixer, output);
+        }
+
+        connect (graph, input, output);
+    }
+
+    static void prepare (AudioProcessorGraph& graph)
+    {
+        graph.setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+        graph.prepareToPlay (sampleRate, blockSize);
+    }
+
+    static void render (AudioProcessorGraph& graph, AudioBuffer<float>& buffer)
+    {
+        MidiBuffer midi;
+
+        const ScopedLock sl (graph.getCallbackLock());
+        graph.processBlock (buffer, midi);
+    }
+
+    /** Feeds the same blocks of noise through both graphs, and checks that they come
+        out bit-for-bit the same. */
+    static bool rendersIdentically (AudioProcessorGraph& a, AudioProcessorGraph& b, int numBlocks, Random& random)
+    {
+        AudioBuffer<float> bufferA (numChannels, blockSize), bufferB (numChannels, blockSize);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const int numSamples = 1 + random.nextInt (blockSize);
+            bufferA.setSize (numChannels, numSamples, false, false, true);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    bufferA.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            bufferB.makeCopyOf (bufferA, true);
+
+            render (a, bufferA);
+            render (b, bufferB);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                if (memcmp (bufferA.getReadPointer (ch), bufferB.getReadPointer (ch), sizeof (float) * (size_t) numSamples) != 0)
+                    return false;
+        }
+
+        return true;
+    }
+
+    template <typename Condition>
+    static bool waitUntil (Condition condition)
+    {
+        for (auto startTime = Time::getMillisecondCounter(); Time::getMillisecondCounter() - startTime < 5000;)
+        {
+            if (condition())
+                return true;
+
+            dispatchMessages();
+        }
+
+        return false;
+    }
+
+    /** Gives the message loop a chance to deliver the graph's async updates. */
+    static void dispatchMessages()
+    {
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        if (MessageManager::getInstance()->isThisTheMessageThread())
+        {
+            MessageManager::getInstance()->runDispatchLoopUntil (1);
+            return;
+        }
+       #endif
+
+        Thread::sleep (1);
+    }
+
+    //==============================================================================
+    /** Renders a constant input through a graph of parallel branches, like an audio
+        callback would. Whichever sequence it's using, each block should come out as
+        a whole number of branches' worth of signal, on every sample and channel. */
+    struct RenderThread  : public Thread
+    {
+        RenderThread (AudioProcessorGraph& g)  : Thread ("Graph Test Render Thread"), graph (g)
+        {
+            startThread (8);
+        }
+
+        ~RenderThread()
+        {
+            stopThread (4000);
+        }
+
+        void run() override
+        {
+            AudioBuffer<float> buffer (numChannels, blockSize);
+
+            while (! threadShouldExit())
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    FloatVectorOperations::fill (buffer.getWritePointer (ch), 1.0f, blockSize);
+
+                render (graph, buffer);
+
+                const float value = buffer.getSample (0, 0);
+
+                if (! isValidOutput (buffer, value))
+                    ++numInvalidBlocks;
+
+                lastOutput = value;
+                ++numBlocks;
+
+                wait (1);
+            }
+        }
+
+        static bool isValidOutput (const AudioBuffer<float>& buffer, float value)
+        {
+            const float numBranches = value / branchGain;
+
+            if (numBranches < 0 || numBranches > (float) maxBranches || numBranches != std::floor (numBranches))
+                return false;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    if (buffer.getSample (ch, i) != value)
+                        return false;
+
+            return true;
+        }
+
+        AudioProcessorGraph& graph;
+        Atomic<float> lastOutput { -1.0f };
+        Atomic<int> numBlocks, numInvalidBlocks;
+
+        JUCE_DECLARE_NON_COPYABLE (RenderThread)
+    };
+};
+
+static AudioProcessorGraphTests audioProcessorGraphTests;
+
+#endif
+
 } // namespace juce
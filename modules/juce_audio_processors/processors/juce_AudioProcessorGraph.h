@@ -27,6 +27,10 @@
 namespace juce
 {
 
+#ifndef DOXYGEN
+ namespace GraphRenderingOps { struct RenderSequence; }
+#endif
+
 //==============================================================================
 /**
     A type of AudioProcessor which plays back a graph of other AudioProcessors.
@@ -79,6 +83,27 @@ public:
         */
         NamedValueSet properties;
 
+        //==============================================================================
+        /** Lets the graph skip this node's processor while its input is silent.
+
+            When this is enabled and all the node's audio inputs have been silent, with no
+            incoming midi, for longer than its processor's getTailLengthSeconds(), the graph
+            stops calling processBlock() and just clears the node's outputs, until some
+            non-silent input arrives. Only enable it for processors whose output really does
+            die away with their input, e.g. effects like reverbs and EQs - not for synths or
+            anything else that can make a sound with no input. Nodes without any audio inputs
+            are never skipped, and a processor that returns an infinite tail length will
+            always be called.
+
+            This can be changed at any time, from any thread.
+        */
+        void setSkippedWhenSilent (bool shouldBeSkipped) noexcept   { skipWhenSilent = shouldBeSkipped; }
+
+        /** Returns true if the graph can skip this node while its input is silent.
+            @see setSkippedWhenSilent
+        */
+        bool isSkippedWhenSilent() const noexcept                   { return skipWhenSilent; }
+
         //==============================================================================
         /** A convenient typedef for referring to a pointer to a node object. */
         typedef ReferenceCountedObjectPtr<Node> Ptr;
@@ -89,6 +114,7 @@ public:
 
         const ScopedPointer<AudioProcessor> processor;
         bool isPrepared;
+        std::atomic<bool> skipWhenSilent { false };
 
         Node (uint32 nodeId, AudioProcessor*) noexcept;
 
@@ -255,6 +281,47 @@ public:
     */
     static const int midiChannelIndex;
 
+    //==============================================================================
+    /** Enables or disables multi-threaded rendering of the graph.
+
+        By default the graph renders all of its nodes one after another on the audio
+        thread. If you pass a number greater than zero here, the graph will create that
+        many realtime worker threads, and will split its rendering sequence into a set
+        of tasks whose dependencies are worked out from the buffers that they share.
+        During each audio callback, any nodes that don't depend on each other will then
+        be processed concurrently by the worker threads and the audio thread.
+
+        No memory is allocated and no locks are taken while the tasks are run, but
+        bear in mind that in this mode the processors in the graph may have their
+        processBlock() methods called from threads other than the audio thread, and
+        that several of them may be running at the same time.
+
+        The number of threads is limited to one less than the number of CPU cores,
+        as the audio thread also takes part in the rendering. Passing zero will stop
+        any worker threads and go back to serial rendering.
+        This should be called from the message thread.
+
+        @see getNumWorkerThreads
+    */
+    void setNumWorkerThreads (int numWorkerThreads);
+
+    /** Returns the number of worker threads used for multi-threaded rendering, or
+        zero if the graph is rendered serially.
+        @see setNumWorkerThreads
+    */
+    int getNumWorkerThreads() const noexcept;
+
+    //==============================================================================
+    /** Adjusts the delays that compensate for the latencies of the nodes, after the
+        latency of one or more of their processors has changed.
+
+        A host can call this when a plugin reports a new latency, e.g. from its
+        AudioProcessorListener::audioProcessorChanged() callback. If the existing delay
+        lines can accommodate the new latencies, they're just retuned, and the graph
+        carries on rendering without any interruption. Otherwise, the rendering sequence
+        gets rebuilt in the background. This must be called on the message thread.
+    */
+    void updateLatencyCompensation();
 
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
@@ -384,21 +451,28 @@ private:
     ReferenceCountedArray<Node> nodes;
     OwnedArray<Connection> connections;
     uint32 lastNodeId;
-    OwnedArray<MidiBuffer> midiBuffers;
-    Array<void*> renderingOps;
 
     friend class AudioGraphIOProcessor;
     struct AudioProcessorGraphBufferHelpers;
     ScopedPointer<AudioProcessorGraphBufferHelpers> audioBuffers;
 
+    struct ParallelRenderer;
+    ScopedPointer<ParallelRenderer> parallelRenderer;
+
+    struct RenderSequenceBuilder;
+    ScopedPointer<RenderSequenceBuilder> builder;
+    GraphRenderingOps::RenderSequence* currentSequence = nullptr;
+
     MidiBuffer* currentMidiInputBuffer;
     MidiBuffer currentMidiOutputBuffer;
 
-    bool isPrepared;
+    bool isPrepared, needsRebuild = false;
 
     void handleAsyncUpdate() override;
+    void topologyChanged();
+    void swapRenderSequence (GraphRenderingOps::RenderSequence*);
     void clearRenderingSequence();
-    void buildRenderingSequence();
+    void buildRenderingSequence (bool buildInBackground);
     bool isAnInputTo (uint32 possibleInputId, uint32 possibleDestinationId, int recursionCheck) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorGraph)
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+BlockSizeAdapter::BlockSizeAdapter (AudioProcessor& p, int fixedBlockSize, bool addLatencyToKeepBlocksFull)
+    : processor (p), fixedSize (fixedBlockSize), usesFifo (addLatencyToKeepBlocksFull)
+{
+    jassert (fixedBlockSize > 0);
+}
+
+BlockSizeAdapter::~BlockSizeAdapter() {}
+
+void BlockSizeAdapter::prepare (int maxNumChannels)
+{
+    if (usesFifo)
+    {
+        floatFifo.setSize (maxNumChannels, fixedSize);
+        doubleFifo.setSize (maxNumChannels, fixedSize);
+    }
+
+    // a reasonable amount of room, so that midi doesn't usually need to be allocated on the audio thread
+    for (auto* m : { &midiIn, &midiOut, &midiResult })
+        m->ensureSize (2048);
+
+    reset();
+}
+
+void BlockSizeAdapter::reset()
+{
+    floatFifo.clear();
+    doubleFifo.clear();
+    midiIn.clear();
+    midiOut.clear();
+    fifoPosition = 0;
+}
+
+//==============================================================================
+void BlockSizeAdapter::process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages, bool isBypassed)
+{
+    if (usesFifo)
+        processWithFifo (buffer, floatFifo, midiMessages, isBypassed);
+    else
+        processSplit (buffer, midiMessages, isBypassed);
+}
+
+void BlockSizeAdapter::process (AudioBuffer<double>& buffer, MidiBuffer& midiMessages, bool isBypassed)
+{
+    if (usesFifo)
+        processWithFifo (buffer, doubleFifo, midiMessages, isBypassed);
+    else
+        processSplit (buffer, midiMessages, isBypassed);
+}
+
+template <typename FloatType>
+void BlockSizeAdapter::callProcessor (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, bool isBypassed)
+{
+    if (isBypassed)
+        processor.processBlockBypassed (buffer, midiMessages);
+    else
+        processor.processBlock (buffer, midiMessages);
+}
+
+template <typename FloatType>
+void BlockSizeAdapter::processSplit (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, bool isBypassed)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    if (numSamples <= fixedSize)
+    {
+        callProcessor (buffer, midiMessages, isBypassed);
+        return;
+    }
+
+    midiResult.clear();
+
+    for (int pos = 0; pos < numSamples; pos += fixedSize)
+    {
+        const int numThisTime = jmin (fixedSize, numSamples - pos);
+        AudioBuffer<FloatType> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), pos, numThisTime);
+
+        midiIn.clear();
+        midiIn.addEvents (midiMessages, pos, numThisTime, -pos);
+
+        callProcessor (chunk, midiIn, isBypassed);
+
+        midiResult.addEvents (midiIn, 0, -1, pos);
+    }
+
+    midiMessages.swapWith (midiResult);
+}
+
+template <typename FloatType>
+void BlockSizeAdapter::processWithFifo (AudioBuffer<FloatType>& buffer, AudioBuffer<FloatType>& fifo,
+                                        MidiBuffer& midiMessages, bool isBypassed)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels > fifo.getNumChannels())
+    {
+        // prepare() needs to be called with enough channels for the buffers that the
+        // host passes in, otherwise the blocks can't be buffered up
+        jassertfalse;
+        callProcessor (buffer, midiMessages, isBypassed);
+        return;
+    }
+
+    midiResult.clear();
+
+    for (int pos = 0; pos < numSamples;)
+    {
+        const int numThisTime = jmin (fixedSize - fifoPosition, numSamples - pos);
+
+        // the FIFO holds the processor's output from the last full block, which gets
+        // swapped for the new input, so everything comes out one block later
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto* data = buffer.getWritePointer (i, pos);
+            std::swap_ranges (data, data + numThisTime, fifo.getWritePointer (i, fifoPosition));
+        }
+
+        midiIn.addEvents (midiMessages, pos, numThisTime, fifoPosition - pos);
+        midiResult.addEvents (midiOut, fifoPosition, numThisTime, pos - fifoPosition);
+
+        pos += numThisTime;
+        fifoPosition += numThisTime;
+
+        if (fifoPosition == fixedSize)
+        {
+            AudioBuffer<FloatType> block (fifo.getArrayOfWritePointers(), numChannels, fixedSize);
+            callProcessor (block, midiIn, isBypassed);
+
+            midiOut.swapWith (midiIn);
+            midiIn.clear();
+            fifoPosition = 0;
+        }
+    }
+
+    midiMessages.swapWith (midiResult);
+}
+
+} // namespace juce
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioProcessor;
+
+//==============================================================================
+/**
+    Splits up or re-buffers the blocks that a host sends, so that an AudioProcessor's
+    processBlock() method is always called with a known block size.
+
+    Hosts can call a plugin with any block size at all, including single-sample blocks
+    around loop points, which can be very expensive for processors that do a lot of
+    set-up work for each block, or whose DSP is written for a particular size.
+
+    A processor enables this by calling AudioProcessor::setFixedBlockSize(), and the
+    plugin wrappers, AudioProcessorPlayer and AudioProcessorGraph will then pass their
+    blocks through the processor's adapter rather than calling processBlock() directly.
+    There are two modes:
+
+    - Without latency, any block that's longer than the fixed size gets split into
+      chunks of the fixed size, plus a shorter one for whatever is left over. The
+      processor is never called with more than the fixed size, but smaller host blocks
+      are passed on as they are, because they can't be merged without delaying them.
+
+    - With latency, the audio and midi go through a FIFO, and the processor is only
+      ever called with exactly the fixed size. This delays everything by the fixed
+      block size, which is added to the value that AudioProcessor::getLatencySamples()
+      returns, so the host will compensate for it.
+
+    @see AudioProcessor::setFixedBlockSize
+*/
+class JUCE_API  BlockSizeAdapter
+{
+public:
+    //==============================================================================
+    /** Creates an adapter for a processor. */
+    BlockSizeAdapter (AudioProcessor& processor, int fixedBlockSize, bool addLatencyToKeepBlocksFull);
+
+    /** Destructor. */
+    ~BlockSizeAdapter();
+
+    //==============================================================================
+    /** Allocates the FIFOs for a number of channels, and clears anything in them.
+        AudioProcessor calls this when its playback details are set.
+    */
+    void prepare (int maxNumChannels);
+
+    /** Clears the FIFOs. */
+    void reset();
+
+    /** Returns the block size that the processor will be called with. */
+    int getFixedBlockSize() const noexcept          { return fixedSize; }
+
+    /** Returns the number of samples of delay that the adapter adds. */
+    int getLatencySamples() const noexcept          { return usesFifo ? fixedSize : 0; }
+
+    //==============================================================================
+    /** Passes a block from the host to the processor's processBlock() or
+        processBlockBypassed() methods, in chunks of the fixed size.
+    */
+    void process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages, bool isBypassed);
+
+    /** Passes a block from the host to the processor's processBlock() or
+        processBlockBypassed() methods, in chunks of the fixed size.
+    */
+    void process (AudioBuffer<double>& buffer, MidiBuffer& midiMessages, bool isBypassed);
+
+private:
+    //==============================================================================
+    AudioProcessor& processor;
+    const int fixedSize;
+    const bool usesFifo;
+    AudioBuffer<float> floatFifo;
+    AudioBuffer<double> doubleFifo;
+    MidiBuffer midiIn, midiOut, midiResult;
+    int fifoPosition = 0;
+
+    template <typename FloatType> void processSplit (AudioBuffer<FloatType>&, MidiBuffer&, bool);
+    template <typename FloatType> void processWithFifo (AudioBuffer<FloatType>&, AudioBuffer<FloatType>& fifo, MidiBuffer&, bool);
+    template <typename FloatType> void callProcessor (AudioBuffer<FloatType>&, MidiBuffer&, bool);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockSizeAdapter)
+};
+
+} // namespace juce
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ParameterAutomationBuffer::ParameterAutomationBuffer() {}
+ParameterAutomationBuffer::~ParameterAutomationBuffer() {}
+
+void ParameterAutomationBuffer::prepare (int numParams, int maxPointsPerParameter)
+{
+    jassert (numParams >= 0 && maxPointsPerParameter > 0);
+
+    numParameters = numParams;
+    maxPoints = jmax (1, maxPointsPerParameter);
+
+    points.malloc ((size_t) (numParameters * maxPoints));
+    numPoints.malloc ((size_t) numParameters);
+    changedParameters.malloc ((size_t) numParameters);
+    startValues.calloc ((size_t) numParameters);
+    numChangedParameters = 0;
+
+    // (a parameter with no automation in the current block has a point count of -1)
+    for (int i = 0; i < numParameters; ++i)
+        numPoints[i] = -1;
+}
+
+void ParameterAutomationBuffer::clear() noexcept
+{
+    for (int i = 0; i < numChangedParameters; ++i)
+        numPoints[changedParameters[i]] = -1;
+
+    numChangedParameters = 0;
+}
+
+void ParameterAutomationBuffer::setValueAtStartOfBlock (int parameterIndex, float normalisedValue) noexcept
+{
+    if (! isPositiveAndBelow (parameterIndex, numParameters))
+    {
+        jassertfalse;
+        return;
+    }
+
+    if (! hasAutomation (parameterIndex))
+        changedParameters[numChangedParameters++] = parameterIndex;
+
+    startValues[parameterIndex] = normalisedValue;
+    numPoints[parameterIndex] = 0;
+}
+
+void ParameterAutomationBuffer::addPoint (int parameterIndex, int sampleOffset, float normalisedValue) noexcept
+{
+    if (! isPositiveAndBelow (parameterIndex, numParameters))
+    {
+        jassertfalse;
+        return;
+    }
+
+    // you need to call setValueAtStartOfBlock() before adding any points!
+    if (! hasAutomation (parameterIndex))
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& num = numPoints[parameterIndex];
+    auto* paramPoints = points + parameterIndex * maxPoints;
+
+    // points must be added in order!
+    jassert (num == 0 || sampleOffset >= paramPoints[num - 1].sampleOffset);
+
+    if (num == maxPoints)
+        --num;
+
+    paramPoints[num++] = { sampleOffset, normalisedValue };
+}
+
+int ParameterAutomationBuffer::getChangedParameterIndex (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numChangedParameters));
+    return changedParameters[index];
+}
+
+bool ParameterAutomationBuffer::hasAutomation (int parameterIndex) const noexcept
+{
+    return isPositiveAndBelow (parameterIndex, numParameters) && numPoints[parameterIndex] >= 0;
+}
+
+float ParameterAutomationBuffer::getValueAtStartOfBlock (int parameterIndex) const noexcept
+{
+    return isPositiveAndBelow (parameterIndex, numParameters) ? startValues[parameterIndex] : 0.0f;
+}
+
+int ParameterAutomationBuffer::getNumPoints (int parameterIndex) const noexcept
+{
+    return hasAutomation (parameterIndex) ? numPoints[parameterIndex] : 0;
+}
+
+const ParameterAutomationBuffer::Point* ParameterAutomationBuffer::getPoints (int parameterIndex) const noexcept
+{
+    return isPositiveAndBelow (parameterIndex, numParameters) ? points + parameterIndex * maxPoints : nullptr;
+}
+
+bool ParameterAutomationBuffer::renderValues (int parameterIndex, float* dest, int numSamples) const noexcept
+{
+    if (! hasAutomation (parameterIndex))
+        return false;
+
+    auto* paramPoints = getPoints (parameterIndex);
+    auto num = numPoints[parameterIndex];
+
+    // each segment is a straight line from one breakpoint to the next, where the start
+    // value counts as being at sample 0
+    auto segmentStart = 0;
+    auto segmentValue = startValues[parameterIndex];
+    auto pos = 0;
+
+    for (int i = 0; i < num; ++i)
+    {
+        auto& p = paramPoints[i];
+        auto end = jlimit (0, numSamples, p.sampleOffset);
+
+        if (end > pos)
+        {
+            auto step = (p.value - segmentValue) / (float) (p.sampleOffset - segmentStart);
+
+            for (int j = pos; j < end; ++j)
+                dest[j] = segmentValue + step * (float) (j - segmentStart);
+
+            pos = end;
+        }
+
+        segmentStart = p.sampleOffset;
+        segmentValue = p.value;
+    }
+
+    if (pos < numSamples)
+        FloatVectorOperations::fill (dest + pos, segmentValue, numSamples - pos);
+
+    return true;
+}
+
+} // namespace juce
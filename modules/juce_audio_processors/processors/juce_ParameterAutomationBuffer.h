@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds the sample-accurate automation that a plugin host has sent for each of an
+    AudioProcessor's parameters during the current block.
+
+    A processor that wants to use this should call AudioProcessor::setParameterAutomationBufferEnabled(),
+    and can then call AudioProcessor::getParameterAutomationBuffer() during its processBlock()
+    method to find out exactly where in the block each parameter's value changed. Where a
+    host doesn't send sample offsets, or the plugin format doesn't support them, the buffer
+    will simply be empty, and the parameters' values will have been set as usual. At the
+    moment, only the VST3 wrapper provides sample-accurate automation.
+
+    The plugin wrappers still call setValue() on each parameter with the last value in the
+    block, so AudioProcessorParameter::getValue() stays correct either way.
+
+    The automation for each parameter is stored as a list of breakpoints, each giving a
+    normalised value at a sample position within the block. The value is taken to move in
+    a straight line from each breakpoint to the next one, starting from the value that the
+    parameter had at the start of the block, and stays at the last breakpoint's value until
+    the end of the block. You can either read the breakpoints directly, or use renderValues()
+    to turn them into a per-sample curve.
+
+    None of the methods allocate memory apart from prepare(), so the buffer can be filled
+    and read on the audio thread.
+
+    @see AudioProcessor::setParameterAutomationBufferEnabled, AudioProcessor::getParameterAutomationBuffer
+*/
+class JUCE_API  ParameterAutomationBuffer
+{
+public:
+    //==============================================================================
+    /** Creates an empty buffer. You'll need to call prepare() before using it. */
+    ParameterAutomationBuffer();
+
+    /** Destructor. */
+    ~ParameterAutomationBuffer();
+
+    //==============================================================================
+    /** A single automation breakpoint. */
+    struct Point
+    {
+        /** The position of this point, in samples from the start of the block. */
+        int sampleOffset;
+
+        /** The parameter's normalised value at this position. */
+        float value;
+    };
+
+    //==============================================================================
+    /** Allocates space for the given number of parameters, and for up to maxPointsPerParameter
+        breakpoints per parameter in each block. This also clears the buffer.
+    */
+    void prepare (int numParameters, int maxPointsPerParameter);
+
+    /** Removes the automation for all parameters. The plugin wrappers call this at the start of each block. */
+    void clear() noexcept;
+
+    /** Starts recording automation for a parameter in the current block.
+
+        This marks the parameter as having changed, and gives the value it had before
+        any of the block's breakpoints. If it's called more than once during a block, it'll
+        discard any points that were added before.
+    */
+    void setValueAtStartOfBlock (int parameterIndex, float normalisedValue) noexcept;
+
+    /** Adds a breakpoint for a parameter.
+
+        setValueAtStartOfBlock() must have been called for the parameter first, and points must
+        be added in order of increasing sampleOffset. If there's no room left for the parameter,
+        the new point replaces its last one, so the final value is never lost.
+    */
+    void addPoint (int parameterIndex, int sampleOffset, float normalisedValue) noexcept;
+
+    //==============================================================================
+    /** Returns the number of parameters that have automation in the current block. */
+    int getNumChangedParameters() const noexcept                    { return numChangedParameters; }
+
+    /** Returns the index of one of the parameters that have automation in the current block.
+        @see getNumChangedParameters
+    */
+    int getChangedParameterIndex (int index) const noexcept;
+
+    /** Returns true if the given parameter has any automation in the current block. */
+    bool hasAutomation (int parameterIndex) const noexcept;
+
+    /** Returns the value that a parameter had before its first breakpoint. */
+    float getValueAtStartOfBlock (int parameterIndex) const noexcept;
+
+    /** Returns the number of breakpoints that a parameter has in the current block. */
+    int getNumPoints (int parameterIndex) const noexcept;
+
+    /** Returns the breakpoints for a parameter in the current block.
+        @see getNumPoints
+    */
+    const Point* getPoints (int parameterIndex) const noexcept;
+
+    /** Fills a buffer with a parameter's normalised value at each sample in the block.
+
+        If the parameter has no automation in the current block, this returns false and
+        leaves the buffer untouched.
+    */
+    bool renderValues (int parameterIndex, float* destination, int numSamples) const noexcept;
+
+    /** Returns the number of parameters that prepare() allocated space for. */
+    int getNumParameters() const noexcept                           { return numParameters; }
+
+private:
+    //==============================================================================
+    HeapBlock<Point> points;
+    HeapBlock<int> numPoints, changedParameters;
+    HeapBlock<float> startValues;
+    int numParameters = 0, maxPoints = 0, numChangedParameters = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterAutomationBuffer)
+};
+
+} // namespace juce
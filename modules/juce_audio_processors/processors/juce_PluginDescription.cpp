@@ -148,4 +148,47 @@ bool PluginDescription::loadFromXml (const XmlElement& xml)
     return false;
 }
 
+void PluginDescription::writeToStream (OutputStream& output) const
+{
+    output.writeString (name);
+    output.writeString (descriptiveName);
+    output.writeString (pluginFormatName);
+    output.writeString (category);
+    output.writeString (manufacturerName);
+    output.writeString (version);
+    output.writeString (fileOrIdentifier);
+    output.writeInt64 (lastFileModTime.toMilliseconds());
+    output.writeInt64 (lastInfoUpdateTime.toMilliseconds());
+    output.writeInt (uid);
+    output.writeCompressedInt (numInputChannels);
+    output.writeCompressedInt (numOutputChannels);
+    output.writeByte ((char) ((isInstrument ? 1 : 0) | (hasSharedContainer ? 2 : 0)));
+}
+
+bool PluginDescription::readFromStream (InputStream& input)
+{
+    name                = input.readString();
+    descriptiveName     = input.readString();
+    pluginFormatName    = input.readString();
+    category            = input.readString();
+    manufacturerName    = input.readString();
+    version             = input.readString();
+    fileOrIdentifier    = input.readString();
+    lastFileModTime     = Time (input.readInt64());
+    lastInfoUpdateTime  = Time (input.readInt64());
+    uid                 = input.readInt();
+    numInputChannels    = input.readCompressedInt();
+    numOutputChannels   = input.readCompressedInt();
+
+    // the flags are written last, so if they're missing then the stream has been truncated
+    if (input.isExhausted())
+        return false;
+
+    auto flags = input.readByte();
+    isInstrument        = (flags & 1) != 0;
+    hasSharedContainer  = (flags & 2) != 0;
+
+    return true;
+}
+
 } // namespace juce
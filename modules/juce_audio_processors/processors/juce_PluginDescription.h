@@ -147,6 +147,19 @@ public:
     */
     bool loadFromXml (const XmlElement& xml);
 
+    /** Writes these details to a stream in a compact binary format, which is much
+        quicker to read back than the XML version.
+
+        @see readFromStream
+    */
+    void writeToStream (OutputStream& output) const;
+
+    /** Reloads the info in this structure from data that was written by writeToStream().
+
+        Returns false if the stream ran out before a whole description had been read.
+    */
+    bool readFromStream (InputStream& input);
+
 
 private:
     //==============================================================================
@@ -27,27 +27,96 @@
 namespace juce
 {
 
+//==============================================================================
+/*  Hash tables for finding the types for a file, or the type that matches an identifier
+    string or uid, without searching the whole list. Each lookup gives the same results as searching
+    the list in order. It's built when it's first needed, kept up to date when types are added,
+    and thrown away when types are removed or re-ordered.
+*/
+struct KnownPluginList::TypeIndex
+{
+    TypeIndex (const OwnedArray<PluginDescription>& types)
+    {
+        typesForFile.reserve (types.size());
+        typesForIdentifierSuffix.reserve (types.size());
+        typesForUid.reserve (types.size());
+
+        for (int i = types.size(); --i >= 0;)
+            addAtStart (types.getUnchecked (i));
+    }
+
+    void addAtStart (PluginDescription* desc)
+    {
+        typesForFile.getReference (desc->fileOrIdentifier).insert (0, desc);
+        typesForIdentifierSuffix.set (getIdentifierSuffix (*desc), desc);
+        typesForUid.set (desc->uid, desc);
+    }
+
+    PluginDescription* findDuplicateOf (const PluginDescription& type)
+    {
+        if (auto* types = typesForFile.find (type.fileOrIdentifier))
+            for (auto* desc : *types)
+                if (desc->isDuplicateOf (type))
+                    return desc;
+
+        return nullptr;
+    }
+
+    // This has to match the end of the string that PluginDescription::createIdentifierString() returns
+    static String getIdentifierSuffix (const PluginDescription& desc)
+    {
+        return "-" + String::toHexString (desc.fileOrIdentifier.hashCode())
+             + "-" + String::toHexString (desc.uid);
+    }
+
+    // Finds the suffix of an identifier string, as PluginDescription::matchesIdentifierString() would
+    static String findIdentifierSuffix (const String& identifierString)
+    {
+        auto lastDash = identifierString.lastIndexOfChar ('-');
+        auto previousDash = lastDash > 0 ? identifierString.substring (0, lastDash).lastIndexOfChar ('-') : -1;
+
+        return previousDash >= 0 ? identifierString.substring (previousDash).toLowerCase() : String();
+    }
+
+    FlatHashMap<String, Array<PluginDescription*>> typesForFile;
+    FlatHashMap<String, PluginDescription*> typesForIdentifierSuffix;
+    FlatHashMap<int, PluginDescription*> typesForUid;
+};
+
+//==============================================================================
 KnownPluginList::KnownPluginList()  {}
 KnownPluginList::~KnownPluginList() {}
 
-void KnownPluginList::clear()
+KnownPluginList::TypeIndex& KnownPluginList::getTypeIndex() const
 {
-    ScopedLock lock (typesArrayLock);
+    if (typeIndex == nullptr)
+        typeIndex = new TypeIndex (types);
+
+    return *typeIndex;
+}
 
-    if (! types.isEmpty())
+void KnownPluginList::clear()
+{
     {
+        ScopedLock lock (typesArrayLock);
+
+        if (types.isEmpty())
+            return;
+
         types.clear();
-        sendChangeMessage();
+        typeIndex = nullptr;
     }
+
+    listeners.call (&Listener::knownPluginListReplaced, *this);
+    sendChangeMessage();
 }
 
 PluginDescription* KnownPluginList::getTypeForFile (const String& fileOrIdentifier) const
 {
     ScopedLock lock (typesArrayLock);
 
-    for (auto* desc : types)
-        if (desc->fileOrIdentifier == fileOrIdentifier)
-            return desc;
+    if (auto* typesForFile = getTypeIndex().typesForFile.find (fileOrIdentifier))
+        return typesForFile->getFirst();
 
     return nullptr;
 }
@@ -56,58 +125,87 @@ PluginDescription* KnownPluginList::getTypeForIdentifierString (const String& id
 {
     ScopedLock lock (typesArrayLock);
 
-    for (auto* desc : types)
-        if (desc->matchesIdentifierString (identifierString))
-            return desc;
+    auto suffix = TypeIndex::findIdentifierSuffix (identifierString);
+
+    if (suffix.isNotEmpty())
+        if (auto* desc = getTypeIndex().typesForIdentifierSuffix.find (suffix))
+            return *desc;
+
+    return nullptr;
+}
+
+PluginDescription* KnownPluginList::getTypeForUid (int uid) const
+{
+    ScopedLock lock (typesArrayLock);
+
+    if (auto* desc = getTypeIndex().typesForUid.find (uid))
+        return *desc;
 
     return nullptr;
 }
 
 bool KnownPluginList::addType (const PluginDescription& type)
 {
+    bool isNewType = true;
+
     {
         ScopedLock lock (typesArrayLock);
 
-        for (auto* desc : types)
+        if (auto* desc = getTypeIndex().findDuplicateOf (type))
         {
-            if (desc->isDuplicateOf (type))
-            {
-                // strange - found a duplicate plugin with different info..
-                jassert (desc->name == type.name);
-                jassert (desc->isInstrument == type.isInstrument);
+            // strange - found a duplicate plugin with different info..
+            jassert (desc->name == type.name);
+            jassert (desc->isInstrument == type.isInstrument);
 
-                *desc = type;
-                return false;
-            }
+            *desc = type;
+            isNewType = false;
         }
+        else
+        {
+            auto* newType = types.insert (0, new PluginDescription (type));
+            getTypeIndex().addAtStart (newType);
+        }
+    }
 
-        types.insert (0, new PluginDescription (type));
+    if (! isNewType)
+    {
+        listeners.call (&Listener::knownPluginTypeChanged, *this, type);
+        return false;
     }
 
+    listeners.call (&Listener::knownPluginTypeAdded, *this, type);
     sendChangeMessage();
     return true;
 }
 
 void KnownPluginList::removeType (const int index)
 {
+    ScopedPointer<PluginDescription> removed;
+
     {
         ScopedLock lock (typesArrayLock);
-        types.remove (index);
+        removed = types.removeAndReturn (index);
+        typeIndex = nullptr;
     }
 
+    if (removed != nullptr)
+        listeners.call (&Listener::knownPluginTypeRemoved, *this, *removed);
+
     sendChangeMessage();
 }
 
 bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
                                          AudioPluginFormat& formatToUse) const
 {
-    if (getTypeForFile (fileOrIdentifier) == nullptr)
-        return false;
-
     ScopedLock lock (typesArrayLock);
 
-    for (auto* d : types)
-        if (d->fileOrIdentifier == fileOrIdentifier && formatToUse.pluginNeedsRescanning (*d))
+    auto* typesForFile = getTypeIndex().typesForFile.find (fileOrIdentifier);
+
+    if (typesForFile == nullptr)
+        return false;
+
+    for (auto* d : *typesForFile)
+        if (formatToUse.pluginNeedsRescanning (*d))
             return false;
 
     return true;
@@ -132,14 +230,17 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
 
         ScopedLock lock (typesArrayLock);
 
-        for (auto* d : types)
+        if (auto* typesForFile = getTypeIndex().typesForFile.find (fileOrIdentifier))
         {
-            if (d->fileOrIdentifier == fileOrIdentifier && d->pluginFormatName == format.getName())
+            for (auto* d : *typesForFile)
             {
-                if (format.pluginNeedsRescanning (*d))
-                    needsRescanning = true;
-                else
-                    typesFound.add (new PluginDescription (*d));
+                if (d->pluginFormatName == format.getName())
+                {
+                    if (format.pluginNeedsRescanning (*d))
+                        needsRescanning = true;
+                    else
+                        typesFound.add (new PluginDescription (*d));
+                }
             }
         }
 
@@ -236,6 +337,7 @@ void KnownPluginList::addToBlacklist (const String& pluginID)
     if (! blacklist.contains (pluginID))
     {
         blacklist.add (pluginID);
+        listeners.call (&Listener::knownPluginBlacklistChanged, *this);
         sendChangeMessage();
     }
 }
@@ -247,6 +349,7 @@ void KnownPluginList::removeFromBlacklist (const String& pluginID)
     if (index >= 0)
     {
         blacklist.remove (index);
+        listeners.call (&Listener::knownPluginBlacklistChanged, *this);
         sendChangeMessage();
     }
 }
@@ -256,6 +359,7 @@ void KnownPluginList::clearBlacklistedFiles()
     if (blacklist.size() > 0)
     {
         blacklist.clear();
+        listeners.call (&Listener::knownPluginBlacklistChanged, *this);
         sendChangeMessage();
     }
 }
@@ -320,12 +424,16 @@ void KnownPluginList::sort (const SortMethod method, bool forwards)
 
             PluginSorter sorter (method, forwards);
             types.sort (sorter, true);
+            typeIndex = nullptr;
 
             newOrder.addArray (types);
         }
 
         if (oldOrder != newOrder)
+        {
+            listeners.call (&Listener::knownPluginListReordered, *this);
             sendChangeMessage();
+        }
     }
 }
 
@@ -349,23 +457,161 @@ XmlElement* KnownPluginList::createXml() const
 
 void KnownPluginList::recreateFromXml (const XmlElement& xml)
 {
-    clear();
-    clearBlacklistedFiles();
+    OwnedArray<PluginDescription> newTypes;
+    StringArray newBlacklist;
 
     if (xml.hasTagName ("KNOWNPLUGINS"))
     {
         forEachXmlChildElement (xml, e)
         {
-            PluginDescription info;
-
             if (e->hasTagName ("BLACKLISTED"))
-                blacklist.add (e->getStringAttribute ("id"));
-            else if (info.loadFromXml (*e))
-                addType (info);
+            {
+                newBlacklist.add (e->getStringAttribute ("id"));
+            }
+            else
+            {
+                ScopedPointer<PluginDescription> info (new PluginDescription());
+
+                if (info->loadFromXml (*e))
+                    newTypes.add (info.release());
+            }
         }
     }
+
+    replaceAllTypes (newTypes, newBlacklist);
 }
 
+// This gives the same result as clearing the list and then calling addType() for each of
+// the new types in turn, but without re-searching the list or sending a message for each one.
+void KnownPluginList::replaceAllTypes (OwnedArray<PluginDescription>& newTypes, const StringArray& newBlacklist)
+{
+    {
+        ScopedLock lock (typesArrayLock);
+
+        types.clear();
+        types.ensureStorageAllocated (newTypes.size());
+        typeIndex = new TypeIndex (types);
+
+        for (int i = 0; i < newTypes.size(); ++i)
+        {
+            auto* type = newTypes.getUnchecked (i);
+
+            if (auto* existing = typeIndex->findDuplicateOf (*type))
+            {
+                *existing = *type;
+            }
+            else
+            {
+                types.add (type);
+                typeIndex->addAtStart (type);
+                newTypes.set (i, nullptr, false);
+            }
+        }
+
+        // addType() puts each new type at the start of the list
+        std::reverse (types.begin(), types.end());
+    }
+
+    blacklist = newBlacklist;
+
+    listeners.call (&Listener::knownPluginListReplaced, *this);
+    listeners.call (&Listener::knownPluginBlacklistChanged, *this);
+    sendChangeMessage();
+}
+
+//==============================================================================
+static const int knownPluginListMagicNumber = (int) ByteOrder::littleEndianInt ("KPL1");
+
+void KnownPluginList::writeToStream (OutputStream& output) const
+{
+    output.writeInt (knownPluginListMagicNumber);
+
+    {
+        ScopedLock lock (typesArrayLock);
+
+        // written in reverse, so that reading them back with replaceAllTypes() restores the same order
+        output.writeCompressedInt (types.size());
+
+        for (int i = types.size(); --i >= 0;)
+            types.getUnchecked (i)->writeToStream (output);
+    }
+
+    output.writeCompressedInt (blacklist.size());
+
+    for (auto& b : blacklist)
+        output.writeString (b);
+
+    // the magic number is repeated at the end, so that a truncated stream can be detected
+    output.writeInt (knownPluginListMagicNumber);
+}
+
+bool KnownPluginList::readFromStream (InputStream& input)
+{
+    if (input.readInt() != knownPluginListMagicNumber)
+        return false;
+
+    auto numTypes = input.readCompressedInt();
+
+    if (numTypes < 0)
+        return false;
+
+    OwnedArray<PluginDescription> newTypes;
+
+    for (int i = 0; i < numTypes; ++i)
+    {
+        auto* desc = newTypes.add (new PluginDescription());
+
+        if (! desc->readFromStream (input))
+            return false;
+    }
+
+    auto numBlacklisted = input.readCompressedInt();
+
+    if (numBlacklisted < 0)
+        return false;
+
+    StringArray newBlacklist;
+
+    for (int i = 0; i < numBlacklisted; ++i)
+        newBlacklist.add (input.readString());
+
+    if (input.readInt() != knownPluginListMagicNumber)
+        return false;
+
+    replaceAllTypes (newTypes, newBlacklist);
+    return true;
+}
+
+bool KnownPluginList::saveToCacheFile (const File& file) const
+{
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (out.failedToOpen())
+            return false;
+
+        writeToStream (out);
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+bool KnownPluginList::loadFromCacheFile (const File& file)
+{
+    MappedInputStream in (file);
+    return in.openedOk() && readFromStream (in);
+}
+
+//==============================================================================
+void KnownPluginList::addListener (Listener* listenerToAdd)         { listeners.add (listenerToAdd); }
+void KnownPluginList::removeListener (Listener* listenerToRemove)   { listeners.remove (listenerToRemove); }
+
 //==============================================================================
 struct PluginTreeUtils
 {
@@ -505,7 +751,13 @@ struct PluginTreeUtils
             const bool isItemTicked = addToMenu (*sub, subMenu, allPlugins, currentlyTickedPluginID);
             isTicked = isTicked || isItemTicked;
 
-            m.addSubMenu (sub->folder, subMenu, true, nullptr, isItemTicked, 0);
+            // the sub-menu is moved into place rather than copied, as these can be very large
+            PopupMenu::Item item;
+            item.text = sub->folder;
+            item.isEnabled = subMenu.getNumItems() > 0;
+            item.isTicked = isItemTicked;
+            item.subMenu = new PopupMenu (std::move (subMenu));
+            m.addItem (std::move (item));
         }
 
         for (auto* plugin : tree.plugins)
@@ -75,6 +75,13 @@ public:
     */
     PluginDescription* getTypeForIdentifierString (const String& identifierString) const;
 
+    /** Looks for a type in the list which has this uid.
+
+        Note that uids aren't always unique between formats, so if more than one type
+        has this uid, this returns the first one in the list.
+    */
+    PluginDescription* getTypeForUid (int uid) const;
+
     /** Adds a type manually from its description. */
     bool addType (const PluginDescription& type);
 
@@ -169,6 +176,33 @@ public:
     /** Recreates the state of this list from its stored XML format. */
     void recreateFromXml (const XmlElement& xml);
 
+    /** Writes the list and its blacklist to a stream, in a binary format that's much
+        quicker to load than the XML created by createXml().
+
+        The format may change between versions of JUCE, so it's best used as a cache
+        that can be rebuilt from the XML, rather than as the only copy of the list.
+
+        @see readFromStream, saveToCacheFile
+    */
+    void writeToStream (OutputStream& output) const;
+
+    /** Replaces the contents of this list with data that was written by writeToStream().
+
+        If the stream doesn't contain a valid list, this returns false and leaves the
+        list unchanged.
+    */
+    bool readFromStream (InputStream& input);
+
+    /** Writes the list to a file using writeToStream(). */
+    bool saveToCacheFile (const File& file) const;
+
+    /** Replaces the contents of this list with a file that was written by saveToCacheFile().
+
+        The file is memory-mapped rather than being read into memory first. If the
+        file doesn't exist or isn't valid, this returns false and leaves the list unchanged.
+    */
+    bool loadFromCacheFile (const File& file);
+
     //==============================================================================
     /** A structure that recursively holds a tree of plugins.
         @see KnownPluginList::createTree()
@@ -183,6 +217,50 @@ public:
     /** Creates a PluginTree object containing all the known plugins. */
     PluginTree* createTree (const SortMethod sortMethod) const;
 
+    //==============================================================================
+    /** Receives callbacks describing each change that is made to a KnownPluginList.
+
+        The list also sends a change message whenever it changes, but that doesn't say
+        what has changed, so anything that uses it has to re-read the whole list. These
+        callbacks let you update only the parts that are affected.
+
+        The callbacks are made synchronously by the thread that changed the list (which
+        may be a scanning thread rather than the message thread), after the list has
+        been updated and unlocked.
+
+        @see KnownPluginList::addListener
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called when a new type has been added to the list. */
+        virtual void knownPluginTypeAdded (KnownPluginList&, const PluginDescription&) {}
+
+        /** Called when a type that was already in the list has had its details replaced. */
+        virtual void knownPluginTypeChanged (KnownPluginList&, const PluginDescription&) {}
+
+        /** Called when a type has been removed from the list. */
+        virtual void knownPluginTypeRemoved (KnownPluginList&, const PluginDescription&) {}
+
+        /** Called when the types in the list have been re-ordered. */
+        virtual void knownPluginListReordered (KnownPluginList&) {}
+
+        /** Called when the whole list has been cleared, or replaced by loading a new one. */
+        virtual void knownPluginListReplaced (KnownPluginList&) {}
+
+        /** Called when files have been added to or removed from the blacklist. */
+        virtual void knownPluginBlacklistChanged (KnownPluginList&) {}
+    };
+
+    /** Registers a listener to be told about changes to the list. */
+    void addListener (Listener* listenerToAdd);
+
+    /** Deregisters a previously-registered listener. */
+    void removeListener (Listener* listenerToRemove);
+
     //==============================================================================
     class CustomScanner
     {
@@ -218,6 +296,13 @@ private:
     StringArray blacklist;
     ScopedPointer<CustomScanner> scanner;
     CriticalSection scanLock, typesArrayLock;
+    ListenerList<Listener> listeners;
+
+    struct TypeIndex;
+    mutable ScopedPointer<TypeIndex> typeIndex;
+    TypeIndex& getTypeIndex() const;
+
+    void replaceAllTypes (OwnedArray<PluginDescription>&, const StringArray&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginList)
 };
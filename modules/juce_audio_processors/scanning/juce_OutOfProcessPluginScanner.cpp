@@ -0,0 +1,472 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static const char* const pluginScannerCommandLineID = "jucePluginScanWorker";
+
+static MemoryBlock xmlToMemoryBlock (const XmlElement& xml)
+{
+    auto text = xml.createDocument (String(), true, false);
+    return MemoryBlock (text.toRawUTF8(), text.getNumBytesAsUTF8());
+}
+
+static XmlElement* memoryBlockToXml (const MemoryBlock& block)
+{
+    return XmlDocument::parse (block.toString());
+}
+
+//==============================================================================
+struct OutOfProcessPluginScanner::WorkerProcess  : public ChildProcessMaster
+{
+    WorkerProcess() {}
+
+    bool launch (const File& executable)
+    {
+        // (nothing reads the worker's output, so it mustn't fill up a pipe and block)
+        return launchSlaveProcess (executable, pluginScannerCommandLineID, 0, 0);
+    }
+
+    /** Asks the worker to scan a file, and waits for its answer.
+        Returns false if the worker died, hung or was abandoned, in which case it
+        mustn't be used again.
+    */
+    bool scan (const String& formatName, const String& fileOrIdentifier,
+               OwnedArray<PluginDescription>& result, int timeoutMs,
+               const KnownPluginList::CustomScanner& scanner)
+    {
+        {
+            const ScopedLock sl (replyLock);
+            reply = MemoryBlock();
+            hasReplied = false;
+        }
+
+        XmlElement request ("SCAN");
+        request.setAttribute ("format", formatName);
+        request.setAttribute ("identifier", fileOrIdentifier);
+        request.setAttribute ("timeout", timeoutMs);
+
+        if (connectionLost.get() != 0 || ! sendMessageToSlave (xmlToMemoryBlock (request)))
+            return false;
+
+        auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        for (;;)
+        {
+            replyReceived.wait (100);
+
+            if (connectionLost.get() != 0 || scanner.shouldExit())
+                return false;
+
+            {
+                const ScopedLock sl (replyLock);
+
+                if (hasReplied)
+                {
+                    ScopedPointer<XmlElement> xml (memoryBlockToXml (reply));
+
+                    if (xml == nullptr || ! xml->hasTagName ("SCANRESULT"))
+                        return false;
+
+                    forEachXmlChildElement (*xml, e)
+                    {
+                        PluginDescription desc;
+
+                        if (desc.loadFromXml (*e))
+                            result.add (new PluginDescription (desc));
+                    }
+
+                    return true;
+                }
+            }
+
+            if (Time::getMillisecondCounter() > endTime)
+                return false;
+        }
+    }
+
+    void handleMessageFromSlave (const MemoryBlock& message) override
+    {
+        {
+            const ScopedLock sl (replyLock);
+            reply = message;
+            hasReplied = true;
+        }
+
+        replyReceived.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        connectionLost = 1;
+        replyReceived.signal();
+    }
+
+    CriticalSection replyLock;
+    MemoryBlock reply;
+    bool hasReplied = false;
+    WaitableEvent replyReceived;
+    Atomic<int> connectionLost;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerProcess)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const File& executable, int maxWorkers,
+                                                      int timeoutMs, const File& scanCacheFile)
+    : workerExecutable (executable),
+      maxNumWorkers (jmax (1, maxWorkers)),
+      scanTimeoutMs (timeoutMs),
+      cacheFile (scanCacheFile)
+{
+    if (cacheFile.existsAsFile())
+        cache = XmlDocument::parse (cacheFile);
+
+    if (cache == nullptr || ! cache->hasTagName ("SCANCACHE"))
+        cache = new XmlElement ("SCANCACHE");
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    // all the scans should have finished before the scanner is deleted!
+    jassert (numWorkers == idleWorkers.size());
+
+    idleWorkers.clear();
+    saveScanCache();
+}
+
+//==============================================================================
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    bool succeeded = false;
+
+    if (findCachedResult (format, fileOrIdentifier, result, succeeded))
+        return succeeded;
+
+    if (auto* worker = acquireWorker())
+    {
+        OwnedArray<PluginDescription> found;
+        succeeded = worker->scan (format.getName(), fileOrIdentifier, found, scanTimeoutMs, *this);
+
+        releaseWorker (worker, succeeded);
+
+        // if the scan was abandoned, don't let the plugin get blacklisted for it
+        if (shouldExit())
+            return true;
+
+        addCachedResult (format, fileOrIdentifier, found, succeeded);
+        result.addCopiesOf (found);
+        return succeeded;
+    }
+
+    if (shouldExit())
+        return true;
+
+    // couldn't launch a worker (is the executable set up correctly?), so fall back
+    // on scanning the plugin in this process.
+    jassertfalse;
+    format.findAllTypesForFile (result, fileOrIdentifier);
+    return true;
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    {
+        const ScopedLock sl (workerLock);
+        numWorkers -= idleWorkers.size();
+        idleWorkers.clear();
+    }
+
+    saveScanCache();
+}
+
+//==============================================================================
+OutOfProcessPluginScanner::WorkerProcess* OutOfProcessPluginScanner::acquireWorker()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (workerLock);
+
+            if (! idleWorkers.isEmpty())
+                return idleWorkers.removeAndReturn (idleWorkers.size() - 1);
+
+            if (numWorkers < maxNumWorkers)
+            {
+                ++numWorkers;
+                break;
+            }
+        }
+
+        if (shouldExit())
+            return nullptr;
+
+        workerReleased.wait (100);
+    }
+
+    ScopedPointer<WorkerProcess> worker (new WorkerProcess());
+
+    if (worker->launch (workerExecutable))
+        return worker.release();
+
+    releaseWorker (nullptr, false);
+    return nullptr;
+}
+
+void OutOfProcessPluginScanner::releaseWorker (WorkerProcess* worker, bool isStillUsable)
+{
+    ScopedPointer<WorkerProcess> workerToDelete;
+
+    {
+        const ScopedLock sl (workerLock);
+
+        if (isStillUsable)
+        {
+            idleWorkers.add (worker);
+        }
+        else
+        {
+            workerToDelete = worker;
+            --numWorkers;
+        }
+    }
+
+    // (deleting the worker disconnects from it, which makes its process terminate itself)
+    workerToDelete = nullptr;
+    workerReleased.signal();
+}
+
+//==============================================================================
+static bool getFileStamp (const String& fileOrIdentifier, int64& modificationTime, int64& size)
+{
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return false;
+
+    File file (fileOrIdentifier);
+
+    if (! file.exists())
+        return false;
+
+    modificationTime = file.getLastModificationTime().toMilliseconds();
+    size = file.getSize();
+    return true;
+}
+
+static XmlElement* findCacheEntry (XmlElement& cache, const String& formatName, const String& fileOrIdentifier)
+{
+    forEachXmlChildElementWithTagName (cache, e, "FILE")
+        if (e->getStringAttribute ("identifier") == fileOrIdentifier
+             && e->getStringAttribute ("format") == formatName)
+            return e;
+
+    return nullptr;
+}
+
+bool OutOfProcessPluginScanner::findCachedResult (AudioPluginFormat& format, const String& fileOrIdentifier,
+                                                  OwnedArray<PluginDescription>& result, bool& succeeded)
+{
+    int64 modificationTime, size;
+
+    if (cacheFile == File() || ! getFileStamp (fileOrIdentifier, modificationTime, size))
+        return false;
+
+    const ScopedLock sl (cacheLock);
+
+    auto* entry = findCacheEntry (*cache, format.getName(), fileOrIdentifier);
+
+    if (entry == nullptr
+         || entry->getStringAttribute ("modified").getLargeIntValue() != modificationTime
+         || entry->getStringAttribute ("size").getLargeIntValue() != size)
+        return false;
+
+    forEachXmlChildElement (*entry, e)
+    {
+        PluginDescription desc;
+
+        if (desc.loadFromXml (*e))
+            result.add (new PluginDescription (desc));
+    }
+
+    succeeded = entry->getBoolAttribute ("loaded");
+    return true;
+}
+
+void OutOfProcessPluginScanner::addCachedResult (AudioPluginFormat& format, const String& fileOrIdentifier,
+                                                 const OwnedArray<PluginDescription>& found, bool succeeded)
+{
+    int64 modificationTime, size;
+
+    if (cacheFile == File() || ! getFileStamp (fileOrIdentifier, modificationTime, size))
+        return;
+
+    const ScopedLock sl (cacheLock);
+
+    if (auto* oldEntry = findCacheEntry (*cache, format.getName(), fileOrIdentifier))
+        cache->removeChildElement (oldEntry, true);
+
+    auto* entry = cache->createNewChildElement ("FILE");
+    entry->setAttribute ("format", format.getName());
+    entry->setAttribute ("identifier", fileOrIdentifier);
+    entry->setAttribute ("modified", String (modificationTime));
+    entry->setAttribute ("size", String (size));
+    entry->setAttribute ("loaded", succeeded);
+
+    for (auto* desc : found)
+        entry->addChildElement (desc->createXml());
+
+    cacheChanged = true;
+}
+
+void OutOfProcessPluginScanner::clearScanCache()
+{
+    const ScopedLock sl (cacheLock);
+    cache->deleteAllChildElements();
+    cacheChanged = true;
+}
+
+void OutOfProcessPluginScanner::saveScanCache()
+{
+    const ScopedLock sl (cacheLock);
+
+    if (cacheChanged && cacheFile != File())
+    {
+        cache->writeToFile (cacheFile, String());
+        cacheChanged = false;
+    }
+}
+
+//==============================================================================
+/*  If a plugin hangs the worker's message thread, the connection can't deliver its
+    connection-lost callback, so this thread makes sure that the process will still
+    go away once the scanner has given up waiting for it.
+*/
+struct OutOfProcessPluginScanner::Worker::Watchdog  : private Thread
+{
+    Watchdog()  : Thread ("Plugin scan watchdog")
+    {
+        startThread();
+    }
+
+    ~Watchdog()
+    {
+        stopThread (1000);
+    }
+
+    void scanStarted (int timeoutMs) noexcept
+    {
+        // (this allows a bit of extra time, so that the scanner will normally notice first)
+        deadline = (int64) Time::getMillisecondCounter() + timeoutMs + 1000;
+    }
+
+    void scanFinished() noexcept
+    {
+        deadline = 0;
+    }
+
+private:
+    Atomic<int64> deadline;
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            auto scanDeadline = deadline.get();
+
+            if (scanDeadline != 0 && (int64) Time::getMillisecondCounter() > scanDeadline)
+                Process::terminate();
+
+            wait (100);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Watchdog)
+};
+
+OutOfProcessPluginScanner::Worker::Worker()
+{
+    formatManager.addDefaultFormats();
+}
+
+OutOfProcessPluginScanner::Worker::~Worker() {}
+
+bool OutOfProcessPluginScanner::Worker::initialiseFromCommandLine (const String& commandLine)
+{
+    if (! ChildProcessSlave::initialiseFromCommandLine (commandLine, pluginScannerCommandLineID))
+        return false;
+
+    watchdog = new Watchdog();
+    return true;
+}
+
+void OutOfProcessPluginScanner::Worker::handleMessageFromMaster (const MemoryBlock& message)
+{
+    ScopedPointer<XmlElement> request (memoryBlockToXml (message));
+
+    if (request == nullptr || ! request->hasTagName ("SCAN"))
+        return;
+
+    auto formatName = request->getStringAttribute ("format");
+    auto fileOrIdentifier = request->getStringAttribute ("identifier");
+    watchdog->scanStarted (request->getIntAttribute ("timeout", 30000));
+
+    // plugins generally expect to be loaded on the message thread
+    MessageManager::callAsync ([this, formatName, fileOrIdentifier]
+    {
+        XmlElement result ("SCANRESULT");
+
+        for (int i = 0; i < formatManager.getNumFormats(); ++i)
+        {
+            auto* format = formatManager.getFormat (i);
+
+            if (format->getName() == formatName)
+            {
+                OwnedArray<PluginDescription> found;
+                format->findAllTypesForFile (found, fileOrIdentifier);
+
+                for (auto* desc : found)
+                    result.addChildElement (desc->createXml());
+
+                break;
+            }
+        }
+
+        watchdog->scanFinished();
+        sendMessageToMaster (xmlToMemoryBlock (result));
+    });
+}
+
+void OutOfProcessPluginScanner::Worker::handleConnectionLost()
+{
+    // This gets called on the connection's thread, so it'll still happen if a plugin
+    // has hung the message thread. There's nothing else for this process to do, and no
+    // point in trying to shut the hung plugin down cleanly.
+    Process::terminate();
+}
+
+} // namespace juce
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a separate child
+    process, so that plugins which crash or hang can't take the host down with them.
+
+    The scanner keeps a pool of worker processes, and each call to findPluginTypesFor()
+    borrows one of them for the plugin it's scanning. Because KnownPluginList doesn't hold
+    any locks while its custom scanner is busy, several threads can scan at once, each with
+    its own worker - e.g. a PluginListComponent whose setNumberOfThreadsForScanning() has been
+    given the same number of threads as the scanner has workers. The types that are found
+    get added to the KnownPluginList as each plugin finishes, so its change messages report
+    the results as they come in.
+
+    A worker that crashes, or that doesn't reply within the timeout, is discarded and its
+    plugin is reported as having failed, which makes the KnownPluginList blacklist it.
+
+    If you give it a cache file, the scanner remembers the result of every file that it has
+    scanned, along with the file's modification time and size, and won't launch a worker
+    for a file again until one of those changes.
+
+    The worker processes are copies of an executable which must create an
+    OutOfProcessPluginScanner::Worker at startup - see the Worker class for details.
+
+    @see KnownPluginList::setCustomScanner, PluginListComponent
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param workerExecutable     the executable to launch for each worker process. This is
+                                    often the host app itself (File::currentExecutableFile).
+        @param maxNumWorkers        the maximum number of worker processes that can be running
+                                    at the same time
+        @param scanTimeoutMs        how long a worker is given to scan a single file before the
+                                    plugin is assumed to have hung
+        @param scanCacheFile        if this isn't File(), it's used to store the results of previous
+                                    scans, so that unchanged files don't get loaded again
+    */
+    OutOfProcessPluginScanner (const File& workerExecutable,
+                               int maxNumWorkers,
+                               int scanTimeoutMs = 30000,
+                               const File& scanCacheFile = File());
+
+    /** Destructor. */
+    ~OutOfProcessPluginScanner();
+
+    //==============================================================================
+    /** Forgets all the results in the scan cache, so that every file will be scanned again. */
+    void clearScanCache();
+
+    /** Writes the scan cache to its file, if it has changed.
+        This also happens when a scan finishes, and when the scanner is deleted.
+    */
+    void saveScanCache();
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        The child-process end of an OutOfProcessPluginScanner.
+
+        The executable that the scanner launches must create one of these at startup and
+        call initialiseFromCommandLine(). E.g. in your JUCEApplication:
+
+        @code
+        void initialise (const String& commandLine) override
+        {
+            scanWorker = new OutOfProcessPluginScanner::Worker();
+
+            if (scanWorker->initialiseFromCommandLine (commandLine))
+                return; // this process is a scanning worker, so don't create any UI
+
+            scanWorker = nullptr;
+            ...
+        @endcode
+
+        The worker scans each plugin that it's asked about on its message thread, using the
+        formats in its AudioPluginFormatManager. It terminates its process as soon as the
+        scanner disconnects from it, or if a plugin keeps it busy for longer than the
+        scanner's timeout.
+    */
+    class JUCE_API  Worker  : private ChildProcessSlave
+    {
+    public:
+        /** Creates a worker, with the default plugin formats in its format manager. */
+        Worker();
+
+        /** Destructor. */
+        ~Worker();
+
+        /** Checks whether this process was launched as a scanning worker, and if it was,
+            connects it to the scanner that launched it and returns true.
+        */
+        bool initialiseFromCommandLine (const String& commandLine);
+
+        /** Returns the format manager that's used to scan plugins, so that you can add
+            any custom formats to it before calling initialiseFromCommandLine().
+        */
+        AudioPluginFormatManager& getFormatManager() noexcept       { return formatManager; }
+
+    private:
+        struct Watchdog;
+        friend struct ContainerDeletePolicy<Watchdog>;
+
+        AudioPluginFormatManager formatManager;
+        ScopedPointer<Watchdog> watchdog;
+
+        void handleMessageFromMaster (const MemoryBlock&) override;
+        void handleConnectionLost() override;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    struct WorkerProcess;
+    friend struct WorkerProcess;
+    friend struct ContainerDeletePolicy<WorkerProcess>;
+
+    const File workerExecutable;
+    const int maxNumWorkers, scanTimeoutMs;
+
+    OwnedArray<WorkerProcess> idleWorkers;
+    int numWorkers = 0;
+    CriticalSection workerLock;
+    WaitableEvent workerReleased;
+
+    const File cacheFile;
+    ScopedPointer<XmlElement> cache;
+    bool cacheChanged = false;
+    CriticalSection cacheLock;
+
+    WorkerProcess* acquireWorker();
+    void releaseWorker (WorkerProcess*, bool isStillUsable);
+
+    bool findCachedResult (AudioPluginFormat&, const String&, OwnedArray<PluginDescription>&, bool& succeeded);
+    void addCachedResult (AudioPluginFormat&, const String&, const OwnedArray<PluginDescription>&, bool succeeded);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
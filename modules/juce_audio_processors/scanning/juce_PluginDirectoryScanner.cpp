@@ -93,14 +93,20 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             OwnedArray<PluginDescription> typesFound;
 
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+            {
+                const ScopedLock sl (deadMansPedalLock);
+                auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+                crashedPlugins.removeString (file);
+                crashedPlugins.add (file);
+                setDeadMansPedalFile (crashedPlugins);
+            }
 
             list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
 
             // Managed to load without crashing, so remove it from the dead-man's-pedal..
+            // (this is re-read, because other threads may be scanning at the same time)
+            const ScopedLock sl (deadMansPedalLock);
+            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
             crashedPlugins.removeString (file);
             setDeadMansPedalFile (crashedPlugins);
 
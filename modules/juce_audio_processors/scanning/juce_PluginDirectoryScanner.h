@@ -118,6 +118,7 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    CriticalSection deadMansPedalLock;
     Atomic<int> nextIndex;
     float progress = 0;
     const bool allowAsync;
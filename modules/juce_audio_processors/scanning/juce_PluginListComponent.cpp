@@ -164,6 +164,7 @@ PluginListComponent::PluginListComponent (AudioPluginFormatManager& manager, Kno
 
     setSize (400, 600);
     list.addChangeListener (this);
+    list.addListener (this);
     updateList();
     table.getHeader().reSortTable();
 
@@ -173,6 +174,7 @@ PluginListComponent::PluginListComponent (AudioPluginFormatManager& manager, Kno
 
 PluginListComponent::~PluginListComponent()
 {
+    list.removeListener (this);
     list.removeChangeListener (this);
 }
 
@@ -206,10 +208,20 @@ void PluginListComponent::resized()
 
 void PluginListComponent::changeListenerCallback (ChangeBroadcaster*)
 {
-    table.getHeader().reSortTable();
+    // Removing or re-ordering types doesn't affect the order of the ones that are left,
+    // so the table only needs re-sorting if some types have been added or changed.
+    if (needsResorting.exchange (false))
+        table.getHeader().reSortTable();
+
     updateList();
 }
 
+// These may be called by a scanning thread, so they just make a note that the
+// table needs re-sorting when the change message arrives.
+void PluginListComponent::knownPluginTypeAdded (KnownPluginList&, const PluginDescription&)     { needsResorting = true; }
+void PluginListComponent::knownPluginTypeChanged (KnownPluginList&, const PluginDescription&)   { needsResorting = true; }
+void PluginListComponent::knownPluginListReplaced (KnownPluginList&)                            { needsResorting = true; }
+
 void PluginListComponent::updateList()
 {
     table.updateContent();
@@ -35,6 +35,7 @@ namespace juce
 class JUCE_API  PluginListComponent   : public Component,
                                         public FileDragAndDropTarget,
                                         private ChangeListener,
+                                        private KnownPluginList::Listener,
                                         private Button::Listener
 {
 public:
@@ -102,6 +103,7 @@ private:
     String dialogTitle, dialogText;
     bool allowAsync;
     int numThreads;
+    std::atomic<bool> needsResorting { false };
 
     class TableModel;
     ScopedPointer<TableListBoxModel> tableModel;
@@ -125,6 +127,9 @@ private:
     void filesDropped (const StringArray&, int, int) override;
     void buttonClicked (Button*) override;
     void changeListenerCallback (ChangeBroadcaster*) override;
+    void knownPluginTypeAdded (KnownPluginList&, const PluginDescription&) override;
+    void knownPluginTypeChanged (KnownPluginList&, const PluginDescription&) override;
+    void knownPluginListReplaced (KnownPluginList&) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginListComponent)
 };
@@ -27,10 +27,105 @@
 namespace juce
 {
 
+/*  Parameter values live in fixed-size blocks of contiguous floats, so that a processor
+    reading lots of them touches as few cache lines as possible, and so that the pointers
+    handed out by getRawParameterValue() never move when more parameters are added.
+*/
+struct AudioProcessorValueTreeState::ValueStorage
+{
+    float& allocate (float initialValue)
+    {
+        if (numValues % valuesPerBlock == 0)
+            blocks.add (new Block());
+
+        auto& v = blocks.getLast()->values[numValues++ % valuesPerBlock];
+        v = initialValue;
+        return v;
+    }
+
+private:
+    enum { valuesPerBlock = 128 };
+
+    struct Block  { float values[valuesPerBlock]; };
+
+    OwnedArray<Block> blocks;
+    int numValues = 0;
+};
+
+//==============================================================================
+/*  A bounded, lock-free queue of the indices of parameters whose values have changed,
+    which the message thread drains in order to update the ValueTree.
+
+    Each parameter only posts itself when its needsUpdate flag goes from 0 to 1, and the
+    flag is only cleared once its entry has been taken out again, so there can never be more
+    entries in flight than there are parameters. That means post() can't overflow and never
+    needs to block, even if several threads are setting values at once.
+*/
+struct AudioProcessorValueTreeState::ChangeQueue
+{
+    /** Must only be called while nothing else can be posting, i.e. while parameters are being created. */
+    void ensureCapacity (int numParameters)
+    {
+        if (numParameters <= capacity)
+            return;
+
+        auto newCapacity = jmax (64, (int) nextPowerOfTwo (numParameters));
+        HeapBlock<Atomic<int>> newSlots ((size_t) newCapacity, true);
+
+        auto numPending = 0;
+
+        for (auto i = readPosition; i != writePosition.get(); ++i)
+            if (auto entry = slots[(int) (i & (uint32) (capacity - 1))].get())
+                newSlots[numPending++].set (entry);
+
+        slots.swapWith (newSlots);
+        capacity = newCapacity;
+        readPosition = 0;
+        writePosition = (uint32) numPending;
+    }
+
+    /** Called on whichever thread has just set a parameter's needsUpdate flag. */
+    void post (int parameterIndex) noexcept
+    {
+        jassert (capacity > 0);
+
+        auto position = ++writePosition - 1;
+        slots[(int) (position & (uint32) (capacity - 1))].set (parameterIndex + 1);
+    }
+
+    /** Called on the message thread: returns the index of the next parameter that's
+        changed, or -1 if there aren't any more.
+    */
+    int pop() noexcept
+    {
+        if (capacity == 0)
+            return -1;
+
+        auto& slot = slots[(int) (readPosition & (uint32) (capacity - 1))];
+
+        // (an empty slot can also mean that a writer has claimed it but not filled it in
+        // yet - in which case it'll be picked up on the next timer callback)
+        auto entry = slot.exchange (0);
+
+        if (entry == 0)
+            return -1;
+
+        ++readPosition;
+        return entry - 1;
+    }
+
+private:
+    HeapBlock<Atomic<int>> slots;
+    int capacity = 0;
+    Atomic<uint32> writePosition;
+    uint32 readPosition = 0;
+};
+
+//==============================================================================
 struct AudioProcessorValueTreeState::Parameter   : public AudioProcessorParameterWithID,
                                                    private ValueTree::Listener
 {
-    Parameter (AudioProcessorValueTreeState& s,
+    Parameter (AudioProcessorValueTreeState& s, int index,
                const String& parameterID, const String& paramName, const String& labelText,
                NormalisableRange<float> r, float defaultVal,
                std::function<String (float)> valueToText,
@@ -39,15 +134,16 @@ struct AudioProcessorValueTreeState::Parameter   : public AudioProcessorParamete
                bool automatable,
                bool discrete)
         : AudioProcessorParameterWithID (parameterID, paramName, labelText),
-          owner (s), valueToTextFunction (valueToText), textToValueFunction (textToValue),
-          range (r), value (defaultVal), defaultValue (defaultVal),
+          owner (s), indexInState (index), idHash (XXHash64::hash (StringRef (parameterID))),
+          valueToTextFunction (valueToText), textToValueFunction (textToValue),
+          range (r), value (s.values->allocate (defaultVal)), defaultValue (defaultVal),
           listenersNeedCalling (true),
           isMetaParam (meta),
           isAutomatableParam (automatable),
           isDiscreteParam (discrete)
     {
         state.addListener (this);
-        needsUpdate.set (1);
+        markAsChanged();
     }
 
     ~Parameter()
@@ -87,13 +183,21 @@ struct AudioProcessorValueTreeState::Parameter   : public AudioProcessorParamete
         {
             value = newValue;
 
-            listeners.call (&AudioProcessorValueTreeState::Listener::parameterChanged, paramID, value);
+            if (! listeners.isEmpty())
+                listeners.call (&AudioProcessorValueTreeState::Listener::parameterChanged, paramID, value);
+
             listenersNeedCalling = false;
 
-            needsUpdate.set (1);
+            markAsChanged();
         }
     }
 
+    void markAsChanged() noexcept
+    {
+        if (needsUpdate.compareAndSetBool (1, 0))
+            owner.changeQueue->post (indexInState);
+    }
+
     void setNewState (const ValueTree& v)
     {
         state = v;
@@ -157,12 +261,15 @@ struct AudioProcessorValueTreeState::Parameter   : public AudioProcessorParamete
     bool isDiscrete() const override           { return isDiscreteParam; }
 
     AudioProcessorValueTreeState& owner;
+    const int indexInState;
+    const uint64 idHash;
     ValueTree state;
     ListenerList<AudioProcessorValueTreeState::Listener> listeners;
     std::function<String (float)> valueToTextFunction;
     std::function<float (const String&)> textToValueFunction;
     NormalisableRange<float> range;
-    float value, defaultValue;
+    float& value;
+    float defaultValue;
     Atomic<int> needsUpdate;
     bool listenersNeedCalling;
     const bool isMetaParam, isAutomatableParam, isDiscreteParam;
@@ -177,7 +284,9 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, U
       valueType ("PARAM"),
       valuePropertyID ("value"),
       idPropertyID ("id"),
-      updatingConnections (false)
+      updatingConnections (false),
+      values (new ValueStorage()),
+      changeQueue (new ChangeQueue())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -196,10 +305,13 @@ AudioProcessorParameterWithID* AudioProcessorValueTreeState::createAndAddParamet
     // All parameters must be created before giving this manager a ValueTree state!
     jassert (! state.isValid());
 
-    Parameter* p = new Parameter (*this, paramID, paramName, labelText, r,
+    changeQueue->ensureCapacity (parameters.size() + 1);
+
+    Parameter* p = new Parameter (*this, parameters.size(), paramID, paramName, labelText, r,
                                   defaultVal, valueToTextFunction, textToValueFunction,
                                   isMetaParameter, isAutomatableParameter,
                                   isDiscreteParameter);
+    parameters.add (p);
     processor.addParameter (p);
     return p;
 }
@@ -245,6 +357,171 @@ float* AudioProcessorValueTreeState::getRawParameterValue (StringRef paramID) co
     return nullptr;
 }
 
+//==============================================================================
+namespace BinaryStateHelpers
+{
+    static const int magicNumber = (int) ByteOrder::littleEndianInt ("APVB");
+    static const int formatVersion = 1;
+
+    enum Flags
+    {
+        isChangesOnly = 1,
+        hasOtherState = 2
+    };
+
+    // returns a copy of the state tree without the parameters' child trees in it
+    static ValueTree getNonParameterState (const ValueTree& state, const Identifier& parameterType)
+    {
+        ValueTree other (state.getType());
+        other.copyPropertiesFrom (state, nullptr);
+
+        for (int i = 0; i < state.getNumChildren(); ++i)
+        {
+            auto child = state.getChild (i);
+
+            if (! child.hasType (parameterType))
+                other.addChild (child.createCopy(), -1, nullptr);
+        }
+
+        return other;
+    }
+}
+
+void AudioProcessorValueTreeState::copyStateToBinary (MemoryBlock& destData)
+{
+    writeParametersToBinary (destData, false);
+}
+
+void AudioProcessorValueTreeState::copyStateChangesToBinary (MemoryBlock& destData)
+{
+    writeParametersToBinary (destData, true);
+}
+
+void AudioProcessorValueTreeState::writeParametersToBinary (MemoryBlock& destData, bool onlyChangedValues)
+{
+    using namespace BinaryStateHelpers;
+
+    const int numParams = parameters.size();
+
+    if (lastSavedValues.size() != numParams)
+    {
+        lastSavedValues.clearQuick();
+        lastSavedValues.insertMultiple (0, std::numeric_limits<float>::quiet_NaN(), numParams);
+    }
+
+    int numToWrite = 0;
+
+    for (int i = 0; i < numParams; ++i)
+        if (! onlyChangedValues || parameters.getUnchecked (i)->value != lastSavedValues.getUnchecked (i))
+            ++numToWrite;
+
+    ValueTree otherState;
+
+    if (! onlyChangedValues && state.isValid())
+    {
+        otherState = getNonParameterState (state, valueType);
+
+        if (otherState.getNumProperties() == 0 && otherState.getNumChildren() == 0)
+            otherState = ValueTree();
+    }
+
+    destData.reset();
+    MemoryOutputStream out (destData, false);
+    out.preallocate ((size_t) (16 + numToWrite * 12));
+
+    out.writeInt (magicNumber);
+    out.writeInt (formatVersion);
+    out.writeInt ((onlyChangedValues ? isChangesOnly : 0) | (otherState.isValid() ? hasOtherState : 0));
+    out.writeInt (numToWrite);
+
+    for (int i = 0; i < numParams; ++i)
+    {
+        auto* p = parameters.getUnchecked (i);
+        const float v = p->value;
+
+        if (! onlyChangedValues || v != lastSavedValues.getUnchecked (i))
+        {
+            out.writeInt64 ((int64) p->idHash);
+            out.writeFloat (v);
+            lastSavedValues.setUnchecked (i, v);
+        }
+    }
+
+    if (otherState.isValid())
+        otherState.writeToStream (out);
+}
+
+bool AudioProcessorValueTreeState::replaceStateFromBinary (const void* data, size_t sizeInBytes)
+{
+    using namespace BinaryStateHelpers;
+
+    MemoryInputStream in (data, sizeInBytes, false);
+
+    if (sizeInBytes < 16 || in.readInt() != magicNumber)
+    {
+        // not one of ours, so see if it's an older XML state
+        ScopedPointer<XmlElement> xml (AudioProcessor::getXmlFromBinary (data, (int) sizeInBytes));
+
+        if (xml == nullptr || ! xml->hasTagName (state.getType().toString()))
+            return false;
+
+        state = ValueTree::fromXml (*xml);
+        return true;
+    }
+
+    if (in.readInt() > formatVersion)
+        return false;
+
+    const int flags = in.readInt();
+    const int numValues = in.readInt();
+
+    if (numValues < 0 || (int64) numValues * 12 > in.getNumBytesRemaining())
+        return false;
+
+    HashMap<uint64, Parameter*> parametersByHash (jmax (64, parameters.size() * 2));
+
+    for (auto* p : parameters)
+        parametersByHash.set (p->idHash, p);
+
+    HeapBlock<bool> parametersFound ((size_t) parameters.size() + 1, true);
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const uint64 hash = (uint64) in.readInt64();
+        const float v = in.readFloat();
+
+        if (auto* p = parametersByHash[hash])
+        {
+            p->setUnnormalisedValue (p->range.snapToLegalValue (v));
+            parametersFound[p->indexInState] = true;
+        }
+    }
+
+    if ((flags & isChangesOnly) == 0)
+    {
+        for (auto* p : parameters)
+            if (! parametersFound[p->indexInState])
+                p->setUnnormalisedValue (p->defaultValue);
+
+        if (state.isValid())
+        {
+            const ValueTree otherState ((flags & hasOtherState) != 0 ? ValueTree::readFromStream (in)
+                                                                     : ValueTree (state.getType()));
+
+            state.copyPropertiesFrom (otherState, undoManager);
+
+            for (int i = state.getNumChildren(); --i >= 0;)
+                if (! state.getChild (i).hasType (valueType))
+                    state.removeChild (i, undoManager);
+
+            for (int i = 0; i < otherState.getNumChildren(); ++i)
+                state.addChild (otherState.getChild (i).createCopy(), -1, undoManager);
+        }
+    }
+
+    return true;
+}
+
 ValueTree AudioProcessorValueTreeState::getOrCreateChildValueTree (const String& paramID)
 {
     ValueTree v (state.getChildWithProperty (idPropertyID, paramID));
@@ -307,21 +584,17 @@ void AudioProcessorValueTreeState::valueTreeParentChanged (ValueTree&) {}
 
 void AudioProcessorValueTreeState::timerCallback()
 {
-    const int numParams = processor.getParameters().size();
     bool anythingUpdated = false;
 
-    for (int i = 0; i < numParams; ++i)
+    for (int index; (index = changeQueue->pop()) >= 0;)
     {
-        AudioProcessorParameter* const ap = processor.getParameters().getUnchecked(i);
-        jassert (dynamic_cast<Parameter*> (ap) != nullptr);
+        Parameter* p = parameters.getUnchecked (index);
 
-        Parameter* p = static_cast<Parameter*> (ap);
-
-        if (p->needsUpdate.compareAndSetBool (0, 1))
-        {
-            p->copyValueToValueTree();
-            anythingUpdated = true;
-        }
+        // (this must be cleared before the value is read, so that any change that
+        // arrives while we're busy will post the parameter again)
+        p->needsUpdate.set (0);
+        p->copyValueToValueTree();
+        anythingUpdated = true;
     }
 
     startTimer (anythingUpdated ? 1000 / 50
@@ -126,6 +126,44 @@ public:
     /** Returns the range that was set when the given parameter was created. */
     NormalisableRange<float> getParameterRange (StringRef parameterID) const noexcept;
 
+    //==============================================================================
+    /** Writes the whole state to a compact binary block, which can be returned from
+        AudioProcessor::getStateInformation().
+
+        Rather than converting the ValueTree to XML, this writes each parameter's value
+        next to a hash of its ID, followed by any other properties and children that you've
+        added to the state tree, in ValueTree's binary format. That makes saving and loading
+        a processor with thousands of parameters much quicker.
+
+        @see replaceStateFromBinary, copyStateChangesToBinary
+    */
+    void copyStateToBinary (MemoryBlock& destData);
+
+    /** Writes just the parameters whose values have changed since the last call to
+        copyStateToBinary() or copyStateChangesToBinary().
+
+        This is useful for things like an undo history, where the state needs to be
+        captured very often but only a few parameters will have changed each time. The
+        block can be passed to replaceStateFromBinary(), which will only change the
+        parameters that it contains, so a set of changes needs to be applied on top of the
+        state that it was taken from. It doesn't include any of the other properties and
+        children in the state tree.
+    */
+    void copyStateChangesToBinary (MemoryBlock& destData);
+
+    /** Restores a state that was written by copyStateToBinary() or copyStateChangesToBinary().
+
+        To make it easy to move over from saving the state as XML, this will also accept a
+        block that was written with AudioProcessor::copyXmlToBinary(), as long as the XML's
+        tag is the same as the type of the state tree.
+
+        Any parameters that a full state doesn't mention are reset to their default values,
+        and any parameter IDs in it that aren't recognised are ignored.
+
+        @returns false if the data wasn't in a format that could be read
+    */
+    bool replaceStateFromBinary (const void* data, size_t sizeInBytes);
+
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
 
@@ -217,6 +255,10 @@ private:
     //==============================================================================
     struct Parameter;
     friend struct Parameter;
+    struct ValueStorage;
+    struct ChangeQueue;
+    friend struct ContainerDeletePolicy<ValueStorage>;
+    friend struct ContainerDeletePolicy<ChangeQueue>;
 
     ValueTree getOrCreateChildValueTree (const String&);
     void timerCallback() override;
@@ -229,8 +271,15 @@ private:
     void valueTreeRedirected (ValueTree&) override;
     void updateParameterConnectionsToChildTrees();
 
+    void writeParametersToBinary (MemoryBlock&, bool onlyChangedValues);
+
     Identifier valueType, valuePropertyID, idPropertyID;
     bool updatingConnections;
+    Array<float> lastSavedValues;
+
+    ScopedPointer<ValueStorage> values;
+    ScopedPointer<ChangeQueue> changeQueue;
+    Array<Parameter*> parameters;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorValueTreeState)
 };
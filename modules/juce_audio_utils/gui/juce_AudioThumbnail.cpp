@@ -91,16 +91,22 @@ public:
     LevelDataSource (AudioThumbnail& thumb, AudioFormatReader* newReader, int64 hash)
         : hashCode (hash), owner (thumb), reader (newReader)
     {
+        setTimeSlicePriority (TimeSliceClient::backgroundPriority);
     }
 
     LevelDataSource (AudioThumbnail& thumb, InputSource* src)
         : hashCode (src->hashCode()), owner (thumb), source (src)
     {
+        setTimeSlicePriority (TimeSliceClient::backgroundPriority);
     }
 
     ~LevelDataSource()
     {
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+
+        if (pool != nullptr)
+            for (auto* job : generatorJobs)
+                pool->removeJob (job, true, -1);
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -113,16 +119,30 @@ public:
 
         createReader();
 
+        // a reader that was passed to setReader() can be shared between threads if we can map it
+        if (source == nullptr)
+            if (auto* mappedReader = dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()))
+                canReadConcurrently = mappedReader->mapEntireFile();
+
         if (reader != nullptr)
         {
             lengthInSamples = reader->lengthInSamples;
             numChannels = reader->numChannels;
             sampleRate = reader->sampleRate;
 
+            if (auto* summaryCache = owner.cache.getPeakSummaryCache())
+                summary = summaryCache->getSummaryFor (hashCode, *reader);
+
             if (lengthInSamples <= 0 || isFullyLoaded())
+            {
                 reader = nullptr;
+            }
             else
+            {
+                initialiseChunks();
                 owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                startGeneratorJobs();
+            }
         }
     }
 
@@ -146,7 +166,10 @@ public:
             if (levels.size() < (int) reader->numChannels)
                 levels.insertMultiple (0, {}, (int) reader->numChannels - levels.size());
 
-            reader->readMaxLevels (startSample, numSamples, levels.getRawDataPointer(), (int) reader->numChannels);
+            if (summary != nullptr)
+                summary->readMaxLevels (*reader, startSample, numSamples, levels.getRawDataPointer(), (int) reader->numChannels);
+            else
+                reader->readMaxLevels (startSample, numSamples, levels.getRawDataPointer(), (int) reader->numChannels);
 
             lastReaderUseTime = Time::getMillisecondCounter();
         }
@@ -158,13 +181,22 @@ public:
         reader = nullptr;
     }
 
+    /** Tells the source which part of the file is on screen, so that the chunks
+        covering it get scanned before the rest.
+    */
+    void setVisibleRange (Range<int64> newVisibleRange) noexcept
+    {
+        const SpinLock::ScopedLockType sl (chunkLock);
+        visibleRange = newVisibleRange;
+    }
+
     int useTimeSlice() override
     {
         if (isFullyLoaded())
         {
             if (reader != nullptr && source != nullptr)
             {
-                if (Time::getMillisecondCounter() > lastReaderUseTime + timeBeforeDeletingReader)
+                if (Time::getMillisecondCounter() > lastReaderUseTime.get() + timeBeforeDeletingReader)
                     releaseResources();
                 else
                     return 200;
@@ -173,7 +205,7 @@ public:
             return -1;
         }
 
-        bool justFinished = false;
+        int chunk = -1;
 
         {
             const ScopedLock sl (readerLock);
@@ -181,17 +213,22 @@ public:
 
             if (reader != nullptr)
             {
-                if (! readNextBlock())
-                    return 0;
+                if (numChunks == 0)
+                    initialiseChunks();
 
-                justFinished = true;
+                chunk = claimNextChunk();
+
+                if (chunk >= 0)
+                    readChunk (chunk, timeSliceBuffer, timeSliceLevels);
             }
         }
 
-        if (justFinished)
-            owner.cache.storeThumb (owner, hashCode);
+        // (if all the remaining chunks are being read by the pool, just wait for them)
+        if (chunk < 0)
+            return 200;
 
-        return 200;
+        storeChunk (chunk, timeSliceLevels);
+        return 0;
     }
 
     bool isFullyLoaded() const noexcept
@@ -210,63 +247,305 @@ public:
     int64 hashCode = 0;
 
 private:
+    //==============================================================================
+    /** The levels generated from one chunk of the file, laid out channel by channel. */
+    struct ChunkLevels
+    {
+        HeapBlock<MinMaxValue> levels, fineLevels;
+        int numThumbSamps = 0, numFineSamps = 0;
+    };
+
+    /** Scans chunks of a memory-mapped file on one of the cache's pool threads. */
+    class GeneratorJob  : public ThreadPoolJob
+    {
+    public:
+        GeneratorJob (LevelDataSource& s)  : ThreadPoolJob ("Thumbnail generator"), owner (s) {}
+
+        JobStatus runJob() override
+        {
+            if (shouldExit())
+                return jobHasFinished;
+
+            auto chunk = owner.claimNextChunk();
+
+            if (chunk < 0)
+                return jobHasFinished;
+
+            owner.readChunk (chunk, buffer, levels);
+            owner.storeChunk (chunk, levels);
+
+            // returning to the pool after each chunk lets other thumbnails have a go
+            return jobNeedsRunningAgain;
+        }
+
+    private:
+        LevelDataSource& owner;
+        AudioSampleBuffer buffer;
+        ChunkLevels levels;
+
+        JUCE_DECLARE_NON_COPYABLE (GeneratorJob)
+    };
+
+    enum { thumbSamplesPerChunk = 256 };
+    enum { chunkPending = 0, chunkInProgress, chunkDone };
+
     AudioThumbnail& owner;
     ScopedPointer<InputSource> source;
     ScopedPointer<AudioFormatReader> reader;
     CriticalSection readerLock;
-    uint32 lastReaderUseTime = 0;
+    Atomic<uint32> lastReaderUseTime;
+    bool canReadConcurrently = false;
+    AudioPeakSummaryCache::Summary::Ptr summary;
+
+    HeapBlock<uint8> chunkStates;
+    int numChunks = 0, numContiguousChunksDone = 0;
+    int64 samplesPerChunk = 0;
+    Range<int64> visibleRange;
+    SpinLock chunkLock;
+
+    ThreadPool* pool = nullptr;
+    OwnedArray<GeneratorJob> generatorJobs;
+    AudioSampleBuffer timeSliceBuffer;
+    ChunkLevels timeSliceLevels;
 
     void createReader()
     {
         if (reader == nullptr && source != nullptr)
+        {
             if (InputStream* audioFileStream = source->createInputStream())
-                reader = owner.formatManagerToUse.createReaderFor (audioFileStream);
+            {
+                if (auto* fileStream = dynamic_cast<FileInputStream*> (audioFileStream))
+                    reader = createMappedReader (fileStream->getFile());
+
+                if (reader != nullptr)
+                    delete audioFileStream;
+                else
+                    reader = owner.formatManagerToUse.createReaderFor (audioFileStream);
+            }
+
+            // (createMappedReader() only returns readers that have been mapped successfully)
+            canReadConcurrently = (dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()) != nullptr);
+        }
     }
 
-    bool readNextBlock()
+    MemoryMappedAudioFormatReader* createMappedReader (const File& file) const
+    {
+        for (auto* format : owner.formatManagerToUse)
+        {
+            if (format->canHandleFile (file))
+            {
+                if (auto* mappedReader = format->createMemoryMappedReader (file))
+                {
+                    if (mappedReader->mapEntireFile())
+                        return mappedReader;
+
+                    delete mappedReader;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void startGeneratorJobs()
+    {
+        pool = owner.cache.getThreadPool();
+
+        if (pool != nullptr && canReadConcurrently)
+        {
+            for (int i = jmin (pool->getNumThreads(), numChunks - numContiguousChunksDone); --i >= 0;)
+            {
+                auto* job = generatorJobs.add (new GeneratorJob (*this));
+                pool->addJob (job, false);
+            }
+        }
+    }
+
+    //==============================================================================
+    void initialiseChunks()
+    {
+        const SpinLock::ScopedLockType sl (chunkLock);
+
+        samplesPerChunk = thumbSamplesPerChunk * (int64) owner.samplesPerThumbSample;
+        numChunks = (int) ((lengthInSamples + samplesPerChunk - 1) / samplesPerChunk);
+        numContiguousChunksDone = (int) jmin ((int64) numChunks, numSamplesFinished / samplesPerChunk);
+
+        chunkStates.calloc ((size_t) numChunks);
+
+        for (int i = 0; i < numContiguousChunksDone; ++i)
+            chunkStates[i] = chunkDone;
+    }
+
+    int findPendingChunk (int start, int end) const noexcept
+    {
+        for (int i = start; i < end; ++i)
+            if (chunkStates[i] == chunkPending)
+                return i;
+
+        return -1;
+    }
+
+    /** Picks the next chunk to scan: anything on screen comes first, then the rest
+        of the file following it, then whatever's left before it.
+    */
+    int claimNextChunk() noexcept
+    {
+        const SpinLock::ScopedLockType sl (chunkLock);
+
+        if (numChunks == 0)
+            return -1;
+
+        auto firstVisible = (int) jlimit ((int64) 0, (int64) numChunks, visibleRange.getStart() / samplesPerChunk);
+        auto endVisible   = (int) jlimit ((int64) firstVisible, (int64) numChunks, (visibleRange.getEnd() + samplesPerChunk - 1) / samplesPerChunk);
+
+        auto chunk = findPendingChunk (firstVisible, endVisible);
+
+        if (chunk < 0)  chunk = findPendingChunk (endVisible, numChunks);
+        if (chunk < 0)  chunk = findPendingChunk (numContiguousChunksDone, firstVisible);
+
+        if (chunk >= 0)
+            chunkStates[chunk] = chunkInProgress;
+
+        return chunk;
+    }
+
+    static void findLevels (const AudioSampleBuffer& buffer, MinMaxValue* dest,
+                            int numValues, int samplesPerValue) noexcept
+    {
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+        {
+            auto* samples = buffer.getReadPointer (chan);
+
+            for (int i = 0; i < numValues; ++i)
+                dest++->setFloat (FloatVectorOperations::findMinAndMax (samples + i * samplesPerValue, samplesPerValue));
+        }
+    }
+
+    /** True if levels of this size can be made from the shared peak summary. */
+    bool canUseSummaryFor (int samplesPerValue) const noexcept
+    {
+        return summary != nullptr && samplesPerValue % summary->getSamplesPerBlock() == 0;
+    }
+
+    /** Makes thumbnail levels from the shared peak summary, which only needs to read
+        the parts of the file that no other client has scanned yet.
+    */
+    void findLevelsFromSummary (int64 startSample, int numSamples, MinMaxValue* dest,
+                                int numValues, int samplesPerValue)
+    {
+        HeapBlock<Range<float>> ranges (numChannels);
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            auto start = startSample + i * (int64) samplesPerValue;
+            summary->readMaxLevels (*reader, start, jmin ((int64) samplesPerValue, startSample + numSamples - start),
+                                    ranges, (int) numChannels);
+
+            for (int chan = 0; chan < (int) numChannels; ++chan)
+                dest[chan * numValues + i].setFloat (ranges[chan]);
+        }
+    }
+
+    /** Reads a chunk of audio and reduces it to thumbnail levels. */
+    void readChunk (int chunk, AudioSampleBuffer& buffer, ChunkLevels& result)
     {
         jassert (reader != nullptr);
 
-        if (! isFullyLoaded())
+        auto startSample = chunk * samplesPerChunk;
+        auto numToDo = (int) jmin (samplesPerChunk, lengthInSamples - startSample);
+        auto samplesPerFineSample = owner.getSamplesPerFineSample();
+
+        result.numThumbSamps = sampleToThumbSample (startSample + numToDo) - sampleToThumbSample (startSample);
+        result.numFineSamps = samplesPerFineSample > 0 ? numToDo / samplesPerFineSample : 0;
+
+        if (result.numThumbSamps > 0 || result.numFineSamps > 0)
         {
-            auto numToDo = (int) jmin (256 * (int64) owner.samplesPerThumbSample, lengthInSamples - numSamplesFinished);
+            auto thumbLevelsFromSummary = canUseSummaryFor (owner.samplesPerThumbSample);
+            auto fineLevelsFromSummary  = result.numFineSamps == 0 || canUseSummaryFor (samplesPerFineSample);
+
+            if (! (thumbLevelsFromSummary && fineLevelsFromSummary))
+            {
+                buffer.setSize ((int) numChannels, numToDo, false, false, true);
+                reader->read (&buffer, 0, numToDo, startSample, true, true);
+            }
+
+            if (result.levels == nullptr)
+                result.levels.malloc ((size_t) (numChannels * thumbSamplesPerChunk));
+
+            if (thumbLevelsFromSummary)
+                findLevelsFromSummary (startSample, numToDo, result.levels, result.numThumbSamps, owner.samplesPerThumbSample);
+            else
+                findLevels (buffer, result.levels, result.numThumbSamps, owner.samplesPerThumbSample);
 
-            if (numToDo > 0)
+            if (result.numFineSamps > 0)
             {
-                auto startSample = numSamplesFinished;
+                if (result.fineLevels == nullptr)
+                    result.fineLevels.malloc ((size_t) (numChannels * (unsigned int) (samplesPerChunk / samplesPerFineSample)));
 
-                auto firstThumbIndex = sampleToThumbSample (startSample);
-                auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
-                auto numThumbSamps = lastThumbIndex - firstThumbIndex;
+                if (fineLevelsFromSummary)
+                    findLevelsFromSummary (startSample, numToDo, result.fineLevels, result.numFineSamps, samplesPerFineSample);
+                else
+                    findLevels (buffer, result.fineLevels, result.numFineSamps, samplesPerFineSample);
+            }
+        }
 
-                HeapBlock<MinMaxValue> levelData ((unsigned int) numThumbSamps * numChannels);
-                HeapBlock<MinMaxValue*> levels (numChannels);
+        lastReaderUseTime = Time::getMillisecondCounter();
+    }
+
+    void storeChunk (int chunk, const ChunkLevels& chunkLevels)
+    {
+        int64 samplesFinished;
+        bool justFinished;
+
+        {
+            const SpinLock::ScopedLockType sl (chunkLock);
 
+            chunkStates[chunk] = chunkDone;
+
+            while (numContiguousChunksDone < numChunks && chunkStates[numContiguousChunksDone] == chunkDone)
+                ++numContiguousChunksDone;
+
+            samplesFinished = jmin (lengthInSamples, numContiguousChunksDone * samplesPerChunk);
+            justFinished = samplesFinished >= lengthInSamples && numSamplesFinished < lengthInSamples;
+            numSamplesFinished = jmax (numSamplesFinished, samplesFinished);
+        }
+
+        {
+            const ScopedLock sl (owner.lock);
+
+            HeapBlock<const MinMaxValue*> channelLevels (numChannels);
+            auto numThumbSamps = chunkLevels.numThumbSamps;
+            auto numFineSamps = chunkLevels.numFineSamps;
+
+            if (numFineSamps > 0)
+            {
                 for (int i = 0; i < (int) numChannels; ++i)
-                    levels[i] = levelData + i * numThumbSamps;
+                    channelLevels[i] = chunkLevels.fineLevels + i * numFineSamps;
 
-                HeapBlock<Range<float>> levelsRead (numChannels);
+                owner.setFineLevels (channelLevels, (int) (chunk * samplesPerChunk / owner.getSamplesPerFineSample()),
+                                     (int) numChannels, numFineSamps);
+            }
 
-                for (int i = 0; i < numThumbSamps; ++i)
-                {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+            if (numThumbSamps > 0)
+            {
+                for (int i = 0; i < (int) numChannels; ++i)
+                    channelLevels[i] = chunkLevels.levels + i * numThumbSamps;
 
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
-                }
+                owner.setLevels (channelLevels, sampleToThumbSample (chunk * samplesPerChunk), (int) numChannels, numThumbSamps);
+            }
 
-                {
-                    const ScopedUnlock su (readerLock);
-                    owner.setLevels (levels, firstThumbIndex, (int) numChannels, numThumbSamps);
-                }
+            // chunks can finish out of order, so setLevels() won't always have moved this on
+            auto thumbSamplesFinished = sampleToThumbSample (samplesFinished) * (int64) owner.samplesPerThumbSample;
 
-                numSamplesFinished += numToDo;
-                lastReaderUseTime = Time::getMillisecondCounter();
+            if (thumbSamplesFinished > owner.numSamplesFinished)
+            {
+                owner.numSamplesFinished = thumbSamplesFinished;
+                owner.sendChangeMessage();
             }
         }
 
-        return isFullyLoaded();
+        if (justFinished)
+            owner.cache.storeThumb (owner, hashCode);
     }
 };
 
@@ -274,6 +553,11 @@ private:
 class AudioThumbnail::ThumbData
 {
 public:
+    /** Each coarse level holds one value for every levelRatio values in the level below it,
+        and the optional fine level holds levelRatio values for each one in the main data.
+    */
+    enum { levelRatio = 8, numCoarseLevels = 2 };
+
     ThumbData (const int numThumbSamples)
         : peakLevel (-1)
     {
@@ -293,31 +577,43 @@ public:
 
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
-        if (startSample >= 0)
-        {
-            endSample = jmin (endSample, data.size() - 1);
+        getMinMax (data, startSample, endSample, result);
+    }
 
-            int8 mx = -128;
-            int8 mn = 127;
+    /** Level 0 is the main data, and each level above that is levelRatio times coarser. */
+    void getMinMax (int level, int startSample, int endSample, MinMaxValue& result) const noexcept
+    {
+        jassert (isPositiveAndNotGreaterThan (level, (int) numCoarseLevels));
+        getMinMax (level == 0 ? data : coarseData[level - 1], startSample, endSample, result);
+    }
 
-            while (startSample <= endSample)
-            {
-                auto& v = data.getReference (startSample);
+    bool hasFineData() const noexcept
+    {
+        return fineData.size() > 0;
+    }
 
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+    /** Returns false if any of the fine values in this range haven't been written yet. */
+    bool getFineMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
+    {
+        if (startSample < 0 || endSample >= fineData.size())
+            return false;
 
-                ++startSample;
-            }
+        int8 mx = -128;
+        int8 mn = 127;
 
-            if (mn <= mx)
-            {
-                result.set (mn, mx);
-                return;
-            }
+        for (int i = startSample; i <= endSample; ++i)
+        {
+            auto& v = fineData.getReference (i);
+
+            if (! v.isNonZero())
+                return false;
+
+            if (v.getMinValue() < mn)  mn = v.getMinValue();
+            if (v.getMaxValue() > mx)  mx = v.getMaxValue();
         }
 
-        result.set (1, 0);
+        result.set (mn, mx);
+        return true;
     }
 
     void write (const MinMaxValue* values, int startIndex, int numValues)
@@ -331,6 +627,27 @@ public:
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateCoarseLevels (startIndex, numValues);
+    }
+
+    void writeFine (const MinMaxValue* values, int startIndex, int numValues)
+    {
+        auto extraNeeded = startIndex + numValues - fineData.size();
+
+        if (extraNeeded > 0)
+            fineData.insertMultiple (-1, MinMaxValue(), extraNeeded);
+
+        auto* dest = fineData.getRawDataPointer() + startIndex;
+
+        for (int i = 0; i < numValues; ++i)
+            dest[i] = values[i];
+    }
+
+    void rebuildCoarseLevels()
+    {
+        resetPeak();
+        updateCoarseLevels (0, data.size());
     }
 
     void resetPeak() noexcept
@@ -342,7 +659,8 @@ public:
     {
         if (peakLevel < 0)
         {
-            for (auto& s : data)
+            // (the top level has the same extremes as the main data, but far fewer values)
+            for (auto& s : coarseData[numCoarseLevels - 1])
             {
                 auto peak = s.getPeak();
 
@@ -355,9 +673,90 @@ public:
     }
 
 private:
-    Array<MinMaxValue> data;
+    Array<MinMaxValue> data, fineData;
+    Array<MinMaxValue> coarseData[numCoarseLevels];
     int peakLevel;
 
+    static void getMinMax (const Array<MinMaxValue>& levelData, int startSample, int endSample, MinMaxValue& result) noexcept
+    {
+        if (startSample >= 0)
+        {
+            endSample = jmin (endSample, levelData.size() - 1);
+
+            int8 mx = -128;
+            int8 mn = 127;
+
+            while (startSample <= endSample)
+            {
+                auto& v = levelData.getReference (startSample);
+
+                if (v.getMinValue() < mn)  mn = v.getMinValue();
+                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+
+                ++startSample;
+            }
+
+            if (mn <= mx)
+            {
+                result.set (mn, mx);
+                return;
+            }
+        }
+
+        result.set (1, 0);
+    }
+
+    void updateCoarseLevels (int startIndex, int numValues)
+    {
+        if (numValues <= 0)
+            return;
+
+        auto* source = &data;
+
+        for (auto& level : coarseData)
+        {
+            auto first = startIndex / levelRatio;
+            auto last  = (startIndex + numValues - 1) / levelRatio;
+            auto extraNeeded = last + 1 - level.size();
+
+            if (extraNeeded > 0)
+                level.insertMultiple (-1, MinMaxValue(), extraNeeded);
+
+            for (int i = first; i <= last; ++i)
+                level.getReference (i) = combine (*source, i * levelRatio);
+
+            source = &level;
+            startIndex = first;
+            numValues = last + 1 - first;
+        }
+    }
+
+    /** Merges a group of levelRatio values, skipping any that haven't been written. */
+    static MinMaxValue combine (const Array<MinMaxValue>& source, int start) noexcept
+    {
+        auto end = jmin (start + (int) levelRatio, source.size());
+        int8 mx = -128;
+        int8 mn = 127;
+
+        for (int i = start; i < end; ++i)
+        {
+            auto& v = source.getReference (i);
+
+            if (v.isNonZero())
+            {
+                if (v.getMinValue() < mn)  mn = v.getMinValue();
+                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+            }
+        }
+
+        MinMaxValue result;
+
+        if (mn < mx)
+            result.set (mn, mx);
+
+        return result;
+    }
+
     void ensureSize (int thumbSamples)
     {
         auto extraNeeded = thumbSamples - data.size();
@@ -458,7 +857,12 @@ private:
 
         ensureSize (numSamples);
 
-        if (timePerPixel * rate <= sampsPerThumbSample && levelData != nullptr)
+        auto samplesPerPixel = timePerPixel * rate;
+        auto samplesPerFineSample = sampsPerThumbSample / (int) ThumbData::levelRatio;
+        auto useFineData = samplesPerFineSample > 0 && samplesPerPixel >= samplesPerFineSample
+                            && chans.size() > 0 && chans.getUnchecked (0)->hasFineData();
+
+        if (samplesPerPixel <= sampsPerThumbSample && (levelData != nullptr || useFineData))
         {
             auto sample = roundToInt (startTime * rate);
             Array<Range<float>> levels;
@@ -470,7 +874,21 @@ private:
 
                 if (sample >= 0)
                 {
-                    if (sample >= levelData->lengthInSamples)
+                    auto usedFineData = useFineData
+                                         && copyFineData (chans, sample / samplesPerFineSample,
+                                                          jmax (sample, nextSample - 1) / samplesPerFineSample, i);
+
+                    if (usedFineData)
+                    {
+                        // (the high-resolution level had everything this pixel needs)
+                    }
+                    else if (levelData == nullptr)
+                    {
+                        for (int chan = 0; chan < numChannelsCached; ++chan)
+                            chans.getUnchecked (chan)->getMinMax (sample / sampsPerThumbSample, nextSample / sampsPerThumbSample,
+                                                                  *getData (chan, i));
+                    }
+                    else if (sample >= levelData->lengthInSamples)
                     {
                         for (int chan = 0; chan < numChannelsCached; ++chan)
                             *getData (chan, i) = MinMaxValue();
@@ -496,12 +914,24 @@ private:
         {
             jassert (chans.size() == numChannelsCached);
 
+            // use the coarsest level that still has levelRatio values for each pixel, so that
+            // the pixel boundaries don't get rounded too far
+            auto thumbSamplesPerPixel = samplesPerPixel / sampsPerThumbSample;
+            int level = 0, levelScale = 1;
+            const int ratio = ThumbData::levelRatio;
+
+            while (level < (int) ThumbData::numCoarseLevels && thumbSamplesPerPixel >= levelScale * ratio * ratio)
+            {
+                ++level;
+                levelScale *= ratio;
+            }
+
             for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
             {
                 ThumbData* channelData = chans.getUnchecked (channelNum);
                 MinMaxValue* cacheData = getData (channelNum, 0);
 
-                auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+                auto timeToThumbSampleFactor = rate / ((double) sampsPerThumbSample * levelScale);
 
                 startTime = cachedStart;
                 auto sample = roundToInt (startTime * timeToThumbSampleFactor);
@@ -510,7 +940,9 @@ private:
                 {
                     auto nextSample = roundToInt ((startTime + timePerPixel) * timeToThumbSampleFactor);
 
-                    channelData->getMinMax (sample, nextSample, *cacheData);
+                    // (the main level includes the value at nextSample, as it always has, but the
+                    // coarser ones leave it out, as it could reach a long way past this pixel)
+                    channelData->getMinMax (level, sample, level == 0 ? nextSample : jmax (sample, nextSample - 1), *cacheData);
 
                     ++cacheData;
                     startTime += timePerPixel;
@@ -522,6 +954,15 @@ private:
         return true;
     }
 
+    bool copyFineData (const OwnedArray<ThumbData>& chans, int startFineSample, int endFineSample, int cacheIndex)
+    {
+        for (int chan = 0; chan < numChannelsCached; ++chan)
+            if (! chans.getUnchecked (chan)->getFineMinMax (startFineSample, endFineSample, *getData (chan, cacheIndex)))
+                return false;
+
+        return true;
+    }
+
     MinMaxValue* getData (const int channelNum, const int cacheIndex) noexcept
     {
         jassert (isPositiveAndBelow (channelNum, numChannelsCached) && isPositiveAndBelow (cacheIndex, data.size()));
@@ -616,6 +1057,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked(chan)->getData(i)->read (input);
 
+    for (auto* c : channels)
+        c->rebuildCoarseLevels();
+
     return true;
 }
 
@@ -724,10 +1168,55 @@ void AudioThumbnail::addBlock (const int64 startSample, const AudioSampleBuffer&
             }
         }
 
+        if (auto samplesPerFineSample = getSamplesPerFineSample())
+        {
+            auto firstFineIndex = (int) (startSample / samplesPerFineSample);
+            auto numFineToDo = (int) ((startSample + numSamples + (samplesPerFineSample - 1)) / samplesPerFineSample) - firstFineIndex;
+
+            const HeapBlock<MinMaxValue> fineData (numFineToDo * numChans);
+            const HeapBlock<MinMaxValue*> fineChannels (numChans);
+
+            for (int chan = 0; chan < numChans; ++chan)
+            {
+                auto* sourceData = incoming.getReadPointer (chan, startOffsetInBuffer);
+                auto* dest = fineData + numFineToDo * chan;
+                fineChannels [chan] = dest;
+
+                for (int i = 0; i < numFineToDo; ++i)
+                {
+                    auto start = i * samplesPerFineSample;
+                    dest[i].setFloat (FloatVectorOperations::findMinAndMax (sourceData + start, jmin (samplesPerFineSample, numSamples - start)));
+                }
+            }
+
+            setFineLevels (fineChannels, firstFineIndex, numChans, numFineToDo);
+        }
+
         setLevels (thumbChannels, firstThumbIndex, numChans, numToDo);
     }
 }
 
+void AudioThumbnail::setFineLevels (const MinMaxValue* const* values, int fineIndex, int numChans, int numValues)
+{
+    const ScopedLock sl (lock);
+
+    for (int i = jmin (numChans, channels.size()); --i >= 0;)
+        channels.getUnchecked(i)->writeFine (values[i], fineIndex, numValues);
+}
+
+void AudioThumbnail::setHighResolutionLevelEnabled (bool shouldBeEnabled)
+{
+    highResolutionLevelEnabled = shouldBeEnabled;
+}
+
+int AudioThumbnail::getSamplesPerFineSample() const noexcept
+{
+    if (highResolutionLevelEnabled && samplesPerThumbSample % ThumbData::levelRatio == 0)
+        return samplesPerThumbSample / ThumbData::levelRatio;
+
+    return 0;
+}
+
 void AudioThumbnail::setLevels (const MinMaxValue* const* values, int thumbIndex, int numChans, int numValues)
 {
     const ScopedLock sl (lock);
@@ -807,6 +1296,9 @@ void AudioThumbnail::drawChannel (Graphics& g, const Rectangle<int>& area, doubl
 {
     const ScopedLock sl (lock);
 
+    if (source != nullptr && sampleRate > 0)
+        source->setVisibleRange ({ (int64) (startTime * sampleRate), (int64) (endTime * sampleRate) });
+
     window->drawChannel (g, area, startTime, endTime, channelNum, verticalZoomFactor,
                          sampleRate, numChannels, samplesPerThumbSample, source, channels);
 }
@@ -44,6 +44,10 @@ namespace juce
     The thumbnail stores an internal low-res version of the wave data, and this can
     be loaded and saved to avoid having to scan the file again.
 
+    If the AudioThumbnailCache was created with some generation threads and the file
+    can be memory-mapped, the scan is shared out between those threads, and the part of
+    the file that was most recently drawn is always scanned first.
+
     @see AudioThumbnailCache, AudioThumbnailBase
 */
 class JUCE_API  AudioThumbnail    : public AudioThumbnailBase
@@ -189,6 +193,20 @@ public:
     /** Returns the hash code that was set by setSource() or setReader(). */
     int64 getHashCode() const override;
 
+    /** Enables an extra, high-resolution level of detail in the thumbnail.
+
+        Alongside its main data, the thumbnail keeps coarser copies of it to draw
+        zoomed-out views quickly. If this is enabled, it'll also keep a level with eight
+        times the resolution of the main data, so that zoomed-in views only need to go back
+        to the audio source once there's less than one value per pixel. This needs eight times
+        as much memory as the main data, and doesn't get saved by saveTo(), so it's off by
+        default.
+
+        To have any effect, this must be called before setting the source, and
+        sourceSamplesPerThumbnailSample must be a multiple of 8.
+    */
+    void setHighResolutionLevelEnabled (bool shouldBeEnabled);
+
 private:
     //==============================================================================
     AudioFormatManager& formatManagerToUse;
@@ -214,11 +232,14 @@ private:
     int64 totalSamples = 0, numSamplesFinished = 0;
     int32 numChannels = 0;
     double sampleRate = 0;
+    bool highResolutionLevelEnabled = false;
     CriticalSection lock;
 
     void clearChannelData();
     bool setDataSource (LevelDataSource* newSource);
     void setLevels (const MinMaxValue* const* values, int thumbIndex, int numChans, int numValues);
+    void setFineLevels (const MinMaxValue* const* values, int fineIndex, int numChans, int numValues);
+    int getSamplesPerFineSample() const noexcept;
     void createChannels (int length);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnail)
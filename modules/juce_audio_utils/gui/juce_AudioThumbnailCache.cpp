@@ -27,6 +27,47 @@
 namespace juce
 {
 
+static inline int getThumbnailCacheFileMagicHeader() noexcept
+{
+    return (int) ByteOrder::littleEndianInt ("ThmC");
+}
+
+// Version 1 streams start with the "ThmC" header and hold uncompressed thumbnail
+// data. Since version 2 they start with "ThmV" and the version number, and each
+// thumbnail's data is zlib-compressed.
+static inline int getVersionedThumbnailCacheFileMagicHeader() noexcept
+{
+    return (int) ByteOrder::littleEndianInt ("ThmV");
+}
+
+enum { currentThumbnailCacheFormatVersion = 2 };
+
+static void writeThumbnailCacheHeader (OutputStream& out)
+{
+    out.writeInt (getVersionedThumbnailCacheFileMagicHeader());
+    out.writeInt (currentThumbnailCacheFormatVersion);
+}
+
+// Returns the format version, or 0 if the stream isn't a thumbnail cache
+static int readThumbnailCacheHeader (InputStream& in)
+{
+    auto magic = in.readInt();
+
+    if (magic == getThumbnailCacheFileMagicHeader())
+        return 1;
+
+    if (magic == getVersionedThumbnailCacheFileMagicHeader())
+    {
+        auto version = in.readInt();
+
+        if (version >= 2 && version <= currentThumbnailCacheFormatVersion)
+            return version;
+    }
+
+    return 0;
+}
+
+//==============================================================================
 class AudioThumbnailCache::ThumbnailCacheEntry
 {
 public:
@@ -36,19 +77,66 @@ public:
     {
     }
 
-    ThumbnailCacheEntry (InputStream& in)
+    ~ThumbnailCacheEntry()
+    {
+        getMemoryUsage().remove (accountedBytes);
+    }
+
+    ThumbnailCacheEntry (InputStream& in, int formatVersion)
         : hash (in.readInt64()),
           lastUsed (0)
     {
         const int64 len = in.readInt64();
-        in.readIntoMemoryBlock (data, (ssize_t) len);
+
+        if (formatVersion < 2)
+        {
+            in.readIntoMemoryBlock (data, (ssize_t) len);
+            updateMemoryUsage();
+            return;
+        }
+
+        const int64 compressedLen = in.readInt64();
+
+        MemoryBlock compressed;
+        in.readIntoMemoryBlock (compressed, (ssize_t) compressedLen);
+
+        GZIPDecompressorInputStream unzipper (new MemoryInputStream (compressed, false), true,
+                                              GZIPDecompressorInputStream::zlibFormat, len);
+        unzipper.readIntoMemoryBlock (data, (ssize_t) len);
+
+        if ((int64) data.getSize() != len)
+            data.reset();
+
+        updateMemoryUsage();
+    }
+
+    // to be called after the data has changed
+    void updateMemoryUsage()
+    {
+        auto newSize = (int64) data.getSize();
+        getMemoryUsage().add (newSize - accountedBytes);
+        accountedBytes = newSize;
+    }
+
+    static MemoryUsage::Category& getMemoryUsage()
+    {
+        static MemoryUsage::Category& category = MemoryUsage::getCategory ("AudioThumbnailCache");
+        return category;
     }
 
     void write (OutputStream& out)
     {
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream zipper (&compressed, 9);
+            zipper << data;
+        }
+
         out.writeInt64 (hash);
         out.writeInt64 ((int64) data.getSize());
-        out << data;
+        out.writeInt64 ((int64) compressed.getDataSize());
+        out << compressed.getMemoryBlock();
     }
 
     int64 hash;
@@ -56,6 +144,8 @@ public:
     MemoryBlock data;
 
 private:
+    int64 accountedBytes = 0;
+
     JUCE_LEAK_DETECTOR (ThumbnailCacheEntry)
 };
 
@@ -68,6 +158,16 @@ AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
     thread.startThread (2);
 }
 
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numGenerationThreads)
+    : AudioThumbnailCache (maxNumThumbs)
+{
+    if (numGenerationThreads > 0)
+    {
+        pool = new ThreadPool (numGenerationThreads);
+        pool->setThreadPriorities (2);
+    }
+}
+
 AudioThumbnailCache::~AudioThumbnailCache()
 {
 }
@@ -100,6 +200,14 @@ int AudioThumbnailCache::findOldestThumb() const
     return oldest;
 }
 
+void AudioThumbnailCache::addThumb (ThumbnailCacheEntry* te)
+{
+    if (thumbs.size() < maxNumThumbsToStore)
+        thumbs.add (te);
+    else
+        thumbs.set (findOldestThumb(), te);
+}
+
 bool AudioThumbnailCache::loadThumb (AudioThumbnailBase& thumb, const int64 hashCode)
 {
     const ScopedLock sl (lock);
@@ -113,31 +221,61 @@ bool AudioThumbnailCache::loadThumb (AudioThumbnailBase& thumb, const int64 hash
         return true;
     }
 
-    return loadNewThumb (thumb, hashCode);
+    return loadThumbFromCacheDirectory (thumb, hashCode)
+            || loadNewThumb (thumb, hashCode);
 }
 
 void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
                                       const int64 hashCode)
 {
-    const ScopedLock sl (lock);
-    ThumbnailCacheEntry* te = findThumbFor (hashCode);
+    ThumbnailCacheEntry fileEntry (hashCode);
+    File file;
 
-    if (te == nullptr)
     {
-        te = new ThumbnailCacheEntry (hashCode);
+        const ScopedLock sl (lock);
+        ThumbnailCacheEntry* te = findThumbFor (hashCode);
+
+        if (te == nullptr)
+        {
+            te = new ThumbnailCacheEntry (hashCode);
+            addThumb (te);
+        }
+
+        {
+            MemoryOutputStream out (te->data, false);
+            thumb.saveTo (out);
+        }
+
+        te->updateMemoryUsage();
 
-        if (thumbs.size() < maxNumThumbsToStore)
-            thumbs.add (te);
-        else
-            thumbs.set (findOldestThumb(), te);
+        saveNewlyFinishedThumbnail (thumb, hashCode);
+
+        file = getCacheFileFor (hashCode);
+        fileEntry.data = te->data;
     }
 
+    // (the file is written outside the lock so that other thumbnails don't have to wait for the disk)
+    if (file != File())
     {
-        MemoryOutputStream out (te->data, false);
-        thumb.saveTo (out);
-    }
+        TemporaryFile temp (file);
+
+        {
+            FileOutputStream out (temp.getFile());
+
+            if (! out.openedOk())
+                return;
+
+            writeThumbnailCacheHeader (out);
+            out.writeInt (1);
+            fileEntry.write (out);
+            out.flush();
 
-    saveNewlyFinishedThumbnail (thumb, hashCode);
+            if (out.getStatus().failed())
+                return;
+        }
+
+        temp.overwriteTargetFileWithTemporary();
+    }
 }
 
 void AudioThumbnailCache::clear()
@@ -153,16 +291,65 @@ void AudioThumbnailCache::removeThumb (const int64 hashCode)
     for (int i = thumbs.size(); --i >= 0;)
         if (thumbs.getUnchecked(i)->hash == hashCode)
             thumbs.remove (i);
+
+    if (cacheDirectory != File())
+        getCacheFileFor (hashCode).deleteFile();
 }
 
-static inline int getThumbnailCacheFileMagicHeader() noexcept
+//==============================================================================
+void AudioThumbnailCache::setCacheDirectory (const File& directory)
 {
-    return (int) ByteOrder::littleEndianInt ("ThmC");
+    const ScopedLock sl (lock);
+    cacheDirectory = directory;
+
+    if (cacheDirectory != File())
+        cacheDirectory.createDirectory();
+}
+
+File AudioThumbnailCache::getCacheDirectory() const
+{
+    const ScopedLock sl (lock);
+    return cacheDirectory;
+}
+
+File AudioThumbnailCache::getCacheFileFor (const int64 hash) const
+{
+    if (cacheDirectory == File())
+        return {};
+
+    return cacheDirectory.getChildFile (String::toHexString (hash) + ".thumb");
+}
+
+bool AudioThumbnailCache::loadThumbFromCacheDirectory (AudioThumbnailBase& thumb, const int64 hashCode)
+{
+    FileInputStream in (getCacheFileFor (hashCode));
+
+    if (in.openedOk())
+    {
+        auto formatVersion = readThumbnailCacheHeader (in);
+
+        if (formatVersion > 0 && in.readInt() == 1)
+        {
+            ScopedPointer<ThumbnailCacheEntry> te (new ThumbnailCacheEntry (in, formatVersion));
+            MemoryInputStream thumbData (te->data, false);
+
+            if (te->hash == hashCode && thumb.loadFrom (thumbData))
+            {
+                te->lastUsed = Time::getMillisecondCounter();
+                addThumb (te.release());
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 bool AudioThumbnailCache::readFromStream (InputStream& source)
 {
-    if (source.readInt() != getThumbnailCacheFileMagicHeader())
+    auto formatVersion = readThumbnailCacheHeader (source);
+
+    if (formatVersion == 0)
         return false;
 
     const ScopedLock sl (lock);
@@ -170,7 +357,7 @@ bool AudioThumbnailCache::readFromStream (InputStream& source)
     int numThumbnails = jmin (maxNumThumbsToStore, source.readInt());
 
     while (--numThumbnails >= 0 && ! source.isExhausted())
-        thumbs.add (new ThumbnailCacheEntry (source));
+        thumbs.add (new ThumbnailCacheEntry (source, formatVersion));
 
     return true;
 }
@@ -179,7 +366,7 @@ void AudioThumbnailCache::writeToStream (OutputStream& out)
 {
     const ScopedLock sl (lock);
 
-    out.writeInt (getThumbnailCacheFileMagicHeader());
+    writeThumbnailCacheHeader (out);
     out.writeInt (thumbs.size());
 
     for (int i = 0; i < thumbs.size(); ++i)
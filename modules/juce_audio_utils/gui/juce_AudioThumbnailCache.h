@@ -48,6 +48,14 @@ public:
     */
     explicit AudioThumbnailCache (int maxNumThumbsToStore);
 
+    /** Creates a cache object which also has a pool of threads for generating thumbnails.
+
+        Thumbnails whose files can be memory-mapped (e.g. WAV and AIFF files) will split
+        their scanning between these threads rather than doing it all on the cache's single
+        TimeSliceThread, so a long file can be scanned several times faster.
+    */
+    AudioThumbnailCache (int maxNumThumbsToStore, int numGenerationThreads);
+
     /** Destructor. */
     virtual ~AudioThumbnailCache();
 
@@ -70,24 +78,67 @@ public:
     */
     void storeThumb (const AudioThumbnailBase& thumb, int64 hashCode);
 
-    /** Tells the cache to forget about the thumb with the given hashcode. */
+    /** Tells the cache to forget about the thumb with the given hashcode.
+        If a cache directory has been set, the thumb's file is also deleted.
+    */
     void removeThumb (int64 hashCode);
 
+    //==============================================================================
+    /** Sets a directory in which the cache will keep a copy of each finished thumbnail.
+
+        Every thumbnail that finishes loading is written to its own file in this folder,
+        named after its hash code, and when a thumbnail with a matching hash code is next
+        requested it'll be re-loaded from there instead of re-scanning the audio. For files,
+        the hash comes from the FileInputSource, so you'll probably want to create it with
+        useFileTimeInHashGeneration set to true, so that a file which has been modified won't
+        pick up its old thumbnail.
+
+        Pass File() to stop using a directory.
+    */
+    void setCacheDirectory (const File& directory);
+
+    /** Returns the directory set with setCacheDirectory(), or File() if there isn't one. */
+    File getCacheDirectory() const;
+
     //==============================================================================
     /** Attempts to re-load a saved cache of thumbnails from a stream.
-        The cache data must have been written by the writeToStream() method.
+        The cache data must have been written by the writeToStream() method, either by
+        this version or by older versions which didn't compress the data.
         This will replace all currently-loaded thumbnails with the new data.
     */
     bool readFromStream (InputStream& source);
 
     /** Writes all currently-loaded cache data to a stream.
-        The resulting data can be re-loaded with readFromStream().
+        The data is written in a versioned format with each thumbnail compressed, and this
+        can be re-loaded with readFromStream().
     */
     void writeToStream (OutputStream& stream);
 
     /** Returns the thread that client thumbnails can use. */
     TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
 
+    /** Returns the pool that client thumbnails can use to generate their data in
+        parallel, or nullptr if the cache wasn't given any generation threads.
+    */
+    ThreadPool* getThreadPool() noexcept                { return pool; }
+
+    //==============================================================================
+    /** Gives the cache's thumbnails a set of peak summaries to share with other clients.
+
+        A thumbnail of a file that has already been scanned by another thumbnail or meter
+        using the same AudioPeakSummaryCache is then built from the stored levels rather
+        than by re-reading the audio, as long as its samplesPerThumbSample is a multiple
+        of the summary cache's block size.
+
+        The AudioPeakSummaryCache isn't owned by this object, and must be kept alive for as
+        long as any thumbnails are using it. Pass nullptr to stop using one; thumbnails
+        which have already started loading will carry on with their current summary.
+    */
+    void setPeakSummaryCache (AudioPeakSummaryCache* summaryCacheToUse) noexcept    { peakSummaryCache = summaryCacheToUse; }
+
+    /** Returns the cache that was set with setPeakSummaryCache(), or nullptr. */
+    AudioPeakSummaryCache* getPeakSummaryCache() const noexcept                     { return peakSummaryCache; }
+
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
@@ -102,15 +153,21 @@ protected:
 private:
     //==============================================================================
     TimeSliceThread thread;
+    ScopedPointer<ThreadPool> pool;
 
     class ThumbnailCacheEntry;
     friend struct ContainerDeletePolicy<ThumbnailCacheEntry>;
     OwnedArray<ThumbnailCacheEntry> thumbs;
     CriticalSection lock;
     int maxNumThumbsToStore;
+    File cacheDirectory;
+    AudioPeakSummaryCache* peakSummaryCache = nullptr;
 
     ThumbnailCacheEntry* findThumbFor (int64 hash) const;
     int findOldestThumb() const;
+    void addThumb (ThumbnailCacheEntry*);
+    File getCacheFileFor (int64 hash) const;
+    bool loadThumbFromCacheDirectory (AudioThumbnailBase&, int64 hash);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailCache)
 };
@@ -36,6 +36,14 @@ struct AudioVisualiserComponent::ChannelInfo
         clear();
     }
 
+    // The level history is written by the audio thread, which hands copies of it to
+    // the message thread through a TripleBuffer every time a new block is complete.
+    struct Snapshot
+    {
+        Array<Range<float>> levels;
+        int nextSample;
+    };
+
     void clear() noexcept
     {
         for (int i = 0; i < levels.size(); ++i)
@@ -43,15 +51,28 @@ struct AudioVisualiserComponent::ChannelInfo
 
         value = Range<float>();
         subSample = 0;
+
+        publish();
     }
 
     void pushSamples (const float* inputSamples, const int num) noexcept
     {
+        bool blockCompleted = false;
+
         for (int i = 0; i < num; ++i)
-            pushSample (inputSamples[i]);
+            blockCompleted = pushSampleWithoutPublishing (inputSamples[i]) || blockCompleted;
+
+        if (blockCompleted)
+            publish();
     }
 
     void pushSample (const float newSample) noexcept
+    {
+        if (pushSampleWithoutPublishing (newSample))
+            publish();
+    }
+
+    bool pushSampleWithoutPublishing (const float newSample) noexcept
     {
         if (--subSample <= 0)
         {
@@ -59,11 +80,38 @@ struct AudioVisualiserComponent::ChannelInfo
             levels.getReference (nextSample++) = value;
             subSample = owner.getSamplesPerBlock();
             value = Range<float> (newSample, newSample);
+            return true;
         }
-        else
+
+        value = value.getUnionWith (newSample);
+        return false;
+    }
+
+    void publish() noexcept
+    {
+        auto& snapshot = snapshots.getWriteFrame();
+        jassert (snapshot.levels.size() == levels.size());
+
+        std::copy (levels.begin(), levels.end(), snapshot.levels.begin());
+        snapshot.nextSample = nextSample;
+        snapshots.publish();
+    }
+
+    /** Blanks the snapshot being displayed, and returns true if it wasn't blank already.
+        This is only called by the message thread, which owns the read frame.
+    */
+    bool clearDisplayedSnapshot() noexcept
+    {
+        auto& snapshot = snapshots.getReadFrame();
+        bool changed = false;
+
+        for (auto& level : snapshot.levels)
         {
-            value = value.getUnionWith (newSample);
+            changed = changed || level != Range<float>();
+            level = Range<float>();
         }
+
+        return changed;
     }
 
     void setBufferSize (int newSize)
@@ -73,12 +121,15 @@ struct AudioVisualiserComponent::ChannelInfo
 
         if (nextSample >= newSize)
             nextSample = 0;
+
+        snapshots.reset ({ levels, nextSample });
     }
 
     AudioVisualiserComponent& owner;
     Array<Range<float>> levels;
     Range<float> value;
     int nextSample, subSample;
+    TripleBuffer<Snapshot> snapshots;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelInfo)
 };
@@ -117,12 +168,22 @@ void AudioVisualiserComponent::setBufferSize (int newNumSamples)
 
 void AudioVisualiserComponent::clear()
 {
-    for (int i = 0; i < channels.size(); ++i)
-        channels.getUnchecked(i)->clear();
+    // the channels are cleared by the thread which pushes the data, so that the
+    // message thread never writes to the state of the audio thread, but the timer
+    // blanks the display in the meantime in case no more data arrives
+    clearPending.set (true);
+}
+
+void AudioVisualiserComponent::handlePendingClear() noexcept
+{
+    if (clearPending.exchange (false))
+        for (int i = 0; i < channels.size(); ++i)
+            channels.getUnchecked(i)->clear();
 }
 
 void AudioVisualiserComponent::pushBuffer (const float** d, int numChannels, int num)
 {
+    handlePendingClear();
     numChannels = jmin (numChannels, channels.size());
 
     for (int i = 0; i < numChannels; ++i)
@@ -138,6 +199,7 @@ void AudioVisualiserComponent::pushBuffer (const AudioSampleBuffer& buffer)
 
 void AudioVisualiserComponent::pushBuffer (const AudioSourceChannelInfo& buffer)
 {
+    handlePendingClear();
     const int numChannels = jmin (buffer.buffer->getNumChannels(), channels.size());
 
     for (int i = 0; i < numChannels; ++i)
@@ -147,6 +209,7 @@ void AudioVisualiserComponent::pushBuffer (const AudioSourceChannelInfo& buffer)
 
 void AudioVisualiserComponent::pushSample (const float* d, int numChannels)
 {
+    handlePendingClear();
     numChannels = jmin (numChannels, channels.size());
 
     for (int i = 0; i < numChannels; ++i)
@@ -165,7 +228,20 @@ void AudioVisualiserComponent::setRepaintRate (int frequencyInHz)
 
 void AudioVisualiserComponent::timerCallback()
 {
-    repaint();
+    bool anyNewData = false;
+    const bool clearing = clearPending.get();
+
+    for (int i = 0; i < channels.size(); ++i)
+    {
+        auto* channel = channels.getUnchecked(i);
+        anyNewData = channel->snapshots.acquireLatest() || anyNewData;
+
+        if (clearing)
+            anyNewData = channel->clearDisplayedSnapshot() || anyNewData;
+    }
+
+    if (anyNewData)
+        repaint();
 }
 
 void AudioVisualiserComponent::setColours (Colour bk, Colour fg) noexcept
@@ -186,10 +262,10 @@ void AudioVisualiserComponent::paint (Graphics& g)
 
     for (int i = 0; i < channels.size(); ++i)
     {
-        const ChannelInfo& c = *channels.getUnchecked(i);
+        auto& snapshot = channels.getUnchecked(i)->snapshots.getReadFrame();
 
         paintChannel (g, r.removeFromTop (channelHeight),
-                      c.levels.begin(), c.levels.size(), c.nextSample);
+                      snapshot.levels.begin(), snapshot.levels.size(), snapshot.nextSample);
     }
 }
 
@@ -40,6 +40,10 @@ namespace juce
     for fancy additional features that you'd like it to support! If you're building a
     real-world app that requires more powerful waveform display, you'll probably want to
     create your own component instead.
+
+    The data is pushed and painted without any locking: each time a new block of levels
+    is complete, the thread calling the push methods hands a snapshot of them over to
+    the message thread through a TripleBuffer.
 */
 class JUCE_API AudioVisualiserComponent  : public Component,
                                            private Timer
@@ -67,7 +71,10 @@ public:
     /** */
     int getSamplesPerBlock() const noexcept                         { return inputSamplesPerBlock; }
 
-    /** Clears the contents of the buffers. */
+    /** Clears the contents of the buffers.
+        This is done by the thread which pushes the data, the next time it does so, but
+        the display is cleared by the next repaint timer callback in any case.
+    */
     void clear();
 
     /** Pushes a buffer of channels data.
@@ -125,7 +132,9 @@ private:
     OwnedArray<ChannelInfo> channels;
     int numSamples, inputSamplesPerBlock;
     Colour backgroundColour, waveformColour;
+    Atomic<bool> clearPending { false };
 
+    void handlePendingClear() noexcept;
     void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioVisualiserComponent)
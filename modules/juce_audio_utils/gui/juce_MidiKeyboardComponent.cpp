@@ -72,6 +72,7 @@ MidiKeyboardComponent::MidiKeyboardComponent (MidiKeyboardState& s, Orientation
       midiInChannelMask (0xffff),
       velocity (1.0f),
       shouldCheckState (false),
+      lastNumStateChanges (0),
       rangeStart (0),
       rangeEnd (127),
       firstKey (12 * 4.0f),
@@ -693,14 +694,14 @@ void MidiKeyboardComponent::resized()
 }
 
 //==============================================================================
+// These are probably being called from the audio thread, so the timer picks up the
+// changes by checking the state's change count instead
 void MidiKeyboardComponent::handleNoteOn (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
 {
-    shouldCheckState = true; // (probably being called from the audio thread, so avoid blocking in here)
 }
 
 void MidiKeyboardComponent::handleNoteOff (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
 {
-    shouldCheckState = true; // (probably being called from the audio thread, so avoid blocking in here)
 }
 
 //==============================================================================
@@ -842,18 +843,21 @@ void MidiKeyboardComponent::mouseWheelMove (const MouseEvent&, const MouseWheelD
 
 void MidiKeyboardComponent::timerCallback()
 {
-    if (shouldCheckState)
+    auto numStateChanges = state.getNumStateChanges();
+
+    if (shouldCheckState || numStateChanges != lastNumStateChanges)
     {
         shouldCheckState = false;
+        lastNumStateChanges = numStateChanges;
 
-        for (int i = rangeStart; i <= rangeEnd; ++i)
-        {
-            if (keysCurrentlyDrawnDown[i] != state.isNoteOnForChannels (midiInChannelMask, i))
-            {
-                keysCurrentlyDrawnDown.setBit (i, state.isNoteOnForChannels (midiInChannelMask, i));
-                repaintNote (i);
-            }
-        }
+        // only the keys that have gone up or down since they were last drawn need repainting
+        auto notesOn = state.getNotesOnForChannels (midiInChannelMask);
+        auto changedNotes = notesOn;
+        changedNotes ^= keysCurrentlyDrawnDown;
+        keysCurrentlyDrawnDown = notesOn;
+
+        for (int i = changedNotes.findNextSetBit (rangeStart); i >= 0 && i <= rangeEnd; i = changedNotes.findNextSetBit (i + 1))
+            repaintNote (i);
     }
 
     if (shouldCheckMousePos)
@@ -396,6 +396,7 @@ private:
     Array<int> mouseOverNotes, mouseDownNotes;
     BigInteger keysPressed, keysCurrentlyDrawnDown;
     bool shouldCheckState;
+    uint32 lastNumStateChanges;
 
     int rangeStart, rangeEnd;
     float firstKey;
@@ -54,15 +54,19 @@ void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
         }
 
         AudioProcessor* oldOne;
+        bool wasPrepared;
 
         {
             const ScopedLock sl (lock);
-            oldOne = isPrepared ? processor : nullptr;
-            processor = processorToPlay;
+            oldOne = processor.exchange (processorToPlay);
+            wasPrepared = isPrepared;
             isPrepared = true;
         }
 
-        if (oldOne != nullptr)
+        // the audio thread may still be in the middle of a block with the old one
+        waitUntilNotInUse (oldOne);
+
+        if (oldOne != nullptr && wasPrepared)
             oldOne->releaseResources();
     }
 }
@@ -73,33 +77,81 @@ void AudioProcessorPlayer::setDoublePrecisionProcessing (bool doublePrecision)
     {
         const ScopedLock sl (lock);
 
-        if (processor != nullptr)
-        {
-            processor->releaseResources();
-
-            bool supportsDouble = processor->supportsDoublePrecisionProcessing() && doublePrecision;
-
-            processor->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
-                                                              : AudioProcessor::singlePrecision);
-            processor->prepareToPlay (sampleRate, blockSize);
-        }
-
+        // the processor is taken out of the callback while its precision is changed
+        auto* processorToPlay = processor.load();
+        setProcessor (nullptr);
         isDoublePrecision = doublePrecision;
+        setProcessor (processorToPlay);
     }
 }
 
 //==============================================================================
+AudioProcessor* AudioProcessorPlayer::startUsingProcessor() noexcept
+{
+    for (;;)
+    {
+        auto* p = processor.load();
+        processorInUse = p;
+
+        // if setProcessor() swapped it before processorInUse was set, it may not
+        // have seen that it's in use, so the new one must be used instead
+        if (processor.load() == p)
+            return p;
+    }
+}
+
+void AudioProcessorPlayer::waitUntilNotInUse (AudioProcessor* p) const noexcept
+{
+    while (p != nullptr && processorInUse.load() == p)
+        Thread::yield();
+}
+
 void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChannelData,
                                                   const int numInputChannels,
                                                   float** const outputChannelData,
                                                   const int numOutputChannels,
                                                   const int numSamples)
 {
+    JUCE_REALTIME_CONTEXT;
+
     // these should have been prepared by audioDeviceAboutToStart()...
     jassert (sampleRate > 0 && blockSize > 0);
 
     incomingMidi.clear();
     messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
+
+    bool processed = false;
+
+    if (auto* p = startUsingProcessor())
+    {
+        // (this lock is only held briefly by other threads, e.g. while the processor is suspended)
+        const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (p->getCallbackLock());
+
+        if (! p->isSuspended())
+        {
+            if (p->isUsingDoublePrecision())
+                processDoublePrecision (*p, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples);
+            else
+                processSinglePrecision (*p, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples);
+
+            processed = true;
+        }
+    }
+
+    processorInUse = nullptr;
+
+    if (! processed)
+        for (int i = 0; i < numOutputChannels; ++i)
+            FloatVectorOperations::clear (outputChannelData[i], numSamples);
+}
+
+void AudioProcessorPlayer::processSinglePrecision (AudioProcessor& p,
+                                                   const float** const inputChannelData,
+                                                   const int numInputChannels,
+                                                   float** const outputChannelData,
+                                                   const int numOutputChannels,
+                                                   const int numSamples)
+{
     int totalNumChans = 0;
 
     if (numInputChannels > numOutputChannels)
@@ -143,33 +195,54 @@ void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChann
 
     AudioSampleBuffer buffer (channels, totalNumChans, numSamples);
 
+    if (auto* adapter = p.getBlockSizeAdapter())
+        adapter->process (buffer, incomingMidi, false);
+    else
+        p.processBlock (buffer, incomingMidi);
+}
+
+void AudioProcessorPlayer::processDoublePrecision (AudioProcessor& p,
+                                                   const float** const inputChannelData,
+                                                   const int numInputChannels,
+                                                   float** const outputChannelData,
+                                                   const int numOutputChannels,
+                                                   const int numSamples)
+{
+    // The device's data is converted straight into the double buffer and back again,
+    // so there's no need to copy it through the output channels first
+    conversionBuffer.setSize (jmax (numInputChannels, numOutputChannels), numSamples,
+                              false, false, true);
+
+    for (int i = 0; i < conversionBuffer.getNumChannels(); ++i)
     {
-        const ScopedLock sl (lock);
+        auto* dest = conversionBuffer.getWritePointer (i);
+
+        if (i < numInputChannels)
+        {
+            auto* src = inputChannelData[i];
 
-        if (processor != nullptr)
+            for (int j = 0; j < numSamples; ++j)
+                dest[j] = (double) src[j];
+        }
+        else
         {
-            const ScopedLock sl2 (processor->getCallbackLock());
-
-            if (! processor->isSuspended())
-            {
-                if (processor->isUsingDoublePrecision())
-                {
-                    conversionBuffer.makeCopyOf (buffer, true);
-                    processor->processBlock (conversionBuffer, incomingMidi);
-                    buffer.makeCopyOf (conversionBuffer, true);
-                }
-                else
-                {
-                    processor->processBlock (buffer, incomingMidi);
-                }
-
-                return;
-            }
+            zeromem (dest, sizeof (double) * (size_t) numSamples);
         }
     }
 
+    if (auto* adapter = p.getBlockSizeAdapter())
+        adapter->process (conversionBuffer, incomingMidi, false);
+    else
+        p.processBlock (conversionBuffer, incomingMidi);
+
     for (int i = 0; i < numOutputChannels; ++i)
-        FloatVectorOperations::clear (outputChannelData[i], numSamples);
+    {
+        auto* src = conversionBuffer.getReadPointer (i);
+        auto* dest = outputChannelData[i];
+
+        for (int j = 0; j < numSamples; ++j)
+            dest[j] = (float) src[j];
+    }
 }
 
 void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
@@ -189,12 +262,17 @@ void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
     messageCollector.reset (sampleRate);
     channels.calloc (jmax (numChansIn, numChansOut) + 2);
 
-    if (processor != nullptr)
+    // everything the callback uses is allocated here, so that it doesn't have to
+    // allocate anything on the audio thread
+    tempBuffer.setSize (jmax (1, numChansIn - numChansOut), newBlockSize);
+    conversionBuffer.setSize (jmax (1, numChansIn, numChansOut), newBlockSize);
+    incomingMidi.ensureSize (4096);
+
+    if (auto* oldProcessor = processor.load())
     {
         if (isPrepared)
-            processor->releaseResources();
+            oldProcessor->releaseResources();
 
-        auto* oldProcessor = processor;
         setProcessor (nullptr);
         setProcessor (oldProcessor);
     }
@@ -204,8 +282,9 @@ void AudioProcessorPlayer::audioDeviceStopped()
 {
     const ScopedLock sl (lock);
 
-    if (processor != nullptr && isPrepared)
-        processor->releaseResources();
+    if (auto* p = processor.load())
+        if (isPrepared)
+            p->releaseResources();
 
     sampleRate = 0.0;
     blockSize = 0;
@@ -37,6 +37,11 @@ namespace juce
     It's also a MidiInputCallback, so you can connect it to both an audio and midi
     input to send both streams through the processor.
 
+    All the buffers are allocated when the device starts, so the audio callback
+    doesn't allocate anything unless the device delivers more samples than it said it
+    would. Changing the processor doesn't lock the audio callback - setProcessor()
+    just waits for the current block to finish before releasing the old processor.
+
     @see AudioProcessor, AudioProcessorGraph
 */
 class JUCE_API  AudioProcessorPlayer    : public AudioIODeviceCallback,
@@ -58,7 +63,7 @@ public:
     void setProcessor (AudioProcessor* processorToPlay);
 
     /** Returns the current audio processor that is being played. */
-    AudioProcessor* getCurrentProcessor() const noexcept            { return processor; }
+    AudioProcessor* getCurrentProcessor() const noexcept            { return processor.load(); }
 
     /** Returns a midi message collector that you can pass midi messages to if you
         want them to be injected into the midi stream that is being sent to the
@@ -92,7 +97,9 @@ public:
 
 private:
     //==============================================================================
-    AudioProcessor* processor = nullptr;
+    // the audio callback stores the processor that it's using in processorInUse, so
+    // that setProcessor() can swap them without a lock
+    std::atomic<AudioProcessor*> processor { nullptr }, processorInUse { nullptr };
     CriticalSection lock;
     double sampleRate = 0;
     int blockSize = 0;
@@ -106,6 +113,11 @@ private:
     MidiBuffer incomingMidi;
     MidiMessageCollector messageCollector;
 
+    AudioProcessor* startUsingProcessor() noexcept;
+    void waitUntilNotInUse (AudioProcessor*) const noexcept;
+    void processSinglePrecision (AudioProcessor&, const float**, int, float**, int, int);
+    void processDoublePrecision (AudioProcessor&, const float**, int, float**, int, int);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorPlayer)
 };
 
@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Each worker renders one job at a time with its own processor, and encodes its
+// output on its own background thread.
+struct OfflineRenderer::Worker
+{
+    Worker() : writerThread ("Offline render writer")
+    {
+        writerThread.startThread (4);
+    }
+
+    ~Worker()
+    {
+        if (processor != nullptr && preparedSampleRate > 0)
+            processor->releaseResources();
+
+        processor = nullptr;
+        writerThread.stopThread (5000);
+    }
+
+    ScopedPointer<AudioProcessor> processor;
+    TimeSliceThread writerThread;
+    double preparedSampleRate = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+// The state of a render() call, which the calling thread and the pool's threads
+// all take jobs from.
+struct OfflineRenderer::Batch
+{
+    Batch (OfflineRenderer& r, const Array<Job>& jobsToRender, const JobFinishedCallback& cb)
+        : renderer (r), jobs (jobsToRender), callback (cb)
+    {
+        results.insertMultiple (0, Result::ok(), jobs.size());
+    }
+
+    void run (Worker& worker)
+    {
+        for (;;)
+        {
+            auto index = nextJob++;
+
+            if (index >= jobs.size())
+                return;
+
+            auto result = renderer.cancelled ? Result::fail ("Cancelled")
+                                             : renderer.renderJob (worker, jobs.getReference (index));
+
+            // the array was sized up front, so each thread writes to its own element
+            results.getReference (index) = result;
+
+            if (callback != nullptr && ! callback (index, result))
+                renderer.cancelled = true;
+        }
+    }
+
+    OfflineRenderer& renderer;
+    const Array<Job>& jobs;
+    const JobFinishedCallback& callback;
+    Array<Result> results;
+    std::atomic<int> nextJob { 0 }, numHelpersRunning { 0 };
+    WaitableEvent helpersFinished;
+
+    JUCE_DECLARE_NON_COPYABLE (Batch)
+};
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer (AudioFormatManager& formatManager,
+                                  ProcessorFactory createProcessor,
+                                  const Options& renderOptions)
+    : formats (formatManager),
+      processorFactory (std::move (createProcessor)),
+      options (renderOptions)
+{
+    jassert (processorFactory != nullptr);
+    jassert (options.blockSize > 0);
+
+    auto numThreads = options.numThreads > 0 ? options.numThreads : SystemStats::getNumCpus();
+
+    for (int i = 0; i < numThreads; ++i)
+        workers.add (new Worker());
+
+    // (the thread that calls render() does the work of the first worker)
+    if (numThreads > 1)
+        pool = new ThreadPool (numThreads - 1);
+
+    readScheduler = new BufferingAudioReadScheduler (jmax (1, options.numReadThreads));
+}
+
+OfflineRenderer::OfflineRenderer (AudioFormatManager& formatManager, ProcessorFactory createProcessor)
+    : OfflineRenderer (formatManager, std::move (createProcessor), Options())
+{
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    pool = nullptr;
+    workers.clear();
+}
+
+Array<Result> OfflineRenderer::render (const Array<Job>& jobs, const JobFinishedCallback& jobFinished)
+{
+    cancelled = false;
+
+    auto numWorkers = jmin (workers.size(), jobs.size());
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto& worker = *workers.getUnchecked (i);
+
+        if (worker.processor == nullptr)
+        {
+            worker.processor = processorFactory();
+            worker.preparedSampleRate = 0;
+        }
+    }
+
+    Batch batch (*this, jobs, jobFinished);
+    batch.numHelpersRunning = numWorkers - 1;
+
+    for (int i = 1; i < numWorkers; ++i)
+    {
+        auto* worker = workers.getUnchecked (i);
+
+        pool->addJob ([&batch, worker]
+        {
+            batch.run (*worker);
+
+            if (--batch.numHelpersRunning == 0)
+                batch.helpersFinished.signal();
+        });
+    }
+
+    if (numWorkers > 0)
+        batch.run (*workers.getUnchecked (0));
+
+    if (numWorkers > 1)
+        batch.helpersFinished.wait();
+
+    return batch.results;
+}
+
+//==============================================================================
+Result OfflineRenderer::renderJob (Worker& worker, const Job& job)
+{
+    if (worker.processor == nullptr)
+        return Result::fail ("Couldn't create a processor");
+
+    auto& processor = *worker.processor;
+    ScopedPointer<AudioFormatReader> reader;
+    auto sampleRate = job.sampleRate;
+
+    if (job.inputFile != File())
+    {
+        auto* sourceReader = formats.createReaderFor (job.inputFile);
+
+        if (sourceReader == nullptr)
+            return Result::fail ("Couldn't read " + job.inputFile.getFullPathName());
+
+        sampleRate = sourceReader->sampleRate;
+
+        auto* bufferingReader = new BufferingAudioReader (sourceReader, *readScheduler, options.blockSize * 8);
+        bufferingReader->setReadTimeout (-1);
+        reader = bufferingReader;
+    }
+
+    auto numInputSamples = reader != nullptr ? reader->lengthInSamples : 0;
+    auto length = (job.lengthInSamples >= 0 ? job.lengthInSamples : numInputSamples) + job.tailLengthInSamples;
+
+    if (length <= 0 || sampleRate <= 0)
+        return Result::fail ("Nothing to render into " + job.outputFile.getFullPathName());
+
+    auto* format = formats.findFormatForFileExtension (job.outputFile.getFileExtension());
+
+    if (format == nullptr)
+        return Result::fail ("Unknown audio format for " + job.outputFile.getFullPathName());
+
+    auto numIns  = processor.getTotalNumInputChannels();
+    auto numOuts = processor.getTotalNumOutputChannels();
+
+    if (numOuts <= 0)
+        return Result::fail ("The processor has no outputs");
+
+    if (worker.preparedSampleRate != sampleRate)
+    {
+        if (worker.preparedSampleRate > 0)
+            processor.releaseResources();
+
+        processor.setNonRealtime (true);
+        processor.setPlayConfigDetails (numIns, numOuts, sampleRate, options.blockSize);
+        processor.prepareToPlay (sampleRate, options.blockSize);
+        worker.preparedSampleRate = sampleRate;
+    }
+    else
+    {
+        processor.reset();
+    }
+
+    TemporaryFile temp (job.outputFile);
+
+    {
+        ScopedPointer<FileOutputStream> out (temp.getFile().createOutputStream());
+
+        if (out == nullptr || out->failedToOpen())
+            return Result::fail ("Couldn't write to " + job.outputFile.getFullPathName());
+
+        auto* writer = format->createWriterFor (out, sampleRate, (unsigned int) numOuts, options.bitsPerSample,
+                                                {}, options.qualityOptionIndex);
+
+        if (writer == nullptr)
+            return Result::fail ("Couldn't create a " + format->getFormatName() + " writer for "
+                                   + job.outputFile.getFullPathName());
+
+        out.release();
+
+        AudioFormatWriter::ThreadedWriter threadedWriter (writer, worker.writerThread, options.blockSize * 8 + 1);
+
+        AudioBuffer<float> buffer (jmax (numIns, numOuts), options.blockSize);
+        HeapBlock<const float*> outputChannels ((size_t) numOuts);
+        MidiBuffer midi;
+
+        // the processor's latency is skipped at the start, and made up for at the end
+        auto numToSkip = (int64) jmax (0, processor.getLatencySamples());
+        auto total = length + numToSkip;
+
+        for (int64 position = 0; position < total;)
+        {
+            if (cancelled)
+                return Result::fail ("Cancelled");
+
+            auto numSamples = (int) jmin ((int64) options.blockSize, total - position);
+            AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+            block.clear();
+
+            if (reader != nullptr && numIns > 0 && position < numInputSamples)
+            {
+                auto numToRead = (int) jmin ((int64) numSamples, numInputSamples - position);
+
+                reader->read (reinterpret_cast<int* const*> (block.getArrayOfWritePointers()),
+                              numIns, position, numToRead, true);
+
+                if (! reader->usesFloatingPointData)
+                    for (int i = 0; i < numIns; ++i)
+                        FloatVectorOperations::convertFixedToFloat (block.getWritePointer (i),
+                                                                    reinterpret_cast<const int*> (block.getReadPointer (i)),
+                                                                    1.0f / (float) 0x7fffffff, numToRead);
+            }
+
+            midi.clear();
+            processor.processBlock (block, midi);
+
+            auto skip = (int) jmin ((int64) numSamples, numToSkip);
+            numToSkip -= skip;
+            position += numSamples;
+
+            if (skip < numSamples)
+            {
+                for (int i = 0; i < numOuts; ++i)
+                    outputChannels[i] = block.getReadPointer (i, skip);
+
+                while (! threadedWriter.write (outputChannels, numSamples - skip))
+                {
+                    if (cancelled)
+                        return Result::fail ("Cancelled");
+
+                    Thread::sleep (1);
+                }
+            }
+        }
+    }
+
+    if (! temp.overwriteTargetFileWithTemporary())
+        return Result::fail ("Couldn't replace " + job.outputFile.getFullPathName());
+
+    return Result::ok();
+}
+
+} // namespace juce
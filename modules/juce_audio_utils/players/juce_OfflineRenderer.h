@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders audio files through copies of an AudioProcessor or AudioProcessorGraph
+    as fast as the machine allows, spreading the files across several threads.
+
+    This is for things like bouncing stems or batch-processing a folder of files
+    through a plugin chain, where nothing needs to keep up with a live audio device.
+    Each thread has its own instance of the processor, made by a function that you
+    supply, and renders whole files with it in large blocks. While a file is being
+    processed, its audio is read ahead by a BufferingAudioReadScheduler and the
+    results are encoded on a separate background thread, so reading, processing and
+    writing all overlap.
+
+    The processors are put into non-realtime mode, and their latency is compensated
+    for, so the output files line up with the input files.
+
+    E.g.
+    @code
+    AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    OfflineRenderer renderer (formats, [&] { return createMyPluginChain(); });
+
+    Array<OfflineRenderer::Job> jobs;
+
+    for (auto& f : inputFiles)
+    {
+        OfflineRenderer::Job job;
+        job.inputFile = f;
+        job.outputFile = outputFolder.getChildFile (f.getFileNameWithoutExtension() + ".wav");
+        jobs.add (job);
+    }
+
+    auto results = renderer.render (jobs);
+    @endcode
+
+    @see AudioProcessor, AudioProcessorGraph, AudioFormatWriter
+*/
+class JUCE_API  OfflineRenderer
+{
+public:
+    //==============================================================================
+    /** A function that creates a new instance of the processor to render with.
+        It's called on the thread that calls render(), once for each rendering thread,
+        and the renderer deletes the processors that it returns.
+    */
+    using ProcessorFactory = std::function<AudioProcessor*()>;
+
+    /** Describes one file to render. */
+    struct Job
+    {
+        /** The audio file to feed into the processor. If this is File(), the processor
+            is given silence, which is handy for rendering synths or generators.
+        */
+        File inputFile;
+
+        /** The file to write. Its format is chosen by its file extension, and any
+            existing file will be replaced.
+        */
+        File outputFile;
+
+        /** The number of samples to write, or -1 to use the length of the input file. */
+        int64 lengthInSamples = -1;
+
+        /** A number of extra samples to render after the end of the input, e.g. to
+            capture the tail of a reverb.
+        */
+        int64 tailLengthInSamples = 0;
+
+        /** The sample rate to use when there's no input file. */
+        double sampleRate = 44100.0;
+    };
+
+    /** The settings that the renderer uses. */
+    struct Options
+    {
+        /** The number of files to render at once, or 0 to use one per CPU core. */
+        int numThreads = 0;
+
+        /** The number of threads that read the input files. */
+        int numReadThreads = 2;
+
+        /** The number of samples that are processed in each processBlock() call. */
+        int blockSize = 8192;
+
+        /** The bit depth of the output files. */
+        int bitsPerSample = 24;
+
+        /** The index of the output format's quality option to use, if it has any. */
+        int qualityOptionIndex = 0;
+    };
+
+    /** Called on one of the rendering threads as each job finishes, with the index
+        of the job in the array that was passed to render().
+        Return false to cancel the jobs that haven't finished yet.
+    */
+    using JobFinishedCallback = std::function<bool (int jobIndex, const Result&)>;
+
+    //==============================================================================
+    /** Creates a renderer.
+        The AudioFormatManager is used to open the input files and to find the formats
+        of the output files, and must stay alive for as long as the renderer does.
+    */
+    OfflineRenderer (AudioFormatManager& formatManager,
+                     ProcessorFactory createProcessor,
+                     const Options& options);
+
+    /** Creates a renderer with the default Options. */
+    OfflineRenderer (AudioFormatManager& formatManager,
+                     ProcessorFactory createProcessor);
+
+    /** Destructor. */
+    ~OfflineRenderer();
+
+    //==============================================================================
+    /** Renders a list of jobs, and waits for them all to finish.
+
+        The processors are created the first time they're needed, and are kept and
+        re-used by later calls, being reset() between each job.
+
+        @returns a Result for each job, in the same order as the jobs
+    */
+    Array<Result> render (const Array<Job>& jobs,
+                          const JobFinishedCallback& jobFinished = nullptr);
+
+    /** Stops a render() call that's running on another thread as soon as possible.
+        Any jobs that haven't finished will fail.
+    */
+    void cancel() noexcept              { cancelled = true; }
+
+private:
+    //==============================================================================
+    struct Worker;
+    struct Batch;
+
+    AudioFormatManager& formats;
+    const ProcessorFactory processorFactory;
+    const Options options;
+
+    OwnedArray<Worker> workers;
+    ScopedPointer<ThreadPool> pool;
+    ScopedPointer<BufferingAudioReadScheduler> readScheduler;
+    std::atomic<bool> cancelled { false };
+
+    Result renderJob (Worker&, const Job&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
+
+} // namespace juce
@@ -0,0 +1,377 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+struct OneShotSamplePlayer::Sound  : public ReferenceCountedObject
+{
+    Sound (int soundID, int note, double rate) : id (soundID), midiNoteNumber (note), sampleRate (rate) {}
+
+    const int id, midiNoteNumber;
+    const double sampleRate;
+    AudioSampleBuffer samples;
+
+    JUCE_DECLARE_NON_COPYABLE (Sound)
+};
+
+struct OneShotSamplePlayer::SoundTable  : public ReferenceCountedObject
+{
+    const Sound* findSound (int soundID) const noexcept
+    {
+        for (auto* s : sounds)
+            if (s->id == soundID)
+                return s;
+
+        return nullptr;
+    }
+
+    bool contains (const Sound* s) const noexcept
+    {
+        return sounds.contains (const_cast<Sound*> (s));
+    }
+
+    ReferenceCountedArray<Sound> sounds;
+};
+
+//==============================================================================
+struct OneShotSamplePlayer::Voice
+{
+    // A position in one of the sounds. Each voice has two of these, so that when it's
+    // stolen, the old sound can fade out while the new one starts.
+    struct Playhead
+    {
+        bool isActive() const noexcept     { return sound != nullptr; }
+
+        void render (AudioSampleBuffer& output, int startSample, int numSamples) noexcept
+        {
+            auto& source = sound->samples;
+            auto length = source.getNumSamples();
+            auto numSourceChannels = source.getNumChannels();
+            auto numOutputChannels = output.getNumChannels();
+
+            if (increment == 1.0 && fadeStep == 0)
+            {
+                auto start = (int) position;
+                auto num = jmin (numSamples, length - start);
+
+                for (int i = 0; i < numOutputChannels; ++i)
+                    output.addFrom (i, startSample, source, i % numSourceChannels, start, num, gain);
+
+                position += num;
+
+                if (start + num >= length)
+                    sound = nullptr;
+
+                return;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto index = (int) position;
+
+                if (index >= length || gain <= 0)
+                {
+                    sound = nullptr;
+                    return;
+                }
+
+                auto next = jmin (index + 1, length - 1);
+                auto alpha = (float) (position - index);
+
+                for (int chan = 0; chan < numOutputChannels; ++chan)
+                {
+                    auto* src = source.getReadPointer (chan % numSourceChannels);
+                    output.addSample (chan, startSample + i, gain * (src[index] + alpha * (src[next] - src[index])));
+                }
+
+                position += increment;
+                gain += fadeStep;
+            }
+        }
+
+        const Sound* sound = nullptr;
+        double position = 0, increment = 1.0;
+        float gain = 0, fadeStep = 0;
+    };
+
+    bool isPlaying() const noexcept     { return current.isActive(); }
+
+    void start (const Sound& s, float gain, double outputSampleRate, int fadeOutSamples, uint32 order) noexcept
+    {
+        fadeOut (fadeOutSamples);
+
+        current.sound = &s;
+        current.position = 0;
+        current.increment = s.sampleRate > 0 ? s.sampleRate / outputSampleRate : 1.0;
+        current.gain = gain;
+        current.fadeStep = 0;
+        startOrder = order;
+    }
+
+    void fadeOut (int fadeOutSamples) noexcept
+    {
+        if (current.isActive())
+        {
+            tail = current;
+            tail.fadeStep = -tail.gain / (float) fadeOutSamples;
+            current.sound = nullptr;
+        }
+    }
+
+    void stopIfNotIn (const SoundTable& table) noexcept
+    {
+        if (current.isActive() && ! table.contains (current.sound))  current.sound = nullptr;
+        if (tail.isActive() && ! table.contains (tail.sound))        tail.sound = nullptr;
+    }
+
+    void render (AudioSampleBuffer& output, int startSample, int numSamples) noexcept
+    {
+        if (current.isActive())  current.render (output, startSample, numSamples);
+        if (tail.isActive())     tail.render (output, startSample, numSamples);
+    }
+
+    Playhead current, tail;
+    uint32 startOrder = 0;
+};
+
+//==============================================================================
+OneShotSamplePlayer::OneShotSamplePlayer (int numVoices, int maxPendingTriggers)
+    : pendingTriggers (maxPendingTriggers)
+{
+    jassert (numVoices > 0);
+
+    for (int i = 0; i < numVoices; ++i)
+        voices.add (new Voice());
+
+    publishTable (new SoundTable());
+}
+
+OneShotSamplePlayer::~OneShotSamplePlayer()
+{
+}
+
+//==============================================================================
+int OneShotSamplePlayer::addSound (const AudioSampleBuffer& samples, double sampleRate, int midiNoteNumber)
+{
+    const ScopedLock sl (tableLock);
+
+    auto* sound = new Sound (nextSoundID++, midiNoteNumber, sampleRate);
+    sound->samples.makeCopyOf (samples);
+
+    auto* newTable = new SoundTable();
+    newTable->sounds.addArray (currentTable->sounds);
+    newTable->sounds.add (sound);
+    publishTable (newTable);
+
+    return sound->id;
+}
+
+int OneShotSamplePlayer::addSound (AudioFormatReader& reader, int midiNoteNumber)
+{
+    auto length = (int) reader.lengthInSamples;
+
+    if (length <= 0 || reader.numChannels == 0)
+        return 0;
+
+    AudioSampleBuffer samples (jmin (2, (int) reader.numChannels), length);
+    reader.read (&samples, 0, length, 0, true, true);
+
+    return addSound (samples, reader.sampleRate, midiNoteNumber);
+}
+
+void OneShotSamplePlayer::removeSound (int soundID)
+{
+    const ScopedLock sl (tableLock);
+
+    if (auto* sound = currentTable->findSound (soundID))
+    {
+        auto* newTable = new SoundTable();
+        newTable->sounds.addArray (currentTable->sounds);
+        newTable->sounds.removeObject (const_cast<Sound*> (sound));
+        publishTable (newTable);
+    }
+}
+
+void OneShotSamplePlayer::clearSounds()
+{
+    const ScopedLock sl (tableLock);
+    publishTable (new SoundTable());
+}
+
+int OneShotSamplePlayer::getNumSounds() const
+{
+    const ScopedLock sl (tableLock);
+    return currentTable->sounds.size();
+}
+
+void OneShotSamplePlayer::publishTable (SoundTable* newTable)
+{
+    if (currentTable != nullptr)
+    {
+        // once the audio thread has picked up the current table, it has stopped any voices
+        // that were playing sounds from the older ones, so they can safely be deleted
+        if (tableSeenByAudioThread.load() == currentTable.get())
+            retiredTables.clear();
+
+        retiredTables.add (currentTable);
+    }
+
+    currentTable = newTable;
+    liveTable = newTable;
+}
+
+OneShotSamplePlayer::SoundTable& OneShotSamplePlayer::startUsingLatestTable() noexcept
+{
+    auto* table = liveTable.load();
+
+    if (table != tableInUse)
+    {
+        for (auto* v : voices)
+            v->stopIfNotIn (*table);
+
+        tableInUse = table;
+        tableSeenByAudioThread = table;
+    }
+
+    return *table;
+}
+
+//==============================================================================
+bool OneShotSamplePlayer::trigger (int soundID, float gain) noexcept
+{
+    return pendingTriggers.push ({ soundID, -1, gain });
+}
+
+bool OneShotSamplePlayer::triggerNote (int midiNoteNumber, float velocity) noexcept
+{
+    return pendingTriggers.push ({ 0, midiNoteNumber, velocity });
+}
+
+void OneShotSamplePlayer::stopAllVoices() noexcept
+{
+    stopRequested = true;
+}
+
+void OneShotSamplePlayer::startSounds (const SoundTable& table, const Trigger& t) noexcept
+{
+    if (t.midiNoteNumber < 0)
+    {
+        if (auto* sound = table.findSound (t.soundID))
+            startVoice (*sound, t.gain);
+
+        return;
+    }
+
+    for (auto* sound : table.sounds)
+        if (sound->midiNoteNumber == t.midiNoteNumber)
+            startVoice (*sound, t.gain);
+}
+
+void OneShotSamplePlayer::startVoice (const Sound& sound, float gain) noexcept
+{
+    Voice* voiceToUse = nullptr;
+
+    for (auto* v : voices)
+    {
+        if (! v->isPlaying())
+        {
+            voiceToUse = v;
+            break;
+        }
+
+        // steal the voice that has been playing the longest
+        if (voiceToUse == nullptr || (int32) (v->startOrder - voiceToUse->startOrder) < 0)
+            voiceToUse = v;
+    }
+
+    voiceToUse->start (sound, gain, outputSampleRate, fadeOutSamples, nextVoiceOrder++);
+}
+
+//==============================================================================
+void OneShotSamplePlayer::prepareToPlay (int, double sampleRate)
+{
+    outputSampleRate = sampleRate > 0 ? sampleRate : 44100.0;
+    fadeOutSamples = jmax (1, roundToInt (outputSampleRate * 0.005));
+}
+
+void OneShotSamplePlayer::releaseResources()
+{
+}
+
+void OneShotSamplePlayer::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    static const MidiBuffer noMidi;
+
+    info.clearActiveBufferRegion();
+    renderNextBlock (*info.buffer, noMidi, info.startSample, info.numSamples);
+}
+
+void OneShotSamplePlayer::renderNextBlock (AudioSampleBuffer& outputBuffer, const MidiBuffer& midiMessages,
+                                           int startSample, int numSamples)
+{
+    JUCE_REALTIME_CONTEXT;
+
+    auto& table = startUsingLatestTable();
+
+    if (stopRequested.exchange (false))
+        for (auto* v : voices)
+            v->fadeOut (fadeOutSamples);
+
+    Trigger t;
+
+    while (pendingTriggers.pop (t))
+        startSounds (table, t);
+
+    MidiBuffer::Iterator iter (midiMessages);
+    iter.setNextSamplePosition (startSample);
+
+    const uint8* midiData;
+    int numBytes, position, renderedUpTo = startSample;
+    const int endSample = startSample + numSamples;
+
+    while (iter.getNextEvent (midiData, numBytes, position) && position < endSample)
+    {
+        // note-on, with a velocity of 0 meaning note-off
+        if (numBytes >= 3 && (midiData[0] & 0xf0) == 0x90 && midiData[2] != 0)
+        {
+            renderVoices (outputBuffer, renderedUpTo, position - renderedUpTo);
+            renderedUpTo = position;
+
+            startSounds (table, { 0, midiData[1], midiData[2] / 127.0f });
+        }
+    }
+
+    renderVoices (outputBuffer, renderedUpTo, endSample - renderedUpTo);
+}
+
+void OneShotSamplePlayer::renderVoices (AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept
+{
+    if (numSamples > 0)
+        for (auto* v : voices)
+            v->render (outputBuffer, startSample, numSamples);
+}
+
+} // namespace juce
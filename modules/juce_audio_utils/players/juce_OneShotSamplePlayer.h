@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioSource which plays short, preloaded sounds from a fixed pool of voices.
+
+    This is designed for things like UI feedback sounds and metronome clicks, where a
+    sound may be triggered many times a second from any thread, and needs to start
+    with a predictable latency. The sounds are held in memory, all the voices are
+    allocated up-front, and trigger() just pushes a request onto a lock-free queue,
+    so neither triggering nor rendering ever allocates or waits for a lock.
+
+    Triggers that arrive via trigger() or triggerNote() start at the beginning of the
+    next block that is rendered. Note-on events passed to renderNextBlock() start at
+    their exact sample position, so in a plugin you can use this for sample-accurate
+    clicks.
+
+    When all the voices are busy, the one that has been playing the longest is
+    stolen - its sound is faded out over a few milliseconds rather than being cut
+    off, so there's no click.
+
+    Sounds can be added and removed at any time. The audio thread picks up the new
+    set of sounds at the start of its next block, and any sounds that were removed
+    are only deleted once it's no longer using them.
+
+    @see SoundPlayer
+*/
+class JUCE_API  OneShotSamplePlayer  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a player.
+
+        @param numVoices            the number of sounds that can play at once
+        @param maxPendingTriggers   the number of triggers that can be queued between two
+                                    audio blocks - any more than this will be ignored
+    */
+    OneShotSamplePlayer (int numVoices = 16, int maxPendingTriggers = 128);
+
+    /** Destructor. */
+    ~OneShotSamplePlayer();
+
+    //==============================================================================
+    /** Adds a sound, copying the samples from a buffer.
+
+        If the sound's sample rate differs from the output's, it'll be resampled as it
+        plays. If midiNoteNumber is 0 to 127, the sound will also be played by note-on
+        events for that note.
+
+        @returns an ID which you can pass to trigger() or removeSound()
+    */
+    int addSound (const AudioSampleBuffer& samples, double sampleRate, int midiNoteNumber = -1);
+
+    /** Adds a sound, reading the whole of an AudioFormatReader into memory.
+
+        Only the first two channels of the reader are used.
+
+        @returns an ID which you can pass to trigger() or removeSound(), or 0 if the
+                 reader is empty
+    */
+    int addSound (AudioFormatReader& reader, int midiNoteNumber = -1);
+
+    /** Removes one of the sounds. Any voices that are playing it will be stopped. */
+    void removeSound (int soundID);
+
+    /** Removes all the sounds. */
+    void clearSounds();
+
+    /** Returns the number of sounds that have been added. */
+    int getNumSounds() const;
+
+    //==============================================================================
+    /** Starts playing one of the sounds.
+
+        This can be called from any thread, including the audio thread, and doesn't
+        allocate or lock. The sound will start at the beginning of the next block.
+
+        @returns false if too many triggers have been queued since the last block
+    */
+    bool trigger (int soundID, float gain = 1.0f) noexcept;
+
+    /** Starts playing any sounds which were added for the given MIDI note.
+        Like trigger(), this can be called from any thread.
+    */
+    bool triggerNote (int midiNoteNumber, float velocity = 1.0f) noexcept;
+
+    /** Fades out all the voices that are currently playing.
+        This can be called from any thread.
+    */
+    void stopAllVoices() noexcept;
+
+    /** Returns the number of voices in the pool. */
+    int getNumVoices() const noexcept                   { return voices.size(); }
+
+    //==============================================================================
+    /** Adds the output of the voices to a buffer.
+
+        Any note-on events in the MIDI buffer will start their sounds at the right
+        sample position. Unlike getNextAudioBlock(), this adds to the buffer's existing
+        contents rather than replacing them.
+    */
+    void renderNextBlock (AudioSampleBuffer& outputBuffer, const MidiBuffer& midiMessages,
+                          int startSample, int numSamples);
+
+    //==============================================================================
+    /** @internal */
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    /** @internal */
+    void releaseResources() override;
+    /** @internal */
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    struct Sound;
+    struct SoundTable;
+    struct Voice;
+
+    struct Trigger
+    {
+        int soundID, midiNoteNumber;
+        float gain;
+    };
+
+    OwnedArray<Voice> voices;
+    MultiProducerFifo<Trigger> pendingTriggers;
+    std::atomic<bool> stopRequested { false };
+    double outputSampleRate = 44100.0;
+    int fadeOutSamples = 220;
+    uint32 nextVoiceOrder = 0;
+
+    // The sounds are kept in immutable tables, which are swapped as a whole when one is
+    // added or removed. Replaced tables are kept in retiredTables until the audio thread
+    // has shown that it's using the latest one.
+    CriticalSection tableLock;
+    ReferenceCountedObjectPtr<SoundTable> currentTable;
+    ReferenceCountedArray<SoundTable> retiredTables;
+    std::atomic<SoundTable*> liveTable { nullptr }, tableSeenByAudioThread { nullptr };
+    SoundTable* tableInUse = nullptr;
+    int nextSoundID = 1;
+
+    void publishTable (SoundTable*);
+    SoundTable& startUsingLatestTable() noexcept;
+    void startSounds (const SoundTable&, const Trigger&) noexcept;
+    void startVoice (const Sound&, float gain) noexcept;
+    void renderVoices (AudioSampleBuffer&, int startSample, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OneShotSamplePlayer)
+};
+
+} // namespace juce
@@ -155,6 +155,7 @@ SoundPlayer::SoundPlayer()
     : sampleRate (44100.0), bufferSize (512)
 {
     formatManager.registerBasicFormats();
+    mixer.addInputSource (&preloadedSounds, false);
     player.setSource (&mixer);
 }
 
@@ -243,6 +244,30 @@ void SoundPlayer::playTestSound()
     play (newSound, true, true);
 }
 
+//==============================================================================
+int SoundPlayer::preload (const File& file)
+{
+    if (file.existsAsFile())
+        if (ScopedPointer<AudioFormatReader> reader = formatManager.createReaderFor (file))
+            return preloadedSounds.addSound (*reader);
+
+    return 0;
+}
+
+int SoundPlayer::preload (const void* resourceData, size_t resourceSize)
+{
+    if (resourceData != nullptr && resourceSize > 0)
+        if (ScopedPointer<AudioFormatReader> reader = formatManager.createReaderFor (new MemoryInputStream (resourceData, resourceSize, false)))
+            return preloadedSounds.addSound (*reader);
+
+    return 0;
+}
+
+bool SoundPlayer::playPreloaded (int soundID, float gain) noexcept
+{
+    return preloadedSounds.trigger (soundID, gain);
+}
+
 //==============================================================================
 void SoundPlayer::audioDeviceIOCallback (const float** inputChannelData,
                                          int numInputChannels,
@@ -32,6 +32,12 @@ namespace juce
     A simple sound player that you can add to the AudioDeviceManager to play
     simple sounds.
 
+    Each call to one of the play() methods creates a new set of audio sources for the
+    sound, which is fine for occasional sounds. For sounds that are played often, such
+    as UI feedback or metronome clicks, use preload() to load them into memory once, and
+    then playPreloaded() to trigger them - this doesn't allocate or lock, and can be
+    called from any thread.
+
     @see AudioProcessor, AudioProcessorGraph
 */
 class JUCE_API  SoundPlayer             : public AudioIODeviceCallback
@@ -107,6 +113,31 @@ public:
      */
     void playTestSound();
 
+    //==============================================================================
+    /** Loads a sound file into memory, so that it can be played with playPreloaded().
+        @returns an ID for the sound, or 0 if the file couldn't be read
+    */
+    int preload (const File& file);
+
+    /** Loads a sound from a JUCE resource, so that it can be played with playPreloaded().
+        @returns an ID for the sound, or 0 if the data couldn't be read
+    */
+    int preload (const void* resourceData, size_t resourceSize);
+
+    /** Plays a sound which was loaded with preload().
+
+        This can be called from any thread, and doesn't allocate or lock. The sound
+        starts at the beginning of the next audio block.
+
+        @see OneShotSamplePlayer::trigger
+    */
+    bool playPreloaded (int soundID, float gain = 1.0f) noexcept;
+
+    /** Returns the player which plays the preloaded sounds.
+        You can use this to add sounds from a buffer, or assign sounds to MIDI notes.
+    */
+    OneShotSamplePlayer& getPreloadedSoundPlayer() noexcept     { return preloadedSounds; }
+
     //==============================================================================
     /** @internal */
     void audioDeviceIOCallback (const float**, int, float**, int, int) override;
@@ -123,6 +154,7 @@ private:
     AudioSourcePlayer player;
     MixerAudioSource mixer;
     OwnedArray<AudioSource> sources;
+    OneShotSamplePlayer preloadedSounds;
 
     //==============================================================================
     double sampleRate;
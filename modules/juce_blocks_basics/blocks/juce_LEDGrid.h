@@ -71,6 +71,12 @@ public:
     struct Renderer     : public juce::ReferenceCountedObject
     {
         virtual ~Renderer();
+
+        /** Called when the block is ready to display a new frame.
+            If the connection to the device can't keep up with the frame rate, this
+            will be called less often, so any animation should be based on the time
+            rather than on the number of calls.
+        */
         virtual void renderLEDGrid (LEDGrid&) = 0;
 
         /** The Renderer class is reference-counted, so always use a Renderer::Ptr when
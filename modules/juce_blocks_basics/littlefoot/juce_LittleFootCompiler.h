@@ -69,8 +69,9 @@ struct Compiler
 
             compiledObjectCode.clear();
 
-            CodeGenerator codeGen (compiledObjectCode, stb);
+            CodeGenerator codeGen (compiledObjectCode, stb, generateSuperInstructions);
             codeGen.generateCode (stb.blockBeingParsed, stb.heapSizeRequired);
+            codeSizeReport = codeGen.createSizeReport();
             return Result::ok();
         }
         catch (String error)
@@ -79,6 +80,11 @@ struct Compiler
         }
     }
 
+    /** After a successful compilation, this returns a description of the program's size,
+        the space taken by each of its functions, and how much the optimiser managed to save.
+    */
+    const String& getCodeSizeReport() const noexcept    { return codeSizeReport; }
+
     /** After a successful compilation, this returns the finished Program. */
     Program getCompiledProgram() const noexcept
     {
@@ -90,7 +96,18 @@ struct Compiler
     */
     Array<uint8> compiledObjectCode;
 
+    /** If this is enabled, the compiler will replace some common pairs of instructions
+        with single combined ones, which run faster.
+
+        Only Runners from this version of the library onwards know about these
+        instructions, so leave this turned off when compiling programs that will be
+        sent to a BLOCKS device.
+    */
+    bool generateSuperInstructions = false;
+
 private:
+    String codeSizeReport;
+
     struct Statement;
     struct Expression;
     struct BlockStatement;
@@ -517,6 +534,7 @@ private:
             }
 
             match (Token::closeParen);
+            f->name = name;
             f->functionID = createFunctionID (name, returnType, f->getArgumentTypes());
 
             if (findFunction (f->functionID) != nullptr || findNativeFunction (f->functionID) != nullptr)
@@ -942,8 +960,8 @@ private:
     //==============================================================================
     struct CodeGenerator
     {
-        CodeGenerator (Array<uint8>& output, const SyntaxTreeBuilder& stb)
-            : outputCode (output), syntaxTree (stb) {}
+        CodeGenerator (Array<uint8>& output, const SyntaxTreeBuilder& stb, bool useSuperInstructions)
+            : outputCode (output), syntaxTree (stb), shouldUseSuperInstructions (useSuperInstructions) {}
 
         void generateCode (BlockPtr outerBlock, uint32 heapSizeBytesRequired)
         {
@@ -967,7 +985,13 @@ private:
             for (auto f : syntaxTree.functions)
                 f->emit (*this);
 
-            removeJumpsToNextInstruction (codeStart);
+            unoptimisedSize = outputCode.size();
+            optimise (codeStart);
+            optimisedSize = outputCode.size();
+
+            if (shouldUseSuperInstructions)
+                combineInstructionPairs (codeStart);
+
             resolveMarkers();
 
             Program::writeInt16 (outputCode.begin() + 2, (int16) outputCode.size());
@@ -979,6 +1003,39 @@ private:
         //==============================================================================
         Array<uint8>& outputCode;
         const SyntaxTreeBuilder& syntaxTree;
+        const bool shouldUseSuperInstructions;
+        int unoptimisedSize = 0, optimisedSize = 0;
+
+        String createSizeReport() const
+        {
+            const Program program (outputCode.begin(), (uint32) outputCode.size());
+            auto& functions = syntaxTree.functions;
+            auto codeStart = (int) Program::programHeaderSize + functions.size() * (int) (sizeof (FunctionID) + sizeof (int16));
+
+            String report;
+            report << "Program size: " << outputCode.size() << " bytes ("
+                   << codeStart << " bytes of header, " << (outputCode.size() - codeStart) << " bytes of code)\n"
+                   << "Saved by optimisation: " << (unoptimisedSize - optimisedSize) << " bytes\n";
+
+            if (shouldUseSuperInstructions)
+                report << "Saved by super-instructions: " << (optimisedSize - outputCode.size()) << " bytes\n";
+
+            report << "Heap size: " << (int) program.getHeapSizeBytes() << " bytes, globals: " << (int) program.getNumGlobals() << "\n";
+
+            for (int i = 0; i < functions.size(); ++i)
+            {
+                auto f = functions.getUnchecked (i);
+                StringArray args;
+
+                for (auto& arg : f->arguments)
+                    args.add (getTypeName (arg.type));
+
+                report << getTypeName (f->returnType) << " " << f->name << " (" << args.joinIntoString (", ") << "): "
+                       << (int) (program.getFunctionEndAddress ((uint32) i) - program.getFunctionStartAddress ((uint32) i)) << " bytes\n";
+            }
+
+            return report;
+        }
 
         struct Marker  { int index = 0; };
         struct MarkerAndAddress  { Marker marker; int address; };
@@ -1034,8 +1091,52 @@ private:
                     m.address -= size;
         }
 
-        void removeJumpsToNextInstruction (int address)
+        int getOpSize (int address) const noexcept
         {
+            return 1 + Program::getNumExtraBytesForOpcode ((OpCode) outputCode.getUnchecked (address));
+        }
+
+        static bool isConditionalJump (OpCode op) noexcept    { return op == OpCode::jumpIfTrue || op == OpCode::jumpIfFalse; }
+        static OpCode getOppositeJump (OpCode op) noexcept    { return op == OpCode::jumpIfTrue ? OpCode::jumpIfFalse : OpCode::jumpIfTrue; }
+
+        bool isMarkerUsed (Marker marker) const noexcept
+        {
+            for (auto m : markersToResolve)
+                if (m.marker.index == marker.index)
+                    return true;
+
+            return false;
+        }
+
+        // (markers that nothing refers to, e.g. an unused break target, don't count)
+        bool isJumpTarget (int address) const noexcept
+        {
+            for (auto m : resolvedMarkers)
+                if (m.address == address && isMarkerUsed (m.marker))
+                    return true;
+
+            return false;
+        }
+
+        void optimise (int codeStart)
+        {
+            for (;;)
+            {
+                bool changed = threadJumps (codeStart);
+                changed = removeUnreachableCode (codeStart) || changed;
+                changed = removeJumpsToNextInstruction (codeStart) || changed;
+                changed = simplifyConditionalJumps (codeStart) || changed;
+                changed = forwardStoredValues (codeStart) || changed;
+
+                if (! changed)
+                    break;
+            }
+        }
+
+        bool removeJumpsToNextInstruction (int address)
+        {
+            bool changed = false;
+
             while (address < outputCode.size())
             {
                 auto op = (OpCode) outputCode.getUnchecked (address);
@@ -1050,6 +1151,7 @@ private:
                         if (getResolvedMarkerAddress (marker) == address + opSize)
                         {
                             removeCode (address, opSize);
+                            changed = true;
                             continue;
                         }
                     }
@@ -1057,6 +1159,256 @@ private:
 
                 address += opSize;
             }
+
+            return changed;
+        }
+
+        // Follows a chain of unconditional jumps, giving up if it goes round in a loop
+        Marker getFinalJumpTarget (Marker target) const
+        {
+            auto original = target;
+
+            for (int numHops = 0; numHops < 16; ++numHops)
+            {
+                auto address = getResolvedMarkerAddress (target);
+
+                if (address >= outputCode.size() || (OpCode) outputCode.getUnchecked (address) != OpCode::jump)
+                    return target;
+
+                auto next = getMarkerAtAddress (address + 1);
+
+                if (next.index == 0 || next.index == target.index)
+                    return target;
+
+                target = next;
+            }
+
+            return original;
+        }
+
+        // Makes jumps that land on another jump go straight to its destination, and
+        // replaces jumps to a return instruction with the return itself
+        bool threadJumps (int codeStart)
+        {
+            bool changed = false;
+
+            for (int i = markersToResolve.size(); --i >= 0;)
+            {
+                auto& m = markersToResolve.getReference (i);
+                auto address = m.address - 1;
+
+                if (address < codeStart)
+                    continue;
+
+                auto op = (OpCode) outputCode.getUnchecked (address);
+
+                if (op != OpCode::jump && ! isConditionalJump (op))
+                    continue;
+
+                auto finalTarget = getFinalJumpTarget (m.marker);
+
+                if (finalTarget.index != m.marker.index)
+                {
+                    m.marker = finalTarget;
+                    changed = true;
+                }
+
+                if (op == OpCode::jump)
+                {
+                    auto targetAddress = getResolvedMarkerAddress (m.marker);
+                    auto targetOp = (OpCode) outputCode.getUnchecked (targetAddress);
+
+                    if (targetOp == OpCode::retVoid || targetOp == OpCode::retValue)
+                    {
+                        auto numArgs = outputCode.getUnchecked (targetAddress + 1);
+                        markersToResolve.remove (i);
+                        outputCode.set (address, (uint8) targetOp);
+                        outputCode.set (address + 1, numArgs);
+                        removeCode (address + 2, 1);
+                        changed = true;
+                    }
+                }
+            }
+
+            return changed;
+        }
+
+        // Removes any code after a jump or return that nothing can jump to
+        bool removeUnreachableCode (int address)
+        {
+            bool changed = false;
+
+            while (address < outputCode.size())
+            {
+                auto op = (OpCode) outputCode.getUnchecked (address);
+                address += getOpSize (address);
+
+                if (op == OpCode::jump || op == OpCode::retVoid || op == OpCode::retValue)
+                {
+                    auto end = address;
+
+                    while (end < outputCode.size() && ! isJumpTarget (end))
+                        end += getOpSize (end);
+
+                    if (end > address)
+                    {
+                        removeCode (address, end - address);
+                        changed = true;
+                    }
+                }
+            }
+
+            return changed;
+        }
+
+        bool simplifyConditionalJumps (int address)
+        {
+            bool changed = false;
+
+            while (address < outputCode.size())
+            {
+                auto op = (OpCode) outputCode.getUnchecked (address);
+                auto nextAddress = address + getOpSize (address);
+
+                if (nextAddress < outputCode.size() && ! isJumpTarget (nextAddress))
+                {
+                    auto nextOp = (OpCode) outputCode.getUnchecked (nextAddress);
+
+                    if (isConditionalJump (nextOp))
+                    {
+                        // a test that a conditional jump can do by itself, e.g. "if (! x)" or "if (a != b)"
+                        if (op == OpCode::logicalNot || op == OpCode::testZE_int32 || op == OpCode::testNZ_int32)
+                        {
+                            removeCode (address, 1);
+
+                            if (op != OpCode::testNZ_int32)
+                                outputCode.set (address, (uint8) getOppositeJump (nextOp));
+
+                            changed = true;
+                            continue;
+                        }
+                    }
+                    else if (isConditionalJump (op) && nextOp == OpCode::jump)
+                    {
+                        // a conditional jump over an unconditional one can be turned around
+                        auto jumpEnd = nextAddress + getOpSize (nextAddress);
+
+                        if (getResolvedMarkerAddress (getMarkerAtAddress (address + 1)) == jumpEnd)
+                        {
+                            auto newTarget = getMarkerAtAddress (nextAddress + 1);
+
+                            for (auto& m : markersToResolve)
+                                if (m.address == address + 1)
+                                    m.marker = newTarget;
+
+                            outputCode.set (address, (uint8) getOppositeJump (op));
+                            removeCode (nextAddress, jumpEnd - nextAddress);
+                            changed = true;
+                        }
+                    }
+                }
+
+                address += getOpSize (address);
+            }
+
+            return changed;
+        }
+
+        // Where a value is stored in a variable and then immediately read back, this keeps
+        // a copy on the stack instead, which is smaller than the second access
+        bool forwardStoredValues (int address)
+        {
+            bool changed = false;
+
+            while (address < outputCode.size())
+            {
+                auto op = (OpCode) outputCode.getUnchecked (address);
+                auto nextAddress = address + getOpSize (address);
+
+                if (nextAddress < outputCode.size() && ! isJumpTarget (nextAddress))
+                {
+                    auto nextOp = (OpCode) outputCode.getUnchecked (nextAddress);
+
+                    int index = -1, nextIndex = -2, maxIndex = 32766;
+
+                    if (op == OpCode::dropToStack && nextOp == OpCode::dupOffset)
+                    {
+                        index     = outputCode.getUnchecked (address + 1);
+                        nextIndex = outputCode.getUnchecked (nextAddress + 1);
+                        maxIndex  = 126;
+                    }
+                    else if ((op == OpCode::dropToGlobal  && nextOp == OpCode::dupFromGlobal)
+                          || (op == OpCode::dropToStack16 && nextOp == OpCode::dupOffset16))
+                    {
+                        index     = Program::readInt16 (outputCode.begin() + address + 1);
+                        nextIndex = Program::readInt16 (outputCode.begin() + nextAddress + 1);
+                    }
+
+                    if (index == nextIndex && index <= maxIndex)
+                    {
+                        removeCode (nextAddress, getOpSize (nextAddress));
+
+                        // after the dup, a stack variable is one place further down
+                        if (op == OpCode::dropToStack)
+                            outputCode.set (address + 1, (uint8) (index + 1));
+                        else if (op == OpCode::dropToStack16)
+                            Program::writeInt16 (outputCode.getRawDataPointer() + address + 1, (int16) (index + 1));
+
+                        outputCode.insert (address, (uint8) OpCode::dup);
+                        shiftMarkersAfter (address);
+                        changed = true;
+                    }
+                }
+
+                address += getOpSize (address);
+            }
+
+            return changed;
+        }
+
+        // After inserting a byte at this address, moves the markers that come after it
+        void shiftMarkersAfter (int address)
+        {
+            for (auto& m : markersToResolve)
+                if (m.address > address)
+                    ++m.address;
+
+            for (auto& m : resolvedMarkers)
+                if (m.address > address)
+                    ++m.address;
+        }
+
+        void combineInstructionPairs (int address)
+        {
+            while (address < outputCode.size())
+            {
+                auto op = (OpCode) outputCode.getUnchecked (address);
+                auto nextAddress = address + 1 + Program::getNumExtraBytesForOpcode (op);
+
+                // the second op can't be removed if something jumps straight to it
+                if (nextAddress < outputCode.size() && ! isJumpTarget (nextAddress))
+                {
+                    auto nextOp = (OpCode) outputCode.getUnchecked (nextAddress);
+
+                    if (nextOp == OpCode::add_int32 && (op == OpCode::push1 || op == OpCode::push8))
+                    {
+                        auto value = op == OpCode::push1 ? (uint8) 1 : outputCode.getUnchecked (address + 1);
+
+                        outputCode.set (address, (uint8) OpCode::addImmediate8);
+                        outputCode.set (address + 1, value);
+
+                        if (op == OpCode::push8)
+                            removeCode (nextAddress, 1);
+                    }
+                    else if (op == OpCode::sub_int32 && nextOp >= OpCode::testZE_int32 && nextOp <= OpCode::testLE_int32)
+                    {
+                        outputCode.set (address, (uint8) ((int) OpCode::compareZE_int32 + ((int) nextOp - (int) OpCode::testZE_int32)));
+                        removeCode (nextAddress, 1);
+                    }
+                }
+
+                address += 1 + Program::getNumExtraBytesForOpcode ((OpCode) outputCode.getUnchecked (address));
+            }
         }
 
         Marker breakTarget, continueTarget;
@@ -1169,6 +1521,7 @@ private:
     //==============================================================================
     struct Function  : public AllocatedObject
     {
+        String name;
         FunctionID functionID;
         Type returnType;
         Array<Variable> arguments;
@@ -1287,7 +1640,18 @@ private:
         Statement* simplify (SyntaxTreeBuilder& stb) override
         {
             for (int i = 0; i < statements.size(); ++i)
-                statements.set (i, statements.getReference(i)->simplify (stb));
+            {
+                auto s = statements.getReference(i)->simplify (stb);
+                statements.set (i, s);
+
+                // anything after a return, break or continue can never be reached
+                if (s->alwaysReturns() || dynamic_cast<BreakStatement*> (s) != nullptr
+                                       || dynamic_cast<ContinueStatement*> (s) != nullptr)
+                {
+                    statements.removeRange (i + 1, statements.size());
+                    break;
+                }
+            }
 
             return this;
         }
@@ -1520,6 +1884,12 @@ private:
             iterator = iterator->simplify (stb);
             body = body->simplify (stb);
             condition = condition->simplify (stb);
+
+            // a loop that's never entered only needs its initialiser
+            if (auto literal = dynamic_cast<LiteralValue*> (condition))
+                if (! isDoLoop && ! literal->value)
+                    return initialiser;
+
             return this;
         }
 
@@ -1855,6 +2225,9 @@ private:
 
         ExpPtr simplifyInt (int a, int b, LiteralValue* literal)
         {
+            if (b == 0 && (operation == Token::divide || operation == Token::modulo))
+                return this; // leave this to fail at run-time
+
             if (operation == Token::plus)                 { literal->value = a +  b; return literal; }
             if (operation == Token::minus)                { literal->value = a -  b; return literal; }
             if (operation == Token::times)                { literal->value = a *  b; return literal; }
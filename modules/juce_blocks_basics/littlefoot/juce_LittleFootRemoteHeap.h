@@ -96,7 +96,10 @@ struct LittleFootRemoteHeap
         if (readLittleEndianBitsInBuffer (targetData, startBit, numBits) != value)
         {
             writeLittleEndianBitsInBuffer (targetData, startBit, numBits, value);
-            invalidateData();
+            needsSyncing = true;
+
+            if (programStateKnown && startBit < programSize * 8)
+                programStateKnown = false;
         }
     }
 
@@ -120,6 +123,14 @@ struct LittleFootRemoteHeap
         return ! needsSyncing;
     }
 
+    /** Returns true if some of the changes are still being sent, or are waiting
+        to be acknowledged by the device.
+    */
+    bool hasPendingMessages() const noexcept
+    {
+        return ! messagesSent.isEmpty();
+    }
+
     static bool isAllZero (const uint8* data, size_t size) noexcept
     {
         for (size_t i = 0; i < size; ++i)
@@ -156,17 +167,28 @@ struct LittleFootRemoteHeap
             }
         }
 
+        // This keeps sending packets until more than maxBytesInFlight bytes are waiting
+        // for an ACK, sending more as soon as earlier ones are acknowledged, and resending
+        // any that have gone unacknowledged for too long.
+        auto now = Time::getCurrentTime();
+        auto resendTime = now - RelativeTime::milliseconds (resendTimeoutMs);
+        int bytesInFlight = 0;
+
         for (auto* m : messagesSent)
         {
-            if (m->dispatchTime >= Time::getCurrentTime() - RelativeTime::milliseconds (250))
+            if (m->dispatchTime != Time() && m->dispatchTime >= resendTime)
+            {
+                bytesInFlight += m->packet.size();
+                continue;
+            }
+
+            if (bytesInFlight > maxBytesInFlight)
                 break;
 
-            m->dispatchTime = Time::getCurrentTime();
+            m->dispatchTime = now;
             bi.sendMessageToDevice (m->packet);
+            bytesInFlight += m->packet.size();
             //DBG ("Sending packet " << (int) m->packetIndex << " - " << m->packet.size() << " bytes, device " << bi.getDeviceIndex());
-
-            if (getTotalSizeOfMessagesSent() > 200)
-                break;
         }
     }
 
@@ -248,16 +270,8 @@ private:
     OwnedArray<ChangeMessage> messagesSent;
     uint32 lastPacketIndexReceived = 0;
 
-    int getTotalSizeOfMessagesSent() const noexcept
-    {
-        int total = 0;
-
-        for (auto* m : messagesSent)
-            if (m->dispatchTime != Time())
-                total += m->packet.size();
-
-        return total;
-    }
+    static constexpr int maxBytesInFlight = 200;
+    static constexpr int resendTimeoutMs = 250;
 
     void dumpStatus()
     {
@@ -287,18 +301,63 @@ private:
        #endif
     }
 
+    // Works out the cheapest way to describe the changes using the protocol's
+    // skip/set commands, measured in bits, by finding the best encoding for each
+    // prefix of the block in turn.
     struct Diff
     {
         Diff (uint16* current, const uint8* target, size_t blockSizeToUse)
             : newData (target), blockSize (blockSizeToUse)
         {
-            ranges.ensureStorageAllocated ((int) blockSize);
+            auto size = (int) blockSize;
+
+            HeapBlock<bool> isUnchanged (size);
+            HeapBlock<int> unchangedRunStart (size), sameValueRunStart (size);
 
-            for (int i = 0; i < (int) blockSize; ++i)
-                ranges.add ({ i, 1, newData[i] == current[i], false });
+            for (int i = 0; i < size; ++i)
+            {
+                isUnchanged[i] = newData[i] == current[i];
+                unchangedRunStart[i] = (i > 0 && isUnchanged[i] && isUnchanged[i - 1]) ? unchangedRunStart[i - 1] : i;
+                sameValueRunStart[i] = (i > 0 && newData[i] == newData[i - 1]) ? sameValueRunStart[i - 1] : i;
+            }
+
+            HeapBlock<Step> best (size + 1);
+            best[0] = { 0, 0, 0, false, false, 0 };
+
+            for (int end = 1; end <= size; ++end)
+            {
+                auto& b = best[end];
+                b.cost = std::numeric_limits<int>::max();
+
+                auto tryRange = [&] (int start, bool skip, bool mixed, int cost)
+                {
+                    cost += best[start].cost;
+
+                    if (cost < b.cost)
+                        b = { cost, start, end - start, skip, mixed,
+                              skip ? best[start].lastValue : newData[end - 1] };
+                };
+
+                auto last = end - 1;
+
+                if (isUnchanged[last])
+                {
+                    tryRange (unchangedRunStart[last], true, false, PacketBuilder::getSkipBytesNumBits (end - unchangedRunStart[last]));
+
+                    if (unchangedRunStart[last] < last)
+                        tryRange (last, true, false, PacketBuilder::getSkipBytesNumBits (1));
+                }
+
+                for (auto start : { sameValueRunStart[last], last })
+                    tryRange (start, false, false, PacketBuilder::getSetBytesWithValueNumBits (end - start, newData[last] == best[start].lastValue));
+
+                for (int start = jmax (0, end - maxSequenceLength); start < last; ++start)
+                    tryRange (start, false, true, PacketBuilder::getSetBytesNumBits (end - start));
+            }
+
+            for (int end = size; end > 0; end = best[end].start)
+                ranges.insert (0, { best[end].start, best[end].length, best[end].isSkipped, best[end].isMixed });
 
-            coalesceUniformRegions();
-            coalesceSequences();
             trim();
         }
 
@@ -373,48 +432,21 @@ private:
             bool isSkipped, isMixed;
         };
 
-        const uint8* const newData;
-        const size_t blockSize;
-        Array<ByteSequence> ranges;
-
-        void coalesceUniformRegions()
+        struct Step
         {
-            for (int i = ranges.size(); --i > 0;)
-            {
-                auto& r1 = ranges.getReference (i - 1);
-                auto r2 = ranges.getReference (i);
+            int cost, start, length;
+            bool isSkipped, isMixed;
+            uint8 lastValue;
+        };
 
-                if (r1.isSkipped == r2.isSkipped
-                     && (r1.isSkipped || newData[r1.index] == newData[r2.index]))
-                {
-                    r1.length += r2.length;
-                    ranges.remove (i);
-                    i = jmin (ranges.size() - 1, i + 1);
-                }
-            }
-        }
+        // a sequence must be small enough to always fit into a single packet
+        static constexpr int maxSequenceLength = 32;
 
-        void coalesceSequences()
-        {
-            for (int i = ranges.size(); --i > 0;)
-            {
-                auto& r1 = ranges.getReference (i - 1);
-                auto r2 = ranges.getReference (i);
+        using PacketBuilder = typename ImplementationClass::PacketBuilder;
 
-                if (! (r1.isSkipped || r2.isSkipped)
-                     && (r1.isMixed || r1.length == 1)
-                     && (r2.isMixed || r2.length == 1))
-                {
-                    if (r1.length + r2.length < 32)
-                    {
-                        r1.length += r2.length;
-                        r1.isMixed = true;
-                        ranges.remove (i);
-                        i = jmin (ranges.size() - 1, i + 1);
-                    }
-                }
-            }
-        }
+        const uint8* const newData;
+        const size_t blockSize;
+        Array<ByteSequence> ranges;
 
         void trim()
         {
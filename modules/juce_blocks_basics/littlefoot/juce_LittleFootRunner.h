@@ -36,6 +36,18 @@ namespace littlefoot
  #define LITTLEFOOT_DUMP_PROGRAM 0
 #endif
 
+/*  When this is enabled, the Runner jumps straight from each op to the next one through
+    a table of label addresses, rather than going back round a switch statement. This
+    relies on the "labels as values" extension, so is only available with GCC and clang.
+*/
+#ifndef LITTLEFOOT_USE_COMPUTED_GOTO
+ #if (defined (__GNUC__) || defined (__clang__)) && ! RUNNING_ON_REAL_BLOCK_DEVICE
+  #define LITTLEFOOT_USE_COMPUTED_GOTO 1
+ #else
+  #define LITTLEFOOT_USE_COMPUTED_GOTO 0
+ #endif
+#endif
+
 using int8        = signed char;
 using uint8       = unsigned char;
 using int16       = signed short;
@@ -112,6 +124,13 @@ using FunctionID  = int16;
     OP       (getHeapBits) \
     OP       (setHeapByte) \
     OP       (setHeapInt) \
+    OP_INT8  (addImmediate8) \
+    OP       (compareZE_int32) \
+    OP       (compareNZ_int32) \
+    OP       (compareGT_int32) \
+    OP       (compareGE_int32) \
+    OP       (compareLT_int32) \
+    OP       (compareLE_int32) \
 
 enum class OpCode  : uint8
 {
@@ -487,6 +506,39 @@ struct Runner
         return FunctionExecutionContext (*this, function).run();
     }
 
+    /** Calls a function a number of times in a row, stopping if it fails.
+
+        This only has to look the function up once, so it's quicker than calling
+        callFunction() in a loop when a simulator needs to run the same function lots
+        of times. The time-out function is checked as each call runs, in the same way
+        as FunctionExecutionContext::run().
+    */
+    template <typename TimeOutCheckFunction>
+    ErrorCode callFunctionRepeatedly (FunctionID function, uint32 numTimes, TimeOutCheckFunction hasTimedOut) noexcept
+    {
+        const FunctionExecutionContext initialContext (*this, function);
+
+        if (! initialContext.isValid())
+            return ErrorCode::unknownFunction;
+
+        for (uint32 i = 0; i < numTimes; ++i)
+        {
+            auto context = initialContext;
+            auto result = context.run (hasTimedOut);
+
+            if (result != ErrorCode::ok)
+                return result;
+        }
+
+        return ErrorCode::ok;
+    }
+
+    /** Calls a function a number of times in a row, stopping if it fails. */
+    ErrorCode callFunctionRepeatedly (FunctionID function, uint32 numTimes) noexcept
+    {
+        return callFunctionRepeatedly (function, numTimes, [] { return false; });
+    }
+
     /** */
     static constexpr uint32 totalProgramAndHeapSpace = programAndHeapSpace;
 
@@ -635,6 +687,12 @@ struct Runner
         template <typename... Args>
         void setArguments (Args... args) noexcept   { pushArguments (args...); push0(); /* (dummy return address) */ }
 
+        /** */
+        ErrorCode run() noexcept
+        {
+            return run ([] { return false; });
+        }
+
         /** */
         template <typename TimeOutCheckFunction>
         ErrorCode run (TimeOutCheckFunction hasTimedOut) noexcept
@@ -645,6 +703,43 @@ struct Runner
             error = ErrorCode::unknownInstruction;
             uint16 opsPerformed = 0;
 
+           #if LITTLEFOOT_USE_COMPUTED_GOTO
+            #define LITTLEFOOT_OP_LABEL(name)  &&op_ ## name,
+
+            static const void* const opTable[] =
+            {
+                LITTLEFOOT_OPCODES (LITTLEFOOT_OP_LABEL, LITTLEFOOT_OP_LABEL, LITTLEFOOT_OP_LABEL, LITTLEFOOT_OP_LABEL)
+            };
+
+            #undef LITTLEFOOT_OP_LABEL
+
+            // this does the same checks as the loop below, before jumping to the next op's label
+            #define LITTLEFOOT_DISPATCH \
+                if (programCounter >= programEnd) return error; \
+                if ((++opsPerformed & 63) == 0 && hasTimedOut()) return ErrorCode::executionTimedOut; \
+                dumpDebugTrace(); \
+                if (*programCounter >= (uint8) OpCode::endOfOpcodes) goto unknownOp; \
+                goto *opTable[*programCounter++];
+
+            #define LITTLEFOOT_THREADED_OP(name)          op_ ## name: name();                             LITTLEFOOT_DISPATCH
+            #define LITTLEFOOT_THREADED_OP_INT8(name)     op_ ## name: name ((int8) *programCounter++);    LITTLEFOOT_DISPATCH
+            #define LITTLEFOOT_THREADED_OP_INT16(name)    op_ ## name: name (readProgram16());             LITTLEFOOT_DISPATCH
+            #define LITTLEFOOT_THREADED_OP_INT32(name)    op_ ## name: name (readProgram32());             LITTLEFOOT_DISPATCH
+
+            LITTLEFOOT_DISPATCH
+            LITTLEFOOT_OPCODES (LITTLEFOOT_THREADED_OP, LITTLEFOOT_THREADED_OP_INT8, LITTLEFOOT_THREADED_OP_INT16, LITTLEFOOT_THREADED_OP_INT32)
+
+            #undef LITTLEFOOT_THREADED_OP
+            #undef LITTLEFOOT_THREADED_OP_INT8
+            #undef LITTLEFOOT_THREADED_OP_INT16
+            #undef LITTLEFOOT_THREADED_OP_INT32
+            #undef LITTLEFOOT_DISPATCH
+
+          unknownOp:
+            ++programCounter;
+            setError (ErrorCode::unknownInstruction);
+            return error;
+           #else
             for (;;)
             {
                 if (programCounter >= programEnd)
@@ -670,6 +765,7 @@ struct Runner
 
                 jassert (programCounter != nullptr);
             }
+           #endif
         }
 
     private:
@@ -772,6 +868,16 @@ struct Runner
         void setHeapByte() noexcept                 { if (checkStackUnderflow()) runner->setHeapByte ((uint32) tos, (uint8)  *stack++); drop(); }
         void setHeapInt() noexcept                  { if (checkStackUnderflow()) runner->setHeapInt  ((uint32) tos, (uint32) *stack++); drop(); }
 
+        // These "super-instructions" each do the same job as a common pair of ops, and are
+        // only generated when the Compiler has been asked to use them.
+        void addImmediate8 (int8 value) noexcept    { tos = tos + value; }
+        void compareZE_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testZE_int32(); } }
+        void compareNZ_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testNZ_int32(); } }
+        void compareGT_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testGT_int32(); } }
+        void compareGE_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testGE_int32(); } }
+        void compareLT_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testLT_int32(); } }
+        void compareLE_int32() noexcept             { if (checkStackUnderflow()) { tos = *stack++ - tos; testLE_int32(); } }
+
         void callNative (FunctionID functionID) noexcept
         {
             auto numFunctions = runner->numNativeFunctions;
@@ -201,6 +201,46 @@ struct HostPacketBuilder
         return true;
     }
 
+    //==============================================================================
+    /** Returns the number of bits that skipBytes() will use for this many bytes. */
+    static int getSkipBytesNumBits (int numToSkip) noexcept
+    {
+        int numBits = 0;
+
+        for (; numToSkip > 0; numToSkip -= (int) ByteCountMany::maxValue)
+            numBits += (int) DataChangeCommand::bits
+                         + (numToSkip > (int) ByteCountFew::maxValue ? (int) ByteCountMany::bits : (int) ByteCountFew::bits);
+
+        return numBits;
+    }
+
+    /** Returns the number of bits that setMultipleBytes() will use for a sequence of this many bytes. */
+    static int getSetBytesNumBits (int num) noexcept
+    {
+        return (int) DataChangeCommand::bits + num * (int) (ByteValue::bits + ByteSequenceContinues::bits);
+    }
+
+    /** Returns the number of bits that setMultipleBytes() will use to set this many bytes to a single value. */
+    static int getSetBytesWithValueNumBits (int num, bool valueIsSameAsLastValue) noexcept
+    {
+        if (num == 1)
+            return getSetBytesNumBits (1);
+
+        int numBits = 0;
+
+        for (; num > 0; num -= (int) ByteCountMany::maxValue)
+        {
+            if (num > (int) ByteCountFew::maxValue)
+                numBits += (int) (DataChangeCommand::bits + ByteCountMany::bits + ByteValue::bits);
+            else
+                numBits += (int) (DataChangeCommand::bits + ByteCountFew::bits)
+                             + (valueIsSameAsLastValue ? 0 : (int) ByteValue::bits);
+        }
+
+        return numBits;
+    }
+
+    //==============================================================================
     bool addProgramEventMessage (const int32* messageData)
     {
         if (! data.hasCapacity (BitSizes::programEventMessage))
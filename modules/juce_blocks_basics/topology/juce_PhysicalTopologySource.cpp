@@ -322,6 +322,11 @@ struct PhysicalTopologySource::Internal
         return static_cast<Block::Timestamp> (timestamp);
     }
 
+    static void addEventsToQueue (RealtimeEventQueue& queue, const RealtimeEvent* events, int numEvents) noexcept
+    {
+        queue.addEvents (events, numEvents);
+    }
+
     static juce::Array<DeviceInfo> getArrayOfDeviceInfo (const juce::Array<BlocksProtocol::DeviceStatus>& devices)
     {
         juce::Array<DeviceInfo> result;
@@ -536,6 +541,7 @@ struct PhysicalTopologySource::Internal
             currentDeviceConnections = getArrayOfConnections (incomingTopologyConnections);
             currentTopologyDevices = incomingTopologyDevices;
             currentTopologyConnections = incomingTopologyConnections;
+            realtimeDecoder.setDevices (currentDeviceInfo);
             detector.handleTopologyChange();
 
             lastTopologyReceiveTime = juce::Time::getCurrentTime();
@@ -720,6 +726,133 @@ struct PhysicalTopologySource::Internal
 
         TouchList<TouchStart> touchStartPositions;
 
+        //==============================================================================
+        // This decodes just the touch and button messages for a RealtimeEventQueue, on
+        // the thread that receives the packets. It keeps its own copy of the device list,
+        // because the main one is only safe to use on the message thread.
+        struct RealtimeDecoder
+        {
+            void setDevices (const juce::Array<DeviceInfo>& devices)
+            {
+                const juce::SpinLock::ScopedLockType sl (deviceLock);
+
+                for (auto& d : deviceDetails)
+                    d = {};
+
+                for (auto& info : devices)
+                {
+                    BlocksProtocol::BlockDataSheet dataSheet (info.serial);
+                    deviceDetails[info.index & 63] = { info.uid, (float) dataSheet.widthUnits, (float) dataSheet.heightUnits };
+                }
+            }
+
+            void decodePacket (PhysicalTopologySource::RealtimeEventQueue& queue, const void* data, size_t dataSize)
+            {
+                numEvents = 0;
+                hostTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+                {
+                    const juce::SpinLock::ScopedLockType sl (deviceLock);
+                    auto d = static_cast<const uint8*> (data);
+
+                    BlocksProtocol::HostPacketDecoder<RealtimeDecoder>
+                        ::processNextPacket (*this, *d, d + 1, (int) dataSize - 1);
+                }
+
+                addEventsToQueue (queue, events, numEvents);
+            }
+
+            // The following methods will be called by the HostPacketDecoder:
+            void handleTouchChange (BlocksProtocol::TopologyIndex deviceIndex,
+                                    uint32 timestamp,
+                                    BlocksProtocol::TouchIndex touchIndex,
+                                    BlocksProtocol::TouchPosition position,
+                                    BlocksProtocol::TouchVelocity velocity,
+                                    bool isStart, bool isEnd)
+            {
+                auto& device = deviceDetails[deviceIndex & 63];
+
+                if (device.uid != Block::UID() && numEvents < maxEventsPerPacket)
+                {
+                    auto& e = events[numEvents++];
+                    e.type = PhysicalTopologySource::RealtimeEvent::Type::touch;
+                    e.blockUID = device.uid;
+                    e.hostTimeMs = hostTimeMs;
+
+                    auto& touch = e.touch;
+                    touch.index             = (int) touchIndex.get();
+                    touch.x                 = position.x.toUnipolarFloat() * device.width;
+                    touch.y                 = position.y.toUnipolarFloat() * device.height;
+                    touch.z                 = position.z.toUnipolarFloat();
+                    touch.xVelocity         = velocity.vx.toBipolarFloat();
+                    touch.yVelocity         = velocity.vy.toBipolarFloat();
+                    touch.zVelocity         = velocity.vz.toBipolarFloat();
+                    touch.eventTimestamp    = deviceTimestampToHost (timestamp);
+                    touch.isTouchStart      = isStart;
+                    touch.isTouchEnd        = isEnd;
+                    touch.blockUID          = device.uid;
+
+                    auto& startPos = touchStartPositions.getValue (touch);
+
+                    if (isStart)
+                        startPos = { touch.x, touch.y };
+
+                    touch.startX = startPos.x;
+                    touch.startY = startPos.y;
+                }
+            }
+
+            void handleControlButtonUpDown (BlocksProtocol::TopologyIndex deviceIndex, uint32 timestamp,
+                                            BlocksProtocol::ControlButtonID buttonID, bool isDown)
+            {
+                auto& device = deviceDetails[deviceIndex & 63];
+
+                if (device.uid != Block::UID() && numEvents < maxEventsPerPacket)
+                {
+                    auto& e = events[numEvents++];
+                    e.type = isDown ? PhysicalTopologySource::RealtimeEvent::Type::buttonDown
+                                    : PhysicalTopologySource::RealtimeEvent::Type::buttonUp;
+                    e.blockUID = device.uid;
+                    e.hostTimeMs = hostTimeMs;
+                    e.buttonIndex = (int) buttonID.get();
+                    e.buttonTimestamp = deviceTimestampToHost (timestamp);
+                }
+            }
+
+            void beginTopology (int, int) {}
+            void extendTopology (int, int) {}
+            void handleTopologyDevice (BlocksProtocol::DeviceStatus) {}
+            void handleTopologyConnection (BlocksProtocol::DeviceConnection) {}
+            void endTopology() {}
+            void handleVersion (BlocksProtocol::DeviceVersion) {}
+            void handleName (BlocksProtocol::DeviceName) {}
+            void handleCustomMessage (BlocksProtocol::TopologyIndex, uint32, const int32*) {}
+            void handlePacketACK (BlocksProtocol::TopologyIndex, BlocksProtocol::PacketCounter) {}
+            void handleFirmwareUpdateACK (BlocksProtocol::TopologyIndex, BlocksProtocol::FirmwareUpdateACKCode, BlocksProtocol::FirmwareUpdateACKDetail) {}
+            void handleConfigUpdateMessage (BlocksProtocol::TopologyIndex, int32, int32, int32, int32) {}
+            void handleConfigSetMessage (BlocksProtocol::TopologyIndex, int32, int32) {}
+            void handleConfigFactorySyncEndMessage (BlocksProtocol::TopologyIndex) {}
+            void handleLogMessage (BlocksProtocol::TopologyIndex, const String&) {}
+
+        private:
+            struct DeviceDetails
+            {
+                Block::UID uid;
+                float width, height;
+            };
+
+            static constexpr int maxEventsPerPacket = 64;
+
+            juce::SpinLock deviceLock;
+            DeviceDetails deviceDetails[64] = {};
+            TouchList<TouchStart> touchStartPositions;
+            PhysicalTopologySource::RealtimeEvent events[maxEventsPerPacket];
+            int numEvents = 0;
+            double hostTimeMs = 0;
+        };
+
+        RealtimeDecoder realtimeDecoder;
+
         juce::Time lastGlobalPingTime;
 
         struct BlockPingTime
@@ -788,6 +921,13 @@ struct PhysicalTopologySource::Internal
         //==============================================================================
         void handleIncomingMessage (const void* data, size_t dataSize)
         {
+            {
+                const juce::SpinLock::ScopedLockType sl (detector.realtimeEventQueueLock);
+
+                if (auto* queue = detector.realtimeEventQueue)
+                    realtimeDecoder.decodePacket (*queue, data, dataSize);
+            }
+
             juce::MemoryBlock mb (data, dataSize);
 
             {
@@ -1129,6 +1269,9 @@ struct PhysicalTopologySource::Internal
         juce::Array<ControlButtonImplementation*> activeControlButtons;
         juce::Array<TouchSurfaceImplementation*> activeTouchSurfaces;
 
+        juce::SpinLock realtimeEventQueueLock;
+        RealtimeEventQueue* realtimeEventQueue = nullptr;
+
         BlockTopology currentTopology;
 
     private:
@@ -1621,7 +1764,9 @@ struct PhysicalTopologySource::Internal
                 return;
             }
 
-            if (ledGrid != nullptr)
+            // A new frame is only rendered once the device has caught up with the last
+            // one, so if the connection is slow, frames get dropped rather than queued.
+            if (ledGrid != nullptr && ! remoteHeap.hasPendingMessages())
                 if (auto renderer = ledGrid->getRenderer())
                     renderer->renderLEDGrid (*ledGrid);
 
@@ -2336,9 +2481,49 @@ void PhysicalTopologySource::cancelAllActiveTouches() noexcept
     detector->detector->cancelAllActiveTouches();
 }
 
+void PhysicalTopologySource::setRealtimeEventQueue (RealtimeEventQueue* queueToUse)
+{
+    auto& d = *detector->detector;
+    const juce::SpinLock::ScopedLockType sl (d.realtimeEventQueueLock);
+    d.realtimeEventQueue = queueToUse;
+}
+
 bool PhysicalTopologySource::hasOwnServiceTimer() const     { return false; }
 void PhysicalTopologySource::handleTimerTick()              { detector->handleTimerTick(); }
 
+//==============================================================================
+PhysicalTopologySource::RealtimeEventQueue::RealtimeEventQueue (int capacity)
+    : fifo (capacity), events ((size_t) capacity)
+{
+}
+
+PhysicalTopologySource::RealtimeEventQueue::~RealtimeEventQueue() {}
+
+void PhysicalTopologySource::RealtimeEventQueue::addEvents (const RealtimeEvent* newEvents, int numEvents) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numEvents, start1, size1, start2, size2);
+
+    std::copy (newEvents, newEvents + size1, events + start1);
+    std::copy (newEvents + size1, newEvents + size1 + size2, events + start2);
+    fifo.finishedWrite (size1 + size2);
+
+    if (size1 + size2 < numEvents)
+        numDroppedEvents += numEvents - (size1 + size2);
+}
+
+int PhysicalTopologySource::RealtimeEventQueue::readEvents (RealtimeEvent* destination, int maxEvents) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (maxEvents, start1, size1, start2, size2);
+
+    std::copy (events + start1, events + start1 + size1, destination);
+    std::copy (events + start2, events + start2 + size2, destination + size1);
+    fifo.finishedRead (size1 + size2);
+
+    return size1 + size2;
+}
+
 PhysicalTopologySource::DeviceConnection::DeviceConnection() {}
 PhysicalTopologySource::DeviceConnection::~DeviceConnection() {}
 
@@ -70,6 +70,95 @@ public:
 
     static const char* const* getStandardLittleFootFunctions() noexcept;
 
+    //==========================================================================
+    /** A touch or button event that was read by a RealtimeEventQueue. */
+    struct RealtimeEvent
+    {
+        enum class Type
+        {
+            touch,
+            buttonDown,
+            buttonUp
+        };
+
+        Type type;
+
+        /** The ID of the block that sent this event. */
+        Block::UID blockUID;
+
+        /** The time at which the packet containing this event arrived, as returned by
+            Time::getMillisecondCounterHiRes(). All the events in a packet are given the
+            same time, so this can be compared with the time at which an audio block
+            started in order to work out a sample position for the event.
+        */
+        double hostTimeMs;
+
+        /** For touch events, this is the touch, exactly as it would be passed to a
+            TouchSurface::Listener.
+        */
+        TouchSurface::Touch touch;
+
+        /** For button events, this is the button's index in the block's getButtons() array. */
+        int buttonIndex;
+
+        /** For button events, this is the block's timestamp for the event. */
+        Block::Timestamp buttonTimestamp;
+    };
+
+    /**
+        A lock-free queue that's given touch and button events on the thread that
+        reads data from the devices, as soon as the events have been decoded.
+
+        Normally these events are passed on to listeners on the message thread, which
+        can add a lot of jitter when the message thread is busy. If you attach one of
+        these queues with setRealtimeEventQueue(), the events are also written to it,
+        a packet at a time, and your audio thread can read them with readEvents().
+
+        @see PhysicalTopologySource::setRealtimeEventQueue
+    */
+    class RealtimeEventQueue
+    {
+    public:
+        /** Creates a queue that can hold a given number of events. */
+        explicit RealtimeEventQueue (int capacity = 1024);
+
+        /** Destructor. */
+        ~RealtimeEventQueue();
+
+        /** Removes up to maxEvents of the oldest events from the queue, copying them
+            into the destination array, and returns the number that were copied.
+            This doesn't lock or allocate, so it can be called on the audio thread, but
+            only one thread should read from a queue.
+        */
+        int readEvents (RealtimeEvent* destination, int maxEvents) noexcept;
+
+        /** Returns the number of events that have been thrown away because the queue
+            was full when they arrived.
+        */
+        int getNumDroppedEvents() const noexcept        { return numDroppedEvents.load(); }
+
+    private:
+        friend class PhysicalTopologySource;
+
+        juce::AbstractFifo fifo;
+        juce::HeapBlock<RealtimeEvent> events;
+        std::atomic<int> numDroppedEvents { 0 };
+
+        void addEvents (const RealtimeEvent*, int numEvents) noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeEventQueue)
+    };
+
+    /** Attaches a queue which will be given touch and button events on the thread
+        that reads from the devices, as well as their being sent to the usual listeners.
+
+        Pass nullptr to detach it again. When this method returns, the previous queue
+        is no longer being used, so it's safe to delete it. Note that all the
+        PhysicalTopologySources that use the default device detector share a single
+        queue.
+    */
+    void setRealtimeEventQueue (RealtimeEventQueue* queueToUse);
+
 protected:
     virtual bool hasOwnServiceTimer() const;
     virtual void handleTimerTick();
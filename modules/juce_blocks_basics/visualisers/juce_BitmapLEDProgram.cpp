@@ -39,11 +39,13 @@ void BitmapLEDProgram::setLED (uint32 x, uint32 y, LEDColour colour)
 
         if (x < w && y < h)
         {
-            auto bit = (x + y * w) * 16;
+            auto value565 = (uint32) (colour.getRed() >> 3)
+                             | ((uint32) (colour.getGreen() >> 2) << 5)
+                             | ((uint32) (colour.getBlue()  >> 3) << 11);
 
-            block.setDataBits (bit,      5, colour.getRed()   >> 3);
-            block.setDataBits (bit + 5,  6, colour.getGreen() >> 2);
-            block.setDataBits (bit + 11, 5, colour.getBlue()  >> 3);
+            // each pixel is byte-aligned, so both bytes can be written in one go
+            const uint8 bytes[] = { (uint8) value565, (uint8) (value565 >> 8) };
+            block.setDataBytes ((x + y * w) * 2, bytes, sizeof (bytes));
         }
     }
     else
@@ -91,6 +91,7 @@
 #include "box2d/Dynamics/Joints/b2WheelJoint.cpp"
 #include "box2d/Rope/b2Rope.cpp"
 
+#include "utils/juce_Box2DWorldStepper.cpp"
 #include "utils/juce_Box2DRenderer.cpp"
 
 #if defined (__clang__)
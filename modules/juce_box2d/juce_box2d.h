@@ -66,5 +66,6 @@
 #endif
 
 #ifndef DOXYGEN // for some reason, Doxygen sees this as a re-definition of Box2DRenderer
+ #include "utils/juce_Box2DWorldStepper.h"
  #include "utils/juce_Box2DRenderer.h"
 #endif // DOXYGEN
@@ -46,6 +46,69 @@ void Box2DRenderer::render (Graphics& g, b2World& world,
     world.DrawDebugData();
 }
 
+static void addPolygons (Path& p, const Array<b2Vec2>& vertices, const Array<int>& sizes)
+{
+    auto* v = vertices.begin();
+
+    for (auto size : sizes)
+    {
+        p.startNewSubPath (v[0].x, v[0].y);
+
+        for (int i = 1; i < size; ++i)
+            p.lineTo (v[i].x, v[i].y);
+
+        p.closeSubPath();
+        v += size;
+    }
+}
+
+static void addCircles (Path& p, const Array<Box2DWorldSnapshot::Circle>& circles)
+{
+    for (auto& c : circles)
+        p.addEllipse (c.centre.x - c.radius, c.centre.y - c.radius, c.radius * 2.0f, c.radius * 2.0f);
+}
+
+void Box2DRenderer::render (Graphics& g, const Box2DWorldSnapshot& snapshot,
+                            float left, float top, float right, float bottom,
+                            const Rectangle<float>& target)
+{
+    graphics = &g;
+
+    g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
+                                                       right, top,    target.getRight(), target.getY(),
+                                                       left,  bottom, target.getX(),     target.getBottom()));
+
+    for (auto* batch : snapshot.batches)
+    {
+        if (batch->isEmpty())
+            continue;
+
+        g.setColour (getColour (batch->colour));
+
+        fillPath.clear();
+        addPolygons (fillPath, batch->solidPolygonVertices, batch->solidPolygonSizes);
+        addCircles (fillPath, batch->solidCircles);
+
+        if (! fillPath.isEmpty())
+            g.fillPath (fillPath);
+
+        strokePath.clear();
+        addPolygons (strokePath, batch->polygonOutlineVertices, batch->polygonOutlineSizes);
+        addCircles (strokePath, batch->circleOutlines);
+
+        for (int i = 0; i + 1 < batch->segments.size(); i += 2)
+        {
+            auto& p1 = batch->segments.getReference (i);
+            auto& p2 = batch->segments.getReference (i + 1);
+            strokePath.startNewSubPath (p1.x, p1.y);
+            strokePath.lineTo (p2.x, p2.y);
+        }
+
+        if (! strokePath.isEmpty())
+            g.strokePath (strokePath, PathStrokeType (getLineThickness()));
+    }
+}
+
 Colour Box2DRenderer::getColour (const b2Color& c) const
 {
     return Colour::fromFloatRGBA (c.r, c.g, c.b, 1.0f);
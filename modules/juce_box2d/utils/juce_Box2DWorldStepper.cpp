@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+Box2DWorldSnapshot::Box2DWorldSnapshot()
+{
+    SetFlags (e_shapeBit);
+}
+
+void Box2DWorldSnapshot::capture (b2World& world)
+{
+    clear();
+    world.SetDebugDraw (this);
+    world.DrawDebugData();
+}
+
+void Box2DWorldSnapshot::clear() noexcept
+{
+    for (auto* b : batches)
+    {
+        b->solidCircles.clearQuick();
+        b->circleOutlines.clearQuick();
+        b->solidPolygonVertices.clearQuick();
+        b->polygonOutlineVertices.clearQuick();
+        b->solidPolygonSizes.clearQuick();
+        b->polygonOutlineSizes.clearQuick();
+        b->segments.clearQuick();
+    }
+}
+
+bool Box2DWorldSnapshot::Batch::isEmpty() const noexcept
+{
+    return solidCircles.isEmpty() && circleOutlines.isEmpty()
+            && solidPolygonSizes.isEmpty() && polygonOutlineSizes.isEmpty()
+            && segments.isEmpty();
+}
+
+Box2DWorldSnapshot::Batch& Box2DWorldSnapshot::getBatch (const b2Color& colour)
+{
+    // There are only a handful of different colours, and the world draws bodies
+    // of the same kind one after another, so the last one used is checked first.
+    for (int i = batches.size(); --i >= 0;)
+    {
+        auto& b = *batches.getUnchecked (i);
+
+        if (b.colour.r == colour.r && b.colour.g == colour.g && b.colour.b == colour.b)
+            return b;
+    }
+
+    auto* b = batches.add (new Batch());
+    b->colour = colour;
+    return *b;
+}
+
+void Box2DWorldSnapshot::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& colour)
+{
+    auto& b = getBatch (colour);
+    b.polygonOutlineVertices.addArray (vertices, vertexCount);
+    b.polygonOutlineSizes.add (vertexCount);
+}
+
+void Box2DWorldSnapshot::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& colour)
+{
+    auto& b = getBatch (colour);
+    b.solidPolygonVertices.addArray (vertices, vertexCount);
+    b.solidPolygonSizes.add (vertexCount);
+}
+
+void Box2DWorldSnapshot::DrawCircle (const b2Vec2& center, float32 radius, const b2Color& colour)
+{
+    getBatch (colour).circleOutlines.add ({ center, radius });
+}
+
+void Box2DWorldSnapshot::DrawSolidCircle (const b2Vec2& center, float32 radius, const b2Vec2&, const b2Color& colour)
+{
+    getBatch (colour).solidCircles.add ({ center, radius });
+}
+
+void Box2DWorldSnapshot::DrawSegment (const b2Vec2& p1, const b2Vec2& p2, const b2Color& colour)
+{
+    auto& b = getBatch (colour);
+    b.segments.add (p1);
+    b.segments.add (p2);
+}
+
+void Box2DWorldSnapshot::DrawTransform (const b2Transform&)
+{
+}
+
+//==============================================================================
+Box2DWorldStepper::Box2DWorldStepper (b2World& worldToStep, double stepRate,
+                                      int numVelocityIterations, int numPositionIterations)
+    : Thread ("Box2D stepper"),
+      world (worldToStep),
+      stepsPerSecond (stepRate),
+      velocityIterations (numVelocityIterations),
+      positionIterations (numPositionIterations)
+{
+    jassert (stepsPerSecond > 0);
+}
+
+Box2DWorldStepper::~Box2DWorldStepper()
+{
+    stop();
+}
+
+void Box2DWorldStepper::start()
+{
+    startThread();
+}
+
+void Box2DWorldStepper::stop()
+{
+    stopThread (-1);
+}
+
+const Box2DWorldSnapshot& Box2DWorldStepper::getLatestSnapshot() noexcept
+{
+    const SpinLock::ScopedLockType sl (swapLock);
+
+    if (readyIsNew)
+    {
+        std::swap (reading, ready);
+        readyIsNew = false;
+    }
+
+    return *reading;
+}
+
+void Box2DWorldStepper::publishSnapshot() noexcept
+{
+    const SpinLock::ScopedLockType sl (swapLock);
+    std::swap (writing, ready);
+    readyIsNew = true;
+}
+
+void Box2DWorldStepper::run()
+{
+    auto stepLengthMs = 1000.0 / stepsPerSecond;
+    auto nextStepTime = Time::getMillisecondCounterHiRes();
+
+    {
+        const ScopedLock sl (lock);
+        writing->capture (world);
+    }
+
+    publishSnapshot();
+
+    while (! threadShouldExit())
+    {
+        auto now = Time::getMillisecondCounterHiRes();
+
+        if (now < nextStepTime)
+        {
+            wait (jmax (1, roundToInt (nextStepTime - now)));
+            continue;
+        }
+
+        // if the steps are taking longer than real-time, don't try to catch up
+        nextStepTime = jmax (nextStepTime + stepLengthMs, now - stepLengthMs);
+
+        {
+            const ScopedLock sl (lock);
+            world.Step ((float32) (1.0 / stepsPerSecond), velocityIterations, positionIterations);
+            writing->capture (world);
+        }
+
+        ++numSteps;
+        publishSnapshot();
+    }
+}
+
+} // namespace juce
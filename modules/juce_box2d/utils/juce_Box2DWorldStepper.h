@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/** A copy of the shapes in a Box2D world, which can be drawn by a Box2DRenderer
+    without needing to touch the world itself.
+
+    The shapes are grouped by the colour that Box2D's debug drawing gives them,
+    so that a renderer can draw all the shapes of each colour in a single pass,
+    rather than making a separate call for every body.
+
+    A snapshot keeps its storage when it's cleared or re-captured, so capturing a
+    world of the same size over and over again doesn't allocate any memory.
+
+    @see Box2DWorldStepper, Box2DRenderer
+*/
+class Box2DWorldSnapshot   : public b2Draw
+{
+public:
+    Box2DWorldSnapshot();
+
+    /** Replaces the contents of this snapshot with the current shapes in a world.
+        This uses the world's debug-drawing mechanism, so it will replace any b2Draw
+        object that was set with b2World::SetDebugDraw().
+    */
+    void capture (b2World& world);
+
+    /** Removes all the shapes, but keeps the memory that they were using. */
+    void clear() noexcept;
+
+    //==============================================================================
+    struct Circle
+    {
+        b2Vec2 centre;
+        float32 radius;
+    };
+
+    /** All the shapes of one colour. */
+    struct Batch
+    {
+        b2Color colour;
+
+        Array<Circle> solidCircles, circleOutlines;
+
+        Array<b2Vec2> solidPolygonVertices, polygonOutlineVertices;
+        Array<int> solidPolygonSizes, polygonOutlineSizes;
+
+        /** The start and end points of each line segment. */
+        Array<b2Vec2> segments;
+
+        bool isEmpty() const noexcept;
+    };
+
+    /** The batches of shapes, one for each colour that was used. */
+    OwnedArray<Batch> batches;
+
+    //==============================================================================
+    /** @internal */
+    void DrawPolygon (const b2Vec2*, int32, const b2Color&) override;
+    /** @internal */
+    void DrawSolidPolygon (const b2Vec2*, int32, const b2Color&) override;
+    /** @internal */
+    void DrawCircle (const b2Vec2& center, float32 radius, const b2Color&) override;
+    /** @internal */
+    void DrawSolidCircle (const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color&) override;
+    /** @internal */
+    void DrawSegment (const b2Vec2& p1, const b2Vec2& p2, const b2Color&) override;
+    /** @internal */
+    void DrawTransform (const b2Transform&) override;
+
+private:
+    Batch& getBatch (const b2Color&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DWorldSnapshot)
+};
+
+//==============================================================================
+/**
+    Steps a Box2D world on a background thread, so that the physics doesn't hold up
+    the message thread.
+
+    After each step, the thread captures a Box2DWorldSnapshot of the world. The
+    snapshots are triple-buffered, so your paint() method can draw the latest one
+    with a Box2DRenderer while the next step is being calculated, and neither thread
+    ever has to wait for the other.
+
+    E.g.
+    @code
+    MyComponent() : stepper (world)
+    {
+        createBodies (world);
+        stepper.start();
+        startTimerHz (60);
+    }
+
+    void timerCallback() override     { repaint(); }
+
+    void paint (Graphics& g) override
+    {
+        Box2DRenderer renderer;
+        renderer.render (g, stepper.getLatestSnapshot(), -40.0f, -40.0f, 40.0f, 40.0f, getLocalBounds().toFloat());
+    }
+    @endcode
+
+    While the stepper is running, the world must only be changed while holding the
+    lock returned by getLock().
+*/
+class Box2DWorldStepper   : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates a stepper for a world. The world must outlive the stepper.
+        It won't start stepping until you call start().
+    */
+    Box2DWorldStepper (b2World& worldToStep,
+                       double stepsPerSecond = 60.0,
+                       int velocityIterations = 8,
+                       int positionIterations = 3);
+
+    /** Destructor. This will stop the thread if it's running. */
+    ~Box2DWorldStepper();
+
+    //==============================================================================
+    /** Starts stepping the world. */
+    void start();
+
+    /** Stops stepping the world, waiting for the current step to finish. */
+    void stop();
+
+    /** Returns the lock that's held while the world is being stepped and captured.
+        You need to hold this whenever you change or read the world while the stepper
+        is running.
+    */
+    const CriticalSection& getLock() const noexcept         { return lock; }
+
+    /** Returns the number of steps that have been done so far. */
+    int64 getNumSteps() const noexcept                      { return numSteps.load(); }
+
+    //==============================================================================
+    /** Returns the most recent snapshot of the world.
+
+        The snapshot that's returned won't be changed until the next time this is called,
+        so this should only be called by one thread, (normally the one that's painting).
+    */
+    const Box2DWorldSnapshot& getLatestSnapshot() noexcept;
+
+private:
+    //==============================================================================
+    b2World& world;
+    const double stepsPerSecond;
+    const int velocityIterations, positionIterations;
+
+    CriticalSection lock;
+    std::atomic<int64> numSteps { 0 };
+
+    Box2DWorldSnapshot snapshots[3];
+    Box2DWorldSnapshot* writing = snapshots;
+    Box2DWorldSnapshot* ready = snapshots + 1;
+    Box2DWorldSnapshot* reading = snapshots + 2;
+    bool readyIsNew = false;
+    SpinLock swapLock;
+
+    void run() override;
+    void publishSnapshot() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DWorldStepper)
+};
+
+} // namespace juce
@@ -126,6 +126,9 @@ void AbstractFifo::finishedRead (int numRead) noexcept
     validStart = newStart;
 }
 
+AbstractFifo::ScopedRead  AbstractFifo::read (int numToRead) noexcept     { return { *this, numToRead }; }
+AbstractFifo::ScopedWrite AbstractFifo::write (int numToWrite) noexcept   { return { *this, numToWrite }; }
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -224,6 +227,35 @@ public:
 
             fifo.finishedRead (size1 + size2);
         }
+
+        beginTest ("Scoped reads and writes");
+        {
+            int values [100];
+            AbstractFifo scopedFifo (numElementsInArray (values));
+
+            for (int block = 0; block < 10; ++block)
+            {
+                int written = 0, read = 0;
+                bool allCorrect = true;
+
+                {
+                    const auto scopedWriter = scopedFifo.write (70);
+                    expectEquals (scopedWriter.blockSize1 + scopedWriter.blockSize2, 70);
+                    scopedWriter.forEach ([&] (int index) { values[index] = written++; });
+                }
+
+                expectEquals (scopedFifo.getNumReady(), 70);
+
+                {
+                    const auto scopedReader = scopedFifo.read (100);
+                    expectEquals (scopedReader.blockSize1 + scopedReader.blockSize2, 70);
+                    scopedReader.forEach ([&] (int index) { allCorrect = (values[index] == read++) && allCorrect; });
+                }
+
+                expect (allCorrect);
+                expectEquals (scopedFifo.getNumReady(), 0);
+            }
+        }
     }
 };
 
@@ -200,6 +200,121 @@ public:
     */
     void finishedRead (int numRead) noexcept;
 
+    //==============================================================================
+private:
+    enum class ReadOrWrite
+    {
+        read,
+        write
+    };
+
+public:
+    /** Class for a scoped reader/writer.
+
+        Rather than calling prepareToRead()/finishedRead() or prepareToWrite()/finishedWrite()
+        by hand, you can create one of these with read() or write(), which will call the
+        finished method for you when it goes out of scope, with the size of both regions.
+
+        e.g.
+        @code
+        void addToFifo (const int* someData, int numItems)
+        {
+            const auto scope = abstractFifo.write (numItems);
+
+            if (scope.blockSize1 > 0)
+                copySomeData (myBuffer + scope.startIndex1, someData, scope.blockSize1);
+
+            if (scope.blockSize2 > 0)
+                copySomeData (myBuffer + scope.startIndex2, someData + scope.blockSize1, scope.blockSize2);
+        }
+        @endcode
+
+        @see AbstractFifo::read, AbstractFifo::write
+    */
+    template <ReadOrWrite mode>
+    class ScopedReadWrite  final
+    {
+    public:
+        /** Construct an unassigned reader/writer. Doesn't do anything upon destruction. */
+        ScopedReadWrite() = default;
+
+        /** Construct a reader/writer and immediately call prepareRead/prepareWrite
+            on the abstractFifo which was passed in.
+            This object will hold a pointer back to the fifo, so make sure that
+            the fifo outlives this object.
+        */
+        ScopedReadWrite (AbstractFifo& f, int num) noexcept  : fifo (&f)
+        {
+            prepare (*fifo, num);
+        }
+
+        ScopedReadWrite (const ScopedReadWrite&) = delete;
+        ScopedReadWrite& operator= (const ScopedReadWrite&) = delete;
+
+        /** Moves the region and the responsibility of finishing it from another reader/writer. */
+        ScopedReadWrite (ScopedReadWrite&& other) noexcept
+        {
+            swap (other);
+        }
+
+        /** Moves the region and the responsibility of finishing it from another reader/writer. */
+        ScopedReadWrite& operator= (ScopedReadWrite&& other) noexcept
+        {
+            swap (other);
+            return *this;
+        }
+
+        /** Calls finishedRead or finishedWrite if this is an assigned reader/writer. */
+        ~ScopedReadWrite() noexcept
+        {
+            if (fifo != nullptr)
+                finish (*fifo, blockSize1 + blockSize2);
+        }
+
+        /** Calls the passed function with each index that was deemed valid
+            for the current read/write operation.
+        */
+        template <typename FunctionToApply>
+        void forEach (FunctionToApply&& func) const
+        {
+            for (auto i = startIndex1, e = startIndex1 + blockSize1; i != e; ++i)  func (i);
+            for (auto i = startIndex2, e = startIndex2 + blockSize2; i != e; ++i)  func (i);
+        }
+
+        int startIndex1 = 0, blockSize1 = 0, startIndex2 = 0, blockSize2 = 0;
+
+    private:
+        void prepare (AbstractFifo&, int) noexcept;
+        static void finish (AbstractFifo&, int) noexcept;
+
+        void swap (ScopedReadWrite& other) noexcept
+        {
+            std::swap (other.fifo, fifo);
+            std::swap (other.startIndex1, startIndex1);
+            std::swap (other.blockSize1, blockSize1);
+            std::swap (other.startIndex2, startIndex2);
+            std::swap (other.blockSize2, blockSize2);
+        }
+
+        AbstractFifo* fifo = nullptr;
+    };
+
+    typedef ScopedReadWrite<ReadOrWrite::read>   ScopedRead;
+    typedef ScopedReadWrite<ReadOrWrite::write>  ScopedWrite;
+
+    /** Replaces prepareToRead/finishedRead with a single function.
+        This function returns an object which contains the start indices and
+        block sizes, and also automatically finishes the read operation when
+        it goes out of scope.
+    */
+    ScopedRead read (int numToRead) noexcept;
+
+    /** Replaces prepareToWrite/finishedWrite with a single function.
+        This function returns an object which contains the start indices and
+        block sizes, and also automatically finishes the write operation when
+        it goes out of scope.
+    */
+    ScopedWrite write (int numToWrite) noexcept;
 
 private:
     //==============================================================================
@@ -209,4 +324,28 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AbstractFifo)
 };
 
+template <>
+inline void AbstractFifo::ScopedReadWrite<AbstractFifo::ReadOrWrite::read>::finish (AbstractFifo& f, int num) noexcept
+{
+    f.finishedRead (num);
+}
+
+template <>
+inline void AbstractFifo::ScopedReadWrite<AbstractFifo::ReadOrWrite::write>::finish (AbstractFifo& f, int num) noexcept
+{
+    f.finishedWrite (num);
+}
+
+template <>
+inline void AbstractFifo::ScopedReadWrite<AbstractFifo::ReadOrWrite::read>::prepare (AbstractFifo& f, int num) noexcept
+{
+    f.prepareToRead (num, startIndex1, blockSize1, startIndex2, blockSize2);
+}
+
+template <>
+inline void AbstractFifo::ScopedReadWrite<AbstractFifo::ReadOrWrite::write>::prepare (AbstractFifo& f, int num) noexcept
+{
+    f.prepareToWrite (num, startIndex1, blockSize1, startIndex2, blockSize2);
+}
+
 } // namespace juce
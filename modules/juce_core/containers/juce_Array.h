@@ -45,11 +45,15 @@ namespace juce
     To make all the array's methods thread-safe, pass in "CriticalSection" as the templated
     TypeOfCriticalSectionToUse parameter, instead of the default DummyCriticalSection.
 
-    @see OwnedArray, ReferenceCountedArray, StringArray, CriticalSection
+    The AllocatorType parameter decides where the elements are stored: by default they
+    go in a HeapBlock, but you can use MemoryArena::Allocator to keep them in a MemoryArena.
+
+    @see OwnedArray, ReferenceCountedArray, StringArray, CriticalSection, MemoryArena
 */
 template <typename ElementType,
           typename TypeOfCriticalSectionToUse = DummyCriticalSection,
-          int minimumAllocatedSize = 0>
+          int minimumAllocatedSize = 0,
+          class AllocatorType = HeapAllocator>
 class Array
 {
 private:
@@ -62,10 +66,20 @@ public:
     {
     }
 
+    /** Creates an empty array which will use the given allocator for its storage.
+        @see MemoryArena::Allocator
+    */
+    explicit Array (const AllocatorType& allocator) noexcept
+        : data (allocator)
+    {
+    }
+
     /** Creates a copy of another array.
+        The copy will use the same allocator as the original.
         @param other    the array to copy
     */
-    Array (const Array<ElementType, TypeOfCriticalSectionToUse>& other)
+    Array (const Array& other)
+        : data (other.data.getAllocator())
     {
         const ScopedLockType lock (other.getLock());
         numUsed = other.numUsed;
@@ -75,8 +89,8 @@ public:
             new (data.elements + i) ElementType (other.data.elements[i]);
     }
 
-    Array (Array<ElementType, TypeOfCriticalSectionToUse>&& other) noexcept
-        : data (static_cast<ArrayAllocationBase<ElementType, TypeOfCriticalSectionToUse>&&> (other.data)),
+    Array (Array&& other) noexcept
+        : data (static_cast<ArrayAllocationBase<ElementType, TypeOfCriticalSectionToUse, AllocatorType>&&> (other.data)),
           numUsed (other.numUsed)
     {
         other.numUsed = 0;
@@ -165,7 +179,7 @@ public:
     {
         const ScopedLockType lock (getLock());
         deleteAllElements();
-        data = static_cast<ArrayAllocationBase<ElementType, TypeOfCriticalSectionToUse>&&> (other.data);
+        data = static_cast<ArrayAllocationBase<ElementType, TypeOfCriticalSectionToUse, AllocatorType>&&> (other.data);
         numUsed = other.numUsed;
         other.numUsed = 0;
         return *this;
@@ -1246,7 +1260,7 @@ public:
 
 private:
     //==============================================================================
-    ArrayAllocationBase <ElementType, TypeOfCriticalSectionToUse> data;
+    ArrayAllocationBase <ElementType, TypeOfCriticalSectionToUse, AllocatorType> data;
     int numUsed = 0;
 
     void removeInternal (const int indexToRemove)
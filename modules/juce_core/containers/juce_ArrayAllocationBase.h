@@ -23,6 +23,39 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    The default allocator for ArrayAllocationBase and Array, which keeps the
+    elements in a HeapBlock.
+
+    An allocator class just has to provide a BlockType template which behaves like a
+    HeapBlock, and which can be constructed from the allocator and give it back again.
+
+    @see MemoryArena::Allocator
+*/
+struct HeapAllocator
+{
+    template <typename ElementType>
+    struct BlockType  : public HeapBlock<ElementType>
+    {
+        BlockType() noexcept {}
+        explicit BlockType (const HeapAllocator&) noexcept {}
+
+        BlockType (BlockType&& other) noexcept
+            : HeapBlock<ElementType> (static_cast<HeapBlock<ElementType>&&> (other))
+        {
+        }
+
+        BlockType& operator= (BlockType&& other) noexcept
+        {
+            HeapBlock<ElementType>::operator= (static_cast<HeapBlock<ElementType>&&> (other));
+            return *this;
+        }
+
+        HeapAllocator getAllocator() const noexcept     { return {}; }
+    };
+};
+
 //==============================================================================
 /**
     Implements some basic array storage allocation functions.
@@ -33,32 +66,40 @@ namespace juce
     It inherits from a critical section class to allow the arrays to use
     the "empty base class optimisation" pattern to reduce their footprint.
 
-    @see Array, OwnedArray, ReferenceCountedArray
+    @see Array, OwnedArray, ReferenceCountedArray, HeapAllocator
 */
-template <class ElementType, class TypeOfCriticalSectionToUse>
+template <class ElementType, class TypeOfCriticalSectionToUse, class AllocatorType = HeapAllocator>
 class ArrayAllocationBase  : public TypeOfCriticalSectionToUse
 {
 public:
+    typedef typename AllocatorType::template BlockType<ElementType> BlockType;
+
     //==============================================================================
     /** Creates an empty array. */
     ArrayAllocationBase() noexcept
     {
     }
 
+    /** Creates an empty array which will use the given allocator. */
+    explicit ArrayAllocationBase (const AllocatorType& allocator) noexcept
+        : elements (allocator)
+    {
+    }
+
     /** Destructor. */
     ~ArrayAllocationBase() noexcept
     {
     }
 
     ArrayAllocationBase (ArrayAllocationBase&& other) noexcept
-        : elements (static_cast<HeapBlock<ElementType>&&> (other.elements)),
+        : elements (static_cast<BlockType&&> (other.elements)),
           numAllocated (other.numAllocated)
     {
     }
 
     ArrayAllocationBase& operator= (ArrayAllocationBase&& other) noexcept
     {
-        elements = static_cast<HeapBlock<ElementType>&&> (other.elements);
+        elements = static_cast<BlockType&&> (other.elements);
         numAllocated = other.numAllocated;
         return *this;
     }
@@ -109,6 +150,12 @@ public:
             setAllocatedSize (maxNumElements);
     }
 
+    /** Returns the allocator that this array is using. */
+    AllocatorType getAllocator() const noexcept
+    {
+        return elements.getAllocator();
+    }
+
     /** Swap the contents of two objects. */
     void swapWith (ArrayAllocationBase& other) noexcept
     {
@@ -117,7 +164,7 @@ public:
     }
 
     //==============================================================================
-    HeapBlock<ElementType> elements;
+    BlockType elements;
     int numAllocated = 0;
 
 private:
@@ -0,0 +1,519 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/** @internal
+    This picks the type that a FlatHashMap's lookup methods take. For String keys
+    with the default hash functions it's a StringRef, so that looking something up
+    doesn't mean creating a temporary String.
+*/
+template <typename KeyType, class HashFunctionType>
+struct FlatHashMapLookupKeyType          { typedef typename TypeHelpers::ParameterType<KeyType>::type type; };
+
+template <>
+struct FlatHashMapLookupKeyType<String, DefaultHashFunctions>  { typedef StringRef type; };
+
+//==============================================================================
+/**
+    Holds a set of mappings between some key/value pairs, keeping them all in one
+    contiguous block of memory.
+
+    This does the same job as HashMap, but instead of allocating a separate object
+    for each item and chaining them together, it stores the items directly in the
+    table, using open addressing with "Robin Hood" probing. This means that adding an
+    item usually doesn't allocate anything, and a lookup normally only has to look at
+    one or two neighbouring slots, so it's much kinder to the CPU cache. Use reserve()
+    if you know how many items you're going to add, to avoid the table being resized
+    as it grows.
+
+    The hash function class has the same form as the one used by HashMap, but it will
+    always be given an upperLimit of 0x7fffffff, and its result is then scrambled and
+    reduced to the table size internally.
+
+    If the keys are Strings and you're using the default hash functions, all the lookup
+    methods will take a StringRef, so you can look things up with a string literal or an
+    Identifier without a temporary String being created.
+
+    Because items are moved around when others are added or removed, any pointer or
+    reference to a value in the map is only valid until the map is next modified.
+
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+    map.set ("two", 2);
+
+    DBG (map["two"]); // prints "2"
+
+    for (auto& item : map)
+        DBG (item.key << " -> " << item.value);
+    @endcode
+
+    @see HashMap, FlatHashSet, DefaultHashFunctions
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultHashFunctions>
+class FlatHashMap
+{
+private:
+    typedef typename TypeHelpers::ParameterType<KeyType>::type   KeyTypeParameter;
+    typedef typename TypeHelpers::ParameterType<ValueType>::type ValueTypeParameter;
+    typedef typename FlatHashMapLookupKeyType<KeyType, HashFunctionType>::type LookupKeyType;
+
+public:
+    //==============================================================================
+    /** One of the key/value pairs in the map.
+        When iterating a map, you can change the value, but mustn't change the key!
+    */
+    struct Item
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+    //==============================================================================
+    /** Creates an empty map.
+
+        @param hashFunction An instance of HashFunctionType, which will be copied and
+                            stored to use with the map. This parameter can be omitted
+                            if HashFunctionType has a default constructor.
+    */
+    explicit FlatHashMap (HashFunctionType hashFunction = HashFunctionType())
+        : hashFunctionToUse (hashFunction)
+    {
+    }
+
+    /** Move constructor. */
+    FlatHashMap (FlatHashMap&& other) noexcept
+        : hashFunctionToUse (other.hashFunctionToUse)
+    {
+        swapWith (other);
+    }
+
+    /** Move assignment operator. */
+    FlatHashMap& operator= (FlatHashMap&& other) noexcept
+    {
+        swapWith (other);
+        return *this;
+    }
+
+    /** Destructor. */
+    ~FlatHashMap()
+    {
+        clear();
+    }
+
+    //==============================================================================
+    /** Removes all values from the map.
+        This won't release the memory that the table is using - if you need to do
+        that, swap it with an empty map.
+    */
+    void clear() noexcept
+    {
+        for (int i = 0; i < numSlots; ++i)
+        {
+            if (probeLengths[i] != 0)
+            {
+                items[i].~Item();
+                probeLengths[i] = 0;
+            }
+        }
+
+        numItems = 0;
+    }
+
+    /** Returns the current number of items in the map. */
+    inline int size() const noexcept                    { return numItems; }
+
+    /** Returns true if the map is empty. */
+    inline bool isEmpty() const noexcept                { return numItems == 0; }
+
+    /** Makes sure that the table is big enough to hold this many items without
+        needing to be resized.
+    */
+    void reserve (int numItemsNeeded)
+    {
+        auto slotsNeeded = getNumSlotsNeededFor (numItemsNeeded);
+
+        if (slotsNeeded > numSlots)
+            resizeTable (slotsNeeded);
+    }
+
+    //==============================================================================
+    /** Returns a pointer to the value that is associated with the given key, or
+        nullptr if the key isn't in the map.
+    */
+    ValueType* find (LookupKeyType keyToLookFor) noexcept
+    {
+        auto index = findIndex (keyToLookFor);
+        return index >= 0 ? &(items[index].value) : nullptr;
+    }
+
+    /** Returns a pointer to the value that is associated with the given key, or
+        nullptr if the key isn't in the map.
+    */
+    const ValueType* find (LookupKeyType keyToLookFor) const noexcept
+    {
+        auto index = findIndex (keyToLookFor);
+        return index >= 0 ? &(items[index].value) : nullptr;
+    }
+
+    /** Returns the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is returned.
+    */
+    ValueType operator[] (LookupKeyType keyToLookFor) const
+    {
+        if (auto* value = find (keyToLookFor))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns true if the map contains an item with the specified key. */
+    bool contains (LookupKeyType keyToLookFor) const noexcept
+    {
+        return findIndex (keyToLookFor) >= 0;
+    }
+
+    /** Returns a reference to the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is
+        added to the map and a reference to this is returned.
+    */
+    ValueType& getReference (KeyTypeParameter key)
+    {
+        auto index = findIndex (key);
+
+        if (index < 0)
+        {
+            if (getNumSlotsNeededFor (numItems + 1) > numSlots)
+                resizeTable (jmax (16, numSlots * 2));
+
+            index = insert ({ key, ValueType() });
+        }
+
+        return items[index].value;
+    }
+
+    /** Adds or replaces an element in the map.
+        If there's already an item with the given key, this will replace its value.
+    */
+    void set (KeyTypeParameter newKey, ValueTypeParameter newValue)      { getReference (newKey) = newValue; }
+
+    /** Removes an item with the given key, returning true if there was one. */
+    bool remove (LookupKeyType keyToRemove)
+    {
+        auto index = findIndex (keyToRemove);
+
+        if (index < 0)
+            return false;
+
+        // Move the following items back, until one that's already in its best slot
+        for (;;)
+        {
+            items[index].~Item();
+            probeLengths[index] = 0;
+
+            auto next = (index + 1) & (numSlots - 1);
+
+            if (probeLengths[next] <= 1)
+                break;
+
+            new (items + index) Item (static_cast<Item&&> (items[next]));
+            probeLengths[index] = (uint8) (probeLengths[next] - 1);
+            index = next;
+        }
+
+        --numItems;
+        return true;
+    }
+
+    /** Efficiently swaps the contents of two maps. */
+    void swapWith (FlatHashMap& otherMap) noexcept
+    {
+        items.swapWith (otherMap.items);
+        probeLengths.swapWith (otherMap.probeLengths);
+        std::swap (numSlots, otherMap.numSlots);
+        std::swap (numItems, otherMap.numItems);
+        std::swap (slotShift, otherMap.slotShift);
+    }
+
+    //==============================================================================
+    /** Iterates over the items in a map, in no particular order. */
+    template <typename MapType, typename ItemType>
+    struct IteratorBase
+    {
+        IteratorBase (MapType& mapToIterate, int startIndex) noexcept
+            : map (mapToIterate), index (startIndex)
+        {
+            skipEmptySlots();
+        }
+
+        ItemType& operator*() const noexcept                        { return map.items[index]; }
+        ItemType* operator->() const noexcept                       { return map.items + index; }
+        IteratorBase& operator++() noexcept                         { ++index; skipEmptySlots(); return *this; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return index != other.index; }
+
+    private:
+        MapType& map;
+        int index;
+
+        void skipEmptySlots() noexcept
+        {
+            while (index < map.numSlots && map.probeLengths[index] == 0)
+                ++index;
+        }
+    };
+
+    typedef IteratorBase<FlatHashMap, Item> Iterator;
+    typedef IteratorBase<const FlatHashMap, const Item> ConstIterator;
+
+    /** Returns an iterator pointing at the first item in the map. */
+    Iterator begin() noexcept                   { return Iterator (*this, 0); }
+    /** Returns an iterator pointing beyond the last item in the map. */
+    Iterator end() noexcept                     { return Iterator (*this, numSlots); }
+    /** Returns an iterator pointing at the first item in the map. */
+    ConstIterator begin() const noexcept        { return ConstIterator (*this, 0); }
+    /** Returns an iterator pointing beyond the last item in the map. */
+    ConstIterator end() const noexcept          { return ConstIterator (*this, numSlots); }
+
+private:
+    //==============================================================================
+    // Each slot's probe length is 1 + its distance from the slot that its hash chose,
+    // or 0 if the slot is empty.
+    enum { maxProbeLength = 255 };
+
+    HashFunctionType hashFunctionToUse;
+    HeapBlock<Item> items;
+    HeapBlock<uint8> probeLengths;
+    int numSlots = 0, numItems = 0, slotShift = 32;
+
+    template <typename Key>
+    int getFirstSlot (const Key& key) const noexcept
+    {
+        const int hash = hashFunctionToUse.generateHash (key, 0x7fffffff);
+        jassert (hash >= 0); // your hash function is generating out-of-range numbers!
+
+        // multiplying by the golden ratio spreads out hashes that only differ in their low bits
+        return (int) (((uint32) hash * 2654435769u) >> slotShift);
+    }
+
+    // The table is kept at most 80% full
+    static int getNumSlotsNeededFor (int numItemsNeeded) noexcept
+    {
+        int slots = 16;
+
+        while (numItemsNeeded * 5 > slots * 4)
+            slots *= 2;
+
+        return slots;
+    }
+
+    int findIndex (LookupKeyType keyToLookFor) const noexcept
+    {
+        if (numItems == 0)
+            return -1;
+
+        auto index = getFirstSlot (keyToLookFor);
+
+        // An item further from its first slot than we are means the key isn't there
+        for (int probeLength = 1; probeLength <= probeLengths[index]; ++probeLength)
+        {
+            if (probeLengths[index] == probeLength && items[index].key == keyToLookFor)
+                return index;
+
+            index = (index + 1) & (numSlots - 1);
+        }
+
+        return -1;
+    }
+
+    // Adds an item whose key isn't already in the map, returning the index at which it ends up
+    int insert (Item&& newItem)
+    {
+        Item item (static_cast<Item&&> (newItem));
+        auto index = getFirstSlot (item.key);
+        int probeLength = 1;
+        int newItemIndex = -1;
+
+        for (;;)
+        {
+            if (probeLengths[index] == 0)
+            {
+                new (items + index) Item (static_cast<Item&&> (item));
+                probeLengths[index] = (uint8) probeLength;
+                ++numItems;
+                return newItemIndex >= 0 ? newItemIndex : index;
+            }
+
+            // Take the slot from any item that's closer to its first slot than this one
+            if (probeLengths[index] < probeLength)
+            {
+                std::swap (item, items[index]);
+
+                auto displacedProbeLength = (int) probeLengths[index];
+                probeLengths[index] = (uint8) probeLength;
+                probeLength = displacedProbeLength;
+
+                if (newItemIndex < 0)
+                    newItemIndex = index;
+            }
+
+            index = (index + 1) & (numSlots - 1);
+
+            if (++probeLength == maxProbeLength)
+            {
+                // This should only happen with a really bad hash function: the table is
+                // grown, and the item that's been displaced goes back in afterwards.
+                const KeyType newKey (newItemIndex >= 0 ? items[newItemIndex].key : item.key);
+                resizeTable (numSlots * 2);
+                auto displacedIndex = insert (static_cast<Item&&> (item));
+                return newItemIndex >= 0 ? findIndex (newKey) : displacedIndex;
+            }
+        }
+    }
+
+    void resizeTable (int newNumSlots)
+    {
+        jassert (isPowerOfTwo (newNumSlots));
+
+        HeapBlock<Item> oldItems (static_cast<HeapBlock<Item>&&> (items));
+        HeapBlock<uint8> oldProbeLengths (static_cast<HeapBlock<uint8>&&> (probeLengths));
+        auto oldNumSlots = numSlots;
+
+        items.malloc ((size_t) newNumSlots);
+        probeLengths.calloc ((size_t) newNumSlots);
+        numSlots = newNumSlots;
+        numItems = 0;
+
+        slotShift = 32;
+
+        for (auto n = newNumSlots; n > 1; n >>= 1)
+            --slotShift;
+
+        for (int i = 0; i < oldNumSlots; ++i)
+        {
+            if (oldProbeLengths[i] != 0)
+            {
+                insert (static_cast<Item&&> (oldItems[i]));
+                oldItems[i].~Item();
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    Holds a set of unique keys, stored in the same way as a FlatHashMap.
+
+    @code
+    FlatHashSet<String> names;
+    names.add ("one");
+
+    if (names.contains ("one"))
+        DBG ("found it");
+    @endcode
+
+    @see FlatHashMap, SortedSet
+*/
+template <typename KeyType,
+          class HashFunctionType = DefaultHashFunctions>
+class FlatHashSet
+{
+private:
+    struct Empty {};
+    typedef FlatHashMap<KeyType, Empty, HashFunctionType> MapType;
+    typedef typename TypeHelpers::ParameterType<KeyType>::type   KeyTypeParameter;
+    typedef typename FlatHashMapLookupKeyType<KeyType, HashFunctionType>::type LookupKeyType;
+
+public:
+    //==============================================================================
+    /** Creates an empty set.
+
+        @param hashFunction An instance of HashFunctionType, which will be copied and
+                            stored to use with the set. This parameter can be omitted
+                            if HashFunctionType has a default constructor.
+    */
+    explicit FlatHashSet (HashFunctionType hashFunction = HashFunctionType())
+        : map (hashFunction)
+    {
+    }
+
+    /** Removes all the keys from the set. */
+    void clear() noexcept                                   { map.clear(); }
+
+    /** Returns the number of keys in the set. */
+    int size() const noexcept                               { return map.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                           { return map.isEmpty(); }
+
+    /** Makes sure that the set can hold this many keys without needing to be resized. */
+    void reserve (int numItemsNeeded)                       { map.reserve (numItemsNeeded); }
+
+    /** Returns true if the set contains the given key. */
+    bool contains (LookupKeyType keyToLookFor) const noexcept   { return map.contains (keyToLookFor); }
+
+    /** Adds a key to the set, returning true if it wasn't already there. */
+    bool add (KeyTypeParameter newKey)
+    {
+        auto oldSize = map.size();
+        map.getReference (newKey);
+        return map.size() != oldSize;
+    }
+
+    /** Removes a key from the set, returning true if it was there. */
+    bool remove (LookupKeyType keyToRemove)                 { return map.remove (keyToRemove); }
+
+    /** Efficiently swaps the contents of two sets. */
+    void swapWith (FlatHashSet& otherSet) noexcept          { map.swapWith (otherSet.map); }
+
+    //==============================================================================
+    /** Iterates over the keys in a set, in no particular order. */
+    struct Iterator
+    {
+        Iterator (typename MapType::ConstIterator i) noexcept  : iterator (i) {}
+
+        const KeyType& operator*() const noexcept               { return iterator->key; }
+        Iterator& operator++() noexcept                         { ++iterator; return *this; }
+        bool operator!= (const Iterator& other) const noexcept  { return iterator != other.iterator; }
+
+    private:
+        typename MapType::ConstIterator iterator;
+    };
+
+    /** Returns an iterator pointing at the first key in the set. */
+    Iterator begin() const noexcept     { return Iterator (map.begin()); }
+    /** Returns an iterator pointing beyond the last key in the set. */
+    Iterator end() const noexcept       { return Iterator (map.end()); }
+
+private:
+    MapType map;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatHashSet)
+};
+
+} // namespace juce
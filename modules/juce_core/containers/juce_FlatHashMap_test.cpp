@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FlatHashMapTest : public UnitTest
+{
+    FlatHashMapTest() : UnitTest ("FlatHashMap", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Random changes");
+        runRandomChanges<int> (1000);
+        runRandomChanges<void*> (1000);
+        runRandomChanges<String> (1000);
+
+        beginTest ("Many keys");
+        runRandomChanges<int> (20000);
+
+        beginTest ("Bad hash function");
+        {
+            FlatHashMap<int, int, ConstantHash> map;
+
+            for (int i = 0; i < 200; ++i)
+                map.set (i, i * 3);
+
+            expectEquals (map.size(), 200);
+
+            for (int i = 0; i < 200; ++i)
+                expectEquals (map[i], i * 3);
+
+            for (int i = 0; i < 200; i += 2)
+                expect (map.remove (i));
+
+            for (int i = 0; i < 200; ++i)
+                expect (map.contains (i) == ((i & 1) != 0));
+        }
+
+        beginTest ("StringRef lookups");
+        {
+            FlatHashMap<String, int> map;
+            map.set ("one", 1);
+            map.set ("two", 2);
+
+            expectEquals (map["one"], 1);
+            expectEquals (map[StringRef ("two")], 2);
+            expectEquals (map[Identifier ("two").toString()], 2);
+            expect (map.find ("three") == nullptr);
+            expect (map.remove ("one"));
+            expect (! map.contains ("one"));
+        }
+
+        beginTest ("Reserve and iterate");
+        {
+            FlatHashMap<int, int> map;
+            map.reserve (100);
+
+            for (int i = 0; i < 100; ++i)
+                map.set (i, i);
+
+            int total = 0, count = 0;
+
+            for (auto& item : map)
+            {
+                expectEquals (item.key, item.value);
+                total += item.value;
+                ++count;
+            }
+
+            expectEquals (count, 100);
+            expectEquals (total, 4950);
+
+            FlatHashMap<int, int> other (static_cast<FlatHashMap<int, int>&&> (map));
+            expectEquals (other.size(), 100);
+            expect (other.contains (42));
+
+            other.clear();
+            expect (other.isEmpty());
+            expect (! other.contains (42));
+        }
+
+        beginTest ("FlatHashSet");
+        {
+            FlatHashSet<String> set;
+            expect (set.add ("a"));
+            expect (set.add ("b"));
+            expect (! set.add ("a"));
+            expectEquals (set.size(), 2);
+            expect (set.contains ("b"));
+            expect (set.remove ("b"));
+            expect (! set.contains ("b"));
+
+            int count = 0;
+
+            for (auto& key : set)
+            {
+                expectEquals (key, String ("a"));
+                ++count;
+            }
+
+            expectEquals (count, 1);
+        }
+    }
+
+    //==============================================================================
+    struct ConstantHash
+    {
+        int generateHash (int, int) const noexcept     { return 7; }
+    };
+
+    template <typename KeyType>
+    void runRandomChanges (int numKeys)
+    {
+        Random r (872364);
+        Array<KeyType> keys;
+
+        for (int i = 0; i < numKeys; ++i)
+            keys.addIfNotAlreadyThere (generateRandomKey<KeyType> (r));
+
+        HashMap<KeyType, int> groundTruth;
+        FlatHashMap<KeyType, int> map;
+
+        for (int i = 0; i < numKeys * 10; ++i)
+        {
+            auto& key = keys.getReference (r.nextInt (keys.size()));
+
+            if (r.nextInt (3) == 0)
+            {
+                expectEquals ((int) map.remove (key), (int) groundTruth.contains (key));
+                groundTruth.remove (key);
+            }
+            else
+            {
+                auto value = r.nextInt();
+                map.set (key, value);
+                groundTruth.set (key, value);
+            }
+
+            expectEquals (map.size(), groundTruth.size());
+        }
+
+        for (auto& key : keys)
+        {
+            expectEquals ((int) map.contains (key), (int) groundTruth.contains (key));
+            expectEquals (map[key], groundTruth[key]);
+        }
+    }
+
+    template <typename KeyType>
+    static KeyType generateRandomKey (Random&);
+};
+
+template <> int   FlatHashMapTest::generateRandomKey<int>   (Random& r) { return r.nextInt(); }
+template <> void* FlatHashMapTest::generateRandomKey<void*> (Random& r) { return reinterpret_cast<void*> (r.nextInt64()); }
+
+template <> String FlatHashMapTest::generateRandomKey<String> (Random& r)
+{
+    String str;
+
+    auto len = r.nextInt (8) + 1;
+
+    for (int i = 0; i < len; ++i)
+        str += static_cast<char> (r.nextInt (95) + 32);
+
+    return str;
+}
+
+static FlatHashMapTest flatHashMapTest;
+
+} // namespace juce
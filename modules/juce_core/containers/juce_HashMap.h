@@ -41,6 +41,16 @@ struct DefaultHashFunctions
     static int generateHash (int64 key, int upperLimit) noexcept            { return generateHash ((uint64) key, upperLimit); }
     /** Generates a simple hash from a string. */
     static int generateHash (const String& key, int upperLimit) noexcept    { return generateHash ((uint32) key.hashCode(), upperLimit); }
+    /** Generates a simple hash from a StringRef. This gives the same result as the String version. */
+    static int generateHash (StringRef key, int upperLimit) noexcept
+    {
+        uint32 result = 0;
+
+        for (auto t = key.text; ! t.isEmpty();)
+            result = 31 * result + (uint32) t.getAndAdvance();
+
+        return generateHash (result, upperLimit);
+    }
     /** Generates a simple hash from a variant. */
     static int generateHash (const var& key, int upperLimit) noexcept       { return generateHash (key.toString(), upperLimit); }
     /** Generates a simple hash from a void ptr. */
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A single-reader, single-writer lock-free FIFO which holds its own items.
+
+    This wraps an AbstractFifo and a buffer, so that blocks of items can be pushed
+    and popped with a single call, copying both regions of the buffer at once.
+
+    The items are copied with memcpy, so ElementType must be a trivially copyable
+    type, e.g. a number or a POD struct.
+
+    @see AbstractFifo, MultiProducerFifo, OverwritingFifo
+*/
+template <typename ElementType>
+class LockFreeFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO which can hold up to the given number of items. */
+    explicit LockFreeFifo (int capacity)
+        : fifo (capacity + 1), buffer ((size_t) capacity + 1)
+    {
+        jassert (capacity > 0);
+    }
+
+    //==============================================================================
+    /** Returns the maximum number of items that the FIFO can hold. */
+    int getCapacity() const noexcept                { return fifo.getTotalSize() - 1; }
+
+    /** Returns the number of items that can currently be written. */
+    int getFreeSpace() const noexcept               { return fifo.getFreeSpace(); }
+
+    /** Returns the number of items that can currently be read. */
+    int getNumReady() const noexcept                { return fifo.getNumReady(); }
+
+    /** Removes all the items from the FIFO.
+        Note that this isn't thread-safe, so don't call it if there's any danger that it
+        might overlap with a read or a write!
+    */
+    void reset() noexcept                           { fifo.reset(); }
+
+    //==============================================================================
+    /** Copies as many of the given items as there is space for into the FIFO, and
+        returns the number of items written. This must only be called by the writer thread.
+    */
+    int write (const ElementType* source, int numItems) noexcept
+    {
+        const auto scope = fifo.write (numItems);
+
+        copyItems (buffer + scope.startIndex1, source, scope.blockSize1);
+        copyItems (buffer + scope.startIndex2, source + scope.blockSize1, scope.blockSize2);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    /** Copies up to numItems items out of the FIFO, and returns the number of items
+        read. This must only be called by the reader thread.
+    */
+    int read (ElementType* dest, int numItems) noexcept
+    {
+        const auto scope = fifo.read (numItems);
+
+        copyItems (dest, buffer + scope.startIndex1, scope.blockSize1);
+        copyItems (dest + scope.blockSize1, buffer + scope.startIndex2, scope.blockSize2);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    /** Adds a single item, returning false if the FIFO is full. */
+    bool push (const ElementType& item) noexcept    { return write (&item, 1) == 1; }
+
+    /** Removes a single item, returning false if the FIFO is empty. */
+    bool pop (ElementType& item) noexcept           { return read (&item, 1) == 1; }
+
+private:
+    //==============================================================================
+    static void copyItems (ElementType* dest, const ElementType* source, int num) noexcept
+    {
+        if (num > 0)
+            memcpy (dest, source, (size_t) num * sizeof (ElementType));
+    }
+
+    AbstractFifo fifo;
+    HeapBlock<ElementType> buffer;
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeFifo)
+};
+
+} // namespace juce
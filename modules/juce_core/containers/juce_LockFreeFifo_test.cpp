@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LockFreeFifoTest  : public UnitTest
+{
+    LockFreeFifoTest() : UnitTest ("Lock-free FIFOs", "Containers") {}
+
+    struct Item
+    {
+        int producer, value;
+    };
+
+    class ProducerThread  : public Thread
+    {
+    public:
+        ProducerThread (MultiProducerFifo<Item>& f, int index, int num)
+            : Thread ("fifo producer"), fifo (f), producerIndex (index), numItems (num)
+        {
+        }
+
+        void run() override
+        {
+            for (int i = 0; i < numItems && ! threadShouldExit();)
+            {
+                if (fifo.push ({ producerIndex, i }))
+                    ++i;
+                else
+                    Thread::sleep (1);
+            }
+        }
+
+    private:
+        MultiProducerFifo<Item>& fifo;
+        int producerIndex, numItems;
+    };
+
+    void runTest() override
+    {
+        beginTest ("LockFreeFifo bulk transfers");
+        {
+            LockFreeFifo<int> fifo (100);
+            expectEquals (fifo.getCapacity(), 100);
+
+            int source[70], dest[100];
+            int next = 0, expected = 0;
+            bool allCorrect = true;
+
+            for (int block = 0; block < 20; ++block)
+            {
+                for (auto& v : source)
+                    v = next++;
+
+                expectEquals (fifo.write (source, numElementsInArray (source)), 70);
+                expectEquals (fifo.getNumReady(), 70);
+                expectEquals (fifo.getFreeSpace(), 30);
+                expectEquals (fifo.write (source, 70), 30);
+
+                auto numRead = fifo.read (dest, numElementsInArray (dest));
+                expectEquals (numRead, 100);
+
+                for (int i = 0; i < 70; ++i)
+                    allCorrect = (dest[i] == expected++) && allCorrect;
+
+                // these were the first 30 items of the same block, written again
+                for (int i = 70; i < 100; ++i)
+                    allCorrect = (dest[i] == expected - 70 + (i - 70)) && allCorrect;
+            }
+
+            expect (allCorrect);
+
+            int single = 0;
+            expect (! fifo.pop (single));
+            expect (fifo.push (42));
+            expect (fifo.pop (single));
+            expectEquals (single, 42);
+        }
+
+        beginTest ("MultiProducerFifo");
+        {
+            const int numProducers = 4, numItems = 20000;
+
+            MultiProducerFifo<Item> fifo (100);
+            expectEquals (fifo.getCapacity(), 128);
+
+            OwnedArray<ProducerThread> producers;
+
+            for (int i = 0; i < numProducers; ++i)
+                producers.add (new ProducerThread (fifo, i, numItems));
+
+            for (auto* p : producers)
+                p->startThread();
+
+            int nextValues[numProducers] = {};
+            int numReceived = 0;
+            bool inOrder = true;
+            auto timeout = Time::getMillisecondCounter() + 20000;
+
+            while (numReceived < numProducers * numItems && Time::getMillisecondCounter() < timeout)
+            {
+                Item item;
+
+                if (fifo.pop (item))
+                {
+                    inOrder = (item.value == nextValues[item.producer]++) && inOrder;
+                    ++numReceived;
+                }
+                else
+                {
+                    Thread::sleep (1);
+                }
+            }
+
+            for (auto* p : producers)
+                p->stopThread (5000);
+
+            expectEquals (numReceived, numProducers * numItems);
+            expect (inOrder);
+
+            Item item;
+            expect (! fifo.pop (item));
+        }
+
+        beginTest ("OverwritingFifo");
+        {
+            OverwritingFifo<int> fifo (8);
+            expectEquals (fifo.getCapacity(), 8);
+
+            int value = 0;
+            expect (! fifo.pop (value));
+
+            for (int i = 0; i < 3; ++i)
+                fifo.push (i);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                expect (fifo.pop (value));
+                expectEquals (value, i);
+            }
+
+            for (int i = 0; i < 20; ++i)
+                fifo.push (i);
+
+            // only the latest 8 items are kept
+            for (int i = 12; i < 20; ++i)
+            {
+                expect (fifo.pop (value));
+                expectEquals (value, i);
+            }
+
+            expect (! fifo.pop (value));
+            expectEquals ((int) fifo.getNumDropped(), 12);
+
+            fifo.reset();
+            expectEquals ((int) fifo.getNumDropped(), 0);
+            expect (! fifo.pop (value));
+        }
+    }
+};
+
+static LockFreeFifoTest lockFreeFifoTest;
+
+} // namespace juce
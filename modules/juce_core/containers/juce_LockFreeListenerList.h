@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A version of ListenerList whose call() methods are wait-free, so that a
+    broadcaster can safely call its listeners from a realtime thread, e.g. the
+    audio callback.
+
+    Rather than locking and walking an Array that might be changed underneath it,
+    the list keeps an immutable snapshot of its listeners. add(), remove() and clear()
+    build a new snapshot and publish it with a single atomic exchange, and the old one
+    is only deleted once every call that might have been using it has finished. A call
+    never takes a lock, allocates or waits for anything, no matter what the other
+    threads are doing.
+
+    The methods which change the list may allocate and take a lock, so they should
+    be called from a non-realtime thread such as the message thread.
+
+    Because each call iterates the snapshot that was current when it started, the
+    semantics are a little different from ListenerList:
+    - a listener that's added during a call won't be called until the next one.
+    - a listener that's removed while a call is in progress on another thread (or
+      by one of the callbacks) may still be called by that call. So if a listener
+      could be called from another thread, call waitForCallsToFinish() after removing
+      it and before deleting it.
+
+    e.g.
+    @code
+    // audio thread
+    levelListeners.call (&LevelListener::levelChanged, level);
+
+    // message thread
+    levelListeners.remove (meter);
+    levelListeners.waitForCallsToFinish();
+    delete meter;
+    @endcode
+
+    @see ListenerList
+*/
+template <class ListenerClass>
+class LockFreeListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    LockFreeListenerList()  : current (new Snapshot()) {}
+
+    /** Destructor.
+        There mustn't be any calls still in progress when the list is deleted!
+    */
+    ~LockFreeListenerList()
+    {
+        jassert (numReaders[0] == 0 && numReaders[1] == 0);
+        delete current.load();
+    }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+        A listener can only be added once, so if the listener is already in the list,
+        this method has no effect.
+        @see remove
+    */
+    void add (ListenerClass* listenerToAdd)
+    {
+        // Listeners can't be null pointers!
+        jassert (listenerToAdd != nullptr);
+
+        if (listenerToAdd != nullptr)
+        {
+            const ScopedLock sl (writeLock);
+            auto* oldSnapshot = current.load();
+
+            if (! oldSnapshot->listeners.contains (listenerToAdd))
+            {
+                auto* newSnapshot = new Snapshot (*oldSnapshot);
+                newSnapshot->listeners.add (listenerToAdd);
+                publish (newSnapshot);
+            }
+        }
+    }
+
+    /** Removes a listener from the list.
+        If the listener wasn't in the list, this has no effect.
+
+        A call which is in progress on another thread may still invoke the listener
+        after this returns - see waitForCallsToFinish().
+    */
+    void remove (ListenerClass* listenerToRemove)
+    {
+        // Listeners can't be null pointers!
+        jassert (listenerToRemove != nullptr);
+
+        const ScopedLock sl (writeLock);
+        auto* oldSnapshot = current.load();
+
+        if (oldSnapshot->listeners.contains (listenerToRemove))
+        {
+            auto* newSnapshot = new Snapshot (*oldSnapshot);
+            newSnapshot->listeners.removeFirstMatchingValue (listenerToRemove);
+            publish (newSnapshot);
+        }
+    }
+
+    /** Clears the list. */
+    void clear()
+    {
+        const ScopedLock sl (writeLock);
+
+        if (! current.load()->listeners.isEmpty())
+            publish (new Snapshot());
+    }
+
+    /** Blocks until any calls that were in progress when this method was called have
+        finished, and deletes any snapshots of the list which are no longer in use.
+
+        After a listener has been removed, this makes sure that no other thread can
+        still be calling it. Calls which start while this is waiting don't hold it up,
+        so it can't be starved by a thread which is calling the list continuously.
+
+        Never call this from inside one of the list's callbacks, as it would wait for
+        itself forever!
+    */
+    void waitForCallsToFinish()
+    {
+        const ScopedLock sl (writeLock);
+
+        for (int numPeriods = 0; numPeriods < 3;)
+        {
+            if (tryToReclaimSnapshots())
+                ++numPeriods;
+            else
+                Thread::yield();
+        }
+    }
+
+    //==============================================================================
+    /** Returns the number of registered listeners. */
+    int size() const noexcept
+    {
+        const ScopedReader reader (*this);
+        return reader.snapshot->listeners.size();
+    }
+
+    /** Returns true if any listeners are registered. */
+    bool isEmpty() const noexcept                       { return size() == 0; }
+
+    /** Returns true if the specified listener has been added to the list. */
+    bool contains (ListenerClass* listener) const noexcept
+    {
+        const ScopedReader reader (*this);
+        return reader.snapshot->listeners.contains (listener);
+    }
+
+    //==============================================================================
+    /** Calls a member function on each listener in the list, with the given parameters.
+        The listeners are called in the same order as ListenerList calls them.
+    */
+    template <typename... MethodArgs, typename... Args>
+    void call (void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args) const
+    {
+        callCheckedExcluding (nullptr, DummyBailOutChecker(), callbackFunction, args...);
+    }
+
+    /** Calls a member function, with the given parameters, on all but the specified
+        listener in the list. This can be useful if the caller is also a listener and
+        needs to exclude itself.
+    */
+    template <typename... MethodArgs, typename... Args>
+    void callExcluding (ListenerClass* listenerToExclude,
+                        void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args) const
+    {
+        callCheckedExcluding (listenerToExclude, DummyBailOutChecker(), callbackFunction, args...);
+    }
+
+    /** Calls a member function on each listener in the list, with the given parameters
+        and a bail-out-checker. See the ListenerList notes for info about writing a
+        bail-out checker.
+    */
+    template <class BailOutCheckerType, typename... MethodArgs, typename... Args>
+    void callChecked (const BailOutCheckerType& bailOutChecker,
+                      void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args) const
+    {
+        callCheckedExcluding (nullptr, bailOutChecker, callbackFunction, args...);
+    }
+
+    /** Calls a member function, with the given parameters, on all but the specified
+        listener in the list, with a bail-out-checker.
+
+        Note that if the bail-out checker's object is the one that owns this list, the
+        list mustn't be deleted by a callback, even if the checker stops the call, because
+        the call still needs the list to finish up afterwards.
+    */
+    template <class BailOutCheckerType, typename... MethodArgs, typename... Args>
+    void callCheckedExcluding (ListenerClass* listenerToExclude,
+                               const BailOutCheckerType& bailOutChecker,
+                               void (ListenerClass::*callbackFunction) (MethodArgs...), Args&&... args) const
+    {
+        const ScopedReader reader (*this);
+        auto& listeners = reader.snapshot->listeners;
+
+        for (int i = listeners.size(); --i >= 0 && ! bailOutChecker.shouldBailOut();)
+        {
+            auto* l = listeners.getUnchecked (i);
+
+            if (l != listenerToExclude)
+                (l->*callbackFunction) (args...);
+        }
+    }
+
+    //==============================================================================
+    /** A dummy bail-out checker that always returns false. */
+    struct DummyBailOutChecker
+    {
+        bool shouldBailOut() const noexcept             { return false; }
+    };
+
+    typedef ListenerClass ListenerType;
+
+private:
+    //==============================================================================
+    struct Snapshot
+    {
+        Array<ListenerClass*> listeners;
+    };
+
+    // Each call registers itself in the counter for the current epoch before it loads
+    // the snapshot. The writer flips the epoch whenever the counter for the other one
+    // has drained, and a snapshot that was replaced before one flip is safe to delete
+    // once the counters for both epochs have been seen to drain after it.
+    struct ScopedReader
+    {
+        ScopedReader (const LockFreeListenerList& l) noexcept
+            : counter (l.numReaders[l.epoch.load() & 1])
+        {
+            ++counter;
+            snapshot = l.current.load();
+        }
+
+        ~ScopedReader() noexcept    { --counter; }
+
+        std::atomic<int>& counter;
+        const Snapshot* snapshot;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedReader)
+    };
+
+    void publish (Snapshot* newSnapshot)
+    {
+        retired.add (current.exchange (newSnapshot));
+
+        // this never waits - anything that's still in use is left for the next write
+        for (int i = 0; i < 3 && tryToReclaimSnapshots(); ++i)
+        {}
+    }
+
+    bool tryToReclaimSnapshots()
+    {
+        auto oldEpoch = epoch.load();
+
+        if (numReaders[(oldEpoch + 1) & 1] != 0)
+            return false;
+
+        // the snapshots that were waiting for this counter to drain can now go
+        waitingForSecondDrain.clear();
+        waitingForSecondDrain.swapWith (waitingForFirstDrain);
+        waitingForFirstDrain.swapWith (retired);
+        epoch = oldEpoch + 1;
+        return true;
+    }
+
+    std::atomic<Snapshot*> current;
+    mutable std::atomic<int> numReaders[2] { { 0 }, { 0 } };
+    std::atomic<uint32> epoch { 0 };
+
+    CriticalSection writeLock;
+    OwnedArray<Snapshot> retired, waitingForFirstDrain, waitingForSecondDrain;
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeListenerList)
+};
+
+} // namespace juce
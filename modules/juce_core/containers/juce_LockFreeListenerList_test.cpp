@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LockFreeListenerListTest  : public UnitTest
+{
+    LockFreeListenerListTest() : UnitTest ("LockFreeListenerList", "Containers") {}
+
+    struct TestListener
+    {
+        void valueChanged (int newValue)
+        {
+            // gives a removal on another thread a chance to overlap the call
+            Thread::yield();
+
+            if (! isAlive)
+                calledAfterDeletion = true;
+
+            lastValue = newValue;
+            ++numCalls;
+        }
+
+        void addOther()     { list->add (other); }
+        void removeSelf()   { list->remove (this); }
+
+        LockFreeListenerList<TestListener>* list = nullptr;
+        TestListener* other = nullptr;
+        std::atomic<bool> isAlive { true }, calledAfterDeletion { false };
+        std::atomic<int> numCalls { 0 };
+        int lastValue = 0;
+    };
+
+    struct BailOutAfter
+    {
+        bool shouldBailOut() const noexcept    { return ++numChecks > limit; }
+
+        mutable int numChecks = 0;
+        int limit;
+    };
+
+    class CallerThread  : public Thread
+    {
+    public:
+        CallerThread (LockFreeListenerList<TestListener>& l)  : Thread ("listener caller"), list (l)
+        {
+            // a normal priority, so that it can't starve the test thread on a single core
+            startThread (0);
+        }
+
+        ~CallerThread()
+        {
+            stopThread (5000);
+        }
+
+        void run() override
+        {
+            for (int n = 0; ! threadShouldExit(); ++n)
+                list.call (&TestListener::valueChanged, n);
+        }
+
+    private:
+        LockFreeListenerList<TestListener>& list;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Adding and removing");
+        {
+            LockFreeListenerList<TestListener> list;
+            TestListener a, b;
+
+            expect (list.isEmpty());
+            list.add (&a);
+            list.add (&b);
+            list.add (&a);
+            expectEquals (list.size(), 2);
+            expect (list.contains (&a) && list.contains (&b));
+
+            list.remove (&a);
+            expectEquals (list.size(), 1);
+            expect (! list.contains (&a));
+
+            list.clear();
+            expect (list.isEmpty());
+        }
+
+        beginTest ("Calling");
+        {
+            LockFreeListenerList<TestListener> list;
+            TestListener a, b, c;
+            list.add (&a);
+            list.add (&b);
+            list.add (&c);
+
+            list.call (&TestListener::valueChanged, 3);
+            expect (a.numCalls == 1 && b.numCalls == 1 && c.numCalls == 1);
+            expectEquals (c.lastValue, 3);
+
+            list.callExcluding (&b, &TestListener::valueChanged, 4);
+            expect (a.numCalls == 2 && b.numCalls == 1 && c.numCalls == 2);
+
+            // listeners are called from the end of the list, like ListenerList
+            BailOutAfter checker;
+            checker.limit = 1;
+            list.callChecked (checker, &TestListener::valueChanged, 5);
+            expect (a.numCalls == 2 && b.numCalls == 1 && c.numCalls == 3);
+        }
+
+        beginTest ("Changing the list from a callback");
+        {
+            LockFreeListenerList<TestListener> list;
+            TestListener a, b;
+            a.list = &list;
+            a.other = &b;
+            list.add (&a);
+
+            list.call (&TestListener::addOther);
+            expect (list.contains (&b));
+
+            list.add (&b);
+            b.list = &list;
+            list.call (&TestListener::removeSelf);
+            expect (list.isEmpty());
+        }
+
+        beginTest ("Calling from another thread");
+        {
+            LockFreeListenerList<TestListener> list;
+            OwnedArray<TestListener> listeners;
+            auto r = getRandom();
+
+            for (int i = 0; i < 8; ++i)
+                list.add (listeners.add (new TestListener()));
+
+            {
+                CallerThread caller (list);
+
+                while (listeners.getFirst()->numCalls == 0)
+                    Thread::yield();
+
+                for (int i = 0; i < 1000; ++i)
+                {
+                    auto* l = listeners.getUnchecked (r.nextInt (listeners.size()));
+
+                    if (l->isAlive)
+                    {
+                        list.remove (l);
+                        list.waitForCallsToFinish();
+                        l->isAlive = false;
+                    }
+                    else
+                    {
+                        l->isAlive = true;
+                        list.add (l);
+                    }
+                }
+            }
+
+            int totalCalls = 0;
+
+            for (auto* l : listeners)
+            {
+                expect (! l->calledAfterDeletion);
+                totalCalls += l->numCalls;
+            }
+
+            expect (totalCalls > 0);
+        }
+    }
+};
+
+static LockFreeListenerListTest lockFreeListenerListTest;
+
+} // namespace juce
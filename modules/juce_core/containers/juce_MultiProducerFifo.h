@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A bounded lock-free FIFO which can be written to by any number of threads at
+    once, and read by a single thread.
+
+    Each slot of the buffer has a sequence number which tells the writers whether it
+    is free and the reader whether it has been filled, so the only contention between
+    writers is a compare-and-swap on the write position, and the reader never waits
+    for anything.
+
+    This is handy when several real-time sources feed the same consumer, e.g. the MIDI
+    input callbacks of several devices feeding an audio callback.
+
+    The items are moved out of the slots by the reader, so ElementType can be any
+    default-constructible, copyable type.
+
+    @see LockFreeFifo, AbstractFifo
+*/
+template <typename ElementType>
+class MultiProducerFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO which can hold at least the given number of items. The
+        capacity is rounded up to a power of two.
+    */
+    explicit MultiProducerFifo (int minimumCapacity)
+        : mask ((uint32) nextPowerOfTwo (jmax (2, minimumCapacity)) - 1)
+    {
+        cells.resize ((int) mask + 1);
+        reset();
+    }
+
+    //==============================================================================
+    /** Returns the maximum number of items that the FIFO can hold. */
+    int getCapacity() const noexcept        { return (int) mask + 1; }
+
+    /** Removes all the items from the FIFO.
+        Note that this isn't thread-safe, so don't call it if there's any danger that it
+        might overlap with a call to push() or pop()!
+    */
+    void reset() noexcept
+    {
+        for (int i = 0; i < cells.size(); ++i)
+            cells.getReference (i).sequence = (uint32) i;
+
+        writePosition = 0;
+        readPosition = 0;
+    }
+
+    //==============================================================================
+    /** Adds an item to the FIFO, returning false if it is full.
+        This can be called by any number of threads concurrently.
+    */
+    bool push (const ElementType& item) noexcept
+    {
+        auto position = writePosition.get();
+
+        for (;;)
+        {
+            auto& cell = cells.getReference ((int) (position & mask));
+            auto difference = (int32) (cell.sequence.get() - position);
+
+            if (difference == 0)
+            {
+                if (writePosition.compareAndSetBool (position + 1, position))
+                {
+                    cell.item = item;
+                    cell.sequence = position + 1;
+                    return true;
+                }
+
+                position = writePosition.get();
+            }
+            else if (difference < 0)
+            {
+                return false;   // the FIFO is full
+            }
+            else
+            {
+                position = writePosition.get();
+            }
+        }
+    }
+
+    /** Removes the oldest item from the FIFO, returning false if it is empty.
+        This must only be called by the reader thread.
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        auto& cell = cells.getReference ((int) (readPosition & mask));
+
+        if ((int32) (cell.sequence.get() - (readPosition + 1)) < 0)
+            return false;
+
+        result = std::move (cell.item);
+        cell.sequence = readPosition + mask + 1;
+        ++readPosition;
+        return true;
+    }
+
+private:
+    //==============================================================================
+    struct Cell
+    {
+        Atomic<uint32> sequence;
+        ElementType item;
+    };
+
+    const uint32 mask;
+    Array<Cell> cells;
+    Atomic<uint32> writePosition;
+    uint32 readPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (MultiProducerFifo)
+};
+
+} // namespace juce
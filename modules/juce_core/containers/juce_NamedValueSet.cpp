@@ -23,6 +23,38 @@
 namespace juce
 {
 
+/*  Once a set has this many values, it keeps a hash table that maps each name
+    to its position in the array.
+*/
+enum { minNumValuesForIndex = 16 };
+
+struct NamedValueSet::Index
+{
+    // Identifiers are pooled, so we can just hash the address of their text
+    static const void* getKey (const Identifier& name) noexcept   { return name.getCharPointer().getAddress(); }
+
+    Index (const Array<NamedValue>& values)
+    {
+        positions.reserve (values.size() * 2);
+
+        for (int i = 0; i < values.size(); ++i)
+            add (values.getReference (i).name, i);
+    }
+
+    void add (const Identifier& name, int position)     { positions.set (getKey (name), position); }
+    void remove (const Identifier& name)                { positions.remove (getKey (name)); }
+
+    // returns -1 if the name isn't there
+    int find (const Identifier& name) const noexcept
+    {
+        auto* position = positions.find (getKey (name));
+        return position != nullptr ? *position : -1;
+    }
+
+    FlatHashMap<const void*, int> positions;
+};
+
+//==============================================================================
 NamedValueSet::NamedValueSet() noexcept
 {
 }
@@ -30,23 +62,27 @@ NamedValueSet::NamedValueSet() noexcept
 NamedValueSet::NamedValueSet (const NamedValueSet& other)
    : values (other.values)
 {
+    updateIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+    updateIndex();
     return *this;
 }
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-    : values (static_cast<Array<NamedValue>&&> (other.values))
+    : values (static_cast<Array<NamedValue>&&> (other.values)),
+      nameIndex (other.nameIndex.release())
 {
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    nameIndex.swapWith (other.nameIndex);
     return *this;
 }
 
@@ -57,6 +93,15 @@ NamedValueSet::~NamedValueSet() noexcept
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex = nullptr;
+}
+
+void NamedValueSet::updateIndex()
+{
+    if (values.size() >= minNumValuesForIndex)
+        nameIndex = new Index (values);
+    else
+        nameIndex = nullptr;
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const
@@ -107,6 +152,12 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto i = nameIndex->find (name);
+        return i >= 0 ? &(values.getReference (i).value) : nullptr;
+    }
+
     for (NamedValue* e = values.end(), *i = values.begin(); i != e; ++i)
         if (i->name == name)
             return &(i->value);
@@ -126,6 +177,12 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add (NamedValue (name, static_cast<var&&> (newValue)));
+
+    if (nameIndex != nullptr)
+        nameIndex->add (name, values.size() - 1);
+    else if (values.size() >= minNumValuesForIndex)
+        updateIndex();
+
     return true;
 }
 
@@ -141,6 +198,12 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add (NamedValue (name, newValue));
+
+    if (nameIndex != nullptr)
+        nameIndex->add (name, values.size() - 1);
+    else if (values.size() >= minNumValuesForIndex)
+        updateIndex();
+
     return true;
 }
 
@@ -151,6 +214,9 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+        return nameIndex->find (name);
+
     const int numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -162,18 +228,21 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    const int numValues = values.size();
+    auto i = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference(i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (i < 0)
+        return false;
+
+    values.remove (i);
 
-    return false;
+    // removing the last value doesn't move any of the others, so the index
+    // only needs rebuilding if something else was removed
+    if (nameIndex != nullptr && i == values.size() && values.size() >= minNumValuesForIndex)
+        nameIndex->remove (name);
+    else
+        updateIndex();
+
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -221,6 +290,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add (NamedValue (att->name, var (att->value)));
     }
+
+    updateIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -244,4 +315,86 @@ void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class NamedValueSetTests  : public UnitTest
+{
+public:
+    NamedValueSetTests() : UnitTest ("NamedValueSet", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Lookups");
+
+        Random r = getRandom();
+        NamedValueSet set;
+        Array<Identifier> names;
+        Array<int> expected;
+
+        auto check = [&] (const NamedValueSet& s)
+        {
+            expectEquals (s.size(), names.size());
+
+            for (int i = 0; i < names.size(); ++i)
+            {
+                expect (s.getName (i) == names[i]);
+                expectEquals (s.indexOf (names[i]), i);
+                expect (s[names[i]] == var (expected[i]));
+            }
+
+            expect (! s.contains ("missing"));
+            expectEquals (s.indexOf ("missing"), -1);
+        };
+
+        for (int i = 0; i < 400; ++i)
+        {
+            Identifier valueName ("value" + String (r.nextInt (60)));
+            auto value = r.nextInt (1000);
+            auto existing = names.indexOf (valueName);
+
+            if (r.nextInt (3) == 0)
+            {
+                expect (set.remove (valueName) == (existing >= 0));
+
+                if (existing >= 0)
+                {
+                    names.remove (existing);
+                    expected.remove (existing);
+                }
+            }
+            else
+            {
+                set.set (valueName, value);
+
+                if (existing >= 0)
+                {
+                    expected.set (existing, value);
+                }
+                else
+                {
+                    names.add (valueName);
+                    expected.add (value);
+                }
+            }
+
+            check (set);
+        }
+
+        NamedValueSet copy (set);
+        check (copy);
+
+        NamedValueSet moved (static_cast<NamedValueSet&&> (copy));
+        check (moved);
+
+        set.clear();
+        expect (set.isEmpty());
+        expect (! set.contains (names.getFirst()));
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+#endif
+
 } // namespace juce
@@ -28,6 +28,9 @@ namespace juce
 
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
+
+    Small sets are searched linearly, but once a set grows beyond a handful of
+    values, it also keeps a hash table of its names so that lookups stay fast.
 */
 class JUCE_API  NamedValueSet
 {
@@ -169,7 +172,12 @@ public:
 
 private:
     //==============================================================================
+    struct Index;
+
     Array<NamedValue> values;
+    ScopedPointer<Index> nameIndex;
+
+    void updateIndex();
 };
 
 } // namespace juce
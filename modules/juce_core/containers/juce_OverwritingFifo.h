@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A single-reader, single-writer FIFO which overwrites its oldest items when it
+    is full, so that the writer never fails and never waits.
+
+    This is meant for things like telemetry and metering, where a real-time thread
+    must be able to publish data whatever the reader is doing, and losing old data
+    is better than losing new data. Each slot has a sequence number, so that the reader
+    can tell when an item has been overwritten while it was copying it, in which case
+    the item is skipped and counted in getNumDropped().
+
+    The items are copied without any locking, so ElementType must be a trivially
+    copyable type, e.g. a number or a POD struct.
+
+    @see LockFreeFifo, AbstractFifo
+*/
+template <typename ElementType>
+class OverwritingFifo
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO which keeps at least the given number of the latest items. The
+        capacity is rounded up to a power of two.
+    */
+    explicit OverwritingFifo (int minimumCapacity)
+        : mask ((uint32) nextPowerOfTwo (jmax (2, minimumCapacity)) - 1)
+    {
+        slots.resize ((int) mask + 1);
+        reset();
+    }
+
+    //==============================================================================
+    /** Returns the maximum number of items that the FIFO can hold. */
+    int getCapacity() const noexcept        { return (int) mask + 1; }
+
+    /** Returns the number of items which the reader has missed because the writer
+        overwrote them before they could be read.
+    */
+    uint32 getNumDropped() const noexcept   { return numDropped; }
+
+    /** Removes all the items from the FIFO and resets the dropped item count.
+        Note that this isn't thread-safe, so don't call it if there's any danger that it
+        might overlap with a call to push() or pop()!
+    */
+    void reset() noexcept
+    {
+        for (int i = 0; i < slots.size(); ++i)
+            slots.getReference (i).sequence = 0;
+
+        writeCount = 0;
+        readCount = 0;
+        numDropped = 0;
+    }
+
+    //==============================================================================
+    /** Adds an item, overwriting the oldest one if the FIFO is full.
+        This must only be called by the writer thread.
+    */
+    void push (const ElementType& item) noexcept
+    {
+        auto count = writeCount.get();
+        auto& slot = slots.getReference ((int) (count & mask));
+
+        // an odd sequence number means that the slot is being written
+        slot.sequence = 2 * count + 1;
+        slot.item = item;
+        slot.sequence = 2 * count + 2;
+
+        writeCount = count + 1;
+    }
+
+    /** Removes the oldest item that hasn't been overwritten, returning false if
+        there aren't any. This must only be called by the reader thread.
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        for (;;)
+        {
+            auto written = writeCount.get();
+
+            if (readCount == written)
+                return false;
+
+            if (written - readCount > mask + 1)
+            {
+                numDropped += written - readCount - (mask + 1);
+                readCount = written - (mask + 1);
+            }
+
+            auto& slot = slots.getReference ((int) (readCount & mask));
+            auto expectedSequence = 2 * readCount + 2;
+
+            if (slot.sequence.get() == expectedSequence)
+            {
+                result = slot.item;
+                slot.sequence.memoryBarrier();
+
+                if (slot.sequence.get() == expectedSequence)
+                {
+                    ++readCount;
+                    return true;
+                }
+            }
+
+            // the writer has lapped us while we were reading this slot
+            ++readCount;
+            ++numDropped;
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        Atomic<uint32> sequence;
+        ElementType item;
+    };
+
+    const uint32 mask;
+    Array<Slot> slots;
+    Atomic<uint32> writeCount;
+    uint32 readCount = 0, numDropped = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (OverwritingFifo)
+};
+
+} // namespace juce
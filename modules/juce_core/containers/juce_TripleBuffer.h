@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free way of sharing the latest state of some data between a single
+    writer thread and a single reader thread, e.g. between an audio callback and
+    the paint() method of a visualiser.
+
+    The class holds three frames of data, which are swapped instead of being copied.
+    The writer always has a frame of its own to fill in with getWriteFrame(), and
+    hands it over with publish(). The reader calls acquireLatest() to take the most
+    recently published frame, which it then owns and can use until its next call to
+    acquireLatest(). Neither side can ever block the other one, and if the writer
+    publishes several frames before the reader acquires one, only the latest is kept.
+
+    The frames can be of any type, e.g. fixed size POD structs or AudioBuffers. They
+    are all created as copies of the same initial frame, so that any buffers they
+    contain are allocated once, on the thread which creates the TripleBuffer.
+
+    e.g.
+    @code
+    // audio thread
+    auto& frame = tripleBuffer.getWriteFrame();
+    frame.makeCopyOf (audioBuffer, true);
+    tripleBuffer.publish();
+
+    // message thread
+    if (tripleBuffer.acquireLatest())
+        drawWaveform (tripleBuffer.getReadFrame());
+    @endcode
+
+    @see AbstractFifo
+*/
+template <typename FrameType>
+class TripleBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a TripleBuffer with three default-constructed frames. */
+    TripleBuffer()  : TripleBuffer (FrameType()) {}
+
+    /** Creates a TripleBuffer with three copies of the given frame. */
+    explicit TripleBuffer (const FrameType& initialFrame)
+        : frames { initialFrame, initialFrame, initialFrame }
+    {
+    }
+
+    /** Replaces all the frames with copies of the given one, and forgets about any
+        frames that have been published but not acquired.
+
+        Note that this isn't thread-safe, so don't call it if there's any danger that it
+        might overlap with a call to any other method in this class!
+    */
+    void reset (const FrameType& initialFrame)
+    {
+        for (auto& frame : frames)
+            frame = initialFrame;
+
+        writeIndex = 0;
+        readIndex = 1;
+        middle = 2;
+    }
+
+    //==============================================================================
+    /** Returns the frame that the writer thread can currently fill in.
+        Its content is whatever was in this frame the last time it was used, so you'll
+        need to overwrite all of it before calling publish().
+    */
+    FrameType& getWriteFrame() noexcept             { return frames[writeIndex]; }
+
+    /** Makes the frame returned by getWriteFrame() available to the reader thread,
+        and gives the writer a new frame to fill in.
+    */
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange (writeIndex | newFrameFlag) & indexMask;
+    }
+
+    //==============================================================================
+    /** Returns true if a frame has been published since the last call to acquireLatest(). */
+    bool hasNewFrame() const noexcept               { return (middle.get() & newFrameFlag) != 0; }
+
+    /** If a new frame has been published, this makes it the one returned by
+        getReadFrame() and returns true. Otherwise it returns false, and getReadFrame()
+        keeps returning the previous frame.
+    */
+    bool acquireLatest() noexcept
+    {
+        if (! hasNewFrame())
+            return false;
+
+        readIndex = middle.exchange (readIndex) & indexMask;
+        return true;
+    }
+
+    /** Returns the frame that was returned by the last call to acquireLatest().
+        The reader thread owns this frame until it calls acquireLatest() again, so the
+        non-const version can be used to process the data in place.
+    */
+    const FrameType& getReadFrame() const noexcept  { return frames[readIndex]; }
+
+    /** Returns the frame that was returned by the last call to acquireLatest(). */
+    FrameType& getReadFrame() noexcept              { return frames[readIndex]; }
+
+private:
+    //==============================================================================
+    enum { indexMask = 3, newFrameFlag = 4 };
+
+    FrameType frames[3];
+    int writeIndex = 0, readIndex = 1;
+    Atomic<int> middle { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
+
+} // namespace juce
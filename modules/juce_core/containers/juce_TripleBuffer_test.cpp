@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TripleBufferTest  : public UnitTest
+{
+    TripleBufferTest() : UnitTest ("TripleBuffer", "Containers") {}
+
+    struct Frame
+    {
+        int values[64];
+    };
+
+    class WriteThread  : public Thread
+    {
+    public:
+        WriteThread (TripleBuffer<Frame>& b)  : Thread ("triple buffer writer"), buffer (b)
+        {
+            startThread();
+        }
+
+        ~WriteThread()
+        {
+            stopThread (5000);
+        }
+
+        void run() override
+        {
+            int n = 0;
+
+            while (! threadShouldExit())
+            {
+                ++n;
+
+                for (auto& v : buffer.getWriteFrame().values)
+                    v = n;
+
+                buffer.publish();
+            }
+        }
+
+    private:
+        TripleBuffer<Frame>& buffer;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Single thread");
+        {
+            TripleBuffer<int> buffer (0);
+
+            expect (! buffer.hasNewFrame());
+            expect (! buffer.acquireLatest());
+            expectEquals (buffer.getReadFrame(), 0);
+
+            buffer.getWriteFrame() = 1;
+            buffer.publish();
+            buffer.getWriteFrame() = 2;
+            buffer.publish();
+
+            expect (buffer.hasNewFrame());
+            expect (buffer.acquireLatest());
+            expectEquals (buffer.getReadFrame(), 2);
+            expect (! buffer.acquireLatest());
+            expectEquals (buffer.getReadFrame(), 2);
+
+            buffer.getWriteFrame() = 3;
+            buffer.publish();
+
+            expect (buffer.acquireLatest());
+            expectEquals (buffer.getReadFrame(), 3);
+
+            buffer.reset (7);
+            expect (! buffer.acquireLatest());
+            expectEquals (buffer.getReadFrame(), 7);
+        }
+
+        beginTest ("Concurrent writer");
+        {
+            TripleBuffer<Frame> buffer;
+
+            for (auto& v : buffer.getReadFrame().values)
+                v = 0;
+
+            WriteThread writer (buffer);
+
+            int lastValue = 0;
+            bool framesAreConsistent = true, valuesIncrease = true;
+
+            for (int count = 100000; --count >= 0;)
+            {
+                if (buffer.acquireLatest())
+                {
+                    auto& frame = buffer.getReadFrame();
+                    auto value = frame.values[0];
+
+                    for (auto v : frame.values)
+                        framesAreConsistent = framesAreConsistent && (v == value);
+
+                    valuesIncrease = valuesIncrease && (value > lastValue);
+                    lastValue = value;
+                }
+            }
+
+            expect (framesAreConsistent);
+            expect (valuesIncrease);
+        }
+    }
+};
+
+static TripleBufferTest tripleBufferTest;
+
+} // namespace juce
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MappedInputStream::MappedInputStream (const File& f)  : file (f)
+{
+    if (file.existsAsFile())
+    {
+        if (file.getSize() == 0)
+        {
+            // an empty file can't be mapped, but there's nothing to read from it anyway
+            ok = true;
+        }
+        else
+        {
+            mappedFile = new MemoryMappedFile (file, MemoryMappedFile::readOnly);
+            data = static_cast<const char*> (mappedFile->getData());
+
+            if (data != nullptr)
+            {
+                dataSize = mappedFile->getSize();
+                ok = true;
+            }
+        }
+    }
+}
+
+MappedInputStream::~MappedInputStream()
+{
+}
+
+int64 MappedInputStream::getTotalLength()
+{
+    return (int64) dataSize;
+}
+
+int MappedInputStream::read (void* buffer, int howMany)
+{
+    // The buffer should never be null, and a negative size is probably a
+    // sign that something is broken!
+    jassert (buffer != nullptr && howMany >= 0);
+
+    auto num = jmin ((size_t) jmax (0, howMany), dataSize - position);
+
+    if (num > 0)
+    {
+        memcpy (buffer, data + position, num);
+        position += num;
+    }
+
+    return (int) num;
+}
+
+bool MappedInputStream::isExhausted()
+{
+    return position >= dataSize;
+}
+
+int64 MappedInputStream::getPosition()
+{
+    return (int64) position;
+}
+
+bool MappedInputStream::setPosition (int64 pos)
+{
+    position = (size_t) jlimit ((int64) 0, (int64) dataSize, pos);
+    return true;
+}
+
+void MappedInputStream::skipNextBytes (int64 numBytesToSkip)
+{
+    if (numBytesToSkip > 0)
+        setPosition (getPosition() + numBytesToSkip);
+}
+
+const void* MappedInputStream::getDirectView (size_t& numBytesAvailable)
+{
+    numBytesAvailable = dataSize - position;
+
+    // an empty file has no mapping, so this returns a dummy pointer rather than
+    // nullptr, which would make the caller think it had to read the stream instead
+    return data != nullptr ? data + position : "";
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MappedInputStreamTests  : public UnitTest
+{
+public:
+    MappedInputStreamTests() : UnitTest ("MappedInputStream", "Streams") {}
+
+    void runTest() override
+    {
+        auto tempFile = File::createTempFile (".bin");
+
+        MemoryBlock data (50000);
+        getRandom().fillBitsRandomly (data.getData(), data.getSize());
+        tempFile.replaceWithData (data.getData(), data.getSize());
+
+        beginTest ("Reading");
+        {
+            MappedInputStream in (tempFile);
+            expect (in.openedOk());
+            expectEquals (in.getTotalLength(), (int64) data.getSize());
+
+            MemoryBlock result;
+            HeapBlock<char> buffer (777);
+
+            for (;;)
+            {
+                auto num = in.read (buffer, 777);
+
+                if (num <= 0)
+                    break;
+
+                result.append (buffer, (size_t) num);
+            }
+
+            expect (in.isExhausted());
+            expect (result == data);
+        }
+
+        beginTest ("Seeking and direct views");
+        {
+            MappedInputStream in (tempFile);
+
+            expect (in.setPosition (1234));
+            size_t numAvailable = 0;
+            auto* view = in.getDirectView (numAvailable);
+
+            expect (view != nullptr);
+            expectEquals ((int) numAvailable, (int) data.getSize() - 1234);
+            expect (memcmp (view, addBytesToPointer (data.getData(), 1234), numAvailable) == 0);
+            expectEquals (in.getPosition(), (int64) 1234);
+
+            in.skipNextBytes (100000);
+            expect (in.isExhausted());
+
+            in.setPosition (0);
+            MemoryBlock block;
+            expectEquals ((int) in.readIntoMemoryBlock (block, 100), 100);
+            expect (memcmp (block.getData(), data.getData(), 100) == 0);
+            expectEquals (in.getPosition(), (int64) 100);
+        }
+
+        beginTest ("Empty and missing files");
+        {
+            tempFile.replaceWithText ({});
+            MappedInputStream empty (tempFile);
+            expect (empty.openedOk());
+            expect (empty.isExhausted());
+            expect (empty.readEntireStreamAsString().isEmpty());
+
+            tempFile.deleteFile();
+            MappedInputStream missing (tempFile);
+            expect (missing.failedToOpen());
+        }
+
+        beginTest ("XML parsing from a mapped file");
+        {
+            tempFile.replaceWithText ("<?xml version=\"1.0\"?><root a=\"1\"><child/></root>");
+
+            XmlDocument doc (tempFile);
+            ScopedPointer<XmlElement> xml (doc.getDocumentElement());
+            expect (xml != nullptr && xml->hasTagName ("root") && xml->getIntAttribute ("a") == 1);
+
+            MappedInputStream in (tempFile);
+            expectEquals (in.readEntireStreamAsString(), tempFile.loadFileAsString());
+        }
+
+        tempFile.deleteFile();
+    }
+};
+
+static MappedInputStreamTests mappedInputStreamTests;
+
+#endif
+
+} // namespace juce
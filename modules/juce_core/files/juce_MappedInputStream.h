@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An input stream that reads from a local file by memory-mapping it.
+
+    Because the whole file is mapped, getDirectView() can return a pointer to the
+    file's contents, so things like XmlDocument and InputStream::readEntireStreamAsString()
+    can use the data without first copying it into a buffer. The OS will page the
+    data in lazily as it's touched, so opening even a very large file is cheap.
+
+    The file shouldn't be modified or truncated while this stream is open - see the
+    notes in MemoryMappedFile about that.
+
+    @see FileInputStream, MemoryMappedFile, InputStream::getDirectView
+*/
+class JUCE_API  MappedInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a MappedInputStream to read from the given file.
+
+        After creating one, you should use openedOk() to make sure that it's OK
+        before trying to read from it!
+    */
+    explicit MappedInputStream (const File& fileToRead);
+
+    /** Destructor. */
+    ~MappedInputStream();
+
+    //==============================================================================
+    /** Returns the file that this stream is reading from. */
+    const File& getFile() const noexcept                { return file; }
+
+    /** Returns true if the file was mapped successfully (or is an empty file). */
+    bool openedOk() const noexcept                      { return ok; }
+
+    /** Returns true if the file couldn't be mapped for some reason. */
+    bool failedToOpen() const noexcept                  { return ! ok; }
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    int read (void*, int) override;
+    bool isExhausted() override;
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    void skipNextBytes (int64) override;
+    const void* getDirectView (size_t& numBytesAvailable) override;
+
+private:
+    //==============================================================================
+    const File file;
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    const char* data = nullptr;
+    size_t dataSize = 0, position = 0;
+    bool ok = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedInputStream)
+};
+
+} // namespace juce
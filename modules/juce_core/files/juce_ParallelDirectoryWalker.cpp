@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The walk is shared with the pool jobs, because a job may not get started until
+// after the search has finished and walk() has returned.
+struct ParallelDirectoryWalker::Walk
+{
+    Walk (const String& wildCardPattern, int typeFlags,
+          const FileCallback& fileCallback, const DirectoryFilter& directoryFilter)
+        : whatToLookFor (typeFlags), callback (fileCallback), shouldEnterDirectory (directoryFilter)
+    {
+        wildCards.addTokens (wildCardPattern, ";,", "\"'");
+        wildCards.trim();
+        wildCards.removeEmptyStrings();
+
+        matchesEverything = wildCards.isEmpty() || (wildCards.size() == 1 && wildCards[0] == "*");
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            File directory;
+
+            {
+                const ScopedLock sl (lock);
+
+                if (finished)
+                    return;
+
+                if (numDirectoriesInProgress == 0 && (cancelled || pendingDirectories.isEmpty()))
+                {
+                    finished = true;
+                    workAvailable.signal();
+                    return;
+                }
+
+                if (! cancelled && ! pendingDirectories.isEmpty())
+                {
+                    directory = pendingDirectories.removeAndReturn (pendingDirectories.size() - 1);
+                    ++numDirectoriesInProgress;
+                }
+            }
+
+            if (directory == File())
+            {
+                // another thread is still reading a directory, which may add more work
+                workAvailable.wait (5);
+                continue;
+            }
+
+            Array<File> subDirectories;
+            scanDirectory (directory, subDirectories);
+
+            {
+                const ScopedLock sl (lock);
+                pendingDirectories.addArray (subDirectories);
+                --numDirectoriesInProgress;
+            }
+
+            workAvailable.signal();
+        }
+    }
+
+    void scanDirectory (const File& directory, Array<File>& subDirectories)
+    {
+        DirectoryIterator iter (directory, false, "*", File::findFilesAndDirectories | (whatToLookFor & File::ignoreHiddenFiles));
+        FoundFile found;
+
+        while (! cancelled
+                && iter.next (&found.isDirectory, &found.isHidden, &found.fileSize,
+                              &found.modificationTime, &found.creationTime, &found.isReadOnly))
+        {
+            found.file = iter.getFile();
+
+            if (found.isDirectory && (shouldEnterDirectory == nullptr || shouldEnterDirectory (found.file)))
+                subDirectories.add (found.file);
+
+            if ((whatToLookFor & (found.isDirectory ? File::findDirectories : File::findFiles)) != 0
+                  && matchesWildCard (found.file.getFileName())
+                  && ! callback (found))
+                cancelled = true;
+        }
+    }
+
+    bool matchesWildCard (const String& filename) const
+    {
+        if (matchesEverything)
+            return true;
+
+        for (auto& w : wildCards)
+            if (filename.matchesWildcard (w, ! File::areFileNamesCaseSensitive()))
+                return true;
+
+        return false;
+    }
+
+    const int whatToLookFor;
+    const FileCallback callback;
+    const DirectoryFilter shouldEnterDirectory;
+    StringArray wildCards;
+    bool matchesEverything;
+
+    CriticalSection lock;
+    Array<File> pendingDirectories;
+    int numDirectoriesInProgress = 0;
+    bool finished = false;
+    std::atomic<bool> cancelled { false };
+    WaitableEvent workAvailable;
+
+    JUCE_DECLARE_NON_COPYABLE (Walk)
+};
+
+//==============================================================================
+bool ParallelDirectoryWalker::walk (ThreadPool& pool, const File& directory, const String& wildCard,
+                                    int whatToLookFor, const FileCallback& callback,
+                                    const DirectoryFilter& shouldEnterDirectory)
+{
+    // you have to specify the type of files you're looking for!
+    jassert ((whatToLookFor & (File::findFiles | File::findDirectories)) != 0);
+    jassert (callback != nullptr);
+
+    if (! directory.isDirectory())
+        return true;
+
+    auto w = std::make_shared<Walk> (wildCard, whatToLookFor, callback, shouldEnterDirectory);
+    w->pendingDirectories.add (directory);
+
+    for (int i = pool.getNumThreads(); --i >= 0;)
+        pool.addJob ([w] { w->run(); });
+
+    w->run();
+
+    return ! w->cancelled;
+}
+
+Array<File> ParallelDirectoryWalker::findChildFiles (ThreadPool& pool, const File& directory,
+                                                     int whatToLookFor, const String& wildCard)
+{
+    CriticalSection resultsLock;
+    Array<File> results;
+
+    walk (pool, directory, wildCard, whatToLookFor, [&] (const FoundFile& f)
+    {
+        const ScopedLock sl (resultsLock);
+        results.add (f.file);
+        return true;
+    });
+
+    results.sort();
+    return results;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelDirectoryWalkerTests  : public UnitTest
+{
+public:
+    ParallelDirectoryWalkerTests() : UnitTest ("ParallelDirectoryWalker", "Files") {}
+
+    void runTest() override
+    {
+        auto root = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("ParallelDirectoryWalkerTest", {}, false);
+        root.createDirectory();
+
+        for (int i = 0; i < 8; ++i)
+        {
+            auto dir = root.getChildFile ("dir" + String (i));
+
+            for (int j = 0; j < 8; ++j)
+            {
+                auto sub = dir.getChildFile ("sub" + String (j));
+                sub.createDirectory();
+
+                for (int k = 0; k < 5; ++k)
+                    sub.getChildFile ("file" + String (k) + (k % 2 == 0 ? ".txt" : ".dat")).replaceWithText ("x");
+            }
+        }
+
+        ThreadPool pool (4);
+
+        beginTest ("Finds the same files as File::findChildFiles");
+        {
+            for (auto type : { (int) File::findFiles, (int) File::findDirectories, (int) File::findFilesAndDirectories })
+            {
+                for (auto wildCard : { "*", "*.txt", "*.txt;*.dat", "sub3" })
+                {
+                    Array<File> expected;
+                    root.findChildFiles (expected, type, true, wildCard);
+                    expected.sort();
+
+                    expect (ParallelDirectoryWalker::findChildFiles (pool, root, type, wildCard) == expected);
+                }
+            }
+        }
+
+        beginTest ("Directory filter");
+        {
+            auto files = ParallelDirectoryWalker::findChildFiles (pool, root, File::findFiles);
+            Atomic<int> count;
+
+            ParallelDirectoryWalker::walk (pool, root, "*", File::findFiles,
+                                           [&] (const ParallelDirectoryWalker::FoundFile& f)
+                                           {
+                                               expect (! f.isDirectory);
+                                               expectEquals (f.fileSize, (int64) 1);
+                                               ++count;
+                                               return true;
+                                           },
+                                           [] (const File& dir) { return dir.getFileName() != "dir0"; });
+
+            expectEquals (count.get(), files.size() - 8 * 5);
+        }
+
+        beginTest ("Cancelling");
+        {
+            Atomic<int> count;
+
+            auto completed = ParallelDirectoryWalker::walk (pool, root, "*", File::findFiles,
+                                                            [&] (const ParallelDirectoryWalker::FoundFile&)
+                                                            {
+                                                                return ++count < 10;
+                                                            });
+
+            expect (! completed);
+            expect (count.get() < 8 * 8 * 5);
+        }
+
+        root.deleteRecursively();
+    }
+};
+
+static ParallelDirectoryWalkerTests parallelDirectoryWalkerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Recursively searches a directory tree, using the threads of a ThreadPool to
+    scan several sub-directories at once.
+
+    A recursive DirectoryIterator reads one directory at a time on the calling thread,
+    which leaves most of the machine idle when a big tree is being indexed, particularly
+    on network drives or SSDs where the latency of each directory read dominates.
+    This class keeps a queue of directories that still need to be read, and the pool's
+    threads and the calling thread all take directories from it, adding any
+    sub-directories they find back onto the queue.
+
+    E.g.
+    @code
+    ThreadPool pool;
+
+    ParallelDirectoryWalker::walk (pool, File ("/samples"), "*.wav;*.aif", File::findFiles,
+                                   [&] (const ParallelDirectoryWalker::FoundFile& f)
+                                   {
+                                       addToIndex (f.file, f.fileSize);  // (must be thread-safe!)
+                                       return ! userHasPressedCancel();
+                                   });
+    @endcode
+
+    As with DirectoryIterator, the order in which the files are found is undefined,
+    and here it will also vary from one run to the next.
+
+    @see DirectoryIterator, File::findChildFiles, ThreadPool
+*/
+class JUCE_API  ParallelDirectoryWalker  final
+{
+public:
+    //==============================================================================
+    /** The details of a file that was found by the walker.
+        These are all read by the same OS call that found the file, so looking at
+        them doesn't involve any further file-system access.
+    */
+    struct FoundFile
+    {
+        File file;
+        int64 fileSize;
+        Time modificationTime, creationTime;
+        bool isDirectory, isHidden, isReadOnly;
+    };
+
+    /** Called for each matching file or directory.
+        This will be called on several threads at once, so it must be thread-safe.
+        Return false to stop the search.
+    */
+    using FileCallback = std::function<bool (const FoundFile&)>;
+
+    /** Called for each sub-directory before it's searched.
+        This will be called on several threads at once, so it must be thread-safe.
+        Return false to skip the directory and everything inside it.
+    */
+    using DirectoryFilter = std::function<bool (const File&)>;
+
+    //==============================================================================
+    /** Searches a directory and all its sub-directories.
+
+        The calling thread does its share of the work, and this method won't return
+        until the whole tree has been searched, or the callback has asked it to stop.
+        Because the calling thread takes part, it's safe to call this from one of the
+        pool's own jobs, or with a pool that's already busy.
+
+        @param pool                 the pool whose threads should help with the search
+        @param directory            the directory to search
+        @param wildCard             the file pattern to match. This may contain multiple patterns
+                                    separated by a semi-colon or comma, e.g. "*.jpg;*.png".
+                                    Sub-directories are searched whether or not they match it.
+        @param whatToLookFor        a value from the File::TypesOfFileToFind enum. If it contains
+                                    File::ignoreHiddenFiles, hidden directories won't be searched
+        @param callback             called for each file or directory that's found
+        @param shouldEnterDirectory an optional filter that can stop particular
+                                    sub-directories from being searched
+        @returns true if the whole tree was searched, or false if the callback stopped it
+    */
+    static bool walk (ThreadPool& pool,
+                      const File& directory,
+                      const String& wildCard,
+                      int whatToLookFor,
+                      const FileCallback& callback,
+                      const DirectoryFilter& shouldEnterDirectory = nullptr);
+
+    /** Returns all the files in a directory and its sub-directories.
+
+        This is a parallel version of File::findChildFiles() with searchRecursively set
+        to true. The results are sorted, so they're the same each time.
+    */
+    static Array<File> findChildFiles (ThreadPool& pool,
+                                       const File& directory,
+                                       int whatToLookFor,
+                                       const String& wildCard = "*");
+
+private:
+    //==============================================================================
+    struct Walk;
+
+    ParallelDirectoryWalker() = delete;
+};
+
+} // namespace juce
@@ -25,297 +25,113 @@ namespace juce
 
 struct JSONParser
 {
-    static Result parseObjectOrArray (String::CharPointerType t, var& result)
+    static Result parseObjectOrArray (JSONReader& reader, var& result)
     {
-        t = t.findEndOfWhitespace();
-
-        switch (t.getAndAdvance())
+        switch (reader.next())
         {
-            case 0:      result = var(); return Result::ok();
-            case '{':    return parseObject (t, result);
-            case '[':    return parseArray  (t, result);
+            case JSONReader::endOfDocument:  result = var(); return Result::ok();
+            case JSONReader::objectStart:    return parseObject (reader, result);
+            case JSONReader::arrayStart:     return parseArray  (reader, result);
+            case JSONReader::parseError:     return reader.getResult();
+            default:                         break;
         }
 
-        return createFail ("Expected '{' or '['", &t);
+        reader.fail ("Expected '{' or '['", reader.tokenStart);
+        return reader.getResult();
     }
 
-    static Result parseString (const juce_wchar quoteChar, String::CharPointerType& t, var& result)
+    static Result parseAny (JSONReader& reader, var& result)
     {
-        MemoryOutputStream buffer (256);
-
-        for (;;)
-        {
-            auto c = t.getAndAdvance();
-
-            if (c == quoteChar)
-                break;
-
-            if (c == '\\')
-            {
-                c = t.getAndAdvance();
-
-                switch (c)
-                {
-                    case '"':
-                    case '\'':
-                    case '\\':
-                    case '/':  break;
-
-                    case 'a':  c = '\a'; break;
-                    case 'b':  c = '\b'; break;
-                    case 'f':  c = '\f'; break;
-                    case 'n':  c = '\n'; break;
-                    case 'r':  c = '\r'; break;
-                    case 't':  c = '\t'; break;
-
-                    case 'u':
-                    {
-                        c = 0;
-
-                        for (int i = 4; --i >= 0;)
-                        {
-                            auto digitValue = CharacterFunctions::getHexDigitValue (t.getAndAdvance());
-
-                            if (digitValue < 0)
-                                return createFail ("Syntax error in unicode escape sequence");
-
-                            c = (juce_wchar) ((c << 4) + static_cast<juce_wchar> (digitValue));
-                        }
-
-                        break;
-                    }
-                }
-            }
-
-            if (c == 0)
-                return createFail ("Unexpected end-of-input in string constant");
-
-            buffer.appendUTF8Char (c);
-        }
-
-        result = buffer.toUTF8();
-        return Result::ok();
-    }
-
-    static Result parseAny (String::CharPointerType& t, var& result)
-    {
-        t = t.findEndOfWhitespace();
-        auto t2 = t;
-
-        switch (t2.getAndAdvance())
-        {
-            case '{':    t = t2; return parseObject (t, result);
-            case '[':    t = t2; return parseArray  (t, result);
-            case '"':    t = t2; return parseString ('"',  t, result);
-            case '\'':   t = t2; return parseString ('\'', t, result);
-
-            case '-':
-                t2 = t2.findEndOfWhitespace();
-                if (! CharacterFunctions::isDigit (*t2))
-                    break;
-
-                t = t2;
-                return parseNumber (t, result, true);
-
-            case '0': case '1': case '2': case '3': case '4':
-            case '5': case '6': case '7': case '8': case '9':
-                return parseNumber (t, result, false);
-
-            case 't':   // "true"
-                if (t2.getAndAdvance() == 'r' && t2.getAndAdvance() == 'u' && t2.getAndAdvance() == 'e')
-                {
-                    t = t2;
-                    result = var (true);
-                    return Result::ok();
-                }
-                break;
-
-            case 'f':   // "false"
-                if (t2.getAndAdvance() == 'a' && t2.getAndAdvance() == 'l'
-                      && t2.getAndAdvance() == 's' && t2.getAndAdvance() == 'e')
-                {
-                    t = t2;
-                    result = var (false);
-                    return Result::ok();
-                }
-                break;
-
-            case 'n':   // "null"
-                if (t2.getAndAdvance() == 'u' && t2.getAndAdvance() == 'l' && t2.getAndAdvance() == 'l')
-                {
-                    t = t2;
-                    result = var();
-                    return Result::ok();
-                }
-                break;
-
-            default:
-                break;
-        }
-
-        return createFail ("Syntax error", &t);
+        reader.next();
+        return parseValue (reader, result);
     }
 
 private:
-    static Result createFail (const char* const message, const String::CharPointerType* location = nullptr)
+    static Result parseValue (JSONReader& reader, var& result)
     {
-        String m (message);
-        if (location != nullptr)
-            m << ": \"" << String (*location, 20) << '"';
-
-        return Result::fail (m);
-    }
-
-    static Result parseNumber (String::CharPointerType& t, var& result, const bool isNegative)
-    {
-        auto oldT = t;
-
-        int64 intValue = t.getAndAdvance() - '0';
-        jassert (intValue >= 0 && intValue < 10);
-
-        for (;;)
+        switch (reader.getTokenType())
         {
-            auto previousChar = t;
-            auto c = t.getAndAdvance();
-            auto digit = ((int) c) - '0';
+            case JSONReader::objectStart:  return parseObject (reader, result);
+            case JSONReader::arrayStart:   return parseArray  (reader, result);
+            case JSONReader::stringValue:  result = reader.getString(); break;
+            case JSONReader::boolValue:    result = var (reader.getBoolValue()); break;
+            case JSONReader::nullValue:    result = var(); break;
 
-            if (isPositiveAndBelow (digit, 10))
+            case JSONReader::numberValue:
             {
-                intValue = intValue * 10 + digit;
-                continue;
-            }
+                auto intValue = reader.getIntValue();
 
-            if (c == 'e' || c == 'E' || c == '.')
-            {
-                t = oldT;
-                auto asDouble = CharacterFunctions::readDoubleValue (t);
-                result = isNegative ? -asDouble : asDouble;
-                return Result::ok();
-            }
+                if (! reader.isInteger())
+                    result = reader.getDoubleValue();
+                else if (intValue >= -0x7fffffff && intValue <= 0x7fffffff)
+                    result = (int) intValue;
+                else
+                    result = intValue;
 
-            if (CharacterFunctions::isWhitespace (c)
-                 || c == ',' || c == '}' || c == ']' || c == 0)
-            {
-                t = previousChar;
                 break;
             }
 
-            return createFail ("Syntax error in number", &oldT);
-        }
-
-        auto correctedValue = isNegative ? -intValue : intValue;
+            case JSONReader::endOfDocument:
+                reader.fail ("Syntax error", reader.tokenStart);
+                return reader.getResult();
 
-        if ((intValue >> 31) != 0)
-            result = correctedValue;
-        else
-            result = (int) correctedValue;
+            case JSONReader::objectEnd:
+            case JSONReader::arrayEnd:
+            case JSONReader::propertyName:
+            case JSONReader::parseError:
+            default:
+                return reader.getResult();
+        }
 
         return Result::ok();
     }
 
-    static Result parseObject (String::CharPointerType& t, var& result)
+    static Result parseObject (JSONReader& reader, var& result)
     {
         auto resultObject = new DynamicObject();
         result = resultObject;
         auto& resultProperties = resultObject->getProperties();
 
-        for (;;)
+        while (reader.next() == JSONReader::propertyName)
         {
-            t = t.findEndOfWhitespace();
-
-            auto oldT = t;
-            auto c = t.getAndAdvance();
-
-            if (c == '}')
-                break;
-
-            if (c == 0)
-                return createFail ("Unexpected end-of-input in object declaration");
+            const Identifier propertyName (reader.getString());
 
-            if (c == '"')
+            if (! propertyName.isValid())
             {
-                var propertyNameVar;
-                auto r = parseString ('"', t, propertyNameVar);
-
-                if (r.failed())
-                    return r;
-
-                const Identifier propertyName (propertyNameVar.toString());
-
-                if (propertyName.isValid())
-                {
-                    t = t.findEndOfWhitespace();
-                    oldT = t;
-
-                    auto c2 = t.getAndAdvance();
-
-                    if (c2 != ':')
-                        return createFail ("Expected ':', but found", &oldT);
-
-                    resultProperties.set (propertyName, var());
-                    var* propertyValue = resultProperties.getVarPointer (propertyName);
-
-                    auto r2 = parseAny (t, *propertyValue);
-
-                    if (r2.failed())
-                        return r2;
-
-                    t = t.findEndOfWhitespace();
-                    oldT = t;
-
-                    auto nextChar = t.getAndAdvance();
-
-                    if (nextChar == ',')
-                        continue;
-
-                    if (nextChar == '}')
-                        break;
-                }
+                reader.fail ("Expected object member declaration, but found", reader.getRawValue().start - 1);
+                return reader.getResult();
             }
 
-            return createFail ("Expected object member declaration, but found", &oldT);
+            resultProperties.set (propertyName, var());
+            auto r = parseAny (reader, *resultProperties.getVarPointer (propertyName));
+
+            if (r.failed())
+                return r;
         }
 
-        return Result::ok();
+        return reader.getResult();
     }
 
-    static Result parseArray (String::CharPointerType& t, var& result)
+    static Result parseArray (JSONReader& reader, var& result)
     {
         result = var (Array<var>());
         auto* destArray = result.getArray();
 
         for (;;)
         {
-            t = t.findEndOfWhitespace();
+            auto type = reader.next();
 
-            auto oldT = t;
-            auto c = t.getAndAdvance();
-
-            if (c == ']')
+            if (type == JSONReader::arrayEnd)
                 break;
 
-            if (c == 0)
-                return createFail ("Unexpected end-of-input in array declaration");
+            if (type == JSONReader::parseError)
+                return reader.getResult();
 
-            t = oldT;
             destArray->add (var());
-            auto r = parseAny (t, destArray->getReference (destArray->size() - 1));
+            auto r = parseValue (reader, destArray->getReference (destArray->size() - 1));
 
             if (r.failed())
                 return r;
-
-            t = t.findEndOfWhitespace();
-            oldT = t;
-
-            auto nextChar = t.getAndAdvance();
-
-            if (nextChar == ',')
-                continue;
-
-            if (nextChar == ']')
-                break;
-
-            return createFail ("Expected object array item, but found", &oldT);
         }
 
         return Result::ok();
@@ -375,10 +191,30 @@ struct JSONFormatter
         out << "\\u" << String::toHexString ((int) value).paddedLeft ('0', 4);
     }
 
+    static bool isPlainChar (juce_wchar c) noexcept
+    {
+        return c >= 32 && c < 127 && c != '\"' && c != '\\';
+    }
+
     static void writeString (OutputStream& out, String::CharPointerType t)
     {
         for (;;)
         {
+           #if JUCE_STRING_UTF_TYPE == 8
+            // write any runs of characters that don't need escaping in one go..
+            auto* runStart = t.getAddress();
+            auto* runEnd = runStart;
+
+            while (isPlainChar ((juce_wchar) (uint8) *runEnd))
+                ++runEnd;
+
+            if (runEnd != runStart)
+            {
+                out.write (runStart, (size_t) (runEnd - runStart));
+                t = String::CharPointerType (runEnd);
+            }
+           #endif
+
             auto c = t.getAndAdvance();
 
             switch (c)
@@ -477,9 +313,10 @@ var JSON::parse (const String& text)
 
 var JSON::fromString (StringRef text)
 {
+    JSONReader reader (String (text.text));
     var result;
 
-    if (! JSONParser::parseAny (text.text, result))
+    if (! JSONParser::parseAny (reader, result))
         result = var();
 
     return result;
@@ -487,29 +324,42 @@ var JSON::fromString (StringRef text)
 
 var JSON::parse (InputStream& input)
 {
-    return parse (input.readEntireStreamAsString());
+    JSONReader reader (input);
+    var result;
+
+    if (! JSONParser::parseObjectOrArray (reader, result))
+        result = var();
+
+    return result;
 }
 
 var JSON::parse (const File& file)
 {
-    return parse (file.loadFileAsString());
+    JSONReader reader (file);
+    var result;
+
+    if (! JSONParser::parseObjectOrArray (reader, result))
+        result = var();
+
+    return result;
 }
 
 Result JSON::parse (const String& text, var& result)
 {
-    return JSONParser::parseObjectOrArray (text.getCharPointer(), result);
+    JSONReader reader (text);
+    return JSONParser::parseObjectOrArray (reader, result);
 }
 
 String JSON::toString (const var& data, const bool allOnOneLine, int maximumDecimalPlaces)
 {
     MemoryOutputStream mo (1024);
-    JSONFormatter::write (mo, data, 0, allOnOneLine, maximumDecimalPlaces);
+    JSONWriter (mo, allOnOneLine, maximumDecimalPlaces).writeValue (data);
     return mo.toUTF8();
 }
 
 void JSON::writeToStream (OutputStream& output, const var& data, const bool allOnOneLine, int maximumDecimalPlaces)
 {
-    JSONFormatter::write (output, data, 0, allOnOneLine, maximumDecimalPlaces);
+    JSONWriter (output, allOnOneLine, maximumDecimalPlaces).writeValue (data);
 }
 
 String JSON::escapeString (StringRef s)
@@ -523,10 +373,41 @@ Result JSON::parseQuotedString (String::CharPointerType& t, var& result)
 {
     auto quote = t.getAndAdvance();
 
-    if (quote == '"' || quote == '\'')
-        return JSONParser::parseString (quote, t, result);
+    if (quote != '"' && quote != '\'')
+        return Result::fail ("Not a quoted string!");
+
+    bool hasEscapes = false;
+    const char* error = nullptr;
+
+   #if JUCE_STRING_UTF_TYPE == 8
+    auto* start = t.getAddress();
+
+    if (auto* closeQuote = JSONReaderHelpers::findEndOfString (start, nullptr, (char) quote, hasEscapes, error))
+    {
+        result = JSONReaderHelpers::decodeString (start, closeQuote, hasEscapes);
+        t = String::CharPointerType (closeQuote + 1);
+        return Result::ok();
+    }
+   #else
+    // find the closing quote, and then convert the string to UTF-8 to decode it
+    auto end = t;
+
+    for (auto c = *end; c != quote; c = *++end)
+        if (c == 0 || (c == '\\' && *++end == 0))
+            return Result::fail ("Unexpected end-of-input in string constant");
+
+    auto content = String (t, end) + quote;
+    auto* start = content.toRawUTF8();
+
+    if (auto* closeQuote = JSONReaderHelpers::findEndOfString (start, nullptr, (char) quote, hasEscapes, error))
+    {
+        result = JSONReaderHelpers::decodeString (start, closeQuote, hasEscapes);
+        t = end + 1;
+        return Result::ok();
+    }
+   #endif
 
-    return Result::fail ("Not a quoted string!");
+    return Result::fail (error);
 }
 
 //==============================================================================
@@ -615,6 +496,36 @@ public:
         }
     }
 
+    static void writeStreamed (JSONWriter& writer, const var& v)
+    {
+        if (auto* array = v.getArray())
+        {
+            writer.startArray();
+
+            for (auto& item : *array)
+                writeStreamed (writer, item);
+
+            writer.endArray();
+        }
+        else if (auto* object = v.getDynamicObject())
+        {
+            writer.startObject();
+
+            for (auto& property : object->getProperties())
+            {
+                writer.writeName (property.name.toString());
+                writeStreamed (writer, property.value);
+            }
+
+            writer.endObject();
+        }
+        else if (v.isString())  writer.writeString (v.toString());
+        else if (v.isDouble())  writer.writeDouble (v);
+        else if (v.isBool())    writer.writeBool (v);
+        else if (v.isVoid())    writer.writeNull();
+        else                    writer.writeInt (v);
+    }
+
     void runTest() override
     {
         beginTest ("JSON");
@@ -642,6 +553,15 @@ public:
             var parsed = JSON::parse ("[" + asString + "]")[0];
             String parsedString (JSON::toString (parsed, oneLine));
             expect (asString.isNotEmpty() && parsedString == asString);
+
+            MemoryOutputStream written;
+
+            {
+                JSONWriter writer (written, oneLine);
+                writeStreamed (writer, v);
+            }
+
+            expectEquals (written.toString(), asString);
         }
     }
 };
@@ -31,7 +31,10 @@ namespace juce
     functions allow you to parse JSON into a var object, and to convert a var
     object to JSON-formatted text.
 
-    @see var
+    To read or write large amounts of JSON without building a var tree, you can
+    use a JSONReader or JSONWriter instead.
+
+    @see var, JSONReader, JSONWriter
 */
 class JUCE_API  JSON
 {
@@ -0,0 +1,711 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace JSONReaderHelpers
+{
+    static bool isWhitespace (const char c) noexcept
+    {
+        return c == ' ' || (c <= 13 && c >= 9);
+    }
+
+    static bool isDigit (const char c) noexcept
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // returns true if any of the bytes in the word are equal to the byte that's repeated in the pattern
+    static bool containsByte (uint64 word, uint64 pattern) noexcept
+    {
+        auto x = word ^ pattern;
+        return ((x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL) != 0;
+    }
+
+    /*  Returns the position of the closing quote of a string that starts at p, or nullptr
+        if it's malformed. If end is nullptr, the text is assumed to be null-terminated.
+    */
+    static const char* findEndOfString (const char* p, const char* end, const char quote,
+                                        bool& hasEscapes, const char*& error) noexcept
+    {
+        const auto quotes      = 0x0101010101010101ULL * (uint8) quote;
+        const auto backslashes = 0x0101010101010101ULL * (uint8) '\\';
+
+        for (;;)
+        {
+            // skip through the bulk of the string 8 bytes at a time..
+            if (end != nullptr)
+            {
+                while (end - p >= 8)
+                {
+                    uint64 word;
+                    memcpy (&word, p, sizeof (word));
+
+                    if (containsByte (word, quotes) || containsByte (word, backslashes))
+                        break;
+
+                    p += 8;
+                }
+            }
+
+            while (p != end && *p != 0 && *p != quote && *p != '\\')
+                ++p;
+
+            if (p == end || *p == 0)
+                break;
+
+            if (*p == quote)
+                return p;
+
+            hasEscapes = true;
+            ++p;
+
+            if (p == end || *p == 0)
+                break;
+
+            if (*p == 'u')
+            {
+                juce_wchar c = 0;
+
+                for (int i = 4; --i >= 0;)
+                {
+                    auto digitValue = (++p == end) ? -1 : CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) *p);
+
+                    if (digitValue < 0)
+                    {
+                        error = "Syntax error in unicode escape sequence";
+                        return nullptr;
+                    }
+
+                    c = (juce_wchar) ((c << 4) + static_cast<juce_wchar> (digitValue));
+                }
+
+                if (c == 0)
+                    break;
+            }
+
+            ++p;
+        }
+
+        error = "Unexpected end-of-input in string constant";
+        return nullptr;
+    }
+
+    static juce_wchar readUnicodeEscape (const char*& p) noexcept
+    {
+        juce_wchar c = 0;
+
+        for (int i = 4; --i >= 0;)
+            c = (juce_wchar) ((c << 4) + static_cast<juce_wchar> (CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) *p++)));
+
+        return c;
+    }
+
+    // decodes the escape sequences in a string that has already been checked by findEndOfString()
+    static void decodeString (const char* p, const char* end, MemoryOutputStream& out)
+    {
+        for (;;)
+        {
+            auto* runStart = p;
+
+            while (p < end && *p != '\\')
+                ++p;
+
+            out.write (runStart, (size_t) (p - runStart));
+
+            if (p == end)
+                break;
+
+            ++p;
+            auto c = *p++;
+
+            switch (c)
+            {
+                case 'a':  c = '\a'; break;
+                case 'b':  c = '\b'; break;
+                case 'f':  c = '\f'; break;
+                case 'n':  c = '\n'; break;
+                case 'r':  c = '\r'; break;
+                case 't':  c = '\t'; break;
+
+                case 'u':
+                {
+                    auto unicodeChar = readUnicodeEscape (p);
+
+                    // join up any UTF-16 surrogate pairs..
+                    if (unicodeChar >= 0xd800 && unicodeChar <= 0xdbff && end - p >= 6 && p[0] == '\\' && p[1] == 'u')
+                    {
+                        auto next = p + 2;
+                        auto low = readUnicodeEscape (next);
+
+                        if (low >= 0xdc00 && low <= 0xdfff)
+                        {
+                            unicodeChar = (juce_wchar) (0x10000 + ((unicodeChar - 0xd800) << 10) + (low - 0xdc00));
+                            p = next;
+                        }
+                    }
+
+                    out.appendUTF8Char (unicodeChar);
+                    continue;
+                }
+
+                default:
+                    break;  // any other escaped character just stands for itself
+            }
+
+            out << c;
+        }
+    }
+
+    static String decodeString (const char* start, const char* end, bool hasEscapes)
+    {
+        if (! hasEscapes)
+            return start == end ? String() : String::fromUTF8 (start, (int) (end - start));
+
+        char stackSpace[256];
+        MemoryArena arena (stackSpace, sizeof (stackSpace));
+        MemoryOutputStream buffer (arena, 128);
+        decodeString (start, end, buffer);
+        return buffer.toUTF8();
+    }
+
+    static String describeLocation (const char* location, const char* end)
+    {
+        auto numBytes = jmin ((pointer_sized_int) 80, (pointer_sized_int) (end - location));
+        return String::fromUTF8 (location, (int) numBytes).substring (0, 20);
+    }
+}
+
+//==============================================================================
+JSONReader::JSONReader (const void* utf8Data, size_t numBytes)
+{
+    setData (utf8Data, numBytes);
+}
+
+JSONReader::JSONReader (const String& text)  : ownedText (text)
+{
+    setData (ownedText.toRawUTF8(), ownedText.getNumBytesAsUTF8());
+}
+
+JSONReader::JSONReader (const File& file)  : mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
+{
+    if (mappedFile->getData() != nullptr)
+    {
+        setData (mappedFile->getData(), mappedFile->getSize());
+    }
+    else
+    {
+        mappedFile = nullptr;
+        file.loadFileAsData (ownedData);
+        setData (ownedData.getData(), ownedData.getSize());
+    }
+}
+
+JSONReader::JSONReader (InputStream& input)
+{
+    input.readIntoMemoryBlock (ownedData);
+    setData (ownedData.getData(), ownedData.getSize());
+}
+
+JSONReader::~JSONReader() {}
+
+void JSONReader::setData (const void* data, size_t numBytes)
+{
+    auto* utf8 = static_cast<const char*> (data);
+
+    if (numBytes >= 2 && (CharPointer_UTF16::isByteOrderMarkBigEndian (utf8)
+                           || CharPointer_UTF16::isByteOrderMarkLittleEndian (utf8)))
+    {
+        ownedText = String::createStringFromData (utf8, (int) numBytes);
+        utf8 = ownedText.toRawUTF8();
+        numBytes = ownedText.getNumBytesAsUTF8();
+    }
+    else if (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (utf8))
+    {
+        utf8 += 3;
+        numBytes -= 3;
+    }
+
+    position = tokenStart = utf8;
+    dataEnd = utf8 + numBytes;
+
+    // stop at a null terminator, in case the data is followed by some junk
+    if (numBytes > 0)
+        if (auto* terminator = static_cast<const char*> (memchr (utf8, 0, numBytes)))
+            dataEnd = terminator;
+}
+
+//==============================================================================
+JSONReader::TokenType JSONReader::next()
+{
+    if (tokenType == parseError)
+        return parseError;
+
+    if (state == finished)
+        return tokenType = endOfDocument;
+
+    rawValue = {};
+    hasEscapes = false;
+
+    for (;;)
+    {
+        skipWhitespace();
+        tokenStart = position;
+        tokenDepth = nestingIsObject.size();
+        auto c = position < dataEnd ? *position : (char) 0;
+
+        switch (state)
+        {
+            case expectValue:
+                if (c == 0 && nestingIsObject.isEmpty())
+                {
+                    state = finished;
+                    return tokenType = endOfDocument;
+                }
+
+                return readValue();
+
+            case expectValueOrArrayEnd:
+                if (c == 0)   return fail ("Unexpected end-of-input in array declaration");
+                if (c == ']') return closeContainer (arrayEnd);
+
+                return readValue();
+
+            case expectNameOrObjectEnd:
+                if (c == 0)    return fail ("Unexpected end-of-input in object declaration");
+                if (c == '}')  return closeContainer (objectEnd);
+                if (c != '"')  return fail ("Expected object member declaration, but found", position);
+
+                ++position;
+
+                if (readString (propertyName, '"') == parseError)
+                    return parseError;
+
+                skipWhitespace();
+
+                if (position == dataEnd || *position != ':')
+                    return fail ("Expected ':', but found", position);
+
+                ++position;
+                state = expectValue;
+                return propertyName;
+
+            case expectSeparator:
+            {
+                auto inObject = nestingIsObject.getLast();
+
+                if (c == ',')
+                {
+                    ++position;
+                    state = inObject ? expectNameOrObjectEnd : expectValueOrArrayEnd;
+                    continue;
+                }
+
+                if (inObject && c == '}')   return closeContainer (objectEnd);
+                if (! inObject && c == ']') return closeContainer (arrayEnd);
+
+                return fail (inObject ? "Expected object member declaration, but found"
+                                      : "Expected object array item, but found", position);
+            }
+
+            case finished:
+            default:
+                return tokenType = endOfDocument;
+        }
+    }
+}
+
+Result JSONReader::getResult() const
+{
+    return tokenType == parseError ? Result::fail (errorMessage) : Result::ok();
+}
+
+JSONReader::TokenType JSONReader::fail (const char* message, const char* location)
+{
+    errorMessage = message;
+
+    if (location != nullptr)
+        errorMessage << ": \"" << JSONReaderHelpers::describeLocation (location, dataEnd) << '"';
+
+    return tokenType = parseError;
+}
+
+void JSONReader::skipWhitespace() noexcept
+{
+    while (position < dataEnd && JSONReaderHelpers::isWhitespace (*position))
+        ++position;
+}
+
+JSONReader::TokenType JSONReader::readValue()
+{
+    auto c = position < dataEnd ? *position : (char) 0;
+
+    switch (c)
+    {
+        case '{':
+            ++position;
+            nestingIsObject.add (true);
+            state = expectNameOrObjectEnd;
+            return tokenType = objectStart;
+
+        case '[':
+            ++position;
+            nestingIsObject.add (false);
+            state = expectValueOrArrayEnd;
+            return tokenType = arrayStart;
+
+        case '"':
+        case '\'':
+            ++position;
+            return readString (stringValue, c);
+
+        case '-':
+        {
+            auto* p = position + 1;
+
+            while (p < dataEnd && JSONReaderHelpers::isWhitespace (*p))
+                ++p;
+
+            if (p < dataEnd && JSONReaderHelpers::isDigit (*p))
+            {
+                position = p;
+                return readNumber (true);
+            }
+
+            break;
+        }
+
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return readNumber (false);
+
+        case 't':   return readKeyword ("true",  4, boolValue);
+        case 'f':   return readKeyword ("false", 5, boolValue);
+        case 'n':   return readKeyword ("null",  4, nullValue);
+
+        default:
+            break;
+    }
+
+    return fail ("Syntax error", position);
+}
+
+JSONReader::TokenType JSONReader::readString (TokenType type, char quote)
+{
+    const char* error = nullptr;
+    auto* closeQuote = JSONReaderHelpers::findEndOfString (position, dataEnd, quote, hasEscapes, error);
+
+    if (closeQuote == nullptr)
+        return fail (error);
+
+    rawValue = { position, closeQuote };
+    position = closeQuote + 1;
+    tokenType = type;
+
+    if (type != propertyName)
+        state = nestingIsObject.isEmpty() ? finished : expectSeparator;
+
+    return type;
+}
+
+JSONReader::TokenType JSONReader::readNumber (bool isNegative)
+{
+    using namespace JSONReaderHelpers;
+
+    auto* start = position;
+    auto* p = start;
+    uint64 value = 0;
+
+    while (p < dataEnd && isDigit (*p))
+        value = value * 10 + (uint64) (*p++ - '0');
+
+    auto c = p < dataEnd ? *p : (char) 0;
+
+    if (c == '.' || c == 'e' || c == 'E')
+    {
+        auto* numberEnd = p;
+
+        while (numberEnd < dataEnd && (isDigit (*numberEnd) || *numberEnd == '.' || *numberEnd == 'e'
+                                        || *numberEnd == 'E' || *numberEnd == '+' || *numberEnd == '-'))
+            ++numberEnd;
+
+        // take a null-terminated copy of the digits, so that readDoubleValue() can't run off the end
+        char buffer[64];
+        String longNumber;
+        auto numBytes = (size_t) (numberEnd - start);
+        const char* digits = buffer;
+
+        if (numBytes < sizeof (buffer))
+        {
+            memcpy (buffer, start, numBytes);
+            buffer[numBytes] = 0;
+        }
+        else
+        {
+            longNumber = String::fromUTF8 (start, (int) numBytes);
+            digits = longNumber.toRawUTF8();
+        }
+
+        CharPointer_ASCII t (digits);
+        auto asDouble = CharacterFunctions::readDoubleValue (t);
+
+        position = start + (t.getAddress() - digits);
+        doubleValue = isNegative ? -asDouble : asDouble;
+        isDouble = true;
+    }
+    else if (c == 0 || isWhitespace (c) || c == ',' || c == '}' || c == ']')
+    {
+        position = p;
+        intValue = (int64) (isNegative ? (0 - value) : value);
+        isDouble = false;
+    }
+    else
+    {
+        return fail ("Syntax error in number", start);
+    }
+
+    rawValue = { start, position };
+    state = nestingIsObject.isEmpty() ? finished : expectSeparator;
+    return tokenType = numberValue;
+}
+
+JSONReader::TokenType JSONReader::readKeyword (const char* keyword, size_t length, TokenType type)
+{
+    if ((size_t) (dataEnd - position) < length || memcmp (position, keyword, length) != 0)
+        return fail ("Syntax error", position);
+
+    rawValue = { position, position + length };
+    position += length;
+    boolean = (keyword[0] == 't');
+    state = nestingIsObject.isEmpty() ? finished : expectSeparator;
+    return tokenType = type;
+}
+
+JSONReader::TokenType JSONReader::closeContainer (TokenType type)
+{
+    ++position;
+    nestingIsObject.removeLast();
+    tokenDepth = nestingIsObject.size();
+    state = nestingIsObject.isEmpty() ? finished : expectSeparator;
+    return tokenType = type;
+}
+
+bool JSONReader::skipValue()
+{
+    if (tokenType != objectStart && tokenType != arrayStart)
+        return tokenType != parseError;
+
+    auto* p = position;
+    int depth = 0;
+
+    for (;;)
+    {
+        while (p < dataEnd && *p != '"' && *p != '\'' && *p != '{' && *p != '}' && *p != '[' && *p != ']')
+            ++p;
+
+        if (p == dataEnd)
+        {
+            fail (nestingIsObject.getLast() ? "Unexpected end-of-input in object declaration"
+                                            : "Unexpected end-of-input in array declaration");
+            return false;
+        }
+
+        auto c = *p++;
+
+        if (c == '"' || c == '\'')
+        {
+            bool escapes = false;
+            const char* error = nullptr;
+            auto* closeQuote = JSONReaderHelpers::findEndOfString (p, dataEnd, c, escapes, error);
+
+            if (closeQuote == nullptr)
+            {
+                fail (error);
+                return false;
+            }
+
+            p = closeQuote + 1;
+        }
+        else if (c == '{' || c == '[')
+        {
+            ++depth;
+        }
+        else if (--depth < 0)
+        {
+            position = p - 1;
+            closeContainer (nestingIsObject.getLast() ? objectEnd : arrayEnd);
+            return true;
+        }
+    }
+}
+
+String JSONReader::getString() const
+{
+    return JSONReaderHelpers::decodeString (rawValue.start, rawValue.end, hasEscapes);
+}
+
+//==============================================================================
+String JSONReader::TextRange::toString() const
+{
+    return start == end ? String() : String::fromUTF8 (start, (int) (end - start));
+}
+
+bool JSONReader::TextRange::operator== (StringRef other) const noexcept
+{
+   #if JUCE_STRING_UTF_TYPE == 8
+    auto* s = other.text.getAddress();
+
+    // (the range never contains a null, so this stops at the end of the other string)
+    for (auto* p = start; p < end; ++p, ++s)
+        if (*p != *s)
+            return false;
+
+    return *s == 0;
+   #else
+    CharPointer_UTF8 p (start);
+    auto s = other.text;
+
+    while (p.getAddress() < end)
+        if (p.getAndAdvance() != s.getAndAdvance())
+            return false;
+
+    return s.isEmpty();
+   #endif
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONReaderTests  : public UnitTest
+{
+public:
+    JSONReaderTests() : UnitTest ("JSONReader", "JSON") {}
+
+    void runTest() override
+    {
+        beginTest ("Tokens");
+        {
+            JSONReader reader ("{ \"id\": 12, \"name\": \"a\\tb\\u00e9\", \"list\": [ 1.5, -3, true, null, [] ], \"x\": false }");
+
+            expect (reader.next() == JSONReader::objectStart);
+            expectEquals (reader.getDepth(), 0);
+            expect (reader.next() == JSONReader::propertyName);
+            expect (reader.getRawValue() == "id");
+            expectEquals (reader.getDepth(), 1);
+            expect (reader.next() == JSONReader::numberValue);
+            expect (reader.isInteger());
+            expectEquals (reader.getIntValue(), (int64) 12);
+
+            expect (reader.next() == JSONReader::propertyName);
+            expect (reader.next() == JSONReader::stringValue);
+            expect (reader.getRawValue() == "a\\tb\\u00e9");
+            expectEquals (reader.getString(), String ("a\tb") + String::charToString ((juce_wchar) 0xe9));
+
+            expect (reader.next() == JSONReader::propertyName);
+            expect (reader.next() == JSONReader::arrayStart);
+            expect (reader.next() == JSONReader::numberValue);
+            expect (! reader.isInteger());
+            expectEquals (reader.getDoubleValue(), 1.5);
+            expect (reader.next() == JSONReader::numberValue);
+            expectEquals (reader.getIntValue(), (int64) -3);
+            expect (reader.next() == JSONReader::boolValue);
+            expect (reader.getBoolValue());
+            expect (reader.next() == JSONReader::nullValue);
+            expect (reader.next() == JSONReader::arrayStart);
+            expectEquals (reader.getDepth(), 2);
+            expect (reader.next() == JSONReader::arrayEnd);
+            expect (reader.next() == JSONReader::arrayEnd);
+            expectEquals (reader.getDepth(), 1);
+
+            expect (reader.next() == JSONReader::propertyName);
+            expect (reader.next() == JSONReader::boolValue);
+            expect (! reader.getBoolValue());
+            expect (reader.next() == JSONReader::objectEnd);
+            expect (reader.next() == JSONReader::endOfDocument);
+            expect (reader.next() == JSONReader::endOfDocument);
+            expect (reader.getResult().wasOk());
+        }
+
+        beginTest ("Long strings");
+        {
+            String s;
+
+            for (int i = 0; i < 100; ++i)
+                s << "abcdefg" << i << (i % 7 == 0 ? "\\\"" : "");
+
+            JSONReader reader ("[\"" + s + "\"]");
+            expect (reader.next() == JSONReader::arrayStart);
+            expect (reader.next() == JSONReader::stringValue);
+            expectEquals (reader.getString(), s.replace ("\\\"", "\""));
+            expect (reader.next() == JSONReader::arrayEnd);
+        }
+
+        beginTest ("Skipping values");
+        {
+            JSONReader reader ("[ { \"a\": [1, \"]}\", {}] }, 2 ]");
+
+            expect (reader.next() == JSONReader::arrayStart);
+            expect (reader.next() == JSONReader::objectStart);
+            expect (reader.skipValue());
+            expect (reader.getTokenType() == JSONReader::objectEnd);
+            expect (reader.next() == JSONReader::numberValue);
+            expectEquals (reader.getIntValue(), (int64) 2);
+            expect (reader.next() == JSONReader::arrayEnd);
+        }
+
+        beginTest ("Errors");
+        {
+            expectError ("[1 2]",        "Expected object array item, but found: \"2]\"");
+            expectError ("{\"a\" 1}",    "Expected ':', but found: \"1}\"");
+            expectError ("[1x]",         "Syntax error in number: \"1x]\"");
+            expectError ("[\"abc",       "Unexpected end-of-input in string constant");
+            expectError ("[\"\\u12G4\"]", "Syntax error in unicode escape sequence");
+            expectError ("{",            "Unexpected end-of-input in object declaration");
+            expectError ("[tru]",        "Syntax error: \"tru]\"");
+        }
+    }
+
+    void expectError (const char* json, const String& error)
+    {
+        JSONReader reader (json, strlen (json));
+
+        while (reader.next() != JSONReader::parseError)
+        {
+            if (reader.getTokenType() == JSONReader::endOfDocument)
+            {
+                expect (false, "no error for " + String (json));
+                return;
+            }
+        }
+
+        expectEquals (reader.getResult().getErrorMessage(), error);
+        expect (reader.next() == JSONReader::parseError);
+    }
+};
+
+static JSONReaderTests jsonReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast, forward-only JSON parser which steps through a document one token at a time.
+
+    Where JSON::parse() builds a tree of var objects, this lets you walk through the
+    data and only pick out the parts that you need, with no allocations except for
+    any strings that you ask it to decode.
+
+    e.g.
+    @code
+    JSONReader reader (jsonText);
+
+    while (reader.next() != JSONReader::endOfDocument)
+    {
+        if (reader.getTokenType() == JSONReader::propertyName && reader.getRawValue() == "id")
+        {
+            reader.next();
+            DBG (reader.getIntValue());
+        }
+        else if (reader.getTokenType() == JSONReader::parseError)
+        {
+            DBG (reader.getResult().getErrorMessage());
+            break;
+        }
+    }
+    @endcode
+
+    The reader accepts the same slightly-relaxed syntax as JSON::parse(), so strings
+    may be single-quoted and trailing commas are allowed. The data must be UTF-8,
+    or UTF-16 with a byte-order-mark, which will be converted when the reader is created.
+
+    @see JSON, JSONWriter
+*/
+class JUCE_API  JSONReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader for a block of UTF-8 data.
+        The reader doesn't take a copy of the data, so it must stay valid for the
+        reader's lifetime.
+    */
+    JSONReader (const void* utf8Data, size_t numBytes);
+
+    /** Creates a reader for a string. */
+    explicit JSONReader (const String& text);
+
+    /** Creates a reader for a file, which will be memory-mapped if possible. */
+    explicit JSONReader (const File& file);
+
+    /** Creates a reader that parses the remaining contents of a stream.
+        This reads all of the stream's data into memory before the parsing begins.
+    */
+    explicit JSONReader (InputStream& input);
+
+    /** Destructor. */
+    ~JSONReader();
+
+    //==============================================================================
+    /** The different types of token that next() can find. */
+    enum TokenType
+    {
+        objectStart,    /**< The opening brace of an object. */
+        objectEnd,      /**< The closing brace of an object. */
+        arrayStart,     /**< The opening bracket of an array. */
+        arrayEnd,       /**< The closing bracket of an array. */
+        propertyName,   /**< The name of one of an object's properties - the next token will be its value. */
+        stringValue,    /**< A string - use getString() to read it. */
+        numberValue,    /**< A number - use getIntValue() or getDoubleValue() to read it. */
+        boolValue,      /**< true or false - use getBoolValue() to find out which. */
+        nullValue,      /**< The keyword null. */
+        endOfDocument,  /**< The outer value has been read. Any data after it is ignored. */
+        parseError      /**< The data is malformed - use getResult() to find out why. */
+    };
+
+    /** Moves on to the next token in the document, and returns its type.
+        Once the end of the document or an error has been reached, this will keep
+        returning the same value.
+    */
+    TokenType next();
+
+    /** Returns the type of the current token, i.e. the last value that next() returned. */
+    TokenType getTokenType() const noexcept                 { return tokenType; }
+
+    /** Returns an error if the reader has found a problem with the data, or Result::ok() if not. */
+    Result getResult() const;
+
+    //==============================================================================
+    /** Points to a section of the reader's UTF-8 source data.
+        These are only valid for the lifetime of the JSONReader.
+    */
+    struct JUCE_API  TextRange
+    {
+        const char* start = nullptr;
+        const char* end = nullptr;
+
+        /** Returns the number of bytes in the range. */
+        size_t getNumBytes() const noexcept                 { return (size_t) (end - start); }
+
+        /** Returns true if the range is empty. */
+        bool isEmpty() const noexcept                       { return start == end; }
+
+        /** Creates a String containing a copy of this range. */
+        String toString() const;
+
+        /** Compares the range's characters with a string. */
+        bool operator== (StringRef) const noexcept;
+
+        /** Compares the range's characters with a string. */
+        bool operator!= (StringRef other) const noexcept    { return ! operator== (other); }
+    };
+
+    /** Returns the source text of the current token.
+        For a string or property name, this is the undecoded text between its quotes,
+        and for a number it's the digits, without any minus sign.
+    */
+    TextRange getRawValue() const noexcept                  { return rawValue; }
+
+    /** Returns the decoded content of the current string or property name. */
+    String getString() const;
+
+    /** Returns true if the current number was written without a decimal point or exponent. */
+    bool isInteger() const noexcept                         { return ! isDouble; }
+
+    /** Returns the current number as an integer.
+        If it has a fractional part, this will be truncated.
+    */
+    int64 getIntValue() const noexcept                      { return isDouble ? (int64) doubleValue : intValue; }
+
+    /** Returns the current number as a double. */
+    double getDoubleValue() const noexcept                  { return isDouble ? doubleValue : (double) intValue; }
+
+    /** Returns true if the current token is the keyword true. */
+    bool getBoolValue() const noexcept                      { return boolean; }
+
+    //==============================================================================
+    /** Returns the number of objects and arrays that enclose the current token.
+        For the outer value this is zero, as it is for the end of an outer object or array.
+    */
+    int getDepth() const noexcept                           { return tokenDepth; }
+
+    /** If the current token is an objectStart or arrayStart, this moves on to its matching
+        end token.
+
+        To make this fast, it only looks for the brackets and strings, so it won't notice
+        any syntax errors inside the value that it skips.
+
+        @returns false if the data ended before the closing bracket was found
+    */
+    bool skipValue();
+
+private:
+    //==============================================================================
+    enum State
+    {
+        expectValue,
+        expectValueOrArrayEnd,
+        expectNameOrObjectEnd,
+        expectSeparator,
+        finished
+    };
+
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    MemoryBlock ownedData;
+    String ownedText;
+    const char* dataEnd = nullptr;
+    const char* position = nullptr;
+    const char* tokenStart = nullptr;
+    TokenType tokenType = endOfDocument;
+    State state = expectValue;
+    TextRange rawValue;
+    Array<bool> nestingIsObject;
+    String errorMessage;
+    int64 intValue = 0;
+    double doubleValue = 0;
+    int tokenDepth = 0;
+    bool isDouble = false, boolean = false, hasEscapes = false;
+
+    friend struct JSONParser;
+
+    void setData (const void*, size_t);
+    TokenType readValue();
+    TokenType readString (TokenType, char quote);
+    TokenType readNumber (bool isNegative);
+    TokenType readKeyword (const char* keyword, size_t length, TokenType);
+    TokenType closeContainer (TokenType);
+    TokenType fail (const char* message, const char* location = nullptr);
+    void skipWhitespace() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONReader)
+};
+
+} // namespace juce
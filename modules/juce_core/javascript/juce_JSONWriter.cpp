@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+JSONWriter::JSONWriter (OutputStream& destination, bool oneLine, int decimalPlaces)
+    : out (destination), maximumDecimalPlaces (decimalPlaces), allOnOneLine (oneLine)
+{
+}
+
+JSONWriter::~JSONWriter()
+{
+    // You need to close all the objects and arrays that you start!
+    jassert (levels.isEmpty());
+}
+
+//==============================================================================
+void JSONWriter::startItem()
+{
+    auto& level = levels.getReference (levels.size() - 1);
+
+    if (level.numItems++ > 0)
+    {
+        if (allOnOneLine)
+            out << ", ";
+        else
+            out << ',' << newLine;
+    }
+    else if (! allOnOneLine && ! level.isObject)
+    {
+        out << newLine;
+    }
+
+    if (! allOnOneLine)
+        JSONFormatter::writeSpaces (out, levels.size() * JSONFormatter::indentSize);
+}
+
+void JSONWriter::startValue()
+{
+    if (levels.isEmpty())
+        return;
+
+    if (levels.getLast().isObject)
+    {
+        // Every value in an object needs a name - call writeName() before writing it!
+        jassert (hasName);
+        hasName = false;
+        return;
+    }
+
+    startItem();
+}
+
+void JSONWriter::openContainer (char bracket, bool isObject)
+{
+    startValue();
+    out << bracket;
+
+    if (isObject && ! allOnOneLine)
+        out << newLine;
+
+    levels.add ({ isObject, 0 });
+}
+
+void JSONWriter::closeContainer (char bracket, bool isObject)
+{
+    // This doesn't match the object or array that was most recently started!
+    jassert (levels.size() > 0 && levels.getLast().isObject == isObject && ! hasName);
+
+    auto numItems = levels.getLast().numItems;
+    levels.removeLast();
+
+    if (! allOnOneLine && (numItems > 0 || isObject))
+    {
+        if (numItems > 0)
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, levels.size() * JSONFormatter::indentSize);
+    }
+
+    out << bracket;
+}
+
+void JSONWriter::startObject()  { openContainer ('{', true); }
+void JSONWriter::endObject()    { closeContainer ('}', true); }
+void JSONWriter::startArray()   { openContainer ('[', false); }
+void JSONWriter::endArray()     { closeContainer (']', false); }
+
+void JSONWriter::writeName (StringRef propertyName)
+{
+    // Names can only be written inside an object, and each one needs a value after it
+    jassert (levels.size() > 0 && levels.getLast().isObject && ! hasName);
+
+    startItem();
+    out << '"';
+    JSONFormatter::writeString (out, propertyName.text);
+    out << "\": ";
+    hasName = true;
+}
+
+//==============================================================================
+void JSONWriter::writeString (StringRef text)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, text.text);
+    out << '"';
+}
+
+void JSONWriter::writeInt (int64 value)
+{
+    startValue();
+    out << value;
+}
+
+void JSONWriter::writeDouble (double value)
+{
+    startValue();
+    out << String (value, maximumDecimalPlaces);
+}
+
+void JSONWriter::writeBool (bool value)
+{
+    startValue();
+    out << (value ? "true" : "false");
+}
+
+void JSONWriter::writeNull()
+{
+    startValue();
+    out << "null";
+}
+
+void JSONWriter::writeValue (const var& value)
+{
+    startValue();
+    JSONFormatter::write (out, value, levels.size() * JSONFormatter::indentSize, allOnOneLine, maximumDecimalPlaces);
+}
+
+} // namespace juce
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes JSON-formatted data directly to a stream, one value at a time.
+
+    This produces the same layout as JSON::toString(), but lets you write out a big
+    structure without first having to build a var tree to hold it.
+
+    e.g.
+    @code
+    JSONWriter json (out);
+
+    json.startObject();
+        json.writeName ("name");
+        json.writeString ("foo");
+        json.writeName ("values");
+        json.startArray();
+            json.writeInt (1);
+            json.writeDouble (2.5);
+        json.endArray();
+    json.endObject();
+    @endcode
+
+    Every value that goes inside an object must be preceded by a call to writeName(),
+    and each object or array that you start must be ended before the writer is deleted.
+
+    @see JSON, JSONReader
+*/
+class JUCE_API  JSONWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer.
+        If allOnOneLine is true, the output will be compacted into a single line of text
+        with no carriage-returns. The maximumDecimalPlaces parameter determines the
+        precision of floating point numbers.
+    */
+    JSONWriter (OutputStream& destination, bool allOnOneLine = false, int maximumDecimalPlaces = 20);
+
+    /** Destructor. */
+    ~JSONWriter();
+
+    //==============================================================================
+    /** Writes the opening brace of an object. */
+    void startObject();
+
+    /** Writes the closing brace of the object that was most recently started. */
+    void endObject();
+
+    /** Writes the opening bracket of an array. */
+    void startArray();
+
+    /** Writes the closing bracket of the array that was most recently started. */
+    void endArray();
+
+    /** Writes the name of a property in the current object.
+        This must be followed by the property's value.
+    */
+    void writeName (StringRef propertyName);
+
+    //==============================================================================
+    /** Writes a string, escaping any characters that need it. */
+    void writeString (StringRef text);
+
+    /** Writes an integer. */
+    void writeInt (int64 value);
+
+    /** Writes a floating point number. */
+    void writeDouble (double value);
+
+    /** Writes true or false. */
+    void writeBool (bool value);
+
+    /** Writes a null value. */
+    void writeNull();
+
+    /** Writes a var and anything that it contains. */
+    void writeValue (const var& value);
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        bool isObject;
+        int numItems;
+    };
+
+    OutputStream& out;
+    Array<Level> levels;
+    const int maximumDecimalPlaces;
+    const bool allOnOneLine;
+    bool hasName = false;
+
+    void startValue();
+    void startItem();
+    void openContainer (char bracket, bool isObject);
+    void closeContainer (char bracket, bool isObject);
+
+    JUCE_DECLARE_NON_COPYABLE (JSONWriter)
+};
+
+} // namespace juce
@@ -73,7 +73,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         setMethod ("parseFloat", parseFloat);
     }
 
-    Time timeout;
+    // The deadline is held as a Time::getMillisecondCounterHiRes() value, and is only compared
+    // against the clock once every timeCheckInterval calls to checkTimeOut(), as reading the time
+    // is far more expensive than anything else that a typical loop iteration does.
+    double timeout = 0;
+    int callsUntilNextTimeCheck = 1;
+    enum { timeCheckInterval = 256 };
 
     typedef const var::NativeFunctionArgs& Args;
     typedef const char* TokenType;
@@ -105,6 +110,34 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     static Identifier getPrototypeIdentifier()                { static const Identifier i ("prototype"); return i; }
     static var* getPropertyPointer (DynamicObject* o, const Identifier& i) noexcept   { return o->getProperties().getVarPointer (i); }
 
+    //==============================================================================
+    /** A single-entry inline cache that remembers the index at which an expression last found
+        its property, so that repeated lookups of the same name can skip searching the object.
+        A cached slot is only used if the object still has the same name at that index, so
+        the cache can never return the wrong value, it'll just fall back to a normal search.
+    */
+    struct PropertySlotCache
+    {
+        var* find (DynamicObject* o, const Identifier& name) const noexcept
+        {
+            auto& props = o->getProperties();
+            auto* values = props.begin();
+
+            if (isPositiveAndBelow (slot, props.size()) && values[slot].name == name)
+                return &(values[slot].value);
+
+            auto index = props.indexOf (name);
+
+            if (index < 0)
+                return nullptr;
+
+            slot = index;
+            return &(values[index].value);
+        }
+
+        mutable int slot = -1;
+    };
+
     //==============================================================================
     struct CodeLocation
     {
@@ -137,11 +170,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         ReferenceCountedObjectPtr<RootObject> root;
         DynamicObject::Ptr scope;
 
-        var findFunctionCall (const CodeLocation& location, const var& targetObject, const Identifier& functionName) const
+        var findFunctionCall (const CodeLocation& location, const var& targetObject,
+                              const Identifier& functionName, const PropertySlotCache& cache) const
         {
             if (auto* o = targetObject.getDynamicObject())
             {
-                if (auto* prop = getPropertyPointer (o, functionName))
+                if (auto* prop = cache.find (o, functionName))
                     return *prop;
 
                 for (auto* p = o->getProperty (getPrototypeIdentifier()).getDynamicObject(); p != nullptr;
@@ -179,13 +213,13 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return nullptr;
         }
 
-        var findSymbolInParentScopes (const Identifier& name) const
+        var findSymbolInParentScopes (const Identifier& name, const PropertySlotCache& cache) const
         {
-            if (auto* v = getPropertyPointer (scope, name))
-                return *v;
+            for (auto* s = this; s != nullptr; s = s->parent)
+                if (auto* v = cache.find (s->scope.get(), name))
+                    return *v;
 
-            return parent != nullptr ? parent->findSymbolInParentScopes (name)
-                                     : var::undefined();
+            return var::undefined();
         }
 
         bool findAndInvokeMethod (const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
@@ -235,8 +269,13 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         void checkTimeOut (const CodeLocation& location) const
         {
-            if (Time::getCurrentTime() > root->timeout)
-                location.throwError (root->timeout == Time() ? "Interrupted" : "Execution timed-out");
+            if (--(root->callsUntilNextTimeCheck) > 0)
+                return;
+
+            root->callsUntilNextTimeCheck = timeCheckInterval;
+
+            if (Time::getMillisecondCounterHiRes() > root->timeout)
+                location.throwError (root->timeout == 0 ? "Interrupted" : "Execution timed-out");
         }
     };
 
@@ -300,12 +339,19 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ResultCode perform (const Scope& s, var*) const override
         {
-            s.scope->setProperty (name, initialiser->getResult (s));
+            auto value = initialiser->getResult (s);
+
+            if (auto* v = cache.find (s.scope.get(), name))
+                *v = static_cast<var&&> (value);
+            else
+                s.scope->setProperty (name, value);
+
             return ok;
         }
 
         Identifier name;
         ExpPtr initialiser;
+        PropertySlotCache cache;
     };
 
     struct LoopStatement  : public Statement
@@ -374,17 +420,18 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     {
         UnqualifiedName (const CodeLocation& l, const Identifier& n) noexcept : Expression (l), name (n) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name, cache); }
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (auto* v = getPropertyPointer (s.scope, name))
+            if (auto* v = cache.find (s.scope.get(), name))
                 *v = newValue;
             else
                 s.root->setProperty (name, newValue);
         }
 
         Identifier name;
+        PropertySlotCache cache;
     };
 
     struct DotOperator  : public Expression
@@ -394,6 +441,11 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var getResult (const Scope& s) const override
         {
             auto p = parent->getResult (s);
+
+            if (auto* o = p.getDynamicObject())
+                if (auto* v = cache.find (o, child))
+                    return *v;
+
             static const Identifier lengthID ("length");
 
             if (child == lengthID)
@@ -402,10 +454,6 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 if (p.isString())                 return p.toString().length();
             }
 
-            if (auto* o = p.getDynamicObject())
-                if (auto* v = getPropertyPointer (o, child))
-                    return *v;
-
             return var::undefined();
         }
 
@@ -419,6 +467,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ExpPtr parent;
         Identifier child;
+        PropertySlotCache cache;
     };
 
     struct ArraySubscript  : public Expression
@@ -499,6 +548,17 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         {
             var a (lhs->getResult (s)), b (rhs->getResult (s));
 
+            // fast paths for the common cases of plain numbers, which skip the type-juggling below
+            if (a.isInt())
+            {
+                if (b.isInt())     return getWithInts ((int) a, (int) b);
+                if (b.isDouble())  return getWithDoubles ((double) a, (double) b);
+            }
+            else if (a.isDouble() && (b.isDouble() || b.isInt()))
+            {
+                return getWithDoubles ((double) a, (double) b);
+            }
+
             if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
                 return getWithUndefinedArg();
 
@@ -724,7 +784,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
             {
                 auto thisObject = dot->parent->getResult (s);
-                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child), thisObject);
+                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child, dot->cache), thisObject);
             }
 
             auto function = object->getResult (s);
@@ -1813,8 +1873,13 @@ JavascriptEngine::JavascriptEngine()  : maximumExecutionTime (15.0), root (new R
 
 JavascriptEngine::~JavascriptEngine() {}
 
-void JavascriptEngine::prepareTimeout() const noexcept   { root->timeout = Time::getCurrentTime() + maximumExecutionTime; }
-void JavascriptEngine::stop() noexcept                   { root->timeout = {}; }
+void JavascriptEngine::prepareTimeout() const noexcept
+{
+    root->timeout = Time::getMillisecondCounterHiRes() + maximumExecutionTime.inSeconds() * 1000.0;
+    root->callsUntilNextTimeCheck = 1;
+}
+
+void JavascriptEngine::stop() noexcept                   { root->timeout = 0; }
 
 void JavascriptEngine::registerNativeObject (const Identifier& name, DynamicObject* object)
 {
@@ -1895,6 +1960,81 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
     return root->getProperties();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptEngineTests  : public UnitTest
+{
+public:
+    JavascriptEngineTests() : UnitTest ("JavascriptEngine", "Javascript") {}
+
+    void runTest() override
+    {
+        beginTest ("Arithmetic");
+        {
+            JavascriptEngine engine;
+
+            expectEquals ((int) engine.evaluate ("3 + 4 * 2"), 11);
+            expectEquals ((double) engine.evaluate ("1.5 * 4"), 6.0);
+            expectEquals ((double) engine.evaluate ("3 / 2"), 1.5);
+            expectEquals ((double) engine.evaluate ("2 + 0.5"), 2.5);
+            expectEquals (engine.evaluate ("\"a\" + 1").toString(), String ("a1"));
+            expect ((bool) engine.evaluate ("2 < 2.5"));
+            expect ((bool) engine.evaluate ("true == 1"));
+        }
+
+        beginTest ("Cached name lookups");
+        {
+            JavascriptEngine engine;
+
+            expect (engine.execute ("var total = 0;"
+                                    "function add (n) { var x = n; total = total + x; return x; }"
+                                    "function shadow (total) { return total; }"
+                                    "for (var i = 0; i < 10; ++i) { add (i); shadow (100 - i); }").wasOk());
+
+            expectEquals ((int) engine.evaluate ("total"), 45);
+            expectEquals ((int) engine.evaluate ("shadow (7)"), 7);
+            expectEquals ((int) engine.evaluate ("add (5)"), 5);
+            expectEquals ((int) engine.evaluate ("total"), 50);
+        }
+
+        beginTest ("Cached property lookups");
+        {
+            JavascriptEngine engine;
+
+            expect (engine.execute ("function getB (o) { return o.b; }"
+                                    "var o1 = { a: 1, b: 2 };"
+                                    "var o2 = { b: 3 };"
+                                    "var o3 = { c: 4 };"
+                                    "var sum = getB (o1) + getB (o2) + getB (o1);"
+                                    "var missing = getB (o3);").wasOk());
+
+            expectEquals ((int) engine.evaluate ("sum"), 7);
+            expect (engine.evaluate ("missing").isUndefined());
+            expectEquals ((int) engine.evaluate ("[1, 2, 3].length"), 3);
+            expectEquals ((int) engine.evaluate ("\"abcd\".length"), 4);
+        }
+
+        beginTest ("Timeouts");
+        {
+            JavascriptEngine engine;
+            engine.maximumExecutionTime = RelativeTime::milliseconds (50);
+
+            auto result = engine.execute ("for (;;) {}");
+            expectEquals (result.getErrorMessage(), String ("Line 1, column 5 : Execution timed-out"));
+
+            engine.maximumExecutionTime = RelativeTime::seconds (10);
+            expect (engine.execute ("var n = 0; for (var i = 0; i < 1000; ++i) n = n + 1;").wasOk());
+            expectEquals ((int) engine.evaluate ("n"), 1000);
+        }
+    }
+};
+
+static JavascriptEngineTests javascriptEngineTests;
+
+#endif
+
 #if JUCE_MSVC
  #pragma warning (pop)
 #endif
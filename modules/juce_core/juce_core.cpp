@@ -72,6 +72,10 @@
   #include <sys/errno.h>
   #include <unistd.h>
   #include <netinet/in.h>
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
  #endif
 
  #if JUCE_LINUX
@@ -93,15 +97,26 @@
  #include <sys/time.h>
  #include <net/if.h>
  #include <sys/ioctl.h>
+ #include <poll.h>
 
  #if ! JUCE_ANDROID
   #include <execinfo.h>
  #endif
+
+ #if JUCE_LINUX || JUCE_MAC
+  #include <spawn.h>
+ #endif
+#endif
+
+#if JUCE_MAC
+ #include <crt_externs.h>
 #endif
 
 #if JUCE_MAC || JUCE_IOS
  #include <xlocale.h>
  #include <mach/mach.h>
+ #include <mach/thread_policy.h>
+ #include <sys/event.h>
 #endif
 
 #if JUCE_ANDROID
@@ -110,6 +125,24 @@
 
 #undef check
 
+// The embedded zlib's CRC32 can switch to the carry-less multiply instructions at runtime,
+// which needs a compiler that can generate them without the whole file being built for them.
+#if JUCE_INCLUDE_ZLIB_CODE && JUCE_USE_FAST_ZLIB
+ #ifndef JUCE_USE_CLMUL_INTRINSICS
+  #if JUCE_INTEL && ((JUCE_MSVC && _MSC_VER >= 1900) || JUCE_CLANG \
+                       || (JUCE_GCC && ! JUCE_MINGW && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409))
+   #define JUCE_USE_CLMUL_INTRINSICS 1
+  #endif
+ #endif
+
+ #if JUCE_USE_CLMUL_INTRINSICS
+  #include <immintrin.h>
+ #elif JUCE_ARM && defined (__ARM_FEATURE_CRC32)
+  #define JUCE_USE_ARM_CRC32_INTRINSICS 1
+  #include <arm_acle.h>
+ #endif
+#endif
+
 //==============================================================================
 #ifndef    JUCE_STANDALONE_APPLICATION
  JUCE_COMPILER_WARNING ("Please re-save your project with the latest Projucer version to avoid this warning")
@@ -125,33 +158,46 @@
 #include "files/juce_DirectoryIterator.cpp"
 #include "files/juce_File.cpp"
 #include "files/juce_FileInputStream.cpp"
+#include "files/juce_MappedInputStream.cpp"
 #include "files/juce_FileOutputStream.cpp"
 #include "files/juce_FileSearchPath.cpp"
+#include "files/juce_ParallelDirectoryWalker.cpp"
 #include "files/juce_TemporaryFile.cpp"
+#include "javascript/juce_JSONReader.cpp"
 #include "javascript/juce_JSON.cpp"
+#include "javascript/juce_JSONWriter.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "logging/juce_FileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_AsyncLogger.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
 #include "maths/juce_Random.cpp"
 #include "memory/juce_MemoryBlock.cpp"
+#include "memory/juce_MemoryArena.cpp"
+#include "memory/juce_SharedMemory.cpp"
+#include "memory/juce_SharedMemoryFifo.cpp"
+#include "memory/juce_MemoryUsage.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
+#include "misc/juce_XXHash.cpp"
 #include "misc/juce_StdFunctionCompat.cpp"
 #include "network/juce_MACAddress.cpp"
 #include "network/juce_NamedPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketReactor.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
+#include "streams/juce_BufferedOutputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
 #include "streams/juce_InputStream.cpp"
 #include "streams/juce_MemoryInputStream.cpp"
 #include "streams/juce_MemoryOutputStream.cpp"
 #include "streams/juce_SubregionStream.cpp"
 #include "system/juce_SystemStats.cpp"
+#include "system/juce_CPUDispatch.cpp"
 #include "text/juce_CharacterFunctions.cpp"
 #include "text/juce_Identifier.cpp"
 #include "text/juce_LocalisedStrings.cpp"
@@ -163,13 +209,19 @@
 #include "text/juce_TextDiff.cpp"
 #include "text/juce_Base64.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
+#include "threads/juce_RealtimeSafety.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
+#include "threads/juce_WorkStealingScheduler.cpp"
+#include "threads/juce_ParallelAlgorithms.cpp"
 #include "time/juce_PerformanceCounter.cpp"
+#include "time/juce_Tracer.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
+#include "xml/juce_XmlReader.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
@@ -182,6 +234,7 @@
 #if ! JUCE_WINDOWS
 #include "native/juce_posix_SharedCode.h"
 #include "native/juce_posix_NamedPipe.cpp"
+#include "native/juce_posix_SharedMemory.cpp"
 #endif
 
 //==============================================================================
@@ -199,6 +252,7 @@
 #include "native/juce_win32_Registry.cpp"
 #include "native/juce_win32_SystemStats.cpp"
 #include "native/juce_win32_Threads.cpp"
+#include "native/juce_win32_SharedMemory.cpp"
 
 //==============================================================================
 #elif JUCE_LINUX
@@ -223,14 +277,23 @@
 
 #endif
 
+#include "threads/juce_AdaptiveLock.cpp"
 #include "threads/juce_ChildProcess.cpp"
+#include "threads/juce_ChildProcessPool.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
+#include "threads/juce_LightweightSemaphore.cpp"
+#include "threads/juce_WaitableEvent.cpp"
 #include "network/juce_URL.cpp"
 #include "network/juce_WebInputStream.cpp"
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
 #include "containers/juce_HashMap_test.cpp"
+#include "containers/juce_FlatHashMap_test.cpp"
+#include "containers/juce_TripleBuffer_test.cpp"
+#include "containers/juce_LockFreeFifo_test.cpp"
+#include "containers/juce_LockFreeListenerList_test.cpp"
+#include "misc/juce_FixedSizeFunction_test.cpp"
 #endif
 
 //==============================================================================
@@ -131,6 +131,17 @@
  #define JUCE_ZLIB_INCLUDE_PATH <zlib.h>
 #endif
 
+/** Config: JUCE_USE_FAST_ZLIB
+    Enables some speed-ups in Juce's embedded zlib code: a CRC32 that uses the carry-less
+    multiply or CRC32 instructions when the CPU has them, and a match-copying loop in the
+    inflater that moves 8 bytes at a time. The compressed data is identical either way.
+
+    This has no effect if JUCE_INCLUDE_ZLIB_CODE is disabled.
+*/
+#ifndef JUCE_USE_FAST_ZLIB
+ #define JUCE_USE_FAST_ZLIB 1
+#endif
+
 /** Config: JUCE_USE_CURL
     Enables http/https support via libcurl (Linux only). Enabling this will add an additional
     run-time dynamic dependency to libcurl.
@@ -141,6 +152,25 @@
  #define JUCE_USE_CURL 0
 #endif
 
+/** Config: JUCE_ENABLE_TRACING
+    Enables the JUCE_TRACE_ macros, which record events with the Tracer class, including
+    the ones in JUCE's own audio callbacks, message dispatching and painting code. When
+    this is disabled, the macros compile to nothing.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
+/** Config: JUCE_CHECK_REALTIME_SAFETY
+    Makes JUCE report any memory allocation, locking, waiting or message posting that
+    happens on its audio threads, along with a stack trace. See the RealtimeSafety class
+    for details. This replaces the global operator new and delete, and slows down every
+    allocation and lock, so it should only be used for debugging.
+*/
+#ifndef JUCE_CHECK_REALTIME_SAFETY
+ #define JUCE_CHECK_REALTIME_SAFETY 0
+#endif
+
 
 /** Config: JUCE_CATCH_UNHANDLED_EXCEPTIONS
     If enabled, this will add some exception-catching code to forward unhandled exceptions
@@ -218,8 +248,10 @@ namespace juce
 #include "logging/juce_Logger.h"
 #include "memory/juce_LeakedObjectDetector.h"
 #include "memory/juce_ContainerDeletePolicy.h"
+#include "threads/juce_RealtimeSafety.h"
 #include "memory/juce_HeapBlock.h"
 #include "memory/juce_MemoryBlock.h"
+#include "memory/juce_MemoryArena.h"
 #include "memory/juce_ReferenceCountedObject.h"
 #include "memory/juce_ScopedPointer.h"
 #include "memory/juce_OptionalScopedPointer.h"
@@ -241,24 +273,31 @@ namespace juce
 #include "containers/juce_SortedSet.h"
 #include "containers/juce_SparseSet.h"
 #include "containers/juce_AbstractFifo.h"
+#include "containers/juce_TripleBuffer.h"
+#include "containers/juce_LockFreeFifo.h"
+#include "containers/juce_MultiProducerFifo.h"
+#include "containers/juce_OverwritingFifo.h"
 #include "text/juce_NewLine.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
 #include "text/juce_StringArray.h"
 #include "text/juce_StringPairArray.h"
 #include "text/juce_TextDiff.h"
-#include "text/juce_LocalisedStrings.h"
-#include "text/juce_Base64.h"
 #include "misc/juce_Result.h"
+#include "misc/juce_FixedSizeFunction.h"
 #include "containers/juce_Variant.h"
 #include "containers/juce_NamedValueSet.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
+#include "text/juce_LocalisedStrings.h"
 #include "time/juce_RelativeTime.h"
 #include "time/juce_Time.h"
 #include "streams/juce_InputStream.h"
 #include "streams/juce_OutputStream.h"
 #include "streams/juce_BufferedInputStream.h"
+#include "streams/juce_BufferedOutputStream.h"
+#include "text/juce_Base64.h"
 #include "streams/juce_MemoryInputStream.h"
 #include "streams/juce_MemoryOutputStream.h"
 #include "streams/juce_SubregionStream.h"
@@ -269,12 +308,15 @@ namespace juce
 #include "files/juce_FileOutputStream.h"
 #include "files/juce_FileSearchPath.h"
 #include "files/juce_MemoryMappedFile.h"
+#include "files/juce_MappedInputStream.h"
 #include "files/juce_TemporaryFile.h"
 #include "files/juce_FileFilter.h"
 #include "files/juce_WildcardFileFilter.h"
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
 #include "javascript/juce_JSON.h"
+#include "javascript/juce_JSONReader.h"
+#include "javascript/juce_JSONWriter.h"
 #include "javascript/juce_Javascript.h"
 #include "maths/juce_BigInteger.h"
 #include "maths/juce_Expression.h"
@@ -282,6 +324,7 @@ namespace juce
 #include "misc/juce_RuntimePermissions.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_WindowsRegistry.h"
+#include "misc/juce_XXHash.h"
 #include "threads/juce_ChildProcess.h"
 #include "threads/juce_DynamicLibrary.h"
 #include "threads/juce_HighResolutionTimer.h"
@@ -289,22 +332,38 @@ namespace juce
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
 #include "threads/juce_WaitableEvent.h"
+#include "threads/juce_AdaptiveLock.h"
+#include "threads/juce_LightweightSemaphore.h"
 #include "threads/juce_Thread.h"
+#include "containers/juce_LockFreeListenerList.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
 #include "threads/juce_TimeSliceThread.h"
+#include "logging/juce_AsyncLogger.h"
+#include "threads/juce_WorkStealingScheduler.h"
+#include "threads/juce_ParallelAlgorithms.h"
+#include "files/juce_ParallelDirectoryWalker.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
 #include "network/juce_IPAddress.h"
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
+#include "memory/juce_SharedMemory.h"
+#include "memory/juce_SharedMemoryFifo.h"
+#include "memory/juce_MemoryUsage.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketReactor.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
 #include "system/juce_SystemStats.h"
+#include "system/juce_CPUDispatch.h"
+#include "threads/juce_ChildProcessPool.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_Tracer.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
+#include "xml/juce_XmlReader.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
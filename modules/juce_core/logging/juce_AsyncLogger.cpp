@@ -0,0 +1,442 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+AsyncLogger::RealtimeMessage::RealtimeMessage() noexcept
+{
+    text[0] = 0;
+}
+
+void AsyncLogger::RealtimeMessage::append (const char* source, int numBytes) noexcept
+{
+    if (numBytes > maxLength - length)
+    {
+        numBytes = maxLength - length;
+
+        // don't leave half of a UTF-8 character at the end
+        while (numBytes > 0 && (source[numBytes] & 0xc0) == 0x80)
+            --numBytes;
+    }
+
+    memcpy (text + length, source, (size_t) numBytes);
+    length += numBytes;
+    text[length] = 0;
+}
+
+void AsyncLogger::RealtimeMessage::appendUnsigned (uint64 value) noexcept
+{
+    char digits[20];
+    auto* end = digits + numElementsInArray (digits);
+    auto* d = end;
+
+    do
+    {
+        *--d = (char) ('0' + (int) (value % 10));
+        value /= 10;
+    }
+    while (value > 0);
+
+    append (d, (int) (end - d));
+}
+
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (const char* s) noexcept
+{
+    if (s == nullptr)
+        s = "(null)";
+
+    append (s, (int) strlen (s));
+    return *this;
+}
+
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (int64 value) noexcept
+{
+    if (value < 0)
+    {
+        append ("-", 1);
+        appendUnsigned ((uint64) -(value + 1) + 1);
+    }
+    else
+    {
+        appendUnsigned ((uint64) value);
+    }
+
+    return *this;
+}
+
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (int value) noexcept     { return operator<< ((int64) value); }
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (uint32 value) noexcept  { appendUnsigned (value); return *this; }
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (float value) noexcept   { return operator<< ((double) value); }
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (bool value) noexcept    { return operator<< (value ? "true" : "false"); }
+
+AsyncLogger::RealtimeMessage& AsyncLogger::RealtimeMessage::operator<< (double value) noexcept
+{
+    if (std::isnan (value))
+        return operator<< ("nan");
+
+    if (value < 0)
+    {
+        append ("-", 1);
+        value = -value;
+    }
+
+    if (std::isinf (value))
+        return operator<< ("inf");
+
+    if (value >= 1.0e15 || (value > 0 && value < 1.0e-4))
+    {
+        auto exponent = (int) std::floor (std::log10 (value));
+        return operator<< (value / std::pow (10.0, exponent)) << "e" << exponent;
+    }
+
+    auto units = (uint64) (value * 1000000.0 + 0.5);
+    appendUnsigned (units / 1000000);
+
+    if (auto fraction = (int) (units % 1000000))
+    {
+        char digits[7] = { '.' };
+        int numDigits = 6;
+
+        for (int i = 6; i > 0; --i)
+        {
+            digits[i] = (char) ('0' + fraction % 10);
+            fraction /= 10;
+        }
+
+        while (digits[numDigits] == '0')
+            --numDigits;
+
+        append (digits, numDigits + 1);
+    }
+
+    return *this;
+}
+
+//==============================================================================
+AsyncLogger::FileSink::FileSink (const File& file, int64 maxFileSizeBytes, int numOldFiles)
+    : logFile (file), maxFileSize (maxFileSizeBytes), maxNumOldFiles (jmax (0, numOldFiles))
+{
+}
+
+AsyncLogger::FileSink::~FileSink() {}
+
+File AsyncLogger::FileSink::getOldLogFile (int index) const
+{
+    return logFile.getSiblingFile (logFile.getFileNameWithoutExtension()
+                                     + "." + String (index) + logFile.getFileExtension());
+}
+
+void AsyncLogger::FileSink::write (const Array<Message>& messages)
+{
+    for (auto& m : messages)
+    {
+        if (stream == nullptr)
+        {
+            if (! logFile.exists())
+                logFile.create();  // (to create the parent directories)
+
+            stream = new FileOutputStream (logFile);
+
+            if (stream->failedToOpen())
+            {
+                stream = nullptr;
+                return;
+            }
+        }
+
+        *stream << m.time.formatted ("%Y-%m-%d %H:%M:%S.")
+                << String (m.time.getMilliseconds()).paddedLeft ('0', 3)
+                << "  " << m.text << newLine;
+
+        if (maxFileSize > 0 && stream->getPosition() > maxFileSize)
+            rotate();
+    }
+
+    if (stream != nullptr)
+        stream->flush();
+}
+
+void AsyncLogger::FileSink::rotate()
+{
+    stream = nullptr;
+
+    if (maxNumOldFiles == 0)
+    {
+        logFile.deleteFile();
+        return;
+    }
+
+    getOldLogFile (maxNumOldFiles).deleteFile();
+
+    for (int i = maxNumOldFiles; --i > 0;)
+        getOldLogFile (i).moveFileTo (getOldLogFile (i + 1));
+
+    logFile.moveFileTo (getOldLogFile (1));
+}
+
+//==============================================================================
+AsyncLogger::AsyncLogger (Sink* sinkToUse, int maxQueuedMessages)
+    : Thread ("Async logger"), queue (maxQueuedMessages), sink (sinkToUse)
+{
+    startThread (3);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stopThread (-1);
+}
+
+void AsyncLogger::setSink (Sink* newSink)
+{
+    ScopedPointer<Sink> oldSink (newSink);
+
+    const ScopedLock sl (sinkLock);
+    sink.swapWith (oldSink);
+}
+
+bool AsyncLogger::logRealtime (const RealtimeMessage& message) noexcept
+{
+    Entry e;
+    e.time = Time::currentTimeMillis();
+    e.realtimeText = message;
+
+    // (this is counted before it's pushed so that flush() can't miss it)
+    ++numQueued;
+
+    if (queue.push (e))
+        return true;
+
+    --numQueued;
+    ++numDropped;
+    return false;
+}
+
+void AsyncLogger::logMessage (const String& message)
+{
+    Entry e;
+    e.time = Time::currentTimeMillis();
+    e.text = message;
+
+    ++numQueued;
+
+    while (! queue.push (e))
+    {
+        // if this fails, the sink is logging its own messages..
+        jassert (getThreadId() != Thread::getCurrentThreadId());
+
+        notify();
+        Thread::sleep (1);
+    }
+
+    notify();
+}
+
+void AsyncLogger::flush()
+{
+    notify();
+
+    auto target = numQueued.get();
+
+    while (numWritten.get() < jmin (target, numQueued.get()))
+        messagesWritten.wait (10);
+}
+
+void AsyncLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        // The realtime threads don't wake this thread up, so it also checks the queue regularly
+        wait (50);
+        writePendingMessages();
+    }
+
+    writePendingMessages();
+}
+
+void AsyncLogger::writePendingMessages()
+{
+    Array<Message> messages;
+    Entry e;
+
+    while (queue.pop (e))
+    {
+        messages.add ({ Time (e.time), e.realtimeText.getLength() > 0 ? String (CharPointer_UTF8 (e.realtimeText.getText()))
+                                                                       : e.text });
+        e.text = String();
+    }
+
+    if (messages.isEmpty())
+        return;
+
+    {
+        const ScopedLock sl (sinkLock);
+
+        if (sink != nullptr)
+            sink->write (messages);
+    }
+
+    numWritten += messages.size();
+    messagesWritten.signal();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncLoggerTests  : public UnitTest
+{
+public:
+    AsyncLoggerTests() : UnitTest ("AsyncLogger", "Logging") {}
+
+    struct CollectingSink  : public AsyncLogger::Sink
+    {
+        void write (const Array<AsyncLogger::Message>& newMessages) override
+        {
+            for (auto& m : newMessages)
+                messages.add (m.text);
+        }
+
+        StringArray messages;
+    };
+
+    struct LoggingThread  : public Thread
+    {
+        LoggingThread (AsyncLogger& l, int i) : Thread ("logging test"), logger (l), index (i) {}
+
+        void run() override
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                if (i % 2 == 0)
+                    logger.logMessage (String (index) + " " + String (i));
+                else
+                    while (! logger.logRealtime (AsyncLogger::RealtimeMessage() << index << " " << i))
+                        Thread::sleep (1);
+            }
+        }
+
+        AsyncLogger& logger;
+        const int index;
+    };
+
+    static String format (const AsyncLogger::RealtimeMessage& m)
+    {
+        return String (CharPointer_UTF8 (m.getText()));
+    }
+
+    void runTest() override
+    {
+        beginTest ("Realtime message formatting");
+        {
+            using RM = AsyncLogger::RealtimeMessage;
+
+            expectEquals (format (RM() << "a" << 1 << " " << -23 << " " << (int64) -9223372036854775807LL - 1),
+                          String ("a1 -23 -9223372036854775808"));
+            expectEquals (format (RM() << (uint32) 4000000000u << " " << true << " " << false),
+                          String ("4000000000 true false"));
+            expectEquals (format (RM() << 1.5 << " " << -0.25f << " " << 2.0 << " " << 0.1234567),
+                          String ("1.5 -0.25 2 0.123457"));
+            expectEquals (format (RM() << 1.0e20 << " " << 2.5e-7), String ("1e20 2.5e-7"));
+            expectEquals (format (RM() << std::numeric_limits<double>::infinity()), String ("inf"));
+
+            RM longMessage;
+
+            for (int i = 0; i < 100; ++i)
+                longMessage << "\xc3\xa9";
+
+            expect (longMessage.getLength() <= RM::maxLength);
+            expect (format (longMessage).length() == longMessage.getLength() / 2);
+        }
+
+        beginTest ("Messages from several threads");
+        {
+            auto* sink = new CollectingSink();
+            AsyncLogger logger (sink, 64);
+
+            OwnedArray<LoggingThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new LoggingThread (logger, i))->startThread();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            logger.flush();
+            expectEquals (sink->messages.size(), 4000);
+
+            // each thread's messages must arrive in the order they were logged
+            bool allInOrder = true;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int next = 0;
+
+                for (auto& m : sink->messages)
+                {
+                    if (m.upToFirstOccurrenceOf (" ", false, false).getIntValue() == i)
+                    {
+                        allInOrder = allInOrder && m.fromFirstOccurrenceOf (" ", false, false).getIntValue() == next;
+                        ++next;
+                    }
+                }
+            }
+
+            expect (allInOrder);
+        }
+
+        beginTest ("File sink rotation");
+        {
+            auto dir = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("AsyncLoggerTest", {}, false);
+            auto file = dir.getChildFile ("log.txt");
+
+            {
+                auto* sink = new AsyncLogger::FileSink (file, 1000, 2);
+                AsyncLogger logger (sink);
+
+                for (int i = 0; i < 100; ++i)
+                    logger.logMessage ("message " + String (i) + String::repeatedString ("x", 40));
+
+                logger.flush();
+
+                expect (file.existsAsFile());
+                expect (sink->getOldLogFile (1).existsAsFile());
+                expect (sink->getOldLogFile (2).existsAsFile());
+                expect (! sink->getOldLogFile (3).exists());
+                expect (sink->getOldLogFile (1).getSize() <= 1100);
+
+                logger.logMessage ("last message");
+            }
+
+            expect (file.loadFileAsString().contains ("last message"));
+            dir.deleteRecursively();
+        }
+    }
+};
+
+static AsyncLoggerTests asyncLoggerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A Logger that hands its messages to a background thread to be written, so that
+    logging never makes the calling thread wait for the disk.
+
+    Messages are put into a lock-free queue, and a writer thread takes them off in
+    batches and passes them to a Sink, which does the actual writing. FileSink writes
+    them to a file which is rotated when it gets too big, or you can write your own
+    Sink to send them somewhere else. The sink can be replaced while the logger is
+    running.
+
+    Ordinary messages can be logged from any thread with writeToLog() or logMessage().
+    For the audio thread, or anywhere else that mustn't allocate or lock, build a
+    RealtimeMessage on the stack and pass it to logRealtime(), or use the
+    JUCE_LOG_REALTIME macro:
+    @code
+    JUCE_LOG_REALTIME (logger, "buffer " << bufferIndex << " took " << elapsedMs << "ms");
+    @endcode
+
+    @see Logger, FileLogger
+*/
+class JUCE_API  AsyncLogger  : public Logger,
+                               private Thread
+{
+public:
+    //==============================================================================
+    /** A logged message, as it's passed to a Sink. */
+    struct Message
+    {
+        Time time;      /**< The time at which the message was logged. */
+        String text;    /**< The message itself. */
+    };
+
+    //==============================================================================
+    /** Receives batches of messages from an AsyncLogger's writer thread. */
+    struct JUCE_API  Sink
+    {
+        /** Destructor. */
+        virtual ~Sink() {}
+
+        /** Called on the writer thread with the messages that have been logged since the
+            last call, in the order in which they were queued.
+        */
+        virtual void write (const Array<Message>& messages) = 0;
+    };
+
+    //==============================================================================
+    /** A Sink that appends messages to a text file.
+
+        When the file gets bigger than a given size, it's renamed with ".1" added to
+        its name (and any older ones are moved up to ".2", ".3" etc.), and a new file
+        is started.
+    */
+    class JUCE_API  FileSink  : public Sink
+    {
+    public:
+        /** Creates a sink that writes to the given file.
+            @param fileToWriteTo        the file to append to. It will be created, along with
+                                        any parent directories, if it doesn't exist.
+            @param maxFileSizeBytes     when the file grows beyond this size, it's rotated. If
+                                        this is zero or less, it's never rotated
+            @param maxNumOldFiles       the number of rotated files to keep
+        */
+        FileSink (const File& fileToWriteTo,
+                  int64 maxFileSizeBytes = 1024 * 1024,
+                  int maxNumOldFiles = 3);
+
+        /** Destructor. */
+        ~FileSink();
+
+        /** Returns the file that this sink is writing to. */
+        const File& getLogFile() const noexcept         { return logFile; }
+
+        /** Returns the name of one of the rotated files, where 1 is the most recent. */
+        File getOldLogFile (int index) const;
+
+        /** @internal */
+        void write (const Array<Message>&) override;
+
+    private:
+        File logFile;
+        int64 maxFileSize;
+        int maxNumOldFiles;
+        ScopedPointer<FileOutputStream> stream;
+
+        void rotate();
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileSink)
+    };
+
+    //==============================================================================
+    /** A fixed-size message buffer which can be built up and logged without allocating
+        any memory.
+
+        Text and numbers can be appended with the << operators, and anything that
+        doesn't fit in the buffer is silently dropped.
+
+        @see logRealtime, JUCE_LOG_REALTIME
+    */
+    class JUCE_API  RealtimeMessage
+    {
+    public:
+        /** Creates an empty message. */
+        RealtimeMessage() noexcept;
+
+        /** Appends a null-terminated UTF-8 string. */
+        RealtimeMessage& operator<< (const char*) noexcept;
+        /** Appends a number. */
+        RealtimeMessage& operator<< (int) noexcept;
+        /** Appends a number. */
+        RealtimeMessage& operator<< (int64) noexcept;
+        /** Appends a number. */
+        RealtimeMessage& operator<< (uint32) noexcept;
+        /** Appends a number, with up to 6 decimal places. */
+        RealtimeMessage& operator<< (double) noexcept;
+        /** Appends a number, with up to 6 decimal places. */
+        RealtimeMessage& operator<< (float) noexcept;
+        /** Appends "true" or "false". */
+        RealtimeMessage& operator<< (bool) noexcept;
+
+        /** Returns the text, as a null-terminated UTF-8 string. */
+        const char* getText() const noexcept            { return text; }
+
+        /** Returns the number of bytes in the text. */
+        int getLength() const noexcept                  { return length; }
+
+        /** The maximum number of bytes that a message can contain. */
+        enum { maxLength = 239 };
+
+    private:
+        char text[maxLength + 1];
+        int length = 0;
+
+        void append (const char*, int numBytes) noexcept;
+        void appendUnsigned (uint64) noexcept;
+    };
+
+    //==============================================================================
+    /** Creates a logger which writes to the given sink.
+
+        @param sinkToUse        the sink to write messages to. This will be owned and
+                                deleted by the logger. It may be nullptr, in which case
+                                messages are thrown away until a sink is set.
+        @param maxQueuedMessages   the size of the queue. If realtime messages are logged
+                                faster than the writer thread can deal with them, any that
+                                don't fit are dropped (see getNumDroppedMessages()), and
+                                logMessage() will wait for space.
+    */
+    AsyncLogger (Sink* sinkToUse, int maxQueuedMessages = 1024);
+
+    /** Destructor.
+        Any messages that are still waiting are written before this returns.
+    */
+    ~AsyncLogger();
+
+    //==============================================================================
+    /** Replaces the sink that messages are written to.
+        The object passed in will be owned by the logger, and the old one is deleted.
+        This waits for any batch that's currently being written to finish.
+    */
+    void setSink (Sink* newSink);
+
+    /** Logs a message from a thread that mustn't allocate, lock or wait.
+        This just copies the message into the queue, and returns false if the
+        queue was full.
+    */
+    bool logRealtime (const RealtimeMessage&) noexcept;
+
+    /** Waits until all the messages that have been logged so far have been written. */
+    void flush();
+
+    /** Returns the number of realtime messages that were dropped because the queue
+        was full.
+    */
+    int getNumDroppedMessages() const noexcept          { return numDropped.get(); }
+
+    /** @internal */
+    void logMessage (const String&) override;
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        int64 time = 0;
+        String text;
+        RealtimeMessage realtimeText;
+    };
+
+    MultiProducerFifo<Entry> queue;
+    CriticalSection sinkLock;
+    ScopedPointer<Sink> sink;
+    WaitableEvent messagesWritten;
+    Atomic<int64> numQueued, numWritten;
+    Atomic<int> numDropped;
+
+    void run() override;
+    void writePendingMessages();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncLogger)
+};
+
+//==============================================================================
+/** Builds an AsyncLogger::RealtimeMessage from a sequence of << operators, and logs
+    it without allocating any memory.
+
+    @code
+    JUCE_LOG_REALTIME (logger, "overrun in block " << blockNumber);
+    @endcode
+
+    @see AsyncLogger::logRealtime
+*/
+#define JUCE_LOG_REALTIME(asyncLogger, messageSequence) \
+    do { juce::AsyncLogger::RealtimeMessage juceRealtimeMessage; \
+         juceRealtimeMessage << messageSequence; \
+         (asyncLogger).logRealtime (juceRealtimeMessage); } while (false)
+
+} // namespace juce
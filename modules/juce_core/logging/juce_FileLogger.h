@@ -27,7 +27,10 @@ namespace juce
 /**
     A simple implementation of a Logger that writes to a file.
 
-    @see Logger
+    This writes each message to the file on the thread that logs it. If you need to
+    log from time-critical threads, use an AsyncLogger with a FileSink instead.
+
+    @see Logger, AsyncLogger
 */
 class JUCE_API  FileLogger  : public Logger
 {
@@ -50,6 +50,296 @@ int findHighestSetBit (uint32 n) noexcept
   #endif
 }
 
+//==============================================================================
+// These do the arithmetic directly on arrays of 32-bit words, using 64-bit
+// intermediate values for the products and carries.
+namespace BigIntegerWords
+{
+    // returns the carry out of the top of a
+    static uint32 addInPlace (uint32* a, size_t numA, const uint32* b, size_t numB) noexcept
+    {
+        jassert (numA >= numB);
+        uint64 carry = 0;
+        size_t i = 0;
+
+        for (; i < numB; ++i)
+        {
+            carry += (uint64) a[i] + b[i];
+            a[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        for (; carry != 0 && i < numA; ++i)
+        {
+            carry += a[i];
+            a[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        return (uint32) carry;
+    }
+
+    // returns the borrow out of the top of a
+    static uint32 subtractInPlace (uint32* a, size_t numA, const uint32* b, size_t numB) noexcept
+    {
+        jassert (numA >= numB);
+        uint64 borrow = 0;
+        size_t i = 0;
+
+        for (; i < numB; ++i)
+        {
+            auto diff = (uint64) a[i] - b[i] - borrow;
+            a[i] = (uint32) diff;
+            borrow = diff >> 63;
+        }
+
+        for (; borrow != 0 && i < numA; ++i)
+        {
+            auto diff = (uint64) a[i] - borrow;
+            a[i] = (uint32) diff;
+            borrow = diff >> 63;
+        }
+
+        return (uint32) borrow;
+    }
+
+    static int compare (const uint32* a, const uint32* b, size_t numWords) noexcept
+    {
+        for (auto i = numWords; i > 0; --i)
+            if (a[i - 1] != b[i - 1])
+                return a[i - 1] > b[i - 1] ? 1 : -1;
+
+        return 0;
+    }
+
+    static void multiplySchoolbook (uint32* result, const uint32* a, size_t numA, const uint32* b, size_t numB) noexcept
+    {
+        std::fill (result, result + numA + numB, (uint32) 0);
+
+        for (size_t i = 0; i < numB; ++i)
+        {
+            const uint64 multiplier = b[i];
+            uint64 carry = 0;
+
+            for (size_t j = 0; j < numA; ++j)
+            {
+                carry += result[i + j] + a[j] * multiplier;
+                result[i + j] = (uint32) carry;
+                carry >>= 32;
+            }
+
+            result[i + numA] = (uint32) carry;
+        }
+    }
+
+    // Below this size, the overhead of splitting the numbers up costs more than it saves
+    enum { karatsubaThreshold = 40 };
+
+    // Writes numA + numB words of result, which mustn't overlap a or b
+    static void multiply (uint32* result, const uint32* a, size_t numA, const uint32* b, size_t numB)
+    {
+        if (numA < numB)
+        {
+            std::swap (a, b);
+            std::swap (numA, numB);
+        }
+
+        if (numB < karatsubaThreshold || numB * 2 <= numA)
+        {
+            multiplySchoolbook (result, a, numA, b, numB);
+            return;
+        }
+
+        // Karatsuba: with a = a1.x + a0 and b = b1.x + b0, the middle term a1.b0 + a0.b1
+        // is (a0 + a1) * (b0 + b1) - a0.b0 - a1.b1, which needs three multiplications
+        // instead of four.
+        auto half = numA / 2;
+        auto highA = numA - half, highB = numB - half;
+
+        multiply (result, a, half, b, half);                        // a0.b0
+        multiply (result + 2 * half, a + half, highA, b + half, highB); // a1.b1
+
+        auto numSumA = jmax (half, highA) + 1, numSumB = jmax (half, highB) + 1;
+        HeapBlock<uint32> sumA (numSumA, true), sumB (numSumB, true), middle (numSumA + numSumB);
+
+        memcpy (sumA, a, half * sizeof (uint32));
+        memcpy (sumB, b, half * sizeof (uint32));
+        addInPlace (sumA, numSumA, a + half, highA);
+        addInPlace (sumB, numSumB, b + half, highB);
+
+        auto numMiddle = numSumA + numSumB;
+        multiply (middle, sumA, numSumA, sumB, numSumB);
+        subtractInPlace (middle, numMiddle, result, 2 * half);
+        subtractInPlace (middle, numMiddle, result + 2 * half, highA + highB);
+
+        while (numMiddle > 0 && middle[numMiddle - 1] == 0)
+            --numMiddle;
+
+        addInPlace (result + half, numA + numB - half, middle, numMiddle);
+    }
+
+    // Knuth's algorithm D. The quotient has (numU - numV + 1) words and the remainder has
+    // numV words. The top word of v mustn't be zero.
+    static void divide (uint32* quotient, uint32* remainder,
+                        const uint32* u, size_t numU, const uint32* v, size_t numV)
+    {
+        jassert (numU >= numV && numV > 0 && v[numV - 1] != 0);
+
+        if (numV == 1)
+        {
+            const uint64 divisor = v[0];
+            uint64 rem = 0;
+
+            for (auto i = numU; i > 0; --i)
+            {
+                auto n = (rem << 32) | u[i - 1];
+                quotient[i - 1] = (uint32) (n / divisor);
+                rem = n % divisor;
+            }
+
+            remainder[0] = (uint32) rem;
+            return;
+        }
+
+        // Shift both numbers so that the top bit of the divisor is set, which keeps the
+        // estimate of each quotient word to within 2 of the correct value.
+        auto shift = 31 - findHighestSetBit (v[numV - 1]);
+        HeapBlock<uint32> vn (numV), un (numU + 1);
+
+        for (auto i = numV - 1; i > 0; --i)
+            vn[i] = (v[i] << shift) | (uint32) ((uint64) v[i - 1] >> (32 - shift));
+
+        vn[0] = v[0] << shift;
+        un[numU] = (uint32) ((uint64) u[numU - 1] >> (32 - shift));
+
+        for (auto i = numU - 1; i > 0; --i)
+            un[i] = (u[i] << shift) | (uint32) ((uint64) u[i - 1] >> (32 - shift));
+
+        un[0] = u[0] << shift;
+
+        const uint64 base = (uint64) 1 << 32;
+        const uint64 topDivisor = vn[numV - 1], nextDivisor = vn[numV - 2];
+
+        for (auto j = numU - numV + 1; j > 0;)
+        {
+            --j;
+
+            auto n = ((uint64) un[j + numV] << 32) | un[j + numV - 1];
+            auto qhat = n / topDivisor;
+            auto rhat = n % topDivisor;
+
+            while (qhat >= base || qhat * nextDivisor > ((rhat << 32) | un[j + numV - 2]))
+            {
+                --qhat;
+                rhat += topDivisor;
+
+                if (rhat >= base)
+                    break;
+            }
+
+            // subtract qhat * divisor from this section of the dividend
+            int64 borrow = 0, t = 0;
+
+            for (size_t i = 0; i < numV; ++i)
+            {
+                auto p = qhat * vn[i];
+                t = (int64) un[i + j] - borrow - (int64) (p & 0xffffffff);
+                un[i + j] = (uint32) t;
+                borrow = (int64) (p >> 32) - (t >> 32);
+            }
+
+            t = (int64) un[j + numV] - borrow;
+            un[j + numV] = (uint32) t;
+            quotient[j] = (uint32) qhat;
+
+            if (t < 0)
+            {
+                // the estimate was one too big, so add the divisor back
+                --quotient[j];
+                un[j + numV] += addInPlace (un + j, numV, vn, numV);
+            }
+        }
+
+        for (size_t i = 0; i < numV - 1; ++i)
+            remainder[i] = (un[i] >> shift) | (uint32) ((uint64) un[i + 1] << (32 - shift));
+
+        remainder[numV - 1] = un[numV - 1] >> shift;
+    }
+
+    //==============================================================================
+    // Montgomery multiplication for an odd modulus of numWords words, where R = 2^(32 * numWords).
+    // This replaces the division in each modular multiplication with a series of word
+    // multiplications, so it's much faster for repeated operations like exponentiation.
+    struct MontgomeryMultiplier
+    {
+        MontgomeryMultiplier (const uint32* m, size_t n)
+            : modulus (m), numWords (n), temp (n + 2)
+        {
+            jassert ((m[0] & 1) != 0);
+
+            // find -1 / m mod 2^32 by Newton's method: each step doubles the number of correct bits
+            auto inverse = m[0];
+
+            for (int i = 0; i < 4; ++i)
+                inverse *= 2 - m[0] * inverse;
+
+            minusInverse = (uint32) (0 - inverse);
+        }
+
+        // result = a * b / R mod m. The result can be the same array as a or b.
+        void multiply (uint32* result, const uint32* a, const uint32* b) noexcept
+        {
+            auto* t = temp.get();
+            auto n = numWords;
+            std::fill (t, t + n + 2, (uint32) 0);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64 multiplier = b[i];
+                uint64 carry = 0;
+
+                for (size_t j = 0; j < n; ++j)
+                {
+                    carry += t[j] + a[j] * multiplier;
+                    t[j] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[n];
+                t[n] = (uint32) carry;
+                t[n + 1] = (uint32) (carry >> 32);
+
+                // add a multiple of the modulus that makes the bottom word zero, and shift it away
+                const uint64 q = (uint32) (t[0] * minusInverse);
+                carry = ((uint64) t[0] + q * modulus[0]) >> 32;
+
+                for (size_t j = 1; j < n; ++j)
+                {
+                    carry += t[j] + q * modulus[j];
+                    t[j - 1] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[n];
+                t[n - 1] = (uint32) carry;
+                t[n] = t[n + 1] + (uint32) (carry >> 32);
+            }
+
+            if (t[n] != 0 || compare (t, modulus, n) >= 0)
+                subtractInPlace (t, n + 1, modulus, n);
+
+            memcpy (result, t, n * sizeof (uint32));
+        }
+
+        const uint32* modulus;
+        size_t numWords;
+        uint32 minusInverse;
+        HeapBlock<uint32> temp;
+
+        JUCE_DECLARE_NON_COPYABLE (MontgomeryMultiplier)
+    };
+}
+
 //==============================================================================
 BigInteger::BigInteger()
     : allocatedSize (numPreallocatedInts)
@@ -527,35 +817,20 @@ BigInteger& BigInteger::operator*= (const BigInteger& other)
     auto n = getHighestBit();
     auto t = other.getHighestBit();
 
+    if (n < 0 || t < 0)
+    {
+        clear();
+        return *this;
+    }
+
     auto wasNegative = isNegative();
-    setNegative (false);
 
     BigInteger total;
     total.highestBit = n + t + 1;
     auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
 
-    n >>= 5;
-    t >>= 5;
-
-    auto m = other;
-    m.setNegative (false);
-
-    auto* mValues = m.getValues();
-    auto* values = getValues();
-
-    for (int i = 0; i <= t; ++i)
-    {
-        uint32 c = 0;
-
-        for (int j = 0; j <= n; ++j)
-        {
-            auto uv = (uint64) totalValues[i + j] + (uint64) values[j] * (uint64) mValues[i] + (uint64) c;
-            totalValues[i + j] = (uint32) uv;
-            c = uv >> 32;
-        }
-
-        totalValues[i + n + 1] = c;
-    }
+    BigIntegerWords::multiply (totalValues, getValues(), sizeNeededToHold (n),
+                               other.getValues(), sizeNeededToHold (t));
 
     total.highestBit = total.getHighestBit();
     total.setNegative (wasNegative ^ other.isNegative());
@@ -584,26 +859,29 @@ void BigInteger::divideBy (const BigInteger& divisor, BigInteger& remainder)
     {
         auto wasNegative = isNegative();
 
-        swapWith (remainder);
-        remainder.setNegative (false);
-        clear();
+        if (ourHB < divHB)
+        {
+            swapWith (remainder);
+            clear();
+        }
+        else
+        {
+            auto numWords = sizeNeededToHold (ourHB);
+            auto numDivisorWords = sizeNeededToHold (divHB);
 
-        BigInteger temp (divisor);
-        temp.setNegative (false);
+            BigInteger quotient, rem;
+            quotient.highestBit = (int) (numWords - numDivisorWords + 1) * 32 - 1;
+            rem.highestBit = (int) numDivisorWords * 32 - 1;
 
-        auto leftShift = ourHB - divHB;
-        temp <<= leftShift;
+            BigIntegerWords::divide (quotient.ensureSize (numWords - numDivisorWords + 1),
+                                     rem.ensureSize (numDivisorWords),
+                                     getValues(), numWords, divisor.getValues(), numDivisorWords);
 
-        while (leftShift >= 0)
-        {
-            if (remainder.compareAbsolute (temp) >= 0)
-            {
-                remainder -= temp;
-                setBit (leftShift);
-            }
+            quotient.highestBit = quotient.getHighestBit();
+            rem.highestBit = rem.getHighestBit();
 
-            if (--leftShift >= 0)
-                temp >>= 1;
+            swapWith (quotient);
+            remainder.swapWith (rem);
         }
 
         negative = wasNegative ^ divisor.isNegative();
@@ -905,68 +1183,107 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
 
 void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
 {
+    jassert (! exponent.isNegative());
+
     *this %= modulus;
-    auto exp = exponent;
-    exp %= modulus;
 
-    if (modulus.getHighestBit() <= 32 || modulus % 2 == 0)
+    if (isNegative())
+        *this += modulus;
+
+    if (modulus.getHighestBit() <= 0)
     {
+        clear();
+        return;
+    }
+
+    auto numExponentBits = exponent.getHighestBit() + 1;
+
+    if (! modulus[0])
+    {
+        // Montgomery multiplication needs an odd modulus, so this just does it the long way
         auto a = *this;
-        auto n = exp.getHighestBit();
+        *this = 1;
 
-        for (int i = n; --i >= 0;)
+        for (int i = numExponentBits; --i >= 0;)
         {
             *this *= *this;
+            *this %= modulus;
 
-            if (exp[i])
+            if (exponent[i])
+            {
                 *this *= a;
-
-            if (compareAbsolute (modulus) >= 0)
                 *this %= modulus;
+            }
         }
+
+        return;
     }
-    else
+
+    // This uses a sliding window, so that for each run of up to windowBits bits of the
+    // exponent, there's only one multiplication by one of a table of precalculated odd powers.
+    auto windowBits = numExponentBits > 671 ? 6
+                    : numExponentBits > 239 ? 5
+                    : numExponentBits > 79  ? 4
+                    : numExponentBits > 23  ? 3 : 1;
+
+    auto numWords = sizeNeededToHold (modulus.getHighestBit());
+    BigIntegerWords::MontgomeryMultiplier montgomery (modulus.getValues(), numWords);
+
+    auto toMontgomeryForm = [&] (BigInteger value, uint32* dest)
     {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
+        value <<= (int) numWords * 32;
+        value %= modulus;
+        std::fill (dest, dest + numWords, (uint32) 0);
+        memcpy (dest, value.getValues(), sizeof (uint32) * jmin (numWords, sizeNeededToHold (value.getHighestBit())));
+    };
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+    HeapBlock<uint32> powers (numWords << (windowBits - 1)), result (numWords), square (numWords);
 
-        if (! g.isOne())
-        {
-            BigInteger a (*this);
+    toMontgomeryForm (*this, powers);
+    toMontgomeryForm (1, result);
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                *this *= *this;
+    if (windowBits > 1)
+    {
+        montgomery.multiply (square, powers, powers);
 
-                if (exp[i])
-                    *this *= a;
+        for (size_t i = 1; i < ((size_t) 1 << (windowBits - 1)); ++i)
+            montgomery.multiply (powers + i * numWords, powers + (i - 1) * numWords, square);
+    }
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
-            }
-        }
-        else
+    for (int i = numExponentBits - 1; i >= 0;)
+    {
+        if (! exponent[i])
         {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+            montgomery.multiply (result, result, result);
+            --i;
+            continue;
+        }
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+        auto windowStart = jmax (0, i - windowBits + 1);
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
-            }
+        while (! exponent[windowStart])
+            ++windowStart;
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
-        }
+        auto windowSize = i - windowStart + 1;
+
+        for (int j = 0; j < windowSize; ++j)
+            montgomery.multiply (result, result, result);
+
+        auto oddPower = exponent.getBitRangeAsInt (windowStart, windowSize);
+        montgomery.multiply (result, result, powers + (oddPower >> 1) * numWords);
+
+        i = windowStart - 1;
     }
+
+    // multiplying by 1 takes the value back out of Montgomery form
+    std::fill (square.get(), square + numWords, (uint32) 0);
+    square[0] = 1;
+    montgomery.multiply (result, result, square);
+
+    clear();
+    highestBit = (int) numWords * 32 - 1;
+    memcpy (ensureSize (numWords), result, numWords * sizeof (uint32));
+    highestBit = getHighestBit();
 }
 
 void BigInteger::montgomeryMultiplication (const BigInteger& other, const BigInteger& modulus,
@@ -1333,6 +1650,89 @@ public:
             }
         }
 
+        {
+            beginTest ("Large multiplication and division");
+
+            Random r = getRandom();
+
+            for (int j = 200; --j >= 0;)
+            {
+                BigInteger a, b;
+                r.fillBitsRandomly (a, 0, r.nextInt (4000) + 1);
+                r.fillBitsRandomly (b, 0, r.nextInt (4000) + 1);
+
+                if (b.isZero())
+                    continue;
+
+                auto product = a * b;
+                expect (product / b == a);
+                expect (product % b == 0);
+
+                BigInteger quotient (a), remainder;
+                quotient.divideBy (b, remainder);
+                expect (remainder < b);
+                expect (quotient * b + remainder == a);
+
+                // (a + b)^2 = a^2 + 2ab + b^2 checks the Karatsuba sums against each other
+                auto sum = a + b;
+                expect (sum * sum == a * a + (product << 1) + b * b);
+            }
+        }
+
+        {
+            beginTest ("Modular exponentiation");
+
+            Random r = getRandom();
+
+            auto slowExponentModulo = [] (BigInteger base, const BigInteger& exponent, const BigInteger& modulus)
+            {
+                BigInteger result (1);
+                base %= modulus;
+
+                for (int i = exponent.getHighestBit(); i >= 0; --i)
+                {
+                    result = (result * result) % modulus;
+
+                    if (exponent[i])
+                        result = (result * base) % modulus;
+                }
+
+                return result % modulus;
+            };
+
+            for (int j = 100; --j >= 0;)
+            {
+                BigInteger base, exponent, modulus;
+                r.fillBitsRandomly (base, 0, r.nextInt (1100) + 1);
+                r.fillBitsRandomly (exponent, 0, r.nextInt (700) + 1);
+                r.fillBitsRandomly (modulus, 0, r.nextInt (1100) + 2);
+
+                if (modulus.isZero())
+                    continue;
+
+                auto result = base;
+                result.exponentModulo (exponent, modulus);
+                expect (result == slowExponentModulo (base, exponent, modulus));
+            }
+
+            // Fermat's little theorem, with the Mersenne prime 2^127 - 1
+            BigInteger prime;
+            prime.setRange (0, 127, true);
+
+            for (int j = 20; --j >= 0;)
+            {
+                BigInteger a;
+                r.fillBitsRandomly (a, 0, 120);
+                a += 2;
+                a.exponentModulo (prime - 1, prime);
+                expect (a.isOne());
+            }
+
+            BigInteger x (12345);
+            x.exponentModulo (0, prime);
+            expect (x.isOne());
+        }
+
         {
             beginTest ("Bit setting");
 
@@ -1173,4 +1173,468 @@ String Expression::Scope::getScopeUID() const
     return {};
 }
 
+//==============================================================================
+Expression::Program::Program() {}
+Expression::Program::~Program() {}
+
+Expression::Program::Program (const Expression& expression)
+{
+    if (expression.term != nullptr)
+    {
+        int stackSize = 0;
+        compile (expression, stackSize);
+    }
+}
+
+void Expression::Program::compile (const Expression& e, int& stackSize)
+{
+    auto& t = *e.term;
+    auto type = t.getType();
+
+    if (type == constantType)
+    {
+        instructions.add ({ OpCode::pushConstant, 0, t.toDouble() });
+        ++stackSize;
+    }
+    else if (type == symbolType || (type == operatorType && t.getName() == "."))
+    {
+        // (a dotted symbol is resolved as a whole, so it gets a single slot)
+        instructions.add ({ OpCode::pushSymbol, getSymbolSlot (e), 0.0 });
+        ++stackSize;
+    }
+    else if (type == functionType)
+    {
+        auto numParams = t.getNumInputs();
+
+        for (int i = 0; i < numParams; ++i)
+            compile (Expression (t.getInput (i)), stackSize);
+
+        functions.add ({ t.getName(), numParams });
+        instructions.add ({ OpCode::callFunction, functions.size() - 1, 0.0 });
+        stackSize += 1 - numParams;
+    }
+    else if (t.getNumInputs() == 1)
+    {
+        compile (Expression (t.getInput (0)), stackSize);
+        instructions.add ({ OpCode::negate, 0, 0.0 });
+    }
+    else
+    {
+        jassert (t.getNumInputs() == 2);
+
+        compile (Expression (t.getInput (0)), stackSize);
+        compile (Expression (t.getInput (1)), stackSize);
+
+        auto op = t.getName();
+        instructions.add ({ op == "+" ? OpCode::add
+                                      : (op == "-" ? OpCode::subtract
+                                                   : (op == "*" ? OpCode::multiply : OpCode::divide)), 0, 0.0 });
+        --stackSize;
+    }
+
+    maxStackSize = jmax (maxStackSize, stackSize);
+}
+
+int Expression::Program::getSymbolSlot (const Expression& e)
+{
+    auto name = e.toString();
+    auto index = symbolNames.indexOf (name);
+
+    if (index < 0)
+    {
+        index = symbolNames.size();
+        symbolNames.add (name);
+        symbols.add (e);
+    }
+
+    return index;
+}
+
+int Expression::Program::getNumSymbols() const noexcept                     { return symbolNames.size(); }
+String Expression::Program::getSymbolName (int index) const                 { return symbolNames[index]; }
+int Expression::Program::indexOfSymbol (const String& symbolName) const     { return symbolNames.indexOf (symbolName); }
+
+double Expression::Program::run (const double* symbolValues, const Scope& scope) const
+{
+    double localStack[32];
+    HeapBlock<double> heapStack;
+    auto* stack = localStack;
+
+    if (maxStackSize > numElementsInArray (localStack))
+    {
+        heapStack.malloc ((size_t) maxStackSize);
+        stack = heapStack;
+    }
+
+    int numOnStack = 0;
+
+    for (auto& i : instructions)
+    {
+        switch (i.opCode)
+        {
+            case OpCode::pushConstant:  stack[numOnStack++] = i.value; break;
+            case OpCode::pushSymbol:    stack[numOnStack++] = symbolValues[i.index]; break;
+            case OpCode::add:           --numOnStack; stack[numOnStack - 1] += stack[numOnStack]; break;
+            case OpCode::subtract:      --numOnStack; stack[numOnStack - 1] -= stack[numOnStack]; break;
+            case OpCode::multiply:      --numOnStack; stack[numOnStack - 1] *= stack[numOnStack]; break;
+            case OpCode::divide:        --numOnStack; stack[numOnStack - 1] /= stack[numOnStack]; break;
+            case OpCode::negate:        stack[numOnStack - 1] = -stack[numOnStack - 1]; break;
+
+            case OpCode::callFunction:
+            {
+                auto& f = functions.getReference (i.index);
+                numOnStack -= f.numParameters;
+                stack[numOnStack] = scope.evaluateFunction (f.name, f.numParameters > 0 ? stack + numOnStack : nullptr, f.numParameters);
+                ++numOnStack;
+                break;
+            }
+
+            default: jassertfalse; break;
+        }
+    }
+
+    return numOnStack > 0 ? stack[0] : 0.0;
+}
+
+double Expression::Program::evaluate (const double* symbolValues) const
+{
+    String error;
+    return evaluate (symbolValues, Scope(), error);
+}
+
+double Expression::Program::evaluate (const double* symbolValues, const Scope& scope, String& evaluationError) const
+{
+    try
+    {
+        return run (symbolValues, scope);
+    }
+    catch (Helpers::EvaluationError& e)
+    {
+        evaluationError = e.description;
+    }
+
+    return 0;
+}
+
+double Expression::Program::evaluate (const Scope& scope, String& evaluationError) const
+{
+    try
+    {
+        auto numSymbols = symbols.size();
+        HeapBlock<double> values ((size_t) jmax (1, numSymbols));
+
+        for (int i = 0; i < numSymbols; ++i)
+            values[i] = symbols.getReference (i).term->resolve (scope, 0)->toDouble();
+
+        return run (values, scope);
+    }
+    catch (Helpers::EvaluationError& e)
+    {
+        evaluationError = e.description;
+    }
+
+    return 0;
+}
+
+//==============================================================================
+struct Expression::DependencyGraph::Node
+{
+    Node (const String& nodeName) : name (nodeName) {}
+
+    const String name;
+    Program program;
+    Array<int> inputs, dependents;   // indexes of other nodes
+    Array<double> inputValues;
+    double value = 0;
+    bool isExpression = false, isOutOfDate = false, isBeingEvaluated = false, hasChanged = false;
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+Expression::DependencyGraph::DependencyGraph() {}
+Expression::DependencyGraph::~DependencyGraph() {}
+
+int Expression::DependencyGraph::getOrCreateNode (const String& name)
+{
+    if (nodeIndexes.contains (name))
+        return nodeIndexes[name];
+
+    auto index = nodes.size();
+    nodes.add (new Node (name));
+    nodeIndexes.set (name, index);
+    return index;
+}
+
+void Expression::DependencyGraph::setExpression (const String& name, const Expression& expression)
+{
+    auto index = getOrCreateNode (name);
+    auto& node = *nodes.getUnchecked (index);
+
+    for (auto input : node.inputs)
+        nodes.getUnchecked (input)->dependents.removeFirstMatchingValue (index);
+
+    node.program = Program (expression);
+    node.inputs.clearQuick();
+
+    for (int i = 0; i < node.program.getNumSymbols(); ++i)
+    {
+        auto input = getOrCreateNode (node.program.getSymbolName (i));
+        node.inputs.add (input);
+        nodes.getUnchecked (input)->dependents.addIfNotAlreadyThere (index);
+    }
+
+    node.inputValues.resize (node.inputs.size());
+    node.isExpression = true;
+    node.isOutOfDate = true;
+    node.hasChanged = true;
+    markDependentsAsOutOfDate (node);
+}
+
+void Expression::DependencyGraph::removeExpression (const String& name)
+{
+    if (nodeIndexes.contains (name))
+    {
+        auto index = nodeIndexes[name];
+        auto& node = *nodes.getUnchecked (index);
+
+        if (node.isExpression)
+        {
+            for (auto input : node.inputs)
+                nodes.getUnchecked (input)->dependents.removeFirstMatchingValue (index);
+
+            node.program = Program();
+            node.inputs.clear();
+            node.inputValues.clear();
+            node.isExpression = false;
+            node.isOutOfDate = false;
+            node.hasChanged = false;
+            node.value = 0;
+            markDependentsAsOutOfDate (node);
+        }
+    }
+}
+
+void Expression::DependencyGraph::setInput (const String& name, double newValue)
+{
+    auto& node = *nodes.getUnchecked (getOrCreateNode (name));
+
+    if (! node.isExpression && node.value != newValue)
+    {
+        node.value = newValue;
+        markDependentsAsOutOfDate (node);
+    }
+}
+
+double Expression::DependencyGraph::getValue (const String& name)
+{
+    if (! nodeIndexes.contains (name))
+        return 0;
+
+    auto& node = *nodes.getUnchecked (nodeIndexes[name]);
+    bringUpToDate (node);
+    return node.value;
+}
+
+StringArray Expression::DependencyGraph::updateValues()
+{
+    StringArray changed;
+
+    for (auto* node : nodes)
+    {
+        bringUpToDate (*node);
+
+        if (node->hasChanged)
+        {
+            node->hasChanged = false;
+            changed.add (node->name);
+        }
+    }
+
+    return changed;
+}
+
+void Expression::DependencyGraph::markDependentsAsOutOfDate (Node& node)
+{
+    for (auto index : node.dependents)
+    {
+        auto& dependent = *nodes.getUnchecked (index);
+
+        if (! dependent.isOutOfDate)
+        {
+            dependent.isOutOfDate = true;
+            markDependentsAsOutOfDate (dependent);
+        }
+    }
+}
+
+bool Expression::DependencyGraph::bringUpToDate (Node& node)
+{
+    if (! node.isOutOfDate)
+        return true;
+
+    if (node.isBeingEvaluated)
+        return false; // a circular reference
+
+    node.isBeingEvaluated = true;
+    bool inputsAreValid = true;
+
+    for (int i = 0; i < node.inputs.size(); ++i)
+    {
+        auto& input = *nodes.getUnchecked (node.inputs.getUnchecked (i));
+        inputsAreValid = bringUpToDate (input) && inputsAreValid;
+        node.inputValues.setUnchecked (i, input.value);
+    }
+
+    auto newValue = inputsAreValid ? node.program.evaluate (node.inputValues.getRawDataPointer()) : 0.0;
+    ++numEvaluations;
+
+    if (newValue != node.value)
+    {
+        node.value = newValue;
+        node.hasChanged = true;
+    }
+
+    node.isOutOfDate = false;
+    node.isBeingEvaluated = false;
+    return inputsAreValid;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ExpressionTests  : public UnitTest
+{
+public:
+    ExpressionTests() : UnitTest ("Expression", "Maths") {}
+
+    struct TestScope  : public Expression::Scope
+    {
+        Expression getSymbolValue (const String& symbol) const override
+        {
+            if (symbol == "a")  return Expression (3.0);
+            if (symbol == "b")  return Expression (4.0);
+            if (symbol == "c")  return Expression::symbol ("a") * Expression (2.0);
+
+            return Expression::Scope::getSymbolValue (symbol);
+        }
+
+        void visitRelativeScope (const String& scopeName, Visitor& visitor) const override
+        {
+            if (scopeName == "parent")
+            {
+                struct ParentScope  : public Expression::Scope
+                {
+                    Expression getSymbolValue (const String& symbol) const override
+                    {
+                        return Expression (symbol == "width" ? 100.0 : 0.0);
+                    }
+                };
+
+                visitor.visit (ParentScope());
+                return;
+            }
+
+            Expression::Scope::visitRelativeScope (scopeName, visitor);
+        }
+    };
+
+    void runTest() override
+    {
+        beginTest ("Programs give the same results as Expressions");
+        {
+            TestScope scope;
+
+            for (auto text : { "1 + 2 * 3", "(a + b) / 2 - -c", "-(a - b) * max (a, b, c) + min (1, 2)",
+                               "parent.width / 2 - a", "sin (0) + abs (-b)", "a / 0", "1 - 2 - 3 + 4" })
+            {
+                String error;
+                Expression e (text, error);
+                expect (error.isEmpty());
+
+                String programError;
+                Expression::Program program (e);
+                auto expected = e.evaluate (scope);
+                auto result = program.evaluate (scope, programError);
+
+                expect (programError.isEmpty());
+                expect (result == expected || (std::isnan (result) && std::isnan (expected)), text);
+            }
+
+            String error;
+            Expression::Program program (Expression ("unknownSymbol + 1", error));
+            program.evaluate (scope, error);
+            expect (error.isNotEmpty());
+        }
+
+        beginTest ("Supplying symbol values");
+        {
+            String error;
+            Expression::Program program (Expression ("x * x + y - parent.left + x", error));
+
+            expectEquals (program.getNumSymbols(), 3);
+            expectEquals (program.getSymbolName (2), String ("parent.left"));
+
+            double values[3];
+            values[program.indexOfSymbol ("x")] = 3.0;
+            values[program.indexOfSymbol ("y")] = 5.0;
+            values[program.indexOfSymbol ("parent.left")] = 1.0;
+
+            expectEquals (program.evaluate (values), 16.0);
+            expectEquals (Expression::Program().evaluate (nullptr), 0.0);
+        }
+
+        beginTest ("Dependency graph");
+        {
+            String error;
+            Expression::DependencyGraph graph;
+            graph.setExpression ("left",   Expression ("margin", error));
+            graph.setExpression ("right",  Expression ("width - margin", error));
+            graph.setExpression ("centre", Expression ("(left + right) / 2", error));
+            graph.setExpression ("top",    Expression ("margin * 2", error));
+
+            graph.setInput ("width", 500.0);
+            graph.setInput ("margin", 10.0);
+
+            auto changed = graph.updateValues();
+            changed.sort (false);
+            expect (changed == StringArray ({ "centre", "left", "right", "top" }));
+            expectEquals (graph.getValue ("centre"), 250.0);
+            expectEquals (graph.getValue ("right"), 490.0);
+
+            auto numEvaluations = graph.getNumEvaluations();
+            graph.setInput ("width", 600.0);
+            changed = graph.updateValues();
+            changed.sort (false);
+
+            expect (changed == StringArray ({ "centre", "right" }));
+            expectEquals (graph.getNumEvaluations() - numEvaluations, 2);
+            expectEquals (graph.getValue ("centre"), 300.0);
+
+            numEvaluations = graph.getNumEvaluations();
+            graph.setInput ("width", 600.0);
+            expect (graph.updateValues().isEmpty());
+            expectEquals (graph.getNumEvaluations(), numEvaluations);
+
+            graph.setExpression ("left", Expression ("margin * 3", error));
+            expectEquals (graph.getValue ("centre"), 310.0);
+            expectEquals (graph.getValue ("top"), 20.0);
+
+            graph.removeExpression ("left");
+            graph.setInput ("left", 100.0);
+            expectEquals (graph.getValue ("centre"), 345.0);
+
+            graph.setExpression ("a", Expression ("b + 1", error));
+            graph.setExpression ("b", Expression ("a + 1", error));
+            expectEquals (graph.getValue ("a"), 0.0);
+            expectEquals (graph.getValue ("b"), 0.0);
+        }
+    }
+};
+
+static ExpressionTests expressionTests;
+
+#endif
+
 } // namespace juce
@@ -237,6 +237,193 @@ public:
     */
     Expression getInput (int index) const;
 
+    //==============================================================================
+    /**
+        A flattened form of an Expression, which is much quicker to evaluate repeatedly.
+
+        Evaluating an Expression walks its tree of terms, creating a new term object for
+        each intermediate result, and looks up every symbol by name each time. A Program
+        turns the tree into a list of postfix instructions that run on a small stack, and
+        gives each distinct symbol a numbered slot, so that you can supply the symbol values
+        as a plain array. A dotted symbol such as "parent.left" gets a single slot, whose
+        name is the whole dotted string.
+
+        E.g.
+        @code
+        Expression::Program program (Expression ("width / 2 - margin", error));
+
+        auto widthSlot  = program.indexOfSymbol ("width");
+        auto marginSlot = program.indexOfSymbol ("margin");
+
+        double values[2];
+        values[widthSlot] = 400.0;
+        values[marginSlot] = 10.0;
+
+        auto result = program.evaluate (values);  // 190.0
+        @endcode
+
+        @see Expression::DependencyGraph
+    */
+    class JUCE_API  Program
+    {
+    public:
+        /** Creates a program that always returns 0. */
+        Program();
+
+        /** Compiles an expression. */
+        explicit Program (const Expression& expression);
+
+        /** Destructor. */
+        ~Program();
+
+        /** Creates a copy of another program. */
+        Program (const Program&) = default;
+
+        /** Copies another program. */
+        Program& operator= (const Program&) = default;
+
+        /** Returns the number of distinct symbols that the expression uses. */
+        int getNumSymbols() const noexcept;
+
+        /** Returns the name of one of the symbols, e.g. "x" or "parent.left". */
+        String getSymbolName (int index) const;
+
+        /** Returns the slot number used by a symbol, or -1 if the expression doesn't use it. */
+        int indexOfSymbol (const String& symbolName) const;
+
+        /** Evaluates the program, given the values of each of its symbols.
+
+            The symbolValues array must contain getNumSymbols() values, in slot order.
+            Any function calls are handled by a default Scope, so only the basic functions
+            such as min, max, sin, etc. can be used, and unknown ones will evaluate to 0.
+        */
+        double evaluate (const double* symbolValues) const;
+
+        /** Evaluates the program, given the values of each of its symbols, and using a scope
+            to perform any functions that it calls.
+        */
+        double evaluate (const double* symbolValues, const Scope& scope, String& evaluationError) const;
+
+        /** Evaluates the program, using a scope to find the values of its symbols.
+            This gives the same result as Expression::evaluate (const Scope&, String&).
+        */
+        double evaluate (const Scope& scope, String& evaluationError) const;
+
+    private:
+        //==============================================================================
+        enum class OpCode  { pushConstant, pushSymbol, add, subtract, multiply, divide, negate, callFunction };
+
+        struct Instruction
+        {
+            OpCode opCode;
+            int index;      // the symbol or function index
+            double value;   // the constant, for pushConstant
+        };
+
+        struct Function
+        {
+            String name;
+            int numParameters;
+        };
+
+        Array<Instruction> instructions;
+        Array<Function> functions;
+        Array<Expression> symbols;
+        StringArray symbolNames;
+        int maxStackSize = 1;
+
+        void compile (const Expression&, int& stackSize);
+        int getSymbolSlot (const Expression&);
+        double run (const double* symbolValues, const Scope&) const;
+
+        JUCE_LEAK_DETECTOR (Program)
+    };
+
+    //==============================================================================
+    /**
+        A set of named expressions which can refer to each other, which keeps track of
+        which ones depend on which, so that when something changes, only the expressions
+        that are affected by it get evaluated again.
+
+        Any symbol that's used by one of the expressions but isn't the name of another
+        expression is treated as an input, whose value you set with setInput(). Inputs
+        start off with a value of 0.
+
+        This is handy for things like layouts, where a lot of positions are defined
+        in terms of each other, and only a few of them change at a time:
+        @code
+        Expression::DependencyGraph graph;
+        graph.setExpression ("left",  Expression ("margin", error));
+        graph.setExpression ("right", Expression ("width - margin", error));
+        graph.setExpression ("centre", Expression ("(left + right) / 2", error));
+
+        graph.setInput ("width", 500.0);
+        graph.setInput ("margin", 10.0);
+
+        for (auto& name : graph.updateValues())
+            moveSomethingTo (name, graph.getValue (name));
+        @endcode
+
+        All the expressions are compiled into Programs, and any functions that they call
+        are handled by a default Scope. A set of expressions which refer to each other in a
+        loop will all evaluate to 0.
+
+        This class isn't thread-safe.
+
+        @see Expression::Program
+    */
+    class JUCE_API  DependencyGraph
+    {
+    public:
+        /** Creates an empty graph. */
+        DependencyGraph();
+
+        /** Destructor. */
+        ~DependencyGraph();
+
+        /** Adds a named expression, or replaces the expression that has this name. */
+        void setExpression (const String& name, const Expression& expression);
+
+        /** Removes a named expression.
+            If other expressions use its name, it'll be turned back into an input.
+        */
+        void removeExpression (const String& name);
+
+        /** Changes the value of an input.
+            If the name belongs to an expression, this does nothing.
+        */
+        void setInput (const String& name, double newValue);
+
+        /** Returns the current value of an expression or input.
+            If the value is out-of-date, this will evaluate it, along with anything that
+            it depends on which is also out-of-date.
+        */
+        double getValue (const String& name);
+
+        /** Brings all the expressions up-to-date.
+            @returns the names of the expressions whose values have changed since the last
+                     time they were evaluated (or which have been evaluated for the first time)
+        */
+        StringArray updateValues();
+
+        /** Returns the number of times an expression has been evaluated since the graph was created. */
+        int getNumEvaluations() const noexcept      { return numEvaluations; }
+
+    private:
+        //==============================================================================
+        struct Node;
+        friend struct ContainerDeletePolicy<Node>;
+        OwnedArray<Node> nodes;
+        HashMap<String, int> nodeIndexes;
+        int numEvaluations = 0;
+
+        int getOrCreateNode (const String&);
+        void markDependentsAsOutOfDate (Node&);
+        bool bringUpToDate (Node&);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DependencyGraph)
+    };
+
 private:
     //==============================================================================
     class Term;
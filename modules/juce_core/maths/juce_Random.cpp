@@ -151,6 +151,119 @@ void Random::fillBitsRandomly (BigInteger& arrayToChange, int startBit, int numB
         arrayToChange.setBit (startBit + numBits, nextBool());
 }
 
+//==============================================================================
+namespace RandomHelpers
+{
+    // A set of independent xoshiro128+ generators, stored lane-by-lane so that
+    // stepping them all at once turns into a handful of vector instructions.
+    struct BlockGenerator
+    {
+        enum { numLanes = 16 };
+
+        BlockGenerator (uint64 seed) noexcept
+        {
+            // splitmix64 expands the seed into all the generators' states, as
+            // recommended by the xoshiro authors
+            for (auto* word : { s0, s1, s2, s3 })
+            {
+                for (int i = 0; i < numLanes; i += 2)
+                {
+                    auto z = (seed += 0x9e3779b97f4a7c15ULL);
+                    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                    z ^= z >> 31;
+
+                    word[i]     = (uint32) z;
+                    word[i + 1] = (uint32) (z >> 32);
+                }
+            }
+        }
+
+        // Fills numLanes floats in the range 0 to 1.0 (exclusive), or if excludeZero
+        // is true, in the range above 0 up to 1.0 (inclusive)
+        void nextFloats (float* results, bool excludeZero) noexcept
+        {
+            auto offset = excludeZero ? 1 : 0;
+
+            for (int i = 0; i < numLanes; ++i)
+            {
+                auto bits = s0[i] + s3[i];
+                auto t = s1[i] << 9;
+
+                s2[i] ^= s0[i];
+                s3[i] ^= s1[i];
+                s1[i] ^= s2[i];
+                s0[i] ^= s3[i];
+                s2[i] ^= t;
+                s3[i] = (s3[i] << 11) | (s3[i] >> 21);
+
+                results[i] = (float) ((int) (bits >> 8) + offset) * (1.0f / 16777216.0f);
+            }
+        }
+
+        // each word of the state is kept in its own array, which is what lets the
+        // compiler step all the lanes together
+        uint32 s0[numLanes], s1[numLanes], s2[numLanes], s3[numLanes];
+    };
+}
+
+void Random::fillBuffer (float* destination, int numValues, Distribution distribution) noexcept
+{
+    using namespace RandomHelpers;
+
+    jassert (destination != nullptr || numValues <= 0);
+
+    BlockGenerator generator ((uint64) nextInt64());
+    const int numLanes = BlockGenerator::numLanes;
+
+    const int blockSize = distribution == gaussian ? numLanes * 2 : numLanes;
+
+    float a[numLanes], b[numLanes], partialBlock[numLanes * 2];
+
+    while (numValues > 0)
+    {
+        // whole blocks are written straight into the destination
+        auto* d = numValues >= blockSize ? destination : partialBlock;
+
+        if (distribution == uniform)
+        {
+            generator.nextFloats (d, false);
+        }
+        else if (distribution == triangular)
+        {
+            generator.nextFloats (a, false);
+            generator.nextFloats (b, false);
+
+            for (int i = 0; i < numLanes; ++i)
+                d[i] = a[i] - b[i];
+        }
+        else
+        {
+            // Box-Muller transform, which produces two values from each pair of uniform values
+            generator.nextFloats (a, true);
+            generator.nextFloats (b, false);
+
+            for (int i = 0; i < numLanes; ++i)
+            {
+                auto radius = std::sqrt (-2.0f * std::log (a[i]));
+                auto angle = 2.0f * MathConstants<float>::pi * b[i];
+
+                d[i]            = radius * std::cos (angle);
+                d[i + numLanes] = radius * std::sin (angle);
+            }
+        }
+
+        if (d == partialBlock)
+        {
+            memcpy (destination, partialBlock, sizeof (float) * (size_t) numValues);
+            return;
+        }
+
+        destination += blockSize;
+        numValues -= blockSize;
+    }
+}
+
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
@@ -178,6 +291,56 @@ public:
             n = r.nextInt (0x7ffffffe) + 1;
             expect (r.nextInt (n) >= 0 && r.nextInt (n) < n);
         }
+
+        beginTest ("fillBuffer");
+
+        const int numValues = 100003;
+        HeapBlock<float> values (numValues);
+
+        for (auto distribution : { Random::uniform, Random::triangular, Random::gaussian })
+        {
+            double sum = 0, sumOfSquares = 0;
+            auto minValue = std::numeric_limits<float>::max();
+            auto maxValue = -minValue;
+
+            r.fillBuffer (values, numValues, distribution);
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                sum += values[i];
+                sumOfSquares += values[i] * values[i];
+                minValue = jmin (minValue, values[i]);
+                maxValue = jmax (maxValue, values[i]);
+            }
+
+            auto mean = sum / numValues;
+            auto variance = sumOfSquares / numValues - mean * mean;
+
+            if (distribution == Random::uniform)
+            {
+                expect (minValue >= 0.0f && maxValue < 1.0f);
+                expect (std::abs (mean - 0.5) < 0.01 && std::abs (variance - 1.0 / 12.0) < 0.01);
+            }
+            else if (distribution == Random::triangular)
+            {
+                expect (minValue > -1.0f && maxValue < 1.0f);
+                expect (std::abs (mean) < 0.01 && std::abs (variance - 1.0 / 6.0) < 0.01);
+            }
+            else
+            {
+                expect (std::abs (mean) < 0.02 && std::abs (variance - 1.0) < 0.03);
+            }
+        }
+
+        {
+            HeapBlock<float> first (numValues), second (numValues);
+            Random r1 (1234), r2 (1234);
+
+            r1.fillBuffer (first, numValues);
+            r2.fillBuffer (second, numValues);
+            expect (memcmp (first, second, sizeof (float) * numValues) == 0);
+            expect (r1.getSeed() == r2.getSeed() && r1.getSeed() != 1234);
+        }
     }
 };
 
@@ -96,6 +96,27 @@ public:
     /** Sets a range of bits in a BigInteger to random values. */
     void fillBitsRandomly (BigInteger& arrayToChange, int startBit, int numBits);
 
+    //==============================================================================
+    /** The shapes of distribution that fillBuffer() can produce. */
+    enum Distribution
+    {
+        uniform,     /**< Values in the range 0 (inclusive) to 1.0 (exclusive), like nextFloat(). */
+        triangular,  /**< Values in the range -1.0 to 1.0, most likely near 0. This is the
+                          difference of two uniform values, as used for TPDF dither. */
+        gaussian     /**< Normally-distributed values, with a mean of 0 and a standard deviation of 1. */
+    };
+
+    /** Fills a block of floats with random values.
+
+        This is much quicker than calling nextFloat() for each value, so it's the one
+        to use for generating noise or dither in audio code. The values come from a
+        set of xoshiro128+ generators which run side-by-side, so the compiler can
+        vectorise them. Those generators are seeded from this object, so the results
+        are repeatable for a given seed, and each call advances the seed by the same
+        amount as a call to nextInt64().
+    */
+    void fillBuffer (float* destination, int numValues, Distribution distribution = uniform) noexcept;
+
     //==============================================================================
     /** Resets this Random object to a given seed value. */
     void setSeed (int64 newSeed) noexcept;
@@ -128,6 +128,7 @@ public:
     */
     ~HeapBlock()
     {
+        checkRealtimeSafetyOfFree();
         std::free (data);
     }
 
@@ -270,6 +271,7 @@ public:
     */
     void free() noexcept
     {
+        checkRealtimeSafetyOfFree();
         std::free (data);
         data = nullptr;
     }
@@ -302,6 +304,8 @@ private:
 
     void throwOnAllocationFailure() const
     {
+        JUCE_REALTIME_SAFETY_CHECK (memoryAllocation);
+
        #if JUCE_EXCEPTIONS_DISABLED
         jassert (data != nullptr); // without exceptions, you'll need to find a better way to handle this failure case.
        #else
@@ -309,6 +313,14 @@ private:
        #endif
     }
 
+    void checkRealtimeSafetyOfFree() const noexcept
+    {
+       #if JUCE_CHECK_REALTIME_SAFETY
+        if (data != nullptr)
+            RealtimeSafety::check (RealtimeSafety::memoryDeallocation);
+       #endif
+    }
+
    #if ! (defined (JUCE_DLL) || defined (JUCE_DLL_BUILD))
     JUCE_DECLARE_NON_COPYABLE (HeapBlock)
     JUCE_PREVENT_HEAP_ALLOCATION // Creating a 'new HeapBlock' would be missing the point!
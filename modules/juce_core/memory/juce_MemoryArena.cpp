@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MemoryArena::Chunk
+{
+    Chunk* next;
+    size_t size;
+    bool isOwned;
+
+    char* getData() noexcept    { return reinterpret_cast<char*> (this + 1); }
+};
+
+static char* alignPointer (char* p, size_t alignment) noexcept
+{
+    jassert (isPowerOfTwo (alignment));
+    auto address = reinterpret_cast<pointer_sized_uint> (p);
+    return reinterpret_cast<char*> ((address + alignment - 1) & ~(pointer_sized_uint) (alignment - 1));
+}
+
+//==============================================================================
+MemoryArena::MemoryArena (size_t sizeOfChunks) noexcept
+    : chunkSize (sizeOfChunks)
+{
+}
+
+MemoryArena::MemoryArena (void* preallocatedMemory, size_t preallocatedSize, size_t sizeOfChunks) noexcept
+    : chunkSize (sizeOfChunks)
+{
+    auto* start = alignPointer (static_cast<char*> (preallocatedMemory), alignof (Chunk));
+    auto* end = static_cast<char*> (preallocatedMemory) + preallocatedSize;
+
+    if (preallocatedMemory != nullptr && start + sizeof (Chunk) < end)
+    {
+        firstChunk = currentChunk = reinterpret_cast<Chunk*> (start);
+        firstChunk->next = nullptr;
+        firstChunk->size = (size_t) (end - firstChunk->getData());
+        firstChunk->isOwned = false;
+    }
+}
+
+MemoryArena::~MemoryArena()
+{
+    for (auto* c = firstChunk; c != nullptr;)
+    {
+        auto* next = c->next;
+
+        if (c->isOwned)
+            std::free (c);
+
+        c = next;
+    }
+}
+
+//==============================================================================
+void* MemoryArena::allocate (size_t numBytes, size_t alignment) noexcept
+{
+    for (;;)
+    {
+        if (currentChunk != nullptr)
+        {
+            auto* data = currentChunk->getData();
+            auto* start = alignPointer (data + position, alignment);
+
+            if (start + numBytes <= data + currentChunk->size)
+            {
+                position = (size_t) (start + numBytes - data);
+                lastAllocation = start;
+                return start;
+            }
+
+            if (currentChunk->next != nullptr)
+            {
+                currentChunk = currentChunk->next;
+                position = 0;
+                lastAllocation = nullptr;
+                continue;
+            }
+        }
+
+        if (! addChunk (numBytes + alignment))
+            return nullptr;
+    }
+}
+
+void* MemoryArena::reallocate (void* block, size_t oldNumBytes, size_t newNumBytes, size_t alignment) noexcept
+{
+    if (block == nullptr)
+        return allocate (newNumBytes, alignment);
+
+    auto* b = static_cast<char*> (block);
+
+    if (b == lastAllocation)
+    {
+        auto* data = currentChunk->getData();
+
+        if (b + newNumBytes <= data + currentChunk->size)
+        {
+            position = (size_t) (b + newNumBytes - data);
+            return block;
+        }
+    }
+    else if (newNumBytes <= oldNumBytes)
+    {
+        return block;
+    }
+
+    auto* newBlock = allocate (newNumBytes, alignment);
+
+    if (newBlock != nullptr)
+        memcpy (newBlock, block, jmin (oldNumBytes, newNumBytes));
+
+    return newBlock;
+}
+
+void MemoryArena::deallocate (void* block, size_t numBytes) noexcept
+{
+    auto* b = static_cast<char*> (block);
+
+    if (b != nullptr && b == lastAllocation
+         && b + numBytes == currentChunk->getData() + position)
+    {
+        position = (size_t) (b - currentChunk->getData());
+        lastAllocation = nullptr;
+    }
+}
+
+void MemoryArena::reset() noexcept
+{
+    currentChunk = firstChunk;
+    position = 0;
+    lastAllocation = nullptr;
+}
+
+size_t MemoryArena::getCapacity() const noexcept
+{
+    size_t total = 0;
+
+    for (auto* c = firstChunk; c != nullptr; c = c->next)
+        total += c->size;
+
+    return total;
+}
+
+bool MemoryArena::addChunk (size_t minimumSize) noexcept
+{
+    auto size = jmax (chunkSize, minimumSize);
+    auto* c = static_cast<Chunk*> (std::malloc (sizeof (Chunk) + size));
+
+    if (c == nullptr)
+    {
+        jassertfalse; // out of memory!
+        return false;
+    }
+
+    c->size = size;
+    c->isOwned = true;
+
+    // new chunks go after the current one, so that any bigger ones further along can still be used
+    if (currentChunk != nullptr)
+    {
+        c->next = currentChunk->next;
+        currentChunk->next = c;
+    }
+    else
+    {
+        c->next = firstChunk;
+        firstChunk = c;
+    }
+
+    currentChunk = c;
+    position = 0;
+    lastAllocation = nullptr;
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MemoryArenaTests  : public UnitTest
+{
+public:
+    MemoryArenaTests() : UnitTest ("MemoryArena", "Memory") {}
+
+    void runTest() override
+    {
+        beginTest ("Allocation");
+        {
+            MemoryArena arena (256);
+
+            auto* a = static_cast<char*> (arena.allocate (10));
+            auto* b = static_cast<char*> (arena.allocate (100, 64));
+            expect (a != nullptr && b != nullptr);
+            expect ((reinterpret_cast<pointer_sized_uint> (b) & 63) == 0);
+            expect (b >= a + 10);
+
+            auto* big = arena.allocate (1000);
+            expect (big != nullptr);
+            memset (big, 1, 1000);
+            expect (arena.getCapacity() >= 1256);
+
+            auto capacity = arena.getCapacity();
+            arena.reset();
+
+            for (int i = 0; i < 10; ++i)
+                arena.allocate (100);
+
+            expectEquals ((int) arena.getCapacity(), (int) capacity);
+        }
+
+        beginTest ("Reallocation");
+        {
+            MemoryArena arena (256);
+
+            auto* a = static_cast<char*> (arena.allocate (8));
+            memcpy (a, "abcdefg", 8);
+            expect (arena.reallocate (a, 8, 64) == a);
+
+            auto* b = arena.allocate (8);
+            auto* a2 = static_cast<char*> (arena.reallocate (a, 64, 128));
+            expect (a2 != a && a2 != b);
+            expect (String (a2) == "abcdefg");
+
+            arena.deallocate (a2, 128);
+            expect (arena.allocate (128) == a2);
+        }
+
+        beginTest ("Preallocated memory");
+        {
+            char space[512];
+            MemoryArena arena (space, sizeof (space));
+
+            auto* a = static_cast<char*> (arena.allocate (100));
+            expect (a >= space && a + 100 <= space + sizeof (space));
+            expect (arena.getCapacity() <= sizeof (space));
+
+            auto* b = static_cast<char*> (arena.allocate (1000));
+            expect (b != nullptr && (b + 1000 <= space || b >= space + sizeof (space)));
+        }
+
+        beginTest ("Arrays");
+        {
+            char space[256];
+            MemoryArena arena (space, sizeof (space), 1024);
+
+            Array<int, DummyCriticalSection, 0, MemoryArena::Allocator> array (arena);
+
+            for (int i = 0; i < 1000; ++i)
+                array.add (i);
+
+            expectEquals (array.size(), 1000);
+            expectEquals (array[500], 500);
+
+            auto copy = array;
+            copy.removeRange (0, 10);
+            expectEquals (copy.getFirst(), 10);
+            expectEquals (array.getFirst(), 0);
+
+            Array<int> heapArray (array.begin(), array.size());
+            expectEquals (heapArray.getLast(), 999);
+
+            array.clear();
+            expect (array.isEmpty());
+
+            Array<int, DummyCriticalSection, 0, MemoryArena::Allocator> unattached;
+            unattached.addArray (heapArray);
+            expectEquals (unattached.size(), 1000);
+        }
+    }
+};
+
+static MemoryArenaTests memoryArenaTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast, monotonic allocator that hands out memory from a few large chunks.
+
+    Each allocation just bumps a pointer along the current chunk, and individual
+    blocks are never really freed - instead, reset() makes all of the arena's
+    memory available again at once, without giving any of it back to the system.
+    That makes it a good fit for temporary structures that get built and thrown
+    away repeatedly, like the scratch data for a parser, or for a block of audio.
+
+    If you give it a block of preallocated memory (e.g. a buffer on the stack), the
+    arena will use that before it touches the heap, so if the buffer's big enough,
+    allocating from it is realtime-safe. Otherwise, it'll allocate more chunks as
+    it needs them, and keep them until it's deleted.
+
+    To make an Array keep its elements in an arena, give it a MemoryArena::Allocator:
+    @code
+    char stackSpace[1024];
+    MemoryArena arena (stackSpace, sizeof (stackSpace));
+
+    Array<int, DummyCriticalSection, 0, MemoryArena::Allocator> numbers (arena);
+    numbers.add (1);
+    @endcode
+
+    The arena must outlive anything that has been allocated from it, and a MemoryArena
+    isn't thread-safe, so only use it from one thread at a time.
+
+    @see HeapBlock, Array
+*/
+class JUCE_API  MemoryArena
+{
+public:
+    //==============================================================================
+    /** Creates an empty arena.
+        @param chunkSize    the size of each chunk of memory that the arena allocates
+                            from the system. A single allocation that's bigger than this
+                            will get a chunk of its own.
+    */
+    explicit MemoryArena (size_t chunkSize = 4096) noexcept;
+
+    /** Creates an arena which will use some existing memory before it allocates any of its own.
+        The arena won't take ownership of this memory, and it must stay valid for the arena's lifetime.
+    */
+    MemoryArena (void* preallocatedMemory, size_t preallocatedSize, size_t chunkSize = 4096) noexcept;
+
+    /** Destructor.
+        This releases the arena's memory without calling any destructors, so make sure
+        that nothing's still using it!
+    */
+    ~MemoryArena();
+
+    //==============================================================================
+    /** The alignment that allocate() uses by default. */
+    enum { defaultAlignment = 16 };
+
+    /** Returns a block of memory from the arena.
+        The alignment must be a power of two. This will only return nullptr if the arena
+        needed to allocate a new chunk and the system ran out of memory.
+    */
+    void* allocate (size_t numBytes, size_t alignment = defaultAlignment) noexcept;
+
+    /** Resizes a block that was returned by allocate(), keeping its contents.
+
+        If this is the block that was allocated most recently, it can usually grow or
+        shrink in place. Otherwise, a larger block has to be allocated and the data
+        copied into it, because the original block's memory won't be reused until the
+        arena is reset. If the block is nullptr, this just allocates a new one.
+    */
+    void* reallocate (void* block, size_t oldNumBytes, size_t newNumBytes,
+                      size_t alignment = defaultAlignment) noexcept;
+
+    /** Tells the arena that a block isn't needed any more.
+        Only the most recent allocation can actually be recycled - for anything else,
+        this does nothing, and the memory stays in use until the arena's reset.
+    */
+    void deallocate (void* block, size_t numBytes) noexcept;
+
+    /** Makes all of the arena's memory available to be allocated again.
+        Any memory that was allocated before this call mustn't be used afterwards.
+        This doesn't free any of the arena's chunks, so once an arena has grown
+        big enough for a job, repeating that job won't allocate anything.
+    */
+    void reset() noexcept;
+
+    /** Returns the total number of bytes in the chunks that this arena is using,
+        including any preallocated memory.
+    */
+    size_t getCapacity() const noexcept;
+
+    //==============================================================================
+    template <typename ElementType>
+    class Block;
+
+    /**
+        An allocator that tells an Array to keep its elements in a MemoryArena.
+
+        A default-constructed Allocator isn't attached to an arena, and makes the array
+        use the heap, just like a normal Array does.
+
+        @see Array
+    */
+    struct Allocator
+    {
+        Allocator() noexcept {}
+        Allocator (MemoryArena& arenaToUse) noexcept  : arena (&arenaToUse) {}
+
+        template <typename ElementType>
+        using BlockType = Block<ElementType>;
+
+        MemoryArena* arena = nullptr;
+    };
+
+    //==============================================================================
+    /**
+        Very simple container class to hold a pointer to some data in a MemoryArena.
+
+        This works just like a HeapBlock, but its memory comes from an arena - or from
+        the heap, if it hasn't been given an arena.
+
+        @see HeapBlock
+    */
+    template <typename ElementType>
+    class Block
+    {
+    public:
+        /** Creates a Block which uses the heap. */
+        Block() noexcept {}
+
+        /** Creates a Block which will allocate from an arena's memory. */
+        explicit Block (const Allocator& allocator) noexcept  : arena (allocator.arena) {}
+
+        Block (Block&& other) noexcept
+            : data (other.data), numAllocated (other.numAllocated), arena (other.arena)
+        {
+            other.data = nullptr;
+            other.numAllocated = 0;
+        }
+
+        Block& operator= (Block&& other) noexcept
+        {
+            swapWith (other);
+            return *this;
+        }
+
+        /** Destructor. */
+        ~Block()                                                                { free(); }
+
+        //==============================================================================
+        /** Returns a raw pointer to the allocated data. */
+        inline operator ElementType*() const noexcept                           { return data; }
+
+        /** Returns a raw pointer to the allocated data. */
+        inline ElementType* get() const noexcept                                { return data; }
+
+        /** Returns a reference to one of the data elements. */
+        template <typename IndexType>
+        inline ElementType& operator[] (IndexType index) const noexcept         { return data [index]; }
+
+        /** Returns a pointer to a data element at an offset from the start of the array. */
+        template <typename IndexType>
+        inline ElementType* operator+ (IndexType index) const noexcept          { return data + index; }
+
+        //==============================================================================
+        /** Re-allocates the block to a specified number of elements, keeping any data
+            that was already there. The new space's contents are undefined.
+        */
+        void realloc (size_t newNumElements)
+        {
+            auto newNumBytes = newNumElements * sizeof (ElementType);
+
+            if (arena != nullptr)
+                data = static_cast<ElementType*> (arena->reallocate (data, numAllocated * sizeof (ElementType),
+                                                                     newNumBytes, alignof (ElementType)));
+            else
+                data = static_cast<ElementType*> (data == nullptr ? std::malloc (newNumBytes)
+                                                                  : std::realloc (data, newNumBytes));
+
+            numAllocated = data != nullptr ? newNumElements : 0;
+        }
+
+        /** Frees the block. */
+        void free() noexcept
+        {
+            if (arena != nullptr)
+                arena->deallocate (data, numAllocated * sizeof (ElementType));
+            else
+                std::free (data);
+
+            data = nullptr;
+            numAllocated = 0;
+        }
+
+        /** Swaps this object's data and arena with another Block. */
+        void swapWith (Block& other) noexcept
+        {
+            std::swap (data, other.data);
+            std::swap (numAllocated, other.numAllocated);
+            std::swap (arena, other.arena);
+        }
+
+        /** Returns an Allocator that will create Blocks in the same arena as this one. */
+        Allocator getAllocator() const noexcept
+        {
+            Allocator a;
+            a.arena = arena;
+            return a;
+        }
+
+    private:
+        ElementType* data = nullptr;
+        size_t numAllocated = 0;
+        MemoryArena* arena = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (Block)
+    };
+
+private:
+    //==============================================================================
+    struct Chunk;
+    Chunk* firstChunk = nullptr;
+    Chunk* currentChunk = nullptr;
+    size_t position = 0, chunkSize;
+    char* lastAllocation = nullptr;
+
+    bool addChunk (size_t minimumSize) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryArena)
+};
+
+} // namespace juce
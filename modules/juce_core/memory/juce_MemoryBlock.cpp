@@ -362,7 +362,22 @@ String MemoryBlock::toBase64Encoding() const
     d += initialLen;
     d.write ('.');
 
-    for (size_t i = 0; i < numChars; ++i)
+    // the bits are taken from the lowest first, so each 3 bytes make 4 whole characters
+    auto* source = reinterpret_cast<const uint8*> (data.getData());
+    auto numGroups = size / 3;
+
+    for (size_t i = 0; i < numGroups; ++i)
+    {
+        auto bits = (uint32) source[0] | ((uint32) source[1] << 8) | ((uint32) source[2] << 16);
+        source += 3;
+
+        d.write ((juce_wchar) (uint8) base64EncodingTable[bits & 63]);
+        d.write ((juce_wchar) (uint8) base64EncodingTable[(bits >> 6) & 63]);
+        d.write ((juce_wchar) (uint8) base64EncodingTable[(bits >> 12) & 63]);
+        d.write ((juce_wchar) (uint8) base64EncodingTable[bits >> 18]);
+    }
+
+    for (auto i = numGroups * 4; i < numChars; ++i)
         d.write ((juce_wchar) (uint8) base64EncodingTable[getBitRange (i * 6, 6)]);
 
     d.writeNull();
@@ -388,23 +403,40 @@ bool MemoryBlock::fromBase64Encoding (StringRef s)
     setSize ((size_t) numBytesNeeded, true);
 
     auto srcChars = dot + 1;
-    int pos = 0;
+    uint32 bits = 0;
+    int numBits = 0;
+    size_t byteIndex = 0;
 
     for (;;)
     {
         auto c = (int) srcChars.getAndAdvance();
 
         if (c == 0)
-            return true;
+            break;
 
         c -= 43;
 
         if (isPositiveAndBelow (c, numElementsInArray (base64DecodingTable)))
         {
-            setBitRange ((size_t) pos, 6, base64DecodingTable[c]);
-            pos += 6;
+            // the bits are stored lowest first, so each whole byte can be written as soon as it's complete
+            bits |= (uint32) base64DecodingTable[c] << numBits;
+            numBits += 6;
+
+            if (numBits >= 8)
+            {
+                if (byteIndex < size)
+                    data[byteIndex++] = (char) bits;
+
+                bits >>= 8;
+                numBits -= 8;
+            }
         }
     }
+
+    if (numBits > 0 && byteIndex < size)
+        data[byteIndex] = (char) bits;
+
+    return true;
 }
 
 } // namespace juce
@@ -0,0 +1,337 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace MemoryUsageHelpers
+{
+    // (this is only set once the registry is being destroyed at shutdown, after
+    // which any categories that still exist mustn't try to unregister themselves)
+    static std::atomic<bool> registryDeleted { false };
+
+    struct Registry
+    {
+        Registry() {}
+
+        ~Registry()
+        {
+            registryDeleted = true;
+            ownedCategories.clear();
+        }
+
+        CriticalSection lock;
+        Array<MemoryUsage::Category*> categories;
+        OwnedArray<MemoryUsage::Category> ownedCategories;
+        std::atomic<int64> totalBudget { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (Registry)
+    };
+
+    static Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static Array<MemoryUsage::Category*> getAllCategories()
+    {
+        auto& registry = getRegistry();
+        const ScopedLock sl (registry.lock);
+        return registry.categories;
+    }
+}
+
+//==============================================================================
+MemoryUsage::Category::Category (const String& categoryName)  : name (categoryName)
+{
+    auto& registry = MemoryUsageHelpers::getRegistry();
+    const ScopedLock sl (registry.lock);
+
+    for (auto* c : registry.categories)
+    {
+        // Each category needs a different name. If you want to share a category between
+        // several objects, use MemoryUsage::getCategory() to find it.
+        jassert (c->getName() != name);
+        ignoreUnused (c);
+    }
+
+    registry.categories.add (this);
+}
+
+MemoryUsage::Category::~Category()
+{
+    if (! MemoryUsageHelpers::registryDeleted)
+    {
+        auto& registry = MemoryUsageHelpers::getRegistry();
+        const ScopedLock sl (registry.lock);
+        registry.categories.removeFirstMatchingValue (this);
+    }
+}
+
+void MemoryUsage::Category::add (int64 numBytes) noexcept
+{
+    auto newValue = (currentBytes += numBytes);
+
+    // more has been removed from this category than was added to it!
+    jassert (newValue >= 0);
+
+    auto peak = peakBytes.load();
+
+    while (newValue > peak && ! peakBytes.compare_exchange_weak (peak, newValue))
+    {}
+}
+
+void MemoryUsage::Category::resetPeak() noexcept
+{
+    peakBytes = currentBytes.load();
+}
+
+bool MemoryUsage::Category::isOverBudget() const noexcept
+{
+    auto limit = budget.load();
+    return limit > 0 && currentBytes.load() > limit;
+}
+
+MemoryUsage::Category& MemoryUsage::getCategory (const String& name)
+{
+    auto& registry = MemoryUsageHelpers::getRegistry();
+    const ScopedLock sl (registry.lock);
+
+    for (auto* c : registry.categories)
+        if (c->getName() == name)
+            return *c;
+
+    return *registry.ownedCategories.add (new Category (name));
+}
+
+//==============================================================================
+Array<MemoryUsage::Entry> MemoryUsage::getSnapshot()
+{
+    Array<Entry> entries;
+
+    for (auto* c : MemoryUsageHelpers::getAllCategories())
+        entries.add ({ c->getName(), c->getCurrentBytes(), c->getPeakBytes(), c->getBudget() });
+
+    std::sort (entries.begin(), entries.end(),
+               [] (const Entry& a, const Entry& b) { return a.name.compareNatural (b.name) < 0; });
+
+    return entries;
+}
+
+int64 MemoryUsage::getTotalBytes()
+{
+    int64 total = 0;
+
+    for (auto* c : MemoryUsageHelpers::getAllCategories())
+        total += c->getCurrentBytes();
+
+    return total;
+}
+
+String MemoryUsage::getSummary()
+{
+    String summary;
+
+    for (auto& e : getSnapshot())
+    {
+        summary << e.name << ": " << File::descriptionOfSizeInBytes (e.currentBytes)
+                << " (peak " << File::descriptionOfSizeInBytes (e.peakBytes);
+
+        if (e.budget > 0)
+            summary << ", budget " << File::descriptionOfSizeInBytes (e.budget);
+
+        summary << ")" << newLine;
+    }
+
+    summary << "Total: " << File::descriptionOfSizeInBytes (getTotalBytes());
+
+    if (auto totalBudget = getTotalBudget())
+        summary << " (budget " << File::descriptionOfSizeInBytes (totalBudget) << ")";
+
+    return summary;
+}
+
+//==============================================================================
+void MemoryUsage::setTotalBudget (int64 maxNumBytes) noexcept
+{
+    MemoryUsageHelpers::getRegistry().totalBudget = maxNumBytes;
+}
+
+int64 MemoryUsage::getTotalBudget() noexcept
+{
+    return MemoryUsageHelpers::getRegistry().totalBudget.load();
+}
+
+bool MemoryUsage::enforceBudgets()
+{
+    // the release functions are called without the registry being locked, as they'll
+    // probably need to take the locks of their own subsystems
+    auto categories = MemoryUsageHelpers::getAllCategories();
+    bool allWithinBudget = true;
+
+    for (auto* c : categories)
+    {
+        if (c->isOverBudget() && c->releaseMemory != nullptr)
+            c->releaseMemory (c->getCurrentBytes() - c->getBudget());
+
+        if (c->isOverBudget())
+            allWithinBudget = false;
+    }
+
+    if (auto totalBudget = getTotalBudget())
+    {
+        int64 total = 0;
+
+        for (auto* c : categories)
+            total += c->getCurrentBytes();
+
+        auto excess = total - totalBudget;
+
+        if (excess > 0)
+        {
+            // shrink the biggest categories first
+            std::sort (categories.begin(), categories.end(),
+                       [] (Category* a, Category* b) { return a->getCurrentBytes() > b->getCurrentBytes(); });
+
+            for (auto* c : categories)
+            {
+                if (excess <= 0)
+                    break;
+
+                if (c->releaseMemory != nullptr)
+                {
+                    auto before = c->getCurrentBytes();
+                    c->releaseMemory (excess);
+                    excess -= before - c->getCurrentBytes();
+                }
+            }
+
+            if (excess > 0)
+                allWithinBudget = false;
+        }
+    }
+
+    return allWithinBudget;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MemoryUsageTests  : public UnitTest
+{
+public:
+    MemoryUsageTests() : UnitTest ("MemoryUsage", "Memory") {}
+
+    static const MemoryUsage::Entry* findEntry (const Array<MemoryUsage::Entry>& entries, const String& name)
+    {
+        for (auto& e : entries)
+            if (e.name == name)
+                return &e;
+
+        return nullptr;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Counting bytes");
+        {
+            auto totalBefore = MemoryUsage::getTotalBytes();
+
+            {
+                MemoryUsage::Category counter ("MemoryUsageTests A");
+                counter.add (1000);
+                counter.add (500);
+                counter.remove (1200);
+
+                expectEquals (counter.getCurrentBytes(), (int64) 300);
+                expectEquals (counter.getPeakBytes(), (int64) 1500);
+                expectEquals (MemoryUsage::getTotalBytes() - totalBefore, (int64) 300);
+
+                counter.resetPeak();
+                expectEquals (counter.getPeakBytes(), (int64) 300);
+
+                auto snapshot = MemoryUsage::getSnapshot();
+                auto* entry = findEntry (snapshot, "MemoryUsageTests A");
+                expect (entry != nullptr && entry->currentBytes == 300);
+                expect (MemoryUsage::getSummary().contains ("MemoryUsageTests A: 300 bytes"));
+
+                expect (&MemoryUsage::getCategory ("MemoryUsageTests A") == &counter);
+                counter.remove (300);
+            }
+
+            expect (findEntry (MemoryUsage::getSnapshot(), "MemoryUsageTests A") == nullptr);
+            expectEquals (MemoryUsage::getTotalBytes(), totalBefore);
+        }
+
+        beginTest ("Budgets");
+        {
+            MemoryUsage::Category a ("MemoryUsageTests B"), b ("MemoryUsageTests C"), fixed ("MemoryUsageTests D");
+
+            auto releaseFrom = [] (MemoryUsage::Category& c)
+            {
+                return [&c] (int64 numBytes) { c.remove (jmin (numBytes, c.getCurrentBytes())); };
+            };
+
+            a.releaseMemory = releaseFrom (a);
+            b.releaseMemory = releaseFrom (b);
+
+            a.add (5000);
+            b.add (3000);
+            fixed.add (2000);
+
+            a.setBudget (4000);
+            expect (a.isOverBudget());
+            expect (! b.isOverBudget());
+            expect (MemoryUsage::enforceBudgets());
+            expectEquals (a.getCurrentBytes(), (int64) 4000);
+
+            fixed.setBudget (1000);
+            expect (! MemoryUsage::enforceBudgets());
+            fixed.setBudget (0);
+
+            auto budgetBefore = MemoryUsage::getTotalBudget();
+            MemoryUsage::setTotalBudget (MemoryUsage::getTotalBytes() - 4500);
+            expect (MemoryUsage::enforceBudgets());
+
+            // the largest category is shrunk first
+            expectEquals (a.getCurrentBytes(), (int64) 0);
+            expectEquals (b.getCurrentBytes(), (int64) 2500);
+            expectEquals (fixed.getCurrentBytes(), (int64) 2000);
+
+            MemoryUsage::setTotalBudget (MemoryUsage::getTotalBytes() - 4000);
+            expect (! MemoryUsage::enforceBudgets());
+            expectEquals (b.getCurrentBytes(), (int64) 0);
+
+            MemoryUsage::setTotalBudget (budgetBefore);
+            fixed.remove (2000);
+        }
+    }
+};
+
+static MemoryUsageTests memoryUsageTests;
+
+#endif
+
+} // namespace juce
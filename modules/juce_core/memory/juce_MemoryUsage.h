@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Keeps track of how much memory the caches and other large subsystems in an
+    app are using, split up into named categories.
+
+    Each subsystem that wants to report its usage creates a MemoryUsage::Category
+    and tells it whenever it allocates or frees something big. The totals can then be
+    looked at while the app is running with getSnapshot(), or shown with a
+    MemoryUsageComponent. Several of JUCE's own classes report their usage: the
+    ImageCache, the software renderer's glyph cache, AudioThumbnailCache, the impulse
+    responses held by dsp::Convolution, and OpenGLTexture.
+
+    The numbers are the sizes of the main blocks of data that each subsystem holds,
+    rather than an exact count of every allocation, but they're cheap to keep up to
+    date, and they give a good idea of where the memory is going.
+
+    Each category can also be given a budget. Subsystems that are able to free some
+    of their memory, such as caches, can supply a releaseMemory function, and
+    enforceBudgets() will ask them to shrink until everything fits, e.g.
+    @code
+    MemoryUsage::setTotalBudget (256 * 1024 * 1024);
+    MemoryUsage::getCategory ("ImageCache").setBudget (32 * 1024 * 1024);
+    ...
+    // then, every so often (or when the OS warns that memory is low):
+    MemoryUsage::enforceBudgets();
+    @endcode
+
+    @see MemoryUsageComponent
+*/
+class JUCE_API  MemoryUsage
+{
+public:
+    //==============================================================================
+    /** A named counter of the bytes that a subsystem is using.
+
+        Categories are usually static objects that live for as long as the app does.
+        All the methods that change the count are lock-free, so they can be called on
+        any thread.
+    */
+    class JUCE_API  Category
+    {
+    public:
+        /** Creates a category and adds it to the list that getSnapshot() reports.
+            Each category should have a different name.
+        */
+        explicit Category (const String& name);
+
+        /** Destructor. */
+        ~Category();
+
+        /** Returns the category's name. */
+        const String& getName() const noexcept                  { return name; }
+
+        /** Adds a number of bytes to the category's usage. */
+        void add (int64 numBytes) noexcept;
+
+        /** Removes a number of bytes from the category's usage. */
+        void remove (int64 numBytes) noexcept                    { add (-numBytes); }
+
+        /** Returns the number of bytes that are currently in use. */
+        int64 getCurrentBytes() const noexcept                   { return currentBytes.load(); }
+
+        /** Returns the largest number of bytes that have been in use since the category
+            was created, or since resetPeak() was called.
+        */
+        int64 getPeakBytes() const noexcept                      { return peakBytes.load(); }
+
+        /** Resets the peak usage to the current usage. */
+        void resetPeak() noexcept;
+
+        /** Sets the number of bytes that this category should be kept within.
+            A value of 0 means that it has no limit. Setting a budget doesn't stop the
+            category growing beyond it - see enforceBudgets().
+        */
+        void setBudget (int64 maxNumBytes) noexcept              { budget = maxNumBytes; }
+
+        /** Returns the category's budget, or 0 if it doesn't have one. */
+        int64 getBudget() const noexcept                         { return budget.load(); }
+
+        /** Returns true if the category has a budget, and is using more than it. */
+        bool isOverBudget() const noexcept;
+
+        /** If the subsystem can free some of its memory when asked to, it can set this
+            to a function that tries to free at least the given number of bytes.
+            It will be called by enforceBudgets(), on whichever thread calls that.
+        */
+        std::function<void (int64 numBytesToRelease)> releaseMemory;
+
+    private:
+        const String name;
+        std::atomic<int64> currentBytes { 0 }, peakBytes { 0 }, budget { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (Category)
+    };
+
+    /** Returns the category with a given name, creating a new one if there isn't
+        one yet. Categories that are created this way are kept until the app exits.
+    */
+    static Category& getCategory (const String& name);
+
+    //==============================================================================
+    /** The usage of a category at the time a snapshot was taken. */
+    struct Entry
+    {
+        String name;
+        int64 currentBytes, peakBytes, budget;
+    };
+
+    /** Returns the current usage of all the categories, in alphabetical order. */
+    static Array<Entry> getSnapshot();
+
+    /** Returns the sum of the current usage of all the categories. */
+    static int64 getTotalBytes();
+
+    /** Returns a multi-line description of the current usage, which is handy for logging. */
+    static String getSummary();
+
+    //==============================================================================
+    /** Sets the number of bytes that all the categories together should be kept within.
+        A value of 0 means that there's no limit.
+    */
+    static void setTotalBudget (int64 maxNumBytes) noexcept;
+
+    /** Returns the total budget, or 0 if there isn't one. */
+    static int64 getTotalBudget() noexcept;
+
+    /** Asks any categories that are over their budgets to free some memory, and then,
+        if the total is over the total budget, asks the largest categories to free
+        enough to bring it back within it.
+
+        Only categories that have a releaseMemory function can be shrunk.
+
+        @returns true if all the categories and the total are now within their budgets
+    */
+    static bool enforceBudgets();
+
+private:
+    MemoryUsage() = delete;
+};
+
+} // namespace juce
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A named block of memory that can be shared between processes on the same machine.
+
+    One process calls create() to make a region with a given name and size, and any
+    others can then map the same memory with openExisting(). Anything that one of them
+    writes to getData() can be read straight away by all the others, so there's no
+    need for any copying or system calls, but it's up to you to keep the access
+    thread-safe, e.g. with atomics that live in the region itself.
+
+    The region belongs to the object that created it, and its name is removed when
+    that object is closed or deleted, although any processes that still have it open
+    can carry on using it until they close it too.
+
+    @see SharedMemoryFifo, NamedPipe, MemoryMappedFile
+*/
+class JUCE_API  SharedMemory  final
+{
+public:
+    //==============================================================================
+    /** Creates a SharedMemory object that isn't attached to a region. */
+    SharedMemory();
+
+    /** Destructor. */
+    ~SharedMemory();
+
+    //==============================================================================
+    /** Tries to create a new region with the given name.
+
+        The memory is always zeroed when it's created. If a region with this name
+        already exists, the method fails if mustNotExist is true, otherwise the old one
+        is replaced with a new one (apart from on Windows, where the existing region is
+        opened instead).
+
+        Returns true if it succeeds.
+    */
+    bool create (const String& name, size_t numBytes, bool mustNotExist = false);
+
+    /** Tries to open a region that another SharedMemory object has created.
+        Returns true if it succeeds.
+    */
+    bool openExisting (const String& name);
+
+    /** Unmaps the region, if it's open. */
+    void close();
+
+    /** True if a region is currently open. */
+    bool isOpen() const noexcept                    { return pimpl != nullptr; }
+
+    /** Returns the last name that was used to try to open a region. */
+    String getName() const                          { return currentName; }
+
+    //==============================================================================
+    /** Returns the start of the region, or nullptr if it isn't open. */
+    void* getData() const noexcept;
+
+    /** Returns the size of the region in bytes, or 0 if it isn't open.
+        When a region has been opened with openExisting(), this may have been rounded
+        up to a whole number of pages.
+    */
+    size_t getSize() const noexcept;
+
+private:
+    //==============================================================================
+    JUCE_PUBLIC_IN_DLL_BUILD (class Pimpl)
+    ScopedPointer<Pimpl> pimpl;
+    String currentName;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemory)
+};
+
+} // namespace juce
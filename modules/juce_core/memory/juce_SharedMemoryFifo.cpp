@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The start of the shared region. The reader and writer each have their own cache line.
+struct SharedMemoryFifo::Header
+{
+    uint32 magic, capacity;
+    char padding1[56];
+
+    std::atomic<uint32> writePosition;
+    std::atomic<int32> dataCount, readerWaiting;
+    char padding2[52];
+
+    std::atomic<uint32> readPosition;
+    std::atomic<int32> spaceCount, writerWaiting;
+    char padding3[52];
+};
+
+// Lets one end of the FIFO sleep until the other one has done something. The
+// implementations are in the platform-specific files.
+class SharedMemoryFifo::Signal
+{
+public:
+    Signal (const String& name, std::atomic<int32>& counter, bool isCreator);
+    ~Signal();
+
+    bool isValid() const noexcept;
+
+    // Returns when notify() is called, when the counter no longer holds the value
+    // that's passed in, or when the timeout runs out (and sometimes spuriously).
+    void wait (int32 lastCount, int timeoutMilliseconds);
+    void notify();
+
+private:
+    std::atomic<int32>& counter;
+
+   #if JUCE_WINDOWS
+    void* event = nullptr;
+   #elif ! (JUCE_LINUX || JUCE_ANDROID)
+    String fifoPath;
+    int fifoHandle = -1;
+    bool ownsFifo = false;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Signal)
+};
+
+enum { sharedMemoryFifoMagic = 0x4a534646 };
+
+//==============================================================================
+SharedMemoryFifo::SharedMemoryFifo() {}
+
+SharedMemoryFifo::~SharedMemoryFifo()
+{
+    close();
+}
+
+bool SharedMemoryFifo::create (const String& name, int capacityInBytes)
+{
+    close();
+
+    auto capacity = (uint32) nextPowerOfTwo (jlimit (16, 1 << 30, capacityInBytes));
+
+    if (! memory.create (name, sizeof (Header) + capacity))
+        return false;
+
+    auto* h = static_cast<Header*> (memory.getData());
+    h->capacity = capacity;
+
+    if (! attach (name, true))
+        return false;
+
+    std::atomic_thread_fence (std::memory_order_release);
+    h->magic = sharedMemoryFifoMagic;
+    return true;
+}
+
+bool SharedMemoryFifo::openExisting (const String& name)
+{
+    close();
+
+    if (! memory.openExisting (name) || memory.getSize() < sizeof (Header))
+    {
+        memory.close();
+        return false;
+    }
+
+    auto* h = static_cast<Header*> (memory.getData());
+    std::atomic_thread_fence (std::memory_order_acquire);
+
+    if (h->magic != sharedMemoryFifoMagic
+         || ! isPowerOfTwo (h->capacity)
+         || memory.getSize() < sizeof (Header) + h->capacity)
+    {
+        memory.close();
+        return false;
+    }
+
+    return attach (name, false);
+}
+
+bool SharedMemoryFifo::attach (const String& name, bool isCreator)
+{
+    auto* h = static_cast<Header*> (memory.getData());
+
+    dataSignal  = new Signal (name + "_data",  h->dataCount,  isCreator);
+    spaceSignal = new Signal (name + "_space", h->spaceCount, isCreator);
+
+    if (! (dataSignal->isValid() && spaceSignal->isValid()))
+    {
+        close();
+        return false;
+    }
+
+    header = h;
+    buffer = static_cast<char*> (memory.getData()) + sizeof (Header);
+    return true;
+}
+
+void SharedMemoryFifo::close()
+{
+    header = nullptr;
+    buffer = nullptr;
+    dataSignal = nullptr;
+    spaceSignal = nullptr;
+    memory.close();
+}
+
+//==============================================================================
+int SharedMemoryFifo::getCapacity() const noexcept
+{
+    return header != nullptr ? (int) header->capacity : 0;
+}
+
+int SharedMemoryFifo::getNumReady() const noexcept
+{
+    if (header == nullptr)
+        return 0;
+
+    return (int) (header->writePosition.load (std::memory_order_acquire)
+                    - header->readPosition.load (std::memory_order_acquire));
+}
+
+int SharedMemoryFifo::getFreeSpace() const noexcept
+{
+    return header != nullptr ? getCapacity() - getNumReady() : 0;
+}
+
+bool SharedMemoryFifo::write (const void* sourceData, int numBytes) noexcept
+{
+    if (header == nullptr || numBytes < 0)
+        return false;
+
+    auto capacity = header->capacity;
+    auto writePos = header->writePosition.load (std::memory_order_relaxed);
+
+    if ((uint32) numBytes > capacity - (writePos - header->readPosition.load (std::memory_order_acquire)))
+        return false;
+
+    auto start = writePos & (capacity - 1);
+    auto firstPart = jmin ((uint32) numBytes, capacity - start);
+
+    memcpy (buffer + start, sourceData, firstPart);
+    memcpy (buffer, static_cast<const char*> (sourceData) + firstPart, (size_t) numBytes - firstPart);
+
+    header->writePosition.store (writePos + (uint32) numBytes, std::memory_order_release);
+    header->dataCount.fetch_add (1);
+
+    if (header->readerWaiting.load() != 0)
+        dataSignal->notify();
+
+    return true;
+}
+
+bool SharedMemoryFifo::read (void* destData, int numBytes) noexcept
+{
+    if (header == nullptr || numBytes < 0)
+        return false;
+
+    auto capacity = header->capacity;
+    auto readPos = header->readPosition.load (std::memory_order_relaxed);
+
+    if ((uint32) numBytes > header->writePosition.load (std::memory_order_acquire) - readPos)
+        return false;
+
+    auto start = readPos & (capacity - 1);
+    auto firstPart = jmin ((uint32) numBytes, capacity - start);
+
+    memcpy (destData, buffer + start, firstPart);
+    memcpy (static_cast<char*> (destData) + firstPart, buffer, (size_t) numBytes - firstPart);
+
+    header->readPosition.store (readPos + (uint32) numBytes, std::memory_order_release);
+    header->spaceCount.fetch_add (1);
+
+    if (header->writerWaiting.load() != 0)
+        spaceSignal->notify();
+
+    return true;
+}
+
+bool SharedMemoryFifo::waitForData (int numBytes, int timeoutMilliseconds)
+{
+    return waitFor (numBytes, timeoutMilliseconds, true);
+}
+
+bool SharedMemoryFifo::waitForFreeSpace (int numBytes, int timeoutMilliseconds)
+{
+    return waitFor (numBytes, timeoutMilliseconds, false);
+}
+
+bool SharedMemoryFifo::waitFor (int numBytes, int timeoutMilliseconds, bool forData)
+{
+    if (header == nullptr || numBytes > getCapacity())
+        return false;
+
+    auto& waiting = forData ? header->readerWaiting : header->writerWaiting;
+    auto& counter = forData ? header->dataCount : header->spaceCount;
+    auto& signal  = forData ? *dataSignal : *spaceSignal;
+
+    auto isReady = [&] { return (forData ? getNumReady() : getFreeSpace()) >= numBytes; };
+    auto endTime = Time::getMillisecondCounter() + (uint32) jmax (0, timeoutMilliseconds);
+
+    for (;;)
+    {
+        if (isReady())
+            return true;
+
+        // The other end bumps the counter before it checks this flag, so either it
+        // sees that we're waiting, or the counter has changed and the wait returns.
+        waiting.store (1);
+        auto lastCount = counter.load();
+
+        if (isReady())
+        {
+            waiting.store (0);
+            return true;
+        }
+
+        int timeToWait = -1;
+
+        if (timeoutMilliseconds >= 0)
+        {
+            auto now = Time::getMillisecondCounter();
+
+            if (now >= endTime)
+            {
+                waiting.store (0);
+                return false;
+            }
+
+            timeToWait = (int) (endTime - now);
+        }
+
+        signal.wait (lastCount, timeToWait);
+        waiting.store (0);
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SharedMemoryFifoTests  : public UnitTest
+{
+public:
+    SharedMemoryFifoTests() : UnitTest ("SharedMemoryFifo", "Memory") {}
+
+    static String getTestName (Random& r)
+    {
+        return "juce_test_" + String::toHexString (r.nextInt64());
+    }
+
+    class WriterThread  : public Thread
+    {
+    public:
+        WriterThread (const String& n, int blocks, int size)
+            : Thread ("fifo writer"), name (n), numBlocks (blocks), blockSize (size)
+        {
+        }
+
+        void run() override
+        {
+            SharedMemoryFifo fifo;
+
+            if (! fifo.openExisting (name))
+                return;
+
+            HeapBlock<uint8> block ((size_t) blockSize);
+
+            for (int i = 0; i < numBlocks && ! threadShouldExit(); ++i)
+            {
+                for (int j = 0; j < blockSize; ++j)
+                    block[j] = (uint8) (i + j);
+
+                while (! fifo.write (block, blockSize) && ! threadShouldExit())
+                    fifo.waitForFreeSpace (blockSize, 100);
+            }
+        }
+
+        const String name;
+        const int numBlocks, blockSize;
+    };
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("SharedMemory");
+        {
+            auto fifoName = getTestName (r);
+            SharedMemory creator, opener;
+
+            expect (! opener.openExisting (fifoName));
+            expect (creator.create (fifoName, 1000));
+            expect (creator.getSize() == 1000);
+            expect (creator.getData() != nullptr);
+
+            expect (opener.openExisting (fifoName));
+            expect (opener.getSize() >= 1000);
+
+            static_cast<char*> (creator.getData())[999] = 42;
+            expectEquals ((int) static_cast<char*> (opener.getData())[999], 42);
+
+            SharedMemory other;
+            expect (! other.create (fifoName, 1000, true));
+
+            opener.close();
+            expect (! opener.isOpen());
+            expect (opener.getData() == nullptr);
+        }
+
+        beginTest ("Reads and writes");
+        {
+            auto fifoName = getTestName (r);
+            SharedMemoryFifo writer, reader;
+
+            expect (! reader.openExisting (fifoName));
+            expect (writer.create (fifoName, 1000));
+            expectEquals (writer.getCapacity(), 1024);
+            expect (reader.openExisting (fifoName));
+            expectEquals (reader.getCapacity(), 1024);
+
+            uint8 source[300], dest[300];
+            uint8 next = 0, expected = 0;
+            bool allCorrect = true;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto numBytes = r.nextInt ({ 1, 300 });
+
+                for (int j = 0; j < numBytes; ++j)
+                    source[j] = next++;
+
+                while (! writer.write (source, numBytes))
+                {
+                    auto numToRead = reader.getNumReady();
+                    expect (reader.read (dest, jmin (numToRead, 300)));
+
+                    for (int j = 0; j < jmin (numToRead, 300); ++j)
+                        allCorrect = allCorrect && dest[j] == expected++;
+                }
+            }
+
+            expect (allCorrect);
+            expectEquals (writer.getNumReady() + writer.getFreeSpace(), 1024);
+            expect (! reader.read (dest, reader.getNumReady() + 1));
+            expect (! writer.write (source, writer.getFreeSpace() + 1));
+
+            expect (! reader.waitForData (reader.getNumReady() + 1, 0));
+            expect (reader.waitForData (reader.getNumReady(), 0));
+        }
+
+        beginTest ("Waiting across threads");
+        {
+            auto fifoName = getTestName (r);
+            SharedMemoryFifo reader;
+            expect (reader.create (fifoName, 4096));
+
+            const int numBlocks = 2000, blockSize = 1000;
+            WriterThread writer (fifoName, numBlocks, blockSize);
+            writer.startThread();
+
+            HeapBlock<uint8> block ((size_t) blockSize);
+            bool allCorrect = true;
+            int numRead = 0;
+
+            for (; numRead < numBlocks; ++numRead)
+            {
+                if (! reader.waitForData (blockSize, 5000) || ! reader.read (block, blockSize))
+                    break;
+
+                for (int j = 0; j < blockSize; ++j)
+                    allCorrect = allCorrect && block[j] == (uint8) (numRead + j);
+            }
+
+            expectEquals (numRead, numBlocks);
+            expect (allCorrect);
+            writer.stopThread (1000);
+
+            auto start = Time::getMillisecondCounter();
+            expect (! reader.waitForData (1, 50));
+            expect (Time::getMillisecondCounter() - start >= 40);
+        }
+    }
+};
+
+static SharedMemoryFifoTests sharedMemoryFifoTests;
+
+#endif
+
+} // namespace juce
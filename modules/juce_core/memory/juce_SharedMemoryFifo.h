@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A single-reader, single-writer lock-free FIFO of bytes which lives in shared
+    memory, so that the reader and writer can be in different processes.
+
+    One process calls create() to make the FIFO, and the other uses openExisting()
+    with the same name. Data is copied straight into and out of the shared region
+    without any locks or system calls, so e.g. a block of audio can be passed to
+    another process for about the same cost as passing it between two threads.
+
+    When one end has to wait, waitForData() and waitForFreeSpace() block on a signal
+    (a futex on Linux and Android, an event on Windows, or a FIFO on other systems)
+    which the other end only triggers when there's actually someone waiting.
+
+    A FIFO is only ever written by one end and read by the other. To talk in both
+    directions, create a pair of them.
+
+    @see SharedMemory, LockFreeFifo, AbstractFifo
+*/
+class JUCE_API  SharedMemoryFifo  final
+{
+public:
+    //==============================================================================
+    /** Creates a SharedMemoryFifo that isn't attached to any shared memory. */
+    SharedMemoryFifo();
+
+    /** Destructor. */
+    ~SharedMemoryFifo();
+
+    //==============================================================================
+    /** Tries to create a new FIFO with the given name.
+
+        The capacity is rounded up to a power of two. If a FIFO with this name already
+        exists, it's replaced (see SharedMemory::create()). Returns true if it succeeds.
+    */
+    bool create (const String& name, int capacityInBytes);
+
+    /** Tries to open a FIFO that another process has created.
+        Returns true if it succeeds.
+    */
+    bool openExisting (const String& name);
+
+    /** Closes the FIFO, if it's open. */
+    void close();
+
+    /** True if the FIFO is currently open. */
+    bool isOpen() const noexcept                { return header != nullptr; }
+
+    /** Returns the number of bytes that the FIFO can hold. */
+    int getCapacity() const noexcept;
+
+    /** Returns the number of bytes that are waiting to be read. */
+    int getNumReady() const noexcept;
+
+    /** Returns the number of bytes that can be written without waiting. */
+    int getFreeSpace() const noexcept;
+
+    //==============================================================================
+    /** Copies a block of data into the FIFO.
+
+        This either writes the whole block, or nothing at all if there isn't enough
+        space for it, which means that a reader will never see part of one. If the
+        reader is waiting for data, it's woken up. This must only be called by the
+        writer.
+    */
+    bool write (const void* sourceData, int numBytes) noexcept;
+
+    /** Waits until there's space to write the given number of bytes.
+
+        This must only be called by the writer. A negative timeout waits forever.
+        Returns true if the space is available, or false if it timed out first.
+    */
+    bool waitForFreeSpace (int numBytes, int timeoutMilliseconds);
+
+    //==============================================================================
+    /** Copies a block of data out of the FIFO.
+
+        This either reads the whole block, or nothing at all if fewer bytes than that
+        are ready. If the writer is waiting for space, it's woken up. This must only be
+        called by the reader.
+    */
+    bool read (void* destData, int numBytes) noexcept;
+
+    /** Waits until there are at least the given number of bytes ready to read.
+
+        This must only be called by the reader. A negative timeout waits forever.
+        Returns true if the data is available, or false if it timed out first.
+    */
+    bool waitForData (int numBytes, int timeoutMilliseconds);
+
+private:
+    //==============================================================================
+    struct Header;
+    class Signal;
+    friend struct ContainerDeletePolicy<Signal>;
+
+    SharedMemory memory;
+    Header* header = nullptr;
+    char* buffer = nullptr;
+    ScopedPointer<Signal> dataSignal, spaceSignal;
+
+    bool attach (const String& name, bool isCreator);
+    bool waitFor (int numBytes, int timeoutMilliseconds, bool forData);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryFifo)
+};
+
+} // namespace juce
@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A wrapper for a function or lambda, like std::function, which stores the callable
+    object inside itself rather than allocating space for it on the heap.
+
+    The len parameter is the number of bytes that are reserved for the callable
+    object. If you try to store an object that is bigger than this, you'll get a
+    compile error rather than a hidden allocation, so creating, moving, calling
+    and destroying a FixedSizeFunction are all safe on a realtime thread.
+
+    Unlike std::function, a FixedSizeFunction can only be moved, not copied, so
+    it can hold lambdas that capture move-only objects.
+
+    E.g.
+    @code
+    FixedSizeFunction<32, float (float)> shaper = [drive] (float x) { return std::tanh (x * drive); };
+
+    auto y = shaper (x);
+    @endcode
+
+    @see MessageManager::callAsync
+*/
+template <size_t len, typename Signature>
+class FixedSizeFunction;
+
+template <size_t len, typename Result, typename... Arguments>
+class FixedSizeFunction<len, Result (Arguments...)>
+{
+public:
+    //==============================================================================
+    /** Creates an empty function. */
+    FixedSizeFunction() noexcept {}
+
+    /** Creates an empty function. */
+    FixedSizeFunction (decltype (nullptr)) noexcept {}
+
+    /** Creates a function that will call a copy of the given callable object. */
+    template <typename Callable,
+              typename CallableType = typename std::decay<Callable>::type,
+              typename = typename std::enable_if<! std::is_same<CallableType, FixedSizeFunction>::value>::type>
+    FixedSizeFunction (Callable&& callable)
+    {
+        static_assert (sizeof (CallableType) <= len,
+                       "This callable object is too big to fit into the FixedSizeFunction - you'll need to make its size larger");
+        static_assert (alignof (CallableType) <= alignof (Storage),
+                       "This callable object needs a stricter alignment than the FixedSizeFunction can provide");
+
+        new (&storage) CallableType (std::forward<Callable> (callable));
+        invoker = &invoke<CallableType>;
+        manager = &manage<CallableType>;
+    }
+
+    /** Move constructor. The other function will be left empty. */
+    FixedSizeFunction (FixedSizeFunction&& other) noexcept
+    {
+        takeFrom (other);
+    }
+
+    /** Destructor. */
+    ~FixedSizeFunction() noexcept
+    {
+        clear();
+    }
+
+    //==============================================================================
+    /** Takes over the callable object from another function, which will be left empty. */
+    FixedSizeFunction& operator= (FixedSizeFunction&& other) noexcept
+    {
+        if (&other != this)
+        {
+            clear();
+            takeFrom (other);
+        }
+
+        return *this;
+    }
+
+    /** Deletes the callable object, leaving this function empty. */
+    FixedSizeFunction& operator= (decltype (nullptr)) noexcept
+    {
+        clear();
+        return *this;
+    }
+
+    /** Replaces the callable object with a copy of a new one. */
+    template <typename Callable,
+              typename = typename std::enable_if<! std::is_same<typename std::decay<Callable>::type, FixedSizeFunction>::value>::type>
+    FixedSizeFunction& operator= (Callable&& callable)
+    {
+        return *this = FixedSizeFunction (std::forward<Callable> (callable));
+    }
+
+    //==============================================================================
+    /** Calls the function. You mustn't call this if the function is empty. */
+    Result operator() (Arguments... args) const
+    {
+        jassert (invoker != nullptr);
+        return invoker (&storage, std::forward<Arguments> (args)...);
+    }
+
+    /** Returns true if this function contains a callable object. */
+    explicit operator bool() const noexcept                 { return invoker != nullptr; }
+
+    /** Returns true if this function is empty. */
+    bool operator== (decltype (nullptr)) const noexcept     { return invoker == nullptr; }
+
+    /** Returns true if this function contains a callable object. */
+    bool operator!= (decltype (nullptr)) const noexcept     { return invoker != nullptr; }
+
+private:
+    //==============================================================================
+    using Storage = typename std::aligned_storage<(len > 0 ? len : 1)>::type;
+
+    // The manager either moves the object into an empty storage block, or just
+    // destroys it if the destination is null.
+    using Invoker = Result (*) (void*, Arguments...);
+    using Manager = void (*) (void* source, void* destination);
+
+    mutable Storage storage;
+    Invoker invoker = nullptr;
+    Manager manager = nullptr;
+
+    template <typename CallableType>
+    static Result invoke (void* callable, Arguments... args)
+    {
+        return static_cast<Result> ((*static_cast<CallableType*> (callable)) (std::forward<Arguments> (args)...));
+    }
+
+    template <typename CallableType>
+    static void manage (void* source, void* destination)
+    {
+        auto* callable = static_cast<CallableType*> (source);
+
+        if (destination != nullptr)
+            new (destination) CallableType (std::move (*callable));
+
+        callable->~CallableType();
+    }
+
+    void takeFrom (FixedSizeFunction& other) noexcept
+    {
+        if (other.manager != nullptr)
+        {
+            other.manager (&other.storage, &storage);
+            invoker = other.invoker;
+            manager = other.manager;
+            other.invoker = nullptr;
+            other.manager = nullptr;
+        }
+    }
+
+    void clear() noexcept
+    {
+        if (manager != nullptr)
+        {
+            auto* m = manager;
+            invoker = nullptr;
+            manager = nullptr;
+            m (&storage, nullptr);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FixedSizeFunction)
+};
+
+} // namespace juce
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FixedSizeFunctionTest  : public UnitTest
+{
+    FixedSizeFunctionTest() : UnitTest ("FixedSizeFunction", "Functions") {}
+
+    struct LifetimeCounter
+    {
+        LifetimeCounter (int& c) : count (c)                                { ++count; }
+        LifetimeCounter (const LifetimeCounter& other) : count (other.count) { ++count; }
+        ~LifetimeCounter()                                                   { --count; }
+
+        int& count;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Empty functions");
+        {
+            FixedSizeFunction<16, void()> f;
+            expect (! f);
+            expect (f == nullptr);
+
+            FixedSizeFunction<16, void()> g (nullptr);
+            expect (g == nullptr);
+        }
+
+        beginTest ("Calling lambdas and function pointers");
+        {
+            int a = 3, b = 4;
+            FixedSizeFunction<2 * sizeof (int*), int (int)> f = [&a, &b] (int x) { return a * x + b; };
+
+            expect (f != nullptr);
+            expectEquals (f (2), 10);
+
+            a = 5;
+            expectEquals (f (2), 14);
+
+            FixedSizeFunction<sizeof (void*), double (double)> g = static_cast<double (*) (double)> (std::sqrt);
+            expectEquals (g (16.0), 4.0);
+
+            FixedSizeFunction<8, void (int&)> increment = [] (int& x) { ++x; };
+            increment (a);
+            expectEquals (a, 6);
+
+            FixedSizeFunction<8, void()> discardsResult = [] { return 42; };
+            discardsResult();
+        }
+
+        beginTest ("Mutable lambdas keep their state");
+        {
+            int n = 0;
+            FixedSizeFunction<8, int()> counter = [n]() mutable { return ++n; };
+            counter();
+            counter();
+            expectEquals (counter(), 3);
+            expectEquals (n, 0);
+        }
+
+        beginTest ("Moving");
+        {
+            int numAlive = 0;
+
+            {
+                LifetimeCounter lc (numAlive);
+                FixedSizeFunction<16, int()> f = [lc] { return lc.count; };
+                expectEquals (numAlive, 2);
+
+                auto g = std::move (f);
+                expect (f == nullptr);
+                expect (g != nullptr);
+                expectEquals (numAlive, 2);
+                expectEquals (g(), 2);
+
+                FixedSizeFunction<16, int()> h;
+                h = std::move (g);
+                expect (g == nullptr);
+                expectEquals (numAlive, 2);
+
+                h = nullptr;
+                expect (h == nullptr);
+                expectEquals (numAlive, 1);
+
+                h = [lc] { return 0; };
+                expectEquals (numAlive, 2);
+
+                h = [] { return 1; };
+                expectEquals (numAlive, 1);
+                expectEquals (h(), 1);
+            }
+
+            expectEquals (numAlive, 0);
+        }
+
+        beginTest ("Move-only captures");
+        {
+            struct MoveOnly
+            {
+                std::unique_ptr<int> value;
+                int operator()() const  { return *value; }
+            };
+
+            FixedSizeFunction<sizeof (void*), int()> f = MoveOnly { std::unique_ptr<int> (new int (7)) };
+
+            auto g = std::move (f);
+            expectEquals (g(), 7);
+        }
+    }
+};
+
+static FixedSizeFunctionTest fixedSizeFunctionTest;
+
+} // namespace juce
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XXHashHelpers
+{
+    static const uint64 prime1 = 0x9e3779b185ebca87ULL;
+    static const uint64 prime2 = 0xc2b2ae3d27d4eb4fULL;
+    static const uint64 prime3 = 0x165667b19e3779f9ULL;
+    static const uint64 prime4 = 0x85ebca77c2b2ae63ULL;
+    static const uint64 prime5 = 0x27d4eb2f165667c5ULL;
+
+    static inline uint64 rotateLeft (uint64 x, int bits) noexcept   { return (x << bits) | (x >> (64 - bits)); }
+
+    static inline uint64 round (uint64 accumulator, uint64 input) noexcept
+    {
+        return rotateLeft (accumulator + input * prime2, 31) * prime1;
+    }
+
+    static inline uint64 mergeRound (uint64 hash, uint64 accumulator) noexcept
+    {
+        return (hash ^ round (0, accumulator)) * prime1 + prime4;
+    }
+
+    // Consumes as many whole 32-byte stripes as there are, and returns the number of bytes used
+    static size_t processStripes (uint64* acc, const uint8* data, size_t numBytes) noexcept
+    {
+        auto v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+        auto* end = data + (numBytes & ~(size_t) 31);
+
+        for (auto* d = data; d < end; d += 32)
+        {
+            v1 = round (v1, ByteOrder::littleEndianInt64 (d));
+            v2 = round (v2, ByteOrder::littleEndianInt64 (d + 8));
+            v3 = round (v3, ByteOrder::littleEndianInt64 (d + 16));
+            v4 = round (v4, ByteOrder::littleEndianInt64 (d + 24));
+        }
+
+        acc[0] = v1; acc[1] = v2; acc[2] = v3; acc[3] = v4;
+        return (size_t) (end - data);
+    }
+}
+
+//==============================================================================
+XXHash64::XXHash64 (uint64 seed) noexcept    { reset (seed); }
+XXHash64::~XXHash64() noexcept {}
+
+XXHash64::XXHash64 (const XXHash64& other) noexcept
+{
+    operator= (other);
+}
+
+XXHash64& XXHash64::operator= (const XXHash64& other) noexcept
+{
+    memcpy (accumulators, other.accumulators, sizeof (accumulators));
+    memcpy (pending, other.pending, sizeof (pending));
+    totalLength = other.totalLength;
+    seedValue = other.seedValue;
+    numPending = other.numPending;
+    return *this;
+}
+
+void XXHash64::reset (uint64 seed) noexcept
+{
+    using namespace XXHashHelpers;
+
+    accumulators[0] = seed + prime1 + prime2;
+    accumulators[1] = seed + prime2;
+    accumulators[2] = seed;
+    accumulators[3] = seed - prime1;
+    totalLength = 0;
+    numPending = 0;
+    seedValue = seed;
+}
+
+void XXHash64::addData (const void* data, size_t numBytes) noexcept
+{
+    auto* d = static_cast<const uint8*> (data);
+    totalLength += numBytes;
+
+    if (numPending > 0)
+    {
+        auto numToCopy = jmin (numBytes, (size_t) (sizeof (pending) - numPending));
+        memcpy (pending + numPending, d, numToCopy);
+        numPending += (uint32) numToCopy;
+        d += numToCopy;
+        numBytes -= numToCopy;
+
+        if (numPending < sizeof (pending))
+            return;
+
+        XXHashHelpers::processStripes (accumulators, pending, sizeof (pending));
+        numPending = 0;
+    }
+
+    auto numUsed = XXHashHelpers::processStripes (accumulators, d, numBytes);
+
+    numPending = (uint32) (numBytes - numUsed);
+    memcpy (pending, d + numUsed, numPending);
+}
+
+int64 XXHash64::addStream (InputStream& input, int64 maxBytesToRead)
+{
+    if (maxBytesToRead < 0)
+        maxBytesToRead = std::numeric_limits<int64>::max();
+
+    const int bufferSize = 65536;
+    HeapBlock<uint8> buffer (bufferSize);
+    int64 totalRead = 0;
+
+    while (totalRead < maxBytesToRead)
+    {
+        auto bytesRead = input.read (buffer, (int) jmin ((int64) bufferSize, maxBytesToRead - totalRead));
+
+        if (bytesRead <= 0)
+            break;
+
+        addData (buffer, (size_t) bytesRead);
+        totalRead += bytesRead;
+    }
+
+    return totalRead;
+}
+
+uint64 XXHash64::getResult() const noexcept
+{
+    using namespace XXHashHelpers;
+
+    uint64 h;
+
+    if (totalLength >= sizeof (pending))
+    {
+        h = rotateLeft (accumulators[0], 1)  + rotateLeft (accumulators[1], 7)
+          + rotateLeft (accumulators[2], 12) + rotateLeft (accumulators[3], 18);
+
+        for (auto a : accumulators)
+            h = mergeRound (h, a);
+    }
+    else
+    {
+        h = seedValue + prime5;
+    }
+
+    h += totalLength;
+
+    auto* d = pending;
+    auto* end = pending + numPending;
+
+    for (; d + 8 <= end; d += 8)
+        h = rotateLeft (h ^ round (0, ByteOrder::littleEndianInt64 (d)), 27) * prime1 + prime4;
+
+    if (d + 4 <= end)
+    {
+        h = rotateLeft (h ^ ((uint64) ByteOrder::littleEndianInt (d) * prime1), 23) * prime2 + prime3;
+        d += 4;
+    }
+
+    for (; d < end; ++d)
+        h = rotateLeft (h ^ (*d * prime5), 11) * prime1;
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+//==============================================================================
+uint64 XXHash64::hash (const void* data, size_t numBytes, uint64 seed) noexcept
+{
+    XXHash64 hasher (seed);
+    hasher.addData (data, numBytes);
+    return hasher.getResult();
+}
+
+uint64 XXHash64::hash (const MemoryBlock& data, uint64 seed) noexcept
+{
+    return hash (data.getData(), data.getSize(), seed);
+}
+
+uint64 XXHash64::hash (StringRef text, uint64 seed) noexcept
+{
+    return hash (text.text.getAddress(), text.text.sizeInBytes() - 1, seed);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XXHashTests  : public UnitTest
+{
+public:
+    XXHashTests() : UnitTest ("XXHash64", "Maths") {}
+
+    void runTest() override
+    {
+        beginTest ("Reference values");
+        {
+            expect (XXHash64::hash ("", 0) == 0xef46db3751d8e999ULL);
+            expect (XXHash64::hash ("a", 1) == 0xd24ec4f1a98c6e5bULL);
+            expect (XXHash64::hash ("abc", 3) == 0x44bc2cf5ad770999ULL);
+            expect (XXHash64::hash (StringRef ("The quick brown fox jumps over the lazy dog")) == 0x0b242d361fda71bcULL);
+        }
+
+        beginTest ("Incremental hashing");
+        {
+            auto r = getRandom();
+            MemoryBlock data (1000);
+            r.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (size_t size : { 0, 1, 3, 4, 7, 8, 31, 32, 33, 63, 64, 65, 100, 1000 })
+            {
+                auto seed = (uint64) r.nextInt64();
+                auto expected = XXHash64::hash (data.getData(), size, seed);
+
+                XXHash64 hasher (seed);
+                size_t pos = 0;
+
+                while (pos < size)
+                {
+                    auto chunk = jmin (size - pos, (size_t) r.nextInt (40));
+                    hasher.addData (addBytesToPointer (data.getData(), pos), chunk);
+                    pos += chunk;
+                }
+
+                expect (hasher.getResult() == expected);
+
+                MemoryInputStream m (data.getData(), size, false);
+                XXHash64 streamHasher (seed);
+                expectEquals (streamHasher.addStream (m), (int64) size);
+                expect (streamHasher.getResult() == expected);
+            }
+        }
+
+        beginTest ("Different seeds give different hashes");
+        {
+            expect (XXHash64::hash ("abc", 3, 1) != XXHash64::hash ("abc", 3, 2));
+        }
+    }
+};
+
+static XXHashTests xxHashTests;
+
+#endif
+
+} // namespace juce
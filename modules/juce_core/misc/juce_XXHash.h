@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Calculates a 64-bit xxHash (XXH64) of a block of data.
+
+    This is a very fast non-cryptographic hash, which is a good choice for things
+    like cache keys, hash-table lookups or checking whether a file has changed. It
+    can run at several GB/s, which is many times faster than MD5 or SHA256, but
+    it's NOT secure - don't use it for anything where someone might deliberately
+    try to create a collision. For that, use SHA256 from the juce_cryptography module.
+
+    The results are the same as the reference XXH64 implementation, so they can be
+    compared with hashes that were created by other programs.
+
+    You can either hash a whole block in one go:
+    @code
+    auto key = XXHash64::hash (data, numBytes);
+    @endcode
+
+    ..or feed it the data a piece at a time:
+    @code
+    XXHash64 hasher;
+    hasher.addData (header, headerSize);
+    hasher.addStream (fileStream);
+    auto key = hasher.getResult();
+    @endcode
+*/
+class JUCE_API  XXHash64
+{
+public:
+    //==============================================================================
+    /** Creates a hasher with no data added yet. */
+    explicit XXHash64 (uint64 seed = 0) noexcept;
+
+    /** Destructor. */
+    ~XXHash64() noexcept;
+
+    /** Creates a copy of another hasher, including any data it has been given. */
+    XXHash64 (const XXHash64&) noexcept;
+
+    /** Copies another hasher, including any data it has been given. */
+    XXHash64& operator= (const XXHash64&) noexcept;
+
+    //==============================================================================
+    /** Adds a block of data to the hash. */
+    void addData (const void* data, size_t numBytes) noexcept;
+
+    /** Reads data from a stream and adds it to the hash.
+
+        This will read from the stream until the stream is exhausted, or until
+        maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+        stream will be read.
+
+        @returns the number of bytes that were read
+    */
+    int64 addStream (InputStream& input, int64 maxBytesToRead = -1);
+
+    /** Returns the hash of all the data that has been added so far.
+        This doesn't change the hasher's state, so you can carry on adding more data
+        afterwards.
+    */
+    uint64 getResult() const noexcept;
+
+    /** Clears any data that has been added, and starts again with a new seed. */
+    void reset (uint64 seed = 0) noexcept;
+
+    //==============================================================================
+    /** Returns the hash of a block of data. */
+    static uint64 hash (const void* data, size_t numBytes, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of a MemoryBlock. */
+    static uint64 hash (const MemoryBlock& data, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of the UTF-8 representation of a string. */
+    static uint64 hash (StringRef text, uint64 seed = 0) noexcept;
+
+private:
+    //==============================================================================
+    uint64 accumulators[4], totalLength = 0, seedValue;
+    uint8 pending[32];
+    uint32 numPending = 0;
+
+    JUCE_LEAK_DETECTOR (XXHash64)
+};
+
+} // namespace juce
@@ -476,11 +476,13 @@ void CPUInformation::initialise() noexcept
     else if (cpuFamily == ANDROID_CPU_FAMILY_ARM)
     {
         hasNeon = ((cpuFeatures & ANDROID_CPU_ARM_FEATURE_NEON) != 0);
+        hasSHA  = ((cpuFeatures & ANDROID_CPU_ARM_FEATURE_SHA2) != 0);
     }
     else if (cpuFamily == ANDROID_CPU_FAMILY_ARM64)
     {
         // all arm 64-bit cpus have neon
         hasNeon = true;
+        hasSHA  = ((cpuFeatures & ANDROID_CPU_ARM64_FEATURE_SHA2) != 0);
     }
 }
 
@@ -23,6 +23,109 @@
 namespace juce
 {
 
+/*  Keeps the curl handles of finished streams so that later streams can use them again.
+
+    A multi handle holds on to the connections that its transfers have used, so a
+    stream that gets a recycled one can skip connecting and, for https, the TLS
+    handshake if it's talking to the same server. All the handles also share their
+    DNS lookups and TLS sessions, so a new connection to a known server is cheaper too.
+*/
+struct CurlHandlePool
+{
+    static CurlHandlePool& getInstance()
+    {
+        static CurlHandlePool pool;
+        return pool;
+    }
+
+    CurlHandlePool()
+    {
+        share = curl_share_init();
+
+        if (share != nullptr)
+        {
+            curl_share_setopt (share, CURLSHOPT_LOCKFUNC, lockShare);
+            curl_share_setopt (share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+            curl_share_setopt (share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+
+    ~CurlHandlePool()
+    {
+        for (auto& h : idleHandles)
+        {
+            curl_easy_cleanup (h.curl);
+            curl_multi_cleanup (h.multi);
+        }
+
+        if (share != nullptr)
+            curl_share_cleanup (share);
+    }
+
+    /** Returns an idle pair of handles, or false if there aren't any. */
+    bool take (CURLM*& multi, CURL*& curl)
+    {
+        const ScopedLock sl (lock);
+
+        if (idleHandles.isEmpty())
+            return false;
+
+        auto h = idleHandles.removeAndReturn (idleHandles.size() - 1);
+        multi = h.multi;
+        curl = h.curl;
+        return true;
+    }
+
+    /** Takes back a pair of handles. The easy handle mustn't be attached to the multi handle. */
+    void release (CURLM* multi, CURL* curl)
+    {
+        curl_easy_reset (curl);
+
+        {
+            const ScopedLock sl (lock);
+
+            if (idleHandles.size() < maxIdleHandles)
+            {
+                idleHandles.add ({ multi, curl });
+                return;
+            }
+        }
+
+        curl_easy_cleanup (curl);
+        curl_multi_cleanup (multi);
+    }
+
+    CURLSH* share = nullptr;
+
+private:
+    struct Handles
+    {
+        CURLM* multi;
+        CURL* curl;
+    };
+
+    Array<Handles> idleHandles;
+    CriticalSection lock;
+    CriticalSection shareLocks[CURL_LOCK_DATA_LAST];
+
+    enum { maxIdleHandles = 8 };
+
+    static void lockShare (CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+    {
+        if (isPositiveAndBelow ((int) data, (int) CURL_LOCK_DATA_LAST))
+            static_cast<CurlHandlePool*> (userptr)->shareLocks[data].enter();
+    }
+
+    static void unlockShare (CURL*, curl_lock_data data, void* userptr)
+    {
+        if (isPositiveAndBelow ((int) data, (int) CURL_LOCK_DATA_LAST))
+            static_cast<CurlHandlePool*> (userptr)->shareLocks[data].exit();
+    }
+};
+
+//==============================================================================
 class WebInputStream::Pimpl
 {
 public:
@@ -30,17 +133,18 @@ public:
         : owner (ownerStream), url (urlToCopy), isPost (shouldUsePost),
           httpRequest (isPost ? "POST" : "GET")
     {
-        multi = curl_multi_init();
-
-        if (multi != nullptr)
+        if (! CurlHandlePool::getInstance().take (multi, curl))
         {
-            curl = curl_easy_init();
+            multi = curl_multi_init();
 
-            if (curl != nullptr)
-                if (curl_multi_add_handle (multi, curl) == CURLM_OK)
-                    return;
+            if (multi != nullptr)
+                curl = curl_easy_init();
         }
 
+        if (curl != nullptr)
+            if (curl_multi_add_handle (multi, curl) == CURLM_OK)
+                return;
+
         cleanup();
     }
 
@@ -111,8 +215,11 @@ public:
                 headerList = nullptr;
             }
 
-            curl_easy_cleanup (curl);
+            // Removing the easy handle has aborted any unfinished transfer, so the handles
+            // can be used again. Their connections are only kept if they were left idle.
+            CurlHandlePool::getInstance().release (multi, curl);
             curl = nullptr;
+            multi = nullptr;
         }
 
         if (multi != nullptr)
@@ -153,6 +260,16 @@ public:
             && curl_easy_setopt (curl, CURLOPT_USERAGENT, userAgent.toRawUTF8()) == CURLE_OK
             && curl_easy_setopt (curl, CURLOPT_FOLLOWLOCATION, (maxRedirects > 0 ? 1 : 0)) == CURLE_OK)
         {
+            if (auto* share = CurlHandlePool::getInstance().share)
+                curl_easy_setopt (curl, CURLOPT_SHARE, share);
+
+           #if LIBCURL_VERSION_NUM >= 0x072f00
+            // Uses HTTP/2 for https if the server and this build of curl support it. Each
+            // stream has its own connection, so requests don't get multiplexed, but headers
+            // are compressed and a connection can be reused for the next stream.
+            curl_easy_setopt (curl, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS);
+           #endif
+
             if (isPost)
             {
                 if (curl_easy_setopt (curl, CURLOPT_READDATA, this) != CURLE_OK
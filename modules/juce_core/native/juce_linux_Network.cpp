@@ -66,6 +66,121 @@ bool JUCE_CALLTYPE Process::openEmailWithAttachments (const String& /* targetEma
 
 //==============================================================================
 #if ! JUCE_USE_CURL
+/*  Holds on to sockets whose last response has been read completely, so that the next
+    request to the same server can skip connecting.
+*/
+struct HTTPConnectionPool
+{
+    static HTTPConnectionPool& getInstance()
+    {
+        static HTTPConnectionPool pool;
+        return pool;
+    }
+
+    ~HTTPConnectionPool()
+    {
+        for (auto& c : idleConnections)
+            ::close (c.socketHandle);
+    }
+
+    /** Returns an idle socket that's connected to the given server, or -1 if there isn't one. */
+    int takeConnection (const String& serverKey)
+    {
+        Array<int> socketsToClose;
+        int result = -1;
+
+        {
+            const ScopedLock sl (lock);
+            auto now = Time::getMillisecondCounter();
+
+            for (int i = idleConnections.size(); --i >= 0;)
+            {
+                auto c = idleConnections.getReference (i);
+
+                if (c.serverKey == serverKey)
+                {
+                    idleConnections.remove (i);
+
+                    if (now - c.timeReleased < maxIdleTimeMs && ! hasBeenClosedByServer (c.socketHandle))
+                    {
+                        result = c.socketHandle;
+                        break;
+                    }
+
+                    socketsToClose.add (c.socketHandle);
+                }
+            }
+        }
+
+        for (auto s : socketsToClose)
+            ::close (s);
+
+        return result;
+    }
+
+    /** Takes ownership of a socket that can be used for another request to the same server. */
+    void releaseConnection (const String& serverKey, int socketHandle)
+    {
+        Array<int> socketsToClose;
+
+        {
+            const ScopedLock sl (lock);
+            auto now = Time::getMillisecondCounter();
+
+            for (int i = idleConnections.size(); --i >= 0;)
+            {
+                if (now - idleConnections.getReference (i).timeReleased >= maxIdleTimeMs)
+                {
+                    socketsToClose.add (idleConnections.getReference (i).socketHandle);
+                    idleConnections.remove (i);
+                }
+            }
+
+            if (idleConnections.size() >= maxIdleConnections)
+            {
+                socketsToClose.add (idleConnections.getReference (0).socketHandle);
+                idleConnections.remove (0);
+            }
+
+            idleConnections.add ({ serverKey, socketHandle, now });
+        }
+
+        for (auto s : socketsToClose)
+            ::close (s);
+    }
+
+private:
+    struct IdleConnection
+    {
+        String serverKey;
+        int socketHandle;
+        uint32 timeReleased;
+    };
+
+    Array<IdleConnection> idleConnections;
+    CriticalSection lock;
+
+    // Servers commonly drop idle connections after 5 to 15 seconds, and any socket that's
+    // been closed in the meantime is caught by hasBeenClosedByServer()
+    enum { maxIdleConnections = 16, maxIdleTimeMs = 10000 };
+
+    // An idle connection shouldn't have anything to read, so if it's readable then the
+    // server has closed it, or sent something that we can't use.
+    static bool hasBeenClosedByServer (int socketHandle)
+    {
+        fd_set readbits;
+        FD_ZERO (&readbits);
+        FD_SET (socketHandle, &readbits);
+
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = 0;
+
+        return select (socketHandle + 1, &readbits, 0, 0, &tv) != 0;
+    }
+};
+
+//==============================================================================
 class WebInputStream::Pimpl
 {
 public:
@@ -194,6 +309,7 @@ public:
 
                 if (chunkSize == 0)
                 {
+                    bodyFinished = readChunkTrailer();
                     finished = true;
                     return 0;
                 }
@@ -204,6 +320,19 @@ public:
             if (bytesToRead > chunkEnd - position)
                 bytesToRead = static_cast<int> (chunkEnd - position);
         }
+        else if (contentLength >= 0 && ! isChunked)
+        {
+            // the server won't close a kept-alive connection, so we mustn't wait for more than the body
+            if (position >= contentLength)
+            {
+                bodyFinished = true;
+                finished = true;
+                return 0;
+            }
+
+            if (bytesToRead > contentLength - position)
+                bytesToRead = static_cast<int> (contentLength - position);
+        }
 
         fd_set readbits;
         FD_ZERO (&readbits);
@@ -217,12 +346,28 @@ public:
             return 0;   // (timeout)
 
         const int bytesRead = jmax (0, (int) recv (socketHandle, buffer, (size_t) bytesToRead, MSG_WAITALL));
+
+       #ifdef TCP_QUICKACK
+        // Linux only acknowledges packets quickly at the start of a connection, so on a
+        // kept-alive one a server that writes its headers and body separately would have
+        // to wait for a delayed ACK before it can send the body.
+        const int one = 1;
+        setsockopt (socketHandle, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof (one));
+       #endif
         if (bytesRead == 0)
             finished = true;
 
         if (! readingChunk)
+        {
             position += bytesRead;
 
+            if (contentLength >= 0 && ! isChunked && position >= contentLength)
+            {
+                bodyFinished = true;
+                finished = true;
+            }
+        }
+
         return bytesRead;
     }
 
@@ -269,6 +414,8 @@ private:
     bool isChunked = false, readingChunk = false;
     CriticalSection closeSocketLock, createSocketLock;
     bool hasBeenCancelled = false;
+    String serverKey;
+    bool keepAlive = false, bodyFinished = false, socketIsFromPool = false;
 
     void closeSocket (bool resetLevelsOfRedirection = true)
     {
@@ -276,11 +423,20 @@ private:
 
         if (socketHandle >= 0)
         {
-            ::shutdown (socketHandle, SHUT_RDWR);
-            ::close (socketHandle);
+            if (keepAlive && bodyFinished && ! hasBeenCancelled)
+            {
+                HTTPConnectionPool::getInstance().releaseConnection (serverKey, socketHandle);
+            }
+            else
+            {
+                ::shutdown (socketHandle, SHUT_RDWR);
+                ::close (socketHandle);
+            }
         }
 
         socketHandle = -1;
+        keepAlive = false;
+        bodyFinished = false;
 
         if (resetLevelsOfRedirection)
             levelsOfRedirection = 0;
@@ -327,59 +483,40 @@ private:
             port = hostPort;
         }
 
-        struct addrinfo hints;
-        zerostruct (hints);
+        serverKey = serverName.toLowerCase() + ":" + String (port);
 
-        hints.ai_family = AF_UNSPEC;
-        hints.ai_socktype = SOCK_STREAM;
-        hints.ai_flags = AI_NUMERICSERV;
+        const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort, hostPath,
+                                                              address, headers, postData, isPost, httpRequestCmd));
+        String responseHeader;
 
-        struct addrinfo* result = nullptr;
-        if (getaddrinfo (serverName.toUTF8(), String (port).toUTF8(), &hints, &result) != 0 || result == 0)
-            return 0;
-
-        {
-            const ScopedLock lock (createSocketLock);
-
-            socketHandle = hasBeenCancelled ? -1
-                                            : socket (result->ai_family, result->ai_socktype, 0);
-        }
-
-        if (socketHandle == -1)
+        // If a pooled connection turns out to have been closed by the server, the request
+        // is sent again on a new one.
+        for (bool allowPooledConnection = true;; allowPooledConnection = false)
         {
-            freeaddrinfo (result);
-            return 0;
-        }
-
-        int receiveBufferSize = 16384;
-        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
-        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
-
-      #if JUCE_MAC
-        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
-      #endif
-
-        if (::connect (socketHandle, result->ai_addr, result->ai_addrlen) == -1)
-        {
-            closeSocket();
-            freeaddrinfo (result);
-            return 0;
-        }
+            finished = false;
+            isChunked = false;
+            contentLength = -1;
+            position = 0;
 
-        freeaddrinfo (result);
+            if (! openSocket (serverName, port, allowPooledConnection))
+                return 0;
 
-        {
-            const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort, hostPath,
-                                                                  address, headers, postData, isPost, httpRequestCmd));
+            if (sendHeader (socketHandle, requestHeader, timeOutTime, owner, listener))
+            {
+                responseHeader = readResponse (timeOutTime);
 
-            if (! sendHeader (socketHandle, requestHeader, timeOutTime, owner, listener))
+                if (responseHeader.isNotEmpty() || ! socketIsFromPool)
+                    break;
+            }
+            else if (! socketIsFromPool)
             {
                 closeSocket();
                 return 0;
             }
+
+            closeSocket (false);
         }
 
-        String responseHeader (readResponse (timeOutTime));
         position = 0;
 
         if (responseHeader.isNotEmpty())
@@ -389,6 +526,42 @@ private:
             const int status = responseHeader.fromFirstOccurrenceOf (" ", false, false)
                                              .substring (0, 3).getIntValue();
 
+            String contentLengthString (findHeaderItem (headerLines, "Content-Length:"));
+
+            if (contentLengthString.isNotEmpty())
+                contentLength = contentLengthString.getLargeIntValue();
+
+            isChunked = (findHeaderItem (headerLines, "Transfer-Encoding:") == "chunked");
+            chunkEnd = 0;
+
+            const String connectionHeader (findHeaderItem (headerLines, "Connection:"));
+            const String proxyConnectionHeader (findHeaderItem (headerLines, "Proxy-Connection:"));
+
+            if (responseHeader.startsWithIgnoreCase ("HTTP/1.0"))
+                keepAlive = connectionHeader.equalsIgnoreCase ("keep-alive") || proxyConnectionHeader.equalsIgnoreCase ("keep-alive");
+            else
+                keepAlive = ! (connectionHeader.equalsIgnoreCase ("close") || proxyConnectionHeader.equalsIgnoreCase ("close"));
+
+            if (httpRequestCmd == "HEAD" || status == 204 || status == 304 || (status >= 100 && status < 200))
+            {
+                // these responses never have a body, whatever their headers say
+                bodyFinished = true;
+                finished = true;
+            }
+            else if (! isChunked)
+            {
+                if (contentLength == 0)
+                {
+                    bodyFinished = true;
+                    finished = true;
+                }
+                else if (contentLength < 0)
+                {
+                    // the end of the body can only be found when the server closes the connection
+                    keepAlive = false;
+                }
+            }
+
             String location (findHeaderItem (headerLines, "Location:"));
 
             if (++levelsOfRedirection <= numRedirects
@@ -410,13 +583,6 @@ private:
                 return createConnection (listener, numRedirects);
             }
 
-            String contentLengthString (findHeaderItem (headerLines, "Content-Length:"));
-
-            if (contentLengthString.isNotEmpty())
-                contentLength = contentLengthString.getLargeIntValue();
-
-            isChunked = (findHeaderItem (headerLines, "Transfer-Encoding:") == "chunked");
-
             return status;
         }
 
@@ -424,6 +590,95 @@ private:
         return 0;
     }
 
+    bool openSocket (const String& serverName, int port, bool allowPooledConnection)
+    {
+        if (allowPooledConnection)
+        {
+            const ScopedLock lock (createSocketLock);
+
+            if (hasBeenCancelled)
+                return false;
+
+            socketHandle = HTTPConnectionPool::getInstance().takeConnection (serverKey);
+            socketIsFromPool = (socketHandle >= 0);
+
+            if (socketIsFromPool)
+                return true;
+        }
+
+        socketIsFromPool = false;
+
+        struct addrinfo hints;
+        zerostruct (hints);
+
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICSERV;
+
+        struct addrinfo* result = nullptr;
+        if (getaddrinfo (serverName.toUTF8(), String (port).toUTF8(), &hints, &result) != 0 || result == 0)
+            return false;
+
+        {
+            const ScopedLock lock (createSocketLock);
+
+            socketHandle = hasBeenCancelled ? -1
+                                            : socket (result->ai_family, result->ai_socktype, 0);
+        }
+
+        if (socketHandle == -1)
+        {
+            freeaddrinfo (result);
+            return false;
+        }
+
+        int receiveBufferSize = 16384;
+        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
+        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
+
+      #if JUCE_MAC
+        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
+      #endif
+
+        if (::connect (socketHandle, result->ai_addr, result->ai_addrlen) == -1)
+        {
+            closeSocket();
+            freeaddrinfo (result);
+            return false;
+        }
+
+        freeaddrinfo (result);
+        return true;
+    }
+
+    // Reads the optional trailer headers and the blank line that end a chunked body.
+    bool readChunkTrailer()
+    {
+        int lineLength = 0;
+
+        for (int i = 0; i < 8192; ++i)
+        {
+            char c = 0;
+
+            if (read (&c, 1) != 1)
+                return false;
+
+            if (c == '\n')
+            {
+                if (lineLength == 0)
+                    return true;
+
+                lineLength = 0;
+            }
+            else if (c != '\r')
+            {
+                ++lineLength;
+            }
+        }
+
+        return false;
+    }
+
     //==============================================================================
     String readResponse (const uint32 timeOutTime)
     {
@@ -487,7 +742,7 @@ private:
         writeValueIfNotPresent (header, userHeaders, "User-Agent:", "JUCE/" JUCE_STRINGIFY(JUCE_MAJOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_MINOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_BUILDNUMBER));
-        writeValueIfNotPresent (header, userHeaders, "Connection:", "close");
+        writeValueIfNotPresent (header, userHeaders, "Connection:", "keep-alive");
 
         if (isPost)
             writeValueIfNotPresent (header, userHeaders, "Content-Length:", String ((int) postData.getSize()));
@@ -508,6 +763,13 @@ private:
     {
         size_t totalHeaderSent = 0;
 
+        // a pooled connection may have been closed by the server, which mustn't raise SIGPIPE
+       #ifdef MSG_NOSIGNAL
+        const int sendFlags = MSG_NOSIGNAL;
+       #else
+        const int sendFlags = 0;
+       #endif
+
         while (totalHeaderSent < requestHeader.getSize())
         {
             if (Time::getMillisecondCounter() > timeOutTime)
@@ -515,7 +777,7 @@ private:
 
             const int numToSend = jmin (1024, (int) (requestHeader.getSize() - totalHeaderSent));
 
-            if (send (socketHandle, static_cast<const char*> (requestHeader.getData()) + totalHeaderSent, (size_t) numToSend, 0) != numToSend)
+            if (send (socketHandle, static_cast<const char*> (requestHeader.getData()) + totalHeaderSent, (size_t) numToSend, sendFlags) != numToSend)
                 return false;
 
             totalHeaderSent += (size_t) numToSend;
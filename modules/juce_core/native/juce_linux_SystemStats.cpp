@@ -147,6 +147,14 @@ void CPUInformation::initialise() noexcept
     hasSSE42 = flags.contains ("sse4_2");
     hasAVX   = flags.contains ("avx");
     hasAVX2  = flags.contains ("avx2");
+    hasAVX512F = flags.contains ("avx512f");
+    hasPCLMULQDQ = flags.contains ("pclmulqdq");
+
+    // (ARM CPUs list their extensions under "Features" rather than "flags")
+    auto armFeatures = getCpuInfo ("Features");
+    hasSHA   = flags.contains ("sha_ni") || armFeatures.contains ("sha2");
+    hasNeon  = armFeatures.contains ("neon") || armFeatures.contains ("asimd");
+    hasSVE   = armFeatures.contains ("sve");
 
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
@@ -81,9 +81,12 @@ void CPUInformation::initialise() noexcept
     hasSSE41 = (c & (1u << 19)) != 0;
     hasSSE42 = (c & (1u << 20)) != 0;
     hasAVX   = (c & (1u << 28)) != 0;
+    hasPCLMULQDQ = (c & (1u << 1)) != 0;
 
     SystemStatsHelpers::doCPUID (a, b, c, d, 7);
     hasAVX2  = (b & (1u <<  5)) != 0;
+    hasAVX512F = (b & (1u << 16)) != 0;
+    hasSHA   = (b & (1u << 29)) != 0;
    #endif
 
     numLogicalCPUs = (int) [[NSProcessInfo processInfo] activeProcessorCount];
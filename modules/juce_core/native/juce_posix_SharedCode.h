@@ -36,99 +36,190 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { pthread_mutex_destroy (&lock); }
-void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock); }
+void CriticalSection::enter() const noexcept        { JUCE_REALTIME_SAFETY_CHECK (lockAcquired); pthread_mutex_lock (&lock); }
 bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
 //==============================================================================
-WaitableEvent::WaitableEvent (const bool useManualReset) noexcept
-    : triggered (false), manualReset (useManualReset)
-{
-    pthread_cond_init (&condition, 0);
-
-    pthread_mutexattr_t atts;
-    pthread_mutexattr_init (&atts);
-   #if ! JUCE_ANDROID
-    pthread_mutexattr_setprotocol (&atts, PTHREAD_PRIO_INHERIT);
-   #endif
-    pthread_mutex_init (&mutex, &atts);
-    pthread_mutexattr_destroy (&atts);
-}
+// These let a thread sleep until another thread changes the value of an atomic int,
+// which is all that WaitableEvent, AdaptiveLock and LightweightSemaphore need from the
+// OS. A wait may return early for no reason, so callers must always check the value
+// again afterwards.
+#if ! (JUCE_LINUX || JUCE_ANDROID)
+namespace ParkingLot
+{
+    // A fallback for systems that can't wait on an address: the waiting threads sleep on
+    // a condition variable from a table that's indexed by the address
+    struct Bucket
+    {
+        Bucket() noexcept
+        {
+            pthread_mutex_init (&mutex, nullptr);
+            pthread_cond_init (&condition, nullptr);
+        }
 
-WaitableEvent::~WaitableEvent() noexcept
-{
-    pthread_cond_destroy (&condition);
-    pthread_mutex_destroy (&mutex);
-}
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+    };
 
-bool WaitableEvent::wait (const int timeOutMillisecs) const noexcept
-{
-    pthread_mutex_lock (&mutex);
+    static Bucket& getBucket (const void* address) noexcept
+    {
+        static Bucket buckets[31];
+        return buckets[(pointer_sized_uint) address % numElementsInArray (buckets)];
+    }
 
-    if (! triggered)
+    static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
     {
-        if (timeOutMillisecs < 0)
+        auto& bucket = getBucket (&word);
+        pthread_mutex_lock (&bucket.mutex);
+
+        if (word.load() == expectedValue)
         {
-            do
+            if (timeoutMilliseconds < 0)
             {
-                pthread_cond_wait (&condition, &mutex);
+                pthread_cond_wait (&bucket.condition, &bucket.mutex);
             }
-            while (! triggered);
-        }
-        else
-        {
-            struct timeval now;
-            gettimeofday (&now, 0);
-
-            struct timespec time;
-            time.tv_sec  = now.tv_sec  + (timeOutMillisecs / 1000);
-            time.tv_nsec = (now.tv_usec + ((timeOutMillisecs % 1000) * 1000)) * 1000;
-
-            if (time.tv_nsec >= 1000000000)
+            else
             {
-                time.tv_nsec -= 1000000000;
-                time.tv_sec++;
-            }
+                struct timeval now;
+                gettimeofday (&now, 0);
 
-            do
-            {
-                if (pthread_cond_timedwait (&condition, &mutex, &time) == ETIMEDOUT)
+                struct timespec time;
+                time.tv_sec  = now.tv_sec  + (timeoutMilliseconds / 1000);
+                time.tv_nsec = (now.tv_usec + ((timeoutMilliseconds % 1000) * 1000)) * 1000;
+
+                if (time.tv_nsec >= 1000000000)
                 {
-                    pthread_mutex_unlock (&mutex);
-                    return false;
+                    time.tv_nsec -= 1000000000;
+                    time.tv_sec++;
                 }
+
+                pthread_cond_timedwait (&bucket.condition, &bucket.mutex, &time);
             }
-            while (! triggered);
         }
+
+        pthread_mutex_unlock (&bucket.mutex);
+    }
+
+    // other addresses can share the bucket, so this always has to wake all of them
+    static void wake (std::atomic<int32>& word) noexcept
+    {
+        auto& bucket = getBucket (&word);
+        pthread_mutex_lock (&bucket.mutex);
+        pthread_cond_broadcast (&bucket.condition);
+        pthread_mutex_unlock (&bucket.mutex);
+    }
+}
+#endif
+
+#if JUCE_LINUX || JUCE_ANDROID
+
+namespace FutexHelpers
+{
+    static inline long futex (std::atomic<int32>& word, int op, int32 value,
+                              const struct timespec* timeout = nullptr) noexcept
+    {
+        return syscall (SYS_futex, reinterpret_cast<int32*> (&word), op, value, timeout, nullptr, 0);
+    }
+
+    // PI futexes have to contain the kernel's ID for the thread that owns them
+    static inline int32 getCurrentThreadID() noexcept
+    {
+        static thread_local const int32 threadID = (int32) syscall (SYS_gettid);
+        return threadID;
     }
+}
+
+namespace AddressWait
+{
+    static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
+    {
+        struct timespec timeout;
+        timeout.tv_sec = timeoutMilliseconds / 1000;
+        timeout.tv_nsec = (timeoutMilliseconds % 1000) * 1000000;
 
-    if (! manualReset)
-        triggered = false;
+        FutexHelpers::futex (word, FUTEX_WAIT_PRIVATE, expectedValue, timeoutMilliseconds >= 0 ? &timeout : nullptr);
+    }
 
-    pthread_mutex_unlock (&mutex);
-    return true;
+    static void wakeOne (std::atomic<int32>& word) noexcept    { FutexHelpers::futex (word, FUTEX_WAKE_PRIVATE, 1); }
+    static void wakeAll (std::atomic<int32>& word) noexcept    { FutexHelpers::futex (word, FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max()); }
 }
 
-void WaitableEvent::signal() const noexcept
+#elif JUCE_MAC || JUCE_IOS
+
+namespace AddressWait
 {
-    pthread_mutex_lock (&mutex);
+    // __ulock_wait and __ulock_wake are the same primitives that libc++ uses for its atomic
+    // waits. They've only existed since macOS 10.12 and iOS 10, so are looked up at runtime.
+    struct ULockFunctions
+    {
+        typedef int (*WaitFunction) (uint32_t operation, void* address, uint64_t value, uint32_t timeoutMicrosecs);
+        typedef int (*WakeFunction) (uint32_t operation, void* address, uint64_t wakeValue);
+
+        enum
+        {
+            compareAndWait = 1,
+            wakeAllFlag    = 0x00000100,
+            noErrnoFlag    = 0x01000000
+        };
+
+        WaitFunction waitFunction = (WaitFunction) dlsym (RTLD_DEFAULT, "__ulock_wait");
+        WakeFunction wakeFunction = (WakeFunction) dlsym (RTLD_DEFAULT, "__ulock_wake");
+
+        bool isAvailable() const noexcept     { return waitFunction != nullptr && wakeFunction != nullptr; }
+    };
+
+    static const ULockFunctions& getULockFunctions() noexcept
+    {
+        static ULockFunctions functions;
+        return functions;
+    }
+
+    static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
+    {
+        auto& ulock = getULockFunctions();
+
+        if (! ulock.isAvailable())
+            return ParkingLot::wait (word, expectedValue, timeoutMilliseconds);
+
+        // a timeout of zero means wait forever
+        auto timeoutMicrosecs = timeoutMilliseconds < 0 ? 0 : (uint32_t) jmax (1, timeoutMilliseconds) * 1000u;
+
+        ulock.waitFunction (ULockFunctions::compareAndWait | ULockFunctions::noErrnoFlag,
+                            &word, (uint64_t) (uint32) expectedValue, timeoutMicrosecs);
+    }
 
-    if (! triggered)
+    static void wake (std::atomic<int32>& word, bool wakeAllThreads) noexcept
     {
-        triggered = true;
-        pthread_cond_broadcast (&condition);
+        auto& ulock = getULockFunctions();
+
+        if (! ulock.isAvailable())
+            return ParkingLot::wake (word);
+
+        ulock.wakeFunction (ULockFunctions::compareAndWait | ULockFunctions::noErrnoFlag
+                              | (wakeAllThreads ? (uint32_t) ULockFunctions::wakeAllFlag : 0u),
+                            &word, 0);
     }
 
-    pthread_mutex_unlock (&mutex);
+    static void wakeOne (std::atomic<int32>& word) noexcept    { wake (word, false); }
+    static void wakeAll (std::atomic<int32>& word) noexcept    { wake (word, true); }
 }
 
-void WaitableEvent::reset() const noexcept
+#else
+
+namespace AddressWait
 {
-    pthread_mutex_lock (&mutex);
-    triggered = false;
-    pthread_mutex_unlock (&mutex);
+    static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
+    {
+        ParkingLot::wait (word, expectedValue, timeoutMilliseconds);
+    }
+
+    static void wakeOne (std::atomic<int32>& word) noexcept    { ParkingLot::wake (word); }
+    static void wakeAll (std::atomic<int32>& word) noexcept    { ParkingLot::wake (word); }
 }
 
+#endif
+
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
@@ -1032,6 +1123,67 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return pthread_setschedparam ((pthread_t) handle, policy, &param) == 0;
 }
 
+bool Thread::setCurrentThreadRealtime (const RealtimeOptions& options)
+{
+    if (options.affinityMask != 0)
+        setCurrentThreadAffinityMask (options.affinityMask);
+
+   #if JUCE_MAC || JUCE_IOS
+    if (options.periodMs > 0)
+    {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info (&timebase);
+
+        auto toMachTime = [&timebase] (double ms)  { return (uint32_t) (ms * 1.0e6 * timebase.denom / timebase.numer); };
+
+        thread_time_constraint_policy_data_t policy;
+        policy.period      = toMachTime (options.periodMs);
+        policy.computation = toMachTime (options.getProcessingTimeMs());
+        policy.constraint  = toMachTime (options.getMaximumProcessingTimeMs());
+        policy.preemptible = true;
+
+        return thread_policy_set (pthread_mach_thread_np (pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                                  (thread_policy_t) &policy, THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+    }
+
+    return setThreadPriority (nullptr, options.priority);
+   #else
+    #if JUCE_LINUX && defined (SYS_sched_setattr)
+    if (options.useDeadlineScheduling && options.periodMs > 0)
+    {
+        // glibc doesn't have a wrapper for sched_setattr(), so this is the kernel's struct
+        struct
+        {
+            uint32 size, policy;
+            uint64 flags;
+            int32 nice;
+            uint32 priority;
+            uint64 runtime, deadline, period;
+        } attr = {};
+
+        const uint32 schedDeadline = 6;
+
+        attr.size     = sizeof (attr);
+        attr.policy   = schedDeadline;
+        attr.runtime  = (uint64) (options.getProcessingTimeMs() * 1.0e6);
+        attr.deadline = (uint64) (options.getMaximumProcessingTimeMs() * 1.0e6);
+        attr.period   = (uint64) (options.periodMs * 1.0e6);
+
+        if (syscall (SYS_sched_setattr, 0, &attr, 0) == 0)
+            return true;
+    }
+    #endif
+
+    const int minPriority = sched_get_priority_min (SCHED_FIFO);
+    const int maxPriority = sched_get_priority_max (SCHED_FIFO);
+
+    struct sched_param param;
+    param.sched_priority = ((maxPriority - minPriority) * options.priority) / 10 + minPriority;
+
+    return pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) == 0;
+   #endif
+}
+
 Thread::ThreadID JUCE_CALLTYPE Thread::getCurrentThreadId()
 {
     return (ThreadID) pthread_self();
@@ -1051,7 +1203,7 @@ void JUCE_CALLTYPE Thread::yield()
  #define SUPPORT_AFFINITIES 1
 #endif
 
-void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMask)
+void Thread::setThreadAffinityMask (void* handle, const uint32 affinityMask)
 {
    #if SUPPORT_AFFINITIES
     cpu_set_t affinity;
@@ -1061,10 +1213,20 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
         if ((affinityMask & (1 << i)) != 0)
             CPU_SET (i, &affinity);
 
+    // a mask of zero lets the thread run anywhere again
+    if (affinityMask == 0)
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+            CPU_SET (i, &affinity);
+
+    if (handle == nullptr)
+        handle = (void*) pthread_self();
+
    #if (! JUCE_ANDROID) && ((! JUCE_LINUX) || ((__GLIBC__ * 1000 + __GLIBC_MINOR__) >= 2004))
-    pthread_setaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity);
+    pthread_setaffinity_np ((pthread_t) handle, sizeof (cpu_set_t), &affinity);
    #elif JUCE_ANDROID
-    sched_setaffinity (gettid(), sizeof (cpu_set_t), &affinity);
+    // (there's no way to find the kernel thread id of another thread here)
+    if (pthread_equal ((pthread_t) handle, pthread_self()))
+        sched_setaffinity (gettid(), sizeof (cpu_set_t), &affinity);
    #else
     // NB: this call isn't really correct because it sets the affinity of the process,
     // (getpid) not the thread (not gettid). But it's included here as a fallback for
@@ -1072,13 +1234,18 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
     sched_setaffinity (getpid(), sizeof (cpu_set_t), &affinity);
    #endif
 
-    sched_yield();
+    if (pthread_equal ((pthread_t) handle, pthread_self()))
+        sched_yield();
+
+   #elif JUCE_MAC || JUCE_IOS
+    // threads can't be pinned to CPUs on Apple platforms
+    ignoreUnused (handle, affinityMask);
 
    #else
     // affinities aren't supported because either the appropriate header files weren't found,
     // or the SUPPORT_AFFINITIES macro was turned off
     jassertfalse;
-    ignoreUnused (affinityMask);
+    ignoreUnused (handle, affinityMask);
    #endif
 }
 
@@ -1124,7 +1291,6 @@ class ChildProcess::ActiveProcess
 {
 public:
     ActiveProcess (const StringArray& arguments, int streamFlags)
-        : childPID (0), pipeHandle (0), readHandle (0)
     {
         String exe (arguments[0].unquoted());
 
@@ -1133,90 +1299,161 @@ public:
         jassert (File::getCurrentWorkingDirectory().getChildFile (exe).existsAsFile()
                   || ! exe.containsChar (File::getSeparatorChar()));
 
+        // The argument list is built before launching, because the child mustn't allocate
+        Array<char*> argv;
+        for (int i = 0; i < arguments.size(); ++i)
+            if (arguments[i].isNotEmpty())
+                argv.add (const_cast<char*> (arguments[i].toRawUTF8()));
+
+        argv.add (nullptr);
+
         int pipeHandles[2] = { 0 };
 
-        if (pipe (pipeHandles) == 0)
-        {
-            const pid_t result = fork();
+        if (pipe (pipeHandles) != 0)
+            return;
 
-            if (result < 0)
-            {
-                close (pipeHandles[0]);
-                close (pipeHandles[1]);
-            }
-            else if (result == 0)
-            {
-                // we're the child process..
-                close (pipeHandles[0]);   // close the read handle
+        // The read end mustn't be inherited, or another process launched at the same
+        // time would keep it open, and this one would never see the end of its output
+        fcntl (pipeHandles[0], F_SETFD, FD_CLOEXEC);
 
-                if ((streamFlags & wantStdOut) != 0)
-                    dup2 (pipeHandles[1], STDOUT_FILENO); // turns the pipe into stdout
-                else
-                    dup2 (open ("/dev/null", O_WRONLY), STDOUT_FILENO);
+       #if JUCE_LINUX || JUCE_MAC
+        // posix_spawn doesn't have to copy this process's address space like fork()
+        // does, which makes a big difference when launching lots of processes from a
+        // large host
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init (&actions);
+        posix_spawn_file_actions_addclose (&actions, pipeHandles[0]);
 
-                if ((streamFlags & wantStdErr) != 0)
-                    dup2 (pipeHandles[1], STDERR_FILENO);
-                else
-                    dup2 (open ("/dev/null", O_WRONLY), STDERR_FILENO);
+        if ((streamFlags & wantStdOut) != 0)
+            posix_spawn_file_actions_adddup2 (&actions, pipeHandles[1], STDOUT_FILENO);
+        else
+            posix_spawn_file_actions_addopen (&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
 
-                close (pipeHandles[1]);
+        if ((streamFlags & wantStdErr) != 0)
+            posix_spawn_file_actions_adddup2 (&actions, pipeHandles[1], STDERR_FILENO);
+        else
+            posix_spawn_file_actions_addopen (&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
 
-                Array<char*> argv;
-                for (int i = 0; i < arguments.size(); ++i)
-                    if (arguments[i].isNotEmpty())
-                        argv.add (const_cast<char*> (arguments[i].toRawUTF8()));
+        posix_spawn_file_actions_addclose (&actions, pipeHandles[1]);
 
-                argv.add (nullptr);
+       #if JUCE_MAC
+        auto* environment = *_NSGetEnviron();
+       #else
+        auto* environment = environ;
+       #endif
 
-                execvp (exe.toRawUTF8(), argv.getRawDataPointer());
-                exit (-1);
-            }
+        pid_t result = 0;
+
+        if (posix_spawnp (&result, exe.toRawUTF8(), &actions, nullptr, argv.getRawDataPointer(), environment) != 0)
+            result = -1;
+
+        posix_spawn_file_actions_destroy (&actions);
+       #else
+        const pid_t result = fork();
+
+        if (result == 0)
+        {
+            // we're the child process..
+            close (pipeHandles[0]);   // close the read handle
+
+            if ((streamFlags & wantStdOut) != 0)
+                dup2 (pipeHandles[1], STDOUT_FILENO); // turns the pipe into stdout
             else
-            {
-                // we're the parent process..
-                childPID = result;
-                pipeHandle = pipeHandles[0];
-                close (pipeHandles[1]); // close the write handle
-            }
+                dup2 (open ("/dev/null", O_WRONLY), STDOUT_FILENO);
+
+            if ((streamFlags & wantStdErr) != 0)
+                dup2 (pipeHandles[1], STDERR_FILENO);
+            else
+                dup2 (open ("/dev/null", O_WRONLY), STDERR_FILENO);
+
+            close (pipeHandles[1]);
+
+            execvp (exe.toRawUTF8(), argv.getRawDataPointer());
+            _exit (-1);
+        }
+       #endif
+
+        close (pipeHandles[1]); // close the write handle
+
+        if (result < 0)
+        {
+            close (pipeHandles[0]);
+        }
+        else
+        {
+            // we're the parent process..
+            childPID = result;
+            pipeHandle = pipeHandles[0];
         }
     }
 
     ~ActiveProcess()
     {
-        if (readHandle != 0)
-            fclose (readHandle);
-
         if (pipeHandle != 0)
             close (pipeHandle);
     }
 
     bool isRunning() const noexcept
     {
-        if (childPID != 0)
+        if (childPID != 0 && ! hasExited)
         {
-            int childState;
-            const int pid = waitpid (childPID, &childState, WNOHANG);
-            return pid == 0 || ! (WIFEXITED (childState) || WIFSIGNALED (childState));
+            // (once waitpid has reported the exit, the child is gone, so its status has to be kept)
+            int childState = 0;
+            auto pid = waitpid (childPID, &childState, WNOHANG);
+
+            if (pid < 0 || (pid == childPID && (WIFEXITED (childState) || WIFSIGNALED (childState))))
+            {
+                hasExited = true;
+
+                if (pid == childPID && WIFEXITED (childState))
+                    exitCode = (uint32) WEXITSTATUS (childState);
+            }
         }
 
-        return false;
+        return childPID != 0 && ! hasExited;
     }
 
     int read (void* const dest, const int numBytes) noexcept
     {
         jassert (dest != nullptr);
+        int total = 0;
 
-        #ifdef fdopen
-         #error // the zlib headers define this function as NULL!
-        #endif
+        while (total < numBytes)
+        {
+            auto numRead = ::read (pipeHandle, addBytesToPointer (dest, total), (size_t) (numBytes - total));
+
+            if (numRead <= 0)
+            {
+                if (numRead < 0 && errno == EINTR)
+                    continue;
+
+                break;
+            }
+
+            total += (int) numRead;
+        }
+
+        return total;
+    }
 
-        if (readHandle == 0 && childPID != 0)
-            readHandle = fdopen (pipeHandle, "r");
+    int readAvailable (void* const dest, const int numBytes) noexcept
+    {
+        jassert (dest != nullptr);
+
+        pollfd pfd;
+        pfd.fd = pipeHandle;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        if (poll (&pfd, 1, 0) <= 0)
+            return 0;
+
+        auto numRead = ::read (pipeHandle, dest, (size_t) numBytes);
 
-        if (readHandle != 0)
-            return (int) fread (dest, 1, (size_t) numBytes, readHandle);
+        if (numRead < 0)
+            return errno == EINTR || errno == EAGAIN ? 0 : -1;
 
-        return 0;
+        return numRead == 0 ? -1 : (int) numRead;
     }
 
     bool killProcess() const noexcept
@@ -1226,23 +1463,16 @@ public:
 
     uint32 getExitCode() const noexcept
     {
-        if (childPID != 0)
-        {
-            int childState = 0;
-            const int pid = waitpid (childPID, &childState, WNOHANG);
-
-            if (pid >= 0 && WIFEXITED (childState))
-                return WEXITSTATUS (childState);
-        }
-
-        return 0;
+        isRunning();
+        return exitCode;
     }
 
-    int childPID;
+    int childPID = 0;
 
 private:
-    int pipeHandle;
-    FILE* readHandle;
+    int pipeHandle = 0;
+    mutable bool hasExited = false;
+    mutable uint32 exitCode = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
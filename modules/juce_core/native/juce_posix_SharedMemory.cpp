@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class SharedMemory::Pimpl
+{
+public:
+    Pimpl (const String& name, size_t numBytes, bool createRegion, bool mustNotExist)
+        : path (getPath (name))
+    {
+        int handle;
+        size_t regionSize = numBytes;
+
+        if (createRegion)
+        {
+            if (! mustNotExist)
+                unlinkRegion();
+
+            handle = openRegion (O_RDWR | O_CREAT | O_EXCL);
+
+            if (handle == -1)
+                return;
+
+            ownsRegion = true;
+
+            if (ftruncate (handle, (off_t) numBytes) != 0)
+            {
+                ::close (handle);
+                return;
+            }
+        }
+        else
+        {
+            handle = openRegion (O_RDWR);
+
+            if (handle == -1)
+                return;
+
+            struct stat info;
+
+            if (fstat (handle, &info) != 0 || info.st_size <= 0)
+            {
+                ::close (handle);
+                return;
+            }
+
+            regionSize = (size_t) info.st_size;
+        }
+
+        auto* m = mmap (nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+        ::close (handle);
+
+        if (m != MAP_FAILED)
+        {
+            data = m;
+            size = regionSize;
+        }
+    }
+
+    ~Pimpl()
+    {
+        if (data != nullptr)
+            munmap (data, size);
+
+        if (ownsRegion)
+            unlinkRegion();
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+
+private:
+    const String path;
+    bool ownsRegion = false;
+
+    static String getPath (const String& name)
+    {
+        auto legalName = File::createLegalFileName (name).removeCharacters ("/");
+
+       #if JUCE_ANDROID
+        return File::getSpecialLocation (File::tempDirectory).getChildFile (legalName + ".shm").getFullPathName();
+       #else
+        // some systems only allow very short names
+        if (legalName.length() > 28)
+            legalName = String::toHexString (name.hashCode64());
+
+        return "/" + legalName;
+       #endif
+    }
+
+    int openRegion (int flags) const
+    {
+       #if JUCE_ANDROID
+        return ::open (path.toUTF8(), flags, 0600);
+       #else
+        return shm_open (path.toUTF8(), flags, 0600);
+       #endif
+    }
+
+    void unlinkRegion() const
+    {
+       #if JUCE_ANDROID
+        ::unlink (path.toUTF8());
+       #else
+        shm_unlink (path.toUTF8());
+       #endif
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+bool SharedMemory::create (const String& name, size_t numBytes, bool mustNotExist)
+{
+    close();
+    currentName = name;
+
+    if (numBytes == 0)
+        return false;
+
+    pimpl = new Pimpl (name, numBytes, true, mustNotExist);
+
+    if (pimpl->data == nullptr)
+        pimpl = nullptr;
+
+    return pimpl != nullptr;
+}
+
+bool SharedMemory::openExisting (const String& name)
+{
+    close();
+    currentName = name;
+    pimpl = new Pimpl (name, 0, false, false);
+
+    if (pimpl->data == nullptr)
+        pimpl = nullptr;
+
+    return pimpl != nullptr;
+}
+
+void SharedMemory::close()
+{
+    pimpl = nullptr;
+}
+
+void* SharedMemory::getData() const noexcept    { return pimpl != nullptr ? pimpl->data : nullptr; }
+size_t SharedMemory::getSize() const noexcept   { return pimpl != nullptr ? pimpl->size : 0; }
+
+//==============================================================================
+#if JUCE_LINUX || JUCE_ANDROID
+
+SharedMemoryFifo::Signal::Signal (const String&, std::atomic<int32>& c, bool)  : counter (c) {}
+SharedMemoryFifo::Signal::~Signal() {}
+
+bool SharedMemoryFifo::Signal::isValid() const noexcept   { return true; }
+
+void SharedMemoryFifo::Signal::wait (int32 lastCount, int timeoutMilliseconds)
+{
+    struct timespec timeout;
+    timeout.tv_sec = timeoutMilliseconds / 1000;
+    timeout.tv_nsec = (timeoutMilliseconds % 1000) * 1000000;
+
+    // the counter's in memory that's mapped by both processes, so this mustn't use FUTEX_PRIVATE_FLAG
+    syscall (SYS_futex, reinterpret_cast<int32*> (&counter), FUTEX_WAIT, lastCount,
+             timeoutMilliseconds >= 0 ? &timeout : nullptr, nullptr, 0);
+}
+
+void SharedMemoryFifo::Signal::notify()
+{
+    syscall (SYS_futex, reinterpret_cast<int32*> (&counter), FUTEX_WAKE,
+             std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+}
+
+#else
+
+// There's no futex here that works between processes, so the signal is a
+// FIFO that the other end writes a byte into.
+SharedMemoryFifo::Signal::Signal (const String& name, std::atomic<int32>& c, bool isCreator)
+    : counter (c)
+{
+   #if JUCE_IOS
+    fifoPath = File::getSpecialLocation (File::tempDirectory)
+                 .getChildFile (File::createLegalFileName (name)).getFullPathName();
+   #else
+    fifoPath = "/tmp/" + File::createLegalFileName (name);
+   #endif
+
+    if (isCreator)
+    {
+        ::unlink (fifoPath.toUTF8());
+
+        if (mkfifo (fifoPath.toUTF8(), 0600) != 0)
+            return;
+
+        ownsFifo = true;
+    }
+
+    fifoHandle = ::open (fifoPath.toUTF8(), O_RDWR | O_NONBLOCK);
+}
+
+SharedMemoryFifo::Signal::~Signal()
+{
+    if (fifoHandle != -1)
+        ::close (fifoHandle);
+
+    if (ownsFifo)
+        ::unlink (fifoPath.toUTF8());
+}
+
+bool SharedMemoryFifo::Signal::isValid() const noexcept   { return fifoHandle != -1; }
+
+void SharedMemoryFifo::Signal::wait (int32 lastCount, int timeoutMilliseconds)
+{
+    if (counter.load() != lastCount)
+        return;
+
+    struct timeval timeout;
+    timeout.tv_sec = timeoutMilliseconds / 1000;
+    timeout.tv_usec = (timeoutMilliseconds % 1000) * 1000;
+
+    fd_set readSet;
+    FD_ZERO (&readSet);
+    FD_SET (fifoHandle, &readSet);
+
+    if (select (fifoHandle + 1, &readSet, nullptr, nullptr, timeoutMilliseconds >= 0 ? &timeout : nullptr) > 0)
+    {
+        char buffer[64];
+
+        while (::read (fifoHandle, buffer, sizeof (buffer)) > 0)
+        {}
+    }
+}
+
+void SharedMemoryFifo::Signal::notify()
+{
+    const char byte = 0;
+    auto result = ::write (fifoHandle, &byte, 1);
+    ignoreUnused (result);
+}
+
+#endif
+
+} // namespace juce
@@ -771,7 +771,15 @@ public:
 
         if (handle == INVALID_HANDLE_VALUE)
         {
-            handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
+           #ifdef FIND_FIRST_EX_LARGE_FETCH
+            // skipping the short 8.3 names and fetching the entries in larger batches makes a big
+            // difference when listing big folders on network shares
+            handle = FindFirstFileEx (directoryWithWildCard.toWideCharPointer(), FindExInfoBasic, &findData,
+                                      FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+
+            if (handle == INVALID_HANDLE_VALUE && GetLastError() == ERROR_INVALID_PARAMETER) // (not supported before Windows 7)
+           #endif
+                handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
 
             if (handle == INVALID_HANDLE_VALUE)
                 return false;
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static String getSharedObjectName (const String& name)
+{
+    return "Local\\" + File::createLegalFileName (name);
+}
+
+//==============================================================================
+class SharedMemory::Pimpl
+{
+public:
+    Pimpl (const String& name, size_t numBytes, bool createRegion, bool mustNotExist)
+    {
+        auto mappingName = getSharedObjectName (name);
+
+        if (createRegion)
+        {
+            handle = CreateFileMapping (INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        (DWORD) ((uint64) numBytes >> 32), (DWORD) numBytes,
+                                        mappingName.toWideCharPointer());
+
+            auto alreadyExisted = (GetLastError() == ERROR_ALREADY_EXISTS);
+
+            if (handle != nullptr && alreadyExisted && mustNotExist)
+            {
+                CloseHandle (handle);
+                handle = nullptr;
+            }
+
+            if (handle == nullptr || ! mapView())
+                return;
+
+            // a region that already existed can't be resized, but it can be reused if it's big enough
+            if (size < numBytes)
+            {
+                unmap();
+                return;
+            }
+
+            size = numBytes;
+
+            if (alreadyExisted)
+                zeromem (data, size);
+        }
+        else
+        {
+            handle = OpenFileMapping (FILE_MAP_ALL_ACCESS, FALSE, mappingName.toWideCharPointer());
+
+            if (handle != nullptr)
+                mapView();
+        }
+    }
+
+    ~Pimpl()
+    {
+        unmap();
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+
+private:
+    HANDLE handle = nullptr;
+
+    bool mapView()
+    {
+        data = MapViewOfFile (handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+
+        MEMORY_BASIC_INFORMATION info;
+
+        if (data == nullptr || VirtualQuery (data, &info, sizeof (info)) == 0)
+        {
+            unmap();
+            return false;
+        }
+
+        size = (size_t) info.RegionSize;
+        return true;
+    }
+
+    void unmap()
+    {
+        if (data != nullptr)
+            UnmapViewOfFile (data);
+
+        if (handle != nullptr)
+            CloseHandle (handle);
+
+        data = nullptr;
+        handle = nullptr;
+        size = 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+bool SharedMemory::create (const String& name, size_t numBytes, bool mustNotExist)
+{
+    close();
+    currentName = name;
+
+    if (numBytes == 0)
+        return false;
+
+    pimpl = new Pimpl (name, numBytes, true, mustNotExist);
+
+    if (pimpl->data == nullptr)
+        pimpl = nullptr;
+
+    return pimpl != nullptr;
+}
+
+bool SharedMemory::openExisting (const String& name)
+{
+    close();
+    currentName = name;
+    pimpl = new Pimpl (name, 0, false, false);
+
+    if (pimpl->data == nullptr)
+        pimpl = nullptr;
+
+    return pimpl != nullptr;
+}
+
+void SharedMemory::close()
+{
+    pimpl = nullptr;
+}
+
+void* SharedMemory::getData() const noexcept    { return pimpl != nullptr ? pimpl->data : nullptr; }
+size_t SharedMemory::getSize() const noexcept   { return pimpl != nullptr ? pimpl->size : 0; }
+
+//==============================================================================
+SharedMemoryFifo::Signal::Signal (const String& name, std::atomic<int32>& c, bool)
+    : counter (c)
+{
+    // an auto-reset event, which is shared by name with the other process
+    event = CreateEvent (nullptr, FALSE, FALSE, getSharedObjectName (name).toWideCharPointer());
+}
+
+SharedMemoryFifo::Signal::~Signal()
+{
+    if (event != nullptr)
+        CloseHandle (event);
+}
+
+bool SharedMemoryFifo::Signal::isValid() const noexcept   { return event != nullptr; }
+
+void SharedMemoryFifo::Signal::wait (int32 lastCount, int timeoutMilliseconds)
+{
+    if (counter.load() == lastCount)
+        WaitForSingleObject (event, timeoutMilliseconds >= 0 ? (DWORD) timeoutMilliseconds : INFINITE);
+}
+
+void SharedMemoryFifo::Signal::notify()
+{
+    SetEvent (event);
+}
+
+} // namespace juce
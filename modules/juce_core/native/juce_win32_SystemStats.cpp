@@ -147,11 +147,14 @@ void CPUInformation::initialise() noexcept
     hasSSSE3 = (info[2] & (1 <<  9)) != 0;
     hasSSE41 = (info[2] & (1 << 19)) != 0;
     hasSSE42 = (info[2] & (1 << 20)) != 0;
+    hasPCLMULQDQ = (info[2] & (1 << 1)) != 0;
     has3DNow = (info[1] & (1 << 31)) != 0;
 
     callCPUID (info, 7);
 
-    hasAVX2 = (info[1] & (1 << 5)) != 0;
+    hasAVX2    = (info[1] & (1 <<  5)) != 0;
+    hasAVX512F = (info[1] & (1 << 16)) != 0;
+    hasSHA     = (info[1] & (1 << 29)) != 0;
 
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
@@ -43,23 +43,166 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { DeleteCriticalSection ((CRITICAL_SECTION*) lock); }
-void CriticalSection::enter() const noexcept        { EnterCriticalSection ((CRITICAL_SECTION*) lock); }
+void CriticalSection::enter() const noexcept        { JUCE_REALTIME_SAFETY_CHECK (lockAcquired); EnterCriticalSection ((CRITICAL_SECTION*) lock); }
 bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSection ((CRITICAL_SECTION*) lock) != FALSE; }
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) lock); }
 
 
 //==============================================================================
-WaitableEvent::WaitableEvent (const bool manualReset) noexcept
-    : handle (CreateEvent (0, manualReset ? TRUE : FALSE, FALSE, 0)) {}
+// These let a thread sleep until another thread changes the value of an atomic int,
+// which is all that WaitableEvent, AdaptiveLock and LightweightSemaphore need from the
+// OS. A wait may return early for no reason, so callers must always check the value
+// again afterwards.
+namespace AddressWait
+{
+    typedef BOOL (WINAPI* WaitOnAddressFunction) (volatile VOID*, PVOID, SIZE_T, DWORD);
+    typedef void (WINAPI* WakeByAddressFunction) (PVOID);
 
-WaitableEvent::~WaitableEvent() noexcept        { CloseHandle (handle); }
+    // WaitOnAddress only exists in Windows 8 and later, so has to be loaded dynamically
+    struct Functions
+    {
+        Functions()  : library ("api-ms-win-core-synch-l1-2-0.dll")
+        {
+            waitOnAddress       = (WaitOnAddressFunction) library.getFunction ("WaitOnAddress");
+            wakeByAddressSingle = (WakeByAddressFunction) library.getFunction ("WakeByAddressSingle");
+            wakeByAddressAll    = (WakeByAddressFunction) library.getFunction ("WakeByAddressAll");
+        }
 
-void WaitableEvent::signal() const noexcept     { SetEvent (handle); }
-void WaitableEvent::reset() const noexcept      { ResetEvent (handle); }
+        bool isAvailable() const noexcept
+        {
+            return waitOnAddress != nullptr && wakeByAddressSingle != nullptr && wakeByAddressAll != nullptr;
+        }
 
-bool WaitableEvent::wait (const int timeOutMs) const noexcept
-{
-    return WaitForSingleObject (handle, (DWORD) timeOutMs) == WAIT_OBJECT_0;
+        DynamicLibrary library;
+        WaitOnAddressFunction waitOnAddress;
+        WakeByAddressFunction wakeByAddressSingle, wakeByAddressAll;
+    };
+
+    static const Functions& getFunctions() noexcept
+    {
+        static Functions functions;
+        return functions;
+    }
+
+    //==============================================================================
+    // On older systems, each waiting thread sleeps on its own event, in a list that's
+    // kept in a table indexed by the address
+    struct ParkingLot
+    {
+        struct Waiter
+        {
+            const void* address;
+            HANDLE event;
+            Waiter* next;
+        };
+
+        struct Bucket
+        {
+            Bucket() noexcept     { InitializeCriticalSection (&lock); }
+
+            CRITICAL_SECTION lock;
+            Waiter* firstWaiter = nullptr;
+        };
+
+        static Bucket& getBucket (const void* address) noexcept
+        {
+            static Bucket buckets[31];
+            return buckets[(pointer_sized_uint) address % numElementsInArray (buckets)];
+        }
+
+        static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
+        {
+            auto& bucket = getBucket (&word);
+            Waiter waiter = { &word, CreateEvent (0, FALSE, FALSE, 0), nullptr };
+
+            EnterCriticalSection (&bucket.lock);
+
+            if (word.load() != expectedValue)
+            {
+                LeaveCriticalSection (&bucket.lock);
+                CloseHandle (waiter.event);
+                return;
+            }
+
+            waiter.next = bucket.firstWaiter;
+            bucket.firstWaiter = &waiter;
+            LeaveCriticalSection (&bucket.lock);
+
+            WaitForSingleObject (waiter.event, timeoutMilliseconds < 0 ? INFINITE : (DWORD) timeoutMilliseconds);
+
+            // if it timed out, it'll still be in the list. Otherwise, the event was set while
+            // the lock was held, so nothing can touch it after this
+            EnterCriticalSection (&bucket.lock);
+
+            for (auto** w = &bucket.firstWaiter; *w != nullptr; w = &((*w)->next))
+            {
+                if (*w == &waiter)
+                {
+                    *w = waiter.next;
+                    break;
+                }
+            }
+
+            LeaveCriticalSection (&bucket.lock);
+            CloseHandle (waiter.event);
+        }
+
+        static void wake (std::atomic<int32>& word, bool wakeAllThreads) noexcept
+        {
+            auto& bucket = getBucket (&word);
+            EnterCriticalSection (&bucket.lock);
+
+            for (auto** w = &bucket.firstWaiter; *w != nullptr;)
+            {
+                if ((*w)->address == &word)
+                {
+                    SetEvent ((*w)->event);
+                    *w = (*w)->next;
+
+                    if (! wakeAllThreads)
+                        break;
+                }
+                else
+                {
+                    w = &((*w)->next);
+                }
+            }
+
+            LeaveCriticalSection (&bucket.lock);
+        }
+    };
+
+    //==============================================================================
+    static void wait (std::atomic<int32>& word, int32 expectedValue, int timeoutMilliseconds) noexcept
+    {
+        auto& functions = getFunctions();
+
+        if (functions.isAvailable())
+            functions.waitOnAddress (&word, &expectedValue, sizeof (expectedValue),
+                                     timeoutMilliseconds < 0 ? INFINITE : (DWORD) timeoutMilliseconds);
+        else
+            ParkingLot::wait (word, expectedValue, timeoutMilliseconds);
+    }
+
+    static void wakeOne (std::atomic<int32>& word) noexcept
+    {
+        auto& functions = getFunctions();
+
+        if (functions.isAvailable())
+            functions.wakeByAddressSingle (&word);
+        else
+            ParkingLot::wake (word, false);
+    }
+
+    static void wakeAll (std::atomic<int32>& word) noexcept
+    {
+        auto& functions = getFunctions();
+
+        if (functions.isAvailable())
+            functions.wakeByAddressAll (&word);
+        else
+            ParkingLot::wake (word, true);
+    }
 }
 
 //==============================================================================
@@ -152,9 +295,46 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return SetThreadPriority (handle, pri) != FALSE;
 }
 
-void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMask)
+void Thread::setThreadAffinityMask (void* handle, const uint32 affinityMask)
+{
+    if (handle == 0)
+        handle = GetCurrentThread();
+
+    DWORD_PTR processMask = 0, systemMask = 0;
+
+    // a mask of zero lets the thread run anywhere again
+    if (affinityMask == 0 && GetProcessAffinityMask (GetCurrentProcess(), &processMask, &systemMask))
+        SetThreadAffinityMask (handle, processMask);
+    else
+        SetThreadAffinityMask (handle, affinityMask);
+}
+
+bool Thread::setCurrentThreadRealtime (const RealtimeOptions& options)
 {
-    SetThreadAffinityMask (GetCurrentThread(), affinityMask);
+    if (options.affinityMask != 0)
+        setCurrentThreadAffinityMask (options.affinityMask);
+
+    // MMCSS needs avrt.dll, which is kept open for as long as the process runs, because
+    // the thread's registration lasts until it exits
+    static DynamicLibrary avrtLibrary ("avrt.dll");
+
+    JUCE_LOAD_WINAPI_FUNCTION (avrtLibrary, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+    JUCE_LOAD_WINAPI_FUNCTION (avrtLibrary, AvSetMmThreadPriority, avSetMmThreadPriority, BOOL, (HANDLE, int))
+
+    bool joinedMmcss = false;
+
+    if (avSetMmThreadCharacteristics != 0 && avSetMmThreadPriority != 0)
+    {
+        DWORD taskIndex = 0;
+
+        if (auto mmcssHandle = avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex))
+        {
+            avSetMmThreadPriority (mmcssHandle, 1 /* AVRT_PRIORITY_HIGH */);
+            joinedMmcss = true;
+        }
+    }
+
+    return setThreadPriority (0, options.priority) || joinedMmcss;
 }
 
 //==============================================================================
@@ -486,6 +666,29 @@ public:
         return total;
     }
 
+    int readAvailable (void* dest, int numNeeded) const noexcept
+    {
+        if (! ok)
+            return -1;
+
+        // (this is checked first, so that anything written just before exiting isn't missed)
+        auto running = isRunning();
+        DWORD available = 0;
+
+        if (! PeekNamedPipe ((HANDLE) readPipe, nullptr, 0, nullptr, &available, nullptr))
+            return -1;
+
+        if (available == 0)
+            return running ? 0 : -1;
+
+        DWORD numRead = 0;
+
+        if (! ReadFile ((HANDLE) readPipe, dest, (DWORD) jmin ((int) available, numNeeded), &numRead, nullptr))
+            return -1;
+
+        return (int) numRead;
+    }
+
     bool killProcess() const noexcept
     {
         return TerminateProcess (processInfo.hProcess, 0) != FALSE;
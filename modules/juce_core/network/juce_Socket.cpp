@@ -242,6 +242,60 @@ namespace SocketHelpers
         return (int) bytesRead;
     }
 
+   #if JUCE_LINUX
+    static int readDatagrams (SocketHandle handle, char* destBuffer, int maxBytesPerDatagram,
+                              int maxNumDatagrams, int* datagramSizes, CriticalSection& readLock) noexcept
+    {
+        enum { maxDatagramsPerCall = 64 };
+        int numRead = 0;
+
+        while (numRead < maxNumDatagrams)
+        {
+            mmsghdr headers[maxDatagramsPerCall];
+            iovec buffers[maxDatagramsPerCall];
+            auto numToRead = jmin ((int) maxDatagramsPerCall, maxNumDatagrams - numRead);
+
+            zeromem (headers, sizeof (headers));
+
+            for (int i = 0; i < numToRead; ++i)
+            {
+                buffers[i].iov_base = destBuffer + (size_t) (numRead + i) * (size_t) maxBytesPerDatagram;
+                buffers[i].iov_len = (size_t) maxBytesPerDatagram;
+                headers[i].msg_hdr.msg_iov = buffers + i;
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int result = -1;
+
+            {
+                // avoid race-condition
+                CriticalSection::ScopedTryLockType lock (readLock);
+
+                if (lock.isLocked())
+                    result = ::recvmmsg (handle, headers, (unsigned int) numToRead, MSG_DONTWAIT, nullptr);
+            }
+
+            if (result <= 0)
+            {
+                if (result < 0 && numRead == 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                    return -1;
+
+                break;
+            }
+
+            for (int i = 0; i < result; ++i)
+                datagramSizes[numRead + i] = (int) headers[i].msg_len;
+
+            numRead += result;
+
+            if (result < numToRead)
+                break;
+        }
+
+        return numRead;
+    }
+   #endif
+
     static int waitForReadiness (const volatile int& handle, CriticalSection& readLock,
                                  const bool forReading, const int timeoutMsecs) noexcept
     {
@@ -469,6 +523,81 @@ int StreamingSocket::write (const void* sourceBuffer, const int numBytesToWrite)
     return (int) ::send (handle, (const char*) sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, 0);
 }
 
+int StreamingSocket::writeMultiple (const void* const* blocks, const int* blockSizes, int numBlocks)
+{
+    if (isListener || ! connected)
+        return -1;
+
+    enum { maxBlocksPerCall = 16 };
+
+    int totalWritten = 0;
+    int blockIndex = 0, offsetInBlock = 0;
+
+    while (blockIndex < numBlocks)
+    {
+       #if JUCE_WINDOWS
+        WSABUF buffers[maxBlocksPerCall];
+       #else
+        iovec buffers[maxBlocksPerCall];
+       #endif
+
+        int numBuffers = 0;
+
+        for (int i = blockIndex; i < numBlocks && numBuffers < maxBlocksPerCall; ++i)
+        {
+            auto offset = (i == blockIndex ? offsetInBlock : 0);
+            auto* data = static_cast<const char*> (blocks[i]) + offset;
+            auto size = blockSizes[i] - offset;
+
+           #if JUCE_WINDOWS
+            buffers[numBuffers].buf = const_cast<char*> (data);
+            buffers[numBuffers].len = (ULONG) size;
+           #else
+            buffers[numBuffers].iov_base = const_cast<char*> (data);
+            buffers[numBuffers].iov_len = (size_t) size;
+           #endif
+
+            ++numBuffers;
+        }
+
+       #if JUCE_WINDOWS
+        DWORD bytesSent = 0;
+
+        if (WSASend (handle, buffers, (DWORD) numBuffers, &bytesSent, 0, nullptr, nullptr) != 0)
+            return -1;
+
+        auto result = (int) bytesSent;
+       #else
+        msghdr message;
+        zerostruct (message);
+        message.msg_iov = buffers;
+        message.msg_iovlen = (decltype (message.msg_iovlen)) numBuffers;
+
+        auto result = (int) ::sendmsg (handle, &message, 0);
+
+        if (result < 0)
+            return -1;
+       #endif
+
+        if (result == 0 && numBuffers > 0)
+            break;
+
+        totalWritten += result;
+
+        // skip past whatever was sent, in case the call only managed part of it
+        while (blockIndex < numBlocks && result >= blockSizes[blockIndex] - offsetInBlock)
+        {
+            result -= blockSizes[blockIndex] - offsetInBlock;
+            offsetInBlock = 0;
+            ++blockIndex;
+        }
+
+        offsetInBlock += result;
+    }
+
+    return totalWritten;
+}
+
 //==============================================================================
 int StreamingSocket::waitUntilReady (const bool readyForReading,
                                      const int timeoutMsecs) const
@@ -697,14 +826,39 @@ int DatagramSocket::read (void* destBuffer, int maxBytesToRead, bool shouldBlock
                                       shouldBlock, readLock, &senderIPAddress, &senderPort);
 }
 
-int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
-                           const void* sourceBuffer, int numBytesToWrite)
+int DatagramSocket::readMultiple (void* destBuffer, int maxBytesPerDatagram,
+                                  int maxNumDatagrams, int* datagramSizes)
 {
-    jassert (SocketHelpers::isValidPortNumber (remotePortNumber));
-
-    if (handle < 0)
+    if (handle < 0 || ! isBound)
         return -1;
 
+   #if JUCE_LINUX
+    return SocketHelpers::readDatagrams (handle, static_cast<char*> (destBuffer), maxBytesPerDatagram,
+                                         maxNumDatagrams, datagramSizes, readLock);
+   #else
+    bool connected = true;
+    int numRead = 0;
+
+    SocketHelpers::setSocketBlockingState (handle, false);
+
+    while (numRead < maxNumDatagrams)
+    {
+        auto* dest = static_cast<char*> (destBuffer) + (size_t) numRead * (size_t) maxBytesPerDatagram;
+        auto bytesRead = SocketHelpers::readSocket (handle, dest, maxBytesPerDatagram,
+                                                    connected, false, readLock);
+        if (bytesRead <= 0)
+            break;
+
+        datagramSizes[numRead++] = bytesRead;
+    }
+
+    return numRead;
+   #endif
+}
+
+static struct addrinfo* getCachedServerAddress (void*& lastServerAddress, String& lastServerHost, int& lastServerPort,
+                                                const String& remoteHostname, int remotePortNumber)
+{
     struct addrinfo*& info = reinterpret_cast<struct addrinfo*&> (lastServerAddress);
 
     // getaddrinfo can be quite slow so cache the result of the address lookup
@@ -714,17 +868,96 @@ int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
             freeaddrinfo (info);
 
         if ((info = SocketHelpers::getAddressInfo (true, remoteHostname, remotePortNumber)) == nullptr)
-            return -1;
+            return nullptr;
 
         lastServerHost = remoteHostname;
         lastServerPort = remotePortNumber;
     }
 
+    return info;
+}
+
+int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
+                           const void* sourceBuffer, int numBytesToWrite)
+{
+    jassert (SocketHelpers::isValidPortNumber (remotePortNumber));
+
+    if (handle < 0)
+        return -1;
+
+    auto* info = getCachedServerAddress (lastServerAddress, lastServerHost, lastServerPort,
+                                         remoteHostname, remotePortNumber);
+
+    if (info == nullptr)
+        return -1;
+
     return (int) ::sendto (handle, (const char*) sourceBuffer,
                            (juce_recvsend_size_t) numBytesToWrite, 0,
                            info->ai_addr, (socklen_t) info->ai_addrlen);
 }
 
+int DatagramSocket::writeMultiple (const String& remoteHostname, int remotePortNumber,
+                                   const void* const* datagrams, const int* datagramSizes,
+                                   int numDatagrams)
+{
+    jassert (SocketHelpers::isValidPortNumber (remotePortNumber));
+
+    if (handle < 0)
+        return -1;
+
+    auto* info = getCachedServerAddress (lastServerAddress, lastServerHost, lastServerPort,
+                                         remoteHostname, remotePortNumber);
+
+    if (info == nullptr)
+        return -1;
+
+    int numWritten = 0;
+
+   #if JUCE_LINUX
+    enum { maxDatagramsPerCall = 64 };
+
+    while (numWritten < numDatagrams)
+    {
+        mmsghdr headers[maxDatagramsPerCall];
+        iovec buffers[maxDatagramsPerCall];
+        auto numToWrite = jmin ((int) maxDatagramsPerCall, numDatagrams - numWritten);
+
+        zeromem (headers, sizeof (headers));
+
+        for (int i = 0; i < numToWrite; ++i)
+        {
+            buffers[i].iov_base = const_cast<void*> (datagrams[numWritten + i]);
+            buffers[i].iov_len = (size_t) datagramSizes[numWritten + i];
+            headers[i].msg_hdr.msg_name = info->ai_addr;
+            headers[i].msg_hdr.msg_namelen = (socklen_t) info->ai_addrlen;
+            headers[i].msg_hdr.msg_iov = buffers + i;
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        auto result = ::sendmmsg (handle, headers, (unsigned int) numToWrite, 0);
+
+        if (result <= 0)
+            break;
+
+        numWritten += result;
+    }
+   #else
+    while (numWritten < numDatagrams)
+    {
+        auto result = ::sendto (handle, (const char*) datagrams[numWritten],
+                                (juce_recvsend_size_t) datagramSizes[numWritten], 0,
+                                info->ai_addr, (socklen_t) info->ai_addrlen);
+
+        if (result < 0)
+            break;
+
+        ++numWritten;
+    }
+   #endif
+
+    return (numWritten == 0 && numDatagrams > 0) ? -1 : numWritten;
+}
+
 bool DatagramSocket::joinMulticast (const String& multicastIPAddress)
 {
     if (! isBound || handle < 0)
@@ -145,6 +145,16 @@ public:
     */
     int write (const void* sourceBuffer, int numBytesToWrite);
 
+    /** Writes several blocks of bytes to the socket, one after another.
+
+        The other end receives the same stream of bytes as if the blocks had been
+        copied into one buffer and passed to write(), but they're sent directly from
+        where they are, with as few system calls as possible.
+
+        @returns the total number of bytes written, or -1 if there was an error.
+    */
+    int writeMultiple (const void* const* blocks, const int* blockSizes, int numBlocks);
+
     //==============================================================================
     /** Puts this socket into "listener" mode.
 
@@ -290,6 +300,25 @@ public:
               bool blockUntilSpecifiedAmountHasArrived,
               String& senderIPAddress, int& senderPortNumber);
 
+    /** Reads as many of the datagrams that are waiting on the socket as will fit,
+        without blocking.
+
+        Each datagram is written into its own maxBytesPerDatagram-sized slot of
+        destBuffer, which must have room for maxNumDatagrams of them, and its size is
+        written into the corresponding element of datagramSizes. Datagrams that are
+        too big for a slot are truncated.
+
+        This gives the same results as calling read() repeatedly, but on platforms that
+        support it the datagrams are all fetched with a single system call, which is
+        a lot cheaper when packets are arriving at a high rate.
+
+        @returns the number of datagrams read, which is 0 if none were waiting, or -1
+                 if there was an error.
+        @see read, waitUntilReady
+    */
+    int readMultiple (void* destBuffer, int maxBytesPerDatagram,
+                      int maxNumDatagrams, int* datagramSizes);
+
     /** Writes bytes to the socket from a buffer.
 
         Note that this method will block unless you have checked the socket is ready
@@ -300,6 +329,18 @@ public:
     int write (const String& remoteHostname, int remotePortNumber,
                const void* sourceBuffer, int numBytesToWrite);
 
+    /** Writes several datagrams to the same target.
+
+        This has the same effect as calling write() for each of them in turn, but on
+        platforms that support it the datagrams are all sent with a single system call.
+
+        @returns the number of datagrams that were sent, or -1 if there was an error
+                 before any of them could be sent.
+    */
+    int writeMultiple (const String& remoteHostname, int remotePortNumber,
+                       const void* const* datagrams, const int* datagramSizes,
+                       int numDatagrams);
+
     /** Closes the underlying socket object.
 
         Closes the underlying socket object and aborts any read or write operations.
@@ -0,0 +1,702 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SocketReactor::Registration
+{
+    int64 id;
+    int handle;
+    Listener* listener;
+    bool notifyWhenWritable;
+
+    Thread::ThreadID callbackThread = nullptr;
+    bool pendingRead = false, pendingWrite = false;
+    std::atomic<bool> removed { false };
+};
+
+struct SocketReactorEvent
+{
+    int64 id;
+    bool readable, writable;
+};
+
+//==============================================================================
+#if JUCE_LINUX || JUCE_ANDROID
+
+struct SocketReactor::Pimpl
+{
+    Pimpl (SocketReactor&)
+        : epollHandle (epoll_create1 (EPOLL_CLOEXEC)),
+          wakeHandle (eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        epoll_event e;
+        zerostruct (e);
+        e.events = EPOLLIN;
+        e.data.u64 = 0;
+
+        if (epollHandle >= 0 && wakeHandle >= 0)
+            epoll_ctl (epollHandle, EPOLL_CTL_ADD, wakeHandle, &e);
+    }
+
+    ~Pimpl()
+    {
+        if (epollHandle >= 0)  ::close (epollHandle);
+        if (wakeHandle >= 0)   ::close (wakeHandle);
+    }
+
+    static int getMaxNumThreads() noexcept          { return std::numeric_limits<int>::max(); }
+
+    bool add (Registration& r)
+    {
+        auto e = getEventFor (r);
+        return epoll_ctl (epollHandle, EPOLL_CTL_ADD, r.handle, &e) == 0;
+    }
+
+    void rearm (Registration& r)
+    {
+        auto e = getEventFor (r);
+        epoll_ctl (epollHandle, EPOLL_CTL_MOD, r.handle, &e);
+    }
+
+    void remove (Registration& r)
+    {
+        epoll_event e;
+        zerostruct (e);
+        epoll_ctl (epollHandle, EPOLL_CTL_DEL, r.handle, &e);
+    }
+
+    int wait (SocketReactorEvent* events, int maxEvents)
+    {
+        epoll_event raw[maxEventsPerWait];
+        auto numRaw = epoll_wait (epollHandle, raw, jmin (maxEvents, (int) maxEventsPerWait), -1);
+        int num = 0;
+
+        for (int i = 0; i < numRaw; ++i)
+        {
+            if (raw[i].data.u64 == 0)
+                continue;
+
+            auto flags = raw[i].events;
+            events[num++] = { (int64) raw[i].data.u64,
+                              (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0,
+                              (flags & EPOLLOUT) != 0 };
+        }
+
+        return num;
+    }
+
+    // The wake-up handle is level-triggered and never gets reset, so every thread sees it.
+    void wakeAllThreads()
+    {
+        uint64 one = 1;
+        auto result = ::write (wakeHandle, &one, sizeof (one));
+        ignoreUnused (result);
+    }
+
+private:
+    enum { maxEventsPerWait = 16 };
+    const int epollHandle, wakeHandle;
+
+    static epoll_event getEventFor (const Registration& r) noexcept
+    {
+        epoll_event e;
+        zerostruct (e);
+
+        // one-shot, so that no other thread gets the socket until it's re-armed
+        e.events = (uint32) EPOLLIN | (uint32) EPOLLRDHUP | (uint32) EPOLLONESHOT
+                     | (r.notifyWhenWritable ? (uint32) EPOLLOUT : 0u);
+        e.data.u64 = (uint64) r.id;
+        return e;
+    }
+};
+
+//==============================================================================
+#elif JUCE_MAC || JUCE_IOS
+
+struct SocketReactor::Pimpl
+{
+    Pimpl (SocketReactor&)  : queueHandle (kqueue())
+    {
+        change (wakeIdent, EVFILT_USER, EV_ADD, 0);
+    }
+
+    ~Pimpl()
+    {
+        if (queueHandle >= 0)
+            ::close (queueHandle);
+    }
+
+    static int getMaxNumThreads() noexcept          { return std::numeric_limits<int>::max(); }
+
+    bool add (Registration& r)
+    {
+        // with EV_DISPATCH, a filter is disabled as soon as it fires, until it's re-armed
+        if (! change ((uintptr_t) r.handle, EVFILT_READ, EV_ADD | EV_DISPATCH, r.id))
+            return false;
+
+        if (r.notifyWhenWritable)
+            change ((uintptr_t) r.handle, EVFILT_WRITE, EV_ADD | EV_DISPATCH, r.id);
+
+        return true;
+    }
+
+    void rearm (Registration& r)
+    {
+        change ((uintptr_t) r.handle, EVFILT_READ, EV_ENABLE, r.id);
+
+        if (r.notifyWhenWritable)
+            change ((uintptr_t) r.handle, EVFILT_WRITE, EV_ADD | EV_DISPATCH | EV_ENABLE, r.id);
+        else
+            change ((uintptr_t) r.handle, EVFILT_WRITE, EV_DELETE, r.id);
+    }
+
+    void remove (Registration& r)
+    {
+        change ((uintptr_t) r.handle, EVFILT_READ,  EV_DELETE, r.id);
+        change ((uintptr_t) r.handle, EVFILT_WRITE, EV_DELETE, r.id);
+    }
+
+    int wait (SocketReactorEvent* events, int maxEvents)
+    {
+        struct kevent raw[maxEventsPerWait];
+        auto numRaw = kevent (queueHandle, nullptr, 0, raw, jmin (maxEvents, (int) maxEventsPerWait), nullptr);
+        int num = 0;
+
+        for (int i = 0; i < numRaw; ++i)
+            if (raw[i].filter == EVFILT_READ || raw[i].filter == EVFILT_WRITE)
+                events[num++] = { (int64) (pointer_sized_int) raw[i].udata,
+                                  raw[i].filter == EVFILT_READ,
+                                  raw[i].filter == EVFILT_WRITE };
+
+        return num;
+    }
+
+    // Without EV_CLEAR, the user event stays triggered, so every thread sees it.
+    void wakeAllThreads()
+    {
+        struct kevent e;
+        EV_SET (&e, wakeIdent, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+        kevent (queueHandle, &e, 1, nullptr, 0, nullptr);
+    }
+
+private:
+    enum { maxEventsPerWait = 16, wakeIdent = 1 };
+    const int queueHandle;
+
+    bool change (uintptr_t ident, int16_t filter, uint16_t flags, int64 id)
+    {
+        struct kevent e;
+        EV_SET (&e, ident, filter, flags, 0, 0, (void*) (pointer_sized_int) id);
+        return kevent (queueHandle, &e, 1, nullptr, 0, nullptr) == 0;
+    }
+};
+
+//==============================================================================
+#else
+
+// This just polls all the sockets from a single thread, with a short timeout so
+// that any changes to the set of sockets are picked up.
+struct SocketReactor::Pimpl
+{
+    Pimpl (SocketReactor& r)  : owner (r) {}
+
+    static int getMaxNumThreads() noexcept          { return 1; }
+
+    bool add (Registration&)        { return true; }
+    void rearm (Registration&)      {}
+    void remove (Registration&)     {}
+    void wakeAllThreads()           {}
+
+    int wait (SocketReactorEvent* events, int maxEvents)
+    {
+        handles.clearQuick();
+        ids.clearQuick();
+
+        {
+            const ScopedLock sl (owner.lock);
+
+            for (auto* r : owner.registrations)
+            {
+                if (! r->removed && r->callbackThread == nullptr)
+                {
+                    PollHandle p;
+                    zerostruct (p);
+                    p.fd = (decltype (p.fd)) r->handle;
+                    p.events = (short) (POLLIN | (r->notifyWhenWritable ? POLLOUT : 0));
+                    handles.add (p);
+                    ids.add (r->id);
+                }
+            }
+        }
+
+        if (handles.isEmpty())
+        {
+            Thread::sleep (pollIntervalMs);
+            return 0;
+        }
+
+       #if JUCE_MINGW
+        auto numReady = pollWithSelect();
+       #elif JUCE_WINDOWS
+        auto numReady = WSAPoll (handles.getRawDataPointer(), (ULONG) handles.size(), pollIntervalMs);
+       #else
+        auto numReady = poll (handles.getRawDataPointer(), (nfds_t) handles.size(), pollIntervalMs);
+       #endif
+
+        if (numReady <= 0)
+        {
+            if (numReady < 0)
+                Thread::sleep (pollIntervalMs);
+
+            return 0;
+        }
+
+        int num = 0;
+
+        for (int i = 0; i < handles.size() && num < maxEvents; ++i)
+        {
+            auto flags = handles.getReference (i).revents;
+
+            if (flags != 0)
+                events[num++] = { ids.getUnchecked (i),
+                                  (flags & (POLLIN | POLLHUP | POLLERR)) != 0,
+                                  (flags & POLLOUT) != 0 };
+        }
+
+        return num;
+    }
+
+private:
+   #if JUCE_MINGW
+    struct PollHandle  { SOCKET fd; short events, revents; };
+    enum { POLLIN = 1, POLLOUT = 4, POLLERR = 8, POLLHUP = 16 };
+
+    // MinGW's headers don't have WSAPoll, so this has to make do with select(),
+    // which can only handle FD_SETSIZE sockets at once.
+    int pollWithSelect()
+    {
+        fd_set readSet, writeSet;
+        FD_ZERO (&readSet);
+        FD_ZERO (&writeSet);
+
+        auto num = jmin (handles.size(), (int) FD_SETSIZE);
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto& p = handles.getReference (i);
+            FD_SET (p.fd, &readSet);
+
+            if ((p.events & POLLOUT) != 0)
+                FD_SET (p.fd, &writeSet);
+        }
+
+        struct timeval timeout = { 0, pollIntervalMs * 1000 };
+        auto result = select (0, &readSet, &writeSet, nullptr, &timeout);
+
+        for (int i = 0; i < num && result > 0; ++i)
+        {
+            auto& p = handles.getReference (i);
+            p.revents = (short) ((FD_ISSET (p.fd, &readSet)  ? POLLIN  : 0)
+                               | (FD_ISSET (p.fd, &writeSet) ? POLLOUT : 0));
+        }
+
+        return result;
+    }
+   #elif JUCE_WINDOWS
+    typedef WSAPOLLFD PollHandle;
+   #else
+    typedef struct pollfd PollHandle;
+   #endif
+
+    enum { pollIntervalMs = 20 };
+
+    SocketReactor& owner;
+    Array<PollHandle> handles;
+    Array<int64> ids;
+};
+
+#endif
+
+//==============================================================================
+class SocketReactor::WorkerThread  : public Thread
+{
+public:
+    WorkerThread (SocketReactor& r)  : Thread ("JUCE socket reactor"), owner (r) {}
+
+    void run() override     { owner.runWorker (*this); }
+
+private:
+    SocketReactor& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (WorkerThread)
+};
+
+void SocketReactor::Listener::socketReadyForWriting (int) {}
+
+//==============================================================================
+SocketReactor::SocketReactor (int numThreads)
+    : pimpl (new Pimpl (*this))
+{
+    numThreads = jlimit (1, Pimpl::getMaxNumThreads(), numThreads);
+
+    for (int i = 0; i < numThreads; ++i)
+        threads.add (new WorkerThread (*this))->startThread();
+}
+
+SocketReactor::~SocketReactor()
+{
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    pimpl->wakeAllThreads();
+
+    for (auto* t : threads)
+        t->stopThread (4000);
+
+    const ScopedLock sl (lock);
+
+    while (registrations.size() > 0)
+        deleteRegistration (registrations.getLast());
+}
+
+//==============================================================================
+bool SocketReactor::addSocket (int socketHandle, Listener* listener, bool notifyWhenWritable)
+{
+    jassert (listener != nullptr);
+
+    if (socketHandle < 0 || listener == nullptr)
+        return false;
+
+    const ScopedLock sl (lock);
+
+    if (findRegistration (socketHandle) != nullptr)
+        return false;
+
+    auto* r = new Registration();
+    r->id = nextRegistrationId++;
+    r->handle = socketHandle;
+    r->listener = listener;
+    r->notifyWhenWritable = notifyWhenWritable;
+
+    registrations.add (r);
+    registrationsById.set (r->id, r);
+
+    if (! pimpl->add (*r))
+    {
+        deleteRegistration (r);
+        return false;
+    }
+
+    return true;
+}
+
+bool SocketReactor::addSocket (StreamingSocket& socket, Listener* listener, bool notifyWhenWritable)
+{
+    return socket.isConnected() && addSocket (socket.getRawSocketHandle(), listener, notifyWhenWritable);
+}
+
+bool SocketReactor::addSocket (DatagramSocket& socket, Listener* listener, bool notifyWhenWritable)
+{
+    return addSocket (socket.getRawSocketHandle(), listener, notifyWhenWritable);
+}
+
+void SocketReactor::removeSocket (int socketHandle)
+{
+    const ScopedLock sl (lock);
+
+    auto* r = findRegistration (socketHandle);
+
+    if (r == nullptr)
+        return;
+
+    r->removed = true;
+    pimpl->remove (*r);
+
+    if (r->callbackThread == nullptr)
+    {
+        deleteRegistration (r);
+        return;
+    }
+
+    // if we're inside one of its callbacks, it'll be deleted when that returns
+    if (r->callbackThread == Thread::getCurrentThreadId())
+        return;
+
+    auto id = r->id;
+
+    while (findRegistrationWithId (id) != nullptr)
+    {
+        const ScopedUnlock ul (lock);
+        callbackFinished.wait (5);
+    }
+}
+
+void SocketReactor::setNotifyWhenWritable (int socketHandle, bool shouldNotify)
+{
+    const ScopedLock sl (lock);
+
+    if (auto* r = findRegistration (socketHandle))
+    {
+        if (r->notifyWhenWritable != shouldNotify)
+        {
+            r->notifyWhenWritable = shouldNotify;
+
+            // if a callback's in progress, this gets picked up when it's re-armed
+            if (r->callbackThread == nullptr)
+                pimpl->rearm (*r);
+        }
+    }
+}
+
+int SocketReactor::getNumSockets() const
+{
+    const ScopedLock sl (lock);
+    int num = 0;
+
+    for (auto* r : registrations)
+        if (! r->removed)
+            ++num;
+
+    return num;
+}
+
+//==============================================================================
+SocketReactor::Registration* SocketReactor::findRegistration (int socketHandle) const noexcept
+{
+    for (auto* r : registrations)
+        if (r->handle == socketHandle && ! r->removed)
+            return r;
+
+    return nullptr;
+}
+
+SocketReactor::Registration* SocketReactor::findRegistrationWithId (int64 id) const noexcept
+{
+    return registrationsById[id];
+}
+
+void SocketReactor::deleteRegistration (Registration* r)
+{
+    registrationsById.remove (r->id);
+    registrations.removeObject (r);
+}
+
+void SocketReactor::runWorker (WorkerThread& thread)
+{
+    SocketReactorEvent events[16];
+
+    while (! thread.threadShouldExit())
+    {
+        auto numEvents = pimpl->wait (events, numElementsInArray (events));
+
+        for (int i = 0; i < numEvents && ! thread.threadShouldExit(); ++i)
+            handleEvent (events[i].id, events[i].readable, events[i].writable);
+    }
+}
+
+void SocketReactor::handleEvent (int64 id, bool readable, bool writable)
+{
+    Registration* r;
+
+    {
+        const ScopedLock sl (lock);
+        r = findRegistrationWithId (id);
+
+        if (r == nullptr || r->removed)
+            return;
+
+        // another thread is already dealing with this socket, so let it make the callbacks
+        if (r->callbackThread != nullptr)
+        {
+            r->pendingRead  = r->pendingRead  || readable;
+            r->pendingWrite = r->pendingWrite || writable;
+            return;
+        }
+
+        r->callbackThread = Thread::getCurrentThreadId();
+    }
+
+    for (;;)
+    {
+        if (readable)
+            r->listener->socketReadyForReading (r->handle);
+
+        if (writable && ! r->removed)
+            r->listener->socketReadyForWriting (r->handle);
+
+        const ScopedLock sl (lock);
+
+        if (r->removed)
+        {
+            deleteRegistration (r);
+            break;
+        }
+
+        readable = r->pendingRead;
+        writable = r->pendingWrite;
+        r->pendingRead = r->pendingWrite = false;
+
+        if (! (readable || writable))
+        {
+            r->callbackThread = nullptr;
+            pimpl->rearm (*r);
+            return;
+        }
+    }
+
+    callbackFinished.signal();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SocketReactorTests  : public UnitTest
+{
+public:
+    SocketReactorTests() : UnitTest ("SocketReactor", "Networking") {}
+
+    struct Counter  : public SocketReactor::Listener
+    {
+        void socketReadyForReading (int handle) override
+        {
+            char buffer[256];
+            auto numRead = ::recv ((SocketHandleType) handle, buffer, sizeof (buffer), 0);
+
+            if (numRead > 0)
+                bytesRead += (int) numRead;
+
+            ++numCallbacks;
+        }
+
+        Atomic<int> numCallbacks, bytesRead;
+    };
+
+   #if JUCE_WINDOWS
+    typedef SOCKET SocketHandleType;
+   #else
+    typedef int SocketHandleType;
+   #endif
+
+    static bool waitFor (std::function<bool()> condition)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (condition())
+                return true;
+
+            Thread::sleep (2);
+        }
+
+        return false;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Datagram sockets");
+        {
+            SocketReactor reactor (2);
+            expect (reactor.getNumThreads() >= 1);
+
+            const int numSockets = 20;
+            OwnedArray<DatagramSocket> receivers;
+            OwnedArray<Counter> counters;
+
+            for (int i = 0; i < numSockets; ++i)
+            {
+                auto* s = receivers.add (new DatagramSocket (false));
+                expect (s->bindToPort (0, "127.0.0.1"));
+                expect (reactor.addSocket (*s, counters.add (new Counter())));
+            }
+
+            expectEquals (reactor.getNumSockets(), numSockets);
+            expect (! reactor.addSocket (*receivers[0], counters[0]));
+
+            DatagramSocket sender;
+            const char data[100] = {};
+
+            for (int round = 0; round < 5; ++round)
+                for (auto* s : receivers)
+                    sender.write ("127.0.0.1", s->getBoundPort(), data, sizeof (data));
+
+            expect (waitFor ([&]
+            {
+                for (auto* c : counters)
+                    if (c->bytesRead.get() < 5 * (int) sizeof (data))
+                        return false;
+
+                return true;
+            }));
+
+            for (auto* c : counters)
+                expectEquals (c->bytesRead.get(), 5 * (int) sizeof (data));
+
+            for (auto* s : receivers)
+                reactor.removeSocket (s->getRawSocketHandle());
+
+            expectEquals (reactor.getNumSockets(), 0);
+
+            auto numCallbacks = counters[0]->numCallbacks.get();
+            sender.write ("127.0.0.1", receivers[0]->getBoundPort(), data, sizeof (data));
+            Thread::sleep (50);
+            expectEquals (counters[0]->numCallbacks.get(), numCallbacks);
+        }
+
+        beginTest ("Removing from a callback");
+        {
+            struct SelfRemover  : public SocketReactor::Listener
+            {
+                SelfRemover (SocketReactor& r) : reactor (r) {}
+
+                void socketReadyForReading (int handle) override
+                {
+                    reactor.removeSocket (handle);
+                    ++numCallbacks;
+                }
+
+                SocketReactor& reactor;
+                Atomic<int> numCallbacks;
+            };
+
+            SocketReactor reactor;
+            DatagramSocket receiver (false), sender;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+
+            SelfRemover remover (reactor);
+            expect (reactor.addSocket (receiver, &remover));
+
+            const char data[10] = {};
+            sender.write ("127.0.0.1", receiver.getBoundPort(), data, sizeof (data));
+
+            expect (waitFor ([&] { return reactor.getNumSockets() == 0; }));
+            Thread::sleep (20);
+            expectEquals (remover.numCallbacks.get(), 1);
+        }
+    }
+};
+
+static SocketReactorTests socketReactorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Waits for activity on any number of sockets, using a small pool of threads.
+
+    Rather than giving every socket its own thread that blocks in a read, you can
+    add them all to a SocketReactor, and it'll call your Listener whenever one of
+    them has some data waiting, so the read won't block. This uses epoll on Linux
+    and Android, kqueue on OSX and iOS, and poll() elsewhere.
+
+    Each socket is only ever handed to one thread at a time, and it won't be
+    reported again until the callback for it has returned, so a Listener doesn't
+    need to worry about two threads reading the same socket. Different sockets may
+    be handled on different threads at the same time though, so if a Listener is
+    shared between sockets, it needs to be thread-safe.
+
+    The callbacks should do as little work as they can and mustn't block, because
+    any other sockets that become ready have to wait for a free thread. If a
+    callback only reads part of the data that's waiting, it'll just be called again.
+
+    A socket must be removed before it's closed or deleted.
+
+    @see StreamingSocket, DatagramSocket, InterprocessConnectionServer
+*/
+class JUCE_API  SocketReactor  final
+{
+public:
+    //==============================================================================
+    /** Receives callbacks from a SocketReactor. */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called when a socket has data waiting to be read.
+
+            This is also called when the connection has been closed or has failed, in
+            which case reading from it will return 0 or -1. It's called on one of the
+            reactor's threads.
+        */
+        virtual void socketReadyForReading (int socketHandle) = 0;
+
+        /** Called when a socket that was added with notifyWhenWritable set can be
+            written to without blocking.
+        */
+        virtual void socketReadyForWriting (int socketHandle);
+    };
+
+    //==============================================================================
+    /** Creates a reactor with the given number of threads.
+        On systems that have to use poll(), there's only ever one thread.
+    */
+    explicit SocketReactor (int numThreads = 1);
+
+    /** Destructor.
+        Any sockets that are still registered are removed first.
+    */
+    ~SocketReactor();
+
+    //==============================================================================
+    /** Starts watching a socket.
+
+        The listener must stay valid until the socket is removed. If notifyWhenWritable
+        is true, you'll also get a callback whenever the socket can be written to (see
+        setNotifyWhenWritable()).
+
+        Returns false if the socket isn't valid or has already been added.
+    */
+    bool addSocket (int socketHandle, Listener* listener, bool notifyWhenWritable = false);
+
+    /** Starts watching a StreamingSocket. @see addSocket */
+    bool addSocket (StreamingSocket& socket, Listener* listener, bool notifyWhenWritable = false);
+
+    /** Starts watching a DatagramSocket. @see addSocket */
+    bool addSocket (DatagramSocket& socket, Listener* listener, bool notifyWhenWritable = false);
+
+    /** Stops watching a socket.
+
+        When this returns, the socket's listener won't receive any more callbacks, and
+        if one was in progress on another thread, it has finished. It's fine to call
+        this from inside one of the socket's own callbacks.
+    */
+    void removeSocket (int socketHandle);
+
+    /** Changes whether a socket's listener is told when the socket can be written to.
+
+        A socket can nearly always be written to, so this should only be turned on when
+        you have data which couldn't be sent, and off again once it's all gone.
+    */
+    void setNotifyWhenWritable (int socketHandle, bool shouldNotify);
+
+    /** Returns the number of sockets that are being watched. */
+    int getNumSockets() const;
+
+    /** Returns the number of threads that handle the callbacks. */
+    int getNumThreads() const noexcept                  { return threads.size(); }
+
+private:
+    //==============================================================================
+    struct Registration;
+    class WorkerThread;
+    friend class WorkerThread;
+    struct Pimpl;
+    friend struct ContainerDeletePolicy<Pimpl>;
+
+    CriticalSection lock;
+    OwnedArray<Registration> registrations;
+    HashMap<int64, Registration*> registrationsById;
+    int64 nextRegistrationId = 1;
+    WaitableEvent callbackFinished;
+    ScopedPointer<Pimpl> pimpl;
+    OwnedArray<WorkerThread> threads;
+
+    Registration* findRegistration (int socketHandle) const noexcept;
+    Registration* findRegistrationWithId (int64 id) const noexcept;
+    void runWorker (WorkerThread&);
+    void handleEvent (int64 id, bool readable, bool writable);
+    void deleteRegistration (Registration*);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketReactor)
+};
+
+} // namespace juce
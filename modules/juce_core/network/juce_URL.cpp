@@ -105,6 +105,189 @@ struct FallbackDownloadTask  : public URL::DownloadTask,
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FallbackDownloadTask)
 };
 
+//==============================================================================
+struct ParallelDownloadTask  : public URL::DownloadTask
+{
+    ParallelDownloadTask (const URL& urlToUse,
+                          FileOutputStream* outputStreamToUse,
+                          WebInputStream* firstStream,
+                          const String& extraHeadersToUse,
+                          int numParts,
+                          URL::DownloadTask::Listener* listenerToUse)
+        : fileStream (outputStreamToUse),
+          listener (listenerToUse),
+          numPartsRemaining (numParts)
+    {
+        jassert (fileStream != nullptr);
+        jassert (firstStream != nullptr);
+
+        contentLength = firstStream->getTotalLength();
+        httpCode      = firstStream->getStatusCode();
+
+        auto partSize = (contentLength + numParts - 1) / numParts;
+
+        // the first part is read from the stream that found out the length
+        for (int i = 0; i < numParts; ++i)
+            parts.add (new Part (*this, urlToUse, extraHeadersToUse, i == 0 ? firstStream : nullptr,
+                                 partSize * i, jmin (contentLength, partSize * (i + 1))));
+
+        for (auto* p : parts)
+            p->startThread();
+    }
+
+    ~ParallelDownloadTask()
+    {
+        isBeingDeleted = true;
+        stopParts (nullptr);
+
+        for (auto* p : parts)
+            p->waitForThreadToExit (-1);
+    }
+
+    //==============================================================================
+    struct Part  : public Thread
+    {
+        Part (ParallelDownloadTask& ownerTask, const URL& urlToUse, const String& extraHeadersToUse,
+              WebInputStream* streamToUse, int64 start, int64 end)
+            : Thread ("DownloadTask thread"),
+              owner (ownerTask), url (urlToUse), extraHeaders (extraHeadersToUse),
+              stream (streamToUse), position (start), endPosition (end)
+        {
+        }
+
+        void run() override
+        {
+            owner.partFinished (*this, openStream() && readStream());
+        }
+
+        bool openStream()
+        {
+            if (stream != nullptr)
+                return true;
+
+            ScopedPointer<WebInputStream> newStream (new WebInputStream (url, false));
+            newStream->withExtraHeaders (extraHeaders);
+            newStream->withExtraHeaders ("Range: bytes=" + String (position) + "-" + String (endPosition - 1));
+
+            {
+                const ScopedLock sl (streamLock);
+
+                if (threadShouldExit())
+                    return false;
+
+                stream = newStream.release();
+            }
+
+            // a server that ignores the range would send the whole file
+            return stream->connect (nullptr)
+                    && stream->getStatusCode() == 206
+                    && stream->getResponseHeaders()["Content-Range"].startsWith ("bytes " + String (position) + "-");
+        }
+
+        bool readStream()
+        {
+            HeapBlock<char> buffer (bufferSize);
+
+            while (position < endPosition && ! threadShouldExit())
+            {
+                auto actual = stream->read (buffer.get(), (int) jmin ((int64) bufferSize, endPosition - position));
+
+                if (actual <= 0 || threadShouldExit() || stream->isError())
+                    return false;
+
+                if (! owner.writeBlock (position, buffer.get(), (size_t) actual))
+                    return false;
+
+                position += actual;
+                owner.addProgress (actual);
+            }
+
+            return position == endPosition;
+        }
+
+        void cancel()
+        {
+            signalThreadShouldExit();
+
+            const ScopedLock sl (streamLock);
+
+            if (stream != nullptr)
+                stream->cancel();
+        }
+
+        ParallelDownloadTask& owner;
+        const URL url;
+        const String extraHeaders;
+        ScopedPointer<WebInputStream> stream;
+        CriticalSection streamLock;
+        int64 position;
+        const int64 endPosition;
+
+        enum { bufferSize = 0x8000 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Part)
+    };
+
+    //==============================================================================
+    bool writeBlock (int64 position, const void* data, size_t numBytes)
+    {
+        const ScopedLock sl (fileLock);
+        return fileStream->setPosition (position) && fileStream->write (data, numBytes);
+    }
+
+    void addProgress (int numBytes)
+    {
+        const ScopedLock sl (progressLock);
+        downloaded += numBytes;
+
+        if (listener != nullptr)
+            listener->progress (this, downloaded, contentLength);
+    }
+
+    void partFinished (Part& part, bool succeeded)
+    {
+        if (! succeeded)
+            stopParts (&part);
+
+        {
+            const ScopedLock sl (progressLock);
+
+            if (! succeeded)
+                error = true;
+
+            if (--numPartsRemaining > 0)
+                return;
+        }
+
+        {
+            const ScopedLock sl (fileLock);
+            fileStream->flush();
+        }
+
+        finished = true;
+
+        if (listener != nullptr && ! isBeingDeleted)
+            listener->finished (this, ! error);
+    }
+
+    void stopParts (Part* partToSkip)
+    {
+        for (auto* p : parts)
+            if (p != partToSkip)
+                p->cancel();
+    }
+
+    //==============================================================================
+    const ScopedPointer<FileOutputStream> fileStream;
+    URL::DownloadTask::Listener* const listener;
+    OwnedArray<Part> parts;
+    CriticalSection fileLock, progressLock;
+    int numPartsRemaining;
+    std::atomic<bool> isBeingDeleted { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelDownloadTask)
+};
+
 void URL::DownloadTask::Listener::progress (DownloadTask*, int64, int64) {}
 URL::DownloadTask::Listener::~Listener() {}
 
@@ -130,6 +313,39 @@ URL::DownloadTask* URL::DownloadTask::createFallbackDownloader (const URL& urlTo
     return nullptr;
 }
 
+URL::DownloadTask* URL::DownloadTask::createParallelDownloader (const URL& urlToUse,
+                                                                const File& targetFileToUse,
+                                                                int numConnections,
+                                                                const String& extraHeadersToUse,
+                                                                Listener* listenerToUse)
+{
+    const size_t bufferSize = 0x8000;
+    const int64 minimumPartSize = 256 * 1024;
+    targetFileToUse.deleteFile();
+
+    if (ScopedPointer<FileOutputStream> outputStream = targetFileToUse.createOutputStream (bufferSize))
+    {
+        ScopedPointer<WebInputStream> stream = new WebInputStream (urlToUse, false);
+        stream->withExtraHeaders (extraHeadersToUse);
+
+        if (stream->connect (nullptr))
+        {
+            auto length = stream->getTotalLength();
+            auto numParts = (int) jmin ((int64) numConnections, length / minimumPartSize);
+
+            if (numParts > 1
+                 && stream->getStatusCode() == 200
+                 && stream->getResponseHeaders()["Accept-Ranges"].containsIgnoreCase ("bytes"))
+                return new ParallelDownloadTask (urlToUse, outputStream.release(), stream.release(),
+                                                 extraHeadersToUse, numParts, listenerToUse);
+
+            return new FallbackDownloadTask (outputStream.release(), bufferSize, stream.release(), listenerToUse);
+        }
+    }
+
+    return nullptr;
+}
+
 URL::DownloadTask::DownloadTask() {}
 URL::DownloadTask::~DownloadTask() {}
 
@@ -498,6 +714,12 @@ WebInputStream* URL::createInputStream (const bool usePostCommand,
     return wi.release();
 }
 
+URL::DownloadTask* URL::downloadToFileInParallel (const File& targetLocation, int numConnections,
+                                                  String extraHeaders, DownloadTask::Listener* listener)
+{
+    return URL::DownloadTask::createParallelDownloader (*this, targetLocation, numConnections, extraHeaders, listener);
+}
+
 //==============================================================================
 bool URL::readEntireBinaryStream (MemoryBlock& destData, bool usePostCommand) const
 {
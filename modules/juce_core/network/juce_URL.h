@@ -363,6 +363,7 @@ public:
     private:
         friend class URL;
         static DownloadTask* createFallbackDownloader (const URL&, const File&, const String&, Listener*, bool);
+        static DownloadTask* createParallelDownloader (const URL&, const File&, int, const String&, Listener*);
 
     public:
        #if JUCE_IOS
@@ -388,6 +389,24 @@ public:
                                   DownloadTask::Listener* listener = nullptr,
                                   bool usePostCommand = false);
 
+    /** Downloads the URL to a file, fetching different parts of it over several
+        connections at the same time.
+
+        If the server gives the length of the file and accepts byte-range requests,
+        the file is split into as many as numConnections parts, each of at least 256KB,
+        which are downloaded in parallel and written into their places in the target
+        file. Otherwise this just downloads it over a single connection.
+
+        Unlike downloadToFile(), this always uses WebInputStreams rather than a native
+        background task, so on mobile it won't carry on while your app is suspended.
+        The listener's progress callback may come from any of the download threads,
+        but never from more than one at a time.
+    */
+    DownloadTask* downloadToFileInParallel (const File& targetLocation,
+                                            int numConnections,
+                                            String extraHeaders = String(),
+                                            DownloadTask::Listener* listener = nullptr);
+
     //==============================================================================
     /** Tries to download the entire contents of this URL into a binary data block.
 
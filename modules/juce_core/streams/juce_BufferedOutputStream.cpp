@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+BufferedOutputStream::BufferedOutputStream (OutputStream* destStream, int size, bool takeOwnership)
+   : destination (destStream, takeOwnership),
+     bufferSize ((size_t) jmax (16, size))
+{
+    // You need to supply a real stream when creating a BufferedOutputStream
+    jassert (destStream != nullptr);
+
+    buffer.malloc (bufferSize);
+}
+
+BufferedOutputStream::BufferedOutputStream (OutputStream& destStream, int size)
+   : BufferedOutputStream (&destStream, size, false)
+{
+}
+
+BufferedOutputStream::~BufferedOutputStream()
+{
+    writeBuffer();
+}
+
+//==============================================================================
+bool BufferedOutputStream::writeBuffer()
+{
+    if (numBuffered == 0)
+        return true;
+
+    auto numToWrite = numBuffered;
+    numBuffered = 0;
+    return destination->write (buffer, numToWrite);
+}
+
+void BufferedOutputStream::flush()
+{
+    writeBuffer();
+    destination->flush();
+}
+
+int64 BufferedOutputStream::getPosition()
+{
+    return destination->getPosition() + (int64) numBuffered;
+}
+
+bool BufferedOutputStream::setPosition (int64 newPosition)
+{
+    return writeBuffer() && destination->setPosition (newPosition);
+}
+
+bool BufferedOutputStream::write (const void* data, size_t numBytes)
+{
+    jassert (data != nullptr && ((ssize_t) numBytes) >= 0);
+
+    if (numBuffered + numBytes <= bufferSize)
+    {
+        memcpy (buffer + numBuffered, data, numBytes);
+        numBuffered += numBytes;
+        return true;
+    }
+
+    if (! writeBuffer())
+        return false;
+
+    // anything that wouldn't fit in the buffer gets written directly
+    if (numBytes >= bufferSize)
+        return destination->write (data, numBytes);
+
+    memcpy (buffer, data, numBytes);
+    numBuffered = numBytes;
+    return true;
+}
+
+bool BufferedOutputStream::writeRepeatedByte (uint8 byte, size_t numTimesToRepeat)
+{
+    while (numTimesToRepeat > 0)
+    {
+        if (numBuffered == bufferSize && ! writeBuffer())
+            return false;
+
+        auto numToDo = jmin (numTimesToRepeat, bufferSize - numBuffered);
+        memset (buffer + numBuffered, byte, numToDo);
+        numBuffered += numToDo;
+        numTimesToRepeat -= numToDo;
+    }
+
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BufferedOutputStreamTests  : public UnitTest
+{
+public:
+    BufferedOutputStreamTests() : UnitTest ("BufferedOutputStream", "Streams") {}
+
+    // counts the calls that actually reach the destination
+    struct CountingStream  : public MemoryOutputStream
+    {
+        bool write (const void* data, size_t numBytes) override
+        {
+            ++numWrites;
+            return MemoryOutputStream::write (data, numBytes);
+        }
+
+        int numWrites = 0;
+    };
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Writes the same data as an unbuffered stream");
+        {
+            MemoryOutputStream expected;
+            CountingStream dest;
+
+            {
+                BufferedOutputStream buffered (dest, 1000);
+
+                for (int i = 0; i < 5000; ++i)
+                {
+                    switch (r.nextInt (5))
+                    {
+                        case 0:     expected.writeInt (i);              buffered.writeInt (i);              break;
+                        case 1:     expected.writeDouble (i * 0.5);     buffered.writeDouble (i * 0.5);     break;
+                        case 2:     expected.writeString ("abc");       buffered.writeString ("abc");       break;
+                        case 3:     expected.writeRepeatedByte (1, 300); buffered.writeRepeatedByte (1, 300); break;
+                        default:
+                        {
+                            MemoryBlock block ((size_t) r.nextInt (3000));
+                            r.fillBitsRandomly (block.getData(), block.getSize());
+                            expected.write (block.getData(), block.getSize());
+                            buffered.write (block.getData(), block.getSize());
+                            break;
+                        }
+                    }
+
+                    expectEquals (buffered.getPosition(), expected.getPosition());
+                }
+            }
+
+            expect (dest.getMemoryBlock() == expected.getMemoryBlock());
+            expect (dest.numWrites < 5000);
+        }
+
+        beginTest ("Small writes are combined");
+        {
+            CountingStream dest;
+
+            {
+                BufferedOutputStream buffered (dest, 4096);
+
+                for (int i = 0; i < 4096; ++i)
+                    buffered.writeInt (i);
+
+                expectEquals (dest.numWrites, 3);
+            }
+
+            expectEquals (dest.numWrites, 4);
+            expectEquals ((int) dest.getDataSize(), 4096 * 4);
+        }
+
+        beginTest ("Repositioning");
+        {
+            MemoryOutputStream dest;
+
+            {
+                BufferedOutputStream buffered (dest, 64);
+                buffered.writeString ("hello world");
+                expect (buffered.setPosition (6));
+                expectEquals (buffered.getPosition(), (int64) 6);
+                buffered.write ("there", 5);
+            }
+
+            expectEquals (dest.toUTF8(), String ("hello there"));
+        }
+    }
+};
+
+static BufferedOutputStreamTests bufferedOutputStreamTests;
+
+#endif
+
+} // namespace juce
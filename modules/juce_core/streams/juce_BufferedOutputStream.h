@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/** Wraps another output stream, and collects the data written to it in a buffer
+    before passing it on.
+
+    If you're writing lots of small pieces of data, e.g. one value at a time with
+    writeInt() or writeFloat(), wrapping the stream in one of these means that the
+    destination stream gets written in large chunks, so there are far fewer calls
+    to the underlying file or socket. Writes which are larger than the buffer are
+    passed straight through without being copied.
+
+    Because the data is held back, an error in the destination stream may not be
+    reported until a later write, or a call to flush().
+
+    @see BufferedInputStream
+*/
+class JUCE_API  BufferedOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a BufferedOutputStream that writes to another stream.
+
+        @param destStream                   the stream to write to
+        @param bufferSize                   the number of bytes to collect before writing them
+                                            to the destination
+        @param deleteDestStreamWhenDestroyed whether the destStream that is passed in should be
+                                            deleted by this object when it is itself deleted.
+    */
+    BufferedOutputStream (OutputStream* destStream,
+                          int bufferSize,
+                          bool deleteDestStreamWhenDestroyed);
+
+    /** Creates a BufferedOutputStream that writes to another stream.
+
+        @param destStream       the stream to write to - this must not be deleted until
+                                this object has been destroyed.
+        @param bufferSize       the number of bytes to collect before writing them to the
+                                destination
+    */
+    BufferedOutputStream (OutputStream& destStream, int bufferSize);
+
+    /** Destructor.
+
+        Any data still in the buffer is written to the destination, which may then be
+        deleted, if that option was chosen when the buffered stream was created.
+    */
+    ~BufferedOutputStream();
+
+    //==============================================================================
+    /** Writes any buffered data to the destination stream, and then flushes that stream. */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64 newPosition) override;
+    bool write (const void* dataToWrite, size_t numberOfBytes) override;
+    bool writeRepeatedByte (uint8 byte, size_t numTimesToRepeat) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destination;
+    HeapBlock<char> buffer;
+    size_t bufferSize, numBuffered = 0;
+
+    bool writeBuffer();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferedOutputStream)
+};
+
+} // namespace juce
@@ -202,17 +202,43 @@ String InputStream::readNextLine()
 
 size_t InputStream::readIntoMemoryBlock (MemoryBlock& block, ssize_t numBytes)
 {
+    size_t numAvailable = 0;
+
+    if (auto* view = getDirectView (numAvailable))
+    {
+        if (numBytes >= 0)
+            numAvailable = jmin (numAvailable, (size_t) numBytes);
+
+        block.append (view, numAvailable);
+        skipNextBytes ((int64) numAvailable);
+        return numAvailable;
+    }
+
     MemoryOutputStream mo (block, true);
     return (size_t) mo.writeFromInputStream (*this, numBytes);
 }
 
 String InputStream::readEntireStreamAsString()
 {
+    size_t numAvailable = 0;
+
+    if (auto* view = getDirectView (numAvailable))
+    {
+        skipNextBytes ((int64) numAvailable);
+        return String::createStringFromData (view, (int) numAvailable);
+    }
+
     MemoryOutputStream mo;
     mo << *this;
     return mo.toString();
 }
 
+const void* InputStream::getDirectView (size_t& numBytesAvailable)
+{
+    numBytesAvailable = 0;
+    return nullptr;
+}
+
 //==============================================================================
 void InputStream::skipNextBytes (int64 numBytesToSkip)
 {
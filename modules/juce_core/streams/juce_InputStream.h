@@ -247,6 +247,21 @@ public:
     */
     virtual void skipNextBytes (int64 numBytesToSkip);
 
+    //==============================================================================
+    /** If the rest of this stream's data is already in memory, this returns a pointer
+        to it, so that it can be used without copying.
+
+        The pointer is to the data at the stream's current position, and numBytesAvailable
+        is set to the number of bytes between there and the end of the stream. Reading
+        from the view doesn't move the stream's position - use setPosition() or
+        skipNextBytes() if you need to do that. The memory stays valid until the stream
+        is deleted.
+
+        Streams that can't do this (which is the default) return nullptr. Streams that
+        can include MemoryInputStream and MappedInputStream.
+    */
+    virtual const void* getDirectView (size_t& numBytesAvailable);
+
 
 protected:
     //==============================================================================
@@ -94,6 +94,18 @@ int64 MemoryInputStream::getPosition()
     return (int64) position;
 }
 
+void MemoryInputStream::skipNextBytes (int64 numBytesToSkip)
+{
+    if (numBytesToSkip > 0)
+        setPosition (getPosition() + numBytesToSkip);
+}
+
+const void* MemoryInputStream::getDirectView (size_t& numBytesAvailable)
+{
+    numBytesAvailable = dataSize - position;
+    return addBytesToPointer (data, position);
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -132,6 +144,27 @@ public:
         expect (mi.readInt64BigEndian() == randomInt64);
         expect (mi.readDouble() == randomDouble);
         expect (mi.readDoubleBigEndian() == randomDouble);
+
+        beginTest ("Direct views");
+        {
+            const char text[] = "abcdefghij";
+            MemoryInputStream m (text, 10, false);
+            m.setPosition (3);
+
+            size_t numAvailable = 0;
+            auto* view = m.getDirectView (numAvailable);
+            expect (view == text + 3 && numAvailable == 7);
+            expectEquals (m.getPosition(), (int64) 3);
+
+            SubregionStream sub (&m, 2, 5, false);
+            sub.setPosition (1);
+            view = sub.getDirectView (numAvailable);
+            expect (view == text + 3 && numAvailable == 4);
+
+            m.setPosition (2);
+            expectEquals (m.readEntireStreamAsString(), String ("cdefghij"));
+            expect (m.isExhausted());
+        }
     }
 
     static String createRandomWideCharString (Random& r)
@@ -75,6 +75,8 @@ public:
     int64 getTotalLength() override;
     bool isExhausted() override;
     int read (void* destBuffer, int maxBytesToRead) override;
+    void skipNextBytes (int64 numBytesToSkip) override;
+    const void* getDirectView (size_t& numBytesAvailable) override;
 
 private:
     //==============================================================================
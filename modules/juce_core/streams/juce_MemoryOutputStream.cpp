@@ -43,9 +43,18 @@ MemoryOutputStream::MemoryOutputStream (void* destBuffer, size_t destBufferSize)
     jassert (externalData != nullptr); // This must be a valid pointer.
 }
 
+MemoryOutputStream::MemoryOutputStream (MemoryArena& arenaToUse, size_t initialSize)
+  : arena (&arenaToUse)
+{
+    growArenaBlock (initialSize);
+}
+
 MemoryOutputStream::~MemoryOutputStream()
 {
     trimExternalBlockSize();
+
+    if (arena != nullptr)
+        arena->deallocate (externalData, availableSize);
 }
 
 void MemoryOutputStream::flush()
@@ -63,6 +72,20 @@ void MemoryOutputStream::preallocate (const size_t bytesToPreallocate)
 {
     if (blockToUse != nullptr)
         blockToUse->ensureSize (bytesToPreallocate + 1);
+    else if (arena != nullptr && bytesToPreallocate + 1 > availableSize)
+        growArenaBlock (bytesToPreallocate + 1);
+}
+
+bool MemoryOutputStream::growArenaBlock (size_t newSize)
+{
+    if (auto* newData = arena->reallocate (externalData, availableSize, newSize, 1))
+    {
+        externalData = newData;
+        availableSize = newSize;
+        return true;
+    }
+
+    return false;
 }
 
 void MemoryOutputStream::reset() noexcept
@@ -71,6 +94,14 @@ void MemoryOutputStream::reset() noexcept
     size = 0;
 }
 
+// The storage grows geometrically rather than by a capped amount, so that a stream
+// which is written a piece at a time doesn't end up re-copying its contents over and
+// over once it gets large.
+static size_t getGrownStorageSize (size_t storageNeeded) noexcept
+{
+    return (storageNeeded + storageNeeded / 2 + 32) & ~(size_t) 31;
+}
+
 char* MemoryOutputStream::prepareToWrite (size_t numBytes)
 {
     jassert ((ssize_t) numBytes >= 0);
@@ -81,13 +112,15 @@ char* MemoryOutputStream::prepareToWrite (size_t numBytes)
     if (blockToUse != nullptr)
     {
         if (storageNeeded >= blockToUse->getSize())
-            blockToUse->ensureSize ((storageNeeded + jmin (storageNeeded / 2, (size_t) (1024 * 1024)) + 32) & ~31u);
+            blockToUse->ensureSize (getGrownStorageSize (storageNeeded));
 
         data = static_cast<char*> (blockToUse->getData());
     }
     else
     {
-        if (storageNeeded > availableSize)
+        if (storageNeeded > availableSize
+             && (arena == nullptr
+                  || ! growArenaBlock (getGrownStorageSize (storageNeeded))))
             return nullptr;
 
         data = static_cast<char*> (externalData);
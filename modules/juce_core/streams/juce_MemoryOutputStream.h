@@ -61,6 +61,14 @@ public:
     */
     MemoryOutputStream (void* destBuffer, size_t destBufferSize);
 
+    /** Creates a MemoryOutputStream that will keep its data in a MemoryArena.
+        This is handy for building temporary strings without any heap allocation.
+        The arena must outlive the stream, and its memory is handed back (if possible)
+        when the stream is deleted.
+        @see MemoryArena
+    */
+    MemoryOutputStream (MemoryArena& arenaToUse, size_t initialSize = 256);
+
     /** Destructor.
         This will free any data that was written to it.
     */
@@ -82,6 +90,10 @@ public:
 
     /** Increases the internal storage capacity to be able to contain at least the specified
         amount of data without needing to be resized.
+
+        The storage grows geometrically as data is written, so this isn't needed for
+        efficiency, but if you know roughly how much you're going to write, calling it
+        first avoids the intermediate reallocations and copies.
     */
     void preallocate (size_t bytesToPreallocate);
 
@@ -117,8 +129,11 @@ private:
     MemoryBlock* const blockToUse = nullptr;
     MemoryBlock internalBlock;
     void* externalData = nullptr;
+    MemoryArena* const arena = nullptr;
     size_t position = 0, size = 0, availableSize = 0;
 
+    bool growArenaBlock (size_t);
+
     void trimExternalBlockSize();
     char* prepareToWrite (size_t);
 
@@ -70,6 +70,16 @@ int SubregionStream::read (void* destBuffer, int maxBytesToRead)
     return source->read (destBuffer, maxBytesToRead);
 }
 
+const void* SubregionStream::getDirectView (size_t& numBytesAvailable)
+{
+    auto* view = source->getDirectView (numBytesAvailable);
+
+    if (view != nullptr && lengthOfSourceStream >= 0)
+        numBytesAvailable = (size_t) jlimit ((int64) 0, (int64) numBytesAvailable, lengthOfSourceStream - getPosition());
+
+    return view;
+}
+
 bool SubregionStream::isExhausted()
 {
     if (lengthOfSourceStream >= 0 && getPosition() >= lengthOfSourceStream)
@@ -68,6 +68,7 @@ public:
     int64 getPosition() override;
     bool setPosition (int64 newPosition) override;
     int read (void* destBuffer, int maxBytesToRead) override;
+    const void* getDirectView (size_t& numBytesAvailable) override;
     bool isExhausted() override;
 
 private:
@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace CPUDispatchHelpers
+{
+    struct FeatureInfo
+    {
+        CPUDispatch::Feature flag;
+        const char* name;
+        bool (*isPresent)() noexcept;
+    };
+
+    static const FeatureInfo features[] =
+    {
+        { CPUDispatch::sse2,      "sse2",      SystemStats::hasSSE2 },
+        { CPUDispatch::sse3,      "sse3",      SystemStats::hasSSE3 },
+        { CPUDispatch::ssse3,     "ssse3",     SystemStats::hasSSSE3 },
+        { CPUDispatch::sse41,     "sse4.1",    SystemStats::hasSSE41 },
+        { CPUDispatch::sse42,     "sse4.2",    SystemStats::hasSSE42 },
+        { CPUDispatch::avx,       "avx",       SystemStats::hasAVX },
+        { CPUDispatch::avx2,      "avx2",      SystemStats::hasAVX2 },
+        { CPUDispatch::avx512f,   "avx512f",   SystemStats::hasAVX512F },
+        { CPUDispatch::sha,       "sha",       SystemStats::hasSHA },
+        { CPUDispatch::pclmulqdq, "pclmulqdq", SystemStats::hasPCLMULQDQ },
+        { CPUDispatch::neon,      "neon",      SystemStats::hasNeon },
+        { CPUDispatch::sve,       "sve",       SystemStats::hasSVE }
+    };
+
+    static uint32 findFeature (const String& name) noexcept
+    {
+        for (auto& f : features)
+            if (name.equalsIgnoreCase (f.name))
+                return (uint32) f.flag;
+
+        return 0;
+    }
+
+    // Parses the format used by the JUCE_CPU_DISPATCH environment variable
+    struct Overrides
+    {
+        explicit Overrides (const String& text)
+        {
+            StringArray items;
+            items.addTokens (text, ", ", "\"");
+            items.removeEmptyStrings();
+
+            for (auto& item : items)
+            {
+                if (item.startsWithChar ('-'))
+                {
+                    auto feature = findFeature (item.substring (1));
+                    jassert (feature != 0); // unknown feature name!
+                    disabledFeatures |= feature;
+                }
+                else if (item.containsChar ('='))
+                {
+                    variants.set (item.upToFirstOccurrenceOf ("=", false, false).trim(),
+                                  item.fromFirstOccurrenceOf ("=", false, false).trim());
+                }
+            }
+        }
+
+        uint32 disabledFeatures = 0;
+        StringPairArray variants;
+    };
+}
+
+//==============================================================================
+struct CPUDispatch::Registry
+{
+    Registry()
+        : detectedFeatures (findDetectedFeatures()),
+          overrides (SystemStats::getEnvironmentVariable ("JUCE_CPU_DISPATCH", {}))
+    {
+    }
+
+    static Registry& getInstance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static uint32 findDetectedFeatures() noexcept
+    {
+        uint32 result = 0;
+
+        for (auto& f : CPUDispatchHelpers::features)
+            if (f.isPresent())
+                result |= (uint32) f.flag;
+
+        return result;
+    }
+
+    FunctionBase* findFunction (const String& name) const noexcept
+    {
+        for (auto* f : functions)
+            if (f->getName() == name)
+                return f;
+
+        return nullptr;
+    }
+
+    const uint32 detectedFeatures;
+    const CPUDispatchHelpers::Overrides overrides;
+
+    CriticalSection lock;
+    Array<FunctionBase*> functions;
+};
+
+//==============================================================================
+uint32 CPUDispatch::getDetectedFeatures() noexcept
+{
+    return Registry::getInstance().detectedFeatures;
+}
+
+uint32 CPUDispatch::getAvailableFeatures() noexcept
+{
+    auto& r = Registry::getInstance();
+    return r.detectedFeatures & ~r.overrides.disabledFeatures;
+}
+
+String CPUDispatch::getFeatureNames (uint32 featureFlags)
+{
+    StringArray names;
+
+    for (auto& f : CPUDispatchHelpers::features)
+        if ((featureFlags & (uint32) f.flag) != 0)
+            names.add (f.name);
+
+    return names.joinIntoString (" ");
+}
+
+StringPairArray CPUDispatch::getSelectedVariants()
+{
+    auto& r = Registry::getInstance();
+    const ScopedLock sl (r.lock);
+
+    StringPairArray result;
+
+    for (auto* f : r.functions)
+        result.set (f->getName(), f->getSelectedVariantName());
+
+    return result;
+}
+
+StringArray CPUDispatch::getVariantNames (const String& functionName)
+{
+    auto& r = Registry::getInstance();
+    const ScopedLock sl (r.lock);
+
+    if (auto* f = r.findFunction (functionName))
+        return f->getVariantNames();
+
+    return {};
+}
+
+bool CPUDispatch::setVariant (const String& functionName, const String& variantName)
+{
+    auto& r = Registry::getInstance();
+    const ScopedLock sl (r.lock);
+
+    if (auto* f = r.findFunction (functionName))
+        return f->setVariant (variantName);
+
+    return false;
+}
+
+//==============================================================================
+CPUDispatch::FunctionBase::FunctionBase (const char* functionName)  : name (functionName)
+{
+}
+
+CPUDispatch::FunctionBase::~FunctionBase()
+{
+    auto& r = Registry::getInstance();
+    const ScopedLock sl (r.lock);
+    r.functions.removeFirstMatchingValue (this);
+}
+
+void CPUDispatch::FunctionBase::addVariant (const char* variantName, uint32 features)
+{
+    variantNames.add (variantName);
+    requiredFeatures.add (features);
+}
+
+bool CPUDispatch::FunctionBase::canUse (int index) const noexcept
+{
+    return (requiredFeatures[index] & ~getAvailableFeatures()) == 0;
+}
+
+void CPUDispatch::FunctionBase::selectInitialVariant()
+{
+    auto& r = Registry::getInstance();
+    auto requestedVariant = r.overrides.variants[name];
+
+    if (requestedVariant.isEmpty() || ! setVariant (requestedVariant))
+    {
+        // a variant was requested that doesn't exist, or can't run on this CPU
+        jassert (requestedVariant.isEmpty());
+
+        for (int i = 0; i < variantNames.size(); ++i)
+        {
+            if (canUse (i))
+            {
+                selectedIndex = i;
+                useVariant (i);
+                break;
+            }
+        }
+    }
+
+    // there must be at least one variant that doesn't need any special features!
+    jassert (selectedIndex >= 0);
+
+    const ScopedLock sl (r.lock);
+    jassert (r.findFunction (name) == nullptr); // each function must have a unique name
+    r.functions.add (this);
+}
+
+String CPUDispatch::FunctionBase::getSelectedVariantName() const
+{
+    return variantNames[selectedIndex];
+}
+
+bool CPUDispatch::FunctionBase::setVariant (const String& variantName)
+{
+    auto index = variantNames.indexOf (variantName, true);
+
+    if (index < 0 || ! canUse (index))
+        return false;
+
+    const ScopedLock sl (Registry::getInstance().lock);
+
+    useVariant (index);
+    selectedIndex = index;
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class CPUDispatchTests  : public UnitTest
+{
+public:
+    CPUDispatchTests() : UnitTest ("CPUDispatch", "System") {}
+
+    static int generic() noexcept    { return 1; }
+    static int fast() noexcept       { return 2; }
+    static int fastest() noexcept    { return 3; }
+
+    void runTest() override
+    {
+        beginTest ("Feature names");
+        {
+            expectEquals (CPUDispatch::getFeatureNames (CPUDispatch::sse2 | CPUDispatch::avx512f), String ("sse2 avx512f"));
+            expectEquals (CPUDispatch::getFeatureNames (0), String());
+            expect ((CPUDispatch::getAvailableFeatures() & ~CPUDispatch::getDetectedFeatures()) == 0);
+            expectEquals (SystemStats::getCpuFeatures(), CPUDispatch::getFeatureNames (CPUDispatch::getDetectedFeatures()));
+        }
+
+        beginTest ("Variant selection");
+        {
+            auto features = CPUDispatch::getAvailableFeatures();
+            auto missingFeature = (features + 1) & ~features;  // the lowest feature that's not available
+
+            using FunctionType = int (*)() noexcept;
+
+            {
+                CPUDispatch::Function<FunctionType> f ("CPUDispatchTest", { { "fastest", missingFeature, fastest },
+                                                                           { "fast",    features,       fast },
+                                                                           { "generic", 0,              generic } });
+
+                expectEquals (f.get()(), 2);
+                expectEquals (f.getSelectedVariantName(), String ("fast"));
+                expectEquals (CPUDispatch::getSelectedVariants()["CPUDispatchTest"], String ("fast"));
+                expect (CPUDispatch::getVariantNames ("CPUDispatchTest") == StringArray ("fastest", "fast", "generic"));
+
+                expect (CPUDispatch::setVariant ("CPUDispatchTest", "generic"));
+                expectEquals (f.get()(), 1);
+                expectEquals (CPUDispatch::getSelectedVariants()["CPUDispatchTest"], String ("generic"));
+
+                expect (! CPUDispatch::setVariant ("CPUDispatchTest", "fastest"));
+                expect (! CPUDispatch::setVariant ("CPUDispatchTest", "nonexistent"));
+                expect (! CPUDispatch::setVariant ("NonexistentFunction", "generic"));
+                expectEquals (f.get()(), 1);
+            }
+
+            expect (! CPUDispatch::getSelectedVariants().containsKey ("CPUDispatchTest"));
+        }
+
+        beginTest ("Parsing overrides");
+        {
+            CPUDispatchHelpers::Overrides o ("-avx512f, SHA256=generic  FloatVectorOperations=avx,-SSE4.1");
+
+            expect (o.disabledFeatures == (uint32) (CPUDispatch::avx512f | CPUDispatch::sse41));
+            expectEquals (o.variants["SHA256"], String ("generic"));
+            expectEquals (o.variants["FloatVectorOperations"], String ("avx"));
+        }
+    }
+};
+
+static CPUDispatchTests cpuDispatchTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A registry of functions which have several implementations for different CPU
+    instruction sets, and which pick the best one at runtime.
+
+    Each dispatched function is declared as a CPUDispatch::Function, with a list of
+    variants in order of preference. Each variant has a name and the set of Feature
+    flags that it needs, and the first one that the CPU supports is used, e.g.
+    @code
+    static float sumGeneric (const float*, int) noexcept;
+    static float sumAVX (const float*, int) noexcept;   // (compiled with AVX enabled)
+
+    static float sum (const float* data, int num) noexcept
+    {
+        static const CPUDispatch::Function<float (*) (const float*, int)> impl ("sum",
+        {
+            { "avx",     CPUDispatch::avx, sumAVX },
+            { "generic", 0,                sumGeneric }
+        });
+
+        return impl.get() (data, num);
+    }
+    @endcode
+
+    The last variant should normally need no features at all, so that there's always
+    one that can be used.
+
+    Each function registers itself the first time it's used, and you can then find out
+    which variant it chose with getSelectedVariants(), or change it with setVariant().
+
+    For comparing the variants in a real application, the choice can also be made
+    with the JUCE_CPU_DISPATCH environment variable. This contains a list of items
+    separated by commas or spaces, where each item is either "functionName=variantName"
+    to choose a variant for one function, or "-featureName" to behave as if the CPU
+    doesn't have that feature, e.g.
+    @code
+    JUCE_CPU_DISPATCH="-avx512f, SHA256=generic"
+    @endcode
+
+    A variant that needs features which the CPU doesn't have will never be chosen.
+
+    @see SystemStats::getCpuFeatures
+*/
+class JUCE_API  CPUDispatch
+{
+public:
+    //==============================================================================
+    /** The CPU features that a variant can depend on. */
+    enum Feature
+    {
+        sse2        = 1 << 0,
+        sse3        = 1 << 1,
+        ssse3       = 1 << 2,
+        sse41       = 1 << 3,
+        sse42       = 1 << 4,
+        avx         = 1 << 5,
+        avx2        = 1 << 6,
+        avx512f     = 1 << 7,
+        sha         = 1 << 8,
+        pclmulqdq   = 1 << 9,
+        neon        = 1 << 10,
+        sve         = 1 << 11
+    };
+
+    /** Returns the Feature flags for everything that the CPU supports. */
+    static uint32 getDetectedFeatures() noexcept;
+
+    /** Returns the Feature flags that variants are allowed to use.
+        This is the same as getDetectedFeatures(), minus anything that has been turned
+        off with the JUCE_CPU_DISPATCH environment variable.
+    */
+    static uint32 getAvailableFeatures() noexcept;
+
+    /** Returns the names of a set of Feature flags, separated by spaces. */
+    static String getFeatureNames (uint32 features);
+
+    //==============================================================================
+    /** Returns the name of each function that has been registered, paired with the
+        name of the variant that it's using.
+    */
+    static StringPairArray getSelectedVariants();
+
+    /** Returns the names of a registered function's variants, in order of preference. */
+    static StringArray getVariantNames (const String& functionName);
+
+    /** Makes a registered function use one of its variants.
+
+        This can be called at any time, and affects all threads.
+
+        @returns false if there's no such function or variant, or if the CPU doesn't
+                 support the variant
+    */
+    static bool setVariant (const String& functionName, const String& variantName);
+
+    //==============================================================================
+    /** The base class for Function, which handles the choice of variant. */
+    class JUCE_API  FunctionBase
+    {
+    public:
+        /** Returns the function's name. */
+        const String& getName() const noexcept              { return name; }
+
+        /** Returns the names of the variants, in order of preference. */
+        const StringArray& getVariantNames() const noexcept { return variantNames; }
+
+        /** Returns the name of the variant that's being used. */
+        String getSelectedVariantName() const;
+
+        /** Changes the variant that's being used.
+            @returns false if there's no such variant, or the CPU doesn't support it
+        */
+        bool setVariant (const String& variantName);
+
+    protected:
+        /** @internal */
+        explicit FunctionBase (const char* functionName);
+        /** @internal */
+        virtual ~FunctionBase();
+
+        /** @internal */
+        void addVariant (const char* variantName, uint32 requiredFeatures);
+        /** Chooses the initial variant and registers the function. @internal */
+        void selectInitialVariant();
+        /** @internal */
+        virtual void useVariant (int index) noexcept = 0;
+
+    private:
+        const String name;
+        StringArray variantNames;
+        Array<uint32> requiredFeatures;
+        std::atomic<int> selectedIndex { -1 };
+
+        bool canUse (int index) const noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (FunctionBase)
+    };
+
+    //==============================================================================
+    /**
+        A function which has several variants for different CPU features.
+
+        The VariantType is usually a function pointer, but can be anything that fits in
+        a std::atomic, e.g. an enum or a bool that chooses between code paths.
+    */
+    template <typename VariantType>
+    class Function  : public FunctionBase
+    {
+    public:
+        /** Describes one of the variants. */
+        struct Variant
+        {
+            const char* name;
+            uint32 requiredFeatures;
+            VariantType value;
+        };
+
+        /** Creates the function and chooses which of the variants to use.
+            The variants must be listed in order of preference, best first.
+        */
+        Function (const char* functionName, std::initializer_list<Variant> variantsInOrderOfPreference)
+            : FunctionBase (functionName)
+        {
+            for (auto& v : variantsInOrderOfPreference)
+            {
+                addVariant (v.name, v.requiredFeatures);
+                values.add (v.value);
+            }
+
+            selectInitialVariant();
+        }
+
+        /** Returns the variant that's being used. */
+        VariantType get() const noexcept        { return current.load (std::memory_order_relaxed); }
+
+    private:
+        Array<VariantType> values;
+        std::atomic<VariantType> current;
+
+        void useVariant (int index) noexcept override   { current = values.getReference (index); }
+
+        JUCE_DECLARE_NON_COPYABLE (Function)
+    };
+
+private:
+    struct Registry;
+
+    CPUDispatch() = delete;
+};
+
+} // namespace juce
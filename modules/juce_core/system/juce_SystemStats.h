@@ -171,7 +171,18 @@ public:
     static bool hasSSE42() noexcept;  /**< Returns true if Intel SSE4.2 instructions are available. */
     static bool hasAVX() noexcept;    /**< Returns true if Intel AVX instructions are available. */
     static bool hasAVX2() noexcept;   /**< Returns true if Intel AVX2 instructions are available. */
+    static bool hasAVX512F() noexcept; /**< Returns true if Intel AVX-512 Foundation instructions are available. */
+    static bool hasSHA() noexcept;    /**< Returns true if the SHA-256 instructions are available (Intel SHA extensions, or the ARMv8 SHA2 instructions). */
+    static bool hasPCLMULQDQ() noexcept; /**< Returns true if the Intel carry-less multiply instruction (PCLMULQDQ) is available. */
     static bool hasNeon() noexcept;   /**< Returns true if ARM NEON instructions are available. */
+    static bool hasSVE() noexcept;    /**< Returns true if ARM SVE (Scalable Vector Extension) instructions are available. */
+
+    /** Returns a list of the CPU's instruction set extensions, separated by spaces.
+        This only includes the ones that have a has...() method here, so is mainly useful
+        for logging, e.g. to see which code paths CPUDispatch is able to choose.
+        @see CPUDispatch
+    */
+    static String getCpuFeatures();
 
     //==============================================================================
     /** Finds out how much RAM is in the machine.
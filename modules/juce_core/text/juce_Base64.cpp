@@ -23,48 +23,167 @@
 namespace juce
 {
 
-bool Base64::convertToBase64 (OutputStream& base64Result, const void* sourceData, size_t sourceDataSize)
+namespace Base64Helpers
 {
-    static const char lookup[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    auto* source = static_cast<const uint8*> (sourceData);
+    static const char encodingTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-    while (sourceDataSize > 0)
+    enum : uint8
     {
-        char frame[4];
-        auto byte0 = *source++;
-        frame[0] = lookup [(byte0 & 0xfcu) >> 2];
-        uint32 bits = (byte0 & 0x03u) << 4;
+        invalidChar = 0xff,
+        paddingChar = 0xfe
+    };
 
-        if (sourceDataSize > 1)
+    struct DecodingTable
+    {
+        DecodingTable() noexcept
         {
-            auto byte1 = *source++;
-            frame[1] = lookup[bits | ((byte1 & 0xf0u) >> 4)];
-            bits = (byte1 & 0x0fu) << 2;
+            memset (values, invalidChar, sizeof (values));
 
-            if (sourceDataSize > 2)
-            {
-                auto byte2 = *source++;
-                frame[2] = lookup[bits | ((byte2 & 0xc0u) >> 6)];
-                frame[3] = lookup[byte2 & 0x3fu];
-                sourceDataSize -= 3;
-            }
-            else
-            {
-                frame[2] = lookup[bits];
-                frame[3] = '=';
-                sourceDataSize = 0;
-            }
+            for (int i = 0; i < 64; ++i)
+                values[(uint8) encodingTable[i]] = (uint8) i;
+
+            values[(uint8) '='] = paddingChar;
         }
-        else
+
+        uint8 values[256];
+    };
+
+    template <typename CharType>
+    static inline uint8 getCharValue (const uint8* table, CharType c) noexcept
+    {
+        auto index = (uint32) (typename std::make_unsigned<CharType>::type) c;
+        return index < 256 ? table[index] : (uint8) invalidChar;
+    }
+
+    static const uint8* getDecodingTable() noexcept
+    {
+        static const DecodingTable table;
+        return table.values;
+    }
+
+    // Encodes as many whole 3-byte groups as there are, and returns the number of bytes used
+    static size_t encodeGroups (const uint8* source, size_t numBytes, char* dest) noexcept
+    {
+        auto numGroups = numBytes / 3;
+
+        for (size_t i = 0; i < numGroups; ++i)
         {
-            frame[1] = lookup[bits];
-            frame[2] = '=';
-            frame[3] = '=';
-            sourceDataSize = 0;
+            auto bits = ((uint32) source[0] << 16) | ((uint32) source[1] << 8) | source[2];
+            dest[0] = encodingTable[bits >> 18];
+            dest[1] = encodingTable[(bits >> 12) & 63];
+            dest[2] = encodingTable[(bits >> 6) & 63];
+            dest[3] = encodingTable[bits & 63];
+            source += 3;
+            dest += 4;
         }
 
-        if (! base64Result.write (frame, 4))
+        return numGroups * 3;
+    }
+
+    // Encodes the last 1 or 2 bytes of the data as a padded 4-character frame
+    static void encodeFinalGroup (const uint8* source, size_t numBytes, char* dest) noexcept
+    {
+        jassert (numBytes == 1 || numBytes == 2);
+
+        auto bits = ((uint32) source[0] << 16) | (numBytes > 1 ? ((uint32) source[1] << 8) : 0);
+        dest[0] = encodingTable[bits >> 18];
+        dest[1] = encodingTable[(bits >> 12) & 63];
+        dest[2] = numBytes > 1 ? encodingTable[(bits >> 6) & 63] : '=';
+        dest[3] = '=';
+    }
+
+    // Decodes 4-character groups until it reaches one that contains padding or anything
+    // that isn't a base-64 character, and returns the number of characters used
+    template <typename CharType>
+    static size_t decodeGroups (const CharType* source, size_t numChars, uint8* dest) noexcept
+    {
+        auto* table = getDecodingTable();
+        size_t i = 0;
+
+        for (; i + 4 <= numChars; i += 4)
+        {
+            auto a = getCharValue (table, source[i]);
+            auto b = getCharValue (table, source[i + 1]);
+            auto c = getCharValue (table, source[i + 2]);
+            auto d = getCharValue (table, source[i + 3]);
+
+            if (((a | b | c | d) & 0xc0) != 0)
+                break;
+
+            auto bits = ((uint32) a << 18) | ((uint32) b << 12) | ((uint32) c << 6) | d;
+            dest[0] = (uint8) (bits >> 16);
+            dest[1] = (uint8) (bits >> 8);
+            dest[2] = (uint8) bits;
+            dest += 3;
+        }
+
+        return i;
+    }
+
+    // Decodes a single group which may be padded. Returns the number of bytes produced,
+    // or -1 if the group isn't valid.
+    template <typename CharType>
+    static int decodeFinalGroup (const CharType* source, size_t numChars, uint8* dest) noexcept
+    {
+        auto* table = getDecodingTable();
+        uint8 data[4];
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            auto c = i < numChars ? getCharValue (table, source[i]) : (uint8) invalidChar;
+
+            if (c == invalidChar)
+                return -1;
+
+            if (c == paddingChar)
+            {
+                if (i <= 1)
+                    return -1;
+
+                c = 64;
+            }
+
+            data[i] = c;
+        }
+
+        dest[0] = (uint8) ((data[0] << 2) | (data[1] >> 4));
+
+        if (data[2] >= 64)
+            return 1;
+
+        dest[1] = (uint8) ((data[1] << 4) | (data[2] >> 2));
+
+        if (data[3] >= 64)
+            return 2;
+
+        dest[2] = (uint8) ((data[2] << 6) | data[3]);
+        return 3;
+    }
+}
+
+//==============================================================================
+bool Base64::convertToBase64 (OutputStream& base64Result, const void* sourceData, size_t sourceDataSize)
+{
+    using namespace Base64Helpers;
+
+    auto* source = static_cast<const uint8*> (sourceData);
+    char buffer[4096];
+
+    while (sourceDataSize >= 3)
+    {
+        auto numDone = encodeGroups (source, jmin (sourceDataSize, sizeof (buffer) / 4 * 3), buffer);
+
+        if (! base64Result.write (buffer, numDone / 3 * 4))
             return false;
+
+        source += numDone;
+        sourceDataSize -= numDone;
+    }
+
+    if (sourceDataSize > 0)
+    {
+        encodeFinalGroup (source, sourceDataSize, buffer);
+        return base64Result.write (buffer, 4);
     }
 
     return true;
@@ -72,34 +191,32 @@ bool Base64::convertToBase64 (OutputStream& base64Result, const void* sourceData
 
 bool Base64::convertFromBase64 (OutputStream& binaryOutput, StringRef base64TextInput)
 {
-    for (auto s = base64TextInput.text; ! s.isEmpty();)
+    using namespace Base64Helpers;
+
+    auto* text = base64TextInput.text.getAddress();
+    auto numChars = base64TextInput.text.sizeInBytes() / sizeof (*text) - 1;
+    uint8 buffer[3072];
+
+    for (size_t pos = 0; pos < numChars;)
     {
-        uint8 data[4];
+        auto numDone = decodeGroups (text + pos, jmin (numChars - pos, sizeof (buffer) / 3 * 4), buffer);
 
-        for (int i = 0; i < 4; ++i)
+        if (numDone > 0)
         {
-            auto c = (uint32) s.getAndAdvance();
-
-            if (c >= 'A' && c <= 'Z')         c -= 'A';
-            else if (c >= 'a' && c <= 'z')    c -= 'a' - 26;
-            else if (c >= '0' && c <= '9')    c += 52 - '0';
-            else if (c == '+')                c = 62;
-            else if (c == '/')                c = 63;
-            else if (c == '=')                { c = 64; if (i <= 1) return false; }
-            else                              return false;
+            if (! binaryOutput.write (buffer, numDone / 4 * 3))
+                return false;
 
-            data[i] = (uint8) c;
+            pos += numDone;
+            continue;
         }
 
-        binaryOutput.writeByte ((char) ((data[0] << 2) | (data[1] >> 4)));
+        // the next group is padded, incomplete or contains a bad character
+        auto numBytes = decodeFinalGroup (text + pos, numChars - pos, buffer);
 
-        if (data[2] < 64)
-        {
-            binaryOutput.writeByte ((char) ((data[1] << 4) | (data[2] >> 2)));
+        if (numBytes < 0 || ! binaryOutput.write (buffer, (size_t) numBytes))
+            return false;
 
-            if (data[3] < 64)
-                binaryOutput.writeByte ((char) ((data[2] << 6) | data[3]));
-        }
+        pos += 4;
     }
 
     return true;
@@ -119,6 +236,227 @@ String Base64::toBase64 (const String& text)
     return toBase64 (text.toRawUTF8(), strlen (text.toRawUTF8()));
 }
 
+//==============================================================================
+Base64EncodingOutputStream::Base64EncodingOutputStream (OutputStream* destStream, bool deleteDestStreamWhenDestroyed)
+   : destination (destStream, deleteDestStreamWhenDestroyed)
+{
+    jassert (destStream != nullptr);
+}
+
+Base64EncodingOutputStream::Base64EncodingOutputStream (OutputStream& destStream)
+   : destination (&destStream, false)
+{
+}
+
+Base64EncodingOutputStream::~Base64EncodingOutputStream()
+{
+    flush();
+}
+
+void Base64EncodingOutputStream::flush()
+{
+    if (! isFinished)
+    {
+        if (numPending > 0)
+        {
+            char frame[4];
+            Base64Helpers::encodeFinalGroup (pending, numPending, frame);
+            destination->write (frame, 4);
+            numPending = 0;
+        }
+
+        isFinished = true;
+    }
+
+    destination->flush();
+}
+
+int64 Base64EncodingOutputStream::getPosition()
+{
+    return numBytesWritten;
+}
+
+bool Base64EncodingOutputStream::setPosition (int64)
+{
+    return false;
+}
+
+bool Base64EncodingOutputStream::write (const void* data, size_t numBytes)
+{
+    using namespace Base64Helpers;
+
+    // Once the stream has been flushed, the encoding is finished and you can't add any more data!
+    jassert (! isFinished);
+
+    if (isFinished)
+        return false;
+
+    auto* sourceData = static_cast<const uint8*> (data);
+    numBytesWritten += (int64) numBytes;
+    char buffer[4096];
+
+    if (numPending > 0)
+    {
+        while (numPending < 3 && numBytes > 0)
+        {
+            pending[numPending++] = *sourceData++;
+            --numBytes;
+        }
+
+        if (numPending < 3)
+            return true;
+
+        encodeGroups (pending, 3, buffer);
+        numPending = 0;
+
+        if (! destination->write (buffer, 4))
+            return false;
+    }
+
+    while (numBytes >= 3)
+    {
+        auto numDone = encodeGroups (sourceData, jmin (numBytes, sizeof (buffer) / 4 * 3), buffer);
+
+        if (! destination->write (buffer, numDone / 3 * 4))
+            return false;
+
+        sourceData += numDone;
+        numBytes -= numDone;
+    }
+
+    memcpy (pending, sourceData, numBytes);
+    numPending = numBytes;
+    return true;
+}
+
+//==============================================================================
+Base64DecodingInputStream::Base64DecodingInputStream (InputStream* sourceStream, bool deleteSourceWhenDestroyed)
+   : source (sourceStream, deleteSourceWhenDestroyed),
+     originalSourcePos (sourceStream->getPosition())
+{
+}
+
+Base64DecodingInputStream::Base64DecodingInputStream (InputStream& sourceStream)
+   : Base64DecodingInputStream (&sourceStream, false)
+{
+}
+
+Base64DecodingInputStream::~Base64DecodingInputStream()
+{
+}
+
+bool Base64DecodingInputStream::decodeNextBlock()
+{
+    using namespace Base64Helpers;
+
+    decodedPos = 0;
+    decodedSize = 0;
+
+    if (failed)
+        return false;
+
+    // top up the text buffer, leaving out any whitespace
+    while (! sourceFinished && numTextChars < sizeof (text))
+    {
+        auto numRead = source->read (text + numTextChars, (int) (sizeof (text) - numTextChars));
+
+        if (numRead <= 0)
+        {
+            sourceFinished = true;
+            break;
+        }
+
+        auto* d = text + numTextChars;
+
+        for (auto* s = d; s < text + numTextChars + (size_t) numRead; ++s)
+            if (! CharacterFunctions::isWhitespace (*s))
+                *d++ = *s;
+
+        numTextChars = (size_t) (d - text);
+    }
+
+    if (numTextChars == 0)
+        return false;
+
+    auto numUsed = decodeGroups (text, numTextChars, decoded);
+    decodedSize = numUsed / 4 * 3;
+
+    if (numUsed == 0)
+    {
+        // the next group is padded, incomplete or contains a bad character
+        auto numBytes = decodeFinalGroup (text, numTextChars, decoded);
+
+        if (numBytes < 0)
+        {
+            failed = true;
+            numTextChars = 0;
+            return false;
+        }
+
+        decodedSize = (size_t) numBytes;
+        numUsed = 4;
+    }
+
+    numTextChars -= numUsed;
+    memmove (text, text + numUsed, numTextChars);
+    return true;
+}
+
+int64 Base64DecodingInputStream::getTotalLength()
+{
+    return -1;
+}
+
+bool Base64DecodingInputStream::isExhausted()
+{
+    return decodedPos == decodedSize && ! decodeNextBlock();
+}
+
+int Base64DecodingInputStream::read (void* destBuffer, int maxBytesToRead)
+{
+    auto* dest = static_cast<uint8*> (destBuffer);
+    int numRead = 0;
+
+    while (numRead < maxBytesToRead)
+    {
+        if (decodedPos == decodedSize && ! decodeNextBlock())
+            break;
+
+        auto numToCopy = jmin ((size_t) (maxBytesToRead - numRead), decodedSize - decodedPos);
+        memcpy (dest + numRead, decoded + decodedPos, numToCopy);
+        decodedPos += numToCopy;
+        numRead += (int) numToCopy;
+    }
+
+    currentPos += numRead;
+    return numRead;
+}
+
+int64 Base64DecodingInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool Base64DecodingInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, we have to start decoding again from the beginning
+        if (! source->setPosition (originalSourcePos))
+            return false;
+
+        currentPos = 0;
+        numTextChars = 0;
+        decodedPos = 0;
+        decodedSize = 0;
+        sourceFinished = false;
+        failed = false;
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -154,6 +492,103 @@ public:
             auto result = out.getMemoryBlock();
             expect (result == original);
         }
+
+        beginTest ("MemoryBlock encoding");
+        {
+            static const char table[] = ".ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+";
+
+            for (int i = 200; --i >= 0;)
+            {
+                auto original = createRandomData (r);
+
+                // this is the bit-by-bit version of the format, which the encoded text must still match
+                String expected (original.getSize());
+                expected << '.';
+
+                for (size_t j = 0; j < (original.getSize() * 8 + 5) / 6; ++j)
+                    expected << table[original.getBitRange (j * 6, 6)];
+
+                expectEquals (original.toBase64Encoding(), expected);
+
+                MemoryBlock result;
+                expect (result.fromBase64Encoding (expected));
+                expect (result == original);
+            }
+        }
+
+        beginTest ("Reference values and invalid text");
+        {
+            expectEquals (Base64::toBase64 ("f"), String ("Zg=="));
+            expectEquals (Base64::toBase64 ("fo"), String ("Zm8="));
+            expectEquals (Base64::toBase64 ("foobar"), String ("Zm9vYmFy"));
+
+            MemoryOutputStream out;
+            expect (Base64::convertFromBase64 (out, "Zm9vYg==Zm8="));
+            expectEquals (out.toString(), String ("foobfo"));
+
+            for (auto bad : { "Zm9", "Z===", "Zm9v!mFy", "Zm 9vYmFy" })
+            {
+                MemoryOutputStream m;
+                expect (! Base64::convertFromBase64 (m, bad));
+            }
+        }
+
+        beginTest ("Streams");
+        {
+            for (int i = 100; --i >= 0;)
+            {
+                auto original = createRandomData (r);
+
+                for (int extra = r.nextInt (25); --extra >= 0;)
+                {
+                    auto more = createRandomData (r);
+                    original.append (more.getData(), more.getSize());
+                }
+                auto expected = Base64::toBase64 (original.getData(), original.getSize());
+
+                MemoryOutputStream text;
+
+                {
+                    Base64EncodingOutputStream encoder (text);
+
+                    for (size_t pos = 0; pos < original.getSize();)
+                    {
+                        auto num = jmin (original.getSize() - pos, (size_t) r.nextInt (5000));
+                        expect (encoder.write (addBytesToPointer (original.getData(), pos), num));
+                        pos += num;
+                    }
+
+                    expectEquals (encoder.getPosition(), (int64) original.getSize());
+                }
+
+                expectEquals (text.toString(), expected);
+
+                // split the text into lines, which the decoder should ignore
+                StringArray lines;
+
+                for (int start = 0; start < expected.length(); start += 76)
+                    lines.add (expected.substring (start, start + 76));
+
+                auto multiLineText = lines.joinIntoString ("\r\n");
+                MemoryInputStream in (multiLineText.toRawUTF8(), multiLineText.getNumBytesAsUTF8(), false);
+                Base64DecodingInputStream decoder (in);
+                MemoryBlock decoded;
+                expectEquals ((size_t) decoder.readIntoMemoryBlock (decoded), original.getSize());
+                expect (decoded == original);
+                expect (decoder.isExhausted() && ! decoder.hasFailed());
+
+                if (original.getSize() > 10)
+                {
+                    expect (decoder.setPosition (5));
+                    expectEquals ((int) decoder.readByte(), (int) (char) original[5]);
+                }
+            }
+
+            MemoryInputStream bad ("Zm9vYmFy$Zm9v", 13, false);
+            Base64DecodingInputStream decoder (bad);
+            expectEquals (decoder.readEntireStreamAsString(), String ("foobar"));
+            expect (decoder.hasFailed());
+        }
     }
 };
 
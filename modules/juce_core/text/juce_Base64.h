@@ -48,4 +48,123 @@ struct JUCE_API Base64
     static String toBase64 (const String& textToEncode);
 };
 
+//==============================================================================
+/**
+    An OutputStream which converts the data written to it into base-64 text, and
+    writes that text to another stream.
+
+    This lets you encode large amounts of data (e.g. a big plugin state, or a file)
+    without having to hold the whole thing in memory first. The text is the same as
+    Base64::convertToBase64() would produce for the same data.
+
+    Because the final group of characters may need padding, the encoding can't be
+    completed until all the data has been written. So, like the GZIPCompressorOutputStream,
+    calling flush() finishes the encoding, and you can't write any more data afterwards.
+    This is done automatically when the stream is deleted.
+
+    @see Base64, Base64DecodingInputStream
+*/
+class JUCE_API  Base64EncodingOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates an encoder which writes its text to another stream.
+
+        @param destStream                   the stream to write the base-64 text to
+        @param deleteDestStreamWhenDestroyed whether the destStream should be deleted
+                                            when this object is deleted
+    */
+    Base64EncodingOutputStream (OutputStream* destStream, bool deleteDestStreamWhenDestroyed);
+
+    /** Creates an encoder which writes its text to another stream.
+        The destination stream must not be deleted until this object has been destroyed.
+    */
+    Base64EncodingOutputStream (OutputStream& destStream);
+
+    /** Destructor. */
+    ~Base64EncodingOutputStream();
+
+    //==============================================================================
+    /** Writes any remaining data with its padding, and flushes the destination stream.
+        Once this has been called, no more data can be written to this stream.
+    */
+    void flush() override;
+
+    /** Returns the number of bytes of binary data that have been written to this stream. */
+    int64 getPosition() override;
+
+    /** This type of stream can't be repositioned, so this always returns false. */
+    bool setPosition (int64) override;
+
+    bool write (const void*, size_t) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destination;
+    uint8 pending[3];
+    size_t numPending = 0;
+    int64 numBytesWritten = 0;
+    bool isFinished = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Base64EncodingOutputStream)
+};
+
+//==============================================================================
+/**
+    An InputStream which reads base-64 text from another stream, and returns the
+    binary data that it decodes.
+
+    Any whitespace and line-breaks in the text are ignored, so it can be used to read
+    base-64 that has been split into lines. If the text contains anything else that
+    isn't valid base-64, the stream stops at that point, and hasFailed() will return true.
+
+    @see Base64, Base64EncodingOutputStream
+*/
+class JUCE_API  Base64DecodingInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decoder which reads its text from another stream.
+
+        @param sourceStream                 the stream to read the base-64 text from
+        @param deleteSourceWhenDestroyed    whether the sourceStream should be deleted
+                                            when this object is deleted
+    */
+    Base64DecodingInputStream (InputStream* sourceStream, bool deleteSourceWhenDestroyed);
+
+    /** Creates a decoder which reads its text from another stream.
+        The source stream must not be deleted until this object has been destroyed.
+    */
+    Base64DecodingInputStream (InputStream& sourceStream);
+
+    /** Destructor. */
+    ~Base64DecodingInputStream();
+
+    //==============================================================================
+    /** Returns true if the stream was stopped by some text that isn't valid base-64. */
+    bool hasFailed() const noexcept             { return failed; }
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void*, int) override;
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> source;
+    const int64 originalSourcePos;
+    int64 currentPos = 0;
+    char text[4096];
+    size_t numTextChars = 0;
+    uint8 decoded[3072];
+    size_t decodedPos = 0, decodedSize = 0;
+    bool sourceFinished = false, failed = false;
+
+    bool decodeNextBlock();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Base64DecodingInputStream)
+};
+
 } // namespace juce
@@ -29,9 +29,10 @@ namespace juce
 
     Comparing two Identifier objects is very fast (an O(1) operation), but creating
     them can be slower than just using a String directly, so the optimal way to use them
-    is to keep some static Identifier objects for the things you use often.
+    is to keep some static Identifier objects for the things you use often
+    (the JUCE_IDENTIFIER macro is a quick way to make one).
 
-    @see NamedValueSet, ValueTree
+    @see NamedValueSet, ValueTree, JUCE_IDENTIFIER
 */
 class JUCE_API  Identifier  final
 {
@@ -127,4 +128,21 @@ private:
     String name;
 };
 
+//==============================================================================
+/** Returns a static Identifier for a string literal.
+
+    Creating an Identifier means looking up its name in the global StringPool, so
+    if you write Identifier ("foo") in code that runs often, the same lookup gets done
+    over and over again. This macro only does the lookup the first time that the line
+    of code is run, and after that just returns a reference to the same Identifier, e.g.
+    @code
+    auto gain = tree[JUCE_IDENTIFIER ("gain")];
+    @endcode
+
+    The argument has to be a string literal (or some other constant expression),
+    because it's only evaluated once.
+*/
+#define JUCE_IDENTIFIER(stringLiteral) \
+    ([]() -> const juce::Identifier& { static const juce::Identifier staticIdentifier (stringLiteral); return staticIdentifier; }())
+
 } // namespace juce
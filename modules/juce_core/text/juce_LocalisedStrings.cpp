@@ -30,13 +30,23 @@ LocalisedStrings::LocalisedStrings (const String& fileContents, bool ignoreCase)
 
 LocalisedStrings::LocalisedStrings (const File& fileToLoad, bool ignoreCase)
 {
+    {
+        MemoryMappedFile mappedFile (fileToLoad, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() != nullptr
+             && loadFromBinaryData (mappedFile.getData(), mappedFile.getSize(), ignoreCase))
+            return;
+    }
+
     loadFromText (fileToLoad.loadFileAsString(), ignoreCase);
 }
 
 LocalisedStrings::LocalisedStrings (const LocalisedStrings& other)
     : languageName (other.languageName), countryCodes (other.countryCodes),
-      translations (other.translations), fallback (createCopyIfNotNull (other.fallback.get()))
+      translations (other.translations), ignoresCase (other.ignoresCase),
+      fallback (createCopyIfNotNull (other.fallback.get()))
 {
+    rebuildLookupTable();
 }
 
 LocalisedStrings& LocalisedStrings::operator= (const LocalisedStrings& other)
@@ -44,7 +54,9 @@ LocalisedStrings& LocalisedStrings::operator= (const LocalisedStrings& other)
     languageName = other.languageName;
     countryCodes = other.countryCodes;
     translations = other.translations;
+    ignoresCase = other.ignoresCase;
     fallback = createCopyIfNotNull (other.fallback.get());
+    rebuildLookupTable();
     return *this;
 }
 
@@ -55,18 +67,55 @@ LocalisedStrings::~LocalisedStrings()
 //==============================================================================
 String LocalisedStrings::translate (const String& text) const
 {
-    if (fallback != nullptr && ! translations.containsKey (text))
-        return fallback->translate (text);
+    if (auto* result = findTranslation (text))
+        return *result;
 
-    return translations.getValue (text, text);
+    return text;
 }
 
 String LocalisedStrings::translate (const String& text, const String& resultIfNotFound) const
 {
-    if (fallback != nullptr && ! translations.containsKey (text))
-        return fallback->translate (text, resultIfNotFound);
+    if (auto* result = findTranslation (text))
+        return *result;
+
+    return resultIfNotFound;
+}
+
+const String* LocalisedStrings::findTranslation (const String& text) const
+{
+    for (auto* strings = this; strings != nullptr; strings = strings->fallback)
+    {
+        if (auto* result = strings->lookupTable.find ({ text, strings->ignoresCase }))
+            return result;
+    }
+
+    return nullptr;
+}
+
+void LocalisedStrings::rebuildLookupTable()
+{
+    auto& keys   = translations.getAllKeys();
+    auto& values = translations.getAllValues();
+
+    lookupTable.clear();
+    lookupTable.reserve (keys.size());
+
+    for (int i = 0; i < keys.size(); ++i)
+        lookupTable.set ({ keys[i], ignoresCase }, values[i]);
+}
+
+int LocalisedStrings::LookupKeyHash::generateHash (const LookupKey& key, int upperLimit) noexcept
+{
+    uint32 result = 0;
+
+    for (auto t = key.text.getCharPointer(); ! t.isEmpty();)
+    {
+        auto c = t.getAndAdvance();
+        // (this must fold case in the same way as String::equalsIgnoreCase)
+        result = result * 31u + (uint32) (key.ignoreCase ? CharacterFunctions::toUpperCase (c) : c);
+    }
 
-    return translations.getValue (text, resultIfNotFound);
+    return (int) (result % (uint32) upperLimit);
 }
 
 namespace
@@ -118,13 +167,105 @@ namespace
                 .replace ("\\r", "\r")
                 .replace ("\\n", "\n");
     }
+
+    /*  The binary format is the magic number, the number of translations as a
+        little-endian int32, then a sequence of null-terminated UTF-8 strings: the
+        language name, the space-separated country codes, and then each original
+        string followed by its translation.
+    */
+    static const char binaryFileMagic[] = { 'J', 'T', 'R', '1' };
+
+    struct BinaryStringReader
+    {
+        BinaryStringReader (const void* data, size_t size) noexcept
+            : position (static_cast<const char*> (data)), end (position + size) {}
+
+        bool read (String& result)
+        {
+            for (auto* p = position; p < end; ++p)
+            {
+                if (*p == 0)
+                {
+                    result = String (CharPointer_UTF8 (position), CharPointer_UTF8 (p));
+                    position = p + 1;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        const char* position;
+        const char* const end;
+    };
+}
+
+bool LocalisedStrings::loadFromBinaryData (const void* data, size_t size, bool ignoreCase)
+{
+    const size_t headerSize = sizeof (binaryFileMagic) + sizeof (int32);
+
+    if (size < headerSize || memcmp (data, binaryFileMagic, sizeof (binaryFileMagic)) != 0)
+        return false;
+
+    auto numStrings = (int) ByteOrder::littleEndianInt (addBytesToPointer (data, sizeof (binaryFileMagic)));
+    BinaryStringReader reader (addBytesToPointer (data, headerSize), size - headerSize);
+    String countries;
+
+    if (numStrings < 0 || ! (reader.read (languageName) && reader.read (countries)))
+        return false;
+
+    countryCodes.addTokens (countries, true);
+    countryCodes.removeEmptyStrings();
+
+    StringArray keys, values;
+    keys.ensureStorageAllocated (numStrings);
+    values.ensureStorageAllocated (numStrings);
+
+    for (int i = 0; i < numStrings; ++i)
+    {
+        String key, value;
+
+        if (! (reader.read (key) && reader.read (value)))
+        {
+            jassertfalse; // this file is truncated or corrupt!
+            break;
+        }
+
+        keys.add (key);
+        values.add (value);
+    }
+
+    translations.setIgnoresCase (ignoreCase);
+    ignoresCase = ignoreCase;
+    translations.addArray (keys, values);
+
+    rebuildLookupTable();
+    return true;
+}
+
+bool LocalisedStrings::saveAsBinaryFile (const File& file) const
+{
+    MemoryOutputStream out;
+    out.write (binaryFileMagic, sizeof (binaryFileMagic));
+    out.writeInt (translations.size());
+    out.writeString (languageName);
+    out.writeString (countryCodes.joinIntoString (" "));
+
+    for (int i = 0; i < translations.size(); ++i)
+    {
+        out.writeString (translations.getAllKeys()[i]);
+        out.writeString (translations.getAllValues()[i]);
+    }
+
+    return file.replaceWithData (out.getData(), out.getDataSize());
 }
 
 void LocalisedStrings::loadFromText (const String& fileContents, bool ignoreCase)
 {
     translations.setIgnoresCase (ignoreCase);
+    ignoresCase = ignoreCase;
 
-    StringArray lines;
+    StringArray lines, keys, values;
     lines.addLines (fileContents);
 
     for (auto& l : lines)
@@ -143,7 +284,10 @@ void LocalisedStrings::loadFromText (const String& fileContents, bool ignoreCase
                 auto newText = unescapeString (line.substring (openingQuote + 1, closeQuote));
 
                 if (newText.isNotEmpty())
-                    translations.set (originalText, newText);
+                {
+                    keys.add (originalText);
+                    values.add (newText);
+                }
             }
         }
         else if (line.startsWithIgnoreCase ("language:"))
@@ -158,7 +302,9 @@ void LocalisedStrings::loadFromText (const String& fileContents, bool ignoreCase
         }
     }
 
+    translations.addArray (keys, values);
     translations.minimiseStorageOverheads();
+    rebuildLookupTable();
 }
 
 void LocalisedStrings::addStrings (const LocalisedStrings& other)
@@ -167,6 +313,7 @@ void LocalisedStrings::addStrings (const LocalisedStrings& other)
     jassert (countryCodes == other.countryCodes);
 
     translations.addArray (other.translations);
+    rebuildLookupTable();
 }
 
 void LocalisedStrings::setFallback (LocalisedStrings* f)
@@ -203,4 +350,103 @@ JUCE_API String translate (const String& text, const String& resultIfNotFound)
     return resultIfNotFound;
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LocalisedStringsTests  : public UnitTest
+{
+public:
+    LocalisedStringsTests() : UnitTest ("LocalisedStrings", "Text") {}
+
+    void runTest() override
+    {
+        const String text ("language: French\n"
+                           "countries: fr be\n"
+                           "\"hello\" = \"bonjour\"\n"
+                           "// a comment\n"
+                           "\"goodbye\" = \"au revoir\"\n"
+                           "\"a \\\"quote\\\"\" = \"une \\\"citation\\\"\"\n"
+                           "\"Hello\" = \"salut\"\n");
+
+        beginTest ("Parsing");
+        {
+            LocalisedStrings strings (text, false);
+
+            expectEquals (strings.getLanguageName(), String ("French"));
+            expect (strings.getCountryCodes() == StringArray ("fr", "be"));
+            expectEquals (strings.getMappings().size(), 4);
+            expectEquals (strings.translate ("hello"), String ("bonjour"));
+            expectEquals (strings.translate ("Hello"), String ("salut"));
+            expectEquals (strings.translate ("a \"quote\""), String ("une \"citation\""));
+            expectEquals (strings.translate ("missing"), String ("missing"));
+            expectEquals (strings.translate ("missing", "x"), String ("x"));
+        }
+
+        beginTest ("Ignoring case");
+        {
+            LocalisedStrings strings (text, true);
+
+            expectEquals (strings.getMappings().size(), 3);
+            expectEquals (strings.translate ("HELLO"), String ("salut"));
+            expectEquals (strings.translate ("GoodBye"), String ("au revoir"));
+        }
+
+        beginTest ("Fallback");
+        {
+            LocalisedStrings strings (text, false);
+            strings.setFallback (new LocalisedStrings ("\"extra\" = \"en plus\"\n\"hello\" = \"allo\"", false));
+
+            expectEquals (strings.translate ("hello"), String ("bonjour"));
+            expectEquals (strings.translate ("extra"), String ("en plus"));
+
+            LocalisedStrings copy (strings);
+            expectEquals (copy.translate ("extra"), String ("en plus"));
+        }
+
+        beginTest ("Adding strings");
+        {
+            LocalisedStrings strings (text, false);
+            String extra ("language: French\ncountries: fr be\n");
+
+            for (int i = 0; i < 1000; ++i)
+                extra << "\"key" << i << "\" = \"value" << i << "\"\n";
+
+            extra << "\"hello\" = \"allo\"\n";
+            strings.addStrings (LocalisedStrings (extra, false));
+
+            expectEquals (strings.getMappings().size(), 1004);
+            expectEquals (strings.translate ("hello"), String ("allo"));
+            expectEquals (strings.translate ("key567"), String ("value567"));
+        }
+
+        beginTest ("Binary files");
+        {
+            LocalisedStrings strings (text, false);
+            auto file = File::createTempFile ("translations");
+
+            expect (strings.saveAsBinaryFile (file));
+
+            LocalisedStrings loaded (file, false);
+            expectEquals (loaded.getLanguageName(), String ("French"));
+            expect (loaded.getCountryCodes() == strings.getCountryCodes());
+            expect (loaded.getMappings() == strings.getMappings());
+            expectEquals (loaded.translate ("a \"quote\""), String ("une \"citation\""));
+
+            LocalisedStrings loadedIgnoringCase (file, true);
+            expectEquals (loadedIgnoringCase.translate ("GOODBYE"), String ("au revoir"));
+
+            file.replaceWithText (text);
+            expectEquals (LocalisedStrings (file, false).translate ("goodbye"), String ("au revoir"));
+
+            file.deleteFile();
+        }
+    }
+};
+
+static LocalisedStringsTests localisedStringsTests;
+
+#endif
+
 } // namespace juce
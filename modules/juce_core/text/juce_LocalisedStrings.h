@@ -54,6 +54,11 @@ namespace juce
     if the first non-whitespace character on a line isn't a quote, then it's ignored,
     (you can use this to add comments).
 
+    Looking up a string uses a hash table, so it's quick even for very large sets of
+    translations. For big translation files, you can also use saveAsBinaryFile() to
+    create a pre-parsed version, which the File constructor will load much faster
+    than the text format.
+
     Note that this is a singleton class, so don't create or destroy the object directly.
     There's also a TRANS(text) macro defined to make it easy to use the this.
 
@@ -79,6 +84,9 @@ public:
 
     /** Creates a set of translations from a file.
 
+        The file can either be a text translation file, or a binary one that was
+        created by saveAsBinaryFile().
+
         When you create one of these, you can call setCurrentMappings() to make it
         the set of mappings that the system's using.
     */
@@ -166,6 +174,17 @@ public:
     /** Provides access to the actual list of mappings. */
     const StringPairArray& getMappings() const            { return translations; }
 
+    //==============================================================================
+    /** Writes these translations to a pre-parsed binary file.
+
+        Loading this file with the LocalisedStrings (const File&, bool) constructor
+        is much faster than parsing the text version, which makes a difference for
+        translation files with thousands of strings. The fallback isn't saved.
+
+        @returns true if the file was written successfully
+    */
+    bool saveAsBinaryFile (const File& fileToWriteTo) const;
+
     //==============================================================================
     /** Adds and merges another set of translations into this set.
 
@@ -188,10 +207,33 @@ private:
     String languageName;
     StringArray countryCodes;
     StringPairArray translations;
+    // Keys are compared without case when ignoresCase is set, so that lookups never need
+    // to create a lower-case copy of the text
+    struct LookupKey
+    {
+        String text;
+        bool ignoreCase;
+
+        bool operator== (const LookupKey& other) const noexcept
+        {
+            return ignoreCase ? text.equalsIgnoreCase (other.text) : text == other.text;
+        }
+    };
+
+    struct LookupKeyHash
+    {
+        static int generateHash (const LookupKey&, int upperLimit) noexcept;
+    };
+
+    FlatHashMap<LookupKey, String, LookupKeyHash> lookupTable;
+    bool ignoresCase = false;
     ScopedPointer<LocalisedStrings> fallback;
     friend struct ContainerDeletePolicy<LocalisedStrings>;
 
     void loadFromText (const String&, bool ignoreCase);
+    bool loadFromBinaryData (const void*, size_t, bool ignoreCase);
+    void rebuildLookupTable();
+    const String* findTranslation (const String&) const;
 
     JUCE_LEAK_DETECTOR (LocalisedStrings)
 };
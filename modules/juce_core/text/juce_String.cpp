@@ -2670,6 +2670,39 @@ public:
             expect (! v2.equals (v4));
             expect (! v4.equals (v2));
         }
+
+        {
+            beginTest ("StringPool");
+
+            StringPool pool;
+            StringArray names;
+
+            for (int i = 0; i < 1000; ++i)
+                names.add (pool.getPooledString ("name" + String (i)));
+
+            for (int i = 0; i < names.size(); ++i)
+            {
+                const String original ("name" + String (i));
+                expect (pool.getPooledString (original).getCharPointer() == names[i].getCharPointer());
+                expect (pool.getPooledString (original.toRawUTF8()).getCharPointer() == names[i].getCharPointer());
+                expect (pool.getPooledString (StringRef (original)).getCharPointer() == names[i].getCharPointer());
+
+                const String padded ("[" + original + "]");
+                auto start = padded.getCharPointer() + 1;
+                expect (pool.getPooledString (start, start.findTerminatingNull() - 1).getCharPointer() == names[i].getCharPointer());
+            }
+
+            const String firstName (names[0]);
+            const void* firstNameAddress = firstName.getCharPointer().getAddress();
+            names.clear();
+            pool.garbageCollect();
+
+            expect (firstName.getReferenceCount() == 2);
+            expect (pool.getPooledString (firstName).getCharPointer().getAddress() == firstNameAddress);
+            expect (pool.getPooledString (String()).isEmpty());
+
+            expect (JUCE_IDENTIFIER ("testIdentifier") == Identifier ("testIdentifier"));
+        }
     }
 };
 
@@ -119,8 +119,51 @@ void StringPairArray::set (const String& key, const String& value)
 
 void StringPairArray::addArray (const StringPairArray& other)
 {
-    for (int i = 0; i < other.size(); ++i)
-        set (other.keys[i], other.values[i]);
+    addArray (other.keys, other.values);
+}
+
+void StringPairArray::addArray (const StringArray& keysToAdd, const StringArray& valuesToAdd)
+{
+    // the lists of keys and values need to be the same length!
+    jassert (keysToAdd.size() == valuesToAdd.size());
+
+    auto numToAdd = jmin (keysToAdd.size(), valuesToAdd.size());
+
+    if ((int64) numToAdd * keys.size() < 256)
+    {
+        for (int i = 0; i < numToAdd; ++i)
+            set (keysToAdd[i], valuesToAdd[i]);
+
+        return;
+    }
+
+    // For bigger lists, indexing the keys avoids searching the whole array for each one.
+    // (The index stored is 1 + the key's position, so that 0 means it's a new key)
+    FlatHashMap<String, int> indexes;
+    indexes.reserve (keys.size() + numToAdd);
+
+    for (int i = 0; i < keys.size(); ++i)
+        indexes.set (ignoreCase ? keys[i].toLowerCase() : keys[i], i + 1);
+
+    keys.ensureStorageAllocated (keys.size() + numToAdd);
+    values.ensureStorageAllocated (values.size() + numToAdd);
+
+    for (int i = 0; i < numToAdd; ++i)
+    {
+        auto& key = keysToAdd[i];
+        auto& index = indexes.getReference (ignoreCase ? key.toLowerCase() : key);
+
+        if (index > 0)
+        {
+            values.set (index - 1, valuesToAdd[i]);
+        }
+        else
+        {
+            keys.add (key);
+            values.add (valuesToAdd[i]);
+            index = keys.size();
+        }
+    }
 }
 
 void StringPairArray::clear()
@@ -103,6 +103,14 @@ public:
     */
     void addArray (const StringPairArray& other);
 
+    /** Adds a list of keys and their values to the array.
+
+        Any keys that are already in the array will have their values replaced, and if
+        the same key appears more than once in the list, the last value is used. For
+        large numbers of items this is much quicker than calling set() for each one.
+    */
+    void addArray (const StringArray& keysToAdd, const StringArray& valuesToAdd);
+
     //==============================================================================
     /** Removes all elements from the array. */
     void clear();
@@ -25,10 +25,7 @@ namespace juce
 
 static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
-
-
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
-StringPool::~StringPool() {}
+static const int numStringPoolShards = 16;
 
 struct StartEndString
 {
@@ -58,44 +55,140 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+static uint32 calculateHash (CharPointer_UTF8 t) noexcept
+{
+    uint32 result = 0;
+
+    while (auto c = t.getAndAdvance())
+        result = 31 * result + (uint32) c;
+
+    return result;
+}
+
+static uint32 calculateHash (const String& s) noexcept   { return calculateHash (s.getCharPointer()); }
+
+static uint32 calculateHash (const StartEndString& s) noexcept
 {
-    int start = 0;
-    int end = strings.size();
+    uint32 result = 0;
 
-    while (start < end)
+    for (auto t = s.start; t < s.end;)
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        auto c = t.getAndAdvance();
 
-        if (startComp == 0)
-            return startString;
+        if (c == 0)
+            break;
 
-        const int halfway = (start + end) / 2;
+        result = 31 * result + (uint32) c;
+    }
+
+    return result;
+}
 
-        if (halfway == start)
+//==============================================================================
+struct StringPool::Shard
+{
+    template <typename NewStringType>
+    String getPooledString (const NewStringType& newString, uint32 hash)
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        garbageCollectIfNeeded();
+
+        if (entries.isEmpty())
+            entries.resize (32);
+
+        auto mask = (uint32) entries.size() - 1;
+
+        for (auto i = hash & mask;; i = (i + 1) & mask)
         {
-            if (startComp > 0)
-                ++start;
+            auto& e = entries.getReference ((int) i);
 
-            break;
+            if (e.string.isEmpty())
+            {
+                e.string = String (newString);
+                e.hash = hash;
+                String result (e.string);
+
+                if (++numUsed * 4 > entries.size() * 3)
+                    resize (entries.size() * 2);
+
+                return result;
+            }
+
+            if (e.hash == hash && compareStrings (newString, e.string) == 0)
+                return e.string;
+        }
+    }
+
+    void garbageCollect()
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        resize (entries.size());
+        lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    }
+
+private:
+    struct Entry
+    {
+        String string;
+        uint32 hash = 0;
+    };
+
+    void garbageCollectIfNeeded()
+    {
+        if (numUsed > minNumberOfStringsForGarbageCollection / numStringPoolShards
+             && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
+        {
+            resize (entries.size());
+            lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
         }
+    }
+
+    // Rebuilds the table, dropping any strings that nothing else is using
+    void resize (int newSize)
+    {
+        Array<Entry> oldEntries;
+        oldEntries.swapWith (entries);
+        entries.resize (newSize);
+        numUsed = 0;
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+        auto mask = (uint32) newSize - 1;
 
-        if (halfwayComp == 0)
-            return halfwayString;
+        for (auto& e : oldEntries)
+        {
+            if (e.string.isNotEmpty() && e.string.getReferenceCount() > 1)
+            {
+                auto i = e.hash & mask;
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+                while (entries.getReference ((int) i).string.isNotEmpty())
+                    i = (i + 1) & mask;
+
+                entries.getReference ((int) i) = e;
+                ++numUsed;
+            }
+        }
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    SpinLock lock;
+    Array<Entry> entries;
+    int numUsed = 0;
+    uint32 lastGarbageCollectionTime = 0;
+};
+
+//==============================================================================
+StringPool::StringPool() noexcept
+{
+    for (int i = 0; i < numStringPoolShards; ++i)
+        shards.add (new Shard());
+}
+
+StringPool::~StringPool() {}
+
+template <typename NewStringType>
+String StringPool::addPooledString (const NewStringType& newString)
+{
+    auto hash = calculateHash (newString);
+    return shards.getUnchecked ((int) ((hash >> 16) % (uint32) numStringPoolShards))->getPooledString (newString, hash);
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -103,9 +196,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (CharPointer_UTF8 (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -113,9 +204,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -123,9 +212,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (newString.text);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -133,27 +220,13 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
-}
-
-void StringPool::garbageCollectIfNeeded()
-{
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    return addPooledString (newString);
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
-
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference(i).getReferenceCount() == 1)
-            strings.remove (i);
-
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    for (auto* shard : shards)
+        shard->garbageCollect();
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
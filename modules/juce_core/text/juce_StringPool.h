@@ -33,6 +33,10 @@ namespace juce
     is returned every time a matching string is asked for. This means that it's trivial to
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
+
+    The strings are kept in a set of hash tables, each with its own lock, so looking
+    up a string doesn't involve searching the whole pool, and threads that are looking
+    up different strings will rarely have to wait for each other.
 */
 class JUCE_API  StringPool
 {
@@ -76,11 +80,11 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct Shard;
+    OwnedArray<Shard> shards;
 
-    void garbageCollectIfNeeded();
+    template <typename NewStringType>
+    String addPooledString (const NewStringType&);
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
@@ -25,177 +25,310 @@ namespace juce
 
 struct TextDiffHelpers
 {
-    enum { minLengthToMatch = 3,
-           maxComplexity = 16 * 1024 * 1024 };
+    enum { maxComplexity = 16 * 1024 * 1024,
+           minEditCostLimit = 256 };
 
-    struct StringRegion
+    // The two strings are compared as lists of tokens, which are either single characters
+    // or whole lines. Each token is reduced to an integer so that comparing them is cheap.
+    struct TokenList
     {
-        StringRegion (const String& s) noexcept
-            : text (s.getCharPointer()), start (0), length (s.length()) {}
+        int size() const noexcept                   { return tokens.size(); }
 
-        StringRegion (String::CharPointerType t, int s, int len) noexcept
-            : text (t), start (s), length (len) {}
-
-        void incrementStart() noexcept  { ++text; ++start; --length; }
+        // returns the character index at which a token starts
+        int getCharIndex (int tokenIndex) const noexcept
+        {
+            return offsets.isEmpty() ? tokenIndex : offsets.getUnchecked (tokenIndex);
+        }
 
-        String::CharPointerType text;
-        int start, length;
+        Array<uint32> tokens;
+        Array<int> offsets; // only used for lines, with an extra entry for the end of the text
     };
 
-    static void addInsertion (TextDiff& td, String::CharPointerType text, int index, int length)
+    static TokenList tokenise (const String& text, TextDiff::Granularity granularity, HashMap<String, int>& lineIDs)
     {
-        TextDiff::Change c;
-        c.insertedText = String (text, (size_t) length);
-        c.start = index;
-        c.length = 0;
-        td.changes.add (c);
-    }
+        TokenList list;
 
-    static void addDeletion (TextDiff& td, int index, int length)
-    {
-        TextDiff::Change c;
-        c.start = index;
-        c.length = length;
-        td.changes.add (c);
-    }
+        if (granularity == TextDiff::characterGranularity)
+        {
+            list.tokens.ensureStorageAllocated (text.length());
 
-    static void diffSkippingCommonStart (TextDiff& td, StringRegion a, StringRegion b)
-    {
-        for (;;)
+            for (auto t = text.getCharPointer(); ! t.isEmpty();)
+                list.tokens.add ((uint32) t.getAndAdvance());
+
+            return list;
+        }
+
+        int index = 0;
+
+        for (auto t = text.getCharPointer(); ! t.isEmpty();)
         {
-            auto ca = *a.text;
-            auto cb = *b.text;
+            auto lineStart = t;
+            list.offsets.add (index);
+
+            for (;;)
+            {
+                ++index;
 
-            if (ca != cb || ca == 0)
-                break;
+                if (t.getAndAdvance() == '\n' || t.isEmpty())
+                    break;
+            }
 
-            a.incrementStart();
-            b.incrementStart();
+            String line (lineStart, t);
+
+            if (! lineIDs.contains (line))
+                lineIDs.set (line, lineIDs.size());
+
+            list.tokens.add ((uint32) lineIDs[line]);
         }
 
-        diffRecursively (td, a, b);
+        list.offsets.add (index);
+        return list;
     }
 
-    static void diffRecursively (TextDiff& td, StringRegion a, StringRegion b)
+    //==============================================================================
+    // This is Myers' O(ND) algorithm, using the linear-space divide-and-conquer version,
+    // so it only needs enough memory for the two lists of furthest-reaching paths.
+    struct Differ
     {
-        int indexA = 0, indexB = 0;
-        auto len = findLongestCommonSubstring (a.text, a.length, indexA,
-                                               b.text, b.length, indexB);
-
-        if (len >= minLengthToMatch)
-        {
-            if (indexA > 0 && indexB > 0)
-                diffSkippingCommonStart (td, StringRegion (a.text, a.start, indexA),
-                                             StringRegion (b.text, b.start, indexB));
-            else if (indexA > 0)
-                addDeletion (td, b.start, indexA);
-            else if (indexB > 0)
-                addInsertion (td, b.text, b.start, indexB);
-
-            diffRecursively (td, StringRegion (a.text + (indexA + len), a.start + indexA + len, a.length - indexA - len),
-                                 StringRegion (b.text + (indexB + len), b.start + indexB + len, b.length - indexB - len));
-        }
-        else
+        Differ (const TokenList& a, const TokenList& b)
+            : tokensA (a.tokens.begin()), tokensB (b.tokens.begin())
         {
-            if (a.length > 0)   addDeletion (td, b.start, a.length);
-            if (b.length > 0)   addInsertion (td, b.text, b.start, b.length);
+            auto maxD = (a.size() + b.size() + 1) / 2;
+            forward.malloc (2 * (size_t) maxD + 2);
+            backward.malloc (2 * (size_t) maxD + 2);
+
+            diff (0, a.size(), 0, b.size());
         }
-    }
 
-    static int findLongestCommonSubstring (String::CharPointerType a, const int lenA, int& indexInA,
-                                           String::CharPointerType b, const int lenB, int& indexInB) noexcept
-    {
-        if (lenA == 0 || lenB == 0)
-            return 0;
+        struct Region
+        {
+            int startA, endA, startB, endB;
+        };
 
-        if (lenA * lenB > maxComplexity)
-            return findCommonSuffix (a, lenA, indexInA,
-                                     b, lenB, indexInB);
+        Array<Region> regions; // the parts of each list which are different, in order
 
-        auto scratchSpace = sizeof (int) * (2 + 2 * (size_t) lenB);
+    private:
+        const uint32* tokensA;
+        const uint32* tokensB;
+        HeapBlock<int> forward, backward;
 
-        if (scratchSpace < 4096)
+        void diff (int startA, int endA, int startB, int endB)
         {
-            auto* scratch = (int*) alloca (scratchSpace);
-            return findLongestCommonSubstring (a, lenA, indexInA, b, lenB, indexInB, scratchSpace, scratch);
+            while (startA < endA && startB < endB && tokensA[startA] == tokensB[startB])
+            {
+                ++startA;
+                ++startB;
+            }
+
+            while (startA < endA && startB < endB && tokensA[endA - 1] == tokensB[endB - 1])
+            {
+                --endA;
+                --endB;
+            }
+
+            int splitA, splitB;
+
+            if (startA == endA || startB == endB
+                 || ! findSplitPoint (startA, endA, startB, endB, splitA, splitB)
+                 || (splitA == startA && splitB == startB)
+                 || (splitA == endA && splitB == endB))
+            {
+                addRegion (startA, endA, startB, endB);
+                return;
+            }
+
+            diff (startA, splitA, startB, splitB);
+            diff (splitA, endA, splitB, endB);
         }
 
-        HeapBlock<int> scratch (scratchSpace);
-        return findLongestCommonSubstring (a, lenA, indexInA, b, lenB, indexInB, scratchSpace, scratch);
-    }
+        void addRegion (int startA, int endA, int startB, int endB)
+        {
+            if (startA == endA && startB == endB)
+                return;
 
-    static int findLongestCommonSubstring (String::CharPointerType a, const int lenA, int& indexInA,
-                                           String::CharPointerType b, const int lenB, int& indexInB,
-                                           const size_t scratchSpace, int* const lines) noexcept
-    {
-        zeromem (lines, scratchSpace);
+            if (! regions.isEmpty())
+            {
+                auto& last = regions.getReference (regions.size() - 1);
 
-        auto* l0 = lines;
-        auto* l1 = l0 + lenB + 1;
+                if (last.endA == startA && last.endB == startB)
+                {
+                    last.endA = endA;
+                    last.endB = endB;
+                    return;
+                }
+            }
 
-        int loopsWithoutImprovement = 0;
-        int bestLength = 0;
+            regions.add ({ startA, endA, startB, endB });
+        }
 
-        for (int i = 0; i < lenA; ++i)
+        // Searches forwards from the start and backwards from the end at the same time, until
+        // the two paths meet somewhere in the middle. If the number of edits needed gets too
+        // large, it gives up and returns false, and the whole region is treated as a change.
+        bool findSplitPoint (int startA, int endA, int startB, int endB, int& splitA, int& splitB) noexcept
         {
-            auto ca = a.getAndAdvance();
-            auto b2 = b;
+            auto* a = tokensA + startA;
+            auto* b = tokensB + startB;
+            auto lenA = endA - startA;
+            auto lenB = endB - startB;
+            auto maxD = (lenA + lenB + 1) / 2;
+            auto vLength = 2 * maxD + 2;
+            auto delta = lenA - lenB;
+            auto isOdd = (delta & 1) != 0;
+            auto costLimit = jmax ((int) minEditCostLimit, (int) maxComplexity / (lenA + lenB));
+
+            // indexed by diagonal k = x - y, offset so that it can go negative
+            auto* vf = forward.get() + maxD;
+            auto* vb = backward.get() + maxD;
+
+            for (int i = 0; i < vLength; ++i)
+            {
+                forward[i] = -1;
+                backward[i] = -1;
+            }
+
+            vf[1] = 0;
+            vb[1] = 0;
 
-            for (int j = 0; j < lenB; ++j)
+            // these are used to skip diagonals which have run off the edge of the grid
+            int forwardStart = 0, forwardEnd = 0, backwardStart = 0, backwardEnd = 0;
+
+            for (int d = 0; d < maxD && d <= costLimit; ++d)
             {
-                if (ca != b2.getAndAdvance())
+                for (int k = -d + forwardStart; k <= d - forwardEnd; k += 2)
                 {
-                    l1[j + 1] = 0;
+                    auto x = (k == -d || (k != d && vf[k - 1] < vf[k + 1])) ? vf[k + 1] : vf[k - 1] + 1;
+                    auto y = x - k;
+
+                    while (x < lenA && y < lenB && a[x] == b[y])
+                    {
+                        ++x;
+                        ++y;
+                    }
+
+                    vf[k] = x;
+
+                    if (x > lenA)
+                    {
+                        forwardEnd += 2;
+                    }
+                    else if (y > lenB)
+                    {
+                        forwardStart += 2;
+                    }
+                    else if (isOdd)
+                    {
+                        auto backwardK = delta - k;
+
+                        if (backwardK >= -maxD && backwardK < vLength - maxD && vb[backwardK] != -1
+                             && x >= lenA - vb[backwardK])
+                        {
+                            splitA = startA + x;
+                            splitB = startB + y;
+                            return true;
+                        }
+                    }
                 }
-                else
+
+                for (int k = -d + backwardStart; k <= d - backwardEnd; k += 2)
                 {
-                    auto len = l0[j] + 1;
-                    l1[j + 1] = len;
+                    auto x = (k == -d || (k != d && vb[k - 1] < vb[k + 1])) ? vb[k + 1] : vb[k - 1] + 1;
+                    auto y = x - k;
+
+                    while (x < lenA && y < lenB && a[lenA - 1 - x] == b[lenB - 1 - y])
+                    {
+                        ++x;
+                        ++y;
+                    }
+
+                    vb[k] = x;
 
-                    if (len > bestLength)
+                    if (x > lenA)
+                    {
+                        backwardEnd += 2;
+                    }
+                    else if (y > lenB)
+                    {
+                        backwardStart += 2;
+                    }
+                    else if (! isOdd)
                     {
-                        loopsWithoutImprovement = 0;
-                        bestLength = len;
-                        indexInA = i;
-                        indexInB = j;
+                        auto forwardK = delta - k;
+
+                        if (forwardK >= -maxD && forwardK < vLength - maxD && vf[forwardK] != -1
+                             && vf[forwardK] >= lenA - x)
+                        {
+                            splitA = startA + vf[forwardK];
+                            splitB = startB + vf[forwardK] - forwardK;
+                            return true;
+                        }
                     }
                 }
             }
 
-            if (++loopsWithoutImprovement > 100)
-                break;
-
-            std::swap (l0, l1);
+            return false;
         }
 
-        indexInA -= bestLength - 1;
-        indexInB -= bestLength - 1;
-        return bestLength;
+        JUCE_DECLARE_NON_COPYABLE (Differ)
+    };
+
+    //==============================================================================
+    static void addInsertion (TextDiff& td, String::CharPointerType text, int index, int length)
+    {
+        TextDiff::Change c;
+        c.insertedText = String (text, (size_t) length);
+        c.start = index;
+        c.length = 0;
+        td.changes.add (c);
+    }
+
+    static void addDeletion (TextDiff& td, int index, int length)
+    {
+        TextDiff::Change c;
+        c.start = index;
+        c.length = length;
+        td.changes.add (c);
     }
 
-    static int findCommonSuffix (String::CharPointerType a, int lenA, int& indexInA,
-                                 String::CharPointerType b, int lenB, int& indexInB) noexcept
+    static void diff (TextDiff& td, const String& original, const String& target, TextDiff::Granularity granularity)
     {
-        int length = 0;
-        a += lenA - 1;
-        b += lenB - 1;
+        HashMap<String, int> lineIDs;
+        auto a = tokenise (original, granularity, lineIDs);
+        auto b = tokenise (target, granularity, lineIDs);
+
+        Differ differ (a, b);
 
-        while (length < lenA && length < lenB && *a == *b)
+        // Each change is applied after the previous ones, so everything before it already
+        // matches the target, and its position is an index into the target string.
+        auto targetText = target.getCharPointer();
+        int targetIndex = 0;
+
+        for (auto& r : differ.regions)
         {
-            --a;
-            --b;
-            ++length;
-        }
+            auto start = b.getCharIndex (r.startB);
+            auto numToDelete = a.getCharIndex (r.endA) - a.getCharIndex (r.startA);
+            auto numToInsert = b.getCharIndex (r.endB) - start;
 
-        indexInA = lenA - length;
-        indexInB = lenB - length;
-        return length;
+            if (numToDelete > 0)
+                addDeletion (td, start, numToDelete);
+
+            if (numToInsert > 0)
+            {
+                targetText += start - targetIndex;
+                targetIndex = start;
+                addInsertion (td, targetText, start, numToInsert);
+            }
+        }
     }
 };
 
 TextDiff::TextDiff (const String& original, const String& target)
+    : TextDiff (original, target, characterGranularity)
 {
-    TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
+}
+
+TextDiff::TextDiff (const String& original, const String& target, Granularity granularity)
+{
+    TextDiffHelpers::diff (*this, original, target, granularity);
 }
 
 String TextDiff::appliedTo (String text) const
@@ -246,13 +379,33 @@ public:
         return CharPointer_UTF32 (buffer);
     }
 
-    void testDiff (const String& a, const String& b)
+    static String createLines (Random& r, int numLines)
     {
-        TextDiff diff (a, b);
+        StringArray lines;
+
+        for (int i = 0; i < numLines; ++i)
+            lines.add ("line " + String (r.nextInt (numLines / 4 + 1)));
+
+        return lines.joinIntoString (r.nextBool() ? "\n" : "\r\n") + (r.nextBool() ? "\n" : "");
+    }
+
+    void testDiff (const String& a, const String& b, TextDiff::Granularity granularity = TextDiff::characterGranularity)
+    {
+        TextDiff diff (a, b, granularity);
         auto result = diff.appliedTo (a);
         expectEquals (result, b);
     }
 
+    static int getNumCharsChanged (const TextDiff& diff)
+    {
+        int total = 0;
+
+        for (auto& c : diff.changes)
+            total += c.isDeletion() ? c.length : c.insertedText.length();
+
+        return total;
+    }
+
     void runTest() override
     {
         beginTest ("TextDiff");
@@ -273,6 +426,65 @@ public:
             testDiff (s, createString (r));
             testDiff (s + createString (r), s + createString (r));
         }
+
+        beginTest ("Minimal changes");
+        {
+            TextDiff diff ("abcdefgh", "abXdefYgh");
+            expectEquals (diff.changes.size(), 3);
+            expectEquals (getNumCharsChanged (diff), 3);
+            expectEquals (diff.appliedTo ("abcdefgh"), String ("abXdefYgh"));
+
+            // the longest common subsequence of these is 5 characters, so 4 + 4 must change
+            expectEquals (getNumCharsChanged (TextDiff ("xabcabcabcy", "xcbacbacbay")), 8);
+        }
+
+        beginTest ("Lines");
+        {
+            testDiff (String(), "a\nb", TextDiff::lineGranularity);
+            testDiff ("a\nb", String(), TextDiff::lineGranularity);
+            testDiff ("a\nb", "a\nb\n", TextDiff::lineGranularity);
+            testDiff ("a\r\nb\r\nc", "a\nb\r\nc", TextDiff::lineGranularity);
+
+            for (int i = 200; --i >= 0;)
+            {
+                auto s = createLines (r, r.nextInt (50));
+                testDiff (s, createLines (r, r.nextInt (50)), TextDiff::lineGranularity);
+                testDiff (s + createLines (r, 10), s + createLines (r, 10), TextDiff::lineGranularity);
+            }
+
+            TextDiff diff ("one\ntwo\nthree\nfour\n", "one\nTWO\nthree\nfour\nfive\n", TextDiff::lineGranularity);
+            expectEquals (diff.changes.size(), 3);
+            expectEquals (diff.changes[0].start, 4);
+            expectEquals (diff.changes[0].length, 4);
+            expectEquals (diff.changes[1].insertedText, String ("TWO\n"));
+            expectEquals (diff.changes[2].insertedText, String ("five\n"));
+        }
+
+        beginTest ("Large texts");
+        {
+            StringArray lines;
+
+            for (int i = 0; i < 10000; ++i)
+                lines.add ("This is line number " + String (i));
+
+            auto original = lines.joinIntoString ("\n");
+
+            for (int i = 0; i < 20; ++i)
+                lines.set (r.nextInt (lines.size()), "A changed line " + String (i));
+
+            lines.insert (r.nextInt (lines.size()), "An inserted line");
+            lines.remove (r.nextInt (lines.size()));
+            auto target = lines.joinIntoString ("\n");
+
+            TextDiff lineDiff (original, target, TextDiff::lineGranularity);
+            expectEquals (lineDiff.appliedTo (original), target);
+            expect (lineDiff.changes.size() <= 2 * 22);
+
+            testDiff (original, target);
+
+            // this is too different to find the smallest diff quickly, but should still be correct
+            testDiff (original, target.toUpperCase());
+        }
     }
 };
 
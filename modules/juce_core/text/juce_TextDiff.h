@@ -30,14 +30,39 @@ namespace juce
     Once created, the TextDiff object contains an array of change objects, where
     each change can be either an insertion or a deletion. When applied in order
     to the original string, these changes will convert it to the target string.
+
+    The differences are found with Myers' O(ND) algorithm, so the time taken depends
+    on the size of the text multiplied by the amount that has changed, and the memory
+    used is proportional to the size of the text. If the two strings are so different
+    that finding the smallest set of changes would take too long, it'll settle for a
+    set that's larger than necessary, but still correct.
 */
 class JUCE_API TextDiff
 {
 public:
+    /** The units in which the two strings are compared. */
+    enum Granularity
+    {
+        characterGranularity,   /**< Finds the smallest set of changes to individual characters. */
+        lineGranularity         /**< Treats each line as a single item, so that a changed line is replaced
+                                     as a whole. This is much faster for large multi-line texts, and
+                                     produces the kind of changes that a person would expect to see when
+                                     comparing two files. */
+    };
+
     /** Creates a set of diffs for converting the original string into the target. */
     TextDiff (const String& original,
               const String& target);
 
+    /** Creates a set of diffs for converting the original string into the target,
+        comparing them in the given units.
+        Whichever granularity is used, the changes are still expressed as character
+        indices and lengths.
+    */
+    TextDiff (const String& original,
+              const String& target,
+              Granularity granularity);
+
     /** Applies this sequence of changes to the original string, producing the
         target string that was specified when generating them.
 
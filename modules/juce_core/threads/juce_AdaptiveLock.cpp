@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace AdaptiveLockHelpers
+{
+    // Tells the CPU that this is a spin-wait loop, so that it can save power and give
+    // its resources to a hyperthread sibling, which may be the one holding the lock.
+    static inline void pause() noexcept
+    {
+       #if JUCE_INTEL && JUCE_MSVC
+        _mm_pause();
+       #elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+        __builtin_ia32_pause();
+       #elif JUCE_ARM && (JUCE_GCC || JUCE_CLANG)
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+
+    // There's no point spinning on a single core, as the owner can't release the
+    // lock until the waiting thread gives up its time-slice.
+    static bool isWorthSpinning() noexcept
+    {
+        static const bool worthSpinning = SystemStats::getNumCpus() > 1;
+        return worthSpinning;
+    }
+
+    enum { maxPausesPerRound = 64 };
+}
+
+//==============================================================================
+AdaptiveLock::AdaptiveLock (bool usePriorityInheritance, int spinRounds) noexcept
+    : priorityInheritance (usePriorityInheritance), maxSpinRounds (jmax (0, spinRounds))
+{
+}
+
+AdaptiveLock::~AdaptiveLock() noexcept
+{
+    jassert (state.load() == 0); // deleting a lock that's still held!
+}
+
+void AdaptiveLock::enter() const noexcept
+{
+    if (tryAcquire())
+    {
+        ++statistics.numAcquisitions;
+        return;
+    }
+
+    int numRounds = 0;
+    bool acquired = false;
+
+    if (AdaptiveLockHelpers::isWorthSpinning())
+    {
+        for (int numPauses = 1; numRounds < maxSpinRounds && ! acquired; ++numRounds)
+        {
+            for (int i = 0; i < numPauses; ++i)
+                AdaptiveLockHelpers::pause();
+
+            numPauses = jmin (numPauses * 2, (int) AdaptiveLockHelpers::maxPausesPerRound);
+
+            // only attempt the atomic write when it looks likely to succeed, to avoid
+            // stealing the cache line from the owner
+            acquired = state.load (std::memory_order_relaxed) == 0 && tryAcquire();
+        }
+    }
+
+    if (! acquired)
+        acquireBySleeping();
+
+    // the counters are only touched while the lock is held, so they don't need to be atomic
+    ++statistics.numAcquisitions;
+    ++statistics.numContendedAcquisitions;
+    statistics.numSpinRounds += numRounds;
+
+    if (acquired)
+        ++statistics.numAcquiredWhileSpinning;
+    else
+        ++statistics.numAcquiredAfterSleeping;
+}
+
+bool AdaptiveLock::tryEnter() const noexcept
+{
+    if (! tryAcquire())
+        return false;
+
+    ++statistics.numAcquisitions;
+    return true;
+}
+
+void AdaptiveLock::exit() const noexcept
+{
+    jassert (state.load() != 0); // Agh! Releasing a lock that isn't currently held!
+    release();
+}
+
+AdaptiveLock::Statistics AdaptiveLock::getStatistics() const noexcept
+{
+    const ScopedLockType sl (*this);
+    auto result = statistics;
+    --result.numAcquisitions; // don't count the one that was needed to read them
+    return result;
+}
+
+void AdaptiveLock::resetStatistics() noexcept
+{
+    const ScopedLockType sl (*this);
+    statistics = Statistics();
+}
+
+//==============================================================================
+// Without priority inheritance, the state is 0 when unlocked, 1 when locked, and 2 when
+// locked with threads that may be sleeping on it. With priority inheritance, the state
+// is a PI futex, which holds the owner's thread ID, and the kernel does the waiting.
+bool AdaptiveLock::tryAcquire() const noexcept
+{
+    int32 expected = 0;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    auto lockedValue = priorityInheritance ? FutexHelpers::getCurrentThreadID() : 1;
+   #else
+    ignoreUnused (priorityInheritance); // there are no PI futexes here
+    auto lockedValue = 1;
+   #endif
+
+    return state.compare_exchange_strong (expected, lockedValue, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void AdaptiveLock::acquireBySleeping() const noexcept
+{
+   #if JUCE_LINUX || JUCE_ANDROID
+    if (priorityInheritance)
+    {
+        while (FutexHelpers::futex (state, FUTEX_LOCK_PI_PRIVATE, 0) != 0)
+        {
+            // EINTR and EAGAIN mean that it's worth trying again, but anything else means
+            // that PI futexes aren't supported, so all we can do is poll
+            if (errno != EINTR && errno != EAGAIN)
+            {
+                while (! tryAcquire())
+                    Thread::yield();
+
+                return;
+            }
+        }
+
+        return;
+    }
+   #endif
+
+    while (state.exchange (2, std::memory_order_acquire) != 0)
+        AddressWait::wait (state, 2, -1);
+}
+
+void AdaptiveLock::release() const noexcept
+{
+   #if JUCE_LINUX || JUCE_ANDROID
+    if (priorityInheritance)
+    {
+        // if there are waiters, the kernel will have set a flag in the state, so this
+        // will fail and it has to pick the next owner
+        auto owner = FutexHelpers::getCurrentThreadID();
+
+        if (! state.compare_exchange_strong (owner, 0, std::memory_order_release, std::memory_order_relaxed))
+            FutexHelpers::futex (state, FUTEX_UNLOCK_PI_PRIVATE, 0);
+
+        return;
+    }
+   #endif
+
+    if (state.exchange (0, std::memory_order_release) == 2)
+        AddressWait::wakeOne (state);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AdaptiveLockTests  : public UnitTest
+{
+public:
+    AdaptiveLockTests() : UnitTest ("AdaptiveLock", "Threads") {}
+
+    void runTest() override
+    {
+        for (auto usePriorityInheritance : { false, true })
+        {
+            beginTest (usePriorityInheritance ? "Priority-inheriting lock" : "Lock");
+            {
+                AdaptiveLock lock (usePriorityInheritance);
+
+                expect (lock.tryEnter());
+                expect (! lock.tryEnter());
+                lock.exit();
+
+                {
+                    const AdaptiveLock::ScopedLockType sl (lock);
+                    expect (! lock.tryEnter());
+                }
+
+                expect (lock.tryEnter());
+                lock.exit();
+
+                auto stats = lock.getStatistics();
+                expectEquals (stats.numAcquisitions, (int64) 3);
+                expectEquals (stats.numContendedAcquisitions, (int64) 0);
+
+                lock.resetStatistics();
+                expectEquals (lock.getStatistics().numAcquisitions, (int64) 0);
+            }
+
+            for (auto spinRounds : { 0, 10 })
+            {
+                beginTest ("Mutual exclusion with " + String (spinRounds) + " spin rounds");
+
+                AdaptiveLock lock (usePriorityInheritance, spinRounds);
+                int64 counter = 0;
+                const int numThreads = 4, numIterations = 20000;
+
+                OwnedArray<IncrementerThread> threads;
+
+                for (int i = 0; i < numThreads; ++i)
+                    threads.add (new IncrementerThread (lock, counter, numIterations));
+
+                // normal priority, as realtime threads spinning on a single core could
+                // starve the rest of the test of CPU time
+                for (auto* t : threads)
+                    t->startThread (0);
+
+                for (auto* t : threads)
+                    expect (t->waitForThreadToExit (20000));
+
+                expectEquals (counter, (int64) numThreads * numIterations);
+
+                auto stats = lock.getStatistics();
+                expectEquals (stats.numAcquisitions, (int64) numThreads * numIterations);
+                expectEquals (stats.numAcquiredWhileSpinning + stats.numAcquiredAfterSleeping,
+                              stats.numContendedAcquisitions);
+
+                if (spinRounds == 0)
+                    expectEquals (stats.numAcquiredWhileSpinning, (int64) 0);
+            }
+        }
+    }
+
+    struct IncrementerThread  : public Thread
+    {
+        IncrementerThread (AdaptiveLock& l, int64& c, int n)
+            : Thread ("AdaptiveLock test"), lock (l), counter (c), numIterations (n) {}
+
+        void run() override
+        {
+            for (int i = 0; i < numIterations; ++i)
+            {
+                const AdaptiveLock::ScopedLockType sl (lock);
+                auto value = counter;
+
+                if ((i & 63) == 0)
+                    Thread::yield(); // makes it more likely that another thread finds the lock held
+
+                counter = value + 1;
+            }
+        }
+
+        AdaptiveLock& lock;
+        int64& counter;
+        const int numIterations;
+    };
+};
+
+static AdaptiveLockTests adaptiveLockTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock for short critical sections, which spins for a little while before
+    putting the waiting thread to sleep.
+
+    A CriticalSection always goes straight to the OS when it's contended, and a
+    SpinLock will burn CPU for as long as it has to wait. An AdaptiveLock sits between
+    the two: when it finds the lock held, it retries a bounded number of times with an
+    exponentially increasing number of CPU pause instructions between attempts, which
+    is usually enough for a short critical section on another core to finish. If the
+    lock still isn't free after that, the thread sleeps until the owner releases it,
+    using the same OS primitives as a WaitableEvent.
+    When the lock isn't contended, entering and exiting it is a single atomic operation
+    each, with no system calls.
+
+    Like a SpinLock, this is NOT re-entrant.
+
+    If you pass true for usePriorityInheritance, a high-priority thread that's waiting
+    for the lock will temporarily raise the priority of the thread that holds it, so
+    that e.g. an audio thread can't be held up by a low-priority thread that's been
+    pre-empted while holding the lock. This is done by the kernel with a PI futex on
+    Linux and Android, and has no effect on other platforms.
+
+    The lock keeps some statistics about how often it was contended, which you can use
+    to decide whether it's the right kind of lock for the job - see getStatistics().
+
+    @see SpinLock, CriticalSection
+*/
+class JUCE_API  AdaptiveLock
+{
+public:
+    //==============================================================================
+    /** Creates an AdaptiveLock.
+
+        @param usePriorityInheritance   if true, a thread that's waiting for the lock will
+                                        lend its priority to the thread that holds it (see
+                                        the class description for the platforms that support it)
+        @param maxSpinRounds            the number of times to retry before going to sleep. Each
+                                        round waits for twice as long as the previous one, up to
+                                        a limit, so the default will spin for a few microseconds
+                                        at most. Passing zero will make it sleep straight away.
+    */
+    explicit AdaptiveLock (bool usePriorityInheritance = false, int maxSpinRounds = 10) noexcept;
+
+    /** Destructor. */
+    ~AdaptiveLock() noexcept;
+
+    //==============================================================================
+    /** Acquires the lock, spinning and then sleeping until it's available.
+
+        Note that an AdaptiveLock is NOT re-entrant, so if a thread tries to acquire a
+        lock that it already holds, this method will never return!
+
+        It's strongly recommended that you never call this method directly - instead use the
+        ScopedLockType class to manage the locking using an RAII pattern instead.
+    */
+    void enter() const noexcept;
+
+    /** Attempts to acquire the lock without waiting, returning true if this was successful. */
+    bool tryEnter() const noexcept;
+
+    /** Releases the lock, waking up a thread that's waiting for it if there is one. */
+    void exit() const noexcept;
+
+    //==============================================================================
+    /** Some counts of how the lock has been acquired. */
+    struct Statistics
+    {
+        /** The total number of times the lock has been acquired. */
+        int64 numAcquisitions = 0;
+
+        /** The number of times that enter() found the lock already held. */
+        int64 numContendedAcquisitions = 0;
+
+        /** The number of contended acquisitions that got the lock while spinning,
+            without having to sleep.
+        */
+        int64 numAcquiredWhileSpinning = 0;
+
+        /** The number of contended acquisitions that had to sleep. */
+        int64 numAcquiredAfterSleeping = 0;
+
+        /** The total number of spin rounds, across all of the contended acquisitions. */
+        int64 numSpinRounds = 0;
+    };
+
+    /** Returns the statistics that have been gathered since the lock was created, or
+        since resetStatistics() was last called.
+
+        The counters are only ever updated by the thread that holds the lock, so this
+        acquires the lock to read them, and mustn't be called while you're holding it.
+    */
+    Statistics getStatistics() const noexcept;
+
+    /** Sets all of the statistics back to zero.
+        This acquires the lock, so mustn't be called while you're holding it.
+    */
+    void resetStatistics() noexcept;
+
+    //==============================================================================
+    /** Provides the type of scoped lock to use for locking an AdaptiveLock. */
+    typedef GenericScopedLock <AdaptiveLock>       ScopedLockType;
+
+    /** Provides the type of scoped unlocker to use with an AdaptiveLock. */
+    typedef GenericScopedUnlock <AdaptiveLock>     ScopedUnlockType;
+
+    /** Provides the type of scoped try-locker to use with an AdaptiveLock. */
+    typedef GenericScopedTryLock <AdaptiveLock>    ScopedTryLockType;
+
+private:
+    //==============================================================================
+    // The meaning of the state's value depends on the platform's implementation, but
+    // it's always zero when the lock is free.
+    mutable std::atomic<int32> state { 0 };
+    const bool priorityInheritance;
+    const int maxSpinRounds;
+    mutable Statistics statistics;
+
+    bool tryAcquire() const noexcept;
+    void acquireBySleeping() const noexcept;
+    void release() const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (AdaptiveLock)
+};
+
+} // namespace juce
@@ -36,6 +36,11 @@ int ChildProcess::readProcessOutput (void* dest, int numBytes)
     return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
 }
 
+int ChildProcess::readAvailableOutput (void* dest, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->readAvailable (dest, numBytes) : -1;
+}
+
 bool ChildProcess::kill()
 {
     return activeProcess == nullptr || activeProcess->killProcess();
@@ -54,6 +59,8 @@ bool ChildProcess::waitForProcessToFinish (const int timeoutMs) const
     {
         if (! isRunning())
             return true;
+
+        Thread::sleep (1);
     }
     while (timeoutMs < 0 || Time::getMillisecondCounter() < timeoutTime);
 
@@ -62,20 +69,24 @@ bool ChildProcess::waitForProcessToFinish (const int timeoutMs) const
 
 String ChildProcess::readAllProcessOutput()
 {
-    MemoryOutputStream result;
+    MemoryBlock result;
+    size_t size = 0;
 
     for (;;)
     {
-        char buffer [512];
-        const int num = readProcessOutput (buffer, sizeof (buffer));
+        // read straight into the result, growing it as needed
+        if (result.getSize() - size < 16384)
+            result.setSize (jmax ((size_t) 65536, result.getSize() * 2));
+
+        auto num = readProcessOutput (addBytesToPointer (result.getData(), size), (int) (result.getSize() - size));
 
         if (num <= 0)
             break;
 
-        result.write (buffer, (size_t) num);
+        size += (size_t) num;
     }
 
-    return result.toString();
+    return String::createStringFromData (result.getData(), (int) size);
 }
 
 //==============================================================================
@@ -102,6 +113,54 @@ public:
         //String output (p.readAllProcessOutput());
         //expect (output.isNotEmpty());
       #endif
+
+      #if JUCE_MAC || JUCE_LINUX
+        beginTest ("Output and exit codes");
+        {
+            ChildProcess c;
+            expect (c.start (StringArray ({ "sh", "-c", "echo hello; echo world >&2; exit 3" })));
+            expectEquals (c.readAllProcessOutput().removeCharacters ("\r"), String ("hello\nworld\n"));
+            expect (c.waitForProcessToFinish (5000));
+            expectEquals ((int) c.getExitCode(), 3);
+            expectEquals ((int) c.getExitCode(), 3);
+
+            expect (c.start (StringArray ({ "sh", "-c", "echo hidden >&2" }), ChildProcess::wantStdOut));
+            expect (c.readAllProcessOutput().isEmpty());
+
+            expect (! c.start ("a_command_that_really_does_not_exist_anywhere"));
+        }
+
+        beginTest ("Large output");
+        {
+            ChildProcess c;
+            expect (c.start (StringArray ({ "sh", "-c", "i=0; while [ $i -lt 20000 ]; do echo 0123456789; i=$((i+1)); done" })));
+            expectEquals (c.readAllProcessOutput().length(), 220000);
+        }
+
+        beginTest ("Non-blocking reads");
+        {
+            ChildProcess c;
+            expect (c.start (StringArray ({ "sh", "-c", "sleep 0.2; echo done" })));
+
+            char buffer[64];
+            expectEquals (c.readAvailableOutput (buffer, sizeof (buffer)), 0);
+
+            MemoryOutputStream output;
+
+            for (;;)
+            {
+                auto num = c.readAvailableOutput (buffer, sizeof (buffer));
+
+                if (num < 0)
+                    break;
+
+                output.write (buffer, (size_t) num);
+                Thread::sleep (5);
+            }
+
+            expectEquals (output.toString(), String ("done\n"));
+        }
+      #endif
     }
 };
 
@@ -82,6 +82,15 @@ public:
     */
     int readProcessOutput (void* destBuffer, int numBytesToRead);
 
+    /** Reads whatever output the child process has produced so far, without waiting
+        for any more.
+
+        @returns the number of bytes read, which may be 0 if nothing is available yet,
+                 or -1 if the process has closed its output and it has all been read.
+        @see ChildProcessPool
+    */
+    int readAvailableOutput (void* destBuffer, int maxBytesToRead);
+
     /** Blocks until the process has finished, and then returns its complete output
         as a string.
     */
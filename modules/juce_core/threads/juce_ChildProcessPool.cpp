@@ -0,0 +1,314 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct ChildProcessPool::RunningJob
+{
+    RunningJob (Job& j) : job (std::move (j)) {}
+
+    Job job;
+    ChildProcess process;
+
+    JUCE_DECLARE_NON_COPYABLE (RunningJob)
+};
+
+//==============================================================================
+ChildProcessPool::ChildProcessPool (int maxNumConcurrentProcesses)
+    : Thread ("Child process pool"), maxNumRunning (jmax (1, maxNumConcurrentProcesses))
+{
+    startThread();
+}
+
+ChildProcessPool::~ChildProcessPool()
+{
+    signalThreadShouldExit();
+    cancelAllJobs (true);
+    stopThread (-1);
+}
+
+void ChildProcessPool::addJob (const Job& job)
+{
+    // you need to give it something to run!
+    jassert (job.arguments.size() > 0);
+
+    {
+        const ScopedLock sl (lock);
+        pendingJobs.add (new Job (job));
+    }
+
+    notify();
+}
+
+void ChildProcessPool::cancelAllJobs (bool killRunningProcesses)
+{
+    const ScopedLock sl (lock);
+    pendingJobs.clear();
+
+    if (killRunningProcesses)
+        for (auto* r : runningJobs)
+            r->process.kill();
+}
+
+bool ChildProcessPool::waitForAllJobs (int timeoutMs)
+{
+    auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (pendingJobs.isEmpty() && runningJobs.isEmpty())
+                return true;
+        }
+
+        if (timeoutMs < 0)
+        {
+            jobFinished.wait (100);
+        }
+        else
+        {
+            auto now = Time::getMillisecondCounter();
+
+            if (now >= endTime)
+                return false;
+
+            jobFinished.wait ((int) jmin ((uint32) 100, endTime - now));
+        }
+    }
+}
+
+int ChildProcessPool::getNumRunningJobs() const
+{
+    const ScopedLock sl (lock);
+    return runningJobs.size();
+}
+
+int ChildProcessPool::getNumPendingJobs() const
+{
+    const ScopedLock sl (lock);
+    return pendingJobs.size();
+}
+
+//==============================================================================
+void ChildProcessPool::run()
+{
+    while (! threadShouldExit())
+    {
+        startPendingJobs();
+
+        // (only this thread changes the list of running jobs, so it can look at it without locking)
+        if (! serviceRunningJobs())
+            wait (runningJobs.isEmpty() ? -1 : 2);
+    }
+}
+
+void ChildProcessPool::startPendingJobs()
+{
+    while (! threadShouldExit())
+    {
+        ScopedPointer<Job> job;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (pendingJobs.isEmpty() || runningJobs.size() >= maxNumRunning)
+                return;
+
+            job = pendingJobs.removeAndReturn (0);
+        }
+
+        ScopedPointer<RunningJob> r (new RunningJob (*job));
+
+        if (r->process.start (r->job.arguments, r->job.streamFlags))
+        {
+            const ScopedLock sl (lock);
+            runningJobs.add (r.release());
+        }
+        else
+        {
+            if (r->job.onFinished != nullptr)
+                r->job.onFinished (false, 0);
+
+            jobFinished.signal();
+        }
+    }
+}
+
+bool ChildProcessPool::serviceRunningJobs()
+{
+    char buffer[8192];
+    bool anythingHappened = false;
+
+    for (int i = runningJobs.size(); --i >= 0;)
+    {
+        auto* r = runningJobs.getUnchecked (i);
+
+        // This is checked before reading, so that anything written just before the
+        // process exited will still be read
+        auto stillRunning = r->process.isRunning();
+
+        // (a limit on the number of reads stops one very chatty process starving the others)
+        for (int numReads = 0; numReads < 16 || ! stillRunning; ++numReads)
+        {
+            auto num = r->process.readAvailableOutput (buffer, (int) sizeof (buffer));
+
+            if (num <= 0)
+                break;
+
+            anythingHappened = true;
+
+            if (r->job.onOutput != nullptr)
+                r->job.onOutput (buffer, num);
+        }
+
+        if (! stillRunning)
+        {
+            ScopedPointer<RunningJob> finishedJob;
+
+            {
+                const ScopedLock sl (lock);
+                finishedJob = runningJobs.removeAndReturn (i);
+            }
+
+            if (finishedJob->job.onFinished != nullptr)
+                finishedJob->job.onFinished (true, finishedJob->process.getExitCode());
+
+            anythingHappened = true;
+            jobFinished.signal();
+        }
+    }
+
+    return anythingHappened;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_MAC || JUCE_LINUX)
+
+class ChildProcessPoolTests  : public UnitTest
+{
+public:
+    ChildProcessPoolTests() : UnitTest ("ChildProcessPool", "Threads") {}
+
+    void runTest() override
+    {
+        beginTest ("Running many processes");
+        {
+            const int numJobs = 40;
+            ChildProcessPool pool (6);
+
+            CriticalSection resultsLock;
+            StringArray outputs;
+            Array<int> exitCodes;
+            exitCodes.insertMultiple (0, -1, numJobs);
+
+            for (int i = 0; i < numJobs; ++i)
+                outputs.add ({});
+            Atomic<int> maxRunning;
+
+            for (int i = 0; i < numJobs; ++i)
+            {
+                ChildProcessPool::Job job;
+                job.arguments = StringArray ({ "sh", "-c", "echo job " + String (i) + "; exit " + String (i % 5) });
+
+                job.onOutput = [&, i] (const char* data, int numBytes)
+                {
+                    const ScopedLock sl (resultsLock);
+                    outputs.getReference (i) += String::fromUTF8 (data, numBytes);
+                };
+
+                job.onFinished = [&, i] (bool started, uint32 exitCode)
+                {
+                    expect (started);
+                    const ScopedLock sl (resultsLock);
+                    exitCodes.set (i, (int) exitCode);
+                };
+
+                pool.addJob (job);
+            }
+
+            for (int i = 0; i < 100 && pool.getNumRunningJobs() + pool.getNumPendingJobs() > 0; ++i)
+            {
+                expect (pool.getNumRunningJobs() <= 6);
+                Thread::sleep (5);
+            }
+
+            expect (pool.waitForAllJobs (30000));
+
+            for (int i = 0; i < numJobs; ++i)
+            {
+                expectEquals (outputs[i], "job " + String (i) + "\n");
+                expectEquals (exitCodes[i], i % 5);
+            }
+        }
+
+        beginTest ("Processes that can't be started");
+        {
+            ChildProcessPool pool;
+            bool wasStarted = true;
+
+            ChildProcessPool::Job job;
+            job.arguments = StringArray ("a_command_that_really_does_not_exist_anywhere");
+            job.onFinished = [&] (bool started, uint32) { wasStarted = started; };
+            pool.addJob (job);
+
+            expect (pool.waitForAllJobs (10000));
+            expect (! wasStarted);
+        }
+
+        beginTest ("Cancelling");
+        {
+            ChildProcessPool pool (1);
+            Atomic<int> numFinished;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                ChildProcessPool::Job job;
+                job.arguments = StringArray ({ "sleep", "10" });
+                job.onFinished = [&] (bool, uint32) { ++numFinished; };
+                pool.addJob (job);
+            }
+
+            while (pool.getNumRunningJobs() == 0)
+                Thread::sleep (1);
+
+            auto startTime = Time::getMillisecondCounter();
+            pool.cancelAllJobs (true);
+
+            expect (pool.waitForAllJobs (5000));
+            expect (Time::getMillisecondCounter() - startTime < 5000);
+            expectEquals (numFinished.get(), 1);
+            expectEquals (pool.getNumPendingJobs(), 0);
+        }
+    }
+};
+
+static ChildProcessPoolTests childProcessPoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs a queue of child processes, keeping a given number of them running at once,
+    and streams their output back through callbacks.
+
+    A single background thread launches the processes and watches all of them, reading
+    their output without blocking as soon as it arrives. This makes it much cheaper
+    than having a thread per process when you need to run hundreds of them, e.g. for
+    scanning plugins out-of-process or running build tools.
+
+    @code
+    ChildProcessPool pool (8);
+
+    for (auto& file : filesToCheck)
+    {
+        ChildProcessPool::Job job;
+        job.arguments = { checkerExe, file.getFullPathName() };
+        job.onOutput = [] (const char* data, int numBytes) { ... };
+        job.onFinished = [] (bool started, uint32 exitCode) { ... };
+        pool.addJob (job);
+    }
+
+    pool.waitForAllJobs (-1);
+    @endcode
+
+    @see ChildProcess
+*/
+class JUCE_API  ChildProcessPool  : private Thread
+{
+public:
+    //==============================================================================
+    /** Describes a process for the pool to run. */
+    struct Job
+    {
+        /** The executable, followed by its arguments. */
+        StringArray arguments;
+
+        /** Which of the process's output streams should be captured - this is a
+            combination of ChildProcess::StreamFlags values.
+        */
+        int streamFlags = ChildProcess::wantStdOut | ChildProcess::wantStdErr;
+
+        /** Called on the pool's thread with each chunk of output as it arrives. */
+        std::function<void (const char* data, int numBytes)> onOutput;
+
+        /** Called on the pool's thread when the process has finished. If it couldn't
+            be launched, started will be false.
+        */
+        std::function<void (bool started, uint32 exitCode)> onFinished;
+    };
+
+    //==============================================================================
+    /** Creates a pool which runs up to the given number of processes at once. */
+    explicit ChildProcessPool (int maxNumConcurrentProcesses = SystemStats::getNumCpus());
+
+    /** Destructor.
+        Any jobs that haven't been started are thrown away, and any processes that are
+        still running are killed.
+    */
+    ~ChildProcessPool();
+
+    //==============================================================================
+    /** Adds a job to the queue. It'll be launched as soon as there's a free slot. */
+    void addJob (const Job& job);
+
+    /** Removes any jobs that haven't been started yet, and optionally kills the
+        processes that are running. Jobs that are removed don't get their onFinished
+        callback called.
+    */
+    void cancelAllJobs (bool killRunningProcesses);
+
+    /** Waits until all the jobs have finished.
+        @returns false if the timeout expired first
+    */
+    bool waitForAllJobs (int timeoutMs);
+
+    /** Returns the number of processes that are currently running. */
+    int getNumRunningJobs() const;
+
+    /** Returns the number of jobs that are waiting to be started. */
+    int getNumPendingJobs() const;
+
+private:
+    //==============================================================================
+    struct RunningJob;
+
+    const int maxNumRunning;
+    CriticalSection lock;
+    OwnedArray<Job> pendingJobs;
+    OwnedArray<RunningJob> runningJobs;
+    WaitableEvent jobFinished;
+    bool killRunningJobs = false;
+
+    void run() override;
+    void startPendingJobs();
+    bool serviceRunningJobs();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPool)
+};
+
+} // namespace juce
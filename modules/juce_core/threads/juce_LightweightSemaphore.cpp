@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+LightweightSemaphore::LightweightSemaphore (int initialCount) noexcept
+    : count (initialCount)
+{
+    jassert (initialCount >= 0);
+}
+
+LightweightSemaphore::~LightweightSemaphore() noexcept {}
+
+bool LightweightSemaphore::tryWait() noexcept
+{
+    auto oldCount = count.load (std::memory_order_relaxed);
+
+    while (oldCount > 0)
+        if (count.compare_exchange_weak (oldCount, oldCount - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+
+    return false;
+}
+
+bool LightweightSemaphore::wait (int timeOutMilliseconds) noexcept
+{
+    if (tryWait())
+        return true;
+
+    if (timeOutMilliseconds == 0)
+        return false;
+
+    JUCE_REALTIME_SAFETY_CHECK (waitedOnEvent);
+
+    auto endTime = Time::getMillisecondCounterHiRes() + timeOutMilliseconds;
+    ++numWaiters;
+
+    for (;;)
+    {
+        // this only sleeps if the count is still zero, so can't miss a signal() that
+        // happens after the tryWait() below has failed
+        if (timeOutMilliseconds < 0)
+        {
+            AddressWait::wait (count, 0, -1);
+        }
+        else
+        {
+            auto millisecsLeft = endTime - Time::getMillisecondCounterHiRes();
+
+            if (millisecsLeft <= 0)
+                break;
+
+            AddressWait::wait (count, 0, jmax (1, roundToInt (millisecsLeft)));
+        }
+
+        if (tryWait())
+        {
+            --numWaiters;
+            return true;
+        }
+    }
+
+    --numWaiters;
+    return tryWait();
+}
+
+void LightweightSemaphore::signal (int amount) noexcept
+{
+    jassert (amount >= 0);
+
+    if (amount <= 0)
+        return;
+
+    count += amount;
+
+    if (numWaiters.load() > 0)
+    {
+        if (amount == 1)
+            AddressWait::wakeOne (count);
+        else
+            AddressWait::wakeAll (count);
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LightweightSemaphoreTests  : public UnitTest
+{
+public:
+    LightweightSemaphoreTests() : UnitTest ("LightweightSemaphore", "Threads") {}
+
+    void runTest() override
+    {
+        beginTest ("Counting");
+        {
+            LightweightSemaphore s (2);
+
+            expect (s.tryWait());
+            expect (s.wait (0));
+            expect (! s.tryWait());
+
+            s.signal (3);
+            expectEquals (s.getCount(), 3);
+            expect (s.wait());
+            expectEquals (s.getCount(), 2);
+        }
+
+        beginTest ("Timeout");
+        {
+            LightweightSemaphore s;
+
+            auto start = Time::getMillisecondCounterHiRes();
+            expect (! s.wait (20));
+            expect (Time::getMillisecondCounterHiRes() - start >= 19.0);
+        }
+
+        beginTest ("Waking threads");
+        {
+            LightweightSemaphore jobs, finished;
+            Atomic<int> numJobsDone;
+            const int numThreads = 4, numJobs = 1000;
+
+            OwnedArray<Thread> threads;
+
+            for (int i = 0; i < numThreads; ++i)
+                threads.add (new WorkerThread (jobs, finished, numJobsDone));
+
+            for (auto* t : threads)
+                t->startThread (0);
+
+            for (int i = 0; i < numJobs; ++i)
+            {
+                jobs.signal();
+
+                if ((i & 15) == 0)
+                    Thread::yield(); // gives the workers a chance to go to sleep again
+            }
+
+            for (int i = 0; i < numJobs; ++i)
+                expect (finished.wait (10000));
+
+            expectEquals (numJobsDone.get(), numJobs);
+
+            for (auto* t : threads)
+                t->signalThreadShouldExit();
+
+            jobs.signal (numThreads);
+
+            for (auto* t : threads)
+                expect (t->waitForThreadToExit (5000));
+
+            expect (! finished.tryWait());
+        }
+    }
+
+    struct WorkerThread  : public Thread
+    {
+        WorkerThread (LightweightSemaphore& j, LightweightSemaphore& f, Atomic<int>& n)
+            : Thread ("LightweightSemaphore test"), jobs (j), finished (f), numJobsDone (n) {}
+
+        void run() override
+        {
+            for (;;)
+            {
+                jobs.wait();
+
+                if (threadShouldExit())
+                    return;
+
+                ++numJobsDone;
+                finished.signal();
+            }
+        }
+
+        LightweightSemaphore& jobs;
+        LightweightSemaphore& finished;
+        Atomic<int>& numJobsDone;
+    };
+};
+
+static LightweightSemaphoreTests lightweightSemaphoreTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A counting semaphore that only involves the OS when a thread actually has to sleep.
+
+    The semaphore holds a count, which signal() increases, and wait() decreases, waiting
+    for another thread to signal it if the count is zero. While the count is above zero,
+    or nothing is waiting, both calls are just an atomic operation or two, so this is a
+    cheap way to hand out work to a set of worker threads: add the jobs to a queue, and
+    signal the semaphore once for each of them.
+
+    When a thread does have to sleep, it uses the OS's lightest primitive for waiting on
+    a memory address: a futex on Linux and Android, __ulock_wait on macOS and iOS, or
+    WaitOnAddress on Windows, with a fallback for older systems.
+
+    @see WaitableEvent
+*/
+class JUCE_API  LightweightSemaphore
+{
+public:
+    //==============================================================================
+    /** Creates a semaphore with a given initial count. */
+    explicit LightweightSemaphore (int initialCount = 0) noexcept;
+
+    /** Destructor.
+        If other threads are waiting on this object when it gets deleted, this
+        can cause nasty errors, so be careful!
+    */
+    ~LightweightSemaphore() noexcept;
+
+    //==============================================================================
+    /** Decrements the count, first waiting for it to be above zero if it isn't already.
+
+        @param timeOutMilliseconds  the maximum time to wait, in milliseconds. A negative
+                                    value will cause it to wait forever.
+        @returns    true if the count was decremented, or false if the timeout expired first
+    */
+    bool wait (int timeOutMilliseconds = -1) noexcept;
+
+    /** Decrements the count if it's above zero, returning true if it was, without waiting. */
+    bool tryWait() noexcept;
+
+    /** Increases the count, waking up as many waiting threads as it can satisfy. */
+    void signal (int amount = 1) noexcept;
+
+    /** Returns the current count.
+        By the time this returns, other threads may already have changed it, so it's only
+        really useful for debugging and statistics.
+    */
+    int getCount() const noexcept                   { return count.load(); }
+
+private:
+    //==============================================================================
+    std::atomic<int32> count, numWaiters { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (LightweightSemaphore)
+};
+
+} // namespace juce
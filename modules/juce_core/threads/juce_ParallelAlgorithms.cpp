@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+int ParallelAlgorithms::getGrainSize (int numItems, int numThreads, int minGrainSize) noexcept
+{
+    jassert (minGrainSize > 0);
+
+    // A few chunks per thread lets the threads even out the load when some chunks
+    // take longer than others, without making the chunks so small that the cost of
+    // handing them out starts to matter.
+    auto numChunksWanted = jmax (1, numThreads) * 4;
+
+    return jmax (jmax (1, minGrainSize), numItems / numChunksWanted + (numItems % numChunksWanted != 0 ? 1 : 0));
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelAlgorithmsTests  : public UnitTest
+{
+public:
+    ParallelAlgorithmsTests() : UnitTest ("ParallelAlgorithms", "Threads") {}
+
+    struct Item
+    {
+        int key, originalIndex;
+    };
+
+    struct KeyComparator
+    {
+        static int compareElements (const Item& a, const Item& b) noexcept   { return a.key - b.key; }
+    };
+
+    struct TestBuffer
+    {
+        TestBuffer (int channels, int samples) : numChannels (channels), numSamples (samples), data ((size_t) (channels * samples), true) {}
+
+        int getNumChannels() const noexcept      { return numChannels; }
+        int getNumSamples() const noexcept       { return numSamples; }
+        float* getWritePointer (int channel)     { return data + channel * numSamples; }
+
+        int numChannels, numSamples;
+        HeapBlock<float> data;
+    };
+
+    void runTest() override
+    {
+        WorkStealingScheduler scheduler (3, 0);
+        auto r = getRandom();
+
+        beginTest ("Grain size");
+        {
+            expectEquals (ParallelAlgorithms::getGrainSize (100, 4, 1000), 1000);
+            expectEquals (ParallelAlgorithms::getGrainSize (16000, 4, 100), 1000);
+            expectEquals (ParallelAlgorithms::getGrainSize (16001, 4, 100), 1001);
+            expectEquals (ParallelAlgorithms::getGrainSize (0, 4, 10), 10);
+        }
+
+        beginTest ("forEach");
+        {
+            for (auto size : { 0, 1, 100, 10000, 54321 })
+            {
+                HeapBlock<int> data ((size_t) size + 1, true);
+                ParallelAlgorithms::forEach (scheduler, data.getData(), size, [] (int& i) { ++i; }, 64);
+
+                bool allDone = true;
+
+                for (int i = 0; i < size; ++i)
+                    allDone = allDone && data[i] == 1;
+
+                expect (allDone);
+                expectEquals (data[size], 0);
+
+                Array<int> array;
+
+                for (int i = 0; i < size; ++i)
+                    array.add (i);
+
+                ParallelAlgorithms::forEach (scheduler, array, [] (int& i) { i *= 2; }, 100);
+
+                for (int i = 0; i < size; ++i)
+                    allDone = allDone && array.getUnchecked (i) == i * 2;
+
+                expect (allDone);
+            }
+        }
+
+        beginTest ("forRange covers every item exactly once");
+        {
+            const int size = 100000;
+            HeapBlock<Atomic<int>> counts ((size_t) size, true);
+
+            ParallelAlgorithms::forRange (scheduler, size, [&] (int start, int end)
+            {
+                expect (start < end);
+
+                for (int i = start; i < end; ++i)
+                    ++counts[i];
+            }, 10);
+
+            int numWrong = 0;
+
+            for (int i = 0; i < size; ++i)
+                if (counts[i].get() != 1)
+                    ++numWrong;
+
+            expectEquals (numWrong, 0);
+        }
+
+        beginTest ("forEachChannel");
+        {
+            TestBuffer buffer (8, 3000);
+
+            ParallelAlgorithms::forEachChannel (scheduler, buffer, [] (int channel, float* samples, int numSamples)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    samples[i] = (float) channel;
+            });
+
+            for (int channel = 0; channel < 8; ++channel)
+            {
+                expectEquals (buffer.getWritePointer (channel)[0], (float) channel);
+                expectEquals (buffer.getWritePointer (channel)[buffer.numSamples - 1], (float) channel);
+            }
+        }
+
+        beginTest ("reduce");
+        {
+            for (auto size : { 0, 1, 100, 10000, 123457 })
+            {
+                Array<int> array;
+                int64 expected = 0;
+
+                for (int i = 0; i < size; ++i)
+                {
+                    array.add (r.nextInt (1000) - 500);
+                    expected += array.getLast();
+                }
+
+                expectEquals (ParallelAlgorithms::reduce (scheduler, array, (int64) 0,
+                                                          [] (int64 total, int v) { return total + v; },
+                                                          [] (int64 a, int64 b) { return a + b; }, 100),
+                              expected);
+
+                expectEquals (ParallelAlgorithms::reduce (scheduler, array.begin(), size, (int64) 0, std::plus<int64>(), 100),
+                              expected);
+
+                auto maxValue = ParallelAlgorithms::reduce (scheduler, array, -1000, [] (int a, int b) { return jmax (a, b); }, 100);
+                expectEquals (maxValue, size > 0 ? *std::max_element (array.begin(), array.end()) : -1000);
+            }
+        }
+
+        beginTest ("reduceRange is deterministic");
+        {
+            HeapBlock<float> data (100000);
+
+            for (int i = 0; i < 100000; ++i)
+                data[i] = r.nextFloat() * 1000.0f;
+
+            auto sum = [&]
+            {
+                return ParallelAlgorithms::reduceRange (scheduler, 100000, 0.0f,
+                                                        [&] (int start, int end)
+                                                        {
+                                                            float total = 0;
+
+                                                            for (int i = start; i < end; ++i)
+                                                                total += data[i];
+
+                                                            return total;
+                                                        },
+                                                        [] (float a, float b) { return a + b; }, 500);
+            };
+
+            auto first = sum();
+
+            for (int i = 0; i < 10; ++i)
+                expect (sum() == first);
+        }
+
+        beginTest ("sort");
+        {
+            for (auto size : { 0, 1, 2, 100, 1000, 33333, 100000 })
+            {
+                Array<int> array;
+
+                for (int i = 0; i < size; ++i)
+                    array.add (r.nextInt (size / 2 + 1));
+
+                auto expected = array;
+                expected.sort();
+
+                ParallelAlgorithms::sort (scheduler, array);
+                expect (array == expected);
+
+                auto data = expected;
+
+                for (int i = size; --i > 0;)
+                    data.swap (i, r.nextInt (i + 1));
+
+                DefaultElementComparator<int> comparator;
+                ParallelAlgorithms::sort (scheduler, data.begin(), size, comparator, false, 50);
+                expect (data == expected);
+            }
+        }
+
+        beginTest ("Stable sort");
+        {
+            const int size = 50000;
+            Array<Item> items;
+
+            for (int i = 0; i < size; ++i)
+                items.add ({ r.nextInt (100), i });
+
+            KeyComparator comparator;
+            ParallelAlgorithms::sort (scheduler, items, comparator, true, 100);
+
+            bool isStable = true;
+
+            for (int i = 1; i < size; ++i)
+            {
+                auto& a = items.getReference (i - 1);
+                auto& b = items.getReference (i);
+                isStable = isStable && (a.key < b.key || (a.key == b.key && a.originalIndex < b.originalIndex));
+            }
+
+            expect (isStable);
+        }
+
+        beginTest ("Sorting strings");
+        {
+            StringArray strings;
+
+            for (int i = 0; i < 20000; ++i)
+                strings.add (String::toHexString (r.nextInt()));
+
+            auto expected = strings;
+            expected.sortNatural();
+
+            struct NaturalComparator
+            {
+                static int compareElements (const String& a, const String& b) noexcept   { return a.compareNatural (b); }
+            };
+
+            NaturalComparator comparator;
+            ParallelAlgorithms::sort (scheduler, strings.begin(), strings.size(), comparator, false, 200);
+            expect (strings == expected);
+        }
+
+        beginTest ("Calling from inside a task");
+        {
+            Array<int> results;
+            results.insertMultiple (0, 0, 16);
+
+            WorkStealingScheduler::TaskGroup group;
+            OwnedArray<WorkStealingScheduler::FunctionTask> tasks;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                tasks.add (new WorkStealingScheduler::FunctionTask ([&, i]
+                {
+                    HeapBlock<int> data (10000);
+
+                    for (int j = 0; j < 10000; ++j)
+                        data[j] = j;
+
+                    results.set (i, ParallelAlgorithms::reduce (scheduler, data.getData(), 10000, 0, std::plus<int>(), 100));
+                }));
+
+                scheduler.submit (*tasks.getLast(), &group);
+            }
+
+            scheduler.wait (group);
+
+            for (auto result : results)
+                expectEquals (result, 49995000);
+        }
+    }
+};
+
+static ParallelAlgorithmsTests parallelAlgorithmsTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,468 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Some parallel versions of common array operations, which split the work up
+    between the threads of a WorkStealingScheduler.
+
+    The data is divided into chunks, and the scheduler's workers and the calling
+    thread take chunks until there are none left, so a slow chunk doesn't hold up
+    the others. The chunk size is picked by getGrainSize(): there are enough chunks
+    to keep all the threads busy, but none of them is smaller than the minimum grain
+    size you give. If the whole input would fit into a single chunk, the operation
+    just runs serially on the calling thread, so there's no overhead for small arrays.
+
+    E.g.
+    @code
+    WorkStealingScheduler scheduler;
+
+    ParallelAlgorithms::sort (scheduler, events);
+
+    ParallelAlgorithms::forEach (scheduler, samples.getData(), numSamples,
+                                 [] (float& s) { s = std::tanh (s); });
+
+    auto total = ParallelAlgorithms::reduce (scheduler, levels.getData(), numLevels,
+                                             0.0, [] (double sum, float v) { return sum + v; },
+                                                  [] (double a, double b) { return a + b; });
+    @endcode
+
+    All of these functions wait until the work is finished before returning, and the
+    calling thread helps out while it waits, so they can be called from inside
+    another WorkStealingScheduler task. The functions you pass in will be called on
+    several threads at once, so they must be thread-safe, and they mustn't throw
+    exceptions. These functions allocate memory, so don't use them on a realtime thread.
+
+    @see WorkStealingScheduler
+*/
+struct ParallelAlgorithms
+{
+    //==============================================================================
+    enum
+    {
+        /** The default minimum number of items that forEach() and reduce() will give to each task. */
+        defaultGrainSize = 4096,
+
+        /** The default minimum number of elements that sort() will give to each task. */
+        defaultSortGrainSize = 16384
+    };
+
+    /** Returns the number of items that each chunk of work should contain.
+
+        This aims for a few chunks per thread, so that the threads can balance the load
+        between them, but never returns less than minGrainSize. If the result is at
+        least numItems, the work should be done serially.
+    */
+    static int getGrainSize (int numItems, int numThreads, int minGrainSize) noexcept;
+
+    //==============================================================================
+    /** Calls a function for a set of sub-ranges that together cover the range 0 to numItems.
+
+        The function must have the form:
+        @code
+        void myFunction (int startIndex, int endIndex);   // endIndex is exclusive
+        @endcode
+    */
+    template <typename RangeFunction>
+    static void forRange (WorkStealingScheduler& scheduler, int numItems,
+                          RangeFunction&& function, int minGrainSize = defaultGrainSize)
+    {
+        runInChunks (scheduler, numItems, getGrainSize (numItems, scheduler.getNumWorkers() + 1, minGrainSize), function);
+    }
+
+    /** Calls a function for each index from 0 to numItems - 1.
+
+        The function must have the form:
+        @code
+        void myFunction (int index);
+        @endcode
+    */
+    template <typename IndexFunction>
+    static void forEach (WorkStealingScheduler& scheduler, int numItems,
+                         IndexFunction&& function, int minGrainSize = defaultGrainSize)
+    {
+        forRange (scheduler, numItems, [&function] (int start, int end)
+        {
+            for (int i = start; i < end; ++i)
+                function (i);
+        }, minGrainSize);
+    }
+
+    /** Calls a function for each element of a block of data, e.g. a HeapBlock.
+
+        The function must have the form:
+        @code
+        void myFunction (ElementType& element);
+        @endcode
+    */
+    template <typename ElementType, typename ElementFunction>
+    static void forEach (WorkStealingScheduler& scheduler, ElementType* data, int numElements,
+                         ElementFunction&& function, int minGrainSize = defaultGrainSize)
+    {
+        forRange (scheduler, numElements, [data, &function] (int start, int end)
+        {
+            for (int i = start; i < end; ++i)
+                function (data[i]);
+        }, minGrainSize);
+    }
+
+    /** Calls a function for each element of an Array.
+        The array is locked while this runs.
+        @see forEach
+    */
+    template <typename ElementType, typename CriticalSectionType, int minimumAllocatedSize, typename ElementFunction>
+    static void forEach (WorkStealingScheduler& scheduler, Array<ElementType, CriticalSectionType, minimumAllocatedSize>& array,
+                         ElementFunction&& function, int minGrainSize = defaultGrainSize)
+    {
+        const typename Array<ElementType, CriticalSectionType, minimumAllocatedSize>::ScopedLockType lock (array.getLock());
+        forEach (scheduler, array.begin(), array.size(), function, minGrainSize);
+    }
+
+    /** Calls a function for each channel of an audio buffer.
+
+        This works with AudioBuffer, or any other class that has getNumChannels(),
+        getNumSamples() and getWritePointer (int channel) methods. The function must
+        have the form:
+        @code
+        void myFunction (int channel, SampleType* channelData, int numSamples);
+        @endcode
+
+        Each task is given enough channels to cover at least minSamplesPerTask samples,
+        so short buffers are processed serially.
+    */
+    template <typename BufferType, typename ChannelFunction>
+    static void forEachChannel (WorkStealingScheduler& scheduler, BufferType& buffer,
+                                ChannelFunction&& function, int minSamplesPerTask = defaultGrainSize)
+    {
+        auto numSamples = buffer.getNumSamples();
+
+        forEach (scheduler, buffer.getNumChannels(), [&] (int channel)
+        {
+            function (channel, buffer.getWritePointer (channel), numSamples);
+        }, jmax (1, minSamplesPerTask / jmax (1, numSamples)));
+    }
+
+    //==============================================================================
+    /** Combines the results of a function that is called for a set of sub-ranges of 0 to numItems.
+
+        The range function must have the form:
+        @code
+        ResultType reduceRange (int startIndex, int endIndex);   // endIndex is exclusive
+        @endcode
+
+        ..and the results of the sub-ranges are then combined with:
+        @code
+        ResultType combine (ResultType a, ResultType b);
+        @endcode
+
+        The partial results are always combined in order, starting from the identity value,
+        so if you use the same grain size and number of threads, floating-point sums will
+        give the same answer each time.
+
+        @param identity     a value that doesn't change the result when it's combined with
+                            another, e.g. 0 for a sum, or 1 for a product
+    */
+    template <typename ResultType, typename RangeFunction, typename CombineFunction>
+    static ResultType reduceRange (WorkStealingScheduler& scheduler, int numItems, ResultType identity,
+                                   RangeFunction&& reduceRangeFunction, CombineFunction&& combine,
+                                   int minGrainSize = defaultGrainSize)
+    {
+        auto grainSize = getGrainSize (numItems, scheduler.getNumWorkers() + 1, minGrainSize);
+
+        if (numItems <= 0)
+            return identity;
+
+        if (grainSize >= numItems)
+            return combine (identity, reduceRangeFunction (0, numItems));
+
+        std::vector<ResultType> partialResults ((size_t) getNumChunks (numItems, grainSize), identity);
+
+        runInChunks (scheduler, numItems, grainSize, [&] (int start, int end)
+        {
+            partialResults[(size_t) (start / grainSize)] = reduceRangeFunction (start, end);
+        });
+
+        for (auto& r : partialResults)
+            identity = combine (identity, r);
+
+        return identity;
+    }
+
+    /** Combines all the elements of a block of data, e.g. a HeapBlock.
+
+        Each task starts from the identity value and adds its elements with:
+        @code
+        ResultType accumulate (ResultType total, const ElementType& element);
+        @endcode
+
+        ..and then the tasks' results are combined in order with:
+        @code
+        ResultType combine (ResultType a, ResultType b);
+        @endcode
+
+        @see reduceRange
+    */
+    template <typename ElementType, typename ResultType, typename AccumulateFunction, typename CombineFunction>
+    static ResultType reduce (WorkStealingScheduler& scheduler, const ElementType* data, int numElements,
+                              ResultType identity, AccumulateFunction&& accumulate, CombineFunction&& combine,
+                              int minGrainSize = defaultGrainSize)
+    {
+        return reduceRange (scheduler, numElements, identity, [&] (int start, int end)
+        {
+            auto total = identity;
+
+            for (int i = start; i < end; ++i)
+                total = accumulate (total, data[i]);
+
+            return total;
+        }, combine, minGrainSize);
+    }
+
+    /** Combines all the elements of a block of data, using the same function to add each
+        element and to combine the tasks' results, e.g. std::plus<>() for a sum.
+        @see reduceRange
+    */
+    template <typename ElementType, typename ResultType, typename CombineFunction>
+    static ResultType reduce (WorkStealingScheduler& scheduler, const ElementType* data, int numElements,
+                              ResultType identity, CombineFunction&& combine, int minGrainSize = defaultGrainSize)
+    {
+        return reduce (scheduler, data, numElements, identity, combine, combine, minGrainSize);
+    }
+
+    /** Combines all the elements of an Array.
+        The array is locked while this runs.
+        @see reduceRange
+    */
+    template <typename ElementType, typename CriticalSectionType, int minimumAllocatedSize,
+              typename ResultType, typename AccumulateFunction, typename CombineFunction>
+    static ResultType reduce (WorkStealingScheduler& scheduler, const Array<ElementType, CriticalSectionType, minimumAllocatedSize>& array,
+                              ResultType identity, AccumulateFunction&& accumulate, CombineFunction&& combine,
+                              int minGrainSize = defaultGrainSize)
+    {
+        const typename Array<ElementType, CriticalSectionType, minimumAllocatedSize>::ScopedLockType lock (array.getLock());
+        return reduce (scheduler, array.begin(), array.size(), identity, accumulate, combine, minGrainSize);
+    }
+
+    /** Combines all the elements of an Array, using the same function to add each element
+        and to combine the tasks' results.
+        The array is locked while this runs.
+        @see reduceRange
+    */
+    template <typename ElementType, typename CriticalSectionType, int minimumAllocatedSize,
+              typename ResultType, typename CombineFunction>
+    static ResultType reduce (WorkStealingScheduler& scheduler, const Array<ElementType, CriticalSectionType, minimumAllocatedSize>& array,
+                              ResultType identity, CombineFunction&& combine, int minGrainSize = defaultGrainSize)
+    {
+        return reduce (scheduler, array, identity, combine, combine, minGrainSize);
+    }
+
+    //==============================================================================
+    /** Sorts a block of data, e.g. a HeapBlock.
+
+        Each task sorts a chunk of the data, and then the sorted chunks are merged
+        together in pairs. The comparator works in the same way as for sortArray(), but
+        it'll be called on several threads at once, so its compareElements() method must
+        be thread-safe.
+
+        The elements must be move-constructible and move-assignable.
+
+        @see sortArray, Array::sort
+    */
+    template <typename ElementType, typename ElementComparator>
+    static void sort (WorkStealingScheduler& scheduler, ElementType* data, int numElements,
+                      ElementComparator& comparator, bool retainOrderOfEquivalentItems = false,
+                      int minGrainSize = defaultSortGrainSize)
+    {
+        ignoreUnused (comparator); // if you pass in an object with a static compareElements() method, this
+                                   // avoids getting warning messages about the parameter being unused
+
+        auto grainSize = getGrainSize (numElements, scheduler.getNumWorkers() + 1, minGrainSize);
+
+        if (grainSize >= numElements)
+        {
+            if (numElements > 1)
+                sortArray (comparator, data, 0, numElements - 1, retainOrderOfEquivalentItems);
+
+            return;
+        }
+
+        runInChunks (scheduler, numElements, grainSize, [&] (int start, int end)
+        {
+            sortArray (comparator, data, start, end - 1, retainOrderOfEquivalentItems);
+        });
+
+        // The merges go back and forth between the data and this buffer. Merging always takes
+        // the element from the earlier run when two are equivalent, so a stable sort stays stable.
+        std::vector<ElementType> buffer (std::make_move_iterator (data), std::make_move_iterator (data + numElements));
+        auto* source = buffer.data();
+        auto* dest = data;
+
+        for (int runLength = grainSize; runLength < numElements; runLength *= 2)
+        {
+            auto numPairs = getNumChunks (numElements, runLength * 2);
+
+            runInChunks (scheduler, numPairs, 1, [=, &comparator] (int firstPair, int endPair)
+            {
+                for (int pair = firstPair; pair < endPair; ++pair)
+                {
+                    auto start = pair * runLength * 2;
+                    auto middle = jmin (start + runLength, numElements);
+                    auto end = jmin (middle + runLength, numElements);
+
+                    mergeRuns (comparator, source + start, source + middle, source + end, dest + start);
+                }
+            });
+
+            std::swap (source, dest);
+        }
+
+        if (source != data)
+        {
+            runInChunks (scheduler, numElements, grainSize, [=] (int start, int end)
+            {
+                std::move (source + start, source + end, data + start);
+            });
+        }
+    }
+
+    /** Sorts an Array using a comparator.
+        The array is locked while it's being sorted.
+        @see Array::sort
+    */
+    template <typename ElementType, typename CriticalSectionType, int minimumAllocatedSize, typename ElementComparator>
+    static void sort (WorkStealingScheduler& scheduler, Array<ElementType, CriticalSectionType, minimumAllocatedSize>& array,
+                      ElementComparator& comparator, bool retainOrderOfEquivalentItems = false,
+                      int minGrainSize = defaultSortGrainSize)
+    {
+        const typename Array<ElementType, CriticalSectionType, minimumAllocatedSize>::ScopedLockType lock (array.getLock());
+        sort (scheduler, array.begin(), array.size(), comparator, retainOrderOfEquivalentItems, minGrainSize);
+    }
+
+    /** Sorts an Array using a DefaultElementComparator.
+        The array is locked while it's being sorted.
+        @see Array::sort
+    */
+    template <typename ElementType, typename CriticalSectionType, int minimumAllocatedSize>
+    static void sort (WorkStealingScheduler& scheduler, Array<ElementType, CriticalSectionType, minimumAllocatedSize>& array)
+    {
+        DefaultElementComparator<ElementType> comparator;
+        sort (scheduler, array, comparator);
+    }
+
+private:
+    //==============================================================================
+    static int getNumChunks (int numItems, int grainSize) noexcept
+    {
+        return (numItems + grainSize - 1) / grainSize;
+    }
+
+    // The calling thread and up to one helper task per worker all take chunks from
+    // a shared counter until they run out.
+    template <typename RangeFunction>
+    struct ChunkRunner
+    {
+        ChunkRunner (int items, int grain, RangeFunction& f) noexcept
+            : numItems (items), grainSize (grain), numChunks (getNumChunks (items, grain)), function (f) {}
+
+        void runChunks()
+        {
+            for (;;)
+            {
+                auto chunk = nextChunk++;
+
+                if (chunk >= numChunks)
+                    return;
+
+                auto start = chunk * grainSize;
+                function (start, jmin (start + grainSize, numItems));
+            }
+        }
+
+        struct HelperTask  : public WorkStealingScheduler::Task
+        {
+            HelperTask (ChunkRunner& r) noexcept : runner (r) {}
+            void run() override     { runner.runChunks(); }
+
+            ChunkRunner& runner;
+        };
+
+        const int numItems, grainSize, numChunks;
+        RangeFunction& function;
+        std::atomic<int> nextChunk { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (ChunkRunner)
+    };
+
+    template <typename RangeFunction>
+    static void runInChunks (WorkStealingScheduler& scheduler, int numItems, int grainSize, RangeFunction&& function)
+    {
+        if (numItems <= 0)
+            return;
+
+        if (grainSize >= numItems)
+        {
+            function (0, numItems);
+            return;
+        }
+
+        using Runner = ChunkRunner<typename std::remove_reference<RangeFunction>::type>;
+        Runner runner (numItems, grainSize, function);
+
+        OwnedArray<typename Runner::HelperTask> helpers;
+
+        for (int i = jmin (runner.numChunks - 1, scheduler.getNumWorkers()); --i >= 0;)
+            helpers.add (new typename Runner::HelperTask (runner));
+
+        WorkStealingScheduler::TaskGroup group;
+
+        for (auto* h : helpers)
+            scheduler.submit (*h, &group);
+
+        runner.runChunks();
+        scheduler.wait (group);
+    }
+
+    template <typename ElementType, typename ElementComparator>
+    static void mergeRuns (ElementComparator& comparator, ElementType* first, ElementType* middle,
+                           ElementType* end, ElementType* dest)
+    {
+        auto* second = middle;
+
+        while (first < middle && second < end)
+        {
+            if (comparator.compareElements (*second, *first) < 0)
+                *dest++ = std::move (*second++);
+            else
+                *dest++ = std::move (*first++);
+        }
+
+        dest = std::move (first, middle, dest);
+        std::move (second, end, dest);
+    }
+
+    ParallelAlgorithms() = delete;
+};
+
+} // namespace juce
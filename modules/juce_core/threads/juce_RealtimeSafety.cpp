@@ -0,0 +1,421 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The state of each thread that's in a realtime context is kept in a fixed table,
+// because the checks are made from inside the allocator and locks, so finding it
+// mustn't allocate or lock anything itself. The depths are only ever touched by the
+// thread that owns the slot.
+struct RealtimeSafety::ThreadState
+{
+    std::atomic<Thread::ThreadID> threadId;
+    int realtimeDepth, exemptionDepth;
+};
+
+namespace RealtimeSafetyHelpers
+{
+    enum { maxThreads = 64 };
+
+    static std::atomic<int> numThreadStatesInUse { 0 };
+    static std::atomic<int> numViolations { 0 };
+
+    static void reportToDebugOutput (RealtimeSafety::ViolationType type, const String& stackTrace)
+    {
+        struct ReportedTraces
+        {
+            CriticalSection lock;
+            StringArray traces;
+        };
+
+        static ReportedTraces reported;
+        const ScopedLock sl (reported.lock);
+
+        if (reported.traces.contains (stackTrace))
+            return;
+
+        reported.traces.add (stackTrace);
+        Logger::outputDebugString ("*** Realtime safety violation: " + RealtimeSafety::getDescription (type)
+                                     + " on an audio thread" + newLine + stackTrace);
+    }
+
+    struct HandlerHolder
+    {
+        CriticalSection lock;
+        RealtimeSafety::ViolationHandler handler { reportToDebugOutput };
+    };
+
+    static HandlerHolder& getHandlerHolder()
+    {
+        static HandlerHolder holder;
+        return holder;
+    }
+}
+
+//==============================================================================
+String RealtimeSafety::getDescription (ViolationType type)
+{
+    switch (type)
+    {
+        case memoryAllocation:      return "memory allocation";
+        case memoryDeallocation:    return "memory deallocation";
+        case lockAcquired:          return "CriticalSection lock";
+        case waitedOnEvent:         return "WaitableEvent wait";
+        case messagePosted:         return "message posted to the message thread";
+        default:                    jassertfalse; return {};
+    }
+}
+
+void RealtimeSafety::setViolationHandler (ViolationHandler newHandler)
+{
+    auto& holder = RealtimeSafetyHelpers::getHandlerHolder();
+
+    if (newHandler == nullptr)
+        newHandler = RealtimeSafetyHelpers::reportToDebugOutput;
+
+    const ScopedLock sl (holder.lock);
+    std::swap (holder.handler, newHandler);
+}
+
+int RealtimeSafety::getNumViolations() noexcept
+{
+    return RealtimeSafetyHelpers::numViolations.load();
+}
+
+//==============================================================================
+RealtimeSafety::ThreadState* RealtimeSafety::getAllThreadStates() noexcept
+{
+    static ThreadState states[RealtimeSafetyHelpers::maxThreads] = {};
+    return states;
+}
+
+RealtimeSafety::ThreadState* RealtimeSafety::findStateForCurrentThread() noexcept
+{
+    using namespace RealtimeSafetyHelpers;
+
+    // this is the only cost for threads that have never been in a realtime context
+    if (numThreadStatesInUse.load (std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    auto threadId = Thread::getCurrentThreadId();
+    auto* states = getAllThreadStates();
+
+    for (int i = 0; i < maxThreads; ++i)
+        if (states[i].threadId.load (std::memory_order_relaxed) == threadId)
+            return states + i;
+
+    return nullptr;
+}
+
+RealtimeSafety::ThreadState* RealtimeSafety::getOrCreateStateForCurrentThread() noexcept
+{
+    using namespace RealtimeSafetyHelpers;
+
+    if (auto* existing = findStateForCurrentThread())
+        return existing;
+
+    auto threadId = Thread::getCurrentThreadId();
+    auto* states = getAllThreadStates();
+
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        Thread::ThreadID empty = nullptr;
+
+        if (states[i].threadId.compare_exchange_strong (empty, threadId))
+        {
+            states[i].realtimeDepth = 0;
+            states[i].exemptionDepth = 0;
+            ++numThreadStatesInUse;
+            return states + i;
+        }
+    }
+
+    // There are more threads in realtime contexts than this can keep track of,
+    // so this one won't be checked!
+    jassertfalse;
+    return nullptr;
+}
+
+void RealtimeSafety::releaseState (ThreadState* state) noexcept
+{
+    if (state->realtimeDepth == 0 && state->exemptionDepth == 0)
+    {
+        state->threadId = nullptr;
+        --RealtimeSafetyHelpers::numThreadStatesInUse;
+    }
+}
+
+bool RealtimeSafety::isInRealtimeContext() noexcept
+{
+    auto* state = findStateForCurrentThread();
+    return state != nullptr && state->realtimeDepth > 0;
+}
+
+void RealtimeSafety::check (ViolationType type) noexcept
+{
+    auto* state = findStateForCurrentThread();
+
+    if (state == nullptr || state->realtimeDepth == 0 || state->exemptionDepth > 0)
+        return;
+
+    ++RealtimeSafetyHelpers::numViolations;
+
+    // anything that the reporting does is exempt, or this would recurse
+    ++(state->exemptionDepth);
+
+    {
+        auto stackTrace = SystemStats::getStackBacktrace();
+        auto& holder = RealtimeSafetyHelpers::getHandlerHolder();
+        ViolationHandler handler;
+
+        {
+            const ScopedLock sl (holder.lock);
+            handler = holder.handler;
+        }
+
+        handler (type, stackTrace);
+    }
+
+    --(state->exemptionDepth);
+}
+
+//==============================================================================
+RealtimeSafety::ScopedRealtimeContext::ScopedRealtimeContext() noexcept
+    : state (getOrCreateStateForCurrentThread())
+{
+    if (state != nullptr)
+        ++(state->realtimeDepth);
+}
+
+RealtimeSafety::ScopedRealtimeContext::~ScopedRealtimeContext() noexcept
+{
+    if (state != nullptr)
+    {
+        --(state->realtimeDepth);
+        releaseState (state);
+    }
+}
+
+RealtimeSafety::ScopedExemption::ScopedExemption() noexcept
+    : state (findStateForCurrentThread())
+{
+    if (state != nullptr)
+        ++(state->exemptionDepth);
+}
+
+RealtimeSafety::ScopedExemption::~ScopedExemption() noexcept
+{
+    if (state != nullptr)
+    {
+        --(state->exemptionDepth);
+        releaseState (state);
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeSafetyTests  : public UnitTest
+{
+public:
+    RealtimeSafetyTests() : UnitTest ("RealtimeSafety", "Threads") {}
+
+    struct OtherThread  : public Thread
+    {
+        OtherThread() : Thread ("RealtimeSafety test") {}
+
+        void run() override
+        {
+            RealtimeSafety::check (RealtimeSafety::lockAcquired);
+            wasInRealtimeContext = RealtimeSafety::isInRealtimeContext();
+        }
+
+        bool wasInRealtimeContext = true;
+    };
+
+    void runTest() override
+    {
+        Array<RealtimeSafety::ViolationType> violations;
+
+        RealtimeSafety::setViolationHandler ([&] (RealtimeSafety::ViolationType type, const String& stackTrace)
+        {
+            violations.add (type);
+            expect (stackTrace.isNotEmpty());
+        });
+
+        beginTest ("Violations are only reported in a realtime context");
+        {
+            RealtimeSafety::check (RealtimeSafety::lockAcquired);
+            expect (! RealtimeSafety::isInRealtimeContext());
+            expect (violations.isEmpty());
+
+            auto numBefore = RealtimeSafety::getNumViolations();
+            bool wasInContext = false, wasStillInContext = false;
+            OtherThread thread;
+
+            // (the expectations are all made afterwards, as the UnitTest methods take a lock)
+            {
+                const RealtimeSafety::ScopedRealtimeContext context;
+                wasInContext = RealtimeSafety::isInRealtimeContext();
+
+                RealtimeSafety::check (RealtimeSafety::waitedOnEvent);
+
+                {
+                    const RealtimeSafety::ScopedRealtimeContext nestedContext;
+                    RealtimeSafety::check (RealtimeSafety::messagePosted);
+                }
+
+                wasStillInContext = RealtimeSafety::isInRealtimeContext();
+
+                {
+                    const RealtimeSafety::ScopedExemption exemption;
+                    RealtimeSafety::check (RealtimeSafety::lockAcquired);
+
+                    // (starting a thread allocates, so this is done inside the exemption)
+                    thread.startThread();
+                    thread.waitForThreadToExit (-1);
+                }
+            }
+
+            expect (wasInContext && wasStillInContext);
+            expect (! thread.wasInRealtimeContext);
+            expect (! RealtimeSafety::isInRealtimeContext());
+            RealtimeSafety::check (RealtimeSafety::lockAcquired);
+
+            expectEquals (violations.size(), 2);
+            expectEquals (RealtimeSafety::getNumViolations() - numBefore, 2);
+            expect (violations[0] == RealtimeSafety::waitedOnEvent);
+            expect (violations[1] == RealtimeSafety::messagePosted);
+        }
+
+       #if JUCE_CHECK_REALTIME_SAFETY
+        beginTest ("Allocations, locks and waits are checked");
+        {
+            violations.clearQuick();
+            violations.ensureStorageAllocated (16);
+
+            CriticalSection lock;
+            WaitableEvent event;
+            event.signal();
+
+            {
+                const RealtimeSafety::ScopedRealtimeContext context;
+
+                ScopedPointer<int> p (new int (1));
+                p = nullptr;
+
+                {
+                    HeapBlock<char> block (16);
+                }
+
+                {
+                    const ScopedLock sl (lock);
+                }
+
+                {
+                    const RealtimeSafety::ScopedExemptLock<CriticalSection> sl (lock);
+                }
+
+                event.wait (0);
+            }
+
+            expectEquals (violations.size(), 6);
+            expect (violations[0] == RealtimeSafety::memoryAllocation);
+            expect (violations[1] == RealtimeSafety::memoryDeallocation);
+            expect (violations[2] == RealtimeSafety::memoryAllocation);
+            expect (violations[3] == RealtimeSafety::memoryDeallocation);
+            expect (violations[4] == RealtimeSafety::lockAcquired);
+            expect (violations[5] == RealtimeSafety::waitedOnEvent);
+        }
+       #endif
+
+        RealtimeSafety::setViolationHandler (nullptr);
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+#endif
+
+} // namespace juce
+
+//==============================================================================
+#if JUCE_CHECK_REALTIME_SAFETY
+
+// Replacing the global allocation functions lets allocations made by any code be
+// checked, not just JUCE's own classes.
+namespace juce
+{
+    static void* allocateAndCheck (size_t size)
+    {
+        RealtimeSafety::check (RealtimeSafety::memoryAllocation);
+
+        for (;;)
+        {
+            if (auto* p = std::malloc (size > 0 ? size : 1))
+                return p;
+
+            if (auto handler = std::get_new_handler())
+                handler();
+            else
+               #if JUCE_EXCEPTIONS_DISABLED
+                std::abort();
+               #else
+                throw std::bad_alloc();
+               #endif
+        }
+    }
+
+    static void* allocateAndCheck (size_t size, const std::nothrow_t&) noexcept
+    {
+        RealtimeSafety::check (RealtimeSafety::memoryAllocation);
+        return std::malloc (size > 0 ? size : 1);
+    }
+
+    static void freeAndCheck (void* p) noexcept
+    {
+        if (p != nullptr)
+        {
+            RealtimeSafety::check (RealtimeSafety::memoryDeallocation);
+            std::free (p);
+        }
+    }
+}
+
+void* operator new   (size_t size)                                      { return juce::allocateAndCheck (size); }
+void* operator new[] (size_t size)                                      { return juce::allocateAndCheck (size); }
+void* operator new   (size_t size, const std::nothrow_t& nt) noexcept   { return juce::allocateAndCheck (size, nt); }
+void* operator new[] (size_t size, const std::nothrow_t& nt) noexcept   { return juce::allocateAndCheck (size, nt); }
+void operator delete   (void* p) noexcept                               { juce::freeAndCheck (p); }
+void operator delete[] (void* p) noexcept                               { juce::freeAndCheck (p); }
+void operator delete   (void* p, const std::nothrow_t&) noexcept        { juce::freeAndCheck (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept        { juce::freeAndCheck (p); }
+
+#if __cpp_sized_deallocation
+void operator delete   (void* p, size_t) noexcept                       { juce::freeAndCheck (p); }
+void operator delete[] (void* p, size_t) noexcept                       { juce::freeAndCheck (p); }
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A debugging aid that reports anything that isn't realtime-safe when it happens
+    on an audio thread.
+
+    When JUCE_CHECK_REALTIME_SAFETY is enabled, JUCE marks the threads that run its
+    audio callbacks (AudioIODeviceCallbacks driven by an AudioDeviceManager, the
+    AudioProcessorPlayer, the plugin wrappers' process calls and the worker threads
+    of a multi-threaded AudioProcessorGraph) as realtime contexts. While a thread is
+    in one of these contexts, any of the following will be reported:
+     - allocating or freeing memory with new/delete or a HeapBlock (which includes
+       Strings, Arrays, MemoryBlocks, etc.)
+     - locking a CriticalSection
+     - waiting on a WaitableEvent
+     - posting a message to the message thread, e.g. with MessageManager::callAsync
+       or AsyncUpdater::triggerAsyncUpdate
+
+    By default, each violation is written to the debug output along with a stack
+    trace. Each distinct stack trace is only reported once, so a mistake that happens
+    on every block won't flood the output. You can supply your own handler with
+    setViolationHandler(), e.g. to make a unit test fail.
+
+    You can mark your own realtime threads with JUCE_REALTIME_CONTEXT, and when
+    something on the audio thread is known to be acceptable, such as an AudioProcessor's
+    callback lock, which is only ever held briefly by other threads, you can exempt
+    it with a ScopedExemption or ScopedExemptLock.
+
+    The checking costs very little when no thread is in a realtime context, but
+    every allocation and lock is still routed through it, so it's only intended for
+    debug builds.
+*/
+class JUCE_API  RealtimeSafety
+{
+public:
+    //==============================================================================
+    /** The different kinds of operation that are reported. */
+    enum ViolationType
+    {
+        memoryAllocation,
+        memoryDeallocation,
+        lockAcquired,
+        waitedOnEvent,
+        messagePosted
+    };
+
+    /** Returns a description of a type of violation, e.g. "memory allocation". */
+    static String getDescription (ViolationType);
+
+    /** A callback that's given each violation, along with a stack trace of where it
+        happened. This is called on the thread that caused the violation, and anything
+        that it does won't itself be reported.
+    */
+    using ViolationHandler = std::function<void (ViolationType, const String& stackTrace)>;
+
+    /** Replaces the function that's called for each violation.
+        Passing nullptr restores the default handler, which writes the violation to the
+        debug output.
+    */
+    static void setViolationHandler (ViolationHandler newHandler);
+
+    /** Returns the total number of violations that have been found. */
+    static int getNumViolations() noexcept;
+
+    //==============================================================================
+    /** Returns true if the calling thread is in a realtime context. */
+    static bool isInRealtimeContext() noexcept;
+
+    /** Reports a violation if the calling thread is in a realtime context.
+        This is called by the operations that are checked, and you can call it from
+        your own code too.
+    */
+    static void check (ViolationType) noexcept;
+
+private:
+    struct ThreadState;
+
+public:
+    //==============================================================================
+    /** Marks the calling thread as being in a realtime context for the lifetime of
+        this object. These can be nested.
+        @see JUCE_REALTIME_CONTEXT
+    */
+    struct JUCE_API  ScopedRealtimeContext
+    {
+        ScopedRealtimeContext() noexcept;
+        ~ScopedRealtimeContext() noexcept;
+
+    private:
+        ThreadState* state;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeContext)
+    };
+
+    /** Stops violations on the calling thread being reported, for the lifetime of
+        this object.
+    */
+    struct JUCE_API  ScopedExemption
+    {
+        ScopedExemption() noexcept;
+        ~ScopedExemption() noexcept;
+
+    private:
+        ThreadState* state;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedExemption)
+    };
+
+    /** Holds a lock for the lifetime of this object, without reporting the locking
+        as a violation.
+
+        This is for locks that are known to only be held very briefly by other threads,
+        such as an AudioProcessor's callback lock. Anything else that happens while the
+        lock is held is still checked.
+    */
+    template <typename LockType>
+    struct ScopedExemptLock
+    {
+        explicit ScopedExemptLock (const LockType& lockToUse) noexcept  : lock (lockToUse)
+        {
+            const ScopedExemption exemption;
+            lock.enter();
+        }
+
+        ~ScopedExemptLock() noexcept    { lock.exit(); }
+
+    private:
+        const LockType& lock;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedExemptLock)
+    };
+
+private:
+    //==============================================================================
+    static ThreadState* getAllThreadStates() noexcept;
+    static ThreadState* findStateForCurrentThread() noexcept;
+    static ThreadState* getOrCreateStateForCurrentThread() noexcept;
+    static void releaseState (ThreadState*) noexcept;
+
+    RealtimeSafety() = delete;
+};
+
+//==============================================================================
+#if JUCE_CHECK_REALTIME_SAFETY || DOXYGEN
+ /** Marks the calling thread as a realtime context until the end of the enclosing scope.
+     @see RealtimeSafety
+ */
+ #define JUCE_REALTIME_CONTEXT                 const juce::RealtimeSafety::ScopedRealtimeContext JUCE_JOIN_MACRO (juceRealtimeContext, __LINE__)
+
+ /** Reports a violation if the calling thread is in a realtime context. @see RealtimeSafety::check */
+ #define JUCE_REALTIME_SAFETY_CHECK(type)      juce::RealtimeSafety::check (juce::RealtimeSafety::type)
+#else
+ #define JUCE_REALTIME_CONTEXT
+ #define JUCE_REALTIME_SAFETY_CHECK(type)
+#endif
+
+} // namespace juce
@@ -34,7 +34,7 @@ namespace juce
     It's most appropriate for simple situations where you're only going to hold the
     lock for a very brief time.
 
-    @see CriticalSection
+    @see CriticalSection, AdaptiveLock
 */
 class JUCE_API  SpinLock
 {
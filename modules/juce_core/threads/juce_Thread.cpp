@@ -91,6 +91,9 @@ void Thread::threadEntryPoint()
         if (affinityMask != 0)
             setCurrentThreadAffinityMask (affinityMask);
 
+        if (isRealtimeThread)
+            setCurrentThreadRealtime (realtimeOptions);
+
         try
         {
             run();
@@ -145,6 +148,7 @@ void Thread::startThread (int priority)
             priority = 9;
 
         threadPriority = priority;
+        isRealtimeThread = false;
         startThread();
     }
     else
@@ -153,6 +157,27 @@ void Thread::startThread (int priority)
     }
 }
 
+void Thread::startRealtimeThread (const RealtimeOptions& options)
+{
+    const ScopedLock sl (startStopLock);
+
+    if (threadHandle == nullptr)
+    {
+       #if JUCE_ANDROID
+        isAndroidRealtimeThread = true;
+       #endif
+
+        realtimeOptions = options;
+        isRealtimeThread = true;
+        threadPriority = options.priority;
+
+        if (options.affinityMask != 0)
+            affinityMask = options.affinityMask;
+
+        startThread();
+    }
+}
+
 bool Thread::isThreadRunning() const
 {
     return threadHandle != nullptr;
@@ -279,7 +304,24 @@ bool Thread::setCurrentThreadPriority (const int newPriority)
 
 void Thread::setAffinityMask (const uint32 newAffinityMask)
 {
+    // (as with setPriority, the lock mustn't be taken when this is called by the thread itself)
+    if (getCurrentThreadId() == getThreadId())
+    {
+        affinityMask = newAffinityMask;
+        setCurrentThreadAffinityMask (newAffinityMask);
+        return;
+    }
+
+    const ScopedLock sl (startStopLock);
     affinityMask = newAffinityMask;
+
+    if (isThreadRunning())
+        setThreadAffinityMask (threadHandle, newAffinityMask);
+}
+
+void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 newAffinityMask)
+{
+    setThreadAffinityMask (nullptr, newAffinityMask);
 }
 
 //==============================================================================
@@ -94,6 +94,101 @@ public:
     */
     void startThread (int priority);
 
+    //==============================================================================
+    /** A set of options that describe how a realtime thread should be scheduled.
+
+        These can be passed to startRealtimeThread() or setCurrentThreadRealtime(), and
+        each platform turns them into the best realtime scheduling that it has:
+        - on macOS and iOS, the thread is given a Mach time-constraint policy made from
+          the period, processing time and maximum processing time. If there's no period,
+          it just gets a high priority.
+        - on Linux, it uses SCHED_FIFO, or SCHED_DEADLINE if you've asked for it with
+          withDeadlineScheduling() and set a period.
+        - on Windows, the thread joins the MMCSS "Pro Audio" task, and gets a high priority.
+        - on Android, it's created in the same way as a realtimeAudioPriority thread.
+
+        Most platforms need special rights for realtime scheduling (e.g. an rtprio limit on
+        Linux), and if it isn't allowed, the thread keeps running at its normal priority.
+
+        e.g. @code
+        startRealtimeThread (Thread::RealtimeOptions()
+                               .withApproximateAudioProcessingTime (blockSize, sampleRate)
+                               .withAffinityMask (1 << 2));
+        @endcode
+    */
+    struct RealtimeOptions
+    {
+        /** Sets the priority, from 0 to 10, which is used by the platforms that schedule
+            realtime threads by priority. The default is 9.
+        */
+        RealtimeOptions withPriority (int newPriority) const                { auto o = *this; o.priority = jlimit (0, 10, newPriority); return o; }
+
+        /** Sets how often the thread has some work to do, e.g. the duration of an audio block. */
+        RealtimeOptions withPeriodMs (double newPeriodMs) const             { auto o = *this; o.periodMs = newPeriodMs; return o; }
+
+        /** Sets the period to the duration of a block of audio. */
+        RealtimeOptions withApproximateAudioProcessingTime (int samplesPerBlock, double sampleRate) const
+        {
+            jassert (samplesPerBlock > 0 && sampleRate > 0);
+            return withPeriodMs (1000.0 * samplesPerBlock / sampleRate);
+        }
+
+        /** Sets the amount of CPU time that the thread needs in each period.
+            If this isn't set, half the period is used.
+        */
+        RealtimeOptions withProcessingTimeMs (double newTimeMs) const       { auto o = *this; o.processingTimeMs = newTimeMs; return o; }
+
+        /** Sets the time from the start of each period within which the thread's work must
+            be finished. If this isn't set, the whole period is used.
+        */
+        RealtimeOptions withMaximumProcessingTimeMs (double newTimeMs) const { auto o = *this; o.maxProcessingTimeMs = newTimeMs; return o; }
+
+        /** Sets the CPUs that the thread is allowed to run on, in the same format as
+            setAffinityMask(). This can be used to pin the thread to a core that's been
+            isolated from the rest of the system. Zero means that it can use any of them.
+        */
+        RealtimeOptions withAffinityMask (uint32 newMask) const             { auto o = *this; o.affinityMask = newMask; return o; }
+
+        /** On Linux, asks for the SCHED_DEADLINE policy instead of SCHED_FIFO when there's a
+            period. The kernel will stop the thread running for the rest of a period if it uses
+            more than its processing time, and it won't allow a thread with an affinity mask
+            to use this policy, in which case SCHED_FIFO is used instead.
+        */
+        RealtimeOptions withDeadlineScheduling (bool shouldUseDeadline) const { auto o = *this; o.useDeadlineScheduling = shouldUseDeadline; return o; }
+
+        /** Returns the processing time, after filling in its default value. */
+        double getProcessingTimeMs() const noexcept
+        {
+            return jmin (getMaximumProcessingTimeMs(), processingTimeMs > 0 ? processingTimeMs : periodMs * 0.5);
+        }
+
+        /** Returns the maximum processing time, after filling in its default value. */
+        double getMaximumProcessingTimeMs() const noexcept
+        {
+            return maxProcessingTimeMs > 0 ? jmin (maxProcessingTimeMs, periodMs) : periodMs;
+        }
+
+        int priority = 9;
+        double periodMs = 0, processingTimeMs = 0, maxProcessingTimeMs = 0;
+        uint32 affinityMask = 0;
+        bool useDeadlineScheduling = false;
+    };
+
+    /** Starts the thread with realtime scheduling.
+
+        The options are applied by the new thread itself before it calls run(). If the
+        thread is already running, this won't do anything.
+
+        @see RealtimeOptions, setCurrentThreadRealtime, startThread
+    */
+    void startRealtimeThread (const RealtimeOptions& options);
+
+    /** Gives the calling thread realtime scheduling.
+        Returns false if the platform didn't allow it.
+        @see RealtimeOptions, startRealtimeThread
+    */
+    static bool setCurrentThreadRealtime (const RealtimeOptions& options);
+
     /** Attempts to stop the thread running.
 
         This method will cause the threadShouldExit() method to return true
@@ -241,8 +336,10 @@ public:
     //==============================================================================
     /** Sets the affinity mask for the thread.
 
-        This will only have an effect next time the thread is started - i.e. if the
-        thread is already running when called, it'll have no effect.
+        If the thread is running, the new mask is applied straight away, and it'll also be
+        used whenever the thread is started again. Each bit of the mask allows the thread to
+        run on one CPU, and zero means any CPU. Note that macOS and iOS don't allow threads
+        to be pinned to CPUs, so there this has no effect.
 
         @see setCurrentThreadAffinityMask
     */
@@ -332,6 +429,8 @@ private:
     int threadPriority = 5;
     size_t threadStackSize;
     uint32 affinityMask = 0;
+    RealtimeOptions realtimeOptions;
+    bool isRealtimeThread = false;
     bool deleteOnThreadEnd = false;
     bool volatile shouldExit = false;
     ListenerList<Listener, Array<Listener*, CriticalSection>> listeners;
@@ -349,6 +448,7 @@ private:
     void killThread();
     void threadEntryPoint();
     static bool setThreadPriority (void*, int);
+    static void setThreadAffinityMask (void*, uint32);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Thread)
 };
@@ -98,6 +98,13 @@ ThreadPool::ThreadPool (const int numThreads, size_t threadStackSize)
     createThreads (numThreads, threadStackSize);
 }
 
+ThreadPool::ThreadPool (const int numThreads, const Thread::RealtimeOptions& realtimeOptions, size_t threadStackSize)
+{
+    jassert (numThreads > 0); // not much point having a pool without any threads!
+
+    createThreads (numThreads, threadStackSize, &realtimeOptions);
+}
+
 ThreadPool::ThreadPool()
 {
     createThreads (SystemStats::getNumCpus());
@@ -109,13 +116,18 @@ ThreadPool::~ThreadPool()
     stopThreads();
 }
 
-void ThreadPool::createThreads (int numThreads, size_t threadStackSize)
+void ThreadPool::createThreads (int numThreads, size_t threadStackSize, const Thread::RealtimeOptions* realtimeOptions)
 {
     for (int i = jmax (1, numThreads); --i >= 0;)
         threads.add (new ThreadPoolThread (*this, threadStackSize));
 
     for (auto* t : threads)
-        t->startThread();
+    {
+        if (realtimeOptions != nullptr)
+            t->startRealtimeThread (*realtimeOptions);
+        else
+            t->startThread();
+    }
 }
 
 void ThreadPool::stopThreads()
@@ -166,6 +166,20 @@ public:
     */
     ThreadPool (int numberOfThreads, size_t threadStackSize = 0);
 
+    /** Creates a thread pool whose threads are all started with Thread::startRealtimeThread().
+
+        This is for pools that do time-critical work, e.g. jobs that have to be finished
+        within an audio callback. Any jobs that are run on such a pool should avoid
+        blocking, as they'll be competing with the audio threads for CPU time.
+
+        @param numberOfThreads  the number of threads to run
+        @param realtimeOptions  the scheduling options to use for each thread
+        @param threadStackSize  the size of the stack of each thread, or zero to use the
+                                OS's default stack size
+        @see Thread::RealtimeOptions
+    */
+    ThreadPool (int numberOfThreads, const Thread::RealtimeOptions& realtimeOptions, size_t threadStackSize = 0);
+
     /** Creates a thread pool with one thread per CPU core.
         Once you've created a pool, you can give it some jobs by calling addJob().
         If you want to specify the number of threads, use the other constructor; this
@@ -331,7 +345,7 @@ private:
     bool runNextJob (ThreadPoolThread&);
     ThreadPoolJob* pickNextJobToRun();
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
-    void createThreads (int numThreads, size_t threadStackSize = 0);
+    void createThreads (int numThreads, size_t threadStackSize = 0, const Thread::RealtimeOptions* realtimeOptions = nullptr);
     void stopThreads();
 
     // Note that this method has changed, and no longer has a parameter to indicate
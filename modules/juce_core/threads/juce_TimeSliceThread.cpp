@@ -23,13 +23,52 @@
 namespace juce
 {
 
-TimeSliceThread::TimeSliceThread (const String& name)  : Thread (name)
+// Each thread that calls clients has one of these. The callback lock is held while a
+// client is being called, so that removeTimeSliceClient() can wait for it to finish.
+struct TimeSliceThread::ClientCaller
 {
+    CriticalSection callbackLock;
+    TimeSliceClient* clientBeingCalled = nullptr;
+    ScopedPointer<Thread> helperThread; // null for the TimeSliceThread's own caller
+};
+
+struct TimeSliceThread::HelperThread  : public Thread
+{
+    HelperThread (TimeSliceThread& t, ClientCaller& c, const String& name)
+        : Thread (name), owner (t), caller (c)
+    {
+    }
+
+    void run() override
+    {
+        owner.callClients (*this, caller);
+    }
+
+    TimeSliceThread& owner;
+    ClientCaller& caller;
+
+    JUCE_DECLARE_NON_COPYABLE (HelperThread)
+};
+
+//==============================================================================
+TimeSliceThread::TimeSliceThread (const String& name, int numThreads)  : Thread (name)
+{
+    callers.add (new ClientCaller());
+
+    for (int i = 1; i < numThreads; ++i)
+    {
+        auto* caller = callers.add (new ClientCaller());
+        caller->helperThread = new HelperThread (*this, *caller, name + " " + String (i + 1));
+    }
 }
 
 TimeSliceThread::~TimeSliceThread()
 {
     stopThread (2000);
+
+    for (auto* caller : callers)
+        if (caller->helperThread != nullptr)
+            caller->helperThread->stopThread (2000);
 }
 
 //==============================================================================
@@ -40,28 +79,38 @@ void TimeSliceThread::addTimeSliceClient (TimeSliceClient* const client, int mil
         const ScopedLock sl (listLock);
         client->nextCallTime = Time::getCurrentTime() + RelativeTime::milliseconds (millisecondsBeforeStarting);
         clients.addIfNotAlreadyThere (client);
-        notify();
+        wakeUpAllThreads();
     }
 }
 
 void TimeSliceThread::removeTimeSliceClient (TimeSliceClient* const client)
 {
-    const ScopedLock sl1 (listLock);
-
-    // if there's a chance we're in the middle of calling this client, we need to
-    // also lock the outer lock..
-    if (clientBeingCalled == client)
+    for (;;)
     {
+        const ScopedLock sl1 (listLock);
+        auto* caller = findCallerOf (client);
+
+        if (caller == nullptr)
+        {
+            clients.removeFirstMatchingValue (client);
+            return;
+        }
+
+        // we're in the middle of calling this client, so we need to also lock the
+        // caller's callback lock..
         const ScopedUnlock ul (listLock); // unlock first to get the order right..
 
-        const ScopedLock sl2 (callbackLock);
+        const ScopedLock sl2 (caller->callbackLock);
         const ScopedLock sl3 (listLock);
 
-        clients.removeFirstMatchingValue (client);
-    }
-    else
-    {
-        clients.removeFirstMatchingValue (client);
+        // ..but while the list was unlocked, another thread may have started calling it
+        auto* newCaller = findCallerOf (client);
+
+        if (newCaller == nullptr || newCaller == caller)
+        {
+            clients.removeFirstMatchingValue (client);
+            return;
+        }
     }
 }
 
@@ -82,8 +131,10 @@ void TimeSliceThread::moveToFrontOfQueue (TimeSliceClient* client)
 
     if (clients.contains (client))
     {
-        client->nextCallTime = Time::getCurrentTime();
-        notify();
+        // If the client is being called right now, this marks it so that the thread calls it
+        // again straight away, rather than using the delay that it returns
+        client->nextCallTime = findCallerOf (client) != nullptr ? Time() : Time::getCurrentTime();
+        wakeUpAllThreads();
     }
 }
 
@@ -98,87 +149,221 @@ TimeSliceClient* TimeSliceThread::getClient (const int i) const
     return clients[i];
 }
 
+int TimeSliceThread::getNumThreads() const noexcept
+{
+    return callers.size();
+}
+
 //==============================================================================
-TimeSliceClient* TimeSliceThread::getNextClient (int index) const
+TimeSliceThread::ClientCaller* TimeSliceThread::findCallerOf (TimeSliceClient* client) const
 {
-    Time soonest;
-    TimeSliceClient* client = nullptr;
+    for (auto* caller : callers)
+        if (caller->clientBeingCalled == client)
+            return caller;
 
-    for (int i = clients.size(); --i >= 0;)
+    return nullptr;
+}
+
+// Returns the due client with the highest priority, choosing the one that's been waiting
+// longest if several have the same priority. If none are due, this returns nullptr and
+// reduces msUntilNextClient to the time until the next one will be.
+TimeSliceClient* TimeSliceThread::getNextClient (Time now, int& msUntilNextClient) const
+{
+    TimeSliceClient* best = nullptr;
+
+    for (auto* c : clients)
     {
-        auto* c = clients.getUnchecked ((i + index) % clients.size());
+        if (findCallerOf (c) != nullptr)
+            continue; // it's being called by another thread
 
-        if (client == nullptr || c->nextCallTime < soonest)
+        if (c->nextCallTime > now)
+        {
+            auto msUntilDue = jmax ((int64) 1, (c->nextCallTime - now).inMilliseconds());
+            msUntilNextClient = (int) jmin ((int64) msUntilNextClient, msUntilDue);
+        }
+        else if (best == nullptr
+                  || c->timeSlicePriority > best->timeSlicePriority
+                  || (c->timeSlicePriority == best->timeSlicePriority && c->nextCallTime < best->nextCallTime))
         {
-            client = c;
-            soonest = c->nextCallTime;
+            best = c;
         }
     }
 
-    return client;
+    return best;
 }
 
-void TimeSliceThread::run()
+void TimeSliceThread::wakeUpAllThreads()
+{
+    notify();
+
+    for (auto* caller : callers)
+        if (caller->helperThread != nullptr)
+            caller->helperThread->notify();
+}
+
+void TimeSliceThread::callClients (Thread& thread, ClientCaller& caller)
 {
-    int index = 0;
+    int numCallsWithoutWaiting = 0;
 
-    while (! threadShouldExit())
+    while (! thread.threadShouldExit())
     {
         int timeToWait = 500;
 
         {
-            Time nextClientTime;
+            const ScopedLock sl (caller.callbackLock);
+
+            auto now = Time::getCurrentTime();
             int numClients = 0;
 
             {
                 const ScopedLock sl2 (listLock);
 
                 numClients = clients.size();
-                index = numClients > 0 ? ((index + 1) % numClients) : 0;
-
-                if (auto* firstClient = getNextClient (index))
-                    nextClientTime = firstClient->nextCallTime;
+                caller.clientBeingCalled = getNextClient (now, timeToWait);
             }
 
-            if (numClients > 0)
+            if (auto* client = caller.clientBeingCalled)
             {
-                auto now = Time::getCurrentTime();
+                const int msUntilNextCall = client->useTimeSlice();
+
+                const ScopedLock sl2 (listLock);
 
-                if (nextClientTime > now)
-                {
-                    timeToWait = (int) jmin ((int64) 500, (nextClientTime - now).inMilliseconds());
-                }
+                // (a null nextCallTime means moveToFrontOfQueue() was called while the client was busy)
+                if (msUntilNextCall >= 0)
+                    client->nextCallTime = client->nextCallTime == Time() ? now
+                                                                          : now + RelativeTime::milliseconds (msUntilNextCall);
                 else
-                {
-                    timeToWait = index == 0 ? 1 : 0;
+                    clients.removeFirstMatchingValue (client);
+
+                caller.clientBeingCalled = nullptr;
+
+                // once every client has had a turn without a break, give the CPU a rest
+                timeToWait = ++numCallsWithoutWaiting >= numClients ? 1 : 0;
+            }
+        }
 
-                    const ScopedLock sl (callbackLock);
+        if (timeToWait > 0)
+        {
+            numCallsWithoutWaiting = 0;
+            thread.wait (timeToWait);
+        }
+    }
+}
 
-                    {
-                        const ScopedLock sl2 (listLock);
-                        clientBeingCalled = getNextClient (index);
-                    }
+void TimeSliceThread::run()
+{
+    for (auto* caller : callers)
+        if (caller->helperThread != nullptr)
+            caller->helperThread->startThread();
 
-                    if (clientBeingCalled != nullptr)
-                    {
-                        const int msUntilNextCall = clientBeingCalled->useTimeSlice();
+    callClients (*this, *callers.getFirst());
 
-                        const ScopedLock sl2 (listLock);
+    for (auto* caller : callers)
+        if (caller->helperThread != nullptr)
+            caller->helperThread->stopThread (2000);
+}
 
-                        if (msUntilNextCall >= 0)
-                            clientBeingCalled->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
-                        else
-                            clients.removeFirstMatchingValue (clientBeingCalled);
 
-                        clientBeingCalled = nullptr;
-                    }
-                }
-            }
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TimeSliceThreadTests  : public UnitTest
+{
+public:
+    TimeSliceThreadTests() : UnitTest ("TimeSliceThread", "Threads") {}
+
+    void runTest() override
+    {
+        beginTest ("Priorities");
+        {
+            TimeSliceThread thread ("TimeSliceThread test");
+            Array<int> callOrder;
+            CriticalSection orderLock;
+
+            TestClient background (callOrder, orderLock, TimeSliceClient::backgroundPriority, -1);
+            TestClient normal     (callOrder, orderLock, TimeSliceClient::normalPriority, -1);
+            TestClient playback   (callOrder, orderLock, TimeSliceClient::playbackPriority, -1);
+
+            // they're all added before the thread starts, so they'll all be due at once
+            thread.addTimeSliceClient (&background);
+            thread.addTimeSliceClient (&normal);
+            thread.addTimeSliceClient (&playback);
+            thread.startThread (0);
+
+            for (int i = 0; i < 500 && thread.getNumClients() > 0; ++i)
+                Thread::sleep (2);
+
+            thread.stopThread (2000);
+
+            const ScopedLock sl (orderLock);
+            expect (callOrder == Array<int> (TimeSliceClient::playbackPriority,
+                                             TimeSliceClient::normalPriority,
+                                             TimeSliceClient::backgroundPriority));
         }
 
-        if (timeToWait > 0)
-            wait (timeToWait);
+        beginTest ("Multiple threads");
+        {
+            TimeSliceThread thread ("TimeSliceThread test", 3);
+            expectEquals (thread.getNumThreads(), 3);
+
+            Array<int> callOrder;
+            CriticalSection orderLock;
+            OwnedArray<TestClient> testClients;
+
+            for (int i = 0; i < 8; ++i)
+                thread.addTimeSliceClient (testClients.add (new TestClient (callOrder, orderLock, TimeSliceClient::normalPriority, 0)));
+
+            thread.startThread (0);
+            Thread::sleep (50);
+
+            for (auto* c : testClients)
+                thread.removeTimeSliceClient (c);
+
+            thread.stopThread (2000);
+
+            for (auto* c : testClients)
+            {
+                expect (c->numCalls.get() > 0);
+                expect (! c->wasCalledConcurrently);
+            }
+        }
     }
-}
+
+    struct TestClient  : public TimeSliceClient
+    {
+        TestClient (Array<int>& order, CriticalSection& lock, int priority, int result)
+            : callOrder (order), orderLock (lock), resultToReturn (result)
+        {
+            setTimeSlicePriority (priority);
+        }
+
+        int useTimeSlice() override
+        {
+            if (++numActiveCalls > 1)
+                wasCalledConcurrently = true;
+
+            {
+                const ScopedLock sl (orderLock);
+                callOrder.add (getTimeSlicePriority());
+            }
+
+            ++numCalls;
+            Thread::yield();
+            --numActiveCalls;
+            return resultToReturn;
+        }
+
+        Array<int>& callOrder;
+        CriticalSection& orderLock;
+        const int resultToReturn;
+        Atomic<int> numCalls, numActiveCalls;
+        bool wasCalledConcurrently = false;
+    };
+};
+
+static TimeSliceThreadTests timeSliceThreadTests;
+
+#endif
 
 } // namespace juce
@@ -61,10 +61,33 @@ public:
     */
     virtual int useTimeSlice() = 0;
 
+    //==============================================================================
+    /** Some standard priorities that can be passed to setTimeSlicePriority(). */
+    enum Priority
+    {
+        backgroundPriority  = -10,  /**< For work that nothing is waiting for, e.g. generating thumbnails or scanning directories. */
+        normalPriority      = 0,    /**< The default priority. */
+        playbackPriority    = 10    /**< For work that has to keep up with something that's playing or recording, e.g. reading ahead from disk for an audio stream. */
+    };
+
+    /** Sets the priority of this client relative to the other clients of its TimeSliceThread.
+
+        Whenever several clients are due to be called, the thread will call the one with the
+        highest priority first, so a client with a higher priority can't be held up by clients
+        with lower ones. Clients with the same priority are called in order of how long they've
+        been waiting. You can use any value, but the ones in the Priority enum cover most cases.
+
+        This should be called before the client is added to a thread.
+    */
+    void setTimeSlicePriority (int newPriority) noexcept        { timeSlicePriority = newPriority; }
+
+    /** Returns the priority that was set with setTimeSlicePriority(). */
+    int getTimeSlicePriority() const noexcept                   { return timeSlicePriority; }
 
 private:
     friend class TimeSliceThread;
     Time nextCallTime;
+    int timeSlicePriority = normalPriority;
 };
 
 
@@ -73,6 +96,16 @@ private:
     A thread that keeps a list of clients, and calls each one in turn, giving them
     all a chance to run some sort of short task.
 
+    Each time a thread is free, it calls whichever of the clients that are due has the
+    highest priority (see TimeSliceClient::setTimeSlicePriority()), and among those with
+    the same priority, the one whose requested call time is the earliest. This means that
+    e.g. a BufferingAudioSource reading ahead for playback won't have to wait for an
+    AudioThumbnail that's sharing the thread.
+
+    If you pass a number of threads to the constructor, the clients will be shared between
+    that many threads, so that a slow client can't hold up all of the others. A client is
+    never called by more than one thread at a time.
+
     @see TimeSliceClient, Thread
 */
 class JUCE_API  TimeSliceThread   : public Thread
@@ -84,8 +117,12 @@ public:
 
         When first created, the thread is not running. Use the startThread()
         method to start it.
+
+        If numThreads is more than 1, starting the thread will also start that many
+        minus one helper threads, which will call clients alongside it. They'll be
+        stopped again when this thread stops.
     */
-    explicit TimeSliceThread (const String& threadName);
+    explicit TimeSliceThread (const String& threadName, int numThreads = 1);
 
     /** Destructor.
 
@@ -127,6 +164,9 @@ public:
     /** Returns one of the registered clients. */
     TimeSliceClient* getClient (int index) const;
 
+    /** Returns the number of threads that call the clients, including this one. */
+    int getNumThreads() const noexcept;
+
     //==============================================================================
    #ifndef DOXYGEN
     void run() override;
@@ -134,11 +174,17 @@ public:
 
     //==============================================================================
 private:
-    CriticalSection callbackLock, listLock;
+    struct ClientCaller;
+    struct HelperThread;
+
+    CriticalSection listLock;
     Array<TimeSliceClient*> clients;
-    TimeSliceClient* clientBeingCalled = nullptr;
+    OwnedArray<ClientCaller> callers;
 
-    TimeSliceClient* getNextClient (int index) const;
+    void callClients (Thread&, ClientCaller&);
+    TimeSliceClient* getNextClient (Time now, int& msUntilNextClient) const;
+    ClientCaller* findCallerOf (TimeSliceClient*) const;
+    void wakeUpAllThreads();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeSliceThread)
 };
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+// The event is a flag that waiting threads sleep on with AddressWait, which lets a
+// signal() when nothing is waiting, and a wait() on an event that's already been
+// signalled, both be done without a system call or a mutex.
+WaitableEvent::WaitableEvent (const bool useManualReset) noexcept
+    : manualReset (useManualReset)
+{
+}
+
+WaitableEvent::~WaitableEvent() noexcept {}
+
+bool WaitableEvent::wait (const int timeOutMilliseconds) const noexcept
+{
+    JUCE_REALTIME_SAFETY_CHECK (waitedOnEvent);
+
+    auto consumeSignal = [this]
+    {
+        if (manualReset)
+            return triggered.load() != 0;
+
+        int32 expected = 1;
+        return triggered.compare_exchange_strong (expected, 0);
+    };
+
+    if (consumeSignal())
+        return true;
+
+    if (timeOutMilliseconds == 0)
+        return false;
+
+    auto endTime = Time::getMillisecondCounterHiRes() + timeOutMilliseconds;
+    ++numWaiters;
+
+    for (;;)
+    {
+        if (timeOutMilliseconds < 0)
+        {
+            AddressWait::wait (triggered, 0, -1);
+        }
+        else
+        {
+            auto millisecsLeft = endTime - Time::getMillisecondCounterHiRes();
+
+            if (millisecsLeft <= 0)
+                break;
+
+            AddressWait::wait (triggered, 0, jmax (1, roundToInt (millisecsLeft)));
+        }
+
+        // the wait may also have returned because of a spurious wake-up, or because
+        // another thread got to the signal first
+        if (consumeSignal())
+        {
+            --numWaiters;
+            return true;
+        }
+    }
+
+    --numWaiters;
+    return consumeSignal();
+}
+
+void WaitableEvent::signal() const noexcept
+{
+    if (triggered.exchange (1) == 0 && numWaiters.load() > 0)
+    {
+        if (manualReset)
+            AddressWait::wakeAll (triggered);
+        else
+            AddressWait::wakeOne (triggered);
+    }
+}
+
+void WaitableEvent::reset() const noexcept
+{
+    triggered = 0;
+}
+
+} // namespace juce
@@ -30,6 +30,12 @@ namespace juce
     A thread can call wait() on a WaitableObject, and this will suspend the
     calling thread until another thread wakes it up by calling the signal()
     method.
+
+    Signalling an event that nothing is waiting on, or waiting on one that has already
+    been signalled, doesn't involve any system calls, so it's cheap to use these for
+    waking up worker threads.
+
+    @see LightweightSemaphore
 */
 class JUCE_API  WaitableEvent
 {
@@ -96,13 +102,8 @@ public:
 
 private:
     //==============================================================================
-   #if JUCE_WINDOWS
-    void* handle;
-   #else
-    mutable pthread_cond_t condition;
-    mutable pthread_mutex_t mutex;
-    mutable bool triggered, manualReset;
-   #endif
+    mutable std::atomic<int32> triggered { 0 }, numWaiters { 0 };
+    const bool manualReset;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaitableEvent)
 };
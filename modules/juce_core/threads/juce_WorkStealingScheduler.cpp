@@ -0,0 +1,598 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A fixed-size Chase-Lev deque. Only the owning worker calls push() and pop(),
+    which work on the bottom end; any other thread may call steal(), which takes
+    from the top. The indices are free-running, and only their differences are used.
+*/
+
+struct WorkStealingScheduler::WorkDeque
+{
+    WorkDeque (int capacity)  : mask ((uint32) capacity - 1)
+    {
+        slots.calloc ((size_t) capacity);
+    }
+
+    bool push (Task* task) noexcept
+    {
+        auto b = bottom.get();
+
+        if ((int32) (b - top.get()) > (int32) mask)
+            return false;
+
+        slots[b & mask].set (task);
+        bottom.set (b + 1);
+        return true;
+    }
+
+    Task* pop() noexcept
+    {
+        auto b = bottom.get() - 1;
+        bottom.set (b);
+        auto t = top.get();
+
+        if ((int32) (b - t) < 0)
+        {
+            bottom.set (b + 1);
+            return nullptr;
+        }
+
+        auto* task = slots[b & mask].get();
+
+        if (b == t)
+        {
+            // this is the last item, so we have to race any thieves for it
+            if (! top.compareAndSetBool (t + 1, t))
+                task = nullptr;
+
+            bottom.set (t + 1);
+        }
+
+        return task;
+    }
+
+    Task* steal() noexcept
+    {
+        auto t = top.get();
+        auto b = bottom.get();
+
+        if ((int32) (b - t) <= 0)
+            return nullptr;
+
+        auto* task = slots[t & mask].get();
+        return top.compareAndSetBool (t + 1, t) ? task : nullptr;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return (int32) (bottom.get() - top.get()) <= 0;
+    }
+
+    HeapBlock<Atomic<Task*>> slots;
+    const uint32 mask;
+    Atomic<uint32> top, bottom;
+
+    JUCE_DECLARE_NON_COPYABLE (WorkDeque)
+};
+
+//==============================================================================
+/*  A bounded multi-producer, multi-consumer queue holding tasks submitted from
+    threads that aren't workers. Each cell carries a sequence number that tells
+    producers and consumers whose turn it is to use it.
+*/
+
+struct WorkStealingScheduler::SubmissionQueue
+{
+    SubmissionQueue (int capacity)  : mask ((uint32) capacity - 1)
+    {
+        cells.calloc ((size_t) capacity);
+
+        for (uint32 i = 0; i <= mask; ++i)
+            cells[i].sequence.set (i);
+    }
+
+    bool push (Task* task) noexcept
+    {
+        auto pos = writePos.get();
+
+        for (;;)
+        {
+            auto& cell = cells[pos & mask];
+            auto diff = (int32) (cell.sequence.get() - pos);
+
+            if (diff == 0)
+            {
+                if (writePos.compareAndSetBool (pos + 1, pos))
+                {
+                    cell.task = task;
+                    cell.sequence.set (pos + 1);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+
+            pos = writePos.get();
+        }
+    }
+
+    Task* pop() noexcept
+    {
+        auto pos = readPos.get();
+
+        for (;;)
+        {
+            auto& cell = cells[pos & mask];
+            auto diff = (int32) (cell.sequence.get() - (pos + 1));
+
+            if (diff == 0)
+            {
+                if (readPos.compareAndSetBool (pos + 1, pos))
+                {
+                    auto* task = cell.task;
+                    cell.sequence.set (pos + mask + 1);
+                    return task;
+                }
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+
+            pos = readPos.get();
+        }
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return (int32) (writePos.get() - readPos.get()) <= 0;
+    }
+
+    struct Cell
+    {
+        Atomic<uint32> sequence;
+        Task* task;
+    };
+
+    HeapBlock<Cell> cells;
+    const uint32 mask;
+    Atomic<uint32> writePos, readPos;
+
+    JUCE_DECLARE_NON_COPYABLE (SubmissionQueue)
+};
+
+//==============================================================================
+class WorkStealingScheduler::Worker  : public Thread
+{
+public:
+    Worker (WorkStealingScheduler& s, int index, int queueCapacity, size_t stackSize)
+        : Thread ("Work stealing worker " + String (index), stackSize),
+          scheduler (s), workerIndex (index), deque (queueCapacity),
+          random ((int64) index * 0x9e3779b9 + 1)
+    {
+    }
+
+    void run() override
+    {
+        threadID.set (getCurrentThreadId());
+
+        while (! threadShouldExit())
+        {
+            if (auto* task = scheduler.findTask (workerIndex, random))
+            {
+                scheduler.runTask (*task);
+                continue;
+            }
+
+            // Announce that we're about to sleep before checking the queues one last
+            // time, so that a task submitted in between will always signal the event.
+            ++scheduler.numSleepingWorkers;
+
+            if (auto* task = scheduler.findTask (workerIndex, random))
+            {
+                --scheduler.numSleepingWorkers;
+                scheduler.runTask (*task);
+                continue;
+            }
+
+            scheduler.workAvailable.wait (100);
+            --scheduler.numSleepingWorkers;
+        }
+    }
+
+    WorkStealingScheduler& scheduler;
+    const int workerIndex;
+    WorkDeque deque;
+    Random random;
+    Atomic<Thread::ThreadID> threadID;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+WorkStealingScheduler::Task::Task() noexcept {}
+
+WorkStealingScheduler::Task::~Task()
+{
+    // you mustn't delete a task while it's still waiting to be run!
+    jassert (group == nullptr);
+}
+
+WorkStealingScheduler::FunctionTask::FunctionTask (std::function<void()> f)  : function (static_cast<std::function<void()>&&> (f))
+{
+    jassert (function != nullptr);
+}
+
+void WorkStealingScheduler::FunctionTask::run()
+{
+    function();
+}
+
+WorkStealingScheduler::TaskGroup::TaskGroup() noexcept {}
+
+WorkStealingScheduler::TaskGroup::~TaskGroup()
+{
+    // you mustn't delete a group while some of its tasks are still pending!
+    jassert (isFinished());
+}
+
+void WorkStealingScheduler::TaskGroup::setContinuation (Task* task, TaskGroup* groupForTask) noexcept
+{
+    // the continuation can't be changed while the group is running
+    jassert (isFinished());
+    jassert (groupForTask != this);
+
+    continuation = task;
+    continuationGroup = groupForTask;
+}
+
+//==============================================================================
+WorkStealingScheduler::WorkStealingScheduler (int numWorkers, int threadPriority, bool pinWorkersToCores,
+                                              int queueCapacity, size_t threadStackSize)
+{
+    jassert (numWorkers > 0); // not much point having a scheduler without any threads!
+
+    createWorkers (numWorkers, threadPriority, pinWorkersToCores, queueCapacity, threadStackSize);
+}
+
+WorkStealingScheduler::WorkStealingScheduler()
+{
+    createWorkers (SystemStats::getNumCpus(), 5, false, 1024, 0);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+    for (auto* w : workers)
+        w->signalThreadShouldExit();
+
+    for (auto* w : workers)
+    {
+        workAvailable.signal();
+        w->stopThread (-1);
+    }
+
+    Random random;
+
+    while (auto* task = findTask (-1, random))
+        runTask (*task);
+}
+
+void WorkStealingScheduler::createWorkers (int numWorkers, int threadPriority, bool pinWorkersToCores,
+                                           int queueCapacity, size_t threadStackSize)
+{
+    numWorkers = jmax (1, numWorkers);
+    queueCapacity = (int) nextPowerOfTwo (jmax (2, queueCapacity));
+
+    submissionQueue = new SubmissionQueue (queueCapacity);
+
+    for (int i = numWorkers; --i >= 0;)
+        workers.add (new Worker (*this, workers.size(), queueCapacity, threadStackSize));
+
+    auto numCpus = jlimit (1, 32, SystemStats::getNumCpus());
+
+    for (auto* w : workers)
+    {
+        if (pinWorkersToCores)
+            w->setAffinityMask (1u << (w->workerIndex % numCpus));
+
+        w->startThread (threadPriority);
+    }
+}
+
+int WorkStealingScheduler::getNumWorkers() const noexcept
+{
+    return workers.size();
+}
+
+int WorkStealingScheduler::getCurrentWorkerIndex() const noexcept
+{
+    auto currentThread = Thread::getCurrentThreadId();
+
+    for (auto* w : workers)
+        if (w->threadID.get() == currentThread)
+            return w->workerIndex;
+
+    return -1;
+}
+
+//==============================================================================
+void WorkStealingScheduler::submit (Task& task, TaskGroup* group) noexcept
+{
+    // a task can't be submitted again until it has finished running!
+    jassert (task.group == nullptr);
+
+    if (group != nullptr)
+        ++(group->numPending);
+
+    task.group = group;
+    enqueue (task, getCurrentWorkerIndex());
+}
+
+void WorkStealingScheduler::submit (Task* const* tasks, int numTasks, TaskGroup* group) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    if (group != nullptr)
+        group->numPending += numTasks;
+
+    auto workerIndex = getCurrentWorkerIndex();
+
+    for (int i = 0; i < numTasks; ++i)
+    {
+        auto& task = *tasks[i];
+
+        // a task can't be submitted again until it has finished running!
+        jassert (task.group == nullptr);
+
+        task.group = group;
+        enqueue (task, workerIndex);
+    }
+}
+
+void WorkStealingScheduler::enqueue (Task& task, int workerIndex) noexcept
+{
+    if ((workerIndex >= 0 && workers.getUnchecked (workerIndex)->deque.push (&task))
+          || submissionQueue->push (&task))
+        wakeWorkerIfSleeping();
+    else
+        runTask (task);
+}
+
+void WorkStealingScheduler::wait (TaskGroup& group) noexcept
+{
+    auto workerIndex = getCurrentWorkerIndex();
+    Random random;
+
+    while (! group.isFinished())
+    {
+        if (auto* task = findTask (workerIndex, random))
+            runTask (*task);
+        else
+            Thread::yield();
+    }
+}
+
+WorkStealingScheduler::Task* WorkStealingScheduler::findTask (int workerIndex, Random& random) noexcept
+{
+    if (workerIndex >= 0)
+        if (auto* task = workers.getUnchecked (workerIndex)->deque.pop())
+            return task;
+
+    if (auto* task = submissionQueue->pop())
+        return task;
+
+    auto numWorkers = workers.size();
+    auto start = random.nextInt (numWorkers);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto victim = (start + i) % numWorkers;
+
+        if (victim != workerIndex)
+            if (auto* task = workers.getUnchecked (victim)->deque.steal())
+                return task;
+    }
+
+    return nullptr;
+}
+
+void WorkStealingScheduler::runTask (Task& task) noexcept
+{
+    // If there's more work queued up and another worker is asleep, wake it before
+    // getting stuck into this task, so that a burst of submissions fans out quickly.
+    if (numSleepingWorkers.get() > 0 && ! submissionQueue->isEmpty())
+        workAvailable.signal();
+
+    auto* group = task.group;
+    task.group = nullptr;
+    task.run();
+
+    if (group != nullptr)
+    {
+        for (;;)
+        {
+            auto numPending = group->numPending.get();
+
+            // If this is the last task, the continuation is submitted before the group is
+            // marked as finished, so anyone waiting on the group will find it already counted
+            // in its own group. Once the count reaches zero, the group may be deleted by a
+            // waiting thread, so it mustn't be touched again after that.
+            if (numPending == 1 && group->continuation != nullptr)
+            {
+                submit (*group->continuation, group->continuationGroup);
+                --(group->numPending);
+                break;
+            }
+
+            if (group->numPending.compareAndSetBool (numPending - 1, numPending))
+                break;
+        }
+    }
+}
+
+void WorkStealingScheduler::wakeWorkerIfSleeping() noexcept
+{
+    if (numSleepingWorkers.get() > 0)
+        workAvailable.signal();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WorkStealingSchedulerTests  : public UnitTest
+{
+public:
+    WorkStealingSchedulerTests() : UnitTest ("WorkStealingScheduler", "Threads") {}
+
+    struct CountingTask  : public WorkStealingScheduler::Task
+    {
+        CountingTask (Atomic<int>& c) : counter (c) {}
+        void run() override   { ++counter; }
+
+        Atomic<int>& counter;
+    };
+
+    struct SpawningTask  : public WorkStealingScheduler::Task
+    {
+        SpawningTask (WorkStealingScheduler& s, OwnedArray<CountingTask>& c, WorkStealingScheduler::TaskGroup& g)
+            : scheduler (s), children (c), group (g) {}
+
+        void run() override
+        {
+            WorkStealingScheduler::TaskGroup childGroup;
+
+            for (auto* c : children)
+                scheduler.submit (*c, &childGroup);
+
+            scheduler.wait (childGroup);
+
+            for (auto* c : children)
+                scheduler.submit (*c, &group);
+        }
+
+        WorkStealingScheduler& scheduler;
+        OwnedArray<CountingTask>& children;
+        WorkStealingScheduler::TaskGroup& group;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Submit and wait");
+        {
+            WorkStealingScheduler scheduler (4);
+            WorkStealingScheduler::TaskGroup group;
+            Atomic<int> counter;
+            OwnedArray<CountingTask> tasks;
+
+            for (int i = 0; i < 5000; ++i)
+                tasks.add (new CountingTask (counter));
+
+            for (int round = 0; round < 4; ++round)
+            {
+                for (auto* t : tasks)
+                    scheduler.submit (*t, &group);
+
+                scheduler.wait (group);
+            }
+
+            expect (group.isFinished());
+            expectEquals (counter.get(), 4 * tasks.size());
+        }
+
+        beginTest ("Nested submission");
+        {
+            WorkStealingScheduler scheduler (3, 5, false, 16);
+            WorkStealingScheduler::TaskGroup group;
+            Atomic<int> counter;
+            OwnedArray<CountingTask> children;
+
+            for (int i = 0; i < 100; ++i)
+                children.add (new CountingTask (counter));
+
+            SpawningTask parent (scheduler, children, group);
+            scheduler.submit (parent, &group);
+            scheduler.wait (group);
+
+            expectEquals (counter.get(), 2 * children.size());
+        }
+
+        beginTest ("Continuations");
+        {
+            WorkStealingScheduler scheduler (2);
+            WorkStealingScheduler::TaskGroup first, second;
+            Atomic<int> counter, finishedCount;
+            bool allFinishedFirst = false;
+
+            WorkStealingScheduler::FunctionTask continuation ([&]
+            {
+                allFinishedFirst = (counter.get() == 64);
+                ++finishedCount;
+            });
+
+            first.setContinuation (&continuation, &second);
+
+            OwnedArray<CountingTask> tasks;
+            Array<WorkStealingScheduler::Task*> batch;
+
+            for (int i = 0; i < 64; ++i)
+                batch.add (tasks.add (new CountingTask (counter)));
+
+            scheduler.submit (batch.getRawDataPointer(), batch.size(), &first);
+            scheduler.wait (first);
+            scheduler.wait (second);
+
+            expect (allFinishedFirst);
+            expectEquals (finishedCount.get(), 1);
+        }
+
+        beginTest ("Deletion runs remaining tasks");
+        {
+            Atomic<int> counter;
+            OwnedArray<CountingTask> tasks;
+
+            for (int i = 0; i < 500; ++i)
+                tasks.add (new CountingTask (counter));
+
+            {
+                WorkStealingScheduler scheduler (2);
+
+                for (auto* t : tasks)
+                    scheduler.submit (*t);
+            }
+
+            expectEquals (counter.get(), tasks.size());
+        }
+    }
+};
+
+static WorkStealingSchedulerTests workStealingSchedulerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,259 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of worker threads that run lightweight tasks using work stealing.
+
+    Unlike ThreadPool, which keeps its jobs in a locked list, each worker here
+    owns a lock-free deque of tasks. A worker pushes and pops tasks at one end
+    of its own deque, and idle workers steal from the other end of their
+    neighbours' deques, so thousands of tiny tasks can be spread across the
+    threads without contention on a single lock.
+
+    Submitting a task never allocates memory or waits for other threads, so it's
+    safe to call submit() from a realtime audio thread. Tasks submitted from outside the
+    scheduler go into a bounded lock-free queue that all the workers read from;
+    tasks submitted from inside another task go straight onto the current
+    worker's deque. If both are full, the task is simply run on the calling thread.
+
+    Tasks can be collected into a TaskGroup, which lets you wait for a batch of
+    work to complete, or have another task submitted automatically when the
+    whole group has finished.
+
+    E.g.
+    @code
+    WorkStealingScheduler scheduler;
+    WorkStealingScheduler::TaskGroup group;
+
+    OwnedArray<MyTask> tasks;   // created in advance, so no allocation is needed later
+
+    for (auto* t : tasks)
+        scheduler.submit (*t, &group);
+
+    scheduler.wait (group);     // the calling thread helps out until the group is done
+    @endcode
+
+    @see ThreadPool, WorkStealingScheduler::Task, WorkStealingScheduler::TaskGroup
+*/
+
+class JUCE_API  WorkStealingScheduler
+{
+public:
+    //==============================================================================
+    class TaskGroup;
+
+    /**
+        A unit of work that can be run by a WorkStealingScheduler.
+
+        Subclasses implement run() to do their work. The scheduler doesn't take
+        ownership of the task, so the object must stay alive until it has run.
+        A task can be submitted again once it has finished running, but mustn't
+        be submitted while it's still waiting in a queue.
+    */
+    class JUCE_API  Task
+    {
+    public:
+        /** Creates a task. */
+        Task() noexcept;
+
+        /** Destructor. */
+        virtual ~Task();
+
+        /** Performs the task's work.
+            This is called on one of the scheduler's threads, or on a thread that is
+            helping out inside WorkStealingScheduler::wait().
+        */
+        virtual void run() = 0;
+
+    private:
+        friend class WorkStealingScheduler;
+        TaskGroup* group = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Task)
+    };
+
+    //==============================================================================
+    /**
+        A Task that calls a std::function.
+
+        The function is stored when the task is created, so submitting it later
+        doesn't allocate anything.
+    */
+    class JUCE_API  FunctionTask  : public Task
+    {
+    public:
+        /** Creates a task that will call the given function. */
+        explicit FunctionTask (std::function<void()> functionToCall);
+
+        /** @internal */
+        void run() override;
+
+    private:
+        std::function<void()> function;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FunctionTask)
+    };
+
+    //==============================================================================
+    /**
+        Keeps track of a set of tasks, so that you can find out when they've all finished.
+
+        Pass a TaskGroup to WorkStealingScheduler::submit() to add a task to it. When the
+        last of its tasks has completed, the group will submit its continuation task,
+        if one has been set.
+
+        A group mustn't be deleted while it still has tasks in progress.
+    */
+    class JUCE_API  TaskGroup
+    {
+    public:
+        /** Creates an empty group. */
+        TaskGroup() noexcept;
+
+        /** Destructor. */
+        ~TaskGroup();
+
+        /** Returns true if none of the tasks in this group are still waiting or running. */
+        bool isFinished() const noexcept                { return numPending.get() == 0; }
+
+        /** Returns the number of tasks in this group that haven't yet finished. */
+        int getNumPendingTasks() const noexcept         { return numPending.get(); }
+
+        /** Sets a task that will be submitted when all the tasks in this group have finished.
+
+            The continuation is submitted each time the group's count of pending tasks drops
+            to zero, so if you want it to run once after a whole batch, add the tasks with the
+            version of WorkStealingScheduler::submit() that takes an array.
+
+            The continuation will be added to continuationGroup, if one is given, before this
+            group is marked as finished, so it's safe to wait on each group in turn. This must be
+            set before submitting any of the group's tasks, and it stays in place until you
+            change it, so the group can be re-used for several rounds of work.
+        */
+        void setContinuation (Task* taskToSubmitWhenFinished,
+                              TaskGroup* continuationGroup = nullptr) noexcept;
+
+    private:
+        friend class WorkStealingScheduler;
+        Atomic<int> numPending;
+        Task* continuation = nullptr;
+        TaskGroup* continuationGroup = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskGroup)
+    };
+
+    //==============================================================================
+    /** Creates a scheduler.
+
+        @param numberOfWorkers      the number of threads to run. These are started
+                                    immediately, and run until the scheduler is deleted.
+        @param threadPriority       the priority to give the workers, in the range 0 to 10, or
+                                    Thread::realtimeAudioPriority to run them at the same
+                                    priority as an audio callback.
+        @param pinWorkersToCores    if true, each worker is given an affinity mask that ties
+                                    it to a single CPU core.
+        @param queueCapacity        the maximum number of tasks that each worker's deque and the
+                                    shared submission queue can hold. This is rounded up
+                                    to a power of two.
+        @param threadStackSize      the stack size for each thread, or zero to use the OS default.
+    */
+    WorkStealingScheduler (int numberOfWorkers,
+                           int threadPriority = 5,
+                           bool pinWorkersToCores = false,
+                           int queueCapacity = 1024,
+                           size_t threadStackSize = 0);
+
+    /** Creates a scheduler with one worker per CPU core.
+        @see SystemStats::getNumCpus()
+    */
+    WorkStealingScheduler();
+
+    /** Destructor.
+        This stops all the workers, and then runs any tasks that were still left in the
+        queues on the calling thread, so that no TaskGroup is left unfinished.
+    */
+    ~WorkStealingScheduler();
+
+    //==============================================================================
+    /** Adds a task to be run by one of the workers.
+
+        This never allocates memory, and apart from signalling a worker if they're all
+        asleep it only touches lock-free queues, so it can be called from a realtime thread.
+        If the group is non-null, the task is added to it and the group will be updated
+        when the task finishes.
+
+        If the queues are full, the task is run immediately on the calling thread.
+    */
+    void submit (Task& task, TaskGroup* group = nullptr) noexcept;
+
+    /** Adds a batch of tasks to be run by the workers.
+
+        This behaves like calling submit() for each task, except that the group's count
+        is raised for all of them before any are queued, so the group can't finish and
+        fire its continuation part-way through the batch.
+    */
+    void submit (Task* const* tasks, int numTasks, TaskGroup* group = nullptr) noexcept;
+
+    /** Waits for all the tasks in a group to finish.
+
+        Rather than sleeping, the calling thread will run any queued tasks it can find
+        while it waits, so this can safely be called from inside another task without
+        starving the workers.
+    */
+    void wait (TaskGroup& group) noexcept;
+
+    /** Returns the number of worker threads. */
+    int getNumWorkers() const noexcept;
+
+    /** If the calling thread is one of this scheduler's workers, this returns its index,
+        otherwise it returns -1.
+    */
+    int getCurrentWorkerIndex() const noexcept;
+
+private:
+    //==============================================================================
+    struct WorkDeque;
+    struct SubmissionQueue;
+    class Worker;
+    friend class Worker;
+    friend struct ContainerDeletePolicy<Worker>;
+
+    OwnedArray<Worker> workers;
+    ScopedPointer<SubmissionQueue> submissionQueue;
+    Atomic<int> numSleepingWorkers;
+    WaitableEvent workAvailable;
+
+    void createWorkers (int numWorkers, int threadPriority, bool pinWorkersToCores,
+                        int queueCapacity, size_t threadStackSize);
+    void enqueue (Task&, int workerIndex) noexcept;
+    Task* findTask (int workerIndex, Random&) noexcept;
+    void runTask (Task&) noexcept;
+    void wakeWorkerIfSleeping() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkStealingScheduler)
+};
+
+} // namespace juce
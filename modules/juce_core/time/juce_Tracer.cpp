@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct Tracer::Event
+{
+    int64 ticks;
+    const char* name;
+    double value;
+    int64 argument;
+    EventType type;
+};
+
+//==============================================================================
+// Only the thread that owns a buffer writes to it, so adding an event just needs the
+// write to be published before the count, for the benefit of anyone reading it.
+struct Tracer::ThreadBuffer
+{
+    ThreadBuffer (int capacity, const String& threadName)
+        : mask ((uint64) nextPowerOfTwo (jmax (16, capacity)) - 1), name (threadName)
+    {
+        events.malloc ((size_t) mask + 1);
+    }
+
+    void add (const Event& e) noexcept
+    {
+        auto n = numWritten.load (std::memory_order_relaxed);
+        events[n & mask] = e;
+        numWritten.store (n + 1, std::memory_order_release);
+    }
+
+    // Copies out the events that are still in the buffer, leaving out any that were
+    // overwritten while they were being copied
+    Array<Event> getEvents (int64 startTicks) const
+    {
+        auto capacity = mask + 1;
+        auto end = numWritten.load (std::memory_order_acquire);
+        auto begin = end > capacity ? end - capacity : 0;
+
+        Array<Event> result;
+        result.ensureStorageAllocated ((int) (end - begin));
+
+        for (auto i = begin; i < end; ++i)
+            result.add (events[i & mask]);
+
+        auto newEnd = numWritten.load (std::memory_order_acquire);
+        // (the slot after the last one that was written may be in the middle of being overwritten)
+        auto numOverwritten = (int) jmin ((uint64) result.size(), newEnd + 1 > capacity + begin ? newEnd + 1 - capacity - begin : 0);
+        result.removeRange (0, numOverwritten);
+
+        int numBeforeStart = 0;
+
+        while (numBeforeStart < result.size() && result.getReference (numBeforeStart).ticks < startTicks)
+            ++numBeforeStart;
+
+        result.removeRange (0, numBeforeStart);
+        return result;
+    }
+
+    HeapBlock<Event> events;
+    const uint64 mask;
+    std::atomic<uint64> numWritten { 0 };
+    String name;
+
+    JUCE_DECLARE_NON_COPYABLE (ThreadBuffer)
+};
+
+//==============================================================================
+// A fixed-size hash table of buffers keyed on the thread ID. Threads only ever claim
+// empty slots, so looking up a thread's buffer doesn't need a lock.
+struct Tracer::Registry
+{
+    Registry()
+    {
+        for (int i = 0; i < maxThreads; ++i)
+        {
+            threadIds[i] = nullptr;
+            buffers[i] = nullptr;
+        }
+    }
+
+    ~Registry()
+    {
+        for (auto& b : buffers)
+            delete b.load();
+    }
+
+    static Registry& get()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadBuffer* getBufferForCurrentThread (const String& threadName)
+    {
+        auto threadId = Thread::getCurrentThreadId();
+        auto hash = (int) (((uint64) (pointer_sized_uint) threadId * 0x9e3779b97f4a7c15ULL) >> 56);
+
+        for (int i = 0; i < maxThreads; ++i)
+        {
+            auto slot = (hash + i) & (maxThreads - 1);
+            auto existing = threadIds[slot].load (std::memory_order_acquire);
+
+            if (existing == nullptr)
+            {
+                // this may lose the race with another thread, in which case it carries on looking
+                if (! threadIds[slot].compare_exchange_strong (existing, threadId))
+                    continue;
+
+                auto* buffer = new ThreadBuffer (eventsPerThread.load(), getDefaultName (threadName, slot));
+                buffers[slot].store (buffer, std::memory_order_release);
+                return buffer;
+            }
+
+            if (existing == threadId)
+                return buffers[slot].load (std::memory_order_acquire);
+        }
+
+        // There are more threads than this can keep track of, so events on any further
+        // threads will be ignored.
+        return nullptr;
+    }
+
+    static String getDefaultName (const String& threadName, int slot)
+    {
+        if (threadName.isNotEmpty())
+            return threadName;
+
+        if (auto* t = Thread::getCurrentThread())
+            return t->getThreadName();
+
+        return "Thread " + String (slot);
+    }
+
+    enum { maxThreads = 256 };
+
+    std::atomic<Thread::ThreadID> threadIds[maxThreads];
+    std::atomic<ThreadBuffer*> buffers[maxThreads];
+    std::atomic<int> eventsPerThread { 65536 };
+    std::atomic<int64> startTicks { 0 };
+    CriticalSection nameLock;
+
+    JUCE_DECLARE_NON_COPYABLE (Registry)
+};
+
+//==============================================================================
+std::atomic<bool> Tracer::active { false };
+constexpr int64 Tracer::noArgument;
+
+void Tracer::start (int maxEventsPerThread)
+{
+    auto& registry = Registry::get();
+    registry.eventsPerThread = maxEventsPerThread;
+    registry.startTicks = Time::getHighResolutionTicks();
+    active = true;
+}
+
+void Tracer::stop() noexcept
+{
+    active = false;
+}
+
+void Tracer::registerCurrentThread (const String& threadName)
+{
+    auto& registry = Registry::get();
+
+    if (auto* buffer = registry.getBufferForCurrentThread (threadName))
+    {
+        if (threadName.isNotEmpty())
+        {
+            const ScopedLock sl (registry.nameLock);
+            buffer->name = threadName;
+        }
+    }
+}
+
+void Tracer::addEvent (EventType type, const char* name, double value, int64 argument) noexcept
+{
+    if (auto* buffer = Registry::get().getBufferForCurrentThread ({}))
+        buffer->add ({ Time::getHighResolutionTicks(), name, value, argument, type });
+}
+
+int Tracer::getNumEventsRecorded()
+{
+    auto& registry = Registry::get();
+    int total = 0;
+
+    for (auto& b : registry.buffers)
+        if (auto* buffer = b.load (std::memory_order_acquire))
+            total += buffer->getEvents (registry.startTicks).size();
+
+    return total;
+}
+
+//==============================================================================
+static String quotedTraceName (const char* name)
+{
+    return JSON::toString (var (String (CharPointer_UTF8 (name))));
+}
+
+bool Tracer::writeChromeTrace (OutputStream& out)
+{
+    auto& registry = Registry::get();
+    auto startTicks = registry.startTicks.load();
+    auto microsecondsPerTick = 1.0e6 / (double) Time::getHighResolutionTicksPerSecond();
+    bool isFirst = true;
+
+    auto beginEvent = [&] (const String& name, const char* phase, int tid)
+    {
+        out << (isFirst ? "\n" : ",\n") << "{\"name\":" << name << ",\"ph\":\"" << phase
+            << "\",\"pid\":1,\"tid\":" << tid;
+
+        isFirst = false;
+    };
+
+    out << "{\"traceEvents\":[";
+
+    for (int tid = 0; tid < Registry::maxThreads; ++tid)
+    {
+        auto* buffer = registry.buffers[tid].load (std::memory_order_acquire);
+
+        if (buffer == nullptr)
+            continue;
+
+        String threadName;
+
+        {
+            const ScopedLock sl (registry.nameLock);
+            threadName = buffer->name;
+        }
+
+        beginEvent ("\"thread_name\"", "M", tid);
+        out << ",\"args\":{\"name\":" << JSON::toString (threadName) << "}}";
+
+        // the buffer may have wrapped around in the middle of a zone, so any ends that
+        // don't have a matching begin are left out
+        int depth = 0;
+
+        for (auto& e : buffer->getEvents (startTicks))
+        {
+            auto timestamp = String ((double) (e.ticks - startTicks) * microsecondsPerTick, 3);
+
+            switch (e.type)
+            {
+                case zoneBegin:
+                    ++depth;
+                    beginEvent (quotedTraceName (e.name), "B", tid);
+
+                    if (e.argument != noArgument)
+                        out << ",\"args\":{\"value\":" << e.argument << "}";
+
+                    break;
+
+                case zoneEnd:
+                    if (depth == 0)
+                        continue;
+
+                    --depth;
+                    beginEvent (quotedTraceName (e.name), "E", tid);
+                    break;
+
+                case counterValue:
+                    beginEvent (quotedTraceName (e.name), "C", tid);
+                    out << ",\"args\":{\"value\":" << String (e.value) << "}";
+                    break;
+
+                case instantEvent:
+                    beginEvent (quotedTraceName (e.name), "i", tid);
+                    out << ",\"s\":\"t\"";
+                    break;
+
+                case flowStart:
+                case flowMiddle:
+                case flowFinish:
+                    beginEvent (quotedTraceName (e.name), e.type == flowStart ? "s" : (e.type == flowMiddle ? "t" : "f"), tid);
+                    out << ",\"cat\":\"flow\",\"id\":\"0x" << String::toHexString (e.argument) << "\"";
+
+                    if (e.type == flowFinish)
+                        out << ",\"bp\":\"e\"";
+
+                    break;
+
+                default:
+                    jassertfalse;
+                    continue;
+            }
+
+            out << ",\"ts\":" << timestamp << "}";
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return true;
+}
+
+bool Tracer::writeChromeTrace (const File& file)
+{
+    FileOutputStream out (file);
+
+    if (out.failedToOpen())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+
+    writeChromeTrace (out);
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TracerTests  : public UnitTest
+{
+public:
+    TracerTests() : UnitTest ("Tracer", "Threads") {}
+
+    // These are kept running until the test has finished, because a new thread might be given
+    // the ID of one that has exited, and would then carry on using its buffer.
+    struct TracingThread  : public Thread
+    {
+        TracingThread() : Thread ("Tracing thread") {}
+
+        ~TracingThread()
+        {
+            canExit.signal();
+            stopThread (-1);
+        }
+
+        void writeEvents()
+        {
+            startThread();
+            eventsWritten.wait (-1);
+        }
+
+        void run() override
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                Tracer::ScopedZone zone ("worker zone", i);
+                Tracer::counter ("worker counter", i * 0.5);
+            }
+
+            Tracer::flowEnd ("test flow", 1234);
+
+            eventsWritten.signal();
+            canExit.wait (-1);
+        }
+
+        WaitableEvent eventsWritten, canExit;
+    };
+
+    static var findEvent (const var& trace, const String& name, const String& phase)
+    {
+        if (auto* events = trace["traceEvents"].getArray())
+            for (auto& e : *events)
+                if (e["name"].toString() == name && e["ph"].toString() == phase)
+                    return e;
+
+        return {};
+    }
+
+    void runTest() override
+    {
+        TracingThread thread1, thread2;
+
+        beginTest ("Recording events on several threads");
+        {
+            Tracer::start();
+
+            {
+                Tracer::ScopedZone zone ("main zone");
+                Tracer::flowBegin ("test flow", 1234);
+                Tracer::instant ("main instant");
+                thread1.writeEvents();
+            }
+
+            Tracer::stop();
+            Tracer::instant ("ignored after stop");
+
+            expectEquals (Tracer::getNumEventsRecorded(), 2 + 1 + 1 + 100 * 3 + 1);
+
+            MemoryOutputStream out;
+            expect (Tracer::writeChromeTrace (out));
+
+            auto trace = JSON::parse (out.toString());
+            auto numThreads = trace["traceEvents"].size() - Tracer::getNumEventsRecorded();
+            expect (numThreads >= 2);
+
+            auto mainZone = findEvent (trace, "main zone", "B");
+            auto workerZone = findEvent (trace, "worker zone", "B");
+            expect (mainZone.isObject() && workerZone.isObject());
+            expect (mainZone["tid"] != workerZone["tid"]);
+            expectEquals ((int) workerZone["args"]["value"], 0);
+
+            expect (findEvent (trace, "thread_name", "M")["args"]["name"].toString().isNotEmpty());
+            expectEquals (findEvent (trace, "test flow", "s")["id"].toString(), String ("0x4d2"));
+            expect (findEvent (trace, "test flow", "f").isObject());
+            expect ((double) findEvent (trace, "worker counter", "C")["args"]["value"] == 0.0);
+            expect (findEvent (trace, "ignored after stop", "i").isVoid());
+        }
+
+        beginTest ("Ring buffers keep the newest events");
+        {
+            // only threads that are registered after this will use the smaller buffers
+            Tracer::start (64);
+            thread2.writeEvents();
+            Tracer::stop();
+
+            MemoryOutputStream out;
+            Tracer::writeChromeTrace (out);
+            auto trace = JSON::parse (out.toString());
+
+            int numWorkerBegins = 0, numWorkerEnds = 0;
+
+            for (auto& e : *trace["traceEvents"].getArray())
+            {
+                if (e["name"].toString() == "worker zone")
+                {
+                    if (e["ph"].toString() == "B")  ++numWorkerBegins;
+                    if (e["ph"].toString() == "E")  ++numWorkerEnds;
+                }
+            }
+
+            expect (numWorkerBegins > 0 && numWorkerBegins < 100);
+            expectEquals (numWorkerEnds, numWorkerBegins);
+            expect (findEvent (trace, "test flow", "f").isObject());
+            expect (findEvent (trace, "main zone", "B").isVoid());
+        }
+    }
+};
+
+static TracerTests tracerTests;
+
+#endif
+
+} // namespace juce
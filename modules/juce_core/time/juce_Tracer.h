@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records a timeline of events from any number of threads, which can be saved in
+    the Chrome trace format and viewed in chrome://tracing or the Perfetto UI.
+
+    Unlike PerformanceCounter, which averages a single interval, this records every
+    occurrence of each event along with the thread that it happened on, so you can
+    see how the work on the audio, message and rendering threads lines up.
+
+    Events are normally added with the JUCE_TRACE_ macros, which are compiled out
+    completely unless JUCE_ENABLE_TRACING is set, e.g.
+    @code
+    void MyProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+    {
+        JUCE_TRACE_ZONE ("MyProcessor::processBlock");
+        JUCE_TRACE_COUNTER ("MyProcessor voices", getNumActiveVoices());
+        ...
+    }
+
+    Tracer::start();
+    ...
+    Tracer::stop();
+    Tracer::writeChromeTrace (File ("~/trace.json"));
+    @endcode
+
+    Each thread writes into its own ring buffer without taking any locks, so adding
+    an event only costs a check of a flag, a read of the high-resolution clock and a
+    few stores. When a buffer is full, the oldest events on that thread are
+    overwritten. The first event on each thread allocates its buffer, so if you
+    don't want that to happen on the audio thread, call registerCurrentThread()
+    from it beforehand (e.g. in prepareToPlay).
+
+    The names that are passed in aren't copied, so they must be string literals or
+    other strings that will outlive the trace.
+
+    Several of JUCE's own classes add events when tracing is enabled: the
+    AudioDeviceManager callback, the nodes of an AudioProcessorGraph, message
+    dispatching (with flow events linking each message to the thread that posted
+    it), Component painting and OpenGLContext frames.
+
+    @see PerformanceCounter
+*/
+class JUCE_API  Tracer
+{
+public:
+    //==============================================================================
+    /** Starts recording events.
+
+        Any events that were recorded previously are discarded. The buffers of threads
+        that have already been registered keep their existing size; threads that are
+        registered after this call will have room for maxEventsPerThread events (which
+        is rounded up to a power of two).
+    */
+    static void start (int maxEventsPerThread = 65536);
+
+    /** Stops recording events. The events that were recorded are kept until start()
+        is called again, so they can be saved with writeChromeTrace().
+    */
+    static void stop() noexcept;
+
+    /** Returns true if events are currently being recorded. */
+    static bool isActive() noexcept         { return active.load (std::memory_order_relaxed); }
+
+    /** Creates the calling thread's buffer, and optionally gives the thread a name.
+        If no name is given, the name of the calling Thread object is used.
+    */
+    static void registerCurrentThread (const String& threadName = String());
+
+    //==============================================================================
+    /** Writes the recorded events as a Chrome trace JSON document.
+
+        This can be called while events are still being recorded, but events that are
+        overwritten while it's running will be left out.
+    */
+    static bool writeChromeTrace (OutputStream& output);
+
+    /** Writes the recorded events to a file as a Chrome trace JSON document. */
+    static bool writeChromeTrace (const File& file);
+
+    /** Returns the total number of events that are currently held in the buffers. */
+    static int getNumEventsRecorded();
+
+    //==============================================================================
+    /** Adds the start of a zone on the calling thread. Each call must be matched by a
+        call to endZone() on the same thread. @see ScopedZone
+    */
+    static void beginZone (const char* name, int64 argument = noArgument) noexcept   { if (isActive()) addEvent (zoneBegin, name, 0, argument); }
+
+    /** Adds the end of the zone that was most recently begun on the calling thread. */
+    static void endZone (const char* name) noexcept                                  { if (isActive()) addEvent (zoneEnd, name, 0, noArgument); }
+
+    /** Adds a value for a named counter, which is drawn as a graph. */
+    static void counter (const char* name, double value) noexcept                    { if (isActive()) addEvent (counterValue, name, value, noArgument); }
+
+    /** Adds an event that has no duration. */
+    static void instant (const char* name) noexcept                                  { if (isActive()) addEvent (instantEvent, name, 0, noArgument); }
+
+    /** Adds the start of a flow, which is drawn as an arrow to the flowStep() and
+        flowEnd() calls that have the same name and id, which may be on other threads.
+        A flow event is attached to the zone that encloses it.
+    */
+    static void flowBegin (const char* name, uint64 id) noexcept                     { if (isActive()) addEvent (flowStart, name, 0, (int64) id); }
+
+    /** Adds an intermediate step to a flow that was started with flowBegin(). */
+    static void flowStep (const char* name, uint64 id) noexcept                      { if (isActive()) addEvent (flowMiddle, name, 0, (int64) id); }
+
+    /** Adds the end of a flow that was started with flowBegin(). */
+    static void flowEnd (const char* name, uint64 id) noexcept                       { if (isActive()) addEvent (flowFinish, name, 0, (int64) id); }
+
+    //==============================================================================
+    /** Records a zone for the lifetime of this object. @see JUCE_TRACE_ZONE */
+    struct ScopedZone
+    {
+        ScopedZone (const char* zoneName, int64 argument = noArgument) noexcept
+            : name (isActive() ? zoneName : nullptr)
+        {
+            if (name != nullptr)
+                addEvent (zoneBegin, name, 0, argument);
+        }
+
+        ~ScopedZone() noexcept
+        {
+            // this is still written if tracing has been stopped since the zone began,
+            // so that the begin event isn't left without an end
+            if (name != nullptr)
+                addEvent (zoneEnd, name, 0, noArgument);
+        }
+
+    private:
+        const char* const name;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedZone)
+    };
+
+    /** The value used for zones that have no argument. */
+    static constexpr int64 noArgument = std::numeric_limits<int64>::min();
+
+private:
+    //==============================================================================
+    enum EventType : uint8
+    {
+        zoneBegin, zoneEnd, counterValue, instantEvent, flowStart, flowMiddle, flowFinish
+    };
+
+    struct Event;
+    struct ThreadBuffer;
+    struct Registry;
+
+    static std::atomic<bool> active;
+
+    static void addEvent (EventType, const char* name, double value, int64 argument) noexcept;
+
+    Tracer() = delete;
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Records a zone on the calling thread, from this point to the end of the enclosing scope.
+     The name must be a string literal. @see Tracer
+ */
+ #define JUCE_TRACE_ZONE(name)                    const juce::Tracer::ScopedZone JUCE_JOIN_MACRO (juceTraceZone, __LINE__) (name)
+
+ /** Records a zone like JUCE_TRACE_ZONE, with a number that's shown alongside it, such as an ID. */
+ #define JUCE_TRACE_ZONE_WITH_ARG(name, argument) const juce::Tracer::ScopedZone JUCE_JOIN_MACRO (juceTraceZone, __LINE__) (name, (juce::int64) (argument))
+
+ /** Records a value of a counter. @see Tracer::counter */
+ #define JUCE_TRACE_COUNTER(name, value)          juce::Tracer::counter (name, (double) (value))
+
+ /** Records an event with no duration. @see Tracer::instant */
+ #define JUCE_TRACE_INSTANT(name)                 juce::Tracer::instant (name)
+
+ /** Records the start of a flow between threads. @see Tracer::flowBegin */
+ #define JUCE_TRACE_FLOW_BEGIN(name, id)          juce::Tracer::flowBegin (name, (juce::uint64) (id))
+
+ /** Records an intermediate step of a flow. @see Tracer::flowStep */
+ #define JUCE_TRACE_FLOW_STEP(name, id)           juce::Tracer::flowStep (name, (juce::uint64) (id))
+
+ /** Records the end of a flow. @see Tracer::flowEnd */
+ #define JUCE_TRACE_FLOW_END(name, id)            juce::Tracer::flowEnd (name, (juce::uint64) (id))
+#else
+ #define JUCE_TRACE_ZONE(name)
+ #define JUCE_TRACE_ZONE_WITH_ARG(name, argument)
+ #define JUCE_TRACE_COUNTER(name, value)
+ #define JUCE_TRACE_INSTANT(name)
+ #define JUCE_TRACE_FLOW_BEGIN(name, id)
+ #define JUCE_TRACE_FLOW_STEP(name, id)
+ #define JUCE_TRACE_FLOW_END(name, id)
+#endif
+
+} // namespace juce
@@ -0,0 +1,447 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Benchmark::Benchmark (const String& nm, const String& ctg)
+    : name (nm), category (ctg)
+{
+    getAllBenchmarks().add (this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Array<Benchmark*> Benchmark::getBenchmarksInCategory (const String& category)
+{
+    if (category.isEmpty())
+        return getAllBenchmarks();
+
+    Array<Benchmark*> benchmarks;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory() == category)
+            benchmarks.add (b);
+
+    return benchmarks;
+}
+
+StringArray Benchmark::getAllCategories()
+{
+    StringArray categories;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory().isNotEmpty())
+            categories.addIfNotAlreadyThere (b->getCategory());
+
+    return categories;
+}
+
+void Benchmark::initialise()  {}
+void Benchmark::shutdown()   {}
+
+void Benchmark::performBenchmark (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmark();
+    shutdown();
+}
+
+void Benchmark::measure (const String& caseName, const std::function<void()>& codeToTime, int64 itemsPerCall)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->measure (caseName, codeToTime, itemsPerCall);
+}
+
+void Benchmark::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+Random Benchmark::getRandom() const
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    return runner->randomForBenchmark;
+}
+
+//==============================================================================
+double BenchmarkRunner::Result::getItemsPerSecond() const noexcept
+{
+    return (itemsPerCall > 0 && median > 0) ? (double) itemsPerCall * 1.0e9 / median : 0.0;
+}
+
+String BenchmarkRunner::Result::getFullName() const
+{
+    return benchmarkName + " / " + caseName;
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner() {}
+BenchmarkRunner::~BenchmarkRunner() {}
+
+void BenchmarkRunner::setOptions (const Options& newOptions) noexcept
+{
+    jassert (newOptions.repetitions > 0 && newOptions.warmupRepetitions >= 0);
+    options = newOptions;
+}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results [index];
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<Benchmark*>& benchmarks, int64 randomSeed)
+{
+    results.clear();
+
+    // unlike the unit tests, the default seed is a fixed one, so that two runs
+    // will always be working on the same data
+    seed = randomSeed != 0 ? randomSeed : 0x5eed;
+    logMessage ("Random seed: 0x" + String::toHexString (seed));
+
+    for (auto* b : benchmarks)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        // each benchmark gets a freshly-seeded generator, so its data doesn't
+        // depend on which other benchmarks were run before it
+        randomForBenchmark = Random (seed);
+        currentBenchmark = b;
+
+        logMessage ("-----------------------------------------------------------------");
+        logMessage ("Running benchmark: " + b->getName());
+
+       #if JUCE_EXCEPTIONS_DISABLED
+        b->performBenchmark (this);
+       #else
+        try
+        {
+            b->performBenchmark (this);
+        }
+        catch (...)
+        {
+            logMessage ("!!! An unhandled exception was thrown!");
+        }
+       #endif
+    }
+
+    currentBenchmark = nullptr;
+}
+
+void BenchmarkRunner::runAllBenchmarks (int64 randomSeed)
+{
+    runBenchmarks (Benchmark::getAllBenchmarks(), randomSeed);
+}
+
+void BenchmarkRunner::runBenchmarksInCategory (const String& category, int64 randomSeed)
+{
+    runBenchmarks (Benchmark::getBenchmarksInCategory (category), randomSeed);
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+//==============================================================================
+static double timeCalls (const std::function<void()>& codeToTime, int64 numCalls)
+{
+    auto start = Time::getHighResolutionTicks();
+
+    for (int64 i = 0; i < numCalls; ++i)
+        codeToTime();
+
+    return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+}
+
+void BenchmarkRunner::measure (const String& caseName, const std::function<void()>& codeToTime, int64 itemsPerCall)
+{
+    jassert (currentBenchmark != nullptr && codeToTime != nullptr);
+
+    if (shouldAbortBenchmarks())
+        return;
+
+    // find how many calls it takes to make a repetition long enough to be timed accurately
+    int64 callsPerRepetition = 1;
+
+    for (;;)
+    {
+        auto seconds = timeCalls (codeToTime, callsPerRepetition);
+
+        if (seconds >= options.minimumRepetitionSeconds || callsPerRepetition >= (((int64) 1) << 40))
+            break;
+
+        // jump most of the way there if the time is big enough to trust, otherwise keep doubling
+        auto scale = seconds > options.minimumRepetitionSeconds * 0.1
+                        ? jlimit (1.1, 10.0, options.minimumRepetitionSeconds * 1.1 / seconds)
+                        : 2.0;
+
+        callsPerRepetition = jmax (callsPerRepetition + 1, (int64) ((double) callsPerRepetition * scale));
+    }
+
+    for (int i = 0; i < options.warmupRepetitions; ++i)
+        timeCalls (codeToTime, callsPerRepetition);
+
+    StatisticsAccumulator<double> stats;
+    Array<double> times;
+
+    for (int i = 0; i < options.repetitions && ! shouldAbortBenchmarks(); ++i)
+    {
+        auto nanoseconds = timeCalls (codeToTime, callsPerRepetition) * 1.0e9 / (double) callsPerRepetition;
+        stats.addValue (nanoseconds);
+        times.add (nanoseconds);
+    }
+
+    if (times.isEmpty())
+        return;
+
+    times.sort();
+    auto mid = times.size() / 2;
+
+    auto* r = new Result();
+    r->benchmarkName      = currentBenchmark->getName();
+    r->category           = currentBenchmark->getCategory();
+    r->caseName           = caseName;
+    r->numRepetitions     = times.size();
+    r->callsPerRepetition = callsPerRepetition;
+    r->itemsPerCall       = itemsPerCall;
+    r->minimum            = stats.getMinValue();
+    r->maximum            = stats.getMaxValue();
+    r->mean               = stats.getAverage();
+    r->median             = (times.size() & 1) != 0 ? times.getUnchecked (mid)
+                                                    : (times.getUnchecked (mid - 1) + times.getUnchecked (mid)) * 0.5;
+    r->standardDeviation  = stats.getStandardDeviation();
+    results.add (r);
+
+    auto message = "  " + caseName + ": " + String (r->median, 1) + " ns"
+                     + " (min " + String (r->minimum, 1)
+                     + ", max " + String (r->maximum, 1)
+                     + ", sd " + String (r->standardDeviation, 1) + ")";
+
+    if (itemsPerCall > 0)
+        message << ", " << String (r->getItemsPerSecond() / 1.0e6, 2) << " M items/sec";
+
+    logMessage (message);
+}
+
+//==============================================================================
+var BenchmarkRunner::getResultsAsVar() const
+{
+    auto* machine = new DynamicObject();
+    machine->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+    machine->setProperty ("operatingSystem", SystemStats::getOperatingSystemName());
+    machine->setProperty ("cpuVendor", SystemStats::getCpuVendor());
+    machine->setProperty ("cpuModel", SystemStats::getCpuModel());
+    machine->setProperty ("numCpus", SystemStats::getNumCpus());
+
+    auto* settings = new DynamicObject();
+    settings->setProperty ("seed", seed);
+    settings->setProperty ("warmupRepetitions", options.warmupRepetitions);
+    settings->setProperty ("repetitions", options.repetitions);
+    settings->setProperty ("minimumRepetitionSeconds", options.minimumRepetitionSeconds);
+
+    Array<var> resultList;
+
+    for (auto* r : results)
+    {
+        auto* o = new DynamicObject();
+        o->setProperty ("benchmark", r->benchmarkName);
+        o->setProperty ("category", r->category);
+        o->setProperty ("case", r->caseName);
+        o->setProperty ("repetitions", r->numRepetitions);
+        o->setProperty ("callsPerRepetition", r->callsPerRepetition);
+        o->setProperty ("itemsPerCall", r->itemsPerCall);
+        o->setProperty ("minimum", r->minimum);
+        o->setProperty ("median", r->median);
+        o->setProperty ("mean", r->mean);
+        o->setProperty ("maximum", r->maximum);
+        o->setProperty ("standardDeviation", r->standardDeviation);
+        o->setProperty ("itemsPerSecond", r->getItemsPerSecond());
+        resultList.add (var (o));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("machine", var (machine));
+    root->setProperty ("options", var (settings));
+    root->setProperty ("results", resultList);
+    return var (root);
+}
+
+String BenchmarkRunner::getResultsAsJSON() const
+{
+    return JSON::toString (getResultsAsVar());
+}
+
+StringArray BenchmarkRunner::findRegressions (const var& previousResults, double tolerance) const
+{
+    StringArray regressions;
+
+    if (auto* previousList = previousResults["results"].getArray())
+    {
+        for (auto* r : results)
+        {
+            for (auto& previous : *previousList)
+            {
+                if (previous["benchmark"].toString() == r->benchmarkName
+                     && previous["case"].toString() == r->caseName)
+                {
+                    auto previousMedian = (double) previous["median"];
+
+                    if (previousMedian > 0 && r->median > previousMedian * (1.0 + tolerance))
+                        regressions.add (r->getFullName() + ": " + String (previousMedian, 1) + " ns -> "
+                                           + String (r->median, 1) + " ns (+"
+                                           + String ((r->median / previousMedian - 1.0) * 100.0, 1) + "%)");
+
+                    break;
+                }
+            }
+        }
+    }
+
+    return regressions;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BenchmarkTests  : public UnitTest
+{
+public:
+    BenchmarkTests() : UnitTest ("Benchmark", "Benchmarks") {}
+
+    struct SummingBenchmark  : public Benchmark
+    {
+        SummingBenchmark() : Benchmark ("Summing", "Test") {}
+
+        void runBenchmark() override
+        {
+            Array<int> data;
+            auto r = getRandom();
+
+            for (int i = 0; i < 1000; ++i)
+                data.add (r.nextInt (100));
+
+            firstValue = data.getFirst();
+
+            measure ("sum 1000 ints", [&]
+            {
+                int total = 0;
+
+                for (auto v : data)
+                    total += v;
+
+                doNotOptimiseAway (total);
+            }, 1000);
+
+            measure ("no items", [] {});
+        }
+
+        int firstValue = 0;
+    };
+
+    struct QuietRunner  : public BenchmarkRunner
+    {
+        void logMessage (const String&) override {}
+    };
+
+    void runTest() override
+    {
+        SummingBenchmark benchmark;
+
+        QuietRunner benchmarkRunner;
+        BenchmarkRunner::Options options;
+        options.warmupRepetitions = 1;
+        options.repetitions = 5;
+        options.minimumRepetitionSeconds = 0.001;
+        benchmarkRunner.setOptions (options);
+
+        beginTest ("Measuring");
+        {
+            benchmarkRunner.runBenchmarks ({ &benchmark });
+            expectEquals (benchmarkRunner.getNumResults(), 2);
+
+            auto* r = benchmarkRunner.getResult (0);
+            expectEquals (r->caseName, String ("sum 1000 ints"));
+            expectEquals (r->numRepetitions, 5);
+            expect (r->callsPerRepetition > 0);
+            expect (r->minimum > 0 && r->minimum <= r->median && r->median <= r->maximum);
+            expect (r->getItemsPerSecond() > 0);
+            expect (benchmarkRunner.getResult (1)->getItemsPerSecond() == 0);
+        }
+
+        beginTest ("Data is reproducible");
+        {
+            auto firstValue = benchmark.firstValue;
+            benchmarkRunner.runBenchmarks ({ &benchmark });
+            expectEquals (benchmark.firstValue, firstValue);
+        }
+
+        beginTest ("JSON and regressions");
+        {
+            auto parsed = JSON::parse (benchmarkRunner.getResultsAsJSON());
+            expectEquals (parsed["results"].size(), 2);
+            expectEquals (parsed["results"][0]["case"].toString(), String ("sum 1000 ints"));
+            expect (benchmarkRunner.findRegressions (parsed, 0.1).isEmpty());
+
+            parsed["results"][0].getDynamicObject()->setProperty ("median", benchmarkRunner.getResult (0)->median * 0.5);
+            expectEquals (benchmarkRunner.findRegressions (parsed, 0.1).size(), 1);
+        }
+    }
+};
+
+static BenchmarkTests benchmarkTests;
+
+#endif
+
+} // namespace juce
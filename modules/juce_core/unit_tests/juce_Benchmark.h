@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class BenchmarkRunner;
+
+
+//==============================================================================
+/**
+    This is a base class for classes that measure how long some code takes to run.
+
+    It works in the same way as UnitTest: create a static instance of your subclass
+    and it'll be added to the list returned by Benchmark::getAllBenchmarks(), so that
+    a BenchmarkRunner can find and run it.
+
+    @code
+    class FooBenchmark  : public Benchmark
+    {
+    public:
+        FooBenchmark()  : Benchmark ("Foo", "Maths") {}
+
+        void runBenchmark() override
+        {
+            HeapBlock<float> data (4096);
+            fillWithNoise (data, 4096, getRandom());
+
+            measure ("process 4096 samples", [&] { foo.process (data, 4096); }, 4096);
+            measure ("calculate sum",        [&] { doNotOptimiseAway (foo.sum (data, 4096)); });
+        }
+    };
+
+    static FooBenchmark fooBenchmark;
+    @endcode
+
+    Each call to measure() times the code it's given many times over, and produces one
+    BenchmarkRunner::Result.
+
+    @see BenchmarkRunner, UnitTest
+*/
+class JUCE_API  Benchmark
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name and optionally places it in a category. */
+    explicit Benchmark (const String& name, const String& category = String());
+
+    /** Destructor. */
+    virtual ~Benchmark();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Returns the category of the benchmark. */
+    const String& getCategory() const noexcept   { return category; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmark (BenchmarkRunner* runner);
+
+    /** Returns the set of all Benchmark objects that currently exist. */
+    static Array<Benchmark*>& getAllBenchmarks();
+
+    /** Returns the set of Benchmarks in a specified category. */
+    static Array<Benchmark*> getBenchmarksInCategory (const String& category);
+
+    /** Returns a StringArray containing all of the categories of Benchmarks that have been registered. */
+    static StringArray getAllCategories();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up your benchmark.
+        This method will be called before runBenchmark().
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after your benchmark has been run.
+        This method will be called after runBenchmark() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass to set up the data and call measure()
+        for each of the things that you want to time.
+    */
+    virtual void runBenchmark() = 0;
+
+protected:
+    //==============================================================================
+    /** Times a piece of code.
+
+        The runner first finds how many calls to the function are needed to make each
+        repetition last long enough to be timed accurately. It then makes some warm-up
+        repetitions that aren't recorded, followed by the timed repetitions, and adds a
+        Result with the statistics to its list.
+
+        @param caseName         a name for this measurement, which is shown alongside the
+                                benchmark's name
+        @param codeToTime       the function to time. It should do the same amount of work
+                                each time it's called
+        @param itemsPerCall     if this is more than zero, it's used to work out a throughput
+                                figure, e.g. the number of samples that each call processes
+    */
+    void measure (const String& caseName, const std::function<void()>& codeToTime, int64 itemsPerCall = 0);
+
+    /** Writes a message to the benchmark log.
+        This can only be called from within your runBenchmark() method.
+    */
+    void logMessage (const String& message);
+
+    /** Returns a shared RandomNumberGenerator, which should be used to create any
+        test data. It's seeded by the runner, so that each run works on the same data.
+
+        This can only be called from within your runBenchmark() method.
+    */
+    Random getRandom() const;
+
+    /** Stops the compiler from optimising away the calculation of a value that the
+        benchmark doesn't otherwise use.
+    */
+    template <typename Type>
+    static void doNotOptimiseAway (const Type& value) noexcept
+    {
+        // reading it through a volatile pointer means that it has to have been calculated
+        ignoreUnused (*reinterpret_cast<const volatile char*> (&value));
+    }
+
+private:
+    //==============================================================================
+    const String name, category;
+    BenchmarkRunner* runner = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
+
+
+//==============================================================================
+/**
+    Runs a set of benchmarks.
+
+    You can instantiate one of these objects and use it to invoke tests on a set of
+    Benchmark objects. By using a subclass of BenchmarkRunner, you can intercept the
+    logging messages, and the results can be saved as JSON and compared with an earlier
+    run to find any regressions.
+
+    @see Benchmark
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** */
+    BenchmarkRunner();
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    //==============================================================================
+    /** The settings that control how each measurement is made. */
+    struct Options
+    {
+        /** The number of untimed repetitions that are made before the timed ones. */
+        int warmupRepetitions = 3;
+
+        /** The number of timed repetitions, from which the statistics are calculated. */
+        int repetitions = 20;
+
+        /** Each repetition calls the code enough times to take at least this long. */
+        double minimumRepetitionSeconds = 0.01;
+    };
+
+    /** Changes the settings that will be used by the next run. */
+    void setOptions (const Options& newOptions) noexcept;
+
+    /** Returns the settings that are being used. */
+    const Options& getOptions() const noexcept          { return options; }
+
+    //==============================================================================
+    /** Runs a set of benchmarks.
+
+        The benchmarks are run in order, and the results are logged. To run all the
+        registered Benchmark objects that exist, use runAllBenchmarks().
+
+        The randomSeed is used to create the data that the benchmarks work on, so it
+        should be the same for runs that are going to be compared. If it's zero, a fixed
+        default seed is used.
+    */
+    void runBenchmarks (const Array<Benchmark*>& benchmarks, int64 randomSeed = 0);
+
+    /** Runs all the Benchmark objects that currently exist. */
+    void runAllBenchmarks (int64 randomSeed = 0);
+
+    /** Runs all the Benchmark objects within a specified category. */
+    void runBenchmarksInCategory (const String& category, int64 randomSeed = 0);
+
+    //==============================================================================
+    /** Contains the results of one call to Benchmark::measure().
+        All the times are in nanoseconds per call to the function that was measured.
+    */
+    struct Result
+    {
+        /** The name of the Benchmark object that was run. */
+        String benchmarkName;
+        /** The category of the Benchmark object that was run. */
+        String category;
+        /** The name that was passed to Benchmark::measure(). */
+        String caseName;
+
+        /** The number of timed repetitions. */
+        int numRepetitions;
+        /** The number of times the function was called in each repetition. */
+        int64 callsPerRepetition;
+        /** The number of items that each call processes, or zero if this wasn't given. */
+        int64 itemsPerCall;
+
+        double minimum, maximum, mean, median, standardDeviation;
+
+        /** Returns the number of items processed per second, based on the median time. */
+        double getItemsPerSecond() const noexcept;
+
+        /** Returns the benchmark and case names, joined together. */
+        String getFullName() const;
+    };
+
+    /** Returns the number of results that have been produced. */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the results. */
+    const Result* getResult (int index) const noexcept;
+
+    /** Returns all the results, along with the options and some details of the machine,
+        as a JSON object.
+    */
+    var getResultsAsVar() const;
+
+    /** Returns the results of getResultsAsVar() as a JSON string. */
+    String getResultsAsJSON() const;
+
+    /** Compares these results with some that were saved earlier by getResultsAsJSON().
+
+        Any measurement whose median time has grown by more than the given proportion
+        (e.g. 0.1 for 10%) is listed in the array that's returned. Measurements that
+        don't appear in both sets of results are ignored.
+    */
+    StringArray findRegressions (const var& previousResults, double tolerance) const;
+
+protected:
+    /** Logs a message about the current progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should abort the benchmarks
+        as soon as possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class Benchmark;
+
+    Options options;
+    OwnedArray<Result> results;
+    Random randomForBenchmark;
+    int64 seed = 0;
+    Benchmark* currentBenchmark = nullptr;
+
+    void measure (const String& caseName, const std::function<void()>& codeToTime, int64 itemsPerCall);
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+} // namespace juce
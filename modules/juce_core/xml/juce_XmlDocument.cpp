@@ -50,81 +50,32 @@ void XmlDocument::setEmptyTextElementsIgnored (const bool shouldBeIgnored) noexc
     ignoreEmptyTextElements = shouldBeIgnored;
 }
 
-namespace XmlIdentifierChars
-{
-    static bool isIdentifierCharSlow (const juce_wchar c) noexcept
-    {
-        return CharacterFunctions::isLetterOrDigit (c)
-                 || c == '_' || c == '-' || c == ':' || c == '.';
-    }
-
-    static bool isIdentifierChar (const juce_wchar c) noexcept
-    {
-        static const uint32 legalChars[] = { 0, 0x7ff6000, 0x87fffffe, 0x7fffffe, 0 };
-
-        return ((int) c < (int) numElementsInArray (legalChars) * 32) ? ((legalChars [c >> 5] & (1 << (c & 31))) != 0)
-                                                                      : isIdentifierCharSlow (c);
-    }
-
-    /*static void generateIdentifierCharConstants()
-    {
-        uint32 n[8] = { 0 };
-        for (int i = 0; i < 256; ++i)
-            if (isIdentifierCharSlow (i))
-                n[i >> 5] |= (1 << (i & 31));
-
-        String s;
-        for (int i = 0; i < 8; ++i)
-            s << "0x" << String::toHexString ((int) n[i]) << ", ";
-
-        DBG (s);
-    }*/
-
-    static String::CharPointerType findEndOfToken (String::CharPointerType p) noexcept
-    {
-        while (isIdentifierChar (*p))
-            ++p;
-
-        return p;
-    }
-}
-
 XmlElement* XmlDocument::getDocumentElement (const bool onlyReadOuterDocumentElement)
 {
     if (originalText.isEmpty() && inputSource != nullptr)
     {
         if (ScopedPointer<InputStream> in = inputSource->createInputStream())
         {
-            MemoryOutputStream data;
-            data.writeFromInputStream (*in, onlyReadOuterDocumentElement ? 8192 : -1);
+            // if the stream's already in memory, it can be parsed without copying it at all
+            size_t numAvailable = 0;
 
-           #if JUCE_STRING_UTF_TYPE == 8
-            if (data.getDataSize() > 2)
+            if (auto* view = in->getDirectView (numAvailable))
             {
-                data.writeByte (0);
-                auto* text = static_cast<const char*> (data.getData());
+                XmlReader reader (view, onlyReadOuterDocumentElement ? jmin (numAvailable, (size_t) 8192) : numAvailable);
+                return parseDocumentElement (reader, onlyReadOuterDocumentElement);
+            }
 
-                if (CharPointer_UTF16::isByteOrderMarkBigEndian (text)
-                      || CharPointer_UTF16::isByteOrderMarkLittleEndian (text))
-                {
-                    originalText = data.toString();
-                }
-                else
-                {
-                    if (CharPointer_UTF8::isByteOrderMark (text))
-                        text += 3;
+            // parse the input buffer directly to avoid copying it all to a string..
+            MemoryBlock data;
+            in->readIntoMemoryBlock (data, onlyReadOuterDocumentElement ? 8192 : -1);
 
-                    // parse the input buffer directly to avoid copying it all to a string..
-                    return parseDocumentElement (String::CharPointerType (text), onlyReadOuterDocumentElement);
-                }
-            }
-           #else
-            originalText = data.toString();
-           #endif
+            XmlReader reader (data.getData(), data.getSize());
+            return parseDocumentElement (reader, onlyReadOuterDocumentElement);
         }
     }
 
-    return parseDocumentElement (originalText.getCharPointer(), onlyReadOuterDocumentElement);
+    XmlReader reader (originalText);
+    return parseDocumentElement (reader, onlyReadOuterDocumentElement);
 }
 
 const String& XmlDocument::getLastParseError() const noexcept
@@ -147,577 +98,153 @@ String XmlDocument::getFileContents (const String& filename) const
     return {};
 }
 
-juce_wchar XmlDocument::readNextChar() noexcept
-{
-    auto c = input.getAndAdvance();
-
-    if (c == 0)
-    {
-        outOfData = true;
-        --input;
-    }
-
-    return c;
-}
-
-XmlElement* XmlDocument::parseDocumentElement (String::CharPointerType textToParse,
-                                               const bool onlyReadOuterDocumentElement)
+XmlElement* XmlDocument::parseDocumentElement (XmlReader& reader, const bool onlyReadOuterDocumentElement)
 {
-    input = textToParse;
+    lastError.clear();
     errorOccurred = false;
-    outOfData = false;
     needToLoadDTD = true;
+    tokenisedDTD.clear();
+    elementsFromEntities.clear();
+    reader.setEntityResolver (this);
 
-    if (textToParse.isEmpty())
-    {
-        lastError = "not enough input";
-    }
-    else if (! parseHeader())
-    {
-        lastError = "malformed header";
-    }
-    else if (! parseDTD())
-    {
-        lastError = "malformed DTD";
-    }
-    else
-    {
-        lastError.clear();
-        ScopedPointer<XmlElement> result (readNextElement (! onlyReadOuterDocumentElement));
+    auto token = reader.next();
+    dtdText = reader.getDTD().toString().trim();
 
-        if (! errorOccurred)
-            return result.release();
-    }
+    ScopedPointer<XmlElement> result;
 
-    return nullptr;
-}
-
-bool XmlDocument::parseHeader()
-{
-    skipNextWhiteSpace();
+    if (token == XmlReader::startElement)
+        result = readNextElement (reader, ! onlyReadOuterDocumentElement);
 
-    if (CharacterFunctions::compareUpTo (input, CharPointer_ASCII ("<?xml"), 5) == 0)
+    if (reader.getTokenType() == XmlReader::parseError)
     {
-        auto headerEnd = CharacterFunctions::find (input, CharPointer_ASCII ("?>"));
-
-        if (headerEnd.isEmpty())
-            return false;
-
-       #if JUCE_DEBUG
-        auto encoding = String (input, headerEnd)
-                          .fromFirstOccurrenceOf ("encoding", false, true)
-                          .fromFirstOccurrenceOf ("=", false, false)
-                          .fromFirstOccurrenceOf ("\"", false, false)
-                          .upToFirstOccurrenceOf ("\"", false, false)
-                          .trim();
-
-        /* If you load an XML document with a non-UTF encoding type, it may have been
-           loaded wrongly.. Since all the files are read via the normal juce file streams,
-           they're treated as UTF-8, so by the time it gets to the parser, the encoding will
-           have been lost. Best plan is to stick to utf-8 or if you have specific files to
-           read, use your own code to convert them to a unicode String, and pass that to the
-           XML parser.
-        */
-        jassert (encoding.isEmpty() || encoding.startsWithIgnoreCase ("utf-"));
-       #endif
-
-        input = headerEnd + 2;
-        skipNextWhiteSpace();
+        lastError = reader.getLastError();
+        return nullptr;
     }
 
-    return true;
-}
+    if (lastError.isEmpty())
+        lastError = reader.getLastError();
 
-bool XmlDocument::parseDTD()
-{
-    if (CharacterFunctions::compareUpTo (input, CharPointer_ASCII ("<!DOCTYPE"), 9) == 0)
-    {
-        input += 9;
-        auto dtdStart = input;
-
-        for (int n = 1; n > 0;)
-        {
-            auto c = readNextChar();
-
-            if (outOfData)
-                return false;
-
-            if (c == '<')
-                ++n;
-            else if (c == '>')
-                --n;
-        }
-
-        dtdText = String (dtdStart, input - 1).trim();
-    }
-
-    return true;
+    return errorOccurred ? nullptr : result.release();
 }
 
-void XmlDocument::skipNextWhiteSpace()
+XmlElement* XmlDocument::readNextElement (XmlReader& reader, const bool alsoParseSubElements)
 {
-    for (;;)
-    {
-        input = input.findEndOfWhitespace();
+    ScopedPointer<XmlElement> node (createElement (reader));
 
-        if (input.isEmpty())
-        {
-            outOfData = true;
-            break;
-        }
-
-        if (*input == '<')
-        {
-            if (input[1] == '!'
-                 && input[2] == '-'
-                 && input[3] == '-')
-            {
-                input += 4;
-                auto closeComment = input.indexOf (CharPointer_ASCII ("-->"));
-
-                if (closeComment < 0)
-                {
-                    outOfData = true;
-                    break;
-                }
+    if (alsoParseSubElements && ! reader.isEmptyElement())
+        if (! readChildElements (reader, *node))
+            return nullptr;
 
-                input += closeComment + 3;
-                continue;
-            }
-
-            if (input[1] == '?')
-            {
-                input += 2;
-                auto closeBracket = input.indexOf (CharPointer_ASCII ("?>"));
-
-                if (closeBracket < 0)
-                {
-                    outOfData = true;
-                    break;
-                }
-
-                input += closeBracket + 2;
-                continue;
-            }
-        }
-
-        break;
-    }
+    return node.release();
 }
 
-void XmlDocument::readQuotedString (String& result)
+XmlElement* XmlDocument::createElement (XmlReader& reader)
 {
-    auto quote = readNextChar();
-
-    while (! outOfData)
-    {
-        auto c = readNextChar();
-
-        if (c == quote)
-            break;
-
-        --input;
-
-        if (c == '&')
-        {
-            readEntity (result);
-        }
-        else
-        {
-            auto start = input;
-
-            for (;;)
-            {
-                auto character = *input;
-
-                if (character == quote)
-                {
-                    result.appendCharPointer (start, input);
-                    ++input;
-                    return;
-                }
+    const ScopedValueSetter<bool> notReadingText (isReadingText, false);
+    auto tagName = reader.getElementName();
 
-                if (character == '&')
-                {
-                    result.appendCharPointer (start, input);
-                    break;
-                }
+   #if JUCE_STRING_UTF_TYPE == 8
+    auto* node = new XmlElement (String::CharPointerType (tagName.start), String::CharPointerType (tagName.end));
+   #else
+    auto* node = new XmlElement (tagName.toString());
+   #endif
 
-                if (character == 0)
-                {
-                    setLastError ("unmatched quotes", false);
-                    outOfData = true;
-                    break;
-                }
-
-                ++input;
-            }
-        }
-    }
-}
+    LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (node->attributes);
 
-XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
-{
-    XmlElement* node = nullptr;
-    skipNextWhiteSpace();
-
-    if (outOfData)
-        return nullptr;
-
-    if (*input == '<')
+    for (int i = 0; i < reader.getNumAttributes(); ++i)
     {
-        ++input;
-        auto endOfToken = XmlIdentifierChars::findEndOfToken (input);
-
-        if (endOfToken == input)
-        {
-            // no tag name - but allow for a gap after the '<' before giving an error
-            skipNextWhiteSpace();
-            endOfToken = XmlIdentifierChars::findEndOfToken (input);
-
-            if (endOfToken == input)
-            {
-                setLastError ("tag name missing", false);
-                return node;
-            }
-        }
-
-        node = new XmlElement (input, endOfToken);
-        input = endOfToken;
-        LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (node->attributes);
-
-        // look for attributes
-        for (;;)
-        {
-            skipNextWhiteSpace();
-            auto c = *input;
-
-            // empty tag..
-            if (c == '/' && input[1] == '>')
-            {
-                input += 2;
-                break;
-            }
-
-            // parse the guts of the element..
-            if (c == '>')
-            {
-                ++input;
-
-                if (alsoParseSubElements)
-                    readChildElements (*node);
+        auto name = reader.getAttributeName (i);
 
-                break;
-            }
-
-            // get an attribute..
-            if (XmlIdentifierChars::isIdentifierChar (c))
-            {
-                auto attNameEnd = XmlIdentifierChars::findEndOfToken (input);
-
-                if (attNameEnd != input)
-                {
-                    auto attNameStart = input;
-                    input = attNameEnd;
-                    skipNextWhiteSpace();
-
-                    if (readNextChar() == '=')
-                    {
-                        skipNextWhiteSpace();
-                        auto nextChar = *input;
-
-                        if (nextChar == '"' || nextChar == '\'')
-                        {
-                            auto* newAtt = new XmlElement::XmlAttributeNode (attNameStart, attNameEnd);
-                            readQuotedString (newAtt->value);
-                            attributeAppender.append (newAtt);
-                            continue;
-                        }
-                    }
-                    else
-                    {
-                        setLastError ("expected '=' after attribute '"
-                                        + String (attNameStart, attNameEnd) + "'", false);
-                        return node;
-                    }
-                }
-            }
-            else
-            {
-                if (! outOfData)
-                    setLastError ("illegal character found in " + node->getTagName() + ": '" + c + "'", false);
-            }
+       #if JUCE_STRING_UTF_TYPE == 8
+        auto* newAtt = new XmlElement::XmlAttributeNode (String::CharPointerType (name.start), String::CharPointerType (name.end));
+        newAtt->value = reader.getAttributeValue (i);
+       #else
+        auto* newAtt = new XmlElement::XmlAttributeNode (name.toString(), reader.getAttributeValue (i));
+       #endif
 
-            break;
-        }
+        attributeAppender.append (newAtt);
     }
 
     return node;
 }
 
-void XmlDocument::readChildElements (XmlElement& parent)
+bool XmlDocument::readChildElements (XmlReader& reader, XmlElement& parent)
 {
     LinkedListPointer<XmlElement>::Appender childAppender (parent.firstChildElement);
 
     for (;;)
     {
-        auto preWhitespaceInput = input;
-        skipNextWhiteSpace();
-
-        if (outOfData)
+        switch (reader.next())
         {
-            setLastError ("unmatched tags", false);
-            break;
-        }
-
-        if (*input == '<')
-        {
-            auto c1 = input[1];
-
-            if (c1 == '/')
-            {
-                // our close tag..
-                auto closeTag = input.indexOf ((juce_wchar) '>');
-
-                if (closeTag >= 0)
-                    input += closeTag + 1;
-
-                break;
-            }
-
-            if (c1 == '!' && CharacterFunctions::compareUpTo (input + 2, CharPointer_ASCII ("[CDATA["), 7) == 0)
-            {
-                input += 9;
-                auto inputStart = input;
-
-                for (;;)
+            case XmlReader::startElement:
+                if (auto* n = readNextElement (reader, true))
                 {
-                    auto c0 = *input;
-
-                    if (c0 == 0)
-                    {
-                        setLastError ("unterminated CDATA section", false);
-                        outOfData = true;
-                        break;
-                    }
-
-                    if (c0 == ']' && input[1] == ']' && input[2] == '>')
-                    {
-                        childAppender.append (XmlElement::createTextElement (String (inputStart, input)));
-                        input += 3;
-                        break;
-                    }
-
-                    ++input;
-                }
-            }
-            else
-            {
-                // this is some other element, so parse and add it..
-                if (auto* n = readNextElement (true))
                     childAppender.append (n);
-                else
-                    break;
-            }
-        }
-        else  // must be a character block
-        {
-            input = preWhitespaceInput; // roll back to include the leading whitespace
-            MemoryOutputStream textElementContent;
-            bool contentShouldBeUsed = ! ignoreEmptyTextElements;
-
-            for (;;)
-            {
-                auto c = *input;
-
-                if (c == '<')
-                {
-                    if (input[1] == '!' && input[2] == '-' && input[3] == '-')
-                    {
-                        input += 4;
-                        auto closeComment = input.indexOf (CharPointer_ASCII ("-->"));
-
-                        if (closeComment < 0)
-                        {
-                            setLastError ("unterminated comment", false);
-                            outOfData = true;
-                            return;
-                        }
-
-                        input += closeComment + 3;
-                        continue;
-                    }
-
                     break;
                 }
 
-                if (c == 0)
+                return false;
+
+            case XmlReader::text:
+                if (reader.isCDATA())
                 {
-                    setLastError ("unmatched tags", false);
-                    outOfData = true;
-                    return;
+                    childAppender.append (XmlElement::createTextElement (reader.getText()));
                 }
-
-                if (c == '&')
+                else if (! (ignoreEmptyTextElements && reader.getRawText().containsOnlyWhitespace()))
                 {
-                    String entity;
-                    readEntity (entity);
+                    // any entities that expand to elements get added before the text
+                    auto numElementsBefore = elementsFromEntities.size();
+                    String text;
 
-                    if (entity.startsWithChar ('<') && entity [1] != 0)
                     {
-                        auto oldInput = input;
-                        auto oldOutOfData = outOfData;
-
-                        input = entity.getCharPointer();
-                        outOfData = false;
-
-                        while (auto* n = readNextElement (true))
-                            childAppender.append (n);
-
-                        input = oldInput;
-                        outOfData = oldOutOfData;
+                        const ScopedValueSetter<bool> readingText (isReadingText, true);
+                        text = reader.getText();
                     }
-                    else
-                    {
-                        textElementContent << entity;
-                        contentShouldBeUsed = contentShouldBeUsed || entity.containsNonWhitespaceChars();
-                    }
-                }
-                else
-                {
-                    for (;; ++input)
-                    {
-                        auto nextChar = *input;
-
-                        if (nextChar == '\r')
-                        {
-                            nextChar = '\n';
 
-                            if (input[1] == '\n')
-                                continue;
-                        }
+                    while (elementsFromEntities.size() > numElementsBefore)
+                        childAppender.append (elementsFromEntities.removeAndReturn (numElementsBefore));
 
-                        if (nextChar == '<' || nextChar == '&')
-                            break;
+                    if (! ignoreEmptyTextElements || text.containsNonWhitespaceChars())
+                        childAppender.append (XmlElement::createTextElement (text));
+                }
 
-                        if (nextChar == 0)
-                        {
-                            setLastError ("unmatched tags", false);
-                            outOfData = true;
-                            return;
-                        }
+                break;
 
-                        textElementContent.appendUTF8Char (nextChar);
-                        contentShouldBeUsed = contentShouldBeUsed || ! CharacterFunctions::isWhitespace (nextChar);
-                    }
-                }
-            }
+            case XmlReader::endElement:
+                return true;
 
-            if (contentShouldBeUsed)
-                childAppender.append (XmlElement::createTextElement (textElementContent.toUTF8()));
+            case XmlReader::endOfDocument:
+            case XmlReader::parseError:
+            default:
+                return false;
         }
     }
 }
 
-void XmlDocument::readEntity (String& result)
+String XmlDocument::resolveEntity (const String& entity)
 {
-    // skip over the ampersand
-    ++input;
+    auto expanded = expandExternalEntity (entity);
 
-    if (input.compareIgnoreCaseUpTo (CharPointer_ASCII ("amp;"), 4) == 0)
-    {
-        input += 4;
-        result += '&';
-    }
-    else if (input.compareIgnoreCaseUpTo (CharPointer_ASCII ("quot;"), 5) == 0)
-    {
-        input += 5;
-        result += '"';
-    }
-    else if (input.compareIgnoreCaseUpTo (CharPointer_ASCII ("apos;"), 5) == 0)
-    {
-        input += 5;
-        result += '\'';
-    }
-    else if (input.compareIgnoreCaseUpTo (CharPointer_ASCII ("lt;"), 3) == 0)
-    {
-        input += 3;
-        result += '<';
-    }
-    else if (input.compareIgnoreCaseUpTo (CharPointer_ASCII ("gt;"), 3) == 0)
-    {
-        input += 3;
-        result += '>';
-    }
-    else if (*input == '#')
+    if (isReadingText && expanded.startsWithChar ('<') && expanded[1] != 0)
     {
-        int charCode = 0;
-        ++input;
+        XmlReader reader (expanded);
+        reader.setEntityResolver (this);
 
-        if (*input == 'x' || *input == 'X')
+        while (reader.next() == XmlReader::startElement)
         {
-            ++input;
-            int numChars = 0;
-
-            while (input[0] != ';')
-            {
-                auto hexValue = CharacterFunctions::getHexDigitValue (input[0]);
-
-                if (hexValue < 0 || ++numChars > 8)
-                {
-                    setLastError ("illegal escape sequence", true);
-                    break;
-                }
-
-                charCode = (charCode << 4) | hexValue;
-                ++input;
-            }
-
-            ++input;
+            if (auto* n = readNextElement (reader, true))
+                elementsFromEntities.add (n);
+            else
+                break;
         }
-        else if (input[0] >= '0' && input[0] <= '9')
-        {
-            int numChars = 0;
 
-            while (input[0] != ';')
-            {
-                if (++numChars > 12)
-                {
-                    setLastError ("illegal escape sequence", true);
-                    break;
-                }
-
-                charCode = charCode * 10 + ((int) input[0] - '0');
-                ++input;
-            }
-
-            ++input;
-        }
-        else
-        {
-            setLastError ("illegal escape sequence", true);
-            result += '&';
-            return;
-        }
+        if (reader.getTokenType() == XmlReader::parseError)
+            setLastError (reader.getLastError(), false);
 
-        result << (juce_wchar) charCode;
+        return {};
     }
-    else
-    {
-        auto entityNameStart = input;
-        auto closingSemiColon = input.indexOf ((juce_wchar) ';');
 
-        if (closingSemiColon < 0)
-        {
-            outOfData = true;
-            result += '&';
-        }
-        else
-        {
-            input += closingSemiColon + 1;
-            result += expandExternalEntity (String (entityNameStart, (size_t) closingSemiColon));
-        }
-    }
+    return expanded;
 }
 
 String XmlDocument::expandEntity (const String& ent)
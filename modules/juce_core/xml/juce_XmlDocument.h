@@ -28,7 +28,9 @@ namespace juce
     Parses a text-based XML document and creates an XmlElement object from it.
 
     The parser will parse DTDs to load external entities but won't
-    check the document for validity against the DTD.
+    check the document for validity against the DTD. If you just need to pull a few
+    values out of a large document, an XmlReader can do that without building the
+    whole tree.
 
     e.g.
     @code
@@ -58,9 +60,9 @@ namespace juce
     }
     @endcode
 
-    @see XmlElement
+    @see XmlElement, XmlReader
 */
-class JUCE_API  XmlDocument
+class JUCE_API  XmlDocument  : private XmlReader::EntityResolver
 {
 public:
     //==============================================================================
@@ -144,23 +146,19 @@ public:
     //==============================================================================
 private:
     String originalText;
-    String::CharPointerType input { nullptr };
-    bool outOfData = false, errorOccurred = false;
+    bool errorOccurred = false, isReadingText = false;
     String lastError, dtdText;
     StringArray tokenisedDTD;
     bool needToLoadDTD = false, ignoreEmptyTextElements = true;
     ScopedPointer<InputSource> inputSource;
+    OwnedArray<XmlElement> elementsFromEntities;
 
-    XmlElement* parseDocumentElement (String::CharPointerType, bool outer);
+    XmlElement* parseDocumentElement (XmlReader&, bool outer);
     void setLastError (const String&, bool carryOn);
-    bool parseHeader();
-    bool parseDTD();
-    void skipNextWhiteSpace();
-    juce_wchar readNextChar() noexcept;
-    XmlElement* readNextElement (bool alsoParseSubElements);
-    void readChildElements (XmlElement&);
-    void readQuotedString (String&);
-    void readEntity (String&);
+    XmlElement* readNextElement (XmlReader&, bool alsoParseSubElements);
+    XmlElement* createElement (XmlReader&);
+    bool readChildElements (XmlReader&, XmlElement&);
+    String resolveEntity (const String&) override;
 
     String getFileContents (const String&) const;
     String expandEntity (const String&);
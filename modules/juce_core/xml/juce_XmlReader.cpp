@@ -0,0 +1,844 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlIdentifierChars
+{
+    static bool isIdentifierCharSlow (const juce_wchar c) noexcept
+    {
+        return CharacterFunctions::isLetterOrDigit (c)
+                 || c == '_' || c == '-' || c == ':' || c == '.';
+    }
+
+    static bool isIdentifierChar (const juce_wchar c) noexcept
+    {
+        static const uint32 legalChars[] = { 0, 0x7ff6000, 0x87fffffe, 0x7fffffe, 0 };
+
+        return ((int) c < (int) numElementsInArray (legalChars) * 32) ? ((legalChars [c >> 5] & (1 << (c & 31))) != 0)
+                                                                      : isIdentifierCharSlow (c);
+    }
+
+    /*static void generateIdentifierCharConstants()
+    {
+        uint32 n[8] = { 0 };
+        for (int i = 0; i < 256; ++i)
+            if (isIdentifierCharSlow (i))
+                n[i >> 5] |= (1 << (i & 31));
+
+        String s;
+        for (int i = 0; i < 8; ++i)
+            s << "0x" << String::toHexString ((int) n[i]) << ", ";
+
+        DBG (s);
+    }*/
+}
+
+namespace XmlReaderHelpers
+{
+    static bool isWhitespace (const juce_wchar c) noexcept
+    {
+        return c < 0x80 ? (c == ' ' || (c <= 13 && c >= 9))
+                        : CharacterFunctions::isWhitespace (c);
+    }
+
+    static bool matches (const char* p, const char* end, const char* token, size_t tokenLength) noexcept
+    {
+        return (size_t) (end - p) >= tokenLength && memcmp (p, token, tokenLength) == 0;
+    }
+
+    template <size_t length>
+    static bool matches (const char* p, const char* end, const char (&token)[length]) noexcept
+    {
+        return matches (p, end, token, length - 1);
+    }
+
+    template <size_t length>
+    static bool matchesIgnoreCase (const char* p, const char* end, const char (&token)[length]) noexcept
+    {
+        if ((size_t) (end - p) < length - 1)
+            return false;
+
+        for (size_t i = 0; i < length - 1; ++i)
+            if (CharacterFunctions::toLowerCase ((juce_wchar) (uint8) p[i]) != (juce_wchar) token[i])
+                return false;
+
+        return true;
+    }
+
+    template <size_t length>
+    static const char* find (const char* p, const char* end, const char (&token)[length]) noexcept
+    {
+        while (auto* found = static_cast<const char*> (memchr (p, token[0], (size_t) (end - p))))
+        {
+            if (matches (found, end, token))
+                return found;
+
+            p = found + 1;
+        }
+
+        return nullptr;
+    }
+
+    static const char* find (const char* p, const char* end, char c) noexcept
+    {
+        return p < end ? static_cast<const char*> (memchr (p, c, (size_t) (end - p))) : nullptr;
+    }
+
+    // Returns the end of a comment or processing instruction that starts at p, or nullptr
+    // if p doesn't point to one, or it's unterminated.
+    static const char* findEndOfCommentOrPI (const char* p, const char* end) noexcept
+    {
+        if (matches (p, end, "<!--"))
+            if (auto* close = find (p + 4, end, "-->"))
+                return close + 3;
+
+        if (matches (p, end, "<?"))
+            if (auto* close = find (p + 2, end, "?>"))
+                return close + 2;
+
+        return nullptr;
+    }
+}
+
+//==============================================================================
+XmlReader::XmlReader (const void* utf8Data, size_t numBytes)
+{
+    setData (utf8Data, numBytes);
+}
+
+XmlReader::XmlReader (const String& documentText)  : ownedText (documentText)
+{
+    setData (ownedText.toRawUTF8(), ownedText.getNumBytesAsUTF8());
+}
+
+XmlReader::XmlReader (const File& file)  : mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
+{
+    if (mappedFile->getData() != nullptr)
+    {
+        setData (mappedFile->getData(), mappedFile->getSize());
+    }
+    else
+    {
+        mappedFile = nullptr;
+        file.loadFileAsData (ownedData);
+        setData (ownedData.getData(), ownedData.getSize());
+    }
+}
+
+XmlReader::XmlReader (InputStream& input)
+{
+    input.readIntoMemoryBlock (ownedData);
+    setData (ownedData.getData(), ownedData.getSize());
+}
+
+XmlReader::~XmlReader() {}
+
+void XmlReader::setData (const void* data, size_t numBytes)
+{
+    auto* utf8 = static_cast<const char*> (data);
+
+    if (numBytes >= 2 && (CharPointer_UTF16::isByteOrderMarkBigEndian (utf8)
+                           || CharPointer_UTF16::isByteOrderMarkLittleEndian (utf8)))
+    {
+        ownedText = String::createStringFromData (utf8, (int) numBytes);
+        utf8 = ownedText.toRawUTF8();
+        numBytes = ownedText.getNumBytesAsUTF8();
+    }
+    else if (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (utf8))
+    {
+        utf8 += 3;
+        numBytes -= 3;
+    }
+
+    position = utf8;
+    dataEnd = utf8 + numBytes;
+
+    // stop at a null terminator, in case the data is followed by some junk
+    if (auto* terminator = XmlReaderHelpers::find (utf8, dataEnd, 0))
+        dataEnd = terminator;
+}
+
+//==============================================================================
+XmlReader::TokenType XmlReader::next()
+{
+    if (! started)
+    {
+        started = true;
+
+        if (! readProlog())
+            return parseError;
+    }
+    else if (tokenType == parseError || tokenType == endOfDocument)
+    {
+        return tokenType;
+    }
+
+    attributes.clearQuick();
+    elementName = textRange = {};
+    emptyElement = cdata = false;
+
+    if (depth > 0)
+        return readContent();
+
+    if (! skipWhitespace() || *position != '<')
+        return tokenType = endOfDocument;
+
+    return readTag();
+}
+
+XmlReader::TokenType XmlReader::fail (const String& error)
+{
+    lastError = error;
+    return tokenType = parseError;
+}
+
+bool XmlReader::readProlog()
+{
+    using namespace XmlReaderHelpers;
+
+    if (position == dataEnd)
+    {
+        fail ("not enough input");
+        return false;
+    }
+
+    skipWhitespace();
+
+    // (a complete header would have been skipped along with the whitespace)
+    if (matches (position, dataEnd, "<?xml"))
+    {
+        fail ("malformed header");
+        return false;
+    }
+
+    if (matches (position, dataEnd, "<!DOCTYPE"))
+    {
+        auto* dtdStart = position + 9;
+        auto* p = dtdStart;
+
+        for (int n = 1; n > 0;)
+        {
+            if (p == dataEnd)
+            {
+                fail ("malformed DTD");
+                return false;
+            }
+
+            auto c = *p++;
+
+            if (c == '<')
+                ++n;
+            else if (c == '>')
+                --n;
+        }
+
+        dtd = { dtdStart, p - 1 };
+        position = p;
+    }
+
+    return true;
+}
+
+XmlReader::TokenType XmlReader::readTag()
+{
+    ++position; // skip the '<'
+    auto* nameEnd = findEndOfToken (position);
+
+    if (nameEnd == position)
+    {
+        // no tag name - but allow for a gap after the '<' before giving an error
+        skipWhitespace();
+        nameEnd = findEndOfToken (position);
+
+        if (nameEnd == position)
+            return fail ("tag name missing");
+    }
+
+    elementName = { position, nameEnd };
+    position = nameEnd;
+    tokenDepth = depth;
+
+    for (;;)
+    {
+        if (! skipWhitespace())
+        {
+            // ran out of data inside the tag, so treat it as an empty one
+            emptyElement = true;
+            break;
+        }
+
+        auto c = *position;
+
+        if (c == '/' && XmlReaderHelpers::matches (position, dataEnd, "/>"))
+        {
+            position += 2;
+            emptyElement = true;
+            break;
+        }
+
+        if (c == '>')
+        {
+            ++position;
+            ++depth;
+            break;
+        }
+
+        auto* charEnd = position;
+        auto wc = readChar (charEnd);
+
+        if (! XmlIdentifierChars::isIdentifierChar (wc))
+            return fail ("illegal character found in " + elementName.toString() + ": '" + String::charToString (wc) + "'");
+
+        Attribute att;
+        att.name = { position, findEndOfToken (position) };
+        position = att.name.end;
+        skipWhitespace();
+
+        if (position == dataEnd || *position != '=')
+            return fail ("expected '=' after attribute '" + att.name.toString() + "'");
+
+        ++position;
+        skipWhitespace();
+
+        if (position == dataEnd || (*position != '"' && *position != '\''))
+        {
+            // an unquoted value ends the tag
+            emptyElement = true;
+            break;
+        }
+
+        auto quote = *position++;
+        auto* closeQuote = XmlReaderHelpers::find (position, dataEnd, quote);
+
+        if (closeQuote == nullptr)
+            return fail ("unmatched quotes");
+
+        att.value = { position, closeQuote };
+        attributes.add (att);
+        position = closeQuote + 1;
+    }
+
+    return tokenType = startElement;
+}
+
+XmlReader::TokenType XmlReader::readContent()
+{
+    using namespace XmlReaderHelpers;
+
+    auto* preWhitespace = position;
+
+    if (! skipWhitespace())
+        return fail ("unmatched tags");
+
+    tokenDepth = depth;
+
+    if (*position == '<')
+    {
+        if (matches (position, dataEnd, "</"))
+        {
+            elementName = { position + 2, findEndOfToken (position + 2) };
+
+            // (if the tag isn't closed, this will also close all the enclosing elements)
+            if (auto* closeTag = find (position, dataEnd, '>'))
+                position = closeTag + 1;
+
+            tokenDepth = --depth;
+            return tokenType = endElement;
+        }
+
+        if (matches (position, dataEnd, "<![CDATA["))
+        {
+            auto* contentStart = position + 9;
+            auto* contentEnd = find (contentStart, dataEnd, "]]>");
+
+            if (contentEnd == nullptr)
+                return fail ("unterminated CDATA section");
+
+            textRange = { contentStart, contentEnd };
+            cdata = true;
+            position = contentEnd + 3;
+            return tokenType = text;
+        }
+
+        return readTag();
+    }
+
+    // must be a character block, so roll back to include the leading whitespace
+    position = preWhitespace;
+
+    for (;;)
+    {
+        auto* openBracket = find (position, dataEnd, '<');
+
+        if (openBracket == nullptr)
+            return fail ("unmatched tags");
+
+        position = openBracket;
+
+        if (matches (position, dataEnd, "<!--") || matches (position, dataEnd, "<?"))
+        {
+            auto* commentEnd = findEndOfCommentOrPI (position, dataEnd);
+
+            if (commentEnd == nullptr)
+                return fail (position[1] == '!' ? "unterminated comment" : "unterminated processing instruction");
+
+            position = commentEnd;
+            continue;
+        }
+
+        break;
+    }
+
+    textRange = { preWhitespace, position };
+    return tokenType = text;
+}
+
+bool XmlReader::skipWhitespace() noexcept
+{
+    for (;;)
+    {
+        while (position < dataEnd)
+        {
+            auto* p = position;
+
+            if (! XmlReaderHelpers::isWhitespace (readChar (p)))
+                break;
+
+            position = p;
+        }
+
+        if (position == dataEnd)
+            return false;
+
+        if (! (XmlReaderHelpers::matches (position, dataEnd, "<!--")
+                || XmlReaderHelpers::matches (position, dataEnd, "<?")))
+            return true;
+
+        // an unterminated comment counts as the end of the data
+        if (auto* commentEnd = XmlReaderHelpers::findEndOfCommentOrPI (position, dataEnd))
+            position = commentEnd;
+        else
+            return false;
+    }
+}
+
+juce_wchar XmlReader::readChar (const char*& p) const noexcept
+{
+    auto byte = (uint8) *p;
+
+    if (byte < 0x80)
+    {
+        ++p;
+        return (juce_wchar) byte;
+    }
+
+    // copy the bytes so that a truncated sequence can't read past the end of the data
+    char buffer[8] = {};
+    memcpy (buffer, p, jmin ((size_t) 4, (size_t) (dataEnd - p)));
+
+    CharPointer_UTF8 c (buffer);
+    auto result = c.getAndAdvance();
+    p += c.getAddress() - buffer;
+    return result;
+}
+
+const char* XmlReader::findEndOfToken (const char* p) const noexcept
+{
+    while (p < dataEnd)
+    {
+        auto* next = p;
+
+        if (! XmlIdentifierChars::isIdentifierChar (readChar (next)))
+            break;
+
+        p = next;
+    }
+
+    return p;
+}
+
+//==============================================================================
+XmlReader::TextRange XmlReader::getAttributeName (int index) const noexcept
+{
+    return attributes[index].name;
+}
+
+XmlReader::TextRange XmlReader::getRawAttributeValue (int index) const noexcept
+{
+    return attributes[index].value;
+}
+
+String XmlReader::getAttributeValue (int index)
+{
+    return decode (attributes[index].value, false);
+}
+
+String XmlReader::getAttributeValue (StringRef attributeName, const String& defaultValue)
+{
+    for (auto& att : attributes)
+        if (att.name == attributeName)
+            return decode (att.value, false);
+
+    return defaultValue;
+}
+
+String XmlReader::getText()
+{
+    return cdata ? textRange.toString() : decode (textRange, true);
+}
+
+bool XmlReader::skipElement()
+{
+    if (tokenType != startElement)
+        return false;
+
+    if (emptyElement)
+        return true;
+
+    auto elementDepth = tokenDepth;
+
+    for (;;)
+    {
+        auto type = next();
+
+        if (type == endElement && tokenDepth == elementDepth)
+            return true;
+
+        if (type == parseError || type == endOfDocument)
+            return false;
+    }
+}
+
+String XmlReader::decode (TextRange range, bool isText)
+{
+    auto isSpecial = [isText] (char c)  { return c == '&' || (isText && (c == '<' || c == '\r')); };
+
+    auto* p = range.start;
+
+    while (p < range.end && ! isSpecial (*p))
+        ++p;
+
+    if (p == range.end)
+        return range.toString();
+
+    char stackSpace[512];
+    MemoryArena arena (stackSpace, sizeof (stackSpace));
+    MemoryOutputStream result (arena, 256);
+    result.write (range.start, (size_t) (p - range.start));
+
+    while (p < range.end)
+    {
+        auto c = *p;
+
+        if (c == '&')
+        {
+            readEntity (result, p, range.end);
+        }
+        else if (c == '\r')
+        {
+            result << '\n';
+
+            if (++p < range.end && *p == '\n')
+                ++p;
+        }
+        else if (c == '<')
+        {
+            // the tokeniser only lets complete comments and processing instructions into a text block
+            if (auto* commentEnd = XmlReaderHelpers::findEndOfCommentOrPI (p, range.end))
+                p = commentEnd;
+            else
+                result << *p++;
+        }
+        else
+        {
+            auto* runStart = p;
+
+            while (p < range.end && ! isSpecial (*p))
+                ++p;
+
+            result.write (runStart, (size_t) (p - runStart));
+        }
+    }
+
+    return result.toUTF8();
+}
+
+void XmlReader::readEntity (MemoryOutputStream& result, const char*& p, const char* end)
+{
+    using namespace XmlReaderHelpers;
+
+    ++p; // skip over the ampersand
+
+    if (matchesIgnoreCase (p, end, "amp;"))   { p += 4; result << '&';  return; }
+    if (matchesIgnoreCase (p, end, "quot;"))  { p += 5; result << '"';  return; }
+    if (matchesIgnoreCase (p, end, "apos;"))  { p += 5; result << '\''; return; }
+    if (matchesIgnoreCase (p, end, "lt;"))    { p += 3; result << '<';  return; }
+    if (matchesIgnoreCase (p, end, "gt;"))    { p += 3; result << '>';  return; }
+
+    if (p < end && *p == '#')
+    {
+        uint32 charCode = 0;
+        ++p;
+
+        if (p < end && (*p == 'x' || *p == 'X'))
+        {
+            ++p;
+            int numChars = 0;
+
+            for (; p < end && *p != ';'; ++p)
+            {
+                auto hexValue = CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) *p);
+
+                if (hexValue < 0 || ++numChars > 8)
+                {
+                    lastError = "illegal escape sequence";
+                    break;
+                }
+
+                charCode = (charCode << 4) | (uint32) hexValue;
+            }
+        }
+        else if (p < end && *p >= '0' && *p <= '9')
+        {
+            int numChars = 0;
+
+            for (; p < end && *p != ';'; ++p)
+            {
+                if (*p < '0' || *p > '9' || ++numChars > 12)
+                {
+                    lastError = "illegal escape sequence";
+                    break;
+                }
+
+                charCode = charCode * 10 + (uint32) (*p - '0');
+            }
+        }
+        else
+        {
+            lastError = "illegal escape sequence";
+            result << '&';
+            return;
+        }
+
+        if (p < end)
+            ++p; // skip the semicolon, or the character that wasn't allowed
+
+        if (charCode != 0)
+            result.appendUTF8Char ((juce_wchar) charCode);
+
+        return;
+    }
+
+    auto* semiColon = find (p, end, ';');
+
+    if (semiColon == nullptr)
+    {
+        result << '&';
+        return;
+    }
+
+    auto entityName = String::fromUTF8 (p, (int) (semiColon - p));
+    p = semiColon + 1;
+
+    if (entityResolver != nullptr)
+    {
+        result << entityResolver->resolveEntity (entityName);
+    }
+    else
+    {
+        lastError = "unknown entity";
+        result << entityName;
+    }
+}
+
+//==============================================================================
+bool XmlReader::TextRange::containsOnlyWhitespace() const noexcept
+{
+    for (auto* p = start; p < end; ++p)
+        if (! CharacterFunctions::isWhitespace (*p))
+            return false;
+
+    return true;
+}
+
+String XmlReader::TextRange::toString() const
+{
+    return start == end ? String() : String::fromUTF8 (start, (int) (end - start));
+}
+
+bool XmlReader::TextRange::operator== (StringRef other) const noexcept
+{
+   #if JUCE_STRING_UTF_TYPE == 8
+    auto* s = other.text.getAddress();
+
+    // (the range never contains a null, so this stops at the end of the other string)
+    for (auto* p = start; p < end; ++p, ++s)
+        if (*p != *s)
+            return false;
+
+    return *s == 0;
+   #else
+    CharPointer_UTF8 p (start);
+    auto s = other.text;
+
+    while (p.getAddress() < end)
+        if (p.getAndAdvance() != s.getAndAdvance())
+            return false;
+
+    return s.isEmpty();
+   #endif
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlReaderTests  : public UnitTest
+{
+public:
+    XmlReaderTests() : UnitTest ("XmlReader", "XML") {}
+
+    void runTest() override
+    {
+        beginTest ("Tokens");
+        {
+            XmlReader reader ("<?xml version=\"1.0\"?>\n<!-- comment -->\n"
+                              "<a x=\"1\" y='two'><b/>hello <!-- c --> there<c>t&amp;x</c></a>");
+
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.getElementName() == "a");
+            expect (! reader.isEmptyElement());
+            expectEquals (reader.getDepth(), 0);
+            expectEquals (reader.getNumAttributes(), 2);
+            expect (reader.getAttributeName (1) == "y");
+            expectEquals (reader.getAttributeValue ("y"), String ("two"));
+            expectEquals (reader.getAttributeValue ("z", "none"), String ("none"));
+
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.getElementName() == "b");
+            expect (reader.isEmptyElement());
+            expectEquals (reader.getDepth(), 1);
+
+            expect (reader.next() == XmlReader::text);
+            expectEquals (reader.getText(), String ("hello  there"));
+
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.next() == XmlReader::text);
+            expect (reader.getRawText() == "t&amp;x");
+            expectEquals (reader.getText(), String ("t&x"));
+            expect (reader.next() == XmlReader::endElement);
+            expect (reader.getElementName() == "c");
+
+            expect (reader.next() == XmlReader::endElement);
+            expectEquals (reader.getDepth(), 0);
+            expect (reader.next() == XmlReader::endOfDocument);
+            expect (reader.next() == XmlReader::endOfDocument);
+            expect (reader.getLastError().isEmpty());
+        }
+
+        beginTest ("Text decoding");
+        {
+            XmlReader reader ("<a b=\"&lt;&#x41;&#66;&QUOT;\">l1\r\nl2\rl3&#9786;<![CDATA[ <raw> &amp; ]]></a>");
+
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.getRawAttributeValue (0) == "&lt;&#x41;&#66;&QUOT;");
+            expectEquals (reader.getAttributeValue (0), String ("<AB\""));
+
+            expect (reader.next() == XmlReader::text);
+            expect (! reader.isCDATA());
+            expectEquals (reader.getText(), String ("l1\nl2\nl3") + String::charToString ((juce_wchar) 9786));
+
+            expect (reader.next() == XmlReader::text);
+            expect (reader.isCDATA());
+            expectEquals (reader.getText(), String (" <raw> &amp; "));
+        }
+
+        beginTest ("Entities");
+        {
+            struct Resolver  : public XmlReader::EntityResolver
+            {
+                String resolveEntity (const String& name) override   { return name.toUpperCase(); }
+            };
+
+            XmlReader reader ("<a>&foo;&#x5A;</a>");
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.next() == XmlReader::text);
+            expectEquals (reader.getText(), String ("fooZ"));
+            expect (reader.getLastError().isNotEmpty());
+
+            Resolver resolver;
+            reader.setEntityResolver (&resolver);
+            expectEquals (reader.getText(), String ("FOOZ"));
+            expect (reader.next() == XmlReader::endElement);
+        }
+
+        beginTest ("Skipping elements");
+        {
+            XmlReader reader ("<!DOCTYPE a [ <!ENTITY e \"x\"> ]><a><b><c/><d>x</d></b><e/></a>");
+
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.getDTD().toString().trim() == "a [ <!ENTITY e \"x\"> ]");
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.skipElement());
+            expect (reader.getTokenType() == XmlReader::endElement);
+            expect (reader.next() == XmlReader::startElement);
+            expect (reader.getElementName() == "e");
+        }
+
+        beginTest ("Errors");
+        {
+            expectError ("", "not enough input");
+            expectError ("<a><b></b>", "unmatched tags");
+            expectError ("< >", "tag name missing");
+            expectError ("<a b>", "expected '=' after attribute 'b'");
+            expectError ("<a b=\"1>", "unmatched quotes");
+            expectError ("<a $>", "illegal character found in a: '$'");
+            expectError ("<a><![CDATA[x</a>", "unterminated CDATA section");
+            expectError ("<!DOCTYPE a <", "malformed DTD");
+        }
+    }
+
+    void expectError (const char* xml, const String& error)
+    {
+        XmlReader reader (xml, strlen (xml));
+
+        while (reader.next() != XmlReader::parseError)
+        {
+            if (reader.getTokenType() == XmlReader::endOfDocument)
+            {
+                expect (false, "no error for " + String (xml));
+                return;
+            }
+        }
+
+        expectEquals (reader.getLastError(), error);
+        expect (reader.next() == XmlReader::parseError);
+    }
+};
+
+static XmlReaderTests xmlReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast, forward-only XML parser that walks through a document one token at a time.
+
+    Unlike XmlDocument, this doesn't build a tree of XmlElement objects - each call to
+    next() moves on to the next start tag, end tag or block of text, and you can then
+    look at the current token's name, attributes or text. The names and raw values are
+    returned as TextRange objects which point directly into the source data, so you
+    can walk a large document without allocating anything, and only pay for creating
+    Strings for the bits you're actually interested in.
+
+    e.g.
+    @code
+    XmlReader reader (File ("myfile.xml"));
+
+    while (reader.next() == XmlReader::startElement)
+    {
+        if (reader.getElementName() == "PLUGIN")
+            DBG (reader.getAttributeValue ("name"));
+    }
+
+    if (reader.getTokenType() == XmlReader::parseError)
+        DBG (reader.getLastError());
+    @endcode
+
+    The data must be UTF-8 or UTF-16 - a UTF-16 document will be converted to UTF-8
+    when the reader is created. DTDs are skipped rather than parsed, so any entities
+    other than the standard ones get passed to an EntityResolver. If you need those
+    expanded from the DTD, use an XmlDocument instead, which uses this class to do
+    its parsing.
+
+    @see XmlDocument, XmlElement
+*/
+class JUCE_API  XmlReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader for a block of UTF-8 data.
+        The reader doesn't take a copy of the data, so it must stay valid for the
+        reader's lifetime.
+    */
+    XmlReader (const void* utf8Data, size_t numBytes);
+
+    /** Creates a reader for some XML text. */
+    explicit XmlReader (const String& documentText);
+
+    /** Creates a reader for a file.
+        The file will be memory-mapped if possible, so only the parts of it that you
+        read will actually get loaded.
+    */
+    explicit XmlReader (const File& file);
+
+    /** Creates a reader that parses the remaining contents of a stream.
+        This reads all of the stream's data into memory before the parsing begins.
+    */
+    explicit XmlReader (InputStream& input);
+
+    /** Destructor. */
+    ~XmlReader();
+
+    //==============================================================================
+    /** The different types of token that next() can find. */
+    enum TokenType
+    {
+        startElement,   /**< An opening tag - use getElementName() and the attribute methods to find out about it. */
+        endElement,     /**< A closing tag. */
+        text,           /**< A block of text or a CDATA section - use getText() or getRawText() to read it. */
+        endOfDocument,  /**< There are no more elements to read. */
+        parseError      /**< The document is malformed - see getLastError() for the reason. */
+    };
+
+    /** Moves on to the next token in the document, and returns its type.
+        Once the end of the document or an error has been reached, this will keep
+        returning the same value.
+    */
+    TokenType next();
+
+    /** Returns the type of the current token, i.e. the last value that next() returned. */
+    TokenType getTokenType() const noexcept                 { return tokenType; }
+
+    //==============================================================================
+    /** Points to a section of the reader's UTF-8 source data.
+        These are only valid for the lifetime of the XmlReader.
+    */
+    struct JUCE_API  TextRange
+    {
+        const char* start = nullptr;
+        const char* end = nullptr;
+
+        /** Returns the number of bytes in the range. */
+        size_t getNumBytes() const noexcept                 { return (size_t) (end - start); }
+
+        /** Returns true if the range is empty. */
+        bool isEmpty() const noexcept                       { return start == end; }
+
+        /** Returns true if the range contains nothing but whitespace. */
+        bool containsOnlyWhitespace() const noexcept;
+
+        /** Creates a String containing a copy of this range. */
+        String toString() const;
+
+        /** Compares the range's characters with a string. */
+        bool operator== (StringRef) const noexcept;
+
+        /** Compares the range's characters with a string. */
+        bool operator!= (StringRef other) const noexcept    { return ! operator== (other); }
+    };
+
+    //==============================================================================
+    /** Returns the tag name of the current startElement or endElement token. */
+    TextRange getElementName() const noexcept               { return elementName; }
+
+    /** Returns true if the current startElement is a self-closing tag such as <foo/>.
+        No endElement token will be returned for an element like this.
+    */
+    bool isEmptyElement() const noexcept                    { return emptyElement; }
+
+    /** Returns the number of attributes that the current startElement has. */
+    int getNumAttributes() const noexcept                   { return attributes.size(); }
+
+    /** Returns the name of one of the current element's attributes. */
+    TextRange getAttributeName (int index) const noexcept;
+
+    /** Returns the undecoded value of one of the current element's attributes, exactly
+        as it appears between the quotes.
+    */
+    TextRange getRawAttributeValue (int index) const noexcept;
+
+    /** Returns the value of one of the current element's attributes, with any entities replaced. */
+    String getAttributeValue (int index);
+
+    /** Looks for an attribute of the current element, and returns its value with any
+        entities replaced, or the default value if the element doesn't have one.
+    */
+    String getAttributeValue (StringRef attributeName, const String& defaultValue = {});
+
+    //==============================================================================
+    /** Returns the undecoded content of the current text token.
+        This may include comments and processing instructions, and for a CDATA section
+        it's the data inside the CDATA markers.
+    */
+    TextRange getRawText() const noexcept                   { return textRange; }
+
+    /** Returns true if the current text token is a CDATA section. */
+    bool isCDATA() const noexcept                           { return cdata; }
+
+    /** Returns the current text token's content, with line-endings converted to
+        newlines, entities replaced, and comments removed.
+    */
+    String getText();
+
+    //==============================================================================
+    /** Returns the number of elements that enclose the current token.
+        For the document's outer element this is zero, and its text and end tag
+        have depths of one and zero respectively.
+    */
+    int getDepth() const noexcept                           { return tokenDepth; }
+
+    /** If the current token is a startElement, this moves on to its matching endElement,
+        skipping everything in between.
+        @returns false if the end of the document or an error was reached first
+    */
+    bool skipElement();
+
+    /** Returns the content of the document's DOCTYPE declaration, if there was one. */
+    TextRange getDTD() const noexcept                       { return dtd; }
+
+    /** Returns a description of the last error or warning that the reader came across.
+        Errors will also make next() return parseError, but warnings (e.g. a malformed
+        entity) are recoverable, so they only get reported here.
+    */
+    const String& getLastError() const noexcept             { return lastError; }
+
+    //==============================================================================
+    /** Used to supply the values of any entities that the reader doesn't recognise.
+        @see setEntityResolver
+    */
+    struct JUCE_API  EntityResolver
+    {
+        /** Destructor. */
+        virtual ~EntityResolver() {}
+
+        /** Returns the replacement text for an entity, given its name without the '&' and ';'. */
+        virtual String resolveEntity (const String& entityName) = 0;
+    };
+
+    /** Sets an object to look up any non-standard entities that come up while the
+        attributes and text are being decoded.
+        If no resolver is set, an unknown entity is replaced by its name and a warning
+        is reported. The object isn't owned by the reader.
+    */
+    void setEntityResolver (EntityResolver* newResolver) noexcept  { entityResolver = newResolver; }
+
+private:
+    //==============================================================================
+    struct Attribute
+    {
+        TextRange name, value;
+    };
+
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    MemoryBlock ownedData;
+    String ownedText;
+    const char* dataEnd = nullptr;
+    const char* position = nullptr;
+    TokenType tokenType = endOfDocument;
+    TextRange elementName, textRange, dtd;
+    Array<Attribute> attributes;
+    String lastError;
+    EntityResolver* entityResolver = nullptr;
+    int depth = 0, tokenDepth = 0;
+    bool started = false, emptyElement = false, cdata = false;
+
+    void setData (const void*, size_t);
+    bool readProlog();
+    TokenType readTag();
+    TokenType readContent();
+    TokenType fail (const String&);
+    bool skipWhitespace() noexcept;
+    juce_wchar readChar (const char*&) const noexcept;
+    const char* findEndOfToken (const char*) const noexcept;
+    String decode (TextRange, bool isText);
+    void readEntity (MemoryOutputStream&, const char*&, const char*);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlReader)
+};
+
+} // namespace juce
@@ -37,6 +37,15 @@ public:
                                        8, strategy) == Z_OK);
     }
 
+    void setStrategy (int newStrategy)
+    {
+        // The strategy is applied when the first block is compressed, so it can't
+        // be changed after any data has been written!
+        jassert (isFirstDeflate);
+
+        strategy = newStrategy;
+    }
+
     ~GZIPCompressorHelper()
     {
         if (streamIsValid)
@@ -66,10 +75,9 @@ public:
     }
 
 private:
-    enum { strategy = 0 };
-
     zlibNamespace::z_stream stream;
     const int compLevel;
+    int strategy = 0;
     bool isFirstDeflate = true, streamIsValid = false, finished = false;
     zlibNamespace::Bytef buffer[32768];
 
@@ -134,6 +142,11 @@ void GZIPCompressorOutputStream::flush()
     destStream->flush();
 }
 
+void GZIPCompressorOutputStream::setCompressionStrategy (CompressionStrategy newStrategy)
+{
+    helper->setStrategy ((int) newStrategy);
+}
+
 bool GZIPCompressorOutputStream::write (const void* destBuffer, size_t howMany)
 {
     jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
@@ -198,6 +211,90 @@ struct GZIPTests  : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Repetitive data and compression strategies");
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                // build the data out of copies of earlier parts of itself, at all sorts of
+                // distances and lengths, so that the inflater has plenty of matches to copy
+                MemoryOutputStream original;
+
+                for (int j = rng.nextInt (300) + 1; --j >= 0;)
+                {
+                    auto size = (int) original.getDataSize();
+
+                    if (size < 16 || rng.nextInt (4) == 0)
+                    {
+                        for (int k = rng.nextInt (50) + 1; --k >= 0;)
+                            original.writeByte ((char) rng.nextInt (256));
+                    }
+                    else
+                    {
+                        auto distance = jmin (size, rng.nextBool() ? rng.nextInt (16) + 1 : rng.nextInt (40000) + 1);
+
+                        for (int k = rng.nextInt (300) + 3; --k >= 0;)
+                            original.writeByte (static_cast<const char*> (original.getData())[original.getDataSize() - (size_t) distance]);
+                    }
+                }
+
+                auto strategy = (GZIPCompressorOutputStream::CompressionStrategy) rng.nextInt (4);
+                auto windowBits = rng.nextBool() ? (int) GZIPCompressorOutputStream::windowBitsGZIP : 0;
+                MemoryOutputStream compressed;
+
+                {
+                    GZIPCompressorOutputStream zipper (&compressed, rng.nextInt (9) + 1, false, windowBits);
+                    zipper.setCompressionStrategy (strategy);
+                    zipper.write (original.getData(), original.getDataSize());
+                }
+
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                GZIPDecompressorInputStream unzipper (&compressedInput, false,
+                                                      windowBits != 0 ? GZIPDecompressorInputStream::gzipFormat
+                                                                      : GZIPDecompressorInputStream::zlibFormat);
+
+                // read it back in small pieces, so that the output buffer is often nearly full
+                MemoryOutputStream uncompressed;
+                HeapBlock<char> buffer (300);
+
+                for (;;)
+                {
+                    auto num = unzipper.read (buffer, rng.nextInt (300) + 1);
+
+                    if (num <= 0)
+                        break;
+
+                    uncompressed.write (buffer, (size_t) num);
+                }
+
+                expect (uncompressed.getMemoryBlock() == original.getMemoryBlock());
+            }
+        }
+
+        beginTest ("CRC32");
+        {
+            using namespace zlibNamespace;
+
+            expect (crc32 (crc32 (0, Z_NULL, 0), (const Bytef*) "123456789", 9) == 0xcbf43926);
+
+            HeapBlock<uint8> data (5000);
+            rng.fillBitsRandomly (data, 5000);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto start = rng.nextInt (100);
+                auto size = rng.nextInt (4900);
+                auto split = rng.nextInt (size + 1);
+                auto whole = crc32 (0, data + start, (uInt) size);
+
+               #if JUCE_INCLUDE_ZLIB_CODE && JUCE_USE_FAST_ZLIB
+                expect (whole == portableCrc32 (0, data + start, (uInt) size));
+               #endif
+
+                auto pieces = crc32 (crc32 (0, data + start, (uInt) split), data + start + split, (uInt) (size - split));
+                expect (pieces == whole);
+            }
+        }
     }
 };
 
@@ -80,6 +80,28 @@ public:
         windowBitsGZIP = 15 + 16
     };
 
+    /** The strategies that can be passed to setCompressionStrategy().
+        For more info about these, see the zlib documentation for deflateInit2's strategy parameter.
+    */
+    enum CompressionStrategy
+    {
+        defaultStrategy     = 0,  /**< Looks for repeated strings anywhere in the window. */
+        filteredStrategy    = 1,  /**< Better for data that's mostly small values with a random distribution. */
+        huffmanOnlyStrategy = 2,  /**< Doesn't look for repeated strings at all, and only uses Huffman coding.
+                                       This is by far the fastest, but only compresses data whose byte values
+                                       are unevenly distributed. */
+        runLengthStrategy   = 3   /**< Only looks for runs of the same byte. This is almost as fast as
+                                       huffmanOnlyStrategy, and works well on things like images and
+                                       sparse binary data. */
+    };
+
+    /** Changes the strategy that zlib uses to compress the data.
+
+        For the fastest compression, combine a compression level of 1 with huffmanOnlyStrategy
+        or runLengthStrategy. This must be called before any data is written to the stream.
+    */
+    void setCompressionStrategy (CompressionStrategy newStrategy);
+
 private:
     //==============================================================================
     OptionalScopedPointer<OutputStream> destStream;
@@ -45,14 +45,32 @@ namespace zlibNamespace
   #undef fdopen
   #define ZLIB_INTERNAL
   #define NO_DUMMY_DECL
+
+  #if JUCE_USE_FAST_ZLIB
+   #define INFLATE_CHUNK_COPY 1
+  #endif
+
   #include "zlib/zlib.h"
   #include "zlib/adler32.c"
   #include "zlib/compress.c"
   #undef DO1
   #undef DO8
+
+  #if JUCE_USE_FAST_ZLIB
+   #undef crc32
+   #define crc32 portableCrc32
+  #endif
+
   #include "zlib/crc32.c"
+
+  #if JUCE_USE_FAST_ZLIB
+   #undef crc32
+   #define crc32 z_crc32
+  #endif
+
   #include "zlib/deflate.c"
   #include "zlib/inffast.c"
+  #undef COPY_FROM_WINDOW
   #undef PULLBYTE
   #undef LOAD
   #undef RESTORE
@@ -72,6 +90,130 @@ namespace zlibNamespace
   #undef Dad
   #undef Len
 
+  #if JUCE_USE_FAST_ZLIB
+// zlib's own crc32() was renamed to portableCrc32() above, so that the rest of zlib (and
+// anything else that calls zlibNamespace::crc32) will use this version instead.
+   #if JUCE_USE_CLMUL_INTRINSICS
+    #if JUCE_MSVC
+     #define JUCE_CLMUL_TARGET
+    #else
+     #define JUCE_CLMUL_TARGET  __attribute__ ((target ("pclmul,sse4.1")))
+    #endif
+
+JUCE_CLMUL_TARGET
+static inline __m128i loadCRCBlock (const uint8* data) noexcept
+{
+    return _mm_loadu_si128 ((const __m128i*) data);
+}
+
+JUCE_CLMUL_TARGET
+static inline __m128i foldCRCBlock (__m128i x, __m128i k, __m128i next) noexcept
+{
+    return _mm_xor_si128 (_mm_xor_si128 (_mm_clmulepi64_si128 (x, k, 0x11), next),
+                          _mm_clmulepi64_si128 (x, k, 0x00));
+}
+
+// Folds the data into the CRC 64 bytes at a time using carry-less multiplies, then
+// reduces it with a Barrett reduction (see Intel's "Fast CRC Computation for Generic
+// Polynomials Using PCLMULQDQ Instruction"). numBytes must be a multiple of 16, and
+// at least 64. This takes and returns the CRC in its inverted form.
+JUCE_CLMUL_TARGET
+static uint32 crc32WithCLMUL (uint32 crc, const uint8* data, size_t numBytes) noexcept
+{
+    alignas (16) static const uint64 k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas (16) static const uint64 k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+    alignas (16) static const uint64 k5k0[] = { 0x0163cd6124, 0x0000000000 };
+    alignas (16) static const uint64 poly[] = { 0x01db710641, 0x01f7011641 };
+
+    auto x1 = _mm_xor_si128 (loadCRCBlock (data), _mm_cvtsi32_si128 ((int) crc));
+    auto x2 = loadCRCBlock (data + 16);
+    auto x3 = loadCRCBlock (data + 32);
+    auto x4 = loadCRCBlock (data + 48);
+    auto k = _mm_load_si128 ((const __m128i*) k1k2);
+
+    data += 64;
+    numBytes -= 64;
+
+    for (; numBytes >= 64; data += 64, numBytes -= 64)
+    {
+        x1 = foldCRCBlock (x1, k, loadCRCBlock (data));
+        x2 = foldCRCBlock (x2, k, loadCRCBlock (data + 16));
+        x3 = foldCRCBlock (x3, k, loadCRCBlock (data + 32));
+        x4 = foldCRCBlock (x4, k, loadCRCBlock (data + 48));
+    }
+
+    k = _mm_load_si128 ((const __m128i*) k3k4);
+    x1 = foldCRCBlock (x1, k, x2);
+    x1 = foldCRCBlock (x1, k, x3);
+    x1 = foldCRCBlock (x1, k, x4);
+
+    for (; numBytes >= 16; data += 16, numBytes -= 16)
+        x1 = foldCRCBlock (x1, k, loadCRCBlock (data));
+
+    // fold 128 bits down to 64
+    auto mask32 = _mm_setr_epi32 (~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128 (x1, k, 0x10);
+    x1 = _mm_xor_si128 (_mm_srli_si128 (x1, 8), x2);
+
+    k = _mm_loadl_epi64 ((const __m128i*) k5k0);
+    x2 = _mm_srli_si128 (x1, 4);
+    x1 = _mm_xor_si128 (_mm_clmulepi64_si128 (_mm_and_si128 (x1, mask32), k, 0x00), x2);
+
+    // Barrett reduction down to 32 bits
+    k = _mm_load_si128 ((const __m128i*) poly);
+    x2 = _mm_clmulepi64_si128 (_mm_and_si128 (x1, mask32), k, 0x10);
+    x2 = _mm_clmulepi64_si128 (_mm_and_si128 (x2, mask32), k, 0x00);
+
+    return (uint32) _mm_extract_epi32 (_mm_xor_si128 (x1, x2), 1);
+}
+   #endif
+
+   #if JUCE_USE_ARM_CRC32_INTRINSICS
+// The ARMv8 CRC32 instructions use the same polynomial as zlib. This takes and returns
+// the CRC in its inverted form.
+static uint32 crc32WithARMInstructions (uint32 crc, const uint8* data, size_t numBytes) noexcept
+{
+    for (; numBytes >= 8; data += 8, numBytes -= 8)
+    {
+        uint64 word;
+        memcpy (&word, data, 8);
+        crc = __crc32d (crc, word);
+    }
+
+    for (; numBytes > 0; ++data, --numBytes)
+        crc = __crc32b (crc, *data);
+
+    return crc;
+}
+   #endif
+
+uLong ZEXPORT crc32 (uLong crc, const Bytef* buf, uInt len)
+{
+    if (buf == Z_NULL)
+        return 0;
+
+   #if JUCE_USE_CLMUL_INTRINSICS
+    static const CPUDispatch::Function<bool> canUseCLMUL ("crc32",
+    {
+        { "pclmulqdq", CPUDispatch::pclmulqdq | CPUDispatch::sse41, true },
+        { "generic",   0,                                            false }
+    });
+
+    if (len >= 64 && canUseCLMUL.get())
+    {
+        auto numBlockBytes = len & ~15u;
+        crc = ~crc32WithCLMUL (~(uint32) crc, buf, numBlockBytes);
+        buf += numBlockBytes;
+        len -= numBlockBytes;
+    }
+   #elif JUCE_USE_ARM_CRC32_INTRINSICS
+    return ~crc32WithARMInstructions (~(uint32) crc, buf, len);
+   #endif
+
+    return portableCrc32 (crc, buf, len);
+}
+  #endif
+
   #if JUCE_CLANG
    #pragma clang diagnostic pop
   #endif
@@ -25,7 +25,7 @@ namespace juce
 
 struct ZipFile::ZipEntryHolder
 {
-    ZipEntryHolder (const char* buffer, int fileNameLen)
+    ZipEntryHolder (const char* buffer, int fileNameLen, int extraFieldLen)
     {
         isCompressed            = ByteOrder::littleEndianShort (buffer + 10) != 0;
         entry.fileTime          = parseFileTime (ByteOrder::littleEndianShort (buffer + 12),
@@ -34,6 +34,39 @@ struct ZipFile::ZipEntryHolder
         entry.uncompressedSize  = (int64) ByteOrder::littleEndianInt (buffer + 24);
         streamOffset            = (int64) ByteOrder::littleEndianInt (buffer + 42);
         entry.filename          = String::fromUTF8 (buffer + 46, fileNameLen);
+
+        readZip64ExtraField (buffer + 46 + fileNameLen, extraFieldLen);
+    }
+
+    // In a ZIP64 archive, any of the sizes or the offset that are too big for 32 bits are set
+    // to 0xffffffff, and their real values are stored in this extra field, in this order.
+    void readZip64ExtraField (const char* extraField, int length)
+    {
+        for (int pos = 0; pos + 4 <= length;)
+        {
+            auto fieldID   = ByteOrder::littleEndianShort (extraField + pos);
+            auto fieldSize = (int) ByteOrder::littleEndianShort (extraField + pos + 2);
+            pos += 4;
+
+            if (fieldID == 1)
+            {
+                auto* data = extraField + pos;
+                auto* end = data + jmin (fieldSize, length - pos);
+
+                for (auto* value : { &entry.uncompressedSize, &compressedSize, &streamOffset })
+                {
+                    if (*value == 0xffffffff && data + 8 <= end)
+                    {
+                        *value = (int64) ByteOrder::littleEndianInt64 (data);
+                        data += 8;
+                    }
+                }
+
+                return;
+            }
+
+            pos += fieldSize;
+        }
     }
 
     struct FileNameComparator
@@ -84,11 +117,29 @@ static int64 findCentralDirectoryFileHeader (InputStream& input, int& numEntries
         {
             if (ByteOrder::littleEndianInt (buffer + i) == 0x06054b50)
             {
-                in.setPosition (pos + i);
+                auto endRecordPos = pos + i;
+                in.setPosition (endRecordPos);
                 in.read (buffer, 22);
                 numEntries = ByteOrder::littleEndianShort (buffer + 10);
                 auto offset = (int64) ByteOrder::littleEndianInt (buffer + 16);
 
+                // A ZIP64 archive has another end record, with 64-bit values, which is found
+                // by a locator that comes immediately before the normal one.
+                char zip64Buffer[56];
+
+                if (endRecordPos >= 20
+                     && in.setPosition (endRecordPos - 20)
+                     && in.read (zip64Buffer, 20) == 20
+                     && ByteOrder::littleEndianInt (zip64Buffer) == 0x07064b50
+                     && in.setPosition ((int64) ByteOrder::littleEndianInt64 (zip64Buffer + 8))
+                     && in.read (zip64Buffer, 56) == 56
+                     && ByteOrder::littleEndianInt (zip64Buffer) == 0x06064b50)
+                {
+                    numEntries = (int) jmin ((int64) std::numeric_limits<int>::max(),
+                                             (int64) ByteOrder::littleEndianInt64 (zip64Buffer + 32));
+                    offset = (int64) ByteOrder::littleEndianInt64 (zip64Buffer + 48);
+                }
+
                 if (offset >= 4)
                 {
                     in.setPosition (offset);
@@ -128,12 +179,15 @@ struct ZipFile::ZipInputStream  : public InputStream
         else
         {
            #if JUCE_DEBUG
-            zf.streamCounter.numOpenStreams++;
+            ++zf.streamCounter.numOpenStreams;
            #endif
         }
 
         char buffer[30];
 
+        // (the source stream may be shared with streams that are being read on other threads)
+        const ScopedLock sl (zf.lock);
+
         if (inputStream != nullptr
              && inputStream->setPosition (zei.streamOffset)
              && inputStream->read (buffer, 30) == 30
@@ -148,7 +202,7 @@ struct ZipFile::ZipInputStream  : public InputStream
     {
        #if JUCE_DEBUG
         if (inputStream != nullptr && inputStream == file.inputStream)
-            file.streamCounter.numOpenStreams--;
+            --file.streamCounter.numOpenStreams;
        #endif
     }
 
@@ -212,6 +266,71 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipInputStream)
 };
 
+//==============================================================================
+// When the zip is a file, this reads an entry's data directly from a memory-mapped view of
+// it, which avoids all the seeking, locking and copying that a ZipInputStream has to do.
+struct ZipFile::MappedEntryStream  : public InputStream
+{
+    MappedEntryStream (const File& zipFile, int64 zipFileSize, const ZipEntryHolder& zei)
+        : map (zipFile, Range<int64> (zei.streamOffset,
+                                      // (the local header's name and extra field lengths aren't
+                                      // known yet, so this allows for the largest they could be)
+                                      jmin (zipFileSize, zei.streamOffset + 30 + 2 * 65535 + zei.compressedSize)),
+               MemoryMappedFile::readOnly)
+    {
+        auto* header = static_cast<const char*> (map.getData());
+
+        if (header == nullptr || map.getRange().getEnd() < zei.streamOffset + 30)
+            return;
+
+        header += zei.streamOffset - map.getRange().getStart();
+
+        if (ByteOrder::littleEndianInt (header) != 0x04034b50)
+            return;
+
+        auto dataStart = zei.streamOffset + 30 + ByteOrder::littleEndianShort (header + 26)
+                                               + ByteOrder::littleEndianShort (header + 28);
+
+        if (dataStart + zei.compressedSize <= map.getRange().getEnd())
+        {
+            data = static_cast<const char*> (map.getData()) + (dataStart - map.getRange().getStart());
+            size = zei.compressedSize;
+        }
+    }
+
+    bool isValid() const noexcept           { return data != nullptr; }
+    const void* getData() const noexcept    { return data; }
+
+    int64 getTotalLength() override         { return size; }
+    int64 getPosition() override            { return pos; }
+    bool isExhausted() override             { return pos >= size; }
+
+    bool setPosition (int64 newPos) override
+    {
+        pos = jlimit ((int64) 0, size, newPos);
+        return true;
+    }
+
+    int read (void* buffer, int howMany) override
+    {
+        auto num = (int) jmin ((int64) howMany, size - pos);
+
+        if (num <= 0)
+            return 0;
+
+        memcpy (buffer, data + pos, (size_t) num);
+        pos += num;
+        return num;
+    }
+
+private:
+    MemoryMappedFile map;
+    const char* data = nullptr;
+    int64 size = 0, pos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedEntryStream)
+};
+
 
 //==============================================================================
 ZipFile::ZipFile (InputStream* stream, bool deleteStreamWhenDestroyed)
@@ -228,7 +347,7 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
     init();
 }
 
-ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
+ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file)), sourceFile (file)
 {
     init();
 }
@@ -251,7 +370,7 @@ ZipFile::OpenStreamCounter::~OpenStreamCounter()
        Streams can't be kept open after the file is deleted because they need to share the input
        stream that is managed by the ZipFile object.
     */
-    jassert (numOpenStreams == 0);
+    jassert (numOpenStreams.get() == 0);
 }
 #endif
 
@@ -294,7 +413,16 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 
     if (auto* zei = entries[index])
     {
-        stream = new ZipInputStream (*this, *zei);
+        if (sourceFile != File() && zei->compressedSize > 0)
+        {
+            ScopedPointer<MappedEntryStream> mapped (new MappedEntryStream (sourceFile, sourceFileSize, *zei));
+
+            if (mapped->isValid())
+                stream = mapped.release();
+        }
+
+        if (stream == nullptr)
+            stream = new ZipInputStream (*this, *zei);
 
         if (zei->isCompressed)
         {
@@ -339,6 +467,7 @@ void ZipFile::init()
 
     if (in != nullptr)
     {
+        sourceFileSize = in->getTotalLength();
         int numEntries = 0;
         auto centralDirectoryPos = findCentralDirectoryFileHeader (*in, numEntries);
 
@@ -364,7 +493,10 @@ void ZipFile::init()
                     if (pos + 46 + fileNameLen > size)
                         break;
 
-                    entries.add (new ZipEntryHolder (buffer, fileNameLen));
+                    auto extraFieldLen = (int) jmin ((size_t) ByteOrder::littleEndianShort (buffer + 30),
+                                                     size - (pos + 46 + fileNameLen));
+
+                    entries.add (new ZipEntryHolder (buffer, fileNameLen, extraFieldLen));
 
                     pos += 46 + fileNameLen
                             + ByteOrder::littleEndianShort (buffer + 30)
@@ -375,6 +507,20 @@ void ZipFile::init()
     }
 }
 
+static String getEntryPath (const ZipFile::ZipEntry& entry)
+{
+   #if JUCE_WINDOWS
+    return entry.filename;
+   #else
+    return entry.filename.replaceCharacter ('\\', '/');
+   #endif
+}
+
+static bool isDirectoryPath (const String& entryPath)
+{
+    return entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\');
+}
+
 Result ZipFile::uncompressTo (const File& targetDirectory,
                               const bool shouldOverwriteFiles)
 {
@@ -389,22 +535,104 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory, bool shouldOverwriteFiles, ThreadPool& pool)
+{
+    // This is shared with the pool jobs, because a job may not get started until
+    // after all the entries have been written and this method has returned.
+    struct Extraction
+    {
+        Extraction (ZipFile& z, const File& target, bool overwrite, const Array<int>& indexes)
+            : zip (z), targetDirectory (target), shouldOverwriteFiles (overwrite), entryIndexes (indexes)
+        {
+            if (entryIndexes.isEmpty())
+                allFinished.signal();
+        }
+
+        void run()
+        {
+            for (;;)
+            {
+                auto index = nextIndex++;
+
+                if (index >= entryIndexes.size())
+                    return;
+
+                if (! failed)
+                {
+                    auto r = zip.uncompressEntry (entryIndexes.getUnchecked (index), targetDirectory, shouldOverwriteFiles);
+
+                    if (r.failed())
+                    {
+                        const ScopedLock sl (lock);
+
+                        if (! failed)
+                            result = r;
+
+                        failed = true;
+                    }
+                }
+
+                if (++numFinished == entryIndexes.size())
+                    allFinished.signal();
+            }
+        }
+
+        ZipFile& zip;
+        const File targetDirectory;
+        const bool shouldOverwriteFiles;
+        const Array<int> entryIndexes;
+        CriticalSection lock;
+        Result result { Result::ok() };
+        std::atomic<int> nextIndex { 0 }, numFinished { 0 };
+        std::atomic<bool> failed { false };
+        WaitableEvent allFinished { true };
+
+        JUCE_DECLARE_NON_COPYABLE (Extraction)
+    };
+
+    // The folders are all created first, so that the jobs don't race each other to create
+    // the same parent folders
+    Array<int> fileEntries;
+
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        auto entryPath = getEntryPath (entries.getUnchecked (i)->entry);
+
+        if (entryPath.isEmpty())
+            continue;
+
+        auto targetFile = targetDirectory.getChildFile (entryPath);
+        auto folder = isDirectoryPath (entryPath) ? targetFile : targetFile.getParentDirectory();
+
+        if (! folder.createDirectory())
+            return Result::fail ("Failed to create target folder: " + folder.getFullPathName());
+
+        if (! isDirectoryPath (entryPath))
+            fileEntries.add (i);
+    }
+
+    auto extraction = std::make_shared<Extraction> (*this, targetDirectory, shouldOverwriteFiles, fileEntries);
+
+    for (int i = jmin (pool.getNumThreads(), fileEntries.size() - 1); --i >= 0;)
+        pool.addJob ([extraction] { extraction->run(); });
+
+    extraction->run();
+    extraction->allFinished.wait();
+
+    return extraction->result;
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     auto* zei = entries.getUnchecked (index);
-
-   #if JUCE_WINDOWS
-    auto entryPath = zei->entry.filename;
-   #else
-    auto entryPath = zei->entry.filename.replaceCharacter ('\\', '/');
-   #endif
+    auto entryPath = getEntryPath (zei->entry);
 
     if (entryPath.isEmpty())
         return Result::ok();
 
     auto targetFile = targetDirectory.getChildFile (entryPath);
 
-    if (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+    if (isDirectoryPath (entryPath))
         return targetFile.createDirectory(); // (entry is a directory, not a file)
 
     ScopedPointer<InputStream> in (createStreamForEntry (index));
@@ -425,12 +653,21 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool sh
         return Result::fail ("Failed to create target folder: " + targetFile.getParentDirectory().getFullPathName());
 
     {
-        FileOutputStream out (targetFile);
+        FileOutputStream out (targetFile, 65536);
 
         if (out.failedToOpen())
             return Result::fail ("Failed to write to target file: " + targetFile.getFullPathName());
 
-        out << *in;
+        // an uncompressed entry that's mapped into memory can be written in one go
+        if (auto* mapped = dynamic_cast<MappedEntryStream*> (in.get()))
+            out.write (mapped->getData(), (size_t) mapped->getTotalLength());
+        else
+            out << *in;
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return Result::fail ("Failed to write to target file: " + targetFile.getFullPathName());
     }
 
     targetFile.setCreationTime (zei->entry.fileTime);
@@ -449,46 +686,96 @@ struct ZipFile::Builder::Item
     {
     }
 
-    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    // Reads and compresses the source into memory. This doesn't touch the target stream,
+    // so it can be done on any thread, before the item's turn to be written comes round.
+    bool compress()
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        compressedData.reset();
+        compressedData.ensureSize ((size_t) jmax ((int64) 0, file.getSize()));
 
-        if (compressionLevel > 0)
-        {
-            GZIPCompressorOutputStream compressor (&compressedData, compressionLevel, false,
-                                                   GZIPCompressorOutputStream::windowBitsRaw);
-            if (! writeSource (compressor))
-                return false;
-        }
-        else
         {
-            if (! writeSource (compressedData))
-                return false;
+            MemoryOutputStream out (compressedData, false);
+
+            if (compressionLevel > 0)
+            {
+                GZIPCompressorOutputStream compressor (&out, compressionLevel, false,
+                                                       GZIPCompressorOutputStream::windowBitsRaw);
+                if (! writeSource (compressor))
+                    return false;
+            }
+            else
+            {
+                if (! writeSource (out))
+                    return false;
+            }
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        compressedSize = (int64) compressedData.getSize();
+        isCompressed = true;
+        return true;
+    }
+
+    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    {
+        if (! isCompressed && ! compress())
+            return false;
+
         headerStart = target.getPosition() - overallStartPosition;
 
+        // If either size is too big for 32 bits, the local header has to hold both of
+        // them in a ZIP64 extra field
+        auto zip64 = needsZip64Sizes();
+
         target.writeInt (0x04034b50);
-        writeFlagsAndSizes (target);
-        target << storedPathname
-               << compressedData;
+        writeFlagsAndSizes (target, zip64, zip64 ? 20 : 0);
+        target << storedPathname;
 
-        return true;
+        if (zip64)
+        {
+            target.writeShort (1);
+            target.writeShort (16);
+            target.writeInt64 (uncompressedSize);
+            target.writeInt64 (compressedSize);
+        }
+
+        auto ok = target.write (compressedData.getData(), compressedData.getSize());
+
+        compressedData.reset();
+        isCompressed = false;
+        return ok;
     }
 
     bool writeDirectoryEntry (OutputStream& target)
     {
+        auto zip64Sizes = needsZip64Sizes();
+        auto zip64Offset = headerStart >= 0xffffffff;
+        auto zip64Length = (zip64Sizes ? 16 : 0) + (zip64Offset ? 8 : 0);
+
         target.writeInt (0x02014b50);
-        target.writeShort (20); // version written
-        writeFlagsAndSizes (target);
+        target.writeShort (zip64Length > 0 ? 45 : 20); // version written
+        writeFlagsAndSizes (target, zip64Sizes, zip64Length > 0 ? zip64Length + 4 : 0);
         target.writeShort (0); // comment length
         target.writeShort (0); // start disk num
         target.writeShort (0); // internal attributes
         target.writeInt (0); // external attributes
-        target.writeInt ((int) (uint32) headerStart);
+        target.writeInt ((int) (zip64Offset ? 0xffffffffu : (uint32) headerStart));
         target << storedPathname;
 
+        if (zip64Length > 0)
+        {
+            target.writeShort (1);
+            target.writeShort ((short) zip64Length);
+
+            if (zip64Sizes)
+            {
+                target.writeInt64 (uncompressedSize);
+                target.writeInt64 (compressedSize);
+            }
+
+            if (zip64Offset)
+                target.writeInt64 (headerStart);
+        }
+
         return true;
     }
 
@@ -497,9 +784,11 @@ private:
     ScopedPointer<InputStream> stream;
     String storedPathname;
     Time fileTime;
+    MemoryBlock compressedData;
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
     int compressionLevel = 0;
     unsigned long checksum = 0;
+    bool isCompressed = false;
 
     static void writeTimeAndDate (OutputStream& target, Time t)
     {
@@ -519,7 +808,7 @@ private:
 
         checksum = 0;
         uncompressedSize = 0;
-        const int bufferSize = 4096;
+        const int bufferSize = 65536;
         HeapBlock<unsigned char> buffer (bufferSize);
 
         while (! stream->isExhausted())
@@ -538,17 +827,22 @@ private:
         return true;
     }
 
-    void writeFlagsAndSizes (OutputStream& target) const
+    bool needsZip64Sizes() const noexcept
     {
-        target.writeShort (10); // version needed
+        return compressedSize >= 0xffffffff || uncompressedSize >= 0xffffffff;
+    }
+
+    void writeFlagsAndSizes (OutputStream& target, bool sizesAreInZip64Field, int extraFieldLength) const
+    {
+        target.writeShort (extraFieldLength > 0 ? 45 : 10); // version needed
         target.writeShort ((short) (1 << 11)); // this flag indicates UTF-8 filename encoding
         target.writeShort (compressionLevel > 0 ? (short) 8 : (short) 0);
         writeTimeAndDate (target, fileTime);
         target.writeInt ((int) checksum);
-        target.writeInt ((int) (uint32) compressedSize);
-        target.writeInt ((int) (uint32) uncompressedSize);
+        target.writeInt ((int) (sizesAreInZip64Field ? 0xffffffffu : (uint32) compressedSize));
+        target.writeInt ((int) (sizesAreInZip64Field ? 0xffffffffu : (uint32) uncompressedSize));
         target.writeShort ((short) storedPathname.toUTF8().sizeInBytes() - 1);
-        target.writeShort (0); // extra field length
+        target.writeShort ((short) extraFieldLength);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Item)
@@ -585,27 +879,288 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
             return false;
     }
 
+    writeCentralDirectory (target, fileStart);
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress, ThreadPool& pool) const
+{
+    // Each item can only be compressed by one thread, so whichever one gets there first
+    // claims it. If the writer reaches an item that no job has started on, it compresses
+    // the item itself rather than waiting for the pool.
+    struct Slot
+    {
+        Atomic<int> claimed;
+        WaitableEvent finished { true };
+        bool ok = false;
+    };
+
+    // This is shared with the pool jobs, because a job may not get started until
+    // after this method has returned.
+    struct SharedState
+    {
+        OwnedArray<Slot> slots;
+
+        void compress (int index, Item& item)
+        {
+            auto& slot = *slots.getUnchecked (index);
+
+            if (slot.claimed.compareAndSetBool (1, 0))
+            {
+                slot.ok = item.compress();
+                slot.finished.signal();
+            }
+        }
+    };
+
+    auto state = std::make_shared<SharedState>();
+
+    for (int i = 0; i < items.size(); ++i)
+        state->slots.add (new Slot());
+
+    // Only a limited number of items are compressed ahead of the one being written, because
+    // each of them has to be held in memory until it's written
+    auto maxItemsAhead = jmax (2, pool.getNumThreads() * 2);
+    auto fileStart = target.getPosition();
+    int numQueued = 0;
+    bool ok = true;
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        for (; numQueued < jmin (items.size(), i + maxItemsAhead); ++numQueued)
+        {
+            auto* item = items.getUnchecked (numQueued);
+            auto index = numQueued;
+            pool.addJob ([state, item, index] { state->compress (index, *item); });
+        }
+
+        if (progress != nullptr)
+            *progress = (i + 0.5) / items.size();
+
+        auto* item = items.getUnchecked (i);
+        auto& slot = *state->slots.getUnchecked (i);
+
+        state->compress (i, *item);
+        slot.finished.wait();
+
+        if (! (slot.ok && item->writeData (target, fileStart)))
+        {
+            ok = false;
+            break;
+        }
+    }
+
+    if (! ok)
+    {
+        // claim all the items that haven't been started, and wait for the ones that have,
+        // so that no jobs will touch them after we return
+        for (auto* slot : state->slots)
+            if (! slot->claimed.compareAndSetBool (1, 0))
+                slot->finished.wait();
+
+        return false;
+    }
+
+    writeCentralDirectory (target, fileStart);
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+void ZipFile::Builder::writeCentralDirectory (OutputStream& target, const int64 fileStart) const
+{
     auto directoryStart = target.getPosition();
 
     for (auto* item : items)
-        if (! item->writeDirectoryEntry (target))
-            return false;
+        item->writeDirectoryEntry (target);
 
     auto directoryEnd = target.getPosition();
+    auto numItems = (int64) items.size();
+    auto directorySize = directoryEnd - directoryStart;
+    auto directoryOffset = directoryStart - fileStart;
+
+    // If any of the values are too big for the normal end record, they're written to a
+    // ZIP64 end record, which is found via a locator just before the normal one
+    if (numItems >= 0xffff || directorySize >= 0xffffffff || directoryOffset >= 0xffffffff)
+    {
+        target.writeInt (0x06064b50);
+        target.writeInt64 (44); // size of the rest of this record
+        target.writeShort (45); // version written
+        target.writeShort (45); // version needed
+        target.writeInt (0);    // this disk number
+        target.writeInt (0);    // disk containing the central directory
+        target.writeInt64 (numItems);
+        target.writeInt64 (numItems);
+        target.writeInt64 (directorySize);
+        target.writeInt64 (directoryOffset);
+
+        target.writeInt (0x07064b50);
+        target.writeInt (0);
+        target.writeInt64 (directoryEnd - fileStart);
+        target.writeInt (1);    // total number of disks
+    }
 
     target.writeInt (0x06054b50);
     target.writeShort (0);
     target.writeShort (0);
-    target.writeShort ((short) items.size());
-    target.writeShort ((short) items.size());
-    target.writeInt ((int) (directoryEnd - directoryStart));
-    target.writeInt ((int) (directoryStart - fileStart));
+    target.writeShort ((short) jmin (numItems, (int64) 0xffff));
+    target.writeShort ((short) jmin (numItems, (int64) 0xffff));
+    target.writeInt ((int) jmin (directorySize, (int64) 0xffffffff));
+    target.writeInt ((int) jmin (directoryOffset, (int64) 0xffffffff));
     target.writeShort (0);
+}
 
-    if (progress != nullptr)
-        *progress = 1.0;
 
-    return true;
-}
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ZipFileTests  : public UnitTest
+{
+public:
+    ZipFileTests() : UnitTest ("ZipFile", "Compression") {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+        OwnedArray<MemoryBlock> contents;
+
+        for (int i = 0; i < 40; ++i)
+        {
+            auto& data = *contents.add (new MemoryBlock ((size_t) r.nextInt (200000)));
+
+            // alternate between random data and text, which compresses well
+            if (i % 2 == 0)
+                r.fillBitsRandomly (data.getData(), data.getSize());
+            else
+                for (size_t j = 0; j < data.getSize(); ++j)
+                    data[j] = (char) ('a' + (j * 7 + (size_t) i) % 13);
+        }
+
+        ThreadPool pool (4);
+        auto time = Time (2017, 5, 20, 12, 30, 10);
+
+        MemoryBlock serialZip, parallelZip;
+
+        {
+            ZipFile::Builder serial, parallel;
+            addEntries (serial, contents, time);
+            addEntries (parallel, contents, time);
+
+            beginTest ("Building in parallel gives the same archive");
+
+            MemoryOutputStream serialOut (serialZip, false), parallelOut (parallelZip, false);
+            expect (serial.writeToStream (serialOut, nullptr));
+            expect (parallel.writeToStream (parallelOut, nullptr, pool));
+        }
+
+        expect (serialZip == parallelZip);
+
+        beginTest ("Reading from a stream");
+        {
+            MemoryInputStream in (serialZip, false);
+            ZipFile zip (in);
+            expectEntries (zip, contents);
+        }
+
+        auto tempZip = File::createTempFile (".zip");
+        auto tempDir = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("ZipFileTests", {}, false);
+        tempZip.replaceWithData (serialZip.getData(), serialZip.getSize());
+
+        {
+            ZipFile zip (tempZip);
+
+            beginTest ("Reading from a file");
+            expectEntries (zip, contents);
+
+            beginTest ("Uncompressing in parallel");
+            expect (zip.uncompressTo (tempDir, true, pool).wasOk());
+
+            for (int i = 0; i < contents.size(); ++i)
+            {
+                MemoryBlock written;
+                expect (tempDir.getChildFile (getEntryName (i)).loadFileAsData (written));
+                expect (written == *contents.getUnchecked (i));
+            }
+        }
+
+        beginTest ("ZIP64 archives");
+        {
+            const int numEntries = 70000;
+            ZipFile::Builder builder;
+
+            for (int i = 0; i < numEntries; ++i)
+            {
+                auto text = String (i);
+                builder.addEntry (new MemoryInputStream (text.toRawUTF8(), text.getNumBytesAsUTF8(), true),
+                                  0, "f" + String (i), time);
+            }
+
+            MemoryBlock zipData;
+
+            {
+                MemoryOutputStream out (zipData, false);
+                expect (builder.writeToStream (out, nullptr));
+            }
+
+            // the normal end record can't hold this many entries
+            expectEquals ((int) ByteOrder::littleEndianShort (static_cast<const char*> (zipData.getData()) + zipData.getSize() - 12), 0xffff);
+
+            MemoryInputStream in (zipData, false);
+            ZipFile zip (in);
+            expectEquals (zip.getNumEntries(), numEntries);
+
+            for (int i = 0; i < numEntries; i += 997)
+            {
+                ScopedPointer<InputStream> entryStream (zip.createStreamForEntry (i));
+                expect (entryStream != nullptr && entryStream->readEntireStreamAsString() == String (i));
+            }
+        }
+
+        tempDir.deleteRecursively();
+        tempZip.deleteFile();
+    }
+
+    static String getEntryName (int index)
+    {
+        return "folder" + String (index % 3) + "/file" + String (index);
+    }
+
+    static void addEntries (ZipFile::Builder& builder, const OwnedArray<MemoryBlock>& contents, Time time)
+    {
+        for (int i = 0; i < contents.size(); ++i)
+            builder.addEntry (new MemoryInputStream (*contents.getUnchecked (i), true),
+                              i % 3 == 0 ? 0 : 6, getEntryName (i), time);
+    }
+
+    void expectEntries (ZipFile& zip, const OwnedArray<MemoryBlock>& contents)
+    {
+        expectEquals (zip.getNumEntries(), contents.size());
+
+        for (int i = 0; i < contents.size(); ++i)
+        {
+            ScopedPointer<InputStream> in (zip.createStreamForEntry (i));
+            expect (in != nullptr);
+
+            if (in != nullptr)
+            {
+                MemoryBlock data;
+                in->readIntoMemoryBlock (data);
+                expect (data == *contents.getUnchecked (i));
+                expectEquals (zip.getEntry (i)->filename, getEntryName (i));
+            }
+        }
+    }
+};
+
+static ZipFileTests zipFileTests;
+
+#endif
 
 } // namespace juce
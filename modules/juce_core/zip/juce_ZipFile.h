@@ -29,6 +29,9 @@ namespace juce
 
     This can enumerate the items in a ZIP file and can create suitable stream objects
     to read each one.
+
+    ZIP64 archives can be read, and the Builder will write the ZIP64 records when an
+    archive has more than 65535 entries, or is too big for the normal 32-bit fields.
 */
 class JUCE_API  ZipFile
 {
@@ -153,6 +156,25 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, using the threads of a ThreadPool
+        to write several entries at once.
+
+        The folders are all created first, and then the entries are shared out between the
+        pool's threads and the calling thread. This method won't return until all of them
+        have been written, or one of them has failed.
+
+        When the zip was opened from a File, the entries are read from a memory-mapped view
+        of it, so the threads don't have to take turns to read from a shared stream.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param pool                 the pool whose threads should help with the work
+        @returns success if the file is successfully unzipped, or the first error that occurred
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         bool shouldOverwriteFiles,
+                         ThreadPool& pool);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
@@ -216,18 +238,33 @@ public:
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, using the threads of a ThreadPool to compress several
+            entries at once.
+
+            The archive that's written is identical to the one that the other writeToStream()
+            method would write, and the entries are still written to the target stream in order,
+            on the calling thread. Only a few entries are compressed ahead of the one being
+            written, so the memory used doesn't grow with the size of the archive.
+
+            Any streams that were given to addEntry() will be read on the pool's threads.
+        */
+        bool writeToStream (OutputStream& target, double* progress, ThreadPool& pool) const;
+
         //==============================================================================
     private:
         struct Item;
         friend struct ContainerDeletePolicy<Item>;
         OwnedArray<Item> items;
 
+        void writeCentralDirectory (OutputStream&, int64 fileStart) const;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
 
 private:
     //==============================================================================
     struct ZipInputStream;
+    struct MappedEntryStream;
     struct ZipEntryHolder;
 
     OwnedArray<ZipEntryHolder> entries;
@@ -235,6 +272,8 @@ private:
     InputStream* inputStream = nullptr;
     ScopedPointer<InputStream> streamToDelete;
     ScopedPointer<InputSource> inputSource;
+    File sourceFile;
+    int64 sourceFileSize = 0;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -242,7 +281,7 @@ private:
         OpenStreamCounter() {}
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        Atomic<int> numOpenStreams;
     };
 
     OpenStreamCounter streamCounter;
@@ -29,6 +29,22 @@
 #  define PUP(a) *++(a)
 #endif
 
+/* The window is a separate buffer from the output, so when INFLATE_CHUNK_COPY
+   is defined, the parts of a match that come from it are copied with memcpy. */
+#ifdef INFLATE_CHUNK_COPY
+#  define COPY_FROM_WINDOW() \
+    do { \
+        zmemcpy(out + OFF, from + OFF, op); \
+        out += op; \
+        from += op; \
+    } while (0)
+#else
+#  define COPY_FROM_WINDOW() \
+    do { \
+        PUP(out) = PUP(from); \
+    } while (--op)
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -91,6 +107,9 @@ void inflate_fast (z_streamp strm, unsigned start)
     unsigned len;               /* match length, unused bytes */
     unsigned dist;              /* match distance */
     unsigned char FAR *from;    /* where to copy match from */
+#ifdef INFLATE_CHUNK_COPY
+    unsigned char FAR *limit;   /* end of the output buffer */
+#endif
 
     /* copy state to local variables */
     state = (struct inflate_state FAR *)strm->state;
@@ -99,6 +118,9 @@ void inflate_fast (z_streamp strm, unsigned start)
     out = strm->next_out - OFF;
     beg = out - (start - strm->avail_out);
     end = out + (strm->avail_out - 257);
+#ifdef INFLATE_CHUNK_COPY
+    limit = out + strm->avail_out;
+#endif
 #ifdef INFLATE_STRICT
     dmax = state->dmax;
 #endif
@@ -194,9 +216,7 @@ void inflate_fast (z_streamp strm, unsigned start)
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
+                            COPY_FROM_WINDOW();
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -205,16 +225,12 @@ void inflate_fast (z_streamp strm, unsigned start)
                         op -= write;
                         if (op < len) {         /* some from end of window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
+                            COPY_FROM_WINDOW();
                             from = window - OFF;
                             if (write < len) {  /* some from start of window */
                                 op = write;
                                 len -= op;
-                                do {
-                                    PUP(out) = PUP(from);
-                                } while (--op);
+                                COPY_FROM_WINDOW();
                                 from = out - dist;      /* rest from output */
                             }
                         }
@@ -223,9 +239,7 @@ void inflate_fast (z_streamp strm, unsigned start)
                         from += write - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
+                            COPY_FROM_WINDOW();
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -243,6 +257,26 @@ void inflate_fast (z_streamp strm, unsigned start)
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
+#ifdef INFLATE_CHUNK_COPY
+                    /* When the match is at least 8 bytes back, each 8-byte
+                       chunk only reads bytes that have already been written,
+                       so it can be copied a chunk at a time.  This may write
+                       up to 7 bytes past the end of the match, which is fine
+                       as long as they're still inside the output buffer, as
+                       they'll be overwritten by whatever comes next. */
+                    if (dist >= 8 && len + 7 <= (unsigned)(limit - out)) {
+                        while (len > 8) {
+                            zmemcpy(out + OFF, from + OFF, 8);
+                            out += 8;
+                            from += 8;
+                            len -= 8;
+                        }
+                        zmemcpy(out + OFF, from + OFF, 8);
+                        out += len;
+                        len = 0;
+                    }
+                    else
+#endif
                     do {                        /* minimum length is three */
                         PUP(out) = PUP(from);
                         PUP(out) = PUP(from);
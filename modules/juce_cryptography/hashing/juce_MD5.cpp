@@ -69,6 +69,62 @@ public:
         memcpy (buffer + bufferPos, static_cast<const char*> (data) + i, dataSize - i);
     }
 
+    int64 processStream (InputStream& input, int64 numBytesToRead)
+    {
+        if (numBytesToRead < 0)
+            numBytesToRead = std::numeric_limits<int64>::max();
+
+        const int bufferSize = 65536;
+        HeapBlock<uint8> tempBuffer (bufferSize);
+        int64 totalRead = 0;
+
+        while (totalRead < numBytesToRead)
+        {
+            auto bytesRead = input.read (tempBuffer, (int) jmin ((int64) bufferSize, numBytesToRead - totalRead));
+
+            if (bytesRead <= 0)
+                break;
+
+            totalRead += bytesRead;
+            processBlock (tempBuffer, (size_t) bytesRead);
+        }
+
+        return totalRead;
+    }
+
+    bool processFile (const File& file)
+    {
+        const int64 fileSize = file.getSize();
+        const int64 windowSize = 64 * 1024 * 1024;
+        int64 position = 0;
+
+        // The file is read through a series of memory-mapped windows, so its contents are hashed
+        // straight out of the page cache without being copied into a buffer first..
+        while (position < fileSize)
+        {
+            const Range<int64> range (position, jmin (fileSize, position + windowSize));
+            MemoryMappedFile window (file, range, MemoryMappedFile::readOnly);
+
+            if (window.getData() == nullptr || window.getRange() != range)
+                break;
+
+            processBlock (window.getData(), window.getSize());
+            position = range.getEnd();
+        }
+
+        if (position == fileSize && fileSize > 0)
+            return true;
+
+        // ..but if that fails, carry on from wherever we got to by reading it normally
+        FileInputStream fin (file);
+
+        if (fin.getStatus().failed() || ! fin.setPosition (position))
+            return false;
+
+        processStream (fin, -1);
+        return true;
+    }
+
     void transform (const void* bufferToTransform) noexcept
     {
         uint32 a = state[0];
@@ -249,10 +305,10 @@ MD5::MD5 (InputStream& input, int64 numBytesToRead)
 
 MD5::MD5 (const File& file)
 {
-    FileInputStream fin (file);
+    MD5Generator generator;
 
-    if (fin.getStatus().wasOk())
-        processStream (fin, -1);
+    if (generator.processFile (file))
+        generator.finish (result);
     else
         zerostruct (result);
 }
@@ -269,22 +325,7 @@ void MD5::processData (const void* data, size_t numBytes) noexcept
 void MD5::processStream (InputStream& input, int64 numBytesToRead)
 {
     MD5Generator generator;
-
-    if (numBytesToRead < 0)
-        numBytesToRead = std::numeric_limits<int64>::max();
-
-    while (numBytesToRead > 0)
-    {
-        uint8 tempBuffer [512];
-        auto bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) sizeof (tempBuffer)));
-
-        if (bytesRead <= 0)
-            break;
-
-        numBytesToRead -= bytesRead;
-        generator.processBlock (tempBuffer, (size_t) bytesRead);
-    }
-
+    generator.processStream (input, numBytesToRead);
     generator.finish (result);
 }
 
@@ -303,6 +344,39 @@ String MD5::toHexString() const
 bool MD5::operator== (const MD5& other) const noexcept   { return memcmp (result, other.result, sizeof (result)) == 0; }
 bool MD5::operator!= (const MD5& other) const noexcept   { return ! operator== (other); }
 
+//==============================================================================
+MD5::Builder::Builder()   : generator (new MD5Generator()) {}
+MD5::Builder::~Builder() {}
+
+void MD5::Builder::addData (const void* data, size_t numBytes)
+{
+    generator->processBlock (data, numBytes);
+}
+
+int64 MD5::Builder::addStream (InputStream& input, int64 maxBytesToRead)
+{
+    return generator->processStream (input, maxBytesToRead);
+}
+
+bool MD5::Builder::addFile (const File& file)
+{
+    return generator->processFile (file);
+}
+
+MD5 MD5::Builder::getResult() const
+{
+    auto finalState = *generator;  // (finishing it off would stop any more data being added)
+
+    MD5 m;
+    finalState.finish (m.result);
+    return m;
+}
+
+void MD5::Builder::reset()
+{
+    generator = new MD5Generator();
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -324,6 +398,14 @@ public:
             MD5 hash (m);
             expectEquals (hash.toHexString(), String (expected));
         }
+
+        {
+            TemporaryFile temp;
+            temp.getFile().create();
+            temp.getFile().appendData (input, strlen (input));
+            MD5 hash (temp.getFile());
+            expectEquals (hash.toHexString(), String (expected));
+        }
     }
 
     void runTest() override
@@ -333,6 +415,35 @@ public:
         test ("", "d41d8cd98f00b204e9800998ecf8427e");
         test ("The quick brown fox jumps over the lazy dog",  "9e107d9d372bb6826bd81d3542a419d6");
         test ("The quick brown fox jumps over the lazy dog.", "e4d909c290d0fb1ca068ffaddf22cbd0");
+
+        beginTest ("Builder");
+        {
+            auto r = getRandom();
+            MemoryBlock data (5000);
+            r.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (size_t size : { 0, 1, 55, 56, 64, 65, 1000, 5000 })
+            {
+                const MD5 expected (data.getData(), size);
+                MD5::Builder builder;
+                size_t pos = 0;
+
+                while (pos < size)
+                {
+                    auto chunk = jmin (size - pos, (size_t) r.nextInt (150));
+                    builder.addData (addBytesToPointer (data.getData(), pos), chunk);
+                    pos += chunk;
+                    builder.getResult();
+                }
+
+                expect (builder.getResult() == expected);
+
+                builder.reset();
+                MemoryInputStream m (data.getData(), size, false);
+                expectEquals (builder.addStream (m), (int64) size);
+                expect (builder.getResult() == expected);
+            }
+        }
     }
 };
 
@@ -27,6 +27,8 @@
 namespace juce
 {
 
+class MD5Generator;
+
 //==============================================================================
 /**
     MD5 checksum class.
@@ -35,7 +37,10 @@ namespace juce
     the MD5 checksum of that data.
 
     You can then retrieve this checksum as a 16-byte block, or as a hex string.
-    @see SHA256
+
+    To calculate a checksum from data that arrives in pieces, use an MD5::Builder.
+
+    @see SHA256, XXHash64
 */
 class JUCE_API  MD5
 {
@@ -101,6 +106,53 @@ public:
     bool operator== (const MD5&) const noexcept;
     bool operator!= (const MD5&) const noexcept;
 
+    //==============================================================================
+    /**
+        Calculates an MD5 checksum from a series of blocks of data.
+        @see SHA256::Builder
+    */
+    class JUCE_API  Builder
+    {
+    public:
+        /** Creates a Builder with no data added yet. */
+        Builder();
+
+        /** Destructor. */
+        ~Builder();
+
+        /** Adds a block of data to the checksum. */
+        void addData (const void* data, size_t numBytes);
+
+        /** Reads data from a stream and adds it to the checksum.
+
+            This will read from the stream until the stream is exhausted, or until
+            maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+            stream will be read.
+
+            @returns the number of bytes that were read
+        */
+        int64 addStream (InputStream& input, int64 maxBytesToRead = -1);
+
+        /** Adds the contents of a file to the checksum.
+            @returns false if the file couldn't be read
+        */
+        bool addFile (const File& file);
+
+        /** Returns the checksum of all the data that has been added so far.
+            This doesn't change the Builder's state, so you can carry on adding more
+            data afterwards.
+        */
+        MD5 getResult() const;
+
+        /** Clears all the data that has been added, so the Builder can be re-used. */
+        void reset();
+
+    private:
+        ScopedPointer<MD5Generator> generator;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+    };
+
 
 private:
     //==============================================================================
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Calculates the hashes of a list of files, using the threads of a ThreadPool to
+    hash several files at once.
+
+    The HashType can be any class that has a constructor taking a File, such as MD5,
+    SHA256 or Whirlpool. A single file's hash has to be calculated in order from start
+    to end, so the work is split up by file rather than within each file.
+
+    E.g.
+    @code
+    ThreadPool pool;
+    auto files = ParallelDirectoryWalker::findChildFiles (pool, sampleFolder, File::findFiles);
+
+    auto hashes = ParallelFileHasher<SHA256>::hashFiles (pool, files);
+    @endcode
+
+    @see MD5, SHA256, ParallelDirectoryWalker
+*/
+template <typename HashType>
+struct ParallelFileHasher
+{
+    /** Called as each file's hash is finished.
+        This will be called on several threads at once, so it must be thread-safe.
+        Return false to stop hashing any more files.
+    */
+    using Callback = std::function<bool (const File&, const HashType&)>;
+
+    /** Hashes each of the files in a list.
+
+        The calling thread does its share of the work, and this method won't return
+        until all the files have been hashed, or the callback has asked it to stop.
+
+        @returns an array containing the hash of each file, in the same order as the
+                 files. If the callback stops it early, the hashes for any files that
+                 hadn't been reached will be default-constructed.
+    */
+    static Array<HashType> hashFiles (ThreadPool& pool, const Array<File>& files,
+                                      const Callback& callback = nullptr)
+    {
+        auto job = std::make_shared<Job> (files, callback);
+
+        for (int i = jmin (pool.getNumThreads(), files.size() - 1); --i >= 0;)
+            pool.addJob ([job] { job->run(); });
+
+        job->run();
+        job->allFinished.wait();
+
+        return job->results;
+    }
+
+private:
+    //==============================================================================
+    // This is shared with the pool jobs, because a job may not get started until
+    // after hashFiles() has returned.
+    struct Job
+    {
+        Job (const Array<File>& filesToHash, const Callback& c)
+            : files (filesToHash), callback (c)
+        {
+            results.insertMultiple (0, HashType(), files.size());
+
+            if (files.isEmpty())
+                allFinished.signal();
+        }
+
+        void run()
+        {
+            for (;;)
+            {
+                auto index = nextIndex++;
+
+                if (index >= files.size())
+                    return;
+
+                if (! cancelled)
+                {
+                    // the array was sized up front, so each thread writes to its own element
+                    results.getReference (index) = HashType (files.getReference (index));
+
+                    if (callback != nullptr && ! callback (files.getReference (index), results.getReference (index)))
+                        cancelled = true;
+                }
+
+                if (++numFinished == files.size())
+                    allFinished.signal();
+            }
+        }
+
+        const Array<File> files;
+        const Callback callback;
+        Array<HashType> results;
+        std::atomic<int> nextIndex { 0 }, numFinished { 0 };
+        std::atomic<bool> cancelled { false };
+        WaitableEvent allFinished { true };
+
+        JUCE_DECLARE_NON_COPYABLE (Job)
+    };
+
+    ParallelFileHasher() = delete;
+};
+
+} // namespace juce
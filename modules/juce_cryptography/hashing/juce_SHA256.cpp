@@ -27,11 +27,31 @@
 namespace juce
 {
 
+#if JUCE_USE_SHA_INTRINSICS
+ #if JUCE_MSVC
+  #define JUCE_SHA_TARGET
+ #else
+  #define JUCE_SHA_TARGET  __attribute__ ((target ("sha,sse4.1")))
+ #endif
+#endif
+
+static const uint32 sha256Constants[] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
 class SHA256Processor
 {
 public:
-    SHA256Processor() noexcept
-        : length (0)
+    SHA256Processor (bool allowHardwareAcceleration = true) noexcept
+        : useHardware (allowHardwareAcceleration && canUseSHAInstructions())
     {
         state[0] = 0x6a09e667;
         state[1] = 0xbb67ae85;
@@ -43,21 +63,157 @@ public:
         state[7] = 0x5be0cd19;
     }
 
-    // expects 64 bytes of data
-    void processFullBlock (const void* const data) noexcept
+    static bool canUseSHAInstructions() noexcept
+    {
+       #if JUCE_USE_SHA_INTRINSICS
+        static const CPUDispatch::Function<bool> useSHAInstructions ("SHA256",
+        {
+            { "sha",     CPUDispatch::sha | CPUDispatch::sse41, true },
+            { "generic", 0,                                      false }
+        });
+
+        return useSHAInstructions.get();
+       #elif JUCE_USE_ARM_SHA_INTRINSICS
+        return true; // (the compiler has been told that every target CPU has them)
+       #else
+        return false;
+       #endif
+    }
+
+    void addData (const void* data, size_t numBytes) noexcept
+    {
+        auto* d = static_cast<const uint8*> (data);
+        length += numBytes;
+
+        if (numPending > 0)
+        {
+            auto numToCopy = jmin (numBytes, sizeof (pending) - numPending);
+            memcpy (pending + numPending, d, numToCopy);
+            numPending += numToCopy;
+            d += numToCopy;
+            numBytes -= numToCopy;
+
+            if (numPending < sizeof (pending))
+                return;
+
+            processBlocks (pending, 1);
+            numPending = 0;
+        }
+
+        auto numBlocks = numBytes / 64;
+        processBlocks (d, numBlocks);
+
+        numPending = numBytes % 64;
+        memcpy (pending, d + numBlocks * 64, numPending);
+    }
+
+    int64 addStream (InputStream& input, int64 numBytesToRead)
+    {
+        if (numBytesToRead < 0)
+            numBytesToRead = std::numeric_limits<int64>::max();
+
+        // (reading in big chunks keeps the per-call overhead of the stream out of the way)
+        const int bufferSize = 65536;
+        HeapBlock<uint8> buffer (bufferSize);
+        int64 totalRead = 0;
+
+        while (totalRead < numBytesToRead)
+        {
+            auto bytesRead = input.read (buffer, (int) jmin ((int64) bufferSize, numBytesToRead - totalRead));
+
+            if (bytesRead <= 0)
+                break;
+
+            addData (buffer, (size_t) bytesRead);
+            totalRead += bytesRead;
+        }
+
+        return totalRead;
+    }
+
+    // Reads the file through a series of memory-mapped windows, so its contents are hashed
+    // straight out of the page cache without being copied into a buffer first.
+    bool addFile (const File& file)
+    {
+        const int64 fileSize = file.getSize();
+        const int64 windowSize = 64 * 1024 * 1024;
+        int64 position = 0;
+
+        while (position < fileSize)
+        {
+            const Range<int64> range (position, jmin (fileSize, position + windowSize));
+            MemoryMappedFile window (file, range, MemoryMappedFile::readOnly);
+
+            if (window.getData() == nullptr || window.getRange() != range)
+                break;
+
+            addData (window.getData(), window.getSize());
+            position = range.getEnd();
+        }
+
+        if (position == fileSize && fileSize > 0)
+            return true;
+
+        // if the file couldn't be mapped, carry on from wherever we got to by reading it normally
+        FileInputStream fin (file);
+
+        if (fin.getStatus().failed() || ! fin.setPosition (position))
+            return false;
+
+        addStream (fin, -1);
+        return true;
+    }
+
+    // This leaves the processor's state alone, so more data can still be added afterwards
+    void getResult (uint8* result) const noexcept
+    {
+        auto numBits = length * 8;
+
+        uint8 finalBlocks[128] = {};
+        memcpy (finalBlocks, pending, numPending);
+        finalBlocks[numPending] = 128; // append a '1' bit
+
+        auto numFinalBytes = numPending < 56 ? 64 : 128;
+
+        for (int i = 0; i < 8; ++i)
+            finalBlocks[numFinalBytes - 1 - i] = (uint8) (numBits >> (i * 8)); // append the length.
+
+        auto finalState = *this;
+        finalState.processBlocks (finalBlocks, (size_t) numFinalBytes / 64);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            *result++ = (uint8) (finalState.state[i] >> 24);
+            *result++ = (uint8) (finalState.state[i] >> 16);
+            *result++ = (uint8) (finalState.state[i] >> 8);
+            *result++ = (uint8) finalState.state[i];
+        }
+    }
+
+private:
+    uint32 state[8];
+    uint64 length = 0;
+    uint8 pending[64];
+    size_t numPending = 0;
+    bool useHardware;
+
+    void processBlocks (const uint8* data, size_t numBlocks) noexcept
     {
-        const uint32 constants[] =
+       #if JUCE_USE_SHA_INTRINSICS || JUCE_USE_ARM_SHA_INTRINSICS
+        if (useHardware)
         {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
+            processBlocksWithSHAInstructions (state, data, numBlocks);
+            return;
+        }
+       #endif
+
+        for (size_t i = 0; i < numBlocks; ++i)
+            processFullBlock (data + i * 64);
+    }
 
+    // expects 64 bytes of data
+    void processFullBlock (const void* const data) noexcept
+    {
         uint32 block[16], s[8];
         memcpy (s, state, sizeof (s));
 
@@ -67,7 +223,7 @@ public:
         for (uint32 j = 0; j < 64; j += 16)
         {
             #define JUCE_SHA256(i) \
-                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j] \
+                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + sha256Constants[i + j] \
                                      + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15])) \
                                                : block[i]); \
                 s[(3 - i) & 7] += s[(7 - i) & 7]; \
@@ -80,73 +236,94 @@ public:
 
         for (int i = 0; i < 8; ++i)
             state[i] += s[i];
-
-        length += 64;
     }
 
-    void processFinalBlock (const void* const data, unsigned int numBytes) noexcept
+   #if JUCE_USE_SHA_INTRINSICS
+    // Uses the Intel SHA extensions. These work on the state as two registers holding
+    // ABEF and CDGH, and each sha256rnds2 does two rounds, so every four message words
+    // take two of them, with the message schedule being calculated alongside.
+    static JUCE_SHA_TARGET void processBlocksWithSHAInstructions (uint32* stateToUpdate, const uint8* data, size_t numBlocks) noexcept
     {
-        jassert (numBytes < 64);
-
-        length += numBytes;
-        length *= 8; // (the length is stored as a count of bits, not bytes)
+        const auto byteSwap = _mm_set_epi64x (0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
 
-        uint8 finalBlocks[128];
+        auto tmp    = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) stateToUpdate), 0xb1);       // CDAB
+        auto state1 = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) (stateToUpdate + 4)), 0x1b); // EFGH
+        auto state0 = _mm_alignr_epi8 (tmp, state1, 8);                                                  // ABEF
+        state1 = _mm_blend_epi16 (state1, tmp, 0xf0);                                                    // CDGH
 
-        memcpy (finalBlocks, data, numBytes);
-        finalBlocks [numBytes++] = 128; // append a '1' bit
-
-        while (numBytes != 56 && numBytes < 64 + 56)
-            finalBlocks [numBytes++] = 0; // pad with zeros..
-
-        for (int i = 8; --i >= 0;)
-            finalBlocks [numBytes++] = (uint8) (length >> (i * 8)); // append the length.
-
-        jassert (numBytes == 64 || numBytes == 128);
-
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
-    }
-
-    void copyResult (uint8* result) const noexcept
-    {
-        for (int i = 0; i < 8; ++i)
+        for (; numBlocks > 0; --numBlocks, data += 64)
         {
-            *result++ = (uint8) (state[i] >> 24);
-            *result++ = (uint8) (state[i] >> 16);
-            *result++ = (uint8) (state[i] >> 8);
-            *result++ = (uint8) state[i];
+            auto savedState0 = state0, savedState1 = state1;
+
+            auto m0 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) data), byteSwap);
+            auto m1 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 16)), byteSwap);
+            auto m2 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 32)), byteSwap);
+            auto m3 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 48)), byteSwap);
+            __m128i msg;
+
+            // (r is the group of four rounds, a holds its message words, and b and d are the
+            // words that get extended from them for the later groups)
+            #define JUCE_SHA_ROUNDS(r, a, b, d) \
+                msg = _mm_add_epi32 (a, _mm_loadu_si128 ((const __m128i*) (sha256Constants + r * 4))); \
+                state1 = _mm_sha256rnds2_epu32 (state1, state0, msg); \
+                if (r >= 3 && r <= 14)  b = _mm_sha256msg2_epu32 (_mm_add_epi32 (b, _mm_alignr_epi8 (a, d, 4)), a); \
+                state0 = _mm_sha256rnds2_epu32 (state0, state1, _mm_shuffle_epi32 (msg, 0x0e)); \
+                if (r >= 1 && r <= 12)  d = _mm_sha256msg1_epu32 (d, a);
+
+            JUCE_SHA_ROUNDS (0,  m0, m1, m3)  JUCE_SHA_ROUNDS (1,  m1, m2, m0)  JUCE_SHA_ROUNDS (2,  m2, m3, m1)  JUCE_SHA_ROUNDS (3,  m3, m0, m2)
+            JUCE_SHA_ROUNDS (4,  m0, m1, m3)  JUCE_SHA_ROUNDS (5,  m1, m2, m0)  JUCE_SHA_ROUNDS (6,  m2, m3, m1)  JUCE_SHA_ROUNDS (7,  m3, m0, m2)
+            JUCE_SHA_ROUNDS (8,  m0, m1, m3)  JUCE_SHA_ROUNDS (9,  m1, m2, m0)  JUCE_SHA_ROUNDS (10, m2, m3, m1)  JUCE_SHA_ROUNDS (11, m3, m0, m2)
+            JUCE_SHA_ROUNDS (12, m0, m1, m3)  JUCE_SHA_ROUNDS (13, m1, m2, m0)  JUCE_SHA_ROUNDS (14, m2, m3, m1)  JUCE_SHA_ROUNDS (15, m3, m0, m2)
+            #undef JUCE_SHA_ROUNDS
+
+            state0 = _mm_add_epi32 (state0, savedState0);
+            state1 = _mm_add_epi32 (state1, savedState1);
         }
-    }
 
-    void processStream (InputStream& input, int64 numBytesToRead, uint8* const result)
+        tmp    = _mm_shuffle_epi32 (state0, 0x1b);   // FEBA
+        state1 = _mm_shuffle_epi32 (state1, 0xb1);   // DCHG
+        _mm_storeu_si128 ((__m128i*) stateToUpdate,       _mm_blend_epi16 (tmp, state1, 0xf0));  // DCBA
+        _mm_storeu_si128 ((__m128i*) (stateToUpdate + 4), _mm_alignr_epi8 (state1, tmp, 8));     // HGFE
+    }
+   #elif JUCE_USE_ARM_SHA_INTRINSICS
+    // Uses the ARMv8 SHA2 instructions, each of which does four rounds
+    static void processBlocksWithSHAInstructions (uint32* stateToUpdate, const uint8* data, size_t numBlocks) noexcept
     {
-        if (numBytesToRead < 0)
-            numBytesToRead = std::numeric_limits<int64>::max();
+        auto state0 = vld1q_u32 (stateToUpdate);
+        auto state1 = vld1q_u32 (stateToUpdate + 4);
 
-        for (;;)
+        for (; numBlocks > 0; --numBlocks, data += 64)
         {
-            uint8 buffer [64];
-            const int bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64) sizeof (buffer)));
-
-            if (bytesRead < (int) sizeof (buffer))
-            {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
-                break;
-            }
-
-            numBytesToRead -= sizeof (buffer);
-            processFullBlock (buffer);
+            auto savedState0 = state0, savedState1 = state1;
+
+            auto m0 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data)));
+            auto m1 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16)));
+            auto m2 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 32)));
+            auto m3 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 48)));
+            uint32x4_t wk, tmp;
+
+            #define JUCE_SHA_ROUNDS(r, a, b, c, d) \
+                wk = vaddq_u32 (a, vld1q_u32 (sha256Constants + r * 4)); \
+                if (r < 12)  a = vsha256su0q_u32 (a, b); \
+                tmp = state0; \
+                state0 = vsha256hq_u32 (state0, state1, wk); \
+                state1 = vsha256h2q_u32 (state1, tmp, wk); \
+                if (r < 12)  a = vsha256su1q_u32 (a, c, d);
+
+            JUCE_SHA_ROUNDS (0,  m0, m1, m2, m3)  JUCE_SHA_ROUNDS (1,  m1, m2, m3, m0)  JUCE_SHA_ROUNDS (2,  m2, m3, m0, m1)  JUCE_SHA_ROUNDS (3,  m3, m0, m1, m2)
+            JUCE_SHA_ROUNDS (4,  m0, m1, m2, m3)  JUCE_SHA_ROUNDS (5,  m1, m2, m3, m0)  JUCE_SHA_ROUNDS (6,  m2, m3, m0, m1)  JUCE_SHA_ROUNDS (7,  m3, m0, m1, m2)
+            JUCE_SHA_ROUNDS (8,  m0, m1, m2, m3)  JUCE_SHA_ROUNDS (9,  m1, m2, m3, m0)  JUCE_SHA_ROUNDS (10, m2, m3, m0, m1)  JUCE_SHA_ROUNDS (11, m3, m0, m1, m2)
+            JUCE_SHA_ROUNDS (12, m0, m1, m2, m3)  JUCE_SHA_ROUNDS (13, m1, m2, m3, m0)  JUCE_SHA_ROUNDS (14, m2, m3, m0, m1)  JUCE_SHA_ROUNDS (15, m3, m0, m1, m2)
+            #undef JUCE_SHA_ROUNDS
+
+            state0 = vaddq_u32 (state0, savedState0);
+            state1 = vaddq_u32 (state1, savedState1);
         }
 
-        copyResult (result);
+        vst1q_u32 (stateToUpdate, state0);
+        vst1q_u32 (stateToUpdate + 4, state1);
     }
-
-private:
-    uint32 state[8];
-    uint64 length;
+   #endif
 
     static inline uint32 rotate (const uint32 x, const uint32 y) noexcept                { return (x >> y) | (x << (32 - y)); }
     static inline uint32 ch  (const uint32 x, const uint32 y, const uint32 z) noexcept   { return z ^ ((y ^ z) & x); }
@@ -156,8 +333,6 @@ private:
     static inline uint32 s1 (const uint32 x) noexcept     { return rotate (x, 17) ^ rotate (x, 19) ^ (x >> 10); }
     static inline uint32 S0 (const uint32 x) noexcept     { return rotate (x, 2)  ^ rotate (x, 13) ^ rotate (x, 22); }
     static inline uint32 S1 (const uint32 x) noexcept     { return rotate (x, 6)  ^ rotate (x, 11) ^ rotate (x, 25); }
-
-    JUCE_DECLARE_NON_COPYABLE (SHA256Processor)
 };
 
 //==============================================================================
@@ -192,22 +367,18 @@ SHA256::SHA256 (const void* const data, const size_t numBytes)
 SHA256::SHA256 (InputStream& input, const int64 numBytesToRead)
 {
     SHA256Processor processor;
-    processor.processStream (input, numBytesToRead, result);
+    processor.addStream (input, numBytesToRead);
+    processor.getResult (result);
 }
 
 SHA256::SHA256 (const File& file)
 {
-    FileInputStream fin (file);
+    SHA256Processor processor;
 
-    if (fin.getStatus().wasOk())
-    {
-        SHA256Processor processor;
-        processor.processStream (fin, -1, result);
-    }
+    if (processor.addFile (file))
+        processor.getResult (result);
     else
-    {
         zerostruct (result);
-    }
 }
 
 SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
@@ -218,9 +389,9 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* const data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.addData (data, numBytes);
+    processor.getResult (result);
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -236,6 +407,37 @@ String SHA256::toHexString() const
 bool SHA256::operator== (const SHA256& other) const noexcept  { return memcmp (result, other.result, sizeof (result)) == 0; }
 bool SHA256::operator!= (const SHA256& other) const noexcept  { return ! operator== (other); }
 
+//==============================================================================
+SHA256::Builder::Builder()   : processor (new SHA256Processor()) {}
+SHA256::Builder::~Builder() {}
+
+void SHA256::Builder::addData (const void* data, size_t numBytes)
+{
+    processor->addData (data, numBytes);
+}
+
+int64 SHA256::Builder::addStream (InputStream& input, int64 maxBytesToRead)
+{
+    return processor->addStream (input, maxBytesToRead);
+}
+
+bool SHA256::Builder::addFile (const File& file)
+{
+    return processor->addFile (file);
+}
+
+SHA256 SHA256::Builder::getResult() const
+{
+    SHA256 hash;
+    processor->getResult (hash.result);
+    return hash;
+}
+
+void SHA256::Builder::reset()
+{
+    processor = new SHA256Processor();
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -263,6 +465,14 @@ public:
             SHA256 hash (m);
             expectEquals (hash.toHexString(), String (expected));
         }
+
+        {
+            TemporaryFile temp;
+            temp.getFile().create();
+            temp.getFile().appendData (input, strlen (input));
+            SHA256 hash (temp.getFile());
+            expectEquals (hash.toHexString(), String (expected));
+        }
     }
 
     void runTest() override
@@ -272,6 +482,87 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+
+        beginTest ("Builder");
+        {
+            auto r = getRandom();
+            MemoryBlock data (5000);
+            r.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (size_t size : { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 5000 })
+            {
+                const SHA256 expected (data.getData(), size);
+                SHA256::Builder builder;
+                size_t pos = 0;
+
+                while (pos < size)
+                {
+                    auto chunk = jmin (size - pos, (size_t) r.nextInt (150));
+                    builder.addData (addBytesToPointer (data.getData(), pos), chunk);
+                    pos += chunk;
+
+                    if (pos < size)
+                        builder.getResult(); // (shouldn't affect the final result)
+                }
+
+                expect (builder.getResult() == expected);
+
+                builder.reset();
+                MemoryInputStream m (data.getData(), size, false);
+                expectEquals (builder.addStream (m), (int64) size);
+                expect (builder.getResult() == expected);
+            }
+        }
+
+        beginTest ("Hardware and portable versions match");
+        {
+            logMessage ("SHA instructions available: " + String (SHA256Processor::canUseSHAInstructions() ? "yes" : "no"));
+
+            auto r = getRandom();
+            MemoryBlock data (10000);
+            r.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto size = (size_t) r.nextInt ((int) data.getSize());
+                uint8 hardwareResult[32], portableResult[32];
+
+                SHA256Processor hardware (true), portable (false);
+                hardware.addData (data.getData(), size);
+                portable.addData (data.getData(), size);
+                hardware.getResult (hardwareResult);
+                portable.getResult (portableResult);
+
+                expect (memcmp (hardwareResult, portableResult, sizeof (hardwareResult)) == 0);
+            }
+        }
+
+        beginTest ("Hashing files in parallel");
+        {
+            Random r (0x1234);
+            OwnedArray<TemporaryFile> temps;
+            Array<File> files;
+            Array<SHA256> expected;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                MemoryBlock data ((size_t) r.nextInt (100000));
+                r.fillBitsRandomly (data.getData(), data.getSize());
+
+                auto* temp = temps.add (new TemporaryFile());
+                temp->getFile().replaceWithData (data.getData(), data.getSize());
+                files.add (temp->getFile());
+                expected.add (SHA256 (data));
+            }
+
+            ThreadPool pool (3);
+            expect (ParallelFileHasher<SHA256>::hashFiles (pool, files) == expected);
+
+            Atomic<int> count;
+            auto partial = ParallelFileHasher<SHA256>::hashFiles (pool, files, [&] (const File&, const SHA256&) { return ++count < 5; });
+            expectEquals (partial.size(), files.size());
+            expect (count.get() < files.size());
+        }
     }
 };
 
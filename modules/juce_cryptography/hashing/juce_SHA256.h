@@ -27,6 +27,8 @@
 namespace juce
 {
 
+class SHA256Processor;
+
 //==============================================================================
 /**
     SHA-256 secure hash generator.
@@ -35,7 +37,14 @@ namespace juce
     calculates the SHA-256 hash of that data.
 
     You can retrieve the hash as a raw 32-byte block, or as a 64-digit hex string.
-    @see MD5
+
+    On CPUs that have the Intel SHA extensions, these are detected at runtime and used
+    instead of the portable code. On ARM, the ARMv8 SHA2 instructions are used when the
+    compiler has been told that they're available (e.g. with -march=armv8-a+crypto).
+
+    To hash data that arrives in pieces, use a SHA256::Builder.
+
+    @see MD5, XXHash64
 */
 class JUCE_API  SHA256
 {
@@ -95,6 +104,62 @@ public:
     bool operator== (const SHA256&) const noexcept;
     bool operator!= (const SHA256&) const noexcept;
 
+    //==============================================================================
+    /**
+        Calculates a SHA-256 hash from a series of blocks of data.
+
+        E.g.
+        @code
+        SHA256::Builder builder;
+
+        while (auto* packet = receiveNextPacket())
+            builder.addData (packet->data, packet->size);
+
+        auto hash = builder.getResult();
+        @endcode
+    */
+    class JUCE_API  Builder
+    {
+    public:
+        /** Creates a Builder with no data added yet. */
+        Builder();
+
+        /** Destructor. */
+        ~Builder();
+
+        /** Adds a block of data to the hash. */
+        void addData (const void* data, size_t numBytes);
+
+        /** Reads data from a stream and adds it to the hash.
+
+            This will read from the stream until the stream is exhausted, or until
+            maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+            stream will be read.
+
+            @returns the number of bytes that were read
+        */
+        int64 addStream (InputStream& input, int64 maxBytesToRead = -1);
+
+        /** Adds the contents of a file to the hash.
+            @returns false if the file couldn't be read
+        */
+        bool addFile (const File& file);
+
+        /** Returns the hash of all the data that has been added so far.
+            This doesn't change the Builder's state, so you can carry on adding more
+            data afterwards.
+        */
+        SHA256 getResult() const;
+
+        /** Clears all the data that has been added, so the Builder can be re-used. */
+        void reset();
+
+    private:
+        ScopedPointer<SHA256Processor> processor;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+    };
+
 
 private:
     //==============================================================================
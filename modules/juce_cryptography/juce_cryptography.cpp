@@ -35,6 +35,22 @@
 
 #include "juce_cryptography.h"
 
+// SHA256 can switch to the Intel SHA extensions at runtime, which needs a compiler that
+// can generate them without the whole file being built for them.
+#ifndef JUCE_USE_SHA_INTRINSICS
+ #if JUCE_INTEL && ((JUCE_MSVC && _MSC_VER >= 1900) || JUCE_CLANG \
+                      || (JUCE_GCC && ! JUCE_MINGW && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409))
+  #define JUCE_USE_SHA_INTRINSICS 1
+ #endif
+#endif
+
+#if JUCE_USE_SHA_INTRINSICS
+ #include <immintrin.h>
+#elif JUCE_ARM && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #define JUCE_USE_ARM_SHA_INTRINSICS 1
+ #include <arm_neon.h>
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
@@ -60,3 +60,4 @@
 #include "hashing/juce_MD5.h"
 #include "hashing/juce_SHA256.h"
 #include "hashing/juce_Whirlpool.h"
+#include "hashing/juce_ParallelFileHasher.h"
@@ -31,6 +31,7 @@ namespace PropertyFileConstants
 {
     JUCE_CONSTEXPR static const int magicNumber            = (int) ByteOrder::littleEndianInt ('P', 'R', 'O', 'P');
     JUCE_CONSTEXPR static const int magicNumberCompressed  = (int) ByteOrder::littleEndianInt ('C', 'P', 'R', 'P');
+    JUCE_CONSTEXPR static const int magicNumberLog         = (int) ByteOrder::littleEndianInt ('P', 'R', 'P', 'L');
 
     JUCE_CONSTEXPR static const char* const fileTag        = "PROPERTIES";
     JUCE_CONSTEXPR static const char* const valueTag       = "VALUE";
@@ -43,6 +44,7 @@ PropertiesFile::Options::Options()
     : commonToAllUsers (false),
       ignoreCaseOfKeyNames (false),
       doNotSave (false),
+      saveInBackground (false),
       millisecondsBeforeSaving (3000),
       storageFormat (PropertiesFile::storeAsXML),
       processLock (nullptr)
@@ -109,6 +111,81 @@ File PropertiesFile::Options::getDefaultFile() const
 }
 
 
+//==============================================================================
+// Writes the files for any PropertiesFile objects that are saving in the background.
+// All of them share a single low-priority thread.
+struct PropertiesFileWriterThread  : public TimeSliceThread
+{
+    PropertiesFileWriterThread()  : TimeSliceThread ("PropertiesFile writer")
+    {
+        startThread (3);
+    }
+
+    ~PropertiesFileWriterThread()
+    {
+        stopThread (10000);
+    }
+};
+
+class PropertiesFile::BackgroundWriter  : public TimeSliceClient
+{
+public:
+    BackgroundWriter (PropertiesFile& f)  : owner (f)
+    {
+        setTimeSlicePriority (backgroundPriority);
+        thread->addTimeSliceClient (this);
+    }
+
+    ~BackgroundWriter()
+    {
+        // (this waits for any write that's in progress to finish)
+        thread->removeTimeSliceClient (this);
+    }
+
+    void writeLater (const StringPairArray& props, uint32 changeCount)
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingProperties = props;
+            pendingChangeCount = changeCount;
+            hasPendingProperties = true;
+        }
+
+        thread->moveToFrontOfQueue (this);
+    }
+
+    int useTimeSlice() override
+    {
+        StringPairArray props;
+        uint32 changeCount;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (! hasPendingProperties)
+                return 10000;
+
+            std::swap (props, pendingProperties);
+            changeCount = pendingChangeCount;
+            hasPendingProperties = false;
+        }
+
+        owner.writeProperties (props, changeCount);
+        return 10000;
+    }
+
+private:
+    PropertiesFile& owner;
+    SharedResourcePointer<PropertiesFileWriterThread> thread;
+
+    CriticalSection lock;
+    StringPairArray pendingProperties;
+    uint32 pendingChangeCount = 0;
+    bool hasPendingProperties = false;
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundWriter)
+};
+
 //==============================================================================
 PropertiesFile::PropertiesFile (const File& f, const Options& o)
     : PropertySet (o.ignoreCaseOfKeyNames),
@@ -128,17 +205,25 @@ PropertiesFile::PropertiesFile (const Options& o)
 
 bool PropertiesFile::reload()
 {
+    const ScopedLock wl (writeLock);
     ProcessScopedLock pl (createProcessLock());
 
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
+    auto hadValuesBeforeLoading = getAllProperties().size() > 0;
+    numRecordsInLog = 0;
     loadedOk = (! file.exists()) || loadAsBinary() || loadAsXml();
+
+    // an incremental save can only append to the file if we know exactly what's in it
+    lastWrittenProperties = getAllProperties();
+    logNeedsRewriting = (numRecordsInLog == 0 || hadValuesBeforeLoading);
     return loadedOk;
 }
 
 PropertiesFile::~PropertiesFile()
 {
+    backgroundWriter = nullptr;
     saveIfNeeded();
 }
 
@@ -149,8 +234,7 @@ InterProcessLock::ScopedLockType* PropertiesFile::createProcessLock() const
 
 bool PropertiesFile::saveIfNeeded()
 {
-    const ScopedLock sl (getLock());
-    return (! needsWriting) || save();
+    return (! needsToBeSaved()) || save();
 }
 
 bool PropertiesFile::needsToBeSaved() const
@@ -163,24 +247,77 @@ void PropertiesFile::setNeedsToBeSaved (const bool needsToBeSaved_)
 {
     const ScopedLock sl (getLock());
     needsWriting = needsToBeSaved_;
+
+    if (needsWriting)
+        ++changeCount;
 }
 
 bool PropertiesFile::save()
 {
-    const ScopedLock sl (getLock());
+    StringPairArray props;
+    uint32 changeCountOfProperties;
 
+    {
+        const ScopedLock sl (getLock());
+        stopTimer();
+
+        props = getAllProperties();
+        changeCountOfProperties = changeCount;
+    }
+
+    return writeProperties (props, changeCountOfProperties);
+}
+
+void PropertiesFile::saveInBackground()
+{
+    const ScopedLock sl (getLock());
     stopTimer();
 
-    if (options.doNotSave
-         || file == File()
-         || file.isDirectory()
-         || ! file.getParentDirectory().createDirectory())
-        return false;
+    if (! needsWriting || options.doNotSave)
+        return;
 
-    if (options.storageFormat == storeAsXML)
-        return saveAsXml();
+    if (backgroundWriter == nullptr)
+        backgroundWriter = new BackgroundWriter (*this);
 
-    return saveAsBinary();
+    backgroundWriter->writeLater (getAllProperties(), changeCount);
+}
+
+bool PropertiesFile::writeProperties (const StringPairArray& props, uint32 changeCountOfProperties)
+{
+    {
+        const ScopedLock wl (writeLock);
+
+        // a newer version may already have been written by a different thread
+        if (changeCountOfProperties < lastWrittenChangeCount)
+            return true;
+
+        if (options.doNotSave
+             || file == File()
+             || file.isDirectory()
+             || ! file.getParentDirectory().createDirectory())
+            return false;
+
+        bool ok = false;
+
+        if (options.storageFormat == storeAsXML)
+            ok = saveAsXml (props);
+        else if (options.storageFormat == storeAsIncrementalBinary)
+            ok = saveAsIncrementalBinary (props);
+        else
+            ok = saveAsBinary (props);
+
+        if (! ok)
+            return false;
+
+        lastWrittenChangeCount = changeCountOfProperties;
+    }
+
+    const ScopedLock sl (getLock());
+
+    if (changeCount == changeCountOfProperties)
+        needsWriting = false;
+
+    return true;
 }
 
 bool PropertiesFile::loadAsXml()
@@ -219,10 +356,9 @@ bool PropertiesFile::loadAsXml()
     return false;
 }
 
-bool PropertiesFile::saveAsXml()
+bool PropertiesFile::saveAsXml (const StringPairArray& props)
 {
     XmlElement doc (PropertyFileConstants::fileTag);
-    const StringPairArray& props = getAllProperties();
 
     for (int i = 0; i < props.size(); ++i)
     {
@@ -241,13 +377,7 @@ bool PropertiesFile::saveAsXml()
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
-    if (doc.writeToFile (file, String()))
-    {
-        needsWriting = false;
-        return true;
-    }
-
-    return false;
+    return doc.writeToFile (file, String());
 }
 
 bool PropertiesFile::loadAsBinary()
@@ -267,6 +397,9 @@ bool PropertiesFile::loadAsBinary()
 
         if (magicNumber == PropertyFileConstants::magicNumber)
             return loadAsBinary (fileStream);
+
+        if (magicNumber == PropertyFileConstants::magicNumberLog)
+            return loadAsIncrementalBinary (fileStream);
     }
 
     return false;
@@ -291,7 +424,7 @@ bool PropertiesFile::loadAsBinary (InputStream& input)
     return true;
 }
 
-bool PropertiesFile::saveAsBinary()
+bool PropertiesFile::saveAsBinary (const StringPairArray& props)
 {
     ProcessScopedLock pl (createProcessLock());
 
@@ -299,26 +432,29 @@ bool PropertiesFile::saveAsBinary()
         return false; // locking failure..
 
     TemporaryFile tempFile (file);
-    ScopedPointer<OutputStream> out (tempFile.getFile().createOutputStream());
 
-    if (out != nullptr)
     {
+        FileOutputStream fileStream (tempFile.getFile());
+
+        if (fileStream.failedToOpen())
+            return false;
+
+        ScopedPointer<GZIPCompressorOutputStream> gzip;
+        OutputStream* out = &fileStream;
+
         if (options.storageFormat == storeAsCompressedBinary)
         {
-            out->writeInt (PropertyFileConstants::magicNumberCompressed);
-            out->flush();
-
-            out = new GZIPCompressorOutputStream (out.release(), 9, true);
+            fileStream.writeInt (PropertyFileConstants::magicNumberCompressed);
+            out = gzip = new GZIPCompressorOutputStream (&fileStream, 9, false);
         }
         else
         {
             // have you set up the storage option flags correctly?
             jassert (options.storageFormat == storeAsBinary);
 
-            out->writeInt (PropertyFileConstants::magicNumber);
+            fileStream.writeInt (PropertyFileConstants::magicNumber);
         }
 
-        const StringPairArray& props = getAllProperties();
         const int numProperties   = props.size();
         const StringArray& keys   = props.getAllKeys();
         const StringArray& values = props.getAllValues();
@@ -331,33 +467,361 @@ bool PropertiesFile::saveAsBinary()
             out->writeString (values[i]);
         }
 
-        out = nullptr;
+        gzip = nullptr;
+        fileStream.flush(); // (this also does an fsync, so the data is safely on disk before the file is replaced)
+
+        if (fileStream.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+// The incremental format is the magic number followed by a series of records. Each
+// record is a 32-bit payload size, the payload, and then a 64-bit XXHash of the
+// payload. A payload is a byte saying whether the value was set or removed, then
+// the key, and then the value if it was set.
+namespace PropertyFileLog
+{
+    enum RecordType
+    {
+        setValue = 1,
+        removeValue = 2
+    };
+
+    static void writeRecord (OutputStream& out, RecordType type, const String& key, const String& value)
+    {
+        MemoryOutputStream payload;
+        payload.writeByte ((char) type);
+        payload.writeString (key);
+
+        if (type == setValue)
+            payload.writeString (value);
 
-        if (tempFile.overwriteTargetFileWithTemporary())
+        out.writeInt ((int) payload.getDataSize());
+        out.write (payload.getData(), payload.getDataSize());
+        out.writeInt64 ((int64) XXHash64::hash (payload.getData(), payload.getDataSize()));
+    }
+
+    static String getLookupKey (const String& key, bool ignoreCase)
+    {
+        return ignoreCase ? key.toLowerCase() : key;
+    }
+}
+
+bool PropertiesFile::loadAsIncrementalBinary (InputStream& input)
+{
+    BufferedInputStream in (input, 8192);
+    MemoryBlock payload;
+
+    // Stops at the first truncated or corrupt record, which will be one that was
+    // being written when the app died
+    for (;;)
+    {
+        auto size = in.readInt();
+
+        if (size <= 0 || size > in.getNumBytesRemaining() - 8)
+            break;
+
+        payload.setSize ((size_t) size);
+
+        if (in.read (payload.getData(), size) != size
+             || (uint64) in.readInt64() != XXHash64::hash (payload.getData(), payload.getSize()))
+            break;
+
+        MemoryInputStream record (payload, false);
+        auto type = record.readByte();
+        const String key (record.readString());
+
+        if (key.isNotEmpty())
         {
-            needsWriting = false;
-            return true;
+            if (type == PropertyFileLog::setValue)
+                getAllProperties().set (key, record.readString());
+            else if (type == PropertyFileLog::removeValue)
+                getAllProperties().remove (StringRef (key));
         }
+
+        ++numRecordsInLog;
     }
 
-    return false;
+    // if there's a damaged record, nothing can be appended after it, so the next save must rewrite the file
+    if (in.getNumBytesRemaining() > 0)
+        numRecordsInLog = 0;
+
+    return true;
+}
+
+bool PropertiesFile::saveAsIncrementalBinary (const StringPairArray& props)
+{
+    // If the log has collected a lot more records than there are values, start a new one
+    if (logNeedsRewriting || ! file.existsAsFile() || numRecordsInLog > 2 * props.size() + 64)
+        return rewriteIncrementalLog (props);
+
+    auto ignoreCase = options.ignoreCaseOfKeyNames;
+    HashMap<String, String> oldValues;
+
+    for (int i = 0; i < lastWrittenProperties.size(); ++i)
+        oldValues.set (PropertyFileLog::getLookupKey (lastWrittenProperties.getAllKeys()[i], ignoreCase),
+                       lastWrittenProperties.getAllValues()[i]);
+
+    MemoryOutputStream changes;
+    int numChanges = 0;
+
+    for (int i = 0; i < props.size(); ++i)
+    {
+        auto& key = props.getAllKeys()[i];
+        auto& value = props.getAllValues()[i];
+        auto lookupKey = PropertyFileLog::getLookupKey (key, ignoreCase);
+
+        if (! oldValues.contains (lookupKey) || oldValues[lookupKey] != value)
+        {
+            PropertyFileLog::writeRecord (changes, PropertyFileLog::setValue, key, value);
+            ++numChanges;
+        }
+
+        oldValues.remove (lookupKey);
+    }
+
+    for (HashMap<String, String>::Iterator i (oldValues); i.next();)
+    {
+        PropertyFileLog::writeRecord (changes, PropertyFileLog::removeValue, i.getKey(), {});
+        ++numChanges;
+    }
+
+    if (numChanges == 0)
+        return true;
+
+    ProcessScopedLock pl (createProcessLock());
+
+    if (pl != nullptr && ! pl->isLocked())
+        return false; // locking failure..
+
+    FileOutputStream out (file);
+
+    if (out.failedToOpen())
+        return false;
+
+    // If this fails part-way through, the partial record will be ignored when the
+    // file is loaded, but it needs to be cleared out before anything else is added
+    logNeedsRewriting = true;
+
+    if (! out.write (changes.getData(), changes.getDataSize()))
+        return false;
+
+    out.flush();
+
+    if (out.getStatus().failed())
+        return false;
+
+    logNeedsRewriting = false;
+    numRecordsInLog += numChanges;
+    lastWrittenProperties = props;
+    return true;
+}
+
+bool PropertiesFile::rewriteIncrementalLog (const StringPairArray& props)
+{
+    ProcessScopedLock pl (createProcessLock());
+
+    if (pl != nullptr && ! pl->isLocked())
+        return false; // locking failure..
+
+    TemporaryFile tempFile (file);
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (out.failedToOpen())
+            return false;
+
+        out.writeInt (PropertyFileConstants::magicNumberLog);
+
+        for (int i = 0; i < props.size(); ++i)
+            PropertyFileLog::writeRecord (out, PropertyFileLog::setValue, props.getAllKeys()[i], props.getAllValues()[i]);
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (! tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    logNeedsRewriting = false;
+    numRecordsInLog = props.size();
+    lastWrittenProperties = props;
+    return true;
+}
+
+//==============================================================================
+void PropertiesFile::saveAutomatically()
+{
+    if (options.saveInBackground)
+        saveInBackground();
+    else
+        saveIfNeeded();
 }
 
 void PropertiesFile::timerCallback()
 {
-    saveIfNeeded();
+    saveAutomatically();
 }
 
 void PropertiesFile::propertyChanged()
 {
     sendChangeMessage();
 
-    needsWriting = true;
+    {
+        const ScopedLock sl (getLock());
+        needsWriting = true;
+        ++changeCount;
+    }
 
     if (options.millisecondsBeforeSaving > 0)
         startTimer (options.millisecondsBeforeSaving);
     else if (options.millisecondsBeforeSaving == 0)
-        saveIfNeeded();
+        saveAutomatically();
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertiesFileTests  : public UnitTest
+{
+public:
+    PropertiesFileTests() : UnitTest ("PropertiesFile", "Values") {}
+
+    static PropertiesFile::Options createOptions (PropertiesFile::StorageFormat format)
+    {
+        PropertiesFile::Options options;
+        options.storageFormat = format;
+        options.millisecondsBeforeSaving = -1;
+        return options;
+    }
+
+    void expectSameValues (PropertiesFile& a, PropertiesFile& b)
+    {
+        expectEquals (a.getAllProperties().size(), b.getAllProperties().size());
+
+        for (auto& key : a.getAllProperties().getAllKeys())
+            expectEquals (b.getValue (key), a.getValue (key));
+    }
+
+    void runTest() override
+    {
+        auto file = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("PropertiesFileTest", ".settings", false);
+        auto r = getRandom();
+
+        beginTest ("Saving and loading");
+        {
+            for (auto format : { PropertiesFile::storeAsXML, PropertiesFile::storeAsBinary,
+                                 PropertiesFile::storeAsCompressedBinary, PropertiesFile::storeAsIncrementalBinary })
+            {
+                file.deleteFile();
+
+                PropertiesFile original (file, createOptions (format));
+
+                for (int i = 0; i < 50; ++i)
+                    original.setValue ("key" + String (i), String (r.nextInt()));
+                expect (original.needsToBeSaved());
+                expect (original.save());
+                expect (! original.needsToBeSaved());
+
+                PropertiesFile loaded (file, createOptions (format));
+                expect (loaded.isValidFile());
+                expectSameValues (original, loaded);
+            }
+        }
+
+        beginTest ("Incremental saves");
+        {
+            file.deleteFile();
+            auto options = createOptions (PropertiesFile::storeAsIncrementalBinary);
+
+            PropertiesFile props (file, options);
+
+            for (int i = 0; i < 100; ++i)
+                props.setValue ("key" + String (i), String::repeatedString ("x", 100));
+
+            expect (props.save());
+            auto fullSize = file.getSize();
+
+            props.setValue ("key5", "changed");
+            props.removeValue ("key6");
+            expect (props.save());
+
+            // only the two changes should have been appended
+            expect (file.getSize() > fullSize);
+            expect (file.getSize() < fullSize + 100);
+
+            {
+                PropertiesFile loaded (file, options);
+                expectSameValues (props, loaded);
+                expect (! loaded.containsKey ("key6"));
+                expectEquals (loaded.getValue ("key5"), String ("changed"));
+            }
+
+            // A truncated record at the end should be ignored, as if that save had never happened
+            auto sizeBeforeLastSave = file.getSize();
+            props.setValue ("key7", "lost");
+            expect (props.save());
+
+            {
+                FileOutputStream out (file);
+                out.setPosition (file.getSize() - 3);
+                out.truncate();
+            }
+
+            PropertiesFile loaded (file, options);
+            expectEquals (loaded.getValue ("key7"), String::repeatedString ("x", 100));
+            expectEquals (loaded.getValue ("key5"), String ("changed"));
+
+            // ..and the next save from that object rewrites the log
+            loaded.setValue ("key8", "new");
+            expect (loaded.save());
+            expect (file.getSize() < sizeBeforeLastSave);
+
+            PropertiesFile reloaded (file, options);
+            expectSameValues (loaded, reloaded);
+        }
+
+        beginTest ("Saving in the background");
+        {
+            for (auto format : { PropertiesFile::storeAsXML, PropertiesFile::storeAsIncrementalBinary })
+            {
+                file.deleteFile();
+                auto options = createOptions (format);
+                options.saveInBackground = true;
+
+                PropertiesFile props (file, options);
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    props.setValue ("key" + String (i % 7), i);
+                    props.saveInBackground();
+                }
+
+                for (int i = 0; i < 500 && props.needsToBeSaved(); ++i)
+                    Thread::sleep (10);
+
+                expect (! props.needsToBeSaved());
+
+                PropertiesFile loaded (file, options);
+                expectSameValues (props, loaded);
+                expectEquals (loaded.getIntValue ("key5"), 19);
+            }
+        }
+
+        file.deleteFile();
+    }
+};
+
+static PropertiesFileTests propertiesFileTests;
+
+#endif
+
 } // namespace juce
@@ -51,7 +51,15 @@ public:
     {
         storeAsBinary,
         storeAsCompressedBinary,
-        storeAsXML
+        storeAsXML,
+
+        /** A compact binary log, where each save just appends records for the values
+            that have changed since the last one, rather than rewriting the whole file.
+            When the log gets much longer than the data it holds, it's rewritten from scratch.
+            Each record is checksummed, so if the app dies in the middle of writing one,
+            the file will be loaded as it was after the previous save.
+        */
+        storeAsIncrementalBinary
     };
 
     //==============================================================================
@@ -115,6 +123,19 @@ public:
         /** If set to true, this prevents the file from being written to disk. */
         bool doNotSave;
 
+        /** If this is true, the saves that happen automatically after a value is changed will
+            be done by a background thread, so that the message thread isn't held up while the
+            data is converted and written to disk. A copy of the values is handed over to the
+            thread, and if they're changed again before it gets round to writing them, only
+            the latest version is saved.
+
+            Explicit calls to save() and saveIfNeeded() still write the file before returning.
+            The default constructor initialises this value to false.
+
+            @see PropertiesFile::saveInBackground
+        */
+        bool saveInBackground;
+
         /** If this is zero or greater, then after a value is changed, the object will wait
             for this amount of time and then save the file. If this zero, the file will be
             written to disk immediately on being changed (which might be slow, as it'll re-write
@@ -207,6 +228,17 @@ public:
     */
     bool save();
 
+    /** If the values have changed since they were last saved, this hands a copy of them
+        to a background thread, which will write them to disk.
+
+        This returns straight away. If another background save is still waiting to start,
+        the two are merged, so that only the newest values get written. needsToBeSaved()
+        will carry on returning true until the file has actually been written.
+
+        @see Options::saveInBackground, saveIfNeeded
+    */
+    void saveInBackground();
+
     /** Returns true if the properties have been altered since the last time they were saved.
         The file is flagged as needing to be saved when you change a value, but you can
         explicitly set this flag with setNeedsToBeSaved().
@@ -232,19 +264,37 @@ protected:
 
 private:
     //==============================================================================
+    class BackgroundWriter;
+    friend class BackgroundWriter;
+
     File file;
     Options options;
     bool loadedOk, needsWriting;
+    uint32 changeCount = 0;
+
+    // These are only used while holding the writeLock
+    CriticalSection writeLock;
+    uint32 lastWrittenChangeCount = 0;
+    StringPairArray lastWrittenProperties;
+    int numRecordsInLog = 0;
+    bool logNeedsRewriting = true;
+
+    ScopedPointer<BackgroundWriter> backgroundWriter;
 
     typedef const ScopedPointer<InterProcessLock::ScopedLockType> ProcessScopedLock;
     InterProcessLock::ScopedLockType* createProcessLock() const;
 
     void timerCallback() override;
-    bool saveAsXml();
-    bool saveAsBinary();
+    void saveAutomatically();
+    bool writeProperties (const StringPairArray&, uint32 changeCountOfProperties);
+    bool saveAsXml (const StringPairArray&);
+    bool saveAsBinary (const StringPairArray&);
+    bool saveAsIncrementalBinary (const StringPairArray&);
+    bool rewriteIncrementalLog (const StringPairArray&);
     bool loadAsXml();
     bool loadAsBinary();
     bool loadAsBinary (InputStream&);
+    bool loadAsIncrementalBinary (InputStream&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PropertiesFile)
 };
@@ -137,14 +137,20 @@ bool UndoManager::perform (UndoableAction* const newAction)
 
             if (actionSet != nullptr && ! newTransaction)
             {
-                if (UndoableAction* const lastAction = actionSet->actions.getLast())
+                for (int i = actionSet->actions.size(); --i >= 0;)
                 {
-                    if (UndoableAction* const coalescedAction = lastAction->createCoalescedAction (action))
+                    auto* previousAction = actionSet->actions.getUnchecked (i);
+
+                    if (auto* coalescedAction = previousAction->createCoalescedAction (action))
                     {
                         action = coalescedAction;
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
+                        totalUnitsStored -= previousAction->getSizeInUnits();
+                        actionSet->actions.remove (i);
+                        break;
                     }
+
+                    if (! previousAction->isIndependentOf (action))
+                        break;
                 }
             }
             else
@@ -45,6 +45,15 @@ namespace juce
     The UndoManager is a ChangeBroadcaster, so listeners can register to be told
     when actions are performed or undone.
 
+    When an action is performed, the manager will try to merge it with an earlier one
+    from the same transaction (see UndoableAction::createCoalescedAction()), so e.g.
+    dragging a slider that's attached to a ValueTree property will only leave one
+    action in the transaction for that property.
+
+    The actions that ValueTree creates report their sizes as an estimate of the number
+    of bytes they're holding onto, so when they're all you're storing, the size limit
+    that you give the constructor is effectively a memory budget in bytes.
+
     @see UndoableAction
 */
 class JUCE_API  UndoManager  : public ChangeBroadcaster
@@ -79,7 +79,11 @@ public:
         can work out how many to keep.
 
         The default value returned here is 10 - units are arbitrary and
-        don't have to be accurate.
+        don't have to be accurate, but the actions that ValueTree creates use
+        an estimate of the number of bytes they're keeping hold of, so if your
+        UndoManager also stores those, it's best to use bytes too.
+
+        The UndoManager assumes that an action will keep returning the same value.
 
         @see UndoManager::getNumberOfUnitsTakenUpByStoredCommands,
              UndoManager::setMaxNumberOfStoredUnits
@@ -94,6 +98,19 @@ public:
         If it's not possible to merge the two actions, the method should return a nullptr.
     */
     virtual UndoableAction* createCoalescedAction (UndoableAction* nextAction)  { ignoreUnused (nextAction); return nullptr; }
+
+    /** Returns true if this action and the one supplied change completely separate things,
+        so that it makes no difference which order they're performed or undone in.
+
+        When a new action can't be coalesced with the last action in the current transaction,
+        the UndoManager will carry on looking back through the transaction for one that it
+        can be coalesced with, as long as every action it skips over is independent of the
+        new one. That means that e.g. a drag that changes two properties in turn will still
+        only leave one action for each property.
+
+        The default implementation returns false, so only consecutive actions get merged.
+    */
+    virtual bool isIndependentOf (UndoableAction* otherAction)  { ignoreUnused (otherAction); return false; }
 };
 
 } // namespace juce
@@ -27,6 +27,88 @@
 namespace juce
 {
 
+/*  The indexed format starts with a header, followed by the nodes, each of which comes
+    after all of its children. Then there's a table of all the Identifiers that were used,
+    and finally a trailer that says where the root node and the table are.
+
+    header:     int32 magic, int32 version
+    node:       compressedInt type, compressedInt numProperties,
+                numProperties * (compressedInt name, var value),
+                compressedInt numChildren, numChildren * int64 childOffset
+    table:      compressedInt numIdentifiers, numIdentifiers * (compressedInt numBytes, utf8 text)
+    trailer:    int64 rootOffset, int64 tableOffset, int32 magic
+
+    All the offsets are relative to the start of the header, and a child always
+    comes before its parent.
+*/
+enum
+{
+    indexedFormatMagic      = 0x58495456, // "VTIX"
+    indexedFormatVersion    = 1,
+    indexedHeaderSize       = 8,
+    indexedTrailerSize      = 20
+};
+
+struct IndexedTreeSource  : public ReferenceCountedObject
+{
+    typedef ReferenceCountedObjectPtr<IndexedTreeSource> Ptr;
+
+    bool initialise (const void* sourceData, size_t sourceSize)
+    {
+        data = static_cast<const uint8*> (sourceData);
+        size = (int64) sourceSize;
+
+        if (data == nullptr || size < indexedHeaderSize + indexedTrailerSize
+             || ByteOrder::littleEndianInt (data) != (uint32) indexedFormatMagic
+             || ByteOrder::littleEndianInt (data + 4) != (uint32) indexedFormatVersion
+             || ByteOrder::littleEndianInt (data + size - 4) != (uint32) indexedFormatMagic)
+            return false;
+
+        rootOffset = (int64) ByteOrder::littleEndianInt64 (data + size - indexedTrailerSize);
+        auto tableOffset = (int64) ByteOrder::littleEndianInt64 (data + size - indexedTrailerSize + 8);
+
+        if (! (isPositiveAndBelow (tableOffset, size - indexedTrailerSize)
+                && isPositiveAndBelow (rootOffset, tableOffset)))
+            return false;
+
+        MemoryInputStream in (getData (tableOffset), getSizeFrom (tableOffset), false);
+        auto numIdentifiers = in.readCompressedInt();
+
+        if (numIdentifiers <= 0)
+            return false;
+
+        identifiers.ensureStorageAllocated (numIdentifiers);
+
+        for (int i = 0; i < numIdentifiers; ++i)
+        {
+            auto numBytes = in.readCompressedInt();
+
+            if (numBytes <= 0 || in.getNumBytesRemaining() < numBytes)
+                return false;
+
+            identifiers.add (String::fromUTF8 (static_cast<const char*> (in.getData()) + in.getPosition(), numBytes));
+            in.skipNextBytes (numBytes);
+        }
+
+        return true;
+    }
+
+    const void* getData (int64 offset) const noexcept       { jassert (isPositiveAndBelow (offset, size)); return data + offset; }
+    size_t getSizeFrom (int64 offset) const noexcept        { return (size_t) (size - offset); }
+
+    const Identifier* getIdentifier (int index) const noexcept
+    {
+        return isPositiveAndBelow (index, identifiers.size()) ? &identifiers.getReference (index) : nullptr;
+    }
+
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    MemoryBlock dataCopy;
+    const uint8* data = nullptr;
+    int64 size = 0, rootOffset = 0;
+    Array<Identifier> identifiers;
+};
+
+//==============================================================================
 class ValueTree::SharedObject  : public ReferenceCountedObject
 {
 public:
@@ -37,7 +119,8 @@ public:
     }
 
     SharedObject (const SharedObject& other)
-        : ReferenceCountedObject(), type (other.type), properties (other.properties)
+        : ReferenceCountedObject(), type (other.type), properties (other.properties),
+          lazySource (other.lazySource), lazyOffset (other.lazyOffset)
     {
         for (int i = 0; i < other.children.size(); ++i)
         {
@@ -45,12 +128,17 @@ public:
             child->parent = this;
             children.add (child);
         }
+
+        if (other.childPropertyIndex != nullptr)
+            setChildIndexProperty (other.childPropertyIndex->property);
     }
 
     ~SharedObject()
     {
         jassert (parent == nullptr); // this should never happen unless something isn't obeying the ref-counting!
 
+        childPropertyIndex = nullptr;
+
         for (int i = children.size(); --i >= 0;)
         {
             const Ptr c (children.getObjectPointerUnchecked(i));
@@ -60,11 +148,236 @@ public:
         }
     }
 
+    //==============================================================================
+    /*  Creates a node that will be decoded from an indexed source when it's first needed.
+        Only its type is read now. Because a child always comes before its parent, the
+        node has to be earlier in the data than its parent, which also means that corrupt
+        data can't make a node contain itself.
+    */
+    static SharedObject* createLazyNode (IndexedTreeSource& source, int64 offset, int64 parentOffset)
+    {
+        if (! isPositiveAndBelow (offset, parentOffset))
+            return nullptr;
+
+        MemoryInputStream in (source.getData (offset), source.getSizeFrom (offset), false);
+
+        if (auto* t = source.getIdentifier (in.readCompressedInt()))
+        {
+            auto node = new SharedObject (*t);
+            node->lazySource = &source;
+            node->lazyOffset = offset;
+            return node;
+        }
+
+        return nullptr;
+    }
+
+    void ensureLoaded() const
+    {
+        if (lazySource != nullptr)
+            const_cast<SharedObject*> (this)->loadFromSource();
+    }
+
+    void loadFromSource()
+    {
+        const IndexedTreeSource::Ptr source (lazySource);
+        lazySource = nullptr;
+
+        MemoryInputStream in (source->getData (lazyOffset), source->getSizeFrom (lazyOffset), false);
+        in.readCompressedInt(); // (the type has already been read)
+
+        for (int i = in.readCompressedInt(); --i >= 0;)
+        {
+            auto* name = source->getIdentifier (in.readCompressedInt());
+
+            if (name == nullptr || in.isExhausted())
+            {
+                jassertfalse;  // trying to read corrupted data!
+                return;
+            }
+
+            properties.set (*name, var::readFromStream (in));
+        }
+
+        auto numChildren = in.readCompressedInt();
+
+        if (numChildren < 0 || in.getNumBytesRemaining() < numChildren * (int64) sizeof (int64))
+        {
+            jassertfalse;  // trying to read corrupted data!
+            return;
+        }
+
+        children.ensureStorageAllocated (numChildren);
+
+        for (int i = 0; i < numChildren; ++i)
+        {
+            auto* child = createLazyNode (*source, in.readInt64(), lazyOffset);
+
+            if (child == nullptr)
+            {
+                jassertfalse;  // trying to read corrupted data!
+                return;
+            }
+
+            children.add (child);
+            child->parent = this;
+        }
+    }
+
+    //==============================================================================
     SharedObject* getRoot() noexcept
     {
         return parent == nullptr ? this : parent->getRoot();
     }
 
+    //==============================================================================
+    /*  The callbacks and undoable actions that a ScopedTransaction is holding back.
+        Property changes (and parent changes) are merged per node, keeping the position
+        of the first one, so that they get delivered once.
+    */
+    struct NotificationBatch
+    {
+        NotificationBatch (UndoManager* um, NotificationBatch* previous) noexcept
+            : undoManager (um), outerBatch (previous)
+        {
+        }
+
+        enum class Type
+        {
+            propertyChanged,
+            childAdded,
+            childRemoved,
+            childOrderChanged,
+            parentChanged
+        };
+
+        struct Notification
+        {
+            Type type;
+            Ptr target, child;
+            Identifier property;
+            ValueTree::Listener* listenerToExclude;
+            int index1, index2;
+        };
+
+        void add (Type type, SharedObject* target, SharedObject* child, int index1 = 0, int index2 = 0)
+        {
+            notifications.add ({ type, target, child, {}, nullptr, index1, index2 });
+        }
+
+        void addMergeable (Type type, SharedObject* target, const Identifier& property,
+                           ValueTree::Listener* listenerToExclude)
+        {
+            auto& existing = mergeableNotifications.getReference (target);
+
+            for (auto i : existing)
+            {
+                auto& n = notifications.getReference (i);
+
+                if (n.type == type && n.property == property)
+                {
+                    if (n.listenerToExclude != listenerToExclude)
+                        n.listenerToExclude = nullptr;
+
+                    return;
+                }
+            }
+
+            existing.add (notifications.size());
+            notifications.add ({ type, target, nullptr, property, listenerToExclude, 0, 0 });
+        }
+
+        void addAction (UndoableAction* newAction)
+        {
+            ScopedPointer<UndoableAction> action (newAction);
+
+            if (action->perform())
+            {
+                // (this looks back for an action to merge with in the same way as the UndoManager)
+                for (int i = actions.size(); --i >= 0;)
+                {
+                    auto* previousAction = actions.getUnchecked (i);
+
+                    if (auto* coalescedAction = previousAction->createCoalescedAction (action))
+                    {
+                        action = coalescedAction;
+                        actions.remove (i);
+                        break;
+                    }
+
+                    if (! previousAction->isIndependentOf (action))
+                        break;
+                }
+
+                actions.add (action.release());
+            }
+        }
+
+        void deliver()
+        {
+            for (auto& n : notifications)
+            {
+                switch (n.type)
+                {
+                    case Type::propertyChanged:     n.target->sendPropertyChangeMessage (n.property, n.listenerToExclude); break;
+                    case Type::childAdded:          n.target->sendChildAddedMessage (ValueTree (n.child)); break;
+                    case Type::childRemoved:        n.target->sendChildRemovedMessage (ValueTree (n.child), n.index1); break;
+                    case Type::childOrderChanged:   n.target->sendChildOrderChangedMessage (n.index1, n.index2); break;
+                    case Type::parentChanged:       n.target->sendParentChangeMessage(); break;
+                    default:                        jassertfalse; break;
+                }
+            }
+        }
+
+        UndoManager* const undoManager;
+        ScopedPointer<NotificationBatch> outerBatch;
+        Array<Notification> notifications;
+        HashMap<const void*, Array<int>> mergeableNotifications;
+        OwnedArray<UndoableAction> actions;
+
+        JUCE_DECLARE_NON_COPYABLE (NotificationBatch)
+    };
+
+    NotificationBatch* findActiveBatch() const noexcept
+    {
+        if (numActiveBatches.get() > 0)
+            for (auto* t = this; t != nullptr; t = t->parent)
+                if (t->activeBatch != nullptr)
+                    return t->activeBatch;
+
+        return nullptr;
+    }
+
+    void beginTransaction (UndoManager* undoManager)
+    {
+        activeBatch = new NotificationBatch (undoManager, activeBatch.release());
+        ++numActiveBatches;
+    }
+
+    void endTransaction (const String& actionName)
+    {
+        ScopedPointer<NotificationBatch> batch (activeBatch.release());
+        activeBatch = batch->outerBatch.release();
+        --numActiveBatches;
+
+        if (batch->undoManager != nullptr && ! batch->actions.isEmpty())
+            performUndoableAction (new TransactionAction (this, batch->actions), batch->undoManager, actionName);
+
+        batch->deliver();
+    }
+
+    void performUndoableAction (UndoableAction* action, UndoManager* undoManager, const String& actionName = {})
+    {
+        // If a transaction is gathering this UndoManager's actions, it gets to keep this one
+        if (numActiveBatches.get() > 0)
+            for (auto* t = this; t != nullptr; t = t->parent)
+                for (auto* b = t->activeBatch.get(); b != nullptr; b = b->outerBatch)
+                    if (b->undoManager == undoManager)
+                        return b->addAction (action);
+
+        undoManager->perform (action, actionName);
+    }
+
     template <typename Function>
     void callListeners (Function fn) const
     {
@@ -97,6 +410,9 @@ public:
 
     void sendPropertyChangeMessage (const Identifier& property, ValueTree::Listener* listenerToExclude = nullptr)
     {
+        if (auto* batch = findActiveBatch())
+            return batch->addMergeable (NotificationBatch::Type::propertyChanged, this, property, listenerToExclude);
+
         ValueTree tree (this);
 
         callListenersForAllParents ([&] (ListenerList<Listener>& list) { list.callExcluding (listenerToExclude, &ValueTree::Listener::valueTreePropertyChanged, tree, property); });
@@ -104,24 +420,36 @@ public:
 
     void sendChildAddedMessage (ValueTree child)
     {
+        if (auto* batch = findActiveBatch())
+            return batch->add (NotificationBatch::Type::childAdded, this, child.object);
+
         ValueTree tree (this);
         callListenersForAllParents ([&] (ListenerList<Listener>& list) { list.call (&ValueTree::Listener::valueTreeChildAdded, tree, child); });
     }
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
+        if (auto* batch = findActiveBatch())
+            return batch->add (NotificationBatch::Type::childRemoved, this, child.object, index);
+
         ValueTree tree (this);
         callListenersForAllParents ([=, &tree, &child] (ListenerList<Listener>& list) { list.call (&ValueTree::Listener::valueTreeChildRemoved, tree, child, index); });
     }
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
+        if (auto* batch = findActiveBatch())
+            return batch->add (NotificationBatch::Type::childOrderChanged, this, nullptr, oldIndex, newIndex);
+
         ValueTree tree (this);
         callListenersForAllParents ([=, &tree] (ListenerList<Listener>& list) { list.call (&ValueTree::Listener::valueTreeChildOrderChanged, tree, oldIndex, newIndex); });
     }
 
     void sendParentChangeMessage()
     {
+        if (auto* batch = findActiveBatch())
+            return batch->addMergeable (NotificationBatch::Type::parentChanged, this, {}, nullptr);
+
         ValueTree tree (this);
 
         for (int j = children.size(); --j >= 0;)
@@ -136,7 +464,17 @@ public:
     {
         if (undoManager == nullptr)
         {
-            if (properties.set (name, newValue))
+            auto* index = getIndexInParent (name);
+
+            if (index != nullptr)
+                index->remove (this);
+
+            const bool changed = properties.set (name, newValue);
+
+            if (index != nullptr)
+                index->add (this);
+
+            if (changed)
                 sendPropertyChangeMessage (name, listenerToExclude);
         }
         else
@@ -144,11 +482,11 @@ public:
             if (auto* existingValue = properties.getVarPointer (name))
             {
                 if (*existingValue != newValue)
-                    undoManager->perform (new SetPropertyAction (this, name, newValue, *existingValue, false, false, listenerToExclude));
+                    performUndoableAction (new SetPropertyAction (this, name, newValue, *existingValue, false, false, listenerToExclude), undoManager);
             }
             else
             {
-                undoManager->perform (new SetPropertyAction (this, name, newValue, {}, true, false, listenerToExclude));
+                performUndoableAction (new SetPropertyAction (this, name, newValue, {}, true, false, listenerToExclude), undoManager);
             }
         }
     }
@@ -162,13 +500,16 @@ public:
     {
         if (undoManager == nullptr)
         {
+            if (auto* index = getIndexInParent (name))
+                index->remove (this);
+
             if (properties.remove (name))
                 sendPropertyChangeMessage (name);
         }
         else
         {
             if (properties.contains (name))
-                undoManager->perform (new SetPropertyAction (this, name, {}, properties [name], false, true));
+                performUndoableAction (new SetPropertyAction (this, name, {}, properties [name], false, true), undoManager);
         }
     }
 
@@ -179,6 +520,10 @@ public:
             while (properties.size() > 0)
             {
                 auto name = properties.getName (properties.size() - 1);
+
+                if (auto* index = getIndexInParent (name))
+                    index->remove (this);
+
                 properties.remove (name);
                 sendPropertyChangeMessage (name);
             }
@@ -186,8 +531,8 @@ public:
         else
         {
             for (int i = properties.size(); --i >= 0;)
-                undoManager->perform (new SetPropertyAction (this, properties.getName(i), {},
-                                                             properties.getValueAt(i), false, true));
+                performUndoableAction (new SetPropertyAction (this, properties.getName(i), {},
+                                                              properties.getValueAt(i), false, true), undoManager);
         }
     }
 
@@ -224,9 +569,31 @@ public:
 
     ValueTree getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
     {
+        if (childPropertyIndex != nullptr && childPropertyIndex->property == propertyName
+             && ! (propertyValue.isVoid() || propertyValue.isUndefined()))
+        {
+            auto* matches = childPropertyIndex->getMatches (propertyValue);
+
+            if (matches == nullptr)
+                return {};
+
+            // If more than one child has this value, we need to search them in order to find the first one
+            if (matches->size() == 1)
+            {
+                auto* s = matches->getFirst();
+
+                if (s->properties[propertyName] == propertyValue)
+                    return ValueTree (s);
+            }
+        }
+
         for (auto* s : children)
+        {
+            s->ensureLoaded();
+
             if (s->properties[propertyName] == propertyValue)
                 return ValueTree (s);
+        }
 
         return {};
     }
@@ -266,6 +633,10 @@ public:
                 {
                     children.insert (index, child);
                     child->parent = this;
+
+                    if (childPropertyIndex != nullptr)
+                        childPropertyIndex->add (child);
+
                     sendChildAddedMessage (ValueTree (child));
                     child->sendParentChangeMessage();
                 }
@@ -274,7 +645,7 @@ public:
                     if (! isPositiveAndBelow (index, children.size()))
                         index = children.size();
 
-                    undoManager->perform (new AddOrRemoveChildAction (this, index, child));
+                    performUndoableAction (new AddOrRemoveChildAction (this, index, child), undoManager);
                 }
             }
             else
@@ -292,6 +663,9 @@ public:
         {
             if (undoManager == nullptr)
             {
+                if (childPropertyIndex != nullptr)
+                    childPropertyIndex->remove (child);
+
                 children.remove (childIndex);
                 child->parent = nullptr;
                 sendChildRemovedMessage (ValueTree (child), childIndex);
@@ -299,7 +673,7 @@ public:
             }
             else
             {
-                undoManager->perform (new AddOrRemoveChildAction (this, childIndex, nullptr));
+                performUndoableAction (new AddOrRemoveChildAction (this, childIndex, nullptr), undoManager);
             }
         }
     }
@@ -328,7 +702,7 @@ public:
                 if (! isPositiveAndBelow (newIndex, children.size()))
                     newIndex = children.size() - 1;
 
-                undoManager->perform (new MoveChildAction (this, currentIndex, newIndex));
+                performUndoableAction (new MoveChildAction (this, currentIndex, newIndex), undoManager);
             }
         }
     }
@@ -350,8 +724,11 @@ public:
         }
     }
 
-    bool isEquivalentTo (const SharedObject& other) const noexcept
+    bool isEquivalentTo (const SharedObject& other) const
     {
+        ensureLoaded();
+        other.ensureLoaded();
+
         if (type != other.type
              || properties.size() != other.properties.size()
              || children.size() != other.children.size()
@@ -367,6 +744,7 @@ public:
 
     XmlElement* createXml() const
     {
+        ensureLoaded();
         auto xml = new XmlElement (type);
         properties.copyToXmlAttributes (*xml);
 
@@ -379,6 +757,7 @@ public:
 
     void writeToStream (OutputStream& output) const
     {
+        ensureLoaded();
         output.writeString (type.toString());
         output.writeCompressedInt (properties.size());
 
@@ -408,6 +787,50 @@ public:
         }
     }
 
+    // A rough estimate of the memory that this object and its children are using,
+    // which the undoable actions use to report their sizes to the UndoManager
+    int getApproximateSizeInBytes() const
+    {
+        auto total = (int) sizeof (*this);
+
+        for (int i = 0; i < properties.size(); ++i)
+            total += (int) sizeof (NamedValueSet::NamedValue) + getApproximateSizeInBytes (properties.getValueAt (i));
+
+        for (auto* c : children)
+            total += c->getApproximateSizeInBytes();
+
+        return total;
+    }
+
+    static int getApproximateSizeInBytes (const var& v)
+    {
+        if (v.isString())       return (int) v.toString().getNumBytesAsUTF8() + 16;
+        if (v.isBinaryData())   return (int) v.getBinaryData()->getSize() + (int) sizeof (MemoryBlock);
+
+        if (auto* array = v.getArray())
+        {
+            auto total = (int) (array->size() * sizeof (var));
+
+            for (auto& element : *array)
+                total += getApproximateSizeInBytes (element);
+
+            return total;
+        }
+
+        if (auto* object = v.getDynamicObject())
+        {
+            auto& objectProperties = object->getProperties();
+            auto total = (int) sizeof (DynamicObject);
+
+            for (int i = 0; i < objectProperties.size(); ++i)
+                total += (int) sizeof (NamedValueSet::NamedValue) + getApproximateSizeInBytes (objectProperties.getValueAt (i));
+
+            return total;
+        }
+
+        return 0;
+    }
+
     //==============================================================================
     struct SetPropertyAction  : public UndoableAction
     {
@@ -416,7 +839,8 @@ public:
                            ValueTree::Listener* listenerToExclude = nullptr)
             : target (so), name (propertyName), newValue (newVal), oldValue (oldVal),
               isAddingNewProperty (isAdding), isDeletingProperty (isDeleting),
-              excludeListener (listenerToExclude)
+              excludeListener (listenerToExclude),
+              sizeInBytes ((int) sizeof (*this) + getApproximateSizeInBytes (newVal) + getApproximateSizeInBytes (oldVal))
         {
         }
 
@@ -444,22 +868,30 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return sizeInBytes;
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
         {
-            if (! (isAddingNewProperty || isDeletingProperty))
+            if (! isDeletingProperty)
             {
-                if (SetPropertyAction* const next = dynamic_cast<SetPropertyAction*> (nextAction))
+                if (auto* next = dynamic_cast<SetPropertyAction*> (nextAction))
                     if (next->target == target && next->name == name
                           && ! (next->isAddingNewProperty || next->isDeletingProperty))
-                        return new SetPropertyAction (target, name, next->newValue, oldValue, false, false);
+                        return new SetPropertyAction (target, name, next->newValue, oldValue, isAddingNewProperty, false);
             }
 
             return nullptr;
         }
 
+        bool isIndependentOf (UndoableAction* otherAction) override
+        {
+            if (auto* other = dynamic_cast<SetPropertyAction*> (otherAction))
+                return other->target != target || other->name != name;
+
+            return false;
+        }
+
     private:
         const Ptr target;
         const Identifier name;
@@ -467,6 +899,7 @@ public:
         var oldValue;
         const bool isAddingNewProperty : 1, isDeletingProperty : 1;
         ValueTree::Listener* excludeListener;
+        const int sizeInBytes;
 
         JUCE_DECLARE_NON_COPYABLE (SetPropertyAction)
     };
@@ -478,7 +911,8 @@ public:
             : target (parentObject),
               child (newChild != nullptr ? newChild : parentObject->children.getObjectPointer (index)),
               childIndex (index),
-              isDeleting (newChild == nullptr)
+              isDeleting (newChild == nullptr),
+              sizeInBytes ((int) sizeof (*this) + (child != nullptr ? child->getApproximateSizeInBytes() : 0))
         {
             jassert (child != nullptr);
         }
@@ -512,13 +946,14 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return sizeInBytes;
         }
 
     private:
         const Ptr target, child;
         const int childIndex;
         const bool isDeleting;
+        const int sizeInBytes;
 
         JUCE_DECLARE_NON_COPYABLE (AddOrRemoveChildAction)
     };
@@ -564,18 +999,161 @@ public:
         JUCE_DECLARE_NON_COPYABLE (MoveChildAction)
     };
 
+    //==============================================================================
+    /*  The actions gathered by a ScopedTransaction. These have all been performed by the
+        time that this is given to the UndoManager, so its first perform() does nothing.
+    */
+    struct TransactionAction  : public UndoableAction
+    {
+        TransactionAction (SharedObject* so, OwnedArray<UndoableAction>& performedActions)
+            : target (so)
+        {
+            actions.swapWith (performedActions);
+        }
+
+        bool perform() override
+        {
+            if (! isPerformed)
+            {
+                target->beginTransaction (nullptr);
+
+                for (auto* a : actions)
+                    a->perform();
+
+                target->endTransaction ({});
+                isPerformed = true;
+            }
+
+            return true;
+        }
+
+        bool undo() override
+        {
+            target->beginTransaction (nullptr);
+
+            for (int i = actions.size(); --i >= 0;)
+                actions.getUnchecked (i)->undo();
+
+            target->endTransaction ({});
+            isPerformed = false;
+            return true;
+        }
+
+        int getSizeInUnits() override
+        {
+            int total = 0;
+
+            for (auto* a : actions)
+                total += a->getSizeInUnits();
+
+            return total;
+        }
+
+    private:
+        const Ptr target;
+        OwnedArray<UndoableAction> actions;
+        bool isPerformed = true;
+
+        JUCE_DECLARE_NON_COPYABLE (TransactionAction)
+    };
+
+    //==============================================================================
+    /*  A hash table of the children, keyed on the value of one of their properties.
+        The values are hashed by their string representation.
+    */
+    struct ChildIndex
+    {
+        ChildIndex (const Identifier& p) noexcept  : property (p) {}
+
+        void add (SharedObject* child)
+        {
+            child->ensureLoaded();
+
+            if (auto* v = child->properties.getVarPointer (property))
+                childrenWithValue.getReference (v->toString()).add (child);
+        }
+
+        void remove (SharedObject* child)
+        {
+            child->ensureLoaded();
+
+            if (auto* v = child->properties.getVarPointer (property))
+            {
+                auto key = v->toString();
+
+                if (childrenWithValue.contains (key))
+                {
+                    auto& matches = childrenWithValue.getReference (key);
+                    matches.removeFirstMatchingValue (child);
+
+                    if (matches.isEmpty())
+                        childrenWithValue.remove (key);
+                }
+            }
+        }
+
+        const Array<SharedObject*>* getMatches (const var& value)
+        {
+            auto key = value.toString();
+
+            if (childrenWithValue.contains (key))
+                return &childrenWithValue.getReference (key);
+
+            return nullptr;
+        }
+
+        const Identifier property;
+        HashMap<String, Array<SharedObject*>> childrenWithValue;
+
+        JUCE_DECLARE_NON_COPYABLE (ChildIndex)
+    };
+
+    void setChildIndexProperty (const Identifier& propertyName)
+    {
+        if (propertyName.isNull())
+        {
+            childPropertyIndex = nullptr;
+        }
+        else if (childPropertyIndex == nullptr || childPropertyIndex->property != propertyName)
+        {
+            childPropertyIndex = new ChildIndex (propertyName);
+
+            for (auto* c : children)
+                childPropertyIndex->add (c);
+        }
+    }
+
+    ChildIndex* getIndexInParent (const Identifier& propertyName) const noexcept
+    {
+        if (parent != nullptr && parent->childPropertyIndex != nullptr && parent->childPropertyIndex->property == propertyName)
+            return parent->childPropertyIndex;
+
+        return nullptr;
+    }
+
     //==============================================================================
     const Identifier type;
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent = nullptr;
+    ScopedPointer<ChildIndex> childPropertyIndex;
+
+    // if this isn't null, the node's properties and children haven't been decoded yet
+    IndexedTreeSource::Ptr lazySource;
+    int64 lazyOffset = 0;
+
+    // the callbacks being held back by any ScopedTransactions for this node
+    ScopedPointer<NotificationBatch> activeBatch;
+    static Atomic<int> numActiveBatches;
 
 private:
     SharedObject& operator= (const SharedObject&);
     JUCE_LEAK_DETECTOR (SharedObject)
 };
 
+Atomic<int> ValueTree::SharedObject::numActiveBatches;
+
 //==============================================================================
 ValueTree::ValueTree() noexcept
 {
@@ -590,8 +1168,10 @@ ValueTree::ValueTree (const Identifier& type)  : object (new ValueTree::SharedOb
     jassert (type.toString().isNotEmpty()); // All objects must be given a sensible type name!
 }
 
-ValueTree::ValueTree (SharedObject* so) noexcept  : object (so)
+ValueTree::ValueTree (SharedObject* so)  : object (so)
 {
+    if (so != nullptr)
+        so->ensureLoaded();
 }
 
 ValueTree::ValueTree (const ValueTree& other) noexcept  : object (other.object)
@@ -872,6 +1452,20 @@ ValueTree ValueTree::getChildWithProperty (const Identifier& propertyName, const
     return object != nullptr ? object->getChildWithProperty (propertyName, propertyValue) : ValueTree();
 }
 
+void ValueTree::setChildIndexProperty (const Identifier& propertyName)
+{
+    if (object != nullptr)
+        object->setChildIndexProperty (propertyName);
+}
+
+Identifier ValueTree::getChildIndexProperty() const
+{
+    if (object != nullptr && object->childPropertyIndex != nullptr)
+        return object->childPropertyIndex->property;
+
+    return {};
+}
+
 bool ValueTree::isAChildOf (const ValueTree& possibleParent) const noexcept
 {
     return object != nullptr && object->isAChildOf (possibleParent.object);
@@ -955,6 +1549,20 @@ void ValueTree::sendPropertyChangeMessage (const Identifier& property)
         object->sendPropertyChangeMessage (property);
 }
 
+//==============================================================================
+ValueTree::ScopedTransaction::ScopedTransaction (const ValueTree& t, UndoManager* undoManager, const String& name)
+    : tree (t), actionName (name)
+{
+    if (tree.object != nullptr)
+        tree.object->beginTransaction (undoManager);
+}
+
+ValueTree::ScopedTransaction::~ScopedTransaction()
+{
+    if (tree.object != nullptr)
+        tree.object->endTransaction (actionName);
+}
+
 //==============================================================================
 XmlElement* ValueTree::createXml() const
 {
@@ -1053,6 +1661,170 @@ ValueTree ValueTree::readFromGZIPData (const void* const data, const size_t numB
     return readFromStream (gzipStream);
 }
 
+//==============================================================================
+void ValueTree::writeToIndexedStream (OutputStream& output) const
+{
+    IndexedWriter writer (output);
+    writer.writeSubtree (*this);
+    writer.finish();
+}
+
+ValueTree ValueTree::readFromIndexedData (const void* data, size_t numBytes)
+{
+    const IndexedTreeSource::Ptr source (new IndexedTreeSource());
+    source->dataCopy.append (data, numBytes);
+
+    if (source->initialise (source->dataCopy.getData(), source->dataCopy.getSize()))
+        return ValueTree (SharedObject::createLazyNode (*source, source->rootOffset, source->size));
+
+    return {};
+}
+
+ValueTree ValueTree::readFromIndexedFile (const File& file)
+{
+    const IndexedTreeSource::Ptr source (new IndexedTreeSource());
+    source->mappedFile = new MemoryMappedFile (file, MemoryMappedFile::readOnly);
+
+    if (source->initialise (source->mappedFile->getData(), source->mappedFile->getSize()))
+        return ValueTree (SharedObject::createLazyNode (*source, source->rootOffset, source->size));
+
+    return {};
+}
+
+//==============================================================================
+ValueTree::IndexedWriter::IndexedWriter (OutputStream& destStream)
+    : output (destStream), startPosition (destStream.getPosition())
+{
+    output.writeInt (indexedFormatMagic);
+    output.writeInt (indexedFormatVersion);
+}
+
+ValueTree::IndexedWriter::~IndexedWriter()
+{
+    finish();
+}
+
+void ValueTree::IndexedWriter::beginNode (const Identifier& type, const NamedValueSet& properties)
+{
+    jassert (! finished);
+    jassert (type.isValid()); // All objects must be given a sensible type name!
+
+    openNodes.add (new OpenNode { type, properties, {} });
+}
+
+void ValueTree::IndexedWriter::endNode()
+{
+    // This must match a call to beginNode()!
+    jassert (openNodes.size() > 0);
+
+    if (auto* node = openNodes.getLast())
+    {
+        auto offset = writeNode (node->type, node->properties, node->childOffsets);
+        openNodes.removeLast();
+        addNode (offset);
+    }
+}
+
+void ValueTree::IndexedWriter::writeSubtree (const ValueTree& tree)
+{
+    jassert (! finished);
+    jassert (tree.isValid());
+
+    if (tree.isValid())
+        addNode (writeTree (tree));
+}
+
+void ValueTree::IndexedWriter::finish()
+{
+    if (finished)
+        return;
+
+    // All the nodes must have been closed, and a root must have been written!
+    jassert (openNodes.isEmpty() && rootOffset >= 0);
+
+    while (openNodes.size() > 0)
+        endNode();
+
+    finished = true;
+
+    if (rootOffset < 0)
+        return;
+
+    auto tableOffset = output.getPosition() - startPosition;
+    output.writeCompressedInt (identifiers.size());
+
+    for (auto& i : identifiers)
+    {
+        auto text = i.toString().toUTF8();
+        auto numBytes = (int) text.sizeInBytes() - 1;
+
+        output.writeCompressedInt (numBytes);
+        output.write (text.getAddress(), (size_t) numBytes);
+    }
+
+    output.writeInt64 (rootOffset);
+    output.writeInt64 (tableOffset);
+    output.writeInt (indexedFormatMagic);
+    output.flush();
+}
+
+int ValueTree::IndexedWriter::getIdentifierIndex (const Identifier& name)
+{
+    if (auto* index = identifierIndexes.getVarPointer (name))
+        return *index;
+
+    identifierIndexes.set (name, identifiers.size());
+    identifiers.add (name);
+    return identifiers.size() - 1;
+}
+
+int64 ValueTree::IndexedWriter::writeNode (const Identifier& type, const NamedValueSet& properties,
+                                           const Array<int64>& childOffsets)
+{
+    auto offset = output.getPosition() - startPosition;
+
+    output.writeCompressedInt (getIdentifierIndex (type));
+    output.writeCompressedInt (properties.size());
+
+    for (int i = 0; i < properties.size(); ++i)
+    {
+        output.writeCompressedInt (getIdentifierIndex (properties.getName (i)));
+        properties.getValueAt (i).writeToStream (output);
+    }
+
+    output.writeCompressedInt (childOffsets.size());
+
+    for (auto childOffset : childOffsets)
+        output.writeInt64 (childOffset);
+
+    return offset;
+}
+
+int64 ValueTree::IndexedWriter::writeTree (const ValueTree& tree)
+{
+    Array<int64> childOffsets;
+    childOffsets.ensureStorageAllocated (tree.getNumChildren());
+
+    for (auto* child : tree.object->children)
+        childOffsets.add (writeTree (ValueTree (child)));
+
+    return writeNode (tree.object->type, tree.object->properties, childOffsets);
+}
+
+void ValueTree::IndexedWriter::addNode (int64 offset)
+{
+    if (auto* parent = openNodes.getLast())
+    {
+        parent->childOffsets.add (offset);
+    }
+    else
+    {
+        // Only one root node can be written!
+        jassert (rootOffset < 0);
+        rootOffset = offset;
+    }
+}
+
 void ValueTree::Listener::valueTreeRedirected (ValueTree&) {}
 
 //==============================================================================
@@ -1120,6 +1892,19 @@ public:
         return v;
     }
 
+    struct CountingListener  : public ValueTree::Listener
+    {
+        void valueTreePropertyChanged (ValueTree&, const Identifier&) override   { ++numPropertyChanges; }
+        void valueTreeChildAdded (ValueTree&, ValueTree&) override               { ++numChildrenAdded; }
+        void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override        { ++numChildrenRemoved; }
+        void valueTreeChildOrderChanged (ValueTree&, int, int) override          {}
+        void valueTreeParentChanged (ValueTree&) override                        {}
+
+        int getTotal() const noexcept   { return numPropertyChanges + numChildrenAdded + numChildrenRemoved; }
+
+        int numPropertyChanges = 0, numChildrenAdded = 0, numChildrenRemoved = 0;
+    };
+
     void runTest() override
     {
         beginTest ("ValueTree");
@@ -1142,6 +1927,234 @@ public:
             ValueTree v4 = v2.createCopy();
             expect (v1.isEquivalentTo (v4));
         }
+
+        beginTest ("Indexed binary format");
+        {
+            for (int i = 10; --i >= 0;)
+            {
+                ValueTree v1 (createRandomTree (nullptr, 0, r));
+                MemoryOutputStream mo;
+                v1.writeToIndexedStream (mo);
+
+                auto v2 = ValueTree::readFromIndexedData (mo.getData(), mo.getDataSize());
+                expect (v2.createCopy().isEquivalentTo (v1));
+                expect (v2.isEquivalentTo (v1));
+
+                auto truncated = ValueTree::readFromIndexedData (mo.getData(), mo.getDataSize() - 1);
+                expect (! truncated.isValid());
+            }
+
+            ValueTree a (createRandomTree (nullptr, 0, r)), b (createRandomTree (nullptr, 0, r));
+            NamedValueSet properties;
+            properties.set ("version", 3);
+
+            auto file = File::createTempFile ("indexed");
+            {
+                FileOutputStream out (file);
+                ValueTree::IndexedWriter writer (out);
+                writer.beginNode ("root", properties);
+                writer.writeSubtree (a);
+                writer.beginNode ("group");
+                writer.writeSubtree (b);
+                writer.endNode();
+                writer.endNode();
+                writer.finish();
+            }
+
+            {
+                auto loaded = ValueTree::readFromIndexedFile (file);
+                expect (loaded.hasType ("root"));
+                expect (loaded["version"] == var (3));
+                expectEquals (loaded.getNumChildren(), 2);
+                expect (loaded.getChild (0).isEquivalentTo (a));
+                expect (loaded.getChild (1).hasType ("group"));
+                expect (loaded.getChild (1).getChild (0).isEquivalentTo (b));
+
+                loaded.getChild (0).setProperty ("edited", true, nullptr);
+                expect (loaded.getChild (0)["edited"] == var (true));
+            }
+
+            file.deleteFile();
+
+            const char garbage[] = "this isn't a valid tree, in any format at all";
+            expect (! ValueTree::readFromIndexedData (garbage, sizeof (garbage)).isValid());
+        }
+
+        beginTest ("Child index");
+        {
+            const Identifier item ("item"), id ("id");
+            UndoManager undoManager;
+            ValueTree root ("root");
+
+            for (int i = 0; i < 200; ++i)
+                root.addChild (ValueTree (item).setProperty (id, i % 150, nullptr), -1, nullptr);
+
+            root.setChildIndexProperty (id);
+            expect (root.getChildIndexProperty() == id);
+
+            auto findLinearly = [&] (const ValueTree& parent, const var& value)
+            {
+                for (int i = 0; i < parent.getNumChildren(); ++i)
+                    if (parent.getChild (i)[id] == value)
+                        return parent.getChild (i);
+
+                return ValueTree();
+            };
+
+            auto checkAll = [&] (const ValueTree& parent)
+            {
+                for (int i = -1; i < 260; ++i)
+                {
+                    const var value (i);
+                    expect (parent.getChildWithProperty (id, value) == findLinearly (parent, value));
+                }
+            };
+
+            checkAll (root);
+
+            for (int i = 0; i < 300; ++i)
+            {
+                auto numChildren = root.getNumChildren();
+
+                switch (r.nextInt (6))
+                {
+                    case 0:  root.addChild (ValueTree (item).setProperty (id, r.nextInt (250), nullptr), r.nextInt (numChildren + 1), &undoManager); break;
+                    case 1:  if (numChildren > 0) root.removeChild (r.nextInt (numChildren), &undoManager); break;
+                    case 2:  if (numChildren > 0) root.getChild (r.nextInt (numChildren)).setProperty (id, r.nextInt (250), &undoManager); break;
+                    case 3:  if (numChildren > 0) root.getChild (r.nextInt (numChildren)).removeProperty (id, &undoManager); break;
+                    case 4:  if (numChildren > 1) root.moveChild (r.nextInt (numChildren), r.nextInt (numChildren), &undoManager); break;
+                    case 5:  undoManager.beginNewTransaction(); undoManager.undo(); break;
+                    default: break;
+                }
+            }
+
+            checkAll (root);
+
+            auto copy = root.createCopy();
+            expect (copy.getChildIndexProperty() == id);
+            checkAll (copy);
+
+            root.removeAllChildren (nullptr);
+            expect (! root.getChildWithProperty (id, 1).isValid());
+
+            root.setChildIndexProperty ({});
+            expect (root.getChildIndexProperty().isNull());
+        }
+
+        beginTest ("Transactions");
+        {
+            const Identifier id ("value");
+            ValueTree root ("root");
+            CountingListener listener;
+            root.addListener (&listener);
+
+            {
+                ValueTree::ScopedTransaction transaction (root);
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    ValueTree child ("child");
+                    root.addChild (child, -1, nullptr);
+
+                    for (int j = 0; j < 10; ++j)
+                    {
+                        child.setProperty (id, j, nullptr);
+                        root.setProperty (id, j, nullptr);
+                    }
+                }
+
+                expectEquals (listener.getTotal(), 0);
+                expectEquals (root.getNumChildren(), 10);
+                expectEquals ((int) root.getChild (9)[id], 9);
+            }
+
+            expectEquals (listener.numChildrenAdded, 10);
+            expectEquals (listener.numPropertyChanges, 11);
+
+            UndoManager undoManager;
+            listener = {};
+
+            {
+                ValueTree::ScopedTransaction outer (root, &undoManager, "Outer");
+                root.removeChild (0, &undoManager);
+
+                {
+                    ValueTree::ScopedTransaction inner (root.getChild (0), &undoManager);
+
+                    for (int j = 0; j < 5; ++j)
+                        root.getChild (0).setProperty (id, 100 + j, &undoManager);
+                }
+
+                expectEquals (listener.getTotal(), 0);
+                root.setProperty (id, "x", &undoManager);
+            }
+
+            expectEquals (listener.numChildrenRemoved, 1);
+            expectEquals (listener.numPropertyChanges, 2);
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 1);
+            expect (undoManager.getUndoDescription() == "Outer");
+
+            listener = {};
+            expect (undoManager.undo());
+
+            expectEquals (root.getNumChildren(), 10);
+            expectEquals ((int) root[id], 9);
+            expectEquals ((int) root.getChild (1)[id], 9);
+            expectEquals (listener.numChildrenAdded, 1);
+            expectEquals (listener.numPropertyChanges, 2);
+
+            expect (undoManager.redo());
+
+            expectEquals (root.getNumChildren(), 9);
+            expectEquals ((int) root.getChild (0)[id], 104);
+            expect (root[id] == var ("x"));
+
+            root.removeListener (&listener);
+        }
+
+        beginTest ("Coalescing undoable property changes");
+        {
+            const Identifier x ("x"), y ("y"), other ("other");
+            ValueTree v ("test");
+            v.setProperty (x, 0, nullptr);
+            UndoManager undoManager;
+
+            undoManager.beginNewTransaction();
+
+            for (int i = 1; i <= 100; ++i)
+            {
+                v.setProperty (x, i, &undoManager);
+                v.setProperty (y, i * 2, &undoManager);
+            }
+
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 2);
+
+            v.addChild (ValueTree ("child"), -1, &undoManager);
+            v.setProperty (x, 1000, &undoManager);
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 4);
+
+            expect (undoManager.undo());
+            expectEquals ((int) v[x], 0);
+            expect (! v.hasProperty (y));
+            expectEquals (v.getNumChildren(), 0);
+
+            expect (undoManager.redo());
+            expectEquals ((int) v[x], 1000);
+            expectEquals ((int) v[y], 200);
+            expectEquals (v.getNumChildren(), 1);
+
+            auto sizeBefore = undoManager.getNumberOfUnitsTakenUpByStoredCommands();
+            undoManager.beginNewTransaction();
+            v.setProperty (other, String::repeatedString ("x", 10000), &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() > sizeBefore + 10000);
+
+            undoManager.setMaxNumberOfStoredUnits (5000, 1);
+            undoManager.beginNewTransaction();
+            v.setProperty (x, 0, &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() < 5000);
+            expect (undoManager.undo());
+            expect (! undoManager.canUndo());
+        }
     }
 };
 
@@ -256,6 +256,32 @@ public:
     */
     ValueTree getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
 
+    /** Makes this node keep a hash table of its children, keyed on the value of the given property.
+
+        Once this is set, getChildWithProperty() can find a child by the value of that property
+        without having to search through all the children, which makes a big difference for
+        nodes that have thousands of them, e.g. when looking up items by an ID. The table is
+        kept up to date as children are added and removed, and as their values for this
+        property change.
+
+        The values are compared using their string representation, so the indexed lookup may
+        not find children whose values are only loosely equal, e.g. 1 and 1.0. If several
+        children share the same value, the first one is still returned.
+
+        The index belongs to this node rather than to this ValueTree object, so it's used by
+        all the ValueTrees that refer to the node, and by copies made with createCopy(). It
+        isn't saved with the tree, and isn't affected by undo. Pass an empty Identifier to
+        remove the index.
+
+        @see getChildWithProperty
+    */
+    void setChildIndexProperty (const Identifier& propertyName);
+
+    /** Returns the property that was passed to setChildIndexProperty(), or an empty
+        Identifier if this node doesn't keep an index of its children.
+    */
+    Identifier getChildIndexProperty() const;
+
     /** Adds a child to this node.
 
         Make sure that the child is removed from any former parent node before calling this, or
@@ -395,6 +421,116 @@ public:
     */
     static ValueTree readFromGZIPData (const void* data, size_t numBytes);
 
+    //==============================================================================
+    /** Stores this tree (and all its children) in an indexed binary format, which can
+        be loaded lazily with readFromIndexedData() or readFromIndexedFile().
+
+        Unlike writeToStream(), this format is versioned, stores each Identifier only
+        once, and records where each node's children are, so that a reader can go
+        straight to the parts of the tree that it needs without decoding the rest.
+
+        Each node is written as soon as its children have been written, so the stream
+        doesn't need to be seekable, and nothing is buffered.
+
+        @see IndexedWriter, readFromIndexedData, readFromIndexedFile
+    */
+    void writeToIndexedStream (OutputStream& output) const;
+
+    /** Loads a tree that was written with writeToIndexedStream() or an IndexedWriter.
+
+        Only the root node is decoded straight away. Every other node is decoded the first
+        time you get a ValueTree that refers to it, so opening a big document is quick, and
+        parts of it that are never looked at don't use up memory.
+
+        The data is copied, so the block can be deleted once this returns. If the data isn't
+        in the right format, this returns an invalid tree.
+    */
+    static ValueTree readFromIndexedData (const void* data, size_t numBytes);
+
+    /** Memory-maps a file that was written with writeToIndexedStream() or an IndexedWriter,
+        and loads it lazily in the same way as readFromIndexedData().
+
+        Nothing is copied out of the file until it's needed, and the file stays mapped until
+        all of its nodes have either been decoded or deleted, so it mustn't be modified while
+        the tree is in use. If the file can't be opened or isn't in the right format, this
+        returns an invalid tree.
+    */
+    static ValueTree readFromIndexedFile (const File& file);
+
+    //==============================================================================
+    /** Writes a tree in the indexed binary format, one piece at a time.
+
+        This lets you save a document without first building all of it as one ValueTree:
+        open a node with beginNode(), add its children with writeSubtree() or with nested
+        beginNode()/endNode() calls, and then close it with endNode(). Each subtree is
+        written to the stream as soon as it's passed in, so it can be thrown away again
+        straight afterwards.
+
+        @code
+        ValueTree::IndexedWriter writer (stream);
+        writer.beginNode ("SESSION", sessionProperties);
+
+        for (auto* track : tracks)
+            writer.writeSubtree (track->createState());
+
+        writer.endNode();
+        writer.finish();
+        @endcode
+
+        @see writeToIndexedStream, readFromIndexedData, readFromIndexedFile
+    */
+    class JUCE_API  IndexedWriter
+    {
+    public:
+        /** Creates a writer that writes to a stream, starting at its current position.
+            The stream must stay valid for the lifetime of the writer.
+        */
+        IndexedWriter (OutputStream& destStream);
+
+        /** Destructor. This will call finish() if it hasn't already been called. */
+        ~IndexedWriter();
+
+        /** Opens a node. Everything written until the matching endNode() becomes its children. */
+        void beginNode (const Identifier& type, const NamedValueSet& properties = {});
+
+        /** Closes the node that was opened by the last call to beginNode(). */
+        void endNode();
+
+        /** Writes a complete tree as a child of the currently open node, or as the root
+            if there are no open nodes.
+        */
+        void writeSubtree (const ValueTree& tree);
+
+        /** Writes the end of the data, after which nothing else can be added.
+            By this point, exactly one root node must have been written, and every node
+            opened with beginNode() must have been closed.
+        */
+        void finish();
+
+    private:
+        struct OpenNode
+        {
+            Identifier type;
+            NamedValueSet properties;
+            Array<int64> childOffsets;
+        };
+
+        OutputStream& output;
+        const int64 startPosition;
+        OwnedArray<OpenNode> openNodes;
+        Array<Identifier> identifiers;
+        NamedValueSet identifierIndexes;
+        int64 rootOffset = -1;
+        bool finished = false;
+
+        int getIdentifierIndex (const Identifier&);
+        int64 writeNode (const Identifier&, const NamedValueSet&, const Array<int64>& childOffsets);
+        int64 writeTree (const ValueTree&);
+        void addNode (int64 offset);
+
+        JUCE_DECLARE_NON_COPYABLE (IndexedWriter)
+    };
+
     //==============================================================================
     /** Listener class for events that happen to a ValueTree.
 
@@ -498,6 +634,12 @@ public:
     */
     void sendPropertyChangeMessage (const Identifier& property);
 
+    //==============================================================================
+    /** Delays and merges the listener callbacks for a tree, and optionally its undoable
+        actions, while it's being changed. See the class description for details.
+    */
+    class ScopedTransaction;
+
     //==============================================================================
     /** This method uses a comparator object to sort the tree's children into order.
 
@@ -572,7 +714,62 @@ private:
     void createListOfChildren (OwnedArray<ValueTree>&) const;
     void reorderChildren (const OwnedArray<ValueTree>&, UndoManager*);
 
-    explicit ValueTree (SharedObject*) noexcept;
+    explicit ValueTree (SharedObject*);
+};
+
+//==============================================================================
+/** Holds back and merges the listener callbacks for a tree while it's being changed.
+
+    While one of these exists, any changes made to the tree that it was created for (or
+    to any of its sub-trees) won't call their listeners straight away. Instead, the
+    callbacks are stored, and delivered in the order they happened when the object is
+    deleted. Repeated changes to the same property of the same node are merged, so
+    that each listener only hears about each changed property once, however many times
+    it was actually set.
+
+    This makes it much cheaper to make large numbers of changes, e.g.
+    @code
+    {
+        ValueTree::ScopedTransaction transaction (tree, &undoManager, "Import");
+
+        for (auto& item : itemsToImport)
+            tree.addChild (item.createTree(), -1, &undoManager);
+    } // the listeners are called here
+    @endcode
+
+    If you supply an UndoManager, all the changes that are made with that UndoManager
+    while the transaction exists are performed straight away, but are then added to it
+    as a single action, so that they'll be undone and redone in one step (and when they
+    are, their callbacks are merged too).
+
+    Transactions can be nested. When an inner one finishes while an outer one is still
+    active, its callbacks and its undoable action are handed on to the outer one.
+
+    Note that the tree's data is always up to date - only the callbacks are delayed.
+*/
+class JUCE_API  ValueTree::ScopedTransaction
+{
+public:
+    /** Starts a transaction for the given tree and all its sub-trees.
+
+        @param tree         the tree whose callbacks should be held back
+        @param undoManager  if this isn't null, the undoable changes made with this
+                            UndoManager will be merged into a single action
+        @param actionName   if this isn't empty, it'll be used as the name of the
+                            UndoManager transaction that the action is added to
+    */
+    ScopedTransaction (const ValueTree& tree,
+                       UndoManager* undoManager = nullptr,
+                       const String& actionName = String());
+
+    /** Destructor. This delivers all the callbacks that were held back. */
+    ~ScopedTransaction();
+
+private:
+    ValueTree tree;
+    String actionName;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedTransaction)
 };
 
 } // namespace juce
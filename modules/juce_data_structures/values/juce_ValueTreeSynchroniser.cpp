@@ -36,7 +36,8 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        changeBatch      = 7
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -72,10 +73,8 @@ namespace ValueTreeSynchroniserHelpers
             stream.writeCompressedInt (path.getUnchecked(i));
     }
 
-    static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
+    static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v, int numLevels)
     {
-        const int numLevels = input.readCompressedInt();
-
         if (! isPositiveAndBelow (numLevels, 65536)) // sanity-check
             return {};
 
@@ -91,8 +90,252 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
+    {
+        return readSubTreeLocation (input, v, input.readCompressedInt());
+    }
+
+    static Identifier readPropertyName (MemoryInputStream& input, const Array<Identifier>* identifiers)
+    {
+        if (identifiers == nullptr)
+            return Identifier (input.readString());
+
+        const int index = input.readCompressedInt();
+        return isPositiveAndBelow (index, identifiers->size()) ? identifiers->getReference (index) : Identifier();
+    }
+
+    static bool applyChangeToTree (ValueTree& v, ChangeType type, MemoryInputStream& input,
+                                   const Array<Identifier>* identifiers, UndoManager* undoManager)
+    {
+        switch (type)
+        {
+            case propertyChanged:
+            {
+                Identifier property (readPropertyName (input, identifiers));
+
+                if (property.isNull())
+                    break;
+
+                v.setProperty (property, var::readFromStream (input), undoManager);
+                return true;
+            }
+
+            case propertyRemoved:
+            {
+                Identifier property (readPropertyName (input, identifiers));
+
+                if (property.isNull())
+                    break;
+
+                v.removeProperty (property, undoManager);
+                return true;
+            }
+
+            case childAdded:
+            {
+                const int index = input.readCompressedInt();
+                v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                return true;
+            }
+
+            case childRemoved:
+            {
+                const int index = input.readCompressedInt();
+
+                if (isPositiveAndBelow (index, v.getNumChildren()))
+                {
+                    v.removeChild (index, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                return false;
+            }
+
+            case childMoved:
+            {
+                const int oldIndex = input.readCompressedInt();
+                const int newIndex = input.readCompressedInt();
+
+                if (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                     && isPositiveAndBelow (newIndex, v.getNumChildren()))
+                {
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                return false;
+            }
+
+            default:
+                break;
+        }
+
+        jassertfalse; // Seem to have received some corrupt data?
+        return false;
+    }
+
+    /*  A batch message holds a table of the property names that it uses, followed by the
+        changes themselves. Each change refers to the names by their index in the table,
+        and a change that's made to the same sub-tree as the previous one has a path
+        length of -1 instead of repeating the path.
+    */
+    static bool applyChangeBatch (ValueTree& root, MemoryInputStream& input, UndoManager* undoManager)
+    {
+        const int numIdentifiers = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numIdentifiers, 65536)) // sanity-check
+            return false;
+
+        Array<Identifier> identifiers;
+
+        for (int i = 0; i < numIdentifiers; ++i)
+        {
+            auto name = input.readString();
+
+            if (name.isEmpty())
+                return false;
+
+            identifiers.add (name);
+        }
+
+        const int numChanges = input.readCompressedInt();
+        ValueTree::ScopedTransaction transaction (root, undoManager);
+        ValueTree v;
+
+        for (int i = 0; i < numChanges; ++i)
+        {
+            const ChangeType type = (ChangeType) input.readByte();
+            const int numLevels = input.readCompressedInt();
+
+            if (numLevels >= 0)
+                v = readSubTreeLocation (input, root, numLevels);
+
+            if (! v.isValid() || ! applyChangeToTree (v, type, input, &identifiers, undoManager))
+                return false;
+        }
+
+        return true;
+    }
 }
 
+//==============================================================================
+struct ValueTreeSynchroniser::PendingChanges
+{
+    MemoryOutputStream& startChange (ValueTreeSynchroniserHelpers::ChangeType type, const Array<int>& path)
+    {
+        stream.writeByte ((char) type);
+
+        if (numChanges > 0 && path == lastPath)
+        {
+            stream.writeCompressedInt (-1);
+        }
+        else
+        {
+            stream.writeCompressedInt (path.size());
+
+            for (int i = path.size(); --i >= 0;)
+                stream.writeCompressedInt (path.getUnchecked(i));
+
+            lastPath = path;
+        }
+
+        ++numChanges;
+        return stream;
+    }
+
+    MemoryOutputStream& startStructuralChange (ValueTreeSynchroniserHelpers::ChangeType type, const Array<int>& path)
+    {
+        // the property changes have to go first, because their paths may not be valid afterwards
+        writePropertyChanges();
+        return startChange (type, path);
+    }
+
+    void addPropertyChange (const ValueTree& tree, const Identifier& property, const Array<int>& path)
+    {
+        String key (property.toString());
+
+        for (auto i : path)
+            key << '/' << i;
+
+        if (! propertyKeys.contains (key))
+        {
+            propertyKeys.set (key, properties.size());
+            properties.add ({ tree, property, path });
+        }
+    }
+
+    MemoryBlock createMessage()
+    {
+        writePropertyChanges();
+
+        MemoryOutputStream m;
+        ValueTreeSynchroniserHelpers::writeHeader (m, ValueTreeSynchroniserHelpers::changeBatch);
+        m.writeCompressedInt (identifiers.size());
+
+        for (auto& id : identifiers)
+            m.writeString (id.toString());
+
+        m.writeCompressedInt (numChanges);
+        m.write (stream.getData(), stream.getDataSize());
+        return m.getMemoryBlock();
+    }
+
+private:
+    struct PropertyChange
+    {
+        ValueTree tree;
+        Identifier property;
+        Array<int> path;
+    };
+
+    void writePropertyName (const Identifier& name)
+    {
+        auto* key = name.getCharPointer().getAddress();
+
+        if (! identifierIndexes.contains (key))
+        {
+            identifierIndexes.set (key, identifiers.size());
+            identifiers.add (name);
+        }
+
+        stream.writeCompressedInt (identifierIndexes[key]);
+    }
+
+    void writePropertyChanges()
+    {
+        for (auto& p : properties)
+        {
+            if (auto* value = p.tree.getPropertyPointer (p.property))
+            {
+                startChange (ValueTreeSynchroniserHelpers::propertyChanged, p.path);
+                writePropertyName (p.property);
+                value->writeToStream (stream);
+            }
+            else
+            {
+                startChange (ValueTreeSynchroniserHelpers::propertyRemoved, p.path);
+                writePropertyName (p.property);
+            }
+        }
+
+        properties.clearQuick();
+        propertyKeys.clear();
+    }
+
+    MemoryOutputStream stream;
+    int numChanges = 0;
+    Array<int> lastPath;
+
+    Array<Identifier> identifiers;
+    HashMap<const void*, int> identifierIndexes;
+
+    Array<PropertyChange> properties;
+    HashMap<String, int> propertyKeys;
+};
+
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -105,14 +348,77 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    // the full state replaces anything that was waiting to be sent
+    stopTimer();
+    pendingChanges = nullptr;
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
     stateChanged (m.getData(), m.getDataSize());
 }
 
+MemoryBlock ValueTreeSynchroniser::createFullSyncMessage()
+{
+    flushPendingChanges();
+
+    MemoryOutputStream m;
+    writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
+    valueTree.writeToStream (m);
+    return m.getMemoryBlock();
+}
+
+//==============================================================================
+void ValueTreeSynchroniser::setCoalescingInterval (int milliseconds)
+{
+    coalescingInterval = jmax (0, milliseconds);
+
+    if (coalescingInterval == 0)
+        flushPendingChanges();
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    stopTimer();
+
+    if (pendingChanges != nullptr)
+    {
+        ScopedPointer<PendingChanges> changes (pendingChanges.release());
+        auto message = changes->createMessage();
+        stateChanged (message.getData(), message.getSize());
+    }
+}
+
+void ValueTreeSynchroniser::timerCallback()
+{
+    flushPendingChanges();
+}
+
+ValueTreeSynchroniser::PendingChanges* ValueTreeSynchroniser::getPendingChanges()
+{
+    if (coalescingInterval <= 0)
+        return nullptr;
+
+    if (pendingChanges == nullptr)
+    {
+        pendingChanges = new PendingChanges();
+        startTimer (coalescingInterval);
+    }
+
+    return pendingChanges;
+}
+
+//==============================================================================
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        Array<int> path;
+        ValueTreeSynchroniserHelpers::getValueTreePath (vt, valueTree, path);
+        pending->addPropertyChange (vt, property, path);
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -135,6 +441,16 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (auto* pending = getPendingChanges())
+    {
+        Array<int> path;
+        ValueTreeSynchroniserHelpers::getValueTreePath (parentTree, valueTree, path);
+        auto& m = pending->startStructuralChange (ValueTreeSynchroniserHelpers::childAdded, path);
+        m.writeCompressedInt (index);
+        childTree.writeToStream (m);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -144,6 +460,14 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        Array<int> path;
+        ValueTreeSynchroniserHelpers::getValueTreePath (parentTree, valueTree, path);
+        pending->startStructuralChange (ValueTreeSynchroniserHelpers::childRemoved, path).writeCompressedInt (oldIndex);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -152,6 +476,16 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        Array<int> path;
+        ValueTreeSynchroniserHelpers::getValueTreePath (parent, valueTree, path);
+        auto& m = pending->startStructuralChange (ValueTreeSynchroniserHelpers::childMoved, path);
+        m.writeCompressedInt (oldIndex);
+        m.writeCompressedInt (newIndex);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -173,70 +507,15 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::changeBatch)
+        return ValueTreeSynchroniserHelpers::applyChangeBatch (root, input, undoManager);
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
         return false;
 
-    switch (type)
-    {
-        case ValueTreeSynchroniserHelpers::propertyChanged:
-        {
-            Identifier property (input.readString());
-            v.setProperty (property, var::readFromStream (input), undoManager);
-            return true;
-        }
-
-        case ValueTreeSynchroniserHelpers::propertyRemoved:
-        {
-            Identifier property (input.readString());
-            v.removeProperty (property, undoManager);
-            return true;
-        }
-
-        case ValueTreeSynchroniserHelpers::childAdded:
-        {
-            const int index = input.readCompressedInt();
-            v.addChild (ValueTree::readFromStream (input), index, undoManager);
-            return true;
-        }
-
-        case ValueTreeSynchroniserHelpers::childRemoved:
-        {
-            const int index = input.readCompressedInt();
-
-            if (isPositiveAndBelow (index, v.getNumChildren()))
-            {
-                v.removeChild (index, undoManager);
-                return true;
-            }
-
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
-        }
-
-        case ValueTreeSynchroniserHelpers::childMoved:
-        {
-            const int oldIndex = input.readCompressedInt();
-            const int newIndex = input.readCompressedInt();
-
-            if (isPositiveAndBelow (oldIndex, v.getNumChildren())
-                 && isPositiveAndBelow (newIndex, v.getNumChildren()))
-            {
-                v.moveChild (oldIndex, newIndex, undoManager);
-                return true;
-            }
-
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
-        }
-
-        default:
-            jassertfalse; // Seem to have received some corrupt data?
-            break;
-    }
-
-    return false;
+    return ValueTreeSynchroniserHelpers::applyChangeToTree (v, type, input, nullptr, undoManager);
 }
 
 } // namespace juce
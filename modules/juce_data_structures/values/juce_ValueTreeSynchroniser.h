@@ -40,8 +40,13 @@ namespace juce
     and implement the stateChanged() method to transmit the encoded change (maybe
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
+
+    By default, each change is sent as soon as it happens. If the tree changes rapidly,
+    you can use setCoalescingInterval() to make it gather up the changes and send them
+    as a single compactly-encoded message at regular intervals instead.
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private Timer
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -69,6 +74,42 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Returns an encoded message containing the entire state of the tree, which can be
+        given to applyChange() on a target tree that has just joined.
+
+        This is for bringing a new target tree up to date without disturbing the ones that
+        are already in sync: before the snapshot is taken, any changes that are waiting to be
+        sent are passed to stateChanged(), so that the snapshot and the messages that follow
+        it fit together. Make sure that the new target receives the snapshot before any of the
+        subsequent stateChanged() messages, and none of the ones that came before it.
+    */
+    MemoryBlock createFullSyncMessage();
+
+    //==============================================================================
+    /** Makes the synchroniser gather up changes and send them in batches.
+
+        If the interval is greater than zero, changes aren't sent as soon as they happen.
+        Instead, they're held back for up to this number of milliseconds, and then sent
+        together in a single stateChanged() message. Repeated changes to the same property
+        are merged, so only its latest value is sent, and property names are only sent once
+        per message. This means that the amount of data sent depends on how many properties
+        actually changed during each interval, rather than how many times they were set.
+
+        An interval of zero (the default) sends each change as soon as it happens.
+        The batches are sent by a Timer, so this needs a running message thread.
+
+        @see flushPendingChanges
+    */
+    void setCoalescingInterval (int milliseconds);
+
+    /** Returns the interval that was set with setCoalescingInterval(). */
+    int getCoalescingInterval() const noexcept      { return coalescingInterval; }
+
+    /** If any changes are being held back by setCoalescingInterval(), this sends them
+        straight away.
+    */
+    void flushPendingChanges();
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -83,7 +124,14 @@ public:
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
 private:
+    struct PendingChanges;
+
     ValueTree valueTree;
+    ScopedPointer<PendingChanges> pendingChanges;
+    int coalescingInterval = 0;
+
+    PendingChanges* getPendingChanges();
+    void timerCallback() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
@@ -119,6 +119,44 @@ public:
         }
     }
 
+    /** Allocates a suitable amount of space in a HeapBlock, and initialises this object
+        to point into it, with the channels aligned and padded as described by an
+        AudioBufferLayout.
+
+        This lets SIMD code use aligned loads and run on past the end of the block into
+        the padding, and lets you keep channels which are written by different threads
+        on separate cache lines.
+
+        The HeapBlock must of course not be freed or re-allocated while this object is still in
+        use, because it will be referencing its data.
+
+        @see AudioBufferLayout
+    */
+    AudioBlock (HeapBlock<char>& heapBlockToUseForAllocation,
+                size_t numberOfChannels, size_t numberOfSamples,
+                const AudioBufferLayout& layout) noexcept
+        : numChannels (static_cast<ChannelCountType> (numberOfChannels)),
+          numSamples (numberOfSamples)
+    {
+        auto alignment = layout.getChannelAlignment<SampleType>();
+        auto stride = layout.getChannelStride<SampleType> (static_cast<int> (numberOfSamples));
+        auto channelListBytes = sizeof (SampleType*) * numberOfChannels;
+
+        heapBlockToUseForAllocation.malloc (channelListBytes + alignment - 1 + stride * sizeof (SampleType) * numberOfChannels);
+
+        auto* chanArray = reinterpret_cast<SampleType**> (heapBlockToUseForAllocation.getData());
+        channels = chanArray;
+
+        auto* data = reinterpret_cast<SampleType*> (addBytesToPointer (chanArray, channelListBytes));
+        data = snapPointerToAlignment (data, alignment);
+
+        for (ChannelCountType i = 0; i < numChannels; ++i)
+        {
+            chanArray[i] = data;
+            data += stride;
+        }
+    }
+
     /** Creates an AudioBlock that points to the data in an AudioBuffer.
         AudioBlock does not copy nor own the memory pointed to by dataToUse.
         Therefore it is the user's responsibility to ensure that the buffer is retained
@@ -401,6 +439,28 @@ public:
         return *this;
     }
 
+    /** Multiplies each source value by the next value of a smoothed ramp, such as a
+        LinearSmoothedValue or MultiplicativeSmoothedValue, and stores it in the receiver.
+        Every channel gets the same ramp, which is moved on by the number of samples.
+    */
+    template <typename SmoothedValueType>
+    AudioBlock& multiplyByRamp (const AudioBlock& src, SmoothedValueType& ramp) noexcept
+    {
+        return applyRamp (src, ramp, [] (NumericType* d, const NumericType* s, const NumericType* r, int num) { FloatVectorOperations::multiply (d, s, r, num); },
+                                     [] (NumericType* d, const NumericType* s, NumericType v, int num)      { FloatVectorOperations::multiply (d, s, v, num); });
+    }
+
+    /** Adds the next value of a smoothed ramp, such as a LinearSmoothedValue, to each
+        source value and stores it in the receiver. Every channel gets the same ramp,
+        which is moved on by the number of samples.
+    */
+    template <typename SmoothedValueType>
+    AudioBlock& addRamp (const AudioBlock& src, SmoothedValueType& ramp) noexcept
+    {
+        return applyRamp (src, ramp, [] (NumericType* d, const NumericType* s, const NumericType* r, int num) { FloatVectorOperations::add (d, s, r, num); },
+                                     [] (NumericType* d, const NumericType* s, NumericType v, int num)      { FloatVectorOperations::add (d, s, v, num); });
+    }
+
     /** Multiplies each value in src with factor and adds the result to the receiver. */
     forcedinline AudioBlock& JUCE_VECTOR_CALLTYPE addWithMultiply (const AudioBlock& src, SampleType factor) noexcept
     {
@@ -532,6 +592,41 @@ private:
     NumericType*       channelPtr (size_t ch) noexcept          { return reinterpret_cast<NumericType*>       (getChannelPointer (ch)); }
     const NumericType* channelPtr (size_t ch) const noexcept    { return reinterpret_cast<const NumericType*> (getChannelPointer (ch)); }
 
+    // Fills a chunk of the ramp at a time, and applies it to each channel, until the
+    // ramp has finished, and then uses the target value for the rest of the block.
+    // For a block of SIMD registers, each value of the ramp is copied to all the lanes.
+    template <typename SmoothedValueType, typename RampOp, typename ValueOp>
+    AudioBlock& applyRamp (const AudioBlock& src, SmoothedValueType& ramp, RampOp rampOp, ValueOp valueOp) noexcept
+    {
+        jassert (numChannels == src.numChannels);
+
+        const int chunkSize = SmoothedValueType::rampChunkSize;
+        const int factor = static_cast<int> (sizeFactor);
+        auto n = static_cast<int> (jmin (numSamples, src.numSamples));
+        NumericType values[chunkSize * sizeFactor];
+        int pos = 0;
+
+        for (; pos < n && ramp.isSmoothing(); pos += chunkSize)
+        {
+            auto num = jmin (chunkSize, n - pos);
+            ramp.fillRamp (values, num);
+
+            if (factor > 1)
+                for (int i = num; --i >= 0;)
+                    for (int lane = factor; --lane >= 0;)
+                        values[i * factor + lane] = values[i];
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                rampOp (channelPtr (ch) + pos * factor, src.channelPtr (ch) + pos * factor, values, num * factor);
+        }
+
+        if (pos < n)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                valueOp (channelPtr (ch) + pos * factor, src.channelPtr (ch) + pos * factor, ramp.getTargetValue(), (n - pos) * factor);
+
+        return *this;
+    }
+
     //==============================================================================
     using ChannelCountType = unsigned int;
 
@@ -115,6 +115,24 @@ struct SIMDRegister
         __mm128 for single-precision floating point on SSE architectures). */
     inline static SIMDRegister JUCE_VECTOR_CALLTYPE fromNative (vSIMDType a) noexcept       { return {a}; }
 
+    /** Creates a new SIMDRegister from the first SIMDNumElements of a scalar array.
+        Unlike when casting a pointer to a SIMDRegister, the array doesn't have to be aligned. */
+    inline static SIMDRegister JUCE_VECTOR_CALLTYPE fromRawArray (const ElementType* a) noexcept
+    {
+        SIMDRegister retval;
+        std::memcpy (&retval.value, a, sizeof (vSIMDType));
+        return retval;
+    }
+
+    /** Copies the elements of the SIMDRegister to a scalar array, which doesn't have to be aligned. */
+    inline void JUCE_VECTOR_CALLTYPE copyToRawArray (ElementType* a) const noexcept
+    {
+        // an element-wise copy, since the elements might not be trivially copyable
+        // types, e.g. std::complex, and the compiler turns it into a single store
+        for (size_t i = 0; i < SIMDNumElements; ++i)
+            a[i] = (*this)[i];
+    }
+
     //==============================================================================
     /** Returns the idx-th element of the receiver. Note that this does not check if idx
         is larger than the native register size. */
@@ -142,6 +160,9 @@ struct SIMDRegister
     /** Subtracts another SIMDRegister to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (SIMDRegister v) noexcept      { value = CmplxOps::mul (value, v.value); return *this; }
 
+    /** Divides the receiver by another SIMDRegister. This is only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (SIMDRegister v) noexcept      { value = NativeOps::div (value, v.value); return *this; }
+
     //==============================================================================
     /** Broadcasts the scalar to all elements of the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator=  (ElementType s) noexcept       { value  = CmplxOps::expand (s); return *this; }
@@ -155,6 +176,9 @@ struct SIMDRegister
     /** Multiplies a scalar to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (ElementType s) noexcept       { value = CmplxOps::mul (value, CmplxOps::expand (s)); return *this; }
 
+    /** Divides the receiver by a scalar. This is only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (ElementType s) noexcept       { value = NativeOps::div (value, CmplxOps::expand (s)); return *this; }
+
     //==============================================================================
     /** Bit-and the reciver with SIMDRegister v and store the result in the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator&= (vMaskType v) noexcept         { value = NativeOps::bit_and (value, toVecType (v.value)); return *this; }
@@ -185,6 +209,12 @@ struct SIMDRegister
     /** Returns the product of the receiver and v.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (SIMDRegister v) const noexcept  { return { CmplxOps::mul (value, v.value) }; }
 
+    /** Returns the quotient of the receiver and v. This is only available for float and double. */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (SIMDRegister v) const noexcept  { return { NativeOps::div (value, v.value) }; }
+
+    /** Returns a vector where each element is the negated value of the corresponding element in the receiver. */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator- () const noexcept                { return { NativeOps::sub (CmplxOps::expand (ElementType()), value) }; }
+
     //==============================================================================
     /** Returns a vector where each element is the sum of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator+ (ElementType s) const noexcept   { return { NativeOps::add (value, CmplxOps::expand (s)) }; }
@@ -195,6 +225,28 @@ struct SIMDRegister
     /** Returns a vector where each element is the difference of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (ElementType s) const noexcept   { return { CmplxOps::mul (value, CmplxOps::expand (s)) }; }
 
+    /** Returns a vector where each element is the corresponding element in the receiver divided by the scalar s.
+        This is only available for float and double. */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (ElementType s) const noexcept   { return { NativeOps::div (value, CmplxOps::expand (s)) }; }
+
+    //==============================================================================
+    /** Returns a vector where each element is the sum of the scalar s and the corresponding element in v.
+
+        The scalar versions of the arithmetic operators let a template written for a scalar type,
+        like the functions in FastMathApproximations, be used with SIMDRegisters too.
+    */
+    friend inline SIMDRegister JUCE_VECTOR_CALLTYPE operator+ (ElementType s, SIMDRegister v) noexcept  { return { NativeOps::add (CmplxOps::expand (s), v.value) }; }
+
+    /** Returns a vector where each element is the difference of the scalar s and the corresponding element in v. */
+    friend inline SIMDRegister JUCE_VECTOR_CALLTYPE operator- (ElementType s, SIMDRegister v) noexcept  { return { NativeOps::sub (CmplxOps::expand (s), v.value) }; }
+
+    /** Returns a vector where each element is the product of the scalar s and the corresponding element in v. */
+    friend inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (ElementType s, SIMDRegister v) noexcept  { return { CmplxOps::mul (CmplxOps::expand (s), v.value) }; }
+
+    /** Returns a vector where each element is the scalar s divided by the corresponding element in v.
+        This is only available for float and double. */
+    friend inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (ElementType s, SIMDRegister v) noexcept  { return { NativeOps::div (CmplxOps::expand (s), v.value) }; }
+
     //==============================================================================
     /** Returns the bit-and of the receiver and v. */
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator& (vMaskType v) const noexcept     { return { NativeOps::bit_and (value, toVecType (v.value)) }; }
@@ -256,6 +308,21 @@ struct SIMDRegister
     /** Returns a new vector where each element is the maximum of the corresponding element of a and b. */
     static inline SIMDRegister JUCE_VECTOR_CALLTYPE max (SIMDRegister a, SIMDRegister b) noexcept    { return { NativeOps::max (a.value, b.value) }; }
 
+    /** Returns a new vector where each element is the corresponding element of a rounded towards zero.
+        This is only available for float and double, with values whose magnitude is below 2^31.
+    */
+    static inline SIMDRegister JUCE_VECTOR_CALLTYPE truncate (SIMDRegister a) noexcept       { return { NativeOps::truncate (a.value) }; }
+
+    /** Returns a new vector where each element is read from the array at the corresponding
+        index in indices, which are truncated to integers. This uses the gather instructions
+        where the CPU has them, and loads the elements one by one otherwise.
+        This is only available for float and double.
+    */
+    static inline SIMDRegister JUCE_VECTOR_CALLTYPE gather (const ElementType* base, SIMDRegister indices) noexcept
+    {
+        return { NativeOps::gather (base, indices.value) };
+    }
+
     //==============================================================================
     /** Multiplies a and b and adds the result to c. */
     static inline SIMDRegister JUCE_VECTOR_CALLTYPE multiplyAdd (SIMDRegister a, const SIMDRegister b, SIMDRegister c) noexcept
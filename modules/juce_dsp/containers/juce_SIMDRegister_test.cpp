@@ -181,6 +181,21 @@ public:
         }
     };
 
+    struct Division
+    {
+        template <typename typeOne, typename typeTwo>
+        static void inplace (typeOne& a, const typeTwo& b)
+        {
+            a /= b;
+        }
+
+        template <typename typeOne, typename typeTwo>
+        static typeOne outofplace (const typeOne& a, const typeTwo& b)
+        {
+            return a / b;
+        }
+    };
+
     struct BitAND
     {
         template <typename typeOne, typename typeTwo>
@@ -607,6 +622,88 @@ public:
         }
     };
 
+    struct CheckScalarFirstOperators
+    {
+        template <typename type>
+        static void run (UnitTest& u, Random& random)
+        {
+            type array_a [SIMDRegister<type>::SIMDNumElements];
+            type array_sum [SIMDRegister<type>::SIMDNumElements];
+            type array_difference [SIMDRegister<type>::SIMDNumElements];
+            type array_product [SIMDRegister<type>::SIMDNumElements];
+            type array_quotient [SIMDRegister<type>::SIMDNumElements];
+            type array_negated [SIMDRegister<type>::SIMDNumElements];
+
+            SIMDRegister_test_internal::fillRandom (array_a, SIMDRegister<type>::SIMDNumElements, random);
+
+            for (size_t j = 0; j < SIMDRegister<type>::SIMDNumElements; ++j)
+            {
+                array_sum[j]        = static_cast<type> (3) + array_a[j];
+                array_difference[j] = static_cast<type> (3) - array_a[j];
+                array_product[j]    = static_cast<type> (3) * array_a[j];
+                array_quotient[j]   = static_cast<type> (3) / array_a[j];
+                array_negated[j]    = -array_a[j];
+            }
+
+            SIMDRegister<type> a;
+            copy (a, array_a);
+
+            u.expect (vecEqualToArray (static_cast<type> (3) + a, array_sum));
+            u.expect (vecEqualToArray (static_cast<type> (3) - a, array_difference));
+            u.expect (vecEqualToArray (static_cast<type> (3) * a, array_product));
+            u.expect (vecEqualToArray (static_cast<type> (3) / a, array_quotient));
+            u.expect (vecEqualToArray (-a, array_negated));
+        }
+    };
+
+    struct CheckTruncate
+    {
+        template <typename type>
+        static void run (UnitTest& u, Random& random)
+        {
+            type array_a [SIMDRegister<type>::SIMDNumElements];
+            type array_truncated [SIMDRegister<type>::SIMDNumElements];
+
+            SIMDRegister_test_internal::fillRandom (array_a, SIMDRegister<type>::SIMDNumElements, random);
+
+            for (size_t j = 0; j < SIMDRegister<type>::SIMDNumElements; ++j)
+                array_truncated[j] = std::trunc (array_a[j]);
+
+            SIMDRegister<type> a;
+            copy (a, array_a);
+
+            u.expect (vecEqualToArray (SIMDRegister<type>::truncate (a), array_truncated));
+        }
+    };
+
+    struct CheckGather
+    {
+        template <typename type>
+        static void run (UnitTest& u, Random& random)
+        {
+            type table [64];
+            type array_indices [SIMDRegister<type>::SIMDNumElements];
+            type array_gathered [SIMDRegister<type>::SIMDNumElements];
+
+            SIMDRegister_test_internal::fillRandom (table, 64, random);
+
+            for (size_t j = 0; j < SIMDRegister<type>::SIMDNumElements; ++j)
+            {
+                array_indices[j] = static_cast<type> (random.nextInt (63)) + static_cast<type> (random.nextFloat());
+                array_gathered[j] = table[static_cast<int> (array_indices[j])];
+            }
+
+            SIMDRegister<type> indices;
+            copy (indices, array_indices);
+
+            u.expect (vecEqualToArray (SIMDRegister<type>::gather (table, indices), array_gathered));
+
+            type array_copy [SIMDRegister<type>::SIMDNumElements];
+            SIMDRegister<type>::fromRawArray (table + 1).copyToRawArray (array_copy);
+            u.expect (std::equal (array_copy, array_copy + SIMDRegister<type>::SIMDNumElements, table + 1));
+        }
+    };
+
     //==============================================================================
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
@@ -648,6 +745,17 @@ public:
         TheTest::template run<uint64_t>(*this, random);
     }
 
+    template <class TheTest>
+    void runTestFloatingPoint (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        Random random = getRandom();
+
+        TheTest::template run<float>   (*this, random);
+        TheTest::template run<double>  (*this, random);
+    }
+
     void runTest()
     {
         runTestForAllTypes<InitializationTest> ("InitializationTest");
@@ -657,6 +765,8 @@ public:
         runTestForAllTypes<OperatorTests<Addition>> ("AdditionOperators");
         runTestForAllTypes<OperatorTests<Subtraction>> ("SubtractionOperators");
         runTestForAllTypes<OperatorTests<Multiplication>> ("MultiplicationOperators");
+        runTestFloatingPoint<OperatorTests<Division>> ("DivisionOperators");
+        runTestFloatingPoint<CheckScalarFirstOperators> ("ScalarFirstOperators");
 
         runTestForAllTypes<BitOperatorTests<BitAND>> ("BitANDOperators");
         runTestForAllTypes<BitOperatorTests<BitOR>>  ("BitOROperators");
@@ -667,6 +777,9 @@ public:
 
         runTestForAllTypes<CheckMultiplyAdd> ("CheckMultiplyAdd");
         runTestForAllTypes<CheckSum> ("CheckSum");
+
+        runTestFloatingPoint<CheckTruncate> ("CheckTruncate");
+        runTestFloatingPoint<CheckGather> ("CheckGather");
     }
 };
 
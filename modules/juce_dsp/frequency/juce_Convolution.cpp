@@ -29,6 +29,170 @@ namespace juce
 namespace dsp
 {
 
+/** The frequency domain partitions of an impulse response, which can be shared
+    by all the convolution engines using the same impulse response.
+*/
+struct ConvolutionImpulseSpectra  : public ReferenceCountedObject
+{
+    using Ptr = ReferenceCountedObjectPtr<ConvolutionImpulseSpectra>;
+
+    /** Creates the partitions of the numSamples samples of an impulse response, for
+        an engine processing blockSize samples at a time with FFTs of size FFTSize.
+        If impulseResponse is nullptr, the partitions are filled with zeros.
+    */
+    ConvolutionImpulseSpectra (const float* impulseResponse, size_t numSamples, size_t blockSize, size_t FFTSize)
+    {
+        auto segmentSize = FFTSize - blockSize;
+        auto numSegments = numSamples / segmentSize + 1;
+
+        FFT fft (roundDoubleToInt (log2 (FFTSize)));
+
+        for (size_t n = 0; n < numSegments; ++n)
+        {
+            AudioBuffer<float> newSegment;
+            newSegment.setSize (1, static_cast<int> (FFTSize * 2));
+            newSegment.clear();
+
+            if (impulseResponse != nullptr)
+            {
+                auto* segmentData = newSegment.getWritePointer (0);
+
+                for (size_t i = 0; i < segmentSize && i + n * segmentSize < numSamples; ++i)
+                    segmentData[i] = impulseResponse[i + n * segmentSize];
+
+                fft.performRealOnlyForwardTransform (segmentData);
+                prepareForConvolution (segmentData, FFTSize);
+            }
+
+            segments.add (newSegment);
+        }
+
+        numBytes = (int64) (numSegments * FFTSize * 2 * sizeof (float));
+        getMemoryUsage().add (numBytes);
+    }
+
+    ~ConvolutionImpulseSpectra()
+    {
+        getMemoryUsage().remove (numBytes);
+    }
+
+    static MemoryUsage::Category& getMemoryUsage()
+    {
+        static MemoryUsage::Category& category = MemoryUsage::getCategory ("Convolution");
+        return category;
+    }
+
+    //==============================================================================
+    /** After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls. */
+    static void prepareForConvolution (float *samples, size_t FFTSize) noexcept
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        for (size_t i = 0; i < FFTSizeDiv2; i++)
+            samples[i] = samples[2 * i];
+
+        samples[FFTSizeDiv2] = 0;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+            samples[i + FFTSizeDiv2] = -samples[2 * (FFTSize - i) + 1];
+    }
+
+    /** Does the convolution operation itself only on half of the frequency domain samples. */
+    static void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output, size_t FFTSize)
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
+        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+
+        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+    }
+
+    /** Undo the re-organization of samples from the function prepareForConvolution.
+        Then, takes the conjugate of the frequency domain first half of samples, to fill the
+        second half, so that the inverse transform will return real samples in the time domain.
+    */
+    static void updateSymmetricFrequencyDomainData (float* samples, size_t FFTSize) noexcept
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        {
+            samples[2 * (FFTSize - i)] = samples[i];
+            samples[2 * (FFTSize - i) + 1] = -samples[FFTSizeDiv2 + i];
+        }
+
+        samples[1] = 0.f;
+
+        // the Nyquist bin isn't part of the convolution, so it mustn't bring back
+        // whatever was left in the buffer
+        samples[FFTSize] = 0.f;
+        samples[FFTSize + 1] = 0.f;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        {
+            samples[2 * i] = samples[2 * (FFTSize - i)];
+            samples[2 * i + 1] = -samples[2 * (FFTSize - i) + 1];
+        }
+    }
+
+    //==============================================================================
+    String key;                             // identifies the impulse response in the cache, empty if not cached
+    Array<AudioBuffer<float>> segments;     // the frequency domain partitions
+    int64 numBytes = 0;                     // the size of the partitions, as reported to MemoryUsage
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionImpulseSpectra)
+};
+
+//==============================================================================
+/** Keeps track of the impulse response partitions currently used, so that all the
+    convolution engines loading the same impulse response with the same settings
+    share a single copy of them. An entry only stays in the cache while an engine
+    is using it.
+*/
+struct ConvolutionImpulseSpectraCache
+{
+    ConvolutionImpulseSpectraCache() = default;
+
+    /** Returns the partitions stored with the given key, or nullptr if there aren't any. */
+    ConvolutionImpulseSpectra::Ptr find (const String& key)
+    {
+        const ScopedLock sl (lock);
+        removeUnusedEntries();
+
+        for (auto* entry : entries)
+            if (entry->key == key)
+                return entry;
+
+        return nullptr;
+    }
+
+    /** Adds some partitions to the cache, with the key they have been given. */
+    void add (ConvolutionImpulseSpectra* spectra)
+    {
+        jassert (spectra->key.isNotEmpty());
+
+        const ScopedLock sl (lock);
+        removeUnusedEntries();
+        entries.add (spectra);
+    }
+
+private:
+    void removeUnusedEntries()
+    {
+        for (int i = entries.size(); --i >= 0;)
+            if (entries.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+                entries.remove (i);
+    }
+
+    CriticalSection lock;
+    ReferenceCountedArray<ConvolutionImpulseSpectra> entries;
+
+    JUCE_DECLARE_NON_COPYABLE (ConvolutionImpulseSpectraCache)
+};
+
+//==============================================================================
 /** This class is the convolution engine itself, processing only one channel at
     a time of input signal.
 */
@@ -61,11 +225,21 @@ struct ConvolutionEngine
         bool wantsTrimming;
         size_t impulseResponseSize;
         size_t maximumBufferSize = 0;
+
+        bool useNonUniformPartitioning = false;
+        size_t tailPartitionSize = 0;
     };
 
+    ~ConvolutionEngine()
+    {
+        cancelTailJob();
+    }
+
     //==============================================================================
     void reset()
     {
+        cancelTailJob();
+
         bufferInput.clear();
         bufferOverlap.clear();
         bufferTempOutput.clear();
@@ -75,21 +249,109 @@ struct ConvolutionEngine
 
         currentSegment = 0;
         inputDataPos = 0;
+
+        if (tailEngine != nullptr)
+        {
+            tailEngine->reset();
+
+            bufferTailInput.clear();
+            bufferTailOutput.clear();
+            FloatVectorOperations::clear (tailJobData, static_cast<int> (tailSize));
+        }
+
+        tailInputPos = 0;
     }
 
     /** Initalize all the states and objects to perform the convolution. */
     void initializeConvolutionEngine (ProcessingInformation& info, int channel)
     {
-        blockSize = (size_t) nextPowerOfTwo ((int) info.maximumBufferSize);
+        cancelTailJob();
+
+        auto newBlockSize = (size_t) nextPowerOfTwo ((int) info.maximumBufferSize);
+        auto impulseResponseSize = (size_t) info.buffer->getNumSamples();
+        auto newTailSize = (size_t) 0;
+
+        if (info.useNonUniformPartitioning)
+        {
+            newTailSize = info.tailPartitionSize > 0 ? (size_t) nextPowerOfTwo ((int) info.tailPartitionSize)
+                                                     : jmax ((size_t) 1024, 16 * newBlockSize);
+
+            newTailSize = jmax (newTailSize, 2 * newBlockSize);
+
+            // the tail can only start after two of its own partitions, so short
+            // impulse responses are simply processed in the uniform way
+            if (impulseResponseSize <= 2 * newTailSize)
+                newTailSize = 0;
+        }
+
+        tailSize = newTailSize;
+
+        if (tailSize > 0)
+        {
+            initializeUniformPartitions (info, channel, newBlockSize, 0, 2 * tailSize);
+
+            if (tailEngine == nullptr)
+                tailEngine = new ConvolutionEngine();
+
+            tailEngine->initializeUniformPartitions (info, channel, tailSize, 2 * tailSize, impulseResponseSize - 2 * tailSize);
+
+            bufferTailInput.setSize  (1, static_cast<int> (tailSize));
+            bufferTailOutput.setSize (1, static_cast<int> (tailSize));
+            tailJobData.allocate (tailSize, true);
+        }
+        else
+        {
+            initializeUniformPartitions (info, channel, newBlockSize, 0, impulseResponseSize);
+
+            tailEngine = nullptr;
+        }
+
+        reset();
+
+        isReady = true;
+    }
+
+    /** Initalize the uniform partitions used to convolve the input signal with the
+        part of the impulse response starting at irStart and irLength samples long.
+    */
+    void initializeUniformPartitions (ProcessingInformation& info, int channel,
+                                      size_t newBlockSize, size_t irStart, size_t irLength)
+    {
+        blockSize = newBlockSize;
 
         FFTSize = blockSize > 128 ? 2 * blockSize
                                   : 4 * blockSize;
 
-        numSegments = ((size_t) info.buffer->getNumSamples()) / (FFTSize - blockSize) + 1;
+        FFTobject = new FFT (roundDoubleToInt (log2 (FFTSize)));
 
-        numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
+        auto numChannels = (info.wantsStereo && info.buffer->getNumChannels() >= 2 ? 2 : 1);
 
-        FFTobject = new FFT (roundDoubleToInt (log2 (FFTSize)));
+        if (channel < numChannels)
+        {
+            auto key = getImpulseSpectraKey (info, channel, irStart, irLength);
+
+            impulseSpectra = key.isNotEmpty() ? spectraCache->find (key) : nullptr;
+
+            if (impulseSpectra == nullptr)
+            {
+                impulseSpectra = new ConvolutionImpulseSpectra (info.buffer->getReadPointer (channel, static_cast<int> (irStart)),
+                                                                irLength, blockSize, FFTSize);
+
+                if (key.isNotEmpty())
+                {
+                    impulseSpectra->key = key;
+                    spectraCache->add (impulseSpectra);
+                }
+            }
+        }
+        else
+        {
+            impulseSpectra = new ConvolutionImpulseSpectra (nullptr, irLength, blockSize, FFTSize);
+        }
+
+        numSegments = (size_t) impulseSpectra->segments.size();
+
+        numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
 
         bufferInput.setSize      (1, static_cast<int> (FFTSize));
         bufferOutput.setSize     (1, static_cast<int> (FFTSize * 2));
@@ -97,7 +359,6 @@ struct ConvolutionEngine
         bufferOverlap.setSize    (1, static_cast<int> (FFTSize));
 
         buffersInputSegments.clear();
-        buffersImpulseSegments.clear();
 
         for (size_t i = 0; i < numInputSegments; ++i)
         {
@@ -106,41 +367,49 @@ struct ConvolutionEngine
             buffersInputSegments.add (newInputSegment);
         }
 
-        for (auto i = 0u; i < numSegments; ++i)
-        {
-            AudioBuffer<float> newImpulseSegment;
-            newImpulseSegment.setSize (1, static_cast<int> (FFTSize * 2));
-            buffersImpulseSegments.add (newImpulseSegment);
-        }
-
-        ScopedPointer<FFT> FFTTempObject = new FFT (roundDoubleToInt (log2 (FFTSize)));
-        auto numChannels = (info.wantsStereo && info.buffer->getNumChannels() >= 2 ? 2 : 1);
-
-        if (channel < numChannels)
-        {
-            auto* channelData = info.buffer->getWritePointer (channel);
+        reset();
 
-            for (size_t n = 0; n < numSegments; ++n)
-            {
-                buffersImpulseSegments.getReference (static_cast<int> (n)).clear();
+        isReady = true;
+    }
 
-                auto* impulseResponse = buffersImpulseSegments.getReference (static_cast<int> (n)).getWritePointer (0);
+    /** Returns the key used to share the partitions of an impulse response between
+        engines, or an empty string if it can't be identified reliably, which is the
+        case for impulse responses loaded from an AudioBuffer.
 
-                if (n == 0)
-                    impulseResponse[0] = 1.0f;
+        Binary data is identified by its content rather than its address, since the
+        same memory might hold a different impulse response by the next time it's loaded.
+    */
+    String getImpulseSpectraKey (const ProcessingInformation& info, int channel, size_t irStart, size_t irLength) const
+    {
+        String source;
 
-                for (size_t i = 0; i < FFTSize - blockSize; ++i)
-                    if (i + n * (FFTSize - blockSize) < (size_t) info.buffer->getNumSamples())
-                        impulseResponse[i] = channelData[i + n * (FFTSize - blockSize)];
+        if (info.sourceType == ProcessingInformation::SourceType::sourceAudioFile)
+            source = info.fileImpulseResponse.getFullPathName() + ":"
+                       + String (info.fileImpulseResponse.getLastModificationTime().toMilliseconds());
+        else if (info.sourceType == ProcessingInformation::SourceType::sourceBinaryData)
+            source = String::toHexString (getContentHash (info.sourceData, info.sourceDataSize)) + ":" + String ((int64) info.sourceDataSize);
+        else
+            return {};
+
+        return "Convolution:" + source
+                 + ":" + String (info.sampleRate)
+                 + ":" + String ((int64) info.impulseResponseSize)
+                 + ":" + String ((int) info.wantsTrimming)
+                 + ":" + String (channel)
+                 + ":" + String ((int64) blockSize)
+                 + ":" + String ((int64) irStart)
+                 + ":" + String ((int64) irLength);
+    }
 
-                FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-                prepareForConvolution (impulseResponse);
-            }
-        }
+    /** A 64-bit FNV-1a hash of some binary data. */
+    static int64 getContentHash (const void* data, size_t numBytes) noexcept
+    {
+        auto hash = (uint64) 0xcbf29ce484222325ull;
 
-        reset();
+        for (auto* p = static_cast<const uint8*> (data); numBytes > 0; --numBytes)
+            hash = (hash ^ *p++) * (uint64) 0x100000001b3ull;
 
-        isReady = true;
+        return (int64) hash;
     }
 
     /** Copy the states of another engine. */
@@ -163,18 +432,147 @@ struct ConvolutionEngine
         bufferOutput        = other.bufferOutput;
 
         buffersInputSegments    = other.buffersInputSegments;
-        buffersImpulseSegments  = other.buffersImpulseSegments;
+        impulseSpectra          = other.impulseSpectra;
         bufferOverlap           = other.bufferOverlap;
 
+        // the other engine must not have any tail job in flight here
+        jassert (other.tailJobState.load() == tailJobIdle);
+        cancelTailJob();
+
+        tailSize            = other.tailSize;
+        tailInputPos        = other.tailInputPos;
+
+        if (other.tailEngine != nullptr)
+        {
+            if (tailEngine == nullptr)
+                tailEngine = new ConvolutionEngine();
+
+            tailEngine->copyStateFromOtherEngine (*other.tailEngine);
+
+            bufferTailInput     = other.bufferTailInput;
+            bufferTailOutput    = other.bufferTailOutput;
+
+            tailJobData.allocate (tailSize, false);
+            FloatVectorOperations::copy (tailJobData, other.tailJobData, static_cast<int> (tailSize));
+        }
+        else
+        {
+            tailEngine = nullptr;
+        }
+
         isReady = true;
     }
 
-    /** Performs the uniform partitioned convolution using FFT. */
+    //==============================================================================
+    /** Performs the convolution, adding the contribution of the tail partitions
+        when the non-uniform partitioning is used.
+
+        The tail engine processes tailSize samples at a time, in the background
+        thread, while the next tailSize input samples are being collected. Since its
+        impulse response starts 2 * tailSize samples into the original one, its output
+        is always ready in time to be added without any additional latency.
+    */
     void processSamples (const float* input, float* output, size_t numSamples)
     {
         if (! isReady)
             return;
 
+        if (tailEngine == nullptr)
+        {
+            processUniformPartitions (input, output, numSamples);
+            return;
+        }
+
+        size_t numSamplesProcessed = 0;
+
+        auto* tailInputData  = bufferTailInput.getWritePointer (0);
+        auto* tailOutputData = bufferTailOutput.getReadPointer (0);
+
+        while (numSamplesProcessed < numSamples)
+        {
+            auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, tailSize - tailInputPos);
+
+            // the input is stored first, since the processing might be done in place
+            FloatVectorOperations::copy (tailInputData + tailInputPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+
+            processUniformPartitions (input + numSamplesProcessed, output + numSamplesProcessed, numSamplesToProcess);
+
+            FloatVectorOperations::add (output + numSamplesProcessed, tailOutputData + tailInputPos, static_cast<int> (numSamplesToProcess));
+
+            tailInputPos += numSamplesToProcess;
+
+            if (tailInputPos == tailSize)
+            {
+                tailInputPos = 0;
+                startNextTailJob();
+            }
+
+            numSamplesProcessed += numSamplesToProcess;
+        }
+    }
+
+    /** Runs the pending tail job if there is one, and returns true in this case. This
+        is called by the background thread, and by the audio thread when the background
+        thread didn't have the time to start the job.
+
+        The job data belongs to whoever moves the state from pending to running, and
+        goes back to the audio thread when the state is released to idle, so the two
+        threads never touch it at the same time.
+    */
+    bool runPendingTailJob()
+    {
+        auto expected = (int) tailJobPending;
+
+        if (! tailJobState.compare_exchange_strong (expected, tailJobRunning, std::memory_order_acquire, std::memory_order_relaxed))
+            return false;
+
+        tailEngine->processUniformPartitions (tailJobData, tailJobData, tailSize);
+
+        tailJobState.store (tailJobIdle, std::memory_order_release);
+        return true;
+    }
+
+    /** The thread which processes the tail jobs. */
+    Thread* tailThread = nullptr;
+
+private:
+    //==============================================================================
+    enum { tailJobIdle = 0, tailJobPending, tailJobRunning };
+
+    /** Returns once the job data is back in the hands of the audio thread. */
+    void waitForTailJob()
+    {
+        if (! runPendingTailJob())
+            while (tailJobState.load (std::memory_order_acquire) == tailJobRunning)
+                Thread::yield();
+    }
+
+    void cancelTailJob()
+    {
+        auto expected = (int) tailJobPending;
+        tailJobState.compare_exchange_strong (expected, tailJobIdle, std::memory_order_acquire, std::memory_order_relaxed);
+
+        while (tailJobState.load (std::memory_order_acquire) == tailJobRunning)
+            Thread::yield();
+    }
+
+    void startNextTailJob()
+    {
+        waitForTailJob();
+
+        FloatVectorOperations::copy (bufferTailOutput.getWritePointer (0), tailJobData, static_cast<int> (tailSize));
+        FloatVectorOperations::copy (tailJobData, bufferTailInput.getReadPointer (0), static_cast<int> (tailSize));
+
+        // publishes the new job data along with the state
+        tailJobState.store (tailJobPending, std::memory_order_release);
+
+        if (tailThread != nullptr)
+            tailThread->notify();
+    }
+
+    /** Performs the uniform partitioned convolution using FFT. */
+    void processUniformPartitions (const float* input, float* output, size_t numSamples)
+    {
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
@@ -198,7 +596,7 @@ struct ConvolutionEngine
 
             // Forward FFT
             FFTobject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+            ConvolutionImpulseSpectra::prepareForConvolution (inputSegmentData, FFTSize);
 
             // Complex multiplication
             if (inputDataWasEmpty)
@@ -214,20 +612,20 @@ struct ConvolutionEngine
                     if (index >= numInputSegments)
                         index -= numInputSegments;
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (index)).getWritePointer (0),
-                                                        buffersImpulseSegments.getReference (static_cast<int> (i)).getWritePointer (0),
-                                                        outputTempData);
+                    ConvolutionImpulseSpectra::convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (index)).getReadPointer (0),
+                                                                                   impulseSpectra->segments.getReference (static_cast<int> (i)).getReadPointer (0),
+                                                                                   outputTempData, FFTSize);
                 }
             }
 
             FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
 
-            convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (currentSegment)).getWritePointer (0),
-                                                buffersImpulseSegments.getReference (0).getWritePointer (0),
-                                                outputData);
+            ConvolutionImpulseSpectra::convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (currentSegment)).getReadPointer (0),
+                                                                           impulseSpectra->segments.getReference (0).getReadPointer (0),
+                                                                           outputData, FFTSize);
 
             // Inverse FFT
-            updateSymmetricFrequencyDomainData (outputData);
+            ConvolutionImpulseSpectra::updateSymmetricFrequencyDomainData (outputData, FFTSize);
             FFTobject->performRealOnlyInverseTransform (outputData);
 
             // Add overlap
@@ -258,65 +656,27 @@ struct ConvolutionEngine
         }
     }
 
-    /** After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls. */
-    void prepareForConvolution (float *samples) noexcept
-    {
-        auto FFTSizeDiv2 = FFTSize / 2;
+    //==============================================================================
+    ScopedPointer<FFT> FFTobject;
 
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
-            samples[i] = samples[2 * i];
+    size_t FFTSize = 0;
+    size_t currentSegment = 0, numInputSegments = 0, numSegments = 0, blockSize = 0, inputDataPos = 0;
 
-        samples[FFTSizeDiv2] = 0;
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
+    Array<AudioBuffer<float>> buffersInputSegments;
+    ConvolutionImpulseSpectra::Ptr impulseSpectra;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[2 * (FFTSize - i) + 1];
-    }
+    SharedResourcePointer<ConvolutionImpulseSpectraCache> spectraCache;
 
-    /** Does the convolution operation itself only on half of the frequency domain samples. */
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
-    {
-        auto FFTSizeDiv2 = FFTSize / 2;
+    bool isReady = false;
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+    //==============================================================================
+    ScopedPointer<ConvolutionEngine> tailEngine;    // processes the end of the impulse response with larger partitions
+    size_t tailSize = 0, tailInputPos = 0;
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
-    }
-
-    /** Undo the re-organization of samples from the function prepareForConvolution.
-        Then, takes the conjugate of the frequency domain first half of samples, to fill the
-        second half, so that the inverse transform will return real samples in the time domain.
-    */
-    void updateSymmetricFrequencyDomainData (float* samples) noexcept
-    {
-        auto FFTSizeDiv2 = FFTSize / 2;
-
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-        {
-            samples[2 * (FFTSize - i)] = samples[i];
-            samples[2 * (FFTSize - i) + 1] = -samples[FFTSizeDiv2 + i];
-        }
-
-        samples[1] = 0.f;
-
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-        {
-            samples[2 * i] = samples[2 * (FFTSize - i)];
-            samples[2 * i + 1] = -samples[2 * (FFTSize - i) + 1];
-        }
-    }
-
-    //==============================================================================
-    ScopedPointer<FFT> FFTobject;
-
-    size_t FFTSize = 0;
-    size_t currentSegment = 0, numInputSegments = 0, numSegments = 0, blockSize = 0, inputDataPos = 0;
-
-    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    Array<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
-
-    bool isReady = false;
+    AudioBuffer<float> bufferTailInput, bufferTailOutput;
+    HeapBlock<float> tailJobData;               // only ever used by the owner of the current job state
+    std::atomic<int> tailJobState { tailJobIdle };
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionEngine)
@@ -341,6 +701,7 @@ public:
         changeImpulseResponseSize,
         changeStereo,
         changeTrimming,
+        changeNonUniformPartitioning,
         numChangeRequestTypes
     };
 
@@ -356,6 +717,11 @@ public:
         for (auto i = 0u; i < 4; ++i)
             engines.add (new ConvolutionEngine());
 
+        tailThread = new TailThread (engines);
+
+        for (auto* e : engines)
+            e->tailThread = tailThread;
+
         currentInfo.maximumBufferSize = 0;
         currentInfo.buffer = &impulseResponse;
     }
@@ -363,6 +729,15 @@ public:
     ~Pimpl()
     {
         stopThread (10000);
+        tailThread->stopThread (10000);
+    }
+
+    //==============================================================================
+    /** Starts the thread processing the tail partitions of the convolution engines. */
+    void startTailThread()
+    {
+        if (! tailThread->isThreadRunning())
+            tailThread->startThread (8);
     }
 
     //==============================================================================
@@ -605,6 +980,21 @@ public:
                 }
                 break;
 
+                case ChangeRequest::changeNonUniformPartitioning:
+                {
+                    auto* arrayParameters = requestParameters[n].getArray();
+                    bool newUseNonUniformPartitioning = arrayParameters->getUnchecked (0);
+                    int64 newTailPartitionSize = arrayParameters->getUnchecked (1);
+
+                    if (currentInfo.useNonUniformPartitioning != newUseNonUniformPartitioning
+                         || currentInfo.tailPartitionSize != (size_t) newTailPartitionSize)
+                        changeLevel = jmax (1, changeLevel);
+
+                    currentInfo.useNonUniformPartitioning = newUseNonUniformPartitioning;
+                    currentInfo.tailPartitionSize = (size_t) newTailPartitionSize;
+                }
+                break;
+
                 default:
                     jassertfalse;
                     break;
@@ -722,13 +1112,44 @@ public:
             {
                 mustInterpolate = false;
 
+                // the old engines are re-initialised before being used again
                 for (auto channel = 0; channel < 2; ++channel)
-                    engines[channel]->copyStateFromOtherEngine (*engines[channel + 2]);
+                    engines.swap (channel, channel + 2);
             }
         }
     }
 
 private:
+    //==============================================================================
+    /** Processes the pending tail jobs of the convolution engines in the background. */
+    struct TailThread  : public Thread
+    {
+        TailThread (const OwnedArray<ConvolutionEngine>& enginesToUse)  : Thread ("Convolution Tail")
+        {
+            for (auto* e : enginesToUse)
+                engines.add (e);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                auto didSomething = false;
+
+                for (auto* e : engines)
+                    if (e->runPendingTailJob())
+                        didSomething = true;
+
+                if (! didSomething)
+                    wait (-1);
+            }
+        }
+
+        Array<ConvolutionEngine*> engines;
+
+        JUCE_DECLARE_NON_COPYABLE (TailThread)
+    };
+
     //==============================================================================
     void run() override
     {
@@ -974,6 +1395,7 @@ private:
 
     //==============================================================================
     OwnedArray<ConvolutionEngine> engines;          // the 4 convolution engines being used
+    ScopedPointer<TailThread> tailThread;           // the thread processing the tail partitions of the engines
 
     AudioBuffer<float> interpolationBuffer;         // a buffer to do the interpolation between the convolution engines 0-1 and 2-3
     LinearSmoothedValue<float> changeVolumes[4];    // the volumes for each convolution engine during interpolation
@@ -1069,6 +1491,18 @@ void Convolution::copyAndLoadImpulseResponseFromBuffer (const AudioBuffer<float>
     pimpl->addToFifo (types, parameters, 3);
 }
 
+void Convolution::setNonUniformPartitioning (bool shouldUseNonUniformPartitioning, size_t tailPartitionSize)
+{
+    if (shouldUseNonUniformPartitioning)
+        pimpl->startTailThread();
+
+    Array<juce::var> parameters;
+    parameters.add (juce::var (shouldUseNonUniformPartitioning));
+    parameters.add (juce::var (static_cast<int64> (tailPartitionSize)));
+
+    pimpl->addToFifo (Pimpl::ChangeRequest::changeNonUniformPartitioning, juce::var (parameters));
+}
+
 void Convolution::prepare (const ProcessSpec& spec)
 {
     jassert (isPositiveAndBelow (spec.numChannels, static_cast<uint32> (3))); // only mono and stereo is supported
@@ -1146,5 +1580,531 @@ void Convolution::processSamples (const AudioBlock<float>& input, AudioBlock<flo
     }
 }
 
+//==============================================================================
+/** Processes several channels at the same time, doing only one forward FFT per
+    input channel and one inverse FFT per output channel, whatever the routing of
+    the impulse response partitions between them.
+*/
+struct MultichannelConvolution::Pimpl
+{
+    //==============================================================================
+    struct Engine
+    {
+        Engine (size_t maximumBufferSize, size_t numChannelsToUse)  : numChannels (numChannelsToUse)
+        {
+            blockSize = (size_t) nextPowerOfTwo ((int) maximumBufferSize);
+
+            FFTSize = blockSize > 128 ? 2 * blockSize
+                                      : 4 * blockSize;
+
+            FFTobject = new FFT (roundDoubleToInt (log2 (FFTSize)));
+
+            for (size_t i = 0; i < numChannels; ++i)
+            {
+                inputs.add (new InputChannel());
+                outputs.add (new OutputChannel());
+            }
+        }
+
+        /** Convolves an input channel with some impulse response partitions, and adds the result to an output channel. */
+        void addRoute (int input, int output, ConvolutionImpulseSpectra* spectra)
+        {
+            outputs.getUnchecked (output)->routes.add ({ input, spectra });
+            numSegments = jmax (numSegments, (size_t) spectra->segments.size());
+        }
+
+        /** Allocates the buffers, must be called once all the routes have been added. */
+        void initialise()
+        {
+            numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
+
+            for (auto* in : inputs)
+            {
+                in->buffer.setSize (1, static_cast<int> (FFTSize));
+
+                for (size_t i = 0; i < numInputSegments; ++i)
+                {
+                    AudioBuffer<float> newInputSegment;
+                    newInputSegment.setSize (1, static_cast<int> (FFTSize * 2));
+                    in->segments.add (newInputSegment);
+                }
+            }
+
+            for (auto* out : outputs)
+            {
+                out->bufferOutput.setSize     (1, static_cast<int> (FFTSize * 2));
+                out->bufferTempOutput.setSize (1, static_cast<int> (FFTSize * 2));
+                out->bufferOverlap.setSize    (1, static_cast<int> (FFTSize));
+            }
+
+            reset();
+        }
+
+        void reset()
+        {
+            for (auto* in : inputs)
+            {
+                in->buffer.clear();
+
+                for (auto& segment : in->segments)
+                    segment.clear();
+            }
+
+            for (auto* out : outputs)
+            {
+                out->bufferOutput.clear();
+                out->bufferTempOutput.clear();
+                out->bufferOverlap.clear();
+            }
+
+            currentSegment = 0;
+            inputDataPos = 0;
+        }
+
+        /** Performs the uniform partitioned convolution of all the channels. */
+        void processSamples (const AudioBlock<float>& input, AudioBlock<float>& output, size_t numSamples)
+        {
+            auto numChannelsToProcess = jmin (numChannels, input.getNumChannels(), output.getNumChannels());
+            auto indexStep = numInputSegments / numSegments;
+
+            size_t numSamplesProcessed = 0;
+
+            while (numSamplesProcessed < numSamples)
+            {
+                const bool inputDataWasEmpty = (inputDataPos == 0);
+                auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
+
+                // Forward FFT, done only once for each input channel
+                for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+                {
+                    auto& in = *inputs.getUnchecked (static_cast<int> (channel));
+                    auto* inputData = in.buffer.getWritePointer (0);
+
+                    FloatVectorOperations::copy (inputData + inputDataPos, input.getChannelPointer (channel) + numSamplesProcessed,
+                                                 static_cast<int> (numSamplesToProcess));
+
+                    auto* inputSegmentData = in.segments.getReference (static_cast<int> (currentSegment)).getWritePointer (0);
+                    FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (FFTSize));
+
+                    FFTobject->performRealOnlyForwardTransform (inputSegmentData);
+                    ConvolutionImpulseSpectra::prepareForConvolution (inputSegmentData, FFTSize);
+                }
+
+                for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+                {
+                    auto& out = *outputs.getUnchecked (static_cast<int> (channel));
+
+                    auto* outputTempData = out.bufferTempOutput.getWritePointer (0);
+                    auto* outputData     = out.bufferOutput.getWritePointer (0);
+                    auto* overlapData    = out.bufferOverlap.getWritePointer (0);
+
+                    // Complex multiplication, for each input channel contributing to this output
+                    if (inputDataWasEmpty)
+                    {
+                        FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (FFTSize + 1));
+
+                        for (auto& route : out.routes)
+                        {
+                            auto& inputSegments = inputs.getUnchecked (route.input)->segments;
+                            auto index = currentSegment;
+
+                            for (int i = 1; i < route.spectra->segments.size(); ++i)
+                            {
+                                index += indexStep;
+
+                                if (index >= numInputSegments)
+                                    index -= numInputSegments;
+
+                                ConvolutionImpulseSpectra::convolutionProcessingAndAccumulate (inputSegments.getReference (static_cast<int> (index)).getReadPointer (0),
+                                                                                               route.spectra->segments.getReference (i).getReadPointer (0),
+                                                                                               outputTempData, FFTSize);
+                            }
+                        }
+                    }
+
+                    FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
+
+                    for (auto& route : out.routes)
+                        ConvolutionImpulseSpectra::convolutionProcessingAndAccumulate (inputs.getUnchecked (route.input)->segments.getReference (static_cast<int> (currentSegment)).getReadPointer (0),
+                                                                                       route.spectra->segments.getReference (0).getReadPointer (0),
+                                                                                       outputData, FFTSize);
+
+                    // Inverse FFT
+                    ConvolutionImpulseSpectra::updateSymmetricFrequencyDomainData (outputData, FFTSize);
+                    FFTobject->performRealOnlyInverseTransform (outputData);
+
+                    // Add overlap
+                    auto* channelOutput = output.getChannelPointer (channel) + numSamplesProcessed;
+
+                    for (size_t i = 0; i < numSamplesToProcess; ++i)
+                        channelOutput[i] = outputData[inputDataPos + i] + overlapData[inputDataPos + i];
+
+                    if (inputDataPos + numSamplesToProcess == blockSize)
+                    {
+                        // Extra step for segSize > blockSize
+                        FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (FFTSize - 2 * blockSize));
+
+                        // Save the overlap
+                        FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (FFTSize - blockSize));
+                    }
+                }
+
+                // Input buffer full => Next block
+                inputDataPos += numSamplesToProcess;
+
+                if (inputDataPos == blockSize)
+                {
+                    for (auto* in : inputs)
+                        in->buffer.clear();
+
+                    inputDataPos = 0;
+
+                    currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+                }
+
+                numSamplesProcessed += numSamplesToProcess;
+            }
+        }
+
+        //==============================================================================
+        struct InputChannel
+        {
+            AudioBuffer<float> buffer;
+            Array<AudioBuffer<float>> segments;
+        };
+
+        struct Route
+        {
+            int input;
+            ConvolutionImpulseSpectra::Ptr spectra;
+        };
+
+        struct OutputChannel
+        {
+            AudioBuffer<float> bufferOutput, bufferTempOutput, bufferOverlap;
+            Array<Route> routes;
+        };
+
+        ScopedPointer<FFT> FFTobject;
+
+        size_t numChannels, FFTSize = 0, blockSize = 0;
+        size_t currentSegment = 0, numInputSegments = 0, numSegments = 1, inputDataPos = 0;
+
+        OwnedArray<InputChannel> inputs;
+        OwnedArray<OutputChannel> outputs;
+
+        JUCE_DECLARE_NON_COPYABLE (Engine)
+    };
+
+    //==============================================================================
+    Pimpl() = default;
+
+    //==============================================================================
+    void prepare (const ProcessSpec& newSpec)
+    {
+        const ScopedLock sl (loadingLock);
+
+        spec = newSpec;
+        isPrepared = true;
+
+        prepareEngine();
+    }
+
+    bool loadImpulseResponse (const File& file, size_t maximumSize)
+    {
+        const ScopedLock sl (loadingLock);
+
+        sourceFile = file;
+        sourceBuffer.setSize (0, 0);
+        sourceSampleRate = 0;
+        sourceMaximumSize = maximumSize;
+
+        return prepareEngine();
+    }
+
+    void copyAndLoadImpulseResponseFromBuffer (const AudioBuffer<float>& buffer, double bufferSampleRate, size_t maximumSize)
+    {
+        const ScopedLock sl (loadingLock);
+
+        sourceFile = File();
+        sourceBuffer.makeCopyOf (buffer);
+        sourceSampleRate = bufferSampleRate;
+        sourceMaximumSize = maximumSize;
+
+        prepareEngine();
+    }
+
+    //==============================================================================
+    void reset() noexcept
+    {
+        if (engine != nullptr)
+            engine->reset();
+    }
+
+    void processSamples (const AudioBlock<float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+    {
+        {
+            const GenericScopedTryLock<SpinLock> sl (engineLock);
+
+            if (sl.isLocked() && pendingEngine != nullptr)
+            {
+                jassert (oldEngine == nullptr);
+
+                oldEngine = engine.release();
+                engine = pendingEngine.release();
+            }
+        }
+
+        auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+        if (engine == nullptr || isBypassed)
+        {
+            if (input.getChannelPointer (0) != output.getChannelPointer (0))
+                output.copy (input);
+
+            return;
+        }
+
+        engine->processSamples (input, output, numSamples);
+    }
+
+private:
+    //==============================================================================
+    /** Creates a new engine for the current settings and impulse response, and
+        hands it over to the audio thread.
+    */
+    bool prepareEngine()
+    {
+        if (! isPrepared || (sourceFile == File() && sourceBuffer.getNumChannels() == 0))
+            return true;
+
+        ScopedPointer<Engine> newEngine = new Engine (spec.maximumBlockSize, spec.numChannels);
+
+        Array<ConvolutionImpulseSpectra::Ptr> spectra;
+
+        if (! createImpulseSpectra (spectra, newEngine->blockSize, newEngine->FFTSize))
+            return false;
+
+        auto numChannels = static_cast<int> (spec.numChannels);
+
+        for (int input = 0; input < numChannels; ++input)
+            for (int output = 0; output < numChannels; ++output)
+                if (auto* s = spectra[getImpulseResponseChannel (spectra.size(), numChannels, input, output)].get())
+                    newEngine->addRoute (input, output, s);
+
+        newEngine->initialise();
+
+        ScopedPointer<Engine> previousPendingEngine, previousEngine;
+
+        {
+            const SpinLock::ScopedLockType sl (engineLock);
+
+            previousPendingEngine = pendingEngine.release();
+            previousEngine = oldEngine.release();
+            pendingEngine = newEngine.release();
+        }
+
+        return true;
+    }
+
+    /** Returns the impulse response channel going from an input to an output, or -1 if there isn't any. */
+    static int getImpulseResponseChannel (int numImpulseResponseChannels, int numChannels, int input, int output) noexcept
+    {
+        if (numImpulseResponseChannels == numChannels * numChannels)
+            return input * numChannels + output;
+
+        if (input != output || numImpulseResponseChannels == 0)
+            return -1;
+
+        return input % numImpulseResponseChannels;
+    }
+
+    String getImpulseSpectraKey (int channel, size_t blockSize) const
+    {
+        return "MultichannelConvolution:" + sourceFile.getFullPathName()
+                 + ":" + String (sourceFile.getLastModificationTime().toMilliseconds())
+                 + ":" + String (spec.sampleRate)
+                 + ":" + String ((int64) sourceMaximumSize)
+                 + ":" + String (channel)
+                 + ":" + String ((int64) blockSize);
+    }
+
+    /** Fills an array with the partitions of each channel of the impulse response,
+        using the ones in the cache when the impulse response comes from a file which
+        has already been loaded by another engine with the same settings.
+    */
+    bool createImpulseSpectra (Array<ConvolutionImpulseSpectra::Ptr>& spectra, size_t blockSize, size_t FFTSize)
+    {
+        if (sourceFile == File())
+        {
+            createImpulseSpectraFromBuffer (spectra, sourceBuffer, sourceSampleRate, blockSize, FFTSize, false);
+            return true;
+        }
+
+        AudioFormatManager manager;
+        manager.registerBasicFormats();
+
+        ScopedPointer<AudioFormatReader> formatReader (manager.createReaderFor (sourceFile));
+
+        if (formatReader == nullptr)
+            return false;
+
+        for (int channel = 0; channel < (int) formatReader->numChannels; ++channel)
+        {
+            auto cached = spectraCache->find (getImpulseSpectraKey (channel, blockSize));
+
+            if (cached == nullptr)
+            {
+                spectra.clear();
+                break;
+            }
+
+            spectra.add (cached);
+        }
+
+        if (spectra.isEmpty())
+        {
+            auto length = formatReader->lengthInSamples;
+
+            if (sourceMaximumSize > 0)
+                length = jmin (length, (int64) std::ceil ((double) sourceMaximumSize * formatReader->sampleRate / spec.sampleRate) + 1);
+
+            AudioBuffer<float> buffer ((int) formatReader->numChannels, (int) length);
+            formatReader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+
+            createImpulseSpectraFromBuffer (spectra, buffer, formatReader->sampleRate, blockSize, FFTSize, true);
+        }
+
+        return true;
+    }
+
+    /** Resamples, resizes and normalizes an impulse response, then creates its partitions. */
+    void createImpulseSpectraFromBuffer (Array<ConvolutionImpulseSpectra::Ptr>& spectra, const AudioBuffer<float>& buffer,
+                                         double bufferSampleRate, size_t blockSize, size_t FFTSize, bool addToCache)
+    {
+        auto numChannels = buffer.getNumChannels();
+        AudioBuffer<float> impulseResponse;
+
+        if (bufferSampleRate == spec.sampleRate)
+        {
+            impulseResponse.makeCopyOf (buffer);
+        }
+        else
+        {
+            auto factorReading = bufferSampleRate / spec.sampleRate;
+            impulseResponse.setSize (numChannels, roundToInt (buffer.getNumSamples() / factorReading));
+
+            AudioBuffer<float> original (buffer);
+            MemoryAudioSource memorySource (original, false);
+            ResamplingAudioSource resamplingSource (&memorySource, false, numChannels);
+
+            resamplingSource.setResamplingRatio (factorReading);
+            resamplingSource.prepareToPlay (impulseResponse.getNumSamples(), spec.sampleRate);
+
+            AudioSourceChannelInfo info (impulseResponse);
+            resamplingSource.getNextAudioBlock (info);
+        }
+
+        auto numSamples = impulseResponse.getNumSamples();
+
+        if (sourceMaximumSize > 0)
+            numSamples = jmin (numSamples, static_cast<int> (sourceMaximumSize));
+
+        // all the channels get the same gain so that the balance between them is kept
+        auto magnitude = 0.0f;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* samples = impulseResponse.getReadPointer (channel);
+            auto channelMagnitude = 0.0f;
+
+            for (int i = 0; i < numSamples; ++i)
+                channelMagnitude += samples[i] * samples[i];
+
+            magnitude = jmax (magnitude, channelMagnitude);
+        }
+
+        if (magnitude > 0.0f)
+            impulseResponse.applyGain (1.0f / (4.0f * std::sqrt (magnitude)) * 0.5f);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* newSpectra = new ConvolutionImpulseSpectra (impulseResponse.getReadPointer (channel), (size_t) numSamples, blockSize, FFTSize);
+            spectra.add (newSpectra);
+
+            if (addToCache)
+            {
+                newSpectra->key = getImpulseSpectraKey (channel, blockSize);
+                spectraCache->add (newSpectra);
+            }
+        }
+    }
+
+    //==============================================================================
+    ProcessSpec spec;
+    bool isPrepared = false;
+
+    CriticalSection loadingLock;                    // protects the source of the impulse response
+    File sourceFile;                                // the impulse response file, if loaded from a file
+    AudioBuffer<float> sourceBuffer;                // the impulse response, if loaded from a buffer
+    double sourceSampleRate = 0;
+    size_t sourceMaximumSize = 0;
+
+    SharedResourcePointer<ConvolutionImpulseSpectraCache> spectraCache;
+
+    SpinLock engineLock;                            // protects the handover of the engines to the audio thread
+    ScopedPointer<Engine> engine;                   // the engine used by the audio thread
+    ScopedPointer<Engine> pendingEngine;            // a new engine that the audio thread will start using
+    ScopedPointer<Engine> oldEngine;                // the previous engine, deleted by the next loading
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+MultichannelConvolution::MultichannelConvolution()  : pimpl (new Pimpl())
+{
+}
+
+MultichannelConvolution::~MultichannelConvolution()
+{
+}
+
+void MultichannelConvolution::prepare (const ProcessSpec& spec)
+{
+    pimpl->prepare (spec);
+}
+
+void MultichannelConvolution::reset() noexcept
+{
+    pimpl->reset();
+}
+
+bool MultichannelConvolution::loadImpulseResponse (const File& fileImpulseResponse, size_t maximumSize)
+{
+    if (! fileImpulseResponse.existsAsFile())
+        return false;
+
+    return pimpl->loadImpulseResponse (fileImpulseResponse, maximumSize);
+}
+
+void MultichannelConvolution::copyAndLoadImpulseResponseFromBuffer (const AudioBuffer<float>& buffer, double bufferSampleRate,
+                                                                    size_t maximumSize)
+{
+    jassert (bufferSampleRate > 0);
+
+    if (buffer.getNumSamples() == 0)
+        return;
+
+    pimpl->copyAndLoadImpulseResponseFromBuffer (buffer, bufferSampleRate, maximumSize);
+}
+
+void MultichannelConvolution::processSamples (const AudioBlock<float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+{
+    jassert (input.getNumChannels() == output.getNumChannels());
+
+    pimpl->processSamples (input, output, isBypassed);
+}
+
 } // namespace dsp
 } // namespace juce
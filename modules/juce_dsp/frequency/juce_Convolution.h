@@ -31,7 +31,8 @@ namespace dsp
 
 /**
     Performs stereo uniform-partitioned convolution of an input signal with an
-    impulse response in the frequency domain, using the juce FFT class.
+    impulse response in the frequency domain, using the juce FFT class. A
+    non-uniform partitioned mode is available as well for long impulse responses.
 
     It provides some thread-safe functions to load impulse responses as well,
     from audio files or memory on the fly without any noticeable artefacts,
@@ -122,6 +123,26 @@ public:
     void copyAndLoadImpulseResponseFromBuffer (const AudioBuffer<float>& buffer, double bufferSampleRate,
                                                bool wantsStereo, bool wantsTrimming, size_t size);
 
+    //==============================================================================
+    /** Enables or disables the non-uniform partitioned convolution mode.
+
+        In this mode, only the beginning of the impulse response is processed with
+        partitions of the size of the audio blocks. The rest of it is processed
+        with much larger partitions on a background thread, which is a lot more
+        efficient for long impulse responses, like the ones used for reverbs, while
+        keeping the latency at zero.
+
+        If the background thread doesn't manage to finish its work in time, the
+        audio thread will wait for it, so this mode works best when there is some
+        spare CPU for it.
+
+        @param shouldUseNonUniformPartitioning  enables or disables the mode
+        @param tailPartitionSize                the size of the tail partitions, rounded up to
+                                                a power of two. If this is zero, a size is chosen
+                                                depending on the maximum buffer size.
+    */
+    void setNonUniformPartitioning (bool shouldUseNonUniformPartitioning, size_t tailPartitionSize = 0);
+
 private:
     //==============================================================================
     struct Pimpl;
@@ -141,5 +162,99 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Convolution)
 };
 
+//==============================================================================
+/**
+    Performs multichannel uniform-partitioned convolution of an input signal with
+    an impulse response in the frequency domain, using the juce FFT class.
+
+    The channels of the impulse response are routed depending on their number,
+    for N channels being processed :
+    - with one channel, every channel is convolved with the same impulse response
+    - with N channels, every channel is convolved with its own impulse response
+    - with N * N channels, the impulse response is a matrix, the channel
+      (input * N + output) going from the input to the output channel. With N = 2,
+      this gives the usual true-stereo layout LL, LR, RL, RR.
+
+    Whatever the routing, every input channel goes through a single forward FFT, whose
+    result is used by all the output channels it contributes to. The frequency domain
+    partitions of the impulse responses are also shared between channels and between
+    all the instances using the same impulse response file at the same sample rate
+    and maximum buffer size.
+
+    Unlike the Convolution class, a new impulse response is loaded synchronously on
+    the calling thread, and replaces the previous one without any crossfade the next
+    time the audio thread processes a block.
+
+    @see Convolution
+*/
+class JUCE_API  MultichannelConvolution
+{
+public:
+    //==============================================================================
+    /** Initialises an object for performing multichannel convolution. */
+    MultichannelConvolution();
+
+    /** Destructor. */
+    ~MultichannelConvolution();
+
+    //==============================================================================
+    /** Must be called before processing, to provide the number of channels, the
+        maximumBufferSize to handle, and the sample rate used for the resampling
+        of the impulse response. Any impulse response already loaded is then
+        prepared again for the new settings.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the processing pipeline, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Performs the convolution on the given set of samples. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, float>::value,
+                       "Convolution engine only supports single precision floating point data");
+
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+    //==============================================================================
+    /** Loads an impulse response from an audio file on any drive. It can load any of
+        the audio formats registered in JUCE, and performs resampling if needed.
+
+        This function mustn't be called from the audio thread.
+
+        @param fileImpulseResponse      the location of the audio file
+        @param maximumSize              the maximum size for the impulse response, or
+                                        zero to use the whole file
+        @returns true if the file could be read
+    */
+    bool loadImpulseResponse (const File& fileImpulseResponse, size_t maximumSize = 0);
+
+    /** Loads an impulse response from an audio buffer, which is copied before doing
+        anything else. Performs resampling if needed.
+
+        This function mustn't be called from the audio thread.
+
+        @param buffer                   the AudioBuffer to use
+        @param bufferSampleRate         the sampleRate of the data in the AudioBuffer
+        @param maximumSize              the maximum size for the impulse response, or
+                                        zero to use the whole buffer
+    */
+    void copyAndLoadImpulseResponseFromBuffer (const AudioBuffer<float>& buffer, double bufferSampleRate,
+                                               size_t maximumSize = 0);
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    ScopedPointer<Pimpl> pimpl;
+
+    //==============================================================================
+    void processSamples (const AudioBlock<float>&, AudioBlock<float>&, bool isBypassed) noexcept;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultichannelConvolution)
+};
+
 } // namespace dsp
 } // namespace juce
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class ConvolutionTest  : public UnitTest
+{
+public:
+    ConvolutionTest() : UnitTest ("Convolution") {}
+
+    /** Stands in for the Convolution's own tail thread, but only tries to run a tail
+        job when the test asks it to, so that the jobs handed over to it and the ones left
+        to the audio thread don't depend on how the threads get scheduled. */
+    struct TestTailThread  : public Thread
+    {
+        TestTailThread (ConvolutionEngine& e)  : Thread ("Convolution Test Tail"), engine (e)
+        {
+            engine.tailThread = this;
+            startThread (8);
+        }
+
+        ~TestTailThread()
+        {
+            signalThreadShouldExit();
+            stepRequested.signal();
+            stopThread (4000);
+            engine.tailThread = nullptr;
+        }
+
+        /** Runs the pending tail job on this thread if there is one, and returns true in this case. */
+        bool runOneJob()
+        {
+            stepRequested.signal();
+            stepFinished.wait (-1);
+            return lastStepRanJob;
+        }
+
+        void run() override
+        {
+            for (;;)
+            {
+                stepRequested.wait (-1);
+
+                if (threadShouldExit())
+                    return;
+
+                lastStepRanJob = engine.runPendingTailJob();
+
+                if (lastStepRanJob)
+                    ++numJobsRun;
+
+                stepFinished.signal();
+            }
+        }
+
+        ConvolutionEngine& engine;
+        WaitableEvent stepRequested, stepFinished;
+        bool lastStepRanJob = false;
+        int numJobsRun = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (TestTailThread)
+    };
+
+    static AudioBuffer<float> createImpulseResponse (int numSamples, Random& random)
+    {
+        AudioBuffer<float> ir (1, numSamples);
+
+        // a decaying noise burst, like a reverb's, so the tail matters but is quieter
+        for (int i = 0; i < numSamples; ++i)
+            ir.setSample (0, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp (-3.0f * (float) i / (float) numSamples));
+
+        lowPass (ir);
+        return ir;
+    }
+
+    /** The engine drops the Nyquist bin of its FFTs, so the test signals are kept away
+        from it, and the tolerance allows for what leaks there at the partition edges. */
+    static void lowPass (AudioBuffer<float>& buffer)
+    {
+        auto* data = buffer.getWritePointer (0);
+
+        for (int pass = 0; pass < 3; ++pass)
+            for (int i = buffer.getNumSamples(); --i > 0;)
+                data[i] = 0.5f * (data[i] + data[i - 1]);
+    }
+
+    static HeapBlock<double> convolveDirectly (const AudioBuffer<float>& input, const AudioBuffer<float>& ir)
+    {
+        const int numSamples = input.getNumSamples();
+        HeapBlock<double> result ((size_t) numSamples, true);
+
+        auto* x = input.getReadPointer (0);
+        auto* h = ir.getReadPointer (0);
+
+        for (int n = 0; n < numSamples; ++n)
+            for (int k = 0; k < jmin (n + 1, ir.getNumSamples()); ++k)
+                result[n] += (double) h[k] * (double) x[n - k];
+
+        return result;
+    }
+
+    static ConvolutionEngine::ProcessingInformation createProcessingInformation (AudioBuffer<float>& ir, size_t maximumBlockSize)
+    {
+        ConvolutionEngine::ProcessingInformation info;
+        info.sourceType = ConvolutionEngine::ProcessingInformation::SourceType::sourceAudioBuffer;
+        info.buffer = &ir;
+        info.sampleRate = 44100.0;
+        info.bufferSampleRate = 44100.0;
+        info.wantsStereo = false;
+        info.wantsTrimming = false;
+        info.impulseResponseSize = (size_t) ir.getNumSamples();
+        info.maximumBufferSize = maximumBlockSize;
+        return info;
+    }
+
+    /** Convolves some random input in random sized blocks, and checks the result against a direct convolution. */
+    void expectConvolvesCorrectly (ConvolutionEngine& engine, const AudioBuffer<float>& ir, size_t maximumBlockSize,
+                                   Random& random, TestTailThread* tailThread)
+    {
+        const int numSamples = 8000;
+        AudioBuffer<float> input (1, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+        lowPass (input);
+        auto expected = convolveDirectly (input, ir);
+
+        AudioBuffer<float> output (1, numSamples);
+
+        for (int start = 0, block = 0; start < numSamples; ++block)
+        {
+            auto num = jmin (1 + random.nextInt ((int) maximumBlockSize), numSamples - start);
+            engine.processSamples (input.getReadPointer (0, start), output.getWritePointer (0, start), (size_t) num);
+            start += num;
+
+            // the tail thread only picks up the jobs after every other block, which leaves
+            // some of them for the audio thread to run when the next one is due
+            if (tailThread != nullptr && (block % 2) == 0)
+                tailThread->runOneJob();
+        }
+
+        double maxError = 0, maxValue = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            maxError = jmax (maxError, std::abs ((double) output.getSample (0, i) - expected[i]));
+            maxValue = jmax (maxValue, std::abs (expected[i]));
+        }
+
+        expect (maxError < 1.0e-3 * maxValue, "Maximum error " + String (maxError) + " for a peak of " + String (maxValue));
+    }
+
+    void runNonUniformTest (bool useTailThread, size_t maximumBlockSize, size_t tailPartitionSize)
+    {
+        auto random = getRandom();
+        auto ir = createImpulseResponse (3000, random);
+
+        auto info = createProcessingInformation (ir, maximumBlockSize);
+        info.useNonUniformPartitioning = true;
+        info.tailPartitionSize = tailPartitionSize;
+
+        ConvolutionEngine engine;
+        engine.initializeConvolutionEngine (info, 0);
+
+        // without a thread, every tail job is run by the audio thread when the next one is due
+        ScopedPointer<TestTailThread> tailThread (useTailThread ? new TestTailThread (engine) : nullptr);
+
+        expectConvolvesCorrectly (engine, ir, maximumBlockSize, random, tailThread);
+
+        if (tailThread != nullptr)
+            expect (tailThread->numJobsRun > 0);
+    }
+
+    /** Loads two different impulse responses of the same size from the same memory, one after
+        the other, while the first one is still in use, so its partitions are in the cache. */
+    void runBinaryDataReloadTest()
+    {
+        auto random = getRandom();
+        const int irSize = 2000;
+        const size_t maximumBlockSize = 256;
+
+        auto firstIR  = createImpulseResponse (irSize, random);
+        auto secondIR = createImpulseResponse (irSize, random);
+
+        HeapBlock<float> binaryData ((size_t) irSize);
+
+        auto loadFromBinaryData = [&] (ConvolutionEngine& engine, AudioBuffer<float>& ir)
+        {
+            FloatVectorOperations::copy (binaryData, ir.getReadPointer (0), irSize);
+
+            auto info = createProcessingInformation (ir, maximumBlockSize);
+            info.sourceType = ConvolutionEngine::ProcessingInformation::SourceType::sourceBinaryData;
+            info.sourceData = binaryData;
+            info.sourceDataSize = (size_t) irSize * sizeof (float);
+
+            engine.initializeConvolutionEngine (info, 0);
+        };
+
+        ConvolutionEngine firstEngine, secondEngine;
+        loadFromBinaryData (firstEngine, firstIR);
+        loadFromBinaryData (secondEngine, secondIR);
+
+        expectConvolvesCorrectly (firstEngine, firstIR, maximumBlockSize, random, nullptr);
+        expectConvolvesCorrectly (secondEngine, secondIR, maximumBlockSize, random, nullptr);
+    }
+
+    void runTest() override
+    {
+        for (auto tailPartitionSize : { 256, 1024 })
+        {
+            beginTest ("Non-uniform partitioning with a tail thread, tail partitions of " + String (tailPartitionSize));
+            runNonUniformTest (true, 64, (size_t) tailPartitionSize);
+            runNonUniformTest (true, 200, (size_t) tailPartitionSize);
+
+            beginTest ("Non-uniform partitioning on the audio thread, tail partitions of " + String (tailPartitionSize));
+            runNonUniformTest (false, 64, (size_t) tailPartitionSize);
+            runNonUniformTest (false, 200, (size_t) tailPartitionSize);
+        }
+
+        beginTest ("Reloading binary data with the same size");
+        runBinaryDataReloadTest();
+    }
+};
+
+static ConvolutionTest convolutionTest;
+
+} // namespace dsp
+} // namespace juce
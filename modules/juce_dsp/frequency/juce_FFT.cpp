@@ -35,6 +35,27 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // The batched versions simply loop over the single transforms, unless the
+    // engine can do better than that
+    virtual void performMultiple (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                                  int numTransforms, bool inverse) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            perform (inputs[i], outputs[i], inverse);
+    }
+
+    virtual void performRealOnlyForwardTransforms (float* const* inputOutputData, int numTransforms, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performRealOnlyForwardTransform (inputOutputData[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransforms (float* const* inputOutputData, int numTransforms) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performRealOnlyInverseTransform (inputOutputData[i]);
+    }
 };
 
 struct FFT::Engine
@@ -104,6 +125,22 @@ struct FFTFallback  : public FFT::Instance
         configInverse = new FFTConfig (1 << order, true);
 
         size = 1 << order;
+
+        if (size >= minSizeForHalfSizeRealTransform)
+        {
+            const int halfSize = size >> 1;
+
+            configHalfForward = new FFTConfig (halfSize, false);
+            configHalfInverse = new FFTConfig (halfSize, true);
+
+            realTwiddles.malloc ((size_t) halfSize);
+
+            for (int i = 0; i < halfSize; ++i)
+            {
+                const double phase = -2.0 * double_Pi * i / (double) size;
+                realTwiddles[i] = { (float) std::cos (phase), (float) std::sin (phase) };
+            }
+        }
     }
 
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
@@ -135,7 +172,7 @@ struct FFTFallback  : public FFT::Instance
 
     const size_t maxFFTScratchSpaceToAlloca = 256 * 1024;
 
-    void performRealOnlyForwardTransform (float* d, bool) const noexcept override
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
     {
         if (size == 1)
             return;
@@ -144,12 +181,12 @@ struct FFTFallback  : public FFT::Instance
 
         if (scratchSize < maxFFTScratchSpaceToAlloca)
         {
-            performRealOnlyForwardTransform (static_cast<Complex<float>*> (alloca (scratchSize)), d);
+            performRealOnlyForwardTransform (static_cast<Complex<float>*> (alloca (scratchSize)), d, ignoreNegativeFreqs);
         }
         else
         {
             HeapBlock<char> heapSpace (scratchSize);
-            performRealOnlyForwardTransform (reinterpret_cast<Complex<float>*> (heapSpace.getData()), d);
+            performRealOnlyForwardTransform (reinterpret_cast<Complex<float>*> (heapSpace.getData()), d, ignoreNegativeFreqs);
         }
     }
 
@@ -171,32 +208,311 @@ struct FFTFallback  : public FFT::Instance
         }
     }
 
-    void performRealOnlyForwardTransform (Complex<float>* scratch, float* d) const noexcept
+    // Real transforms of this size or more are done by packing the even and odd samples
+    // into a complex transform of half the size, and then separating the two spectra.
+    static constexpr int minSizeForHalfSizeRealTransform = 4;
+
+    void performRealOnlyForwardTransform (Complex<float>* scratch, float* d, bool ignoreNegativeFreqs) const noexcept
     {
-        for (int i = 0; i < size; ++i)
+        if (size < minSizeForHalfSizeRealTransform)
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                scratch[i].real (d[i]);
+                scratch[i].imag (0);
+            }
+
+            perform (scratch, reinterpret_cast<Complex<float>*> (d), false);
+            return;
+        }
+
+        const int halfSize = size >> 1;
+        auto* output = reinterpret_cast<Complex<float>*> (d);
+
         {
-            scratch[i].real (d[i]);
-            scratch[i].imag (0);
+            const SpinLock::ScopedLockType sl (processLock);
+            configHalfForward->perform (reinterpret_cast<const Complex<float>*> (d), scratch);
         }
 
-        perform (scratch, reinterpret_cast<Complex<float>*> (d), false);
+        output[0]        = { scratch[0].real() + scratch[0].imag(), 0.0f };
+        output[halfSize] = { scratch[0].real() - scratch[0].imag(), 0.0f };
+
+        for (int i = 1; i < halfSize; ++i)
+        {
+            auto z  = scratch[i];
+            auto zc = std::conj (scratch[halfSize - i]);
+
+            auto even = (z + zc) * 0.5f;
+            auto odd  = (z - zc) * Complex<float> (0.0f, -0.5f);
+
+            output[i] = even + realTwiddles[i] * odd;
+        }
+
+        if (! ignoreNegativeFreqs)
+            for (int i = 1; i < halfSize; ++i)
+                output[size - i] = std::conj (output[i]);
     }
 
     void performRealOnlyInverseTransform (Complex<float>* scratch, float* d) const noexcept
     {
         auto* input = reinterpret_cast<Complex<float>*> (d);
 
-        for (auto i = size >> 1; i < size; ++i)
-            input[i] = std::conj (input[size - i]);
+        if (size < minSizeForHalfSizeRealTransform)
+        {
+            for (auto i = size >> 1; i < size; ++i)
+                input[i] = std::conj (input[size - i]);
+
+            perform (input, scratch, true);
+
+            for (int i = 0; i < size; ++i)
+            {
+                d[i] = scratch[i].real();
+                d[i + size] = scratch[i].imag();
+            }
+
+            return;
+        }
+
+        const int halfSize = size >> 1;
+
+        for (int i = 0; i < halfSize; ++i)
+        {
+            auto x  = input[i];
+            auto xc = std::conj (input[halfSize - i]);
+
+            auto even = (x + xc) * 0.5f;
+            auto odd  = (x - xc) * std::conj (realTwiddles[i]) * 0.5f;
+
+            scratch[i] = { even.real() - odd.imag(), even.imag() + odd.real() };
+        }
+
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+            configHalfInverse->perform (scratch, input);
+        }
+
+        FloatVectorOperations::multiply (d, 1.0f / (float) halfSize, size);
+        FloatVectorOperations::clear (d + size, size);
+    }
+
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    // The batched transforms are done by groups of transforms, each one of them
+    // using its own lane of a SIMDRegister, which the butterflies process at once.
+    using Lanes = SIMDRegister<float>;
+
+    struct ComplexLanes
+    {
+        Lanes re, im;
+
+        Lanes real() const noexcept                 { return re; }
+        Lanes imag() const noexcept                 { return im; }
+        void real (Lanes newValue) noexcept         { re = newValue; }
+        void imag (Lanes newValue) noexcept         { im = newValue; }
+
+        ComplexLanes operator* (Complex<float> w) const noexcept
+        {
+            return { re * w.real() - im * w.imag(),
+                     re * w.imag() + im * w.real() };
+        }
+
+        ComplexLanes operator- (ComplexLanes other) const noexcept  { return { re - other.re, im - other.im }; }
+        ComplexLanes& operator+= (ComplexLanes other) noexcept      { re += other.re; im += other.im; return *this; }
+        ComplexLanes& operator-= (ComplexLanes other) noexcept      { re -= other.re; im -= other.im; return *this; }
+        ComplexLanes& operator*= (Complex<float> w) noexcept        { return *this = *this * w; }
+    };
+
+    static constexpr int numLanes = (int) Lanes::SIMDNumElements;
+
+    void performMultiple (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                          int numTransforms, bool inverse) const noexcept override
+    {
+        if (size == 1)
+        {
+            for (int i = 0; i < numTransforms; ++i)
+                *outputs[i] = *inputs[i];
+
+            return;
+        }
+
+        withLanesScratch ([=] (ComplexLanes* scratchIn, ComplexLanes* scratchOut)
+        {
+            forEachGroup (numTransforms, [=] (int first, int numInGroup)
+            {
+                for (int n = 0; n < size; ++n)
+                {
+                    ComplexLanes c { Lanes::expand (0.0f), Lanes::expand (0.0f) };
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        c.re[(size_t) lane] = inputs[first + lane][n].real();
+                        c.im[(size_t) lane] = inputs[first + lane][n].imag();
+                    }
+
+                    scratchIn[n] = c;
+                }
+
+                performLanes (scratchIn, scratchOut, inverse);
+
+                for (int lane = 0; lane < numInGroup; ++lane)
+                {
+                    auto* output = outputs[first + lane];
+
+                    for (int n = 0; n < size; ++n)
+                        output[n] = { scratchOut[n].re[(size_t) lane], scratchOut[n].im[(size_t) lane] };
+                }
+            },
+            [=] (int index) { perform (inputs[index], outputs[index], inverse); });
+        });
+    }
+
+    void performRealOnlyForwardTransforms (float* const* inputOutputData, int numTransforms, bool) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        withLanesScratch ([=] (ComplexLanes* scratchIn, ComplexLanes* scratchOut)
+        {
+            forEachGroup (numTransforms, [=] (int first, int numInGroup)
+            {
+                for (int n = 0; n < size; ++n)
+                {
+                    ComplexLanes c { Lanes::expand (0.0f), Lanes::expand (0.0f) };
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                        c.re[(size_t) lane] = inputOutputData[first + lane][n];
+
+                    scratchIn[n] = c;
+                }
+
+                performLanes (scratchIn, scratchOut, false);
+
+                for (int lane = 0; lane < numInGroup; ++lane)
+                {
+                    auto* d = inputOutputData[first + lane];
+
+                    for (int n = 0; n < size; ++n)
+                    {
+                        d[2 * n]     = scratchOut[n].re[(size_t) lane];
+                        d[2 * n + 1] = scratchOut[n].im[(size_t) lane];
+                    }
+                }
+            },
+            [=] (int index) { performRealOnlyForwardTransform (inputOutputData[index], false); });
+        });
+    }
+
+    void performRealOnlyInverseTransforms (float* const* inputOutputData, int numTransforms) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        withLanesScratch ([=] (ComplexLanes* scratchIn, ComplexLanes* scratchOut)
+        {
+            forEachGroup (numTransforms, [=] (int first, int numInGroup)
+            {
+                for (int lane = 0; lane < numInGroup; ++lane)
+                {
+                    auto* input = reinterpret_cast<Complex<float>*> (inputOutputData[first + lane]);
+
+                    for (auto i = size >> 1; i < size; ++i)
+                        input[i] = std::conj (input[size - i]);
+                }
+
+                for (int n = 0; n < size; ++n)
+                {
+                    ComplexLanes c { Lanes::expand (0.0f), Lanes::expand (0.0f) };
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        auto* d = inputOutputData[first + lane];
 
-        perform (input, scratch, true);
+                        c.re[(size_t) lane] = d[2 * n];
+                        c.im[(size_t) lane] = d[2 * n + 1];
+                    }
 
-        for (int i = 0; i < size; ++i)
+                    scratchIn[n] = c;
+                }
+
+                performLanes (scratchIn, scratchOut, true);
+
+                for (int lane = 0; lane < numInGroup; ++lane)
+                {
+                    auto* d = inputOutputData[first + lane];
+
+                    for (int n = 0; n < size; ++n)
+                    {
+                        d[n]        = scratchOut[n].re[(size_t) lane];
+                        d[n + size] = scratchOut[n].im[(size_t) lane];
+                    }
+                }
+            },
+            [=] (int index) { performRealOnlyInverseTransform (inputOutputData[index]); });
+        });
+    }
+
+    void performLanes (const ComplexLanes* input, ComplexLanes* output, bool inverse) const noexcept
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        if (inverse)
         {
-            d[i] = scratch[i].real();
-            d[i + size] = scratch[i].imag();
+            configInverse->perform (input, output);
+
+            const float scaleFactor = 1.0f / size;
+
+            for (int i = 0; i < size; ++i)
+            {
+                output[i].re *= scaleFactor;
+                output[i].im *= scaleFactor;
+            }
+        }
+        else
+        {
+            configForward->perform (input, output);
+        }
+    }
+
+    /** Calls a function for each group of transforms which can be done at once, or
+        for the transforms left on their own.
+    */
+    template <typename GroupFunction, typename SingleFunction>
+    static void forEachGroup (int numTransforms, GroupFunction&& processGroup, SingleFunction&& processSingle)
+    {
+        for (int first = 0; first < numTransforms; first += numLanes)
+        {
+            auto numInGroup = jmin (numLanes, numTransforms - first);
+
+            if (numInGroup == 1)
+                processSingle (first);
+            else
+                processGroup (first, numInGroup);
+        }
+    }
+
+    /** Calls a function with two SIMD aligned scratch buffers of size ComplexLanes. */
+    template <typename Function>
+    void withLanesScratch (Function&& function) const noexcept
+    {
+        const size_t scratchSize = Lanes::SIMDRegisterSize + 2 * sizeof (ComplexLanes) * (size_t) size;
+
+        auto callWithSpace = [&] (void* space)
+        {
+            auto* scratchIn = reinterpret_cast<ComplexLanes*> (snapPointerToAlignment (static_cast<char*> (space), Lanes::SIMDRegisterSize));
+            function (scratchIn, scratchIn + size);
+        };
+
+        if (scratchSize < maxFFTScratchSpaceToAlloca)
+        {
+            callWithSpace (alloca (scratchSize));
+        }
+        else
+        {
+            HeapBlock<char> heapSpace (scratchSize);
+            callWithSpace (heapSpace.getData());
         }
     }
+   #endif
 
     //==============================================================================
     struct FFTConfig
@@ -265,9 +581,33 @@ struct FFTFallback  : public FFT::Instance
                 factors[i].radix = divisor;
                 factors[i].length = n;
             }
+
+            // Each butterfly stage gets its twiddles laid out contiguously, so that they can
+            // be read sequentially (and loaded into SIMD registers) instead of at a stride.
+            int numStageTwiddles = 0;
+
+            for (auto& factor : factors)
+            {
+                factor.twiddleOffset = numStageTwiddles;
+                numStageTwiddles += (factor.radix - 1) * factor.length;
+            }
+
+            stageTwiddles.malloc ((size_t) jmax (1, numStageTwiddles));
+
+            for (int i = 0, stride = 1; i < numElementsInArray (factors); ++i)
+            {
+                auto* tw = stageTwiddles + factors[i].twiddleOffset;
+
+                for (int q = 1; q < factors[i].radix; ++q)
+                    for (int k = 0; k < factors[i].length; ++k)
+                        *tw++ = twiddleTable[q * k * stride];
+
+                stride *= factors[i].radix;
+            }
         }
 
-        void perform (const Complex<float>* input, Complex<float>* output) const noexcept
+        template <typename ComplexType>
+        void perform (const ComplexType* input, ComplexType* output) const noexcept
         {
             perform (input, output, 1, 1, factors);
         }
@@ -275,11 +615,12 @@ struct FFTFallback  : public FFT::Instance
         const int fftSize;
         const bool inverse;
 
-        struct Factor { int radix, length; };
+        struct Factor { int radix, length, twiddleOffset; };
         Factor factors[32];
-        HeapBlock<Complex<float>> twiddleTable;
+        HeapBlock<Complex<float>> twiddleTable, stageTwiddles;
 
-        void perform (const Complex<float>* input, Complex<float>* output, int stride, int strideIn, const Factor* facs) const noexcept
+        template <typename ComplexType>
+        void perform (const ComplexType* input, ComplexType* output, int stride, int strideIn, const Factor* facs) const noexcept
         {
             auto factor = *facs++;
             auto* originalOutput = output;
@@ -317,17 +658,19 @@ struct FFTFallback  : public FFT::Instance
             butterfly (factor, originalOutput, stride);
         }
 
-        void butterfly (const Factor factor, Complex<float>* data, int stride) const noexcept
+        template <typename ComplexType>
+        void butterfly (const Factor factor, ComplexType* data, int stride) const noexcept
         {
             switch (factor.radix)
             {
                 case 1:   break;
-                case 2:   butterfly2 (data, stride, factor.length); return;
-                case 4:   butterfly4 (data, stride, factor.length); return;
+                case 2:   butterfly2 (data, stageTwiddles + factor.twiddleOffset, factor.length); return;
+                case 4:   butterfly4 (data, stageTwiddles + factor.twiddleOffset, factor.length); return;
                 default:  jassertfalse; break;
             }
 
-            auto* scratch = static_cast<Complex<float>*> (alloca (sizeof (Complex<float>) * (size_t) factor.radix));
+            auto* scratch = snapPointerToAlignment (static_cast<ComplexType*> (alloca (sizeof (ComplexType) * (size_t) (factor.radix + 1))),
+                                                    sizeof (ComplexType));
 
             for (int i = 0; i < factor.length; ++i)
             {
@@ -357,32 +700,29 @@ struct FFTFallback  : public FFT::Instance
             }
         }
 
-        void butterfly2 (Complex<float>* data, const int stride, const int length) const noexcept
+        template <typename ComplexType>
+        void butterfly2 (ComplexType* data, const Complex<float>* tw, const int length) const noexcept
         {
             auto* dataEnd = data + length;
-            auto* tw = twiddleTable.getData();
 
             for (int i = length; --i >= 0;)
             {
                 auto s = *dataEnd;
-                s *= (*tw);
-                tw += stride;
+                s *= (*tw++);
                 *dataEnd++ = *data - s;
                 *data++ += s;
             }
         }
 
-        void butterfly4 (Complex<float>* data, const int stride, const int length) const noexcept
+        template <typename ComplexType>
+        void butterfly4 (ComplexType* data, const Complex<float>* twiddles, const int length) const noexcept
         {
             auto lengthX2 = length * 2;
             auto lengthX3 = length * 3;
 
-            auto strideX2 = stride * 2;
-            auto strideX3 = stride * 3;
-
-            auto* twiddle1 = twiddleTable.getData();
-            auto* twiddle2 = twiddle1;
-            auto* twiddle3 = twiddle1;
+            auto* twiddle1 = twiddles;
+            auto* twiddle2 = twiddle1 + length;
+            auto* twiddle3 = twiddle2 + length;
 
             for (int i = length; --i >= 0;)
             {
@@ -396,9 +736,9 @@ struct FFTFallback  : public FFT::Instance
                 *data += s1;
                 data[lengthX2] = *data;
                 data[lengthX2] -= s3;
-                twiddle1 += stride;
-                twiddle2 += strideX2;
-                twiddle3 += strideX3;
+                ++twiddle1;
+                ++twiddle2;
+                ++twiddle3;
                 *data += s3;
 
                 if (inverse)
@@ -420,12 +760,85 @@ struct FFTFallback  : public FFT::Instance
             }
         }
 
+       #if JUCE_USE_SIMD
+        //==============================================================================
+        // When the stage is long enough, the butterflies of a single transform are done
+        // several at a time, using a SIMDRegister of complex numbers.
+        using ComplexRegister = SIMDRegister<Complex<float>>;
+
+        static constexpr int numComplexLanes = (int) ComplexRegister::SIMDNumElements;
+
+        static ComplexRegister JUCE_VECTOR_CALLTYPE load (const Complex<float>* source) noexcept
+        {
+            return ComplexRegister::fromRawArray (source);
+        }
+
+        static void JUCE_VECTOR_CALLTYPE store (Complex<float>* dest, ComplexRegister r) noexcept
+        {
+            // stored through its float view, so that it's a single unaligned store
+            SIMDRegister<float>::fromNative (r.value).copyToRawArray (reinterpret_cast<float*> (dest));
+        }
+
+        void butterfly2 (Complex<float>* data, const Complex<float>* tw, const int length) const noexcept
+        {
+            if (length % numComplexLanes != 0)
+                return butterfly2<Complex<float>> (data, tw, length);
+
+            auto* dataEnd = data + length;
+
+            for (int i = 0; i < length; i += numComplexLanes)
+            {
+                auto a = load (data + i);
+                auto s = load (dataEnd + i) * load (tw + i);
+
+                store (data + i,    a + s);
+                store (dataEnd + i, a - s);
+            }
+        }
+
+        void butterfly4 (Complex<float>* data, const Complex<float>* twiddles, const int length) const noexcept
+        {
+            if (length % numComplexLanes != 0)
+                return butterfly4<Complex<float>> (data, twiddles, length);
+
+            auto* twiddle1 = twiddles;
+            auto* twiddle2 = twiddle1 + length;
+            auto* twiddle3 = twiddle2 + length;
+
+            auto* data1 = data + length;
+            auto* data2 = data1 + length;
+            auto* data3 = data2 + length;
+
+            auto rotation = ComplexRegister::expand (inverse ? Complex<float> (0.0f, 1.0f)
+                                                             : Complex<float> (0.0f, -1.0f));
+
+            for (int i = 0; i < length; i += numComplexLanes)
+            {
+                auto x0 = load (data + i);
+                auto s0 = load (data1 + i) * load (twiddle1 + i);
+                auto s1 = load (data2 + i) * load (twiddle2 + i);
+                auto s2 = load (data3 + i) * load (twiddle3 + i);
+
+                auto s3 = s0 + s2;
+                auto s4 = (s0 - s2) * rotation;
+                auto s5 = x0 - s1;
+                auto s6 = x0 + s1;
+
+                store (data + i,  s6 + s3);
+                store (data2 + i, s6 - s3);
+                store (data1 + i, s5 + s4);
+                store (data3 + i, s5 - s4);
+            }
+        }
+       #endif
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTConfig)
     };
 
     //==============================================================================
     SpinLock processLock;
-    ScopedPointer<FFTConfig> configForward, configInverse;
+    ScopedPointer<FFTConfig> configForward, configInverse, configHalfForward, configHalfInverse;
+    HeapBlock<Complex<float>> realTwiddles;
     int size;
 };
 
@@ -828,6 +1241,24 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+void FFT::perform (const Complex<float>* const* inputs, Complex<float>* const* outputs, int numTransforms, bool inverse) const noexcept
+{
+    if (engine != nullptr)
+        engine->performMultiple (inputs, outputs, numTransforms, inverse);
+}
+
+void FFT::performRealOnlyForwardTransforms (float* const* inputOutputData, int numTransforms, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransforms (inputOutputData, numTransforms, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransforms (float* const* inputOutputData, int numTransforms) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransforms (inputOutputData, numTransforms);
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept
 {
     if (size == 1)
@@ -842,5 +1273,24 @@ void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData) const no
     zeromem (&inputOutputData[size], sizeof (float) * static_cast<size_t> (size));
 }
 
+void FFT::performFrequencyOnlyForwardTransforms (float* const* inputOutputData, int numTransforms) const noexcept
+{
+    if (size == 1)
+        return;
+
+    performRealOnlyForwardTransforms (inputOutputData, numTransforms);
+
+    for (int n = 0; n < numTransforms; ++n)
+    {
+        auto* data = inputOutputData[n];
+        auto* out = reinterpret_cast<Complex<float>*> (data);
+
+        for (auto i = 0; i < size; ++i)
+            data[i] = std::abs (out[i]);
+
+        zeromem (&data[size], sizeof (float) * static_cast<size_t> (size));
+    }
+}
+
 } // namespace dsp
 } // namespace juce
@@ -65,9 +65,8 @@ public:
         it may not be necessary to calculate them for your particular application.
         You can use dontCalculateNegativeFrequencies to let the FFT
         engine know that you do not plan on using them. Note that this is only a
-        hint: some FFT engines (currently only the Fallback engine), will still
-        calculate the negative frequencies even if dontCalculateNegativeFrequencies
-        is true.
+        hint: some FFT engines will still calculate the negative frequencies even
+        if dontCalculateNegativeFrequencies is true.
 
         The size of the array passed in must be 2 * getSize(), and the first half
         should contain your raw input sample data. On return, if
@@ -95,6 +94,34 @@ public:
     */
     void performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept;
 
+    //==============================================================================
+    /** Performs several out-of-place FFTs at once, either forward or inverse.
+
+        This gives the same results as calling perform() for each pair of arrays,
+        but it can be a lot faster when many transforms of the same size are needed,
+        for example one for each channel of a buffer, as some engines are able to
+        process several of them at the same time.
+    */
+    void perform (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                  int numTransforms, bool inverse) const noexcept;
+
+    /** Performs several in-place forward transforms on blocks of real data.
+        @see performRealOnlyForwardTransform, perform
+    */
+    void performRealOnlyForwardTransforms (float* const* inputOutputData, int numTransforms,
+                                           bool dontCalculateNegativeFrequencies = false) const noexcept;
+
+    /** Performs the reverse operation of performRealOnlyForwardTransforms().
+        @see performRealOnlyInverseTransform, perform
+    */
+    void performRealOnlyInverseTransforms (float* const* inputOutputData, int numTransforms) const noexcept;
+
+    /** Transforms several arrays to their magnitude frequency response spectrum.
+        @see performFrequencyOnlyForwardTransform, perform
+    */
+    void performFrequencyOnlyForwardTransforms (float* const* inputOutputData, int numTransforms) const noexcept;
+
+    //==============================================================================
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
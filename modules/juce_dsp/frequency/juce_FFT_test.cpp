@@ -191,6 +191,75 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct BatchTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 0; order <= 8; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                for (int numTransforms : { 1, 3, 8, 11 })
+                {
+                    HeapBlock<float> input (n * (size_t) numTransforms), batch (2 * n * (size_t) numTransforms), single (2 * n);
+                    HeapBlock<float*> pointers ((size_t) numTransforms);
+
+                    fillRandom (random, input.getData(), n * (size_t) numTransforms);
+                    zeromem (batch.getData(), 2 * n * (size_t) numTransforms * sizeof (float));
+
+                    for (int i = 0; i < numTransforms; ++i)
+                    {
+                        pointers[i] = batch.getData() + 2 * n * (size_t) i;
+                        memcpy (pointers[i], input.getData() + n * (size_t) i, n * sizeof (float));
+                    }
+
+                    fft.performRealOnlyForwardTransforms (pointers.getData(), numTransforms);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                    {
+                        zeromem (single.getData(), 2 * n * sizeof (float));
+                        memcpy (single.getData(), input.getData() + n * (size_t) i, n * sizeof (float));
+                        fft.performRealOnlyForwardTransform (single.getData());
+
+                        u.expect (checkArrayIsSimilar (single.getData(), pointers[i], 2 * n));
+                    }
+
+                    fft.performRealOnlyInverseTransforms (pointers.getData(), numTransforms);
+
+                    for (int i = 0; i < numTransforms; ++i)
+                        u.expect (checkArrayIsSimilar (input.getData() + n * (size_t) i, pointers[i], n));
+
+                    HeapBlock<Complex<float>> complexInput (n * (size_t) numTransforms), complexOutput (n * (size_t) numTransforms), reference (n);
+                    HeapBlock<const Complex<float>*> inputPointers ((size_t) numTransforms);
+                    HeapBlock<Complex<float>*> outputPointers ((size_t) numTransforms);
+
+                    fillRandom (random, complexInput.getData(), n * (size_t) numTransforms);
+
+                    for (auto inverse : { false, true })
+                    {
+                        for (int i = 0; i < numTransforms; ++i)
+                        {
+                            inputPointers[i]  = complexInput.getData()  + n * (size_t) i;
+                            outputPointers[i] = complexOutput.getData() + n * (size_t) i;
+                        }
+
+                        fft.perform (inputPointers.getData(), outputPointers.getData(), numTransforms, inverse);
+
+                        for (int i = 0; i < numTransforms; ++i)
+                        {
+                            fft.perform (inputPointers[i], reference.getData(), inverse);
+                            u.expect (checkArrayIsSimilar (reference.getData(), outputPointers[i], n));
+                        }
+                    }
+                }
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -204,6 +273,7 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchTest> ("Batched transforms Test");
     }
 };
 
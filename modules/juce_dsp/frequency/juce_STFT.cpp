@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+STFT::STFT()
+{
+    setParameters (Parameters());
+}
+
+STFT::~STFT()
+{
+}
+
+//==============================================================================
+void STFT::setParameters (const Parameters& newParameters)
+{
+    // the FFT size must be a power of two between 2 and 2 ^ 20
+    jassert (newParameters.fftOrder > 0 && newParameters.fftOrder <= 20);
+    // the window can't be larger than the FFT
+    jassert (newParameters.windowSize <= (1 << newParameters.fftOrder));
+    // the hop must be more than 0 and no more than the window size
+    jassert (newParameters.hopSize > 0);
+
+    parameters = newParameters;
+    fftSize = (size_t) 1 << jlimit (1, 20, parameters.fftOrder);
+    windowSize = parameters.windowSize > 0 ? jmin ((size_t) parameters.windowSize, fftSize) : fftSize;
+    hopSize = (size_t) jlimit (1, (int) windowSize, parameters.hopSize);
+
+    fft = new FFT ((int) std::log2 ((double) fftSize));
+
+    // The analysis window is periodic, rather than symmetrical, so that a hann
+    // window with a hop of a half or a quarter adds up to a constant
+    analysisWindow.malloc (windowSize + 1);
+    WindowingFunction<float>::fillWindowingTables (analysisWindow, windowSize + 1, parameters.window, false);
+
+    // Each output sample is the sum of the frames that overlap it, so dividing by the
+    // sum of the squares of the window at the positions that overlap gives back the
+    // input exactly when the spectra haven't been changed
+    synthesisWindow.malloc (windowSize);
+
+    for (size_t i = 0; i < windowSize; ++i)
+    {
+        float sumOfSquares = 0;
+
+        for (auto j = i % hopSize; j < windowSize; j += hopSize)
+            sumOfSquares += analysisWindow[j] * analysisWindow[j];
+
+        synthesisWindow[i] = sumOfSquares > 1.0e-6f ? analysisWindow[i] / sumOfSquares : 0.0f;
+    }
+
+    if (numPreparedChannels > 0)
+        prepare ({ 0.0, 0, (uint32) numPreparedChannels });
+}
+
+//==============================================================================
+void STFT::prepare (const ProcessSpec& spec)
+{
+    numPreparedChannels = spec.numChannels;
+
+    auto samplesPerChannel = 2 * windowSize + 2 * fftSize;
+    channelMemory.malloc (samplesPerChannel * numPreparedChannels);
+
+    inputBuffers.malloc (numPreparedChannels);
+    outputBuffers.malloc (numPreparedChannels);
+    fftBuffers.malloc (numPreparedChannels);
+    spectra.malloc (numPreparedChannels);
+
+    for (size_t ch = 0; ch < numPreparedChannels; ++ch)
+    {
+        auto* memory = channelMemory + ch * samplesPerChannel;
+
+        inputBuffers[ch]  = memory;
+        outputBuffers[ch] = memory + windowSize;
+        fftBuffers[ch]    = memory + 2 * windowSize;
+        spectra[ch]       = reinterpret_cast<Complex<float>*> (fftBuffers[ch]);
+    }
+
+    reset();
+}
+
+void STFT::reset() noexcept
+{
+    channelMemory.clear ((2 * windowSize + 2 * fftSize) * numPreparedChannels);
+    position = 0;
+    samplesUntilNextFrame = hopSize;
+}
+
+//==============================================================================
+void STFT::processChannels (const AudioBlock<float>& input, AudioBlock<float>* output,
+                            size_t numChannels, size_t numSamples) noexcept
+{
+    // you need to call prepare() with enough channels first!
+    jassert (numChannels <= numPreparedChannels);
+    numChannels = jmin (numChannels, numPreparedChannels);
+
+    for (size_t done = 0; done < numSamples;)
+    {
+        auto num = jmin (numSamples - done, samplesUntilNextFrame, windowSize - position);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            // the input is stored before the output is written, in case they're the same block
+            FloatVectorOperations::copy (inputBuffers[ch] + position, input.getChannelPointer (ch) + done, (int) num);
+
+            if (output != nullptr)
+            {
+                FloatVectorOperations::copy (output->getChannelPointer (ch) + done, outputBuffers[ch] + position, (int) num);
+                FloatVectorOperations::clear (outputBuffers[ch] + position, (int) num);
+            }
+        }
+
+        position = (position + num) % windowSize;
+        samplesUntilNextFrame -= num;
+        done += num;
+
+        if (samplesUntilNextFrame == 0)
+        {
+            processFrame (numChannels, output != nullptr);
+            samplesUntilNextFrame = hopSize;
+        }
+    }
+}
+
+void STFT::processFrame (size_t numChannels, bool resynthesise) noexcept
+{
+    // the oldest sample in the circular buffers is at the current position
+    auto numBeforeWrap = (int) (windowSize - position);
+    auto numAfterWrap = (int) position;
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto* frame = fftBuffers[ch];
+        auto* in = inputBuffers[ch];
+
+        FloatVectorOperations::multiply (frame, in + position, analysisWindow, numBeforeWrap);
+        FloatVectorOperations::multiply (frame + numBeforeWrap, in, analysisWindow + numBeforeWrap, numAfterWrap);
+        FloatVectorOperations::clear (frame + windowSize, (int) (2 * fftSize - windowSize));
+    }
+
+    fft->performRealOnlyForwardTransforms (fftBuffers, (int) numChannels, true);
+
+    if (callback != nullptr)
+        callback (spectra, numChannels, getNumBins());
+
+    if (! resynthesise)
+        return;
+
+    fft->performRealOnlyInverseTransforms (fftBuffers, (int) numChannels);
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto* frame = fftBuffers[ch];
+        auto* out = outputBuffers[ch];
+
+        FloatVectorOperations::addWithMultiply (out + position, frame, synthesisWindow, numBeforeWrap);
+        FloatVectorOperations::addWithMultiply (out, frame + numBeforeWrap, synthesisWindow + numBeforeWrap, numAfterWrap);
+    }
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    A short-time Fourier transform, for building spectral effects and analysers.
+
+    The incoming audio is cut into overlapping frames of getWindowSize() samples,
+    one every getHopSize() samples. Each frame is windowed, zero-padded up to the
+    FFT size and transformed, and then the spectra of all the channels are passed
+    to a callback together. The callback can read the spectra, or change them
+    in-place, before process() transforms them back and overlap-adds them into the
+    output.
+
+    The frames are windowed as they're gathered from a circular buffer, so the
+    samples are only copied once on their way into the FFT, and all the channels
+    are transformed with a single batched call. The resynthesis window is scaled so
+    that, if the callback leaves the spectra alone, the output is exactly the input
+    delayed by getLatencyInSamples(), whatever the window and hop size.
+
+    E.g.
+    @code
+    STFT stft;
+    stft.setParameters ({ 11, 512, 0, WindowingFunction<float>::hann });
+
+    stft.setSpectrumCallback ([] (Complex<float>* const* spectra, size_t numChannels, size_t numBins)
+    {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t bin = numBins / 2; bin < numBins; ++bin)
+                spectra[ch][bin] = {};    // a brick-wall low-pass
+    });
+
+    stft.prepare (spec);
+    ...
+    stft.process (ProcessContextReplacing<float> (block));
+    @endcode
+
+    @see FFT, WindowingFunction
+*/
+class JUCE_API  STFT
+{
+public:
+    /** The settings for an STFT. */
+    struct Parameters
+    {
+        /** The FFT has 2 ^ fftOrder points. */
+        int fftOrder = 10;
+
+        /** The number of samples between the starts of successive frames. This must be
+            more than 0, and no more than the window size.
+        */
+        int hopSize = 256;
+
+        /** The number of samples in each frame. Any points of the FFT beyond the
+            window are filled with zeros. If this is 0, the window is the same size
+            as the FFT.
+        */
+        int windowSize = 0;
+
+        /** The shape of the window applied to each frame. */
+        WindowingFunction<float>::WindowingMethod window = WindowingFunction<float>::hann;
+    };
+
+    /** A function that is given the spectra of a frame.
+
+        There is one array of numBins complex values for each channel. The values are
+        the DC bin up to the Nyquist bin, in the format produced by
+        FFT::performRealOnlyForwardTransform(). When the STFT is being used with
+        process(), any changes that the callback makes will be heard in the output.
+    */
+    using SpectrumCallback = std::function<void (Complex<float>* const* spectra, size_t numChannels, size_t numBins)>;
+
+    //==============================================================================
+    /** Creates an STFT with the default parameters. */
+    STFT();
+
+    /** Destructor. */
+    ~STFT();
+
+    //==============================================================================
+    /** Changes the FFT size, hop size or window.
+        This reallocates everything, so call it before prepare(), and not on the audio thread.
+    */
+    void setParameters (const Parameters& newParameters);
+
+    /** Returns the STFT's current parameters. */
+    const Parameters& getParameters() const noexcept        { return parameters; }
+
+    /** Sets the function that is given the spectrum of each frame.
+        This is called on the audio thread, so it mustn't block or allocate.
+    */
+    void setSpectrumCallback (SpectrumCallback newCallback)     { callback = std::move (newCallback); }
+
+    //==============================================================================
+    /** Returns the number of points in the FFT. */
+    size_t getFFTSize() const noexcept                      { return fftSize; }
+
+    /** Returns the number of samples in each frame. */
+    size_t getWindowSize() const noexcept                   { return windowSize; }
+
+    /** Returns the number of samples between the starts of successive frames. */
+    size_t getHopSize() const noexcept                      { return hopSize; }
+
+    /** Returns the number of complex values in each spectrum, which is (getFFTSize() / 2) + 1. */
+    size_t getNumBins() const noexcept                      { return fftSize / 2 + 1; }
+
+    /** Returns the delay between the input and the output of process(). */
+    size_t getLatencyInSamples() const noexcept             { return windowSize; }
+
+    //==============================================================================
+    /** Called before processing starts. This allocates the buffers for each channel. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Clears the buffered input and output. */
+    void reset() noexcept;
+
+    /** Analyses the input block, and resynthesises the output block from the spectra
+        that the callback has been given.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto&& inBlock  = context.getInputBlock();
+        auto&& outBlock = context.getOutputBlock();
+
+        jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+        jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
+
+        processChannels (inBlock, &outBlock, outBlock.getNumChannels(), outBlock.getNumSamples());
+    }
+
+    /** Passes a block of samples to the callback without resynthesising anything.
+        This is cheaper than process() when the spectra are only needed for display
+        or analysis.
+    */
+    void analyse (const AudioBlock<float>& block) noexcept
+    {
+        processChannels (block, nullptr, block.getNumChannels(), block.getNumSamples());
+    }
+
+private:
+    //==============================================================================
+    void processChannels (const AudioBlock<float>& input, AudioBlock<float>* output,
+                          size_t numChannels, size_t numSamples) noexcept;
+    void processFrame (size_t numChannels, bool resynthesise) noexcept;
+
+    //==============================================================================
+    Parameters parameters;
+    size_t fftSize = 0, windowSize = 0, hopSize = 0;
+    ScopedPointer<FFT> fft;
+    HeapBlock<float> analysisWindow, synthesisWindow;
+
+    SpectrumCallback callback;
+
+    // each channel has a circular input buffer and overlap-add accumulator of
+    // windowSize samples, and an FFT buffer of 2 * fftSize samples
+    HeapBlock<float> channelMemory;
+    HeapBlock<float*> inputBuffers, outputBuffers, fftBuffers;
+    HeapBlock<Complex<float>*> spectra;
+    size_t numPreparedChannels = 0, position = 0, samplesUntilNextFrame = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFT)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class STFTTest  : public UnitTest
+{
+public:
+    STFTTest() : UnitTest ("STFT") {}
+
+    void runReconstructionTest (int fftOrder, int windowSize, int hopSize,
+                                WindowingFunction<float>::WindowingMethod window)
+    {
+        STFT stft;
+        stft.setParameters ({ fftOrder, hopSize, windowSize, window });
+
+        const int numChannels = 2, numSamples = 20000;
+        AudioBuffer<float> input (numChannels, numSamples), output (numChannels, numSamples);
+        auto random = getRandom();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        output.makeCopyOf (input);
+        stft.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+
+        // the blocks are processed in-place, in sizes that don't line up with the hop
+        AudioBlock<float> block (output);
+
+        for (size_t start = 0; start < (size_t) numSamples;)
+        {
+            auto num = jmin ((size_t) random.nextInt (700) + 1, (size_t) numSamples - start);
+            auto subBlock = block.getSubBlock (start, num);
+            stft.process (ProcessContextReplacing<float> (subBlock));
+            start += num;
+        }
+
+        auto latency = (int) stft.getLatencyInSamples();
+        float maxError = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < latency; ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (ch, i)));
+
+            for (int i = latency; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (ch, i) - input.getSample (ch, i - latency)));
+        }
+
+        expect (maxError < 1.0e-4f);
+    }
+
+    void runAnalysisTest()
+    {
+        STFT stft;
+        stft.setParameters ({ 10, 256, 0, WindowingFunction<float>::hann });
+
+        const size_t numSamples = 8192, bin = 37;
+        int numFrames = 0;
+        bool peaksCorrect = true;
+
+        stft.setSpectrumCallback ([&] (Complex<float>* const* spectra, size_t numChannels, size_t numBins)
+        {
+            expectEquals ((int) numChannels, 1);
+            expectEquals ((int) numBins, 513);
+
+            size_t peak = 0;
+
+            for (size_t i = 1; i < numBins; ++i)
+                if (std::abs (spectra[0][i]) > std::abs (spectra[0][peak]))
+                    peak = i;
+
+            // the first frames are still partly filled with silence
+            if (++numFrames > 4)
+                peaksCorrect = peaksCorrect && peak == bin;
+        });
+
+        HeapBlock<float> sine (numSamples);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            sine[i] = std::sin (2.0f * MathConstants<float>::pi * (float) (bin * i) / 1024.0f);
+
+        float* channels[] = { sine.getData() };
+        stft.prepare ({ 44100.0, (uint32) numSamples, 1 });
+        stft.analyse (AudioBlock<float> (channels, 1, numSamples));
+
+        expectEquals (numFrames, (int) (numSamples / 256));
+        expect (peaksCorrect);
+    }
+
+    void runSpectralProcessingTest()
+    {
+        STFT stft;
+        stft.setParameters ({ 9, 128, 0, WindowingFunction<float>::hann });
+
+        stft.setSpectrumCallback ([] (Complex<float>* const* spectra, size_t numChannels, size_t numBins)
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numBins; ++i)
+                    spectra[ch][i] *= 0.5f;
+        });
+
+        const size_t numSamples = 4096;
+        HeapBlock<float> input (numSamples), output (numSamples);
+        auto random = getRandom();
+
+        for (size_t i = 0; i < numSamples; ++i)
+            input[i] = random.nextFloat() * 2.0f - 1.0f;
+
+        float* inputChannels[] = { input.getData() };
+        float* outputChannels[] = { output.getData() };
+        AudioBlock<float> inBlock (inputChannels, 1, numSamples), outBlock (outputChannels, 1, numSamples);
+
+        stft.prepare ({ 44100.0, (uint32) numSamples, 1 });
+        stft.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+        float maxError = 0;
+
+        for (size_t i = stft.getLatencyInSamples(); i < numSamples; ++i)
+            maxError = jmax (maxError, std::abs (output[i] - 0.5f * input[i - stft.getLatencyInSamples()]));
+
+        expect (maxError < 1.0e-4f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Reconstruction");
+        runReconstructionTest (10, 0, 256, WindowingFunction<float>::hann);
+        runReconstructionTest (10, 0, 512, WindowingFunction<float>::hann);
+        runReconstructionTest (11, 1000, 300, WindowingFunction<float>::blackman);
+        runReconstructionTest (8, 0, 256, WindowingFunction<float>::rectangular);
+        runReconstructionTest (9, 384, 100, WindowingFunction<float>::hamming);
+
+        beginTest ("Analysis");
+        runAnalysisTest();
+
+        beginTest ("Spectral processing");
+        runSpectralProcessingTest();
+    }
+};
+
+static STFTTest stftTest;
+
+} // namespace dsp
+} // namespace juce
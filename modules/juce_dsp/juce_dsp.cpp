@@ -47,17 +47,21 @@
 
 #if JUCE_DSP_USE_INTEL_MKL
  #include <mkl_dfti.h>
+ #include <mkl_cblas.h>
 #endif
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_BandLimitedOscillator.cpp"
+#include "processors/juce_FDNReverb.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 
 #if JUCE_USE_SIMD
@@ -80,5 +84,11 @@
 #include "containers/juce_SIMDRegister_test.cpp"
 #endif
 #include "frequency/juce_FFT_test.cpp"
+#include "frequency/juce_Convolution_test.cpp"
+#include "frequency/juce_STFT_test.cpp"
 #include "processors/juce_FIRFilter_test.cpp"
+#include "processors/juce_IIRFilter_test.cpp"
+#include "processors/juce_BandLimitedOscillator_test.cpp"
+#include "processors/juce_FDNReverb_test.cpp"
+#include "processors/juce_StateVariableFilter_test.cpp"
 #endif
@@ -124,9 +124,9 @@
 /** Config: JUCE_DSP_USE_INTEL_MKL
 
     If this flag is set, then JUCE will use Intel's MKL for JUCE's FFT and
-    convolution classes.
+    convolution classes, and its BLAS functions for the Matrix multiplications.
 
-    The folder containing the mkl_dfti.h header must be in your header
+    The folder containing the mkl_dfti.h and mkl_cblas.h headers must be in your header
     search paths when using this flag. You also need to add all the necessary
     intel mkl libraries to the "External Libraries to Link" field in the
     Projucer.
@@ -249,15 +249,19 @@ namespace juce
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
 #include "processors/juce_ProcessorDuplicator.h"
+#include "processors/juce_StateUpdater.h"
 #include "processors/juce_Bias.h"
 #include "processors/juce_Gain.h"
 #include "processors/juce_WaveShaper.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_Oscillator.h"
+#include "processors/juce_BandLimitedOscillator.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_Oversampling.h"
+#include "processors/juce_FDNReverb.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
@@ -31,6 +31,11 @@ namespace dsp
 
 /**
     This class contains various fast mathematical function approximations.
+
+    The functions which take a single value are templates, which can be used with
+    SIMDRegister<float> and SIMDRegister<double> as well as with scalars, to
+    calculate several approximations at once. The versions which work on a whole
+    buffer use them to process it with SIMD, when it's available.
 */
 struct FastMathApproximations
 {
@@ -58,8 +63,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cosh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cosh (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::cosh (x); });
     }
 
     /** Provides a fast approximation of the function sinh(x) using a Pade approximant
@@ -86,8 +90,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sinh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sinh (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::sinh (x); });
     }
 
     /** Provides a fast approximation of the function tanh(x) using a Pade approximant
@@ -114,8 +117,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tanh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tanh (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::tanh (x); });
     }
 
     //==============================================================================
@@ -143,8 +145,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cos (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cos (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::cos (x); });
     }
 
     /** Provides a fast approximation of the function sin(x) using a Pade approximant
@@ -171,8 +172,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sin (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sin (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::sin (x); });
     }
 
     /** Provides a fast approximation of the function tan(x) using a Pade approximant
@@ -199,8 +199,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tan (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tan (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::tan (x); });
     }
 
     //==============================================================================
@@ -227,8 +226,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void exp (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::exp (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::exp (x); });
     }
 
     /** Provides a fast approximation of the function log(x+1) using a Pade approximant
@@ -254,8 +252,45 @@ struct FastMathApproximations
     template <typename FloatType>
     static void logNPlusOne (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::logNPlusOne (values[i]);
+        applyToBuffer (values, numValues, [] (auto x) { return FastMathApproximations::logNPlusOne (x); });
+    }
+
+private:
+    //==============================================================================
+    template <typename FloatType, typename Function>
+    static void applyToBuffer (FloatType* values, size_t numValues, Function function) noexcept
+    {
+        auto numVectorised = applyToBufferWithSIMD (values, numValues, function,
+                                                    std::integral_constant<bool, std::is_same<FloatType, float>::value
+                                                                              || std::is_same<FloatType, double>::value>());
+
+        for (size_t i = numVectorised; i < numValues; ++i)
+            values[i] = function (values[i]);
+    }
+
+    template <typename FloatType, typename Function>
+    static size_t applyToBufferWithSIMD (FloatType*, size_t, Function, std::false_type) noexcept
+    {
+        return 0;
+    }
+
+    template <typename FloatType, typename Function>
+    static size_t applyToBufferWithSIMD (FloatType* values, size_t numValues, Function function, std::true_type) noexcept
+    {
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<FloatType>;
+        constexpr auto numLanes = VectorType::SIMDNumElements;
+
+        auto numVectorised = numValues - numValues % numLanes;
+
+        for (size_t i = 0; i < numVectorised; i += numLanes)
+            function (VectorType::fromRawArray (values + i)).copyToRawArray (values + i);
+
+        return numVectorised;
+       #else
+        ignoreUnused (values, numValues, function);
+        return 0;
+       #endif
     }
 };
 
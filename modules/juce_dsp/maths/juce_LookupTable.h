@@ -129,6 +129,44 @@ public:
         return getUnchecked (index);
     }
 
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Calculates the approximated values for a SIMDRegister of indices without range
+        checking. The table values are loaded with gather instructions where the CPU
+        has them.
+
+        @see getUnchecked
+    */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE getUnchecked (SIMDRegister<Type> index) const noexcept
+    {
+        static_assert (std::is_same<Type, FloatType>::value, "The SIMDRegister has to have the type of the table");
+        jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+        auto i = SIMDRegister<Type>::truncate (index);
+        auto f = index - i;
+
+        auto x0 = SIMDRegister<Type>::gather (data.begin(),     i);
+        auto x1 = SIMDRegister<Type>::gather (data.begin() + 1, i);
+
+        return x0 + f * (x1 - x0);
+    }
+
+    /** Calculates the approximated values for a SIMDRegister of indices with range checking.
+
+        @see get
+    */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE get (SIMDRegister<Type> index) const noexcept
+    {
+        // the value at the last point is repeated by the guard point, so the index can be
+        // limited to the last point without changing the result
+        auto lastIndex = SIMDRegister<Type>::expand (static_cast<Type> (getNumPoints() - 1));
+
+        return getUnchecked (SIMDRegister<Type>::min (lastIndex, SIMDRegister<Type>::max (SIMDRegister<Type>::expand (0), index)));
+    }
+   #endif
+
     //==============================================================================
     /** @see getUnchecked */
     FloatType operator[] (FloatType index) const noexcept       { return getUnchecked (index); }
@@ -256,6 +294,42 @@ public:
         return lookupTable[index];
     }
 
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Calculates the approximated values for a SIMDRegister of input values without
+        range checking.
+
+        @see processSampleUnchecked
+    */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE processSampleUnchecked (SIMDRegister<Type> value) const noexcept
+    {
+        return lookupTable.getUnchecked (value * scaler + offset);
+    }
+
+    /** Calculates the approximated values for a SIMDRegister of input values with
+        range checking.
+
+        @see processSample
+    */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE processSample (SIMDRegister<Type> value) const noexcept
+    {
+        auto limited = SIMDRegister<Type>::min (SIMDRegister<Type>::expand (maxInputValue),
+                                                SIMDRegister<Type>::max (SIMDRegister<Type>::expand (minInputValue), value));
+
+        return lookupTable.getUnchecked (limited * scaler + offset);
+    }
+
+    /** @see processSampleUnchecked */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE operator[] (SIMDRegister<Type> index) const noexcept   { return processSampleUnchecked (index); }
+
+    /** @see processSample */
+    template <typename Type = FloatType>
+    SIMDRegister<Type> JUCE_VECTOR_CALLTYPE operator() (SIMDRegister<Type> index) const noexcept   { return processSample (index); }
+   #endif
+
     //==============================================================================
     /** @see processSampleUnchecked */
     FloatType operator[] (FloatType index) const noexcept       { return processSampleUnchecked (index); }
@@ -264,22 +338,42 @@ public:
     FloatType operator() (FloatType index) const noexcept       { return processSample (index); }
 
     //==============================================================================
-    /** Processes an array of input values without range checking
+    /** Processes an array of input values without range checking.
+        With SIMD, the values are processed a whole register at a time.
         @see process
     */
     void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
+        size_t i = 0;
+
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<FloatType>;
+
+        for (; i + VectorType::SIMDNumElements <= numSamples; i += VectorType::SIMDNumElements)
+            processSampleUnchecked (VectorType::fromRawArray (input + i)).copyToRawArray (output + i);
+       #endif
+
+        for (; i < numSamples; ++i)
             output[i] = processSampleUnchecked (input[i]);
     }
 
     //==============================================================================
-    /** Processes an array of input values with range checking
+    /** Processes an array of input values with range checking.
+        With SIMD, the values are processed a whole register at a time.
         @see processUnchecked
     */
     void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
+        size_t i = 0;
+
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<FloatType>;
+
+        for (; i + VectorType::SIMDNumElements <= numSamples; i += VectorType::SIMDNumElements)
+            processSample (VectorType::fromRawArray (input + i)).copyToRawArray (output + i);
+       #endif
+
+        for (; i < numSamples; ++i)
             output[i] = processSample (input[i]);
     }
 
@@ -109,6 +109,231 @@ Matrix<ElementType>& Matrix<ElementType>::swapRows (size_t rowOne, size_t rowTwo
     return *this;
 }
 
+//==============================================================================
+namespace MatrixHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename ElementType>
+    using VectorType = SIMDRegister<ElementType>;
+   #else
+    /** A single element stand-in for SIMDRegister, so that the kernels below
+        also compile when SIMD support is disabled. */
+    template <typename ElementType>
+    struct VectorType
+    {
+        static constexpr size_t SIMDNumElements = 1;
+
+        static VectorType expand (ElementType s) noexcept                                { return { s }; }
+        static VectorType fromRawArray (const ElementType* a) noexcept                   { return { *a }; }
+        static VectorType multiplyAdd (VectorType a, VectorType b, VectorType c) noexcept { return { a.value + b.value * c.value }; }
+        void copyToRawArray (ElementType* a) const noexcept                              { *a = value; }
+        ElementType sum() const noexcept                                                 { return value; }
+
+        ElementType value;
+    };
+   #endif
+
+    // The sizes of the blocks of the right hand side matrix which are kept in the
+    // cache while they are multiplied by the rows of the left hand side one.
+    static constexpr size_t rowBlockSize = 128, columnBlockSize = 128;
+
+    /** Accumulates the product of numRows rows of a (from column k0 to k1) by the
+        columns j0 to j1 of b into the same rows and columns of dst. The columns are
+        processed two vectors at a time, and the remaining ones with scalar code. */
+    template <typename ElementType, size_t numRows>
+    static void multiplyPanel (ElementType* dst, const ElementType* a, const ElementType* b,
+                               size_t p, size_t m, size_t k0, size_t k1, size_t j0, size_t j1) noexcept
+    {
+        using Vec = VectorType<ElementType>;
+        constexpr auto width = Vec::SIMDNumElements;
+
+        auto j = j0;
+
+        for (; j + 2 * width <= j1; j += 2 * width)
+        {
+            Vec acc[numRows][2];
+
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                acc[r][0] = Vec::fromRawArray (dst + r * m + j);
+                acc[r][1] = Vec::fromRawArray (dst + r * m + j + width);
+            }
+
+            for (auto k = k0; k < k1; ++k)
+            {
+                auto b0 = Vec::fromRawArray (b + k * m + j);
+                auto b1 = Vec::fromRawArray (b + k * m + j + width);
+
+                for (size_t r = 0; r < numRows; ++r)
+                {
+                    auto ak = Vec::expand (a[r * p + k]);
+                    acc[r][0] = Vec::multiplyAdd (acc[r][0], ak, b0);
+                    acc[r][1] = Vec::multiplyAdd (acc[r][1], ak, b1);
+                }
+            }
+
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                acc[r][0].copyToRawArray (dst + r * m + j);
+                acc[r][1].copyToRawArray (dst + r * m + j + width);
+            }
+        }
+
+        for (size_t r = 0; r < numRows; ++r)
+            for (auto k = k0; k < k1; ++k)
+            {
+                auto ak = a[r * p + k];
+
+                for (auto jj = j; jj < j1; ++jj)
+                    dst[r * m + jj] += ak * b[k * m + jj];
+            }
+    }
+
+    /** dst (n x m) = a (n x p) * b (p x m), with dst initially cleared. */
+    template <typename ElementType>
+    static void multiplyMatrices (ElementType* dst, const ElementType* a, const ElementType* b,
+                                  size_t n, size_t p, size_t m) noexcept
+    {
+        for (size_t k0 = 0; k0 < p; k0 += rowBlockSize)
+        {
+            auto k1 = jmin (p, k0 + rowBlockSize);
+
+            for (size_t j0 = 0; j0 < m; j0 += columnBlockSize)
+            {
+                auto j1 = jmin (m, j0 + columnBlockSize);
+                size_t i = 0;
+
+                for (; i + 4 <= n; i += 4)
+                    multiplyPanel<ElementType, 4> (dst + i * m, a + i * p, b, p, m, k0, k1, j0, j1);
+
+                for (; i < n; ++i)
+                    multiplyPanel<ElementType, 1> (dst + i * m, a + i * p, b, p, m, k0, k1, j0, j1);
+            }
+        }
+    }
+
+    /** dst (n) = a (n x p) * x (p), four rows at a time. */
+    template <typename ElementType>
+    static void multiplyMatrixVector (ElementType* dst, const ElementType* a, const ElementType* x,
+                                      size_t n, size_t p) noexcept
+    {
+        using Vec = VectorType<ElementType>;
+        constexpr auto width = Vec::SIMDNumElements;
+        constexpr size_t numRows = 4;
+
+        size_t i = 0;
+
+        for (; i + numRows <= n; i += numRows)
+        {
+            Vec acc[numRows];
+            ElementType tail[numRows] = {};
+
+            for (auto& v : acc)
+                v = Vec::expand (0);
+
+            size_t k = 0;
+
+            for (; k + width <= p; k += width)
+            {
+                auto xk = Vec::fromRawArray (x + k);
+
+                for (size_t r = 0; r < numRows; ++r)
+                    acc[r] = Vec::multiplyAdd (acc[r], Vec::fromRawArray (a + (i + r) * p + k), xk);
+            }
+
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                for (auto kk = k; kk < p; ++kk)
+                    tail[r] += a[(i + r) * p + kk] * x[kk];
+
+                dst[i + r] = acc[r].sum() + tail[r];
+            }
+        }
+
+        for (; i < n; ++i)
+        {
+            ElementType sum = 0;
+
+            for (size_t k = 0; k < p; ++k)
+                sum += a[i * p + k] * x[k];
+
+            dst[i] = sum;
+        }
+    }
+
+   #if JUCE_DSP_USE_INTEL_MKL || JUCE_USE_VDSP_FRAMEWORK
+    static void blasMultiply (float* dst, const float* a, const float* b, size_t n, size_t p, size_t m) noexcept
+    {
+        if (m == 1)
+            cblas_sgemv (CblasRowMajor, CblasNoTrans, (int) n, (int) p, 1.0f, a, (int) p, b, 1, 0.0f, dst, 1);
+        else
+            cblas_sgemm (CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) n, (int) m, (int) p,
+                         1.0f, a, (int) p, b, (int) m, 0.0f, dst, (int) m);
+    }
+
+    static void blasMultiply (double* dst, const double* a, const double* b, size_t n, size_t p, size_t m) noexcept
+    {
+        if (m == 1)
+            cblas_dgemv (CblasRowMajor, CblasNoTrans, (int) n, (int) p, 1.0, a, (int) p, b, 1, 0.0, dst, 1);
+        else
+            cblas_dgemm (CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) n, (int) m, (int) p,
+                         1.0, a, (int) p, b, (int) m, 0.0, dst, (int) m);
+    }
+   #endif
+
+    /** Accumulates into the numOutputs channels of dst the mix of the numInputs
+        channels of src, with the gains in the rows of the matrix. */
+    template <typename ElementType, size_t numOutputs>
+    static void mixChannelGroup (ElementType** dst, const ElementType* const* src, const ElementType* gains,
+                                 size_t numInputs, size_t stride, size_t numSamples) noexcept
+    {
+        using Vec = VectorType<ElementType>;
+        constexpr auto width = Vec::SIMDNumElements;
+
+        size_t i = 0;
+
+        for (; i + 2 * width <= numSamples; i += 2 * width)
+        {
+            Vec acc[numOutputs][2];
+
+            for (auto& v : acc)
+                v[0] = v[1] = Vec::expand (0);
+
+            for (size_t ch = 0; ch < numInputs; ++ch)
+            {
+                auto x0 = Vec::fromRawArray (src[ch] + i);
+                auto x1 = Vec::fromRawArray (src[ch] + i + width);
+
+                for (size_t r = 0; r < numOutputs; ++r)
+                {
+                    auto gain = Vec::expand (gains[r * stride + ch]);
+                    acc[r][0] = Vec::multiplyAdd (acc[r][0], gain, x0);
+                    acc[r][1] = Vec::multiplyAdd (acc[r][1], gain, x1);
+                }
+            }
+
+            for (size_t r = 0; r < numOutputs; ++r)
+            {
+                acc[r][0].copyToRawArray (dst[r] + i);
+                acc[r][1].copyToRawArray (dst[r] + i + width);
+            }
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            for (size_t r = 0; r < numOutputs; ++r)
+            {
+                ElementType sum = 0;
+
+                for (size_t ch = 0; ch < numInputs; ++ch)
+                    sum += gains[r * stride + ch] * src[ch][i];
+
+                dst[r][i] = sum;
+            }
+        }
+    }
+}
+
 //==============================================================================
 template <typename ElementType>
 Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
@@ -116,34 +341,83 @@ Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& o
     auto n = getNumRows(), m = other.getNumColumns(), p = getNumColumns();
     Matrix result (n, m);
 
-    jassert (other.getNumRows() == p && n == m);
-
-    size_t offsetMat = 0, offsetlhs = 0;
+    jassert (other.getNumRows() == p);
 
     auto *dst = result.getRawDataPointer();
     auto *a  = getRawDataPointer();
     auto *b  = other.getRawDataPointer();
 
-    for (size_t i = 0; i < n; ++i)
-    {
-        size_t offsetrhs = 0;
+    if (n == 0 || m == 0 || p == 0)
+        return result;
 
-        for (size_t k = 0; k < p; ++k)
-        {
-            auto ak = a[offsetlhs++];
+   #if JUCE_DSP_USE_INTEL_MKL || JUCE_USE_VDSP_FRAMEWORK
+    MatrixHelpers::blasMultiply (dst, a, b, n, p, m);
+   #else
+    if (m == 1)
+        MatrixHelpers::multiplyMatrixVector (dst, a, b, n, p);
+    else
+        MatrixHelpers::multiplyMatrices (dst, a, b, n, p, m);
+   #endif
 
-            for (size_t j = 0; j < m; ++j)
-                dst[offsetMat + j] += ak * b[offsetrhs + j];
+    return result;
+}
 
-            offsetrhs += m;
-        }
+template <typename ElementType>
+Matrix<ElementType> Matrix<ElementType>::transpose() const
+{
+    constexpr size_t blockSize = 16;
 
-        offsetMat += m;
-    }
+    Matrix result (columns, rows);
+
+    auto* dst = result.getRawDataPointer();
+    auto* src = getRawDataPointer();
+
+    for (size_t i0 = 0; i0 < rows; i0 += blockSize)
+        for (size_t j0 = 0; j0 < columns; j0 += blockSize)
+            for (size_t i = i0; i < jmin (rows, i0 + blockSize); ++i)
+                for (size_t j = j0; j < jmin (columns, j0 + blockSize); ++j)
+                    dst[j * rows + i] = src[i * columns + j];
 
     return result;
 }
 
+//==============================================================================
+template <typename ElementType>
+void Matrix<ElementType>::mixChannels (const AudioBlock<ElementType>& input, AudioBlock<ElementType>& output) const noexcept
+{
+    jassert (input.getNumChannels() == columns);
+    jassert (output.getNumChannels() == rows);
+    jassert (input.getNumSamples() == output.getNumSamples());
+
+    auto numSamples = input.getNumSamples();
+
+    HeapBlock<const ElementType*> src (columns);
+    HeapBlock<ElementType*> dst (rows);
+
+    for (size_t ch = 0; ch < columns; ++ch)
+        src[ch] = input.getChannelPointer (ch);
+
+    for (size_t ch = 0; ch < rows; ++ch)
+    {
+        dst[ch] = output.getChannelPointer (ch);
+
+       #if JUCE_DEBUG
+        // the output channels can't be read back as inputs, as they are overwritten
+        for (size_t i = 0; i < columns; ++i)
+            jassert (dst[ch] + numSamples <= src[i] || src[i] + numSamples <= dst[ch]);
+       #endif
+    }
+
+    auto* gains = getRawDataPointer();
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4)
+        MatrixHelpers::mixChannelGroup<ElementType, 4> (dst + r, src, gains + r * columns, columns, columns, numSamples);
+
+    for (; r < rows; ++r)
+        MatrixHelpers::mixChannelGroup<ElementType, 1> (dst + r, src, gains + r * columns, columns, columns, numSamples);
+}
+
 //==============================================================================
 template <typename ElementType>
 bool Matrix<ElementType>::compare (const Matrix& a, const Matrix& b, ElementType tolerance) noexcept
@@ -241,26 +515,25 @@ bool Matrix<ElementType>::solve (Matrix& b) const noexcept
                     if (i == n)
                         return false;
 
-                    for (size_t k = 0; k < n; ++k)
-                        M (j, k) += M (i, k);
-
+                    FloatVectorOperations::add (&M (j, j), &M (i, j), static_cast<int> (n - j));
                     x[j] += x[i];
                 }
 
-                auto t = 1 / M (j, j);
-
-                for (size_t k = 0; k < n; ++k)
-                    M (j, k) *= t;
+                // the columns on the left of j are already zero in the rows below j, so
+                // the row operations only need to go through the remaining ones
+                auto* rowJ = &M (j, j);
+                auto length = static_cast<int> (n - j);
+                auto t = 1 / *rowJ;
 
+                FloatVectorOperations::multiply (rowJ, t, length);
                 x[j] *= t;
 
                 for (size_t k = j + 1; k < n; ++k)
                 {
-                    auto u = -M (k, j);
-
-                    for (size_t l = 0; l < n; ++l)
-                        M (k, l) += u * M (j, l);
+                    auto* rowK = &M (k, j);
+                    auto u = -*rowK;
 
+                    FloatVectorOperations::addWithMultiply (rowK, rowJ, u, length);
                     x[k] += u * x[j];
                 }
             }
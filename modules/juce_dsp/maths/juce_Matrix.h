@@ -29,10 +29,16 @@ namespace juce
 namespace dsp
 {
 
+template <typename SampleType>
+class AudioBlock;
+
 /**
     General matrix and vectors class, meant for classic math manipulation such as
     additions, multiplications, and linear systems of equations solving.
 
+    The multiplications use cache-blocked SIMD kernels, or the BLAS functions of
+    Intel's MKL or Apple's Accelerate framework when JUCE uses them.
+
     @see LinearAlgebra
 */
 template<typename ElementType>
@@ -156,9 +162,15 @@ public:
     /** Scalar multiplication */
     inline Matrix operator* (ElementType scalar) const                  { Matrix result (*this); result *= scalar; return result; }
 
-    /** Matrix multiplication */
+    /** Matrix multiplication.
+
+        If other is a one column vector, this is a matrix-vector product.
+    */
     Matrix operator* (const Matrix& other) const;
 
+    /** Returns the transpose of the matrix. */
+    Matrix transpose() const;
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
     inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
 
@@ -200,6 +212,18 @@ public:
      */
     bool solve (Matrix& b) const noexcept;
 
+    //==============================================================================
+    /** Mixes the channels of an AudioBlock into the channels of another one, using
+        the matrix as the mixing gains, so that each output channel i is the sum of
+        the input channels j multiplied by the element (i, j).
+
+        The input block must have as many channels as the matrix has columns, and the
+        output block as many channels as it has rows. They must have the same number
+        of samples, and not share any memory. The whole mix is done in one SIMD pass
+        over the samples.
+    */
+    void mixChannels (const AudioBlock<ElementType>& input, AudioBlock<ElementType>& output) const noexcept;
+
     //==============================================================================
     /** Returns a String displaying in a convenient way the matrix contents. */
     String toString() const;
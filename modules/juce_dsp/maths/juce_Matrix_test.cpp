@@ -145,6 +145,130 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    struct LargeMultiplicationTest
+    {
+        template <typename ElementType>
+        static Matrix<ElementType> createRandomMatrix (Random& random, size_t rows, size_t columns)
+        {
+            Matrix<ElementType> result (rows, columns);
+
+            for (auto& value : result)
+                value = static_cast<ElementType> (random.nextFloat() * 2.0f - 1.0f);
+
+            return result;
+        }
+
+        template <typename ElementType>
+        static Matrix<ElementType> multiplyReference (const Matrix<ElementType>& a, const Matrix<ElementType>& b)
+        {
+            Matrix<ElementType> result (a.getNumRows(), b.getNumColumns());
+
+            for (size_t i = 0; i < a.getNumRows(); ++i)
+                for (size_t j = 0; j < b.getNumColumns(); ++j)
+                    for (size_t k = 0; k < a.getNumColumns(); ++k)
+                        result (i, j) += a (i, k) * b (k, j);
+
+            return result;
+        }
+
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            auto random = u.getRandom();
+
+            // sizes which aren't multiples of the kernel and block sizes
+            auto a = createRandomMatrix<ElementType> (random, 67, 145);
+            auto b = createRandomMatrix<ElementType> (random, 145, 139);
+            auto x = createRandomMatrix<ElementType> (random, 145, 1);
+
+            u.expect (Matrix<ElementType>::compare (a * b, multiplyReference (a, b), (ElementType) 1e-3));
+            u.expect (Matrix<ElementType>::compare (a * x, multiplyReference (a, x), (ElementType) 1e-3));
+        }
+    };
+
+    struct TransposeTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const ElementType data1[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+            const ElementType data2[] = { 1, 5, 2, 6, 3, 7, 4, 8 };
+
+            u.expect (Matrix<ElementType> (2, 4, data1).transpose() == Matrix<ElementType> (4, 2, data2));
+
+            auto random = u.getRandom();
+            auto a = LargeMultiplicationTest::createRandomMatrix<ElementType> (random, 37, 21);
+            auto t = a.transpose();
+            auto allEqual = true;
+
+            for (size_t i = 0; i < a.getNumRows(); ++i)
+                for (size_t j = 0; j < a.getNumColumns(); ++j)
+                    allEqual = allEqual && (t (j, i) == a (i, j));
+
+            u.expect (allEqual);
+        }
+    };
+
+    struct LargeSolvingTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 23;
+
+            auto random = u.getRandom();
+            auto A = LargeMultiplicationTest::createRandomMatrix<ElementType> (random, n, n);
+            auto X = LargeMultiplicationTest::createRandomMatrix<ElementType> (random, n, 1);
+
+            // make the system well conditioned
+            for (size_t i = 0; i < n; ++i)
+                A (i, i) += static_cast<ElementType> (n);
+
+            auto B = A * X;
+
+            u.expect (A.solve (B));
+            u.expect (Matrix<ElementType>::compare (X, B, (ElementType) 1e-4));
+        }
+    };
+
+    struct MixChannelsTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const int numInputs = 3, numOutputs = 6, numSamples = 37;
+
+            auto random = u.getRandom();
+            auto gains = LargeMultiplicationTest::createRandomMatrix<ElementType> (random, numOutputs, numInputs);
+
+            AudioBuffer<ElementType> inputBuffer (numInputs, numSamples), outputBuffer (numOutputs, numSamples);
+
+            for (int ch = 0; ch < numInputs; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    inputBuffer.setSample (ch, i, static_cast<ElementType> (random.nextFloat() * 2.0f - 1.0f));
+
+            AudioBlock<ElementType> input (inputBuffer), output (outputBuffer);
+            gains.mixChannels (input, output);
+
+            auto allClose = true;
+
+            for (size_t ch = 0; ch < (size_t) numOutputs; ++ch)
+            {
+                for (size_t i = 0; i < (size_t) numSamples; ++i)
+                {
+                    ElementType expected = 0;
+
+                    for (size_t j = 0; j < (size_t) numInputs; ++j)
+                        expected += gains (ch, j) * input.getChannelPointer (j)[i];
+
+                    allClose = allClose && std::abs (output.getChannelPointer (ch)[i] - expected) < (ElementType) 1e-5;
+                }
+            }
+
+            u.expect (allClose);
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -163,6 +287,10 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
+        runTestForAllTypes<TransposeTest> ("TransposeTest");
+        runTestForAllTypes<LargeSolvingTest> ("LargeSolvingTest");
+        runTestForAllTypes<MixChannelsTest> ("MixChannelsTest");
     }
 };
 
@@ -69,6 +69,9 @@ struct SIMDNativeOps<float>
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE add (__m256 a, __m256 b) noexcept                    { return _mm256_add_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE sub (__m256 a, __m256 b) noexcept                    { return _mm256_sub_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE mul (__m256 a, __m256 b) noexcept                    { return _mm256_mul_ps (a, b); }
+    static forcedinline __m256 JUCE_VECTOR_CALLTYPE div (__m256 a, __m256 b) noexcept                    { return _mm256_div_ps (a, b); }
+    static forcedinline __m256 JUCE_VECTOR_CALLTYPE truncate (__m256 a) noexcept                         { return _mm256_round_ps (a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static forcedinline __m256 JUCE_VECTOR_CALLTYPE gather (const float* base, __m256 indices) noexcept  { return _mm256_i32gather_ps (base, _mm256_cvttps_epi32 (indices), sizeof (float)); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_and (__m256 a, __m256 b) noexcept                { return _mm256_and_ps (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_or  (__m256 a, __m256 b) noexcept                { return _mm256_or_ps  (a, b); }
     static forcedinline __m256 JUCE_VECTOR_CALLTYPE bit_xor (__m256 a, __m256 b) noexcept                { return _mm256_xor_ps (a, b); }
@@ -126,6 +129,9 @@ struct SIMDNativeOps<double>
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE add (__m256d a, __m256d b) noexcept                     { return _mm256_add_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE sub (__m256d a, __m256d b) noexcept                     { return _mm256_sub_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE mul (__m256d a, __m256d b) noexcept                     { return _mm256_mul_pd (a, b); }
+    static forcedinline __m256d JUCE_VECTOR_CALLTYPE div (__m256d a, __m256d b) noexcept                     { return _mm256_div_pd (a, b); }
+    static forcedinline __m256d JUCE_VECTOR_CALLTYPE truncate (__m256d a) noexcept                           { return _mm256_round_pd (a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static forcedinline __m256d JUCE_VECTOR_CALLTYPE gather (const double* base, __m256d indices) noexcept   { return _mm256_i32gather_pd (base, _mm256_cvttpd_epi32 (indices), sizeof (double)); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_and (__m256d a, __m256d b) noexcept                 { return _mm256_and_pd (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_or  (__m256d a, __m256d b) noexcept                 { return _mm256_or_pd  (a, b); }
     static forcedinline __m256d JUCE_VECTOR_CALLTYPE bit_xor (__m256d a, __m256d b) noexcept                 { return _mm256_xor_pd (a, b); }
@@ -68,6 +68,7 @@ struct SIMDFallbackOps
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept        { return apply<ScalarAdd> (a, b); }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept        { return apply<ScalarSub> (a, b); }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept        { return apply<ScalarMul> (a, b); }
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept        { return apply<ScalarDiv> (a, b); }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept    { return bitapply<ScalarAnd> (a, b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept    { return bitapply<ScalarOr > (a, b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept    { return bitapply<ScalarXor> (a, b); }
@@ -103,6 +104,30 @@ struct SIMDFallbackOps
         return retval;
     }
 
+    static forcedinline vSIMDType truncate (vSIMDType a) noexcept
+    {
+        vSIMDType retval;
+        auto* dst  = reinterpret_cast<ScalarType*> (&retval);
+        auto* aSrc = reinterpret_cast<const ScalarType*> (&a);
+
+        for (size_t i = 0; i < n; ++i)
+            dst [i] = std::trunc (aSrc [i]);
+
+        return retval;
+    }
+
+    static forcedinline vSIMDType gather (const ScalarType* base, vSIMDType indices) noexcept
+    {
+        vSIMDType retval;
+        auto* dst  = reinterpret_cast<ScalarType*> (&retval);
+        auto* iSrc = reinterpret_cast<const ScalarType*> (&indices);
+
+        for (size_t i = 0; i < n; ++i)
+            dst [i] = base [static_cast<int> (iSrc [i])];
+
+        return retval;
+    }
+
     static forcedinline vSIMDType multiplyAdd (vSIMDType a, vSIMDType b, vSIMDType c) noexcept
     {
         vSIMDType retval;
@@ -135,6 +160,7 @@ struct SIMDFallbackOps
     struct ScalarAdd { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return a + b; } };
     struct ScalarSub { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return a - b; } };
     struct ScalarMul { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return a * b; } };
+    struct ScalarDiv { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return a / b; } };
     struct ScalarMin { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return jmin (a, b); } };
     struct ScalarMax { static forcedinline ScalarType   op (ScalarType a, ScalarType b)   noexcept { return jmax (a, b); } };
     struct ScalarAnd { static forcedinline MaskType     op (MaskType a,   MaskType b)     noexcept { return a & b; } };
@@ -70,6 +70,8 @@ struct SIMDNativeOps<float>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept        { return vaddq_f32 (a, b); }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept        { return vsubq_f32 (a, b); }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept        { return vmulq_f32 (a, b); }
+    static forcedinline vSIMDType truncate (vSIMDType a) noexcept                { return vcvtq_f32_s32 (vcvtq_s32_f32 (a)); }
+    static forcedinline vSIMDType gather (const float* base, vSIMDType indices) noexcept { return fb::gather (base, indices); }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept    { return (vSIMDType) vandq_u32 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept    { return (vSIMDType) vorrq_u32 ((vMaskType) a, (vMaskType) b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept    { return (vSIMDType) veorq_u32 ((vMaskType) a, (vMaskType) b); }
@@ -89,6 +91,19 @@ struct SIMDNativeOps<float>
     static forcedinline vSIMDType oddevensum (vSIMDType a) noexcept { return add (fb::shuffle<(2 << 0) | (3 << 2) | (0 << 4) | (1 << 6)> (a), a); }
 
     //==============================================================================
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept
+    {
+       #if defined (__aarch64__) || defined (__arm64__)
+        return vdivq_f32 (a, b);
+       #else
+        // 32-bit NEON has no division, so the reciprocal estimate is refined with two Newton-Raphson steps
+        auto reciprocal = vrecpeq_f32 (b);
+        reciprocal = vmulq_f32 (vrecpsq_f32 (b, reciprocal), reciprocal);
+        reciprocal = vmulq_f32 (vrecpsq_f32 (b, reciprocal), reciprocal);
+        return vmulq_f32 (a, reciprocal);
+       #endif
+    }
+
     static forcedinline vSIMDType cmplxmul (vSIMDType a, vSIMDType b) noexcept
     {
         vSIMDType rr_ir = mul (a, dupeven (b));
@@ -112,6 +127,7 @@ struct SIMDNativeOps<double>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept        { return fb::add (a, b); }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept        { return fb::sub (a, b); }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept        { return fb::mul (a, b); }
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept        { return fb::div (a, b); }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept    { return fb::bit_and (a, b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept    { return fb::bit_or  (a, b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept    { return fb::bit_xor (a, b); }
@@ -124,6 +140,8 @@ struct SIMDNativeOps<double>
     static forcedinline vSIMDType greaterThan (vSIMDType a, vSIMDType b) noexcept            { return fb::greaterThan (a, b); }
     static forcedinline vSIMDType greaterThanOrEqual (vSIMDType a, vSIMDType b) noexcept     { return fb::greaterThanOrEqual (a, b); }
     static forcedinline vSIMDType multiplyAdd (vSIMDType a, vSIMDType b, vSIMDType c) noexcept { return fb::multiplyAdd (a, b, c); }
+    static forcedinline vSIMDType truncate (vSIMDType a) noexcept                { return fb::truncate (a); }
+    static forcedinline vSIMDType gather (const double* base, vSIMDType indices) noexcept { return fb::gather (base, indices); }
     static forcedinline vSIMDType cmplxmul (vSIMDType a, vSIMDType b) noexcept { return fb::cmplxmul (a, b); }
     static forcedinline double sum (vSIMDType a) noexcept { return fb::sum (a); }
     static forcedinline vSIMDType oddevensum (vSIMDType a) noexcept { return a; }
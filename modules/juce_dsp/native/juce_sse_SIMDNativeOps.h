@@ -68,6 +68,8 @@ struct SIMDNativeOps<float>
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE add (__m128 a, __m128 b) noexcept                    { return _mm_add_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE sub (__m128 a, __m128 b) noexcept                    { return _mm_sub_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE mul (__m128 a, __m128 b) noexcept                    { return _mm_mul_ps (a, b); }
+    static forcedinline __m128 JUCE_VECTOR_CALLTYPE div (__m128 a, __m128 b) noexcept                    { return _mm_div_ps (a, b); }
+    static forcedinline __m128 JUCE_VECTOR_CALLTYPE truncate (__m128 a) noexcept                         { return _mm_cvtepi32_ps (_mm_cvttps_epi32 (a)); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_and (__m128 a, __m128 b) noexcept                { return _mm_and_ps (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_or  (__m128 a, __m128 b) noexcept                { return _mm_or_ps  (a, b); }
     static forcedinline __m128 JUCE_VECTOR_CALLTYPE bit_xor (__m128 a, __m128 b) noexcept                { return _mm_xor_ps (a, b); }
@@ -93,6 +95,17 @@ struct SIMDNativeOps<float>
         return add (rr_ir, bit_xor (ii_ri, _mm_loadu_ps ((float*) kEvenHighBit)));
     }
 
+    static forcedinline __m128 JUCE_VECTOR_CALLTYPE gather (const float* base, __m128 indices) noexcept
+    {
+        // SSE has no gather instruction, so the elements are loaded one at a time
+        __m128i i = _mm_cvttps_epi32 (indices);
+
+        return _mm_setr_ps (base[_mm_cvtsi128_si32 (i)],
+                            base[_mm_cvtsi128_si32 (_mm_shuffle_epi32 (i, _MM_SHUFFLE (1, 1, 1, 1)))],
+                            base[_mm_cvtsi128_si32 (_mm_shuffle_epi32 (i, _MM_SHUFFLE (2, 2, 2, 2)))],
+                            base[_mm_cvtsi128_si32 (_mm_shuffle_epi32 (i, _MM_SHUFFLE (3, 3, 3, 3)))]);
+    }
+
     static forcedinline float JUCE_VECTOR_CALLTYPE sum (__m128 a) noexcept
     {
        #if defined(__SSE4__)
@@ -127,6 +140,8 @@ struct SIMDNativeOps<double>
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE add (__m128d a, __m128d b) noexcept                     { return _mm_add_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE sub (__m128d a, __m128d b) noexcept                     { return _mm_sub_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE mul (__m128d a, __m128d b) noexcept                     { return _mm_mul_pd (a, b); }
+    static forcedinline __m128d JUCE_VECTOR_CALLTYPE div (__m128d a, __m128d b) noexcept                     { return _mm_div_pd (a, b); }
+    static forcedinline __m128d JUCE_VECTOR_CALLTYPE truncate (__m128d a) noexcept                           { return _mm_cvtepi32_pd (_mm_cvttpd_epi32 (a)); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_and (__m128d a, __m128d b) noexcept                 { return _mm_and_pd (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_or  (__m128d a, __m128d b) noexcept                 { return _mm_or_pd  (a, b); }
     static forcedinline __m128d JUCE_VECTOR_CALLTYPE bit_xor (__m128d a, __m128d b) noexcept                 { return _mm_xor_pd (a, b); }
@@ -152,6 +167,12 @@ struct SIMDNativeOps<double>
         return add (rr_ir, bit_xor (ii_ri, vconst (kEvenHighBit)));
     }
 
+    static forcedinline __m128d JUCE_VECTOR_CALLTYPE gather (const double* base, __m128d indices) noexcept
+    {
+        return _mm_setr_pd (base[_mm_cvttsd_si32 (indices)],
+                            base[_mm_cvttsd_si32 (_mm_unpackhi_pd (indices, indices))]);
+    }
+
     static forcedinline double JUCE_VECTOR_CALLTYPE sum (__m128d a) noexcept
     {
        #if defined(__SSE4__)
@@ -0,0 +1,464 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace BandLimitedOscillatorHelpers
+{
+    /** The operations needed by the voice loops, for scalars or SIMD registers. */
+    template <typename Type>
+    struct VectorOps
+    {
+        static Type expand (Type s) noexcept           { return s; }
+        static Type max (Type a, Type b) noexcept      { return jmax (a, b); }
+        static Type wrap (Type p) noexcept             { return p >= static_cast<Type> (1) ? p - static_cast<Type> (1) : p; }
+        static Type sum (Type a) noexcept              { return a; }
+    };
+
+   #if JUCE_USE_SIMD
+    template <typename Type>
+    struct VectorOps<SIMDRegister<Type>>
+    {
+        using Vector = SIMDRegister<Type>;
+
+        static Vector expand (Type s) noexcept         { return Vector::expand (s); }
+        static Vector max (Vector a, Vector b) noexcept { return Vector::max (a, b); }
+        static Type sum (Vector a) noexcept            { return a.sum(); }
+
+        static Vector wrap (Vector p) noexcept
+        {
+            auto one = Vector::expand (static_cast<Type> (1));
+            return p - (one & Vector::greaterThanOrEqual (p, one));
+        }
+    };
+   #endif
+}
+
+//==============================================================================
+template <typename FloatType>
+Wavetable<FloatType>::Wavetable (const Array<FloatType>& sineAmplitudes,
+                                 const Array<FloatType>& cosineAmplitudes,
+                                 size_t size)
+    : Wavetable (0, sineAmplitudes, cosineAmplitudes, size)
+{
+}
+
+template <typename FloatType>
+Wavetable<FloatType>::Wavetable (FloatType dcOffset,
+                                 const Array<FloatType>& sineAmplitudes,
+                                 const Array<FloatType>& cosineAmplitudes,
+                                 size_t size)
+    : tableSize (size)
+{
+    jassert (tableSize >= 8);
+
+    // the highest harmonic which isn't silent, keeping the tables oversampled
+    // by at least two, so that they can be interpolated linearly
+    auto getAmplitude = [] (const Array<FloatType>& amplitudes, size_t harmonic)
+    {
+        return amplitudes[static_cast<int> (harmonic) - 1];
+    };
+
+    auto numAmplitudes = static_cast<size_t> (jmax (sineAmplitudes.size(), cosineAmplitudes.size()));
+    numHarmonics = jmin (numAmplitudes, tableSize / 4);
+
+    while (numHarmonics > 0 && getAmplitude (sineAmplitudes, numHarmonics) == 0
+                            && getAmplitude (cosineAmplitudes, numHarmonics) == 0)
+        --numHarmonics;
+
+    numTables = 1;
+
+    for (auto h = numHarmonics; h > 1; h >>= 1)
+        ++numTables;
+
+    tables.allocate ((tableSize + 2) * numTables, true);
+
+    HeapBlock<double> sines (tableSize), cosines (tableSize), sum (tableSize, true);
+
+    for (size_t i = 0; i < tableSize; ++i)
+    {
+        auto angle = (2.0 * double_Pi) * static_cast<double> (i) / static_cast<double> (tableSize);
+        sines[i]   = std::sin (angle);
+        cosines[i] = std::cos (angle);
+    }
+
+    // the tables are built from the one with the fewest harmonics upwards, so that
+    // each harmonic is only added to the sum once
+    size_t harmonic = 1;
+
+    for (auto index = numTables; index > 0; --index)
+    {
+        auto numHarmonicsInTable = getNumHarmonics (index - 1);
+
+        for (; harmonic <= numHarmonicsInTable; ++harmonic)
+        {
+            auto s = static_cast<double> (getAmplitude (sineAmplitudes, harmonic));
+            auto c = static_cast<double> (getAmplitude (cosineAmplitudes, harmonic));
+            size_t phase = 0;
+
+            for (size_t i = 0; i < tableSize; ++i)
+            {
+                sum[i] += s * sines[phase] + c * cosines[phase];
+                phase = (phase + harmonic) % tableSize;
+            }
+        }
+
+        auto* destination = tables + (index - 1) * (tableSize + 2);
+
+        for (size_t i = 0; i < tableSize; ++i)
+            destination[i] = static_cast<FloatType> (sum[i]) + dcOffset;
+
+        destination[tableSize]     = destination[0];
+        destination[tableSize + 1] = destination[1];
+    }
+}
+
+template <typename FloatType>
+Wavetable<FloatType>* Wavetable<FloatType>::createFromFunction (const std::function<FloatType (FloatType)>& function,
+                                                                size_t size)
+{
+    jassert (size >= 8);
+
+    HeapBlock<double> samples (size);
+    double dcOffset = 0;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        auto x = (2.0 * double_Pi) * static_cast<double> (i) / static_cast<double> (size) - double_Pi;
+        samples[i] = static_cast<double> (function (static_cast<FloatType> (x)));
+        dcOffset += samples[i];
+    }
+
+    // only the harmonics which fit into the tables are analysed
+    auto numHarmonics = size / 4;
+    Array<FloatType> sineAmplitudes, cosineAmplitudes;
+
+    for (size_t harmonic = 1; harmonic <= numHarmonics; ++harmonic)
+    {
+        double s = 0, c = 0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto angle = (2.0 * double_Pi) * static_cast<double> ((harmonic * i) % size) / static_cast<double> (size);
+            s += samples[i] * std::sin (angle);
+            c += samples[i] * std::cos (angle);
+        }
+
+        sineAmplitudes  .add (static_cast<FloatType> (2.0 * s / static_cast<double> (size)));
+        cosineAmplitudes.add (static_cast<FloatType> (2.0 * c / static_cast<double> (size)));
+    }
+
+    return new Wavetable (static_cast<FloatType> (dcOffset / static_cast<double> (size)),
+                          sineAmplitudes, cosineAmplitudes, size);
+}
+
+template <typename FloatType>
+size_t Wavetable<FloatType>::getNumHarmonics (size_t tableIndex) const noexcept
+{
+    jassert (tableIndex < numTables);
+    return numHarmonics >> tableIndex;
+}
+
+template <typename FloatType>
+size_t Wavetable<FloatType>::getTableIndexForIncrement (FloatType phaseIncrement) const noexcept
+{
+    // table i has at most numHarmonics / 2^i harmonics, which all stay below
+    // the Nyquist frequency if that number times the increment is below 0.5
+    auto ratio = static_cast<FloatType> (2 * numHarmonics) * phaseIncrement;
+    size_t index = 0;
+
+    while (ratio > static_cast<FloatType> (1) && index + 1 < numTables)
+    {
+        ratio *= static_cast<FloatType> (0.5);
+        ++index;
+    }
+
+    return index;
+}
+
+template <typename FloatType>
+const FloatType* Wavetable<FloatType>::getTable (size_t tableIndex) const noexcept
+{
+    jassert (tableIndex < numTables);
+    return tables + tableIndex * (tableSize + 2);
+}
+
+//==============================================================================
+template <typename FloatType>
+BandLimitedOscillator<FloatType>::BandLimitedOscillator()
+    : sineTable (new Wavetable<FloatType> (Array<FloatType> (static_cast<FloatType> (1))))
+{
+    voiceMemory.malloc ((numGroups * 4 + 1) * sizeof (VectorType));
+
+    phases        = snapPointerToAlignment (reinterpret_cast<VectorType*> (voiceMemory.getData()), sizeof (VectorType));
+    ratios        = phases + numGroups;
+    inverseRatios = ratios + numGroups;
+    gains         = inverseRatios + numGroups;
+
+    updateVoices();
+    reset();
+}
+
+template <typename FloatType>
+BandLimitedOscillator<FloatType>::~BandLimitedOscillator()
+{
+}
+
+//==============================================================================
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::setWaveform (Waveform newWaveform) noexcept
+{
+    // a wavetable has to be given with setWavetable() first!
+    jassert (newWaveform != wavetable || table != nullptr);
+
+    waveform = newWaveform;
+}
+
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::setWavetable (Wavetable<FloatType>* newWavetable) noexcept
+{
+    table = newWavetable;
+
+    if (table != nullptr)
+        waveform = wavetable;
+}
+
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::setNumVoices (int newNumVoices) noexcept
+{
+    jassert (newNumVoices > 0 && newNumVoices <= maxNumVoices);
+
+    numVoices = jlimit (1, static_cast<int> (maxNumVoices), newNumVoices);
+    updateVoices();
+}
+
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::setDetune (FloatType newDetuneInCents) noexcept
+{
+    detune = newDetuneInCents;
+    updateVoices();
+}
+
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::updateVoices() noexcept
+{
+    auto* voiceRatios        = reinterpret_cast<FloatType*> (ratios);
+    auto* voiceInverseRatios = reinterpret_cast<FloatType*> (inverseRatios);
+    auto* voiceGains         = reinterpret_cast<FloatType*> (gains);
+
+    // the voices are summed with equal power, as their phases are uncorrelated
+    auto gain = static_cast<FloatType> (1.0 / std::sqrt (static_cast<double> (numVoices)));
+
+    for (int voice = 0; voice < static_cast<int> (numGroups * numLanes); ++voice)
+    {
+        auto cents = numVoices > 1 ? static_cast<double> (detune) * (voice / static_cast<double> (numVoices - 1) - 0.5) : 0.0;
+        auto ratio = voice < numVoices ? std::pow (2.0, cents / 1200.0) : 1.0;
+
+        voiceRatios[voice]        = static_cast<FloatType> (ratio);
+        voiceInverseRatios[voice] = static_cast<FloatType> (1.0 / ratio);
+        voiceGains[voice]         = voice < numVoices ? gain : static_cast<FloatType> (0);
+    }
+}
+
+//==============================================================================
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::prepare (const ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    reset();
+}
+
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::reset() noexcept
+{
+    auto* voicePhases = reinterpret_cast<FloatType*> (phases);
+
+    // the unison voices start with spread phases, so that they don't all add up at once
+    for (size_t voice = 0; voice < numGroups * numLanes; ++voice)
+    {
+        auto phase = static_cast<double> (voice) * 0.6180339887498949;
+        voicePhases[voice] = static_cast<FloatType> (phase - std::floor (phase));
+    }
+
+    frequency.reset (sampleRate, 0.05);
+}
+
+//==============================================================================
+template <typename FloatType>
+void BandLimitedOscillator<FloatType>::generate (FloatType* output, size_t numSamples) noexcept
+{
+    constexpr size_t chunkSize = 256;
+    FloatType increments[chunkSize];
+
+    auto scale = static_cast<FloatType> (1.0 / sampleRate);
+    auto shape = (waveform == wavetable && table == nullptr) ? sine : waveform;
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+    {
+        auto num = jmin (chunkSize, numSamples - start);
+        auto isSmoothing = frequency.isSmoothing();
+
+        if (isSmoothing)
+        {
+            for (size_t i = 0; i < num; ++i)
+                increments[i] = frequency.getNextValue() * scale;
+        }
+        else
+        {
+            increments[0] = frequency.getNextValue() * scale;
+        }
+
+        auto* dst = output + start;
+
+        switch (shape)
+        {
+            case triangle:  isSmoothing ? render<triangle, true>  (dst, num, increments) : render<triangle, false>  (dst, num, increments); break;
+            case saw:       isSmoothing ? render<saw, true>       (dst, num, increments) : render<saw, false>       (dst, num, increments); break;
+            case square:    isSmoothing ? render<square, true>    (dst, num, increments) : render<square, false>    (dst, num, increments); break;
+            case wavetable: isSmoothing ? render<wavetable, true> (dst, num, increments) : render<wavetable, false> (dst, num, increments); break;
+            case sine:
+            default:        isSmoothing ? render<sine, true>      (dst, num, increments) : render<sine, false>      (dst, num, increments); break;
+        }
+    }
+}
+
+template <typename FloatType>
+template <int shape, bool isSmoothing>
+void BandLimitedOscillator<FloatType>::render (FloatType* output, size_t numSamples, const FloatType* increments) noexcept
+{
+    using Ops = BandLimitedOscillatorHelpers::VectorOps<VectorType>;
+
+    auto numActiveGroups = (static_cast<size_t> (numVoices) + numLanes - 1) / numLanes;
+
+    // the table of each voice is chosen for the highest frequency of the chunk
+    const FloatType* voiceTables[numGroups * numLanes] = {};
+    const Wavetable<FloatType>* wavetableToUse = (shape == wavetable ? table : sineTable).get();
+    auto size = wavetableToUse->getTableSize();
+
+    if (shape == sine || shape == wavetable)
+    {
+        auto maxIncrement = isSmoothing ? *std::max_element (increments, increments + numSamples) : increments[0];
+        auto* voiceRatios = reinterpret_cast<const FloatType*> (ratios);
+
+        for (size_t voice = 0; voice < numActiveGroups * numLanes; ++voice)
+            voiceTables[voice] = wavetableToUse->getTable (wavetableToUse->getTableIndexForIncrement (maxIncrement * voiceRatios[voice]));
+    }
+
+    auto zero = Ops::expand (static_cast<FloatType> (0));
+    auto one  = Ops::expand (static_cast<FloatType> (1));
+    auto two  = Ops::expand (static_cast<FloatType> (2));
+    auto half = Ops::expand (static_cast<FloatType> (0.5));
+
+    // the saw with its PolyBLEP correction, where a and b are the distances to the
+    // discontinuity after and before it, relative to one sample and clipped to 0
+    auto polyBLEPSaw = [=] (VectorType phase, VectorType inverseIncrement, VectorType& a, VectorType& b) noexcept
+    {
+        a = Ops::max (zero, one - phase * inverseIncrement);
+        b = Ops::max (zero, one - (one - phase) * inverseIncrement);
+
+        return phase * two - one + a * a - b * b;
+    };
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto baseIncrement = increments[isSmoothing ? i : 0];
+        auto baseInverseIncrement = baseIncrement > 0 ? static_cast<FloatType> (1) / baseIncrement
+                                                      : static_cast<FloatType> (1.0e9);
+        auto sum = zero;
+
+        for (size_t group = 0; group < numActiveGroups; ++group)
+        {
+            auto phase = phases[group];
+            auto increment = ratios[group] * baseIncrement;
+            VectorType value;
+
+            if (shape == sine || shape == wavetable)
+            {
+                // there's no gather, so the tables are read lane by lane, skipping the silent voices
+                auto* phaseLanes = reinterpret_cast<const FloatType*> (&phase);
+                auto* valueLanes = reinterpret_cast<FloatType*> (&value);
+                auto** groupTables = voiceTables + group * numLanes;
+                auto numActiveLanes = jmin (numLanes, static_cast<size_t> (numVoices) - group * numLanes);
+
+                value = zero;
+
+                for (size_t lane = 0; lane < numActiveLanes; ++lane)
+                    valueLanes[lane] = Wavetable<FloatType>::interpolate (groupTables[lane], size, phaseLanes[lane]);
+            }
+            else
+            {
+                auto inverseIncrement = inverseRatios[group] * baseInverseIncrement;
+                VectorType a, b;
+
+                if (shape == saw)
+                {
+                    value = polyBLEPSaw (phase, inverseIncrement, a, b);
+                }
+                else
+                {
+                    VectorType a2, b2;
+                    auto shiftedPhase = Ops::wrap (phase + half);
+
+                    if (shape == square)
+                    {
+                        // the difference of two saws half a cycle apart
+                        value = polyBLEPSaw (shiftedPhase, inverseIncrement, a2, b2) - polyBLEPSaw (phase, inverseIncrement, a, b);
+                    }
+                    else
+                    {
+                        // the corners at 0 and half a cycle are rounded with PolyBLAMP corrections,
+                        // scaled by the change of slope of 8 per cycle
+                        polyBLEPSaw (phase, inverseIncrement, a, b);
+                        polyBLEPSaw (shiftedPhase, inverseIncrement, a2, b2);
+
+                        auto distance = phase - half;
+                        auto corners = (a * a * a + b * b * b) - (a2 * a2 * a2 + b2 * b2 * b2);
+
+                        value = one - Ops::max (distance, zero - distance) * Ops::expand (static_cast<FloatType> (4))
+                                  + corners * increment * Ops::expand (static_cast<FloatType> (4.0 / 3.0));
+                    }
+                }
+            }
+
+            sum += value * gains[group];
+            phases[group] = Ops::wrap (phase + increment);
+        }
+
+        output[i] = Ops::sum (sum);
+    }
+}
+
+//==============================================================================
+template class Wavetable<float>;
+template class Wavetable<double>;
+template class BandLimitedOscillator<float>;
+template class BandLimitedOscillator<double>;
+
+} // namespace dsp
+} // namespace juce
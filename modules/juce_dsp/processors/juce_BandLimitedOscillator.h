@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    A set of band-limited tables holding one cycle of a periodic waveform, to be
+    played by a BandLimitedOscillator.
+
+    There is one table per octave: the first table has all the harmonics of the
+    waveform (up to a quarter of the table size), and each following one has half
+    as many harmonics as the previous one. When the waveform is played, the table
+    used is the one with the most harmonics which all stay below the Nyquist
+    frequency, so the waveform doesn't alias, and is never missing more than the
+    top octave of its spectrum.
+
+    The tables can be shared between several oscillators.
+
+    @see BandLimitedOscillator
+*/
+template <typename FloatType>
+class JUCE_API  Wavetable  : public ReferenceCountedObject
+{
+public:
+    /** A typedef for a ref-counted pointer to a wavetable. */
+    using Ptr = ReferenceCountedObjectPtr<Wavetable>;
+
+    /** Creates a wavetable from the amplitudes of its harmonics.
+
+        The element k of each array is the amplitude of harmonic k + 1, so that one
+        cycle of the waveform, with the phase t going from 0 to 1, is the sum of
+        sineAmplitudes[k] * sin (2 pi (k + 1) t) + cosineAmplitudes[k] * cos (2 pi (k + 1) t).
+    */
+    Wavetable (const Array<FloatType>& sineAmplitudes,
+               const Array<FloatType>& cosineAmplitudes = {},
+               size_t tableSize = 2048);
+
+    /** Creates a wavetable from one cycle of a periodic function, such as the ones
+        used by the Oscillator class, which is evaluated from -pi to pi. Its harmonics
+        are found with a discrete Fourier transform of tableSize points.
+    */
+    static Wavetable* createFromFunction (const std::function<FloatType (FloatType)>& function,
+                                          size_t tableSize = 2048);
+
+    //==============================================================================
+    /** Returns the number of samples in each table. */
+    size_t getTableSize() const noexcept                    { return tableSize; }
+
+    /** Returns the number of tables, i.e. the number of octaves which are covered. */
+    size_t getNumTables() const noexcept                    { return numTables; }
+
+    /** Returns the number of harmonics in the first table. */
+    size_t getNumHarmonics() const noexcept                 { return numHarmonics; }
+
+    /** Returns the number of harmonics in one of the tables. */
+    size_t getNumHarmonics (size_t tableIndex) const noexcept;
+
+    /** Returns the index of the table to use for a phase increment, in cycles per
+        sample, so that none of its harmonics goes above the Nyquist frequency.
+    */
+    size_t getTableIndexForIncrement (FloatType phaseIncrement) const noexcept;
+
+    /** Returns one of the tables. It has two extra samples at its end, which repeat
+        the first two, so that it can be interpolated without wrapping the indexes.
+    */
+    const FloatType* getTable (size_t tableIndex) const noexcept;
+
+    /** Returns the interpolated value of one of the tables, for a phase from 0 to 1. */
+    FloatType getSample (size_t tableIndex, FloatType phase) const noexcept
+    {
+        return interpolate (getTable (tableIndex), tableSize, phase);
+    }
+
+    /** Returns the linearly interpolated value of a table for a phase from 0 to 1. */
+    static FloatType interpolate (const FloatType* table, size_t size, FloatType phase) noexcept
+    {
+        auto position = phase * static_cast<FloatType> (size);
+        auto index = static_cast<size_t> (position);
+        auto fraction = position - static_cast<FloatType> (index);
+
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+private:
+    //==============================================================================
+    Wavetable (FloatType dcOffset, const Array<FloatType>& sineAmplitudes,
+               const Array<FloatType>& cosineAmplitudes, size_t tableSize);
+
+    HeapBlock<FloatType> tables;
+    size_t tableSize = 0, numTables = 0, numHarmonics = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Wavetable)
+};
+
+//==============================================================================
+/**
+    An oscillator which generates band-limited waveforms, and can play several
+    detuned unison voices.
+
+    The triangle, saw and square waveforms are generated with PolyBLEP and
+    PolyBLAMP corrections, which remove most of the aliasing of their
+    discontinuities for very little processing. The sine is read from a table, and
+    any other waveform can be played from a mipmapped Wavetable.
+
+    The phases of the unison voices are accumulated side by side in SIMD registers,
+    and the waveforms are rendered by loops which are specialised for each of them,
+    rather than by calling a function for every sample. The voices are summed, and
+    the same signal is written to every channel of the output block, so the
+    oscillator can be used as the first processor of a ProcessorChain.
+
+    @see Wavetable, Oscillator
+*/
+template <typename FloatType>
+class JUCE_API  BandLimitedOscillator
+{
+public:
+    /** The waveforms that can be generated. The saw rises from -1 to 1 over each
+        cycle, the square is 1 during the first half of each cycle, and the triangle
+        starts each cycle at -1.
+    */
+    enum Waveform
+    {
+        sine = 0,
+        triangle,
+        saw,
+        square,
+        wavetable
+    };
+
+    /** The maximum number of unison voices. */
+    enum { maxNumVoices = 16 };
+
+    //==============================================================================
+    /** Creates a sine oscillator with a single voice. */
+    BandLimitedOscillator();
+
+    /** Destructor. */
+    ~BandLimitedOscillator();
+
+    //==============================================================================
+    /** Sets the waveform to generate. The wavetable waveform needs a wavetable to
+        have been given with setWavetable().
+    */
+    void setWaveform (Waveform newWaveform) noexcept;
+
+    /** Returns the waveform which is generated. */
+    Waveform getWaveform() const noexcept                   { return waveform; }
+
+    /** Sets the wavetable to play, and switches to the wavetable waveform. This must
+        not be called while the oscillator is processing.
+    */
+    void setWavetable (Wavetable<FloatType>* newWavetable) noexcept;
+
+    /** Returns the wavetable which is played, if there is one. */
+    Wavetable<FloatType>* getWavetable() const noexcept     { return table.get(); }
+
+    //==============================================================================
+    /** Sets the frequency of the oscillator in Hz. Changes are smoothed over 50 ms. */
+    void setFrequency (FloatType newFrequency) noexcept     { frequency.setValue (newFrequency); }
+
+    /** Returns the frequency of the oscillator in Hz. */
+    FloatType getFrequency() const noexcept                 { return frequency.getTargetValue(); }
+
+    /** Sets the number of unison voices, from 1 to maxNumVoices. */
+    void setNumVoices (int newNumVoices) noexcept;
+
+    /** Returns the number of unison voices. */
+    int getNumVoices() const noexcept                       { return numVoices; }
+
+    /** Sets the detuning between the lowest and highest unison voices, in cents. The
+        other voices are spread evenly between them.
+    */
+    void setDetune (FloatType newDetuneInCents) noexcept;
+
+    /** Returns the detuning between the lowest and highest unison voices, in cents. */
+    FloatType getDetune() const noexcept                    { return detune; }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of the voices. */
+    void reset() noexcept;
+
+    /** Fills the output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto&& outBlock = context.getOutputBlock();
+
+        // this is an output-only processor
+        jassert (context.getInputBlock().getNumChannels() == 0 || (! context.usesSeparateInputAndOutputBlocks()));
+
+        auto numChannels = outBlock.getNumChannels();
+        auto numSamples  = outBlock.getNumSamples();
+
+        if (numChannels == 0)
+            return;
+
+        auto* first = outBlock.getChannelPointer (0);
+        generate (first, numSamples);
+
+        for (size_t ch = 1; ch < numChannels; ++ch)
+            FloatVectorOperations::copy (outBlock.getChannelPointer (ch), first, static_cast<int> (numSamples));
+    }
+
+    /** Generates numSamples samples of the summed voices. */
+    void generate (FloatType* output, size_t numSamples) noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using VectorType = SIMDRegister<FloatType>;
+   #else
+    using VectorType = FloatType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (VectorType) / sizeof (FloatType);
+    static constexpr size_t numGroups = (maxNumVoices + numLanes - 1) / numLanes;
+
+    void updateVoices() noexcept;
+
+    template <int shape, bool isSmoothing>
+    void render (FloatType* output, size_t numSamples, const FloatType* increments) noexcept;
+
+    //==============================================================================
+    // the phases in cycles, and the frequency ratios and gains of the voices,
+    // in groups of SIMD lanes
+    HeapBlock<char> voiceMemory;
+    VectorType* phases = nullptr;
+    VectorType* ratios = nullptr;
+    VectorType* inverseRatios = nullptr;
+    VectorType* gains = nullptr;
+
+    typename Wavetable<FloatType>::Ptr sineTable, table;
+    LinearSmoothedValue<FloatType> frequency { static_cast<FloatType> (440.0) };
+
+    Waveform waveform = sine;
+    int numVoices = 1;
+    FloatType detune = 0;
+    double sampleRate = 48000.0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BandLimitedOscillator)
+};
+
+} // namespace dsp
+} // namespace juce
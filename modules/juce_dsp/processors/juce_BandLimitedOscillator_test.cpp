@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class BandLimitedOscillatorTest : public UnitTest
+{
+    template <typename Type>
+    static Type getPeak (const HeapBlock<Type>& data, size_t numSamples) noexcept
+    {
+        Type peak = {};
+
+        for (size_t i = 0; i < numSamples; ++i)
+            peak = jmax (peak, std::abs (data[i]));
+
+        return peak;
+    }
+
+    template <typename Type>
+    void runSineTest()
+    {
+        constexpr size_t n = 1000;
+        HeapBlock<Type> output (n);
+
+        BandLimitedOscillator<Type> oscillator;
+        oscillator.prepare ({ 48000.0, (uint32) n, 1 });
+        oscillator.setFrequency (static_cast<Type> (1000));
+        oscillator.reset();
+        oscillator.generate (output, n);
+
+        Type maxDifference = {};
+
+        for (size_t i = 0; i < n; ++i)
+            maxDifference = jmax (maxDifference, std::abs (output[i] - static_cast<Type> (std::sin (2.0 * double_Pi * (double) i / 48.0))));
+
+        expect (maxDifference < static_cast<Type> (1e-4));
+    }
+
+    template <typename Type>
+    void runWaveformTest (typename BandLimitedOscillator<Type>::Waveform waveform, int numVoices)
+    {
+        // a whole number of cycles of each frequency, so that a single voice has no DC
+        constexpr size_t n = 4410;
+        HeapBlock<Type> output (n);
+
+        for (auto frequency : { 100.0, 1000.0, 9000.0 })
+        {
+            BandLimitedOscillator<Type> oscillator;
+            oscillator.setWaveform (waveform);
+            oscillator.setNumVoices (numVoices);
+            oscillator.setDetune (static_cast<Type> (25));
+            oscillator.prepare ({ 44100.0, (uint32) n, 1 });
+            oscillator.setFrequency (static_cast<Type> (frequency));
+            oscillator.reset();
+            oscillator.generate (output, n);
+
+            Type sum = {};
+
+            for (size_t i = 0; i < n; ++i)
+                sum += output[i];
+
+            // the voices are summed with equal power, so they can peak above one together
+            auto peak = getPeak (output, n);
+            expect (peak > static_cast<Type> (0.3) && peak < static_cast<Type> (1.5 * std::sqrt ((double) numVoices)));
+
+            if (numVoices == 1)
+                expect (std::abs (sum / static_cast<Type> (n)) < static_cast<Type> (0.01));
+        }
+    }
+
+    void runWavetableTest()
+    {
+        Wavetable<float>::Ptr table (Wavetable<float>::createFromFunction ([] (float x) { return x / float_Pi; }, 1024));
+
+        expectEquals ((int) table->getNumHarmonics(), 256);
+        expectEquals ((int) table->getNumTables(), 9);
+        expectEquals ((int) table->getTableIndexForIncrement (0.0001f), 0);
+        expectEquals ((int) table->getTableIndexForIncrement (0.4f), 8);
+
+        // every table has to stay below Nyquist at the increments it's chosen for
+        for (auto increment : { 0.001f, 0.01f, 0.1f, 0.3f })
+        {
+            auto index = table->getTableIndexForIncrement (increment);
+            expect ((float) table->getNumHarmonics (index) * increment <= 0.5f);
+        }
+
+        // the most detailed table approximates the function itself, away from the step
+        expect (std::abs (table->getSample (0, 0.75f) - 0.5f) < 0.01f);
+        expect (std::abs (table->getSample (0, 0.25f) + 0.5f) < 0.01f);
+    }
+
+public:
+    BandLimitedOscillatorTest() : UnitTest ("Band-limited Oscillator") {}
+
+    void runTest() override
+    {
+        beginTest ("Sine");
+        runSineTest<float>();
+        runSineTest<double>();
+
+        beginTest ("Waveforms");
+
+        for (auto waveform : { BandLimitedOscillator<float>::saw, BandLimitedOscillator<float>::square, BandLimitedOscillator<float>::triangle })
+        {
+            runWaveformTest<float> (waveform, 1);
+            runWaveformTest<float> (waveform, 7);
+        }
+
+        runWaveformTest<double> (BandLimitedOscillator<double>::saw, 16);
+
+        beginTest ("Wavetables");
+        runWavetableTest();
+    }
+};
+
+static BandLimitedOscillatorTest bandLimitedOscillatorTest;
+
+} // namespace dsp
+} // namespace juce
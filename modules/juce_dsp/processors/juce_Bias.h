@@ -88,11 +88,34 @@ public:
     //==============================================================================
     /** Returns the result of processing a single sample. */
     template <typename SampleType>
-    SampleType processSample (SampleType inputSample) const noexcept
+    SampleType processSample (SampleType inputSample) noexcept
     {
         return inputSample + bias.getNextValue();
     }
 
+    /** A per-sample kernel, which lets a ProcessorChain fuse the bias with the
+        processors around it. It works on a copy of the ramp, which it writes back
+        to the Bias when it is destroyed.
+    */
+    template <size_t numChannels>
+    struct FrameKernel
+    {
+        FrameKernel (Bias& b) noexcept  : owner (b), bias (b.bias) {}
+        ~FrameKernel() noexcept         { owner.bias = bias; }
+
+        template <typename SampleType>
+        void processFrame (SampleType* frame) noexcept
+        {
+            auto b = bias.getNextValue();
+
+            for (size_t chan = 0; chan < numChannels; ++chan)
+                frame[chan] += b;
+        }
+
+        Bias& owner;
+        LinearSmoothedValue<FloatType> bias;
+    };
+
     //==============================================================================
     /** Processes the input and output buffers supplied in the processing context. */
     template<typename ProcessContext>
@@ -104,29 +127,7 @@ public:
         jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
         jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
 
-        auto len         = inBlock.getNumSamples();
-        auto numChannels = inBlock.getNumChannels();
-
-        if (numChannels == 1)
-        {
-            auto* src = inBlock.getChannelPointer (0);
-            auto* dst = outBlock.getChannelPointer (0);
-
-            for (size_t i = 0; i < len; ++i)
-                dst[i] = src[i] + bias.getNextValue();
-        }
-        else
-        {
-            auto* biases = static_cast<FloatType*> (alloca (sizeof (FloatType) * len));
-
-            for (size_t i = 0; i < len; ++i)
-                biases[i] = bias.getNextValue();
-
-            for (size_t chan = 0; chan < numChannels; ++chan)
-                FloatVectorOperations::add (outBlock.getChannelPointer (chan),
-                                            inBlock.getChannelPointer (chan),
-                                            biases, static_cast<int> (len));
-        }
+        outBlock.addRamp (inBlock, bias);
     }
 
 
@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FDNReverbHelpers
+{
+    /** The operations needed by the network, for scalars or SIMD registers. */
+    template <typename Type>
+    struct VectorOps
+    {
+        static Type expand (Type s) noexcept                    { return s; }
+        static Type load (const Type* source) noexcept          { return *source; }
+        static void store (Type v, Type* dest) noexcept         { *dest = v; }
+        static Type sum (Type a) noexcept                       { return a; }
+    };
+
+   #if JUCE_USE_SIMD
+    template <typename Type>
+    struct VectorOps<SIMDRegister<Type>>
+    {
+        using Vector = SIMDRegister<Type>;
+
+        static Vector expand (Type s) noexcept                  { return Vector::expand (s); }
+        static Vector load (const Type* source) noexcept        { return Vector::fromRawArray (source); }
+        static void store (Vector v, Type* dest) noexcept       { v.copyToRawArray (dest); }
+        static Type sum (Vector a) noexcept                     { return a.sum(); }
+    };
+   #endif
+
+    // The lengths of the delay lines at the largest room size, in milliseconds. They
+    // are spread over less than an octave, and have no common factors at the usual
+    // sample rates, so that their echoes don't pile up on top of each other.
+    static const double maxDelayTimes[] = { 43.1, 47.9, 53.3, 59.3, 64.9, 71.5, 77.9, 84.7 };
+
+    // The signs with which the input is fed to each line, and with which the lines are
+    // summed into the two outputs. The three patterns are orthogonal, so the outputs
+    // are decorrelated from each other.
+    static const int inputSigns[] = { 1, -1, 1, -1, 1, -1, 1, -1 };
+    static const int leftSigns[]  = { 1, 1, -1, -1, 1, 1, -1, -1 };
+    static const int rightSigns[] = { 1, 1, 1, 1, -1, -1, -1, -1 };
+}
+
+//==============================================================================
+template <typename FloatType>
+FDNReverb<FloatType>::FDNReverb()
+{
+    using namespace FDNReverbHelpers;
+
+    static_assert (numDelayLines % numLanes == 0, "The delay lines must fill a whole number of SIMD registers");
+
+    lineMemory.malloc ((numGroups * 6 + 1) * sizeof (VectorType));
+
+    feedbackGains       = snapPointerToAlignment (reinterpret_cast<VectorType*> (lineMemory.getData()), sizeof (VectorType));
+    dampingCoefficients = feedbackGains + numGroups;
+    filterStates        = dampingCoefficients + numGroups;
+    inputGains          = filterStates + numGroups;
+    leftGains           = inputGains + numGroups;
+    rightGains          = leftGains + numGroups;
+
+    auto scale = static_cast<FloatType> (1.0 / std::sqrt ((double) numDelayLines));
+
+    for (int i = 0; i < numDelayLines; ++i)
+    {
+        reinterpret_cast<FloatType*> (inputGains)[i] = scale * static_cast<FloatType> (inputSigns[i]);
+        reinterpret_cast<FloatType*> (leftGains)[i]  = scale * static_cast<FloatType> (leftSigns[i]);
+        reinterpret_cast<FloatType*> (rightGains)[i] = scale * static_cast<FloatType> (rightSigns[i]);
+    }
+
+    setParameters (Parameters());
+    reset();
+}
+
+template <typename FloatType>
+FDNReverb<FloatType>::~FDNReverb()
+{
+}
+
+//==============================================================================
+template <typename FloatType>
+void FDNReverb<FloatType>::setParameters (const Parameters& newParameters) noexcept
+{
+    parameters = newParameters;
+
+    auto wet = parameters.wetLevel;
+    auto width = parameters.width;
+
+    dryGain .setValue (parameters.dryLevel);
+    wetGain1.setValue (wet * (static_cast<FloatType> (1) + width) / static_cast<FloatType> (2));
+    wetGain2.setValue (wet * (static_cast<FloatType> (1) - width) / static_cast<FloatType> (2));
+
+    updateDelayLines();
+}
+
+template <typename FloatType>
+void FDNReverb<FloatType>::prepare (const ProcessSpec& spec)
+{
+    using namespace FDNReverbHelpers;
+
+    jassert (spec.sampleRate > 0);
+    sampleRate = spec.sampleRate;
+
+    auto maxLength = static_cast<size_t> (std::ceil (maxDelayTimes[numDelayLines - 1] * sampleRate / 1000.0));
+    auto bufferSize = static_cast<size_t> (nextPowerOfTwo (static_cast<int> (maxLength) + 1));
+
+    delayMemory.malloc (bufferSize * numDelayLines);
+    bufferMask = bufferSize - 1;
+
+    const double rampLengthInSeconds = 0.05;
+    dryGain .reset (sampleRate, rampLengthInSeconds);
+    wetGain1.reset (sampleRate, rampLengthInSeconds);
+    wetGain2.reset (sampleRate, rampLengthInSeconds);
+
+    updateDelayLines();
+    reset();
+}
+
+template <typename FloatType>
+void FDNReverb<FloatType>::reset() noexcept
+{
+    if (delayMemory != nullptr)
+        delayMemory.clear ((bufferMask + 1) * numDelayLines);
+
+    for (size_t group = 0; group < numGroups; ++group)
+        filterStates[group] = FDNReverbHelpers::VectorOps<VectorType>::expand (0);
+
+    writeIndex = 0;
+}
+
+template <typename FloatType>
+void FDNReverb<FloatType>::updateDelayLines() noexcept
+{
+    using namespace FDNReverbHelpers;
+
+    auto roomScale = 0.25 + 0.75 * jlimit (0.0, 1.0, static_cast<double> (parameters.roomSize));
+    auto decayTime = jmax (0.05, static_cast<double> (parameters.decayTime));
+    auto damping = jlimit (0.0, 1.0, static_cast<double> (parameters.damping));
+
+    // the damping is given as the gain at Nyquist of a line with the shortest
+    // length, and the longer lines pass through their filters less often per
+    // second, so they're damped more, to make the high frequencies decay at
+    // the same rate in all of them
+    auto shortestLength = maxDelayTimes[0] * roomScale * sampleRate / 1000.0;
+    auto nyquistGain = 1.0 - 0.75 * damping;
+
+    for (int i = 0; i < numDelayLines; ++i)
+    {
+        auto length = jlimit ((size_t) 1, jmax ((size_t) 1, bufferMask),
+                              static_cast<size_t> (maxDelayTimes[i] * roomScale * sampleRate / 1000.0 + 0.5));
+        delayLengths[i] = length;
+
+        // the gain which makes a signal travelling round this line decay by 60dB
+        // in the decay time, ignoring the damping filter
+        auto feedback = std::exp (-std::log (1000.0) * static_cast<double> (length) / (decayTime * sampleRate));
+
+        auto lineNyquistGain = std::pow (nyquistGain, static_cast<double> (length) / shortestLength);
+        auto coefficient = (1.0 - lineNyquistGain) / (1.0 + lineNyquistGain);
+
+        reinterpret_cast<FloatType*> (feedbackGains)[i]       = static_cast<FloatType> (feedback);
+        reinterpret_cast<FloatType*> (dampingCoefficients)[i] = static_cast<FloatType> (coefficient);
+    }
+}
+
+//==============================================================================
+template <typename FloatType>
+void FDNReverb<FloatType>::processStereo (const FloatType* inputLeft, const FloatType* inputRight,
+                                          FloatType* outputLeft, FloatType* outputRight, size_t numSamples) noexcept
+{
+    using Ops = FDNReverbHelpers::VectorOps<VectorType>;
+
+    jassert (inputLeft != nullptr && inputRight != nullptr && outputLeft != nullptr);
+
+    // you need to call prepare() before processing!
+    jassert (delayMemory != nullptr);
+
+    if (delayMemory == nullptr)
+        return;
+
+    // the tail fades away into denormals, which are very slow to process
+    ScopedNoDenormals noDenormals;
+
+    auto* lines = delayMemory.getData();
+    auto half = static_cast<FloatType> (0.5);
+    auto reflectionScale = static_cast<FloatType> (-2.0 / numDelayLines);
+
+    FloatType taps[numDelayLines];
+    VectorType filtered[numGroups];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto inL = inputLeft[i];
+        auto inR = inputRight[i];
+
+        // the lines have different lengths, so their outputs have to be gathered
+        // one at a time, but everything else works on whole registers
+        for (int line = 0; line < numDelayLines; ++line)
+            taps[line] = lines[((writeIndex - delayLengths[line]) & bufferMask) * numDelayLines + (size_t) line];
+
+        auto left  = Ops::expand (0);
+        auto right = Ops::expand (0);
+        auto sum   = Ops::expand (0);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            auto tap = Ops::load (taps + group * numLanes);
+
+            left  += tap * leftGains[group];
+            right += tap * rightGains[group];
+
+            auto state = tap + (filterStates[group] - tap) * dampingCoefficients[group];
+            filterStates[group] = state;
+
+            filtered[group] = state * feedbackGains[group];
+            sum += filtered[group];
+        }
+
+        // A Householder matrix is I - (2 / N) * 1 * 1^T, so mixing the lines through
+        // it only needs the sum of all of them to be subtracted from each one.
+        auto reflection = Ops::expand (Ops::sum (sum) * reflectionScale);
+        auto input = Ops::expand ((inL + inR) * half);
+        auto* destination = lines + writeIndex * numDelayLines;
+
+        for (size_t group = 0; group < numGroups; ++group)
+            Ops::store (filtered[group] + reflection + input * inputGains[group], destination + group * numLanes);
+
+        writeIndex = (writeIndex + 1) & bufferMask;
+
+        auto wetL = Ops::sum (left);
+        auto wetR = Ops::sum (right);
+
+        auto dry  = dryGain.getNextValue();
+        auto wet1 = wetGain1.getNextValue();
+        auto wet2 = wetGain2.getNextValue();
+
+        if (outputRight != nullptr)
+        {
+            outputLeft[i]  = wetL * wet1 + wetR * wet2 + inL * dry;
+            outputRight[i] = wetR * wet1 + wetL * wet2 + inR * dry;
+        }
+        else
+        {
+            outputLeft[i] = (wetL + wetR) * (wet1 + wet2) * half + inL * dry;
+        }
+    }
+}
+
+//==============================================================================
+template class FDNReverb<float>;
+template class FDNReverb<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+/**
+    A stereo reverb made from a feedback delay network.
+
+    The input is fed into eight delay lines, whose outputs are damped by one-pole
+    low-pass filters and mixed back into their inputs through a Householder matrix.
+    The matrix is orthogonal, so it doesn't lose any energy, and the decay time is
+    set exactly by the gain of each line. Unlike the comb filters of a Freeverb,
+    every line feeds every other line, so the echo density builds up much faster
+    and the tail doesn't ring at the frequencies of the individual combs.
+
+    The eight lines are processed side by side in SIMD registers, and a Householder
+    matrix only needs a sum and a subtraction rather than a full matrix product, so
+    the cost per sample is small and doesn't depend on the number of channels.
+
+    The processor takes one or two channels, and can be used in a ProcessorChain.
+
+    @see juce::Reverb
+*/
+template <typename FloatType>
+class JUCE_API  FDNReverb
+{
+public:
+    /** Holds the parameters being used by an FDNReverb. */
+    struct Parameters
+    {
+        FloatType roomSize  = static_cast<FloatType> (0.5);   /**< Room size, 0 to 1.0, which scales the lengths of the delay lines. */
+        FloatType decayTime = static_cast<FloatType> (2.0);   /**< The time in seconds for the tail to decay by 60 dB, at low frequencies. */
+        FloatType damping   = static_cast<FloatType> (0.5);   /**< Damping, 0 to 1.0, where 0 is not damped, 1.0 is fully damped. */
+        FloatType wetLevel  = static_cast<FloatType> (0.33);  /**< Wet level, 0 to 1.0 */
+        FloatType dryLevel  = static_cast<FloatType> (0.4);   /**< Dry level, 0 to 1.0 */
+        FloatType width     = static_cast<FloatType> (1.0);   /**< Reverb width, 0 to 1.0, where 1.0 is very wide. */
+    };
+
+    /** The number of delay lines in the network. */
+    enum { numDelayLines = 8 };
+
+    //==============================================================================
+    /** Creates a reverb with the default parameters. */
+    FDNReverb();
+
+    /** Destructor. */
+    ~FDNReverb();
+
+    //==============================================================================
+    /** Applies a new set of parameters to the reverb.
+        The levels are smoothed, but a change of room size moves the read positions
+        of the delay lines at once, so it may be heard as a click in a playing tail.
+    */
+    void setParameters (const Parameters& newParameters) noexcept;
+
+    /** Returns the reverb's current parameters. */
+    const Parameters& getParameters() const noexcept        { return parameters; }
+
+    //==============================================================================
+    /** Called before processing starts. This allocates the delay lines. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Clears the reverb's tail. */
+    void reset() noexcept;
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto&& inBlock  = context.getInputBlock();
+        auto&& outBlock = context.getOutputBlock();
+
+        jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+        jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
+
+        auto numChannels = outBlock.getNumChannels();
+
+        // only mono and stereo blocks are supported
+        jassert (numChannels == 1 || numChannels == 2);
+
+        if (numChannels == 0)
+            return;
+
+        const FloatType* inputs[2] = { inBlock.getChannelPointer (0),
+                                       inBlock.getChannelPointer (jmin ((size_t) 1, numChannels - 1)) };
+        FloatType* outputs[2] = { outBlock.getChannelPointer (0),
+                                  numChannels > 1 ? outBlock.getChannelPointer (1) : nullptr };
+
+        processStereo (inputs[0], inputs[1], outputs[0], outputs[1], outBlock.getNumSamples());
+    }
+
+    /** Processes a block of stereo samples. The inputs may be the same as the outputs.
+        If the right output is null, the two outputs are summed into the left one,
+        so a mono signal can be processed by passing the same input twice.
+    */
+    void processStereo (const FloatType* inputLeft, const FloatType* inputRight,
+                        FloatType* outputLeft, FloatType* outputRight, size_t numSamples) noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using VectorType = SIMDRegister<FloatType>;
+   #else
+    using VectorType = FloatType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (VectorType) / sizeof (FloatType);
+    static constexpr size_t numGroups = numDelayLines / numLanes;
+
+    void updateDelayLines() noexcept;
+
+    //==============================================================================
+    // the per-line coefficients and filter states, in groups of SIMD lanes
+    HeapBlock<char> lineMemory;
+    VectorType* feedbackGains = nullptr;
+    VectorType* dampingCoefficients = nullptr;
+    VectorType* filterStates = nullptr;
+    VectorType* inputGains = nullptr;
+    VectorType* leftGains = nullptr;
+    VectorType* rightGains = nullptr;
+
+    // the delay lines are interleaved, so that the eight new samples can be
+    // written with a single store for each group
+    HeapBlock<FloatType> delayMemory;
+    size_t bufferMask = 0, writeIndex = 0;
+    size_t delayLengths[numDelayLines] = {};
+
+    Parameters parameters;
+    LinearSmoothedValue<FloatType> dryGain, wetGain1, wetGain2;
+    double sampleRate = 44100.0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverb)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FDNReverbTest : public UnitTest
+{
+    template <typename Type>
+    static Type getEnergy (const HeapBlock<Type>& data, size_t start, size_t numSamples) noexcept
+    {
+        Type energy = {};
+
+        for (size_t i = start; i < start + numSamples; ++i)
+            energy += data[i] * data[i];
+
+        return energy;
+    }
+
+    template <typename Type>
+    void runDecayTest()
+    {
+        const double sampleRate = 48000.0;
+        const size_t n = 48000 * 2;
+        HeapBlock<Type> left (n, true), right (n, true);
+        left[0] = right[0] = static_cast<Type> (1);
+
+        FDNReverb<Type> reverb;
+        typename FDNReverb<Type>::Parameters params;
+        params.decayTime = static_cast<Type> (1);
+        params.damping = 0;
+        params.dryLevel = 0;
+        params.wetLevel = static_cast<Type> (1);
+        reverb.setParameters (params);
+        reverb.prepare ({ sampleRate, (uint32) n, 2 });
+        reverb.processStereo (left, right, left, right, n);
+
+        // the energy in a window after the decay time should be about 60dB below
+        // the energy in the same window at the start of the tail
+        const size_t window = 4800;
+        auto early = getEnergy (left, 4800, window) + getEnergy (right, 4800, window);
+        auto late  = getEnergy (left, 4800 + 48000, window) + getEnergy (right, 4800 + 48000, window);
+
+        expect (early > 0 && late > 0);
+
+        auto decayInDecibels = 10.0 * std::log10 (static_cast<double> (early / late));
+        expect (decayInDecibels > 54.0 && decayInDecibels < 66.0);
+
+        // the two outputs are made from orthogonal mixes of the lines, so they
+        // shouldn't be the same signal
+        Type difference = {};
+
+        for (size_t i = 0; i < n; ++i)
+            difference = jmax (difference, std::abs (left[i] - right[i]));
+
+        expect (difference > static_cast<Type> (1e-3));
+    }
+
+    void runDryTest()
+    {
+        const size_t n = 512;
+        HeapBlock<float> input (n), output (n);
+        Random r (1234);
+
+        for (size_t i = 0; i < n; ++i)
+            input[i] = r.nextFloat() * 2.0f - 1.0f;
+
+        FDNReverb<float> reverb;
+        FDNReverb<float>::Parameters params;
+        params.wetLevel = 0;
+        params.dryLevel = 1.0f;
+        reverb.setParameters (params);
+        reverb.prepare ({ 44100.0, (uint32) n, 1 });
+
+        auto* channels = output.getData();
+        FloatVectorOperations::copy (output, input, (int) n);
+
+        AudioBlock<float> block (&channels, 1, n);
+        reverb.process (ProcessContextReplacing<float> (block));
+
+        for (size_t i = 0; i < n; ++i)
+            expectEquals (output[i], input[i]);
+    }
+
+    void runChainTest()
+    {
+        const size_t n = 4096;
+        AudioBuffer<float> buffer (2, (int) n);
+        buffer.clear();
+        buffer.setSample (0, 0, 1.0f);
+
+        ProcessorChain<Gain<float>, FDNReverb<float>> chain;
+        chain.get<0>().setGainLinear (0.5f);
+        chain.prepare ({ 44100.0, (uint32) n, 2 });
+
+        AudioBlock<float> block (buffer);
+        chain.process (ProcessContextReplacing<float> (block));
+
+        // the dry impulse comes straight through, and the tail starts after the
+        // shortest delay line
+        expect (std::abs (buffer.getSample (0, 0) - 0.5f * 0.4f) < 1.0e-6f);
+        expect (buffer.getMagnitude (1, 1, (int) n - 1) > 0.0f);
+    }
+
+public:
+    FDNReverbTest() : UnitTest ("FDN Reverb") {}
+
+    void runTest() override
+    {
+        beginTest ("Decay time");
+        runDecayTest<float>();
+        runDecayTest<double>();
+
+        beginTest ("Dry signal");
+        runDryTest();
+
+        beginTest ("Processor chain");
+        runChainTest();
+    }
+};
+
+static FDNReverbTest fdnReverbTest;
+
+} // namespace dsp
+} // namespace juce
@@ -154,6 +154,162 @@ void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
     FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
 }
 
+//==============================================================================
+FIR::PartitionedFilterTail::PartitionedFilterTail (size_t newBlockSize, const float* coefficients, size_t newNumCoefficients)
+    : blockSize (newBlockSize), numBins (newBlockSize + 1), numCoefficients (newNumCoefficients),
+      numPartitions ((newNumCoefficients + newBlockSize - 1) / newBlockSize),
+      fft (new FFT (findHighestSetBit (static_cast<uint32> (2 * newBlockSize))))
+{
+    // The FFT size must be a power of two
+    jassert (isPowerOfTwo (blockSize));
+
+    coefficientsInUse.malloc (numCoefficients);
+    filterSpectra.malloc (2 * numBins * numPartitions);
+    inputSpectra.malloc (2 * numBins * numPartitions);
+    window.malloc (2 * blockSize);
+    fftBuffer.malloc (4 * blockSize);
+    accumulator.malloc (2 * numBins);
+    tailOutput.malloc (blockSize);
+
+    updateSpectra (coefficients);
+    reset();
+}
+
+FIR::PartitionedFilterTail::~PartitionedFilterTail() {}
+
+size_t FIR::PartitionedFilterTail::getBlockSizeForFilter (size_t filterSize) noexcept
+{
+    // The time domain part costs blockSize operations per sample, whereas the cost
+    // of the frequency domain part per sample goes down with bigger blocks, as there
+    // are fewer partitions and FFTs for the same filter size
+    size_t newBlockSize = 64;
+
+    while (newBlockSize < 512 && filterSize > 16 * newBlockSize)
+        newBlockSize *= 2;
+
+    return newBlockSize;
+}
+
+void FIR::PartitionedFilterTail::reset() noexcept
+{
+    inputSpectra.clear (2 * numBins * numPartitions);
+    window.clear (2 * blockSize);
+    tailOutput.clear (blockSize);
+
+    position = 0;
+    currentPartition = 0;
+}
+
+void FIR::PartitionedFilterTail::pushInput (const float* input, size_t numSamples) noexcept
+{
+    jassert (position + numSamples <= blockSize);
+
+    FloatVectorOperations::copy (window + blockSize + position, input, static_cast<int> (numSamples));
+}
+
+void FIR::PartitionedFilterTail::addOutput (float* output, size_t numSamples, const float* coefficients) noexcept
+{
+    jassert (position + numSamples <= blockSize);
+
+    FloatVectorOperations::add (output, tailOutput + position, static_cast<int> (numSamples));
+    position += numSamples;
+
+    if (position == blockSize)
+    {
+        processBlock (coefficients);
+        position = 0;
+    }
+}
+
+void FIR::PartitionedFilterTail::processBlock (const float* coefficients) noexcept
+{
+    if (! std::equal (coefficients, coefficients + numCoefficients, coefficientsInUse.getData()))
+        updateSpectra (coefficients);
+
+    // The spectrum of the last two blocks goes into the frequency domain delay line
+    FloatVectorOperations::copy (fftBuffer, window, static_cast<int> (2 * blockSize));
+    FloatVectorOperations::copy (window, window + blockSize, static_cast<int> (blockSize));
+    fft->performRealOnlyForwardTransform (fftBuffer, true);
+
+    currentPartition = (currentPartition == 0 ? numPartitions : currentPartition) - 1;
+    auto* spectrum = inputSpectra + 2 * numBins * currentPartition;
+
+    for (size_t i = 0; i < numBins; ++i)
+    {
+        spectrum[i]           = fftBuffer[2 * i];
+        spectrum[numBins + i] = fftBuffer[2 * i + 1];
+    }
+
+    // Each partition of the filter is multiplied with the spectrum of the input
+    // delayed by the same number of blocks
+    auto* accumulatorReal = accumulator.getData();
+    auto* accumulatorImag = accumulatorReal + numBins;
+    auto num = static_cast<int> (numBins);
+
+    accumulator.clear (2 * numBins);
+
+    for (size_t i = 0; i < numPartitions; ++i)
+    {
+        auto index = currentPartition + i;
+
+        if (index >= numPartitions)
+            index -= numPartitions;
+
+        auto* inputReal  = inputSpectra + 2 * numBins * index;
+        auto* inputImag  = inputReal + numBins;
+        auto* filterReal = filterSpectra + 2 * numBins * i;
+        auto* filterImag = filterReal + numBins;
+
+        FloatVectorOperations::addWithMultiply      (accumulatorReal, inputReal, filterReal, num);
+        FloatVectorOperations::subtractWithMultiply (accumulatorReal, inputImag, filterImag, num);
+        FloatVectorOperations::addWithMultiply      (accumulatorImag, inputReal, filterImag, num);
+        FloatVectorOperations::addWithMultiply      (accumulatorImag, inputImag, filterReal, num);
+    }
+
+    auto fftSize = 2 * blockSize;
+
+    for (size_t i = 0; i < numBins; ++i)
+    {
+        fftBuffer[2 * i]     = accumulatorReal[i];
+        fftBuffer[2 * i + 1] = accumulatorImag[i];
+    }
+
+    for (size_t i = 1; i < blockSize; ++i)
+    {
+        fftBuffer[2 * (fftSize - i)]     =  accumulatorReal[i];
+        fftBuffer[2 * (fftSize - i) + 1] = -accumulatorImag[i];
+    }
+
+    fft->performRealOnlyInverseTransform (fftBuffer);
+
+    // With overlap-save, the second half of the result is the output of the
+    // partitions for the block which is about to start
+    FloatVectorOperations::copy (tailOutput, fftBuffer + blockSize, static_cast<int> (blockSize));
+}
+
+void FIR::PartitionedFilterTail::updateSpectra (const float* coefficients) noexcept
+{
+    std::copy (coefficients, coefficients + numCoefficients, coefficientsInUse.getData());
+
+    for (size_t i = 0; i < numPartitions; ++i)
+    {
+        auto offset = i * blockSize;
+        auto num = jmin (blockSize, numCoefficients - offset);
+
+        fftBuffer.clear (4 * blockSize);
+        FloatVectorOperations::copy (fftBuffer, coefficients + offset, static_cast<int> (num));
+        fft->performRealOnlyForwardTransform (fftBuffer, true);
+
+        auto* spectrum = filterSpectra + 2 * numBins * i;
+
+        for (size_t j = 0; j < numBins; ++j)
+        {
+            spectrum[j]           = fftBuffer[2 * j];
+            spectrum[numBins + j] = fftBuffer[2 * j + 1];
+        }
+    }
+}
+
 //==============================================================================
 template struct FIR::Coefficients<float>;
 template struct FIR::Coefficients<double>;
@@ -29,6 +29,8 @@ namespace juce
 namespace dsp
 {
 
+class FFT;
+
 /**
     Classes for FIR filter processing.
 */
@@ -37,15 +39,61 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+    //==============================================================================
+    /** @internal
+        The uniform-partitioned frequency domain engine which a FIR::Filter<float>
+        uses for the coefficients of a long filter which come after its first block.
+
+        The input is recorded one block at a time, and the contribution of all the
+        partitions to the next block is calculated as soon as a block is complete,
+        so the filter doesn't get any latency from it.
+    */
+    class PartitionedFilterTail
+    {
+    public:
+        PartitionedFilterTail (size_t blockSize, const float* coefficients, size_t numCoefficients);
+        ~PartitionedFilterTail();
+
+        /** Returns the block size that a filter with a given number of coefficients should use. */
+        static size_t getBlockSizeForFilter (size_t filterSize) noexcept;
+
+        /** Clears the recorded input and the pending output. */
+        void reset() noexcept;
+
+        /** Returns the number of samples that can be processed before the current block is complete. */
+        size_t getNumSamplesUntilNextBlock() const noexcept     { return blockSize - position; }
+
+        /** Records some input samples of the current block. */
+        void pushInput (const float* input, size_t numSamples) noexcept;
+
+        /** Adds the contribution of the partitions to some output samples, and processes
+            the current block once it's complete. The coefficients are compared with the
+            ones in use at the end of each block, so that changes to their values get
+            picked up.
+        */
+        void addOutput (float* output, size_t numSamples, const float* coefficients) noexcept;
+
+    private:
+        void processBlock (const float* coefficients) noexcept;
+        void updateSpectra (const float* coefficients) noexcept;
+
+        size_t blockSize, numBins, numCoefficients, numPartitions, position = 0, currentPartition = 0;
+        std::unique_ptr<FFT> fft;
+        HeapBlock<float> coefficientsInUse, filterSpectra, inputSpectra, window, fftBuffer, accumulator, tailOutput;
+
+        JUCE_DECLARE_NON_COPYABLE (PartitionedFilterTail)
+    };
+
     //==============================================================================
     /**
-        A processing class that can perform FIR filtering on an audio signal, in the
-        time domain.
+        A processing class that can perform FIR filtering on an audio signal.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        Short filters are processed in the time domain, several samples at a time using
+        SIMD instructions when the SampleType is a primitive type. When the SampleType is
+        float and the filter has more than fftThreshold coefficients, only its first block
+        of coefficients is processed in the time domain, and the rest is done in the
+        frequency domain with a uniform-partitioned FFT engine. This doesn't add any
+        latency, so there is no need to move to the Convolution class for long filters.
 
         @see FIRFilter::Coefficients, Convolution, FFT
     */
@@ -58,6 +106,11 @@ namespace FIR
         */
         using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
 
+        /** The number of coefficients above which a Filter<float> does most of its
+            processing in the frequency domain.
+        */
+        enum { fftThreshold = 512 };
+
         //==============================================================================
         /** This will create a filter which will produce silence. */
         Filter() : coefficients (new Coefficients<NumericType>)                                     { reset(); }
@@ -94,14 +147,24 @@ namespace FIR
 
                 if (newSize != size)
                 {
-                    memory.malloc (1 + jmax (newSize, size, static_cast<size_t> (128)));
+                    tail.reset (createTail (coefficients->getRawCoefficients(), newSize, IsFloat()));
+
+                    directSize = (tail != nullptr ? PartitionedFilterTail::getBlockSizeForFilter (newSize) : newSize);
+                    historySize = directSize - 1 + jmax (directSize, static_cast<size_t> (128));
 
-                    fifo = snapPointerToAlignment (memory.getData(), sizeof (SampleType));
+                    memory.malloc (1 + historySize);
+
+                    history = snapPointerToAlignment (memory.getData(), sizeof (SampleType));
                     size = newSize;
                 }
 
-                for (size_t i = 0; i < size; ++i)
-                    fifo[i] = SampleType {0};
+                for (size_t i = 0; i < historySize; ++i)
+                    history[i] = SampleType {0};
+
+                pos = historySize - (directSize - 1);
+
+                if (tail != nullptr)
+                    tail->reset();
             }
         }
 
@@ -110,7 +173,9 @@ namespace FIR
             these coefficients are modified in a thread-safe way.
 
             If you change the order of the coefficients then you must call reset after
-            modifying them.
+            modifying them. When a Filter<float> processes a long filter in the frequency
+            domain, changes to the values of the coefficients after the first block
+            are only picked up at the next block boundary.
         */
         typename Coefficients<NumericType>::Ptr coefficients;
 
@@ -131,17 +196,8 @@ namespace FIR
             jassert (inputBlock.getNumChannels()  == 1);
             jassert (outputBlock.getNumChannels() == 1);
 
-            auto numSamples = inputBlock.getNumSamples();
-            auto* src = inputBlock .getChannelPointer (0);
-            auto* dst = outputBlock.getChannelPointer (0);
-
-            auto* fir = coefficients->getRawCoefficients();
-            size_t p = pos;
-
-            for (size_t i = 0; i < numSamples; ++i)
-                dst[i] = processSingleSample (src[i], fifo, fir, size, p);
-
-            pos = p;
+            processSamples (inputBlock.getChannelPointer (0), outputBlock.getChannelPointer (0),
+                            inputBlock.getNumSamples(), IsFloat());
         }
 
 
@@ -151,14 +207,31 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
-            return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
+
+            SampleType out;
+            processSamples (&sample, &out, 1, IsFloat());
+            return out;
         }
 
     private:
         //==============================================================================
+        using IsFloat = std::is_same<SampleType, float>;
+
+       #if JUCE_USE_SIMD
+        using IsVectorisable = std::is_floating_point<SampleType>;
+       #else
+        using IsVectorisable = std::false_type;
+       #endif
+
+        //==============================================================================
+        // The most recent samples are stored backwards in time, so that the output for
+        // the newest one at history[pos] is the dot product of the coefficients with
+        // history[pos .. pos + directSize - 1]. Once the start of the buffer is reached,
+        // the samples which are still needed are moved back to its end.
         HeapBlock<SampleType> memory;
-        SampleType* fifo = nullptr;
-        size_t pos = 0, size = 0;
+        SampleType* history = nullptr;
+        size_t pos = 0, size = 0, directSize = 0, historySize = 0;
+        std::unique_ptr<PartitionedFilterTail> tail;
 
         //==============================================================================
         void check()
@@ -169,25 +242,152 @@ namespace FIR
                 reset();
         }
 
-        static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
-                                                                    const NumericType* fir, size_t m, size_t& p) noexcept
+        static PartitionedFilterTail* createTail (const float* fir, size_t numCoefficients, std::true_type)
         {
-            SampleType out = {};
+            if (numCoefficients <= fftThreshold)
+                return nullptr;
 
-            buf[p] = sample;
+            auto blockSize = PartitionedFilterTail::getBlockSizeForFilter (numCoefficients);
+            return new PartitionedFilterTail (blockSize, fir + blockSize, numCoefficients - blockSize);
+        }
 
-            size_t k;
-            for (k = 0; k < m - p; ++k)
-                out += buf[(p + k)] * fir[k];
+        static PartitionedFilterTail* createTail (const NumericType*, size_t, std::false_type)
+        {
+            return nullptr;
+        }
 
-            for (size_t j = 0; j < p; ++j)
-                out += buf[j] * fir[j + k];
+        //==============================================================================
+        void processSamples (const SampleType* src, SampleType* dst, size_t numSamples, std::false_type) noexcept
+        {
+            processDirect (src, dst, numSamples);
+        }
 
-            p = (p == 0 ? m - 1 : p - 1);
+        void processSamples (const float* src, float* dst, size_t numSamples, std::true_type) noexcept
+        {
+            if (tail == nullptr)
+            {
+                processDirect (src, dst, numSamples);
+                return;
+            }
 
-            return out;
+            auto* fir = coefficients->getRawCoefficients();
+
+            while (numSamples > 0)
+            {
+                auto num = jmin (numSamples, tail->getNumSamplesUntilNextBlock());
+
+                tail->pushInput (src, num);
+                processDirect (src, dst, num);
+                tail->addOutput (dst, num, fir + directSize);
+
+                src += num;
+                dst += num;
+                numSamples -= num;
+            }
+        }
+
+        void processDirect (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+        {
+            auto* fir = coefficients->getRawCoefficients();
+
+            while (numSamples > 0)
+            {
+                if (pos == 0)
+                {
+                    auto numToKeep = directSize - 1;
+                    std::copy (history, history + numToKeep, history + historySize - numToKeep);
+                    pos = historySize - numToKeep;
+                }
+
+                auto num = jmin (numSamples, pos);
+
+                for (size_t i = 0; i < num; ++i)
+                    history[pos - 1 - i] = src[i];
+
+                pos -= num;
+                processHistory (history + pos, dst, num, fir, IsVectorisable());
+
+                src += num;
+                dst += num;
+                numSamples -= num;
+            }
+        }
+
+        // Calculates the output for the num samples which have just been stored at x,
+        // the first one being at x[num - 1]
+        void processHistory (const SampleType* x, SampleType* dst, size_t num,
+                             const NumericType* fir, std::false_type) const noexcept
+        {
+            for (size_t i = 0; i < num; ++i)
+            {
+                auto* buf = x + (num - 1 - i);
+                SampleType out = {};
+
+                for (size_t k = 0; k < directSize; ++k)
+                    out += buf[k] * fir[k];
+
+                dst[i] = out;
+            }
         }
 
+       #if JUCE_USE_SIMD
+        // Calculates groups of consecutive outputs at once: each lane of a vector loaded
+        // from the history is a different output, so that the coefficients only need to
+        // be broadcast, and no horizontal sums are needed.
+        void processHistory (const SampleType* x, SampleType* dst, size_t num,
+                             const NumericType* fir, std::true_type) const noexcept
+        {
+            using VectorType = SIMDRegister<SampleType>;
+            constexpr auto numLanes = VectorType::SIMDNumElements;
+
+            size_t i = 0;
+
+            for (; i + 2 * numLanes <= num; i += 2 * numLanes)
+            {
+                auto* buf0 = x + (num - i - numLanes);
+                auto* buf1 = buf0 - numLanes;
+                auto out0 = VectorType::expand (0), out1 = VectorType::expand (0);
+
+                for (size_t k = 0; k < directSize; ++k)
+                {
+                    auto c = VectorType::expand (fir[k]);
+                    out0 += loadUnaligned<VectorType> (buf0 + k) * c;
+                    out1 += loadUnaligned<VectorType> (buf1 + k) * c;
+                }
+
+                storeReversed (out0, dst + i);
+                storeReversed (out1, dst + i + numLanes);
+            }
+
+            for (; i + numLanes <= num; i += numLanes)
+            {
+                auto* buf = x + (num - i - numLanes);
+                auto out = VectorType::expand (0);
+
+                for (size_t k = 0; k < directSize; ++k)
+                    out += loadUnaligned<VectorType> (buf + k) * VectorType::expand (fir[k]);
+
+                storeReversed (out, dst + i);
+            }
+
+            processHistory (x, dst + i, num - i, fir, std::false_type());
+        }
+
+        template <typename VectorType>
+        static VectorType loadUnaligned (const SampleType* src) noexcept
+        {
+            VectorType v;
+            std::memcpy (&v, src, sizeof (VectorType));
+            return v;
+        }
+
+        template <typename VectorType>
+        static void storeReversed (VectorType v, SampleType* dst) noexcept
+        {
+            for (size_t i = 0; i < VectorType::SIMDNumElements; ++i)
+                dst[i] = v[VectorType::SIMDNumElements - 1 - i];
+        }
+       #endif
 
         JUCE_LEAK_DETECTOR (Filter)
     };
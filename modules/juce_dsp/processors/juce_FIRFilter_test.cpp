@@ -192,6 +192,65 @@ class FIRFilterTest : public UnitTest
         runTestForType<TheTest, SIMDRegister<double>, double>();
     }
 
+    //==============================================================================
+    // Filters above FIR::Filter<float>::fftThreshold are mostly processed in the
+    // frequency domain, so they're compared with a double precision reference
+    template <typename TheTest>
+    void runLongFilterTest (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        Random random (8392829);
+
+        for (auto size : { 512, 513, 1000, 2048, 4097, 20000 })
+        {
+            constexpr size_t n = 3000;
+            auto numCoefficients = static_cast<size_t> (size);
+
+            HeapBlock<float> input (n), output (n), fir (numCoefficients);
+            fillRandom (random, input.getData(), n);
+            fillRandom (random, fir.getData(), numCoefficients);
+
+            FIR::Filter<float> filter (new FIR::Coefficients<float> (fir, numCoefficients));
+            ProcessSpec spec {0.0, n, 1};
+            filter.prepare (spec);
+
+            TheTest::template run<float> (filter, input, output, n);
+            expectLessThan (getMaxErrorFromReference (fir, numCoefficients, input, output, n), 1e-4);
+
+            // the same thing in place, after changing the coefficients
+            fillRandom (random, fir.getData(), numCoefficients);
+            std::copy (fir.getData(), fir + numCoefficients, filter.coefficients->getRawCoefficients());
+            filter.reset();
+
+            HeapBlock<float> buffer (n);
+            std::copy (input.getData(), input + n, buffer.getData());
+
+            auto* data = buffer.getData();
+            AudioBlock<float> block (&data, 1, n);
+            filter.process (ProcessContextReplacing<float> (block));
+
+            expectLessThan (getMaxErrorFromReference (fir, numCoefficients, input, buffer, n), 1e-4);
+        }
+    }
+
+    static double getMaxErrorFromReference (const float* fir, size_t numCoefficients,
+                                            const float* input, const float* output, size_t n) noexcept
+    {
+        double maxError = 0.0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            double sum = 0.0;
+
+            for (size_t k = 0; k < numCoefficients && k <= i; ++k)
+                sum += static_cast<double> (fir[k]) * static_cast<double> (input[i - k]);
+
+            maxError = jmax (maxError, std::abs (sum - static_cast<double> (output[i])));
+        }
+
+        return maxError;
+    }
 
 public:
     FIRFilterTest() : UnitTest ("FIR Filter") {}
@@ -201,6 +260,10 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        runLongFilterTest<LargeBlockTest> ("Long filters, Large Blocks");
+        runLongFilterTest<SampleBySampleTest> ("Long filters, Sample by Sample");
+        runLongFilterTest<SplitBlockTest> ("Long filters, Split Block");
     }
 };
 
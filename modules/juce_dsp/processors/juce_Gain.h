@@ -90,6 +90,29 @@ public:
         return s * gain.getNextValue();
     }
 
+    /** A per-sample kernel, which lets a ProcessorChain fuse the gain with the
+        processors around it. It works on a copy of the ramp, which it writes back
+        to the Gain when it is destroyed.
+    */
+    template <size_t numChannels>
+    struct FrameKernel
+    {
+        FrameKernel (Gain& g) noexcept  : owner (g), gain (g.gain) {}
+        ~FrameKernel() noexcept         { owner.gain = gain; }
+
+        template <typename SampleType>
+        void processFrame (SampleType* frame) noexcept
+        {
+            auto g = gain.getNextValue();
+
+            for (size_t chan = 0; chan < numChannels; ++chan)
+                frame[chan] *= g;
+        }
+
+        Gain& owner;
+        LinearSmoothedValue<FloatType> gain;
+    };
+
     /** Processes the input and output buffers supplied in the processing context. */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
@@ -100,29 +123,7 @@ public:
         jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
         jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
 
-        auto len         = inBlock.getNumSamples();
-        auto numChannels = inBlock.getNumChannels();
-
-        if (numChannels == 1)
-        {
-            auto* src = inBlock.getChannelPointer (0);
-            auto* dst = outBlock.getChannelPointer (0);
-
-            for (size_t i = 0; i < len; ++i)
-                dst[i] = src[i] * gain.getNextValue();
-        }
-        else
-        {
-            auto* gains = static_cast<FloatType*> (alloca (sizeof (FloatType) * len));
-
-            for (size_t i = 0; i < len; ++i)
-                gains[i] = gain.getNextValue();
-
-            for (size_t chan = 0; chan < numChannels; ++chan)
-                FloatVectorOperations::multiply (outBlock.getChannelPointer (chan),
-                                                 inBlock.getChannelPointer (chan),
-                                                 gains, static_cast<int> (len));
-        }
+        outBlock.multiplyByRamp (inBlock, gain);
     }
 
 private:
@@ -91,52 +91,77 @@ IIR::Coefficients<NumericType>::Coefficients (NumericType b0, NumericType b1, Nu
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
-                                                                                                    NumericType frequency)
+IIR::Coefficients<NumericType>& IIR::Coefficients<NumericType>::operator= (const Coefficients& other)
 {
-    jassert (sampleRate > 0.0);
-    jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
+    if (this != &other)
+    {
+        // clearQuick() keeps the old storage, so this only allocates if the order has grown
+        coefficients.clearQuick();
+        coefficients.addArray (other.coefficients);
+    }
 
-    auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
+    return *this;
+}
+
+template <typename NumericType>
+IIR::Coefficients<NumericType>& IIR::Coefficients<NumericType>::assignImpl (const NumericType* values, size_t order)
+{
+    auto a0 = values[order + 1];
+    jassert (a0 != 0);
 
-    return new Coefficients (n, n, n + 1, n - 1);
+    auto a0inv = static_cast<NumericType> (1) / a0;
+
+    coefficients.clearQuick();
+
+    for (size_t i = 0; i <= order; ++i)
+        coefficients.add (values[i] * a0inv);
+
+    for (size_t i = 1; i <= order; ++i)
+        coefficients.add (values[order + 1 + i] * a0inv);
+
+    return *this;
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
-                                                                                                     NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
+                                                                                       NumericType frequency)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
 
     auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
 
-    return new Coefficients (1, -1, n + 1, n - 1);
+    return {{ n, n, n + 1, n - 1 }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
-                                                                                                    NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
+                                                                                        NumericType frequency)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
 
     auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
 
-    return new Coefficients (n - 1, n + 1, n + 1, n - 1);
+    return {{ 1, -1, n + 1, n - 1 }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
-                                                                                          NumericType frequency)
+std::array<NumericType, 4> IIR::ArrayCoefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
+                                                                                       NumericType frequency)
 {
-    return makeLowPass (sampleRate, frequency, inverseRootTwo);
+    jassert (sampleRate > 0.0);
+    jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
+
+    auto n = std::tan (MathConstants<NumericType>::pi * frequency / static_cast<NumericType> (sampleRate));
+
+    return {{ n - 1, n + 1, n + 1, n - 1 }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
-                                                                                          NumericType frequency,
-                                                                                          NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                             NumericType frequency,
+                                                                             NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -147,22 +172,15 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return new Coefficients (c1, c1 * 2, c1,
-                             1, c1 * 2 * (1 - nSquared),
-                             c1 * (1 - invQ * n + nSquared));
+    return {{ c1, c1 * 2, c1,
+              1, c1 * 2 * (1 - nSquared),
+              c1 * (1 - invQ * n + nSquared) }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
-                                                                                           NumericType frequency)
-{
-    return makeHighPass (sampleRate, frequency, inverseRootTwo);
-}
-
-template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
-                                                                                           NumericType frequency,
-                                                                                           NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                              NumericType frequency,
+                                                                              NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -173,22 +191,15 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return new Coefficients (c1, c1 * -2, c1,
-                             1, c1 * 2 * (nSquared - 1),
-                             c1 * (1 - invQ * n + nSquared));
-}
-
-template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
-                                                                                           NumericType frequency)
-{
-    return makeBandPass (sampleRate, frequency, inverseRootTwo);
+    return {{ c1, c1 * -2, c1,
+              1, c1 * 2 * (nSquared - 1),
+              c1 * (1 - invQ * n + nSquared) }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
-                                                                                           NumericType frequency,
-                                                                                           NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                              NumericType frequency,
+                                                                              NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -199,23 +210,16 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto invQ = 1 / Q;
     auto c1 = 1 / (1 + invQ * n + nSquared);
 
-    return new Coefficients (c1 * n * invQ, 0,
-                            -c1 * n * invQ, 1,
-                             c1 * 2 * (1 - nSquared),
-                             c1 * (1 - invQ * n + nSquared));
-}
-
-template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
-                                                                                        NumericType frequency)
-{
-    return makeNotch (sampleRate, frequency, inverseRootTwo);
+    return {{ c1 * n * invQ, 0,
+             -c1 * n * invQ, 1,
+              c1 * 2 * (1 - nSquared),
+              c1 * (1 - invQ * n + nSquared) }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
-                                                                                        NumericType frequency,
-                                                                                        NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeNotch (double sampleRate,
+                                                                           NumericType frequency,
+                                                                           NumericType Q)
 {
     jassert (sampleRate > 0.0);
     jassert (frequency > 0 && frequency <= static_cast<float> (sampleRate * 0.5));
@@ -228,20 +232,13 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto b0 = c1 * (1 + nSquared);
     auto b1 = 2 * c1 * (1 - nSquared);
 
-    return new Coefficients (b0, b1, b0, 1, b1, c1 * (1 - n * invQ + nSquared));
+    return {{ b0, b1, b0, 1, b1, c1 * (1 - n * invQ + nSquared) }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
-                                                                                          NumericType frequency)
-{
-    return makeAllPass (sampleRate, frequency, inverseRootTwo);
-}
-
-template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
-                                                                                          NumericType frequency,
-                                                                                          NumericType Q)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                             NumericType frequency,
+                                                                             NumericType Q)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
@@ -254,14 +251,14 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto b0 = c1 * (1 - n * invQ + nSquared);
     auto b1 = c1 * 2 * (1 - nSquared);
 
-    return new Coefficients (b0, b1, 1, 1, b1, b0);
+    return {{ b0, b1, 1, 1, b1, b0 }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowShelf (double sampleRate,
-                                                                                           NumericType cutOffFrequency,
-                                                                                           NumericType Q,
-                                                                                           NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeLowShelf (double sampleRate,
+                                                                              NumericType cutOffFrequency,
+                                                                              NumericType Q,
+                                                                              NumericType gainFactor)
 {
     jassert (sampleRate > 0.0);
     jassert (cutOffFrequency > 0.0 && cutOffFrequency <= sampleRate * 0.5);
@@ -275,19 +272,19 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto beta = std::sin (omega) * std::sqrt (A) / Q;
     auto aminus1TimesCoso = aminus1 * coso;
 
-    return new Coefficients (A * (aplus1 - aminus1TimesCoso + beta),
-                             A * 2 * (aminus1 - aplus1 * coso),
-                             A * (aplus1 - aminus1TimesCoso - beta),
-                             aplus1 + aminus1TimesCoso + beta,
-                             -2 * (aminus1 + aplus1 * coso),
-                             aplus1 + aminus1TimesCoso - beta);
+    return {{ A * (aplus1 - aminus1TimesCoso + beta),
+              A * 2 * (aminus1 - aplus1 * coso),
+              A * (aplus1 - aminus1TimesCoso - beta),
+              aplus1 + aminus1TimesCoso + beta,
+              -2 * (aminus1 + aplus1 * coso),
+              aplus1 + aminus1TimesCoso - beta }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighShelf (double sampleRate,
-                                                                                            NumericType cutOffFrequency,
-                                                                                            NumericType Q,
-                                                                                            NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makeHighShelf (double sampleRate,
+                                                                               NumericType cutOffFrequency,
+                                                                               NumericType Q,
+                                                                               NumericType gainFactor)
 {
     jassert (sampleRate > 0);
     jassert (cutOffFrequency > 0 && cutOffFrequency <= static_cast<NumericType> (sampleRate * 0.5));
@@ -301,19 +298,19 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto beta = std::sin (omega) * std::sqrt (A) / Q;
     auto aminus1TimesCoso = aminus1 * coso;
 
-    return new Coefficients (A * (aplus1 + aminus1TimesCoso + beta),
-                             A * -2 * (aminus1 + aplus1 * coso),
-                             A * (aplus1 + aminus1TimesCoso - beta),
-                             aplus1 - aminus1TimesCoso + beta,
-                             2 * (aminus1 - aplus1 * coso),
-                             aplus1 - aminus1TimesCoso - beta);
+    return {{ A * (aplus1 + aminus1TimesCoso + beta),
+              A * -2 * (aminus1 + aplus1 * coso),
+              A * (aplus1 + aminus1TimesCoso - beta),
+              aplus1 - aminus1TimesCoso + beta,
+              2 * (aminus1 - aplus1 * coso),
+              aplus1 - aminus1TimesCoso - beta }};
 }
 
 template <typename NumericType>
-typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makePeakFilter (double sampleRate,
-                                                                                             NumericType frequency,
-                                                                                             NumericType Q,
-                                                                                             NumericType gainFactor)
+std::array<NumericType, 6> IIR::ArrayCoefficients<NumericType>::makePeakFilter (double sampleRate,
+                                                                                NumericType frequency,
+                                                                                NumericType Q,
+                                                                                NumericType gainFactor)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= static_cast<NumericType> (sampleRate * 0.5));
@@ -327,10 +324,134 @@ typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::mak
     auto alphaTimesA = alpha * A;
     auto alphaOverA = alpha / A;
 
-    return new Coefficients (1 + alphaTimesA, c2,
-                             1 - alphaTimesA,
-                             1 + alphaOverA, c2,
-                             1 - alphaOverA);
+    return {{ 1 + alphaTimesA, c2,
+              1 - alphaTimesA,
+              1 + alphaOverA, c2,
+              1 - alphaOverA }};
+}
+
+//==============================================================================
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderLowPass (double sampleRate,
+                                                                                                    NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderLowPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderHighPass (double sampleRate,
+                                                                                                     NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderHighPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeFirstOrderAllPass (double sampleRate,
+                                                                                                    NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeFirstOrderAllPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                                          NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowPass (double sampleRate,
+                                                                                          NumericType frequency,
+                                                                                          NumericType Q)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                                           NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeHighPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighPass (double sampleRate,
+                                                                                           NumericType frequency,
+                                                                                           NumericType Q)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeHighPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                                           NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeBandPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeBandPass (double sampleRate,
+                                                                                           NumericType frequency,
+                                                                                           NumericType Q)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeBandPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
+                                                                                        NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeNotch (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeNotch (double sampleRate,
+                                                                                        NumericType frequency,
+                                                                                        NumericType Q)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeNotch (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                                          NumericType frequency)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeAllPass (sampleRate, frequency));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeAllPass (double sampleRate,
+                                                                                          NumericType frequency,
+                                                                                          NumericType Q)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeAllPass (sampleRate, frequency, Q));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeLowShelf (double sampleRate,
+                                                                                           NumericType cutOffFrequency,
+                                                                                           NumericType Q,
+                                                                                           NumericType gainFactor)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeLowShelf (sampleRate, cutOffFrequency, Q, gainFactor));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makeHighShelf (double sampleRate,
+                                                                                            NumericType cutOffFrequency,
+                                                                                            NumericType Q,
+                                                                                            NumericType gainFactor)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makeHighShelf (sampleRate, cutOffFrequency, Q, gainFactor));
+}
+
+template <typename NumericType>
+typename IIR::Coefficients<NumericType>::Ptr IIR::Coefficients<NumericType>::makePeakFilter (double sampleRate,
+                                                                                             NumericType frequency,
+                                                                                             NumericType Q,
+                                                                                             NumericType gainFactor)
+{
+    return new Coefficients (ArrayCoefficients<NumericType>::makePeakFilter (sampleRate, frequency, Q, gainFactor));
 }
 
 template <typename NumericType>
@@ -474,6 +595,9 @@ void IIR::Coefficients<NumericType>::getPhaseForFrequencyArray (double* frequenc
     }
 }
 
+template struct IIR::ArrayCoefficients<float>;
+template struct IIR::ArrayCoefficients<double>;
+
 template struct IIR::Coefficients<float>;
 template struct IIR::Coefficients<double>;
 
@@ -79,6 +79,10 @@ namespace IIR
 
             If you change the order of the coefficients then you must call reset after
             modifying them.
+
+            To change them on the audio thread without allocating, assign one of the
+            ArrayCoefficients arrays to them, and to change them from another thread,
+            use a StateUpdater.
         */
         typename Coefficients<NumericType>::Ptr coefficients;
 
@@ -88,7 +92,7 @@ namespace IIR
             Note that this clears the processing state, but the type of filter and
             its coefficients aren't changed.
         */
-        void reset()            { reset ({}); }
+        void reset()            { reset (SampleType()); }
 
         /** Resets the filter's processing pipeline to a specific value.
             @see reset
@@ -112,6 +116,83 @@ namespace IIR
         */
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept;
 
+        /** A per-sample kernel, which lets a ProcessorChain fuse the filter with the
+            processors around it. It keeps the state of first and second order filters in
+            local variables and writes it back when it is destroyed. As the filter is mono,
+            a multi-channel chain has to wrap it in a ProcessorDuplicator.
+        */
+        template <size_t numChannels>
+        struct FrameKernel
+        {
+            FrameKernel (Filter& f) noexcept  : owner (f)
+            {
+                owner.check();
+                order = owner.order;
+
+                auto* c = owner.coefficients->getRawCoefficients();
+
+                if (order == 1)
+                {
+                    b0 = c[0]; b1 = c[1]; a1 = c[2];
+                    lv1 = owner.state[0];
+                }
+                else if (order == 2)
+                {
+                    b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+                    lv1 = owner.state[0];
+                    lv2 = owner.state[1];
+                }
+            }
+
+            ~FrameKernel() noexcept
+            {
+                if (order == 1)
+                {
+                    util::snapToZero (lv1); owner.state[0] = lv1;
+                }
+                else if (order == 2)
+                {
+                    util::snapToZero (lv1); owner.state[0] = lv1;
+                    util::snapToZero (lv2); owner.state[1] = lv2;
+                }
+                else
+                {
+                    owner.snapToZero();
+                }
+            }
+
+            template <size_t n = numChannels>
+            typename std::enable_if<n == 1>::type processFrame (SampleType* frame) noexcept
+            {
+                auto in = frame[0];
+
+                if (order == 2)
+                {
+                    auto out = (in * b0) + lv1;
+                    frame[0] = out;
+
+                    lv1 = (in * b1) - (out * a1) + lv2;
+                    lv2 = (in * b2) - (out * a2);
+                }
+                else if (order == 1)
+                {
+                    auto out = in * b0 + lv1;
+                    frame[0] = out;
+
+                    lv1 = (in * b1) - (out * a1);
+                }
+                else
+                {
+                    frame[0] = owner.processSample (in);
+                }
+            }
+
+            Filter& owner;
+            size_t order = 0;
+            NumericType b0 = 0, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+            SampleType lv1 {}, lv2 {};
+        };
+
         /** Ensure that the state variables are rounded to zero if the state
             variables are denormals. This is only needed if you are doing
             sample by sample processing.
@@ -131,6 +212,78 @@ namespace IIR
     };
 
 
+    //==============================================================================
+    /** Functions that calculate the coefficients of the standard filter types as plain
+        fixed-size arrays, without allocating any memory.
+
+        First order designs are returned as { b0, b1, a0, a1 } and second order designs
+        as { b0, b1, b2, a0, a1, a2 }. The arrays can be assigned to an existing
+        Coefficients object, which doesn't allocate as long as the object has already
+        held a set of coefficients of at least the same order, so they're safe to use
+        on the audio thread, e.g.
+        @code
+        *filter.coefficients = IIR::ArrayCoefficients<float>::makeLowPass (sampleRate, cutoff);
+        @endcode
+
+        @see Coefficients, StateUpdater
+    */
+    template <typename NumericType>
+    struct ArrayCoefficients
+    {
+        /** Returns the coefficients for a first order low-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderLowPass (double sampleRate, NumericType frequency);
+
+        /** Returns the coefficients for a first order high-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderHighPass (double sampleRate, NumericType frequency);
+
+        /** Returns the coefficients for a first order all-pass filter. */
+        static std::array<NumericType, 4> makeFirstOrderAllPass (double sampleRate, NumericType frequency);
+
+        /** Returns the coefficients for a low-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeLowPass (double sampleRate, NumericType frequency,
+                                                       NumericType Q = inverseRootTwo);
+
+        /** Returns the coefficients for a high-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeHighPass (double sampleRate, NumericType frequency,
+                                                        NumericType Q = inverseRootTwo);
+
+        /** Returns the coefficients for a band-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeBandPass (double sampleRate, NumericType frequency,
+                                                        NumericType Q = inverseRootTwo);
+
+        /** Returns the coefficients for a notch filter with variable Q. */
+        static std::array<NumericType, 6> makeNotch (double sampleRate, NumericType frequency,
+                                                     NumericType Q = inverseRootTwo);
+
+        /** Returns the coefficients for an all-pass filter with variable Q. */
+        static std::array<NumericType, 6> makeAllPass (double sampleRate, NumericType frequency,
+                                                       NumericType Q = inverseRootTwo);
+
+        /** Returns the coefficients for a low-pass shelf filter with variable Q and gain.
+            @see Coefficients::makeLowShelf
+        */
+        static std::array<NumericType, 6> makeLowShelf (double sampleRate, NumericType cutOffFrequency,
+                                                        NumericType Q, NumericType gainFactor);
+
+        /** Returns the coefficients for a high-pass shelf filter with variable Q and gain.
+            @see Coefficients::makeHighShelf
+        */
+        static std::array<NumericType, 6> makeHighShelf (double sampleRate, NumericType cutOffFrequency,
+                                                         NumericType Q, NumericType gainFactor);
+
+        /** Returns the coefficients for a peak filter with variable Q and gain.
+            @see Coefficients::makePeakFilter
+        */
+        static std::array<NumericType, 6> makePeakFilter (double sampleRate, NumericType centreFrequency,
+                                                          NumericType Q, NumericType gainFactor);
+
+    private:
+        // Unfortunately, std::sqrt is not marked as constexpr just yet in all compilers
+        static constexpr NumericType inverseRootTwo = static_cast<NumericType> (0.70710678118654752440L);
+
+        ArrayCoefficients() = delete;
+    };
+
     //==============================================================================
     /** A set of coefficients for use in an Filter object.
         @see IIR::Filter
@@ -154,11 +307,30 @@ namespace IIR
         Coefficients (NumericType b0, NumericType, NumericType b2, NumericType b3,
                       NumericType a0, NumericType a1, NumericType a2, NumericType a3);
 
+        /** Constructs an object from an array returned by one of the ArrayCoefficients
+            functions, or any other array of the form { b0, b1, ..., a0, a1, ... }.
+        */
+        template <size_t Num>
+        explicit Coefficients (const std::array<NumericType, Num>& values)    { assignImpl<Num> (values.data()); }
+
         Coefficients (const Coefficients&) = default;
         Coefficients (Coefficients&&) = default;
-        Coefficients& operator= (const Coefficients&) = default;
         Coefficients& operator= (Coefficients&&) = default;
 
+        /** Copies another set of coefficients.
+            This reuses the existing storage, so won't allocate if this object has already
+            held coefficients of at least the same order.
+        */
+        Coefficients& operator= (const Coefficients&);
+
+        /** Replaces the coefficients with an array of the form { b0, b1, ..., a0, a1, ... },
+            such as the ones returned by the ArrayCoefficients functions.
+            This reuses the existing storage, so won't allocate if this object has already
+            held coefficients of at least the same order.
+        */
+        template <size_t Num>
+        Coefficients& operator= (const std::array<NumericType, Num>& values)  { return assignImpl<Num> (values.data()); }
+
         /** The Coefficients structure is ref-counted, so this is a handy type that can be used
             as a pointer to one.
         */
@@ -277,10 +449,315 @@ namespace IIR
         Array<NumericType> coefficients;
 
     private:
+        template <size_t Num>
+        Coefficients& assignImpl (const NumericType* values)
+        {
+            static_assert (Num % 2 == 0 && Num >= 4, "Must supply an even number of coefficients");
+            return assignImpl (values, Num / 2 - 1);
+        }
+
+        Coefficients& assignImpl (const NumericType* values, size_t order);
+
         // Unfortunately, std::sqrt is not marked as constexpr just yet in all compilers
         static constexpr NumericType inverseRootTwo = static_cast<NumericType> (0.70710678118654752440L);
     };
 
+    //==============================================================================
+    /**
+        A chain of IIR filters that are run one after another, which is how the
+        higher-order designs returned by the FilterDesign class are meant to be used.
+
+        Each section is processed by its own Filter object in Transposed Direct Form II,
+        and like Filter, this class processes a single channel of SampleType, which may
+        be either a primitive or a SIMDRegister.
+
+        @see Filter, FilterDesign, MultiChannelFilter
+    */
+    template <typename SampleType>
+    class CascadedFilter
+    {
+    public:
+        /** The NumericType is the underlying primitive type used by the SampleType (which
+            could be either a primitive or vector)
+        */
+        using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
+
+        //==============================================================================
+        /** Creates a cascade with no sections, which will pass its input through unchanged. */
+        CascadedFilter();
+
+        /** Creates a cascade using copies of a set of coefficients, such as the ones
+            returned by FilterDesign::designIIRLowpassHighOrderButterworthMethod().
+        */
+        CascadedFilter (const Array<Coefficients<NumericType>>& sectionCoefficients);
+
+        //==============================================================================
+        /** Replaces the sections of the cascade with copies of some coefficients.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setSections (const Array<Coefficients<NumericType>>& sectionCoefficients);
+
+        /** Replaces the sections of the cascade with some shared coefficient objects.
+            Changes made later to any of these objects will affect this cascade and any
+            other filters that use them.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setSections (const ReferenceCountedArray<Coefficients<NumericType>>& sectionCoefficients);
+
+        /** Returns the number of sections in the cascade. */
+        size_t getNumSections() const noexcept                  { return (size_t) sections.size(); }
+
+        /** Returns the coefficients used by one of the sections.
+            As with Filter::coefficients, it's up to the caller to make sure that these
+            are modified in a thread-safe way.
+        */
+        Coefficients<NumericType>* getSection (size_t index) const noexcept   { return sections[(int) index]->coefficients.get(); }
+
+        //==============================================================================
+        /** Resets the processing pipeline of all the sections, ready to start a new stream of data. */
+        void reset()            { reset (SampleType()); }
+
+        /** Resets the processing pipeline of all the sections to a specific value. */
+        void reset (SampleType resetToValue);
+
+        /** Called before processing starts. */
+        void prepare (const ProcessSpec&) noexcept;
+
+        /** Processes a block of samples through each section in turn. */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept;
+
+        /** Processes a single sample through each section in turn, without any locking. */
+        SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept;
+
+        /** Ensure that the state variables are rounded to zero if the state
+            variables are denormals. This is only needed if you are doing
+            sample by sample processing.
+        */
+        void snapToZero() noexcept;
+
+    private:
+        //==============================================================================
+        OwnedArray<Filter<SampleType>> sections;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CascadedFilter)
+    };
+
+    //==============================================================================
+    /**
+        Applies the same IIR filter to any number of channels, by packing groups of
+        channels into the lanes of a SIMDRegister and filtering each group at once.
+
+        Using a ProcessorDuplicator with Filter keeps a separate scalar filter for each
+        channel, whereas this class runs a single CascadedFilter<SIMDRegister<SampleType>>
+        for every SIMDRegister<SampleType>::size() channels, so for wide buses it does a
+        fraction of the work. The state of the channels is kept interleaved in the lanes of
+        the registers, and each block is interleaved into a scratch buffer before being
+        filtered, and de-interleaved again afterwards.
+
+        All the channels share the same coefficients, which can be either a single section
+        or a cascade of sections from the FilterDesign class. If JUCE_USE_SIMD is disabled,
+        this falls back to filtering each channel separately.
+
+        The SampleType must be a primitive floating point type.
+
+        @see CascadedFilter, Filter, ProcessorDuplicator
+    */
+    template <typename SampleType>
+    class MultiChannelFilter
+    {
+    public:
+        //==============================================================================
+        /** Creates a filter with no sections, which will pass its input through unchanged. */
+        MultiChannelFilter();
+
+        /** Creates a filter that uses a single set of coefficients for all its channels. */
+        MultiChannelFilter (Coefficients<SampleType>* coefficientsToUse);
+
+        /** Creates a filter that uses copies of a cascade of coefficients for all its channels. */
+        MultiChannelFilter (const Array<Coefficients<SampleType>>& sectionCoefficients);
+
+        //==============================================================================
+        /** Makes all the channels use a single set of coefficients.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setCoefficients (Coefficients<SampleType>* coefficientsToUse);
+
+        /** Makes all the channels use copies of a cascade of coefficients.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setSections (const Array<Coefficients<SampleType>>& sectionCoefficients);
+
+        /** Returns the number of sections that each channel is processed with. */
+        size_t getNumSections() const noexcept                   { return (size_t) sections.size(); }
+
+        /** Returns the coefficients used by one of the sections, which are shared by all the
+            channels. As with Filter::coefficients, it's up to the caller to make sure that
+            these are modified in a thread-safe way.
+        */
+        Coefficients<SampleType>* getSection (size_t index) const noexcept   { return sections[(int) index]; }
+
+        //==============================================================================
+        /** Resets the processing pipeline of all the channels, ready to start a new stream of data. */
+        void reset();
+
+        /** Called before processing starts, to allocate the state for the number of channels
+            and the scratch space for the maximum block size.
+        */
+        void prepare (const ProcessSpec&);
+
+        /** Processes a block of samples. The block can have any number of channels, up
+            to the number given to prepare().
+        */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept;
+
+        /** Ensure that the state variables are rounded to zero if the state
+            variables are denormals.
+        */
+        void snapToZero() noexcept;
+
+    private:
+        //==============================================================================
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<SampleType>;
+       #else
+        using VectorType = SampleType;
+       #endif
+
+        static constexpr size_t numLanes = sizeof (VectorType) / sizeof (SampleType);
+        static constexpr size_t maxChunkSize = 256;
+
+        void updateGroups();
+
+        ReferenceCountedArray<Coefficients<SampleType>> sections;
+        OwnedArray<CascadedFilter<VectorType>> groups;
+        HeapBlock<char> scratchMemory;
+        VectorType* scratch = nullptr;
+        size_t scratchSize = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiChannelFilter)
+    };
+
+    //==============================================================================
+    /**
+        A cascade of IIR sections for a single channel, which computes several output
+        samples at once instead of running the usual one-sample-at-a-time recurrence.
+
+        When there's only one channel to filter there are no channels to spread across
+        the lanes of a SIMDRegister, so this class spreads consecutive samples across them
+        instead. For each section it pre-computes the response of the next
+        SIMDRegister<SampleType>::size() outputs to the current state and to each of the
+        next inputs (the block state-space form of the filter), so a block of outputs is
+        just a handful of vector multiply-adds. The state is then advanced across the whole
+        block in one step, which is the only part of the work that has to wait for the
+        previous block. The state variables are the same ones that a Filter uses in its
+        Transposed Direct Form II structure, so any remaining samples at the end of a block
+        are simply processed in the usual way.
+
+        The results match those of a CascadedFilter to within rounding errors, although
+        they won't be bit-identical. Sections with an order higher than the number of
+        lanes are processed with the normal recurrence. If JUCE_USE_SIMD is disabled, every
+        section is processed with the normal recurrence.
+
+        The SampleType must be a primitive floating point type.
+
+        @see CascadedFilter, Filter, FilterDesign
+    */
+    template <typename SampleType>
+    class BlockFilter
+    {
+    public:
+        //==============================================================================
+        /** Creates a filter with no sections, which will pass its input through unchanged. */
+        BlockFilter();
+
+        /** Creates a filter with a single set of coefficients. */
+        BlockFilter (Coefficients<SampleType>* coefficientsToUse);
+
+        /** Creates a filter using copies of a cascade of coefficients, such as the ones
+            returned by FilterDesign::designIIRLowpassHighOrderButterworthMethod().
+        */
+        BlockFilter (const Array<Coefficients<SampleType>>& sectionCoefficients);
+
+        //==============================================================================
+        /** Makes the filter use a single set of coefficients.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setCoefficients (Coefficients<SampleType>* coefficientsToUse);
+
+        /** Replaces the sections of the cascade with copies of some coefficients.
+            This allocates memory, so shouldn't be called from the audio thread.
+        */
+        void setSections (const Array<Coefficients<SampleType>>& sectionCoefficients);
+
+        /** Returns the number of sections in the cascade. */
+        size_t getNumSections() const noexcept                   { return (size_t) sections.size(); }
+
+        /** Returns the coefficients used by one of the sections.
+            These can be changed while the filter is running (in a thread-safe way), and
+            the block form of the section will be recalculated at the start of the next
+            call to process(). Changing the order of a section will reset its state.
+        */
+        Coefficients<SampleType>* getSection (size_t index) const noexcept   { return sections[(int) index]->coefficients.get(); }
+
+        //==============================================================================
+        /** Resets the processing pipeline of all the sections, ready to start a new stream of data. */
+        void reset()            { reset (SampleType()); }
+
+        /** Resets the processing pipeline of all the sections to a specific value. */
+        void reset (SampleType resetToValue);
+
+        /** Called before processing starts. */
+        void prepare (const ProcessSpec&) noexcept;
+
+        /** Processes a block of samples through each section in turn. */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept;
+
+        /** Ensure that the state variables are rounded to zero if the state
+            variables are denormals.
+        */
+        void snapToZero() noexcept;
+
+    private:
+        //==============================================================================
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<SampleType>;
+       #else
+        using VectorType = SampleType;
+       #endif
+
+        static constexpr size_t numLanes = sizeof (VectorType) / sizeof (SampleType);
+
+        struct Section
+        {
+            Section (Coefficients<SampleType>*);
+
+            void update();
+            void reset (SampleType resetToValue) noexcept;
+            void process (const SampleType* src, SampleType* dst, size_t numSamples) noexcept;
+            void processSerially (const SampleType* src, SampleType* dst, size_t numSamples) noexcept;
+
+            template <size_t fixedOrder>
+            void processBlocks (const SampleType* src, SampleType* dst, size_t numSamples) noexcept;
+            void snapToZero() noexcept;
+
+            typename Coefficients<SampleType>::Ptr coefficients;
+            Array<SampleType> cachedCoefficients;
+            size_t order = 0;
+
+            HeapBlock<SampleType> state, stateTransitions, inputTransitions;
+            HeapBlock<char> responseMemory;
+            VectorType* stateResponses = nullptr;   // the next numLanes outputs for a unit value in each state variable
+            VectorType* inputResponses = nullptr;   // the next numLanes outputs for a unit impulse at each input position
+        };
+
+        OwnedArray<Section> sections;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockFilter)
+    };
+
 } // namespace IIR
 } // namespace dsp
 } // namespace juce
@@ -220,6 +220,553 @@ void Filter<SampleType>::check()
         reset();
 }
 
+//==============================================================================
+template <typename SampleType>
+CascadedFilter<SampleType>::CascadedFilter() {}
+
+template <typename SampleType>
+CascadedFilter<SampleType>::CascadedFilter (const Array<Coefficients<typename CascadedFilter<SampleType>::NumericType>>& c)
+{
+    setSections (c);
+}
+
+template <typename SampleType>
+void CascadedFilter<SampleType>::setSections (const Array<Coefficients<typename CascadedFilter<SampleType>::NumericType>>& c)
+{
+    ReferenceCountedArray<Coefficients<NumericType>> copies;
+
+    for (auto& section : c)
+        copies.add (new Coefficients<NumericType> (section));
+
+    setSections (copies);
+}
+
+template <typename SampleType>
+void CascadedFilter<SampleType>::setSections (const ReferenceCountedArray<Coefficients<typename CascadedFilter<SampleType>::NumericType>>& c)
+{
+    sections.clear();
+
+    for (int i = 0; i < c.size(); ++i)
+        sections.add (new Filter<SampleType> (c.getObjectPointerUnchecked (i)));
+}
+
+template <typename SampleType>
+void CascadedFilter<SampleType>::reset (SampleType resetToValue)
+{
+    for (auto* section : sections)
+        section->reset (resetToValue);
+}
+
+template <typename SampleType>
+void CascadedFilter<SampleType>::prepare (const ProcessSpec& spec) noexcept
+{
+    for (auto* section : sections)
+        section->prepare (spec);
+}
+
+template <typename SampleType>
+template <typename ProcessContext>
+void CascadedFilter<SampleType>::process (const ProcessContext& context) noexcept
+{
+    static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                   "The sample-type of the IIR filter must match the sample-type supplied to this process callback");
+
+    if (sections.isEmpty())
+    {
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels()  == 1);
+        jassert (outputBlock.getNumChannels() == 1);
+
+        auto* src = inputBlock .getChannelPointer (0);
+        auto* dst = outputBlock.getChannelPointer (0);
+
+        if (src != dst)
+            for (size_t i = 0; i < inputBlock.getNumSamples(); ++i)
+                dst[i] = src[i];
+
+        return;
+    }
+
+    // the first section reads from the input, and the rest all work in-place on the output
+    sections.getUnchecked (0)->process (context);
+
+    ProcessContextReplacing<SampleType> replacingContext (context.getOutputBlock());
+
+    for (int i = 1; i < sections.size(); ++i)
+        sections.getUnchecked (i)->process (replacingContext);
+}
+
+template <typename SampleType>
+SampleType JUCE_VECTOR_CALLTYPE CascadedFilter<SampleType>::processSample (SampleType sample) noexcept
+{
+    for (auto* section : sections)
+        sample = section->processSample (sample);
+
+    return sample;
+}
+
+template <typename SampleType>
+void CascadedFilter<SampleType>::snapToZero() noexcept
+{
+    for (auto* section : sections)
+        section->snapToZero();
+}
+
+//==============================================================================
+template <typename SampleType>
+constexpr size_t MultiChannelFilter<SampleType>::numLanes;
+
+template <typename SampleType>
+constexpr size_t MultiChannelFilter<SampleType>::maxChunkSize;
+
+template <typename SampleType>
+MultiChannelFilter<SampleType>::MultiChannelFilter() {}
+
+template <typename SampleType>
+MultiChannelFilter<SampleType>::MultiChannelFilter (Coefficients<SampleType>* c)
+{
+    setCoefficients (c);
+}
+
+template <typename SampleType>
+MultiChannelFilter<SampleType>::MultiChannelFilter (const Array<Coefficients<SampleType>>& c)
+{
+    setSections (c);
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::setCoefficients (Coefficients<SampleType>* c)
+{
+    typename Coefficients<SampleType>::Ptr newCoefficients (c);
+
+    sections.clear();
+
+    if (newCoefficients != nullptr)
+        sections.add (newCoefficients);
+
+    updateGroups();
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::setSections (const Array<Coefficients<SampleType>>& c)
+{
+    sections.clear();
+
+    for (auto& section : c)
+        sections.add (new Coefficients<SampleType> (section));
+
+    updateGroups();
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::updateGroups()
+{
+    for (auto* group : groups)
+        group->setSections (sections);
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::reset()
+{
+    for (auto* group : groups)
+        group->reset();
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    auto numGroups = (int) ((spec.numChannels + numLanes - 1) / numLanes);
+
+    groups.removeRange (numGroups, groups.size());
+
+    while (groups.size() < numGroups)
+    {
+        auto* group = groups.add (new CascadedFilter<VectorType>());
+        group->setSections (sections);
+    }
+
+    auto groupSpec = spec;
+    groupSpec.numChannels = 1;
+
+    for (auto* group : groups)
+        group->prepare (groupSpec);
+
+    scratchSize = jlimit ((size_t) 1, maxChunkSize, (size_t) spec.maximumBlockSize);
+    scratchMemory.malloc ((scratchSize + 1) * sizeof (VectorType));
+    scratch = snapPointerToAlignment (reinterpret_cast<VectorType*> (scratchMemory.getData()), sizeof (VectorType));
+}
+
+template <typename SampleType>
+template <typename ProcessContext>
+void MultiChannelFilter<SampleType>::process (const ProcessContext& context) noexcept
+{
+    static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                   "The sample-type of the IIR filter must match the sample-type supplied to this process callback");
+
+    auto&& inputBlock  = context.getInputBlock();
+    auto&& outputBlock = context.getOutputBlock();
+
+    jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+    jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+    // This filter has been given more channels than it was prepared for!
+    jassert (inputBlock.getNumChannels() <= (size_t) groups.size() * numLanes);
+
+    auto numChannels = jmin (inputBlock.getNumChannels(), (size_t) groups.size() * numLanes);
+    auto numSamples  = inputBlock.getNumSamples();
+
+    auto* interleaved = reinterpret_cast<SampleType*> (scratch);
+    VectorType* scratchChannels[] = { scratch };
+
+    for (size_t firstChannel = 0; firstChannel < numChannels; firstChannel += numLanes)
+    {
+        auto& group = *groups.getUnchecked ((int) (firstChannel / numLanes));
+        auto numChannelsInGroup = jmin (numLanes, numChannels - firstChannel);
+
+        for (size_t start = 0; start < numSamples; start += scratchSize)
+        {
+            auto num = jmin (scratchSize, numSamples - start);
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                if (lane < numChannelsInGroup)
+                {
+                    auto* src = inputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * numLanes + lane] = src[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * numLanes + lane] = SampleType();
+                }
+            }
+
+            AudioBlock<VectorType> block (scratchChannels, 1, num);
+            ProcessContextReplacing<VectorType> groupContext (block);
+            group.process (groupContext);
+
+            for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            {
+                auto* dst = outputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = interleaved[i * numLanes + lane];
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiChannelFilter<SampleType>::snapToZero() noexcept
+{
+    for (auto* group : groups)
+        group->snapToZero();
+}
+
+//==============================================================================
+template <typename SampleType>
+constexpr size_t BlockFilter<SampleType>::numLanes;
+
+template <typename SampleType>
+BlockFilter<SampleType>::BlockFilter() {}
+
+template <typename SampleType>
+BlockFilter<SampleType>::BlockFilter (Coefficients<SampleType>* c)
+{
+    setCoefficients (c);
+}
+
+template <typename SampleType>
+BlockFilter<SampleType>::BlockFilter (const Array<Coefficients<SampleType>>& c)
+{
+    setSections (c);
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::setCoefficients (Coefficients<SampleType>* c)
+{
+    typename Coefficients<SampleType>::Ptr newCoefficients (c);
+
+    sections.clear();
+
+    if (newCoefficients != nullptr)
+        sections.add (new Section (newCoefficients));
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::setSections (const Array<Coefficients<SampleType>>& c)
+{
+    sections.clear();
+
+    for (auto& section : c)
+        sections.add (new Section (new Coefficients<SampleType> (section)));
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::reset (SampleType resetToValue)
+{
+    for (auto* section : sections)
+        section->reset (resetToValue);
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::prepare (const ProcessSpec&) noexcept
+{
+    for (auto* section : sections)
+    {
+        section->update();
+        section->reset (SampleType());
+    }
+}
+
+template <typename SampleType>
+template <typename ProcessContext>
+void BlockFilter<SampleType>::process (const ProcessContext& context) noexcept
+{
+    static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                   "The sample-type of the IIR filter must match the sample-type supplied to this process callback");
+
+    auto&& inputBlock  = context.getInputBlock();
+    auto&& outputBlock = context.getOutputBlock();
+
+    // This class can only process mono signals. Use the ProcessorDuplicator class
+    // to apply this filter on a multi-channel audio stream.
+    jassert (inputBlock.getNumChannels()  == 1);
+    jassert (outputBlock.getNumChannels() == 1);
+
+    auto numSamples = inputBlock.getNumSamples();
+    auto* src = inputBlock .getChannelPointer (0);
+    auto* dst = outputBlock.getChannelPointer (0);
+
+    if (sections.isEmpty())
+    {
+        if (src != dst)
+            FloatVectorOperations::copy (dst, src, (int) numSamples);
+
+        return;
+    }
+
+    // the first section reads from the input, and the rest all work in-place on the output
+    for (auto* section : sections)
+    {
+        section->process (src, dst, numSamples);
+        src = dst;
+    }
+
+    snapToZero();
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::snapToZero() noexcept
+{
+    for (auto* section : sections)
+        section->snapToZero();
+}
+
+//==============================================================================
+template <typename SampleType>
+BlockFilter<SampleType>::Section::Section (Coefficients<SampleType>* c)  : coefficients (c)
+{
+    update();
+    reset (SampleType());
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::Section::update()
+{
+    auto& newCoefficients = coefficients->coefficients;
+
+    if (newCoefficients == cachedCoefficients)
+        return;
+
+    if (newCoefficients.size() == cachedCoefficients.size())
+    {
+        for (int i = 0; i < newCoefficients.size(); ++i)
+            cachedCoefficients.setUnchecked (i, newCoefficients.getUnchecked (i));
+    }
+    else
+    {
+        cachedCoefficients = newCoefficients;
+    }
+
+    auto newOrder = coefficients->getFilterOrder();
+
+    if (newOrder != order)
+    {
+        order = newOrder;
+        state.calloc (jmax (order, (size_t) 1));
+        stateTransitions.malloc (order * order + 1);
+        inputTransitions.malloc (order * numLanes + 1);
+        responseMemory.malloc ((order + numLanes + 1) * sizeof (VectorType));
+        stateResponses = snapPointerToAlignment (reinterpret_cast<VectorType*> (responseMemory.getData()), sizeof (VectorType));
+        inputResponses = stateResponses + order;
+    }
+
+    if (order == 0 || order > numLanes)
+        return;
+
+    // Work out how the next numLanes outputs and the state after them respond to each state
+    // variable and to each of the next numLanes inputs, by running the normal recurrence on
+    // unit values.
+    auto* c = coefficients->getRawCoefficients();
+    SampleType tempState[numLanes], outputs[numLanes];
+
+    auto run = [&] (size_t impulsePosition)
+    {
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            auto in = (i == impulsePosition ? SampleType (1) : SampleType());
+            auto out = (c[0] * in) + tempState[0];
+
+            for (size_t j = 0; j < order - 1; ++j)
+                tempState[j] = (c[j + 1] * in) - (c[order + j + 1] * out) + tempState[j + 1];
+
+            tempState[order - 1] = (c[order] * in) - (c[order * 2] * out);
+            outputs[i] = out;
+        }
+    };
+
+    for (size_t m = 0; m < order; ++m)
+    {
+        for (size_t j = 0; j < order; ++j)
+            tempState[j] = (j == m ? SampleType (1) : SampleType());
+
+        run (numLanes);
+        std::copy (outputs, outputs + numLanes, reinterpret_cast<SampleType*> (stateResponses + m));
+
+        for (size_t j = 0; j < order; ++j)
+            stateTransitions[j * order + m] = tempState[j];
+    }
+
+    for (size_t k = 0; k < numLanes; ++k)
+    {
+        std::fill (tempState, tempState + order, SampleType());
+
+        run (k);
+        std::copy (outputs, outputs + numLanes, reinterpret_cast<SampleType*> (inputResponses + k));
+
+        for (size_t j = 0; j < order; ++j)
+            inputTransitions[j * numLanes + k] = tempState[j];
+    }
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::Section::reset (SampleType resetToValue) noexcept
+{
+    for (size_t i = 0; i < order; ++i)
+        state[i] = resetToValue;
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::Section::process (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+{
+    update();
+
+    auto numBlockSamples = numSamples - (numSamples % numLanes);
+
+    if (order == 0 || order > numLanes)
+        numBlockSamples = 0;
+    else if (order == 1)
+        processBlocks<1> (src, dst, numBlockSamples);
+    else if (order == 2)
+        processBlocks<2> (src, dst, numBlockSamples);
+    else
+        processBlocks<0> (src, dst, numBlockSamples);
+
+    processSerially (src + numBlockSamples, dst + numBlockSamples, numSamples - numBlockSamples);
+}
+
+template <typename SampleType>
+template <size_t fixedOrder>
+void BlockFilter<SampleType>::Section::processBlocks (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+{
+    // a non-zero fixedOrder lets the compiler unroll the loops for the common first and second order sections
+    const size_t n = (fixedOrder != 0 ? fixedOrder : order);
+    SampleType s[numLanes];
+
+    for (size_t j = 0; j < n; ++j)
+        s[j] = state[j];
+
+    for (size_t i = 0; i < numSamples; i += numLanes)
+    {
+        SampleType in[numLanes], newState[numLanes];
+
+        for (size_t k = 0; k < numLanes; ++k)
+            in[k] = src[i + k];
+
+        auto y = stateResponses[0] * s[0];
+
+        for (size_t m = 1; m < n; ++m)
+            y += stateResponses[m] * s[m];
+
+        for (size_t k = 0; k < numLanes; ++k)
+            y += inputResponses[k] * in[k];
+
+        auto* out = reinterpret_cast<const SampleType*> (&y);
+
+        for (size_t k = 0; k < numLanes; ++k)
+            dst[i + k] = out[k];
+
+        // The state at the end of the block doesn't depend on the outputs, so this is the only
+        // part of the calculation that each block has to wait for the previous one to finish.
+        for (size_t j = 0; j < n; ++j)
+        {
+            SampleType sum = {};
+
+            for (size_t k = 0; k < numLanes; ++k)
+                sum += inputTransitions[j * numLanes + k] * in[k];
+
+            for (size_t m = 0; m < n; ++m)
+                sum += stateTransitions[j * n + m] * s[m];
+
+            newState[j] = sum;
+        }
+
+        for (size_t j = 0; j < n; ++j)
+            s[j] = newState[j];
+    }
+
+    for (size_t j = 0; j < n; ++j)
+        state[j] = s[j];
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::Section::processSerially (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+{
+    auto* c = coefficients->getRawCoefficients();
+
+    if (order == 0)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+            dst[i] = src[i] * c[0];
+
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto in = src[i];
+        auto out = (in * c[0]) + state[0];
+        dst[i] = out;
+
+        for (size_t j = 0; j < order - 1; ++j)
+            state[j] = (in * c[j + 1]) - (out * c[order + j + 1]) + state[j + 1];
+
+        state[order - 1] = (in * c[order]) - (out * c[order * 2]);
+    }
+}
+
+template <typename SampleType>
+void BlockFilter<SampleType>::Section::snapToZero() noexcept
+{
+    for (size_t i = 0; i < order; ++i)
+        util::snapToZero (state[i]);
+}
+
 #endif
 
 } // namespace IIR
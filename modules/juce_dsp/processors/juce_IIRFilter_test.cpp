@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRFilterTest : public UnitTest
+{
+    template <typename Type>
+    static void fillRandom (Random& random, AudioBlock<Type>& block)
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+                block.getChannelPointer (ch)[i] = static_cast<Type> ((2.0f * random.nextFloat()) - 1.0f);
+    }
+
+    template <typename Type>
+    static bool checkBlocksAreSimilar (const AudioBlock<Type>& a, const AudioBlock<Type>& b) noexcept
+    {
+        for (size_t ch = 0; ch < a.getNumChannels(); ++ch)
+            for (size_t i = 0; i < a.getNumSamples(); ++i)
+                if (std::abs (a.getChannelPointer (ch)[i] - b.getChannelPointer (ch)[i]) > static_cast<Type> (1e-5))
+                    return false;
+
+        return true;
+    }
+
+    template <typename Type>
+    static Array<IIR::Coefficients<Type>> getHighOrderDesign()
+    {
+        return FilterDesign<Type>::designIIRLowpassHighOrderButterworthMethod (static_cast<Type> (2000), 44100.0,
+                                                                                static_cast<Type> (0.05),
+                                                                                static_cast<Type> (-0.1),
+                                                                                static_cast<Type> (-80));
+    }
+
+    // reference implementation: a separate chain of scalar filters for each channel
+    template <typename Type>
+    static void reference (const Array<IIR::Coefficients<Type>>& sections, const AudioBlock<Type>& input,
+                           AudioBlock<Type>& output, size_t blockSize)
+    {
+        output.copy (input);
+
+        for (size_t ch = 0; ch < input.getNumChannels(); ++ch)
+        {
+            for (auto& section : sections)
+            {
+                IIR::Filter<Type> filter (new IIR::Coefficients<Type> (section));
+                auto* data = output.getChannelPointer (ch);
+
+                for (size_t start = 0; start < output.getNumSamples(); start += blockSize)
+                {
+                    auto* channelData = data + start;
+                    AudioBlock<Type> block (&channelData, 1, jmin (blockSize, output.getNumSamples() - start));
+                    ProcessContextReplacing<Type> context (block);
+                    filter.process (context);
+                }
+            }
+        }
+    }
+
+    template <typename Type>
+    void runMultiChannelTest (const Array<IIR::Coefficients<Type>>& sections)
+    {
+        Random random (8392829);
+        constexpr size_t n = 1013;
+
+        for (auto numChannels : { 1, 3, 8, 11 })
+        {
+            for (auto blockSize : { 1, 64, 300, 1013 })
+            {
+                auto numChans = static_cast<size_t> (numChannels);
+                auto blockLength = static_cast<size_t> (blockSize);
+
+                HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
+                AudioBlock<Type> input (inputBuffer, numChans, n), output (outputBuffer, numChans, n), ref (refBuffer, numChans, n);
+                fillRandom (random, input);
+
+                reference (sections, input, ref, blockLength);
+
+                IIR::MultiChannelFilter<Type> filter (sections);
+                filter.prepare ({ 44100.0, static_cast<uint32> (blockLength), static_cast<uint32> (numChans) });
+
+                for (size_t start = 0; start < n; start += blockLength)
+                {
+                    auto len = jmin (blockLength, n - start);
+                    auto inBlock  = input .getSubBlock (start, len);
+                    auto outBlock = output.getSubBlock (start, len);
+                    ProcessContextNonReplacing<Type> context (inBlock, outBlock);
+                    filter.process (context);
+                }
+
+                expect (checkBlocksAreSimilar (output, ref));
+            }
+        }
+    }
+
+    template <typename Type>
+    void runCascadeTest()
+    {
+        Random random (1234);
+        constexpr size_t n = 517;
+
+        auto sections = getHighOrderDesign<Type>();
+        expect (sections.size() > 1);
+
+        HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
+        AudioBlock<Type> input (inputBuffer, 1, n), output (outputBuffer, 1, n), ref (refBuffer, 1, n);
+        fillRandom (random, input);
+        reference (sections, input, ref, n);
+
+        IIR::CascadedFilter<Type> cascade (sections);
+        expectEquals ((int) cascade.getNumSections(), sections.size());
+
+        cascade.prepare ({ 44100.0, (uint32) n, 1 });
+        ProcessContextNonReplacing<Type> context (input, output);
+        cascade.process (context);
+        expect (checkBlocksAreSimilar (output, ref));
+
+        cascade.reset();
+
+        for (size_t i = 0; i < n; ++i)
+            output.getChannelPointer (0)[i] = cascade.processSample (input.getChannelPointer (0)[i]);
+
+        expect (checkBlocksAreSimilar (output, ref));
+
+        IIR::CascadedFilter<Type> empty;
+        empty.process (context);
+        expect (checkBlocksAreSimilar (output, input));
+    }
+
+    template <typename Type>
+    static Type getMaximumDifference (const AudioBlock<Type>& a, const AudioBlock<Type>& b) noexcept
+    {
+        Type maxDifference = {};
+
+        for (size_t ch = 0; ch < a.getNumChannels(); ++ch)
+            for (size_t i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = jmax (maxDifference, std::abs (a.getChannelPointer (ch)[i] - b.getChannelPointer (ch)[i]));
+
+        return maxDifference;
+    }
+
+    template <typename Type>
+    void runBlockTest (const String& filterName, const Array<IIR::Coefficients<Type>>& sections, Type tolerance)
+    {
+        Random random (4321);
+        constexpr size_t n = 1013;
+        Type maxDifference = {};
+
+        for (auto blockSize : { 1, 3, 64, 1013 })
+        {
+            auto blockLength = static_cast<size_t> (blockSize);
+
+            HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
+            AudioBlock<Type> input (inputBuffer, 1, n), output (outputBuffer, 1, n), ref (refBuffer, 1, n);
+            fillRandom (random, input);
+
+            reference (sections, input, ref, blockLength);
+
+            IIR::BlockFilter<Type> filter (sections);
+            filter.prepare ({ 44100.0, static_cast<uint32> (blockLength), 1 });
+
+            for (size_t start = 0; start < n; start += blockLength)
+            {
+                auto len = jmin (blockLength, n - start);
+                auto inBlock  = input .getSubBlock (start, len);
+                auto outBlock = output.getSubBlock (start, len);
+                ProcessContextNonReplacing<Type> context (inBlock, outBlock);
+                filter.process (context);
+            }
+
+            maxDifference = jmax (maxDifference, getMaximumDifference (output, ref));
+        }
+
+        logMessage (filterName + ": maximum difference from the TDF-II filter = " + String (maxDifference));
+        expect (maxDifference < tolerance);
+    }
+
+    template <typename Type>
+    void runBlockCoefficientChangeTest()
+    {
+        Random random (99);
+        constexpr size_t n = 400;
+
+        HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
+        AudioBlock<Type> input (inputBuffer, 1, n), output (outputBuffer, 1, n), ref (refBuffer, 1, n);
+        fillRandom (random, input);
+
+        IIR::Filter<Type> serial (IIR::Coefficients<Type>::makeLowPass (48000.0, static_cast<Type> (500)));
+        IIR::BlockFilter<Type> block (new IIR::Coefficients<Type> (*serial.coefficients));
+
+        for (size_t start = 0; start < n; start += 100)
+        {
+            auto newCoefficients = IIR::Coefficients<Type>::makePeakFilter (48000.0, static_cast<Type> (100 + start * 10),
+                                                                            static_cast<Type> (0.7), static_cast<Type> (2));
+            *serial.coefficients = *newCoefficients;
+            *block.getSection (0) = *newCoefficients;
+
+            auto inBlock  = input .getSubBlock (start, 100);
+            auto outBlock = output.getSubBlock (start, 100);
+            auto refBlock = ref   .getSubBlock (start, 100);
+
+            ProcessContextNonReplacing<Type> refContext (inBlock, refBlock);
+            ProcessContextNonReplacing<Type> blockContext (inBlock, outBlock);
+            serial.process (refContext);
+            block.process (blockContext);
+        }
+
+        expect (checkBlocksAreSimilar (output, ref));
+    }
+
+    template <typename Type>
+    void runRealtimeUpdateTest()
+    {
+        auto made = IIR::Coefficients<Type>::makePeakFilter (48000.0, static_cast<Type> (1000), static_cast<Type> (0.7), static_cast<Type> (2));
+
+        // assigning an array of the same order reuses the existing storage
+        IIR::Coefficients<Type> coefficients (IIR::ArrayCoefficients<Type>::makeLowPass (48000.0, static_cast<Type> (500)));
+        auto* storage = coefficients.getRawCoefficients();
+
+        coefficients = IIR::ArrayCoefficients<Type>::makePeakFilter (48000.0, static_cast<Type> (1000), static_cast<Type> (0.7), static_cast<Type> (2));
+        expect (coefficients.getRawCoefficients() == storage);
+        expect (coefficients.coefficients == made->coefficients);
+
+        coefficients = IIR::ArrayCoefficients<Type>::makeFirstOrderHighPass (48000.0, static_cast<Type> (200));
+        expect (coefficients.getRawCoefficients() == storage);
+        expect (coefficients.coefficients == IIR::Coefficients<Type>::makeFirstOrderHighPass (48000.0, static_cast<Type> (200))->coefficients);
+
+        coefficients = *made;
+        expect (coefficients.getRawCoefficients() == storage);
+        expect (coefficients.coefficients == made->coefficients);
+
+        // a duplicator's channels all pick up an update to the shared state
+        Random random (7);
+        HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
+        AudioBlock<Type> input (inputBuffer, 2, 256), output (outputBuffer, 2, 256), ref (refBuffer, 2, 256);
+        fillRandom (random, input);
+
+        ProcessorDuplicator<IIR::Filter<Type>, IIR::Coefficients<Type>> duplicator (IIR::Coefficients<Type>::makeLowPass (48000.0, static_cast<Type> (500)));
+        duplicator.prepare ({ 48000.0, 256, 2 });
+
+        StateUpdater<IIR::Coefficients<Type>> updater;
+        expect (! updater.update (*duplicator.state));
+
+        updater.post (IIR::Coefficients<Type>::makeLowPass (48000.0, static_cast<Type> (3000)));
+        updater.post (made);
+        expect (updater.isUpdatePending());
+        expect (updater.update (*duplicator.state));
+        expect (! updater.isUpdatePending());
+        expect (duplicator.state->coefficients == made->coefficients);
+
+        duplicator.process (ProcessContextNonReplacing<Type> (input, output));
+        reference ({ *made }, input, ref, 256);
+        expect (checkBlocksAreSimilar (output, ref));
+
+        // once the audio thread has moved on, the posted states are released
+        updater.post (IIR::Coefficients<Type>::makeLowPass (48000.0, static_cast<Type> (500)));
+        expect (updater.update (*duplicator.state));
+        updater.releaseFinishedStates();
+        expectEquals (made->getReferenceCount(), 1);
+    }
+
+public:
+    IIRFilterTest() : UnitTest ("IIR Filter") {}
+
+    void runTest() override
+    {
+        beginTest ("Cascaded filters");
+        runCascadeTest<float>();
+        runCascadeTest<double>();
+
+        beginTest ("Multi-channel filters");
+        runMultiChannelTest<float>  ({ *IIR::Coefficients<float>::makeLowPass (44100.0, 1000.0f) });
+        runMultiChannelTest<double> ({ *IIR::Coefficients<double>::makeHighShelf (44100.0, 3000.0, 0.7, 2.0) });
+        runMultiChannelTest<float>  ({ *IIR::Coefficients<float>::makeFirstOrderHighPass (44100.0, 200.0f) });
+
+        beginTest ("Multi-channel cascades");
+        runMultiChannelTest<float>  (getHighOrderDesign<float>());
+        runMultiChannelTest<double> (getHighOrderDesign<double>());
+
+        beginTest ("Block filters");
+        runBlockTest<float>  ("Butterworth cascade (float)",  getHighOrderDesign<float>(), 1e-4f);
+        runBlockTest<double> ("Butterworth cascade (double)", getHighOrderDesign<double>(), 1e-10);
+        runBlockTest<float>  ("First order high-pass (float)", { *IIR::Coefficients<float>::makeFirstOrderHighPass (44100.0, 200.0f) }, 1e-4f);
+        // with poles this close to the unit circle, the float TDF-II filter itself is only accurate to around 3e-4
+        runBlockTest<float>  ("Low shelf at 192kHz (float)", { *IIR::Coefficients<float>::makeLowShelf (192000.0, 80.0f, 0.7f, 0.5f) }, 1e-3f);
+        runBlockTest<float>  ("Third order (float)",  { IIR::Coefficients<float>  (0.1f, 0.3f, 0.3f, 0.1f, 1.0f, -0.6f, 0.4f, -0.1f) }, 1e-4f);
+        runBlockTest<double> ("Third order (double)", { IIR::Coefficients<double> (0.1, 0.3, 0.3, 0.1, 1.0, -0.6, 0.4, -0.1) }, 1e-10);
+        runBlockCoefficientChangeTest<float>();
+        runBlockCoefficientChangeTest<double>();
+
+        beginTest ("Realtime coefficient updates");
+        runRealtimeUpdateTest<float>();
+        runRealtimeUpdateTest<double>();
+    }
+};
+
+static IIRFilterTest iirFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
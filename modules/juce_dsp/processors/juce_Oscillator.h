@@ -41,17 +41,25 @@ public:
     */
     using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
 
+    /** The type of function that generates the waveform.
+        This stores the function inline, so a lambda passed in must be no bigger than
+        64 bytes, which is enough for a handful of captured values.
+    */
+    using GeneratorFunction = FixedSizeFunction<64, NumericType (NumericType)>;
+
     /** Creates an oscillator with a periodic input function (-pi..pi).
 
         If lookup table is not zero, then the function will be approximated
         with a lookup table.
     */
-    Oscillator (const std::function<NumericType (NumericType)>& function, size_t lookupTableNumPoints = 0)
-        : generator (function), frequency (440.0f)
+    Oscillator (GeneratorFunction function, size_t lookupTableNumPoints = 0)
+        : generator (std::move (function)), frequency (440.0f)
     {
         if (lookupTableNumPoints != 0)
         {
-            auto table = new LookupTableTransform<NumericType> (generator, static_cast <NumericType> (-1.0 * double_Pi),
+            auto& gen = generator;
+            auto table = new LookupTableTransform<NumericType> ([&gen] (NumericType x) { return gen (x); },
+                                                                static_cast <NumericType> (-1.0 * double_Pi),
                                                                 static_cast<NumericType> (double_Pi), lookupTableNumPoints);
 
             lookupTable = table;
@@ -99,6 +107,23 @@ public:
     /** Processes the input and output buffers supplied in the processing context. */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
+    {
+        // a lookup table is called directly, rather than through the generator function
+        if (lookupTable != nullptr)
+        {
+            auto& table = *lookupTable;
+            processWithGenerator (context, [&table] (NumericType x) { return table.processSampleUnchecked (x); });
+        }
+        else
+        {
+            processWithGenerator (context, generator);
+        }
+    }
+
+private:
+    //==============================================================================
+    template <typename ProcessContext, typename Generator>
+    void processWithGenerator (const ProcessContext& context, const Generator& gen) noexcept
     {
         auto&& outBlock = context.getOutputBlock();
 
@@ -117,8 +142,7 @@ public:
             for (size_t i = 0; i < len; ++i)
             {
                 buffer[i] = pos - static_cast<NumericType> (double_Pi);
-
-                pos = std::fmod (pos + (baseIncrement * frequency.getNextValue()), static_cast<NumericType> (2.0 * double_Pi));
+                pos = wrapPhase (pos + (baseIncrement * frequency.getNextValue()));
             }
 
             for (size_t ch = 0; ch < numChannels; ++ch)
@@ -126,7 +150,7 @@ public:
                 auto* dst = outBlock.getChannelPointer (ch);
 
                 for (size_t i = 0; i < len; ++i)
-                    dst[i] = generator (buffer[i]);
+                    dst[i] = gen (buffer[i]);
             }
         }
         else
@@ -140,8 +164,8 @@ public:
 
                 for (size_t i = 0; i < len; ++i)
                 {
-                    dst[i] = generator (p - static_cast<NumericType> (double_Pi));
-                    p = std::fmod (p + freq, static_cast<NumericType> (2.0 * double_Pi));
+                    dst[i] = gen (p - static_cast<NumericType> (double_Pi));
+                    p = wrapPhase (p + freq);
                 }
             }
 
@@ -149,9 +173,17 @@ public:
         }
     }
 
-private:
+    /** Wraps a phase which has been advanced by less than a cycle, which is
+        much cheaper than calling std::fmod for every sample.
+    */
+    static NumericType wrapPhase (NumericType p) noexcept
+    {
+        auto twoPi = static_cast<NumericType> (2.0 * double_Pi);
+        return p >= twoPi ? (p < twoPi * 2 ? p - twoPi : std::fmod (p, twoPi)) : p;
+    }
+
     //==============================================================================
-    std::function<NumericType (NumericType)> generator;
+    GeneratorFunction generator;
     ScopedPointer<LookupTableTransform<NumericType>> lookupTable;
     Array<NumericType> rampBuffer;
     LinearSmoothedValue<NumericType> frequency {static_cast<NumericType> (440.0)};
@@ -84,7 +84,7 @@ class OversamplingDummy : public OversamplingEngine<SampleType>
 {
 public:
     //===============================================================================
-    OversamplingDummy (size_t numChannels) : OversamplingEngine<SampleType> (numChannels, 1) {}
+    OversamplingDummy (size_t numChannelsToUse) : OversamplingEngine<SampleType> (numChannelsToUse, 1) {}
     ~OversamplingDummy() {}
 
     //===============================================================================
@@ -117,55 +117,29 @@ private:
 };
 
 //===============================================================================
-/** Oversampling engine class performing 2 times oversampling using the Filter
-    Design FIR Equiripple method. The resulting filter is linear phase,
-    symmetric, and has every two samples but the middle one equal to zero,
-    leading to specific processing optimizations.
+/** Base class for the oversampling engines performing 2 times oversampling with
+    a FIR filter. The filter is split into its even and odd phases, which are both
+    processed at the lower sample rate, so that no time is spent on the zeros
+    inserted by the upsampling, or on the samples thrown away by the downsampling.
+
+    The channels are processed in groups, each channel of a group using one lane
+    of a SIMD register.
 */
 template <typename SampleType>
-class Oversampling2TimesEquirippleFIR : public OversamplingEngine<SampleType>
+class Oversampling2TimesPolyphaseFIR : public OversamplingEngine<SampleType>
 {
 public:
     //===============================================================================
-    Oversampling2TimesEquirippleFIR (size_t numChannels,
-                                     SampleType normalizedTransitionWidthUp,
-                                     SampleType stopbandAttenuationdBUp,
-                                     SampleType normalizedTransitionWidthDown,
-                                     SampleType stopbandAttenuationdBDown) : OversamplingEngine<SampleType> (numChannels, 2)
-    {
-        coefficientsUp = *dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthUp, stopbandAttenuationdBUp);
-        coefficientsDown = *dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthDown, stopbandAttenuationdBDown);
-
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (numChannels), static_cast<int> (N));
-
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
-
-        stateDown.setSize (static_cast<int> (numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (numChannels), static_cast<int> (Ndiv4 + 1));
-
-        position.resize (static_cast<int> (numChannels));
-    }
-
-    ~Oversampling2TimesEquirippleFIR() {}
+    Oversampling2TimesPolyphaseFIR (size_t numChannelsToUse) : OversamplingEngine<SampleType> (numChannelsToUse, 2) {}
 
     //===============================================================================
-    SampleType getLatencyInSamples() override
-    {
-        return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
-    }
-
     void reset() override
     {
         OversamplingEngine<SampleType>::reset();
 
-        stateUp.clear();
-        stateDown.clear();
-        stateDown2.clear();
-
-        position.fill (0);
+        for (auto* histories : { &historiesUp, &evenHistoriesDown, &oddHistoriesDown })
+            for (auto* history : *histories)
+                history->clear();
     }
 
     void processSamplesUp (dsp::AudioBlock<SampleType> &inputBlock) override
@@ -173,36 +147,45 @@ public:
         jassert (inputBlock.getNumChannels() <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumChannels()));
         jassert (inputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
-        // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
         auto numSamples = inputBlock.getNumSamples();
+        auto numChannelsToProcess = inputBlock.getNumChannels();
+        const SampleType* inputs[numLanes];
+        SampleType* outputs[numLanes];
 
-        // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); channel++)
+        for (size_t firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += numLanes)
         {
-            auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            auto numGroupChannels = jmin (numLanes, numChannelsToProcess - firstChannel);
+            auto& history = *historiesUp.getUnchecked (static_cast<int> (firstChannel / numLanes));
 
-            for (size_t i = 0; i < numSamples; i++)
+            for (size_t channel = 0; channel < numGroupChannels; ++channel)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
+                inputs[channel]  = inputBlock.getChannelPointer (firstChannel + channel);
+                outputs[channel] = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (firstChannel + channel));
+            }
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            for (size_t start = 0; start < numSamples;)
+            {
+                auto num = history.prepare (numSamples - start);
+                history.write (inputs, numGroupChannels, start, 1, num);
 
-                // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
+                for (size_t i = 0; i < num; ++i)
+                {
+                    auto* x = history.getInputsForSample (i, num);
+                    auto even = process (evenUp, x);
+                    auto odd  = process (oddUp, x);
+
+                    auto* evenLanes = reinterpret_cast<const SampleType*> (&even);
+                    auto* oddLanes  = reinterpret_cast<const SampleType*> (&odd);
+                    auto index = (start + i) << 1;
+
+                    for (size_t channel = 0; channel < numGroupChannels; ++channel)
+                    {
+                        outputs[channel][index]     = evenLanes[channel];
+                        outputs[channel][index + 1] = oddLanes[channel];
+                    }
+                }
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                start += num;
             }
         }
     }
@@ -212,62 +195,415 @@ public:
         jassert (outputBlock.getNumChannels() <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumChannels()));
         jassert (outputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
-        // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
         auto numSamples = outputBlock.getNumSamples();
+        auto numChannelsToProcess = outputBlock.getNumChannels();
+        const SampleType* evenInputs[numLanes];
+        const SampleType* oddInputs[numLanes];
+        SampleType* outputs[numLanes];
 
-        // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); channel++)
+        for (size_t firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += numLanes)
         {
-            auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            auto numGroupChannels = jmin (numLanes, numChannelsToProcess - firstChannel);
+            auto group = static_cast<int> (firstChannel / numLanes);
+            auto& evenHistory = *evenHistoriesDown.getUnchecked (group);
+            auto& oddHistory  = *oddHistoriesDown.getUnchecked (group);
 
-            for (size_t i = 0; i < numSamples; i++)
+            for (size_t channel = 0; channel < numGroupChannels; ++channel)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                evenInputs[channel] = OversamplingEngine<SampleType>::buffer.getReadPointer (static_cast<int> (firstChannel + channel));
+                oddInputs[channel]  = evenInputs[channel] + 1;
+                outputs[channel]    = outputBlock.getChannelPointer (firstChannel + channel);
+            }
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            for (size_t start = 0; start < numSamples;)
+            {
+                auto num = jmin (evenHistory.prepare (numSamples - start), oddHistory.prepare (numSamples - start));
+                evenHistory.write (evenInputs, numGroupChannels, start, 2, num);
+                oddHistory .write (oddInputs,  numGroupChannels, start, 2, num);
 
-                // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+                for (size_t i = 0; i < num; ++i)
+                {
+                    auto out = process (evenDown, evenHistory.getInputsForSample (i, num))
+                             + process (oddDown,  oddHistory .getInputsForSample (i, num));
 
-                samples[i] = out;
+                    auto* lanes = reinterpret_cast<const SampleType*> (&out);
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k++)
-                    buf[k] = buf[k + 2];
+                    for (size_t channel = 0; channel < numGroupChannels; ++channel)
+                        outputs[channel][start + i] = lanes[channel];
+                }
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
+                start += num;
             }
+        }
+    }
 
-            position.setUnchecked (static_cast<int> (channel), pos);
+protected:
+    //===============================================================================
+    /** The coefficients of one phase of the filter. The coefficient i is applied to
+        the input of the phase delayed by delay + i samples, and if the branch is
+        symmetric, to the input delayed by delay + span - i samples as well.
+    */
+    struct Branch
+    {
+        Array<SampleType> coefficients;
+        size_t delay = 0, span = 0;
+        bool isSymmetric = false;
+
+        size_t getMaximumDelay() const noexcept
+        {
+            return isSymmetric ? delay + span
+                               : delay + static_cast<size_t> (coefficients.size()) - 1;
         }
+    };
+
+    /** Must be called by the constructors of the derived classes. The branches
+        include the gain of 2 needed by the upsampling.
+    */
+    void setBranches (const Branch& newEvenUp, const Branch& newOddUp,
+                      const Branch& newEvenDown, const Branch& newOddDown)
+    {
+        evenUp   = newEvenUp;
+        oddUp    = newOddUp;
+        evenDown = newEvenDown;
+        oddDown  = newOddDown;
 
+        for (size_t channel = 0; channel < OversamplingEngine<SampleType>::numChannels; channel += numLanes)
+        {
+            historiesUp      .add (new History (jmax (evenUp.getMaximumDelay(), oddUp.getMaximumDelay())));
+            evenHistoriesDown.add (new History (evenDown.getMaximumDelay()));
+            oddHistoriesDown .add (new History (oddDown.getMaximumDelay()));
+        }
     }
 
 private:
     //===============================================================================
-    dsp::FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+   #if JUCE_USE_SIMD
+    using VectorType = SIMDRegister<SampleType>;
+   #else
+    using VectorType = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (VectorType) / sizeof (SampleType);
+
+    /** The past inputs of a phase for a group of channels, stored backwards in time
+        and interleaved, so that the dot products with the coefficients are contiguous.
+        Once the start of the buffer is reached, the inputs which are still needed are
+        moved back to its end.
+    */
+    struct History
+    {
+        History (size_t maximumDelay)  : numToKeep (maximumDelay), size (maximumDelay + 256)
+        {
+            memory.malloc ((size + 1) * sizeof (VectorType));
+            data = snapPointerToAlignment (reinterpret_cast<VectorType*> (memory.getData()), sizeof (VectorType));
+            clear();
+        }
+
+        void clear() noexcept
+        {
+            std::fill (data, data + size, VectorType());
+            pos = size - numToKeep;
+        }
+
+        /** Makes room for new inputs, and returns how many of them can be written. */
+        size_t prepare (size_t numSamples) noexcept
+        {
+            if (pos == 0)
+            {
+                std::copy (data, data + numToKeep, data + size - numToKeep);
+                pos = size - numToKeep;
+            }
+
+            return jmin (numSamples, pos);
+        }
+
+        void write (const SampleType* const* channels, size_t numChannelsToWrite,
+                    size_t startSample, size_t stride, size_t numSamples) noexcept
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto v = VectorType();
+                auto* lanes = reinterpret_cast<SampleType*> (&v);
+
+                for (size_t channel = 0; channel < numChannelsToWrite; ++channel)
+                    lanes[channel] = channels[channel][(startSample + i) * stride];
+
+                data[pos - 1 - i] = v;
+            }
+
+            pos -= numSamples;
+        }
+
+        /** Returns the inputs for the i-th of the numSamples samples which have just
+            been written, with the input delayed by d samples at index d.
+        */
+        const VectorType* getInputsForSample (size_t i, size_t numSamples) const noexcept
+        {
+            return data + pos + (numSamples - 1 - i);
+        }
+
+        HeapBlock<char> memory;
+        VectorType* data = nullptr;
+        size_t numToKeep, size, pos = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (History)
+    };
+
+    static VectorType JUCE_VECTOR_CALLTYPE process (const Branch& branch, const VectorType* x) noexcept
+    {
+        auto* coefficients = branch.coefficients.begin();
+        auto numCoefficients = static_cast<size_t> (branch.coefficients.size());
+        auto* input = x + branch.delay;
+
+        // two accumulators, so that the additions don't all wait for each other
+        auto out0 = VectorType(), out1 = VectorType();
+        size_t i = 0;
+
+        if (branch.isSymmetric)
+        {
+            auto* mirroredInput = input + branch.span;
+
+            for (; i + 1 < numCoefficients; i += 2)
+            {
+                out0 += (input[i]     + *(mirroredInput - i))       * coefficients[i];
+                out1 += (input[i + 1] + *(mirroredInput - (i + 1))) * coefficients[i + 1];
+            }
+
+            if (i < numCoefficients)
+                out0 += (input[i] + *(mirroredInput - i)) * coefficients[i];
+        }
+        else
+        {
+            for (; i + 1 < numCoefficients; i += 2)
+            {
+                out0 += input[i]     * coefficients[i];
+                out1 += input[i + 1] * coefficients[i + 1];
+            }
+
+            if (i < numCoefficients)
+                out0 += input[i] * coefficients[i];
+        }
+
+        return out0 + out1;
+    }
+
+    //===============================================================================
+    Branch evenUp, oddUp, evenDown, oddDown;
+    OwnedArray<History> historiesUp, evenHistoriesDown, oddHistoriesDown;
+
+    //===============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseFIR)
+};
+
+template <typename SampleType>
+constexpr size_t Oversampling2TimesPolyphaseFIR<SampleType>::numLanes;
+
+
+//===============================================================================
+/** Oversampling engine class performing 2 times oversampling using the Filter
+    Design FIR Equiripple method. The resulting filter is linear phase,
+    symmetric, and has every two samples but the middle one equal to zero,
+    leading to specific processing optimizations.
+*/
+template <typename SampleType>
+class Oversampling2TimesEquirippleFIR : public Oversampling2TimesPolyphaseFIR<SampleType>
+{
+public:
+    //===============================================================================
+    Oversampling2TimesEquirippleFIR (size_t numChannelsToUse,
+                                     SampleType normalizedTransitionWidthUp,
+                                     SampleType stopbandAttenuationdBUp,
+                                     SampleType normalizedTransitionWidthDown,
+                                     SampleType stopbandAttenuationdBDown) : Oversampling2TimesPolyphaseFIR<SampleType> (numChannelsToUse)
+    {
+        auto coefficientsUp = dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthUp, stopbandAttenuationdBUp);
+        auto coefficientsDown = dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthDown, stopbandAttenuationdBDown);
+
+        latency = static_cast<SampleType> (coefficientsUp->getFilterOrder() + coefficientsDown->getFilterOrder()) * 0.5f;
+
+        this->setBranches (getEvenBranch (*coefficientsUp, 2), getOddBranch (*coefficientsUp, 2, false),
+                           getEvenBranch (*coefficientsDown, 1), getOddBranch (*coefficientsDown, 1, true));
+    }
+
+    ~Oversampling2TimesEquirippleFIR() {}
+
+    //===============================================================================
+    SampleType getLatencyInSamples() override
+    {
+        return latency;
+    }
+
+private:
+    //===============================================================================
+    using Branch = typename Oversampling2TimesPolyphaseFIR<SampleType>::Branch;
+
+    /** The even phase of the filter is symmetric, so each coefficient is applied to
+        the sum of two inputs.
+    */
+    static Branch getEvenBranch (const FIR::Coefficients<SampleType>& coefficients, SampleType gain)
+    {
+        auto* fir = coefficients.getRawCoefficients();
+        auto halfOrder = coefficients.getFilterOrder() / 2;
+
+        Branch branch;
+        branch.isSymmetric = true;
+        branch.span = halfOrder;
+
+        for (size_t k = 0; k < halfOrder; k += 2)
+            branch.coefficients.add (fir[k] * gain);
+
+        return branch;
+    }
+
+    /** The odd phase of the filter is a pure delay, as all its coefficients are zero
+        apart from the middle one. For the downsampling, odd samples come one sample
+        later than the even ones, so they need one more sample of delay.
+    */
+    static Branch getOddBranch (const FIR::Coefficients<SampleType>& coefficients, SampleType gain, bool isDownsampling)
+    {
+        auto halfOrder = coefficients.getFilterOrder() / 2;
+
+        // The half-band design must have an odd number of coefficients in each half
+        jassert (halfOrder % 2 == 1);
+
+        Branch branch;
+        branch.delay = (isDownsampling ? halfOrder + 1 : halfOrder - 1) / 2;
+        branch.coefficients.add (coefficients.getRawCoefficients()[halfOrder] * gain);
+
+        return branch;
+    }
+
+    //===============================================================================
+    SampleType latency;
 
     //===============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
 };
 
 
+//===============================================================================
+/** Oversampling engine class performing 2 times oversampling using the minimum
+    phase version of the Filter Design FIR Equiripple filters. The magnitude
+    response is the same, but the latency is much lower, at the cost of a
+    non-linear phase, and of twice the number of operations since the resulting
+    filter isn't half-band anymore.
+*/
+template <typename SampleType>
+class Oversampling2TimesMinimumPhaseFIR : public Oversampling2TimesPolyphaseFIR<SampleType>
+{
+public:
+    //===============================================================================
+    Oversampling2TimesMinimumPhaseFIR (size_t numChannelsToUse,
+                                       SampleType normalizedTransitionWidthUp,
+                                       SampleType stopbandAttenuationdBUp,
+                                       SampleType normalizedTransitionWidthDown,
+                                       SampleType stopbandAttenuationdBDown) : Oversampling2TimesPolyphaseFIR<SampleType> (numChannelsToUse)
+    {
+        auto coefficientsUp = getMinimumPhaseCoefficients (*dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthUp, stopbandAttenuationdBUp));
+        auto coefficientsDown = getMinimumPhaseCoefficients (*dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalizedTransitionWidthDown, stopbandAttenuationdBDown));
+
+        latency = getGroupDelayAtDC (coefficientsUp) + getGroupDelayAtDC (coefficientsDown);
+
+        this->setBranches (getBranch (coefficientsUp, 0, 2, 0), getBranch (coefficientsUp, 1, 2, 0),
+                           getBranch (coefficientsDown, 0, 1, 0), getBranch (coefficientsDown, 1, 1, 1));
+    }
+
+    ~Oversampling2TimesMinimumPhaseFIR() {}
+
+    //===============================================================================
+    SampleType getLatencyInSamples() override
+    {
+        return latency;
+    }
+
+private:
+    //===============================================================================
+    using Branch = typename Oversampling2TimesPolyphaseFIR<SampleType>::Branch;
+
+    /** Returns the minimum phase filter with the same magnitude response as a given
+        filter, calculated with the real cepstrum.
+    */
+    static Array<SampleType> getMinimumPhaseCoefficients (const FIR::Coefficients<SampleType>& coefficients)
+    {
+        auto numCoefficients = static_cast<int> (coefficients.getFilterOrder() + 1);
+
+        // The FFT must be much longer than the filter to keep the aliasing of the
+        // cepstrum low
+        auto order = findHighestSetBit (static_cast<uint32> (numCoefficients)) + 6;
+        auto fftSize = 1 << order;
+
+        FFT fft (order);
+        HeapBlock<Complex<float>> input (fftSize, true), output (fftSize);
+
+        for (int i = 0; i < numCoefficients; ++i)
+            input[i] = static_cast<float> (coefficients.getRawCoefficients()[i]);
+
+        fft.perform (input, output, false);
+
+        // The zeros of the linear phase filter on the unit circle are kept finite
+        // in the log magnitude
+        auto magnitudeFloor = 1.0e-7f;
+
+        for (int i = 0; i < fftSize; ++i)
+            input[i] = std::log (jmax (std::abs (output[i]), magnitudeFloor));
+
+        fft.perform (input, output, true);
+
+        // Folding the cepstrum onto its causal part gives the minimum phase spectrum
+        for (int i = 0; i < fftSize; ++i)
+        {
+            auto isFolded = (i > 0 && i < fftSize / 2);
+            input[i] = (i > fftSize / 2 ? 0.0f : output[i].real() * (isFolded ? 2.0f : 1.0f));
+        }
+
+        fft.perform (input, output, false);
+
+        for (int i = 0; i < fftSize; ++i)
+            input[i] = std::exp (output[i]);
+
+        fft.perform (input, output, true);
+
+        Array<SampleType> result;
+
+        for (int i = 0; i < numCoefficients; ++i)
+            result.add (static_cast<SampleType> (output[i].real()));
+
+        return result;
+    }
+
+    static SampleType getGroupDelayAtDC (const Array<SampleType>& coefficients)
+    {
+        double sum = 0, weightedSum = 0;
+
+        for (int i = 0; i < coefficients.size(); ++i)
+        {
+            sum += static_cast<double> (coefficients.getUnchecked (i));
+            weightedSum += i * static_cast<double> (coefficients.getUnchecked (i));
+        }
+
+        return static_cast<SampleType> (weightedSum / sum);
+    }
+
+    /** Returns the coefficients of one of the two phases of the filter. */
+    static Branch getBranch (const Array<SampleType>& coefficients, int phase, SampleType gain, size_t delay)
+    {
+        Branch branch;
+        branch.delay = delay;
+
+        for (int i = phase; i < coefficients.size(); i += 2)
+            branch.coefficients.add (coefficients.getUnchecked (i) * gain);
+
+        return branch;
+    }
+
+    //===============================================================================
+    SampleType latency;
+
+    //===============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesMinimumPhaseFIR)
+};
+
+
 //===============================================================================
 /** Oversampling engine class performing 2 times oversampling using the Filter
     Design IIR Polyphase Allpass Cascaded method. The resulting filter is minimum
@@ -278,11 +614,11 @@ class Oversampling2TimesPolyphaseIIR : public OversamplingEngine<SampleType>
 {
 public:
     //===============================================================================
-    Oversampling2TimesPolyphaseIIR (size_t numChannels,
+    Oversampling2TimesPolyphaseIIR (size_t numChannelsToUse,
                                     SampleType normalizedTransitionWidthUp,
                                     SampleType stopbandAttenuationdBUp,
                                     SampleType normalizedTransitionWidthDown,
-                                    SampleType stopbandAttenuationdBDown) : OversamplingEngine<SampleType> (2, numChannels)
+                                    SampleType stopbandAttenuationdBDown) : OversamplingEngine<SampleType> (numChannelsToUse, 2)
     {
         auto structureUp = dsp::FilterDesign<SampleType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (normalizedTransitionWidthUp, stopbandAttenuationdBUp);
         dsp::IIR::Coefficients<SampleType> coeffsUp = getCoefficients (structureUp);
@@ -292,21 +628,22 @@ public:
         dsp::IIR::Coefficients<SampleType> coeffsDown = getCoefficients (structureDown);
         latency += static_cast<SampleType> (-(coeffsDown.getPhaseForFrequency (0.0001, 1.0)) / (0.0001 * 2 * double_Pi));
 
-        for (auto i = 0; i < structureUp.directPath.size(); i++)
-            coefficientsUp.add (structureUp.directPath[i].coefficients[0]);
-
-        for (auto i = 1; i < structureUp.delayedPath.size(); i++)
-            coefficientsUp.add (structureUp.delayedPath[i].coefficients[0]);
+        // each path is a cascade of first order allpass sections, y = (alpha + z^-1) / (1 + alpha z^-1),
+        // with the pure delay at the start of the delayed path left out
+        auto directSectionsUp    = getAllpassSections (structureUp.directPath, 0);
+        auto delayedSectionsUp   = getAllpassSections (structureUp.delayedPath, 1);
+        auto directSectionsDown  = getAllpassSections (structureDown.directPath, 0);
+        auto delayedSectionsDown = getAllpassSections (structureDown.delayedPath, 1);
 
-        for (auto i = 0; i < structureDown.directPath.size(); i++)
-            coefficientsDown.add (structureDown.directPath[i].coefficients[0]);
-
-        for (auto i = 1; i < structureDown.delayedPath.size(); i++)
-            coefficientsDown.add (structureDown.delayedPath[i].coefficients[0]);
+        for (size_t channel = 0; channel < numChannelsToUse; ++channel)
+        {
+            directPathUp   .add (new IIR::BlockFilter<SampleType> (directSectionsUp));
+            delayedPathUp  .add (new IIR::BlockFilter<SampleType> (delayedSectionsUp));
+            directPathDown .add (new IIR::BlockFilter<SampleType> (directSectionsDown));
+            delayedPathDown.add (new IIR::BlockFilter<SampleType> (delayedSectionsDown));
+        }
 
-        v1Up.setSize (static_cast<int> (numChannels), coefficientsUp.size());
-        v1Down.setSize (static_cast<int> (numChannels), coefficientsDown.size());
-        delayDown.resize (static_cast<int> (numChannels));
+        delayDown.resize (static_cast<int> (numChannelsToUse));
     }
 
     ~Oversampling2TimesPolyphaseIIR() {}
@@ -317,12 +654,20 @@ public:
         return latency;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        OversamplingEngine<SampleType>::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+        pathBuffer.setSize (2, static_cast<int> (maximumNumberOfSamplesBeforeOversampling), false, false, true);
+    }
+
     void reset() override
     {
         OversamplingEngine<SampleType>::reset();
 
-        v1Up.clear();
-        v1Down.clear();
+        for (auto* paths : { &directPathUp, &delayedPathUp, &directPathDown, &delayedPathDown })
+            for (auto* path : *paths)
+                path->reset();
+
         delayDown.fill (0);
     }
 
@@ -330,133 +675,68 @@ public:
     {
         jassert (inputBlock.getNumChannels() <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumChannels()));
         jassert (inputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
+        jassert (inputBlock.getNumSamples() <= static_cast<size_t> (pathBuffer.getNumSamples()));
 
         // Initialization
-        auto coeffs = coefficientsUp.getRawDataPointer();
-        auto numStages = coefficientsUp.size();
-        auto delayedStages = numStages / 2;
-        auto directStages = numStages - delayedStages;
         auto numSamples = inputBlock.getNumSamples();
+        auto directOut  = pathBuffer.getWritePointer (0);
+        auto delayedOut = pathBuffer.getWritePointer (1);
 
         // Processing
         for (size_t channel = 0; channel < inputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
             auto samples = inputBlock.getChannelPointer (channel);
 
+            // Direct and delayed path cascaded allpass filters
+            processPath (*directPathUp.getUnchecked  (static_cast<int> (channel)), samples, directOut,  numSamples);
+            processPath (*delayedPathUp.getUnchecked (static_cast<int> (channel)), samples, delayedOut, numSamples);
+
+            // Output
             for (size_t i = 0; i < numSamples; i++)
             {
-                // Direct path cascaded allpass filters
-                auto input = samples[i];
-                for (auto n = 0; n < directStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                bufferSamples[i << 1] = input;
-
-                // Delayed path cascaded allpass filters
-                input = samples[i];
-                for (auto n = directStages; n < numStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                bufferSamples[(i << 1) + 1] = input;
+                bufferSamples[i << 1]       = directOut[i];
+                bufferSamples[(i << 1) + 1] = delayedOut[i];
             }
         }
-
-        // Snap To Zero
-        snapToZero (true);
     }
 
     void processSamplesDown (dsp::AudioBlock<SampleType> &outputBlock) override
     {
         jassert (outputBlock.getNumChannels() <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumChannels()));
         jassert (outputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
+        jassert (outputBlock.getNumSamples() <= static_cast<size_t> (pathBuffer.getNumSamples()));
 
         // Initialization
-        auto coeffs = coefficientsDown.getRawDataPointer();
-        auto numStages = coefficientsDown.size();
-        auto delayedStages = numStages / 2;
-        auto directStages = numStages - delayedStages;
         auto numSamples = outputBlock.getNumSamples();
+        auto directOut  = pathBuffer.getWritePointer (0);
+        auto delayedOut = pathBuffer.getWritePointer (1);
 
         // Processing
         for (size_t channel = 0; channel < outputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
             auto delay = delayDown.getUnchecked (static_cast<int> (channel));
 
             for (size_t i = 0; i < numSamples; i++)
             {
-                // Direct path cascaded allpass filters
-                auto input = bufferSamples[i << 1];
-                for (auto n = 0; n < directStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-                auto directOut = input;
-
-                // Delayed path cascaded allpass filters
-                input = bufferSamples[(i << 1) + 1];
-                for (auto n = directStages; n < numStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
-                delay = input;
+                directOut[i]  = bufferSamples[i << 1];
+                delayedOut[i] = bufferSamples[(i << 1) + 1];
             }
 
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
-        }
-
-        // Snap To Zero
-        snapToZero (false);
-    }
+            // Direct and delayed path cascaded allpass filters
+            processPath (*directPathDown.getUnchecked  (static_cast<int> (channel)), directOut,  directOut,  numSamples);
+            processPath (*delayedPathDown.getUnchecked (static_cast<int> (channel)), delayedOut, delayedOut, numSamples);
 
-    void snapToZero (bool snapUpProcessing)
-    {
-        if (snapUpProcessing)
-        {
-            for (auto channel = 0; channel < OversamplingEngine<SampleType>::buffer.getNumChannels(); channel++)
+            // Output
+            for (size_t i = 0; i < numSamples; i++)
             {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
-
-                for (auto n = 0; n < numStages; n++)
-                    util::snapToZero (lv1[n]);
+                samples[i] = (delay + directOut[i]) * static_cast<SampleType> (0.5);
+                delay = delayedOut[i];
             }
-        }
-        else
-        {
-            for (auto channel = 0; channel < OversamplingEngine<SampleType>::buffer.getNumChannels(); channel++)
-            {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
 
-                for (auto n = 0; n < numStages; n++)
-                    util::snapToZero (lv1[n]);
-            }
+            delayDown.setUnchecked (static_cast<int> (channel), delay);
         }
     }
 
@@ -537,11 +817,31 @@ private:
         return coeffs;
     }
 
+    /** Converts one path of the polyphase structure into first order allpass sections. */
+    static Array<IIR::Coefficients<SampleType>> getAllpassSections (const Array<IIR::Coefficients<SampleType>>& path, int firstSection)
+    {
+        Array<IIR::Coefficients<SampleType>> sections;
+
+        for (auto i = firstSection; i < path.size(); i++)
+        {
+            auto alpha = path.getReference (i).coefficients[0];
+            sections.add (IIR::Coefficients<SampleType> (alpha, 1, 1, alpha));
+        }
+
+        return sections;
+    }
+
+    static void processPath (IIR::BlockFilter<SampleType>& path, SampleType* input, SampleType* output, size_t numSamples) noexcept
+    {
+        dsp::AudioBlock<SampleType> inputBlock (&input, 1, numSamples), outputBlock (&output, 1, numSamples);
+        path.process (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock));
+    }
+
     //===============================================================================
-    Array<SampleType> coefficientsUp, coefficientsDown;
     SampleType latency;
 
-    AudioBuffer<SampleType> v1Up, v1Down;
+    OwnedArray<IIR::BlockFilter<SampleType>> directPathUp, delayedPathUp, directPathDown, delayedPathDown;
+    AudioBuffer<SampleType> pathBuffer;
     Array<SampleType> delayDown;
 
     //===============================================================================
@@ -603,6 +903,25 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                                                           twDown, gaindBStartDown + gaindBFactorDown * n));
         }
     }
+    else if (type == FilterType::filterHalfBandFIRMinimumPhase)
+    {
+        numStages = newFactor;
+
+        for (size_t n = 0; n < numStages; n++)
+        {
+            auto twUp = (isMaximumQuality ? 0.10f : 0.12f) * (n == 0 ? 0.5f : 1.f);
+            auto twDown = (isMaximumQuality ? 0.12f : 0.15f) * (n == 0 ? 0.5f : 1.f);
+
+            auto gaindBStartUp = (isMaximumQuality ? -90.f : -70.f);
+            auto gaindBStartDown = (isMaximumQuality ? -70.f : -60.f);
+            auto gaindBFactorUp = (isMaximumQuality ? 10.f : 8.f);
+            auto gaindBFactorDown = (isMaximumQuality ? 10.f : 8.f);
+
+            engines.add (new Oversampling2TimesMinimumPhaseFIR<SampleType> (numChannels,
+                                                                            twUp, gaindBStartUp + gaindBFactorUp * n,
+                                                                            twDown, gaindBStartDown + gaindBFactorDown * n));
+        }
+    }
 }
 
 template <typename SampleType>
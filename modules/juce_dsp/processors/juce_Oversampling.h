@@ -50,7 +50,13 @@ class OversamplingEngine;
     Choose between FIR or IIR filtering depending on your needs in term of
     latency and phase distortion. With FIR filters, the phase is linear but the
     latency is maximum. With IIR filtering, the phase is compromised around the
-    Nyquist frequency but the phase is minimum.
+    Nyquist frequency but the phase is minimum. The minimum phase FIR filters
+    have the same magnitude response as the linear phase ones with a much lower
+    latency, but they need twice as many operations.
+
+    All the filters are processed with polyphase structures, running at the lower
+    sample rate of each stage, and the FIR filters process the channels by groups
+    using SIMD instructions.
 
     @see FilterDesign.
 */
@@ -63,6 +69,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterHalfBandFIRMinimumPhase,
         numFilterTypes
     };
 
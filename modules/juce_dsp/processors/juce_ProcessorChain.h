@@ -46,22 +46,206 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
         static auto& get (ProcessorType& a) noexcept    { return a.getProcessor(); }
     };
 
+    template <int arg>
+    struct ChainGetterHelper
+    {
+        template <typename ChainType>
+        static auto& get (ChainType& a) noexcept        { return ChainGetterHelper<arg - 1>::get (a.processors); }
+    };
+
+    template <>
+    struct ChainGetterHelper<0>
+    {
+        template <typename ChainType>
+        static auto& get (ChainType& a) noexcept        { return a; }
+    };
+
+    //==============================================================================
+    /** True if the processor has a per-sample kernel for the given sample type and
+        number of channels, i.e. a nested FrameKernel<numChannels> class which can be
+        constructed from a reference to the processor, and which has a method
+        processFrame (SampleType* frame) that processes one sample of each channel.
+    */
+    template <typename Processor, typename SampleType, size_t numChannels>
+    struct HasFrameKernel
+    {
+        template <typename P>
+        static auto test (int) -> decltype (typename P::template FrameKernel<numChannels> (std::declval<P&>())
+                                                .processFrame (std::declval<SampleType*>()), std::true_type());
+
+        template <typename>
+        static std::false_type test (...);
+
+        static constexpr bool value = decltype (test<Processor> (0))::value;
+    };
+
+    /** The number of processors at the start of a chain which have a per-sample kernel. */
+    template <typename SampleType, size_t numChannels, typename... Processors>
+    struct NumFusable  : public std::integral_constant<size_t, 0> {};
+
+    template <typename SampleType, size_t numChannels, typename First, typename... Rest>
+    struct NumFusable<SampleType, numChannels, First, Rest...>
+        : public std::integral_constant<size_t, HasFrameKernel<First, SampleType, numChannels>::value
+                                                    ? 1 + NumFusable<SampleType, numChannels, Rest...>::value : 0> {};
+
+    /** Holds the kernels of the first numFused processors of a chain, so that their
+        state lives in local variables while the fused loop runs. Each kernel writes its
+        state back to its processor when it is destroyed.
+    */
+    template <size_t numChannels, size_t numFused, typename ChainType>
+    struct FusedKernels
+    {
+        FusedKernels (ChainType& chain) noexcept  : kernel (chain.getProcessor()), next (chain.processors) {}
+
+        template <typename SampleType>
+        void processFrame (SampleType* frame) noexcept
+        {
+            kernel.processFrame (frame);
+            next.processFrame (frame);
+        }
+
+        typename ChainType::ProcessorType::template FrameKernel<numChannels> kernel;
+        FusedKernels<numChannels, numFused - 1, typename std::remove_reference<decltype (std::declval<ChainType&>().processors)>::type> next;
+    };
+
+    template <size_t numChannels, typename ChainType>
+    struct FusedKernels<numChannels, 1, ChainType>
+    {
+        FusedKernels (ChainType& chain) noexcept  : kernel (chain.getProcessor()) {}
+
+        template <typename SampleType>
+        void processFrame (SampleType* frame) noexcept    { kernel.processFrame (frame); }
+
+        typename ChainType::ProcessorType::template FrameKernel<numChannels> kernel;
+    };
+
+    //==============================================================================
     template <typename Processor, typename Subclass>
     struct ChainBase
     {
+        using ProcessorType = Processor;
+
         Processor processor;
 
         Processor& getProcessor() noexcept       { return processor; }
         Subclass& getThis() noexcept             { return *static_cast<Subclass*> (this); }
 
         template <int arg> auto& get() noexcept  { return GetterHelper<arg>::get (getThis()); }
+
+        /** Processes the context, running the first processors as a single per-sample
+            loop if they have per-sample kernels. If fixedBlockSize is not zero, that loop
+            is split into chunks of that many samples, each with a constant trip count.
+        */
+        template <size_t fixedBlockSize, typename ProcessContext>
+        void processChain (const ProcessContext& context) noexcept
+        {
+            auto numChannels = context.getOutputBlock().getNumChannels();
+
+            if (! context.isBypassed)
+            {
+                if (numChannels == 1)  return processFused<fixedBlockSize, 1> (context);
+                if (numChannels == 2)  return processFused<fixedBlockSize, 2> (context);
+            }
+
+            getThis().template processUnfused<fixedBlockSize> (context);
+        }
+
+    private:
+        template <size_t fixedBlockSize, size_t numChannels, typename ProcessContext>
+        void processFused (const ProcessContext& context) noexcept
+        {
+            using SampleType = typename ProcessContext::SampleType;
+
+            processFused<fixedBlockSize, numChannels> (context, std::integral_constant<size_t, Subclass::template getNumFusable<SampleType, numChannels>()>());
+        }
+
+        template <size_t fixedBlockSize, size_t numChannels, typename ProcessContext>
+        void processFused (const ProcessContext& context, std::integral_constant<size_t, 0>) noexcept
+        {
+            getThis().template processUnfused<fixedBlockSize> (context);
+        }
+
+        template <size_t fixedBlockSize, size_t numChannels, typename ProcessContext, size_t numFused>
+        void processFused (const ProcessContext& context, std::integral_constant<size_t, numFused>) noexcept
+        {
+            using SampleType = typename ProcessContext::SampleType;
+
+            auto&& inputBlock  = context.getInputBlock();
+            auto&& outputBlock = context.getOutputBlock();
+
+            jassert (inputBlock.getNumChannels() == numChannels);
+            jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+            const SampleType* inputs[numChannels];
+            SampleType* outputs[numChannels];
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                inputs[ch]  = inputBlock.getChannelPointer (ch);
+                outputs[ch] = outputBlock.getChannelPointer (ch);
+            }
+
+            auto numSamples = outputBlock.getNumSamples();
+            size_t start = 0;
+
+            if (fixedBlockSize > 0)
+                for (; start + fixedBlockSize <= numSamples; start += fixedBlockSize)
+                    processFrames<numChannels, numFused, fixedBlockSize> (inputs, outputs, start, fixedBlockSize);
+
+            if (start < numSamples)
+                processFrames<numChannels, numFused, 0> (inputs, outputs, start, numSamples - start);
+
+            ProcessContextReplacing<SampleType> remaining (outputBlock);
+            processRemaining<fixedBlockSize, numFused> (remaining, std::integral_constant<bool, (numFused < Subclass::numProcessors)>());
+        }
+
+        template <size_t fixedBlockSize, size_t numFused, typename ProcessContext>
+        void processRemaining (const ProcessContext& context, std::true_type) noexcept
+        {
+            // the processors which follow the fused ones take their input from the output block
+            ChainGetterHelper<numFused>::get (getThis()).template processChain<fixedBlockSize> (context);
+        }
+
+        template <size_t fixedBlockSize, size_t numFused, typename ProcessContext>
+        void processRemaining (const ProcessContext&, std::false_type) noexcept {}
+
+        template <size_t numChannels, size_t numFused, size_t fixedNumSamples, typename SampleType>
+        void processFrames (const SampleType* const* inputs, SampleType* const* outputs,
+                            size_t start, size_t numSamples) noexcept
+        {
+            if (fixedNumSamples > 0)
+                numSamples = fixedNumSamples;
+
+            // the kernels are local to this function, so that the compiler can keep
+            // their state in registers even if it doesn't inline it
+            FusedKernels<numChannels, numFused, Subclass> kernels (getThis());
+
+            for (size_t i = start; i < start + numSamples; ++i)
+            {
+                SampleType frame[numChannels];
+
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    frame[ch] = inputs[ch][i];
+
+                kernels.processFrame (frame);
+
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    outputs[ch][i] = frame[ch];
+            }
+        }
     };
 
+    //==============================================================================
     template <typename FirstProcessor, typename... SubsequentProcessors>
     struct Chain  : public ChainBase<FirstProcessor, Chain<FirstProcessor, SubsequentProcessors...>>
     {
         using Base = ChainBase<FirstProcessor, Chain<FirstProcessor, SubsequentProcessors...>>;
 
+        static constexpr size_t numProcessors = 1 + sizeof... (SubsequentProcessors);
+
+        template <typename SampleType, size_t numChannels>
+        static constexpr size_t getNumFusable() noexcept   { return NumFusable<SampleType, numChannels, FirstProcessor, SubsequentProcessors...>::value; }
+
         void prepare (const ProcessSpec& spec)
         {
             Base::processor.prepare (spec);
@@ -69,10 +253,33 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
         }
 
         template <typename ProcessContext>
-        void process (ProcessContext& context) noexcept
+        void process (const ProcessContext& context) noexcept
+        {
+            Base::template processChain<0> (context);
+        }
+
+        template <size_t fixedBlockSize, typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            Base::template processChain<fixedBlockSize> (context);
+        }
+
+        template <size_t fixedBlockSize, typename ProcessContext>
+        void processUnfused (const ProcessContext& context) noexcept
         {
             Base::processor.process (context);
-            processors.process (context);
+
+            if (context.usesSeparateInputAndOutputBlocks())
+            {
+                // the next processors must take their input from what this one has written
+                ProcessContextReplacing<typename ProcessContext::SampleType> next (context.getOutputBlock());
+                next.isBypassed = context.isBypassed;
+                processors.template processChain<fixedBlockSize> (next);
+            }
+            else
+            {
+                processors.template processChain<fixedBlockSize> (context);
+            }
         }
 
         void reset()
@@ -89,8 +296,25 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
     {
         using Base = ChainBase<ProcessorType, Chain<ProcessorType>>;
 
+        static constexpr size_t numProcessors = 1;
+
+        template <typename SampleType, size_t numChannels>
+        static constexpr size_t getNumFusable() noexcept   { return NumFusable<SampleType, numChannels, ProcessorType>::value; }
+
         template <typename ProcessContext>
-        void process (ProcessContext& context) noexcept
+        void process (const ProcessContext& context) noexcept
+        {
+            Base::template processChain<0> (context);
+        }
+
+        template <size_t fixedBlockSize, typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            Base::template processChain<fixedBlockSize> (context);
+        }
+
+        template <size_t fixedBlockSize, typename ProcessContext>
+        void processUnfused (const ProcessContext& context) noexcept
         {
             Base::processor.process (context);
         }
@@ -113,6 +337,33 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
 /**
     This variadically-templated class lets you join together any number of processor
     classes into a single processor which will call process() on them all in sequence.
+
+    Processors which have a per-sample kernel are fused together. A kernel is a nested
+    class which copies the state of the processor when it is constructed, processes one
+    sample of each channel at a time, and writes the state back when it is destroyed:
+
+    @code
+    template <size_t numChannels>
+    struct FrameKernel
+    {
+        FrameKernel (MyProcessor& processorToUse) noexcept;
+        ~FrameKernel() noexcept;
+
+        template <typename SampleType>
+        void processFrame (SampleType* frame) noexcept;
+    };
+    @endcode
+
+    When a mono or stereo chain starts with such processors, it runs all of their kernels
+    in a single loop over the samples, so that each sample passes through the whole
+    sequence while it and the processors' state stay in registers, rather than the block
+    being read and written once for each processor. Gain, Bias, WaveShaper, IIR::Filter
+    and a ProcessorDuplicator of IIR filters all have per-sample kernels. The remaining
+    processors are then called one after the other on the output block.
+
+    If the block size is known at compile time, you can call process<blockSize> (context)
+    instead of process (context), which makes the fused loop work in chunks with a
+    constant number of samples, which the compiler can unroll.
 */
 template <typename... Processors>
 using ProcessorChain = ProcessorHelpers::Chain<Processors...>;
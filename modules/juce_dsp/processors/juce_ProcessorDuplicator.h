@@ -74,6 +74,40 @@ struct ProcessorDuplicator
             processors[(int) chan]->process (MonoProcessContext<ProcessContext> (context, chan));
     }
 
+    /** A per-sample kernel, which runs the kernels of the mono processors side by side
+        so that a ProcessorChain can fuse the duplicator with the processors around it.
+        This is only usable if the mono processor has a kernel itself.
+    */
+    template <size_t numChannels, typename MonoProcessor = MonoProcessorType, typename = void>
+    struct FrameKernel
+    {
+        FrameKernel (ProcessorDuplicator&) noexcept {}
+    };
+
+    template <size_t numChannels, typename MonoProcessor>
+    struct FrameKernel<numChannels, MonoProcessor,
+                       typename std::enable_if<std::is_class<typename MonoProcessor::template FrameKernel<1>>::value>::type>
+    {
+        using MonoKernel = typename MonoProcessor::template FrameKernel<1>;
+
+        FrameKernel (ProcessorDuplicator& d) noexcept  : FrameKernel (d, std::make_index_sequence<numChannels>()) {}
+
+        template <typename SampleType>
+        auto processFrame (SampleType* frame) noexcept -> decltype (std::declval<MonoKernel&>().processFrame (frame))
+        {
+            for (size_t chan = 0; chan < numChannels; ++chan)
+                kernels[chan].processFrame (frame + chan);
+        }
+
+    private:
+        template <size_t... channels>
+        FrameKernel (ProcessorDuplicator& d, std::index_sequence<channels...>) noexcept
+            : kernels { { *d.processors.getUnchecked ((int) channels) }... }
+        {}
+
+        MonoKernel kernels[numChannels];
+    };
+
     typename StateType::Ptr state;
 
 private:
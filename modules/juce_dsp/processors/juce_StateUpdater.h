@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Passes new processor states (such as a set of IIR::Coefficients) from another
+    thread to the audio thread, without the audio thread ever having to lock, allocate
+    or delete anything.
+
+    A non-realtime thread creates the new state and hands it over with post(). Then at
+    the start of each block the audio thread calls update(), which copies the most recent
+    state that was posted into the one the processor is using. The objects that have been
+    posted are released later, on the posting thread, once the audio thread has finished
+    with them. If several states are posted before the audio thread gets round to calling
+    update(), only the last one is used.
+
+    Because the new values are copied into the processor's existing state object, this
+    works both for a single IIR::Filter and for the state that a ProcessorDuplicator
+    shares between all of its channels:
+    @code
+    // on the message thread
+    updater.post (IIR::Coefficients<float>::makeLowPass (sampleRate, cutoff));
+
+    // on the audio thread
+    updater.update (*filter.coefficients);      // or *duplicator.state
+    filter.process (context);
+    @endcode
+
+    The StateType's copy-assignment operator is what gets called on the audio thread, so
+    it mustn't allocate - IIR::Coefficients only allocates if the order of the filter has
+    grown. If you're changing the coefficients on the audio thread itself, there's no
+    need for this class: just assign one of the IIR::ArrayCoefficients arrays to them.
+
+    @see IIR::Coefficients, IIR::ArrayCoefficients, ProcessorDuplicator
+*/
+template <typename StateType>
+class StateUpdater
+{
+public:
+    //==============================================================================
+    /** Creates an updater with nothing posted. */
+    StateUpdater() = default;
+
+    /** Destructor. */
+    ~StateUpdater() = default;
+
+    //==============================================================================
+    /** Hands a new state over to the audio thread, replacing any that was posted
+        earlier but hasn't been picked up yet.
+
+        This can be called from any thread except the audio thread, and also releases
+        any states that the audio thread has finished with.
+    */
+    void post (typename StateType::Ptr newState)
+    {
+        jassert (newState != nullptr);
+
+        const ScopedLock sl (lock);
+        auto* update = posted.add (new Update { newState, ++lastSerial });
+
+        // a state that was replaced before the audio thread took it can be released straight away
+        if (auto* replaced = pending.exchange (update))
+            posted.removeObject (replaced);
+
+        releaseFinishedStates();
+    }
+
+    /** If a new state has been posted, this copies it into the target and returns true.
+        This is lock-free and never allocates or deletes anything, so it's intended to be
+        called by the audio thread.
+    */
+    bool update (StateType& target) noexcept
+    {
+        if (auto* update = pending.exchange (nullptr))
+        {
+            target = *update->state;
+            lastSerialUsed = update->serial;
+            return true;
+        }
+
+        return false;
+    }
+
+    /** Returns true if a state has been posted that update() hasn't picked up yet. */
+    bool isUpdatePending() const noexcept       { return pending.load() != nullptr; }
+
+    /** Releases any states that the audio thread has finished with.
+        post() does this anyway, but you might want to call it from a timer if you
+        post large states infrequently.
+    */
+    void releaseFinishedStates()
+    {
+        const ScopedLock sl (lock);
+        auto lastUsed = lastSerialUsed.load();
+
+        for (int i = posted.size(); --i >= 0;)
+            if (posted.getUnchecked (i)->serial <= lastUsed)
+                posted.remove (i);
+    }
+
+private:
+    //==============================================================================
+    struct Update
+    {
+        typename StateType::Ptr state;
+        uint32 serial;
+    };
+
+    // The audio thread may still be copying from an update after taking it, so the updates
+    // are only released once their serial number shows that it has moved on.
+    OwnedArray<Update> posted;
+    std::atomic<Update*> pending { nullptr };
+    std::atomic<uint32> lastSerialUsed { 0 };
+    uint32 lastSerial = 0;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (StateUpdater)
+};
+
+} // namespace dsp
+} // namespace juce
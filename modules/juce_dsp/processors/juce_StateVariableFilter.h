@@ -208,6 +208,223 @@ namespace StateVariableFilter
         NumericType R2  = static_cast<NumericType> (std::sqrt (2.0));
         NumericType h   = static_cast<NumericType> (1.0 / (1.0 + R2 * g + g * g));
     };
+
+    //==============================================================================
+    /**
+        A state variable filter with the same TPT structure as Filter, whose cutoff
+        frequency can be changed for every sample.
+
+        Rather than sharing a set of coefficients, it works out its own coefficients
+        for each sample from an array of cutoff frequencies, using a fast approximation
+        of tan() which is accurate to better than 1e-7 over the range that's used, so
+        that it can follow envelopes and LFOs at audio rate.
+
+        The SampleType can be a SIMDRegister, in which case each lane is a separate
+        filter, with its own cutoff frequency and resonance. For example, a synth with
+        many voices can keep one ModulatedFilter<SIMDRegister<float>> for each group
+        of voices, with one voice per lane, and filter them all at once:
+
+        @code
+        // the input of each voice in its lane, and its cutoff for every sample
+        filters[group].process (voiceSamples, voiceSamples, voiceCutoffs, numSamples);
+        @endcode
+
+        @see Filter
+    */
+    template <typename SampleType>
+    class ModulatedFilter
+    {
+    public:
+        //==============================================================================
+        /** The NumericType is the underlying primitive type used by the SampleType (which
+            could be either a primitive or vector)
+        */
+        using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
+
+        /** The type of filter response. */
+        using Type = typename Parameters<NumericType>::Type;
+
+        //==============================================================================
+        /** Creates a low-pass filter with a cutoff of 1000 Hz and a resonance of 1 / sqrt (2). */
+        ModulatedFilter() noexcept
+        {
+            // (these are assigned rather than initialised, so that a SIMDRegister
+            // gets the value in all its lanes)
+            R2 = static_cast<NumericType> (std::sqrt (2.0));
+            cutoff = static_cast<NumericType> (1000);
+            reset();
+        }
+
+        //==============================================================================
+        /** Sets the type of the filter. */
+        void setType (Type newType) noexcept            { type = newType; }
+
+        /** Returns the type of the filter. */
+        Type getType() const noexcept                   { return type; }
+
+        /** Sets the resonance of the filter, which may be different in each lane.
+            As with Filter, the value must be 1 / sqrt (2) for a standard 12 dB/octave filter.
+        */
+        void setResonance (SampleType newResonance) noexcept
+        {
+            R2 = static_cast<NumericType> (1) / newResonance;
+        }
+
+        /** Sets the cutoff frequency in Hz which is used by process (const ProcessContext&). */
+        void setCutoffFrequency (SampleType newFrequency) noexcept     { cutoff = newFrequency; }
+
+        //==============================================================================
+        /** Initialization of the filter */
+        void prepare (const ProcessSpec& spec) noexcept
+        {
+            jassert (spec.sampleRate > 0);
+            sampleRate = spec.sampleRate;
+            reset();
+        }
+
+        /** Resets the filter's processing pipeline. */
+        void reset() noexcept                           { s1 = s2 = SampleType {0}; }
+
+        /** Ensure that the state variables are rounded to zero if the state
+            variables are denormals. This is only needed if you are doing
+            sample by sample processing.
+        */
+        void snapToZero() noexcept                      { util::snapToZero (s1); util::snapToZero (s2); }
+
+        //==============================================================================
+        /** Processes a mono block with the cutoff frequency that was given to
+            setCutoffFrequency(). The coefficients only need to be worked out once for
+            the whole block.
+        */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                           "The sample-type of the filter must match the sample-type supplied to this process callback");
+
+            auto&& inputBlock  = context.getInputBlock();
+            auto&& outputBlock = context.getOutputBlock();
+
+            // This class can only process mono signals. Use the ProcessorDuplicator class
+            // to apply this filter on a multi-channel audio stream.
+            jassert (inputBlock.getNumChannels()  == 1);
+            jassert (outputBlock.getNumChannels() == 1);
+
+            auto n = inputBlock.getNumSamples();
+            auto* src = inputBlock .getChannelPointer (0);
+            auto* dst = outputBlock.getChannelPointer (0);
+            auto g = getG (cutoff);
+            auto h = static_cast<NumericType> (1) / (static_cast<NumericType> (1) + R2 * g + g * g);
+
+            switch (type)
+            {
+                case Type::lowPass:  for (size_t i = 0; i < n; ++i) dst[i] = processLoop<Type::lowPass>  (src[i], g, h); break;
+                case Type::bandPass: for (size_t i = 0; i < n; ++i) dst[i] = processLoop<Type::bandPass> (src[i], g, h); break;
+                case Type::highPass: for (size_t i = 0; i < n; ++i) dst[i] = processLoop<Type::highPass> (src[i], g, h); break;
+                default: jassertfalse;
+            }
+
+            snapToZero();
+        }
+
+        /** Processes a block of samples, with a cutoff frequency in Hz for each sample.
+            The input and output may be the same array. The cutoffs are clipped to the
+            range 0 to 0.49 times the sample rate.
+        */
+        void process (const SampleType* input, SampleType* output,
+                      const SampleType* cutoffFrequencies, size_t numSamples) noexcept
+        {
+            switch (type)
+            {
+                case Type::lowPass:  processModulated<Type::lowPass>  (input, output, cutoffFrequencies, numSamples); break;
+                case Type::bandPass: processModulated<Type::bandPass> (input, output, cutoffFrequencies, numSamples); break;
+                case Type::highPass: processModulated<Type::highPass> (input, output, cutoffFrequencies, numSamples); break;
+                default: jassertfalse;
+            }
+
+            snapToZero();
+        }
+
+        /** Processes a single sample with a cutoff frequency in Hz. */
+        SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample, SampleType cutoffFrequency) noexcept
+        {
+            auto g = getG (cutoffFrequency);
+            auto h = static_cast<NumericType> (1) / (static_cast<NumericType> (1) + R2 * g + g * g);
+
+            switch (type)
+            {
+                case Type::lowPass:  return processLoop<Type::lowPass>  (sample, g, h);
+                case Type::bandPass: return processLoop<Type::bandPass> (sample, g, h);
+                case Type::highPass: return processLoop<Type::highPass> (sample, g, h);
+                default: jassertfalse;
+            }
+
+            return SampleType {0};
+        }
+
+    private:
+        //==============================================================================
+        static NumericType limit (NumericType value, NumericType lower, NumericType upper) noexcept
+        {
+            return jlimit (lower, upper, value);
+        }
+
+       #if JUCE_USE_SIMD
+        template <typename ElementType>
+        static SIMDRegister<ElementType> JUCE_VECTOR_CALLTYPE limit (SIMDRegister<ElementType> value, ElementType lower, ElementType upper) noexcept
+        {
+            return SIMDRegister<ElementType>::min (SIMDRegister<ElementType>::max (value, SIMDRegister<ElementType>::expand (lower)),
+                                                   SIMDRegister<ElementType>::expand (upper));
+        }
+       #endif
+
+        SampleType JUCE_VECTOR_CALLTYPE getG (SampleType frequency) const noexcept
+        {
+            auto normalised = limit (frequency * static_cast<NumericType> (1.0 / sampleRate),
+                                     static_cast<NumericType> (0), static_cast<NumericType> (0.49));
+
+            return FastMathApproximations::tan (normalised * static_cast<NumericType> (double_Pi));
+        }
+
+        template <Type responseType>
+        SampleType JUCE_VECTOR_CALLTYPE processLoop (SampleType sample, SampleType g, SampleType h) noexcept
+        {
+            auto yHP = (sample - s1 * R2 - s1 * g - s2) * h;
+
+            auto yBP = yHP * g + s1;
+            s1       = yHP * g + yBP;
+
+            auto yLP = yBP * g + s2;
+            s2       = yBP * g + yLP;
+
+            return responseType == Type::lowPass  ? yLP
+                 : responseType == Type::bandPass ? yBP
+                                                  : yHP;
+        }
+
+        template <Type responseType>
+        void processModulated (const SampleType* input, SampleType* output,
+                               const SampleType* cutoffFrequencies, size_t numSamples) noexcept
+        {
+            auto one = static_cast<NumericType> (1);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto g = getG (cutoffFrequencies[i]);
+                auto h = one / (one + R2 * g + g * g);
+
+                output[i] = processLoop<responseType> (input[i], g, h);
+            }
+        }
+
+        //==============================================================================
+        Type type = Type::lowPass;
+        SampleType s1, s2, R2, cutoff;
+        double sampleRate = 44100.0;
+
+        //==============================================================================
+        JUCE_LEAK_DETECTOR (ModulatedFilter)
+    };
 }
 
 } // namespace dsp
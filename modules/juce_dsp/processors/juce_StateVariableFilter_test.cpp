@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class StateVariableFilterTest : public UnitTest
+{
+    void runStaticCutoffTest()
+    {
+        // with a fixed cutoff, the modulated filter should match the ordinary one
+        constexpr size_t n = 2048;
+        HeapBlock<float> input (n), expected (n), output (n), cutoffs (n);
+        Random r (42);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            input[i] = r.nextFloat() * 2.0f - 1.0f;
+            cutoffs[i] = 3000.0f;
+        }
+
+        for (auto type : { StateVariableFilter::Parameters<float>::Type::lowPass,
+                           StateVariableFilter::Parameters<float>::Type::bandPass,
+                           StateVariableFilter::Parameters<float>::Type::highPass })
+        {
+            StateVariableFilter::Filter<float> filter;
+            filter.parameters->type = type;
+            filter.parameters->setCutOffFrequency (48000.0, 3000.0f, 2.0f);
+
+            for (size_t i = 0; i < n; ++i)
+                expected[i] = filter.processSample (input[i]);
+
+            StateVariableFilter::ModulatedFilter<float> modulated;
+            modulated.prepare ({ 48000.0, (uint32) n, 1 });
+            modulated.setType (type);
+            modulated.setResonance (2.0f);
+            modulated.process (input, output, cutoffs, n);
+
+            float maxDifference = 0;
+
+            for (size_t i = 0; i < n; ++i)
+                maxDifference = jmax (maxDifference, std::abs (output[i] - expected[i]));
+
+            expect (maxDifference < 1.0e-4f);
+        }
+    }
+
+   #if JUCE_USE_SIMD
+    void runLanesTest()
+    {
+        // each lane of a SIMD filter should behave like a separate scalar filter
+        using Vector = SIMDRegister<float>;
+        constexpr size_t n = 1000;
+
+        HeapBlock<char> memory ((n * 2 + 1) * sizeof (Vector));
+        auto* samples = snapPointerToAlignment (reinterpret_cast<Vector*> (memory.getData()), sizeof (Vector));
+        auto* cutoffs = samples + n;
+
+        HeapBlock<float> laneInput (n), laneCutoffs (n), laneOutput (n);
+        Random r (7);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t lane = 0; lane < Vector::size(); ++lane)
+            {
+                samples[i][lane] = r.nextFloat() * 2.0f - 1.0f;
+
+                // a different sweep in each lane, going up to the top of the range
+                cutoffs[i][lane] = 50.0f + 30000.0f * (float) ((i * (lane + 1)) % n) / (float) n;
+            }
+        }
+
+        HeapBlock<Vector> input (n);
+
+        for (size_t i = 0; i < n; ++i)
+            input[i] = samples[i];
+
+        StateVariableFilter::ModulatedFilter<Vector> filter;
+        filter.prepare ({ 44100.0, (uint32) n, 1 });
+        filter.setType (StateVariableFilter::Parameters<float>::Type::bandPass);
+        filter.process (samples, samples, cutoffs, n);
+
+        for (size_t lane = 0; lane < Vector::size(); ++lane)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                laneInput[i] = input[i][lane];
+                laneCutoffs[i] = cutoffs[i][lane];
+            }
+
+            StateVariableFilter::ModulatedFilter<float> scalar;
+            scalar.prepare ({ 44100.0, (uint32) n, 1 });
+            scalar.setType (StateVariableFilter::Parameters<float>::Type::bandPass);
+            scalar.process (laneInput, laneOutput, laneCutoffs, n);
+
+            float maxDifference = 0;
+
+            for (size_t i = 0; i < n; ++i)
+                maxDifference = jmax (maxDifference, std::abs (laneOutput[i] - samples[i][lane]));
+
+            expect (maxDifference < 1.0e-5f);
+        }
+    }
+   #endif
+
+public:
+    StateVariableFilterTest() : UnitTest ("State Variable Filter") {}
+
+    void runTest() override
+    {
+        beginTest ("Fixed cutoff");
+        runStaticCutoffTest();
+
+       #if JUCE_USE_SIMD
+        beginTest ("SIMD lanes");
+        runLanesTest();
+       #endif
+    }
+};
+
+static StateVariableFilterTest stateVariableFilterTest;
+
+} // namespace dsp
+} // namespace juce
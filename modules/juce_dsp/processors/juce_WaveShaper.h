@@ -29,8 +29,52 @@ namespace juce
 namespace dsp
 {
 
+/**
+    Wraps a function object which can be called with SIMDRegisters as well as with
+    single samples, like a generic lambda using the functions in FastMathApproximations,
+    or a LookupTableTransform. A WaveShaper using one processes whole blocks with SIMD.
+
+    Example:
+
+        struct FastTanh
+        {
+            template <typename Type>
+            Type operator() (Type x) const noexcept   { return FastMathApproximations::tanh (x); }
+        };
+
+        WaveShaper<float, VectorisedFunction<FastTanh>> waveShaper;
+
+    @see WaveShaper
+*/
+template <typename Function>
+struct VectorisedFunction
+{
+    Function function;
+
+    template <typename SampleType>
+    SampleType JUCE_VECTOR_CALLTYPE operator() (SampleType inputSample) const noexcept
+    {
+        return function (inputSample);
+    }
+};
+
+#ifndef DOXYGEN
+namespace WaveShaperHelpers
+{
+    template <typename Function>
+    struct IsVectorised                                 : std::false_type {};
+
+    template <typename Function>
+    struct IsVectorised<VectorisedFunction<Function>>  : std::true_type {};
+}
+#endif
+
+//==============================================================================
 /**
     Applies waveshaping to audio samples as single samples or AudioBlocks.
+
+    If the function is wrapped in a VectorisedFunction, the blocks are processed
+    with SIMD. Otherwise, it's called for every sample.
 */
 template <typename FloatType, typename Function = FloatType (*) (FloatType)>
 struct WaveShaper
@@ -49,6 +93,28 @@ struct WaveShaper
         return functionToUse (inputSample);
     }
 
+    /** A per-sample kernel, which lets a ProcessorChain fuse the waveshaper with
+        the processors around it. This is only usable with a functor or a lambda, as
+        calling a function pointer for every sample would stop the other kernels in
+        the chain from keeping their state in registers. A VectorisedFunction isn't
+        fused either, as it's faster to process the whole block with SIMD.
+    */
+    template <size_t numChannels>
+    struct FrameKernel
+    {
+        FrameKernel (const WaveShaper& w) noexcept  : function (w.functionToUse) {}
+
+        template <typename SampleType, typename FunctionType = Function>
+        auto processFrame (SampleType* frame) const noexcept -> typename std::enable_if<! (std::is_pointer<FunctionType>::value
+                                                                                        || WaveShaperHelpers::IsVectorised<FunctionType>::value)>::type
+        {
+            for (size_t chan = 0; chan < numChannels; ++chan)
+                frame[chan] = function (frame[chan]);
+        }
+
+        Function function;
+    };
+
     /** Processes the input and output buffers supplied in the processing context. */
     template <typename ProcessContext>
     void process (const ProcessContext& context) const noexcept
@@ -56,12 +122,44 @@ struct WaveShaper
         jassert (context.getInputBlock().getNumChannels() == context.getOutputBlock().getNumChannels());
         jassert (context.getInputBlock().getNumSamples()  == context.getOutputBlock().getNumSamples());
 
-        AudioBlock<FloatType>::process (context.getInputBlock(),
-                                        context.getOutputBlock(),
-                                        functionToUse);
+        processBlock (context.getInputBlock(), context.getOutputBlock(),
+                      std::integral_constant<bool, WaveShaperHelpers::IsVectorised<Function>::value
+                                                     && (std::is_same<FloatType, float>::value || std::is_same<FloatType, double>::value)>());
     }
 
     void reset() noexcept {}
+
+private:
+    //==============================================================================
+    void processBlock (const AudioBlock<FloatType>& inBlock, AudioBlock<FloatType>& outBlock, std::false_type) const noexcept
+    {
+        AudioBlock<FloatType>::process (inBlock, outBlock, functionToUse);
+    }
+
+    void processBlock (const AudioBlock<FloatType>& inBlock, AudioBlock<FloatType>& outBlock, std::true_type) const noexcept
+    {
+       #if JUCE_USE_SIMD
+        using VectorType = SIMDRegister<FloatType>;
+        constexpr auto numLanes = VectorType::SIMDNumElements;
+
+        auto numSamples = inBlock.getNumSamples();
+
+        for (size_t chan = 0; chan < inBlock.getNumChannels(); ++chan)
+        {
+            auto* src = inBlock.getChannelPointer (chan);
+            auto* dst = outBlock.getChannelPointer (chan);
+            size_t i = 0;
+
+            for (; i + numLanes <= numSamples; i += numLanes)
+                functionToUse (VectorType::fromRawArray (src + i)).copyToRawArray (dst + i);
+
+            for (; i < numSamples; ++i)
+                dst[i] = functionToUse (src[i]);
+        }
+       #else
+        AudioBlock<FloatType>::process (inBlock, outBlock, functionToUse);
+       #endif
+    }
 };
 
 //==============================================================================
@@ -23,23 +23,165 @@
 namespace juce
 {
 
-class AsyncUpdater::AsyncUpdaterMessage  : public CallbackMessage
+// Rather than each AsyncUpdater posting its own message, the updaters that have been
+// triggered are pushed onto a shared lock-free list, and a single message drains the
+// whole list. So there's only ever one of these messages in the queue, however many
+// updaters are triggered, and re-triggering an updater that's already waiting only
+// costs an atomic operation or two.
+class AsyncUpdater::AsyncUpdaterMessage  : public ReferenceCountedObject
 {
 public:
-    AsyncUpdaterMessage (AsyncUpdater& au)  : owner (au) {}
+    AsyncUpdaterMessage (AsyncUpdater&);
 
-    void messageCallback() override
-    {
-        if (shouldDeliver.compareAndSetBool (0, 1))
-            owner.handleAsyncUpdate();
-    }
+    // Returns false if the dispatch message couldn't be posted
+    bool addToQueue();
 
     AsyncUpdater& owner;
     Atomic<int> shouldDeliver;
 
+private:
+    struct Queue;
+    struct DispatchMessage;
+
+    std::atomic<bool> isQueued { false };
+    AsyncUpdaterMessage* nextInQueue = nullptr;
+
     JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage)
 };
 
+//==============================================================================
+struct AsyncUpdater::AsyncUpdaterMessage::DispatchMessage  : public CallbackMessage
+{
+    DispatchMessage() {}
+    ~DispatchMessage();
+
+    void messageCallback() override;
+
+    bool wasPosted = false, wasDelivered = false;
+
+    JUCE_DECLARE_NON_COPYABLE (DispatchMessage)
+};
+
+struct AsyncUpdater::AsyncUpdaterMessage::Queue
+{
+    static Queue& getInstance()
+    {
+        // (this is deliberately leaked, because a message can still be deleted after
+        // static objects have been destroyed)
+        static auto& instance = *new Queue();
+        return instance;
+    }
+
+    Queue()     { createSpareMessage(); }
+
+    bool postIfNeeded()
+    {
+        if (messagePosted.load() || messagePosted.exchange (true))
+            return true;
+
+        // The message that gets posted was allocated earlier, on the message thread, so a
+        // trigger never allocates. If the post fails, the message's destructor will reset
+        // messagePosted and make a new spare.
+        auto* message = spareMessage.exchange (nullptr);
+
+        if (message == nullptr)
+            message = new DispatchMessage();
+
+        message->wasPosted = true;
+        return message->post();
+    }
+
+    void dispatchAll()
+    {
+        // (the spare has to be ready before messagePosted is cleared, as another thread could post it straight away)
+        createSpareMessage();
+        messagePosted = false;
+
+        // the list is a stack, so it gets reversed to dispatch the updates in the order they were triggered
+        AsyncUpdaterMessage* next = nullptr;
+
+        for (auto* m = first.exchange (nullptr); m != nullptr;)
+        {
+            auto* following = m->nextInQueue;
+            m->nextInQueue = next;
+            next = m;
+            m = following;
+        }
+
+        while (next != nullptr)
+        {
+            auto* m = next;
+            next = m->nextInQueue;
+
+            // after this, another thread can push it back onto the list
+            m->isQueued = false;
+
+            if (m->shouldDeliver.compareAndSetBool (0, 1))
+                m->owner.handleAsyncUpdate();
+
+            m->decReferenceCount();
+        }
+    }
+
+    void messageWasLost()
+    {
+        createSpareMessage();
+        messagePosted = false;
+    }
+
+    void createSpareMessage()
+    {
+        if (spareMessage.load() == nullptr)
+        {
+            auto* message = new DispatchMessage();
+            DispatchMessage* expected = nullptr;
+
+            if (! spareMessage.compare_exchange_strong (expected, message))
+                delete message;
+        }
+    }
+
+    std::atomic<AsyncUpdaterMessage*> first { nullptr };
+    std::atomic<DispatchMessage*> spareMessage { nullptr };
+    std::atomic<bool> messagePosted { false };
+
+    JUCE_DECLARE_NON_COPYABLE (Queue)
+};
+
+AsyncUpdater::AsyncUpdaterMessage::AsyncUpdaterMessage (AsyncUpdater& au)  : owner (au)
+{
+    Queue::getInstance(); // (so that the queue isn't created by the first trigger)
+}
+
+bool AsyncUpdater::AsyncUpdaterMessage::addToQueue()
+{
+    auto& queue = Queue::getInstance();
+
+    if (! isQueued.exchange (true))
+    {
+        incReferenceCount(); // (the queue keeps this alive until it has been dispatched)
+        nextInQueue = queue.first.load();
+
+        while (! queue.first.compare_exchange_weak (nextInQueue, this))
+        {}
+    }
+
+    return queue.postIfNeeded();
+}
+
+AsyncUpdater::AsyncUpdaterMessage::DispatchMessage::~DispatchMessage()
+{
+    // if the message queue was destroyed before this arrived, the next trigger will need to post another one
+    if (wasPosted && ! wasDelivered)
+        Queue::getInstance().messageWasLost();
+}
+
+void AsyncUpdater::AsyncUpdaterMessage::DispatchMessage::messageCallback()
+{
+    wasDelivered = true;
+    Queue::getInstance().dispatchAll();
+}
+
 //==============================================================================
 AsyncUpdater::AsyncUpdater()
 {
@@ -66,7 +208,7 @@ void AsyncUpdater::triggerAsyncUpdate()
     jassert (MessageManager::getInstanceWithoutCreating() != nullptr);
 
     if (activeMessage->shouldDeliver.compareAndSetBool (1, 0))
-        if (! activeMessage->post())
+        if (! activeMessage->addToQueue())
             cancelPendingUpdate(); // if the message queue fails, this avoids getting
                                    // trapped waiting for the message to arrive
 }
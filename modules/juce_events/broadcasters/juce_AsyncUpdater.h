@@ -55,10 +55,13 @@ public:
         If an update callback is already pending but hasn't happened yet, calling
         this method will have no effect.
 
-        It's thread-safe to call this method from any thread, BUT beware of calling
-        it from a real-time (e.g. audio) thread, because it involves posting a message
-        to the system queue, which means it may block (and in general will do on
-        most OSes).
+        It's thread-safe to call this method from any thread, and it never allocates.
+        The updaters that have been triggered are collected in a lock-free list which
+        the message thread drains with a single message, so most calls only cost an
+        atomic operation or two. But beware of calling it from a real-time (e.g. audio)
+        thread: the first trigger after each batch has been delivered has to post that
+        message to the system queue, which may block on some OSes. For a completely
+        lock-free alternative, see RealtimeMessageChannel.
     */
     void triggerAsyncUpdate();
 
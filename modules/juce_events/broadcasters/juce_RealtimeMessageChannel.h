@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fixed-size, lock-free queue that lets realtime threads send messages to the
+    message thread.
+
+    MessageManager::postMessage() and AsyncUpdater::triggerAsyncUpdate() both go through
+    the platform's message queue, which can lock or allocate, so they shouldn't really be
+    called from an audio callback. Instead, you can create one of these channels on the
+    message thread, and then call post() from any number of other threads: it copies the
+    message into one of a set of slots that were allocated when the channel was created,
+    and never blocks or allocates.
+
+    The message thread collects the messages in batches on a timer, and calls your
+    handleMessage() method for each one (or only for the latest one, depending on the
+    DeliveryPolicy you choose). You can also call dispatchPendingMessages() to deliver
+    any waiting messages immediately.
+
+    e.g. @code
+    struct LevelMessage  { int channel; float level; };
+
+    struct LevelMeterChannel  : public RealtimeMessageChannel<LevelMessage>
+    {
+        LevelMeterChannel (MyMeterComponent& m)
+            : RealtimeMessageChannel<LevelMessage> (256, deliverAllMessages), meter (m) {}
+
+        void handleMessage (const LevelMessage& m) override   { meter.setLevel (m.channel, m.level); }
+
+        MyMeterComponent& meter;
+    };
+
+    // ..and then in the audio callback:
+    meterChannel.post ({ channel, buffer.getMagnitude (channel, 0, numSamples) });
+    @endcode
+
+    The MessageType must be default-constructible and copyable, and copying it mustn't
+    allocate or lock - so a simple struct of numbers or pointers is ideal.
+
+    @see AsyncUpdater, MessageManager::callAsync
+*/
+template <typename MessageType>
+class RealtimeMessageChannel  : private Timer
+{
+public:
+    //==============================================================================
+    /** Decides which of the messages that have arrived since the last batch get delivered. */
+    enum DeliveryPolicy
+    {
+        deliverAllMessages,     /**< Every message is delivered, in the order in which it was posted. */
+        deliverLatestMessage    /**< Only the most recent message is delivered, which is handy for
+                                     things like meters or positions where older values are out of date. */
+    };
+
+    //==============================================================================
+    /** Creates a channel.
+
+        @param maxNumPendingMessages    the number of messages that can be waiting for delivery at once.
+                                        This is rounded up to a power of two. When it's full, post() will
+                                        fail until the message thread has caught up
+        @param policy                   which of the waiting messages get delivered
+        @param dispatchIntervalMs       how often the message thread checks for new messages
+    */
+    RealtimeMessageChannel (int maxNumPendingMessages,
+                            DeliveryPolicy policy = deliverAllMessages,
+                            int dispatchIntervalMs = 1000 / 60)
+        : deliveryPolicy (policy)
+    {
+        jassert (maxNumPendingMessages > 0);
+
+        capacity = (int) nextPowerOfTwo (jmax (2, maxNumPendingMessages));
+        messages.resize (capacity);
+        sequences.calloc ((size_t) capacity);
+
+        for (int i = 0; i < capacity; ++i)
+            sequences[i].set ((uint32) i);
+
+        startTimer (dispatchIntervalMs);
+    }
+
+    /** Destructor.
+        Make sure that no other threads are still posting to the channel when it's deleted!
+    */
+    ~RealtimeMessageChannel()
+    {
+        stopTimer();
+    }
+
+    //==============================================================================
+    /** Adds a message to the queue, to be delivered on the message thread.
+
+        This can be called on any thread, including several at once, and never blocks
+        or allocates. It returns false if the queue was full, in which case the message
+        is thrown away.
+    */
+    bool post (const MessageType& message) noexcept
+    {
+        auto position = writePosition.get();
+
+        for (;;)
+        {
+            auto& sequence = sequences[(int) (position & (uint32) (capacity - 1))];
+            auto difference = (int32) (sequence.get() - position);
+
+            if (difference == 0)
+            {
+                // this slot is free, so try to claim it before another writer does
+                if (writePosition.compareAndSetBool (position + 1, position))
+                {
+                    messages.getReference ((int) (position & (uint32) (capacity - 1))) = message;
+                    sequence.set (position + 1);
+                    return true;
+                }
+
+                position = writePosition.get();
+            }
+            else if (difference < 0)
+            {
+                // the slot still holds a message that the message thread hasn't collected yet
+                ++numMessagesDropped;
+                return false;
+            }
+            else
+            {
+                // another writer got here first
+                position = writePosition.get();
+            }
+        }
+    }
+
+    /** Delivers any messages that are waiting, on the calling thread.
+        This must only be called on the message thread.
+    */
+    void dispatchPendingMessages()
+    {
+        MessageType message;
+
+        // (this only takes as many messages as the queue can hold, so that a thread
+        // that's posting very quickly can't keep us here forever)
+        if (deliveryPolicy == deliverLatestMessage)
+        {
+            bool anyMessages = false;
+
+            for (int i = capacity; --i >= 0 && pop (message);)
+                anyMessages = true;
+
+            if (anyMessages)
+                handleMessage (message);
+        }
+        else
+        {
+            for (int i = capacity; --i >= 0 && pop (message);)
+                handleMessage (message);
+        }
+    }
+
+    /** Returns the number of messages that post() has had to throw away because the queue was full. */
+    int getNumMessagesDropped() const noexcept          { return numMessagesDropped.get(); }
+
+    /** Returns the policy that this channel was created with. */
+    DeliveryPolicy getDeliveryPolicy() const noexcept   { return deliveryPolicy; }
+
+    //==============================================================================
+    /** Called on the message thread to deliver a message that was posted to the channel. */
+    virtual void handleMessage (const MessageType& message) = 0;
+
+private:
+    //==============================================================================
+    // Each slot has a sequence number which tells the writers and the reader whose turn it is to
+    // use it: a slot at position p is free for writing when its sequence is p, and holds a
+    // message ready to read when it's p + 1. The reader then sets it to p + capacity, ready for
+    // the next time round.
+    Array<MessageType> messages;
+    HeapBlock<Atomic<uint32>> sequences;
+    int capacity = 0;
+    Atomic<uint32> writePosition;
+    uint32 readPosition = 0;
+    Atomic<int> numMessagesDropped;
+    const DeliveryPolicy deliveryPolicy;
+
+    bool pop (MessageType& result) noexcept
+    {
+        auto index = (int) (readPosition & (uint32) (capacity - 1));
+
+        if (sequences[index].get() != readPosition + 1)
+            return false;
+
+        result = messages.getReference (index);
+        sequences[index].set (readPosition + (uint32) capacity);
+        ++readPosition;
+        return true;
+    }
+
+    void timerCallback() override
+    {
+        dispatchPendingMessages();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeMessageChannel)
+};
+
+} // namespace juce
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct RealtimeMessageChannelTests  : public UnitTest
+{
+    RealtimeMessageChannelTests() : UnitTest ("RealtimeMessageChannel", "Messaging") {}
+
+    /** Records what it gets into an array that outlives it, so that a test can check that
+        nothing arrives after the channel has been deleted. */
+    struct TestChannel  : public RealtimeMessageChannel<int>
+    {
+        TestChannel (Array<int>& log, int maxNumPendingMessages,
+                     DeliveryPolicy policy = deliverAllMessages, int dispatchIntervalMs = 60000)
+            : RealtimeMessageChannel<int> (maxNumPendingMessages, policy, dispatchIntervalMs),
+              received (log)
+        {
+        }
+
+        void handleMessage (const int& message) override
+        {
+            if (! MessageManager::getInstance()->isThisTheMessageThread())
+                ++numDeliveredOffMessageThread;
+
+            received.add (message);
+        }
+
+        Array<int>& received;
+        int numDeliveredOffMessageThread = 0;
+    };
+
+    /** Posts the numbers from 0 to numMessages - 1, trying again whenever the channel is full. */
+    struct ProducerThread  : public Thread
+    {
+        ProducerThread (TestChannel& c, int num)  : Thread ("channel producer"), channel (c), numMessages (num)
+        {
+            // at normal priority, the test thread still gets to collect the messages on a single core
+            startThread (0);
+        }
+
+        ~ProducerThread()
+        {
+            stopThread (5000);
+        }
+
+        void run() override
+        {
+            for (int i = 0; i < numMessages && ! threadShouldExit();)
+            {
+                if (channel.post (i))
+                    ++i;
+                else
+                    Thread::yield();
+            }
+        }
+
+        TestChannel& channel;
+        const int numMessages;
+    };
+
+    void expectInOrder (const Array<int>& received, int first, int num)
+    {
+        expectEquals (received.size(), num);
+
+        bool inOrder = true;
+
+        for (int i = 0; i < jmin (num, received.size()); ++i)
+            inOrder = inOrder && received.getUnchecked (i) == first + i;
+
+        expect (inOrder, "The messages weren't delivered in the order they were posted");
+    }
+
+    void runTest() override
+    {
+        // the console test runner doesn't create a message manager, and this makes the
+        // test's own thread the message thread
+        MessageManager::getInstance();
+
+        beginTest ("Single producer, delivered in order");
+        {
+            const int numMessages = 20000;
+            Array<int> received;
+            TestChannel channel (received, 64);
+
+            {
+                ProducerThread producer (channel, numMessages);
+                auto timeout = Time::getMillisecondCounter() + 20000;
+
+                while (received.size() < numMessages && Time::getMillisecondCounter() < timeout)
+                {
+                    channel.dispatchPendingMessages();
+                    Thread::yield();
+                }
+            }
+
+            expectInOrder (received, 0, numMessages);
+            expectEquals (channel.numDeliveredOffMessageThread, 0);
+        }
+
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        beginTest ("Delivered by the timer on the message thread");
+        {
+            const int numMessages = 500;
+            Array<int> received;
+            TestChannel channel (received, 16, TestChannel::deliverAllMessages, 1);
+
+            {
+                ProducerThread producer (channel, numMessages);
+                auto timeout = Time::getMillisecondCounter() + 20000;
+
+                while (received.size() < numMessages && Time::getMillisecondCounter() < timeout)
+                    MessageManager::getInstance()->runDispatchLoopUntil (1);
+            }
+
+            expectInOrder (received, 0, numMessages);
+            expectEquals (channel.numDeliveredOffMessageThread, 0);
+        }
+       #endif
+
+        beginTest ("Full queue");
+        {
+            Array<int> received;
+            TestChannel channel (received, 5);  // rounded up to 8
+
+            for (int i = 0; i < 8; ++i)
+                expect (channel.post (i));
+
+            expect (! channel.post (8));
+            expect (! channel.post (9));
+            expectEquals (channel.getNumMessagesDropped(), 2);
+
+            channel.dispatchPendingMessages();
+            expectInOrder (received, 0, 8);
+
+            // once the messages have been collected, there's room again
+            received.clear();
+            expect (channel.post (10));
+            channel.dispatchPendingMessages();
+            expectInOrder (received, 10, 1);
+            expectEquals (channel.getNumMessagesDropped(), 2);
+        }
+
+        beginTest ("Latest message only");
+        {
+            Array<int> received;
+            TestChannel channel (received, 8, TestChannel::deliverLatestMessage);
+
+            for (int i = 0; i < 5; ++i)
+                channel.post (i);
+
+            channel.dispatchPendingMessages();
+            expectInOrder (received, 4, 1);
+
+            channel.dispatchPendingMessages();
+            expectEquals (received.size(), 1);
+        }
+
+        beginTest ("Deleted with messages pending");
+        {
+            Array<int> received;
+
+            {
+                TestChannel channel (received, 8, TestChannel::deliverAllMessages, 1);
+
+                for (int i = 0; i < 8; ++i)
+                    channel.post (i);
+            }
+
+           #if JUCE_MODAL_LOOPS_PERMITTED
+            // gives a timer that wasn't stopped properly the chance to fire
+            MessageManager::getInstance()->runDispatchLoopUntil (20);
+           #endif
+
+            expectEquals (received.size(), 0);
+        }
+    }
+};
+
+static RealtimeMessageChannelTests realtimeMessageChannelTests;
+
+} // namespace juce
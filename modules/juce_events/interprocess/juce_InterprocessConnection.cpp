@@ -32,6 +32,221 @@ struct InterprocessConnection::ConnectionThread  : public Thread
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConnectionThread)
 };
 
+//==============================================================================
+/*  Reads messages from a socket when a SocketReactor says there's data waiting.
+
+    A callback mustn't block, so this does a single read each time, and carries on
+    where it left off when it's called again.
+*/
+struct InterprocessConnection::ReactorCallback  : public SocketReactor::Listener
+{
+    ReactorCallback (InterprocessConnection& c)  : owner (c) {}
+
+    void reset() noexcept
+    {
+        headerBytesRead = 0;
+    }
+
+    void socketReadyForReading (int) override
+    {
+        auto* s = owner.socket.get();
+
+        if (s == nullptr)
+            return;
+
+        if (headerBytesRead < (int) sizeof (messageHeader))
+        {
+            auto bytesIn = s->read (addBytesToPointer (messageHeader, headerBytesRead),
+                                    (int) sizeof (messageHeader) - headerBytesRead, false);
+
+            if (bytesIn <= 0)
+                return handleConnectionLost();
+
+            headerBytesRead += bytesIn;
+
+            if (headerBytesRead < (int) sizeof (messageHeader))
+                return;
+
+            messageSize = (int) ByteOrder::swapIfBigEndian (messageHeader[1]);
+
+            // skip over anything that isn't a valid header, like readNextMessageInt() does
+            if (ByteOrder::swapIfBigEndian (messageHeader[0]) != owner.magicMessageHeader || messageSize <= 0)
+            {
+                headerBytesRead = 0;
+                return;
+            }
+
+            owner.receiveBuffer.setSize ((size_t) messageSize);
+            messageBytesRead = 0;
+            return;
+        }
+
+        auto bytesIn = s->read (addBytesToPointer (owner.receiveBuffer.getData(), messageBytesRead),
+                                messageSize - messageBytesRead, false);
+
+        if (bytesIn <= 0)
+            return handleConnectionLost();
+
+        messageBytesRead += bytesIn;
+
+        if (messageBytesRead == messageSize)
+        {
+            headerBytesRead = 0;
+            owner.deliverDataInt (owner.receiveBuffer);
+        }
+    }
+
+    void handleConnectionLost()
+    {
+        owner.deletePipeAndSocket();
+        owner.connectionLostInt();
+    }
+
+    InterprocessConnection& owner;
+    uint32 messageHeader[2];
+    int headerBytesRead = 0, messageSize = 0, messageBytesRead = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReactorCallback)
+};
+
+//==============================================================================
+/*  One direction of a shared memory channel between the two ends of a pipe.
+
+    The buffer is a ring, where the sender copies each message into the next free
+    space and then writes a short header into the pipe to say where it is. The
+    receiver copies it out and moves the read position past it, so the space can be
+    reused. A message is never split across the end of the ring, which means that
+    some space at the end is sometimes skipped. If there's no room for a message, it
+    just gets sent through the pipe as usual.
+*/
+struct InterprocessConnection::SharedMemoryBuffer
+{
+    struct Header
+    {
+        uint32 magic, capacity, sessionId;
+        char padding1[52];
+        std::atomic<uint32> writePosition;
+        char padding2[60];
+        std::atomic<uint32> readPosition;
+        char padding3[60];
+    };
+
+    static String getName (const String& pipeName, bool isCreatorToConnector)
+    {
+        return pipeName + (isCreatorToConnector ? "_ipc_out" : "_ipc_in");
+    }
+
+    static SharedMemoryBuffer* create (const String& name, int size, uint32 sessionId)
+    {
+        auto capacity = (uint32) nextPowerOfTwo (jlimit (4096, 1 << 30, size));
+        ScopedPointer<SharedMemoryBuffer> buffer (new SharedMemoryBuffer());
+
+        if (! buffer->memory.create (name, sizeof (Header) + capacity))
+            return nullptr;
+
+        auto* h = buffer->getHeader();
+        h->capacity = capacity;
+        h->sessionId = sessionId;
+        std::atomic_thread_fence (std::memory_order_release);
+        h->magic = headerMagic;
+
+        buffer->isOwner = true;
+        return buffer.release();
+    }
+
+    static SharedMemoryBuffer* open (const String& name)
+    {
+        ScopedPointer<SharedMemoryBuffer> buffer (new SharedMemoryBuffer());
+
+        if (! buffer->memory.openExisting (name) || buffer->memory.getSize() < sizeof (Header))
+            return nullptr;
+
+        auto* h = buffer->getHeader();
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if (h->magic != headerMagic
+             || ! isPowerOfTwo (h->capacity)
+             || buffer->memory.getSize() < sizeof (Header) + h->capacity)
+            return nullptr;
+
+        return buffer.release();
+    }
+
+    uint32 getSessionId() const noexcept    { return getHeader()->sessionId; }
+
+    // Called by the sender, with the connection's lock held.
+    bool write (const void* const* blocks, const size_t* blockSizes, int numBlocks,
+                size_t totalSize, uint32& position) noexcept
+    {
+        auto* header = getHeader();
+        auto capacity = header->capacity;
+
+        if (totalSize > capacity)
+            return false;
+
+        auto size = (uint32) totalSize;
+        auto start = header->writePosition.load (std::memory_order_relaxed);
+        auto offset = start & (capacity - 1);
+
+        if (offset + size > capacity)
+            start += capacity - offset;
+
+        if (start + size - header->readPosition.load (std::memory_order_acquire) > capacity)
+            return false;
+
+        auto* dest = getData() + (start & (capacity - 1));
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            memcpy (dest, blocks[i], blockSizes[i]);
+            dest += blockSizes[i];
+        }
+
+        header->writePosition.store (start + size, std::memory_order_release);
+        position = start;
+        return true;
+    }
+
+    // Called by the receiver, which must call release() once it's finished with the data.
+    const void* getMessage (uint32 position, uint32 size) const noexcept
+    {
+        auto* header = getHeader();
+        auto capacity = header->capacity;
+        auto offset = position & (capacity - 1);
+
+        if (size > capacity || offset + size > capacity
+             || header->writePosition.load (std::memory_order_acquire) - position < size)
+            return nullptr;
+
+        return getData() + offset;
+    }
+
+    void release (uint32 endPosition) noexcept
+    {
+        getHeader()->readPosition.store (endPosition, std::memory_order_release);
+    }
+
+    bool isOwner = false;
+
+private:
+    enum { headerMagic = 0x4a495043 };
+
+    SharedMemoryBuffer() {}
+
+    Header* getHeader() const noexcept      { return static_cast<Header*> (memory.getData()); }
+    char* getData() const noexcept          { return static_cast<char*> (memory.getData()) + sizeof (Header); }
+
+    SharedMemory memory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryBuffer)
+};
+
+// Set in a message's size field to show that the data is in the shared memory
+// buffer, in which case the header is followed by the session ID and the position.
+// A header like this with a size of zero is the handshake that's used to agree
+// that both ends have the buffers.
+static const uint32 sharedMemoryMessageFlag = 0x80000000;
+
 //==============================================================================
 InterprocessConnection::InterprocessConnection (bool callbacksOnMessageThread, uint32 magicMessageHeaderNumber)
     : useMessageThread (callbacksOnMessageThread),
@@ -61,7 +276,7 @@ bool InterprocessConnection::connectToSocket (const String& hostName,
     if (socket->connect (hostName, portNumber, timeOutMillisecs))
     {
         connectionMadeInt();
-        thread->startThread();
+        startReading();
         return true;
     }
 
@@ -79,6 +294,7 @@ bool InterprocessConnection::connectToPipe (const String& pipeName, const int ti
     {
         const ScopedLock sl (pipeAndSocketLock);
         pipeReceiveMessageTimeout = timeoutMs;
+        openSharedMemory (pipeName, false, 0);
         initialiseWithPipe (newPipe.release());
         return true;
     }
@@ -86,7 +302,8 @@ bool InterprocessConnection::connectToPipe (const String& pipeName, const int ti
     return false;
 }
 
-bool InterprocessConnection::createPipe (const String& pipeName, const int timeoutMs, bool mustNotExist)
+bool InterprocessConnection::createPipe (const String& pipeName, const int timeoutMs,
+                                         bool mustNotExist, int sharedMemorySize)
 {
     disconnect();
 
@@ -96,6 +313,7 @@ bool InterprocessConnection::createPipe (const String& pipeName, const int timeo
     {
         const ScopedLock sl (pipeAndSocketLock);
         pipeReceiveMessageTimeout = timeoutMs;
+        openSharedMemory (pipeName, true, sharedMemorySize);
         initialiseWithPipe (newPipe.release());
         return true;
     }
@@ -103,9 +321,38 @@ bool InterprocessConnection::createPipe (const String& pipeName, const int timeo
     return false;
 }
 
+void InterprocessConnection::openSharedMemory (const String& pipeName, bool isCreator, int size)
+{
+    auto inName  = SharedMemoryBuffer::getName (pipeName, ! isCreator);
+    auto outName = SharedMemoryBuffer::getName (pipeName, isCreator);
+
+    if (isCreator)
+    {
+        if (size <= 0)
+            return;
+
+        auto sessionId = (uint32) Random::getSystemRandom().nextInt();
+        sharedMemoryIn  = SharedMemoryBuffer::create (inName, size, sessionId);
+        sharedMemoryOut = SharedMemoryBuffer::create (outName, size, sessionId);
+    }
+    else
+    {
+        sharedMemoryIn  = SharedMemoryBuffer::open (inName);
+        sharedMemoryOut = SharedMemoryBuffer::open (outName);
+    }
+
+    if (sharedMemoryIn == nullptr || sharedMemoryOut == nullptr
+         || sharedMemoryIn->getSessionId() != sharedMemoryOut->getSessionId())
+    {
+        sharedMemoryIn = nullptr;
+        sharedMemoryOut = nullptr;
+    }
+}
+
 void InterprocessConnection::disconnect()
 {
     thread->signalThreadShouldExit();
+    stopReactorCallbacks();
 
     {
         const ScopedLock sl (pipeAndSocketLock);
@@ -120,9 +367,15 @@ void InterprocessConnection::disconnect()
 
 void InterprocessConnection::deletePipeAndSocket()
 {
+    // the socket has to be removed from the reactor before it's closed
+    stopReactorCallbacks();
+
     const ScopedLock sl (pipeAndSocketLock);
     socket = nullptr;
     pipe = nullptr;
+    sharedMemoryIn = nullptr;
+    sharedMemoryOut = nullptr;
+    canSendThroughSharedMemory = false;
 }
 
 bool InterprocessConnection::isConnected() const
@@ -131,7 +384,7 @@ bool InterprocessConnection::isConnected() const
 
     return ((socket != nullptr && socket->isConnected())
               || (pipe != nullptr && pipe->isOpen()))
-            && thread->isThreadRunning();
+            && (thread->isThreadRunning() || reactorSocketHandle >= 0);
 }
 
 String InterprocessConnection::getConnectedHostName() const
@@ -152,27 +405,135 @@ String InterprocessConnection::getConnectedHostName() const
 //==============================================================================
 bool InterprocessConnection::sendMessage (const MemoryBlock& message)
 {
-    uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
-                                ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
+    return sendMessage (message.getData(), message.getSize());
+}
 
-    MemoryBlock messageData (sizeof (messageHeader) + message.getSize());
-    messageData.copyFrom (messageHeader, 0, sizeof (messageHeader));
-    messageData.copyFrom (message.getData(), sizeof (messageHeader), message.getSize());
+bool InterprocessConnection::sendMessage (const void* messageData, size_t numBytes)
+{
+    return sendMessage (&messageData, &numBytes, 1);
+}
+
+bool InterprocessConnection::sendMessage (const void* const* blocks, const size_t* blockSizes, int numBlocks)
+{
+    size_t totalSize = 0;
 
-    return writeData (messageData.getData(), (int) messageData.getSize()) == (int) messageData.getSize();
+    for (int i = 0; i < numBlocks; ++i)
+        totalSize += blockSizes[i];
+
+    // messages have to fit into the size field of the header!
+    jassert (totalSize < sharedMemoryMessageFlag);
+
+    return writeData (blocks, blockSizes, numBlocks, totalSize);
 }
 
-int InterprocessConnection::writeData (void* data, int dataSize)
+bool InterprocessConnection::writeData (const void* const* blocks, const size_t* blockSizes,
+                                        int numBlocks, size_t totalSize)
 {
     const ScopedLock sl (pipeAndSocketLock);
 
+    uint32 messageHeader[4] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
+                                ByteOrder::swapIfBigEndian ((uint32) totalSize), 0, 0 };
+    uint32 position = 0;
+
+    if (canSendThroughSharedMemory && totalSize > 0
+         && sharedMemoryOut->write (blocks, blockSizes, numBlocks, totalSize, position))
+    {
+        messageHeader[1] = ByteOrder::swapIfBigEndian ((uint32) totalSize | sharedMemoryMessageFlag);
+        messageHeader[2] = ByteOrder::swapIfBigEndian (sharedMemoryOut->getSessionId());
+        messageHeader[3] = ByteOrder::swapIfBigEndian (position);
+
+        return writeBlocks (messageHeader, sizeof (messageHeader), nullptr, nullptr, 0, pipeReceiveMessageTimeout);
+    }
+
+    return writeBlocks (messageHeader, 2 * sizeof (uint32), blocks, blockSizes, numBlocks, pipeReceiveMessageTimeout);
+}
+
+bool InterprocessConnection::writeBlocks (const void* header, int headerSize,
+                                          const void* const* blocks, const size_t* blockSizes,
+                                          int numBlocks, int pipeTimeoutMs)
+{
+    enum { maxBuffersPerWrite = 16, maxBytesToCombine = 4096 };
+
     if (socket != nullptr)
-        return socket->write (data, dataSize);
+    {
+        const void* buffers[maxBuffersPerWrite] = { header };
+        int bufferSizes[maxBuffersPerWrite] = { headerSize };
+        int numBuffers = 1, numBytes = headerSize;
+
+        for (int i = 0;; ++i)
+        {
+            if (i == numBlocks || numBuffers == maxBuffersPerWrite)
+            {
+                if (socket->writeMultiple (buffers, bufferSizes, numBuffers) != numBytes)
+                    return false;
+
+                if (i == numBlocks)
+                    return true;
+
+                numBuffers = 0;
+                numBytes = 0;
+            }
+
+            jassert (blockSizes[i] <= (size_t) std::numeric_limits<int>::max());
+
+            buffers[numBuffers] = blocks[i];
+            bufferSizes[numBuffers++] = (int) blockSizes[i];
+            numBytes += (int) blockSizes[i];
+        }
+    }
 
     if (pipe != nullptr)
-        return pipe->write (data, dataSize, pipeReceiveMessageTimeout);
+    {
+        size_t totalSize = (size_t) headerSize;
 
-    return 0;
+        for (int i = 0; i < numBlocks; ++i)
+            totalSize += blockSizes[i];
+
+        // small messages are cheaper to copy than to write in pieces
+        if (totalSize <= maxBytesToCombine)
+        {
+            char combined[maxBytesToCombine];
+            memcpy (combined, header, (size_t) headerSize);
+            auto* dest = combined + headerSize;
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                memcpy (dest, blocks[i], blockSizes[i]);
+                dest += blockSizes[i];
+            }
+
+            return pipe->write (combined, (int) totalSize, pipeTimeoutMs) == (int) totalSize;
+        }
+
+        if (pipe->write (header, headerSize, pipeTimeoutMs) != headerSize)
+            return false;
+
+        for (int i = 0; i < numBlocks; ++i)
+            if (blockSizes[i] > 0 && pipe->write (blocks[i], (int) blockSizes[i], pipeTimeoutMs) != (int) blockSizes[i])
+                return false;
+
+        return true;
+    }
+
+    return false;
+}
+
+void InterprocessConnection::sendSharedMemoryHandshake()
+{
+    const ScopedLock sl (pipeAndSocketLock);
+
+    if (sharedMemoryIn == nullptr)
+        return;
+
+    uint32 messageHeader[4] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
+                                ByteOrder::swapIfBigEndian (sharedMemoryMessageFlag),
+                                ByteOrder::swapIfBigEndian (sharedMemoryIn->getSessionId()), 0 };
+
+    // If the buffers were left behind by a process that's gone, there may be
+    // nobody at the other end, so don't wait forever.
+    auto timeout = pipeReceiveMessageTimeout >= 0 ? jmin (pipeReceiveMessageTimeout, 1000) : 1000;
+
+    writeBlocks (messageHeader, sizeof (messageHeader), nullptr, nullptr, 0, timeout);
 }
 
 //==============================================================================
@@ -181,7 +542,7 @@ void InterprocessConnection::initialiseWithSocket (StreamingSocket* newSocket)
     jassert (socket == nullptr && pipe == nullptr);
     socket = newSocket;
     connectionMadeInt();
-    thread->startThread();
+    startReading();
 }
 
 void InterprocessConnection::initialiseWithPipe (NamedPipe* newPipe)
@@ -192,6 +553,41 @@ void InterprocessConnection::initialiseWithPipe (NamedPipe* newPipe)
     thread->startThread();
 }
 
+void InterprocessConnection::startReading()
+{
+    if (socket != nullptr && socketReactor != nullptr)
+    {
+        if (reactorCallback == nullptr)
+            reactorCallback = new ReactorCallback (*this);
+
+        reactorCallback->reset();
+
+        if (socketReactor->addSocket (*socket, reactorCallback))
+        {
+            reactorSocketHandle = socket->getRawSocketHandle();
+            return;
+        }
+    }
+
+    thread->startThread();
+}
+
+void InterprocessConnection::stopReactorCallbacks()
+{
+    int handle;
+
+    {
+        const ScopedLock sl (pipeAndSocketLock);
+        handle = reactorSocketHandle;
+        reactorSocketHandle = -1;
+    }
+
+    // This waits for any callback that's in progress, so mustn't be called with the
+    // lock held. If it's called from inside the callback, it returns straight away.
+    if (handle >= 0)
+        socketReactor->removeSocket (handle);
+}
+
 //==============================================================================
 struct ConnectionStateMessage  : public MessageManager::MessageBase
 {
@@ -244,9 +640,11 @@ void InterprocessConnection::connectionLostInt()
 
 struct DataDeliveryMessage  : public Message
 {
-    DataDeliveryMessage (InterprocessConnection* ipc, const MemoryBlock& d)
-        : owner (ipc), data (d)
-    {}
+    DataDeliveryMessage (InterprocessConnection* ipc, MemoryBlock& d)
+        : owner (ipc)
+    {
+        data.swapWith (d);
+    }
 
     void messageCallback() override
     {
@@ -258,10 +656,11 @@ struct DataDeliveryMessage  : public Message
     MemoryBlock data;
 };
 
-void InterprocessConnection::deliverDataInt (const MemoryBlock& data)
+void InterprocessConnection::deliverDataInt (MemoryBlock& data)
 {
     jassert (callbackConnectionState);
 
+    // When the message is posted, it takes the data, and the next one is read into a new block.
     if (useMessageThread)
         (new DataDeliveryMessage (this, data))->post();
     else
@@ -269,45 +668,63 @@ void InterprocessConnection::deliverDataInt (const MemoryBlock& data)
 }
 
 //==============================================================================
+int InterprocessConnection::readData (void* data, int numBytes)
+{
+    return socket != nullptr ? socket->read (data, numBytes, true)
+                             : pipe  ->read (data, numBytes, -1);
+}
+
 bool InterprocessConnection::readNextMessageInt()
 {
     uint32 messageHeader[2];
-    const int bytes = socket != nullptr ? socket->read (messageHeader, sizeof (messageHeader), true)
-                                        : pipe  ->read (messageHeader, sizeof (messageHeader), -1);
+    int bytes = readData (messageHeader, sizeof (messageHeader));
 
     if (bytes == sizeof (messageHeader)
          && ByteOrder::swapIfBigEndian (messageHeader[0]) == magicMessageHeader)
     {
-        int bytesInMessage = (int) ByteOrder::swapIfBigEndian (messageHeader[1]);
+        auto messageSize = ByteOrder::swapIfBigEndian (messageHeader[1]);
 
-        if (bytesInMessage > 0)
+        if ((messageSize & sharedMemoryMessageFlag) == 0)
         {
-            MemoryBlock messageData ((size_t) bytesInMessage, true);
-            int bytesRead = 0;
+            int bytesInMessage = (int) messageSize;
 
-            while (bytesInMessage > 0)
+            if (bytesInMessage > 0)
             {
-                if (thread->threadShouldExit())
-                    return false;
+                receiveBuffer.setSize ((size_t) bytesInMessage);
+                int bytesRead = 0;
+
+                while (bytesInMessage > 0)
+                {
+                    if (thread->threadShouldExit())
+                        return false;
 
-                const int numThisTime = jmin (bytesInMessage, 65536);
-                void* const data = addBytesToPointer (messageData.getData(), bytesRead);
+                    const int numThisTime = jmin (bytesInMessage, 65536);
+                    const int bytesIn = readData (addBytesToPointer (receiveBuffer.getData(), bytesRead), numThisTime);
 
-                const int bytesIn = socket != nullptr ? socket->read (data, numThisTime, true)
-                                                      : pipe  ->read (data, numThisTime, -1);
+                    if (bytesIn <= 0)
+                        break;
 
-                if (bytesIn <= 0)
-                    break;
+                    bytesRead += bytesIn;
+                    bytesInMessage -= bytesIn;
+                }
 
-                bytesRead += bytesIn;
-                bytesInMessage -= bytesIn;
+                zeromem (addBytesToPointer (receiveBuffer.getData(), bytesRead), (size_t) bytesInMessage);
+                deliverDataInt (receiveBuffer);
             }
 
-            if (bytesRead >= 0)
-                deliverDataInt (messageData);
+            return true;
         }
+
+        uint32 location[2];
+        bytes = readData (location, sizeof (location));
+
+        if (bytes == sizeof (location))
+            return readSharedMemoryMessage (messageSize & ~sharedMemoryMessageFlag,
+                                            ByteOrder::swapIfBigEndian (location[0]),
+                                            ByteOrder::swapIfBigEndian (location[1]));
     }
-    else if (bytes < 0)
+
+    if (bytes < 0)
     {
         if (socket != nullptr)
             deletePipeAndSocket();
@@ -319,13 +736,48 @@ bool InterprocessConnection::readNextMessageInt()
     return true;
 }
 
+bool InterprocessConnection::readSharedMemoryMessage (uint32 size, uint32 sessionId, uint32 position)
+{
+    if (sharedMemoryIn == nullptr || sessionId != sharedMemoryIn->getSessionId())
+        return true;
+
+    if (size == 0)
+    {
+        {
+            const ScopedLock sl (pipeAndSocketLock);
+            canSendThroughSharedMemory = (sharedMemoryOut != nullptr);
+        }
+
+        // the end that created the pipe replies to the other end's handshake
+        if (sharedMemoryIn->isOwner)
+            sendSharedMemoryHandshake();
+
+        return true;
+    }
+
+    if (auto* data = sharedMemoryIn->getMessage (position, size))
+    {
+        receiveBuffer.setSize (size);
+        receiveBuffer.copyFrom (data, 0, size);
+        sharedMemoryIn->release (position + size);
+        deliverDataInt (receiveBuffer);
+    }
+
+    return true;
+}
+
 void InterprocessConnection::runThread()
 {
+    if (sharedMemoryIn != nullptr && ! sharedMemoryIn->isOwner)
+        sendSharedMemoryHandshake();
+
     while (! thread->threadShouldExit())
     {
         if (socket != nullptr)
         {
-            auto ready = socket->waitUntilReady (true, 0);
+            // The timeout is only here so that the thread still notices when it's
+            // told to stop on systems where closing the socket doesn't interrupt this.
+            auto ready = socket->waitUntilReady (true, 20);
 
             if (ready < 0)
             {
@@ -335,10 +787,7 @@ void InterprocessConnection::runThread()
             }
 
             if (ready == 0)
-            {
-                thread->wait (1);
                 continue;
-            }
         }
         else if (pipe != nullptr)
         {
@@ -59,7 +59,9 @@ public:
                                             connectionLost() and messageReceived() methods will
                                             always be made using the message thread; if false,
                                             these will be called immediately on the connection's
-                                            own thread.
+                                            own thread, which avoids the delay of waiting for the
+                                            message thread, and lets incoming messages be delivered
+                                            without being copied.
         @param magicMessageHeaderNumber     a magic number to use in the header to check the
                                             validity of the data blocks being sent and received. This
                                             can be any number, but the sender and receiver must obviously
@@ -110,10 +112,33 @@ public:
         @param pipeReceiveMessageTimeoutMs  a timeout length to be used when reading or writing
                                             to the pipe, or -1 for an infinite timeout
         @param mustNotExist   if set to true, the method will fail if the pipe already exists
+        @param sharedMemorySize if this is greater than zero, a pair of shared memory buffers of
+                              (roughly) this many bytes are created alongside the pipe, and any
+                              messages that fit into them are passed through them instead of
+                              being copied through the pipe, which only has to carry a short
+                              header for each one. The process that calls connectToPipe() picks
+                              these up automatically, and the messages that are sent and received
+                              are the same either way.
         @returns true if the pipe was created, or false if it fails (e.g. if another process is
                  already using using the pipe)
     */
-    bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs, bool mustNotExist = false);
+    bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs, bool mustNotExist = false,
+                     int sharedMemorySize = 0);
+
+    /** Makes this connection use a SocketReactor to wait for messages when it's
+        connected to a socket, rather than a thread of its own.
+
+        This lets a process handle a large number of connections with just a few
+        threads. It takes effect the next time the connection is made, and the reactor
+        must outlive the connection. Pipes always use a thread. Pass nullptr to go back
+        to using a thread for sockets too.
+
+        If the connection was created with callbacksOnMessageThread set to false, its
+        callbacks are made on one of the reactor's threads.
+
+        @see SocketReactor, InterprocessConnectionServer::setSocketReactor
+    */
+    void setSocketReactor (SocketReactor* reactorToUse) noexcept    { socketReactor = reactorToUse; }
 
     /** Disconnects and closes any currently-open sockets or pipes. */
     void disconnect();
@@ -143,6 +168,20 @@ public:
     */
     bool sendMessage (const MemoryBlock& message);
 
+    /** Sends a message containing a block of data.
+        This does the same thing as the version that takes a MemoryBlock, but doesn't need the
+        data to be copied into one first.
+    */
+    bool sendMessage (const void* messageData, size_t numBytes);
+
+    /** Sends a message made up of several blocks of data.
+
+        The other end receives a single message containing all the blocks, one after another,
+        but they're written directly from where they are rather than being copied into one
+        buffer first.
+    */
+    bool sendMessage (const void* const* blocks, const size_t* blockSizes, int numBlocks);
+
     //==============================================================================
     /** Called when the connection is first connected.
 
@@ -167,7 +206,8 @@ public:
 
         If the connection was created with the callbacksOnMessageThread flag set, then
         this will be called on the message thread; otherwise it will be called on a server
-        thread.
+        thread. In that case the connection reads every message into the same block, so the
+        one that's passed in here is only valid until the callback returns.
 
         @see sendMessage
     */
@@ -183,22 +223,41 @@ private:
     const bool useMessageThread;
     const uint32 magicMessageHeader;
     int pipeReceiveMessageTimeout = -1;
+    MemoryBlock receiveBuffer;
+
+    struct SharedMemoryBuffer;
+    friend struct ContainerDeletePolicy<SharedMemoryBuffer>;
+    ScopedPointer<SharedMemoryBuffer> sharedMemoryIn, sharedMemoryOut;
+    bool canSendThroughSharedMemory = false;
+
+    SocketReactor* socketReactor = nullptr;
+    int reactorSocketHandle = -1;
+    struct ReactorCallback;
+    friend struct ContainerDeletePolicy<ReactorCallback>;
+    ScopedPointer<ReactorCallback> reactorCallback;
 
     friend class InterprocessConnectionServer;
     void initialiseWithSocket (StreamingSocket*);
     void initialiseWithPipe (NamedPipe*);
     void deletePipeAndSocket();
+    void startReading();
+    void stopReactorCallbacks();
     void connectionMadeInt();
     void connectionLostInt();
-    void deliverDataInt (const MemoryBlock&);
+    void deliverDataInt (MemoryBlock&);
     bool readNextMessageInt();
+    bool readSharedMemoryMessage (uint32, uint32, uint32);
+    int readData (void*, int);
+    void openSharedMemory (const String&, bool, int);
+    void sendSharedMemoryHandshake();
 
     struct ConnectionThread;
     friend struct ConnectionThread;
     friend struct ContainerDeletePolicy<ConnectionThread>;
     ScopedPointer<ConnectionThread> thread;
     void runThread();
-    int writeData (void*, int);
+    bool writeData (const void* const*, const size_t*, int, size_t);
+    bool writeBlocks (const void*, int, const void* const*, const size_t*, int, int);
 
     JUCE_DECLARE_WEAK_REFERENCEABLE (InterprocessConnection)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnection)
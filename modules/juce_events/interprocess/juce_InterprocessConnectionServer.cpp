@@ -74,7 +74,12 @@ void InterprocessConnectionServer::run()
 
         if (clientSocket != nullptr)
             if (InterprocessConnection* newConnection = createConnectionObject())
+            {
+                if (socketReactor != nullptr)
+                    newConnection->setSocketReactor (socketReactor);
+
                 newConnection->initialiseWithSocket (clientSocket.release());
+            }
     }
 }
 
@@ -80,6 +80,16 @@ public:
     */
     int getBoundPort() const noexcept;
 
+    /** Makes the connections that this server creates use a SocketReactor to wait for
+        their messages, rather than each having a thread of its own.
+
+        This only affects connections that are made after it's called, and the reactor
+        must outlive all of them. Pass nullptr to go back to using threads.
+
+        @see InterprocessConnection::setSocketReactor
+    */
+    void setSocketReactor (SocketReactor* reactorToUse) noexcept    { socketReactor = reactorToUse; }
+
 protected:
     /** Creates a suitable connection object for a client process that wants to
         connect to this one.
@@ -95,6 +105,7 @@ protected:
 private:
     //==============================================================================
     ScopedPointer<StreamingSocket> socket;
+    SocketReactor* socketReactor = nullptr;
 
     void run() override;
 
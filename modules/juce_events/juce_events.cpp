@@ -67,6 +67,11 @@
 #include "interprocess/juce_InterprocessConnectionServer.cpp"
 #include "interprocess/juce_ConnectedChildProcess.cpp"
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+#include "broadcasters/juce_RealtimeMessageChannel_test.cpp"
+#endif
+
 //==============================================================================
 #if JUCE_MAC || JUCE_IOS
 
@@ -94,9 +99,11 @@
  #endif
 
 #elif JUCE_LINUX
+ #include "messages/juce_PendingMessageQueue.h"
  #include "native/juce_linux_Messaging.cpp"
 
 #elif JUCE_ANDROID
+ #include "messages/juce_PendingMessageQueue.h"
  #include "native/juce_android_Messaging.cpp"
 
 #endif
@@ -78,6 +78,7 @@
 #include "broadcasters/juce_ChangeBroadcaster.h"
 #include "timers/juce_Timer.h"
 #include "timers/juce_MultiTimer.h"
+#include "broadcasters/juce_RealtimeMessageChannel.h"
 #include "interprocess/juce_InterprocessConnection.h"
 #include "interprocess/juce_InterprocessConnectionServer.h"
 #include "interprocess/juce_ConnectedChildProcess.h"
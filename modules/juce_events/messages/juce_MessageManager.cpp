@@ -28,6 +28,10 @@ MessageManager::MessageManager() noexcept
 {
     if (JUCEApplicationBase::isStandaloneApp())
         Thread::setCurrentThreadName ("Juce Message Thread");
+
+   #if JUCE_ENABLE_TRACING
+    Tracer::registerCurrentThread ("Message Thread");
+   #endif
 }
 
 MessageManager::~MessageManager() noexcept
@@ -63,11 +67,115 @@ void MessageManager::deleteInstance()
     deleteAndZero (instance);
 }
 
+//==============================================================================
+// Keeps a free list of recently-deleted message blocks for each of a few sizes, so
+// that posting a message usually doesn't need to touch the heap at all. Messages are
+// often created on one thread and deleted on another, which is the worst case for
+// most allocators.
+struct MessageBlockPool
+{
+    enum
+    {
+        numSizeClasses = 4,
+        smallestBlockSize = 64,
+        maxFreeBlocksPerSize = 1024
+    };
+
+    static int getSizeClass (size_t size) noexcept
+    {
+        for (int i = 0; i < numSizeClasses; ++i)
+            if (size <= ((size_t) smallestBlockSize << i))
+                return i;
+
+        return -1;
+    }
+
+    void* allocate (size_t size)
+    {
+        auto sizeClass = getSizeClass (size);
+
+        if (sizeClass >= 0)
+        {
+            auto& list = freeLists[sizeClass];
+
+            {
+                const SpinLock::ScopedLockType sl (list.lock);
+
+                if (auto* block = list.first)
+                {
+                    list.first = block->next;
+                    --list.numBlocks;
+                    return block;
+                }
+            }
+
+            size = (size_t) smallestBlockSize << sizeClass;
+        }
+
+        return ::operator new (size);
+    }
+
+    void release (void* block, size_t size) noexcept
+    {
+        auto sizeClass = getSizeClass (size);
+
+        if (sizeClass >= 0)
+        {
+            auto& list = freeLists[sizeClass];
+            const SpinLock::ScopedLockType sl (list.lock);
+
+            if (list.numBlocks < maxFreeBlocksPerSize)
+            {
+                auto* freeBlock = static_cast<FreeBlock*> (block);
+                freeBlock->next = list.first;
+                list.first = freeBlock;
+                ++list.numBlocks;
+                return;
+            }
+        }
+
+        ::operator delete (block);
+    }
+
+    static MessageBlockPool& getInstance()
+    {
+        // This is never deleted, because messages can still be released during static destruction
+        static auto* pool = new MessageBlockPool();
+        return *pool;
+    }
+
+private:
+    struct FreeBlock  { FreeBlock* next; };
+
+    struct FreeList
+    {
+        SpinLock lock;
+        FreeBlock* first = nullptr;
+        int numBlocks = 0;
+    };
+
+    FreeList freeLists[numSizeClasses];
+};
+
+void* MessageManager::MessageBase::operator new (size_t size)
+{
+    return MessageBlockPool::getInstance().allocate (size);
+}
+
+void MessageManager::MessageBase::operator delete (void* block, size_t size) noexcept
+{
+    MessageBlockPool::getInstance().release (block, size);
+}
+
 //==============================================================================
 bool MessageManager::MessageBase::post()
 {
     auto* mm = MessageManager::instance;
 
+    // (this has to happen before posting, because the message may be delivered and deleted straight away)
+    JUCE_TRACE_FLOW_BEGIN ("Message", this);
+    JUCE_REALTIME_SAFETY_CHECK (messagePosted);
+
     if (mm == nullptr || mm->quitMessagePosted || ! postMessageToSystemQueue (this))
     {
         Ptr deleter (this); // (this will delete messages that were just created with a 0 ref count)
@@ -182,6 +182,19 @@ public:
 
         typedef ReferenceCountedObjectPtr<MessageBase> Ptr;
 
+       #ifndef DOXYGEN
+        // Messages are recycled through a pool of memory blocks rather than going
+        // back to the heap each time, as huge numbers of them can get created.
+        static void* operator new (size_t);
+        static void* operator new (size_t, void* p) noexcept     { return p; }
+        static void operator delete (void*, size_t) noexcept;
+        static void operator delete (void*, void*) noexcept      {}
+       #endif
+
+    private:
+        friend class PendingMessageQueue;
+        MessageBase* nextPendingMessage = nullptr;
+
         JUCE_DECLARE_NON_COPYABLE (MessageBase)
     };
 
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*
+    A lock-free queue of messages waiting to be delivered, which is used by the
+    platforms that run their own message loop.
+
+    The messages are linked together through their own nextPendingMessage pointers,
+    so posting doesn't allocate anything. Any thread can push a message onto the
+    queue, but only the message thread can take them off: it grabs everything that
+    has been posted in one go, so it can deliver a whole batch for each wake-up.
+*/
+class PendingMessageQueue
+{
+public:
+    PendingMessageQueue() noexcept {}
+
+    ~PendingMessageQueue()
+    {
+        takeIncomingMessages();
+
+        while (pop() != nullptr)
+        {}
+    }
+
+    /** Adds a message to the queue, which keeps a reference to it until it's popped.
+        This can be called from any thread. It returns true if the queue of incoming
+        messages was empty, which means that the message thread needs waking up.
+    */
+    bool push (MessageManager::MessageBase* message) noexcept
+    {
+        message->incReferenceCount();
+
+        auto* head = incoming.load (std::memory_order_relaxed);
+
+        do
+        {
+            message->nextPendingMessage = head;
+        }
+        while (! incoming.compare_exchange_weak (head, message, std::memory_order_release, std::memory_order_relaxed));
+
+        return head == nullptr;
+    }
+
+    /** Moves all the messages that have been pushed so far onto the end of the list that
+        pop() takes them from, and returns the number of messages that are now waiting there.
+        This must only be called by the message thread.
+    */
+    int takeIncomingMessages() noexcept
+    {
+        auto* message = incoming.exchange (nullptr, std::memory_order_acquire);
+
+        if (message == nullptr)
+            return numWaiting;
+
+        // The incoming messages are linked newest-first, so reverse them
+        auto* newLast = message;
+        MessageManager::MessageBase* reversed = nullptr;
+
+        while (message != nullptr)
+        {
+            auto* next = message->nextPendingMessage;
+            message->nextPendingMessage = reversed;
+            reversed = message;
+            message = next;
+            ++numWaiting;
+        }
+
+        if (last != nullptr)
+            last->nextPendingMessage = reversed;
+        else
+            first = reversed;
+
+        last = newLast;
+        return numWaiting;
+    }
+
+    /** Removes the oldest message that has been taken by takeIncomingMessages(), or returns
+        nullptr if there aren't any. This must only be called by the message thread.
+    */
+    MessageManager::MessageBase::Ptr pop() noexcept
+    {
+        if (first == nullptr)
+            return nullptr;
+
+        MessageManager::MessageBase::Ptr message (first);
+        first = first->nextPendingMessage;
+
+        if (first == nullptr)
+            last = nullptr;
+
+        message->nextPendingMessage = nullptr;
+        message->decReferenceCount();
+        --numWaiting;
+        return message;
+    }
+
+private:
+    std::atomic<MessageManager::MessageBase*> incoming { nullptr };
+    MessageManager::MessageBase* first = nullptr;
+    MessageManager::MessageBase* last = nullptr;
+    int numWaiting = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (PendingMessageQueue)
+};
+
+} // namespace juce
@@ -88,9 +88,12 @@ struct AndroidMessageQueue     : private Android::Runnable
         jassert (MessageManager::getInstance()->isThisTheMessageThread());
     }
 
-    bool post (MessageManager::MessageBase::Ptr&& message)
+    bool post (MessageManager::MessageBase* message)
     {
-        queue.add (static_cast<MessageManager::MessageBase::Ptr&& > (message));
+        // run() takes everything that's in the queue, so the handler only needs to be
+        // told about the first message of each batch
+        if (! queue.push (message))
+            return true;
 
         // this will call us on the message thread
         return handler.post (self.get());
@@ -100,13 +103,15 @@ private:
 
     void run() override
     {
-        while (true)
+        for (auto numToDispatch = queue.takeIncomingMessages(); --numToDispatch >= 0;)
         {
-            MessageManager::MessageBase::Ptr message (queue.removeAndReturn (0));
+            MessageManager::MessageBase::Ptr message (queue.pop());
 
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_ZONE ("Message dispatch");
+            JUCE_TRACE_FLOW_END ("Message", message.get());
             message->messageCallback();
         }
     }
@@ -114,7 +119,7 @@ private:
     // the this pointer to this class in Java land
     GlobalRef self;
 
-    ReferenceCountedArray<MessageManager::MessageBase, CriticalSection> queue;
+    PendingMessageQueue queue;
     Android::Handler handler;
 };
 
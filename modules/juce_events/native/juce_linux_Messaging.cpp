@@ -41,18 +41,14 @@ public:
         auto ret = ::socketpair (AF_LOCAL, SOCK_STREAM, 0, fd);
         ignoreUnused (ret); jassert (ret == 0);
 
+        // Only one wake-up byte is written per batch of messages, so neither end should ever
+        // block: if the socket's buffer is full, the message thread is already due to wake up.
+        for (auto handle : fd)
+            fcntl (handle, F_SETFL, fcntl (handle, F_GETFL) | O_NONBLOCK);
+
         auto internalQueueCb = [this] (int _fd)
         {
-            if (const MessageManager::MessageBase::Ptr msg = this->popNextMessage (_fd))
-            {
-                JUCE_TRY
-                {
-                    msg->messageCallback();
-                    return true;
-                }
-                JUCE_CATCH_EXCEPTION
-            }
-            return false;
+            return this->dispatchPendingMessages (_fd);
         };
 
         pfds[INTERNAL_QUEUE_FD].fd = getReadHandle();
@@ -71,16 +67,10 @@ public:
     //==============================================================================
     void postMessage (MessageManager::MessageBase* const msg) noexcept
     {
-        ScopedLock sl (lock);
-        queue.add (msg);
-
-        const int maxBytesInSocketQueue = 128;
-
-        if (bytesInSocket < maxBytesInSocketQueue)
+        // The message thread takes everything that's in the queue each time it wakes up,
+        // so it only needs to be woken by the first message of each batch.
+        if (pendingMessages.push (msg))
         {
-            bytesInSocket++;
-
-            ScopedUnlock ul (lock);
             const unsigned char x = 0xff;
             ssize_t bytesWritten = write (getWriteHandle(), &x, 1);
             ignoreUnused (bytesWritten);
@@ -136,32 +126,50 @@ public:
 
 private:
     CriticalSection lock;
-    ReferenceCountedArray <MessageManager::MessageBase> queue;
+    PendingMessageQueue pendingMessages;
     int fd[2];
     pollfd pfds[FD_COUNT];
     ScopedPointer<LinuxEventLoop::CallbackFunctionBase> readCallback[FD_COUNT];
     int fdCount = 1;
     int loopCount = 0;
-    int bytesInSocket = 0;
 
     int getWriteHandle() const noexcept     { return fd[0]; }
     int getReadHandle() const noexcept      { return fd[1]; }
 
-    MessageManager::MessageBase::Ptr popNextMessage (int _fd) noexcept
+    bool dispatchPendingMessages (int readHandle)
     {
-        const ScopedLock sl (lock);
+        // The wake-up bytes must be cleared before taking the messages, so that any
+        // message posted after this point will write a new one.
+        unsigned char buffer[64];
 
-        if (bytesInSocket > 0)
+        while (read (readHandle, buffer, sizeof (buffer)) > 0)
+        {}
+
+        // Only the messages that are waiting now are delivered, so that a stream of new
+        // ones can't stop the window system's events from being handled.
+        auto numToDispatch = pendingMessages.takeIncomingMessages();
+
+        if (numToDispatch == 0)
+            return false;
+
+        while (--numToDispatch >= 0)
         {
-            --bytesInSocket;
+            // (a message callback may run a modal loop which delivers the rest of the batch)
+            const MessageManager::MessageBase::Ptr msg (pendingMessages.pop());
 
-            const ScopedUnlock ul (lock);
-            unsigned char x;
-            ssize_t numBytes = read (_fd, &x, 1);
-            ignoreUnused (numBytes);
+            if (msg == nullptr)
+                break;
+
+            JUCE_TRY
+            {
+                JUCE_TRACE_ZONE ("Message dispatch");
+                JUCE_TRACE_FLOW_END ("Message", msg.get());
+                msg->messageCallback();
+            }
+            JUCE_CATCH_EXCEPTION
         }
 
-        return queue.removeAndReturn (0);
+        return true;
     }
 };
 
@@ -79,6 +79,8 @@ private:
         {
             JUCE_TRY
             {
+                JUCE_TRACE_ZONE ("Message dispatch");
+                JUCE_TRACE_FLOW_END ("Message", nextMessage.get());
                 nextMessage->messageCallback();
             }
             JUCE_CATCH_EXCEPTION
@@ -43,6 +43,8 @@ namespace WindowsMessageHelpers
         {
             JUCE_TRY
             {
+                JUCE_TRACE_ZONE ("Message dispatch");
+                JUCE_TRACE_FLOW_END ("Message", message);
                 message->messageCallback();
             }
             JUCE_CATCH_EXCEPTION
@@ -48,17 +48,11 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         MessageManager::MessageBase::Ptr messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -84,7 +78,7 @@ public:
 
             // don't wait for too long because running this loop also helps keep the
             // Time::getApproximateMillisecondTimer value stay up-to-date
-            wait (jlimit (1, 100, timeUntilFirstTimer));
+            wait ((int) jlimit ((int64) 1, (int64) 100, timeUntilFirstTimer));
         }
     }
 
@@ -95,13 +89,15 @@ public:
 
         const LockType::ScopedLockType sl (lock);
 
-        while (firstTimer != nullptr && firstTimer->timerCountdownMs <= 0)
-        {
-            auto* t = firstTimer;
-            t->timerCountdownMs = t->timerPeriodMs;
+        // (any timer that gets restarted during this batch will be due later than this,
+        // so it can't be called twice in the same message)
+        auto now = getCurrentTime();
 
-            removeTimer (t);
-            addTimer (t);
+        while (timers.size() > 0 && timers.getUnchecked (0)->timerDueTimeMs <= now)
+        {
+            auto* t = timers.getUnchecked (0);
+            t->timerDueTimeMs = getNextDueTime (*t, now);
+            moveTimerDown (0);
 
             const LockType::ScopedUnlockType ul (lock);
 
@@ -149,24 +145,24 @@ public:
     {
         if (instance != nullptr)
         {
-            tim->timerCountdownMs = newCounter;
             tim->timerPeriodMs = newCounter;
-
-            if ((tim->nextTimer != nullptr && tim->nextTimer->timerCountdownMs < tim->timerCountdownMs)
-                 || (tim->previousTimer != nullptr && tim->previousTimer->timerCountdownMs > tim->timerCountdownMs))
-            {
-                instance->removeTimer (tim);
-                instance->addTimer (tim);
-            }
+            tim->timerDueTimeMs = instance->getNextDueTime (*tim, instance->getCurrentTime());
+            instance->timerDueTimeChanged (tim);
         }
     }
 
     static TimerThread* instance;
     static LockType lock;
+    static double displayFrameIntervalMs;
 
 private:
-    Timer* firstTimer = nullptr;
+    // The timers are kept in a binary heap ordered by the time at which they're next due,
+    // and each timer knows its own position in it, so adding, removing or rescheduling
+    // one is O(log n) rather than a walk along a sorted list.
+    Array<Timer*> timers;
     WaitableEvent callbackArrived;
+    int64 currentTime = 0;
+    uint32 lastCounterValue = Time::getMillisecondCounter();
 
     struct CallTimersMessage  : public MessageManager::MessageBase
     {
@@ -180,38 +176,48 @@ private:
     };
 
     //==============================================================================
-    void addTimer (Timer* t) noexcept
+    /** Returns a 64-bit millisecond count that won't wrap around (must be called with the lock held). */
+    int64 getCurrentTime() noexcept
     {
-       #if JUCE_DEBUG
-        // trying to add a timer that's already here - shouldn't get to this point,
-        // so if you get this assertion, let me know!
-        jassert (! timerExists (t));
-       #endif
-
-        auto* i = firstTimer;
+        auto now = Time::getMillisecondCounter();
+        currentTime += (int64) (uint32) (now - lastCounterValue);
+        lastCounterValue = now;
+        return currentTime;
+    }
 
-        if (i == nullptr || i->timerCountdownMs > t->timerCountdownMs)
+    /** Works out when a timer should be called next, lining it up with any other
+        timers in its coalescing group.
+    */
+    int64 getNextDueTime (const Timer& t, int64 now) const noexcept
+    {
+        if (t.timerSyncedToDisplay)
         {
-            t->nextTimer = firstTimer;
-            firstTimer = t;
+            // fire on the first frame boundary after now, then every n frames
+            auto numFrames = jmax (1, roundToInt (t.timerPeriodMs / displayFrameIntervalMs));
+            auto nextFrame = std::floor (now / displayFrameIntervalMs) + numFrames;
+            return (int64) std::ceil (nextFrame * displayFrameIntervalMs);
         }
-        else
-        {
-            while (i->nextTimer != nullptr && i->nextTimer->timerCountdownMs <= t->timerCountdownMs)
-                i = i->nextTimer;
 
-            jassert (i != nullptr);
+        auto due = now + t.timerPeriodMs;
 
-            t->nextTimer = i->nextTimer;
-            t->previousTimer = i;
-            i->nextTimer = t;
-        }
+        if (auto interval = t.timerCoalescingIntervalMs)
+            return ((due + interval - 1) / interval) * interval;
+
+        return due;
+    }
 
-        if (auto* next = t->nextTimer)
-            next->previousTimer = t;
+    void addTimer (Timer* t) noexcept
+    {
+       #if JUCE_DEBUG
+        // trying to add a timer that's already here - shouldn't get to this point,
+        // so if you get this assertion, let me know!
+        jassert (! timerExists (t));
+       #endif
 
-        jassert ((t->nextTimer == nullptr || t->nextTimer->timerCountdownMs >= t->timerCountdownMs)
-                  && (t->previousTimer == nullptr || t->previousTimer->timerCountdownMs <= t->timerCountdownMs));
+        t->timerDueTimeMs = getNextDueTime (*t, getCurrentTime());
+        t->positionInQueue = timers.size();
+        timers.add (t);
+        moveTimerUp (t->positionInQueue);
 
         notify();
     }
@@ -224,32 +230,84 @@ private:
         jassert (timerExists (t));
        #endif
 
-        if (t->previousTimer != nullptr)
+        auto pos = t->positionInQueue;
+        auto* last = timers.removeAndReturn (timers.size() - 1);
+
+        if (last != t)
         {
-            jassert (firstTimer != t);
-            t->previousTimer->nextTimer = t->nextTimer;
+            timers.setUnchecked (pos, last);
+            last->positionInQueue = pos;
+            timerDueTimeChanged (last);
         }
-        else
+
+        t->positionInQueue = -1;
+    }
+
+    void timerDueTimeChanged (Timer* t) noexcept
+    {
+        moveTimerDown (moveTimerUp (t->positionInQueue));
+        notify();
+    }
+
+    int moveTimerUp (int pos) noexcept
+    {
+        auto* t = timers.getUnchecked (pos);
+
+        while (pos > 0)
         {
-            jassert (firstTimer == t);
-            firstTimer = t->nextTimer;
+            auto parentPos = (pos - 1) / 2;
+            auto* parent = timers.getUnchecked (parentPos);
+
+            if (parent->timerDueTimeMs <= t->timerDueTimeMs)
+                break;
+
+            timers.setUnchecked (pos, parent);
+            parent->positionInQueue = pos;
+            pos = parentPos;
         }
 
-        if (t->nextTimer != nullptr)
-            t->nextTimer->previousTimer = t->previousTimer;
+        timers.setUnchecked (pos, t);
+        t->positionInQueue = pos;
+        return pos;
+    }
+
+    void moveTimerDown (int pos) noexcept
+    {
+        auto* t = timers.getUnchecked (pos);
+        auto numTimers = timers.size();
+
+        for (;;)
+        {
+            auto childPos = pos * 2 + 1;
+
+            if (childPos >= numTimers)
+                break;
+
+            if (childPos + 1 < numTimers
+                 && timers.getUnchecked (childPos + 1)->timerDueTimeMs < timers.getUnchecked (childPos)->timerDueTimeMs)
+                ++childPos;
+
+            auto* child = timers.getUnchecked (childPos);
+
+            if (t->timerDueTimeMs <= child->timerDueTimeMs)
+                break;
 
-        t->nextTimer = nullptr;
-        t->previousTimer = nullptr;
+            timers.setUnchecked (pos, child);
+            child->positionInQueue = pos;
+            pos = childPos;
+        }
+
+        timers.setUnchecked (pos, t);
+        t->positionInQueue = pos;
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed) const
+    int64 getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
-        for (auto* t = firstTimer; t != nullptr; t = t->nextTimer)
-            t->timerCountdownMs -= numMillisecsElapsed;
+        auto now = getCurrentTime();
 
-        return firstTimer != nullptr ? firstTimer->timerCountdownMs : 1000;
+        return timers.size() > 0 ? timers.getUnchecked (0)->timerDueTimeMs - now : 1000;
     }
 
     void handleAsyncUpdate() override
@@ -260,11 +318,8 @@ private:
    #if JUCE_DEBUG
     bool timerExists (Timer* t) const noexcept
     {
-        for (auto* tt = firstTimer; tt != nullptr; tt = tt->nextTimer)
-            if (tt == t)
-                return true;
-
-        return false;
+        return isPositiveAndBelow (t->positionInQueue, timers.size())
+                 && timers.getUnchecked (t->positionInQueue) == t;
     }
    #endif
 
@@ -273,6 +328,7 @@ private:
 
 Timer::TimerThread* Timer::TimerThread::instance = nullptr;
 Timer::TimerThread::LockType Timer::TimerThread::lock;
+double Timer::TimerThread::displayFrameIntervalMs = 1000.0 / 60.0;
 
 //==============================================================================
 Timer::Timer() noexcept {}
@@ -293,13 +349,12 @@ void Timer::startTimer (int interval) noexcept
 
     if (timerPeriodMs == 0)
     {
-        timerCountdownMs = interval;
         timerPeriodMs = jmax (1, interval);
         TimerThread::add (this);
     }
     else
     {
-        TimerThread::resetCounter (this, interval);
+        TimerThread::resetCounter (this, jmax (1, interval));
     }
 }
 
@@ -322,34 +377,30 @@ void Timer::stopTimer() noexcept
     }
 }
 
-void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
+void Timer::setTimerCoalescingInterval (int coalescingIntervalMs) noexcept
 {
-    if (TimerThread::instance != nullptr)
-        TimerThread::instance->callTimersSynchronously();
+    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
+    timerCoalescingIntervalMs = jmax (0, coalescingIntervalMs);
 }
 
-struct LambdaInvoker  : private Timer
+void Timer::setTimerSyncedToDisplay (bool shouldBeSynced) noexcept
 {
-    LambdaInvoker (int milliseconds, std::function<void()> f)  : function (f)
-    {
-        startTimer (milliseconds);
-    }
-
-    void timerCallback() override
-    {
-        auto f = function;
-        delete this;
-        f();
-    }
+    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
+    timerSyncedToDisplay = shouldBeSynced;
+}
 
-    std::function<void()> function;
+void JUCE_CALLTYPE Timer::setDisplayRefreshRate (double framesPerSecond) noexcept
+{
+    jassert (framesPerSecond > 0);
 
-    JUCE_DECLARE_NON_COPYABLE (LambdaInvoker)
-};
+    const TimerThread::LockType::ScopedLockType sl (TimerThread::lock);
+    TimerThread::displayFrameIntervalMs = 1000.0 / jmax (1.0, framesPerSecond);
+}
 
-void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, std::function<void()> f)
+void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
 {
-    new LambdaInvoker (milliseconds, f);
+    if (TimerThread::instance != nullptr)
+        TimerThread::instance->callTimersSynchronously();
 }
 
 } // namespace juce
@@ -114,8 +114,57 @@ public:
     int getTimerInterval() const noexcept                   { return timerPeriodMs; }
 
     //==============================================================================
-    /** Invokes a lambda after a given number of milliseconds. */
-    static void JUCE_CALLTYPE callAfterDelay (int milliseconds, std::function<void()> functionToCall);
+    /** Puts this timer into a coalescing group, so that its callbacks are lined up
+        with those of other timers in the same group.
+
+        Each time the timer is scheduled, its next callback time is rounded up to a
+        multiple of the given number of milliseconds. This means that all the timers
+        using the same coalescing interval will become due at exactly the same moments,
+        and get called together in a single batch, rather than waking the message thread
+        separately for each one. The cost is that each callback may be delayed by up to
+        the coalescing interval, so it's best suited to things like meters and animations
+        where a little jitter doesn't matter.
+
+        Pass 0 to turn coalescing off again, which is the default. The change takes effect
+        the next time the timer is scheduled.
+
+        @see setTimerSyncedToDisplay
+    */
+    void setTimerCoalescingInterval (int coalescingIntervalMs) noexcept;
+
+    /** Lines this timer's callbacks up with the display's frame rate.
+
+        When this is enabled, the timer's interval is rounded to a whole number of frames,
+        and its callbacks are made on a shared grid of frame boundaries, so all the timers
+        that are synced to the display will be called together once per frame (or once
+        every few frames). This is handy for animation timers.
+
+        The frame grid is based on the rate that setDisplayRefreshRate() sets, which is
+        60Hz by default - there's no way to lock it to the hardware's actual vertical
+        blank from here, so the phase is arbitrary.
+
+        The change takes effect the next time the timer is scheduled.
+
+        @see setTimerCoalescingInterval, setDisplayRefreshRate
+    */
+    void setTimerSyncedToDisplay (bool shouldBeSynced) noexcept;
+
+    /** Sets the frame rate used by timers that are synced to the display.
+        @see setTimerSyncedToDisplay
+    */
+    static void JUCE_CALLTYPE setDisplayRefreshRate (double framesPerSecond) noexcept;
+
+    //==============================================================================
+    /** Invokes a lambda after a given number of milliseconds.
+
+        The function object is stored inside the timer that invokes it, so unlike a
+        std::function, a large lambda doesn't need a separate heap allocation.
+    */
+    template <typename FunctionType>
+    static void callAfterDelay (int milliseconds, FunctionType functionToCall)
+    {
+        new LambdaInvoker<FunctionType> (milliseconds, std::move (functionToCall));
+    }
 
     //==============================================================================
     /** For internal use only: invokes any timers that need callbacks.
@@ -126,10 +175,36 @@ public:
 private:
     class TimerThread;
     friend class TimerThread;
-    int timerCountdownMs = 0, timerPeriodMs = 0;
-    Timer* previousTimer = {}, *nextTimer = {};
+    template <typename FunctionType> struct LambdaInvoker;
+
+    int64 timerDueTimeMs = 0;
+    int timerPeriodMs = 0, timerCoalescingIntervalMs = 0, positionInQueue = -1;
+    bool timerSyncedToDisplay = false;
 
     Timer& operator= (const Timer&) = delete;
 };
 
+//==============================================================================
+#ifndef DOXYGEN
+template <typename FunctionType>
+struct Timer::LambdaInvoker  : private Timer
+{
+    LambdaInvoker (int milliseconds, FunctionType&& f)  : function (std::move (f))
+    {
+        startTimer (milliseconds);
+    }
+
+    void timerCallback() override
+    {
+        auto f = std::move (function);
+        delete this;
+        f();
+    }
+
+    FunctionType function;
+
+    JUCE_DECLARE_NON_COPYABLE (LambdaInvoker)
+};
+#endif
+
 } // namespace juce
@@ -150,6 +150,12 @@ public:
     */
     int createLookupTable (const AffineTransform& transform, HeapBlock<PixelARGB>& resultLookupTable) const;
 
+    /** Returns the number of entries that createLookupTable() will use for this gradient
+        when it's drawn with the given transform.
+        When calling this, the ColourGradient must have at least 2 colour stops specified.
+    */
+    int getLookupTableSize (const AffineTransform& transform) const noexcept;
+
     /** Creates a set of interpolated premultiplied ARGB values.
         This will fill an array of a user-specified size with the gradient, interpolating to fit.
         The numEntries argument specifies the size of the array, and this size must be greater than zero.
@@ -248,22 +248,26 @@ void Graphics::drawSingleLineText (const String& text, const int startX, const i
         if (flags == Justification::left && startX > context.getClipBounds().getRight())
             return;
 
-        GlyphArrangement arr;
-        arr.addLineOfText (context.getFont(), text, (float) startX, (float) baselineY);
+        typedef ShapedTextCache::Pimpl TextCache;
 
-        if (flags != Justification::left)
+        auto cached = TextCache::getInstance()->getLayout ({ TextCache::Key::singleLine, text, context.getFont(),
+                                                             { (float) startX, (float) baselineY, 0.0f, 0.0f }, flags },
+                                                           [&] (TextCache::CachedText& t)
         {
-            auto w = arr.getBoundingBox (0, -1, true).getWidth();
+            t.glyphs.addLineOfText (context.getFont(), text, (float) startX, (float) baselineY);
 
-            if ((flags & (Justification::horizontallyCentred | Justification::horizontallyJustified)) != 0)
-                w /= 2.0f;
+            if (flags != Justification::left)
+            {
+                auto w = t.glyphs.getBoundingBox (0, -1, true).getWidth();
 
-            arr.draw (*this, AffineTransform::translation (-w, 0));
-        }
-        else
-        {
-            arr.draw (*this);
-        }
+                if ((flags & (Justification::horizontallyCentred | Justification::horizontallyJustified)) != 0)
+                    w /= 2.0f;
+
+                t.glyphs.moveRangeOfGlyphs (0, -1, -w, 0);
+            }
+        });
+
+        cached->glyphs.draw (*this);
     }
 }
 
@@ -273,11 +277,19 @@ void Graphics::drawMultiLineText (const String& text, const int startX,
     if (text.isNotEmpty()
          && startX < context.getClipBounds().getRight())
     {
-        GlyphArrangement arr;
-        arr.addJustifiedText (context.getFont(), text,
-                              (float) startX, (float) baselineY, (float) maximumLineWidth,
-                              Justification::left);
-        arr.draw (*this);
+        typedef ShapedTextCache::Pimpl TextCache;
+
+        auto cached = TextCache::getInstance()->getLayout ({ TextCache::Key::multiLine, text, context.getFont(),
+                                                             { (float) startX, (float) baselineY, (float) maximumLineWidth, 0.0f },
+                                                             Justification::left },
+                                                           [&] (TextCache::CachedText& t)
+        {
+            t.glyphs.addJustifiedText (context.getFont(), text,
+                                       (float) startX, (float) baselineY, (float) maximumLineWidth,
+                                       Justification::left);
+        });
+
+        cached->glyphs.draw (*this);
     }
 }
 
@@ -286,14 +298,23 @@ void Graphics::drawText (const String& text, Rectangle<float> area,
 {
     if (text.isNotEmpty() && context.clipRegionIntersects (area.getSmallestIntegerContainer()))
     {
-        GlyphArrangement arr;
-        arr.addCurtailedLineOfText (context.getFont(), text, 0.0f, 0.0f,
-                                    area.getWidth(), useEllipsesIfTooBig);
-
-        arr.justifyGlyphs (0, arr.getNumGlyphs(),
-                           area.getX(), area.getY(), area.getWidth(), area.getHeight(),
-                           justificationType);
-        arr.draw (*this);
+        typedef ShapedTextCache::Pimpl TextCache;
+
+        TextCache::Key key (TextCache::Key::curtailedLine, text, context.getFont(), area, justificationType.getFlags());
+        key.useEllipses = useEllipsesIfTooBig;
+
+        auto cached = TextCache::getInstance()->getLayout (key, [&] (TextCache::CachedText& t)
+        {
+            auto& arr = t.glyphs;
+            arr.addCurtailedLineOfText (context.getFont(), text, 0.0f, 0.0f,
+                                        area.getWidth(), useEllipsesIfTooBig);
+
+            arr.justifyGlyphs (0, arr.getNumGlyphs(),
+                               area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                               justificationType);
+        });
+
+        cached->glyphs.draw (*this);
     }
 }
 
@@ -316,15 +337,23 @@ void Graphics::drawFittedText (const String& text, Rectangle<int> area,
 {
     if (text.isNotEmpty() && (! area.isEmpty()) && context.clipRegionIntersects (area))
     {
-        GlyphArrangement arr;
-        arr.addFittedText (context.getFont(), text,
-                           (float) area.getX(), (float) area.getY(),
-                           (float) area.getWidth(), (float) area.getHeight(),
-                           justification,
-                           maximumNumberOfLines,
-                           minimumHorizontalScale);
-
-        arr.draw (*this);
+        typedef ShapedTextCache::Pimpl TextCache;
+
+        TextCache::Key key (TextCache::Key::fittedText, text, context.getFont(), area.toFloat(), justification.getFlags());
+        key.maximumNumberOfLines = maximumNumberOfLines;
+        key.minimumHorizontalScale = minimumHorizontalScale;
+
+        auto cached = TextCache::getInstance()->getLayout (key, [&] (TextCache::CachedText& t)
+        {
+            t.glyphs.addFittedText (context.getFont(), text,
+                                    (float) area.getX(), (float) area.getY(),
+                                    (float) area.getWidth(), (float) area.getHeight(),
+                                    justification,
+                                    maximumNumberOfLines,
+                                    minimumHorizontalScale);
+        });
+
+        cached->glyphs.draw (*this);
     }
 }
 
@@ -401,6 +430,12 @@ void Graphics::fillPath (const Path& path, const AffineTransform& transform) con
         context.fillPath (path, transform);
 }
 
+void Graphics::fillPath (const PreparedPath& path, const AffineTransform& transform) const
+{
+    if (! (context.isClipEmpty() || path.isEmpty()))
+        context.fillPreparedPath (path, transform);
+}
+
 void Graphics::strokePath (const Path& path,
                            const PathStrokeType& strokeType,
                            const AffineTransform& transform) const
@@ -432,6 +432,13 @@ public:
     /** Fills a path using the currently selected colour or brush, and adds a transform. */
     void fillPath (const Path& path, const AffineTransform& transform) const;
 
+    /** Fills a PreparedPath using the currently selected colour or brush, and adds a transform.
+        If it's drawn repeatedly with transforms that only differ by a whole number of pixels,
+        the renderer can re-use the shape it made last time.
+        @see PreparedPath
+    */
+    void fillPath (const PreparedPath& path, const AffineTransform& transform = {}) const;
+
     /** Draws a path's outline using the currently selected colour or brush. */
     void strokePath (const Path& path,
                      const PathStrokeType& strokeType,
@@ -89,6 +89,7 @@ public:
     virtual void fillRect (const Rectangle<float>&) = 0;
     virtual void fillRectList (const RectangleList<float>&) = 0;
     virtual void fillPath (const Path&, const AffineTransform&) = 0;
+    virtual void fillPreparedPath (const PreparedPath& p, const AffineTransform& t)  { fillPath (p.getPath(), t); }
     virtual void drawImage (const Image&, const AffineTransform&) = 0;
     virtual void drawLine (const Line<float>&) = 0;
 
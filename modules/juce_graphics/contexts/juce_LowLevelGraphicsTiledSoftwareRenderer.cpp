@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LowLevelGraphicsTiledSoftwareRenderer::TileJob  : public ThreadPoolJob
+{
+    TileJob (LowLevelGraphicsTiledSoftwareRenderer& r)  : ThreadPoolJob ("Tile renderer"), owner (r) {}
+
+    JobStatus runJob() override
+    {
+        owner.renderRemainingTiles();
+        return jobHasFinished;
+    }
+
+    LowLevelGraphicsTiledSoftwareRenderer& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (TileJob)
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> o,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              ThreadPool* threadPoolToUse, int heightOfTiles)
+    : image (imageToRenderOnto), origin (o), region (initialClip),
+      pool (threadPoolToUse), tileHeight (heightOfTiles),
+      state (imageToRenderOnto, o, initialClip)
+{
+    jassert (tileHeight >= 0);
+
+    region.clipTo (imageToRenderOnto.getBounds());
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    // a transparency layer was left open, so its contents will never be composited
+    jassert (transparencyLayerDepth == 0);
+
+    if (transparencyLayerDepth == 0)
+        flush();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    // the operations inside a layer can't be rendered until the layer has been closed
+    jassert (transparencyLayerDepth == 0);
+
+    if (numPendingDrawingOperations == 0 || transparencyLayerDepth != 0)
+        return;
+
+    createTiles();
+
+    int numJobsToStart = 0;
+
+    if (pool != nullptr)
+    {
+        numJobsToStart = jmin (pool->getNumThreads(), tiles.size() - 1);
+
+        while (jobs.size() < numJobsToStart)
+            jobs.add (new TileJob (*this));
+
+        for (int i = 0; i < numJobsToStart; ++i)
+            pool->addJob (jobs.getUnchecked (i), false);
+    }
+
+    renderRemainingTiles();
+
+    // any job that hasn't started yet is removed, and any that's running is waited for
+    for (int i = 0; i < numJobsToStart; ++i)
+        pool->removeJob (jobs.getUnchecked (i), false, -1);
+
+    // the state operations are kept so that later tiles start in the right state
+    operations.removeIf ([] (const Operation& op) { return op.drawsPixels; });
+    numPendingDrawingOperations = 0;
+    containsTransparencyLayer = false;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::createTiles()
+{
+    tiles.clearQuick();
+    nextTile = 0;
+
+    auto bounds = region.getBounds();
+    auto numThreads = (pool != nullptr ? pool->getNumThreads() : 0) + 1;
+
+    // A layer's image starts at the top-left of its clip, and because that origin changes the
+    // rounding of sub-pixel coordinates inside the layer, cutting one up would change the
+    // result slightly. So any batch that contains a layer is drawn as a single tile.
+    if (numThreads == 1 || bounds.getHeight() <= 1 || containsTransparencyLayer)
+    {
+        tiles.add (bounds);
+        return;
+    }
+
+    // a few tiles per thread evens out the load when the drawing isn't spread evenly
+    auto h = tileHeight > 0 ? tileHeight
+                            : jmax (16, (bounds.getHeight() + numThreads * 4 - 1) / (numThreads * 4));
+
+    for (int y = bounds.getY(); y < bounds.getBottom(); y += h)
+    {
+        auto tile = bounds.withTop (y).withHeight (jmin (h, bounds.getBottom() - y));
+
+        if (region.intersects (tile))
+            tiles.add (tile);
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderRemainingTiles()
+{
+    for (;;)
+    {
+        auto index = (++nextTile) - 1;
+
+        if (index >= tiles.size())
+            break;
+
+        renderTile (tiles.getReference (index));
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderTile (const Rectangle<int>& tile) const
+{
+    RectangleList<int> tileClip (region);
+    tileClip.clipTo (tile);
+
+    LowLevelGraphicsSoftwareRenderer renderer (image, origin, tileClip);
+
+    for (auto& op : operations)
+        op.perform (renderer);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addDrawingOperation (std::function<void (LowLevelGraphicsContext&)>&& f)
+{
+    // anything that falls outside the clip can't affect any of the tiles
+    if (! state.isClipEmpty())
+    {
+        operations.add ({ std::move (f), true });
+        ++numPendingDrawingOperations;
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addStateOperation (std::function<void (LowLevelGraphicsContext&)>&& f)
+{
+    f (state);
+    operations.add ({ std::move (f), false });
+}
+
+//==============================================================================
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const           { return false; }
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()   { return state.getPhysicalPixelScaleFactor(); }
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    addStateOperation ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    addStateOperation ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    addStateOperation ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+    return ! state.isClipEmpty();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& list)
+{
+    addStateOperation ([list] (LowLevelGraphicsContext& g) { g.clipToRectangleList (list); });
+    return ! state.isClipEmpty();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    addStateOperation ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    addStateOperation ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    addStateOperation ([im, t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (im, t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)   { return state.clipRegionIntersects (r); }
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const                { return state.getClipBounds(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const                            { return state.isClipEmpty(); }
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    addStateOperation ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    addStateOperation ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    // the tracking state only needs the clip, so it doesn't need a real layer
+    state.saveState();
+    operations.add ({ [opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); }, true });
+    ++transparencyLayerDepth;
+    containsTransparencyLayer = true;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    state.restoreState();
+    operations.add ({ [] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); }, true });
+    --transparencyLayerDepth;
+    ++numPendingDrawingOperations;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    operations.add ({ [fill] (LowLevelGraphicsContext& g) { g.setFill (fill); }, false });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    operations.add ({ [opacity] (LowLevelGraphicsContext& g) { g.setOpacity (opacity); }, false });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    operations.add ({ [quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); }, false });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replace)
+{
+    addDrawingOperation ([r, replace] (LowLevelGraphicsContext& g) { g.fillRect (r, replace); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    addDrawingOperation ([r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    addDrawingOperation ([list] (LowLevelGraphicsContext& g) { g.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    addDrawingOperation ([path, t] (LowLevelGraphicsContext& g) { g.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPreparedPath (const PreparedPath& path, const AffineTransform& t)
+{
+    // (the copy shares the original's cached shape, so the tiles can all re-use it)
+    addDrawingOperation ([path, t] (LowLevelGraphicsContext& g) { g.fillPreparedPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    addDrawingOperation ([im, t] (LowLevelGraphicsContext& g) { g.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    addDrawingOperation ([line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& font)
+{
+    addStateOperation ([font] (LowLevelGraphicsContext& g) { g.setFont (font); });
+}
+
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()
+{
+    return state.getFont();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    addDrawingOperation ([glyphNumber, t] (LowLevelGraphicsContext& g)
+    {
+        // glyphs that miss the glyph cache get their outlines straight from the typeface,
+        // which isn't safe to use from more than one thread at once
+        static CriticalSection typefaceLock;
+        const ScopedLock sl (typefaceLock);
+
+        g.drawGlyph (glyphNumber, t);
+    });
+}
+
+} // namespace juce
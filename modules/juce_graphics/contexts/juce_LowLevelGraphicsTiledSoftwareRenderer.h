@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer that splits its clip region into tiles and rasterises them
+    in parallel.
+
+    Rather than drawing immediately, this context records the drawing operations it's
+    given. When it's deleted (or when flush() is called), the initial clip region is cut
+    into horizontal tiles, and each tile is rendered by replaying the recorded operations
+    into a LowLevelGraphicsSoftwareRenderer that's clipped to it. The tiles are shared
+    between the threads of the ThreadPool you supply and the thread that calls flush(),
+    and because every pixel is still produced by the normal software rasteriser, the
+    result is identical to drawing with a LowLevelGraphicsSoftwareRenderer directly.
+
+    The exception is a batch of operations that uses a transparency layer, which is
+    rendered as a single tile on the calling thread.
+
+    Clip queries (getClipBounds(), clipRegionIntersects(), etc) are answered immediately
+    from a copy of the drawing state, so code that skips work outside the clip behaves
+    exactly as it would with the serial renderer.
+
+    Images that are drawn or used as clip masks are referenced rather than copied, so
+    they mustn't be modified until the context has been flushed.
+
+    User code is not supposed to create instances of this class directly - do all your
+    rendering via the Graphics class instead. To have components rendered this way, see
+    LookAndFeel::setNumSoftwareRenderingThreads().
+
+    @see LowLevelGraphicsSoftwareRenderer
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into a clipped subsection of an image.
+
+        If the pool is null, the tiles are all rendered on the thread that calls flush().
+        If tileHeight is 0, a height is chosen that gives each thread a few tiles to do.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool* threadPoolToUse, int tileHeight = 0);
+
+    /** Destructor. This will flush any operations that haven't yet been rendered. */
+    ~LowLevelGraphicsTiledSoftwareRenderer();
+
+    //==============================================================================
+    /** Renders all the operations recorded so far, and waits for the tiles to finish.
+
+        The drawing state (origin, clip, fill, font, etc) carries on unchanged afterwards.
+        This can't be called while a transparency layer is open.
+    */
+    void flush();
+
+    /** Returns the number of drawing operations that are waiting to be rendered. */
+    int getNumPendingOperations() const noexcept        { return numPendingDrawingOperations; }
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void fillPreparedPath (const PreparedPath&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    struct Operation
+    {
+        std::function<void (LowLevelGraphicsContext&)> perform;
+        bool drawsPixels;
+    };
+
+    struct TileJob;
+
+    Image image;
+    Point<int> origin;
+    RectangleList<int> region;
+    ThreadPool* pool;
+    int tileHeight;
+
+    // tracks the drawing state so that clip queries can be answered while recording
+    LowLevelGraphicsSoftwareRenderer state;
+
+    Array<Operation> operations;
+    int numPendingDrawingOperations = 0, transparencyLayerDepth = 0;
+    bool containsTransparencyLayer = false;
+
+    Array<Rectangle<int>> tiles;
+    Atomic<int> nextTile;
+    OwnedArray<TileJob> jobs;
+
+    void addDrawingOperation (std::function<void (LowLevelGraphicsContext&)>&&);
+    void addStateOperation (std::function<void (LowLevelGraphicsContext&)>&&);
+    void createTiles();
+    void renderRemainingTiles();
+    void renderTile (const Rectangle<int>&) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
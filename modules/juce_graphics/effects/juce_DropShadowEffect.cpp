@@ -27,44 +27,122 @@
 namespace juce
 {
 
-static inline void blurDataTriplets (uint8* d, int num, const int delta) noexcept
+// A stack blur, i.e. two box filters of the same size, one after the other, which
+// together make a triangular kernel. Each box is kept as a running sum, so the cost
+// per pixel doesn't depend on the radius.
+//
+// This blurs numLines lines of length samples at once, stepping along all of them
+// together. For the columns of an image the lines are next to each other in memory,
+// so the inner loops run over contiguous bytes and can be vectorised. The values
+// going in and out of each box are kept in small rings, so the source and
+// destination can be the same.
+struct StackBlur
 {
-    uint32 last = d[0];
-    d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-    d += delta;
-
-    num -= 2;
+    StackBlur (int boxRadiusToUse, int maxNumLines)
+        : boxRadius (boxRadiusToUse),
+          boxSize (2 * boxRadiusToUse + 1),
+          ringSize (boxSize + 1),
+          sum1 ((size_t) maxNumLines), sum2 ((size_t) maxNumLines),
+          boxRing ((size_t) (ringSize * maxNumLines)),
+          sourceRing ((size_t) (ringSize * maxNumLines))
+    {
+        jassert (boxRadius > 0);
+    }
 
-    do
+    void blurLines (uint8* data, int length, int numLines, int sampleStride, int lineStride) noexcept
     {
-        const uint32 newLast = d[0];
-        d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-        d += delta;
-        last = newLast;
+        // (a multiply is much quicker than an integer division, and the sums are
+        // small enough to be held exactly in a float)
+        const auto scale = 1.0f / (float) (boxSize * boxSize);
+
+        zeromem (sum1, sizeof (uint32) * (size_t) numLines);
+        zeromem (sum2, sizeof (uint32) * (size_t) numLines);
+
+        // the first box is centred on position p, and the second one on p - boxRadius,
+        // which is the position that gets written
+        for (int p = -boxRadius; p < length + boxRadius; ++p)
+        {
+            auto slot = (p + boxRadius) % ringSize;
+            auto* box = boxRing + slot * numLines;
+            auto* source = sourceRing + slot * numLines;
+
+            const int incoming = p + boxRadius;
+            const int outgoing = p - boxRadius - 1;
+            const int oldBox = p - boxSize;
+            const int target = p - boxRadius;
+
+            if (incoming < length)
+            {
+                auto* s = data + incoming * sampleStride;
+
+                for (int i = 0; i < numLines; ++i)
+                    sum1[i] += (source[i] = s[i * lineStride]);
+            }
+            else
+            {
+                zeromem (source, (size_t) numLines);
+            }
+
+            if (outgoing >= 0)
+            {
+                auto* old = sourceRing + (outgoing % ringSize) * numLines;
+
+                for (int i = 0; i < numLines; ++i)
+                    sum1[i] -= old[i];
+            }
+
+            for (int i = 0; i < numLines; ++i)
+                sum2[i] += (box[i] = sum1[i]);
+
+            if (oldBox >= -boxRadius)
+            {
+                auto* old = boxRing + ((oldBox + boxRadius) % ringSize) * numLines;
+
+                for (int i = 0; i < numLines; ++i)
+                    sum2[i] -= old[i];
+            }
+
+            if (target >= 0)
+            {
+                auto* d = data + target * sampleStride;
+
+                for (int i = 0; i < numLines; ++i)
+                    d[i * lineStride] = (uint8) ((float) sum2[i] * scale + 0.5f);
+            }
+        }
     }
-    while (--num > 0);
 
-    d[0] = (uint8) ((last + d[0] + 1) / 3);
-}
+    const int boxRadius, boxSize, ringSize;
+    HeapBlock<uint32> sum1, sum2, boxRing;
+    HeapBlock<uint8> sourceRing;
+
+    JUCE_DECLARE_NON_COPYABLE (StackBlur)
+};
 
 static void blurSingleChannelImage (uint8* const data, const int width, const int height,
-                                    const int lineStride, const int repetitions) noexcept
+                                    const int lineStride, const int boxRadius)
 {
     jassert (width > 2 && height > 2);
 
-    for (int y = 0; y < height; ++y)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + lineStride * y, width, 1);
+    // both passes step along all the lines at once, which spreads the cost of
+    // managing the rings over a whole row or column
+    StackBlur blur (boxRadius, jmax (width, height));
 
-    for (int x = 0; x < width; ++x)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + x, height, lineStride);
+    blur.blurLines (data, width, height, 1, lineStride);
+    blur.blurLines (data, height, width, lineStride, 1);
+}
+
+// The shadows used to be made by running a 3-tap blur 2 * radius times, so this picks
+// the stack blur with the closest variance, so that they look the same as before.
+static int getBoxRadiusForShadowRadius (int radius) noexcept
+{
+    return jmax (1, roundToInt ((std::sqrt (8.0 * radius + 1.0) - 1.0) / 2.0));
 }
 
 static void blurSingleChannelImage (Image& image, int radius)
 {
     const Image::BitmapData bm (image, Image::BitmapData::readWrite);
-    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, 2 * radius);
+    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, getBoxRadiusForShadowRadius (radius));
 }
 
 //==============================================================================
@@ -95,29 +173,97 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
     }
 }
 
+static Image renderBlurredPath (const Path& path, Rectangle<int> area, Point<int> offset, int radius)
+{
+    Image renderedPath (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
+
+    {
+        Graphics g2 (renderedPath);
+        g2.setColour (Colours::white);
+        g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
+                                                         (float) (offset.y - area.getY())));
+    }
+
+    blurSingleChannelImage (renderedPath, radius);
+    return renderedPath;
+}
+
+// The shape of the shadow only depends on the path's position relative to its
+// integer bounds, so identical shapes at different whole-pixel positions, like the
+// outlines of a row of buttons, all share the same image.
+static int64 getShadowHashCode (const Path& path, Point<int> origin, int radius)
+{
+    XXHash64 hasher (0x5ad0f1a7e2c4b9d3ULL);
+    hasher.addData (&radius, sizeof (radius));
+
+    auto nonZeroWinding = path.isUsingNonZeroWinding();
+    hasher.addData (&nonZeroWinding, sizeof (nonZeroWinding));
+
+    Path::Iterator i (path);
+    auto ox = (float) origin.x, oy = (float) origin.y;
+
+    while (i.next())
+    {
+        const float element[] = { (float) i.elementType,
+                                  i.x1 - ox, i.y1 - oy, i.x2 - ox, i.y2 - oy, i.x3 - ox, i.y3 - oy };
+
+        // only the points that each type of element uses are hashed, as the others
+        // are left over from previous elements
+        int numPoints = 0;
+
+        switch (i.elementType)
+        {
+            case Path::Iterator::startNewSubPath:
+            case Path::Iterator::lineTo:         numPoints = 1; break;
+            case Path::Iterator::quadraticTo:    numPoints = 2; break;
+            case Path::Iterator::cubicTo:        numPoints = 3; break;
+            default:                             break;
+        }
+
+        hasher.addData (element, sizeof (float) * (size_t) (1 + 2 * numPoints));
+    }
+
+    return (int64) hasher.getResult();
+}
+
 void DropShadow::drawForPath (Graphics& g, const Path& path) const
 {
     jassert (radius > 0);
 
-    const Rectangle<int> area ((path.getBounds().getSmallestIntegerContainer() + offset)
-                                   .expanded (radius + 1)
-                                   .getIntersection (g.getClipBounds().expanded (radius + 1)));
+    auto pathBounds = path.getBounds().getSmallestIntegerContainer();
+    auto fullArea = (pathBounds + offset).expanded (radius + 1);
 
-    if (area.getWidth() > 2 && area.getHeight() > 2)
+    // Shadows of a reasonable size are rendered whole and kept in the ImageCache, so
+    // that they can be reused when the component repaints, whatever the clip region.
+    // Very big ones are only rendered for the part that's visible.
+    const int maxCachedPixels = 512 * 512;
+
+    if (fullArea.getWidth() > 2 && fullArea.getHeight() > 2
+         && fullArea.getWidth() * fullArea.getHeight() <= maxCachedPixels)
     {
-        Image renderedPath (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
+        if (! g.getClipBounds().intersects (fullArea))
+            return;
+
+        auto hashCode = getShadowHashCode (path, pathBounds.getPosition(), radius);
+        auto shadowImage = ImageCache::getFromHashCode (hashCode);
 
+        if (! shadowImage.isValid())
         {
-            Graphics g2 (renderedPath);
-            g2.setColour (Colours::white);
-            g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
-                                                             (float) (offset.y - area.getY())));
+            shadowImage = renderBlurredPath (path, fullArea, offset, radius);
+            ImageCache::addImageToCache (shadowImage, hashCode);
         }
 
-        blurSingleChannelImage (renderedPath, radius);
+        g.setColour (colour);
+        g.drawImageAt (shadowImage, fullArea.getX(), fullArea.getY(), true);
+        return;
+    }
+
+    auto area = fullArea.getIntersection (g.getClipBounds().expanded (radius + 1));
 
+    if (area.getWidth() > 2 && area.getHeight() > 2)
+    {
         g.setColour (colour);
-        g.drawImageAt (renderedPath, area.getX(), area.getY(), true);
+        g.drawImageAt (renderBlurredPath (path, area, offset, radius), area.getX(), area.getY(), true);
     }
 }
 
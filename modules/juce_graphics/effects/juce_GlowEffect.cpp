@@ -39,14 +39,31 @@ void GlowEffect::setGlowProperties (float newRadius, Colour newColour, Point<int
 
 void GlowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor, float alpha)
 {
-    Image temp (image.getFormat(), image.getWidth(), image.getHeight(), true);
-
-    ImageConvolutionKernel blurKernel (roundToInt (radius * scaleFactor * 2.0f));
-
-    blurKernel.createGaussianBlur (radius);
-    blurKernel.rescaleAllValues (radius);
-
-    blurKernel.applyToImage (temp, image, image.getBounds());
+    // only the alpha channel of the glow is drawn, so that's all that needs blurring
+    Image temp (image.convertedToFormat (Image::SingleChannel));
+    temp.duplicateIfShared();
+
+    if (temp.getWidth() > 2 && temp.getHeight() > 2)
+    {
+        const Image::BitmapData bm (temp, Image::BitmapData::readWrite);
+
+        // this used to be a convolution kernel which was as wide as the radius times
+        // the scale factor, so the stack blur's triangle is made to cover the same width
+        blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride,
+                                jmax (1, roundToInt (radius * scaleFactor / 2.0f)));
+
+        // the glow is brightened (or dimmed) in proportion to its radius
+        if (radius != 1.0f)
+        {
+            for (int y = 0; y < bm.height; ++y)
+            {
+                auto* line = bm.getLinePointer (y);
+
+                for (int x = 0; x < bm.width; ++x)
+                    line[x] = (uint8) jmin (255, roundToInt (line[x] * radius));
+            }
+        }
+    }
 
     g.setColour (colour.withMultipliedAlpha (alpha));
     g.drawImageAt (temp, offset.x, offset.y, true);
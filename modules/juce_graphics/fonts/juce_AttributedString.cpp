@@ -346,9 +346,14 @@ void AttributedString::draw (Graphics& g, const Rectangle<float>& area) const
 
         if (! g.getInternalContext().drawTextLayout (*this, area))
         {
-            TextLayout layout;
-            layout.createLayout (*this, area.getWidth());
-            layout.draw (g, area);
+            typedef ShapedTextCache::Pimpl TextCache;
+
+            auto cached = TextCache::getInstance()->getLayout ({ *this, area.getWidth() }, [this, &area] (TextCache::CachedText& t)
+            {
+                t.layout.createLayout (*this, area.getWidth());
+            });
+
+            cached->layout.draw (g, area);
         }
     }
 }
@@ -155,7 +155,8 @@ void CustomTypeface::clear()
     defaultCharacter = 0;
     ascent = 1.0f;
     style = "Regular";
-    zeromem (lookupTable, sizeof (lookupTable));
+    glyphsByCharacter.clear();
+    unavailableCharacters.clear();
     glyphs.clear();
 }
 
@@ -182,10 +183,8 @@ void CustomTypeface::addGlyph (juce_wchar character, const Path& path, float wid
     // Check that you're not trying to add the same character twice..
     jassert (findGlyph (character, false) == nullptr);
 
-    if (isPositiveAndBelow ((int) character, numElementsInArray (lookupTable)))
-        lookupTable [character] = (short) glyphs.size();
-
-    glyphs.add (new GlyphInfo (character, path, width));
+    glyphsByCharacter.set ((int) character, glyphs.add (new GlyphInfo (character, path, width)));
+    unavailableCharacters.remove ((int) character);
 }
 
 void CustomTypeface::addKerningPair (juce_wchar char1, juce_wchar char2, float extraAmount) noexcept
@@ -201,15 +200,18 @@ void CustomTypeface::addKerningPair (juce_wchar char1, juce_wchar char2, float e
 
 CustomTypeface::GlyphInfo* CustomTypeface::findGlyph (juce_wchar character, bool loadIfNeeded) noexcept
 {
-    if (isPositiveAndBelow ((int) character, numElementsInArray (lookupTable)) && lookupTable [character] > 0)
-        return glyphs [(int) lookupTable [(int) character]];
+    if (auto* g = glyphsByCharacter.find ((int) character))
+        return *g;
 
-    for (auto* g : glyphs)
-        if (g->character == character)
-            return g;
+    // Remember the characters that couldn't be loaded, so that text containing them
+    // doesn't keep asking the subclass to look for them again.
+    if (loadIfNeeded && ! unavailableCharacters.contains ((int) character))
+    {
+        if (loadGlyphIfPossible (character))
+            return findGlyph (character, false);
 
-    if (loadIfNeeded && loadGlyphIfPossible (character))
-        return findGlyph (character, false);
+        unavailableCharacters.add ((int) character);
+    }
 
     return nullptr;
 }
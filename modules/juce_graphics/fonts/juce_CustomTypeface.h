@@ -155,7 +155,8 @@ private:
     class GlyphInfo;
     friend struct ContainerDeletePolicy<GlyphInfo>;
     OwnedArray<GlyphInfo> glyphs;
-    short lookupTable [128];
+    FlatHashMap<int, GlyphInfo*> glyphsByCharacter;
+    FlatHashSet<int> unavailableCharacters;
 
     GlyphInfo* findGlyph (const juce_wchar character, bool loadIfNeeded) noexcept;
 
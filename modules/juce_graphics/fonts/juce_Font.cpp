@@ -169,6 +169,7 @@ void (*clearOpenGLGlyphCache)() = nullptr;
 void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
+    ShapedTextCache::clear();
 
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ShapedTextCache::Pimpl  : private DeletedAtShutdown
+{
+    Pimpl() {}
+    ~Pimpl() { clearSingletonInstance(); }
+
+    juce_DeclareSingleton (ShapedTextCache::Pimpl, false)
+
+    //==============================================================================
+    /** Everything that the layout of a piece of text depends on. */
+    struct Key
+    {
+        enum Kind
+        {
+            singleLine,
+            multiLine,
+            curtailedLine,
+            fittedText,
+            attributedText
+        };
+
+        Key (Kind k, const String& t, const Font& f, Rectangle<float> a, int justificationFlags) noexcept
+            : kind (k), text (t), font (f), area (a), justification (justificationFlags)
+        {
+        }
+
+        Key (const AttributedString& s, float width)
+            : kind (attributedText), text (s.getText()), area (0, 0, width, 0),
+              justification (s.getJustification().getFlags()), attributedString (s)
+        {
+        }
+
+        int64 getHashCode() const noexcept
+        {
+            auto h = text.hashCode64();
+
+            auto addToHash = [&h] (int64 value) noexcept  { h = h * 101 + value; };
+            auto addFloatToHash = [&] (float value) noexcept  { addToHash (roundToInt (value * 64.0f)); };
+
+            addToHash (kind);
+            addToHash (justification);
+            addToHash (maximumNumberOfLines);
+            addToHash (useEllipses ? 1 : 0);
+            addFloatToHash (area.getX());
+            addFloatToHash (area.getY());
+            addFloatToHash (area.getWidth());
+            addFloatToHash (area.getHeight());
+            addFloatToHash (minimumHorizontalScale);
+
+            if (kind == attributedText)
+            {
+                addToHash (attributedString.getNumAttributes());
+                addFloatToHash (attributedString.getLineSpacing());
+
+                for (int i = 0; i < attributedString.getNumAttributes(); ++i)
+                {
+                    auto& attribute = attributedString.getAttribute (i);
+                    addToHash (attribute.range.getEnd());
+                    addToHash ((int64) attribute.colour.getARGB());
+                    addFloatToHash (attribute.font.getHeight());
+                }
+            }
+            else
+            {
+                addFloatToHash (font.getHeight());
+            }
+
+            return h;
+        }
+
+        bool operator== (const Key& other) const noexcept
+        {
+            return kind == other.kind
+                    && text == other.text
+                    && area == other.area
+                    && justification == other.justification
+                    && maximumNumberOfLines == other.maximumNumberOfLines
+                    && minimumHorizontalScale == other.minimumHorizontalScale
+                    && useEllipses == other.useEllipses
+                    && (kind == attributedText ? haveSameAttributes (attributedString, other.attributedString)
+                                               : font == other.font);
+        }
+
+        static bool haveSameAttributes (const AttributedString& a, const AttributedString& b) noexcept
+        {
+            if (a.getNumAttributes() != b.getNumAttributes()
+                 || a.getWordWrap() != b.getWordWrap()
+                 || a.getReadingDirection() != b.getReadingDirection()
+                 || a.getLineSpacing() != b.getLineSpacing())
+                return false;
+
+            for (int i = 0; i < a.getNumAttributes(); ++i)
+            {
+                auto& a1 = a.getAttribute (i);
+                auto& a2 = b.getAttribute (i);
+
+                if (a1.range != a2.range || a1.colour != a2.colour || a1.font != a2.font)
+                    return false;
+            }
+
+            return true;
+        }
+
+        Kind kind;
+        String text;
+        Font font;
+        Rectangle<float> area;
+        int justification, maximumNumberOfLines = 0;
+        float minimumHorizontalScale = 0;
+        bool useEllipses = false;
+        AttributedString attributedString;
+    };
+
+    //==============================================================================
+    struct CachedText  : public ReferenceCountedObject
+    {
+        CachedText (const Key& k) : key (k) {}
+
+        typedef ReferenceCountedObjectPtr<CachedText> Ptr;
+
+        const Key key;
+        GlyphArrangement glyphs;
+        TextLayout layout;
+        uint32 lastUsed = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (CachedText)
+    };
+
+    /** Returns the cached layout for a key, or calls createLayout (CachedText&) to make
+        a new one if there isn't one.
+
+        The layout that's returned mustn't be modified, as other threads may be drawing it.
+    */
+    template <typename CreateLayoutFn>
+    CachedText::Ptr getLayout (const Key& key, CreateLayoutFn&& createLayout)
+    {
+        auto hash = key.getHashCode();
+
+        {
+            const ScopedLock sl (lock);
+
+            if (auto* text = entries[hash].get())
+            {
+                if (text->key == key)
+                {
+                    text->lastUsed = ++counter;
+                    return text;
+                }
+            }
+        }
+
+        // The layout is created outside the lock, so that threads drawing other text
+        // don't have to wait for it.
+        CachedText::Ptr text (new CachedText (key));
+        createLayout (*text);
+
+        const ScopedLock sl (lock);
+
+        if (maxNumEntries > 0)
+        {
+            text->lastUsed = ++counter;
+            entries.set (hash, text);
+
+            if (entries.size() > maxNumEntries)
+                removeLeastRecentlyUsed();
+        }
+
+        return text;
+    }
+
+    void setMaxNumEntries (int newMax)
+    {
+        const ScopedLock sl (lock);
+        maxNumEntries = newMax;
+
+        if (maxNumEntries <= 0)
+            entries.clear();
+        else if (entries.size() > maxNumEntries)
+            removeLeastRecentlyUsed();
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        entries.clear();
+    }
+
+private:
+    HashMap<int64, CachedText::Ptr> entries;
+    CriticalSection lock;
+    int maxNumEntries = 1000;
+    uint32 counter = 0;
+
+    void removeLeastRecentlyUsed()
+    {
+        // Throwing away the oldest quarter at a time means that the sort only
+        // has to happen every few hundred new layouts.
+        Array<uint32> usage;
+        usage.ensureStorageAllocated (entries.size());
+
+        for (HashMap<int64, CachedText::Ptr>::Iterator i (entries); i.next();)
+            usage.add (i.getValue()->lastUsed);
+
+        usage.sort();
+        auto numToKeep = jmin (maxNumEntries, (maxNumEntries * 3) / 4 + 1);
+        auto threshold = usage[usage.size() - numToKeep];
+
+        Array<int64> keysToRemove;
+
+        for (HashMap<int64, CachedText::Ptr>::Iterator i (entries); i.next();)
+            if (i.getValue()->lastUsed < threshold)
+                keysToRemove.add (i.getKey());
+
+        for (auto key : keysToRemove)
+            entries.remove (key);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
+
+juce_ImplementSingleton (ShapedTextCache::Pimpl)
+
+//==============================================================================
+void ShapedTextCache::setMaxNumEntries (int maxNumEntries)
+{
+    Pimpl::getInstance()->setMaxNumEntries (maxNumEntries);
+}
+
+void ShapedTextCache::clear()
+{
+    if (auto* pimpl = Pimpl::getInstanceWithoutCreating())
+        pimpl->clear();
+}
+
+} // namespace juce
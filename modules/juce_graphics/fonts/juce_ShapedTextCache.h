@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A global cache of the glyph layouts that Graphics uses to draw text.
+
+    Laying out a string means looking up the positions of its glyphs in the typeface,
+    and then curtailing, fitting or justifying them into the space available, which
+    is a large part of the cost of drawing text. As most components draw the same
+    text in the same place every time they're painted, Graphics::drawText(),
+    drawFittedText(), drawSingleLineText(), drawMultiLineText() and AttributedString::draw()
+    keep the layouts they make in this cache, and re-use them until any of the
+    text, font, area or justification changes.
+
+    The layouts are kept in the coordinates they were drawn at, (before the
+    Graphics object's transform is applied), so a component that's moved around
+    doesn't need its text laying out again. When the cache is full, the layouts
+    that haven't been drawn for the longest time are thrown away first.
+
+    @see GlyphArrangement, TextLayout
+*/
+class JUCE_API  ShapedTextCache
+{
+public:
+    //==============================================================================
+    /** Changes the number of layouts that the cache will keep.
+
+        The default is 1000, which is enough for the labels of a fairly busy UI. Passing
+        0 turns the cache off, so that text is laid out again every time it's drawn.
+    */
+    static void setMaxNumEntries (int maxNumEntries);
+
+    /** Throws away all the layouts in the cache.
+
+        This is done for you by Typeface::clearTypefaceCache(), as the layouts refer to
+        the typefaces that were used to make them.
+    */
+    static void clear();
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    friend struct Pimpl;
+    friend class Graphics;
+    friend class AttributedString;
+
+    ShapedTextCache();
+    ~ShapedTextCache();
+
+    JUCE_DECLARE_NON_COPYABLE (ShapedTextCache)
+};
+
+} // namespace juce
@@ -91,10 +91,9 @@ EdgeTable::EdgeTable (Rectangle<int> area, const Path& path, const AffineTransfo
                     auto step = jmin (stepSize, y2 - y1, 256 - (y1 & 255));
                     auto x = roundToInt (startX + multiplier * ((y1 + (step >> 1)) - startY));
 
-                    if (x < leftLimit)
-                        x = leftLimit;
-                    else if (x >= rightLimit)
-                        x = rightLimit - 1;
+                    // (clamping to the exact limits means that the coverage of the pixels
+                    // inside the bounds doesn't depend on how far the bounds extend)
+                    x = jlimit (leftLimit, rightLimit, x);
 
                     addEdgePoint (x, y1 >> 8, direction * step);
                     y1 += step;
@@ -303,6 +302,11 @@ void EdgeTable::allocate()
     table.malloc (getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()));
 }
 
+size_t EdgeTable::getNumBytesAllocated() const noexcept
+{
+    return getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()) * sizeof (int);
+}
+
 void EdgeTable::clearLineSizes() noexcept
 {
     int* t = table;
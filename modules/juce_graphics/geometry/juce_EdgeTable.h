@@ -90,6 +90,9 @@ public:
     */
     void optimiseTable();
 
+    /** Returns the approximate number of bytes that the table's data is using. */
+    size_t getNumBytesAllocated() const noexcept;
+
 
     //==============================================================================
     /** Iterates the lines in the table, for rendering.
@@ -121,7 +124,7 @@ public:
             if (--numPoints > 0)
             {
                 int x = *++line;
-                jassert ((x >> 8) >= bounds.getX() && (x >> 8) < bounds.getRight());
+                jassert ((x >> 8) >= bounds.getX() && (x >> 8) <= bounds.getRight());
                 int levelAccumulator = 0;
 
                 iterationCallback.setEdgeTableYPos (bounds.getY() + y);
@@ -162,8 +165,15 @@ public:
                             jassert (endOfRun <= bounds.getRight());
                             const int numPix = endOfRun - ++x;
 
+                            // (full runs are sent to the same callback as full pixels, so that the
+                            // result doesn't depend on where a run happens to have been split)
                             if (numPix > 0)
-                                iterationCallback.handleEdgeTableLine (x, numPix, level);
+                            {
+                                if (level >= 255)
+                                    iterationCallback.handleEdgeTableLineFull (x, numPix);
+                                else
+                                    iterationCallback.handleEdgeTableLine (x, numPix, level);
+                            }
                         }
 
                         // save the bit at the end to be drawn next time round the loop.
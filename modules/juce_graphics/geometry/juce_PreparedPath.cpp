@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The path is never changed once it's been shared, so only the cached shape needs a lock
+struct PreparedPath::SharedPath  : public ReferenceCountedObject
+{
+    SharedPath() {}
+    SharedPath (const Path& p) : path (p) {}
+
+    Path path;
+    PreparedPath::RenderedShape::Ptr lastShape;
+    SpinLock lock;
+
+    JUCE_DECLARE_NON_COPYABLE (SharedPath)
+};
+
+static Rectangle<int> getRenderedShapeBounds (const Path& path, const AffineTransform& transform)
+{
+    return path.getBoundsTransformed (transform).getSmallestIntegerContainer().expanded (1);
+}
+
+// True if the shapes for these transforms would only be a whole number of pixels apart
+static bool canTranslateShape (const AffineTransform& from, const AffineTransform& to, Point<int>& offset) noexcept
+{
+    if (from.mat00 != to.mat00 || from.mat01 != to.mat01
+         || from.mat10 != to.mat10 || from.mat11 != to.mat11)
+        return false;
+
+    auto dx = to.mat02 - from.mat02;
+    auto dy = to.mat12 - from.mat12;
+
+    if (dx != std::floor (dx) || dy != std::floor (dy)
+         || std::abs (dx) > 0x100000 || std::abs (dy) > 0x100000)
+        return false;
+
+    offset = Point<int> ((int) dx, (int) dy);
+    return true;
+}
+
+//==============================================================================
+PreparedPath::RenderedShape::RenderedShape (const Path& path, const AffineTransform& t)
+    : transform (t), edgeTable (getRenderedShapeBounds (path, t), path, t)
+{
+}
+
+//==============================================================================
+PreparedPath::PreparedPath() noexcept {}
+PreparedPath::~PreparedPath() {}
+
+PreparedPath::PreparedPath (const Path& pathToFill)
+{
+    setPath (pathToFill);
+}
+
+PreparedPath::PreparedPath (const Path& pathToStroke, const PathStrokeType& strokeType, float extraAccuracy)
+{
+    setStrokedPath (pathToStroke, strokeType, extraAccuracy);
+}
+
+PreparedPath::PreparedPath (const PreparedPath& other) noexcept  : shared (other.shared) {}
+
+PreparedPath& PreparedPath::operator= (const PreparedPath& other) noexcept
+{
+    shared = other.shared;
+    return *this;
+}
+
+void PreparedPath::setPath (const Path& pathToFill)
+{
+    shared = pathToFill.isEmpty() ? nullptr : new SharedPath (pathToFill);
+}
+
+void PreparedPath::setStrokedPath (const Path& pathToStroke, const PathStrokeType& strokeType, float extraAccuracy)
+{
+    Path stroke;
+    strokeType.createStrokedPath (stroke, pathToStroke, AffineTransform(), extraAccuracy);
+    setPath (stroke);
+}
+
+void PreparedPath::clear() noexcept
+{
+    shared = nullptr;
+}
+
+bool PreparedPath::isEmpty() const noexcept
+{
+    return shared == nullptr;
+}
+
+const Path& PreparedPath::getPath() const noexcept
+{
+    static const Path emptyPath;
+    return shared != nullptr ? shared->path : emptyPath;
+}
+
+PreparedPath::RenderedShape::Ptr PreparedPath::getRenderedShape (const AffineTransform& transform, Point<int>& offset) const
+{
+    offset = {};
+
+    if (shared == nullptr)
+        return nullptr;
+
+    {
+        const SpinLock::ScopedLockType sl (shared->lock);
+
+        if (auto* last = shared->lastShape.get())
+            if (canTranslateShape (last->transform, transform, offset))
+                return last;
+    }
+
+    // (this is done outside the lock, as it's the slow part)
+    RenderedShape::Ptr newShape (new RenderedShape (shared->path, transform));
+
+    const SpinLock::ScopedLockType sl (shared->lock);
+    shared->lastShape = newShape;
+    return newShape;
+}
+
+} // namespace juce
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a path that's ready to be drawn over and over again.
+
+    Each time Graphics::fillPath() or Graphics::strokePath() is called, the path has
+    to be stroked (for an outline), then flattened and rasterised into an EdgeTable.
+    For shapes that get redrawn on every paint without changing, like the arcs of a
+    rotary slider or a waveform outline, a PreparedPath lets all that work be done
+    once: it strokes the path when it's created, and keeps the rasterised shape from
+    the last time it was drawn. If it's drawn again with the same transform, or one
+    that only differs by a whole number of pixels, the cached shape is just moved into
+    place instead of being rebuilt.
+
+    E.g.
+    @code
+    // in resized()
+    outline = PreparedPath (waveformPath, PathStrokeType (1.5f));
+
+    // in paint()
+    g.fillPath (outline);
+    g.fillPath (outline, AffineTransform::translation (0.0f, 20.0f));  // cheap - reuses the cached shape
+    @endcode
+
+    PreparedPath objects are cheap to copy: copies share the same path and cached
+    shape, and a renderer that draws on several threads can safely use the same one.
+    Calling setPath() or setStrokedPath() replaces the path for this object only.
+
+    Renderers that can't use the cached shape just fill the path, so drawing a
+    PreparedPath always gives the same result as filling getPath().
+
+    @see Graphics::fillPath, Path, PathStrokeType
+*/
+class JUCE_API  PreparedPath
+{
+public:
+    //==============================================================================
+    /** Creates an empty PreparedPath. */
+    PreparedPath() noexcept;
+
+    /** Creates a PreparedPath that will fill a path. */
+    explicit PreparedPath (const Path& pathToFill);
+
+    /** Creates a PreparedPath that will draw the outline of a path.
+        The stroke is created straight away, in the path's own coordinate space.
+        @see setStrokedPath
+    */
+    PreparedPath (const Path& pathToStroke, const PathStrokeType& strokeType, float extraAccuracy = 1.0f);
+
+    /** Creates a copy that shares the other object's path and cached shape. */
+    PreparedPath (const PreparedPath&) noexcept;
+
+    /** Makes this object share another one's path and cached shape. */
+    PreparedPath& operator= (const PreparedPath&) noexcept;
+
+    /** Destructor. */
+    ~PreparedPath();
+
+    //==============================================================================
+    /** Replaces the path with one that will be filled. */
+    void setPath (const Path& pathToFill);
+
+    /** Replaces the path with the outline of a stroked path.
+        The extraAccuracy parameter is passed on to PathStrokeType::createStrokedPath(),
+        so if the shape's going to be drawn scaled-up, you can use a larger value to keep
+        its curves smooth.
+    */
+    void setStrokedPath (const Path& pathToStroke, const PathStrokeType& strokeType, float extraAccuracy = 1.0f);
+
+    /** Clears the path. */
+    void clear() noexcept;
+
+    /** Returns true if there's nothing to draw. */
+    bool isEmpty() const noexcept;
+
+    /** Returns the shape that gets filled. For a stroked path, this is the outline of the stroke. */
+    const Path& getPath() const noexcept;
+
+    //==============================================================================
+    /** A rasterised version of the path, as used by the software renderers. */
+    struct RenderedShape  : public ReferenceCountedObject
+    {
+        RenderedShape (const Path&, const AffineTransform&);
+
+        typedef ReferenceCountedObjectPtr<RenderedShape> Ptr;
+
+        const AffineTransform transform;
+        const EdgeTable edgeTable;
+    };
+
+    /** Returns the path rasterised with the given transform.
+
+        If the shape that was returned last time was made with the same transform, or
+        one that only differs by a whole number of pixels, it's returned again, and the
+        offset is set to the distance it needs to be moved by. Otherwise a new one is made,
+        and the offset is set to zero.
+
+        This is used by the renderers, and is safe to call from several threads at once.
+        It'll return nullptr if the path is empty.
+    */
+    RenderedShape::Ptr getRenderedShape (const AffineTransform& transform, Point<int>& offset) const;
+
+private:
+    //==============================================================================
+    struct SharedPath;
+    ReferenceCountedObjectPtr<SharedPath> shared;
+
+    JUCE_LEAK_DETECTOR (PreparedPath)
+};
+
+} // namespace juce
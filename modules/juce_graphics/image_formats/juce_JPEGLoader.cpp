@@ -258,6 +258,15 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 {
 #if JUCE_USING_COREIMAGE_LOADER
     return juce_loadWithCoreImage (in);
+#else
+    return decodeImageWithOptions (in, {});
+#endif
+}
+
+Image JPEGImageFormat::decodeImageWithOptions (InputStream& in, const DecodingOptions& options)
+{
+#if JUCE_USING_COREIMAGE_LOADER
+    return ImageFileFormat::decodeImageWithOptions (in, options);
 #else
     using namespace jpeglibNamespace;
     using namespace JPEGHelpers;
@@ -296,6 +305,18 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            // the decoder can shrink the image by 2, 4 or 8 as part of the DCT, which is
+            // much quicker than decoding the whole thing
+            auto factor = options.getDownscaleFactor ((int) jpegDecompStruct.image_width,
+                                                      (int) jpegDecompStruct.image_height, 8);
+            unsigned int scale = 1;
+
+            while (scale * 2 <= (unsigned int) factor)
+                scale *= 2;
+
+            jpegDecompStruct.scale_num = 1;
+            jpegDecompStruct.scale_denom = scale;
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -312,7 +333,9 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
                 if (jpeg_start_decompress (&jpegDecompStruct) && ! hasFailed)
                 {
-                    image = Image (Image::RGB, width, height, false);
+                    NativeImageType nativeType;
+                    image = Image (Image::RGB, width, height, false,
+                                   options.imageType != nullptr ? *options.imageType : nativeType);
                     image.getProperties()->set ("originalImageHadAlpha", false);
                     const bool hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
 
@@ -332,8 +355,8 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
                         {
                             for (int i = width; --i >= 0;)
                             {
+                                // (opaque, so there's no need to premultiply)
                                 ((PixelARGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
-                                ((PixelARGB*) dest)->premultiply();
                                 dest += destData.pixelStride;
                                 src += 3;
                             }
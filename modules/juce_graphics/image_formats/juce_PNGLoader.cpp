@@ -375,45 +375,66 @@ namespace PNGHelpers
         return false;
     }
 
-    static bool readImageData (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf, png_bytepp rows) noexcept
+    // Takes the RGBA rows that libpng produces, and writes them into an image, premultiplying
+    // them and averaging each block of pixels if the image is being shrunk.
+    struct RowWriter
     {
-        if (setjmp (errorJumpBuf) == 0)
+        RowWriter (const Image::BitmapData& d, bool alpha, int downscaleFactor)
+            : destData (d), hasAlphaChan (alpha), factor (downscaleFactor)
         {
-            if (png_get_valid (pngReadStruct, pngInfoStruct, PNG_INFO_tRNS))
-                png_set_expand (pngReadStruct);
+            if (factor > 1)
+                totals.calloc ((size_t) (destData.width * 4));
+        }
 
-            png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+        void addRow (int y, const uint8* src) noexcept
+        {
+            if (factor == 1)
+            {
+                writeRow (destData.getLinePointer (y), src);
+                return;
+            }
 
-            png_read_image (pngReadStruct, rows);
-            png_read_end (pngReadStruct, pngInfoStruct);
-            return true;
-        }
+            if (y >= destData.height * factor)
+                return;
 
-        return false;
-    }
+            auto* total = totals.get();
 
-   #if JUCE_MSVC
-    #pragma warning (pop)
-   #endif
+            for (int x = 0; x < destData.width; ++x)
+            {
+                for (int i = 0; i < factor; ++i)
+                {
+                    PixelARGB p;
+                    p.setARGB (hasAlphaChan ? src[3] : (uint8) 0xff, src[0], src[1], src[2]);
+                    p.premultiply();
+
+                    total[0] += p.getAlpha();
+                    total[1] += p.getRed();
+                    total[2] += p.getGreen();
+                    total[3] += p.getBlue();
+                    src += 4;
+                }
 
-    static Image createImageFromData (bool hasAlphaChan, int width, int height, png_bytepp rows)
-    {
-        // now convert the data to a juce image format..
-        Image image (hasAlphaChan ? Image::ARGB : Image::RGB, width, height, hasAlphaChan);
+                total += 4;
+            }
 
-        image.getProperties()->set ("originalImageHadAlpha", image.hasAlphaChannel());
-        hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
+            if ((y % factor) == factor - 1)
+            {
+                writeTotals (destData.getLinePointer (y / factor));
+                zeromem (totals, (size_t) destData.width * 4 * sizeof (uint32));
+            }
+        }
 
-        const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+    private:
+        const Image::BitmapData& destData;
+        const bool hasAlphaChan;
+        const int factor;
+        HeapBlock<uint32> totals;
 
-        for (int y = 0; y < (int) height; ++y)
+        void writeRow (uint8* dest, const uint8* src) const noexcept
         {
-            const uint8* src = rows[y];
-            uint8* dest = destData.getLinePointer (y);
-
             if (hasAlphaChan)
             {
-                for (int i = (int) width; --i >= 0;)
+                for (int i = destData.width; --i >= 0;)
                 {
                     ((PixelARGB*) dest)->setARGB (src[3], src[0], src[1], src[2]);
                     ((PixelARGB*) dest)->premultiply();
@@ -423,7 +444,7 @@ namespace PNGHelpers
             }
             else
             {
-                for (int i = (int) width; --i >= 0;)
+                for (int i = destData.width; --i >= 0;)
                 {
                     ((PixelRGB*) dest)->setARGB (0, src[0], src[1], src[2]);
                     dest += destData.pixelStride;
@@ -432,10 +453,103 @@ namespace PNGHelpers
             }
         }
 
-        return image;
+        void writeTotals (uint8* dest) const noexcept
+        {
+            auto numPixels = (uint32) (factor * factor);
+            auto* total = totals.get();
+
+            for (int i = destData.width; --i >= 0;)
+            {
+                auto a = (uint8) ((total[0] + numPixels / 2) / numPixels);
+                auto r = (uint8) ((total[1] + numPixels / 2) / numPixels);
+                auto g = (uint8) ((total[2] + numPixels / 2) / numPixels);
+                auto b = (uint8) ((total[3] + numPixels / 2) / numPixels);
+
+                if (hasAlphaChan)
+                    ((PixelARGB*) dest)->setARGB (a, r, g, b);
+                else
+                    ((PixelRGB*) dest)->setARGB (0, r, g, b);
+
+                dest += destData.pixelStride;
+                total += 4;
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (RowWriter)
+    };
+
+    // When the image's pixels are laid out the same way as one of libpng's output formats,
+    // the rows can be decoded straight into the image.
+    static bool canDecodeDirectly (const Image::BitmapData& destData, bool hasAlphaChan) noexcept
+    {
+        if (hasAlphaChan)
+            return destData.pixelStride == 4 && PixelARGB::indexA == 3
+                    && (PixelARGB::indexR == 0 || PixelARGB::indexR == 2);
+
+        return destData.pixelStride == 3 && (PixelRGB::indexR == 0 || PixelRGB::indexR == 2);
     }
 
-    static Image readImage (InputStream& in, png_structp pngReadStruct, png_infop pngInfoStruct)
+    static bool readImageData (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf,
+                               const Image::BitmapData& destData, bool hasAlphaChan, bool decodeDirectly,
+                               uint8* rowBuffer, png_bytepp rows, int height, RowWriter& writer) noexcept
+    {
+        if (setjmp (errorJumpBuf) == 0)
+        {
+            if (png_get_valid (pngReadStruct, pngInfoStruct, PNG_INFO_tRNS))
+                png_set_expand (pngReadStruct);
+
+            if (decodeDirectly)
+            {
+                if ((hasAlphaChan ? (int) PixelARGB::indexR : (int) PixelRGB::indexR) == 2)
+                    png_set_bgr (pngReadStruct);
+
+                if (hasAlphaChan)
+                    png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+
+                for (int y = 0; y < height; ++y)
+                {
+                    auto* line = destData.getLinePointer (y);
+                    png_read_row (pngReadStruct, line, nullptr);
+
+                    if (hasAlphaChan)
+                        for (int x = 0; x < destData.width; ++x)
+                            ((PixelARGB*) line)[x].premultiply();
+                }
+            }
+            else
+            {
+                png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+
+                if (rows == nullptr)
+                {
+                    for (int y = 0; y < height; ++y)
+                    {
+                        png_read_row (pngReadStruct, rowBuffer, nullptr);
+                        writer.addRow (y, rowBuffer);
+                    }
+                }
+                else
+                {
+                    png_read_image (pngReadStruct, rows);
+
+                    for (int y = 0; y < height; ++y)
+                        writer.addRow (y, rows[y]);
+                }
+            }
+
+            png_read_end (pngReadStruct, pngInfoStruct);
+            return true;
+        }
+
+        return false;
+    }
+
+   #if JUCE_MSVC
+    #pragma warning (pop)
+   #endif
+
+    static Image readImage (InputStream& in, png_structp pngReadStruct, png_infop pngInfoStruct,
+                            const ImageFileFormat::DecodingOptions& options)
     {
         jmp_buf errorJumpBuf;
         png_set_error_fn (pngReadStruct, &errorJumpBuf, errorCallback, warningCallback);
@@ -446,34 +560,60 @@ namespace PNGHelpers
         if (readHeader (in, pngReadStruct, pngInfoStruct, errorJumpBuf,
                         width, height, bitDepth, colorType, interlaceType))
         {
-            // Load the image into a temp buffer..
-            const size_t lineStride = width * 4;
-            HeapBlock<uint8> tempBuffer (height * lineStride);
-            HeapBlock<png_bytep> rows (height);
-
-            for (size_t y = 0; y < height; ++y)
-                rows[y] = (png_bytep) (tempBuffer + lineStride * y);
-
             png_bytep trans_alpha = nullptr;
             png_color_16p trans_color = nullptr;
             int num_trans = 0;
             png_get_tRNS (pngReadStruct, pngInfoStruct, &trans_alpha, &num_trans, &trans_color);
 
-            if (readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, rows))
-                return createImageFromData ((colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0,
-                                            (int) width, (int) height, rows);
+            bool hasAlphaChan = (colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0;
+            auto factor = options.getDownscaleFactor ((int) width, (int) height, 16);
+
+            NativeImageType nativeType;
+            Image image (hasAlphaChan ? Image::ARGB : Image::RGB, (int) width / factor, (int) height / factor, hasAlphaChan,
+                         options.imageType != nullptr ? *options.imageType : nativeType);
+
+            image.getProperties()->set ("originalImageHadAlpha", image.hasAlphaChannel());
+            hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
+
+            const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+            const bool isInterlaced = interlaceType != PNG_INTERLACE_NONE;
+            const bool decodeDirectly = factor == 1 && ! isInterlaced && canDecodeDirectly (destData, hasAlphaChan);
+
+            // an interlaced image has to be decoded in one go, but otherwise a single row is enough
+            const size_t lineStride = width * 4;
+            HeapBlock<uint8> tempBuffer;
+            HeapBlock<png_bytep> rows;
+
+            if (isInterlaced)
+            {
+                tempBuffer.malloc (height * lineStride);
+                rows.malloc (height);
+
+                for (size_t y = 0; y < height; ++y)
+                    rows[y] = (png_bytep) (tempBuffer + lineStride * y);
+            }
+            else if (! decodeDirectly)
+            {
+                tempBuffer.malloc (lineStride);
+            }
+
+            RowWriter writer (destData, hasAlphaChan, factor);
+
+            if (readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, destData, hasAlphaChan,
+                               decodeDirectly, tempBuffer, rows, (int) height, writer))
+                return image;
         }
 
         return Image();
     }
 
-    static Image readImage (InputStream& in)
+    static Image readImage (InputStream& in, const ImageFileFormat::DecodingOptions& options)
     {
         if (png_structp pngReadStruct = png_create_read_struct (PNG_LIBPNG_VER_STRING, 0, 0, 0))
         {
             if (png_infop pngInfoStruct = png_create_info_struct (pngReadStruct))
             {
-                Image image (readImage (in, pngReadStruct, pngInfoStruct));
+                Image image (readImage (in, pngReadStruct, pngInfoStruct, options));
                 png_destroy_read_struct (&pngReadStruct, &pngInfoStruct, 0);
                 return image;
             }
@@ -513,7 +653,16 @@ Image PNGImageFormat::decodeImage (InputStream& in)
    #if JUCE_USING_COREIMAGE_LOADER
     return juce_loadWithCoreImage (in);
    #else
-    return PNGHelpers::readImage (in);
+    return PNGHelpers::readImage (in, {});
+   #endif
+}
+
+Image PNGImageFormat::decodeImageWithOptions (InputStream& in, const DecodingOptions& options)
+{
+   #if JUCE_USING_COREIMAGE_LOADER
+    return ImageFileFormat::decodeImageWithOptions (in, options);
+   #else
+    return PNGHelpers::readImage (in, options);
    #endif
 }
 
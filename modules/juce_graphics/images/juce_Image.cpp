@@ -41,6 +41,13 @@ ImagePixelData::~ImagePixelData()
 
 void ImagePixelData::sendDataChangeMessage()
 {
+    Array<Image> oldMipmaps;
+
+    {
+        const SpinLock::ScopedLockType sl (mipmapLock);
+        oldMipmaps.swapWith (mipmaps);
+    }
+
     listeners.call (&Listener::imageDataChanged, this);
 }
 
@@ -295,6 +302,102 @@ Image Image::createCopy() const
     return Image();
 }
 
+//==============================================================================
+namespace ImageResamplingHelpers
+{
+    // For each destination pixel along one axis, this lists the source pixels that
+    // it covers, and how much of each one, scaled so that each pixel's weights add up to 1.
+    struct AxisWeights
+    {
+        AxisWeights (int sourceSize, int destSize)
+        {
+            auto scale = sourceSize / (double) destSize;
+
+            for (int i = 0; i < destSize; ++i)
+            {
+                auto start = i * scale;
+                auto end = (i + 1) * scale;
+                auto first = (int) start;
+                auto last = jmin (sourceSize, (int) std::ceil (end));
+
+                firstSource.add (first);
+                numSources.add (last - first);
+                firstWeight.add (weights.size());
+
+                for (int j = first; j < last; ++j)
+                    weights.add ((float) ((jmin (end, j + 1.0) - jmax (start, (double) j)) / scale));
+            }
+        }
+
+        Array<int> firstSource, numSources, firstWeight;
+        Array<float> weights;
+    };
+
+    // Shrinks an image by area-averaging. The source rows are filtered horizontally
+    // one at a time and added into an accumulator row for each destination row, with
+    // plain loops over float arrays that the compiler can vectorise.
+    static void downscale (const Image::BitmapData& src, const Image::BitmapData& dest)
+    {
+        jassert (src.pixelFormat == dest.pixelFormat && src.pixelStride == dest.pixelStride);
+        jassert (dest.width <= src.width && dest.height <= src.height);
+
+        const int numComponents = src.pixelStride;
+        const int rowSize = dest.width * numComponents;
+
+        AxisWeights xWeights (src.width, dest.width), yWeights (src.height, dest.height);
+        HeapBlock<float> filteredRow ((size_t) rowSize), accumulator ((size_t) rowSize);
+        int filteredRowIndex = -1;
+
+        for (int y = 0; y < dest.height; ++y)
+        {
+            for (int i = 0; i < rowSize; ++i)
+                accumulator[i] = 0;
+
+            auto* yWeight = yWeights.weights.begin() + yWeights.firstWeight.getUnchecked (y);
+            auto firstRow = yWeights.firstSource.getUnchecked (y);
+
+            for (int j = 0; j < yWeights.numSources.getUnchecked (y); ++j)
+            {
+                // neighbouring destination rows can share a source row, so keep the last one
+                if (filteredRowIndex != firstRow + j)
+                {
+                    filteredRowIndex = firstRow + j;
+                    auto* line = src.getLinePointer (filteredRowIndex);
+
+                    for (int x = 0; x < dest.width; ++x)
+                    {
+                        auto* xWeight = xWeights.weights.begin() + xWeights.firstWeight.getUnchecked (x);
+                        auto* s = line + xWeights.firstSource.getUnchecked (x) * numComponents;
+                        float sums[4] = {};
+
+                        for (int i = 0; i < xWeights.numSources.getUnchecked (x); ++i)
+                        {
+                            for (int c = 0; c < numComponents; ++c)
+                                sums[c] += xWeight[i] * s[c];
+
+                            s += numComponents;
+                        }
+
+                        for (int c = 0; c < numComponents; ++c)
+                            filteredRow[x * numComponents + c] = sums[c];
+                    }
+                }
+
+                auto rowWeight = yWeight[j];
+
+                for (int i = 0; i < rowSize; ++i)
+                    accumulator[i] += rowWeight * filteredRow[i];
+            }
+
+            auto* d = dest.getLinePointer (y);
+
+            for (int i = 0; i < rowSize; ++i)
+                d[i] = (uint8) jmin (255, (int) (accumulator[i] + 0.5f));
+        }
+    }
+}
+
+//==============================================================================
 Image Image::rescaled (const int newWidth, const int newHeight, const Graphics::ResamplingQuality quality) const
 {
     if (image == nullptr || (image->width == newWidth && image->height == newHeight))
@@ -303,6 +406,14 @@ Image Image::rescaled (const int newWidth, const int newHeight, const Graphics::
     const ScopedPointer<ImageType> type (image->createType());
     Image newImage (type->create (image->pixelFormat, newWidth, newHeight, hasAlphaChannel()));
 
+    if (quality != Graphics::lowResamplingQuality && newWidth <= image->width && newHeight <= image->height)
+    {
+        const BitmapData srcData (*this, BitmapData::readOnly);
+        const BitmapData destData (newImage, BitmapData::writeOnly);
+        ImageResamplingHelpers::downscale (srcData, destData);
+        return newImage;
+    }
+
     Graphics g (newImage);
     g.setImageResamplingQuality (quality);
     g.drawImageTransformed (*this, AffineTransform::scale (newWidth  / (float) image->width,
@@ -310,6 +421,39 @@ Image Image::rescaled (const int newWidth, const int newHeight, const Graphics::
     return newImage;
 }
 
+Image Image::getMipmap (int level) const
+{
+    if (image == nullptr || level <= 0)
+        return *this;
+
+    {
+        const SpinLock::ScopedLockType sl (image->mipmapLock);
+
+        if (level <= image->mipmaps.size())
+            return image->mipmaps.getReference (level - 1);
+    }
+
+    auto parent = getMipmap (level - 1);
+    auto w = jmax (1, parent.getWidth() / 2);
+    auto h = jmax (1, parent.getHeight() / 2);
+
+    if (w == parent.getWidth() && h == parent.getHeight())
+        return parent;
+
+    auto mipmap = parent.rescaled (w, h, Graphics::highResamplingQuality);
+
+    const SpinLock::ScopedLockType sl (image->mipmapLock);
+
+    if (level <= image->mipmaps.size())
+        return image->mipmaps.getReference (level - 1);
+
+    // (if the image was changed while this level was being made, it'll be out of date)
+    if (level == image->mipmaps.size() + 1 && parent.image == (level == 1 ? image : image->mipmaps.getLast().image))
+        image->mipmaps.add (mipmap);
+
+    return mipmap;
+}
+
 Image Image::convertedToFormat (PixelFormat newFormat) const
 {
     if (image == nullptr || newFormat == image->pixelFormat)
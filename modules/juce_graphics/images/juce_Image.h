@@ -202,10 +202,28 @@ public:
 
         Note that if the new size is identical to the existing image, this will just return
         a reference to the original image, and won't actually create a duplicate.
+
+        When the image is being shrunk in both directions and the quality is better than
+        lowResamplingQuality, each new pixel is the average of the area of the original
+        that it covers, so large reductions don't suffer from aliasing.
     */
     Image rescaled (int newWidth, int newHeight,
                     Graphics::ResamplingQuality quality = Graphics::mediumResamplingQuality) const;
 
+    /** Returns a copy of this image that has been shrunk by a power of two.
+
+        Level 0 is the image itself, level 1 is half its size, level 2 a quarter, and
+        so on, (although no level will be smaller than 1 pixel). Each level is made by
+        area-averaging the one above it.
+
+        The levels are kept along with the image's data, so if an image is repeatedly
+        drawn at a reduced size they only have to be made once. They're discarded as soon
+        as the image is modified. The software renderer uses these automatically when it
+        draws an image at less than half its size with a quality better than
+        lowResamplingQuality.
+    */
+    Image getMipmap (int level) const;
+
     /** Creates a copy of this image.
         Note that it's usually more efficient to use duplicateIfShared(), because it may not be necessary
         to copy an image if nothing else is using it.
@@ -484,6 +502,10 @@ public:
     void sendDataChangeMessage();
 
 private:
+    friend class Image;
+    Array<Image> mipmaps;
+    SpinLock mipmapLock;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImagePixelData)
 };
 
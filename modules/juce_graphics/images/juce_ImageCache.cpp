@@ -28,10 +28,28 @@ namespace juce
 {
 
 struct ImageCache::Pimpl     : private Timer,
+                               private ImagePixelData::Listener,
                                private DeletedAtShutdown
 {
-    Pimpl() {}
-    ~Pimpl() { clearSingletonInstance(); }
+    Pimpl()
+    {
+        memoryUsage.releaseMemory = [this] (int64 numBytesToRelease)
+        {
+            const ScopedLock sl (lock);
+            shrinkTo (totalSize - (size_t) jmin ((int64) totalSize, numBytesToRelease));
+        };
+    }
+
+    ~Pimpl()
+    {
+        for (auto& item : images)
+            if (item.source != nullptr)
+                item.source->listeners.remove (this);
+
+        memoryUsage.releaseMemory = nullptr;
+        memoryUsage.remove ((int64) totalSize);
+        clearSingletonInstance();
+    }
 
     juce_DeclareSingleton_SingleThreaded_Minimal (ImageCache::Pimpl)
 
@@ -59,8 +77,58 @@ struct ImageCache::Pimpl     : private Timer,
                 startTimer (2000);
 
             const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter(), getSizeInBytes (image), nullptr });
+            totalSize += images.getReference (images.size() - 1).numBytes;
+            memoryUsage.add ((int64) images.getReference (images.size() - 1).numBytes);
+            applySizeLimit();
+        }
+    }
+
+    //==============================================================================
+    Image getRescaled (const Image& source, int width, int height)
+    {
+        auto* sourceData = source.getPixelData();
+
+        if (sourceData == nullptr || (width == source.getWidth() && height == source.getHeight()))
+            return source;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& item : images)
+            {
+                if (item.source == sourceData && item.image.getWidth() == width && item.image.getHeight() == height)
+                {
+                    item.lastUseTime = Time::getApproximateMillisecondCounter();
+                    return item.image;
+                }
+            }
         }
+
+        auto image = source.rescaled (width, height, Graphics::highResamplingQuality);
+
+        if (! isTimerRunning())
+            startTimer (2000);
+
+        const ScopedLock sl (lock);
+        sourceData->listeners.add (this);
+        images.add ({ image, 0, Time::getApproximateMillisecondCounter(), getSizeInBytes (image), sourceData });
+        totalSize += images.getReference (images.size() - 1).numBytes;
+        memoryUsage.add ((int64) images.getReference (images.size() - 1).numBytes);
+        applySizeLimit();
+        return image;
+    }
+
+    void imageDataChanged (ImagePixelData* data) override         { removeCopiesOf (data); }
+    void imageDataBeingDeleted (ImagePixelData* data) override    { removeCopiesOf (data); }
+
+    void removeCopiesOf (ImagePixelData* data)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = images.size(); --i >= 0;)
+            if (images.getReference (i).source == data)
+                removeItem (i);
     }
 
     void timerCallback() override
@@ -75,8 +143,8 @@ struct ImageCache::Pimpl     : private Timer,
 
             if (item.image.getReferenceCount() <= 1)
             {
-                if (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000)
-                    images.remove (i);
+                if (maxCacheSize == 0 && (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000))
+                    removeItem (i);
             }
             else
             {
@@ -84,17 +152,109 @@ struct ImageCache::Pimpl     : private Timer,
             }
         }
 
+        // images that were in use when they were added may have been released since then
+        applySizeLimit();
+
         if (images.isEmpty())
             stopTimer();
     }
 
+    //==============================================================================
+    void loadAsync (const int64 hashCode, std::function<Image()> decode, std::function<void (const Image&)> callback)
+    {
+        auto image = getFromHashCode (hashCode);
+
+        if (image.isValid())
+        {
+            callback (image);
+            return;
+        }
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto* pending : pendingLoads)
+            {
+                if (pending->hashCode == hashCode)
+                {
+                    pending->callbacks.add (std::move (callback));
+                    return;
+                }
+            }
+
+            auto* pending = pendingLoads.add (new PendingLoad());
+            pending->hashCode = hashCode;
+            pending->callbacks.add (std::move (callback));
+
+            if (decodingThreads == nullptr)
+                decodingThreads = new ThreadPool (numDecodingThreads);
+        }
+
+        decodingThreads->addJob ([hashCode, decode]
+        {
+            auto loadedImage = decode();
+
+            MessageManager::callAsync ([hashCode, loadedImage]
+            {
+                if (auto* cache = getInstanceWithoutCreating())
+                    cache->finishedLoading (hashCode, loadedImage);
+            });
+        });
+    }
+
+    void finishedLoading (const int64 hashCode, Image image)
+    {
+        // it may have been loaded synchronously while this one was being decoded
+        auto existing = getFromHashCode (hashCode);
+
+        if (existing.isValid())
+            image = existing;
+        else
+            addImageToCache (image, hashCode);
+
+        Array<std::function<void (const Image&)>> callbacks;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (int i = pendingLoads.size(); --i >= 0;)
+            {
+                if (pendingLoads.getUnchecked (i)->hashCode == hashCode)
+                {
+                    callbacks.swapWith (pendingLoads.getUnchecked (i)->callbacks);
+                    pendingLoads.remove (i);
+                    break;
+                }
+            }
+        }
+
+        for (auto& callback : callbacks)
+            callback (image);
+    }
+
+    void setNumDecodingThreads (int numThreads)
+    {
+        // This has to be set before any images are loaded asynchronously!
+        jassert (decodingThreads == nullptr);
+        jassert (numThreads > 0);
+
+        numDecodingThreads = jmax (1, numThreads);
+    }
+
     void releaseUnusedImages()
     {
         const ScopedLock sl (lock);
 
         for (int i = images.size(); --i >= 0;)
             if (images.getReference(i).image.getReferenceCount() <= 1)
-                images.remove (i);
+                removeItem (i);
+    }
+
+    void setCacheSizeLimit (size_t maxNumBytes)
+    {
+        const ScopedLock sl (lock);
+        maxCacheSize = maxNumBytes;
+        applySizeLimit();
     }
 
     struct Item
@@ -102,11 +262,81 @@ struct ImageCache::Pimpl     : private Timer,
         Image image;
         int64 hashCode;
         uint32 lastUseTime;
+        size_t numBytes;
+        ImagePixelData* source; // for rescaled copies, the data they were made from
+    };
+
+    struct PendingLoad
+    {
+        int64 hashCode;
+        Array<std::function<void (const Image&)>> callbacks;
     };
 
     Array<Item> images;
+    OwnedArray<PendingLoad> pendingLoads;
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
+    size_t totalSize = 0, maxCacheSize = 0;
+    int numDecodingThreads = jmax (1, SystemStats::getNumCpus() - 1);
+    ScopedPointer<ThreadPool> decodingThreads;
+    MemoryUsage::Category& memoryUsage = MemoryUsage::getCategory ("ImageCache");
+
+private:
+    static size_t getSizeInBytes (const Image& image) noexcept
+    {
+        auto bytesPerPixel = image.isARGB() ? 4 : (image.isRGB() ? 3 : 1);
+        return (size_t) (image.getWidth() * image.getHeight() * bytesPerPixel);
+    }
+
+    void removeItem (int index)
+    {
+        auto* source = images.getReference (index).source;
+
+        if (source != nullptr && ! hasOtherCopiesOf (source, index))
+            source->listeners.remove (this);
+
+        totalSize -= images.getReference (index).numBytes;
+        memoryUsage.remove ((int64) images.getReference (index).numBytes);
+        images.remove (index);
+    }
+
+    bool hasOtherCopiesOf (ImagePixelData* source, int indexToIgnore) const noexcept
+    {
+        for (int i = 0; i < images.size(); ++i)
+            if (i != indexToIgnore && images.getReference (i).source == source)
+                return true;
+
+        return false;
+    }
+
+    void applySizeLimit()
+    {
+        if (maxCacheSize > 0)
+            shrinkTo (maxCacheSize);
+    }
+
+    // removes unused images, least recently used first, until the cache fits in the given size
+    void shrinkTo (size_t maxNumBytes)
+    {
+        while (totalSize > maxNumBytes)
+        {
+            int oldest = -1;
+
+            for (int i = 0; i < images.size(); ++i)
+            {
+                auto& item = images.getReference (i);
+
+                if (item.image.getReferenceCount() <= 1
+                     && (oldest < 0 || item.lastUseTime < images.getReference (oldest).lastUseTime))
+                    oldest = i;
+            }
+
+            if (oldest < 0)
+                break;
+
+            removeItem (oldest);
+        }
+    }
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -156,12 +386,44 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
     return image;
 }
 
+void ImageCache::getFromFileAsync (const File& file, std::function<void (const Image&)> callback)
+{
+    Pimpl::getInstance()->loadAsync (file.hashCode64(),
+                                     [file] { return ImageFileFormat::loadFrom (file); },
+                                     std::move (callback));
+}
+
+void ImageCache::getFromMemoryAsync (const void* imageData, const int dataSize, std::function<void (const Image&)> callback)
+{
+    Pimpl::getInstance()->loadAsync ((int64) (pointer_sized_int) imageData,
+                                     [imageData, dataSize] { return ImageFileFormat::loadFrom (imageData, (size_t) dataSize); },
+                                     std::move (callback));
+}
+
+Image ImageCache::getRescaled (const Image& image, const int width, const int height, const float displayScale)
+{
+    jassert (width > 0 && height > 0 && displayScale > 0);
+
+    return Pimpl::getInstance()->getRescaled (image, jmax (1, roundToInt (width * displayScale)),
+                                                     jmax (1, roundToInt (height * displayScale)));
+}
+
+void ImageCache::setNumDecodingThreads (const int numThreads)
+{
+    Pimpl::getInstance()->setNumDecodingThreads (numThreads);
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setCacheSizeLimit (const size_t maxNumBytes)
+{
+    Pimpl::getInstance()->setCacheSizeLimit (maxNumBytes);
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
@@ -38,7 +38,12 @@ namespace juce
     Another advantage is that after images are released, they will be kept in
     memory for a few seconds before it is actually deleted, so if you're repeatedly
     loading/deleting the same image, it'll reduce the chances of having to reload it
-    each time.
+    each time. Alternatively, setCacheSizeLimit() lets unused images stay in memory
+    until the cache grows past a given size.
+
+    Images can also be decoded on background threads with getFromFileAsync() and
+    getFromMemoryAsync(), which is handy for loading lots of images at startup without
+    blocking the message thread.
 
     @see Image, ImageFileFormat
 */
@@ -79,6 +84,58 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Loads an image from a file on a background thread, (or just returns the image
+        if it's already cached).
+
+        If the cache already contains an image that was loaded from this file, the callback
+        is called with it before this method returns. Otherwise, the file is decoded by one of
+        the cache's decoding threads, and once it has been added to the cache, the callback
+        is called on the message thread with the image, (or with an invalid image if it
+        couldn't be loaded).
+
+        If the same file is requested again while it's still being decoded, it won't be
+        decoded twice - all the callbacks get the same image once it's ready.
+
+        @see getFromFile, getFromMemoryAsync, setNumDecodingThreads
+    */
+    static void getFromFileAsync (const File& file, std::function<void (const Image&)> callback);
+
+    /** Loads an image from an in-memory image file on a background thread, (or just
+        returns the image if it's already cached).
+
+        This works like getFromFileAsync(). The data isn't copied, so it must stay valid
+        until the image has finished loading, (which is no problem for things like BinaryData).
+
+        @see getFromMemory, getFromFileAsync, setNumDecodingThreads
+    */
+    static void getFromMemoryAsync (const void* imageData, int dataSize, std::function<void (const Image&)> callback);
+
+    /** Sets the number of threads that getFromFileAsync() and getFromMemoryAsync() will
+        use to decode images in parallel.
+
+        By default this is one less than the number of CPU cores, (but at least one). It
+        must be called before the first asynchronous load.
+    */
+    static void setNumDecodingThreads (int numThreads);
+
+    //==============================================================================
+    /** Returns a copy of an image that has been shrunk or enlarged for drawing at a
+        particular size, (or just returns it if the cache already has one).
+
+        The copy is rescaled to (width * displayScale) by (height * displayScale) pixels,
+        so on a high-DPI display you can pass the display's scale factor and draw the
+        result into a width x height area to get a sharp image that doesn't need to be
+        resampled again every time it's painted.
+
+        Copies are remembered for each different size and scale, and are kept in the cache
+        like any other image. If the original image is modified or deleted, its copies are
+        removed from the cache.
+
+        @see Image::rescaled
+    */
+    static Image getRescaled (const Image& image, int width, int height, float displayScale = 1.0f);
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -104,9 +161,23 @@ public:
 
     /** Changes the amount of time before an unused image will be removed from the cache.
         By default this is about 5 seconds.
+
+        This is ignored if a size limit has been set with setCacheSizeLimit().
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Makes the cache keep unused images until their total size goes over a limit,
+        instead of releasing them after a timeout.
+
+        Once the images in the cache take up more than this number of bytes, the unused
+        ones are removed, least-recently-used first, until it fits again. Images that
+        are still being used can't be removed, but do count towards the total.
+        Passing 0 goes back to using the timeout.
+
+        @see setCacheTimeout
+    */
+    static void setCacheSizeLimit (size_t maxNumBytes);
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
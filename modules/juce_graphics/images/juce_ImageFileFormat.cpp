@@ -76,6 +76,43 @@ ImageFileFormat* ImageFileFormat::findImageFormatForFileExtension (const File& f
     return nullptr;
 }
 
+//==============================================================================
+int ImageFileFormat::DecodingOptions::getDownscaleFactor (int imageWidth, int imageHeight, int maxFactor) const noexcept
+{
+    if (minimumWidth <= 0 && minimumHeight <= 0)
+        return 1;
+
+    int factor = 1;
+
+    while (factor < maxFactor
+            && imageWidth  / (factor + 1) >= jmax (1, minimumWidth)
+            && imageHeight / (factor + 1) >= jmax (1, minimumHeight))
+        ++factor;
+
+    return factor;
+}
+
+Image ImageFileFormat::decodeImageWithOptions (InputStream& input, const DecodingOptions& options)
+{
+    auto image = decodeImage (input);
+
+    if (image.isValid())
+    {
+        auto properties = *image.getProperties();
+        auto factor = options.getDownscaleFactor (image.getWidth(), image.getHeight(), std::numeric_limits<int>::max());
+
+        if (factor > 1)
+            image = image.rescaled (image.getWidth() / factor, image.getHeight() / factor);
+
+        if (options.imageType != nullptr)
+            image = options.imageType->convert (image);
+
+        *image.getProperties() = properties;
+    }
+
+    return image;
+}
+
 //==============================================================================
 Image ImageFileFormat::loadFrom (InputStream& input)
 {
@@ -109,4 +146,36 @@ Image ImageFileFormat::loadFrom (const void* rawData, const size_t numBytes)
     return Image();
 }
 
+Image ImageFileFormat::loadFrom (InputStream& input, const DecodingOptions& options)
+{
+    if (ImageFileFormat* format = findImageFormatForStream (input))
+        return format->decodeImageWithOptions (input, options);
+
+    return Image();
+}
+
+Image ImageFileFormat::loadFrom (const File& file, const DecodingOptions& options)
+{
+    FileInputStream stream (file);
+
+    if (stream.openedOk())
+    {
+        BufferedInputStream b (stream, 8192);
+        return loadFrom (b, options);
+    }
+
+    return Image();
+}
+
+Image ImageFileFormat::loadFrom (const void* rawData, const size_t numBytes, const DecodingOptions& options)
+{
+    if (rawData != nullptr && numBytes > 4)
+    {
+        MemoryInputStream stream (rawData, numBytes, false);
+        return loadFrom (stream, options);
+    }
+
+    return Image();
+}
+
 } // namespace juce
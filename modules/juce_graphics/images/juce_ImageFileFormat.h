@@ -27,6 +27,8 @@
 namespace juce
 {
 
+class ImageType;
+
 //==============================================================================
 /**
     Base-class for codecs that can read and write image file formats such
@@ -83,6 +85,40 @@ public:
     */
     virtual Image decodeImage (InputStream& input) = 0;
 
+    //==============================================================================
+    /** Settings that control the kind of image that decodeImageWithOptions() creates. */
+    struct JUCE_API  DecodingOptions
+    {
+        /** The type of image to create, or nullptr to use the default NativeImageType.
+            The object must stay valid while the image is being decoded.
+        */
+        const ImageType* imageType = nullptr;
+
+        /** If these are more than zero, the decoder may shrink the image by a whole-number
+            factor as it decodes it, as long as the result is still at least this big. That
+            lets a large image be loaded at the size it'll be displayed, without first
+            creating the full-size version.
+        */
+        int minimumWidth = 0, minimumHeight = 0;
+
+        /** Returns the largest factor (up to maxFactor) that an image of this size could be
+            shrunk by while still meeting the minimum size.
+        */
+        int getDownscaleFactor (int imageWidth, int imageHeight, int maxFactor) const noexcept;
+    };
+
+    /** Tries to decode and return an image from the given stream, using some options to
+        choose the type and size of the image.
+
+        The default implementation calls decodeImage() and then converts the result, but the
+        PNG and JPEG formats decode straight into an image of the requested type, shrinking it
+        as they go. Because the image can only be shrunk by a whole-number factor, it may
+        still be bigger than the minimum size that was asked for.
+
+        @see decodeImage, loadFrom
+    */
+    virtual Image decodeImageWithOptions (InputStream& input, const DecodingOptions& options);
+
     //==============================================================================
     /** Attempts to write an image to a stream.
 
@@ -136,6 +172,24 @@ public:
     */
     static Image loadFrom (const void* rawData,
                            size_t numBytesOfData);
+
+    /** Tries to load an image from a stream, using some options to choose the type and
+        size of the image that's created.
+        @see decodeImageWithOptions
+    */
+    static Image loadFrom (InputStream& input, const DecodingOptions& options);
+
+    /** Tries to load an image from a file, using some options to choose the type and
+        size of the image that's created.
+        @see decodeImageWithOptions
+    */
+    static Image loadFrom (const File& file, const DecodingOptions& options);
+
+    /** Tries to load an image from a block of raw image data, using some options to choose
+        the type and size of the image that's created.
+        @see decodeImageWithOptions
+    */
+    static Image loadFrom (const void* rawData, size_t numBytesOfData, const DecodingOptions& options);
 };
 
 //==============================================================================
@@ -156,6 +210,7 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+    Image decodeImageWithOptions (InputStream&, const DecodingOptions&) override;
     bool writeImageToStream (const Image&, OutputStream&) override;
 };
 
@@ -186,6 +241,7 @@ public:
     bool usesFileExtension (const File&) override;
     bool canUnderstand (InputStream&) override;
     Image decodeImage (InputStream&) override;
+    Image decodeImageWithOptions (InputStream&, const DecodingOptions&) override;
     bool writeImageToStream (const Image&, OutputStream&) override;
 
 private:
@@ -100,6 +100,14 @@
 
 #undef SIZEOF
 
+#if JUCE_INTEL && (JUCE_MSVC || defined (__SSE2__)) && JUCE_LITTLE_ENDIAN
+ #define JUCE_USE_SSE2_PIXEL_BLENDING 1
+ #include <emmintrin.h>
+#elif (defined (__ARM_NEON__) || defined (__ARM_NEON)) && JUCE_LITTLE_ENDIAN && ! TARGET_IPHONE_SIMULATOR
+ #define JUCE_USE_NEON_PIXEL_BLENDING 1
+ #include <arm_neon.h>
+#endif
+
 #if (JUCE_MAC || JUCE_IOS) && USE_COREGRAPHICS_RENDERING && JUCE_USE_COREIMAGE_LOADER
  #define JUCE_USING_COREIMAGE_LOADER 1
 #else
@@ -116,10 +124,14 @@
 #include "geometry/juce_Path.cpp"
 #include "geometry/juce_PathIterator.cpp"
 #include "geometry/juce_PathStrokeType.cpp"
+#include "geometry/juce_PreparedPath.cpp"
 #include "placement/juce_RectanglePlacement.cpp"
+#include "fonts/juce_ShapedTextCache.cpp"
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.cpp"
+#include "native/juce_SIMDPixelBlending.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
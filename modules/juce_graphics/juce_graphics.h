@@ -116,6 +116,7 @@ namespace juce
 #include "geometry/juce_EdgeTable.h"
 #include "geometry/juce_PathIterator.h"
 #include "geometry/juce_PathStrokeType.h"
+#include "geometry/juce_PreparedPath.h"
 #include "placement/juce_RectanglePlacement.h"
 #include "images/juce_ImageCache.h"
 #include "images/juce_ImageConvolutionKernel.h"
@@ -125,6 +126,7 @@ namespace juce
 #include "fonts/juce_AttributedString.h"
 #include "fonts/juce_GlyphArrangement.h"
 #include "fonts/juce_TextLayout.h"
+#include "fonts/juce_ShapedTextCache.h"
 #include "fonts/juce_CustomTypeface.h"
 #include "contexts/juce_GraphicsContext.h"
 #include "contexts/juce_LowLevelGraphicsContext.h"
@@ -132,6 +134,7 @@ namespace juce
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
@@ -281,6 +281,11 @@ class CachedGlyphEdgeTable  : public ReferenceCountedObject
 public:
     CachedGlyphEdgeTable() : glyph (0), lastAccessCount (0) {}
 
+    ~CachedGlyphEdgeTable()
+    {
+        getMemoryUsage().remove (numBytes);
+    }
+
     void draw (RendererType& state, Point<float> pos) const
     {
         if (snapToIntegerCoordinate)
@@ -301,12 +306,23 @@ public:
         edgeTable = typeface->getEdgeTableForGlyph (glyphNumber,
                                                     AffineTransform::scale (fontHeight * font.getHorizontalScale(),
                                                                             fontHeight), fontHeight);
+
+        getMemoryUsage().remove (numBytes);
+        numBytes = edgeTable != nullptr ? (int64) edgeTable->getNumBytesAllocated() : 0;
+        getMemoryUsage().add (numBytes);
+    }
+
+    static MemoryUsage::Category& getMemoryUsage()
+    {
+        static MemoryUsage::Category& category = MemoryUsage::getCategory ("GlyphCache");
+        return category;
     }
 
     Font font;
     ScopedPointer<EdgeTable> edgeTable;
     int glyph, lastAccessCount;
     bool snapToIntegerCoordinate;
+    int64 numBytes = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
@@ -401,7 +417,58 @@ struct FloatRectangleRasterisingInfo
 };
 
 //==============================================================================
-/** Contains classes for calculating the colour of pixels within various types of gradient. */
+/** SSE2 and NEON versions of the loops that the EdgeTableFillers use to blend runs of pixels,
+    and that the GradientPixelIterators use to look up runs of gradient colours.
+
+    Each blend function produces exactly the same pixels as calling PixelARGB::blend() or
+    PixelRGB::blend() on each pixel in turn, where an extraAlpha of 256 means the source is
+    used as it is, and each gradient function produces the same colours as the matching
+    iterator's getPixel(). If there's no vector code for the pixel formats and strides given,
+    or the CPU can't run it, they return false without touching anything, and the caller
+    should do the work itself.
+*/
+namespace SIMDPixelBlending
+{
+    /** Returns true if the blend functions can be used to draw into this kind of pixel. */
+    bool canBlendInto (const PixelARGB*, int destPixelStride) noexcept;
+    bool canBlendInto (const PixelRGB*, int destPixelStride) noexcept;
+
+    template <class PixelType>
+    bool canBlendInto (const PixelType*, int) noexcept                      { return false; }
+
+    /** Blends a solid colour over a run of pixels. */
+    bool blendColour (PixelARGB* dest, int destPixelStride, PixelARGB colour, int numPixels) noexcept;
+    bool blendColour (PixelRGB* dest, int destPixelStride, PixelARGB colour, int numPixels) noexcept;
+
+    template <class PixelType>
+    bool blendColour (PixelType*, int, PixelARGB, int) noexcept             { return false; }
+
+    /** Blends a run of source pixels over a run of destination pixels. */
+    bool blendPixels (PixelARGB* dest, int destPixelStride, const PixelARGB* src, int srcPixelStride, int numPixels, uint32 extraAlpha) noexcept;
+    bool blendPixels (PixelRGB* dest, int destPixelStride, const PixelARGB* src, int srcPixelStride, int numPixels, uint32 extraAlpha) noexcept;
+
+    template <class DestPixelType, class SrcPixelType>
+    bool blendPixels (DestPixelType*, int, const SrcPixelType*, int, int, uint32) noexcept    { return false; }
+
+    /** Looks up a run of colours for a linear gradient. The first pixel's fixed-point position
+        along the gradient is startPosition, and each pixel is positionStep further on.
+    */
+    bool fillLinearGradientSpan (PixelARGB* dest, int numPixels, const PixelARGB* lookupTable, int maxIndex,
+                                 int startPosition, int positionStep, int numScaleBits) noexcept;
+
+    /** Looks up a run of colours for a radial gradient, where the offset of pixel x from the
+        centre is (x * xScale + xOffset, x * yScale + yOffset).
+    */
+    bool fillRadialGradientSpan (PixelARGB* dest, int numPixels, const PixelARGB* lookupTable, int maxIndex, int x,
+                                 double xScale, double xOffset, double yScale, double yOffset,
+                                 double maxDistSquared, float invScale) noexcept;
+}
+
+//==============================================================================
+/** Contains classes for calculating the colour of pixels within various types of gradient.
+    As well as getPixel(), each iterator has a getPixels() method that fills a run of colours in
+    one go, using the SIMDPixelBlending functions where it can.
+*/
 namespace GradientPixelIterators
 {
     /** Iterates the colour of pixels in a linear gradient */
@@ -465,6 +532,28 @@ namespace GradientPixelIterators
                             : lookupTable [jlimit (0, numEntries, (x * scale - start) >> (int) numScaleBits)];
         }
 
+        void getPixels (int x, PixelARGB* dest, int num) const noexcept
+        {
+            if (vertical)
+            {
+                while (--num >= 0)
+                    *dest++ = linePix;
+
+                return;
+            }
+
+            auto position = x * scale - start;
+
+            if (SIMDPixelBlending::fillLinearGradientSpan (dest, num, lookupTable, numEntries, position, scale, (int) numScaleBits))
+                return;
+
+            while (--num >= 0)
+            {
+                *dest++ = lookupTable [jlimit (0, numEntries, position >> (int) numScaleBits)];
+                position += scale;
+            }
+        }
+
     private:
         const PixelARGB* const lookupTable;
         const int numEntries;
@@ -492,30 +581,39 @@ namespace GradientPixelIterators
             jassert (numColours >= 0);
             const Point<float> diff (gradient.point1 - gradient.point2);
             maxDist = diff.x * diff.x + diff.y * diff.y;
-            invScale = numEntries / std::sqrt (maxDist);
+            invScale = (float) (numEntries / std::sqrt (maxDist));
             jassert (roundToInt (std::sqrt (maxDist) * invScale) <= numEntries);
         }
 
         forcedinline void setY (const int y) noexcept
         {
             dy = y - gy1;
-            dy *= dy;
         }
 
         inline PixelARGB getPixel (const int px) const noexcept
         {
             double x = px - gx1;
             x *= x;
-            x += dy;
+            x += dy * dy;
+
+            // (the square root is done in single precision, as that's all the lookup needs, and is much faster)
+            return lookupTable [x >= maxDist ? numEntries : roundToInt (std::sqrt ((float) x) * invScale)];
+        }
 
-            return lookupTable [x >= maxDist ? numEntries : roundToInt (std::sqrt (x) * invScale)];
+        void getPixels (int px, PixelARGB* dest, int num) const noexcept
+        {
+            if (! SIMDPixelBlending::fillRadialGradientSpan (dest, num, lookupTable, numEntries, px,
+                                                             1.0, -gx1, 0.0, dy, maxDist, invScale))
+                while (--num >= 0)
+                    *dest++ = getPixel (px++);
         }
 
     protected:
         const PixelARGB* const lookupTable;
         const int numEntries;
         const double gx1, gy1;
-        double maxDist, invScale, dy;
+        double maxDist, dy;
+        float invScale;
 
         JUCE_DECLARE_NON_COPYABLE (Radial)
     };
@@ -552,7 +650,15 @@ namespace GradientPixelIterators
             if (x >= maxDist)
                 return lookupTable [numEntries];
 
-            return lookupTable [jmin (numEntries, roundToInt (std::sqrt (x) * invScale))];
+            return lookupTable [jmin (numEntries, roundToInt (std::sqrt ((float) x) * invScale))];
+        }
+
+        void getPixels (int px, PixelARGB* dest, int num) const noexcept
+        {
+            if (! SIMDPixelBlending::fillRadialGradientSpan (dest, num, lookupTable, numEntries, px,
+                                                             tM00, lineYM01, tM10, lineYM11, maxDist, invScale))
+                while (--num >= 0)
+                    *dest++ = getPixel (px++);
         }
 
     private:
@@ -563,6 +669,124 @@ namespace GradientPixelIterators
     };
 }
 
+//==============================================================================
+/** Holds a cache of recently-used gradient lookup tables.
+
+    Most gradients get drawn over and over again with the same colours at the same
+    size (e.g. the ones that a look-and-feel uses for its buttons and sliders), so
+    rather than building a new table for every fill, the tables are kept and found
+    again using a hash of the gradient's colour stops and the table size.
+*/
+class GradientLookupTableCache  : private DeletedAtShutdown
+{
+public:
+    /** A lookup table, as created by ColourGradient::createLookupTable(). */
+    struct Table  : public ReferenceCountedObject
+    {
+        typedef ReferenceCountedObjectPtr<Table> Ptr;
+
+        HeapBlock<PixelARGB> colours;
+        int numEntries = 0;
+        uint64 key = 0;
+        int lastAccessCount = 0;
+    };
+
+    GradientLookupTableCache() {}
+
+    ~GradientLookupTableCache()
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static GradientLookupTableCache& getInstance()
+    {
+        GradientLookupTableCache*& c = getSingletonPointer();
+
+        if (c == nullptr)
+            c = new GradientLookupTableCache();
+
+        return *c;
+    }
+
+    /** Returns a table for drawing this gradient with the given transform. */
+    Table::Ptr getTable (const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        return getTable (gradient, gradient.getLookupTableSize (transform));
+    }
+
+    /** Returns a table with a given number of entries for this gradient. */
+    Table::Ptr getTable (const ColourGradient& gradient, int numEntries)
+    {
+        auto key = getHashCode (gradient, numEntries);
+        const ScopedLock sl (lock);
+
+        for (auto* t : tables)
+        {
+            if (t->key == key && t->numEntries == numEntries)
+            {
+                t->lastAccessCount = ++accessCounter;
+                return t;
+            }
+        }
+
+        Table::Ptr t (getTableForReuse());
+        t->colours.malloc ((size_t) numEntries);
+        t->numEntries = numEntries;
+        t->key = key;
+        t->lastAccessCount = ++accessCounter;
+        gradient.createLookupTable (t->colours, numEntries);
+        return t;
+    }
+
+private:
+    enum { maxNumTables = 32 };
+
+    ReferenceCountedArray<Table> tables;
+    int accessCounter = 0;
+    CriticalSection lock;
+
+    static uint64 getHashCode (const ColourGradient& gradient, int numEntries) noexcept
+    {
+        XXHash64 hasher;
+        hasher.addData (&numEntries, sizeof (numEntries));
+
+        for (int i = 0; i < gradient.getNumColours(); ++i)
+        {
+            auto position = gradient.getColourPosition (i);
+            auto argb = gradient.getColour (i).getARGB();
+
+            hasher.addData (&position, sizeof (position));
+            hasher.addData (&argb, sizeof (argb));
+        }
+
+        return hasher.getResult();
+    }
+
+    // Tables that are still being drawn with by another thread have a reference count above 1, so are left alone
+    Table* getTableForReuse()
+    {
+        Table* oldest = nullptr;
+
+        if (tables.size() >= maxNumTables)
+            for (auto* t : tables)
+                if (t->getReferenceCount() == 1 && (oldest == nullptr || t->lastAccessCount < oldest->lastAccessCount))
+                    oldest = t;
+
+        if (oldest == nullptr)
+            oldest = tables.add (new Table());
+
+        return oldest;
+    }
+
+    static GradientLookupTableCache*& getSingletonPointer() noexcept
+    {
+        static GradientLookupTableCache* c = nullptr;
+        return c;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GradientLookupTableCache)
+};
+
 #define JUCE_PERFORM_PIXEL_OP_LOOP(op) \
 { \
     const int destStride = destData.pixelStride;  \
@@ -604,9 +828,17 @@ namespace EdgeTableFillers
         forcedinline void handleEdgeTablePixel (const int x, const int alphaLevel) const noexcept
         {
             if (replaceExisting)
+            {
                 getPixel (x)->set (sourceColour);
+            }
             else
-                getPixel (x)->blend (sourceColour, (uint32) alphaLevel);
+            {
+                // (this does the same sums as handleEdgeTableLine(), so that a pixel comes out
+                // the same whether it's drawn on its own or as part of a run)
+                PixelARGB p (sourceColour);
+                p.multiplyAlpha (alphaLevel);
+                getPixel (x)->blend (p);
+            }
         }
 
         forcedinline void handleEdgeTablePixelFull (const int x) const noexcept
@@ -654,7 +886,8 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, const PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            if (! SIMDPixelBlending::blendColour (dest, destData.pixelStride, colour, width))
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
         forcedinline void replaceLine (PixelRGB* dest, const PixelARGB colour, int width) const noexcept
@@ -752,15 +985,22 @@ namespace EdgeTableFillers
             PixelType* dest = getPixel (x);
 
             if (alphaLevel < 0xff)
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
-            else
+            {
+                if (! blendSpan (dest, x, width, (uint32) alphaLevel))
+                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
+            }
+            else if (! blendSpan (dest, x, width, 256))
+            {
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            }
         }
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             PixelType* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+
+            if (! blendSpan (dest, x, width, 256))
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
     private:
@@ -772,6 +1012,29 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        // The colours are looked up a chunk at a time, so that they can be blended with SIMD
+        bool blendSpan (PixelType* dest, int x, int width, const uint32 extraAlpha) const noexcept
+        {
+            if (! SIMDPixelBlending::canBlendInto (dest, destData.pixelStride))
+                return false;
+
+            PixelARGB colours[64];
+
+            while (width > 0)
+            {
+                auto numToDo = jmin (width, (int) numElementsInArray (colours));
+
+                GradientType::getPixels (x, colours, numToDo);
+                x += numToDo;
+
+                SIMDPixelBlending::blendPixels (dest, destData.pixelStride, colours, (int) sizeof (PixelARGB), numToDo, extraAlpha);
+                dest = addBytesToPointer (dest, numToDo * destData.pixelStride);
+                width -= numToDo;
+            }
+
+            return true;
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -807,14 +1070,12 @@ namespace EdgeTableFillers
 
         forcedinline void handleEdgeTablePixel (const int x, int alphaLevel) const noexcept
         {
-            alphaLevel = (alphaLevel * extraAlpha) >> 8;
-
-            getDestPixel (x)->blend (*getSrcPixel (repeatPattern ? ((x - xOffset) % srcData.width) : (x - xOffset)), (uint32) alphaLevel);
+            blendPixel (x, (alphaLevel * extraAlpha) >> 8);
         }
 
         forcedinline void handleEdgeTablePixelFull (const int x) const noexcept
         {
-            getDestPixel (x)->blend (*getSrcPixel (repeatPattern ? ((x - xOffset) % srcData.width) : (x - xOffset)), (uint32) extraAlpha);
+            blendPixel (x, extraAlpha);
         }
 
         void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept
@@ -835,9 +1096,14 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                {
+                    if (! SIMDPixelBlending::blendPixels (dest, destData.pixelStride, getSrcPixel (x), srcData.pixelStride, width, (uint32) alphaLevel))
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                }
                 else
+                {
                     copyRow (dest, getSrcPixel (x), width);
+                }
             }
         }
 
@@ -858,9 +1124,14 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                {
+                    if (! SIMDPixelBlending::blendPixels (dest, destData.pixelStride, getSrcPixel (x), srcData.pixelStride, width, (uint32) extraAlpha))
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                }
                 else
+                {
                     copyRow (dest, getSrcPixel (x), width);
+                }
             }
         }
 
@@ -893,6 +1164,18 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        // (this uses the same threshold as the line methods, so that a pixel comes out the
+        // same whether it's drawn on its own or as part of a run)
+        forcedinline void blendPixel (const int x, const int alphaLevel) const noexcept
+        {
+            auto* src = getSrcPixel (repeatPattern ? ((x - xOffset) % srcData.width) : (x - xOffset));
+
+            if (alphaLevel < 0xfe)
+                getDestPixel (x)->blend (*src, (uint32) alphaLevel);
+            else
+                getDestPixel (x)->blend (*src);
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             const int destStride = destData.pixelStride;
@@ -904,7 +1187,7 @@ namespace EdgeTableFillers
             {
                 memcpy (dest, src, (size_t) (width * srcStride));
             }
-            else
+            else if (! SIMDPixelBlending::blendPixels (dest, destStride, src, srcStride, width, 256))
             {
                 do
                 {
@@ -948,44 +1231,22 @@ namespace EdgeTableFillers
 
         forcedinline void handleEdgeTablePixel (const int x, const int alphaLevel) noexcept
         {
-            SrcPixelType p;
-            generate (&p, x, 1);
-
-            getDestPixel (x)->blend (p, (uint32) (alphaLevel * extraAlpha) >> 8);
+            blendPixel (x, (alphaLevel * extraAlpha) >> 8);
         }
 
         forcedinline void handleEdgeTablePixelFull (const int x) noexcept
         {
-            SrcPixelType p;
-            generate (&p, x, 1);
-
-            getDestPixel (x)->blend (p, (uint32) extraAlpha);
+            blendPixel (x, extraAlpha);
         }
 
-        void handleEdgeTableLine (const int x, int width, int alphaLevel) noexcept
+        forcedinline void handleEdgeTableLine (const int x, int width, int alphaLevel) noexcept
         {
-            if (width > (int) scratchSize)
-            {
-                scratchSize = (size_t) width;
-                scratchBuffer.malloc (scratchSize);
-            }
-
-            SrcPixelType* span = scratchBuffer;
-            generate (span, x, width);
-
-            DestPixelType* dest = getDestPixel (x);
-            alphaLevel *= extraAlpha;
-            alphaLevel >>= 8;
-
-            if (alphaLevel < 0xfe)
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
-            else
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
+            blendLine (x, width, (alphaLevel * extraAlpha) >> 8);
         }
 
         forcedinline void handleEdgeTableLineFull (const int x, int width) noexcept
         {
-            handleEdgeTableLine (x, width, 255);
+            blendLine (x, width, extraAlpha);
         }
 
         void clipEdgeTableLine (EdgeTable& et, int x, int y_, int width)
@@ -1010,6 +1271,42 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        // (the pixel and line methods use the same threshold, so that a pixel comes out the
+        // same whether it's drawn on its own or as part of a run)
+        forcedinline void blendPixel (const int x, const int alphaLevel) noexcept
+        {
+            SrcPixelType p;
+            generate (&p, x, 1);
+
+            if (alphaLevel < 0xfe)
+                getDestPixel (x)->blend (p, (uint32) alphaLevel);
+            else
+                getDestPixel (x)->blend (p);
+        }
+
+        void blendLine (const int x, int width, const int alphaLevel) noexcept
+        {
+            if (width > (int) scratchSize)
+            {
+                scratchSize = (size_t) width;
+                scratchBuffer.malloc (scratchSize);
+            }
+
+            SrcPixelType* span = scratchBuffer;
+            generate (span, x, width);
+
+            DestPixelType* dest = getDestPixel (x);
+
+            if (SIMDPixelBlending::blendPixels (dest, destData.pixelStride, span, (int) sizeof (SrcPixelType),
+                                                width, alphaLevel < 0xfe ? (uint32) alphaLevel : 256u))
+                return;
+
+            if (alphaLevel < 0xfe)
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
+        }
+
         //==============================================================================
         template <class PixelType>
         void generate (PixelType* dest, const int x, int numPixels) noexcept
@@ -1295,73 +1592,47 @@ namespace EdgeTableFillers
                                               const float offsetFloat, const int offsetInt) noexcept
                 : inverseTransform (transform.inverted()),
                   pixelOffset (offsetFloat), pixelOffsetInt (offsetInt)
-            {}
+            {
+                xStep = toFixedPoint (inverseTransform.mat00);
+                yStep = toFixedPoint (inverseTransform.mat10);
+            }
 
             void setStartOfLine (float sx, float sy, const int numPixels) noexcept
             {
                 jassert (numPixels > 0);
+                ignoreUnused (numPixels);
 
-                sx += pixelOffset;
-                sy += pixelOffset;
-                float x1 = sx, y1 = sy;
-                sx += (float) numPixels;
-                inverseTransform.transformPoints (x1, y1, sx, sy);
+                // The positions are worked out from the start of the whole row rather than
+                // from the start of this span, so that a pixel always samples the same source
+                // position, however the clip region happens to have been split into spans.
+                auto rowX = pixelOffset, rowY = sy + pixelOffset;
+                inverseTransform.transformPoint (rowX, rowY);
 
-                xBresenham.set ((int) (x1 * 256.0f), (int) (sx * 256.0f), numPixels, pixelOffsetInt);
-                yBresenham.set ((int) (y1 * 256.0f), (int) (sy * 256.0f), numPixels, pixelOffsetInt);
+                auto startX = (int64) sx;
+                xPosition = toFixedPoint (rowX) + startX * xStep;
+                yPosition = toFixedPoint (rowY) + startX * yStep;
             }
 
             void next (int& px, int& py) noexcept
             {
-                px = xBresenham.n;  xBresenham.stepToNext();
-                py = yBresenham.n;  yBresenham.stepToNext();
+                px = (int) (xPosition >> fixedPointShift) + pixelOffsetInt;  xPosition += xStep;
+                py = (int) (yPosition >> fixedPointShift) + pixelOffsetInt;  yPosition += yStep;
             }
 
         private:
-            class BresenhamInterpolator
-            {
-            public:
-                BresenhamInterpolator() noexcept {}
-
-                void set (const int n1, const int n2, const int steps, const int offsetInt) noexcept
-                {
-                    numSteps = steps;
-                    step = (n2 - n1) / numSteps;
-                    remainder = modulo = (n2 - n1) % numSteps;
-                    n = n1 + offsetInt;
+            // positions are kept in 1/256ths of a pixel, with some extra bits of precision
+            // so that the rounding errors don't build up along a line
+            enum { fixedPointShift = 16 };
 
-                    if (modulo <= 0)
-                    {
-                        modulo += numSteps;
-                        remainder += numSteps;
-                        --step;
-                    }
-
-                    modulo -= numSteps;
-                }
-
-                forcedinline void stepToNext() noexcept
-                {
-                    modulo += remainder;
-                    n += step;
-
-                    if (modulo > 0)
-                    {
-                        modulo -= numSteps;
-                        ++n;
-                    }
-                }
-
-                int n;
-
-            private:
-                int numSteps, step, modulo, remainder;
-            };
+            static int64 toFixedPoint (double value) noexcept
+            {
+                return (int64) std::floor (value * (double) (256 << fixedPointShift));
+            }
 
             const AffineTransform inverseTransform;
-            BresenhamInterpolator xBresenham, yBresenham;
             const float pixelOffset;
             const int pixelOffsetInt;
+            int64 xStep, yStep, xPosition = 0, yPosition = 0;
 
             JUCE_DECLARE_NON_COPYABLE (TransformedImageSpanInterpolator)
         };
@@ -2277,6 +2548,24 @@ public:
         }
     }
 
+    void fillPreparedPath (const PreparedPath& path, const AffineTransform& t)
+    {
+        if (clip != nullptr)
+        {
+            Point<int> offset;
+
+            if (auto shape = path.getRenderedShape (transform.getTransformWith (t), offset))
+            {
+                if ((shape->edgeTable.getMaximumBounds() + offset).intersects (clip->getClipBounds()))
+                {
+                    auto* edgeTableClip = new EdgeTableRegionType (shape->edgeTable);
+                    edgeTableClip->edgeTable.translate ((float) offset.x, offset.y);
+                    fillShape (edgeTableClip, false);
+                }
+            }
+        }
+    }
+
     void fillEdgeTable (const EdgeTable& edgeTable, const float x, const int y)
     {
         if (clip != nullptr)
@@ -2533,10 +2822,45 @@ public:
     void renderImageTransformed (IteratorType& iter, const Image& src, const int alpha, const AffineTransform& trans, Graphics::ResamplingQuality quality, bool tiledFill) const
     {
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
+
+        // Bilinear sampling skips over source pixels when an image is shrunk to less than
+        // half its size, so that gets drawn from a mipmap level instead.
+        if (quality != Graphics::lowResamplingQuality && ! tiledFill)
+        {
+            auto level = getMipmapLevel (trans);
+
+            if (level > 0)
+            {
+                auto mipmap = src.getMipmap (level);
+
+                const Image::BitmapData srcData (mipmap, Image::BitmapData::readOnly);
+                EdgeTableFillers::renderImageTransformed (iter, destData, srcData, alpha,
+                                                          AffineTransform::scale (src.getWidth()  / (float) mipmap.getWidth(),
+                                                                                  src.getHeight() / (float) mipmap.getHeight())
+                                                                          .followedBy (trans),
+                                                          quality, tiledFill);
+                return;
+            }
+        }
+
         const Image::BitmapData srcData (src, Image::BitmapData::readOnly);
         EdgeTableFillers::renderImageTransformed (iter, destData, srcData, alpha, trans, quality, tiledFill);
     }
 
+    static int getMipmapLevel (const AffineTransform& t) noexcept
+    {
+        auto scale = jmax (juce_hypot (t.mat00, t.mat10), juce_hypot (t.mat01, t.mat11));
+        int level = 0;
+
+        while (scale <= 0.5f && level < 16)
+        {
+            scale *= 2.0f;
+            ++level;
+        }
+
+        return level;
+    }
+
     template <typename IteratorType>
     void renderImageUntransformed (IteratorType& iter, const Image& src, const int alpha, int x, int y, bool tiledFill) const
     {
@@ -2561,17 +2885,18 @@ public:
     template <typename IteratorType>
     void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool isIdentity) const
     {
-        HeapBlock<PixelARGB> lookupTable;
-        const int numLookupEntries = gradient.createLookupTable (trans, lookupTable);
+        auto lookupTable = GradientLookupTableCache::getInstance().getTable (gradient, trans);
+        const PixelARGB* const colours = lookupTable->colours;
+        const int numLookupEntries = lookupTable->numEntries;
         jassert (numLookupEntries > 0);
 
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
 
         switch (destData.pixelFormat)
         {
-            case Image::ARGB:   EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelARGB*) 0); break;
-            case Image::RGB:    EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelRGB*) 0); break;
-            default:            EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelAlpha*) 0); break;
+            case Image::ARGB:   EdgeTableFillers::renderGradient (iter, destData, gradient, trans, colours, numLookupEntries, isIdentity, (PixelARGB*) 0); break;
+            case Image::RGB:    EdgeTableFillers::renderGradient (iter, destData, gradient, trans, colours, numLookupEntries, isIdentity, (PixelRGB*) 0); break;
+            default:            EdgeTableFillers::renderGradient (iter, destData, gradient, trans, colours, numLookupEntries, isIdentity, (PixelAlpha*) 0); break;
         }
     }
 
@@ -2668,6 +2993,7 @@ public:
     void fillRect (const Rectangle<float>& r) override                           { stack->fillRect (r); }
     void fillRectList (const RectangleList<float>& list) override                { stack->fillRectList (list); }
     void fillPath (const Path& path, const AffineTransform& t) override          { stack->fillPath (path, t); }
+    void fillPreparedPath (const PreparedPath& p, const AffineTransform& t) override { stack->fillPreparedPath (p, t); }
     void drawImage (const Image& im, const AffineTransform& t) override          { stack->drawImage (im, t); }
     void drawGlyph (int glyphNumber, const AffineTransform& t) override          { stack->drawGlyph (glyphNumber, t); }
     void drawLine (const Line<float>& line) override                             { stack->drawLine (line); }
@@ -0,0 +1,427 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace RenderingHelpers
+{
+namespace SIMDPixelBlending
+{
+
+static bool isAvailable() noexcept
+{
+    // the vector code expects a PixelARGB's alpha to be its last byte
+    if ((int) PixelARGB::indexA != 3)
+        return false;
+
+   #if JUCE_USE_SSE2_PIXEL_BLENDING
+    static const bool hasSSE2 = SystemStats::hasSSE2();
+    return hasSSE2;
+   #elif JUCE_USE_NEON_PIXEL_BLENDING
+    return true;  // (the NEON code is only compiled for targets that are known to have it)
+   #else
+    return false;
+   #endif
+}
+
+// The vector code treats a PixelRGB as the first three bytes of a PixelARGB, so it can
+// only draw into one if the two formats keep their colour components in the same order.
+static bool rgbComponentsMatchARGB() noexcept
+{
+    return (int) PixelRGB::indexR == (int) PixelARGB::indexR
+        && (int) PixelRGB::indexG == (int) PixelARGB::indexG
+        && (int) PixelRGB::indexB == (int) PixelARGB::indexB;
+}
+
+enum DestFormat
+{
+    argb,       // PixelARGB
+    packedRGB,  // PixelRGB with a 3-byte stride
+    paddedRGB   // PixelRGB with a 4-byte stride, whose fourth byte has to be left alone
+};
+
+//==============================================================================
+#if JUCE_USE_SSE2_PIXEL_BLENDING
+ enum { numPixelsPerOp = 4 };
+
+ // This does the same sums as PixelARGB::blend (src, extraAlpha) to two pixels whose
+ // components have been unpacked into 16-bit values.
+ static forcedinline __m128i blendTwoPixels (__m128i src, __m128i dest, __m128i extraAlpha) noexcept
+ {
+     src = _mm_srli_epi16 (_mm_mullo_epi16 (src, extraAlpha), 8);
+
+     auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+     auto inverseAlpha = _mm_sub_epi16 (_mm_set1_epi16 (0x100), alpha);
+
+     return _mm_add_epi16 (src, _mm_srli_epi16 (_mm_mullo_epi16 (dest, inverseAlpha), 8));
+ }
+
+ static forcedinline __m128i blendFourPixels (__m128i src, __m128i dest, __m128i extraAlpha) noexcept
+ {
+     auto zero = _mm_setzero_si128();
+
+     // (the saturating pack clamps the components in the same way as clampPixelComponents())
+     return _mm_packus_epi16 (blendTwoPixels (_mm_unpacklo_epi8 (src, zero), _mm_unpacklo_epi8 (dest, zero), extraAlpha),
+                              blendTwoPixels (_mm_unpackhi_epi8 (src, zero), _mm_unpackhi_epi8 (dest, zero), extraAlpha));
+ }
+
+ // Loads four 3-byte pixels into the first three bytes of each 32-bit lane
+ static forcedinline __m128i loadFourPackedRGBPixels (const uint8* p) noexcept
+ {
+     int lastFourBytes;
+     memcpy (&lastFourBytes, p + 8, sizeof (lastFourBytes));
+
+     auto packed = _mm_unpacklo_epi64 (_mm_loadl_epi64 ((const __m128i*) p), _mm_cvtsi32_si128 (lastFourBytes));
+
+     return _mm_unpacklo_epi64 (_mm_unpacklo_epi32 (packed, _mm_srli_si128 (packed, 3)),
+                                _mm_unpacklo_epi32 (_mm_srli_si128 (packed, 6), _mm_srli_si128 (packed, 9)));
+ }
+
+ static forcedinline void storeFourPackedRGBPixels (uint8* p, __m128i pixels) noexcept
+ {
+     // squeeze the pixels in each 64-bit half together, then join up the two halves
+     pixels = _mm_and_si128 (pixels, _mm_set1_epi32 (0xffffff));
+
+     auto lowerPixels = _mm_set_epi32 (0, -1, 0, -1);
+     auto pairs = _mm_or_si128 (_mm_and_si128 (pixels, lowerPixels),
+                                _mm_srli_epi64 (_mm_andnot_si128 (lowerPixels, pixels), 8));
+
+     auto packed = _mm_or_si128 (_mm_move_epi64 (pairs), _mm_slli_si128 (_mm_srli_si128 (pairs, 8), 6));
+
+     _mm_storel_epi64 ((__m128i*) p, packed);
+
+     auto lastFourBytes = _mm_cvtsi128_si32 (_mm_srli_si128 (packed, 8));
+     memcpy (p + 8, &lastFourBytes, sizeof (lastFourBytes));
+ }
+
+ template <int format, bool isSolidColour>
+ static forcedinline void blendVectorOfPixels (uint8* dest, const uint8* src, __m128i colour, __m128i extraAlpha) noexcept
+ {
+     auto s = isSolidColour ? colour : _mm_loadu_si128 ((const __m128i*) src);
+
+     if (format == packedRGB)
+     {
+         storeFourPackedRGBPixels (dest, blendFourPixels (s, loadFourPackedRGBPixels (dest), extraAlpha));
+     }
+     else
+     {
+         auto d = _mm_loadu_si128 ((const __m128i*) dest);
+         auto result = blendFourPixels (s, d, extraAlpha);
+
+         if (format == paddedRGB)
+         {
+             auto rgbMask = _mm_set1_epi32 (0xffffff);
+             result = _mm_or_si128 (_mm_and_si128 (result, rgbMask), _mm_andnot_si128 (rgbMask, d));
+         }
+
+         _mm_storeu_si128 ((__m128i*) dest, result);
+     }
+ }
+
+//==============================================================================
+#elif JUCE_USE_NEON_PIXEL_BLENDING
+ enum { numPixelsPerOp = 8 };
+
+ static forcedinline uint8x8_t multiplyAndShift (uint8x8_t a, uint16x8_t b) noexcept
+ {
+     return vshrn_n_u16 (vmulq_u16 (vmovl_u8 (a), b), 8);
+ }
+
+ // This does the same sums as PixelARGB::blend (src, extraAlpha) to eight pixels whose
+ // components have been split into separate vectors.
+ template <int numComponents, typename DestVectorType>
+ static forcedinline void blendEightPixels (uint8x8x4_t src, DestVectorType& dest, uint16x8_t extraAlpha) noexcept
+ {
+     for (int i = 0; i < 4; ++i)
+         src.val[i] = multiplyAndShift (src.val[i], extraAlpha);
+
+     auto inverseAlpha = vsubq_u16 (vdupq_n_u16 (0x100), vmovl_u8 (src.val[3]));
+
+     // (the saturating add clamps the components in the same way as clampPixelComponents())
+     for (int i = 0; i < numComponents; ++i)
+         dest.val[i] = vqadd_u8 (src.val[i], multiplyAndShift (dest.val[i], inverseAlpha));
+ }
+
+ template <int format, bool isSolidColour>
+ static forcedinline void blendVectorOfPixels (uint8* dest, const uint8* src, uint8x8x4_t colour, uint16x8_t extraAlpha) noexcept
+ {
+     auto s = isSolidColour ? colour : vld4_u8 (src);
+
+     if (format == packedRGB)
+     {
+         auto d = vld3_u8 (dest);
+         blendEightPixels<3> (s, d, extraAlpha);
+         vst3_u8 (dest, d);
+     }
+     else
+     {
+         auto d = vld4_u8 (dest);
+         blendEightPixels<format == argb ? 4 : 3> (s, d, extraAlpha);
+         vst4_u8 (dest, d);
+     }
+ }
+#endif
+
+//==============================================================================
+template <int format>
+static forcedinline void blendPixel (uint8* dest, PixelARGB src, uint32 extraAlpha) noexcept
+{
+    if (format == argb)
+        reinterpret_cast<PixelARGB*> (dest)->blend (src, extraAlpha);
+    else
+        reinterpret_cast<PixelRGB*> (dest)->blend (src, extraAlpha);
+}
+
+template <int format, bool isSolidColour>
+static void blendRun (uint8* dest, const PixelARGB* src, PixelARGB colour, int numPixels, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha <= 0x100);
+
+    const int destStride = format == packedRGB ? 3 : 4;
+
+   #if JUCE_USE_SSE2_PIXEL_BLENDING || JUCE_USE_NEON_PIXEL_BLENDING
+    #if JUCE_USE_SSE2_PIXEL_BLENDING
+     auto colourVector = _mm_set1_epi32 ((int) colour.getNativeARGB());
+     auto extraAlphaVector = _mm_set1_epi16 ((short) extraAlpha);
+    #else
+     uint8x8x4_t colourVector;
+
+     for (int i = 0; i < 4; ++i)
+         colourVector.val[i] = vdup_n_u8 (reinterpret_cast<const uint8*> (&colour)[i]);
+
+     auto extraAlphaVector = vdupq_n_u16 ((uint16) extraAlpha);
+    #endif
+
+    for (; numPixels >= numPixelsPerOp; numPixels -= numPixelsPerOp)
+    {
+        blendVectorOfPixels<format, isSolidColour> (dest, reinterpret_cast<const uint8*> (src), colourVector, extraAlphaVector);
+        dest += numPixelsPerOp * destStride;
+
+        if (! isSolidColour)
+            src += numPixelsPerOp;
+    }
+   #endif
+
+    for (; numPixels > 0; --numPixels)
+    {
+        blendPixel<format> (dest, isSolidColour ? colour : *src, extraAlpha);
+        dest += destStride;
+
+        if (! isSolidColour)
+            ++src;
+    }
+}
+
+//==============================================================================
+bool canBlendInto (const PixelARGB*, int destPixelStride) noexcept
+{
+    return destPixelStride == 4 && isAvailable();
+}
+
+bool canBlendInto (const PixelRGB*, int destPixelStride) noexcept
+{
+    return (destPixelStride == 3 || destPixelStride == 4) && rgbComponentsMatchARGB() && isAvailable();
+}
+
+bool blendColour (PixelARGB* dest, int destPixelStride, PixelARGB colour, int numPixels) noexcept
+{
+    if (! canBlendInto (dest, destPixelStride))
+        return false;
+
+    blendRun<argb, true> ((uint8*) dest, nullptr, colour, numPixels, 0x100);
+    return true;
+}
+
+bool blendColour (PixelRGB* dest, int destPixelStride, PixelARGB colour, int numPixels) noexcept
+{
+    if (! canBlendInto (dest, destPixelStride))
+        return false;
+
+    if (destPixelStride == 3)
+        blendRun<packedRGB, true> ((uint8*) dest, nullptr, colour, numPixels, 0x100);
+    else
+        blendRun<paddedRGB, true> ((uint8*) dest, nullptr, colour, numPixels, 0x100);
+
+    return true;
+}
+
+bool blendPixels (PixelARGB* dest, int destPixelStride, const PixelARGB* src, int srcPixelStride, int numPixels, uint32 extraAlpha) noexcept
+{
+    if (srcPixelStride != 4 || ! canBlendInto (dest, destPixelStride))
+        return false;
+
+    blendRun<argb, false> ((uint8*) dest, src, PixelARGB (0, 0, 0, 0), numPixels, extraAlpha);
+    return true;
+}
+
+bool blendPixels (PixelRGB* dest, int destPixelStride, const PixelARGB* src, int srcPixelStride, int numPixels, uint32 extraAlpha) noexcept
+{
+    if (srcPixelStride != 4 || ! canBlendInto (dest, destPixelStride))
+        return false;
+
+    if (destPixelStride == 3)
+        blendRun<packedRGB, false> ((uint8*) dest, src, PixelARGB (0, 0, 0, 0), numPixels, extraAlpha);
+    else
+        blendRun<paddedRGB, false> ((uint8*) dest, src, PixelARGB (0, 0, 0, 0), numPixels, extraAlpha);
+
+    return true;
+}
+
+//==============================================================================
+#if JUCE_USE_SSE2_PIXEL_BLENDING
+ // Limits four lookup indexes to the range 0 to maxIndex
+ static forcedinline __m128i clampIndexes (__m128i indexes, __m128i maxIndex) noexcept
+ {
+     indexes = _mm_andnot_si128 (_mm_srai_epi32 (indexes, 31), indexes);
+     auto tooBig = _mm_cmpgt_epi32 (indexes, maxIndex);
+     return _mm_or_si128 (_mm_andnot_si128 (tooBig, indexes), _mm_and_si128 (tooBig, maxIndex));
+ }
+
+ static forcedinline void lookUpColours (PixelARGB* dest, const PixelARGB* lookupTable, __m128i indexes) noexcept
+ {
+     int32 i[4];
+     _mm_storeu_si128 ((__m128i*) i, indexes);
+
+     dest[0] = lookupTable[i[0]];
+     dest[1] = lookupTable[i[1]];
+     dest[2] = lookupTable[i[2]];
+     dest[3] = lookupTable[i[3]];
+ }
+
+bool fillLinearGradientSpan (PixelARGB* dest, int numPixels, const PixelARGB* lookupTable, int maxIndex,
+                             int startPosition, int positionStep, int numScaleBits) noexcept
+{
+    if (! isAvailable())
+        return false;
+
+    auto positions = _mm_setr_epi32 (startPosition, startPosition + positionStep,
+                                     startPosition + positionStep * 2, startPosition + positionStep * 3);
+    auto step = _mm_set1_epi32 (positionStep * 4);
+    auto shift = _mm_cvtsi32_si128 (numScaleBits);
+    auto maxIndexVector = _mm_set1_epi32 (maxIndex);
+
+    for (; numPixels >= 4; numPixels -= 4)
+    {
+        lookUpColours (dest, lookupTable, clampIndexes (_mm_sra_epi32 (positions, shift), maxIndexVector));
+        positions = _mm_add_epi32 (positions, step);
+        dest += 4;
+    }
+
+    for (auto position = _mm_cvtsi128_si32 (positions); numPixels > 0; --numPixels)
+    {
+        *dest++ = lookupTable [jlimit (0, maxIndex, position >> numScaleBits)];
+        position += positionStep;
+    }
+
+    return true;
+}
+
+// When the gradient isn't transformed, each pixel's vertical offset from the centre is the same,
+// so this skips the sums that the general case needs for it
+template <bool isTransformed>
+static void fillRadialRun (PixelARGB* dest, int numPixels, const PixelARGB* lookupTable, int maxIndex, int x,
+                           double xScale, double xOffset, double yScale, double yOffset,
+                           double maxDistSquared, float invScale) noexcept
+{
+    auto xScaleVector = _mm_set1_pd (xScale), xOffsetVector = _mm_set1_pd (xOffset);
+    auto yScaleVector = _mm_set1_pd (yScale), yOffsetVector = _mm_set1_pd (yOffset);
+    auto yOffsetSquared = _mm_set1_pd (yOffset * yOffset);
+    auto maxDistVector = _mm_set1_pd (maxDistSquared);
+    auto invScaleVector = _mm_set1_ps (invScale);
+    auto maxIndexVector = _mm_set1_epi32 (maxIndex);
+
+    // returns the squared distances from the centre for pixels firstX and firstX + 1
+    auto getDistances = [&] (int firstX) noexcept
+    {
+        auto xs = _mm_setr_pd ((double) firstX, (double) (firstX + 1));
+
+        if (! isTransformed)
+        {
+            auto dx = _mm_add_pd (xs, xOffsetVector);
+            return _mm_add_pd (_mm_mul_pd (dx, dx), yOffsetSquared);
+        }
+
+        auto dx = _mm_add_pd (_mm_mul_pd (xScaleVector, xs), xOffsetVector);
+        auto dy = _mm_add_pd (_mm_mul_pd (yScaleVector, xs), yOffsetVector);
+        return _mm_add_pd (_mm_mul_pd (dx, dx), _mm_mul_pd (dy, dy));
+    };
+
+    auto getIndexes = [&] (int firstX) noexcept
+    {
+        auto dist1 = getDistances (firstX);
+        auto dist2 = getDistances (firstX + 2);
+
+        // the square roots are done in single precision, like the iterators' getPixel() methods
+        auto distances = _mm_sqrt_ps (_mm_movelh_ps (_mm_cvtpd_ps (dist1), _mm_cvtpd_ps (dist2)));
+        auto indexes = _mm_cvtps_epi32 (_mm_mul_ps (distances, invScaleVector));
+
+        auto beyondEnd = _mm_castps_si128 (_mm_shuffle_ps (_mm_castpd_ps (_mm_cmpge_pd (dist1, maxDistVector)),
+                                                           _mm_castpd_ps (_mm_cmpge_pd (dist2, maxDistVector)),
+                                                           _MM_SHUFFLE (2, 0, 2, 0)));
+
+        return clampIndexes (_mm_or_si128 (_mm_andnot_si128 (beyondEnd, indexes),
+                                           _mm_and_si128 (beyondEnd, maxIndexVector)), maxIndexVector);
+    };
+
+    for (; numPixels >= 4; numPixels -= 4)
+    {
+        lookUpColours (dest, lookupTable, getIndexes (x));
+        x += 4;
+        dest += 4;
+    }
+
+    if (numPixels > 0)
+    {
+        PixelARGB lastColours[4];
+        lookUpColours (lastColours, lookupTable, getIndexes (x));
+
+        for (int i = 0; i < numPixels; ++i)
+            dest[i] = lastColours[i];
+    }
+}
+
+bool fillRadialGradientSpan (PixelARGB* dest, int numPixels, const PixelARGB* lookupTable, int maxIndex, int x,
+                             double xScale, double xOffset, double yScale, double yOffset,
+                             double maxDistSquared, float invScale) noexcept
+{
+    if (! isAvailable())
+        return false;
+
+    if (xScale == 1.0 && yScale == 0.0)
+        fillRadialRun<false> (dest, numPixels, lookupTable, maxIndex, x, xScale, xOffset, yScale, yOffset, maxDistSquared, invScale);
+    else
+        fillRadialRun<true>  (dest, numPixels, lookupTable, maxIndex, x, xScale, xOffset, yScale, yOffset, maxDistSquared, invScale);
+
+    return true;
+}
+#else
+bool fillLinearGradientSpan (PixelARGB*, int, const PixelARGB*, int, int, int, int) noexcept                                { return false; }
+bool fillRadialGradientSpan (PixelARGB*, int, const PixelARGB*, int, int, double, double, double, double, double, float) noexcept  { return false; }
+#endif
+
+} // namespace SIMDPixelBlending
+} // namespace RenderingHelpers
+} // namespace juce
@@ -66,6 +66,12 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return StringArray ("/system/fonts");
 }
 
+File FTTypefaceList::getIndexFile()
+{
+    // the system fonts are quick to scan, so it's not worth keeping an index
+    return {};
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
@@ -85,11 +85,20 @@ struct FTFaceWrapper     : public ReferenceCountedObject
 };
 
 //==============================================================================
+/*  Keeps a list of the fonts that are installed.
+
+    Opening every font file with FreeType to find its family and style names is slow
+    when there are lots of fonts, so the names are kept in an index file along with
+    each file's size and modification time. On later runs, only the files which have
+    changed need to be opened, and the faces themselves aren't opened until a
+    typeface is actually created.
+*/
 class FTTypefaceList  : private DeletedAtShutdown
 {
 public:
     FTTypefaceList()  : library (new FTLibWrapper())
     {
+        loadIndex();
         scanFontPaths (getDefaultFontDirectories());
     }
 
@@ -101,12 +110,13 @@ public:
     //==============================================================================
     struct KnownTypeface
     {
-        KnownTypeface (const File& f, const int index, const FTFaceWrapper& face)
+        KnownTypeface (const File& f, const int index, const String& familyName,
+                       const String& styleName, bool monospaced)
            : file (f),
-             family (face.face->family_name),
-             style (face.face->style_name),
+             family (familyName),
+             style (styleName),
              faceIndex (index),
-             isMonospaced ((face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0),
+             isMonospaced (monospaced),
              isSansSerif (isFaceSansSerif (family))
         {
         }
@@ -202,10 +212,15 @@ public:
             DirectoryIterator iter (File::getCurrentWorkingDirectory()
                                        .getChildFile (paths[i]), true);
 
-            while (iter.next())
+            int64 fileSize;
+            Time modificationTime;
+
+            while (iter.next (nullptr, nullptr, &fileSize, &modificationTime, nullptr, nullptr))
                 if (iter.getFile().hasFileExtension ("ttf;pfb;pcf;otf"))
-                    scanFont (iter.getFile());
+                    scanFont (iter.getFile(), fileSize, modificationTime.toMilliseconds());
         }
+
+        saveIndexIfChanged();
     }
 
     void getMonospacedNames (StringArray& monoSpaced) const
@@ -232,13 +247,53 @@ public:
     juce_DeclareSingleton_SingleThreaded_Minimal (FTTypefaceList)
 
 private:
+    //==============================================================================
+    struct IndexedFace
+    {
+        String family, style;
+        int faceIndex;
+        bool isMonospaced;
+    };
+
+    struct IndexedFile
+    {
+        int64 fileSize = -1, modificationTime = 0;
+        Array<IndexedFace> faces;
+        bool wasFound = false;
+    };
+
     FTLibWrapper::Ptr library;
     OwnedArray<KnownTypeface> faces;
+    FlatHashMap<String, IndexedFile> indexedFiles;
+    bool indexChanged = false;
 
     static StringArray getDefaultFontDirectories();
+    static File getIndexFile();
+
+    void scanFont (const File& file, int64 fileSize, int64 modificationTime)
+    {
+        auto& indexed = indexedFiles.getReference (file.getFullPathName());
+
+        if (indexed.wasFound)
+            return;
+
+        if (indexed.fileSize != fileSize || indexed.modificationTime != modificationTime)
+        {
+            indexed.fileSize = fileSize;
+            indexed.modificationTime = modificationTime;
+            indexed.faces = readFaces (file);
+            indexChanged = true;
+        }
+
+        indexed.wasFound = true;
+
+        for (auto& f : indexed.faces)
+            faces.add (new KnownTypeface (file, f.faceIndex, f.family, f.style, f.isMonospaced));
+    }
 
-    void scanFont (const File& file)
+    Array<IndexedFace> readFaces (const File& file) const
     {
+        Array<IndexedFace> result;
         int faceIndex = 0;
         int numFaces = 0;
 
@@ -252,12 +307,112 @@ private:
                     numFaces = (int) face.face->num_faces;
 
                 if ((face.face->face_flags & FT_FACE_FLAG_SCALABLE) != 0)
-                    faces.add (new KnownTypeface (file, faceIndex, face));
+                    result.add ({ face.face->family_name, face.face->style_name, faceIndex,
+                                  (face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0 });
             }
 
             ++faceIndex;
         }
         while (faceIndex < numFaces);
+
+        return result;
+    }
+
+    //==============================================================================
+    enum { indexMagicNumber = 0x4a465849, indexVersion = 1 };
+
+    void loadIndex()
+    {
+        auto indexFile = getIndexFile();
+
+        if (! indexFile.existsAsFile())
+            return;
+
+        FileInputStream in (indexFile);
+
+        if (! in.openedOk() || in.readInt() != indexMagicNumber || in.readInt() != indexVersion)
+            return;
+
+        for (auto numFiles = in.readInt(); --numFiles >= 0 && ! in.isExhausted();)
+        {
+            auto path = in.readString();
+            IndexedFile indexed;
+            indexed.fileSize = in.readInt64();
+            indexed.modificationTime = in.readInt64();
+
+            for (auto numFaces = in.readCompressedInt(); --numFaces >= 0;)
+            {
+                IndexedFace f;
+                f.family = in.readString();
+                f.style = in.readString();
+                f.faceIndex = in.readCompressedInt();
+                f.isMonospaced = in.readBool();
+                indexed.faces.add (f);
+            }
+
+            indexedFiles.set (path, indexed);
+        }
+
+        // if the file has been truncated, the last entry can't be trusted
+        if (in.readInt() != indexMagicNumber)
+            indexedFiles.clear();
+    }
+
+    void saveIndexIfChanged()
+    {
+        // forget about any files that have been deleted since the index was written
+        StringArray deletedFiles;
+
+        for (auto& item : indexedFiles)
+            if (! item.value.wasFound && ! File (item.key).existsAsFile())
+                deletedFiles.add (item.key);
+
+        for (auto& path : deletedFiles)
+            indexedFiles.remove (path);
+
+        auto indexFile = getIndexFile();
+
+        if ((! indexChanged && deletedFiles.isEmpty()) || indexFile == File())
+            return;
+
+        indexChanged = false;
+        indexFile.getParentDirectory().createDirectory();
+        TemporaryFile temp (indexFile);
+
+        {
+            FileOutputStream out (temp.getFile());
+
+            if (! out.openedOk())
+                return;
+
+            out.writeInt (indexMagicNumber);
+            out.writeInt (indexVersion);
+            out.writeInt (indexedFiles.size());
+
+            for (auto& item : indexedFiles)
+            {
+                out.writeString (item.key);
+                out.writeInt64 (item.value.fileSize);
+                out.writeInt64 (item.value.modificationTime);
+                out.writeCompressedInt (item.value.faces.size());
+
+                for (auto& f : item.value.faces)
+                {
+                    out.writeString (f.family);
+                    out.writeString (f.style);
+                    out.writeCompressedInt (f.faceIndex);
+                    out.writeBool (f.isMonospaced);
+                }
+            }
+
+            out.writeInt (indexMagicNumber);
+            out.flush();
+
+            if (out.getStatus().failed())
+                return;
+        }
+
+        temp.overwriteTargetFileWithTemporary();
     }
 
     const KnownTypeface* matchTypeface (const String& familyName, const String& style) const noexcept
@@ -79,6 +79,16 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return fontDirs;
 }
 
+File FTTypefaceList::getIndexFile()
+{
+    auto cacheDir = SystemStats::getEnvironmentVariable ("XDG_CACHE_HOME", {});
+
+    if (cacheDir.trim().isEmpty())
+        cacheDir = "~/.cache";
+
+    return File (cacheDir).getChildFile ("JUCE").getChildFile ("fontindex");
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
@@ -1104,6 +1104,204 @@ Point<int> Component::relativePositionToOtherComponent (const Component* const t
 }
 
 
+//==============================================================================
+struct Component::BatchedBoundsUpdate::PendingChanges
+{
+    static PendingChanges& get()
+    {
+        static PendingChanges pending;
+        return pending;
+    }
+
+    static bool isBatching() noexcept       { return get().depth > 0; }
+
+    void addComponent (Component& c)
+    {
+        if (! c.flags.isBoundsChangeBatched)
+        {
+            c.flags.isBoundsChangeBatched = true;
+
+            auto* parent = c.getParentComponent();
+            changes.add ({ &c, parent, c.getBounds(),
+                           parent != nullptr ? ComponentHelpers::convertToParentSpace (c, c.getLocalBounds()) : Rectangle<int>(),
+                           c.isShowing() });
+        }
+    }
+
+    void deliverChanges()
+    {
+        bool anyShowing = false;
+
+        // The callbacks may move more components, which get added to the list and are
+        // dealt with in the next pass
+        while (! changes.isEmpty())
+        {
+            Array<Change> batch;
+            batch.swapWith (changes);
+
+            RepaintAreas repaints;
+
+            for (auto& change : batch)
+            {
+                auto* c = change.component.get();
+
+                if (c != nullptr)
+                {
+                    c->flags.isBoundsChangeBatched = false;
+                    c->flags.isMoveCallbackPending   = c->getPosition() != change.originalBounds.getPosition();
+                    c->flags.isResizeCallbackPending = c->getWidth()  != change.originalBounds.getWidth()
+                                                        || c->getHeight() != change.originalBounds.getHeight();
+
+                    if (! (c->flags.isMoveCallbackPending || c->flags.isResizeCallbackPending))
+                        continue;
+                }
+
+                if (change.wasShowing)
+                    repaints.add (change.parent.get(), change.originalArea);
+
+                if (c != nullptr)
+                {
+                    if (c->isShowing())
+                    {
+                        anyShowing = true;
+
+                        if (RepaintProfiler::isEnabled())
+                            RepaintProfiler::componentInvalidated (*c, c->getLocalBounds());
+
+                        repaints.add (c->getParentComponent(),
+                                      ComponentHelpers::convertToParentSpace (*c, c->getLocalBounds()));
+
+                        if (c->flags.isResizeCallbackPending && c->cachedImage != nullptr)
+                            c->cachedImage->invalidateAll();
+                    }
+                    else if (c->cachedImage != nullptr)
+                    {
+                        c->cachedImage->invalidateAll();
+                    }
+                }
+            }
+
+            repaints.repaint();
+
+            for (auto& change : batch)
+                if (auto* c = change.component.get())
+                    c->sendMovedResizedMessagesIfPending();
+        }
+
+        if (anyShowing)
+        {
+            auto mainMouse = Desktop::getInstance().getMainMouseSource();
+
+            if (! mainMouse.isDragging())
+                mainMouse.triggerFakeMove();
+        }
+    }
+
+    struct Change
+    {
+        WeakReference<Component> component, parent;
+        Rectangle<int> originalBounds, originalArea;
+        bool wasShowing;
+    };
+
+    // Collects the areas to repaint in each parent, so that they can be merged
+    struct RepaintAreas
+    {
+        void add (Component* parent, Rectangle<int> area)
+        {
+            if (parent != nullptr && ! area.isEmpty())
+            {
+                if (! regionIndexes.contains (parent))
+                {
+                    regionIndexes.set (parent, regions.size());
+                    regions.add (Region (parent));
+                }
+
+                regions.getReference (regionIndexes[parent]).add (area);
+            }
+        }
+
+        void repaint()
+        {
+            for (auto& r : regions)
+                r.repaint();
+        }
+
+        struct Region
+        {
+            explicit Region (Component* p) noexcept  : parent (p) {}
+
+            void add (Rectangle<int> area)
+            {
+                areas.add (area);
+                bounds = bounds.getUnion (area);
+                totalArea += area.getWidth() * (int64) area.getHeight();
+            }
+
+            void repaint()
+            {
+                if (areas.size() <= maxAreasToMerge)
+                {
+                    RectangleList<int> merged;
+
+                    for (auto& a : areas)
+                        merged.add (a);
+
+                    merged.consolidate();
+
+                    for (auto& a : merged)
+                        parent->internalRepaint (a);
+                }
+                else if (totalArea >= bounds.getWidth() * (int64) bounds.getHeight() / 2)
+                {
+                    // Merging lots of areas exactly is slow, so if they cover most of their
+                    // bounding box, it's quicker to redraw the whole box
+                    parent->internalRepaint (bounds);
+                }
+                else
+                {
+                    for (auto& a : areas)
+                        parent->internalRepaint (a);
+                }
+            }
+
+            enum { maxAreasToMerge = 16 };
+
+            Component* parent;
+            Array<Rectangle<int>> areas;
+            Rectangle<int> bounds;
+            int64 totalArea = 0;
+        };
+
+        Array<Region> regions;
+        HashMap<Component*, int> regionIndexes;
+    };
+
+    Array<Change> changes;
+    int depth = 0;
+};
+
+Component::BatchedBoundsUpdate::BatchedBoundsUpdate()
+{
+    // if component methods are being called from threads other than the message
+    // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    ++PendingChanges::get().depth;
+}
+
+Component::BatchedBoundsUpdate::~BatchedBoundsUpdate()
+{
+    auto& pending = PendingChanges::get();
+
+    // The depth is left unchanged while the callbacks are made, so that any components
+    // they move are batched up too
+    if (pending.depth == 1)
+        pending.deliverChanges();
+
+    --pending.depth;
+}
+
 //==============================================================================
 void Component::setBounds (const int x, const int y, int w, int h)
 {
@@ -1124,6 +1322,13 @@ void Component::setBounds (const int x, const int y, int w, int h)
 
     if (wasMoved || wasResized)
     {
+        if (BatchedBoundsUpdate::PendingChanges::isBatching() && ! flags.hasHeavyweightPeerFlag)
+        {
+            BatchedBoundsUpdate::PendingChanges::get().addComponent (*this);
+            boundsRelativeToParent.setBounds (x, y, w, h);
+            return;
+        }
+
         const bool showing = isShowing();
         if (showing)
         {
@@ -1869,23 +2074,34 @@ void Component::alphaChanged()
 //==============================================================================
 void Component::repaint()
 {
+    if (RepaintProfiler::isEnabled())
+        RepaintProfiler::componentInvalidated (*this, getLocalBounds());
+
     internalRepaintUnchecked (getLocalBounds(), true);
 }
 
 void Component::repaint (int x, int y, int w, int h)
 {
-    internalRepaint ({ x, y, w, h });
+    repaint ({ x, y, w, h });
 }
 
 void Component::repaint (Rectangle<int> area)
 {
+    if (RepaintProfiler::isEnabled())
+        RepaintProfiler::componentInvalidated (*this, area.getIntersection (getLocalBounds()));
+
     internalRepaint (area);
 }
 
 void Component::repaintParent()
 {
     if (parentComponent != nullptr)
+    {
+        if (RepaintProfiler::isEnabled())
+            RepaintProfiler::componentInvalidated (*this, getLocalBounds());
+
         parentComponent->internalRepaint (ComponentHelpers::convertToParentSpace (*this, getLocalBounds()));
+    }
 }
 
 void Component::internalRepaint (Rectangle<int> area)
@@ -1927,6 +2143,11 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
                 parentComponent->internalRepaint (ComponentHelpers::convertToParentSpace (*this, area));
         }
     }
+    else if (cachedImage != nullptr)
+    {
+        // nothing needs to be redrawn, but the cached image is now out of date
+        cachedImage->invalidateAll();
+    }
 }
 
 //==============================================================================
@@ -1955,8 +2176,15 @@ void Component::paintWithinParentContext (Graphics& g)
 
 void Component::paintComponentAndChildren (Graphics& g)
 {
+    JUCE_TRACE_ZONE ("Component paint");
     auto clipBounds = g.getClipBounds();
 
+    const bool isProfiling = RepaintProfiler::isEnabled();
+    int64 paintStartTicks = 0, paintTicks = 0;
+
+    if (isProfiling)
+        paintStartTicks = Time::getHighResolutionTicks();
+
     if (flags.dontClipGraphicsFlag)
     {
         paint (g);
@@ -1971,6 +2199,9 @@ void Component::paintComponentAndChildren (Graphics& g)
         g.restoreState();
     }
 
+    if (isProfiling)
+        paintTicks = Time::getHighResolutionTicks() - paintStartTicks;
+
     for (int i = 0; i < childComponentList.size(); ++i)
     {
         auto& child = *childComponentList.getUnchecked (i);
@@ -2019,9 +2250,19 @@ void Component::paintComponentAndChildren (Graphics& g)
         }
     }
 
+    if (isProfiling)
+        paintStartTicks = Time::getHighResolutionTicks();
+
     g.saveState();
     paintOverChildren (g);
     g.restoreState();
+
+    // (this only counts the time taken by this component's own paint methods, not by its children)
+    if (isProfiling)
+    {
+        paintTicks += Time::getHighResolutionTicks() - paintStartTicks;
+        RepaintProfiler::componentPainted (*this, Time::highResolutionTicksToSeconds (paintTicks) * 1000.0);
+    }
 }
 
 void Component::paintEntireComponent (Graphics& g, const bool ignoreAlphaLevel)
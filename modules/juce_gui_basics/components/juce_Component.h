@@ -2166,6 +2166,58 @@ public:
         JUCE_DECLARE_NON_COPYABLE (BailOutChecker)
     };
 
+    //==============================================================================
+    /** Defers the callbacks and repaints caused by moving or resizing components
+        until the end of a block of code.
+
+        Normally, each call to setBounds() repaints the areas that have changed and
+        synchronously calls moved(), resized() and any ComponentListeners. When you're
+        moving a lot of components at once, that's a lot of separate callbacks and
+        overlapping repaints.
+
+        While one of these objects exists, setBounds() and its relatives just change
+        the component's position. When it's deleted, each component that moved or
+        changed size gets a single set of callbacks, and the areas that need to be
+        redrawn are merged before being repainted. If a component ends up back where
+        it started, it doesn't get any callbacks at all.
+
+        @code
+        void resized() override
+        {
+            const Component::BatchedBoundsUpdate batch;
+
+            for (auto* button : buttons)
+                button->setBounds (getBoundsForButton (button));
+
+            // the buttons' resized() methods get called here
+        }
+        @endcode
+
+        Objects can be nested, and the callbacks are made when the outermost one is
+        deleted. Any components that get moved during those callbacks are batched up
+        too. Components that are on the desktop aren't affected, and always move
+        immediately.
+
+        This must only be used on the message thread.
+    */
+    class JUCE_API  BatchedBoundsUpdate
+    {
+    public:
+        /** Starts deferring bounds change callbacks. */
+        BatchedBoundsUpdate();
+
+        /** Sends any pending callbacks and repaints, unless another
+            BatchedBoundsUpdate is still active.
+        */
+        ~BatchedBoundsUpdate();
+
+    private:
+        struct PendingChanges;
+        friend class Component;
+
+        JUCE_DECLARE_NON_COPYABLE (BatchedBoundsUpdate)
+    };
+
     //==============================================================================
     /**
         Base class for objects that can be used to automatically position a component according to
@@ -2215,7 +2267,7 @@ public:
     /** Gives the component a CachedComponentImage that should be used to buffer its painting.
         The object that is passed-in will be owned by this component, and will be deleted automatically
         later on.
-        @see setBufferedToImage
+        @see setBufferedToImage, TiledCachedComponentImage
     */
     void setCachedComponentImage (CachedComponentImage* newCachedImage);
 
@@ -2297,6 +2349,7 @@ private:
         bool mouseDownWasBlocked        : 1;
         bool isMoveCallbackPending      : 1;
         bool isResizeCallbackPending    : 1;
+        bool isBoundsChangeBatched      : 1;
         bool viewportIgnoreDragFlag     : 1;
        #if JUCE_DEBUG
         bool isInsidePaintCall          : 1;
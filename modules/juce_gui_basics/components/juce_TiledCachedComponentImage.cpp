@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TiledCachedComponentImage::Tile
+{
+    Tile (int c, int r) noexcept : column (c), row (r) {}
+
+    size_t getSizeInBytes() const noexcept
+    {
+        return image.isNull() ? 0 : (size_t) (image.getWidth() * image.getHeight() * 4);
+    }
+
+    const int column, row;
+    Image image;
+    RectangleList<int> validArea; // in the component's coordinates
+    uint32 lastUsed = 0;
+};
+
+//==============================================================================
+TiledCachedComponentImage::TiledCachedComponentImage (Component& c, int size, size_t maxMemoryBytes)
+    : owner (c), tileSize (jmax (16, size)), memoryBudget (maxMemoryBytes)
+{
+}
+
+TiledCachedComponentImage::~TiledCachedComponentImage() {}
+
+void TiledCachedComponentImage::setTileSize (int newTileSize)
+{
+    newTileSize = jmax (16, newTileSize);
+
+    if (tileSize != newTileSize)
+    {
+        tileSize = newTileSize;
+        tiles.clear();
+    }
+}
+
+void TiledCachedComponentImage::setMemoryBudget (size_t maxMemoryBytes)
+{
+    memoryBudget = maxMemoryBytes;
+    evictTiles();
+}
+
+size_t TiledCachedComponentImage::getMemoryUsed() const noexcept
+{
+    size_t total = 0;
+
+    for (auto* t : tiles)
+        total += t->getSizeInBytes();
+
+    return total;
+}
+
+//==============================================================================
+void TiledCachedComponentImage::paint (Graphics& g)
+{
+    auto newScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (newScale != scale)
+    {
+        scale = newScale;
+        tiles.clear();
+    }
+
+    auto compBounds = owner.getLocalBounds();
+    auto visibleArea = g.getClipBounds().getIntersection (compBounds);
+
+    if (visibleArea.isEmpty())
+        return;
+
+    ++paintCount;
+
+    auto physicalArea = (visibleArea.toFloat() * scale).getSmallestIntegerContainer();
+    auto firstColumn = physicalArea.getX() / tileSize;
+    auto firstRow    = physicalArea.getY() / tileSize;
+    auto lastColumn  = (physicalArea.getRight()  - 1) / tileSize;
+    auto lastRow     = (physicalArea.getBottom() - 1) / tileSize;
+
+    Graphics::ScopedSaveState ss (g);
+    g.reduceClipRegion (compBounds);
+    g.setColour (Colours::black.withAlpha (owner.getAlpha()));
+
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            auto& tile = getTile (column, row);
+            tile.lastUsed = paintCount;
+            renderTile (tile);
+
+            g.drawImageTransformed (tile.image, AffineTransform::translation ((float) (column * tileSize),
+                                                                              (float) (row * tileSize))
+                                                                 .scaled (1.0f / scale), false);
+        }
+    }
+
+    evictTiles();
+}
+
+bool TiledCachedComponentImage::invalidateAll()
+{
+    for (auto* t : tiles)
+        t->validArea.clear();
+
+    return true;
+}
+
+bool TiledCachedComponentImage::invalidate (const Rectangle<int>& area)
+{
+    for (auto* t : tiles)
+        if (t->validArea.intersectsRectangle (area))
+            t->validArea.subtract (area);
+
+    return true;
+}
+
+void TiledCachedComponentImage::releaseResources()
+{
+    tiles.clear();
+}
+
+//==============================================================================
+TiledCachedComponentImage::Tile& TiledCachedComponentImage::getTile (int column, int row)
+{
+    for (auto* t : tiles)
+        if (t->column == column && t->row == row)
+            return *t;
+
+    return *tiles.add (new Tile (column, row));
+}
+
+Rectangle<int> TiledCachedComponentImage::getTileArea (const Tile& tile) const
+{
+    return (Rectangle<float> ((float) (tile.column * tileSize), (float) (tile.row * tileSize),
+                              (float) tileSize, (float) tileSize) / scale)
+              .getSmallestIntegerContainer()
+              .getIntersection (owner.getLocalBounds());
+}
+
+void TiledCachedComponentImage::renderTile (Tile& tile)
+{
+    auto area = getTileArea (tile);
+
+    if (tile.image.isNull())
+    {
+        tile.image = Image (owner.isOpaque() ? Image::RGB : Image::ARGB, tileSize, tileSize, ! owner.isOpaque());
+        tile.validArea.clear();
+    }
+
+    if (tile.validArea.containsRectangle (area))
+        return;
+
+    Graphics imG (tile.image);
+    auto& lg = imG.getInternalContext();
+
+    lg.addTransform (AffineTransform::scale (scale)
+                       .translated ((float) (-tile.column * tileSize), (float) (-tile.row * tileSize)));
+
+    lg.clipToRectangle (area);
+
+    for (auto& r : tile.validArea)
+        lg.excludeClipRectangle (r);
+
+    if (! owner.isOpaque())
+    {
+        lg.setFill (Colours::transparentBlack);
+        lg.fillRect (area, true);
+        lg.setFill (Colours::black);
+    }
+
+    owner.paintEntireComponent (imG, true);
+
+    tile.validArea = area;
+}
+
+void TiledCachedComponentImage::evictTiles()
+{
+    auto used = getMemoryUsed();
+
+    while (used > memoryBudget)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < tiles.size(); ++i)
+            if (tiles.getUnchecked (i)->lastUsed != paintCount
+                 && (oldest < 0 || tiles.getUnchecked (i)->lastUsed < tiles.getUnchecked (oldest)->lastUsed))
+                oldest = i;
+
+        // everything that's left is on-screen, so has to be kept
+        if (oldest < 0)
+            break;
+
+        used -= tiles.getUnchecked (oldest)->getSizeInBytes();
+        tiles.remove (oldest);
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A CachedComponentImage that buffers a component in a grid of fixed-size tiles.
+
+    Component::setBufferedToImage() keeps one image the size of the whole component,
+    which is a problem for very large components, e.g. a long timeline inside a
+    Viewport. This class only creates tiles for the parts of the component that
+    actually get painted, and when the tiles use more than a given amount of memory,
+    the ones that have been off-screen for longest are thrown away.
+
+    A repaint only invalidates the tiles that it touches, and only the invalid parts
+    of the visible tiles are re-rendered.
+
+    To use it, just give your component one:
+    @code
+    timeline.setCachedComponentImage (new TiledCachedComponentImage (timeline));
+    @endcode
+
+    @see Component::setCachedComponentImage, Component::setBufferedToImage
+*/
+class JUCE_API  TiledCachedComponentImage  : public CachedComponentImage
+{
+public:
+    //==============================================================================
+    /** Creates a tiled image cache for a component.
+
+        The tile size is in physical pixels, and the memory budget is the total size
+        of the tile images that will be kept, in bytes. Tiles that are needed for the
+        area being painted are never thrown away, so a very large visible area may
+        go over the budget.
+    */
+    TiledCachedComponentImage (Component& owner,
+                               int tileSize = 256,
+                               size_t maxMemoryBytes = 32 * 1024 * 1024);
+
+    /** Destructor. */
+    ~TiledCachedComponentImage();
+
+    //==============================================================================
+    /** Changes the size of the tiles, in physical pixels.
+        This will throw away all the existing tiles.
+    */
+    void setTileSize (int newTileSize);
+
+    /** Returns the size of the tiles, in physical pixels. */
+    int getTileSize() const noexcept                        { return tileSize; }
+
+    /** Changes the maximum number of bytes that the tile images should use. */
+    void setMemoryBudget (size_t maxMemoryBytes);
+
+    /** Returns the maximum number of bytes that the tile images should use. */
+    size_t getMemoryBudget() const noexcept                 { return memoryBudget; }
+
+    /** Returns the number of bytes currently used by the tile images. */
+    size_t getMemoryUsed() const noexcept;
+
+    /** Returns the number of tiles that currently exist. */
+    int getNumTiles() const noexcept                        { return tiles.size(); }
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+    /** @internal */
+    bool invalidateAll() override;
+    /** @internal */
+    bool invalidate (const Rectangle<int>&) override;
+    /** @internal */
+    void releaseResources() override;
+
+private:
+    //==============================================================================
+    struct Tile;
+
+    Component& owner;
+    OwnedArray<Tile> tiles;
+    int tileSize;
+    size_t memoryBudget;
+    float scale = 1.0f;
+    uint32 paintCount = 0;
+
+    Tile& getTile (int column, int row);
+    Rectangle<int> getTileArea (const Tile&) const;
+    void renderTile (Tile&);
+    void evictTiles();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TiledCachedComponentImage)
+};
+
+} // namespace juce
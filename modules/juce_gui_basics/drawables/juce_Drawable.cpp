@@ -27,6 +27,131 @@
 namespace juce
 {
 
+//==============================================================================
+class Drawable::RasterCache  : public CachedComponentImage
+{
+public:
+    RasterCache (Drawable& d) noexcept  : owner (d) {}
+
+    void paint (Graphics& g) override
+    {
+        draw (g, owner.getAlpha());
+    }
+
+    void draw (Graphics& g, float opacity)
+    {
+        auto compBounds = owner.getLocalBounds();
+
+        if (compBounds.isEmpty() || opacity <= 0.0f)
+            return;
+
+        if (g.isVectorDevice())
+        {
+            paintDirectly (g, opacity);
+            return;
+        }
+
+        auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        auto imageBounds = (compBounds.toFloat() * scale).getSmallestIntegerContainer();
+
+        if (imageBounds.getWidth() > maxImageSize || imageBounds.getHeight() > maxImageSize)
+        {
+            // too big to be worth caching, so just draw it directly
+            paintDirectly (g, opacity);
+            return;
+        }
+
+        auto& level = getLevel (roundToInt (scale * 100.0f));
+
+        if (level.image.isNull() || level.image.getBounds() != imageBounds.withZeroOrigin())
+        {
+            level.image = Image (Image::ARGB, jmax (1, imageBounds.getWidth()), jmax (1, imageBounds.getHeight()), false);
+            level.isValid = false;
+        }
+
+        if (! level.isValid)
+        {
+            level.image.clear (level.image.getBounds());
+
+            Graphics imG (level.image);
+            imG.addTransform (AffineTransform::scale ((float) level.image.getWidth()  / (float) compBounds.getWidth(),
+                                                      (float) level.image.getHeight() / (float) compBounds.getHeight()));
+            owner.paintEntireComponent (imG, true);
+            level.isValid = true;
+        }
+
+        level.lastUsed = ++useCounter;
+
+        g.setColour (Colours::black.withAlpha (opacity));
+        g.drawImageTransformed (level.image, AffineTransform::scale ((float) compBounds.getWidth()  / (float) level.image.getWidth(),
+                                                                     (float) compBounds.getHeight() / (float) level.image.getHeight()), false);
+    }
+
+    bool invalidateAll() override
+    {
+        for (auto& level : levels)
+            level.isValid = false;
+
+        return true;
+    }
+
+    bool invalidate (const Rectangle<int>&) override    { return invalidateAll(); }
+    void releaseResources() override                     { levels.clear(); }
+
+private:
+    struct Level
+    {
+        int scaleKey;
+        Image image;
+        uint32 lastUsed;
+        bool isValid;
+    };
+
+    Drawable& owner;
+    Array<Level> levels;
+    uint32 useCounter = 0;
+
+    enum { maxNumLevels = 4, maxImageSize = 4096 };
+
+    Level& getLevel (int scaleKey)
+    {
+        for (auto& level : levels)
+            if (level.scaleKey == scaleKey)
+                return level;
+
+        if (levels.size() >= maxNumLevels)
+        {
+            int oldest = 0;
+
+            for (int i = 1; i < levels.size(); ++i)
+                if (levels.getReference (i).lastUsed < levels.getReference (oldest).lastUsed)
+                    oldest = i;
+
+            levels.remove (oldest);
+        }
+
+        levels.add ({ scaleKey, {}, 0, false });
+        return levels.getReference (levels.size() - 1);
+    }
+
+    void paintDirectly (Graphics& g, float opacity)
+    {
+        if (opacity < 1.0f)
+        {
+            g.beginTransparencyLayer (opacity);
+            owner.paintEntireComponent (g, true);
+            g.endTransparencyLayer();
+        }
+        else
+        {
+            owner.paintEntireComponent (g, true);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RasterCache)
+};
+
+//==============================================================================
 Drawable::Drawable()
 {
     setInterceptsMouseClicks (false, false);
@@ -41,6 +166,9 @@ Drawable::Drawable (const Drawable& other)
 
     setComponentID (other.getComponentID());
     setTransform (other.getTransform());
+
+    if (other.isRasterCacheEnabled())
+        setRasterCacheEnabled (true);
 }
 
 Drawable::~Drawable()
@@ -77,7 +205,11 @@ void Drawable::nonConstDraw (Graphics& g, float opacity, const AffineTransform&
 
     if (! g.isClipEmpty())
     {
-        if (opacity < 1.0f)
+        if (auto* cache = dynamic_cast<RasterCache*> (getCachedComponentImage()))
+        {
+            cache->draw (g, opacity);
+        }
+        else if (opacity < 1.0f)
         {
             g.beginTransparencyLayer (opacity);
             paintEntireComponent (g, true);
@@ -116,6 +248,17 @@ void Drawable::setClipPath (Drawable* clipPath)
     }
 }
 
+void Drawable::setRasterCacheEnabled (bool shouldCache)
+{
+    if (shouldCache != isRasterCacheEnabled())
+        setCachedComponentImage (shouldCache ? new RasterCache (*this) : nullptr);
+}
+
+bool Drawable::isRasterCacheEnabled() const noexcept
+{
+    return dynamic_cast<RasterCache*> (getCachedComponentImage()) != nullptr;
+}
+
 void Drawable::transformContextToCorrectOrigin (Graphics& g)
 {
     g.setOrigin (originRelativeToComponent);
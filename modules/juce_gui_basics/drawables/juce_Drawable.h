@@ -125,6 +125,27 @@ public:
     */
     void setClipPath (Drawable* drawableClipPath);
 
+    //==============================================================================
+    /** Enables a cache that keeps rasterised copies of this drawable and its children.
+
+        This is similar to Component::setBufferedToImage(), but it keeps a separate image
+        for each physical pixel scale that the drawable gets painted at (up to a small
+        limit), so moving a window between displays, or drawing the same drawable at a
+        couple of different sizes, doesn't keep re-rendering it. The images are only
+        thrown away when the drawable or one of its children changes.
+
+        This is handy for complex drawables such as those loaded from SVG files, which
+        would otherwise re-fill and re-stroke all of their paths on every repaint. It also
+        applies when the drawable is rendered with draw() or drawWithin().
+
+        Note that because the cache replaces any CachedComponentImage you've set on the
+        component, you can't use it at the same time as setBufferedToImage().
+    */
+    void setRasterCacheEnabled (bool shouldCacheRasterisedImages);
+
+    /** Returns true if setRasterCacheEnabled() has been used to enable the raster cache. */
+    bool isRasterCacheEnabled() const noexcept;
+
     //==============================================================================
     /** Tries to turn some kind of image file into a drawable.
 
@@ -276,6 +297,8 @@ protected:
   #endif
 
 private:
+    class RasterCache;
+
     void nonConstDraw (Graphics&, float opacity, const AffineTransform&);
 
     Drawable& operator= (const Drawable&);
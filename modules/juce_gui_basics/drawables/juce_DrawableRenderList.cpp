@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct DrawableRenderList::Operation
+{
+    enum Type
+    {
+        changesState,
+        savesState,
+        draws
+    };
+
+    Operation (Type t) noexcept  : type (t) {}
+    virtual ~Operation() {}
+
+    virtual void perform (LowLevelGraphicsContext&) const = 0;
+
+    const Type type;
+
+    JUCE_DECLARE_NON_COPYABLE (Operation)
+};
+
+//==============================================================================
+/*  A context that doesn't draw anything, but just keeps a list of the calls that
+    are made to it, so that they can be replayed later.
+*/
+struct DrawableRenderList::Recorder  : public LowLevelGraphicsContext
+{
+    Recorder (OwnedArray<Operation>& ops)  : operations (ops)
+    {
+        fonts.add (Font());
+    }
+
+    bool isVectorDevice() const override                                { return true; }
+    float getPhysicalPixelScaleFactor() override                        { return 1.0f; }
+
+    void setOrigin (Point<int> o) override                              { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.setOrigin (o); }); }
+    void addTransform (const AffineTransform& t) override               { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.addTransform (t); }); }
+
+    bool clipToRectangle (const Rectangle<int>& r) override             { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.clipToRectangle (r); });     return true; }
+    bool clipToRectangleList (const RectangleList<int>& r) override     { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.clipToRectangleList (r); }); return true; }
+    void excludeClipRectangle (const Rectangle<int>& r) override        { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.excludeClipRectangle (r); }); }
+    void clipToPath (const Path& p, const AffineTransform& t) override  { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.clipToPath (p, t); }); }
+
+    void clipToImageAlpha (const Image& i, const AffineTransform& t) override
+    {
+        record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.clipToImageAlpha (i, t); });
+    }
+
+    // While recording, nothing can be culled, because we can't know where the
+    // recording is going to be drawn.
+    bool clipRegionIntersects (const Rectangle<int>&) override          { return true; }
+    Rectangle<int> getClipBounds() const override                       { return { -0x1000000, -0x1000000, 0x2000000, 0x2000000 }; }
+    bool isClipEmpty() const override                                   { return false; }
+
+    void saveState() override
+    {
+        fonts.add (getFont());
+        record (Operation::savesState, [] (LowLevelGraphicsContext& c) { c.saveState(); });
+    }
+
+    void restoreState() override
+    {
+        jassert (fonts.size() > 1);
+        fonts.removeLast();
+
+        // Any state changes made since the last thing was drawn are about to be
+        // discarded, so there's no need to keep them, and if nothing at all was drawn
+        // since the state was saved, the save can go too.
+        while (operations.size() > 0 && operations.getLast()->type == Operation::changesState)
+            operations.removeLast();
+
+        if (operations.size() > 0 && operations.getLast()->type == Operation::savesState)
+            operations.removeLast();
+        else
+            record (Operation::draws, [] (LowLevelGraphicsContext& c) { c.restoreState(); });
+    }
+
+    void beginTransparencyLayer (float opacity) override                { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.beginTransparencyLayer (opacity); }); }
+    void endTransparencyLayer() override                                { record (Operation::draws, [] (LowLevelGraphicsContext& c) { c.endTransparencyLayer(); }); }
+
+    void setFill (const FillType& f) override                           { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.setFill (f); }); }
+    void setOpacity (float opacity) override                            { record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.setOpacity (opacity); }); }
+
+    void setInterpolationQuality (Graphics::ResamplingQuality q) override
+    {
+        record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.setInterpolationQuality (q); });
+    }
+
+    void fillRect (const Rectangle<int>& r, bool replace) override      { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.fillRect (r, replace); }); }
+    void fillRect (const Rectangle<float>& r) override                  { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.fillRect (r); }); }
+    void fillRectList (const RectangleList<float>& r) override          { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.fillRectList (r); }); }
+    void fillPath (const Path& p, const AffineTransform& t) override    { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.fillPath (p, t); }); }
+    void fillPreparedPath (const PreparedPath& p, const AffineTransform& t) override  { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.fillPreparedPath (p, t); }); }
+    void drawImage (const Image& i, const AffineTransform& t) override  { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.drawImage (i, t); }); }
+    void drawLine (const Line<float>& l) override                       { record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.drawLine (l); }); }
+
+    void setFont (const Font& f) override
+    {
+        fonts.getReference (fonts.size() - 1) = f;
+        record (Operation::changesState, [=] (LowLevelGraphicsContext& c) { c.setFont (f); });
+    }
+
+    const Font& getFont() override                                      { return fonts.getReference (fonts.size() - 1); }
+
+    void drawGlyph (int glyphNumber, const AffineTransform& t) override
+    {
+        record (Operation::draws, [=] (LowLevelGraphicsContext& c) { c.drawGlyph (glyphNumber, t); });
+    }
+
+private:
+    template <typename FunctionType>
+    struct FunctionOperation  : public Operation
+    {
+        FunctionOperation (Type t, FunctionType&& f)  : Operation (t), function (static_cast<FunctionType&&> (f)) {}
+
+        void perform (LowLevelGraphicsContext& c) const override    { function (c); }
+
+        const FunctionType function;
+    };
+
+    template <typename FunctionType>
+    void record (Operation::Type type, FunctionType&& f)
+    {
+        operations.add (new FunctionOperation<FunctionType> (type, static_cast<FunctionType&&> (f)));
+    }
+
+    OwnedArray<Operation>& operations;
+    Array<Font> fonts;
+
+    JUCE_DECLARE_NON_COPYABLE (Recorder)
+};
+
+//==============================================================================
+DrawableRenderList::DrawableRenderList() {}
+DrawableRenderList::~DrawableRenderList() {}
+
+DrawableRenderList::Ptr DrawableRenderList::createFrom (const Drawable& drawable)
+{
+    Ptr list (new DrawableRenderList());
+    list->drawableBounds = drawable.getDrawableBounds();
+
+    {
+        Recorder recorder (list->operations);
+        Graphics g (recorder);
+        drawable.draw (g, 1.0f);
+    }
+
+    list->operations.minimiseStorageOverheads();
+    return list;
+}
+
+DrawableRenderList::Ptr DrawableRenderList::createFromSVG (const XmlElement& svgDocument)
+{
+    ScopedPointer<Drawable> drawable (Drawable::createFromSVG (svgDocument));
+
+    if (drawable != nullptr)
+        return createFrom (*drawable);
+
+    return {};
+}
+
+//==============================================================================
+void DrawableRenderList::draw (Graphics& g, float opacity, const AffineTransform& transform) const
+{
+    Graphics::ScopedSaveState ss (g);
+    g.addTransform (transform);
+
+    if (g.isClipEmpty() || opacity <= 0.0f)
+        return;
+
+    auto& context = g.getInternalContext();
+
+    if (opacity < 1.0f)
+        g.beginTransparencyLayer (opacity);
+
+    for (auto* op : operations)
+        op->perform (context);
+
+    if (opacity < 1.0f)
+        g.endTransparencyLayer();
+}
+
+void DrawableRenderList::drawWithin (Graphics& g, Rectangle<float> destArea,
+                                     RectanglePlacement placement, float opacity) const
+{
+    draw (g, opacity, placement.getTransformToFit (drawableBounds, destArea));
+}
+
+} // namespace juce
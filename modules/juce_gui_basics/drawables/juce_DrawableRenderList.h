@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable, shareable recording of the drawing operations that a Drawable
+    performs.
+
+    A Drawable is a tree of components, so each copy of it carries the overhead of
+    the component hierarchy, and can only be used on the message thread. If you
+    just need to draw the same vector artwork in lots of places - e.g. icons loaded
+    from SVG files - you can turn it into a DrawableRenderList once, and then share
+    that single object between all the places that need to draw it.
+
+    Because it can't be modified after it has been created, a DrawableRenderList can
+    safely be drawn by several threads at the same time.
+
+    @see Drawable
+*/
+class JUCE_API  DrawableRenderList  : public ReferenceCountedObject
+{
+public:
+    /** A reference-counted pointer to a DrawableRenderList. */
+    typedef ReferenceCountedObjectPtr<DrawableRenderList> Ptr;
+
+    /** Destructor. */
+    ~DrawableRenderList();
+
+    //==============================================================================
+    /** Records everything that the given drawable draws. */
+    static Ptr createFrom (const Drawable& drawable);
+
+    /** Parses an SVG document and records it, without keeping the Drawable tree
+        that gets built along the way.
+
+        If the document can't be parsed, this returns nullptr.
+        @see Drawable::createFromSVG
+    */
+    static Ptr createFromSVG (const XmlElement& svgDocument);
+
+    //==============================================================================
+    /** Renders the recording, in the same way as Drawable::draw(). */
+    void draw (Graphics& g, float opacity, const AffineTransform& transform = AffineTransform()) const;
+
+    /** Renders the recording within a rectangle, in the same way as Drawable::drawWithin(). */
+    void drawWithin (Graphics& g, Rectangle<float> destArea,
+                     RectanglePlacement placement, float opacity) const;
+
+    /** Returns the bounds of the drawable that this was recorded from.
+        @see Drawable::getDrawableBounds
+    */
+    Rectangle<float> getDrawableBounds() const noexcept     { return drawableBounds; }
+
+    /** Returns the number of drawing operations that were recorded. */
+    int getNumOperations() const noexcept                   { return operations.size(); }
+
+private:
+    //==============================================================================
+    struct Operation;
+    struct Recorder;
+
+    OwnedArray<Operation> operations;
+    Rectangle<float> drawableBounds;
+
+    DrawableRenderList();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DrawableRenderList)
+};
+
+} // namespace juce
@@ -490,7 +490,14 @@ bool DrawableShape::replaceColour (Colour original, Colour replacement)
 {
     bool changed1 = replaceColourInFill (mainFill,   original, replacement);
     bool changed2 = replaceColourInFill (strokeFill, original, replacement);
-    return changed1 || changed2;
+
+    if (changed1 || changed2)
+    {
+        repaint();
+        return true;
+    }
+
+    return false;
 }
 
 Path DrawableShape::getOutlineAsPath() const
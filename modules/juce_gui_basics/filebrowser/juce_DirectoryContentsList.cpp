@@ -32,6 +32,7 @@ DirectoryContentsList::DirectoryContentsList (const FileFilter* f, TimeSliceThre
      fileTypeFlags (File::ignoreHiddenFiles | File::findFiles),
      shouldStop (true)
 {
+    setTimeSlicePriority (TimeSliceClient::backgroundPriority);
 }
 
 DirectoryContentsList::~DirectoryContentsList()
@@ -88,6 +89,7 @@ void DirectoryContentsList::stopSearching()
     shouldStop = true;
     thread.removeTimeSliceClient (this);
     fileFindHandle = nullptr;
+    pendingFiles.clear();
 }
 
 void DirectoryContentsList::clear()
@@ -170,11 +172,13 @@ int DirectoryContentsList::useTimeSlice()
     const uint32 startTime = Time::getApproximateMillisecondCounter();
     bool hasChanged = false;
 
-    for (int i = 100; --i >= 0;)
+    // The files found during each slice are sorted and merged into the list in one go, so
+    // that big folders arrive in chunks rather than costing a sorted insert per file.
+    for (;;)
     {
         if (! checkNextFile (hasChanged))
         {
-            if (hasChanged)
+            if (hasChanged && addPendingFiles())
                 changed();
 
             return 500;
@@ -184,7 +188,7 @@ int DirectoryContentsList::useTimeSlice()
             break;
     }
 
-    if (hasChanged)
+    if (hasChanged && addPendingFiles())
         changed();
 
     return 0;
@@ -250,16 +254,65 @@ bool DirectoryContentsList::addFile (const File& file, const bool isDir,
         info->isDirectory = isDir;
         info->isReadOnly = isReadOnly;
 
-        for (int i = files.size(); --i >= 0;)
-            if (files.getUnchecked(i)->filename == info->filename)
-                return false;
-
-        FileInfoComparator comp;
-        files.addSorted (comp, info.release());
+        pendingFiles.add (info.release());
         return true;
     }
 
     return false;
 }
 
+bool DirectoryContentsList::addPendingFiles()
+{
+    if (pendingFiles.isEmpty())
+        return false;
+
+    FileInfoComparator comp;
+    pendingFiles.sort (comp, true);
+
+    const ScopedLock sl (fileListLock);
+
+    Array<FileInfo*> merged;
+    merged.ensureStorageAllocated (files.size() + pendingFiles.size());
+
+    int existingIndex = 0, numAdded = 0;
+
+    for (auto* info : pendingFiles)
+    {
+        while (existingIndex < files.size()
+                && comp.compareElements (files.getUnchecked (existingIndex), info) < 0)
+            merged.add (files.getUnchecked (existingIndex++));
+
+        // skip any files that are already in the list
+        bool isDuplicate = false;
+
+        for (int i = existingIndex; i < files.size() && comp.compareElements (files.getUnchecked (i), info) == 0; ++i)
+        {
+            if (files.getUnchecked (i)->filename == info->filename)
+            {
+                isDuplicate = true;
+                break;
+            }
+        }
+
+        if (isDuplicate)
+        {
+            delete info;
+        }
+        else
+        {
+            merged.add (info);
+            ++numAdded;
+        }
+    }
+
+    while (existingIndex < files.size())
+        merged.add (files.getUnchecked (existingIndex++));
+
+    pendingFiles.clearQuick (false);
+    files.clearQuick (false);
+    files.addArray (merged);
+
+    return numAdded > 0;
+}
+
 } // namespace juce
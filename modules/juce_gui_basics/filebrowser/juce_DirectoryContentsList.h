@@ -204,7 +204,7 @@ private:
     int fileTypeFlags;
 
     CriticalSection fileListLock;
-    OwnedArray<FileInfo> files;
+    OwnedArray<FileInfo> files, pendingFiles;
 
     ScopedPointer<DirectoryIterator> fileFindHandle;
     bool volatile shouldStop;
@@ -215,6 +215,7 @@ private:
     bool checkNextFile (bool& hasChanged);
     bool addFile (const File&, bool isDir, int64 fileSize, Time modTime,
                   Time creationTime, bool isReadOnly);
+    bool addPendingFiles();
     void setTypeFlags (int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryContentsList)
@@ -99,6 +99,7 @@ public:
     ItemComponent (FileListComponent& fc, TimeSliceThread& t)
         : owner (fc), thread (t)
     {
+        setTimeSlicePriority (TimeSliceClient::backgroundPriority);
     }
 
     ~ItemComponent()
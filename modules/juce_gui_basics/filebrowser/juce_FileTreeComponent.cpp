@@ -48,6 +48,8 @@ public:
           subContentsList (nullptr, false),
           thread (t)
     {
+        setTimeSlicePriority (TimeSliceClient::backgroundPriority);
+
         DirectoryContentsList::FileInfo fileInfo;
 
         if (parentContents != nullptr
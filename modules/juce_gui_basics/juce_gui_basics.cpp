@@ -149,6 +149,7 @@ namespace juce
 }
 
 #include "components/juce_Component.cpp"
+#include "components/juce_TiledCachedComponentImage.cpp"
 #include "components/juce_ComponentListener.cpp"
 #include "mouse/juce_MouseInputSource.cpp"
 #include "components/juce_Desktop.cpp"
@@ -180,6 +181,7 @@ namespace juce
 #include "drawables/juce_DrawableRectangle.cpp"
 #include "drawables/juce_DrawableShape.cpp"
 #include "drawables/juce_DrawableText.cpp"
+#include "drawables/juce_DrawableRenderList.cpp"
 #include "drawables/juce_SVGParser.cpp"
 #include "filebrowser/juce_DirectoryContentsDisplayComponent.cpp"
 #include "filebrowser/juce_DirectoryContentsList.cpp"
@@ -246,6 +248,7 @@ namespace juce
 #include "windows/juce_AlertWindow.cpp"
 #include "windows/juce_CallOutBox.cpp"
 #include "windows/juce_ComponentPeer.cpp"
+#include "windows/juce_RepaintProfiler.cpp"
 #include "windows/juce_DialogWindow.cpp"
 #include "windows/juce_DocumentWindow.cpp"
 #include "windows/juce_ResizableWindow.cpp"
@@ -263,6 +266,7 @@ namespace juce
 
 // these classes are C++11-only
 #if JUCE_COMPILER_SUPPORTS_INITIALIZER_LISTS
+ #include "layout/juce_LayoutResultCache.h"
  #include "layout/juce_FlexBox.cpp"
  #if JUCE_HAS_CONSTEXPR
   #include "layout/juce_GridItem.cpp"
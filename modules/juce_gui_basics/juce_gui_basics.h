@@ -174,6 +174,7 @@ namespace juce
 #include "components/juce_ComponentListener.h"
 #include "components/juce_CachedComponentImage.h"
 #include "components/juce_Component.h"
+#include "components/juce_TiledCachedComponentImage.h"
 #include "layout/juce_ComponentAnimator.h"
 #include "components/juce_Desktop.h"
 #include "layout/juce_ComponentBoundsConstrainer.h"
@@ -235,6 +236,7 @@ namespace juce
 #include "drawables/juce_DrawablePath.h"
 #include "drawables/juce_DrawableRectangle.h"
 #include "drawables/juce_DrawableText.h"
+#include "drawables/juce_DrawableRenderList.h"
 #include "widgets/juce_TextEditor.h"
 #include "widgets/juce_Label.h"
 #include "widgets/juce_ComboBox.h"
@@ -256,6 +258,7 @@ namespace juce
 #include "windows/juce_AlertWindow.h"
 #include "windows/juce_CallOutBox.h"
 #include "windows/juce_ComponentPeer.h"
+#include "windows/juce_RepaintProfiler.h"
 #include "windows/juce_ResizableWindow.h"
 #include "windows/juce_DocumentWindow.h"
 #include "windows/juce_DialogWindow.h"
@@ -768,43 +768,91 @@ FlexBox::FlexBox (Direction d, Wrap w, AlignContent ac, AlignItems ai, JustifyCo
 }
 
 void FlexBox::performLayout (Rectangle<float> targetArea)
+{
+    layoutItems (targetArea, true);
+}
+
+void FlexBox::performLayout (Rectangle<int> targetArea)
+{
+    performLayout (targetArea.toFloat());
+}
+
+void FlexBox::calculateLayout (Rectangle<float> targetArea)
+{
+    layoutItems (targetArea, false);
+}
+
+void FlexBox::layoutItems (Rectangle<float> targetArea, bool updateComponents)
 {
     if (! items.isEmpty())
     {
-        FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
-
-        layout.createStates();
-        layout.initialiseItems();
-        layout.resolveFlexibleLengths();
-        layout.resolveAutoMarginsOnMainAxis();
-        layout.calculateCrossSizesByLine();
-        layout.calculateCrossSizeOfAllItems();
-        layout.alignLinesPerAlignContent();
-        layout.resolveAutoMarginsOnCrossAxis();
-        layout.alignItemsInCrossAxisInLinesPerAlignItems();
-        layout.alignLinesPerAlignSelf();
-        layout.alignItemsByJustifyContent();
-        layout.layoutAllItems();
+        auto key = getLayoutKey (targetArea);
+        auto& cache = *LayoutResultCache::getInstance();
+
+        if (! cache.applyResult (key, items))
+        {
+            FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
+
+            layout.createStates();
+            layout.initialiseItems();
+            layout.resolveFlexibleLengths();
+            layout.resolveAutoMarginsOnMainAxis();
+            layout.calculateCrossSizesByLine();
+            layout.calculateCrossSizeOfAllItems();
+            layout.alignLinesPerAlignContent();
+            layout.resolveAutoMarginsOnCrossAxis();
+            layout.alignItemsInCrossAxisInLinesPerAlignItems();
+            layout.alignLinesPerAlignSelf();
+            layout.alignItemsByJustifyContent();
+            layout.layoutAllItems();
+
+            cache.storeResult (key, items);
+        }
 
         for (auto& item : items)
         {
             item.currentBounds += targetArea.getPosition();
 
-            if (auto* comp = item.associatedComponent)
-                comp->setBounds (Rectangle<int>::leftTopRightBottom ((int) item.currentBounds.getX(),
-                                                                     (int) item.currentBounds.getY(),
-                                                                     (int) item.currentBounds.getRight(),
-                                                                     (int) item.currentBounds.getBottom()));
+            if (updateComponents)
+                if (auto* comp = item.associatedComponent)
+                    comp->setBounds (Rectangle<int>::leftTopRightBottom ((int) item.currentBounds.getX(),
+                                                                         (int) item.currentBounds.getY(),
+                                                                         (int) item.currentBounds.getRight(),
+                                                                         (int) item.currentBounds.getBottom()));
 
             if (auto* box = item.associatedFlexBox)
-                box->performLayout (item.currentBounds);
+                box->layoutItems (item.currentBounds, updateComponents);
         }
     }
 }
 
-void FlexBox::performLayout (Rectangle<int> targetArea)
+// The position of the target area isn't included, because the items are laid out
+// relative to its origin. Nested boxes are left out too, as they do their own lookups.
+uint64 FlexBox::getLayoutKey (Rectangle<float> targetArea) const noexcept
 {
-    performLayout (targetArea.toFloat());
+    LayoutResultCache::KeyBuilder key (0x466c6578426f78); // "FlexBox"
+
+    key.add (targetArea.getWidth());
+    key.add (targetArea.getHeight());
+    key.add (flexDirection);
+    key.add (flexWrap);
+    key.add (alignContent);
+    key.add (alignItems);
+    key.add (justifyContent);
+
+    for (auto& item : items)
+    {
+        const float values[] = { item.flexGrow, item.flexShrink, item.flexBasis,
+                                 item.width,  item.minWidth,  item.maxWidth,
+                                 item.height, item.minHeight, item.maxHeight,
+                                 item.margin.left, item.margin.right, item.margin.top, item.margin.bottom };
+
+        key.add (item.order);
+        key.add (item.alignSelf);
+        key.addData (values, sizeof (values));
+    }
+
+    return key.getKey();
 }
 
 //==============================================================================
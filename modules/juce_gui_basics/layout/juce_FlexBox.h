@@ -65,12 +65,30 @@ public:
     ~FlexBox() noexcept;
 
     //==============================================================================
-    /** Lays-out the box's items within the given rectangle. */
+    /** Lays-out the box's items within the given rectangle.
+
+        This sets the currentBounds of each item, lays out any nested FlexBoxes, and
+        moves the items' components into place.
+
+        Recent results are cached, so if the box's size and items are the same as a
+        layout that was done recently, the calculation is skipped. Components whose
+        bounds haven't changed aren't affected.
+    */
     void performLayout (Rectangle<float> targetArea);
 
     /** Lays-out the box's items within the given rectangle. */
     void performLayout (Rectangle<int> targetArea);
 
+    /** Works out where the box's items would go within the given rectangle, but
+        doesn't move any components.
+
+        This sets the currentBounds of each item, including those in any nested
+        FlexBoxes. It's useful if you need to know the layout of items which don't
+        have components yet, e.g. in a list that only creates components for the
+        rows that are visible.
+    */
+    void calculateLayout (Rectangle<float> targetArea);
+
     //==============================================================================
     /** Specifies how flex items are placed in the flex container, and defines the
         direction of the main axis.
@@ -102,6 +120,9 @@ public:
     Array<FlexItem> items;
 
 private:
+    void layoutItems (Rectangle<float>, bool updateComponents);
+    uint64 getLayoutKey (Rectangle<float>) const noexcept;
+
     JUCE_LEAK_DETECTOR (FlexBox)
 };
 
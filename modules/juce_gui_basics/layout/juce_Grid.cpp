@@ -985,6 +985,38 @@ Grid::~Grid() noexcept {}
 
 //==============================================================================
 void Grid::performLayout (juce::Rectangle<int> targetArea)
+{
+    layoutItems (targetArea, true);
+}
+
+void Grid::calculateLayout (juce::Rectangle<int> targetArea)
+{
+    layoutItems (targetArea, false);
+}
+
+void Grid::layoutItems (juce::Rectangle<int> targetArea, bool updateComponents)
+{
+    const auto key = getLayoutKey (targetArea);
+    auto& cache = *LayoutResultCache::getInstance();
+
+    if (! cache.applyResult (key, items))
+    {
+        calculateItemBounds (targetArea);
+        cache.storeResult (key, items);
+    }
+
+    for (auto& item : items)
+    {
+        item.currentBounds += targetArea.toFloat().getPosition();
+
+        if (updateComponents)
+            if (auto* c = item.associatedComponent)
+                c->setBounds (item.currentBounds.toNearestInt());
+    }
+}
+
+// Sets the items' currentBounds relative to the grid's origin
+void Grid::calculateItemBounds (juce::Rectangle<int> targetArea)
 {
     const auto itemsAndAreas = Grid::AutoPlacement().deduceAllItems (*this);
 
@@ -1018,12 +1050,73 @@ void Grid::performLayout (juce::Rectangle<int> targetArea)
                                                                        rowGap);
 
         auto* item = itemAndArea.first;
-        item->currentBounds = Grid::BoxAlignment::alignItem (*item, *this, areaBounds)
-                                + targetArea.toFloat().getPosition();
+        item->currentBounds = Grid::BoxAlignment::alignItem (*item, *this, areaBounds);
+    }
+}
+
+// The position of the target area isn't included, because the items are laid out
+// relative to its origin.
+juce::uint64 Grid::getLayoutKey (juce::Rectangle<int> targetArea) const noexcept
+{
+    LayoutResultCache::KeyBuilder key (0x47726964); // "Grid"
+
+    auto addTrack = [&key] (const TrackInfo& t)
+    {
+        key.add (t.size);
+        key.add (t.isFraction);
+        key.add (t.hasKeyword);
+        key.add (t.startLineName);
+        key.add (t.endLineName);
+    };
+
+    auto addProperty = [&key] (const GridItem::Property& p)
+    {
+        key.add (p.name);
+        key.add (p.number);
+        key.add (p.isSpan);
+        key.add (p.isAuto);
+    };
+
+    key.add (targetArea.getWidth());
+    key.add (targetArea.getHeight());
+    key.add (justifyItems);
+    key.add (alignItems);
+    key.add (justifyContent);
+    key.add (alignContent);
+    key.add (autoFlow);
+    key.add (columnGap.pixels);
+    key.add (rowGap.pixels);
+
+    key.add (templateColumns.size());
+    for (auto& t : templateColumns)  addTrack (t);
+
+    key.add (templateRows.size());
+    for (auto& t : templateRows)     addTrack (t);
 
-        if (auto* c = item->associatedComponent)
-            c->setBounds (item->currentBounds.toNearestInt());
+    key.add (templateAreas.size());
+    for (auto& a : templateAreas)    key.add (a);
+
+    addTrack (autoRows);
+    addTrack (autoColumns);
+
+    for (auto& item : items)
+    {
+        const float values[] = { item.width,  item.minWidth,  item.maxWidth,
+                                 item.height, item.minHeight, item.maxHeight,
+                                 item.margin.left, item.margin.right, item.margin.top, item.margin.bottom };
+
+        key.add (item.order);
+        key.add (item.justifySelf);
+        key.add (item.alignSelf);
+        addProperty (item.column.start);
+        addProperty (item.column.end);
+        addProperty (item.row.start);
+        addProperty (item.row.end);
+        key.add (item.area);
+        key.addData (values, sizeof (values));
     }
+
+    return key.getKey();
 }
 
 } // namespace juce
@@ -158,9 +158,19 @@ public:
     juce::Array<GridItem> items;
 
     //==============================================================================
-    /** */
+    /** Lays-out the grid's items within the given rectangle.
+
+        This sets the currentBounds of each item, and moves the items' components
+        into place. If the grid's size and items are the same as a layout that was
+        done recently, a cached result is used instead of calculating it again.
+    */
     void performLayout (juce::Rectangle<int>);
 
+    /** Works out where the grid's items would go within the given rectangle, and
+        sets their currentBounds, but doesn't move any components.
+    */
+    void calculateLayout (juce::Rectangle<int>);
+
     //==============================================================================
     /** */
     int getNumberOfColumns() const noexcept         { return templateColumns.size(); }
@@ -173,6 +183,10 @@ private:
     struct PlacementHelpers;
     struct AutoPlacement;
     struct BoxAlignment;
+
+    void layoutItems (juce::Rectangle<int>, bool updateComponents);
+    void calculateItemBounds (juce::Rectangle<int>);
+    juce::uint64 getLayoutKey (juce::Rectangle<int>) const noexcept;
 };
 
 constexpr Grid::Px operator"" _px (long double px)          { return Grid::Px { px }; }
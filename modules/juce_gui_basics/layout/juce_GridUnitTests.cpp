@@ -254,6 +254,40 @@ struct GridTests  : public juce::UnitTest
             expect (grid.items[4].currentBounds == Rect (250.f, 150.f, 100.f, 100.f));
         }
 
+        {
+            beginTest ("Cached layouts");
+
+            Grid grid;
+
+            grid.templateColumns = { Tr (50_px), Tr (1_fr) };
+            grid.templateRows    = { Tr (1_fr), Tr (2_fr) };
+
+            grid.items.addArray ({ GridItem().withArea (1, 1),
+                                   GridItem().withArea (2, 2) });
+
+            grid.performLayout ({ 150, 90 });
+
+            expect (grid.items[0].currentBounds == Rect (0.f,  0.f,  50.f,  30.f));
+            expect (grid.items[1].currentBounds == Rect (50.f, 30.f, 100.f, 60.f));
+
+            grid.items.getReference (0).currentBounds = {};
+            grid.performLayout ({ 10, 20, 150, 90 });
+
+            expect (grid.items[0].currentBounds == Rect (10.f, 20.f, 50.f,  30.f));
+            expect (grid.items[1].currentBounds == Rect (60.f, 50.f, 100.f, 60.f));
+
+            grid.calculateLayout ({ 150, 90 });
+
+            expect (grid.items[0].currentBounds == Rect (0.f,  0.f,  50.f,  30.f));
+            expect (grid.items[1].currentBounds == Rect (50.f, 30.f, 100.f, 60.f));
+
+            grid.templateColumns.set (0, Tr (70_px));
+            grid.items.getReference (1).margin = GridItem::Margin (5);
+            grid.calculateLayout ({ 150, 90 });
+
+            expect (grid.items[0].currentBounds == Rect (0.f,  0.f,  70.f, 30.f));
+            expect (grid.items[1].currentBounds == Rect (75.f, 35.f, 70.f, 50.f));
+        }
     }
 };
 
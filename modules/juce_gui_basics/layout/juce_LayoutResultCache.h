@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*
+    Remembers the item bounds that FlexBox and Grid have recently calculated, so
+    that laying out a container whose size and items haven't changed can skip the
+    layout algorithm.
+
+    Containers are usually rebuilt from scratch in resized(), so rather than
+    tracking changes to each object, a result is looked up by a hash of everything
+    that affects it. The bounds are stored relative to the container's origin,
+    because moving a container doesn't change its layout.
+*/
+class LayoutResultCache  : private DeletedAtShutdown
+{
+public:
+    LayoutResultCache() {}
+    ~LayoutResultCache()    { clearSingletonInstance(); }
+
+    juce_DeclareSingleton (LayoutResultCache, false)
+
+    //==============================================================================
+    /** Builds the key for a layout from all of the values that it depends on. */
+    struct KeyBuilder
+    {
+        KeyBuilder (uint64 seed) noexcept  : hasher (seed) {}
+
+        template <typename ValueType>
+        void add (ValueType value) noexcept
+        {
+            static_assert (std::is_arithmetic<ValueType>::value || std::is_enum<ValueType>::value,
+                           "Only plain values can be added to a key");
+            addData (&value, sizeof (value));
+        }
+
+        // long double has padding bytes on some platforms, which mustn't be hashed
+        void add (long double value) noexcept       { add ((double) value); }
+
+        void add (const String& text) noexcept
+        {
+            // the terminator stops adjacent strings being confused with each other
+            if (text.isEmpty())
+                add ((uint8) 0);
+            else
+                addData (text.toRawUTF8(), text.getNumBytesAsUTF8() + 1);
+        }
+
+        // A key is made from lots of small values, so they're collected in a local
+        // buffer rather than being passed to the hasher one at a time
+        void addData (const void* data, size_t numBytes) noexcept
+        {
+            if (numBuffered + numBytes > sizeof (buffer))
+            {
+                hasher.addData (buffer, numBuffered);
+                numBuffered = 0;
+
+                if (numBytes > sizeof (buffer))
+                {
+                    hasher.addData (data, numBytes);
+                    return;
+                }
+            }
+
+            memcpy (buffer + numBuffered, data, numBytes);
+            numBuffered += numBytes;
+        }
+
+        uint64 getKey() noexcept
+        {
+            hasher.addData (buffer, numBuffered);
+            numBuffered = 0;
+            return hasher.getResult();
+        }
+
+    private:
+
+        XXHash64 hasher;
+        uint8 buffer[512];
+        size_t numBuffered = 0;
+    };
+
+    //==============================================================================
+    /** Looks for a previously stored result with this key, and if there is one,
+        sets the currentBounds of the items to the bounds it contains.
+    */
+    template <typename ItemArray>
+    bool applyResult (uint64 key, ItemArray& items)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& r : results)
+        {
+            if (r.key == key && r.bounds.size() == items.size())
+            {
+                r.lastAccessCount = ++accessCounter;
+
+                for (int i = 0; i < items.size(); ++i)
+                    items.getReference (i).currentBounds = r.bounds.getReference (i);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Stores the currentBounds of the items, replacing the least recently used
+        result if the cache is full.
+    */
+    template <typename ItemArray>
+    void storeResult (uint64 key, const ItemArray& items)
+    {
+        const ScopedLock sl (lock);
+        Result* r = nullptr;
+
+        if (results.size() < maxNumResults)
+        {
+            results.add ({});
+            r = &results.getReference (results.size() - 1);
+        }
+        else
+        {
+            r = results.begin();
+
+            for (auto& other : results)
+                if (other.lastAccessCount < r->lastAccessCount)
+                    r = &other;
+        }
+
+        r->key = key;
+        r->lastAccessCount = ++accessCounter;
+        r->bounds.clearQuick();
+
+        for (auto& item : items)
+            r->bounds.add (item.currentBounds);
+    }
+
+private:
+    struct Result
+    {
+        uint64 key = 0;
+        Array<Rectangle<float>> bounds;
+        int lastAccessCount = 0;
+    };
+
+    enum { maxNumResults = 64 };
+
+    Array<Result> results;
+    int accessCounter = 0;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (LayoutResultCache)
+};
+
+juce_ImplementSingleton (LayoutResultCache)
+
+} // namespace juce
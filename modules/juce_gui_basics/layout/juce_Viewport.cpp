@@ -138,7 +138,7 @@ void Viewport::setViewPosition (const int xPixelsOffset, const int yPixelsOffset
 void Viewport::setViewPosition (Point<int> newPosition)
 {
     if (contentComp != nullptr)
-        contentComp->setTopLeftPosition (viewportPosToCompPos (newPosition));
+        moveContentComp (viewportPosToCompPos (newPosition));
 }
 
 void Viewport::setViewPositionProportionately (const double x, const double y)
@@ -182,9 +182,7 @@ bool Viewport::autoScroll (const int mouseX, const int mouseY, const int activeB
 
         if (dx != 0 || dy != 0)
         {
-            contentComp->setTopLeftPosition (contentComp->getX() + dx,
-                                             contentComp->getY() + dy);
-
+            moveContentComp (contentComp->getPosition() + Point<int> (dx, dy));
             return true;
         }
     }
@@ -312,6 +310,171 @@ bool Viewport::isCurrentlyScrollingOnDrag() const noexcept
     return dragToScrollListener != nullptr && dragToScrollListener->isDragging;
 }
 
+//==============================================================================
+/*  A cached image of the content holder, which is shifted by the scroll distance
+    when the content moves, so that only the newly-exposed area needs painting.
+
+    The valid area is kept in the image's coordinates, i.e. relative to where the
+    content was when the image was last brought up to date.
+*/
+struct Viewport::ScrollBlitImage  : public CachedComponentImage
+{
+    ScrollBlitImage (Viewport& v) noexcept : viewport (v) {}
+
+    void paint (Graphics& g) override
+    {
+        auto& holder = viewport.contentHolder;
+        auto newScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        auto compBounds = holder.getLocalBounds();
+        auto imageBounds = compBounds * newScale;
+
+        if (image.isNull() || image.getBounds() != imageBounds || newScale != scale)
+        {
+            image = Image (Image::ARGB, jmax (1, imageBounds.getWidth()), jmax (1, imageBounds.getHeight()), true);
+            scale = newScale;
+            validArea.clear();
+            imageContentPosition = getContentPosition();
+        }
+        else
+        {
+            scrollImageToMatchContent();
+        }
+
+        if (! validArea.containsRectangle (compBounds))
+        {
+            Graphics imG (image);
+            auto& lg = imG.getInternalContext();
+
+            lg.addTransform (AffineTransform::scale (scale));
+
+            for (auto& i : validArea)
+                lg.excludeClipRectangle (i);
+
+            lg.setFill (Colours::transparentBlack);
+            lg.fillRect (compBounds, true);
+            lg.setFill (Colours::black);
+
+            holder.paintEntireComponent (imG, true);
+        }
+
+        validArea = compBounds;
+
+        g.setColour (Colours::black.withAlpha (holder.getAlpha()));
+        g.drawImageTransformed (image, AffineTransform::scale (compBounds.getWidth()  / (float) imageBounds.getWidth(),
+                                                               compBounds.getHeight() / (float) imageBounds.getHeight()), false);
+    }
+
+    bool invalidateAll() override
+    {
+        validArea.clear();
+        return true;
+    }
+
+    bool invalidate (const Rectangle<int>& area) override
+    {
+        // When the viewport moves the content, the content repaints its old and new
+        // bounds, but we can deal with that by shifting the image when it's next painted
+        if (numMoveRepaintsToSkip > 0)
+        {
+            --numMoveRepaintsToSkip;
+
+            if (area == getContentBounds())
+                return true;
+        }
+
+        validArea.subtract (area + (imageContentPosition - getContentPosition()));
+        return true;
+    }
+
+    void releaseResources() override
+    {
+        image = Image();
+    }
+
+    int numMoveRepaintsToSkip = 0;
+
+private:
+    Viewport& viewport;
+    Image image;
+    RectangleList<int> validArea;
+    Point<int> imageContentPosition;
+    float scale = 1.0f;
+
+    Rectangle<int> getContentBounds() const
+    {
+        auto& holder = viewport.contentHolder;
+
+        if (auto* content = viewport.contentComp.get())
+            return holder.getLocalArea (content, content->getLocalBounds()).getIntersection (holder.getLocalBounds());
+
+        return {};
+    }
+
+    Point<int> getContentPosition() const
+    {
+        if (auto* content = viewport.contentComp.get())
+            return viewport.contentHolder.getLocalArea (content, content->getLocalBounds()).getPosition();
+
+        return {};
+    }
+
+    void scrollImageToMatchContent()
+    {
+        auto contentPosition = getContentPosition();
+        auto delta = contentPosition - imageContentPosition;
+        imageContentPosition = contentPosition;
+
+        if (delta.isOrigin())
+            return;
+
+        auto dx = roundToInt (delta.x * scale);
+        auto dy = roundToInt (delta.y * scale);
+
+        if (dx != delta.x * scale || dy != delta.y * scale
+             || std::abs (dx) >= image.getWidth() || std::abs (dy) >= image.getHeight())
+        {
+            validArea.clear();
+            return;
+        }
+
+        image.moveImageSection (jmax (0, dx), jmax (0, dy), jmax (0, -dx), jmax (0, -dy),
+                                image.getWidth() - std::abs (dx), image.getHeight() - std::abs (dy));
+
+        validArea.offsetAll (delta);
+        validArea.clipTo (viewport.contentHolder.getLocalBounds());
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScrollBlitImage)
+};
+
+void Viewport::setScrollBlittingEnabled (bool shouldUseScrollBlitting)
+{
+    if (isScrollBlittingEnabled() != shouldUseScrollBlitting)
+    {
+        scrollBlitImage = shouldUseScrollBlitting ? new ScrollBlitImage (*this) : nullptr;
+        contentHolder.setCachedComponentImage (scrollBlitImage);
+    }
+}
+
+bool Viewport::isScrollBlittingEnabled() const noexcept
+{
+    return scrollBlitImage != nullptr;
+}
+
+void Viewport::moveContentComp (Point<int> newTopLeft)
+{
+    jassert (contentComp != nullptr);
+
+    // (moving a component repaints its old bounds and then its new bounds in the parent)
+    if (scrollBlitImage != nullptr)
+        scrollBlitImage->numMoveRepaintsToSkip = 2;
+
+    contentComp->setTopLeftPosition (newTopLeft);
+
+    if (scrollBlitImage != nullptr)
+        scrollBlitImage->numMoveRepaintsToSkip = 0;
+}
+
 //==============================================================================
 void Viewport::lookAndFeelChanged()
 {
@@ -262,6 +262,26 @@ public:
     */
     bool isCurrentlyScrollingOnDrag() const noexcept;
 
+    /** Enables an optimisation that makes scrolling much cheaper when the content is
+        expensive to paint.
+
+        When this is turned on, the viewport keeps an image of its visible area. When the
+        content gets scrolled, the pixels that are still visible are moved across inside
+        the image, and only the strip that has just scrolled into view is painted again,
+        rather than the whole visible area.
+
+        It's off by default, because the image uses extra memory, and it doesn't help
+        if the content gets repainted on every frame anyway. It only shifts the existing
+        pixels when the scroll distance is a whole number of physical pixels - otherwise
+        the whole area is repainted as normal.
+    */
+    void setScrollBlittingEnabled (bool shouldUseScrollBlitting);
+
+    /** Returns true if scroll-blitting is turned on.
+        @see setScrollBlittingEnabled
+    */
+    bool isScrollBlittingEnabled() const noexcept;
+
     //==============================================================================
     /** @internal */
     void resized() override;
@@ -304,7 +324,12 @@ private:
     friend struct ContainerDeletePolicy<DragToScrollListener>;
     ScopedPointer<DragToScrollListener> dragToScrollListener;
 
+    struct ScrollBlitImage;
+    friend struct ScrollBlitImage;
+    ScrollBlitImage* scrollBlitImage = nullptr; // (owned by the contentHolder)
+
     Point<int> viewportPosToCompPos (Point<int>) const;
+    void moveContentComp (Point<int> newTopLeft);
 
     void updateVisibleArea();
     void deleteOrRemoveContentComp();
@@ -145,9 +145,25 @@ MouseCursor LookAndFeel::getMouseCursorFor (Component& component)
 LowLevelGraphicsContext* LookAndFeel::createGraphicsContext (const Image& imageToRenderOn, const Point<int>& origin,
                                                              const RectangleList<int>& initialClip)
 {
+    if (renderingThreadPool != nullptr)
+        return new LowLevelGraphicsTiledSoftwareRenderer (imageToRenderOn, origin, initialClip, renderingThreadPool);
+
     return new LowLevelGraphicsSoftwareRenderer (imageToRenderOn, origin, initialClip);
 }
 
+void LookAndFeel::setNumSoftwareRenderingThreads (int numThreads)
+{
+    jassert (numThreads >= 0);
+
+    if (numThreads != getNumSoftwareRenderingThreads())
+        renderingThreadPool = numThreads > 0 ? new ThreadPool (numThreads) : nullptr;
+}
+
+int LookAndFeel::getNumSoftwareRenderingThreads() const noexcept
+{
+    return renderingThreadPool != nullptr ? renderingThreadPool->getNumThreads() : 0;
+}
+
 //==============================================================================
 void LookAndFeel::setUsingNativeAlertWindows (bool shouldUseNativeAlerts)
 {
@@ -186,6 +186,18 @@ public:
                                                             const Point<int>& origin,
                                                             const RectangleList<int>& initialClip);
 
+    /** Makes createGraphicsContext() return a LowLevelGraphicsTiledSoftwareRenderer, which
+        splits each repaint into tiles and rasterises them on a pool of worker threads.
+
+        The output is the same as the normal software renderer's, so this is only worth
+        turning on when painting is slow enough to be a bottleneck, e.g. for large windows
+        full of meters or waveforms. Pass 0 to go back to the normal serial renderer.
+    */
+    void setNumSoftwareRenderingThreads (int numThreads);
+
+    /** Returns the number of worker threads set by setNumSoftwareRenderingThreads(). */
+    int getNumSoftwareRenderingThreads() const noexcept;
+
     void setUsingNativeAlertWindows (bool shouldUseNativeAlerts);
     bool isUsingNativeAlertWindows();
 
@@ -224,6 +236,7 @@ private:
     SortedSet<ColourSetting> colours;
     String defaultSans, defaultSerif, defaultFixed;
     bool useNativeAlertWindows = false;
+    ScopedPointer<ThreadPool> renderingThreadPool;
 
     JUCE_DECLARE_WEAK_REFERENCEABLE (LookAndFeel)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LookAndFeel)
@@ -43,9 +43,18 @@ class MouseSourceState;
 class MenuWindow;
 
 static bool canBeTriggered (const PopupMenu::Item& item) noexcept        { return item.isEnabled && item.itemID != 0 && ! item.isSectionHeader; }
-static bool hasActiveSubMenu (const PopupMenu::Item& item) noexcept      { return item.isEnabled && item.subMenu != nullptr && item.subMenu->items.size() > 0; }
+static bool hasActiveSubMenu (const PopupMenu::Item& item) noexcept
+{
+    return item.isEnabled && (item.subMenu != nullptr ? item.subMenu->items.size() > 0
+                                                      : item.subMenuCreator != nullptr);
+}
+
 static const Colour* getColour (const PopupMenu::Item& item) noexcept    { return item.colour != Colour (0x00000000) ? &item.colour : nullptr; }
-static bool hasSubMenu (const PopupMenu::Item& item) noexcept            { return item.subMenu != nullptr && (item.itemID == 0 || item.subMenu->getNumItems() > 0); }
+static bool hasSubMenu (const PopupMenu::Item& item) noexcept
+{
+    return item.subMenu != nullptr ? (item.itemID == 0 || item.subMenu->getNumItems() > 0)
+                                   : item.subMenuCreator != nullptr;
+}
 
 //==============================================================================
 struct HeaderItemComponent  : public PopupMenu::CustomComponent
@@ -62,7 +71,12 @@ struct HeaderItemComponent  : public PopupMenu::CustomComponent
 
     void getIdealSize (int& idealWidth, int& idealHeight) override
     {
-        getLookAndFeel().getIdealPopupMenuItemSize (getName(), false, -1, idealWidth, idealHeight);
+        getIdealSize (getLookAndFeel(), getName(), idealWidth, idealHeight);
+    }
+
+    static void getIdealSize (LookAndFeel& lf, const String& name, int& idealWidth, int& idealHeight)
+    {
+        lf.getIdealPopupMenuItemSize (name, false, -1, idealWidth, idealHeight);
         idealHeight += idealHeight / 2;
         idealWidth += idealWidth / 4;
     }
@@ -73,23 +87,12 @@ struct HeaderItemComponent  : public PopupMenu::CustomComponent
 //==============================================================================
 struct ItemComponent  : public Component
 {
-    ItemComponent (const PopupMenu::Item& i, int standardItemHeight, MenuWindow& parent)
-      : item (i), customComp (i.customComponent)
+    ItemComponent (PopupMenu::Item& i, MenuWindow& parent)
+      : item (i), customComp (i.isSectionHeader ? new HeaderItemComponent (i.text) : i.customComponent.get())
     {
-        if (item.isSectionHeader)
-            customComp = new HeaderItemComponent (item.text);
-
         addAndMakeVisible (customComp);
 
         parent.addAndMakeVisible (this);
-
-        updateShortcutKeyDescription();
-
-        int itemW = 80;
-        int itemH = 16;
-        getIdealSize (itemW, itemH, standardItemHeight);
-        setSize (itemW, jlimit (1, 600, itemH));
-
         addMouseListener (&parent, false);
     }
 
@@ -98,17 +101,6 @@ struct ItemComponent  : public Component
         removeChildComponent (customComp);
     }
 
-    void getIdealSize (int& idealWidth, int& idealHeight, const int standardItemHeight)
-    {
-        if (customComp != nullptr)
-            customComp->getIdealSize (idealWidth, idealHeight);
-        else
-            getLookAndFeel().getIdealPopupMenuItemSize (getTextForMeasurement(),
-                                                        item.isSeparator,
-                                                        standardItemHeight,
-                                                        idealWidth, idealHeight);
-    }
-
     void paint (Graphics& g) override
     {
         if (customComp == nullptr)
@@ -145,45 +137,15 @@ struct ItemComponent  : public Component
         }
     }
 
-    PopupMenu::Item item;
+    // This refers to the window's copy of the menu, so nothing needs to be copied when
+    // the component is created.
+    PopupMenu::Item& item;
 
 private:
     // NB: we use a copy of the one from the item info in case we're using our own section comp
     ReferenceCountedObjectPtr<CustomComponent> customComp;
     bool isHighlighted = false;
 
-    void updateShortcutKeyDescription()
-    {
-        if (item.commandManager != nullptr
-             && item.itemID != 0
-             && item.shortcutKeyDescription.isEmpty())
-        {
-            String shortcutKey;
-
-            for (auto& keypress : item.commandManager->getKeyMappings()
-                                    ->getKeyPressesAssignedToCommand (item.itemID))
-            {
-                auto key = keypress.getTextDescriptionWithIcons();
-
-                if (shortcutKey.isNotEmpty())
-                    shortcutKey << ", ";
-
-                if (key.length() == 1 && key[0] < 128)
-                    shortcutKey << "shortcut: '" << key << '\'';
-                else
-                    shortcutKey << key;
-            }
-
-            item.shortcutKeyDescription = shortcutKey.trim();
-        }
-    }
-
-    String getTextForMeasurement() const
-    {
-        return item.shortcutKeyDescription.isNotEmpty() ? item.text + "   " + item.shortcutKeyDescription
-                                                        : item.text;
-    }
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ItemComponent)
 };
 
@@ -223,12 +185,19 @@ public:
         setOpaque (lf.findColour (PopupMenu::backgroundColourId).isOpaque()
                      || ! Desktop::canUseSemiTransparentWindows());
 
-        for (int i = 0; i < menu.items.size(); ++i)
+        // The top-level window takes a copy of the menu, because the caller may delete theirs
+        // while it's being shown. Sub-menu windows just use the items in their parent's copy.
+        if (parentWindow == nullptr)
+            ownedMenu = new PopupMenu (menu);
+
+        auto& menuToShow = ownedMenu != nullptr ? *ownedMenu : menu;
+
+        for (int i = 0; i < menuToShow.items.size(); ++i)
         {
-            auto item = menu.items.getUnchecked (i);
+            auto* item = menuToShow.items.getUnchecked (i);
 
-            if (i < menu.items.size() - 1 || ! item->isSeparator)
-                items.add (new ItemComponent (*item, options.getStandardItemHeight(), *this));
+            if (i < menuToShow.items.size() - 1 || ! item->isSeparator)
+                addItem (*item);
         }
 
         auto targetArea = options.getTargetScreenArea() / scaleFactor;
@@ -275,6 +244,77 @@ public:
         items.clear();
     }
 
+    //==============================================================================
+    void addItem (PopupMenu::Item& item)
+    {
+        updateShortcutKeyDescription (item);
+        menuItems.add (&item);
+
+        // A custom component has to be inside the window before it can measure itself, but
+        // the components for normal items are only created when they're scrolled into view
+        auto needsComponent = item.customComponent != nullptr && ! item.isSectionHeader;
+        items.add (needsComponent ? new ItemComponent (item, *this) : nullptr);
+
+        int itemW = 80;
+        int itemH = 16;
+
+        if (item.isSectionHeader)
+            HeaderItemComponent::getIdealSize (getLookAndFeel(), item.text, itemW, itemH);
+        else if (item.customComponent != nullptr)
+            item.customComponent->getIdealSize (itemW, itemH);
+        else
+            getLookAndFeel().getIdealPopupMenuItemSize (getTextForMeasurement (item), item.isSeparator,
+                                                        options.getStandardItemHeight(), itemW, itemH);
+
+        itemBounds.add ({ itemW, jlimit (1, 600, itemH) });
+    }
+
+    ItemComponent* getItemComponent (int index)
+    {
+        auto* c = items.getUnchecked (index);
+
+        if (c == nullptr)
+        {
+            c = new ItemComponent (*menuItems.getUnchecked (index), *this);
+            items.set (index, c);
+            c->setBounds (itemBounds.getReference (index));
+        }
+
+        return c;
+    }
+
+    static void updateShortcutKeyDescription (PopupMenu::Item& item)
+    {
+        if (item.commandManager != nullptr
+             && item.itemID != 0
+             && item.shortcutKeyDescription.isEmpty())
+        {
+            String shortcutKey;
+
+            for (auto& keypress : item.commandManager->getKeyMappings()
+                                    ->getKeyPressesAssignedToCommand (item.itemID))
+            {
+                auto key = keypress.getTextDescriptionWithIcons();
+
+                if (shortcutKey.isNotEmpty())
+                    shortcutKey << ", ";
+
+                if (key.length() == 1 && key[0] < 128)
+                    shortcutKey << "shortcut: '" << key << '\'';
+                else
+                    shortcutKey << key;
+            }
+
+            item.shortcutKeyDescription = shortcutKey.trim();
+        }
+    }
+
+    static String getTextForMeasurement (const PopupMenu::Item& item)
+    {
+        return item.shortcutKeyDescription.isNotEmpty() ? item.text + "   " + item.shortcutKeyDescription
+                                                        : item.text;
+    }
+
     //==============================================================================
     void paint (Graphics& g) override
     {
@@ -742,8 +782,8 @@ public:
 
             for (int i = numChildren; --i >= 0;)
             {
-                colW = jmax (colW, items.getUnchecked (childNum + i)->getWidth());
-                colH += items.getUnchecked (childNum + i)->getHeight();
+                colW = jmax (colW, itemBounds.getReference (childNum + i).getWidth());
+                colH += itemBounds.getReference (childNum + i).getHeight();
             }
 
             colW = jmin (maxMenuW / jmax (1, numColumns - 2), colW + getLookAndFeel().getPopupMenuBorderSize() * 2);
@@ -773,44 +813,43 @@ public:
     {
         jassert (itemID != 0);
 
-        for (int i = items.size(); --i >= 0;)
+        for (int i = menuItems.size(); --i >= 0;)
         {
-            if (auto* m = items.getUnchecked (i))
-            {
-                if (m->item.itemID == itemID
-                     && windowPos.getHeight() > PopupMenuSettings::scrollZone * 4)
-                {
-                    auto currentY = m->getY();
+            auto& bounds = itemBounds.getReference (i);
 
-                    if (wantedY > 0 || currentY < 0 || m->getBottom() > windowPos.getHeight())
-                    {
-                        if (wantedY < 0)
-                            wantedY = jlimit (PopupMenuSettings::scrollZone,
-                                              jmax (PopupMenuSettings::scrollZone,
-                                                    windowPos.getHeight() - (PopupMenuSettings::scrollZone + m->getHeight())),
-                                              currentY);
+            if (menuItems.getUnchecked (i)->itemID == itemID
+                 && windowPos.getHeight() > PopupMenuSettings::scrollZone * 4)
+            {
+                auto currentY = bounds.getY();
 
-                        auto parentArea = getParentArea (windowPos.getPosition());
+                if (wantedY > 0 || currentY < 0 || bounds.getBottom() > windowPos.getHeight())
+                {
+                    if (wantedY < 0)
+                        wantedY = jlimit (PopupMenuSettings::scrollZone,
+                                          jmax (PopupMenuSettings::scrollZone,
+                                                windowPos.getHeight() - (PopupMenuSettings::scrollZone + bounds.getHeight())),
+                                          currentY);
 
-                        int deltaY = wantedY - currentY;
+                    auto parentArea = getParentArea (windowPos.getPosition());
 
-                        windowPos.setSize (jmin (windowPos.getWidth(), parentArea.getWidth()),
-                                           jmin (windowPos.getHeight(), parentArea.getHeight()));
+                    int deltaY = wantedY - currentY;
 
-                        auto newY = jlimit (parentArea.getY(),
-                                            parentArea.getBottom() - windowPos.getHeight(),
-                                            windowPos.getY() + deltaY);
+                    windowPos.setSize (jmin (windowPos.getWidth(), parentArea.getWidth()),
+                                       jmin (windowPos.getHeight(), parentArea.getHeight()));
 
-                        deltaY -= newY - windowPos.getY();
+                    auto newY = jlimit (parentArea.getY(),
+                                        parentArea.getBottom() - windowPos.getHeight(),
+                                        windowPos.getY() + deltaY);
 
-                        childYOffset -= deltaY;
-                        windowPos.setPosition (windowPos.getX(), newY);
+                    deltaY -= newY - windowPos.getY();
 
-                        updateYPositions();
-                    }
+                    childYOffset -= deltaY;
+                    windowPos.setPosition (windowPos.getX(), newY);
 
-                    break;
+                    updateYPositions();
                 }
+
+                break;
             }
         }
     }
@@ -874,9 +913,15 @@ public:
 
             for (int i = 0; i < numChildren; ++i)
             {
-                auto* c = items.getUnchecked (childNum + i);
-                c->setBounds (x, y, colW, c->getHeight());
-                y += c->getHeight();
+                auto& bounds = itemBounds.getReference (childNum + i);
+                bounds.setBounds (x, y, colW, bounds.getHeight());
+                y += bounds.getHeight();
+
+                // only the items that are on-screen need to have components
+                if (auto* c = items.getUnchecked (childNum + i))
+                    c->setBounds (bounds);
+                else if (bounds.getBottom() > 0 && bounds.getY() < getHeight())
+                    getItemComponent (childNum + i);
             }
 
             x += colW;
@@ -909,6 +954,17 @@ public:
         if (childComp != nullptr
              && hasActiveSubMenu (childComp->item))
         {
+            auto& item = childComp->item;
+
+            // a lazily-created sub-menu gets built the first time it's opened
+            if (item.subMenu == nullptr)
+            {
+                item.subMenu = new PopupMenu (item.subMenuCreator());
+
+                if (item.subMenu->items.isEmpty())
+                    return false;
+            }
+
             activeSubMenu = new HelperClasses::MenuWindow (*(childComp->item.subMenu), this,
                                                            options.withTargetScreenArea (childComp->getScreenBounds())
                                                                   .withMinimumWidth (0)
@@ -939,19 +995,18 @@ public:
     {
         disableTimerUntilMouseMoves();
 
-        int start = jmax (0, items.indexOf (currentChild));
+        int start = currentChild != nullptr ? jmax (0, items.indexOf (currentChild)) : 0;
 
-        for (int i = items.size(); --i >= 0;)
+        for (int i = menuItems.size(); --i >= 0;)
         {
             start += delta;
+            auto index = (start + menuItems.size()) % menuItems.size();
+            auto& item = *menuItems.getUnchecked (index);
 
-            if (auto* mic = items.getUnchecked ((start + items.size()) % items.size()))
+            if (canBeTriggered (item) || hasActiveSubMenu (item))
             {
-                if (canBeTriggered (mic->item) || hasActiveSubMenu (mic->item))
-                {
-                    setCurrentlyHighlightedChild (mic);
-                    break;
-                }
+                setCurrentlyHighlightedChild (getItemComponent (index));
+                break;
             }
         }
     }
@@ -987,7 +1042,10 @@ public:
     //==============================================================================
     MenuWindow* parent;
     const Options options;
-    OwnedArray<ItemComponent> items;
+    ScopedPointer<PopupMenu> ownedMenu;
+    Array<PopupMenu::Item*> menuItems;
+    Array<Rectangle<int>> itemBounds;
+    OwnedArray<ItemComponent> items; // null until an item's component is needed
     ApplicationCommandManager** managerOfChosenCommand;
     WeakReference<Component> componentAttachedTo;
     Component* parentComponent = nullptr;
@@ -1214,8 +1272,8 @@ private:
             scrollAcceleration = jmin (4.0, scrollAcceleration * 1.04);
             int amount = 0;
 
-            for (int i = 0; i < window.items.size() && amount == 0; ++i)
-                amount = ((int) scrollAcceleration) * window.items.getUnchecked (i)->getHeight();
+            for (int i = 0; i < window.itemBounds.size() && amount == 0; ++i)
+                amount = ((int) scrollAcceleration) * window.itemBounds.getReference (i).getHeight();
 
             window.alterChildYPos (amount * direction);
             lastScrollTime = timeNow;
@@ -1327,6 +1385,7 @@ PopupMenu::Item::Item (const Item& other)
   : text (other.text),
     itemID (other.itemID),
     subMenu (createCopyIfNotNull (other.subMenu.get())),
+    subMenuCreator (other.subMenuCreator),
     image (other.image != nullptr ? other.image->createCopy() : nullptr),
     customComponent (other.customComponent),
     customCallback (other.customCallback),
@@ -1345,6 +1404,7 @@ PopupMenu::Item& PopupMenu::Item::operator= (const Item& other)
     text = other.text;
     itemID = other.itemID;
     subMenu = createCopyIfNotNull (other.subMenu.get());
+    subMenuCreator = other.subMenuCreator;
     image = (other.image != nullptr ? other.image->createCopy() : nullptr);
     customComponent = other.customComponent;
     customCallback = other.customCallback;
@@ -1358,17 +1418,65 @@ PopupMenu::Item& PopupMenu::Item::operator= (const Item& other)
     return *this;
 }
 
+PopupMenu::Item::Item (Item&& other) noexcept
+  : text (std::move (other.text)),
+    itemID (other.itemID),
+    subMenu (std::move (other.subMenu)),
+    subMenuCreator (std::move (other.subMenuCreator)),
+    image (std::move (other.image)),
+    customComponent (std::move (other.customComponent)),
+    customCallback (std::move (other.customCallback)),
+    commandManager (other.commandManager),
+    shortcutKeyDescription (std::move (other.shortcutKeyDescription)),
+    colour (other.colour),
+    isEnabled (other.isEnabled),
+    isTicked (other.isTicked),
+    isSeparator (other.isSeparator),
+    isSectionHeader (other.isSectionHeader)
+{
+}
+
+PopupMenu::Item& PopupMenu::Item::operator= (Item&& other) noexcept
+{
+    text = std::move (other.text);
+    itemID = other.itemID;
+    subMenu = std::move (other.subMenu);
+    subMenuCreator = std::move (other.subMenuCreator);
+    image = std::move (other.image);
+    customComponent = std::move (other.customComponent);
+    customCallback = std::move (other.customCallback);
+    commandManager = other.commandManager;
+    shortcutKeyDescription = std::move (other.shortcutKeyDescription);
+    colour = other.colour;
+    isEnabled = other.isEnabled;
+    isTicked = other.isTicked;
+    isSeparator = other.isSeparator;
+    isSectionHeader = other.isSectionHeader;
+    return *this;
+}
+
 void PopupMenu::addItem (const Item& newItem)
 {
     // An ID of 0 is used as a return value to indicate that the user
     // didn't pick anything, so you shouldn't use it as the ID for an item..
     jassert (newItem.itemID != 0
               || newItem.isSeparator || newItem.isSectionHeader
-              || newItem.subMenu != nullptr);
+              || newItem.subMenu != nullptr || newItem.subMenuCreator != nullptr);
 
     items.add (new Item (newItem));
 }
 
+void PopupMenu::addItem (Item&& newItem)
+{
+    // An ID of 0 is used as a return value to indicate that the user
+    // didn't pick anything, so you shouldn't use it as the ID for an item..
+    jassert (newItem.itemID != 0
+              || newItem.isSeparator || newItem.isSectionHeader
+              || newItem.subMenu != nullptr || newItem.subMenuCreator != nullptr);
+
+    items.add (new Item (std::move (newItem)));
+}
+
 void PopupMenu::addItem (int itemResultID, const String& itemText, bool isActive, bool isTicked)
 {
     Item i;
@@ -1376,7 +1484,7 @@ void PopupMenu::addItem (int itemResultID, const String& itemText, bool isActive
     i.itemID = itemResultID;
     i.isEnabled = isActive;
     i.isTicked = isTicked;
-    addItem (i);
+    addItem (std::move (i));
 }
 
 static Drawable* createDrawableFromImage (const Image& im)
@@ -1404,7 +1512,7 @@ void PopupMenu::addItem (int itemResultID, const String& itemText, bool isActive
     i.isEnabled = isActive;
     i.isTicked = isTicked;
     i.image = iconToUse;
-    addItem (i);
+    addItem (std::move (i));
 }
 
 void PopupMenu::addCommandItem (ApplicationCommandManager* commandManager,
@@ -1426,7 +1534,7 @@ void PopupMenu::addCommandItem (ApplicationCommandManager* commandManager,
         i.isEnabled = target != nullptr && (info.flags & ApplicationCommandInfo::isDisabled) == 0;
         i.isTicked = (info.flags & ApplicationCommandInfo::isTicked) != 0;
         i.image = iconToUse;
-        addItem (i);
+        addItem (std::move (i));
     }
 }
 
@@ -1440,7 +1548,7 @@ void PopupMenu::addColouredItem (int itemResultID, const String& itemText, Colou
     i.isEnabled = isActive;
     i.isTicked = isTicked;
     i.image = iconToUse;
-    addItem (i);
+    addItem (std::move (i));
 }
 
 void PopupMenu::addColouredItem (int itemResultID, const String& itemText, Colour itemTextColour,
@@ -1453,7 +1561,7 @@ void PopupMenu::addColouredItem (int itemResultID, const String& itemText, Colou
     i.isEnabled = isActive;
     i.isTicked = isTicked;
     i.image = createDrawableFromImage (iconToUse);
-    addItem (i);
+    addItem (std::move (i));
 }
 
 void PopupMenu::addCustomItem (int itemResultID, CustomComponent* cc, const PopupMenu* subMenu)
@@ -1462,7 +1570,7 @@ void PopupMenu::addCustomItem (int itemResultID, CustomComponent* cc, const Popu
     i.itemID = itemResultID;
     i.customComponent = cc;
     i.subMenu = createCopyIfNotNull (subMenu);
-    addItem (i);
+    addItem (std::move (i));
 }
 
 void PopupMenu::addCustomItem (int itemResultID, Component* customComponent, int idealWidth, int idealHeight,
@@ -1495,7 +1603,21 @@ void PopupMenu::addSubMenu (const String& subMenuName, const PopupMenu& subMenu,
     i.isEnabled = isActive && (itemResultID != 0 || subMenu.getNumItems() > 0);
     i.isTicked = isTicked;
     i.image = iconToUse;
-    addItem (i);
+    addItem (std::move (i));
+}
+
+void PopupMenu::addLazySubMenu (const String& subMenuName, std::function<PopupMenu()> createSubMenu,
+                                bool isActive, bool isTicked, int itemResultID)
+{
+    jassert (createSubMenu != nullptr);
+
+    Item i;
+    i.text = subMenuName;
+    i.itemID = itemResultID;
+    i.subMenuCreator = std::move (createSubMenu);
+    i.isEnabled = isActive;
+    i.isTicked = isTicked;
+    addItem (std::move (i));
 }
 
 void PopupMenu::addSeparator()
@@ -1504,7 +1626,7 @@ void PopupMenu::addSeparator()
     {
         Item i;
         i.isSeparator = true;
-        addItem (i);
+        addItem (std::move (i));
     }
 }
 
@@ -1513,7 +1635,7 @@ void PopupMenu::addSectionHeader (const String& title)
     Item i;
     i.text = title;
     i.isSectionHeader = true;
-    addItem (i);
+    addItem (std::move (i));
 }
 
 //==============================================================================
@@ -1765,7 +1887,7 @@ bool PopupMenu::containsAnyActiveItems() const noexcept
             if (mi->subMenu->containsAnyActiveItems())
                 return true;
         }
-        else if (mi->isEnabled)
+        else if (mi->isEnabled) // (this includes lazy sub-menus, which can't be checked without building them)
         {
             return true;
         }
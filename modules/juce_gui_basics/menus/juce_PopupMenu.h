@@ -122,6 +122,12 @@ public:
         /** Creates a copy of an item. */
         Item& operator= (const Item&);
 
+        /** Move constructor. */
+        Item (Item&&) noexcept;
+
+        /** Move assignment operator. */
+        Item& operator= (Item&&) noexcept;
+
         /** The menu item's name. */
         String text;
 
@@ -131,6 +137,12 @@ public:
         /** A sub-menu, or nullptr if there isn't one. */
         ScopedPointer<PopupMenu> subMenu;
 
+        /** If this is set and subMenu is nullptr, it will be called to create the sub-menu
+            the first time that the user opens it, rather than it being built up-front.
+            @see addLazySubMenu
+        */
+        std::function<PopupMenu()> subMenuCreator;
+
         /** A drawable to use as an icon, or nullptr if there isn't one. */
         ScopedPointer<Drawable> image;
 
@@ -175,6 +187,9 @@ public:
     */
     void addItem (const Item& newItem);
 
+    /** Adds an item to the menu, moving it rather than making a copy. */
+    void addItem (Item&& newItem);
+
     /** Appends a new text item for this menu to show.
 
         @param itemResultID     the number that will be returned from the show() method
@@ -346,6 +361,24 @@ public:
                      bool isTicked = false,
                      int itemResultID = 0);
 
+    /** Appends a sub-menu whose contents are only built when the user opens it.
+
+        For big, deeply nested menus (e.g. a list of thousands of plugins sorted into
+        folders), this avoids building and copying all the sub-menus when most of them
+        will never be looked at. The function is called on the message thread each time
+        the menu is shown and the sub-menu is opened, so it mustn't refer to anything that
+        could be deleted while the menu is on screen.
+
+        Because its contents aren't known until it's opened, a lazy sub-menu is ignored by
+        containsCommandItem() and by a recursive MenuItemIterator, and it will always appear
+        to have a sub-menu, even if the function returns an empty one.
+    */
+    void addLazySubMenu (const String& subMenuName,
+                         std::function<PopupMenu()> createSubMenu,
+                         bool isEnabled = true,
+                         bool isTicked = false,
+                         int itemResultID = 0);
+
     /** Appends a separator to the menu, to help break it up into sections.
         The menu class is smart enough not to display separators at the top or bottom
         of the menu, and it will replace mutliple adjacent separators with a single
@@ -2682,6 +2682,7 @@ private:
 
             RectangleList<int>  originalRepaintRegion (regionsNeedingRepaint);
             regionsNeedingRepaint.clear();
+            peer.optimiseRepaintRegion (originalRepaintRegion);
             const Rectangle<int> totalArea (originalRepaintRegion.getBounds());
 
             if (! totalArea.isEmpty())
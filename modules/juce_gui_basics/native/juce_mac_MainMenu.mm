@@ -244,7 +244,7 @@ public:
 
             [item setEnabled: false];
         }
-        else if (i.subMenu != nullptr)
+        else if (i.subMenu != nullptr || i.subMenuCreator != nullptr)
         {
             if (i.text == recentItemsMenuName)
             {
@@ -268,7 +268,9 @@ public:
             [item setTag: i.itemID];
             [item setEnabled: i.isEnabled];
 
-            NSMenu* sub = createMenu (*i.subMenu, i.text, topLevelMenuId, topLevelIndex, false);
+            // a native menu needs all its contents up-front, so any lazy sub-menus are built here
+            NSMenu* sub = createMenu (i.subMenu != nullptr ? *i.subMenu : i.subMenuCreator(),
+                                      i.text, topLevelMenuId, topLevelIndex, false);
             [menuToAddTo setSubmenu: sub forItem: item];
             [sub release];
         }
@@ -164,6 +164,41 @@ public:
         return section2;
     }
 
+    // These do the same as splitting the section, inserting or removing whole sections and
+    // then coalescing them again, but only have to touch the atoms around the edit.
+    void insertSection (int offset, const UniformTextSection& other, const juce_wchar passwordChar)
+    {
+        jassert (font == other.font && colour == other.colour);
+
+        auto start = splitAtomAt (offset, passwordChar);
+        atoms.insertArray (start, other.atoms.begin(), other.atoms.size());
+
+        auto end = start + other.atoms.size();
+        auto numAtoms = atoms.size();
+        joinAtoms (start, passwordChar);
+        joinAtoms (end - (numAtoms - atoms.size()), passwordChar);
+    }
+
+    void removeRange (Range<int> range, const juce_wchar passwordChar)
+    {
+        auto start = splitAtomAt (range.getStart(), passwordChar);
+        auto end = splitAtomAt (range.getEnd(), passwordChar);
+
+        atoms.removeRange (start, end - start);
+        joinAtoms (start, passwordChar);
+    }
+
+    // returns a copy of a range of the text, leaving this section split at the ends of the range
+    UniformTextSection* copyRange (Range<int> range, const juce_wchar passwordChar)
+    {
+        auto start = splitAtomAt (range.getStart(), passwordChar);
+        auto end = splitAtomAt (range.getEnd(), passwordChar);
+
+        auto* copy = new UniformTextSection (String(), font, colour, passwordChar);
+        copy->atoms.insertArray (0, atoms.begin() + start, end - start);
+        return copy;
+    }
+
     void appendAllText (MemoryOutputStream& mo) const
     {
         for (auto& atom : atoms)
@@ -220,6 +255,59 @@ public:
     Array<TextAtom> atoms;
 
 private:
+    // makes sure that an atom starts at the given character offset, and returns its index
+    int splitAtomAt (int offset, const juce_wchar passwordChar)
+    {
+        int index = 0;
+
+        for (int i = 0; i < atoms.size(); ++i)
+        {
+            if (offset == index)
+                return i;
+
+            auto& atom = atoms.getReference (i);
+            auto nextIndex = index + atom.numChars;
+
+            if (offset < nextIndex)
+            {
+                TextAtom secondAtom;
+                secondAtom.atomText = atom.atomText.substring (offset - index);
+                secondAtom.width = font.getStringWidthFloat (secondAtom.getText (passwordChar));
+                secondAtom.numChars = (uint16) secondAtom.atomText.length();
+
+                atom.atomText = atom.atomText.substring (0, offset - index);
+                atom.width = font.getStringWidthFloat (atom.getText (passwordChar));
+                atom.numChars = (uint16) (offset - index);
+
+                atoms.insert (i + 1, secondAtom);
+                return i + 1;
+            }
+
+            index = nextIndex;
+        }
+
+        return atoms.size();
+    }
+
+    // joins an atom onto the one before it if they're both part of the same word
+    void joinAtoms (int index, const juce_wchar passwordChar)
+    {
+        if (index > 0 && index < atoms.size())
+        {
+            auto& lastAtom = atoms.getReference (index - 1);
+            auto& nextAtom = atoms.getReference (index);
+
+            if (! (CharacterFunctions::isWhitespace (lastAtom.atomText.getLastCharacter())
+                    || CharacterFunctions::isWhitespace (nextAtom.atomText[0])))
+            {
+                lastAtom.atomText += nextAtom.atomText;
+                lastAtom.numChars = (uint16) (lastAtom.numChars + nextAtom.numChars);
+                lastAtom.width = font.getStringWidthFloat (lastAtom.getText (passwordChar));
+                atoms.remove (index);
+            }
+        }
+    }
+
     void initialiseAtoms (const String& textToParse, const juce_wchar passwordChar)
     {
         auto text = textToParse.getCharPointer();
@@ -278,6 +366,158 @@ private:
     JUCE_LEAK_DETECTOR (UniformTextSection)
 };
 
+//==============================================================================
+// remembers the layout at the end of each paragraph, so that the text can be laid out
+// from the nearest paragraph instead of from the start, and only the paragraphs that
+// are edited need to be laid out again
+struct TextEditor::LayoutCache
+{
+    // the state of an iterator that has just returned a new-line atom. The layout of
+    // the text that follows only depends on this, not on anything that came before it.
+    struct Paragraph
+    {
+        int sectionIndex, atomIndex, indexInText, endIndex;
+        float lineY, lineHeight, maxDescent, atomRight;
+        float maxRight; // the widest line in the paragraph that this ends
+
+        bool hasSameLayoutAs (const Paragraph& other) const noexcept
+        {
+            return indexInText == other.indexInText
+                    && lineHeight == other.lineHeight
+                    && maxDescent == other.maxDescent
+                    && atomRight == other.atomRight;
+        }
+    };
+
+    void clear()
+    {
+        paragraphs.clearQuick();
+        pending.clearQuick();
+        upToDate = false;
+    }
+
+    // Called before the text is changed. The paragraphs that come entirely after the edit
+    // will lay out in the same way afterwards, so they're moved to where their text will
+    // be, and kept as pending until the layout of the edited text reaches one of them.
+    void textChanged (int start, int numCharsRemoved, int numCharsInserted)
+    {
+        upToDate = false;
+
+        auto end = start + numCharsRemoved;
+        auto delta = numCharsInserted - numCharsRemoved;
+        auto numToKeep = paragraphs.size();
+
+        while (numToKeep > 0 && paragraphs.getReference (numToKeep - 1).endIndex > start)
+            --numToKeep;
+
+        if (numToKeep < paragraphs.size())
+        {
+            // any older pending paragraphs will have been moved by a different
+            // amount to these ones, so they can't be kept as well
+            pending.clearQuick();
+
+            for (int i = numToKeep; i < paragraphs.size(); ++i)
+                if (paragraphs.getReference (i).indexInText >= end)
+                    pending.add (paragraphs.getReference (i));
+
+            paragraphs.removeRange (numToKeep, paragraphs.size());
+        }
+        else
+        {
+            while (! pending.isEmpty() && pending.getReference (0).indexInText < end)
+                pending.remove (0);
+        }
+
+        for (auto& p : pending)
+        {
+            p.indexInText += delta;
+            p.endIndex += delta;
+        }
+    }
+
+    // When the layout of the edited text reaches a pending paragraph, everything after
+    // that is the same as before, apart from its position.
+    bool convergesWithPending (const Paragraph& p)
+    {
+        int numToSkip = 0;
+
+        while (numToSkip < pending.size() && pending.getReference (numToSkip).indexInText < p.indexInText)
+            ++numToSkip;
+
+        pending.removeRange (0, numToSkip);
+
+        if (pending.isEmpty() || ! pending.getReference (0).hasSameLayoutAs (p))
+            return false;
+
+        auto& old = pending.getReference (0);
+        auto sectionDelta = p.sectionIndex - old.sectionIndex;
+        auto atomDelta    = p.atomIndex - old.atomIndex;
+        auto yDelta       = p.lineY - old.lineY;
+
+        paragraphs.ensureStorageAllocated (paragraphs.size() + pending.size());
+        paragraphs.add (p);
+
+        for (int i = 1; i < pending.size(); ++i)
+        {
+            auto next = pending.getReference (i);
+
+            if (next.sectionIndex == old.sectionIndex)
+                next.atomIndex += atomDelta;
+
+            next.sectionIndex += sectionDelta;
+            next.lineY += yDelta;
+            paragraphs.add (next);
+        }
+
+        pending.clearQuick();
+        return true;
+    }
+
+    const Paragraph* getLastParagraph() const noexcept
+    {
+        return paragraphs.isEmpty() ? nullptr : &paragraphs.getReference (paragraphs.size() - 1);
+    }
+
+    // returns the last paragraph that ends at or before the given index
+    const Paragraph* findParagraphBefore (int index) const noexcept
+    {
+        return findLast ([=] (const Paragraph& p) { return p.endIndex <= index; });
+    }
+
+    // returns the last paragraph whose final line is entirely above the given y position
+    const Paragraph* findParagraphAbove (float y) const noexcept
+    {
+        return findLast ([=] (const Paragraph& p) { return p.lineY + p.lineHeight < y; });
+    }
+
+    Array<Paragraph> paragraphs, pending;
+    bool upToDate = false;
+
+    // the settings that the cached layout was made with
+    Justification justification { Justification::left };
+    float justificationWidth = 0, wordWrapWidth = 0, lineSpacing = 0;
+    juce_wchar passwordCharacter = 0;
+
+private:
+    template <typename Predicate>
+    const Paragraph* findLast (Predicate isBefore) const noexcept
+    {
+        int start = 0, end = paragraphs.size();
+
+        while (start < end)
+        {
+            auto mid = (start + end) / 2;
+
+            if (isBefore (paragraphs.getReference (mid)))
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        return start > 0 ? &paragraphs.getReference (start - 1) : nullptr;
+    }
+};
+
 //==============================================================================
 struct TextEditor::Iterator
 {
@@ -300,6 +540,34 @@ struct TextEditor::Iterator
         }
     }
 
+    // starts the iterator just after the end of a paragraph, or at the start of the text if this is null
+    Iterator (const TextEditor& ed, const LayoutCache::Paragraph* p)
+      : Iterator (ed)
+    {
+        if (p != nullptr)
+        {
+            if (auto* section = sections[p->sectionIndex])
+            {
+                if (isPositiveAndBelow (p->atomIndex - 1, section->atoms.size())
+                     && section->atoms.getReference (p->atomIndex - 1).isNewLine())
+                {
+                    sectionIndex = p->sectionIndex;
+                    atomIndex = p->atomIndex;
+                    currentSection = section;
+                    atom = &(section->atoms.getReference (atomIndex - 1));
+                    indexInText = p->indexInText;
+                    lineY = p->lineY;
+                    lineHeight = p->lineHeight;
+                    maxDescent = p->maxDescent;
+                    atomX = atomRight = p->atomRight;
+                    return;
+                }
+            }
+
+            jassertfalse; // the cached layout doesn't match the text
+        }
+    }
+
     Iterator (const Iterator&) = default;
     Iterator& operator= (const Iterator&) = delete;
 
@@ -655,6 +923,15 @@ struct TextEditor::Iterator
         return false;
     }
 
+    //==============================================================================
+    LayoutCache::Paragraph getParagraph (float maxRight) const noexcept
+    {
+        jassert (atom != nullptr && atom->isNewLine());
+
+        return { sectionIndex, atomIndex, indexInText, indexInText + atom->numChars,
+                 lineY, lineHeight, maxDescent, atomRight, maxRight };
+    }
+
     //==============================================================================
     int indexInText = 0;
     float lineY = 0, justificationOffset = 0, lineHeight = 0, maxDescent = 0;
@@ -876,6 +1153,7 @@ namespace TextEditorDefs
 //==============================================================================
 TextEditor::TextEditor (const String& name, juce_wchar passwordChar)
     : Component (name),
+      layoutCache (new LayoutCache()),
       passwordCharacter (passwordChar)
 {
     setMouseCursor (MouseCursor::IBeamCursor);
@@ -1032,6 +1310,7 @@ void TextEditor::applyFontToAllText (const Font& newFont, bool changeCurrentFont
         uts->colour = overallColour;
     }
 
+    layoutCache->clear();
     coalesceSimilarSections();
     updateTextHolderSize();
     scrollToMakeSureCursorIsVisible();
@@ -1043,6 +1322,11 @@ void TextEditor::applyColourToAllText (const Colour& newColour, bool changeCurre
     for (auto* uts : sections)
         uts->colour = newColour;
 
+    // the layout doesn't change, but sections that now look the same must be merged, or
+    // a later edit could merge them and move the cached paragraphs that come after it
+    layoutCache->clear();
+    coalesceSimilarSections();
+
     if (changeCurrentTextColour)
         setColour (TextEditor::textColourId, newColour);
     else
@@ -1257,8 +1541,10 @@ void TextEditor::repaintText (Range<int> range)
 
         if (wordWrapWidth > 0)
         {
+            updateLayoutCache();
+
             Point<float> anchor;
-            Iterator i (*this);
+            Iterator i (*this, layoutCache->findParagraphBefore (range.getStart()));
             i.getCharPosition (range.getStart(), anchor, lh);
 
             auto y1 = (int) anchor.y;
@@ -1377,8 +1663,14 @@ void TextEditor::updateTextHolderSize()
 {
     if (getWordWrapWidth() > 0)
     {
+        updateLayoutCache();
+
         float maxWidth = getJustificationWidth();
-        Iterator i (*this);
+
+        for (auto& p : layoutCache->paragraphs)
+            maxWidth = jmax (maxWidth, p.maxRight);
+
+        Iterator i (*this, layoutCache->getLastParagraph());
 
         while (i.next())
             maxWidth = jmax (maxWidth, i.atomRight);
@@ -1390,6 +1682,71 @@ void TextEditor::updateTextHolderSize()
     }
 }
 
+void TextEditor::updateLayoutCache() const
+{
+    auto& cache = *layoutCache;
+    auto newJustificationWidth = getJustificationWidth();
+    auto newWordWrapWidth = getWordWrapWidth();
+
+    if (cache.justification != justification
+         || cache.justificationWidth != newJustificationWidth
+         || cache.wordWrapWidth != newWordWrapWidth
+         || cache.lineSpacing != lineSpacing
+         || cache.passwordCharacter != passwordCharacter)
+    {
+        cache.clear();
+        cache.justification = justification;
+        cache.justificationWidth = newJustificationWidth;
+        cache.wordWrapWidth = newWordWrapWidth;
+        cache.lineSpacing = lineSpacing;
+        cache.passwordCharacter = passwordCharacter;
+    }
+
+    if (cache.upToDate || newWordWrapWidth <= 0)
+        return;
+
+    for (bool converged = true; converged;)
+    {
+        converged = false;
+        auto* last = cache.getLastParagraph();
+        Iterator i (*this, last);
+
+        if (last != nullptr && i.atom == nullptr)
+        {
+            // the cached layout doesn't match the text, so start again from the beginning
+            cache.clear();
+            converged = true;
+            continue;
+        }
+
+        float maxRight = 0;
+
+        while (i.next())
+        {
+            maxRight = jmax (maxRight, i.atomRight);
+
+            if (i.atom->isNewLine())
+            {
+                auto p = i.getParagraph (maxRight);
+                maxRight = 0;
+
+                if (cache.convergesWithPending (p))
+                {
+                    // the rest of the layout is known now, apart from any text after the
+                    // last pending paragraph, so carry on from there
+                    converged = true;
+                    break;
+                }
+
+                cache.paragraphs.add (p);
+            }
+        }
+    }
+
+    cache.pending.clearQuick();
+    cache.upToDate = true;
+}
+
 int TextEditor::getTextWidth() const    { return textHolder->getWidth(); }
 int TextEditor::getTextHeight() const   { return textHolder->getHeight(); }
 
@@ -1570,7 +1927,10 @@ void TextEditor::drawContent (Graphics& g)
         g.setOrigin (leftIndent, topIndent);
         auto clip = g.getClipBounds();
         Colour selectedTextColour;
-        Iterator i (*this);
+
+        updateLayoutCache();
+        auto* firstParagraph = layoutCache->findParagraphAbove ((float) clip.getY());
+        Iterator i (*this, firstParagraph);
 
         if (! selection.isEmpty())
         {
@@ -1612,7 +1972,7 @@ void TextEditor::drawContent (Graphics& g)
 
         for (auto& underlinedSection : underlinedSections)
         {
-            Iterator i2 (*this);
+            Iterator i2 (*this, firstParagraph);
 
             while (i2.next() && i2.lineY < clip.getBottom())
             {
@@ -2155,32 +2515,39 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
             repaintText ({ insertIndex, getTotalNumChars() }); // must do this before and after changing the data, in case
                                                                // a line gets moved due to word wrap
 
-            int index = 0;
-            int nextIndex = 0;
+            layoutCache->textChanged (insertIndex, 0, text.length());
 
-            for (int i = 0; i < sections.size(); ++i)
+            UniformTextSection newSection (text, font, colour, passwordCharacter);
+
+            if (! insertIntoSimilarSection (insertIndex, newSection))
             {
-                nextIndex = index + sections.getUnchecked (i)->getTotalLength();
+                int index = 0;
+                int nextIndex = 0;
 
-                if (insertIndex == index)
+                for (int i = 0; i < sections.size(); ++i)
                 {
-                    sections.insert (i, new UniformTextSection (text, font, colour, passwordCharacter));
-                    break;
-                }
+                    nextIndex = index + sections.getUnchecked (i)->getTotalLength();
 
-                if (insertIndex > index && insertIndex < nextIndex)
-                {
-                    splitSection (i, insertIndex - index);
-                    sections.insert (i + 1, new UniformTextSection (text, font, colour, passwordCharacter));
-                    break;
+                    if (insertIndex == index)
+                    {
+                        sections.insert (i, new UniformTextSection (newSection));
+                        break;
+                    }
+
+                    if (insertIndex > index && insertIndex < nextIndex)
+                    {
+                        splitSection (i, insertIndex - index);
+                        sections.insert (i + 1, new UniformTextSection (newSection));
+                        break;
+                    }
+
+                    index = nextIndex;
                 }
 
-                index = nextIndex;
+                if (nextIndex == insertIndex)
+                    sections.add (new UniformTextSection (newSection));
             }
 
-            if (nextIndex == insertIndex)
-                sections.add (new UniformTextSection (text, font, colour, passwordCharacter));
-
             coalesceSimilarSections();
             totalNumChars = -1;
             valueTextNeedsUpdating = true;
@@ -2195,38 +2562,48 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
 
 void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>& sectionsToInsert)
 {
-    int index = 0;
-    int nextIndex = 0;
+    int numCharsInserted = 0;
+
+    for (auto* s : sectionsToInsert)
+        numCharsInserted += s->getTotalLength();
 
-    for (int i = 0; i < sections.size(); ++i)
+    layoutCache->textChanged (insertIndex, 0, numCharsInserted);
+
+    if (sectionsToInsert.size() != 1 || ! insertIntoSimilarSection (insertIndex, *sectionsToInsert.getFirst()))
     {
-        nextIndex = index + sections.getUnchecked (i)->getTotalLength();
+        int index = 0;
+        int nextIndex = 0;
 
-        if (insertIndex == index)
+        for (int i = 0; i < sections.size(); ++i)
         {
-            for (int j = sectionsToInsert.size(); --j >= 0;)
-                sections.insert (i, new UniformTextSection (*sectionsToInsert.getUnchecked(j)));
+            nextIndex = index + sections.getUnchecked (i)->getTotalLength();
 
-            break;
-        }
+            if (insertIndex == index)
+            {
+                for (int j = sectionsToInsert.size(); --j >= 0;)
+                    sections.insert (i, new UniformTextSection (*sectionsToInsert.getUnchecked(j)));
 
-        if (insertIndex > index && insertIndex < nextIndex)
-        {
-            splitSection (i, insertIndex - index);
+                break;
+            }
 
-            for (int j = sectionsToInsert.size(); --j >= 0;)
-                sections.insert (i + 1, new UniformTextSection (*sectionsToInsert.getUnchecked(j)));
+            if (insertIndex > index && insertIndex < nextIndex)
+            {
+                splitSection (i, insertIndex - index);
+
+                for (int j = sectionsToInsert.size(); --j >= 0;)
+                    sections.insert (i + 1, new UniformTextSection (*sectionsToInsert.getUnchecked(j)));
+
+                break;
+            }
 
-            break;
+            index = nextIndex;
         }
 
-        index = nextIndex;
+        if (nextIndex == insertIndex)
+            for (auto* s : sectionsToInsert)
+                sections.add (new UniformTextSection (*s));
     }
 
-    if (nextIndex == insertIndex)
-        for (auto* s : sectionsToInsert)
-            sections.add (new UniformTextSection (*s));
-
     coalesceSimilarSections();
     totalNumChars = -1;
     valueTextNeedsUpdating = true;
@@ -2236,28 +2613,55 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
 {
     if (! range.isEmpty())
     {
+        if (um == nullptr)
+            layoutCache->textChanged (range.getStart(), range.getLength(), 0);
+
         int index = 0;
+        UniformTextSection* sectionContainingRange = nullptr;
 
-        for (int i = 0; i < sections.size(); ++i)
+        for (auto* section : sections)
         {
-            auto nextIndex = index + sections.getUnchecked(i)->getTotalLength();
+            auto nextIndex = index + section->getTotalLength();
 
-            if (range.getStart() > index && range.getStart() < nextIndex)
-            {
-                splitSection (i, range.getStart() - index);
-                --i;
-            }
-            else if (range.getEnd() > index && range.getEnd() < nextIndex)
+            if (range.getStart() < nextIndex)
             {
-                splitSection (i, range.getEnd() - index);
-                --i;
+                // if the range is only part of one section, it can be removed without splitting the section up
+                if (range.getEnd() <= nextIndex && (range.getStart() > index || range.getEnd() < nextIndex))
+                    sectionContainingRange = section;
+
+                break;
             }
-            else
+
+            index = nextIndex;
+        }
+
+        auto rangeInSection = range - index;
+
+        if (sectionContainingRange == nullptr)
+        {
+            index = 0;
+
+            for (int i = 0; i < sections.size(); ++i)
             {
-                index = nextIndex;
+                auto nextIndex = index + sections.getUnchecked(i)->getTotalLength();
 
-                if (index > range.getEnd())
-                    break;
+                if (range.getStart() > index && range.getStart() < nextIndex)
+                {
+                    splitSection (i, range.getStart() - index);
+                    --i;
+                }
+                else if (range.getEnd() > index && range.getEnd() < nextIndex)
+                {
+                    splitSection (i, range.getEnd() - index);
+                    --i;
+                }
+                else
+                {
+                    index = nextIndex;
+
+                    if (index > range.getEnd())
+                        break;
+                }
             }
         }
 
@@ -2267,17 +2671,24 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
         {
             Array<UniformTextSection*> removedSections;
 
-            for (auto* section : sections)
+            if (sectionContainingRange != nullptr)
             {
-                if (range.getEnd() <= range.getStart())
-                    break;
+                removedSections.add (sectionContainingRange->copyRange (rangeInSection, passwordCharacter));
+            }
+            else
+            {
+                for (auto* section : sections)
+                {
+                    if (range.getEnd() <= range.getStart())
+                        break;
 
-                auto nextIndex = index + section->getTotalLength();
+                    auto nextIndex = index + section->getTotalLength();
 
-                if (range.getStart() <= index && range.getEnd() >= nextIndex)
-                    removedSections.add (new UniformTextSection (*section));
+                    if (range.getStart() <= index && range.getEnd() >= nextIndex)
+                        removedSections.add (new UniformTextSection (*section));
 
-                index = nextIndex;
+                    index = nextIndex;
+                }
             }
 
             if (um->getNumActionsInCurrentTransaction() > TextEditorDefs::maxActionsPerTransaction)
@@ -2288,26 +2699,33 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
         }
         else
         {
-            auto remainingRange = range;
-
-            for (int i = 0; i < sections.size(); ++i)
+            if (sectionContainingRange != nullptr)
             {
-                auto* section = sections.getUnchecked (i);
-                auto nextIndex = index + section->getTotalLength();
+                sectionContainingRange->removeRange (rangeInSection, passwordCharacter);
+            }
+            else
+            {
+                auto remainingRange = range;
 
-                if (remainingRange.getStart() <= index && remainingRange.getEnd() >= nextIndex)
+                for (int i = 0; i < sections.size(); ++i)
                 {
-                    sections.remove (i);
-                    remainingRange.setEnd (remainingRange.getEnd() - (nextIndex - index));
+                    auto* section = sections.getUnchecked (i);
+                    auto nextIndex = index + section->getTotalLength();
 
-                    if (remainingRange.isEmpty())
-                        break;
+                    if (remainingRange.getStart() <= index && remainingRange.getEnd() >= nextIndex)
+                    {
+                        sections.remove (i);
+                        remainingRange.setEnd (remainingRange.getEnd() - (nextIndex - index));
 
-                    --i;
-                }
-                else
-                {
-                    index = nextIndex;
+                        if (remainingRange.isEmpty())
+                            break;
+
+                        --i;
+                    }
+                    else
+                    {
+                        index = nextIndex;
+                    }
                 }
             }
 
@@ -2394,7 +2812,8 @@ void TextEditor::getCharPosition (int index, Point<float>& anchor, float& lineHe
     }
     else
     {
-        Iterator i (*this);
+        updateLayoutCache();
+        Iterator i (*this, layoutCache->findParagraphBefore (index));
 
         if (sections.isEmpty())
         {
@@ -2412,7 +2831,9 @@ int TextEditor::indexAtPosition (const float x, const float y)
 {
     if (getWordWrapWidth() > 0)
     {
-        for (Iterator i (*this); i.next();)
+        updateLayoutCache();
+
+        for (Iterator i (*this, layoutCache->findParagraphAbove (y)); i.next();)
         {
             if (y < i.lineY + i.lineHeight)
             {
@@ -2487,6 +2908,33 @@ void TextEditor::splitSection (const int sectionIndex, const int charToSplitAt)
                      sections.getUnchecked (sectionIndex)->split (charToSplitAt, passwordCharacter));
 }
 
+bool TextEditor::insertIntoSimilarSection (int insertIndex, const UniformTextSection& newSection)
+{
+    int index = 0;
+
+    for (auto* section : sections)
+    {
+        auto nextIndex = index + section->getTotalLength();
+
+        if (insertIndex <= nextIndex)
+        {
+            if (section->font == newSection.font && section->colour == newSection.colour)
+            {
+                section->insertSection (insertIndex - index, newSection, passwordCharacter);
+                return true;
+            }
+
+            // at the end of a section, the next one might still be similar
+            if (insertIndex < nextIndex)
+                return false;
+        }
+
+        index = nextIndex;
+    }
+
+    return false;
+}
+
 void TextEditor::coalesceSimilarSections()
 {
     for (int i = 0; i < sections.size() - 1; ++i)
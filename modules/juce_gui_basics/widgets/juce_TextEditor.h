@@ -684,6 +684,7 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class UniformTextSection)
     struct Iterator;
+    struct LayoutCache;
     struct TextHolderComponent;
     struct TextEditorViewport;
     struct InsertAction;
@@ -718,6 +719,7 @@ private:
     mutable int totalNumChars = 0;
     int caretPosition = 0;
     OwnedArray<UniformTextSection> sections;
+    ScopedPointer<LayoutCache> layoutCache;
     String textToShowWhenEmpty;
     Colour colourForTextWhenEmpty;
     juce_wchar passwordCharacter;
@@ -747,6 +749,7 @@ private:
     void clearInternal (UndoManager*);
     void insert (const String&, int insertIndex, const Font&, Colour, UndoManager*, int newCaretPos);
     void reinsert (int insertIndex, const OwnedArray<UniformTextSection>&);
+    bool insertIntoSimilarSection (int insertIndex, const UniformTextSection&);
     void remove (Range<int>, UndoManager*, int caretPositionToMoveTo);
     void getCharPosition (int index, Point<float>&, float& lineHeight) const;
     Rectangle<float> getCaretRectangleFloat() const;
@@ -759,6 +762,7 @@ private:
     bool moveCaretWithTransaction (int newPos, bool selecting);
     void drawContent (Graphics&);
     void updateTextHolderSize();
+    void updateLayoutCache() const;
     float getWordWrapWidth() const;
     float getJustificationWidth() const;
     void timerCallbackInt();
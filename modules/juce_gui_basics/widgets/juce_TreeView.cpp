@@ -181,31 +181,28 @@ public:
         for (auto* i : items)
             i->shouldKeep = false;
 
+        Array<TreeViewItem*> itemsNeedingComponents;
+
+        if (auto* root = owner.rootItem)
         {
-            auto* item = owner.rootItem;
-            int y = (item != nullptr && ! owner.rootItemVisible) ? -item->itemHeight : 0;
+            auto* item = root->findItemRecursively (jmax (0, visibleTop) + (owner.rootItemVisible ? 0 : root->itemHeight));
+            auto row = item != nullptr ? item->getRowNumberInTree() : 0;
+            auto y = item != nullptr ? item->getItemY() : 0;
 
             while (item != nullptr && y < visibleBottom)
             {
-                y += item->itemHeight;
-
-                if (y >= visibleTop)
-                {
-                    if (auto* ri = findItem (item->uid))
-                    {
-                        ri->shouldKeep = true;
-                    }
-                    else if (auto* comp = item->createItemComponent())
-                    {
-                        items.add (new RowItem (item, comp, item->uid));
-                        addAndMakeVisible (comp);
-                    }
-                }
+                if (auto* ri = findItem (item->uid))
+                    ri->shouldKeep = true;
+                else
+                    itemsNeedingComponents.add (item);
 
-                item = item->getNextVisibleItem (true);
+                y += item->itemHeight;
+                item = owner.getItemOnRow (++row);
             }
         }
 
+        OwnedArray<Component> spareComponents;
+
         for (int i = items.size(); --i >= 0;)
         {
             auto* ri = items.getUnchecked(i);
@@ -230,11 +227,36 @@ public:
                     keep = true;
                     ri->component->setSize (0, 0);
                 }
+
+                if (! keep)
+                {
+                    spareComponents.add (ri->component.get());
+                    ri->component = nullptr;
+                }
             }
 
             if (! keep)
                 items.remove (i);
         }
+
+        for (auto* item : itemsNeedingComponents)
+        {
+            auto* existing = spareComponents.removeAndReturn (spareComponents.size() - 1);
+
+            if (auto* comp = item->refreshItemComponent (existing))
+            {
+                if (comp != existing)
+                    delete existing;
+
+                items.add (new RowItem (item, comp, item->uid));
+                addAndMakeVisible (comp);
+                comp->setBounds (item->getItemPosition (false).withHeight (item->itemHeight));
+            }
+            else
+            {
+                delete existing;
+            }
+        }
     }
 
     bool isMouseOverButton (TreeViewItem* item) const noexcept
@@ -244,7 +266,7 @@ public:
 
     void resized() override
     {
-        owner.itemsChanged();
+        owner.itemLayoutChanged();
     }
 
     String getTooltip() override
@@ -512,6 +534,7 @@ void TreeView::setIndentSize (const int newIndentSize)
     if (indentSize != newIndentSize)
     {
         indentSize = newIndentSize;
+        itemsChanged();
         resized();
     }
 }
@@ -569,11 +592,14 @@ TreeViewItem* TreeView::getSelectedItem (const int index) const noexcept
 
 int TreeView::getNumRowsInTree() const
 {
+    updateItemPositions();
     return rootItem != nullptr ? (rootItem->getNumRows() - (rootItemVisible ? 0 : 1)) : 0;
 }
 
 TreeViewItem* TreeView::getItemOnRow (int index) const
 {
+    updateItemPositions();
+
     if (! rootItemVisible)
         ++index;
 
@@ -664,7 +690,7 @@ void TreeView::resized()
 {
     viewport->setBounds (getLocalBounds());
 
-    itemsChanged();
+    itemLayoutChanged();
     recalculateIfNeeded();
 }
 
@@ -722,7 +748,7 @@ void TreeView::scrollToKeepItemVisible (TreeViewItem* item)
 
         item = item->getDeepestOpenParentItem();
 
-        auto y = item->y;
+        auto y = item->getItemY();
         auto viewTop = viewport->getViewPositionY();
 
         if (y < viewTop)
@@ -836,12 +862,32 @@ bool TreeView::keyPressed (const KeyPress& key)
 }
 
 void TreeView::itemsChanged() noexcept
+{
+    if (rootItem != nullptr)
+        rootItem->needsLayout = true;
+
+    itemLayoutChanged();
+}
+
+void TreeView::itemLayoutChanged() noexcept
 {
     needsRecalculating = true;
     repaint();
     viewport->getContentComp()->triggerAsyncUpdate();
 }
 
+void TreeView::updateItemPositions() const
+{
+    const ScopedLock sl (nodeAlterationLock);
+
+    if (rootItem != nullptr)
+    {
+        rootItem->updatePositions (false);
+        rootItem->relativeY = rootItemVisible ? 0 : -rootItem->itemHeight;
+        rootItem->relativeRow = rootItemVisible ? 0 : -1;
+    }
+}
+
 void TreeView::recalculateIfNeeded()
 {
     if (needsRecalculating)
@@ -849,10 +895,7 @@ void TreeView::recalculateIfNeeded()
         needsRecalculating = false;
 
         const ScopedLock sl (nodeAlterationLock);
-
-        if (rootItem != nullptr)
-            rootItem->updatePositions (rootItemVisible ? 0 : -rootItem->itemHeight);
-
+        updateItemPositions();
         viewport->updateComponents (false);
 
         if (rootItem != nullptr)
@@ -1150,6 +1193,11 @@ void TreeViewItem::itemOpennessChanged (bool)
 {
 }
 
+Component* TreeViewItem::refreshItemComponent (Component*)
+{
+    return createItemComponent();
+}
+
 int TreeViewItem::getNumSubItems() const noexcept
 {
     return subItems.size();
@@ -1169,7 +1217,8 @@ void TreeViewItem::clearSubItems()
         if (! subItems.isEmpty())
         {
             removeAllSubItemsFromList();
-            treeHasChanged();
+            markLayoutDirty (false);
+            ownerView->itemLayoutChanged();
         }
     }
     else
@@ -1190,18 +1239,21 @@ void TreeViewItem::addSubItem (TreeViewItem* const newItem, const int insertPosi
     {
         newItem->parentItem = nullptr;
         newItem->setOwnerView (ownerView);
-        newItem->y = 0;
+        newItem->relativeY = 0;
+        newItem->relativeRow = 0;
         newItem->itemHeight = newItem->getItemHeight();
         newItem->totalHeight = 0;
+        newItem->totalRows = 1;
         newItem->itemWidth = newItem->getItemWidth();
         newItem->totalWidth = 0;
         newItem->parentItem = this;
+        newItem->markLayoutDirty (true);
 
         if (ownerView != nullptr)
         {
             const ScopedLock sl (ownerView->nodeAlterationLock);
             subItems.insert (insertPosition, newItem);
-            treeHasChanged();
+            ownerView->itemLayoutChanged();
 
             if (newItem->isOpen())
                 newItem->itemOpennessChanged (true);
@@ -1223,7 +1275,10 @@ void TreeViewItem::removeSubItem (int index, bool deleteItem)
         const ScopedLock sl (ownerView->nodeAlterationLock);
 
         if (removeSubItemFromList (index, deleteItem))
-            treeHasChanged();
+        {
+            markLayoutDirty (false);
+            ownerView->itemLayoutChanged();
+        }
     }
     else
     {
@@ -1405,7 +1460,7 @@ Rectangle<int> TreeViewItem::getItemPosition (const bool relativeToTreeViewTopLe
     if (ownerView != nullptr && width < 0)
         width = ownerView->viewport->getViewWidth() - indentX;
 
-    Rectangle<int> r (indentX, y, jmax (0, width), totalHeight);
+    Rectangle<int> r (indentX, getItemY(), jmax (0, width), totalHeight);
 
     if (relativeToTreeViewTopLeft && ownerView != nullptr)
         r -= ownerView->viewport->getViewPosition();
@@ -1415,8 +1470,29 @@ Rectangle<int> TreeViewItem::getItemPosition (const bool relativeToTreeViewTopLe
 
 void TreeViewItem::treeHasChanged() const noexcept
 {
+    markLayoutDirty (true);
+
     if (ownerView != nullptr)
-        ownerView->itemsChanged();
+        ownerView->itemLayoutChanged();
+}
+
+void TreeViewItem::markLayoutDirty (bool remeasureThisItem) const noexcept
+{
+    if (remeasureThisItem)
+        needsLayout = true;
+
+    for (auto* p = parentItem; p != nullptr; p = p->parentItem)
+        p->subItemsNeedLayout = true;
+}
+
+int TreeViewItem::getItemY() const noexcept
+{
+    int y = 0;
+
+    for (auto* item = this; item != nullptr; item = item->parentItem)
+        y += item->relativeY;
+
+    return y;
 }
 
 void TreeViewItem::repaintItem() const
@@ -1431,23 +1507,35 @@ bool TreeViewItem::areAllParentsOpen() const noexcept
             || (parentItem->isOpen() && parentItem->areAllParentsOpen());
 }
 
-void TreeViewItem::updatePositions (int newY)
+void TreeViewItem::updatePositions (bool remeasure)
 {
-    y = newY;
-    itemHeight = getItemHeight();
+    remeasure = remeasure || needsLayout;
+
+    if (! (remeasure || subItemsNeedLayout))
+        return;
+
+    needsLayout = false;
+    subItemsNeedLayout = false;
+
+    if (remeasure)
+    {
+        itemHeight = getItemHeight();
+        itemWidth = getItemWidth();
+    }
+
     totalHeight = itemHeight;
-    itemWidth = getItemWidth();
+    totalRows = 1;
     totalWidth = jmax (itemWidth, 0) + getIndentX();
 
     if (isOpen())
     {
-        newY += totalHeight;
-
         for (auto* i : subItems)
         {
-            i->updatePositions (newY);
-            newY += i->totalHeight;
+            i->relativeY = totalHeight;
+            i->relativeRow = totalRows;
+            i->updatePositions (remeasure);
             totalHeight += i->totalHeight;
+            totalRows += i->totalRows;
             totalWidth = jmax (totalWidth, i->totalWidth);
         }
     }
@@ -1472,6 +1560,7 @@ TreeViewItem* TreeViewItem::getDeepestOpenParentItem() noexcept
 void TreeViewItem::setOwnerView (TreeView* const newOwner) noexcept
 {
     ownerView = newOwner;
+    needsLayout = true;
 
     for (auto* i : subItems)
     {
@@ -1595,9 +1684,14 @@ void TreeViewItem::paintRecursively (Graphics& g, int width)
     {
         auto clip = g.getClipBounds();
 
-        for (auto* ti : subItems)
+        // sub-items are laid out in order, so skip straight to the first one that reaches the clip region
+        auto firstVisible = std::upper_bound (subItems.begin(), subItems.end(), clip.getY(),
+                                              [] (int targetY, const TreeViewItem* ti) { return targetY < ti->relativeY + ti->totalHeight; });
+
+        for (auto i = firstVisible; i != subItems.end(); ++i)
         {
-            auto relY = ti->y - y;
+            auto* ti = *i;
+            auto relY = ti->relativeY;
 
             if (relY >= clip.getBottom())
                 break;
@@ -1635,36 +1729,30 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
 
 int TreeViewItem::getNumRows() const noexcept
 {
-    int num = 1;
-
-    if (isOpen())
-        for (auto* i : subItems)
-            num += i->getNumRows();
-
-    return num;
+    return totalRows;
 }
 
 TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
 {
-    if (index == 0)
-        return this;
+    auto* item = this;
 
-    if (index > 0 && isOpen())
+    while (isPositiveAndBelow (index, item->totalRows))
     {
-        --index;
+        if (index == 0)
+            return item;
 
-        for (auto* i : subItems)
-        {
-            if (index == 0)
-                return i;
+        if (! item->isOpen())
+            break;
 
-            auto numRows = i->getNumRows();
+        // the sub-items' row offsets are in ascending order, so find the last one that starts at or before this row
+        auto next = std::upper_bound (item->subItems.begin(), item->subItems.end(), index,
+                                      [] (int row, const TreeViewItem* ti) { return row < ti->relativeRow; });
 
-            if (numRows > index)
-                return i->getItemOnRow (index);
+        if (next == item->subItems.begin())
+            break;
 
-            index -= numRows;
-        }
+        item = *(next - 1);
+        index -= item->relativeRow;
     }
 
     return nullptr;
@@ -1672,25 +1760,24 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
 
 TreeViewItem* TreeViewItem::findItemRecursively (int targetY) noexcept
 {
-    if (isPositiveAndBelow (targetY, totalHeight))
+    auto* item = this;
+
+    while (isPositiveAndBelow (targetY, item->totalHeight))
     {
-        auto h = itemHeight;
+        if (targetY < item->itemHeight)
+            return item;
 
-        if (targetY < h)
-            return this;
+        if (! item->isOpen())
+            break;
 
-        if (isOpen())
-        {
-            targetY -= h;
+        auto next = std::upper_bound (item->subItems.begin(), item->subItems.end(), targetY,
+                                      [] (int y, const TreeViewItem* ti) { return y < ti->relativeY; });
 
-            for (auto* i : subItems)
-            {
-                if (targetY < i->totalHeight)
-                    return i->findItemRecursively (targetY);
+        if (next == item->subItems.begin())
+            break;
 
-                targetY -= i->totalHeight;
-            }
-        }
+        item = *(next - 1);
+        targetY -= item->relativeY;
     }
 
     return nullptr;
@@ -1735,22 +1822,21 @@ int TreeViewItem::getRowNumberInTree() const noexcept
 {
     if (parentItem != nullptr && ownerView != nullptr)
     {
-        if (! parentItem->isOpen())
-            return parentItem->getRowNumberInTree();
+        ownerView->updateItemPositions();
 
-        int n = 1 + parentItem->getRowNumberInTree();
+        // items inside a closed parent share the row of their outermost closed ancestor
+        auto* visibleItem = this;
 
-        int ourIndex = parentItem->subItems.indexOf (this);
-        jassert (ourIndex >= 0);
+        for (auto* p = parentItem; p != nullptr; p = p->parentItem)
+            if (! p->isOpen())
+                visibleItem = p;
 
-        while (--ourIndex >= 0)
-            n += parentItem->subItems [ourIndex]->getNumRows();
+        int n = 0;
 
-        if (parentItem->parentItem == nullptr
-             && ! ownerView->rootItemVisible)
-            --n;
+        for (auto* item = visibleItem; item != nullptr; item = item->parentItem)
+            n += item->relativeRow;
 
-        return n;
+        return jmax (0, n);
     }
 
     return 0;
@@ -122,6 +122,7 @@ public:
     void sortSubItems (ElementComparator& comparator)
     {
         subItems.sort (comparator);
+        markLayoutDirty (false);
     }
 
     //==============================================================================
@@ -199,6 +200,10 @@ public:
 
     /** Sends a signal to the treeview to make it refresh itself.
         Call this if your items have changed and you want the tree to update to reflect this.
+
+        The tree caches the heights and row counts of its items, and only this item and
+        its sub-items will be re-measured, so if you change the height of some other item
+        you should call this method on that item.
     */
     void treeHasChanged() const noexcept;
 
@@ -322,6 +327,24 @@ public:
     */
     virtual Component* createItemComponent()                        { return nullptr; }
 
+    /** Gives the item a chance to re-use a component that has been scrolled out of view.
+
+        When the tree is scrolled, the components belonging to items that have moved out
+        of view are offered to the items that are coming into view, in the same way that
+        ListBoxModel::refreshComponentForRow() lets a ListBox recycle its row components.
+
+        If existingComponentToUpdate is non-null, it's a component that was created by
+        another item's createItemComponent() or refreshItemComponent(). You can update it
+        to represent this item and return it, or return a different component, in which
+        case the tree will delete the old one. If it's null, you'll need to create a new
+        component, or return nullptr if this item doesn't use one.
+
+        The default implementation ignores the existing component and just calls
+        createItemComponent(), so only override this if all the items in your tree use
+        compatible component types.
+    */
+    virtual Component* refreshItemComponent (Component* existingComponentToUpdate);
+
     //==============================================================================
     /** Draws the item's contents.
 
@@ -582,8 +605,9 @@ private:
     TreeView* ownerView = nullptr;
     TreeViewItem* parentItem = nullptr;
     OwnedArray<TreeViewItem> subItems;
-    int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0;
+    int relativeY = 0, relativeRow = 0, itemHeight = 0, totalHeight = 0, totalRows = 1, itemWidth = 0, totalWidth = 0;
     int uid = 0;
+    mutable bool needsLayout = true, subItemsNeedLayout = false;
     bool selected           : 1;
     bool redrawNeeded       : 1;
     bool drawLinesInside    : 1;
@@ -594,7 +618,9 @@ private:
 
     friend class TreeView;
 
-    void updatePositions (int newY);
+    void updatePositions (bool remeasure);
+    void markLayoutDirty (bool remeasureThisItem) const noexcept;
+    int getItemY() const noexcept;
     int getIndentX() const noexcept;
     void setOwnerView (TreeView*) noexcept;
     void paintRecursively (Graphics&, int width);
@@ -916,6 +942,8 @@ private:
     bool multiSelectEnabled = false, openCloseButtonsVisible = true;
 
     void itemsChanged() noexcept;
+    void itemLayoutChanged() noexcept;
+    void updateItemPositions() const;
     void recalculateIfNeeded();
     void updateButtonUnderMouse (const MouseEvent&);
     struct InsertPoint;
@@ -101,6 +101,53 @@ void ComponentPeer::handleMagnifyGesture (MouseInputSource::InputSourceType type
 }
 
 //==============================================================================
+void ComponentPeer::optimiseRepaintRegion (RectangleList<int>& region)
+{
+    auto numRectanglesBefore = region.getNumRectangles();
+
+    if (numRectanglesBefore == 0)
+        return;
+
+    auto getTotalArea = [] (const RectangleList<int>& r)
+    {
+        int64 total = 0;
+
+        // (the rectangles in a RectangleList never overlap, so they can just be added up)
+        for (auto& rect : r)
+            total += rect.getWidth() * (int64) rect.getHeight();
+
+        return total;
+    };
+
+    auto areaBefore = getTotalArea (region);
+    auto bounds = region.getBounds();
+    auto boundsArea = bounds.getWidth() * (int64) bounds.getHeight();
+
+    if (numRectanglesBefore > 1)
+    {
+        // If the invalidated areas already cover most of their bounding box, then painting
+        // the whole box only adds a little overdraw, and saves clipping and blitting lots
+        // of separate pieces. Otherwise, merge whatever pieces line up exactly, and only fall
+        // back to the bounding box if there are still lots of them, and not too much of the
+        // box would be painted needlessly.
+        if (areaBefore * 4 >= boundsArea * 3)
+        {
+            region = bounds;
+        }
+        else
+        {
+            region.consolidate();
+
+            if (region.getNumRectangles() > 16 && areaBefore * 4 >= boundsArea)
+                region = bounds;
+        }
+    }
+
+    if (RepaintProfiler::isEnabled())
+        RepaintProfiler::regionMerged (*this, numRectanglesBefore, areaBefore,
+                                       region.getNumRectangles(), getTotalArea (region));
+}
+
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
     ModifierKeys::updateCurrentModifiers();
@@ -126,12 +173,20 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
     }
   #endif
 
+    const bool isProfiling = RepaintProfiler::isEnabled();
+
+    if (isProfiling)
+        RepaintProfiler::beginFrame (*this, g.getClipBounds());
+
     JUCE_TRY
     {
         component.paintEntireComponent (g, true);
     }
     JUCE_CATCH_EXCEPTION
 
+    if (isProfiling)
+        RepaintProfiler::endFrame (*this, g);
+
   #if JUCE_ENABLE_REPAINT_DEBUGGING
    #ifdef JUCE_IS_REPAINT_DEBUGGING_ACTIVE
     if (JUCE_IS_REPAINT_DEBUGGING_ACTIVE)
@@ -308,6 +308,14 @@ public:
     */
     virtual void performAnyPendingRepaintsNow() = 0;
 
+    /** Simplifies a region that's about to be repainted.
+
+        Peer implementations that do their own repaint merging can call this before painting,
+        to trade a little overdraw for fewer, larger rectangles when that's likely to be
+        quicker. It also records the region's statistics for the RepaintProfiler.
+    */
+    void optimiseRepaintRegion (RectangleList<int>& region);
+
     /** Changes the window's transparency. */
     virtual void setAlpha (float newAlpha) = 0;
 
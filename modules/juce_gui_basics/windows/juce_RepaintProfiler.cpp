@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct RepaintProfiler::State
+{
+    struct PendingInvalidation
+    {
+        ComponentPeer* peer;
+        Invalidation invalidation;
+    };
+
+    struct PendingMerge
+    {
+        ComponentPeer* peer;
+        int numBefore, numAfter;
+        int64 areaBefore, areaAfter;
+    };
+
+    // (a window that never gets painted, e.g. because it's minimised, mustn't be
+    // allowed to keep piling up invalidations forever)
+    enum { maxPendingInvalidations = 4096 };
+
+    Array<PendingInvalidation> pendingInvalidations;
+    Array<PendingMerge> pendingMerges;
+    ScopedPointer<Frame> currentFrame;
+    int nestedFrameDepth = 0, frameCounter = 0;
+
+    Array<Frame> recentFrames;
+    int maxFramesToKeep = 100;
+
+    ListenerList<Listener> listeners;
+};
+
+bool RepaintProfiler::enabled = false;
+bool RepaintProfiler::overlayEnabled = false;
+
+RepaintProfiler::State& RepaintProfiler::getState()
+{
+    static State state;
+    return state;
+}
+
+//==============================================================================
+void RepaintProfiler::setEnabled (bool shouldBeEnabled)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    enabled = shouldBeEnabled || overlayEnabled;
+
+    if (! enabled)
+    {
+        auto& state = getState();
+        state.pendingInvalidations.clear();
+        state.pendingMerges.clear();
+    }
+}
+
+void RepaintProfiler::setOverlayEnabled (bool shouldShowOverlay)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    overlayEnabled = shouldShowOverlay;
+
+    if (overlayEnabled)
+        enabled = true;
+
+    for (int i = ComponentPeer::getNumPeers(); --i >= 0;)
+        ComponentPeer::getPeer (i)->getComponent().repaint();
+}
+
+void RepaintProfiler::setMaxNumFramesToKeep (int maxNumFrames)
+{
+    auto& state = getState();
+    state.maxFramesToKeep = jmax (1, maxNumFrames);
+
+    if (state.recentFrames.size() > state.maxFramesToKeep)
+        state.recentFrames.removeRange (0, state.recentFrames.size() - state.maxFramesToKeep);
+}
+
+Array<RepaintProfiler::Frame> RepaintProfiler::getRecentFrames()
+{
+    return getState().recentFrames;
+}
+
+void RepaintProfiler::clearRecentFrames()
+{
+    getState().recentFrames.clear();
+}
+
+void RepaintProfiler::addListener (Listener* l)       { getState().listeners.add (l); }
+void RepaintProfiler::removeListener (Listener* l)    { getState().listeners.remove (l); }
+
+//==============================================================================
+void RepaintProfiler::componentInvalidated (Component& c, Rectangle<int> area)
+{
+    auto& state = getState();
+
+    if (state.pendingInvalidations.size() < State::maxPendingInvalidations)
+        if (auto* peer = c.getPeer())
+            state.pendingInvalidations.add ({ peer, { &c, c.getName(), area } });
+}
+
+void RepaintProfiler::componentPainted (Component& c, double milliseconds)
+{
+    auto& state = getState();
+
+    if (state.currentFrame != nullptr)
+        state.currentFrame->paintCalls.add ({ &c, c.getName(), milliseconds });
+}
+
+void RepaintProfiler::regionMerged (ComponentPeer& peer, int numBefore, int64 areaBefore, int numAfter, int64 areaAfter)
+{
+    getState().pendingMerges.add ({ &peer, numBefore, numAfter, areaBefore, areaAfter });
+}
+
+void RepaintProfiler::beginFrame (ComponentPeer& peer, Rectangle<int> paintedBounds)
+{
+    auto& state = getState();
+
+    if (state.currentFrame != nullptr)
+    {
+        ++state.nestedFrameDepth;
+        return;
+    }
+
+    auto* frame = new Frame();
+    state.currentFrame = frame;
+
+    frame->peer = &peer;
+    frame->frameNumber = ++state.frameCounter;
+    frame->startTime = Time::getMillisecondCounterHiRes();
+    frame->milliseconds = 0;
+    frame->paintedBounds = paintedBounds;
+    frame->numRectanglesRequested = frame->numRectanglesPainted = 0;
+    frame->areaRequested = frame->areaPainted = 0;
+
+    for (int i = 0; i < state.pendingInvalidations.size(); ++i)
+    {
+        auto& pending = state.pendingInvalidations.getReference (i);
+
+        if (pending.peer == &peer)
+        {
+            frame->invalidations.add (pending.invalidation);
+            state.pendingInvalidations.remove (i--);
+        }
+    }
+
+    for (int i = 0; i < state.pendingMerges.size(); ++i)
+    {
+        auto& merge = state.pendingMerges.getReference (i);
+
+        if (merge.peer == &peer)
+        {
+            frame->numRectanglesRequested += merge.numBefore;
+            frame->numRectanglesPainted   += merge.numAfter;
+            frame->areaRequested          += merge.areaBefore;
+            frame->areaPainted            += merge.areaAfter;
+
+            state.pendingMerges.remove (i--);
+        }
+    }
+}
+
+static void drawRepaintOverlay (const RepaintProfiler::Frame& frame, Component& peerComponent, Graphics& g)
+{
+    g.saveState();
+
+    for (auto& invalidation : frame.invalidations)
+    {
+        if (auto* c = invalidation.component.getComponent())
+        {
+            auto area = peerComponent.getLocalArea (c, invalidation.area).toFloat();
+
+            g.setColour (Colours::red.withAlpha (0.12f));
+            g.fillRect (area);
+            g.setColour (Colours::red.withAlpha (0.8f));
+            g.drawRect (area, 1.0f);
+        }
+    }
+
+    String text;
+    text << String (frame.milliseconds, 1) << " ms, "
+         << frame.paintCalls.size() << " paints, "
+         << frame.invalidations.size() << " repaints";
+
+    Rectangle<int> textArea (frame.paintedBounds.getX(), frame.paintedBounds.getY(), 200, 16);
+
+    g.setColour (Colours::black.withAlpha (0.7f));
+    g.fillRect (textArea);
+    g.setColour (Colours::white);
+    g.setFont (12.0f);
+    g.drawText (text, textArea.reduced (3, 0), Justification::centredLeft, true);
+
+    g.restoreState();
+}
+
+void RepaintProfiler::endFrame (ComponentPeer& peer, Graphics& g)
+{
+    auto& state = getState();
+
+    if (state.nestedFrameDepth > 0)
+    {
+        --state.nestedFrameDepth;
+        return;
+    }
+
+    ScopedPointer<Frame> frame (state.currentFrame.release());
+
+    if (frame == nullptr)
+        return;
+
+    jassert (frame->peer == &peer);
+    frame->milliseconds = Time::getMillisecondCounterHiRes() - frame->startTime;
+
+    if (overlayEnabled)
+        drawRepaintOverlay (*frame, peer.getComponent(), g);
+
+    if (state.recentFrames.size() >= state.maxFramesToKeep)
+        state.recentFrames.removeRange (0, state.recentFrames.size() - state.maxFramesToKeep + 1);
+
+    state.recentFrames.add (*frame);
+    state.listeners.call (&Listener::repaintFrameRecorded, *frame);
+}
+
+} // namespace juce
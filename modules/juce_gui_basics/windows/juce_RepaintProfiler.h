@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records what gets repainted in each frame, and how long it takes.
+
+    When it's enabled, the profiler keeps a note of every call to Component::repaint(),
+    and of how long each component's paint() and paintOverChildren() methods take. Each
+    time a ComponentPeer paints its window, all of this is gathered up into a Frame, along
+    with some statistics about how the invalidated areas were merged into the region that
+    actually got drawn. You can look at the most recent frames with getRecentFrames(), or
+    register a Listener to be told about each one as it finishes.
+
+    If you enable the overlay too, each frame will be drawn with the areas that were
+    invalidated outlined on top of it, and with its paint time in the corner.
+
+    Everything here happens on the message thread, and when the profiler is disabled
+    (which is the default), it costs no more than checking a flag in each call to repaint()
+    and paint().
+
+    @see ComponentPeer::handlePaint, Component::repaint
+*/
+class JUCE_API  RepaintProfiler
+{
+public:
+    //==============================================================================
+    /** A call to Component::repaint(). */
+    struct Invalidation
+    {
+        /** The component that was repainted. This will be null if it has since been deleted. */
+        Component::SafePointer<Component> component;
+
+        /** The component's name at the time it was repainted. */
+        String componentName;
+
+        /** The area that was invalidated, relative to the component's top-left. */
+        Rectangle<int> area;
+    };
+
+    /** The time a component spent painting itself during a frame. */
+    struct PaintCall
+    {
+        /** The component that was painted. This will be null if it has since been deleted. */
+        Component::SafePointer<Component> component;
+
+        /** The component's name at the time it was painted. */
+        String componentName;
+
+        /** The time taken by the component's paint() and paintOverChildren() methods,
+            not including the time spent painting its children.
+        */
+        double milliseconds;
+    };
+
+    /** Everything that happened in one repaint of a window. */
+    struct Frame
+    {
+        /** The peer that was painted. This could have been deleted since. */
+        ComponentPeer* peer;
+
+        /** A count that goes up by one for each frame that's recorded. */
+        int frameNumber;
+
+        /** The time at which painting started, as returned by Time::getMillisecondCounterHiRes(). */
+        double startTime;
+
+        /** The total time spent painting the frame. */
+        double milliseconds;
+
+        /** The bounds of the area that was painted, relative to the peer's component. */
+        Rectangle<int> paintedBounds;
+
+        /** The repaint() calls that made this frame necessary. */
+        Array<Invalidation> invalidations;
+
+        /** Each component that painted itself during the frame, in the order in which they
+            finished (so a component's children will appear before it).
+        */
+        Array<PaintCall> paintCalls;
+
+        /** The number of separate rectangles in the invalidated region, before and after the
+            peer merged them. These will be 0 if the peer doesn't do its own merging.
+        */
+        int numRectanglesRequested, numRectanglesPainted;
+
+        /** The area in pixels of the invalidated region, and of the region that was actually
+            painted after merging, so that you can see how much overdraw the merging caused.
+            These will be 0 if the peer doesn't do its own merging.
+        */
+        int64 areaRequested, areaPainted;
+    };
+
+    //==============================================================================
+    /** Turns recording on or off. */
+    static void setEnabled (bool shouldBeEnabled);
+
+    /** Returns true if recording is turned on. */
+    static bool isEnabled() noexcept                        { return enabled; }
+
+    /** Turns the debug overlay on or off. This also enables recording if it's needed. */
+    static void setOverlayEnabled (bool shouldShowOverlay);
+
+    /** Returns true if the debug overlay is being drawn. */
+    static bool isOverlayEnabled() noexcept                 { return overlayEnabled; }
+
+    /** Sets the number of frames that getRecentFrames() keeps. The default is 100. */
+    static void setMaxNumFramesToKeep (int maxNumFrames);
+
+    /** Returns the most recently recorded frames, oldest first. */
+    static Array<Frame> getRecentFrames();
+
+    /** Throws away all the recorded frames. */
+    static void clearRecentFrames();
+
+    //==============================================================================
+    /** Receives a callback each time the profiler records a frame. */
+    struct JUCE_API  Listener
+    {
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called on the message thread just after a frame has finished painting. */
+        virtual void repaintFrameRecorded (const Frame&) = 0;
+    };
+
+    /** Registers a listener to be told about each frame. */
+    static void addListener (Listener*);
+
+    /** Removes a listener that was previously added with addListener(). */
+    static void removeListener (Listener*);
+
+    //==============================================================================
+    /** @internal */
+    static void componentInvalidated (Component&, Rectangle<int> area);
+    /** @internal */
+    static void componentPainted (Component&, double milliseconds);
+    /** @internal */
+    static void regionMerged (ComponentPeer&, int numRectanglesBefore, int64 areaBefore, int numRectanglesAfter, int64 areaAfter);
+    /** @internal */
+    static void beginFrame (ComponentPeer&, Rectangle<int> paintedBounds);
+    /** @internal */
+    static void endFrame (ComponentPeer&, Graphics&);
+
+private:
+    //==============================================================================
+    struct State;
+    static State& getState();
+    static bool enabled, overlayEnabled;
+
+    RepaintProfiler() = delete;
+};
+
+} // namespace juce
@@ -294,7 +294,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -307,7 +307,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -332,13 +332,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
                 for (int i = lineStart; i < lineEnd; ++i)
                 {
                     auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+                    auto lineStartInFile = owner->getLineStart (i);
+                    auto index = newPosition - lineStartInFile;
 
                     if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
                     {
                         line = i;
                         indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
+                        characterPos = lineStartInFile + indexInLine;
                     }
                 }
 
@@ -348,7 +349,7 @@ void CodeDocument::Position::setPosition (const int newPosition)
             {
                 auto midIndex = (lineStart + lineEnd + 1) / 2;
 
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
+                if (newPosition >= owner->getLineStart (midIndex))
                     lineStart = midIndex;
                 else
                     lineEnd = midIndex;
@@ -495,11 +496,53 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 int CodeDocument::getNumCharacters() const noexcept
 {
     if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+        return getLineStart (lines.size() - 1) + lastLine->lineLength;
 
     return 0;
 }
 
+int CodeDocument::getLineStart (int lineIndex) const noexcept
+{
+    auto start = lines.getUnchecked (lineIndex)->lineStartInFile;
+    return lineIndex > stepLine ? start + stepLength : start;
+}
+
+void CodeDocument::setLineStart (int lineIndex, int newStart) noexcept
+{
+    lines.getUnchecked (lineIndex)->lineStartInFile = lineIndex > stepLine ? newStart - stepLength : newStart;
+}
+
+void CodeDocument::moveStepTo (int lineIndex) noexcept
+{
+    if (stepLength == 0)
+    {
+        stepLine = lineIndex;
+        return;
+    }
+
+    if (lineIndex > stepLine)
+    {
+        // the lines that the step moves over need the offset added
+        for (int i = stepLine + 1; i <= lineIndex; ++i)
+            lines.getUnchecked (i)->lineStartInFile += stepLength;
+    }
+    else if (stepLine - lineIndex < lines.size() - stepLine)
+    {
+        for (int i = lineIndex + 1; i <= stepLine; ++i)
+            lines.getUnchecked (i)->lineStartInFile -= stepLength;
+    }
+    else
+    {
+        // moving the step back this far would take longer than just applying it everywhere
+        for (int i = stepLine + 1; i < lines.size(); ++i)
+            lines.getUnchecked (i)->lineStartInFile += stepLength;
+
+        stepLength = 0;
+    }
+
+    stepLine = lineIndex;
+}
+
 String CodeDocument::getLine (const int lineIndex) const noexcept
 {
     if (auto* line = lines[lineIndex])
@@ -744,13 +787,19 @@ void CodeDocument::checkLastLineStatus()
         lines.removeLast();
     }
 
+    if (lines.isEmpty())
+        stepLength = 0;
+
+    stepLine = jmin (stepLine, jmax (0, lines.size() - 1));
+
     const CodeDocumentLine* const lastLine = lines.getLast();
 
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        auto start = getLineStart (lines.size() - 1) + lastLine->lineLength;
+        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0, 0));
+        setLineStart (lines.size() - 1, start);
     }
 }
 
@@ -802,6 +851,9 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
             Position pos (*this, insertPos);
             auto firstAffectedLine = pos.getLineNumber();
 
+            // the lines from here onwards will have their stored start positions changed
+            moveStepTo (firstAffectedLine);
+
             auto* firstLine = lines[firstAffectedLine];
             auto textInsideOriginalLine = text;
 
@@ -811,28 +863,35 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
                 textInsideOriginalLine = firstLine->line.substring (0, index)
                                          + textInsideOriginalLine
                                          + firstLine->line.substring (index);
+
+                if (firstLine->lineLength >= maximumLineLength)
+                    maximumLineLength = -1;
             }
 
-            maximumLineLength = -1;
             Array<CodeDocumentLine*> newLines;
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
-            auto* newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
-            lines.set (firstAffectedLine, newFirstLine);
+            int lineStart = firstLine != nullptr ? firstLine->lineStartInFile : 0;
+
+            for (auto* l : newLines)
+            {
+                l->lineStartInFile = lineStart;
+                lineStart += l->lineLength;
+
+                if (maximumLineLength >= 0)
+                    maximumLineLength = jmax (maximumLineLength, l->lineLength);
+            }
+
+            lines.set (firstAffectedLine, newLines.getUnchecked (0));
 
             if (newLines.size() > 1)
                 lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
 
-            int lineStart = newFirstLine->lineStartInFile;
-
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
-            {
-                auto& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
-            }
+            // the new lines all have their real start positions, and everything after
+            // them has moved along by the length of the text
+            stepLine = firstAffectedLine + newLines.size() - 1;
+            stepLength += text.length();
 
             checkLastLineStatus();
             auto newTextLength = text.length();
@@ -893,11 +952,16 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         Position startPosition (*this, startPos);
         Position endPosition (*this, endPos);
 
-        maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
 
+        moveStepTo (firstAffectedLine);
+
+        for (int i = firstAffectedLine; i <= endLine && maximumLineLength >= 0; ++i)
+            if (lines.getUnchecked (i)->lineLength >= maximumLineLength)
+                maximumLineLength = -1;
+
         if (firstAffectedLine == endLine)
         {
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
@@ -916,12 +980,11 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
+        if (maximumLineLength >= 0)
+            maximumLineLength = jmax (maximumLineLength, firstLine.lineLength);
+
+        // everything after the first line has moved back by the length of the deleted text
+        stepLength -= (endPosition.getPosition() - startPosition.getPosition());
 
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
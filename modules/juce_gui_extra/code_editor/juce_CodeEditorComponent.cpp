@@ -269,12 +269,12 @@ private:
 
     void codeDocumentTextInserted (const String& newText, int pos) override
     {
-        owner.codeDocumentChanged (pos, pos + newText.length());
+        owner.codeDocumentChanged (pos, pos + newText.length(), newText.length());
     }
 
     void codeDocumentTextDeleted (int start, int end) override
     {
-        owner.codeDocumentChanged (start, end);
+        owner.codeDocumentChanged (start, end, start - end);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
@@ -369,6 +369,7 @@ CodeEditorComponent::CodeEditorComponent (CodeDocument& doc, CodeTokeniser* cons
     verticalScrollBar.addListener (pimpl);
     horizontalScrollBar.addListener (pimpl);
     document.addListener (pimpl);
+    lastNumLines = document.getNumLines();
 }
 
 CodeEditorComponent::~CodeEditorComponent()
@@ -542,12 +543,14 @@ void CodeEditorComponent::rebuildLineTokens()
         gutter->documentChanged (document, firstLineOnScreen);
 }
 
-void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int endIndex)
+void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int endIndex, const int charDelta)
 {
     const CodeDocument::Position affectedTextStart (document, startIndex);
     const CodeDocument::Position affectedTextEnd (document, endIndex);
 
-    clearCachedIterators (affectedTextStart.getLineNumber());
+    const int numLines = document.getNumLines();
+    keepCachedIteratorsAfterChange (affectedTextStart.getLineNumber(), numLines - lastNumLines, charDelta);
+    lastNumLines = numLines;
 
     rebuildLineTokensAsync();
 
@@ -1537,6 +1540,52 @@ void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
             break;
 
     cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
+
+    if (firstLineToBeInvalid <= 0)
+        pendingIterators.clear();
+}
+
+void CodeEditorComponent::keepCachedIteratorsAfterChange (const int firstChangedLine, const int lineDelta, const int charDelta)
+{
+    // The tokens after the end of the edited text haven't changed, so rather than throwing away
+    // the iterators there, they're moved to where their text now is and kept as pending. When the
+    // tokeniser next passes through the edited lines, it can stop as soon as it reaches one of
+    // them, because from there on it would only produce the same tokens again.
+    const int oldEndLine = firstChangedLine + jmax (0, -lineDelta);
+    const int lastLine = document.getNumLines() - 1;
+
+    auto shift = [=] (CodeDocument::Iterator& t)
+    {
+        t.line += lineDelta;
+        t.position += charDelta;
+        return t.line < lastLine;
+    };
+
+    for (int i = pendingIterators.size(); --i >= 0;)
+    {
+        auto& t = *pendingIterators.getUnchecked (i);
+
+        if (t.line <= oldEndLine || ! shift (t))
+            pendingIterators.remove (i);
+    }
+
+    int numToKeep = 0;
+
+    while (numToKeep < cachedIterators.size()
+            && cachedIterators.getUnchecked (cachedIterators.size() - 1 - numToKeep)->line > oldEndLine)
+        ++numToKeep;
+
+    for (int i = 0; i < numToKeep; ++i)
+    {
+        auto* t = cachedIterators.removeAndReturn (cachedIterators.size() - 1);
+
+        if (shift (*t))
+            pendingIterators.insert (0, t);
+        else
+            delete t;
+    }
+
+    clearCachedIterators (firstChangedLine);
 }
 
 void CodeEditorComponent::updateCachedIterators (int maxLineNum)
@@ -1564,6 +1613,23 @@ void CodeEditorComponent::updateCachedIterators (int maxLineNum)
             {
                 codeTokeniser->readNextToken (*t);
 
+                while (pendingIterators.size() > 0 && pendingIterators.getFirst()->getPosition() < t->getPosition())
+                    pendingIterators.remove (0);
+
+                if (auto* pending = pendingIterators.getFirst())
+                {
+                    if (pending->getPosition() == t->getPosition())
+                    {
+                        // the tokens have converged with the ones from before the edit
+                        pendingIterators.remove (0);
+
+                        while (pendingIterators.size() > 0)
+                            cachedIterators.add (pendingIterators.removeAndReturn (0));
+
+                        break;
+                    }
+                }
+
                 if (t->getLine() >= targetLine)
                     break;
 
@@ -404,10 +404,12 @@ private:
     OwnedArray<CodeEditorLine> lines;
     void rebuildLineTokens();
     void rebuildLineTokensAsync();
-    void codeDocumentChanged (int start, int end);
+    void codeDocumentChanged (int start, int end, int charDelta);
 
-    OwnedArray<CodeDocument::Iterator> cachedIterators;
+    OwnedArray<CodeDocument::Iterator> cachedIterators, pendingIterators;
+    int lastNumLines = 0;
     void clearCachedIterators (int firstLineToBeInvalid);
+    void keepCachedIteratorsAfterChange (int firstChangedLine, int lineDelta, int charDelta);
     void updateCachedIterators (int maxLineNum);
     void getIteratorForPosition (int position, CodeDocument::Iterator&);
 
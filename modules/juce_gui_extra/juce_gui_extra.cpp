@@ -118,6 +118,7 @@
 #include "misc/juce_SystemTrayIconComponent.cpp"
 #include "misc/juce_LiveConstantEditor.cpp"
 #include "misc/juce_AnimatedAppComponent.cpp"
+#include "misc/juce_MemoryUsageComponent.cpp"
 
 //==============================================================================
 #if JUCE_MAC || JUCE_IOS
@@ -98,3 +98,4 @@
 #include "misc/juce_WebBrowserComponent.h"
 #include "misc/juce_LiveConstantEditor.h"
 #include "misc/juce_AnimatedAppComponent.h"
+#include "misc/juce_MemoryUsageComponent.h"
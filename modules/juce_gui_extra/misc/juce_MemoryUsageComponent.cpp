@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static const int memoryUsageRowHeight = 22;
+
+MemoryUsageComponent::MemoryUsageComponent (int refreshIntervalMilliseconds)
+{
+    setOpaque (true);
+    timerCallback();
+    startTimer (jmax (20, refreshIntervalMilliseconds));
+}
+
+MemoryUsageComponent::~MemoryUsageComponent()
+{
+}
+
+int MemoryUsageComponent::getIdealHeight() const noexcept
+{
+    return (entries.size() + 2) * memoryUsageRowHeight;
+}
+
+void MemoryUsageComponent::timerCallback()
+{
+    auto newEntries = MemoryUsage::getSnapshot();
+    auto newTotal = MemoryUsage::getTotalBytes();
+
+    bool changed = newTotal != totalBytes || newEntries.size() != entries.size();
+
+    for (int i = 0; ! changed && i < newEntries.size(); ++i)
+    {
+        auto& a = newEntries.getReference (i);
+        auto& b = entries.getReference (i);
+
+        changed = a.name != b.name || a.currentBytes != b.currentBytes
+                    || a.peakBytes != b.peakBytes || a.budget != b.budget;
+    }
+
+    if (changed)
+    {
+        entries.swapWith (newEntries);
+        totalBytes = newTotal;
+        repaint();
+    }
+}
+
+void MemoryUsageComponent::paint (Graphics& g)
+{
+    auto background = findColour (ResizableWindow::backgroundColourId);
+    auto textColour = background.contrasting();
+
+    g.fillAll (background);
+    g.setFont ((float) memoryUsageRowHeight * 0.6f);
+
+    auto area = getLocalBounds().reduced (4, 0);
+    auto nameWidth = area.getWidth() / 4;
+    auto valueWidth = area.getWidth() / 6;
+
+    auto drawRow = [&] (const String& name, const String& current, const String& peak,
+                        const String& budget, float proportionOfBudget)
+    {
+        auto row = area.removeFromTop (memoryUsageRowHeight);
+
+        g.setColour (textColour);
+        g.drawText (name,    row.removeFromLeft (nameWidth),  Justification::centredLeft, true);
+        g.drawText (current, row.removeFromLeft (valueWidth), Justification::centredRight, true);
+        g.drawText (peak,    row.removeFromLeft (valueWidth), Justification::centredRight, true);
+        g.drawText (budget,  row.removeFromLeft (valueWidth), Justification::centredRight, true);
+
+        if (proportionOfBudget >= 0)
+        {
+            auto bar = row.reduced (8, 5).toFloat();
+
+            g.setColour (textColour.withAlpha (0.2f));
+            g.fillRect (bar);
+
+            g.setColour (proportionOfBudget > 1.0f ? Colours::red : Colours::green);
+            g.fillRect (bar.withWidth (bar.getWidth() * jmin (1.0f, proportionOfBudget)));
+        }
+    };
+
+    auto describe = [] (int64 numBytes) { return File::descriptionOfSizeInBytes (numBytes); };
+
+    drawRow ("Category", "Current", "Peak", "Budget", -1.0f);
+
+    for (auto& e : entries)
+        drawRow (e.name, describe (e.currentBytes), describe (e.peakBytes),
+                 e.budget > 0 ? describe (e.budget) : String ("-"),
+                 e.budget > 0 ? (float) e.currentBytes / (float) e.budget : -1.0f);
+
+    auto totalBudget = MemoryUsage::getTotalBudget();
+
+    drawRow ("Total", describe (totalBytes), {},
+             totalBudget > 0 ? describe (totalBudget) : String ("-"),
+             totalBudget > 0 ? (float) totalBytes / (float) totalBudget : -1.0f);
+}
+
+} // namespace juce
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A component that shows the current and peak usage of each MemoryUsage category,
+    with a bar showing how much of its budget each one is using.
+
+    It updates itself a few times a second, so you can put one in a debug window
+    and watch where an app's memory is going while it runs.
+
+    @see MemoryUsage
+*/
+class JUCE_API  MemoryUsageComponent  : public Component,
+                                        private Timer
+{
+public:
+    /** Creates the component, which will refresh itself at the given rate. */
+    MemoryUsageComponent (int refreshIntervalMilliseconds = 500);
+
+    /** Destructor. */
+    ~MemoryUsageComponent();
+
+    /** Returns the height that the component needs to show all the categories. */
+    int getIdealHeight() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+
+private:
+    //==============================================================================
+    Array<MemoryUsage::Entry> entries;
+    int64 totalBytes = 0;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryUsageComponent)
+};
+
+} // namespace juce
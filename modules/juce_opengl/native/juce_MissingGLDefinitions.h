@@ -56,6 +56,27 @@ enum MissingOpenGLDefinitions
     GL_RGBA32F                      = 0x8814,
    #endif
 
+   #ifndef GL_PROGRAM_BINARY_LENGTH
+    GL_PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257,
+    GL_PROGRAM_BINARY_LENGTH        = 0x8741,
+    GL_NUM_PROGRAM_BINARY_FORMATS   = 0x87fe,
+   #endif
+
+   #ifndef GL_PIXEL_PACK_BUFFER
+    GL_PIXEL_PACK_BUFFER            = 0x88eb,
+    GL_STREAM_READ                  = 0x88e1,
+   #endif
+
+   #ifndef GL_MAP_READ_BIT
+    GL_MAP_READ_BIT                 = 0x0001,
+   #endif
+
+   #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    GL_SYNC_GPU_COMMANDS_COMPLETE   = 0x9117,
+    GL_ALREADY_SIGNALED             = 0x911a,
+    GL_CONDITION_SATISFIED          = 0x911c,
+   #endif
+
    #ifndef GL_COLOR_ATTACHMENT0
     GL_COLOR_ATTACHMENT0            = 0x8CE0,
    #endif
@@ -92,6 +113,14 @@ enum MissingOpenGLDefinitions
     GL_MULTISAMPLE                  = 0x809D,
    #endif
 
+   #ifndef GL_INCR_WRAP
+    GL_INCR_WRAP                    = 0x8507,
+   #endif
+
+   #ifndef GL_DECR_WRAP
+    GL_DECR_WRAP                    = 0x8508,
+   #endif
+
    #if JUCE_WINDOWS && ! defined (GL_TEXTURE0)
     GL_OPERAND0_RGB                 = 0x8590,
     GL_OPERAND1_RGB                 = 0x8591,
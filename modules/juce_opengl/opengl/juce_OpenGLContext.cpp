@@ -66,28 +66,207 @@ private:
 
 #endif
 
+//==============================================================================
+// A list of drawing operations that were recorded by a DisplayListRecorder on the
+// message thread, which can be replayed into a GL context on the render thread.
+struct DisplayList  : public ReferenceCountedObject
+{
+    typedef ReferenceCountedObjectPtr<DisplayList> Ptr;
+    typedef std::function<void (LowLevelGraphicsContext&)> Command;
+
+    void replay (LowLevelGraphicsContext& target) const
+    {
+        for (auto& c : commands)
+            c (target);
+    }
+
+    Array<Command> commands;
+    RectangleList<int> area;  // the region that was repainted, in frame-buffer pixels
+};
+
+//==============================================================================
+// Records everything that's drawn into a DisplayList. The clip region has to be tracked
+// as well, because components use it to decide what to paint, but it's only tracked
+// approximately: it can be bigger than the real clip, which just means that some things
+// get recorded that the real clip will then throw away when the list is replayed.
+class DisplayListRecorder  : public LowLevelGraphicsContext
+{
+public:
+    DisplayListRecorder (DisplayList& listToRecordInto, Rectangle<int> deviceBounds)
+        : list (listToRecordInto)
+    {
+        stack.add (new State())->clip = deviceBounds;
+    }
+
+    bool isVectorDevice() const override                    { return false; }
+
+    void setOrigin (Point<int> o) override                  { getState().transform.setOrigin (o); record ([=] (LowLevelGraphicsContext& g) { g.setOrigin (o); }); }
+    void addTransform (const AffineTransform& t) override   { getState().transform.addTransform (t); record ([=] (LowLevelGraphicsContext& g) { g.addTransform (t); }); }
+    float getPhysicalPixelScaleFactor() override            { return getState().transform.getPhysicalPixelScaleFactor(); }
+
+    bool clipToRectangle (const Rectangle<int>& r) override
+    {
+        getState().clip.clipTo (toDeviceSpace (r));
+        record ([=] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+        return ! getState().clip.isEmpty();
+    }
+
+    bool clipToRectangleList (const RectangleList<int>& rects) override
+    {
+        auto& s = getState();
+
+        if (s.transform.isOnlyTranslated)
+        {
+            RectangleList<int> deviceRects (rects);
+            deviceRects.offsetAll (s.transform.offset);
+            s.clip.clipTo (deviceRects);
+        }
+        else
+        {
+            s.clip.clipTo (toDeviceSpace (rects.getBounds()));
+        }
+
+        record ([=] (LowLevelGraphicsContext& g) { g.clipToRectangleList (rects); });
+        return ! s.clip.isEmpty();
+    }
+
+    void excludeClipRectangle (const Rectangle<int>& r) override
+    {
+        // with a more complex transform, the clip is just left bigger than it should be
+        auto& s = getState();
+
+        if (s.transform.isOnlyTranslated)
+            s.clip.subtract (s.transform.translated (r));
+
+        record ([=] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+    }
+
+    void clipToPath (const Path& path, const AffineTransform& t) override
+    {
+        getState().clip.clipTo (path.getBoundsTransformed (getState().transform.getTransformWith (t)).getSmallestIntegerContainer());
+        record ([=] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+    }
+
+    void clipToImageAlpha (const Image& image, const AffineTransform& t) override
+    {
+        getState().clip.clipTo (image.getBounds().toFloat().transformedBy (getState().transform.getTransformWith (t)).getSmallestIntegerContainer());
+        record ([=] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (image, t); });
+    }
+
+    bool clipRegionIntersects (const Rectangle<int>& r) override     { return getState().clip.intersectsRectangle (toDeviceSpace (r)); }
+    bool isClipEmpty() const override                               { return getState().clip.isEmpty(); }
+
+    Rectangle<int> getClipBounds() const override
+    {
+        return getState().transform.deviceSpaceToUserSpace (getState().clip.getBounds());
+    }
+
+    void saveState() override       { pushState();       record ([] (LowLevelGraphicsContext& g) { g.saveState(); }); }
+    void restoreState() override    { popState();        record ([] (LowLevelGraphicsContext& g) { g.restoreState(); }); }
+
+    void beginTransparencyLayer (float opacity) override    { pushState();       record ([=] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); }); }
+    void endTransparencyLayer() override                    { popState();        record ([] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); }); }
+
+    void setFill (const FillType& fill) override                                { record ([=] (LowLevelGraphicsContext& g) { g.setFill (fill); }); }
+    void setOpacity (float opacity) override                                    { record ([=] (LowLevelGraphicsContext& g) { g.setOpacity (opacity); }); }
+    void setInterpolationQuality (Graphics::ResamplingQuality quality) override { record ([=] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); }); }
+
+    void fillRect (const Rectangle<int>& r, bool replace) override      { record ([=] (LowLevelGraphicsContext& g) { g.fillRect (r, replace); }); }
+    void fillRect (const Rectangle<float>& r) override                  { record ([=] (LowLevelGraphicsContext& g) { g.fillRect (r); }); }
+    void fillRectList (const RectangleList<float>& rects) override      { record ([=] (LowLevelGraphicsContext& g) { g.fillRectList (rects); }); }
+    void fillPath (const Path& path, const AffineTransform& t) override { record ([=] (LowLevelGraphicsContext& g) { g.fillPath (path, t); }); }
+    void fillPreparedPath (const PreparedPath& path, const AffineTransform& t) override { record ([=] (LowLevelGraphicsContext& g) { g.fillPreparedPath (path, t); }); }
+    void drawImage (const Image& image, const AffineTransform& t) override  { record ([=] (LowLevelGraphicsContext& g) { g.drawImage (image, t); }); }
+    void drawLine (const Line<float>& line) override                    { record ([=] (LowLevelGraphicsContext& g) { g.drawLine (line); }); }
+
+    void setFont (const Font& f) override           { getState().font = f; record ([=] (LowLevelGraphicsContext& g) { g.setFont (f); }); }
+    const Font& getFont() override                  { return getState().font; }
+
+    void drawGlyph (int glyphNumber, const AffineTransform& t) override  { record ([=] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); }); }
+
+private:
+    struct State
+    {
+        RenderingHelpers::TranslationOrTransform transform { {} };
+        RectangleList<int> clip;
+        Font font;
+    };
+
+    DisplayList& list;
+    OwnedArray<State> stack;  // the last one is the current state
+
+    void record (DisplayList::Command&& command)
+    {
+        list.commands.add (std::move (command));
+    }
+
+    State& getState() const noexcept    { return *stack.getLast(); }
+
+    void pushState()
+    {
+        stack.add (new State (getState()));
+    }
+
+    void popState()
+    {
+        if (stack.size() > 1)
+            stack.removeLast();
+    }
+
+    Rectangle<int> toDeviceSpace (const Rectangle<int>& r) const noexcept
+    {
+        auto& transform = getState().transform;
+
+        return transform.isOnlyTranslated ? transform.translated (r)
+                                          : transform.transformed (r.toFloat()).getSmallestIntegerContainer();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (DisplayListRecorder)
+};
+
 //==============================================================================
 class OpenGLContext::CachedImage  : public CachedComponentImage,
-                                    private ThreadPoolJob
+                                    private ThreadPoolJob,
+                                    private AsyncUpdater
 {
 public:
     CachedImage (OpenGLContext& c, Component& comp,
                  const OpenGLPixelFormat& pixFormat, void* contextToShare)
         : ThreadPoolJob ("OpenGL Rendering"),
-          context (c), component (comp)
+          context (c), component (comp),
+          renderLock (c.sharedResourceGroup != nullptr ? c.sharedResourceGroup->renderLock : ownRenderLock)
     {
+        // The group's other contexts mustn't be in use while a new one is set up to share with them
+        const ScopedLock sl (renderLock);
+
+        if (contextToShare == nullptr && c.sharedResourceGroup != nullptr)
+            contextToShare = c.sharedResourceGroup->getContextToShareWith();
+
         nativeContext = new NativeContext (component, pixFormat, contextToShare,
                                            c.useMultisampling, c.versionRequired);
 
         if (nativeContext->createdOk())
+        {
             context.nativeContext = nativeContext;
+
+            if (c.sharedResourceGroup != nullptr)
+                c.sharedResourceGroup->contexts.add (&context);
+        }
         else
+        {
             nativeContext = nullptr;
+        }
     }
 
     ~CachedImage()
     {
         stop();
+
+        if (context.sharedResourceGroup != nullptr)
+        {
+            const ScopedLock sl (renderLock);
+            context.sharedResourceGroup->contexts.removeFirstMatchingValue (&context);
+        }
     }
 
     //==============================================================================
@@ -120,6 +299,7 @@ public:
             renderThread = nullptr;
         }
 
+        cancelPendingUpdate();
         hasInitialised = false;
     }
 
@@ -147,6 +327,13 @@ public:
 
     bool invalidateAll() override
     {
+        if (context.retainedComponentPainting)
+        {
+            needsFullRepaint = 1;
+            triggerAsyncUpdate();
+            return false;
+        }
+
         validArea.clear();
         triggerRepaint();
         return false;
@@ -154,6 +341,13 @@ public:
 
     bool invalidate (const Rectangle<int>& area) override
     {
+        if (context.retainedComponentPainting)
+        {
+            invalidArea.add (area * scale);
+            triggerAsyncUpdate();
+            return false;
+        }
+
         validArea.subtract (area * scale);
         triggerRepaint();
         return false;
@@ -210,10 +404,11 @@ public:
 
     bool renderFrame()
     {
+        JUCE_TRACE_ZONE ("OpenGLContext frame");
         MessageManager::Lock::ScopedTryLockType mmLock (messageManagerLock, false);
         const bool isUpdating = needsUpdate.compareAndSetBool (0, 1);
 
-        if (context.renderComponents && isUpdating)
+        if (context.renderComponents && isUpdating && ! context.retainedComponentPainting)
         {
             // This avoids hogging the message thread when doing intensive rendering.
             if (lastMMLockReleaseTime + 1 >= Time::getMillisecondCounter())
@@ -233,6 +428,8 @@ public:
             updateViewportSize (false);
         }
 
+        const ScopedLock sl (renderLock);
+
         if (! context.makeActive())
             return false;
 
@@ -241,6 +438,7 @@ public:
         JUCE_CHECK_OPENGL_ERROR
 
         doWorkWhileWaitingForLock (true);
+        AsyncPixelReader::deliverFinishedReads (context);
 
         if (context.renderer != nullptr)
         {
@@ -254,7 +452,12 @@ public:
 
         if (context.renderComponents)
         {
-            if (isUpdating)
+            if (context.retainedComponentPainting)
+            {
+                if (isUpdating)
+                    replayDisplayList();
+            }
+            else if (isUpdating)
             {
                 paintComponent();
 
@@ -347,6 +550,91 @@ public:
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    // In retained mode, this records the invalid region on the message thread..
+    void handleAsyncUpdate() override
+    {
+        auto oldViewportArea = viewportArea;
+        auto oldScale = scale;
+        updateViewportSize (false);
+
+        if (needsFullRepaint.compareAndSetBool (0, 1) || viewportArea != oldViewportArea || scale != oldScale)
+            invalidArea = viewportArea;
+
+        {
+            // if the GL thread hasn't used the last list yet, this one replaces it
+            const ScopedLock sl (displayListLock);
+
+            if (pendingDisplayList != nullptr)
+                for (auto& r : pendingDisplayList->area)
+                    invalidArea.add (r);
+        }
+
+        invalidArea.clipTo (viewportArea);
+
+        if (invalidArea.isEmpty())
+            return;
+
+        DisplayList::Ptr list (new DisplayList());
+        list->area.swapWith (invalidArea);
+
+        {
+            DisplayListRecorder recorder (*list, viewportArea);
+            recorder.clipToRectangleList (list->area);
+            recorder.addTransform (AffineTransform::scale ((float) scale));
+
+            paintOwner (recorder);
+        }
+
+        {
+            const ScopedLock sl (displayListLock);
+            pendingDisplayList = list;
+        }
+
+        triggerRepaint();
+    }
+
+    // ..and this plays it back into the cached image on the GL thread.
+    void replayDisplayList()
+    {
+        jassert (get (component) == this);
+
+        DisplayList::Ptr list;
+
+        {
+            const ScopedLock sl (displayListLock);
+            std::swap (list, pendingDisplayList);
+        }
+
+        if (! ensureFrameBufferSize())
+            return;
+
+        if (validArea.isEmpty() && (list == nullptr || ! list->area.containsRectangle (viewportArea)))
+        {
+            // the frame buffer has been re-created, so the whole thing needs painting again
+            needsFullRepaint = 1;
+            triggerAsyncUpdate();
+            return;
+        }
+
+        validArea = viewportArea;
+
+        if (list != nullptr)
+        {
+            clearRegionInFrameBuffer (list->area);
+
+            {
+                ScopedPointer<LowLevelGraphicsContext> g (createOpenGLGraphicsContext (context, cachedImageFrameBuffer));
+                list->replay (*g);
+                JUCE_CHECK_OPENGL_ERROR
+            }
+
+            if (! context.isActive())
+                context.makeActive();
+        }
+
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
     void drawComponentBuffer()
     {
        #if ! JUCE_ANDROID
@@ -437,8 +725,11 @@ public:
             } while (! mmLock.retryLock ());
         }
 
-        initialiseOnThread();
-        hasInitialised = true;
+        {
+            const ScopedLock sl (renderLock);
+            initialiseOnThread();
+            hasInitialised = true;
+        }
 
         while (! shouldExit())
         {
@@ -460,9 +751,13 @@ public:
         }
 
         hasInitialised = false;
-        context.makeActive();
-        shutdownOnThread();
-        OpenGLContext::deactivateCurrentContext();
+
+        {
+            const ScopedLock sl (renderLock);
+            context.makeActive();
+            shutdownOnThread();
+            OpenGLContext::deactivateCurrentContext();
+        }
 
         return ThreadPoolJob::jobHasFinished;
     }
@@ -519,6 +814,15 @@ public:
 
         associatedObjectNames.clear();
         associatedObjects.clear();
+
+        if (auto* group = context.sharedResourceGroup.get())
+        {
+            // the group's objects may refer to this context, so they have to go too
+            group->associatedObjectNames.clear();
+            group->associatedObjects.clear();
+            group->contexts.removeFirstMatchingValue (&context);
+        }
+
         cachedImageFrameBuffer.release();
         nativeContext->shutdownOnRenderThread();
     }
@@ -614,6 +918,8 @@ public:
 
     StringArray associatedObjectNames;
     ReferenceCountedArray<ReferenceCountedObject> associatedObjects;
+    CriticalSection ownRenderLock;
+    CriticalSection& renderLock;
 
     WaitableEvent canPaintNowFlag, finishedPaintingFlag, repaintEvent;
    #if JUCE_OPENGL_ES
@@ -622,13 +928,17 @@ public:
     bool shadersAvailable = false;
    #endif
     bool hasInitialised = false;
-    Atomic<int> needsUpdate { 1 }, destroying;
+    Atomic<int> needsUpdate { 1 }, destroying, needsFullRepaint { 1 };
     uint32 lastMMLockReleaseTime = 0;
 
     ScopedPointer<ThreadPool> renderThread;
     ReferenceCountedArray<OpenGLContext::AsyncWorker, CriticalSection> workQueue;
     MessageManager::Lock messageManagerLock;
 
+    RectangleList<int> invalidArea;  // only used by the message thread
+    DisplayList::Ptr pendingDisplayList;
+    CriticalSection displayListLock;
+
    #if JUCE_IOS
     iOSBackgroundProcessCheck backgroundProcessCheck;
    #endif
@@ -821,6 +1131,15 @@ void OpenGLContext::setComponentPaintingEnabled (bool shouldPaintComponent) noex
     renderComponents = shouldPaintComponent;
 }
 
+void OpenGLContext::setRetainedComponentPaintingEnabled (bool shouldRetainPainting) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    retainedComponentPainting = shouldRetainPainting;
+}
+
 void OpenGLContext::setContinuousRepainting (bool shouldContinuouslyRepaint) noexcept
 {
     continuousRepaint = shouldContinuouslyRepaint;
@@ -850,6 +1169,45 @@ void OpenGLContext::setNativeSharedContext (void* nativeContextToShareWith) noex
     contextToShareWith = nativeContextToShareWith;
 }
 
+void OpenGLContext::setSharedResourceGroup (SharedResourceGroup* groupToJoin) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    sharedResourceGroup = groupToJoin;
+}
+
+bool OpenGLContext::sharesResourcesWith (const OpenGLContext* otherContext) const noexcept
+{
+    if (otherContext == this)
+        return true;
+
+    if (sharedResourceGroup == nullptr)
+        return false;
+
+    const ScopedLock sl (sharedResourceGroup->renderLock);
+    return sharedResourceGroup->contexts.contains (this)
+            && sharedResourceGroup->contexts.contains (otherContext);
+}
+
+OpenGLContext::SharedResourceGroup::SharedResourceGroup() {}
+
+OpenGLContext::SharedResourceGroup::~SharedResourceGroup()
+{
+    // all the contexts must have been detached before deleting their group!
+    jassert (contexts.isEmpty());
+}
+
+void* OpenGLContext::SharedResourceGroup::getContextToShareWith() const noexcept
+{
+    for (auto* c : contexts)
+        if (auto* raw = c->getRawContext())
+            return raw;
+
+    return nullptr;
+}
+
 void OpenGLContext::setMultisamplingEnabled (bool b) noexcept
 {
     // This method must not be called when the context has already been attached!
@@ -859,6 +1217,16 @@ void OpenGLContext::setMultisamplingEnabled (bool b) noexcept
     useMultisampling = b;
 }
 
+void OpenGLContext::setGPUPathRenderingEnabled (bool b) noexcept
+{
+    gpuPathRendering = b;
+}
+
+bool OpenGLContext::isGPUPathRenderingEnabled() const noexcept
+{
+    return gpuPathRendering && openGLPixelFormat.stencilBufferBits > 0;
+}
+
 void OpenGLContext::setOpenGLVersionRequired (OpenGLVersion v) noexcept
 {
     versionRequired = v;
@@ -992,6 +1360,13 @@ ReferenceCountedObject* OpenGLContext::getAssociatedObject (const char* name) co
     jassert (c != nullptr && nativeContext != nullptr);
     jassert (getCurrentContext() != nullptr);
 
+    if (auto* group = sharedResourceGroup.get())
+    {
+        const ScopedLock sl (group->renderLock);
+        const int index = group->associatedObjectNames.indexOf (name);
+        return index >= 0 ? group->associatedObjects.getUnchecked (index) : nullptr;
+    }
+
     const int index = c->associatedObjectNames.indexOf (name);
     return index >= 0 ? c->associatedObjects.getUnchecked (index) : nullptr;
 }
@@ -1006,24 +1381,30 @@ void OpenGLContext::setAssociatedObject (const char* name, ReferenceCountedObjec
         jassert (nativeContext != nullptr);
         jassert (getCurrentContext() != nullptr);
 
-        const int index = c->associatedObjectNames.indexOf (name);
+        auto* group = sharedResourceGroup.get();
+        const ScopedLock sl (group != nullptr ? group->renderLock : c->ownRenderLock);
+
+        auto& names   = group != nullptr ? group->associatedObjectNames : c->associatedObjectNames;
+        auto& objects = group != nullptr ? group->associatedObjects     : c->associatedObjects;
+
+        const int index = names.indexOf (name);
 
         if (index >= 0)
         {
             if (newObject != nullptr)
             {
-                c->associatedObjects.set (index, newObject);
+                objects.set (index, newObject);
             }
             else
             {
-                c->associatedObjectNames.remove (index);
-                c->associatedObjects.remove (index);
+                names.remove (index);
+                objects.remove (index);
             }
         }
         else if (newObject != nullptr)
         {
-            c->associatedObjectNames.add (name);
-            c->associatedObjects.add (newObject);
+            names.add (name);
+            objects.add (newObject);
         }
     }
 }
@@ -1031,6 +1412,9 @@ void OpenGLContext::setAssociatedObject (const char* name, ReferenceCountedObjec
 void OpenGLContext::setImageCacheSize (size_t newSize) noexcept     { imageCacheMaxSize = newSize; }
 size_t OpenGLContext::getImageCacheSize() const noexcept            { return imageCacheMaxSize; }
 
+void OpenGLContext::setShaderCacheDirectory (const File& directory) { shaderCacheDirectory = directory; }
+File OpenGLContext::getShaderCacheDirectory() const                 { return shaderCacheDirectory; }
+
 void OpenGLContext::execute (OpenGLContext::AsyncWorker::Ptr workerToUse, bool shouldBlock)
 {
     if (auto* c = getCachedImage())
@@ -121,11 +121,100 @@ public:
     */
     void setNativeSharedContext (void* nativeContextToShareWith) noexcept;
 
+    //==============================================================================
+    /**
+        A group of contexts that share their GL objects with each other.
+
+        If several contexts are going to be open at once, e.g. in a plugin that may have
+        several editor windows, putting them all in the same group means that textures,
+        shader programs and the 2D renderer's image and glyph caches are only created
+        once, rather than once per context.
+
+        The native contexts in a group are created as sharing contexts, so an OpenGLTexture
+        or OpenGLShaderProgram that was created by one of them can be used by the others,
+        and getAssociatedObject() and setAssociatedObject() use a single set of objects
+        for the whole group. To make this safe, only one context in the group renders
+        at a time.
+
+        Objects that are stored with setAssociatedObject() are released when any context
+        leaves the group, because they may refer to the context that created them, so
+        you shouldn't keep pointers to them between render callbacks.
+
+        E.g.
+        @code
+        // (e.g. in your AudioProcessor, so that all its editors can get at it)
+        OpenGLContext::SharedResourceGroup::Ptr sharedGLResources = new OpenGLContext::SharedResourceGroup();
+
+        openGLContext.setSharedResourceGroup (processor.sharedGLResources);
+        openGLContext.attachTo (*this);
+        @endcode
+
+        @see setSharedResourceGroup
+    */
+    class JUCE_API  SharedResourceGroup  : public ReferenceCountedObject
+    {
+    public:
+        SharedResourceGroup();
+
+        /** Destructor. The group mustn't be deleted while any contexts are still using it. */
+        ~SharedResourceGroup();
+
+        typedef ReferenceCountedObjectPtr<SharedResourceGroup> Ptr;
+
+    private:
+        friend class OpenGLContext;
+        CriticalSection renderLock;
+        Array<const OpenGLContext*> contexts;
+        StringArray associatedObjectNames;
+        ReferenceCountedArray<ReferenceCountedObject> associatedObjects;
+
+        void* getContextToShareWith() const noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedResourceGroup)
+    };
+
+    /** Makes this context share its GL objects with other contexts in a group.
+        Pass nullptr to stop sharing. The context keeps a reference to the group.
+        Note: This must be called BEFORE attaching your context to a target component!
+        @see SharedResourceGroup
+    */
+    void setSharedResourceGroup (SharedResourceGroup* groupToJoin) noexcept;
+
+    /** Returns the group that was set with setSharedResourceGroup(), or nullptr. */
+    SharedResourceGroup* getSharedResourceGroup() const noexcept        { return sharedResourceGroup.get(); }
+
+    /** Returns true if GL objects created by another context can be used by this one,
+        i.e. if it's the same context, or they're both attached and in the same group.
+        The other context doesn't have to still exist, as it's only used as an ID.
+    */
+    bool sharesResourcesWith (const OpenGLContext* otherContext) const noexcept;
+
     /** Enables multisampling on platforms where this is implemented.
         If enabling this, you must call this method before attachTo().
     */
     void setMultisamplingEnabled (bool) noexcept;
 
+    /** Makes the 2D renderer fill paths using the GPU's stencil buffer rather than
+        rasterising them on the CPU.
+
+        This suits paths that are large or redrawn every frame, like waveform and spectrum
+        displays, and the triangles for recently-used paths are kept on the GPU so that
+        a path which doesn't change between frames isn't tessellated again.
+
+        It only applies to an OpenGLGraphicsContext that draws straight into this
+        context's own framebuffer (e.g. one made with createOpenGLGraphicsContext() in
+        your renderOpenGL() callback), and it needs a pixel format with some stencil bits
+        (see setPixelFormat()). The edges of paths filled this way are only antialiased
+        when multisampling is enabled. Component painting, which goes through a cached
+        image, always uses the CPU rasteriser.
+    */
+    void setGPUPathRenderingEnabled (bool) noexcept;
+
+    /** Returns true if setGPUPathRenderingEnabled() has been turned on and the pixel
+        format has a stencil buffer.
+    */
+    bool isGPUPathRenderingEnabled() const noexcept;
+
     /** Returns true if shaders can be used in this context. */
     bool areShadersAvailable() const;
 
@@ -156,6 +245,29 @@ public:
     */
     void setComponentPaintingEnabled (bool shouldPaintComponent) noexcept;
 
+    /** Makes the component painting happen on the message thread, so that the GL
+        thread never has to wait for the MessageManager lock.
+
+        Normally, when your component needs repainting, the GL thread has to lock the
+        message thread while it calls your paint() methods, which means that a slow paint
+        routine will hold up both threads, and a busy message thread will delay the
+        next frame. When this is enabled, the paint() calls happen on the message
+        thread instead, and they just record a list of drawing operations, which the
+        GL thread then replays into its cached image without taking any locks.
+
+        Because the drawing is replayed later on another thread, your paint routines
+        mustn't draw any Images whose pixels they'll change afterwards (e.g. a
+        buffer that's updated in a timer callback), or the GL thread could see them
+        half-written. It's fine to draw a new Image object each time.
+
+        This is disabled by default, and has no effect unless component painting is
+        enabled.
+
+        Note: This must be called BEFORE attaching your context to a target component!
+        @see setComponentPaintingEnabled
+    */
+    void setRetainedComponentPaintingEnabled (bool shouldRetainPainting) noexcept;
+
     /** Enables or disables continuous repainting.
         If set to true, the context will run a loop, re-rendering itself without waiting
         for triggerRepaint() to be called, at a frequency determined by the swap interval
@@ -308,6 +420,21 @@ public:
     /** Returns the amount of GPU memory that the internal cache for Images is allowed to use. */
     size_t getImageCacheSize() const noexcept;
 
+    /** Sets a folder in which linked shader programs can be stored, so that the next
+        time they're needed they can be loaded without being compiled again.
+
+        The cache is used by OpenGLShaderProgram::addShadersAndLink(), which is how the
+        context's own 2D renderer builds its shaders. Program binaries only work with the
+        driver that created them, so if a cached one won't load, the program is just
+        compiled as normal and the cache is updated.
+
+        By default no cache is used. Pass File() to turn it off again.
+    */
+    void setShaderCacheDirectory (const File& directory);
+
+    /** Returns the folder that was set by setShaderCacheDirectory(). */
+    File getShaderCacheDirectory() const;
+
     //==============================================================================
    #ifndef DOXYGEN
     class NativeContext;
@@ -326,7 +453,10 @@ private:
     void* contextToShareWith = nullptr;
     OpenGLVersion versionRequired = defaultGLVersion;
     size_t imageCacheMaxSize = 8 * 1024 * 1024;
+    File shaderCacheDirectory;
+    SharedResourceGroup::Ptr sharedResourceGroup;
     bool renderComponents = true, useMultisampling = false, continuousRepaint = false, overrideCanAttach = false;
+    bool gpuPathRendering = false, retainedComponentPainting = false;
     TextureMagnificationFilter texMagFilter = linear;
 
     //==============================================================================
@@ -328,6 +328,242 @@ bool OpenGLFrameBuffer::readPixels (PixelARGB* target, const Rectangle<int>& are
     return true;
 }
 
+//==============================================================================
+#if JUCE_WINDOWS
+ #define JUCE_GL_SYNC_CALLTYPE __stdcall
+#else
+ #define JUCE_GL_SYNC_CALLTYPE
+#endif
+
+// Reads pixels into pixel-pack buffers, and hands them over once a fence shows that
+// the GPU has finished writing them. Buffer mapping and fences are only in GL 3, ES 3 and
+// ARB_sync, so they're looked up when needed rather than being in OpenGLExtensionFunctions.
+struct AsyncPixelReader  : public ReferenceCountedObject
+{
+    AsyncPixelReader (OpenGLContext& c)  : context (c)
+    {
+        fenceSync      = (FenceSyncType)      OpenGLHelpers::getExtensionFunction ("glFenceSync");
+        clientWaitSync = (ClientWaitSyncType) OpenGLHelpers::getExtensionFunction ("glClientWaitSync");
+        deleteSync     = (DeleteSyncType)     OpenGLHelpers::getExtensionFunction ("glDeleteSync");
+        mapBufferRange = (MapBufferRangeType) OpenGLHelpers::getExtensionFunction ("glMapBufferRange");
+        unmapBuffer    = (UnmapBufferType)    OpenGLHelpers::getExtensionFunction ("glUnmapBuffer");
+    }
+
+    ~AsyncPixelReader()
+    {
+        for (auto* r : pendingReads)
+        {
+            deleteSync (r->fence);
+            deleteBuffer (r->buffer);
+        }
+
+        for (auto& b : spareBuffers)
+            deleteBuffer (b);
+    }
+
+    static AsyncPixelReader* get (OpenGLContext& c)
+    {
+        auto* reader = static_cast<AsyncPixelReader*> (c.getAssociatedObject (getID()));
+
+        if (reader == nullptr)
+        {
+            reader = new AsyncPixelReader (c);
+            c.setAssociatedObject (getID(), reader);
+        }
+
+        return reader;
+    }
+
+    // Called by the context at the start of each frame
+    static void deliverFinishedReads (OpenGLContext& c)
+    {
+        if (auto* reader = static_cast<AsyncPixelReader*> (c.getAssociatedObject (getID())))
+            reader->deliverFinishedReads();
+    }
+
+    bool isAvailable() const noexcept
+    {
+        return fenceSync != nullptr && clientWaitSync != nullptr && deleteSync != nullptr
+                && mapBufferRange != nullptr && unmapBuffer != nullptr;
+    }
+
+    // the framebuffer must already be bound
+    void startRead (const Rectangle<int>& area, OpenGLFrameBuffer::AsyncReadCallback&& callback)
+    {
+        auto* r = new PendingRead();
+        r->width = area.getWidth();
+        r->height = area.getHeight();
+        r->buffer = getBuffer ((size_t) (r->width * r->height) * sizeof (PixelARGB));
+        r->callback = std::move (callback);
+
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, r->buffer.id);
+        glPixelStorei (GL_PACK_ALIGNMENT, 4);
+        glReadPixels (area.getX(), area.getY(), r->width, r->height, JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, nullptr);
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+
+        r->fence = fenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        pendingReads.add (r);
+
+        context.triggerRepaint();
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
+private:
+    typedef void* (JUCE_GL_SYNC_CALLTYPE *FenceSyncType) (GLenum, GLbitfield);
+    typedef GLenum (JUCE_GL_SYNC_CALLTYPE *ClientWaitSyncType) (void*, GLbitfield, uint64);
+    typedef void (JUCE_GL_SYNC_CALLTYPE *DeleteSyncType) (void*);
+    typedef void* (JUCE_GL_SYNC_CALLTYPE *MapBufferRangeType) (GLenum, GLintptr, GLsizeiptr, GLbitfield);
+    typedef GLboolean (JUCE_GL_SYNC_CALLTYPE *UnmapBufferType) (GLenum);
+
+    struct Buffer
+    {
+        GLuint id;
+        size_t size;
+    };
+
+    struct PendingRead
+    {
+        Buffer buffer;
+        void* fence;
+        int width, height;
+        OpenGLFrameBuffer::AsyncReadCallback callback;
+    };
+
+    OpenGLContext& context;
+    OwnedArray<PendingRead> pendingReads;
+    Array<Buffer> spareBuffers;
+
+    FenceSyncType fenceSync = nullptr;
+    ClientWaitSyncType clientWaitSync = nullptr;
+    DeleteSyncType deleteSync = nullptr;
+    MapBufferRangeType mapBufferRange = nullptr;
+    UnmapBufferType unmapBuffer = nullptr;
+
+    // Two spare buffers are enough for one read per frame, e.g. when capturing video
+    enum { maxSpareBuffers = 2 };
+
+    static const char* getID() noexcept    { return "AsyncPixelReader"; }
+
+    Buffer getBuffer (size_t numBytes)
+    {
+        for (int i = 0; i < spareBuffers.size(); ++i)
+            if (spareBuffers.getReference (i).size >= numBytes)
+                return spareBuffers.removeAndReturn (i);
+
+        Buffer b = { 0, numBytes };
+        context.extensions.glGenBuffers (1, &b.id);
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, b.id);
+        context.extensions.glBufferData (GL_PIXEL_PACK_BUFFER, (GLsizeiptr) numBytes, nullptr, GL_STREAM_READ);
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+        return b;
+    }
+
+    void releaseBuffer (const Buffer& b)
+    {
+        if (spareBuffers.size() < maxSpareBuffers)
+            spareBuffers.add (b);
+        else
+            deleteBuffer (b);
+    }
+
+    void deleteBuffer (const Buffer& b)
+    {
+        context.extensions.glDeleteBuffers (1, &b.id);
+    }
+
+    void deliverFinishedReads()
+    {
+        // the fences are signalled in the order they were added
+        while (! pendingReads.isEmpty())
+        {
+            auto* r = pendingReads.getFirst();
+            auto status = clientWaitSync (r->fence, 0, 0);
+
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {
+                // come back next frame
+                context.triggerRepaint();
+                return;
+            }
+
+            deleteSync (r->fence);
+
+            auto image = copyToImage (*r);
+            auto callback = std::move (r->callback);
+
+            releaseBuffer (r->buffer);
+            pendingReads.remove (0);
+
+            callback (image);
+        }
+    }
+
+    Image copyToImage (const PendingRead& r)
+    {
+        Image image;
+        auto rowSize = sizeof (PixelARGB) * (size_t) r.width;
+
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, r.buffer.id);
+
+        if (auto* src = static_cast<const uint8*> (mapBufferRange (GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) (rowSize * (size_t) r.height), GL_MAP_READ_BIT)))
+        {
+            image = Image (Image::ARGB, r.width, r.height, false);
+            Image::BitmapData bitmap (image, Image::BitmapData::writeOnly);
+
+            // GL rows go from the bottom up
+            for (int y = 0; y < r.height; ++y)
+                memcpy (bitmap.getLinePointer (r.height - 1 - y), src + rowSize * (size_t) y, rowSize);
+
+            unmapBuffer (GL_PIXEL_PACK_BUFFER);
+        }
+
+        context.extensions.glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+        JUCE_CHECK_OPENGL_ERROR
+        return image;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (AsyncPixelReader)
+};
+
+#undef JUCE_GL_SYNC_CALLTYPE
+
+bool OpenGLFrameBuffer::readPixelsAsync (const Rectangle<int>& area, AsyncReadCallback callback)
+{
+    jassert (callback != nullptr);
+
+    if (pimpl == nullptr)
+        return false;
+
+    auto* reader = AsyncPixelReader::get (pimpl->context);
+
+    if (! reader->isAvailable())
+    {
+        Image image (Image::ARGB, area.getWidth(), area.getHeight(), false);
+
+        {
+            Image::BitmapData bitmap (image, Image::BitmapData::writeOnly);
+            HeapBlock<PixelARGB> data ((size_t) (area.getWidth() * area.getHeight()));
+
+            if (! readPixels (data, area))
+                return false;
+
+            for (int y = 0; y < area.getHeight(); ++y)
+                memcpy (bitmap.getLinePointer (area.getHeight() - 1 - y), data + area.getWidth() * y,
+                        sizeof (PixelARGB) * (size_t) area.getWidth());
+        }
+
+        callback (image);
+        return true;
+    }
+
+    if (! makeCurrentRenderingTarget())
+        return false;
+
+    reader->startRead (area, std::move (callback));
+    pimpl->unbind();
+    return true;
+}
+
 bool OpenGLFrameBuffer::writePixels (const PixelARGB* data, const Rectangle<int>& area)
 {
     OpenGLTargetSaver ts (pimpl->context);
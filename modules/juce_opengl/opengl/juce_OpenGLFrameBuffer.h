@@ -119,6 +119,33 @@ public:
     */
     bool writePixels (const PixelARGB* srcData, const Rectangle<int>& targetArea);
 
+    /** The callback that's given the result of readPixelsAsync(). */
+    typedef std::function<void (const Image&)> AsyncReadCallback;
+
+    /** Starts reading an area of pixels from the framebuffer, without waiting for the GPU.
+
+        readPixels() has to wait until the GPU has finished drawing everything before it
+        can return, which stalls the render thread. This copies the pixels into a pixel
+        buffer object instead, and the callback is given the image at the start of a
+        later frame, once the GPU has finished with it. This makes it suitable for
+        capturing video or screenshots from a context that must keep rendering smoothly.
+
+        The area uses the same bottom-left origin as readPixels(), but the image that's
+        passed to the callback is the right way up. The callback is called on the GL
+        thread, from the context that this framebuffer was created with, and if the
+        context is shut down before the data has arrived, it won't be called at all.
+
+        If the GL version doesn't support pixel buffers and fences (they need GL 3 or ES 3),
+        this falls back to reading the pixels immediately, and calls the callback before
+        returning.
+
+        To capture an OpenGLImageType image, use OpenGLImageType::getFrameBufferFrom() to
+        get its framebuffer.
+
+        @returns false if the read couldn't be started
+    */
+    bool readPixelsAsync (const Rectangle<int>& sourceArea, AsyncReadCallback callback);
+
 private:
     class Pimpl;
     friend struct ContainerDeletePolicy<Pimpl>;
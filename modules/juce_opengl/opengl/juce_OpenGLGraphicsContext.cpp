@@ -149,7 +149,8 @@ private:
 
     bool canUseContext() const noexcept
     {
-        return OpenGLContext::getCurrentContext() == &context;
+        auto* currentContext = OpenGLContext::getCurrentContext();
+        return currentContext != nullptr && currentContext->sharesResourcesWith (&context);
     }
 
     void imageDataChanged (ImagePixelData* im) override
@@ -217,6 +218,332 @@ private:
 };
 
 
+//==============================================================================
+// This list persists in the OpenGLContext, and keeps the tessellated triangles of recently-filled
+// paths in vertex buffers, so that a path which is drawn again with the same transform doesn't
+// have to be flattened and uploaded again.
+struct PathGeometryCache  : public ReferenceCountedObject
+{
+    PathGeometryCache (OpenGLContext& c) noexcept  : context (c) {}
+
+    ~PathGeometryCache()
+    {
+        if (OpenGLContext::getCurrentContext() == &context)
+            for (auto* g : geometries)
+                context.extensions.glDeleteBuffers (1, &g->buffer);
+    }
+
+    static PathGeometryCache* get (OpenGLContext& c)
+    {
+        const char cacheValueID[] = "PathGeometryCache";
+        PathGeometryCache* cache = static_cast<PathGeometryCache*> (c.getAssociatedObject (cacheValueID));
+
+        if (cache == nullptr)
+        {
+            cache = new PathGeometryCache (c);
+            c.setAssociatedObject (cacheValueID, cache);
+        }
+
+        return cache;
+    }
+
+    struct Geometry
+    {
+        Path path;
+        AffineTransform transform;
+        Rectangle<float> bounds;
+        GLuint buffer = 0;
+        GLsizei numVertices = 0;
+        uint32 lastUsed = 0;
+    };
+
+    /** Returns the vertex buffer that holds a list of triangles which, when drawn into the
+        stencil buffer with the path's winding rule, covers the inside of the transformed path.
+        The triangles are in the same coordinates as the transformed path.
+    */
+    const Geometry& getGeometryFor (const Path& path, const AffineTransform& transform)
+    {
+        auto bounds = path.getBounds();
+        ++counter;
+
+        for (auto* g : geometries)
+        {
+            if (g->bounds == bounds && g->transform == transform && g->path == path)
+            {
+                g->lastUsed = counter;
+                return *g;
+            }
+        }
+
+        Geometry* g = nullptr;
+
+        if (geometries.size() < maxNumGeometries)
+        {
+            g = geometries.add (new Geometry());
+            context.extensions.glGenBuffers (1, &g->buffer);
+        }
+        else
+        {
+            g = geometries.getFirst();
+
+            for (auto* other : geometries)
+                if (other->lastUsed < g->lastUsed)
+                    g = other;
+        }
+
+        g->path = path;
+        g->transform = transform;
+        g->bounds = bounds;
+        g->lastUsed = counter;
+
+        Array<Point<float>> triangles;
+        createTriangles (path, transform, triangles);
+        g->numVertices = (GLsizei) triangles.size();
+
+        context.extensions.glBindBuffer (GL_ARRAY_BUFFER, g->buffer);
+        context.extensions.glBufferData (GL_ARRAY_BUFFER, (GLsizeiptr) ((size_t) triangles.size() * sizeof (Point<float>)),
+                                         triangles.begin(), GL_STATIC_DRAW);
+        JUCE_CHECK_OPENGL_ERROR
+        return *g;
+    }
+
+    typedef ReferenceCountedObjectPtr<PathGeometryCache> Ptr;
+
+private:
+    enum { maxNumGeometries = 64 };
+
+    OpenGLContext& context;
+    OwnedArray<Geometry> geometries;
+    uint32 counter = 0;
+
+    // Each sub-path becomes a fan of triangles from its first point. Where the fan overlaps
+    // itself, the winding counts in the stencil buffer cancel out, so this works for any shape.
+    static void createTriangles (const Path& path, const AffineTransform& transform, Array<Point<float>>& triangles)
+    {
+        PathFlatteningIterator iter (path, transform);
+        Point<float> start;
+        int subPathIndex = -1;
+
+        while (iter.next())
+        {
+            if (iter.subPathIndex != subPathIndex)
+            {
+                subPathIndex = iter.subPathIndex;
+                start = { iter.x1, iter.y1 };
+            }
+
+            triangles.add (start);
+            triangles.add ({ iter.x1, iter.y1 });
+            triangles.add ({ iter.x2, iter.y2 });
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PathGeometryCache)
+};
+
+//==============================================================================
+// This persists in the OpenGLContext, and keeps the glyphs that have been drawn recently in
+// a single alpha texture, so that text can be drawn from the GPU without re-rendering them.
+struct GlyphAtlas  : public ReferenceCountedObject
+{
+    GlyphAtlas() {}
+
+    static GlyphAtlas* get (OpenGLContext& c)
+    {
+        const char atlasValueID[] = "GlyphAtlas";
+        GlyphAtlas* atlas = static_cast<GlyphAtlas*> (c.getAssociatedObject (atlasValueID));
+
+        if (atlas == nullptr)
+        {
+            atlas = new GlyphAtlas();
+            c.setAssociatedObject (atlasValueID, atlas);
+        }
+
+        return atlas;
+    }
+
+    enum
+    {
+        atlasSize = 1024,
+        maxGlyphSize = 128,
+        numSubPixelPositions = 4
+    };
+
+    struct Glyph
+    {
+        Rectangle<int> area;    // the glyph's pixels, relative to its origin
+        Point<int> texturePos;
+        bool isLoaded = false, isInAtlas = false;
+    };
+
+    GLuint getTextureID()
+    {
+        if (texture.getTextureID() == 0)
+        {
+            HeapBlock<uint8> blank ((size_t) (atlasSize * atlasSize), true);
+            texture.loadAlpha (blank, atlasSize, atlasSize);
+        }
+
+        return texture.getTextureID();
+    }
+
+    /** Finds a glyph, rendering it into the atlas if it's not already there. The atlas texture
+        must be bound when this is called. If there's no room left, this returns nullptr, and
+        the atlas will need to be cleared before trying again.
+    */
+    const Glyph* getGlyph (const Font& font, int glyphNumber, int subPixelPosition)
+    {
+        auto& glyph = getGlyphsFor (font).getReference (glyphNumber * numSubPixelPositions + subPixelPosition);
+
+        if (! glyph.isLoaded && ! loadGlyph (glyph, font, glyphNumber, subPixelPosition))
+            return nullptr;
+
+        return &glyph;
+    }
+
+    void clear()
+    {
+        fonts.clear();
+        lastFont = nullptr;
+        nextX = nextY = rowHeight = 0;
+    }
+
+    typedef ReferenceCountedObjectPtr<GlyphAtlas> Ptr;
+
+private:
+    struct FontGlyphs
+    {
+        Font font;
+        HashMap<int, Glyph> glyphs;
+    };
+
+    OpenGLTexture texture;
+    OwnedArray<FontGlyphs> fonts;
+    FontGlyphs* lastFont = nullptr;
+    int nextX = 0, nextY = 0, rowHeight = 0;
+
+    HashMap<int, Glyph>& getGlyphsFor (const Font& font)
+    {
+        if (lastFont == nullptr || lastFont->font != font)
+        {
+            lastFont = nullptr;
+
+            for (auto* f : fonts)
+            {
+                if (f->font == font)
+                {
+                    lastFont = f;
+                    break;
+                }
+            }
+
+            if (lastFont == nullptr)
+            {
+                lastFont = fonts.add (new FontGlyphs());
+                lastFont->font = font;
+            }
+        }
+
+        return lastFont->glyphs;
+    }
+
+    bool loadGlyph (Glyph& glyph, const Font& font, int glyphNumber, int subPixelPosition)
+    {
+        auto fontHeight = font.getHeight();
+        auto transform = AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
+                                         .translated ((float) subPixelPosition / (float) numSubPixelPositions, 0.0f);
+
+        const ScopedPointer<EdgeTable> et (font.getTypeface()->getEdgeTableForGlyph (glyphNumber, transform, fontHeight));
+
+        if (et != nullptr)
+            glyph.area = et->getMaximumBounds();
+
+        // glyphs that are blank or too big are remembered, but drawn some other way
+        if (glyph.area.isEmpty() || glyph.area.getWidth() > maxGlyphSize || glyph.area.getHeight() > maxGlyphSize)
+        {
+            glyph.isLoaded = true;
+            return true;
+        }
+
+        if (! allocate (glyph.area.getWidth(), glyph.area.getHeight(), glyph.texturePos))
+            return false;
+
+        AlphaMap alphaMap (*et);
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D (GL_TEXTURE_2D, 0, glyph.texturePos.x, glyph.texturePos.y,
+                         glyph.area.getWidth(), glyph.area.getHeight(),
+                         GL_ALPHA, GL_UNSIGNED_BYTE, alphaMap.data);
+        JUCE_CHECK_OPENGL_ERROR
+
+        glyph.isLoaded = glyph.isInAtlas = true;
+        return true;
+    }
+
+    // the glyphs are packed into rows, with a pixel between them so that they can't bleed together
+    bool allocate (int w, int h, Point<int>& pos) noexcept
+    {
+        if (nextX + w > atlasSize)
+        {
+            nextX = 0;
+            nextY += rowHeight;
+            rowHeight = 0;
+        }
+
+        if (nextY + h > atlasSize)
+            return false;
+
+        pos = { nextX, nextY };
+        nextX += w + 1;
+        rowHeight = jmax (rowHeight, h + 1);
+        return true;
+    }
+
+    struct AlphaMap
+    {
+        AlphaMap (const EdgeTable& et)
+            : area (et.getMaximumBounds())
+        {
+            data.calloc ((size_t) (area.getWidth() * area.getHeight()));
+            et.iterate (*this);
+        }
+
+        inline void setEdgeTableYPos (const int y) noexcept
+        {
+            currentLine = data + (y - area.getY()) * area.getWidth() - area.getX();
+        }
+
+        inline void handleEdgeTablePixel (const int x, const int alphaLevel) const noexcept
+        {
+            currentLine[x] = (uint8) alphaLevel;
+        }
+
+        inline void handleEdgeTablePixelFull (const int x) const noexcept
+        {
+            currentLine[x] = 255;
+        }
+
+        inline void handleEdgeTableLine (int x, int width, const int alphaLevel) const noexcept
+        {
+            memset (currentLine + x, (uint8) alphaLevel, (size_t) width);
+        }
+
+        inline void handleEdgeTableLineFull (int x, int width) const noexcept
+        {
+            memset (currentLine + x, 255, (size_t) width);
+        }
+
+        HeapBlock<uint8> data;
+        const Rectangle<int> area;
+
+    private:
+        uint8* currentLine;
+
+        JUCE_DECLARE_NON_COPYABLE (AlphaMap)
+    };
+
+    JUCE_DECLARE_NON_COPYABLE (GlyphAtlas)
+};
+
 //==============================================================================
 struct Target
 {
@@ -356,11 +683,36 @@ public:
           tiledImage (context),
           tiledImageMasked (context),
           copyTexture (context),
-          maskTexture (context)
+          maskTexture (context),
+          pathStencil (context),
+          glyphAtlas (context)
     {}
 
     typedef ReferenceCountedObjectPtr<ShaderPrograms> Ptr;
 
+    //==============================================================================
+    // Each program is only compiled the first time it's used, because compiling them
+    // all when a context first renders causes a long pause, and most apps only need a few.
+    template <typename ProgramType>
+    struct LazyProgram
+    {
+        LazyProgram (OpenGLContext& c) noexcept  : context (c) {}
+
+        ProgramType& operator*()
+        {
+            if (program == nullptr)
+                program.reset (new ProgramType (context));
+
+            return *program;
+        }
+
+        ProgramType* operator->()       { return &operator*(); }
+
+    private:
+        OpenGLContext& context;
+        std::unique_ptr<ProgramType> program;
+    };
+
     //==============================================================================
     struct ShaderProgramHolder
     {
@@ -384,9 +736,8 @@ public:
                                  "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
                                "}";
 
-            if (program.addVertexShader (OpenGLHelpers::translateVertexShaderToV3 (vertexShader))
-                 && program.addFragmentShader (OpenGLHelpers::translateFragmentShaderToV3 (fragmentShader))
-                 && program.link())
+            if (program.addShadersAndLink (OpenGLHelpers::translateVertexShaderToV3 (vertexShader),
+                                           OpenGLHelpers::translateFragmentShaderToV3 (fragmentShader)))
             {
                 JUCE_CHECK_OPENGL_ERROR
             }
@@ -797,20 +1148,107 @@ public:
         ImageParams imageParams;
     };
 
-    SolidColourProgram solidColourProgram;
-    SolidColourMaskedProgram solidColourMasked;
-    RadialGradientProgram radialGradient;
-    RadialGradientMaskedProgram radialGradientMasked;
-    LinearGradient1Program linearGradient1;
-    LinearGradient1MaskedProgram linearGradient1Masked;
-    LinearGradient2Program linearGradient2;
-    LinearGradient2MaskedProgram linearGradient2Masked;
-    ImageProgram image;
-    ImageMaskedProgram imageMasked;
-    TiledImageProgram tiledImage;
-    TiledImageMaskedProgram tiledImageMasked;
-    CopyTextureProgram copyTexture;
-    MaskTextureProgram maskTexture;
+    // Only draws path triangles into the stencil buffer, so it has no colour or varyings.
+    struct PathStencilProgram  : public ShaderProgramHolder
+    {
+        PathStencilProgram (OpenGLContext& context)
+            : ShaderProgramHolder (context,
+                                   "void main()"
+                                   "{"
+                                     "gl_FragColor = vec4 (1.0);"
+                                   "}",
+                                   "attribute vec2 position;"
+                                   "uniform vec4 screenBounds;"
+                                   "void main()"
+                                   "{"
+                                     "vec2 scaledPos = (position - screenBounds.xy) / screenBounds.zw;"
+                                     "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
+                                   "}"),
+              positionAttribute (program, "position"),
+              screenBounds (program, "screenBounds")
+        {}
+
+        void set2DBounds (const Rectangle<float>& bounds)
+        {
+            screenBounds.set (bounds.getX(), bounds.getY(), 0.5f * bounds.getWidth(), 0.5f * bounds.getHeight());
+        }
+
+        OpenGLShaderProgram::Attribute positionAttribute;
+
+    private:
+        OpenGLShaderProgram::Uniform screenBounds;
+    };
+
+    // Draws glyphs from a GlyphAtlas, with each vertex carrying its own position in the atlas.
+    struct GlyphAtlasProgram  : public ShaderProgramHolder
+    {
+        GlyphAtlasProgram (OpenGLContext& context)
+            : ShaderProgramHolder (context,
+                                   "uniform sampler2D atlasTexture;"
+                                   JUCE_DECLARE_VARYING_COLOUR
+                                   "varying " JUCE_HIGHP " vec2 texturePos;"
+                                   "varying " JUCE_MEDIUMP " float level;"
+                                   "void main()"
+                                   "{"
+                                     "gl_FragColor = frontColour * min (1.0, level * texture2D (atlasTexture, texturePos).a);"
+                                   "}",
+                                   "attribute vec2 position;"
+                                   "attribute vec2 textureCoord;"
+                                   "attribute vec4 colour;"
+                                   "attribute float levelScale;"
+                                   "uniform vec4 screenBounds;"
+                                   "uniform float atlasScale;"
+                                   "varying " JUCE_MEDIUMP " vec4 frontColour;"
+                                   "varying " JUCE_HIGHP " vec2 texturePos;"
+                                   "varying " JUCE_MEDIUMP " float level;"
+                                   "void main()"
+                                   "{"
+                                     "frontColour = colour;"
+                                     "level = levelScale;"
+                                     "texturePos = textureCoord * atlasScale;"
+                                     "vec2 scaledPos = (position - screenBounds.xy) / screenBounds.zw;"
+                                     "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
+                                   "}"),
+              positionAttribute (program, "position"),
+              textureCoordAttribute (program, "textureCoord"),
+              colourAttribute (program, "colour"),
+              levelScaleAttribute (program, "levelScale"),
+              screenBounds (program, "screenBounds"),
+              atlasScale (program, "atlasScale"),
+              atlasTexture (program, "atlasTexture")
+        {}
+
+        void use (const Rectangle<int>& bounds, int atlasSize)
+        {
+            program.use();
+            screenBounds.set ((GLfloat) bounds.getX(), (GLfloat) bounds.getY(),
+                              0.5f * (GLfloat) bounds.getWidth(), 0.5f * (GLfloat) bounds.getHeight());
+            atlasScale.set (1.0f / (GLfloat) atlasSize);
+            atlasTexture.set ((GLint) 0);
+        }
+
+        OpenGLShaderProgram::Attribute positionAttribute, textureCoordAttribute, colourAttribute, levelScaleAttribute;
+
+    private:
+        OpenGLShaderProgram::Uniform screenBounds, atlasScale, atlasTexture;
+    };
+
+    LazyProgram<SolidColourProgram> solidColourProgram;
+    LazyProgram<SolidColourMaskedProgram> solidColourMasked;
+    LazyProgram<RadialGradientProgram> radialGradient;
+    LazyProgram<RadialGradientMaskedProgram> radialGradientMasked;
+    LazyProgram<LinearGradient1Program> linearGradient1;
+    LazyProgram<LinearGradient1MaskedProgram> linearGradient1Masked;
+    LazyProgram<LinearGradient2Program> linearGradient2;
+    LazyProgram<LinearGradient2MaskedProgram> linearGradient2Masked;
+    LazyProgram<ImageProgram> image;
+    LazyProgram<ImageMaskedProgram> imageMasked;
+    LazyProgram<TiledImageProgram> tiledImage;
+    LazyProgram<TiledImageMaskedProgram> tiledImageMasked;
+    LazyProgram<CopyTextureProgram> copyTexture;
+    LazyProgram<MaskTextureProgram> maskTexture;
+    LazyProgram<PathStencilProgram> pathStencil;
+    LazyProgram<GlyphAtlasProgram> glyphAtlas;
 };
 
 //==============================================================================
@@ -1173,13 +1611,7 @@ struct StateHelpers
             v[1].x = v[3].x = (GLshort) (x + w);
             v[2].y = v[3].y = (GLshort) (y + h);
 
-           #if JUCE_BIG_ENDIAN
-            const GLuint rgba = (GLuint) ((colour.getRed() << 24) | (colour.getGreen() << 16)
-                                        | (colour.getBlue() << 8) |  colour.getAlpha());
-           #else
-            const GLuint rgba = (GLuint) ((colour.getAlpha() << 24) | (colour.getBlue() << 16)
-                                        | (colour.getGreen() << 8) |  colour.getRed());
-           #endif
+            const GLuint rgba = getVertexColour (colour);
 
             v[0].colour = rgba;
             v[1].colour = rgba;
@@ -1233,6 +1665,26 @@ struct StateHelpers
                 draw();
         }
 
+        // Must be called after something else has been drawn from a different vertex buffer.
+        void bindBuffers() noexcept
+        {
+            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
+            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
+        }
+
+        static GLuint getVertexColour (const PixelARGB colour) noexcept
+        {
+           #if JUCE_BIG_ENDIAN
+            return (GLuint) ((colour.getRed() << 24) | (colour.getGreen() << 16)
+                           | (colour.getBlue() << 8) |  colour.getAlpha());
+           #else
+            return (GLuint) ((colour.getAlpha() << 24) | (colour.getBlue() << 16)
+                           | (colour.getGreen() << 8) |  colour.getRed());
+           #endif
+        }
+
+        enum { numQuads = 256 };
+
     private:
         struct VertexInfo
         {
@@ -1240,8 +1692,6 @@ struct StateHelpers
             GLuint colour;
         };
 
-        enum { numQuads = 256 };
-
         GLuint buffers[2];
         VertexInfo vertexData [numQuads * 4];
         GLushort indexData [numQuads * 6];
@@ -1261,6 +1711,128 @@ struct StateHelpers
         JUCE_DECLARE_NON_COPYABLE (ShaderQuadQueue)
     };
 
+    //==============================================================================
+    // Collects glyphs that are drawn from the GlyphAtlas, so that a run of text can be drawn
+    // with a single call. It shares the ShaderQuadQueue's index buffer.
+    struct GlyphQuadQueue
+    {
+        GlyphQuadQueue (const OpenGLContext& c, ShaderQuadQueue& q) noexcept
+            : context (c), quadQueue (q)
+        {}
+
+        ~GlyphQuadQueue() noexcept
+        {
+            static_assert (sizeof (VertexInfo) == 16, "Sanity check VertexInfo size");
+
+            if (buffer != 0)
+                context.extensions.glDeleteBuffers (1, &buffer);
+        }
+
+        void setProgram (ShaderPrograms::GlyphAtlasProgram& newProgram, const Rectangle<int>& targetBounds) noexcept
+        {
+            program = &newProgram;
+            bounds = targetBounds;
+        }
+
+        void add (const Rectangle<int>& area, Point<int> texturePos, GLuint colour, float levelScale) noexcept
+        {
+            VertexInfo* const v = vertexData + numVertices;
+            v[0].x = v[2].x = (GLshort) area.getX();
+            v[0].y = v[1].y = (GLshort) area.getY();
+            v[1].x = v[3].x = (GLshort) area.getRight();
+            v[2].y = v[3].y = (GLshort) area.getBottom();
+
+            v[0].u = v[2].u = (GLshort) texturePos.x;
+            v[0].v = v[1].v = (GLshort) texturePos.y;
+            v[1].u = v[3].u = (GLshort) (texturePos.x + area.getWidth());
+            v[2].v = v[3].v = (GLshort) (texturePos.y + area.getHeight());
+
+            for (int i = 0; i < 4; ++i)
+            {
+                v[i].colour = colour;
+                v[i].levelScale = levelScale;
+            }
+
+            numVertices += 4;
+
+            if (numVertices > ShaderQuadQueue::numQuads * 4 - 4)
+                draw();
+        }
+
+        bool isEmpty() const noexcept       { return numVertices == 0; }
+
+        void flush() noexcept
+        {
+            if (numVertices > 0)
+                draw();
+        }
+
+    private:
+        struct VertexInfo
+        {
+            GLshort x, y, u, v;
+            GLuint colour;
+            GLfloat levelScale;
+        };
+
+        const OpenGLContext& context;
+        ShaderQuadQueue& quadQueue;
+        ShaderPrograms::GlyphAtlasProgram* program = nullptr;
+        Rectangle<int> bounds;
+        GLuint buffer = 0;
+        VertexInfo vertexData [ShaderQuadQueue::numQuads * 4];
+        int numVertices = 0;
+
+        void draw() noexcept
+        {
+            jassert (program != nullptr);
+            auto& extensions = context.extensions;
+
+            if (buffer == 0)
+            {
+                extensions.glGenBuffers (1, &buffer);
+                extensions.glBindBuffer (GL_ARRAY_BUFFER, buffer);
+                extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), nullptr, GL_STREAM_DRAW);
+            }
+            else
+            {
+                extensions.glBindBuffer (GL_ARRAY_BUFFER, buffer);
+            }
+
+            extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
+
+            program->use (bounds, GlyphAtlas::atlasSize);
+
+            auto position   = (GLuint) program->positionAttribute.attributeID;
+            auto texCoord   = (GLuint) program->textureCoordAttribute.attributeID;
+            auto colour     = (GLuint) program->colourAttribute.attributeID;
+            auto levelScale = (GLuint) program->levelScaleAttribute.attributeID;
+
+            extensions.glVertexAttribPointer (position,   2, GL_SHORT,         GL_FALSE, sizeof (VertexInfo), (void*) 0);
+            extensions.glVertexAttribPointer (texCoord,   2, GL_SHORT,         GL_FALSE, sizeof (VertexInfo), (void*) 4);
+            extensions.glVertexAttribPointer (colour,     4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof (VertexInfo), (void*) 8);
+            extensions.glVertexAttribPointer (levelScale, 1, GL_FLOAT,         GL_FALSE, sizeof (VertexInfo), (void*) 12);
+            extensions.glEnableVertexAttribArray (position);
+            extensions.glEnableVertexAttribArray (texCoord);
+            extensions.glEnableVertexAttribArray (colour);
+            extensions.glEnableVertexAttribArray (levelScale);
+
+            glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT, 0);
+
+            extensions.glDisableVertexAttribArray (position);
+            extensions.glDisableVertexAttribArray (texCoord);
+            extensions.glDisableVertexAttribArray (colour);
+            extensions.glDisableVertexAttribArray (levelScale);
+            extensions.glUseProgram (0);
+            quadQueue.bindBuffers();
+
+            JUCE_CHECK_OPENGL_ERROR
+            numVertices = 0;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (GlyphQuadQueue)
+    };
+
     //==============================================================================
     struct CurrentShader
     {
@@ -1340,6 +1912,7 @@ public:
           activeTextures (t.context),
           currentShader (t.context),
           shaderQuadQueue (t.context),
+          glyphQuadQueue (t.context, shaderQuadQueue),
           previousFrameBufferTarget (OpenGLFrameBuffer::getCurrentFrameBufferTarget())
     {
         // This object can only be created and used when the current thread has an active OpenGL context.
@@ -1363,21 +1936,176 @@ public:
 
     void flush()
     {
+        glyphQuadQueue.flush();
         shaderQuadQueue.flush();
         currentShader.clearShader (shaderQuadQueue);
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    // Any glyphs that are waiting to be drawn must go before anything else changes the
+    // shader, textures or blending.
+    void flushGlyphs()
+    {
+        glyphQuadQueue.flush();
+    }
+
     void setShader (ShaderPrograms::ShaderBase& shader)
     {
+        glyphQuadQueue.flush();
         currentShader.setShader (target, shaderQuadQueue, shader);
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    bool canFillPathsWithStencil() const noexcept
+    {
+        // the stencil buffer belongs to the context's own framebuffer, so layers and
+        // framebuffers made for images can't use it
+        return target.context.isGPUPathRenderingEnabled()
+                && target.frameBufferID == target.context.getFrameBufferID()
+                && currentShader.programs->pathStencil->lastError.isEmpty();
+    }
+
+    // Marks the pixels inside the path in the stencil buffer, and leaves the stencil test
+    // on so that anything drawn until endStencilledPathFill() only touches those pixels.
+    void beginStencilledPathFill (const Path& path, const AffineTransform& transform, const Rectangle<int>& area)
+    {
+        flush();
+
+        if (pathGeometryCache == nullptr)
+            pathGeometryCache = PathGeometryCache::get (target.context);
+
+        auto& geometry = pathGeometryCache->getGeometryFor (path, transform);
+        auto& program = *currentShader.programs->pathStencil;
+        auto& extensions = target.context.extensions;
+
+        // only the area that's going to be covered needs clearing, and the scissor also
+        // stops the fan triangles from touching the stencil anywhere else
+        auto scissor = area - target.bounds.getPosition();
+        glEnable (GL_SCISSOR_TEST);
+        glScissor (scissor.getX(), target.bounds.getHeight() - scissor.getBottom(), scissor.getWidth(), scissor.getHeight());
+        glStencilMask (0xff);
+        glClearStencil (0);
+        glClear (GL_STENCIL_BUFFER_BIT);
+
+        glEnable (GL_STENCIL_TEST);
+        glStencilFunc (GL_ALWAYS, 0, 0xff);
+        glColorMask (GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+        program.program.use();
+        program.set2DBounds (target.bounds.toFloat());
+
+        auto position = (GLuint) program.positionAttribute.attributeID;
+        extensions.glBindBuffer (GL_ARRAY_BUFFER, geometry.buffer);
+        extensions.glVertexAttribPointer (position, 2, GL_FLOAT, GL_FALSE, 0, (void*) 0);
+        extensions.glEnableVertexAttribArray (position);
+
+        if (path.isUsingNonZeroWinding())
+        {
+            // counts up for the triangles that face one way and down for the others
+            glEnable (GL_CULL_FACE);
+            glCullFace (GL_BACK);
+            glStencilOp (GL_KEEP, GL_KEEP, GL_INCR_WRAP);
+            glDrawArrays (GL_TRIANGLES, 0, geometry.numVertices);
+            glCullFace (GL_FRONT);
+            glStencilOp (GL_KEEP, GL_KEEP, GL_DECR_WRAP);
+            glDrawArrays (GL_TRIANGLES, 0, geometry.numVertices);
+            glDisable (GL_CULL_FACE);
+        }
+        else
+        {
+            glStencilOp (GL_KEEP, GL_KEEP, GL_INVERT);
+            glDrawArrays (GL_TRIANGLES, 0, geometry.numVertices);
+        }
+
+        extensions.glDisableVertexAttribArray (position);
+        extensions.glUseProgram (0);
+        shaderQuadQueue.bindBuffers();
+
+        glColorMask (GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDisable (GL_SCISSOR_TEST);
+        glStencilFunc (GL_NOTEQUAL, 0, 0xff);
+        glStencilOp (GL_KEEP, GL_KEEP, GL_KEEP);
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
+    void endStencilledPathFill()
+    {
+        flush();
+        glDisable (GL_STENCIL_TEST);
+    }
+
+    // Adds a glyph to the current run of text, taking it from the GPU's glyph atlas. Returns
+    // false if the glyph is too big for the atlas and must be drawn some other way.
+    bool drawGlyphFromAtlas (const Font& font, int glyphNumber, Point<float> pos,
+                             const RectangleList<int>& clipRegion, Colour colour)
+    {
+        if (currentShader.programs->glyphAtlas->lastError.isNotEmpty())
+            return false;
+
+        if (glyphAtlas == nullptr)
+            glyphAtlas = GlyphAtlas::get (target.context);
+
+        // once the text has started, nothing else can have been drawn or changed the state
+        if (glyphQuadQueue.isEmpty())
+        {
+            flush();
+            glyphQuadQueue.setProgram (*currentShader.programs->glyphAtlas, target.bounds);
+            activeTextures.setSingleTextureMode (glyphQuadQueue);
+            activeTextures.bindTexture (glyphAtlas->getTextureID());
+            blendMode.setPremultipliedBlendingMode (glyphQuadQueue);
+        }
+
+        if (font.getTypeface()->isHinted())
+            pos.x = std::floor (pos.x + 0.5f);
+
+        Point<int> origin ((int) std::floor (pos.x), roundToInt (pos.y));
+        auto subPixelPosition = roundToInt ((pos.x - (float) origin.x) * GlyphAtlas::numSubPixelPositions);
+
+        if (subPixelPosition == GlyphAtlas::numSubPixelPositions)
+        {
+            ++origin.x;
+            subPixelPosition = 0;
+        }
+
+        auto* glyph = glyphAtlas->getGlyph (font, glyphNumber, subPixelPosition);
+
+        if (glyph == nullptr)
+        {
+            glyphQuadQueue.flush();
+            glyphAtlas->clear();
+            glyph = glyphAtlas->getGlyph (font, glyphNumber, subPixelPosition);
+            jassert (glyph != nullptr);
+        }
+
+        if (glyph->area.isEmpty())
+            return true;
+
+        if (! glyph->isInAtlas)
+            return false;
+
+        // this matches the boost that the software renderer gives to light text
+        auto brightness = colour.getBrightness() - 0.5f;
+        auto levelScale = brightness > 0.0f ? 1.0f + 1.6f * brightness : 1.0f;
+        auto vertexColour = StateHelpers::ShaderQuadQueue::getVertexColour (colour.getPixelARGB());
+        auto area = glyph->area + origin;
+
+        for (auto& r : clipRegion)
+        {
+            auto clipped = r.getIntersection (area);
+
+            if (! clipped.isEmpty())
+                glyphQuadQueue.add (clipped, glyph->texturePos + (clipped.getPosition() - area.getPosition()),
+                                    vertexColour, levelScale);
+        }
+
+        return true;
+    }
+
     void setShaderForGradientFill (const ColourGradient& g, const AffineTransform& transform,
                                    const int maskTextureID, const Rectangle<int>* const maskArea)
     {
         JUCE_CHECK_OPENGL_ERROR
+        flushGlyphs();
         activeTextures.disableTextures (shaderQuadQueue);
         blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
         JUCE_CHECK_OPENGL_ERROR
@@ -1412,14 +2140,14 @@ public:
 
             if (maskArea == nullptr)
             {
-                setShader (programs->radialGradient);
-                gradientParams = &programs->radialGradient.gradientParams;
+                setShader (*programs->radialGradient);
+                gradientParams = &programs->radialGradient->gradientParams;
             }
             else
             {
-                setShader (programs->radialGradientMasked);
-                gradientParams = &programs->radialGradientMasked.gradientParams;
-                maskParams = &programs->radialGradientMasked.maskParams;
+                setShader (*programs->radialGradientMasked);
+                gradientParams = &programs->radialGradientMasked->gradientParams;
+                maskParams = &programs->radialGradientMasked->maskParams;
             }
 
             gradientParams->setMatrix (p1, p2, p3);
@@ -1435,14 +2163,14 @@ public:
             {
                 if (maskArea == nullptr)
                 {
-                    setShader (programs->linearGradient1);
-                    gradientParams = &(programs->linearGradient1.gradientParams);
+                    setShader (*programs->linearGradient1);
+                    gradientParams = &(programs->linearGradient1->gradientParams);
                 }
                 else
                 {
-                    setShader (programs->linearGradient1Masked);
-                    gradientParams = &(programs->linearGradient1Masked.gradientParams);
-                    maskParams = &programs->linearGradient1Masked.maskParams;
+                    setShader (*programs->linearGradient1Masked);
+                    gradientParams = &(programs->linearGradient1Masked->gradientParams);
+                    maskParams = &programs->linearGradient1Masked->maskParams;
                 }
 
                 grad = delta.x / delta.y;
@@ -1452,14 +2180,14 @@ public:
             {
                 if (maskArea == nullptr)
                 {
-                    setShader (programs->linearGradient2);
-                    gradientParams = &(programs->linearGradient2.gradientParams);
+                    setShader (*programs->linearGradient2);
+                    gradientParams = &(programs->linearGradient2->gradientParams);
                 }
                 else
                 {
-                    setShader (programs->linearGradient2Masked);
-                    gradientParams = &(programs->linearGradient2Masked.gradientParams);
-                    maskParams = &programs->linearGradient2Masked.maskParams;
+                    setShader (*programs->linearGradient2Masked);
+                    gradientParams = &(programs->linearGradient2Masked->gradientParams);
+                    maskParams = &programs->linearGradient2Masked->maskParams;
                 }
 
                 grad = delta.y / delta.x;
@@ -1478,6 +2206,7 @@ public:
     void setShaderForTiledImageFill (const TextureInfo& textureInfo, const AffineTransform& transform,
                                      const int maskTextureID, const Rectangle<int>* const maskArea, bool isTiledFill)
     {
+        flushGlyphs();
         blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
 
         ShaderPrograms* const programs = currentShader.programs;
@@ -1491,15 +2220,15 @@ public:
 
             if (isTiledFill)
             {
-                setShader (programs->tiledImageMasked);
-                imageParams = &programs->tiledImageMasked.imageParams;
-                maskParams  = &programs->tiledImageMasked.maskParams;
+                setShader (*programs->tiledImageMasked);
+                imageParams = &programs->tiledImageMasked->imageParams;
+                maskParams  = &programs->tiledImageMasked->maskParams;
             }
             else
             {
-                setShader (programs->imageMasked);
-                imageParams = &programs->imageMasked.imageParams;
-                maskParams  = &programs->imageMasked.maskParams;
+                setShader (*programs->imageMasked);
+                imageParams = &programs->imageMasked->imageParams;
+                maskParams  = &programs->imageMasked->maskParams;
             }
         }
         else
@@ -1509,13 +2238,13 @@ public:
 
             if (isTiledFill)
             {
-                setShader (programs->tiledImage);
-                imageParams = &programs->tiledImage.imageParams;
+                setShader (*programs->tiledImage);
+                imageParams = &programs->tiledImage->imageParams;
             }
             else
             {
-                setShader (programs->image);
-                imageParams = &programs->image.imageParams;
+                setShader (*programs->image);
+                imageParams = &programs->image->imageParams;
             }
         }
 
@@ -1532,8 +2261,11 @@ public:
     StateHelpers::TextureCache textureCache;
     StateHelpers::CurrentShader currentShader;
     StateHelpers::ShaderQuadQueue shaderQuadQueue;
+    StateHelpers::GlyphQuadQueue glyphQuadQueue;
 
     CachedImageList::Ptr cachedImageList;
+    PathGeometryCache::Ptr pathGeometryCache;
+    GlyphAtlas::Ptr glyphAtlas;
 
 private:
     GLuint previousFrameBufferTarget;
@@ -1610,7 +2342,7 @@ public:
 
                 if (transform.isOnlyTranslated)
                 {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                    drawCachedGlyph (cache, font, glyphNumber, pos + transform.offset.toFloat());
                 }
                 else
                 {
@@ -1623,7 +2355,7 @@ public:
                     if (std::abs (xScale - 1.0f) > 0.01f)
                         f.setHorizontalScale (xScale);
 
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                    drawCachedGlyph (cache, f, glyphNumber, pos);
                 }
             }
             else
@@ -1641,6 +2373,40 @@ public:
         }
     }
 
+    void fillPath (const Path& path, const AffineTransform& t)
+    {
+        if (clip == nullptr || isUsingCustomShader || ! state->canFillPathsWithStencil())
+        {
+            BaseClass::fillPath (path, t);
+            return;
+        }
+
+        auto trans = transform.getTransformWith (t);
+        auto area = path.getBoundsTransformed (trans).getSmallestIntegerContainer()
+                        .getIntersection (clip->getClipBounds());
+
+        if (! area.isEmpty())
+        {
+            // the stencil limits the cover to the path, and the clip and fill are applied
+            // to the cover exactly as they would be to any other shape
+            state->beginStencilledPathFill (path, trans, area);
+            fillShape (new RectangleListRegionType (area), false);
+            state->endStencilledPathFill();
+        }
+    }
+
+    // Solid-coloured text inside a rectangular clip is drawn from the GPU's glyph atlas,
+    // and anything else uses the same cached edge tables as the software renderer.
+    void drawCachedGlyph (GlyphCacheType& cache, const Font& f, int glyphNumber, Point<float> pos)
+    {
+        if (fillType.isColour() && ! isUsingCustomShader)
+            if (auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get()))
+                if (state->drawGlyphFromAtlas (f, glyphNumber, pos, rectangleClip->clip, fillType.colour))
+                    return;
+
+        cache.drawGlyph (*this, f, glyphNumber, pos);
+    }
+
     Rectangle<int> getMaximumBounds() const     { return state->target.bounds; }
 
     void setFillType (const FillType& newFill)
@@ -1654,6 +2420,8 @@ public:
     void renderImageTransformed (IteratorType& iter, const Image& src, const int alpha,
                                  const AffineTransform& trans, Graphics::ResamplingQuality, bool tiledFill) const
     {
+        // (loading the image's texture changes the texture binding)
+        state->flushGlyphs();
         state->shaderQuadQueue.flush();
         state->setShaderForTiledImageFill (state->cachedImageList->getTextureFor (src), trans, 0, nullptr, tiledFill);
 
@@ -1675,9 +2443,10 @@ public:
     {
         if (! isUsingCustomShader)
         {
+            state->flushGlyphs();
             state->activeTextures.disableTextures (state->shaderQuadQueue);
             state->blendMode.setBlendMode (state->shaderQuadQueue, replaceContents);
-            state->setShader (state->currentShader.programs->solidColourProgram);
+            state->setShader (*state->currentShader.programs->solidColourProgram);
         }
 
         state->shaderQuadQueue.add (iter, colour);
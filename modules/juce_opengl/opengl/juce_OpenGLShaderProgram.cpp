@@ -133,6 +133,126 @@ bool OpenGLShaderProgram::link() noexcept
     return status != GL_FALSE;
 }
 
+//==============================================================================
+#if JUCE_WINDOWS
+ #define JUCE_GL_PROGRAM_BINARY_CALLTYPE __stdcall
+#else
+ #define JUCE_GL_PROGRAM_BINARY_CALLTYPE
+#endif
+
+// glGetProgramBinary and friends are only in GL 4.1, ES 3 and ARB_get_program_binary,
+// so they're looked up when needed rather than being part of OpenGLExtensionFunctions.
+struct ProgramBinaryFunctions
+{
+    ProgramBinaryFunctions (bool shouldLoadFunctions)
+    {
+        if (! shouldLoadFunctions)
+            return;
+
+        getProgramBinary  = (GetProgramBinaryType)  OpenGLHelpers::getExtensionFunction ("glGetProgramBinary");
+        programBinary     = (ProgramBinaryType)     OpenGLHelpers::getExtensionFunction ("glProgramBinary");
+        programParameteri = (ProgramParameteriType) OpenGLHelpers::getExtensionFunction ("glProgramParameteri");
+
+        if (getProgramBinary != nullptr && programBinary != nullptr && programParameteri != nullptr)
+        {
+            GLint numFormats = 0;
+            glGetIntegerv (GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+            OpenGLHelpers::resetErrorState();
+            isAvailable = numFormats > 0;
+        }
+    }
+
+    typedef void (JUCE_GL_PROGRAM_BINARY_CALLTYPE *GetProgramBinaryType) (GLuint, GLsizei, GLsizei*, GLenum*, void*);
+    typedef void (JUCE_GL_PROGRAM_BINARY_CALLTYPE *ProgramBinaryType) (GLuint, GLenum, const void*, GLsizei);
+    typedef void (JUCE_GL_PROGRAM_BINARY_CALLTYPE *ProgramParameteriType) (GLuint, GLenum, GLint);
+
+    GetProgramBinaryType getProgramBinary = nullptr;
+    ProgramBinaryType programBinary = nullptr;
+    ProgramParameteriType programParameteri = nullptr;
+    bool isAvailable = false;
+};
+
+#undef JUCE_GL_PROGRAM_BINARY_CALLTYPE
+
+static File getProgramCacheFile (const File& cacheDirectory, const String& vertexShader, const String& fragmentShader)
+{
+    // the key includes the driver, because a binary can only be loaded by the driver that made it
+    XXHash64 hasher;
+
+    for (auto* s : { (const char*) glGetString (GL_RENDERER), (const char*) glGetString (GL_VERSION),
+                     vertexShader.toRawUTF8(), fragmentShader.toRawUTF8() })
+        if (s != nullptr)
+            hasher.addData (s, strlen (s) + 1);
+
+    return cacheDirectory.getChildFile (String::toHexString ((int64) hasher.getResult()) + ".glprogram");
+}
+
+bool OpenGLShaderProgram::addShadersAndLink (const String& vertexShaderSourceCode, const String& fragmentShaderSourceCode)
+{
+    // This method can only be used when the current thread has an active OpenGL context.
+    jassert (OpenGLHelpers::isContextActive());
+
+    auto cacheDirectory = context.getShaderCacheDirectory();
+    ProgramBinaryFunctions functions (cacheDirectory != File());
+
+    if (! functions.isAvailable)
+        return addVertexShader (vertexShaderSourceCode)
+                && addFragmentShader (fragmentShaderSourceCode)
+                && link();
+
+    auto cacheFile = getProgramCacheFile (cacheDirectory, vertexShaderSourceCode, fragmentShaderSourceCode);
+    MemoryBlock cached;
+
+    // The cache files contain the binary format as a little-endian uint32, followed by the binary
+    if (cacheFile.loadFileAsData (cached) && cached.getSize() > 4)
+    {
+        functions.programBinary (getProgramID(), (GLenum) ByteOrder::littleEndianInt (cached.getData()),
+                                 addBytesToPointer (cached.getData(), 4), (GLsizei) cached.getSize() - 4);
+
+        GLint status = GL_FALSE;
+        context.extensions.glGetProgramiv (programID, GL_LINK_STATUS, &status);
+        OpenGLHelpers::resetErrorState();
+
+        if (status != GL_FALSE)
+            return true;
+
+        // The driver must have changed, so start again with a new program
+        release();
+        cacheFile.deleteFile();
+    }
+
+    functions.programParameteri (getProgramID(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    if (! (addVertexShader (vertexShaderSourceCode)
+            && addFragmentShader (fragmentShaderSourceCode)
+            && link()))
+        return false;
+
+    GLint length = 0;
+    context.extensions.glGetProgramiv (programID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length > 0)
+    {
+        MemoryBlock binary (4 + (size_t) length);
+        GLsizei numBytesWritten = 0;
+        GLenum format = 0;
+
+        functions.getProgramBinary (programID, length, &numBytesWritten, &format, addBytesToPointer (binary.getData(), 4));
+        OpenGLHelpers::resetErrorState();
+
+        if (numBytesWritten > 0)
+        {
+            *static_cast<uint32*> (binary.getData()) = ByteOrder::swapIfBigEndian ((uint32) format);
+            binary.setSize (4 + (size_t) numBytesWritten);
+
+            cacheDirectory.createDirectory();
+            cacheFile.replaceWithData (binary.getData(), binary.getSize());
+        }
+    }
+
+    return true;
+}
+
 void OpenGLShaderProgram::use() const noexcept
 {
     // The shader program must have been successfully linked when this method is called!
@@ -84,6 +84,18 @@ public:
     */
     bool link() noexcept;
 
+    /** Compiles a vertex and a fragment shader, and links them into this program.
+
+        This does the same as calling addVertexShader(), addFragmentShader() and link(),
+        but if the context has a shader cache (see OpenGLContext::setShaderCacheDirectory()),
+        it'll first try to load a binary of the program that was stored the last time
+        these shaders were linked, and will store a new one if it has to link them itself.
+
+        @returns  true if the program was loaded or linked successfully. If not, you can
+                  call getLastError() to find out what happened.
+    */
+    bool addShadersAndLink (const String& vertexShaderSourceCode, const String& fragmentShaderSourceCode);
+
     /** Get the output for the last shader compilation or link that failed. */
     const String& getLastError() const noexcept             { return errorLog; }
 
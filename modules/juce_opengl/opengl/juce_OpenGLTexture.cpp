@@ -36,14 +36,23 @@ static int getAllowedTextureSize (int x)
    #endif
 }
 
+static MemoryUsage::Category& getTextureMemoryUsage()
+{
+    static MemoryUsage::Category& category = MemoryUsage::getCategory ("OpenGLTexture");
+    return category;
+}
+
 OpenGLTexture::OpenGLTexture()
-    : textureID (0), width (0), height (0), ownerContext (nullptr)
+    : textureID (0), width (0), height (0), numBytes (0), ownerContext (nullptr)
 {
 }
 
 OpenGLTexture::~OpenGLTexture()
 {
     release();
+
+    // (if the texture couldn't be deleted, the context will free it when it's destroyed)
+    getTextureMemoryUsage().remove (numBytes);
 }
 
 bool OpenGLTexture::isValidSize (int width, int height)
@@ -86,6 +95,10 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
 
     const GLint internalformat = type == GL_ALPHA ? GL_ALPHA : GL_RGBA;
 
+    auto newNumBytes = (int64) width * height * (type == GL_ALPHA ? 1 : 4);
+    getTextureMemoryUsage().add (newNumBytes - numBytes);
+    numBytes = newNumBytes;
+
     if (width != w || height != h)
     {
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
@@ -168,15 +181,19 @@ void OpenGLTexture::release()
         // If the texture is deleted while the owner context is not active, it's
         // impossible to delete it, so this will be a leak until the context itself
         // is deleted.
-        jassert (ownerContext == OpenGLContext::getCurrentContext());
+        auto* currentContext = OpenGLContext::getCurrentContext();
+        jassert (currentContext != nullptr && currentContext->sharesResourcesWith (ownerContext));
 
-        if (ownerContext == OpenGLContext::getCurrentContext())
+        if (currentContext != nullptr && currentContext->sharesResourcesWith (ownerContext))
         {
             glDeleteTextures (1, &textureID);
 
             textureID = 0;
             width = 0;
             height = 0;
+
+            getTextureMemoryUsage().remove (numBytes);
+            numBytes = 0;
         }
     }
 }
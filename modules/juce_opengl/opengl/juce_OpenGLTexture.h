@@ -93,6 +93,7 @@ public:
 private:
     GLuint textureID;
     int width, height;
+    int64 numBytes;
     OpenGLContext* ownerContext;
 
     void create (int w, int h, const void*, GLenum, bool topLeft);
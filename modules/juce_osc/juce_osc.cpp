@@ -40,6 +40,8 @@
 #include "osc/juce_OSCArgument.cpp"
 #include "osc/juce_OSCAddress.cpp"
 #include "osc/juce_OSCMessage.cpp"
+#include "osc/juce_OSCMessageView.cpp"
 #include "osc/juce_OSCBundle.cpp"
 #include "osc/juce_OSCReceiver.cpp"
 #include "osc/juce_OSCSender.cpp"
+#include "osc/juce_OSCBatchSender.cpp"
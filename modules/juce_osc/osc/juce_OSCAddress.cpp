@@ -92,55 +92,49 @@ namespace
         }
 
         //==============================================================================
+        // The sets are matched in place rather than being collected into containers first,
+        // so that matching never allocates and can be used on realtime threads.
         static bool matchInsideStringSet (CharPtr pattern, CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
         {
             if (pattern == patternEnd)
                 return false;
 
-            // Note: in case this code is ever moved into the more generic CharPointerFunctions,
-            // the next two lines probably will not compile as soon as this class is used with a
-            // Char template type parameter that is not the same type as String::Char.
-            StringArray set;
-            String currentElement;
+            auto setEnd = pattern;
 
-            while (pattern != patternEnd)
+            while (*setEnd != '}')
+                if (++setEnd == patternEnd)
+                    return false;
+
+            auto remainingPattern = setEnd + 1;
+
+            for (auto elementStart = pattern;;)
             {
-                auto c = pattern.getAndAdvance();
+                auto elementEnd = elementStart;
 
-                switch (c)
-                {
-                    case '}':
-                        set.add (currentElement);
-                        currentElement.clear();
-                        return matchStringSet (set, pattern, patternEnd, target, targetEnd);
+                while (elementEnd != setEnd && *elementEnd != ',')
+                    ++elementEnd;
 
-                    case ',':
-                        set.add (currentElement);
-                        currentElement.clear();
-                        continue;
+                auto t = target;
 
-                    default:
-                        currentElement += c;
-                        continue;
-                }
-            }
+                if (matchStringSetElement (elementStart, elementEnd, t, targetEnd)
+                     && match (remainingPattern, patternEnd, t, targetEnd))
+                    return true;
 
-            return false;
+                if (elementEnd == setEnd)
+                    return false;
+
+                elementStart = elementEnd + 1;
+            }
         }
 
         //==============================================================================
-        static bool matchStringSet (const StringArray& set, CharPtr pattern,
-                                    CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
+        static bool matchStringSetElement (CharPtr element, CharPtr elementEnd, CharPtr& target, CharPtr targetEnd)
         {
-            if (set.size() == 0)
-                return match (pattern, patternEnd, target, targetEnd);
-
-            for (auto& str : set)
-                if (str.getCharPointer().compareUpTo (target, str.length()) == 0)
-                    if (match (pattern, patternEnd, target + str.length(), targetEnd))
-                        return true;
+            for (; element != elementEnd; ++element, ++target)
+                if (target == targetEnd || *element != *target)
+                    return false;
 
-            return false;
+            return true;
         }
 
         //==============================================================================
@@ -150,8 +144,9 @@ namespace
             if (pattern == patternEnd)
                 return false;
 
-            Array<juce_wchar> set;
-            bool setIsNegated = false;
+            auto targetChar = target != targetEnd ? *target : 0;
+            juce_wchar lastCharInSet = 0;
+            bool setIsEmpty = true, setIsNegated = false, setContainsTarget = false;
 
             while (pattern != patternEnd)
             {
@@ -160,16 +155,43 @@ namespace
                 switch (c)
                 {
                     case ']':
-                        return matchCharSet (set, setIsNegated, pattern, patternEnd, target, targetEnd);
+                        if (setIsEmpty)
+                            return match (pattern, patternEnd, target, targetEnd);
+
+                        if (target == targetEnd || setContainsTarget == setIsNegated)
+                            return false;
+
+                        return match (pattern, patternEnd, target + 1, targetEnd);
 
                     case '-':
-                        if (! addCharRangeToSet (set, pattern, patternEnd, target, targetEnd))
+                    {
+                        if (target == targetEnd)
+                            return false;
+
+                        auto rangeEnd = pattern != patternEnd ? *pattern : 0;
+
+                        if (rangeEnd == ']')
+                        {
+                            // special case: '-' has no special meaning at the end.
+                            setIsEmpty = false;
+                            setContainsTarget = setContainsTarget || targetChar == '-';
+                            lastCharInSet = '-';
+                            break;
+                        }
+
+                        if (rangeEnd == ',' || rangeEnd == '{' || rangeEnd == '}' || setIsEmpty)
                             return false;
 
+                        if (targetChar > lastCharInSet && targetChar <= rangeEnd)
+                            setContainsTarget = true;
+
+                        lastCharInSet = jmax (lastCharInSet, (juce_wchar) rangeEnd);
+
                         break;
+                    }
 
                     case '!':
-                        if (set.size() == 0 && setIsNegated == false)
+                        if (setIsEmpty && setIsNegated == false)
                         {
                             setIsNegated = true;
                             break;
@@ -177,75 +199,15 @@ namespace
                         // else = special case: fall through to default and treat '!' as a non-special character.
 
                     default:
-                        set.add (c);
+                        setIsEmpty = false;
+                        setContainsTarget = setContainsTarget || (target != targetEnd && targetChar == c);
+                        lastCharInSet = c;
                         break;
                 }
             }
 
             return false;
         }
-
-        //==============================================================================
-        static bool matchCharSet (const Array<juce_wchar>& set, bool setIsNegated,
-                                  CharPtr pattern, CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            if (set.size() == 0)
-                return match (pattern, patternEnd, target, targetEnd);
-
-            if (target == targetEnd)
-                return false;
-
-            return setIsNegated ? matchCharSetNegated (set, pattern, patternEnd, target, targetEnd)
-                                : matchCharSetNotNegated (set, pattern, patternEnd, target, targetEnd);
-        }
-
-        //==============================================================================
-        static bool matchCharSetNegated (const Array<juce_wchar>& set, CharPtr pattern,
-                                         CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            for (auto c : set)
-                if (*target == c)
-                    return false;
-
-            return match (pattern, patternEnd, target + 1, targetEnd);
-        }
-
-        //==============================================================================
-        static bool matchCharSetNotNegated (const Array<juce_wchar>& set, CharPtr pattern,
-                                            CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            for (auto c : set)
-                if (*target == c)
-                    if (match (pattern, patternEnd, target + 1, targetEnd))
-                        return true;
-
-            return false;
-        }
-
-        //==============================================================================
-        static bool addCharRangeToSet (Array<juce_wchar>& set, CharPtr pattern,
-                                       CharPtr /*patternEnd*/, CharPtr target, CharPtr targetEnd)
-        {
-            if (target == targetEnd)
-                return false;
-
-            auto rangeStart = set.getLast();
-            auto rangeEnd = pattern.getAndAdvance();
-
-            if (rangeEnd == ']')
-            {
-                set.add ('-');  // special case: '-' has no special meaning at the end.
-                return true;
-            }
-
-            if (rangeEnd == ',' || rangeEnd == '{' || rangeEnd == '}' || set.size() == 0)
-                return false;
-
-            while (rangeEnd > rangeStart)
-                set.add (++rangeStart);
-
-            return true;
-        }
     };
 
     //==============================================================================
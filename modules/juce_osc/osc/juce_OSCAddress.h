@@ -79,6 +79,7 @@ private:
     StringArray oscSymbols;
     String asString;
     friend class OSCAddressPattern;
+    friend class OSCMessageView;
 };
 
 //==============================================================================
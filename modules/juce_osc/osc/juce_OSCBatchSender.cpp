@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct OSCBatchSender::Pimpl  : private Timer
+{
+    Pimpl (int maxSize, int maxPackets)
+        : maxPacketSize (jmax ((int) bundleHeaderSize + 16, maxSize)),
+          maxNumPackets (jmax (1, maxPackets)),
+          packetData ((size_t) maxPacketSize * (size_t) maxNumPackets),
+          packetPointers ((size_t) maxNumPackets),
+          packetSizes ((size_t) maxNumPackets)
+    {
+        for (int i = 0; i < maxNumPackets; ++i)
+            packetPointers[i] = getPacket (i);
+
+        setFlushInterval (10);
+    }
+
+    ~Pimpl()
+    {
+        stopTimer();
+        flush();
+    }
+
+    //==============================================================================
+    bool addTarget (const String& hostName, int portNumber)
+    {
+        ScopedPointer<Target> target (new Target());
+        target->hostName = hostName;
+        target->portNumber = portNumber;
+        target->socket = new DatagramSocket (true);
+
+        if (! target->socket->bindToPort (0)) // 0 = use any local port assigned by the OS.
+            return false;
+
+        const ScopedLock sl (lock);
+        targets.add (target.release());
+        return true;
+    }
+
+    void removeTarget (const String& hostName, int portNumber)
+    {
+        const ScopedLock sl (lock);
+
+        // the target should still get whatever was sent while it was a target
+        flushLocked();
+
+        for (int i = targets.size(); --i >= 0;)
+            if (targets.getUnchecked (i)->hostName == hostName && targets.getUnchecked (i)->portNumber == portNumber)
+                targets.remove (i);
+    }
+
+    void removeAllTargets()
+    {
+        const ScopedLock sl (lock);
+        flushLocked();
+        targets.clear();
+    }
+
+    int getNumTargets() const
+    {
+        const ScopedLock sl (lock);
+        return targets.size();
+    }
+
+    //==============================================================================
+    void setFlushInterval (int milliseconds)
+    {
+        const ScopedLock sl (lock);
+        flushInterval = (uint32) jmax (0, milliseconds);
+
+        if (flushInterval > 0)
+            startTimer ((int) flushInterval);
+        else
+            stopTimer();
+    }
+
+    void setUsesBundles (bool shouldUseBundles)
+    {
+        const ScopedLock sl (lock);
+
+        if (usesBundles != shouldUseBundles)
+        {
+            flushLocked();
+            usesBundles = shouldUseBundles;
+        }
+    }
+
+    //==============================================================================
+    bool send (const OSCMessage& message)
+    {
+        const ScopedLock sl (lock);
+
+        if (targets.isEmpty())
+            return false;
+
+        encoder.reset();
+
+        if (! encoder.writeMessage (message))
+            return false;
+
+        auto* data = static_cast<const char*> (encoder.getData());
+        auto size = (int) encoder.getDataSize();
+        bool ok = true;
+
+        if (size + (usesBundles ? (int) bundleHeaderSize + 4 : 0) > maxPacketSize)
+        {
+            // too big to share a packet, so this one goes on its own, keeping the messages in order
+            ok = flushLocked();
+            ok = sendToAllTargets (reinterpret_cast<const void* const*> (&data), &size, 1) && ok;
+            return ok;
+        }
+
+        if (numPackets == 0 || ! usesBundles || packetSizes[numPackets - 1] + size + 4 > maxPacketSize)
+        {
+            if (numPackets == maxNumPackets)
+                ok = flushLocked();
+
+            startPacket();
+        }
+
+        auto& packetSize = packetSizes[numPackets - 1];
+        auto* dest = getPacket (numPackets - 1) + packetSize;
+
+        if (usesBundles)
+        {
+            auto elementSize = ByteOrder::swapIfLittleEndian ((uint32) size);
+            memcpy (dest, &elementSize, 4);
+            dest += 4;
+            packetSize += 4;
+        }
+
+        memcpy (dest, data, (size_t) size);
+        packetSize += size;
+        ++numPendingMessages;
+
+        if (flushInterval > 0 && Time::getMillisecondCounter() - batchStartTime >= flushInterval)
+            ok = flushLocked() && ok;
+
+        return ok;
+    }
+
+    bool flush()
+    {
+        const ScopedLock sl (lock);
+        return flushLocked();
+    }
+
+    int getNumPendingMessages() const
+    {
+        const ScopedLock sl (lock);
+        return numPendingMessages;
+    }
+
+private:
+    //==============================================================================
+    struct Target
+    {
+        String hostName;
+        int portNumber = 0;
+        ScopedPointer<DatagramSocket> socket;
+    };
+
+    enum { bundleHeaderSize = 16 };
+
+    //==============================================================================
+    char* getPacket (int index) const noexcept
+    {
+        return packetData + (size_t) index * (size_t) maxPacketSize;
+    }
+
+    void startPacket() noexcept
+    {
+        if (numPackets == 0)
+            batchStartTime = Time::getMillisecondCounter();
+
+        auto* packet = getPacket (numPackets);
+        packetSizes[numPackets++] = 0;
+
+        if (usesBundles)
+        {
+            // "#bundle", followed by a time tag that means "immediately"
+            static const char header[] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+            static_assert (sizeof (header) == bundleHeaderSize, "wrong bundle header size");
+
+            memcpy (packet, header, sizeof (header));
+            packetSizes[numPackets - 1] = bundleHeaderSize;
+        }
+    }
+
+    bool flushLocked()
+    {
+        if (numPackets == 0)
+            return true;
+
+        auto ok = sendToAllTargets (packetPointers, packetSizes, numPackets);
+
+        numPackets = 0;
+        numPendingMessages = 0;
+        return ok;
+    }
+
+    bool sendToAllTargets (const void* const* datagrams, const int* sizes, int numDatagrams)
+    {
+        bool ok = true;
+
+        for (auto* target : targets)
+            ok = target->socket->writeMultiple (target->hostName, target->portNumber,
+                                                datagrams, sizes, numDatagrams) == numDatagrams
+                   && ok;
+
+        return ok;
+    }
+
+    void timerCallback() override
+    {
+        const ScopedLock sl (lock);
+
+        if (numPackets > 0 && Time::getMillisecondCounter() - batchStartTime >= flushInterval)
+            flushLocked();
+    }
+
+    //==============================================================================
+    const int maxPacketSize, maxNumPackets;
+    HeapBlock<char> packetData;
+    HeapBlock<const void*> packetPointers;
+    HeapBlock<int> packetSizes;
+    int numPackets = 0, numPendingMessages = 0;
+    uint32 flushInterval = 0, batchStartTime = 0;
+    bool usesBundles = true;
+
+    OSCOutputStream encoder;
+    OwnedArray<Target> targets;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+OSCBatchSender::OSCBatchSender (int maxPacketSize, int maxPacketsPerBatch)
+    : pimpl (new Pimpl (maxPacketSize, maxPacketsPerBatch))
+{
+}
+
+OSCBatchSender::~OSCBatchSender()
+{
+    pimpl = nullptr;
+}
+
+bool OSCBatchSender::addTarget (const String& host, int port)       { return pimpl->addTarget (host, port); }
+void OSCBatchSender::removeTarget (const String& host, int port)    { pimpl->removeTarget (host, port); }
+void OSCBatchSender::removeAllTargets()                             { pimpl->removeAllTargets(); }
+int OSCBatchSender::getNumTargets() const                           { return pimpl->getNumTargets(); }
+
+void OSCBatchSender::setFlushInterval (int milliseconds)            { pimpl->setFlushInterval (milliseconds); }
+void OSCBatchSender::setUsesBundles (bool shouldUseBundles)         { pimpl->setUsesBundles (shouldUseBundles); }
+
+bool OSCBatchSender::send (const OSCMessage& message)               { return pimpl->send (message); }
+bool OSCBatchSender::flush()                                        { return pimpl->flush(); }
+int OSCBatchSender::getNumPendingMessages() const                   { return pimpl->getNumPendingMessages(); }
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCBatchSenderTests  : public UnitTest
+{
+public:
+    OSCBatchSenderTests() : UnitTest ("OSCBatchSender class", "OSC") {}
+
+    void runTest()
+    {
+        DatagramSocket receiver (false);
+        expect (receiver.bindToPort (0, "127.0.0.1"));
+        auto port = receiver.getBoundPort();
+        const int numMessages = 500;
+
+        beginTest ("Packing messages into bundles");
+        {
+            OSCBatchSender sender;
+            sender.setFlushInterval (0);
+            expect (! sender.send (OSCMessage ("/nowhere")));
+            expect (sender.addTarget ("127.0.0.1", port));
+            expectEquals (sender.getNumTargets(), 1);
+
+            for (int i = 0; i < numMessages; ++i)
+                expect (sender.send (OSCMessage ("/meter", (int32) i, (float) i * 0.5f)));
+
+            expectEquals (sender.getNumPendingMessages(), numMessages);
+            expect (sender.flush());
+            expectEquals (sender.getNumPendingMessages(), 0);
+
+            Array<OSCMessage> messages;
+            auto numDatagrams = receiveMessages (receiver, messages);
+
+            expectEquals (messages.size(), numMessages);
+            expect (numDatagrams > 0 && numDatagrams < numMessages / 10);
+
+            for (int i = 0; i < messages.size(); ++i)
+            {
+                expect (messages.getReference (i).getAddressPattern().toString() == "/meter");
+                expectEquals (messages.getReference (i)[0].getInt32(), i);
+                expectEquals (messages.getReference (i)[1].getFloat32(), (float) i * 0.5f);
+            }
+        }
+
+        beginTest ("Sending separate datagrams");
+        {
+            OSCBatchSender sender;
+            sender.setFlushInterval (0);
+            sender.setUsesBundles (false);
+            expect (sender.addTarget ("127.0.0.1", port));
+
+            for (int i = 0; i < 20; ++i)
+                expect (sender.send (OSCMessage ("/meter", (int32) i)));
+
+            expect (sender.flush());
+
+            Array<OSCMessage> messages;
+            expectEquals (receiveMessages (receiver, messages), 20);
+            expectEquals (messages.size(), 20);
+        }
+
+        beginTest ("Sending oversized messages");
+        {
+            OSCBatchSender sender;
+            sender.setFlushInterval (0);
+            expect (sender.addTarget ("127.0.0.1", port));
+
+            MemoryBlock bigBlob (3000, true);
+
+            expect (sender.send (OSCMessage ("/first", (int32) 1)));
+            expect (sender.send (OSCMessage ("/big", bigBlob)));
+            expect (sender.send (OSCMessage ("/last", (int32) 2)));
+            expect (sender.flush());
+
+            Array<OSCMessage> messages;
+            expectEquals (receiveMessages (receiver, messages), 3);
+            expectEquals (messages.size(), 3);
+            expect (messages.getReference (1).getAddressPattern().toString() == "/big");
+            expect (messages.getReference (1)[0].getBlob() == bigBlob);
+            expect (messages.getReference (2).getAddressPattern().toString() == "/last");
+        }
+    }
+
+private:
+    static void addMessages (const OSCBundle::Element& element, Array<OSCMessage>& messages)
+    {
+        if (element.isMessage())
+            messages.add (element.getMessage());
+        else
+            for (auto& e : element.getBundle())
+                addMessages (e, messages);
+    }
+
+    int receiveMessages (DatagramSocket& socket, Array<OSCMessage>& messages)
+    {
+        HeapBlock<char> buffer (65536);
+        int numDatagrams = 0;
+
+        while (socket.waitUntilReady (true, 200) == 1)
+        {
+            int size = 0;
+
+            if (socket.readMultiple (buffer, 65536, 1, &size) != 1)
+                break;
+
+            OSCInputStream input (buffer, (size_t) size);
+            addMessages (input.readElementWithKnownSize ((size_t) size), messages);
+            ++numDatagrams;
+        }
+
+        return numDatagrams;
+    }
+};
+
+static OSCBatchSenderTests OSCBatchSenderUnitTests;
+
+#endif // JUCE_UNIT_TESTS
+
+} // namespace juce
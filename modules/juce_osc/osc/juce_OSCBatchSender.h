@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Sends OSC messages to one or more targets in batches.
+
+    When lots of small messages are being sent, e.g. a few hundred meter levels on
+    every display frame, the cost of making a system call for each datagram soon adds
+    up. An OSCBatchSender collects the messages that you give it and packs them into
+    OSC bundles that are as large as the network can carry without fragmenting them,
+    then sends the whole batch to each target in one go.
+
+    The batch is sent when flush() is called, when it's big enough to fill all of
+    the sender's packets, or when the flush interval has passed since the oldest
+    message in it was added. The packets are allocated up-front, so sending doesn't
+    allocate any memory once the first few messages have been encoded.
+
+    Note that an OSCReceiver passes the messages in a bundle to its Listeners'
+    oscBundleReceived() callbacks, not to any ListenerWithOSCAddress objects. If the
+    receiver relies on those, call setUsesBundles (false) to send each message as a
+    datagram of its own; they'll still be sent in batches.
+
+    OSCBatchSender is thread-safe, so messages can be added from any thread.
+
+    @see OSCSender
+*/
+class JUCE_API  OSCBatchSender
+{
+public:
+    //==============================================================================
+    /** The largest datagram that fits into a standard 1500-byte Ethernet frame
+        with an IPv4 header.
+    */
+    enum { defaultMaxPacketSize = 1472 };
+
+    /** Creates a sender.
+
+        @param maxPacketSize        the largest number of bytes to put into each datagram
+        @param maxPacketsPerBatch   the number of datagrams to allocate; when they're all
+                                    full, the batch is sent
+    */
+    OSCBatchSender (int maxPacketSize = defaultMaxPacketSize, int maxPacketsPerBatch = 64);
+
+    /** Destructor. Any messages that haven't been sent yet are flushed. */
+    ~OSCBatchSender();
+
+    //==============================================================================
+    /** Adds a target that the messages should be sent to.
+        @returns true if a socket could be opened for sending to the target.
+    */
+    bool addTarget (const String& targetHostName, int targetPortNumber);
+
+    /** Stops sending messages to a target that was added with addTarget(). */
+    void removeTarget (const String& targetHostName, int targetPortNumber);
+
+    /** Removes all the targets. */
+    void removeAllTargets();
+
+    /** Returns the number of targets that the messages are being sent to. */
+    int getNumTargets() const;
+
+    //==============================================================================
+    /** Sets how long a message may wait in a batch before the batch is sent.
+
+        The batch is checked whenever a message is added, and by a timer on the
+        message thread. A value of 0 turns this off, so that batches are only sent
+        when they're full or flush() is called. The default is 10 milliseconds.
+    */
+    void setFlushInterval (int milliseconds);
+
+    /** Chooses whether messages are packed together into bundles, or sent as separate
+        datagrams. Any messages that are waiting are flushed first. By default bundles
+        are used.
+    */
+    void setUsesBundles (bool shouldUseBundles);
+
+    //==============================================================================
+    /** Adds a message to the batch.
+
+        A message that is too big for a single packet is sent straight away, after
+        any messages that were added before it.
+
+        @returns false if the message couldn't be encoded, if there are no targets,
+                 or if sending a batch that was triggered by this message failed.
+    */
+    bool send (const OSCMessage& message);
+
+   #if JUCE_COMPILER_SUPPORTS_VARIADIC_TEMPLATES
+    /** Creates a new OSC message with the specified address pattern and list
+        of arguments, and adds it to the batch.
+
+        @param  address  The OSC address pattern of the message
+                         (you can use a string literal here).
+        @param  args     The list of arguments for the message.
+    */
+    template <typename... Args>
+    bool send (const OSCAddressPattern& address, Args&&... args)
+    {
+        return send (OSCMessage (address, std::forward<Args> (args)...));
+    }
+   #endif
+
+    /** Sends all the messages that are waiting to every target.
+        @returns true if all of the packets were sent to all of the targets.
+    */
+    bool flush();
+
+    /** Returns the number of messages that are waiting to be sent. */
+    int getNumPendingMessages() const;
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    friend struct Pimpl;
+    friend struct ContainerDeletePolicy<Pimpl>;
+    ScopedPointer<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCBatchSender)
+};
+
+} // namespace juce
@@ -37,7 +37,7 @@ void OSCMessage::setAddressPattern (const OSCAddressPattern& ap) noexcept
     addressPattern = ap;
 }
 
-OSCAddressPattern OSCMessage::getAddressPattern() const noexcept
+const OSCAddressPattern& OSCMessage::getAddressPattern() const noexcept
 {
     return addressPattern;
 }
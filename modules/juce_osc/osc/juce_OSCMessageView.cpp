@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    //==============================================================================
+    // These return the position just after the item that they skip, or 0 if the
+    // data is malformed (every item takes up at least 4 bytes, so 0 is never valid).
+    static size_t skipOSCPaddingZeros (const char* data, size_t dataSize, size_t itemStart, size_t itemEnd) noexcept
+    {
+        auto paddedEnd = itemStart + ((itemEnd - itemStart + 3) & ~(size_t) 3);
+
+        if (paddedEnd > dataSize)
+            return 0;
+
+        for (auto i = itemEnd; i < paddedEnd; ++i)
+            if (data[i] != 0)
+                return 0;
+
+        return paddedEnd;
+    }
+
+    static size_t skipOSCString (const char* data, size_t dataSize, size_t pos) noexcept
+    {
+        if (dataSize - pos < 4)
+            return 0;
+
+        auto* terminator = static_cast<const char*> (std::memchr (data + pos, 0, dataSize - pos));
+
+        if (terminator == nullptr)
+            return 0;
+
+        return skipOSCPaddingZeros (data, dataSize, pos, (size_t) (terminator - data) + 1);
+    }
+
+    static size_t skipOSCBlob (const char* data, size_t dataSize, size_t pos) noexcept
+    {
+        if (dataSize - pos < 4)
+            return 0;
+
+        auto blobSize = (size_t) (uint32) ByteOrder::bigEndianInt (data + pos);
+        pos += 4;
+
+        if (blobSize > dataSize - pos)
+            return 0;
+
+        return blobSize == 0 ? pos : skipOSCPaddingZeros (data, dataSize, pos, pos + blobSize);
+    }
+
+    static bool isValidOSCAddressPatternChar (char c) noexcept
+    {
+        return c > ' ' && c <= '~' && c != '#';
+    }
+}
+
+//==============================================================================
+void OSCMessageView::clear() noexcept
+{
+    data = nullptr;
+    addressPattern = nullptr;
+    typeTags = nullptr;
+    addressPatternLength = 0;
+    numArguments = 0;
+    patternHasWildcards = false;
+}
+
+bool OSCMessageView::parse (const void* sourceData, size_t dataSize) noexcept
+{
+    clear();
+
+    auto* d = static_cast<const char*> (sourceData);
+
+    if (d == nullptr || dataSize == 0 || dataSize > 0x7fffffff || d[0] != '/')
+        return false;
+
+    // address pattern
+    auto pos = skipOSCString (d, dataSize, 0);
+
+    if (pos == 0)
+        return false;
+
+    auto patternLength = std::strlen (d);
+    bool hasWildcards = false;
+
+    for (size_t i = 0; i < patternLength; ++i)
+    {
+        auto c = d[i];
+
+        if (c != '/' && ! isValidOSCAddressPatternChar (c))
+            return false;
+
+        hasWildcards = hasWildcards || c == '*' || c == '?' || c == '{' || c == '}' || c == '[' || c == ']';
+    }
+
+    while (patternLength > 0 && d[patternLength - 1] == '/')
+        --patternLength;
+
+    // type tag string
+    auto typeTagStart = pos;
+
+    if (dataSize - pos < 4 || d[pos] != ',')
+        return false;
+
+    pos = skipOSCString (d, dataSize, pos);
+
+    if (pos == 0)
+        return false;
+
+    auto* tags = d + typeTagStart + 1;
+    auto numTags = std::strlen (tags);
+
+    if (numTags > (size_t) maxNumArguments)
+        return false;
+
+    // arguments
+    for (size_t i = 0; i < numTags; ++i)
+    {
+        argumentOffsets[i] = (uint32) pos;
+
+        switch (tags[i])
+        {
+            case OSCTypes::int32:
+            case OSCTypes::float32:     pos = dataSize - pos >= 4 ? pos + 4 : 0; break;
+            case OSCTypes::string:      pos = skipOSCString (d, dataSize, pos); break;
+            case OSCTypes::blob:        pos = skipOSCBlob (d, dataSize, pos); break;
+            default:                    return false;
+        }
+
+        if (pos == 0)
+            return false;
+    }
+
+    if (pos != dataSize)
+        return false;
+
+    data = d;
+    addressPattern = d;
+    addressPatternLength = patternLength;
+    patternHasWildcards = hasWildcards;
+    typeTags = tags;
+    numArguments = (int) numTags;
+    return true;
+}
+
+//==============================================================================
+bool OSCMessageView::matches (const OSCAddress& address) const noexcept
+{
+    if (addressPattern == nullptr)
+        return false;
+
+    if (! patternHasWildcards)
+    {
+        auto* target = address.asString.toRawUTF8();
+
+        return std::strncmp (target, addressPattern, addressPatternLength) == 0
+                && target[addressPatternLength] == 0;
+    }
+
+    // compare the pattern's symbols to the address's in the same way as OSCAddressPattern,
+    // skipping the empty ones between repeated slashes
+    auto* p = addressPattern;
+    auto* patternEnd = addressPattern + addressPatternLength;
+
+    for (auto& symbol : address.oscSymbols)
+    {
+        while (p != patternEnd && *p == '/')
+            ++p;
+
+        if (p == patternEnd)
+            return false;
+
+        auto* symbolEnd = p;
+
+        while (symbolEnd != patternEnd && *symbolEnd != '/')
+            ++symbolEnd;
+
+        CharPointer_UTF8 target (symbol.toRawUTF8());
+
+        if (! OSCPatternMatcherImpl<CharPointer_UTF8>::match (CharPointer_UTF8 (p), CharPointer_UTF8 (symbolEnd),
+                                                              target, target.findTerminatingNull()))
+            return false;
+
+        p = symbolEnd;
+    }
+
+    while (p != patternEnd && *p == '/')
+        ++p;
+
+    return p == patternEnd;
+}
+
+//==============================================================================
+OSCType OSCMessageView::getType (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numArguments));
+    return typeTags[index];
+}
+
+int32 OSCMessageView::getInt32 (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::int32);
+    return (int32) ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+}
+
+float OSCMessageView::getFloat32 (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::float32);
+
+    union { uint32 asInt; float asFloat; } value;
+    value.asInt = ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+    return value.asFloat;
+}
+
+const char* OSCMessageView::getString (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::string);
+    return data + argumentOffsets[index];
+}
+
+const void* OSCMessageView::getBlobData (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::blob);
+    return data + argumentOffsets[index] + 4;
+}
+
+size_t OSCMessageView::getBlobSize (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::blob);
+    return (size_t) ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+}
+
+//==============================================================================
+OSCMessage OSCMessageView::toMessage() const
+{
+    jassert (addressPattern != nullptr); // the view must hold a message that was parsed successfully!
+
+    OSCMessage message (OSCAddressPattern (String::fromUTF8 (addressPattern, (int) addressPatternLength)));
+
+    for (int i = 0; i < numArguments; ++i)
+    {
+        switch (typeTags[i])
+        {
+            case OSCTypes::int32:       message.addInt32 (getInt32 (i)); break;
+            case OSCTypes::float32:     message.addFloat32 (getFloat32 (i)); break;
+            case OSCTypes::string:      message.addString (String::fromUTF8 (getString (i))); break;
+            case OSCTypes::blob:        message.addBlob (MemoryBlock (getBlobData (i), getBlobSize (i))); break;
+            default:                    jassertfalse; break;
+        }
+    }
+
+    return message;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageViewTests  : public UnitTest
+{
+public:
+    OSCMessageViewTests() : UnitTest ("OSCMessageView class", "OSC") {}
+
+    void runTest()
+    {
+        beginTest ("parsing messages");
+        {
+            const uint8 data[] = {
+                '/', 'f', 'o', 'o', '/', 'b', 'a', 'r', 0, 0, 0, 0,
+                ',', 'i', 'f', 's', 'b', 0, 0, 0,
+                0xff, 0xff, 0xff, 0xfe,
+                0x40, 0x49, 0x0f, 0xdb,
+                'h', 'e', 'l', 'l', 'o', 0, 0, 0,
+                0x00, 0x00, 0x00, 0x03, 0x01, 0x02, 0x03, 0x00
+            };
+
+            OSCMessageView view;
+            expect (view.parse (data, sizeof (data)));
+
+            expectEquals (String (view.getAddressPattern()), String ("/foo/bar"));
+            expect (! view.containsWildcards());
+            expectEquals (view.size(), 4);
+
+            expectEquals (view.getType (0), OSCTypes::int32);
+            expectEquals (view.getType (1), OSCTypes::float32);
+            expectEquals (view.getType (2), OSCTypes::string);
+            expectEquals (view.getType (3), OSCTypes::blob);
+
+            expectEquals (view.getInt32 (0), -2);
+            expectWithinAbsoluteError (view.getFloat32 (1), 3.14159f, 0.00001f);
+            expectEquals (String (view.getString (2)), String ("hello"));
+            expectEquals ((int) view.getBlobSize (3), 3);
+            expect (std::memcmp (view.getBlobData (3), data + 40, 3) == 0);
+
+            auto message = view.toMessage();
+            expect (message.getAddressPattern() == OSCAddressPattern ("/foo/bar"));
+            expectEquals (message.size(), 4);
+            expectEquals (message[0].getInt32(), -2);
+            expectEquals (message[1].getFloat32(), view.getFloat32 (1));
+            expectEquals (message[2].getString(), String ("hello"));
+            expect (message[3].getBlob() == MemoryBlock (data + 40, 3));
+
+            const uint8 emptyMessage[] = { '/', 'a', 0, 0, ',', 0, 0, 0 };
+            expect (view.parse (emptyMessage, sizeof (emptyMessage)));
+            expect (view.isEmpty());
+        }
+
+        beginTest ("rejecting corrupted messages");
+        {
+            OSCMessageView view;
+
+            const uint8 noTypeTags[] = { '/', 'a', 0, 0, 0x00, 0x00, 0x00, 0x01 };
+            expect (! view.parse (noTypeTags, sizeof (noTypeTags)));
+            expect (view.getAddressPattern() == nullptr);
+
+            const uint8 badPadding[] = { '/', 'a', 0, 1, ',', 0, 0, 0 };
+            expect (! view.parse (badPadding, sizeof (badPadding)));
+
+            const uint8 badAddress[] = { '/', ' ', 0, 0, ',', 0, 0, 0 };
+            expect (! view.parse (badAddress, sizeof (badAddress)));
+
+            const uint8 badType[] = { '/', 'a', 0, 0, ',', 'x', 0, 0, 0, 0, 0, 0 };
+            expect (! view.parse (badType, sizeof (badType)));
+
+            const uint8 truncatedInt[] = { '/', 'a', 0, 0, ',', 'i', 0, 0, 0, 0 };
+            expect (! view.parse (truncatedInt, sizeof (truncatedInt)));
+
+            const uint8 trailingData[] = { '/', 'a', 0, 0, ',', 0, 0, 0, 0, 0, 0, 0 };
+            expect (! view.parse (trailingData, sizeof (trailingData)));
+
+            const uint8 oversizedBlob[] = { '/', 'a', 0, 0, ',', 'b', 0, 0, 0x7f, 0xff, 0xff, 0xff, 0, 0, 0, 0 };
+            expect (! view.parse (oversizedBlob, sizeof (oversizedBlob)));
+
+            const uint8 unterminatedString[] = { '/', 'a', 0, 0, ',', 's', 0, 0, 'a', 'b', 'c', 'd' };
+            expect (! view.parse (unterminatedString, sizeof (unterminatedString)));
+        }
+
+        beginTest ("matching addresses");
+        {
+            const char* patterns[] = { "/a/b", "/a/b/", "/a//b", "/*/b", "/?/b", "/a/*", "/[a-c]/b", "/[!a]/b",
+                                       "/{a,bb}/b", "/{a,bb}/*", "/*", "/a/b/c", "/a/{b,c}/?", "/[]a/b", "/a/[-]" };
+
+            const char* addresses[] = { "/a/b", "/a", "/b/b", "/bb/b", "/a/b/c", "/a/c/d", "/c/b", "/a/-" };
+
+            for (auto* pattern : patterns)
+            {
+                MemoryBlock block;
+                block.append (pattern, std::strlen (pattern) + 1);
+
+                while (block.getSize() % 4 != 0)
+                    block.append ("", 1);
+
+                block.append (",\0\0\0", 4);
+
+                OSCMessageView view;
+                expect (view.parse (block.getData(), block.getSize()));
+
+                for (auto* address : addresses)
+                    expect (view.matches (OSCAddress (address)) == OSCAddressPattern (pattern).matches (OSCAddress (address)),
+                            String (pattern) + " vs " + address);
+            }
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
+#endif // JUCE_UNIT_TESTS
+
+} // namespace juce
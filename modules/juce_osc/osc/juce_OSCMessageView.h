@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A read-only view of an OSC message that is stored in a block of binary data,
+    e.g. a packet that has just arrived from the network.
+
+    Unlike OSCMessage, an OSCMessageView doesn't copy anything out of the data:
+    its address pattern, strings and blobs are returned as pointers into the data,
+    so parsing and reading a message never allocates any memory, and is safe to
+    do on a realtime thread. The data must stay valid for as long as the view is
+    being used.
+
+    The data is checked with the same rules as the OSCReceiver uses when it creates
+    OSCMessage objects, but messages with more than maxNumArguments arguments are
+    rejected.
+
+    @see OSCReceiver::ViewListener, OSCMessage
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** The largest number of arguments that a message may have. */
+    enum { maxNumArguments = 64 };
+
+    /** Creates an empty view. */
+    OSCMessageView() noexcept {}
+
+    /** Points the view at a block of data which contains exactly one OSC message.
+
+        @returns true if the data is a valid OSC message. If it isn't, the view
+                 is left empty and false is returned.
+    */
+    bool parse (const void* data, size_t dataSize) noexcept;
+
+    //==============================================================================
+    /** Returns the message's address pattern as a null-terminated string within the
+        message data, or nullptr if the view is empty.
+    */
+    const char* getAddressPattern() const noexcept      { return addressPattern; }
+
+    /** Checks whether the address pattern contains any of the OSC wildcards. */
+    bool containsWildcards() const noexcept             { return patternHasWildcards; }
+
+    /** Checks if the message's address pattern matches an OSC address.
+        This gives the same result as OSCAddressPattern::matches(), without allocating.
+    */
+    bool matches (const OSCAddress& address) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept                           { return numArguments; }
+
+    /** Returns true if the message has no arguments. */
+    bool isEmpty() const noexcept                       { return numArguments == 0; }
+
+    /** Returns the type tag of one of the arguments. */
+    OSCType getType (int index) const noexcept;
+
+    /** Returns the value of an int32 argument.
+        If the argument isn't an int32, the behaviour is undefined.
+    */
+    int32 getInt32 (int index) const noexcept;
+
+    /** Returns the value of a float32 argument.
+        If the argument isn't a float32, the behaviour is undefined.
+    */
+    float getFloat32 (int index) const noexcept;
+
+    /** Returns a string argument as a null-terminated UTF-8 string within the message data.
+        If the argument isn't a string, the behaviour is undefined.
+    */
+    const char* getString (int index) const noexcept;
+
+    /** Returns a pointer to the data of a blob argument within the message data.
+        If the argument isn't a blob, the behaviour is undefined.
+    */
+    const void* getBlobData (int index) const noexcept;
+
+    /** Returns the number of bytes in a blob argument.
+        If the argument isn't a blob, the behaviour is undefined.
+    */
+    size_t getBlobSize (int index) const noexcept;
+
+    //==============================================================================
+    /** Creates an OSCMessage that holds a copy of the viewed message.
+        Unlike the rest of this class, this has to allocate memory.
+    */
+    OSCMessage toMessage() const;
+
+private:
+    //==============================================================================
+    const char* data = nullptr;
+    const char* addressPattern = nullptr;
+    const char* typeTags = nullptr;
+    size_t addressPatternLength = 0;
+    uint32 argumentOffsets[maxNumArguments];
+    int numArguments = 0;
+    bool patternHasWildcards = false;
+
+    void clear() noexcept;
+};
+
+} // namespace juce
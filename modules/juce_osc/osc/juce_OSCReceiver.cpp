@@ -314,12 +314,271 @@ namespace
         }
     };
 
+    //==============================================================================
+    /** Checks a block of OSC data with the same rules as OSCInputStream, without
+        allocating, and calls the visitor for each message that it contains.
+    */
+    template <typename Visitor>
+    static bool visitOSCMessages (const char* data, size_t dataSize, Visitor& visitor)
+    {
+        if (data[0] == '/')
+        {
+            OSCMessageView message;
+
+            if (! message.parse (data, dataSize))
+                return false;
+
+            visitor (message);
+            return true;
+        }
+
+        if (dataSize < 16 || std::memcmp (data, "#bundle", 8) != 0)
+            return false;
+
+        for (size_t pos = 16; pos < dataSize;)
+        {
+            if (dataSize - pos < 4)
+                return false;
+
+            auto elementSize = (size_t) (uint32) ByteOrder::bigEndianInt (data + pos);
+            pos += 4;
+
+            if (elementSize < 4 || elementSize > dataSize - pos
+                 || ! visitOSCMessages (data + pos, elementSize, visitor))
+                return false;
+
+            pos += elementSize;
+        }
+
+        return true;
+    }
+
+    template <typename Visitor>
+    static bool forEachOSCMessage (const char* data, size_t dataSize, Visitor visitor)
+    {
+        if (data[0] != '/')
+        {
+            // a bundle has to be checked all the way through before any of its
+            // messages are delivered
+            auto ignoreMessage = [] (const OSCMessageView&) {};
+
+            if (! visitOSCMessages (data, dataSize, ignoreMessage))
+                return false;
+        }
+
+        return visitOSCMessages (data, dataSize, visitor);
+    }
+
 } // namespace
 
+//==============================================================================
+/** Holds the listeners that were registered with an OSCAddress, arranged as a
+    tree of address symbols, so that finding the listeners for a message takes
+    time proportional to the length of its address pattern rather than to the
+    number of listeners.
+
+    The matches are the same as OSCAddressPattern::matches() would find, but the
+    order in which the listeners are called isn't defined.
+*/
+template <typename ListenerType>
+class OSCAddressListenerTree
+{
+public:
+    OSCAddressListenerTree() noexcept {}
+
+    bool isEmpty() const noexcept     { return numEntries == 0; }
+
+    void add (const OSCAddress& address, ListenerType* listener)
+    {
+        auto* node = &root;
+
+        for (auto& symbol : StringArray::fromTokens (address.toString(), "/", StringRef()))
+            if (symbol.isNotEmpty())
+                node = node->getOrCreateChild (symbol);
+
+        for (auto& entry : node->entries)
+            if (entry.first == address && entry.second == listener)
+                return;
+
+        node->entries.add (std::make_pair (address, listener));
+        ++numEntries;
+    }
+
+    void remove (ListenerType* listener)
+    {
+        numEntries -= root.removeListener (listener);
+    }
+
+    /** Calls the callback for each listener whose address matches a pattern. The
+        pattern must be trimmed of any trailing slashes, like OSCAddressPattern::toString().
+    */
+    template <typename Callback>
+    void callMatchingListeners (const char* pattern, size_t patternLength,
+                                bool patternHasWildcards, Callback&& callback) const
+    {
+        if (numEntries > 0)
+            root.callMatchingListeners (pattern, pattern + patternLength, pattern, patternLength,
+                                        patternHasWildcards, callback);
+    }
+
+private:
+    //==============================================================================
+    struct Node
+    {
+        String symbol;
+        size_t symbolLength = 0;
+        OwnedArray<Node> children; // sorted by symbol
+        Array<std::pair<OSCAddress, ListenerType*>> entries;
+
+        static int compare (const char* a, size_t aLength, const char* b, size_t bLength) noexcept
+        {
+            if (auto diff = std::memcmp (a, b, jmin (aLength, bLength)))
+                return diff;
+
+            return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+        }
+
+        int findChildIndex (const char* s, size_t length, bool& found) const noexcept
+        {
+            int start = 0, end = children.size();
+
+            while (start < end)
+            {
+                auto middle = (start + end) / 2;
+                auto* child = children.getUnchecked (middle);
+                auto diff = compare (s, length, child->symbol.toRawUTF8(), child->symbolLength);
+
+                if (diff == 0)
+                {
+                    found = true;
+                    return middle;
+                }
+
+                if (diff < 0)
+                    end = middle;
+                else
+                    start = middle + 1;
+            }
+
+            found = false;
+            return start;
+        }
+
+        Node* getOrCreateChild (const String& s)
+        {
+            bool found;
+            auto index = findChildIndex (s.toRawUTF8(), s.getNumBytesAsUTF8(), found);
+
+            if (found)
+                return children.getUnchecked (index);
+
+            auto* child = children.insert (index, new Node());
+            child->symbol = s;
+            child->symbolLength = s.getNumBytesAsUTF8();
+            return child;
+        }
+
+        int removeListener (ListenerType* listener)
+        {
+            int numRemoved = 0;
+
+            for (int i = entries.size(); --i >= 0;)
+            {
+                if (entries.getReference (i).second == listener)
+                {
+                    // can't simply call entries.remove (i) because this requires
+                    // a default c'tor to be present for OSCAddress...
+                    for (int j = i; j < entries.size() - 1; ++j)
+                        entries.swap (j, j + 1);
+
+                    entries.removeLast();
+                    ++numRemoved;
+                }
+            }
+
+            for (int i = children.size(); --i >= 0;)
+            {
+                auto* child = children.getUnchecked (i);
+                numRemoved += child->removeListener (listener);
+
+                if (child->entries.isEmpty() && child->children.isEmpty())
+                    children.remove (i);
+            }
+
+            return numRemoved;
+        }
+
+        template <typename Callback>
+        void callMatchingListeners (const char* p, const char* end,
+                                    const char* pattern, size_t patternLength,
+                                    bool patternHasWildcards, Callback& callback) const
+        {
+            // empty symbols between repeated slashes are skipped, as OSCAddressTokeniser does
+            while (p != end && *p == '/')
+                ++p;
+
+            if (p == end)
+            {
+                for (auto& entry : entries)
+                    if (patternHasWildcards || matchesExactly (entry.first, pattern, patternLength))
+                        callback (entry.second);
+
+                return;
+            }
+
+            auto* symbolEnd = p;
+            bool symbolHasWildcards = false;
+
+            for (; symbolEnd != end && *symbolEnd != '/'; ++symbolEnd)
+                symbolHasWildcards = symbolHasWildcards || isWildcard (*symbolEnd);
+
+            if (! symbolHasWildcards)
+            {
+                bool found;
+                auto index = findChildIndex (p, (size_t) (symbolEnd - p), found);
+
+                if (found)
+                    children.getUnchecked (index)->callMatchingListeners (symbolEnd, end, pattern, patternLength,
+                                                                          patternHasWildcards, callback);
+                return;
+            }
+
+            for (auto* child : children)
+            {
+                CharPointer_UTF8 target (child->symbol.toRawUTF8());
+
+                if (OSCPatternMatcherImpl<CharPointer_UTF8>::match (CharPointer_UTF8 (p), CharPointer_UTF8 (symbolEnd),
+                                                                    target, target + (int) child->symbolLength))
+                    child->callMatchingListeners (symbolEnd, end, pattern, patternLength,
+                                                  patternHasWildcards, callback);
+            }
+        }
+
+        static bool isWildcard (char c) noexcept
+        {
+            return c == '*' || c == '?' || c == '{' || c == '}' || c == '[' || c == ']';
+        }
+
+        static bool matchesExactly (const OSCAddress& address, const char* pattern, size_t patternLength) noexcept
+        {
+            // a pattern without wildcards is compared to the whole address string, like
+            // OSCAddressPattern::matches() does, which matters if it has repeated slashes
+            auto* s = address.toString().toRawUTF8();
+            return std::strncmp (s, pattern, patternLength) == 0 && s[patternLength] == 0;
+        }
+    };
+
+    Node root;
+    int numEntries = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (OSCAddressListenerTree)
+};
+
 
 //==============================================================================
 struct OSCReceiver::Pimpl   : private Thread,
-                              private MessageListener
+                              private MessageListener,
+                              private SocketReactor::Listener
 {
     Pimpl()
       : Thread ("Juce OSC server"),
@@ -344,6 +603,12 @@ struct OSCReceiver::Pimpl   : private Thread,
         if (! socket->bindToPort (portNumber))
             return false;
 
+        if (socketReactor != nullptr && socketReactor->addSocket (*socket, this))
+        {
+            usingReactor = true;
+            return true;
+        }
+
         startThread();
         return true;
     }
@@ -352,6 +617,12 @@ struct OSCReceiver::Pimpl   : private Thread,
     {
         if (socket != nullptr)
         {
+            if (usingReactor)
+            {
+                socketReactor->removeSocket (socket->getRawSocketHandle());
+                usingReactor = false;
+            }
+
             signalThreadShouldExit();
             socket->shutdown();
             waitForThreadToExit (10000);
@@ -360,6 +631,11 @@ struct OSCReceiver::Pimpl   : private Thread,
         return true;
     }
 
+    void setSocketReactor (SocketReactor* reactorToUse) noexcept
+    {
+        socketReactor = reactorToUse;
+    }
+
     //==============================================================================
     void addListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToAdd)
     {
@@ -374,13 +650,23 @@ struct OSCReceiver::Pimpl   : private Thread,
     void addListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress);
+        listenersWithAddress.add (addressToMatch, listenerToAdd);
     }
 
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.add (addressToMatch, listenerToAdd);
+    }
+
+    void addListener (OSCReceiver::ViewListener* listenerToAdd)
+    {
+        viewListeners.add (listenerToAdd);
+    }
+
+    void addListener (OSCReceiver::ViewListener* listenerToAdd, OSCAddress addressToMatch)
+    {
+        viewListenersWithAddress.add (addressToMatch, listenerToAdd);
     }
 
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
@@ -395,25 +681,48 @@ struct OSCReceiver::Pimpl   : private Thread,
 
     void removeListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, listenersWithAddress);
+        listenersWithAddress.remove (listenerToRemove);
     }
 
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.remove (listenerToRemove);
     }
 
-    //==============================================================================
-    struct CallbackMessage   : public Message
+    void removeListener (OSCReceiver::ViewListener* listenerToRemove)
     {
-        CallbackMessage (OSCBundle::Element oscElement)  : content (oscElement) {}
+        viewListeners.remove (listenerToRemove);
+        viewListenersWithAddress.remove (listenerToRemove);
+    }
 
-        // the payload of the message. Can be either an OSCMessage or an OSCBundle.
-        OSCBundle::Element content;
-    };
+    //==============================================================================
+    // Tells the message thread that there's some content waiting in pendingContent.
+    struct CallbackMessage   : public Message {};
 
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
+    {
+        bool needsViews = viewListeners.size() > 0 || ! viewListenersWithAddress.isEmpty();
+        bool needsObjects = realtimeListeners.size() > 0 || ! realtimeListenersWithAddress.isEmpty()
+                             || listeners.size() > 0 || ! listenersWithAddress.isEmpty();
+        bool isValid = true;
+
+        // the view listeners get the content first, and this is also a cheap way to check
+        // the data when there's nobody who needs it turned into OSCMessage objects
+        if (needsViews || ! needsObjects)
+            isValid = forEachOSCMessage (data, dataSize, [this] (const OSCMessageView& message)
+                                                         {
+                                                             callViewListeners (message);
+                                                         });
+
+        if (needsObjects)
+            isValid = handleBufferContent (data, dataSize);
+
+        if (! isValid && formatErrorHandler != nullptr)
+            formatErrorHandler (data, (int) dataSize);
+    }
+
+    bool handleBufferContent (const char* data, size_t dataSize)
     {
         OSCInputStream inStream (data, dataSize);
 
@@ -428,18 +737,36 @@ struct OSCReceiver::Pimpl   : private Thread,
             if (content.isMessage())
                 callRealtimeListenersWithAddress (content.getMessage());
 
-            // now post the message that will trigger the handleMessage callback
-            // dealing with the non-realtime listeners.
-            if (listeners.size() > 0 || listenersWithAddress.size() > 0)
-                postMessage (new CallbackMessage (content));
+            // now queue the content for the handleMessage callback dealing with the
+            // non-realtime listeners.
+            if (listeners.size() > 0 || ! listenersWithAddress.isEmpty())
+                addPendingContent (content);
+
+            return true;
         }
         catch (OSCFormatError)
         {
-            if (formatErrorHandler != nullptr)
-                formatErrorHandler (data, (int) dataSize);
+            return false;
         }
     }
 
+    //==============================================================================
+    void addPendingContent (const OSCBundle::Element& content)
+    {
+        bool needsPosting;
+
+        {
+            const ScopedLock sl (pendingContentLock);
+            needsPosting = pendingContent.isEmpty();
+            pendingContent.add (content);
+        }
+
+        // only one message is posted for each batch of content, however fast it
+        // arrives, so that a busy stream can't flood the message queue.
+        if (needsPosting)
+            postMessage (new CallbackMessage());
+    }
+
     //==============================================================================
     void registerFormatErrorHandler (OSCReceiver::FormatErrorHandler handler)
     {
@@ -453,62 +780,49 @@ private:
         while (! threadShouldExit())
         {
             jassert (socket != nullptr);
-            char buffer[oscBufferSize];
             socket->waitUntilReady (true, -1);
 
             if (threadShouldExit())
                 return;
 
-            auto bytesRead = (size_t) socket->read (buffer, (int) sizeof (buffer), false);
-
-            if (bytesRead >= 4)
-                handleBuffer (buffer, bytesRead);
+            readAvailableDatagrams();
         }
     }
 
-    //==============================================================================
-    template <typename ListenerType>
-    void addListenerWithAddress (ListenerType* listenerToAdd,
-                                 OSCAddress address,
-                                 Array<std::pair<OSCAddress, ListenerType*>>& array)
+    void socketReadyForReading (int) override
     {
-        for (auto& i : array)
-            if (address == i.first && listenerToAdd == i.second)
-                return;
-
-        array.add (std::make_pair (address, listenerToAdd));
+        readAvailableDatagrams();
     }
 
-    //==============================================================================
-    template <typename ListenerType>
-    void removeListenerWithAddress (ListenerType* listenerToRemove,
-                                    Array<std::pair<OSCAddress, ListenerType*>>& array)
+    void readAvailableDatagrams()
     {
-        for (int i = 0; i < array.size(); ++i)
-        {
-            if (listenerToRemove == array.getReference (i).second)
-            {
-                // aarrgh... can't simply call array.remove (i) because this
-                // requires a default c'tor to be present for OSCAddress...
-                // luckily, we don't care about methods preserving element order:
-                array.swap (i, array.size() - 1);
-                array.removeLast();
-                break;
-            }
-        }
+        // fetch everything that has arrived since the last wake-up in one go
+        auto numDatagrams = socket->readMultiple (datagramBuffers, oscBufferSize, maxDatagramsPerRead, datagramSizes);
+
+        for (int i = 0; i < numDatagrams; ++i)
+            if (datagramSizes[i] >= 4)
+                handleBuffer (datagramBuffers + (size_t) i * oscBufferSize, (size_t) datagramSizes[i]);
     }
 
     //==============================================================================
     void handleMessage (const Message& msg) override
     {
-        if (auto* callbackMessage = dynamic_cast<const CallbackMessage*> (&msg))
+        if (dynamic_cast<const CallbackMessage*> (&msg) != nullptr)
         {
-            auto& content = callbackMessage->content;
+            Array<OSCBundle::Element> contentToDeliver;
 
-            callListeners (content);
+            {
+                const ScopedLock sl (pendingContentLock);
+                contentToDeliver.swapWith (pendingContent);
+            }
 
-            if (content.isMessage())
-                callListenersWithAddress (content.getMessage());
+            for (auto& content : contentToDeliver)
+            {
+                callListeners (content);
+
+                if (content.isMessage())
+                    callListenersWithAddress (content.getMessage());
+            }
         }
     }
 
@@ -534,33 +848,74 @@ private:
     }
 
     //==============================================================================
+    template <typename ListenerType>
+    static void callListenersWithAddress (const OSCAddressListenerTree<ListenerType>& tree, const OSCMessage& message)
+    {
+        auto& addressPattern = message.getAddressPattern();
+        auto pattern = addressPattern.toString();
+
+        tree.callMatchingListeners (pattern.toRawUTF8(), pattern.getNumBytesAsUTF8(), addressPattern.containsWildcards(),
+                                    [&message] (ListenerType* listener)
+                                    {
+                                        if (listener != nullptr)
+                                            listener->oscMessageReceived (message);
+                                    });
+    }
+
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        callListenersWithAddress (listenersWithAddress, message);
     }
 
     void callRealtimeListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        callListenersWithAddress (realtimeListenersWithAddress, message);
+    }
+
+    void callViewListeners (const OSCMessageView& message)
+    {
+        viewListeners.call (&OSCReceiver::ViewListener::oscMessageReceived, message);
+
+        if (! viewListenersWithAddress.isEmpty())
+        {
+            auto* pattern = message.getAddressPattern();
+            auto patternLength = std::strlen (pattern);
+
+            while (patternLength > 0 && pattern[patternLength - 1] == '/')
+                --patternLength;
+
+            viewListenersWithAddress.callMatchingListeners (pattern, patternLength, message.containsWildcards(),
+                                                            [&message] (OSCReceiver::ViewListener* listener)
+                                                            {
+                                                                if (listener != nullptr)
+                                                                    listener->oscMessageReceived (message);
+                                                            });
+        }
     }
 
     //==============================================================================
     ListenerList<OSCReceiver::Listener<OSCReceiver::MessageLoopCallback>> listeners;
     ListenerList<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>>    realtimeListeners;
 
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
+    OSCAddressListenerTree<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>> listenersWithAddress;
+    OSCAddressListenerTree<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>>    realtimeListenersWithAddress;
+
+    ListenerList<OSCReceiver::ViewListener> viewListeners;
+    OSCAddressListenerTree<OSCReceiver::ViewListener> viewListenersWithAddress;
+
+    Array<OSCBundle::Element> pendingContent;
+    CriticalSection pendingContentLock;
 
     ScopedPointer<DatagramSocket> socket;
     int portNumber = 0;
     OSCReceiver::FormatErrorHandler formatErrorHandler;
-    enum { oscBufferSize = 4098 };
+    enum { oscBufferSize = 4098, maxDatagramsPerRead = 64 };
+
+    HeapBlock<char> datagramBuffers { (size_t) oscBufferSize * maxDatagramsPerRead };
+    int datagramSizes[maxDatagramsPerRead];
+
+    SocketReactor* socketReactor = nullptr;
+    bool usingReactor = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
@@ -585,6 +940,11 @@ bool OSCReceiver::disconnect()
     return pimpl->disconnect();
 }
 
+void OSCReceiver::setSocketReactor (SocketReactor* reactorToUse)
+{
+    pimpl->setSocketReactor (reactorToUse);
+}
+
 void OSCReceiver::addListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToAdd)
 {
     pimpl->addListener (listenerToAdd);
@@ -605,6 +965,16 @@ void OSCReceiver::addListener (ListenerWithOSCAddress<RealtimeCallback>* listene
     pimpl->addListener (listenerToAdd, addressToMatch);
 }
 
+void OSCReceiver::addListener (ViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
+void OSCReceiver::addListener (ViewListener* listenerToAdd, OSCAddress addressToMatch)
+{
+    pimpl->addListener (listenerToAdd, addressToMatch);
+}
+
 void OSCReceiver::removeListener (Listener<MessageLoopCallback>* listenerToRemove)
 {
     pimpl->removeListener (listenerToRemove);
@@ -625,6 +995,11 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::removeListener (ViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1026,6 +1401,7 @@ public:
 
                 expect (bundle.getTimeTag().isImmediately());
                 expect (bundle.size() == 0);
+                expect (canBeVisited (data, sizeof (data)));
             }
 
             // valid bundle (containing both messages and other bundles)
@@ -1087,6 +1463,15 @@ public:
 
                 expect (elements[2].isBundle());
                 expect (! elements[2].getBundle().getTimeTag().isImmediately());
+
+                StringArray visitedAddresses;
+
+                expect (forEachOSCMessage ((const char*) data, sizeof (data), [&] (const OSCMessageView& message)
+                                                                              {
+                                                                                  visitedAddresses.add (message.getAddressPattern());
+                                                                              }));
+
+                expectEquals (visitedAddresses.joinIntoString (" "), String ("/test/1 /test/2"));
             }
 
             // invalid bundles.
@@ -1105,6 +1490,7 @@ public:
 
                 OSCInputStream inStream (data, sizeof (data));
                 expectThrowsType (inStream.readBundle(), OSCFormatError);
+                expect (! canBeVisited (data, sizeof (data)));
             }
 
             {
@@ -1121,6 +1507,7 @@ public:
 
                 OSCInputStream inStream (data, sizeof (data));
                 expectThrowsType (inStream.readBundle(), OSCFormatError);
+                expect (! canBeVisited (data, sizeof (data)));
             }
 
             {
@@ -1131,6 +1518,7 @@ public:
 
                 OSCInputStream inStream (data, sizeof (data));
                 expectThrowsType (inStream.readBundle(), OSCFormatError);
+                expect (! canBeVisited (data, sizeof (data)));
             }
 
             {
@@ -1141,6 +1529,7 @@ public:
 
                 OSCInputStream inStream (data, sizeof (data));
                 expectThrowsType (inStream.readBundle(), OSCFormatError);
+                expect (! canBeVisited (data, sizeof (data)));
             }
 
             {
@@ -1151,13 +1540,115 @@ public:
 
                 OSCInputStream inStream (data, sizeof (data));
                 expectThrowsType (inStream.readBundle(), OSCFormatError);
+                expect (! canBeVisited (data, sizeof (data)));
             }
         }
     }
+
+    static bool canBeVisited (const uint8* data, size_t dataSize)
+    {
+        return forEachOSCMessage ((const char*) data, dataSize, [] (const OSCMessageView&) {});
+    }
 };
 
 static OSCInputStreamTests OSCInputStreamUnitTests;
 
+//==============================================================================
+class OSCAddressListenerTreeTests  : public UnitTest
+{
+public:
+    OSCAddressListenerTreeTests() : UnitTest ("OSCReceiver address listener tree", "OSC") {}
+
+    struct DummyListener {};
+
+    void runTest()
+    {
+        beginTest ("matching the same listeners as OSCAddressPattern::matches()");
+        {
+            const char* addresses[] = { "/a", "/a/b", "/a/b/c", "/a/c", "/b", "/b/b", "/bb/b", "/a//b", "/cue/1",
+                                        "/cue/12", "/cue/2", "/cue/2/go", "/x/y/z", "/a/b/" };
+
+            const char* patterns[] = { "/a", "/a/b", "/a//b", "/a/b/", "/*", "/*/b", "/?/b", "/a/*", "/[a-c]/b",
+                                       "/[!a]/b", "/{a,bb}/b", "/cue/?", "/cue/*", "/cue/[1-2]*", "/cue/{1,2}/go",
+                                       "/*/*/*", "/x/y/z", "/nothing", "/" };
+
+            DummyListener listeners[numElementsInArray (addresses)];
+            OSCAddressListenerTree<DummyListener> tree;
+            firstListener = listeners;
+
+            for (int i = 0; i < numElementsInArray (addresses); ++i)
+                tree.add (OSCAddress (addresses[i]), listeners + i);
+
+            // adding the same address twice is ignored
+            tree.add (OSCAddress (addresses[0]), listeners);
+
+            for (auto* p : patterns)
+            {
+                OSCAddressPattern pattern (p);
+                expectEquals (getMatches (tree, pattern), getExpectedMatches (addresses, pattern), p);
+            }
+
+            tree.remove (listeners + 1);
+            tree.remove (listeners + 7);
+
+            expectEquals (getMatches (tree, OSCAddressPattern ("/a/b")), String ("13"));
+            expectEquals (getMatches (tree, OSCAddressPattern ("/a/*")), String ("3 13"));
+        }
+
+        beginTest ("removing listeners");
+        {
+            DummyListener listener;
+            OSCAddressListenerTree<DummyListener> tree;
+
+            tree.add (OSCAddress ("/a/b"), &listener);
+            tree.add (OSCAddress ("/a/c"), &listener);
+            expect (! tree.isEmpty());
+
+            tree.remove (&listener);
+            expect (tree.isEmpty());
+            expectEquals (getMatches (tree, OSCAddressPattern ("/a/*")), String());
+        }
+    }
+
+private:
+    DummyListener* firstListener = nullptr;
+
+    String getMatches (const OSCAddressListenerTree<DummyListener>& tree, const OSCAddressPattern& pattern)
+    {
+        Array<int> matches;
+        auto s = pattern.toString();
+
+        tree.callMatchingListeners (s.toRawUTF8(), s.getNumBytesAsUTF8(), pattern.containsWildcards(),
+                                    [&] (DummyListener* l) { matches.add ((int) (l - firstListener)); });
+        matches.sort();
+        return toString (matches);
+    }
+
+    template <size_t N>
+    String getExpectedMatches (const char* (&addresses)[N], const OSCAddressPattern& pattern)
+    {
+        Array<int> matches;
+
+        for (int i = 0; i < (int) N; ++i)
+            if (pattern.matches (OSCAddress (addresses[i])))
+                matches.add (i);
+
+        return toString (matches);
+    }
+
+    static String toString (const Array<int>& values)
+    {
+        StringArray s;
+
+        for (auto v : values)
+            s.add (String (v));
+
+        return s.joinIntoString (" ");
+    }
+};
+
+static OSCAddressListenerTreeTests OSCAddressListenerTreeUnitTests;
+
 #endif // JUCE_UNIT_TESTS
 
 } // namespace juce
@@ -60,6 +60,16 @@ public:
     */
     bool disconnect();
 
+    /** Makes the receiver wait for packets using a SocketReactor, rather than its
+        own thread.
+
+        This only takes effect the next time connect() is called. RealtimeCallback
+        listeners will then be called on one of the reactor's threads, so they
+        mustn't block it for long. Pass nullptr to go back to using a thread.
+
+        The reactor must outlive this receiver, or it must be disconnected first.
+    */
+    void setSocketReactor (SocketReactor* reactorToUse);
 
     //==============================================================================
     /** Use this struct as the template parameter for Listener and
@@ -145,6 +155,30 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any memory
+        allocation.
+
+        This type of listener is always called directly on the network thread, and
+        is given an OSCMessageView of the received data rather than an OSCMessage,
+        so if only ViewListeners are registered, the receiver doesn't need to build
+        any OSCMessage objects at all. Messages inside bundles are passed to the
+        listener one at a time, in the order that they appear in the bundle.
+
+        @see OSCReceiver::addListener, OSCMessageView
+    */
+    class JUCE_API  ViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~ViewListener() {}
+
+        /** Called on the network thread when the OSCReceiver receives a new OSC message.
+            The view, and the data it points to, are only valid during this call.
+        */
+        virtual void oscMessageReceived (const OSCMessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -171,6 +205,17 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that is given a view of every OSC message that arrives.
+        The listener will be called in real-time directly on the network thread.
+    */
+    void addListener (ViewListener* listenerToAdd);
+
+    /** Adds a listener that is given a view of the OSC messages that match the
+        address used to register the listener here.
+        The listener will be called in real-time directly on the network thread.
+    */
+    void addListener (ViewListener* listenerToAdd, OSCAddress addressToMatch);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -183,6 +228,12 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener.
+        If the listener was added more than once with different addresses, all of
+        them are removed.
+    */
+    void removeListener (ViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.
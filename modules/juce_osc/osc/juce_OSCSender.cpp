@@ -27,180 +27,193 @@
 namespace juce
 {
 
-namespace
+//==============================================================================
+/** Writes OSC data to an internal memory buffer, which grows as required.
+
+    The data that was written into the stream can then be accessed later as
+    a contiguous block of memory.
+
+    This class implements the Open Sound Control 1.0 Specification for
+    the format in which the OSC data will be written into the buffer.
+*/
+struct OSCOutputStream
 {
-    //==============================================================================
-    /** Writes OSC data to an internal memory buffer, which grows as required.
+    OSCOutputStream() noexcept {}
+
+    /** Returns a pointer to the data that has been written to the stream. */
+    const void* getData() const noexcept    { return output.getData(); }
 
-        The data that was written into the stream can then be accessed later as
-        a contiguous block of memory.
+    /** Returns the number of bytes of data that have been written to the stream. */
+    size_t getDataSize() const noexcept     { return output.getDataSize(); }
 
-        This class implements the Open Sound Control 1.0 Specification for
-        the format in which the OSC data will be written into the buffer.
-    */
-    struct OSCOutputStream
+    /** Empties the stream so that it can be reused, keeping its memory allocated. */
+    void reset() noexcept                   { output.reset(); }
+
+    //==============================================================================
+    bool writeInt32 (int32 value)
     {
-        OSCOutputStream() noexcept {}
+        return output.writeIntBigEndian (value);
+    }
 
-        /** Returns a pointer to the data that has been written to the stream. */
-        const void* getData() const noexcept    { return output.getData(); }
+    bool writeUint64 (uint64 value)
+    {
+        return output.writeInt64BigEndian (int64 (value));
+    }
 
-        /** Returns the number of bytes of data that have been written to the stream. */
-        size_t getDataSize() const noexcept     { return output.getDataSize(); }
+    bool writeFloat32 (float value)
+    {
+        return output.writeFloatBigEndian (value);
+    }
 
-        //==============================================================================
-        bool writeInt32 (int32 value)
-        {
-            return output.writeIntBigEndian (value);
-        }
+    bool writeString (const String& value)
+    {
+        if (! output.writeString (value))
+            return false;
 
-        bool writeUint64 (uint64 value)
-        {
-            return output.writeInt64BigEndian (int64 (value));
-        }
+        const size_t numPaddingZeros = ~value.length() & 3;
 
-        bool writeFloat32 (float value)
-        {
-            return output.writeFloatBigEndian (value);
-        }
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-        bool writeString (const String& value)
-        {
-            if (! output.writeString (value))
-                return false;
+    bool writeBlob (const MemoryBlock& blob)
+    {
+        if (! (output.writeIntBigEndian ((int) blob.getSize())
+                && output.write (blob.getData(), blob.getSize())))
+            return false;
 
-            const size_t numPaddingZeros = ~value.length() & 3;
+        const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+        return output.writeRepeatedByte (0, numPaddingZeros);
+    }
 
-        bool writeBlob (const MemoryBlock& blob)
-        {
-            if (! (output.writeIntBigEndian ((int) blob.getSize())
-                    && output.write (blob.getData(), blob.getSize())))
-                return false;
+    bool writeTimeTag (OSCTimeTag timeTag)
+    {
+        return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
+    }
 
-            const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
+    bool writeAddress (const OSCAddress& address)
+    {
+        return writeString (address.toString());
+    }
 
-            return output.writeRepeatedByte (0, numPaddingZeros);
-        }
+    bool writeAddressPattern (const OSCAddressPattern& ap)
+    {
+        return writeString (ap.toString());
+    }
 
-        bool writeTimeTag (OSCTimeTag timeTag)
-        {
-            return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
-        }
+    bool writeTypeTagString (const OSCTypeList& typeList)
+    {
+        output.writeByte (',');
 
-        bool writeAddress (const OSCAddress& address)
-        {
-            return writeString (address.toString());
-        }
+        if (typeList.size() > 0)
+            output.write (typeList.begin(), (size_t) typeList.size());
 
-        bool writeAddressPattern (const OSCAddressPattern& ap)
-        {
-            return writeString (ap.toString());
-        }
+        output.writeByte ('\0');
 
-        bool writeTypeTagString (const OSCTypeList& typeList)
-        {
-            output.writeByte (',');
+        size_t bytesWritten = (size_t) typeList.size() + 1;
+        size_t numPaddingZeros = ~bytesWritten & 0x03;
 
-            if (typeList.size() > 0)
-                output.write (typeList.begin(), (size_t) typeList.size());
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-            output.writeByte ('\0');
+    bool writeTypeTagString (const OSCMessage& msg)
+    {
+        // this writes the tags straight from the arguments, without having to
+        // build an OSCTypeList first
+        if (! output.writeByte (','))
+            return false;
 
-            size_t bytesWritten = (size_t) typeList.size() + 1;
-            size_t numPaddingZeros = ~bytesWritten & 0x03;
+        for (auto& arg : msg)
+            if (! output.writeByte (arg.getType()))
+                return false;
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+        output.writeByte ('\0');
 
-        bool writeArgument (const OSCArgument& arg)
-        {
-            switch (arg.getType())
-            {
-                case OSCTypes::int32:       return writeInt32 (arg.getInt32());
-                case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
-                case OSCTypes::string:      return writeString (arg.getString());
-                case OSCTypes::blob:        return writeBlob (arg.getBlob());
-
-                default:
-                    // In this very unlikely case you supplied an invalid OSCType!
-                    jassertfalse;
-                    return false;
-            }
-        }
+        size_t bytesWritten = (size_t) msg.size() + 1;
+        size_t numPaddingZeros = ~bytesWritten & 0x03;
 
-        //==============================================================================
-        bool writeMessage (const OSCMessage& msg)
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
+
+    bool writeArgument (const OSCArgument& arg)
+    {
+        switch (arg.getType())
         {
-            if (! writeAddressPattern (msg.getAddressPattern()))
+            case OSCTypes::int32:       return writeInt32 (arg.getInt32());
+            case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
+            case OSCTypes::string:      return writeString (arg.getString());
+            case OSCTypes::blob:        return writeBlob (arg.getBlob());
+
+            default:
+                // In this very unlikely case you supplied an invalid OSCType!
+                jassertfalse;
                 return false;
+        }
+    }
 
-            OSCTypeList typeList;
+    //==============================================================================
+    bool writeMessage (const OSCMessage& msg)
+    {
+        if (! writeAddressPattern (msg.getAddressPattern()))
+            return false;
 
-            for (auto& arg : msg)
-                typeList.add (arg.getType());
+        if (! writeTypeTagString (msg))
+            return false;
 
-            if (! writeTypeTagString (typeList))
+        for (auto& arg : msg)
+            if (! writeArgument (arg))
                 return false;
 
-            for (auto& arg : msg)
-                if (! writeArgument (arg))
-                    return false;
+        return true;
+    }
 
-            return true;
-        }
+    bool writeBundle (const OSCBundle& bundle)
+    {
+        if (! writeString ("#bundle"))
+            return false;
 
-        bool writeBundle (const OSCBundle& bundle)
-        {
-            if (! writeString ("#bundle"))
-                return false;
+        if (! writeTimeTag (bundle.getTimeTag()))
+            return false;
 
-            if (! writeTimeTag (bundle.getTimeTag()))
+        for (auto& element : bundle)
+            if (! writeBundleElement (element))
                 return false;
 
-            for (auto& element : bundle)
-                if (! writeBundleElement (element))
-                    return false;
+        return true;
+    }
 
-            return true;
-        }
+    //==============================================================================
+    bool writeBundleElement (const OSCBundle::Element& element)
+    {
+        const int64 startPos = output.getPosition();
 
-        //==============================================================================
-        bool writeBundleElement (const OSCBundle::Element& element)
-        {
-            const int64 startPos = output.getPosition();
+        if (! writeInt32 (0))   // writing dummy value for element size
+            return false;
 
-            if (! writeInt32 (0))   // writing dummy value for element size
+        if (element.isBundle())
+        {
+            if (! writeBundle (element.getBundle()))
+                return false;
+        }
+        else
+        {
+            if (! writeMessage (element.getMessage()))
                 return false;
-
-            if (element.isBundle())
-            {
-                if (! writeBundle (element.getBundle()))
-                    return false;
-            }
-            else
-            {
-                if (! writeMessage (element.getMessage()))
-                    return false;
-            }
-
-            const int64 endPos = output.getPosition();
-            const int64 elementSize = endPos - (startPos + 4);
-
-            return output.setPosition (startPos)
-                     && writeInt32 ((int32) elementSize)
-                     && output.setPosition (endPos);
         }
 
-    private:
-        MemoryOutputStream output;
+        const int64 endPos = output.getPosition();
+        const int64 elementSize = endPos - (startPos + 4);
 
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
-    };
+        return output.setPosition (startPos)
+                 && writeInt32 ((int32) elementSize)
+                 && output.setPosition (endPos);
+    }
 
-} // namespace
+private:
+    MemoryOutputStream output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
+};
 
 
 //==============================================================================
@@ -235,7 +248,7 @@ struct OSCSender::Pimpl
     //==============================================================================
     bool send (const OSCMessage& message, const String& hostName, int portNumber)
     {
-        OSCOutputStream outStream;
+        outStream.reset();
 
         return outStream.writeMessage (message)
             && sendOutputStream (outStream, hostName, portNumber);
@@ -243,7 +256,7 @@ struct OSCSender::Pimpl
 
     bool send (const OSCBundle& bundle, const String& hostName, int portNumber)
     {
-        OSCOutputStream outStream;
+        outStream.reset();
 
         return outStream.writeBundle (bundle)
             && sendOutputStream (outStream, hostName, portNumber);
@@ -254,14 +267,14 @@ struct OSCSender::Pimpl
 
 private:
     //==============================================================================
-    bool sendOutputStream (OSCOutputStream& outStream, const String& hostName, int portNumber)
+    bool sendOutputStream (OSCOutputStream& streamToSend, const String& hostName, int portNumber)
     {
         if (socket != nullptr)
         {
-            const int streamSize = (int) outStream.getDataSize();
+            const int streamSize = (int) streamToSend.getDataSize();
 
             const int bytesWritten = socket->write (hostName, portNumber,
-                                                    outStream.getData(), streamSize);
+                                                    streamToSend.getData(), streamSize);
             return bytesWritten == streamSize;
         }
 
@@ -276,6 +289,7 @@ private:
     ScopedPointer<DatagramSocket> socket;
     String targetHostName;
     int targetPortNumber = 0;
+    OSCOutputStream outStream; // reused between sends, so that its buffer only has to grow once
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
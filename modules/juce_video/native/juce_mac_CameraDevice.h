@@ -61,7 +61,10 @@ struct CameraDevice::Pimpl
         if (imageOutput == nil)
         {
             imageOutput = [[AVCaptureStillImageOutput alloc] init];
-            auto* imageSettings = [[NSDictionary alloc] initWithObjectsAndKeys: AVVideoCodecJPEG, AVVideoCodecKey, nil];
+
+            // Asking for uncompressed frames avoids encoding each one as a JPEG and then decoding it again
+            auto* imageSettings = [[NSDictionary alloc] initWithObjectsAndKeys: [NSNumber numberWithInt: kCVPixelFormatType_32BGRA],
+                                                                                (id) kCVPixelBufferPixelFormatTypeKey, nil];
             [imageOutput setOutputSettings: imageSettings];
             [imageSettings release];
             [session addOutput: imageOutput];
@@ -150,10 +153,32 @@ struct CameraDevice::Pimpl
         return nil;
     }
 
-    void handleImageCapture (const void* data, size_t size)
+    static Image createImageFrom (CVImageBufferRef pixelBuffer)
     {
-        auto image = ImageFileFormat::loadFrom (data, size);
+        if (CVPixelBufferLockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess)
+            return {};
+
+        auto width  = (int) CVPixelBufferGetWidth (pixelBuffer);
+        auto height = (int) CVPixelBufferGetHeight (pixelBuffer);
+        auto srcLineStride = CVPixelBufferGetBytesPerRow (pixelBuffer);
+        auto* src = static_cast<const uint8*> (CVPixelBufferGetBaseAddress (pixelBuffer));
+
+        // 32BGRA has the same layout in memory as PixelARGB, and the alpha is always opaque
+        Image image (Image::ARGB, width, height, false);
+
+        {
+            const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
 
+            for (int y = 0; y < height; ++y)
+                memcpy (destData.getLinePointer (y), src + srcLineStride * (size_t) y, sizeof (PixelARGB) * (size_t) width);
+        }
+
+        CVPixelBufferUnlockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly);
+        return image;
+    }
+
+    void handleImageCapture (const Image& image)
+    {
         const ScopedLock sl (listenerLock);
 
         if (! listeners.isEmpty())
@@ -176,12 +201,8 @@ struct CameraDevice::Pimpl
             [imageOutput captureStillImageAsynchronouslyFromConnection: videoConnection
                                                      completionHandler: ^(CMSampleBufferRef sampleBuffer, NSError*)
             {
-                auto buffer = CMSampleBufferGetDataBuffer (sampleBuffer);
-                size_t size = CMBlockBufferGetDataLength (buffer);
-                jassert (CMBlockBufferIsRangeContiguous (buffer, 0, size)); // TODO: need to add code to handle this if it happens
-                char* data = nullptr;
-                CMBlockBufferGetDataPointer (buffer, 0, &size, nullptr, &data);
-                handleImageCapture (data, size);
+                if (auto pixelBuffer = CMSampleBufferGetImageBuffer (sampleBuffer))
+                    handleImageCapture (createImageFrom (pixelBuffer));
             }];
         }
     }
@@ -282,7 +282,11 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             const ScopedLock sl (imageSwapLock);
 
             {
-                loadingImage.duplicateIfShared();
+                // if a listener is still holding on to the last frame, there's no need to copy
+                // its pixels, as they're all about to be overwritten
+                if (loadingImage.getReferenceCount() > 1)
+                    loadingImage = Image (Image::RGB, width, height, false);
+
                 const Image::BitmapData destData (loadingImage, 0, 0, width, height, Image::BitmapData::writeOnly);
 
                 for (int i = 0; i < height; ++i)